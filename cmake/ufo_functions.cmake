@@ -40,6 +40,7 @@ endfunction(PREPEND)
 #  NOTRAPFPE - Disable FPE trapping.
 #  WORKING_DIRECTORY - Set working directory.
 #                      If unset, default to ${PROJECT_SOURCE_DIR}/test.
+#  ENVIRONMENT - Environment variables to set in addition to OOPS_TRAPFPE.
 #  ECBUILD   - Beyond this point, pass the remaining options to ecbuild_add_test
 
 function(ufo_add_test)
@@ -47,7 +48,7 @@ function(ufo_add_test)
   set(prefix     ARG)
   set(novals     NOTRAPFPE)
   set(singlevals NAME TIER WORKING_DIRECTORY)
-  set(multivals  ECBUILD )
+  set(multivals  ENVIRONMENT ECBUILD )
   cmake_parse_arguments(${prefix}
                         "${novals}" "${singlevals}" "${multivals}"
                         ${ARGN})
@@ -85,7 +86,7 @@ function(ufo_add_test)
 
       ecbuild_add_test( TARGET  ufo_test_tier${TESTTIER}_${ARG_NAME}
                         WORKING_DIRECTORY ${WORKDIR}
-                        ENVIRONMENT ${TRAPFPE_ENV}
+                        ENVIRONMENT ${TRAPFPE_ENV} ${ARG_ENVIRONMENT}
                         ${ECBUILD_EXTRA}
                         )
 
@@ -0,0 +1,247 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef MAINS_BENCHOBSOPERATOR_H_
+#define MAINS_BENCHOBSOPERATOR_H_
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/JSON.h"
+#include "eckit/mpi/Comm.h"
+
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+
+#include "oops/base/Variables.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Application.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Logger.h"
+
+#include "ufo/GeoVaLs.h"
+#include "ufo/LinearObsOperator.h"
+#include "ufo/Locations.h"
+#include "ufo/ObsBias.h"
+#include "ufo/ObsBiasIncrement.h"
+#include "ufo/ObsDiagnostics.h"
+#include "ufo/ObsOperator.h"
+
+namespace ufo {
+
+/// \brief Application timing observation operators.
+///
+/// For each entry of the `observations` list, the application times repeated calls to the
+/// `simulateObs` method of the operator defined in the `obs operator` section and, if the
+/// `linear obs operator test` section is present (as in the TL/AD tests), to the
+/// `setTrajectory`, `simulateObsTL` and `simulateObsAD` methods of the linear operator defined
+/// in the `linear obs operator` section (or, if that section is absent, `obs operator`). Each
+/// entry must also contain sections `obs space` and `geovals` and may contain `obs bias`.
+///
+/// The top-level `benchmark` section may contain the options
+///
+///   * `warm-up iterations` (default: 1): number of untimed calls made before the timed ones;
+///   * `iterations` (default: 10): number of timed calls;
+///   * `output file` (default: none): name of the JSON file to which the results are written.
+///
+/// For each method, the application reports the minimum, mean, maximum and 50th, 90th and
+/// 99th percentiles of the time taken by a call (on the slowest MPI task), the number of
+/// locations and simulated values (locations times variables or channels) processed per second
+/// based on the median time, and the peak resident set size of each MPI task.
+class BenchObsOperator : public oops::Application {
+ public:
+// -----------------------------------------------------------------------------
+  explicit BenchObsOperator(const eckit::mpi::Comm & comm = oops::mpi::world())
+    : Application(comm) {}
+// -----------------------------------------------------------------------------
+  virtual ~BenchObsOperator() {}
+// -----------------------------------------------------------------------------
+  int execute(const eckit::Configuration & fullConfig, bool validate) const {
+    const util::DateTime winbgn(fullConfig.getString("window begin"));
+    const util::DateTime winend(fullConfig.getString("window end"));
+
+    const eckit::LocalConfiguration benchConf = fullConfig.getSubConfiguration("benchmark");
+    const int nwarmup = benchConf.getInt("warm-up iterations", 1);
+    const int niter = benchConf.getInt("iterations", 10);
+    ASSERT(niter > 0);
+
+    std::vector<eckit::LocalConfiguration> confs;
+    fullConfig.get("observations", confs);
+
+    std::vector<Result> results;
+    for (const eckit::LocalConfiguration & conf : confs) {
+      const eckit::LocalConfiguration obsconf(conf, "obs space");
+      ioda::ObsTopLevelParameters obsparams;
+      obsparams.validateAndDeserialize(obsconf);
+      ioda::ObsSpace odb(obsparams, this->getComm(), winbgn, winend, oops::mpi::myself());
+      const size_t nlocs = odb.globalNumLocs();
+      const size_t nvalues = nlocs * ioda::ObsVector(odb).nvars();
+
+      ObsBiasParameters biasparams;
+      biasparams.validateAndDeserialize(conf.getSubConfiguration("obs bias"));
+      const ObsBias ybias(odb, biasparams);
+
+      const eckit::LocalConfiguration gconf(conf, "geovals");
+      GeoVaLsParameters geovalsparams;
+      geovalsparams.validateAndDeserialize(gconf);
+
+      // Nonlinear operator
+      {
+        ObsOperatorParametersWrapper hopparams;
+        hopparams.validateAndDeserialize(conf.getSubConfiguration("obs operator"));
+        ObsOperator hop(odb, hopparams);
+        oops::Variables vars = hop.requiredVars();
+        vars += ybias.requiredVars();
+        const GeoVaLs gval(geovalsparams, odb, vars);
+        ioda::ObsVector hofx(odb);
+        ioda::ObsVector bias(odb);
+        bias.zero();
+        std::unique_ptr<Locations> locs = hop.locations();
+        ObsDiagnostics diags(odb, *locs, ybias.requiredHdiagnostics());
+        results.push_back(time(odb.obsname(), "simulateObs", nlocs, nvalues, nwarmup, niter,
+                               [&] {hop.simulateObs(gval, hofx, ybias, bias, diags);}));
+      }
+
+      // Linear operator
+      if (conf.has("linear obs operator test")) {
+        LinearObsOperatorParametersWrapper hoptlparams;
+        hoptlparams.validateAndDeserialize(conf.getSubConfiguration(
+            conf.has("linear obs operator") ? "linear obs operator" : "obs operator"));
+        LinearObsOperator hoptl(odb, hoptlparams);
+        oops::Variables vars = hoptl.requiredVars();
+        vars += ybias.requiredVars();
+        const GeoVaLs gval(geovalsparams, odb, vars);
+        results.push_back(time(odb.obsname(), "setTrajectory", nlocs, nvalues, nwarmup, niter,
+                               [&] {hoptl.setTrajectory(gval, ybias);}));
+
+        GeoVaLs dx(gval);
+        dx.random();
+        ioda::ObsVector dy(odb);
+        ObsBiasIncrement ybinc(odb, biasparams);
+        ybinc.zero();
+        results.push_back(time(odb.obsname(), "simulateObsTL", nlocs, nvalues, nwarmup, niter,
+                               [&] {hoptl.simulateObsTL(dx, dy, ybinc);}));
+
+        dy.random();
+        dx.zero();
+        results.push_back(time(odb.obsname(), "simulateObsAD", nlocs, nvalues, nwarmup, niter,
+                               [&] {hoptl.simulateObsAD(dx, dy, ybinc);}));
+      }
+    }
+
+    report(results, benchConf.getString("output file", ""));
+    return 0;
+  }
+// -----------------------------------------------------------------------------
+ private:
+  /// Timings of one method of one operator.
+  struct Result {
+    std::string obsSpace;
+    std::string method;
+    size_t nlocs;
+    size_t nvalues;
+    std::vector<double> seconds;  ///< Time taken by each call, in increasing order.
+  };
+// -----------------------------------------------------------------------------
+  template <typename Function>
+  Result time(const std::string & obsSpace, const std::string & method, size_t nlocs,
+              size_t nvalues, int nwarmup, int niter, const Function & f) const {
+    for (int i = 0; i < nwarmup; ++i)
+      f();
+    Result result{obsSpace, method, nlocs, nvalues, std::vector<double>(niter)};
+    for (int i = 0; i < niter; ++i) {
+      this->getComm().barrier();
+      const auto start = std::chrono::steady_clock::now();
+      f();
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      result.seconds[i] = elapsed.count();
+    }
+    // A call is as slow as the slowest task.
+    this->getComm().allReduceInPlace(result.seconds.begin(), result.seconds.end(),
+                                     eckit::mpi::max());
+    std::sort(result.seconds.begin(), result.seconds.end());
+    oops::Log::info() << "BenchObsOperator: " << obsSpace << " " << method << ": median "
+                      << percentile(result.seconds, 50) << " s" << std::endl;
+    return result;
+  }
+// -----------------------------------------------------------------------------
+  /// Percentile \p p of the sorted values \p x (nearest-rank method).
+  static double percentile(const std::vector<double> & x, double p) {
+    const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * x.size()));
+    return x[std::max<size_t>(rank, 1) - 1];
+  }
+// -----------------------------------------------------------------------------
+  void report(const std::vector<Result> & results, const std::string & outputFile) const {
+    // Peak resident set size of each task, in kB.
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::vector<long> peakRss(this->getComm().size(), 0);  // NOLINT(runtime/int)
+    peakRss[this->getComm().rank()] = usage.ru_maxrss;
+    this->getComm().allReduceInPlace(peakRss.begin(), peakRss.end(), eckit::mpi::sum());
+
+    if (this->getComm().rank() != 0)
+      return;
+
+    std::ofstream file;
+    if (!outputFile.empty())
+      file.open(outputFile);
+    std::ostream & os = outputFile.empty() ? oops::Log::info() : file;
+
+    eckit::JSON json(os);
+    json.startObject();
+    json << "tasks" << this->getComm().size();
+    json << "peak rss kB per task";
+    json.startList();
+    for (long rss : peakRss)  // NOLINT(runtime/int)
+      json << rss;
+    json.endList();
+    json << "results";
+    json.startList();
+    for (const Result & result : results) {
+      const double mean = std::accumulate(result.seconds.begin(), result.seconds.end(), 0.0) /
+                          result.seconds.size();
+      const double median = percentile(result.seconds, 50);
+      json.startObject();
+      json << "obs space" << result.obsSpace;
+      json << "method" << result.method;
+      json << "locations" << result.nlocs;
+      json << "values" << result.nvalues;
+      json << "iterations" << result.seconds.size();
+      json << "min s" << result.seconds.front();
+      json << "mean s" << mean;
+      json << "p50 s" << median;
+      json << "p90 s" << percentile(result.seconds, 90);
+      json << "p99 s" << percentile(result.seconds, 99);
+      json << "max s" << result.seconds.back();
+      json << "locations per s" << (median > 0 ? result.nlocs / median : 0.0);
+      json << "values per s" << (median > 0 ? result.nvalues / median : 0.0);
+      json.endObject();
+    }
+    json.endList();
+    json.endObject();
+    os << std::endl;
+  }
+// -----------------------------------------------------------------------------
+  std::string appname() const {
+    return "ufo::BenchObsOperator";
+  }
+// -----------------------------------------------------------------------------
+};
+
+}  // namespace ufo
+
+#endif  // MAINS_BENCHOBSOPERATOR_H_
@@ -0,0 +1,272 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef MAINS_GENERATESYNTHETICOBS_H_
+#define MAINS_GENERATESYNTHETICOBS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+
+#include "ioda/ObsSpace.h"
+
+#include "oops/base/Variables.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Application.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Duration.h"
+#include "oops/util/Logger.h"
+#include "oops/util/parameters/NumericConstraints.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/Parameters.h"
+#include "oops/util/parameters/RequiredParameter.h"
+
+#include "ufo/AnalyticInit.h"
+#include "ufo/GeoVaLs.h"
+#include "ufo/Locations.h"
+
+namespace ufo {
+
+/// \brief Options controlling the size and structure of a synthetic obs space.
+class SyntheticObsParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(SyntheticObsParameters, Parameters)
+
+ public:
+  /// Total number of locations (over all MPI tasks).
+  oops::RequiredParameter<int> locations{"locations", this, {oops::minConstraint(1)}};
+  /// Number of stations. Records are assigned to stations in turn.
+  oops::Parameter<int> stations{"stations", 1, this, {oops::minConstraint(1)}};
+  /// Number of locations in each record (e.g. levels of a sounding); the last record may be
+  /// shorter.
+  oops::Parameter<int> locationsPerRecord{"locations per record", 1, this,
+                                          {oops::minConstraint(1)}};
+  /// Number of model levels of the GeoVaLs.
+  oops::Parameter<int> levels{"levels", 70, this, {oops::minConstraint(1)}};
+  /// Observation error of all simulated variables.
+  oops::Parameter<float> obsError{"obs error", 1.0f, this, {oops::exclusiveMinConstraint(0.0f)}};
+  /// Seed of the observation noise.
+  oops::Parameter<int> randomSeed{"random seed", 1, this};
+  /// Stations are spread over this latitude-longitude box (degrees).
+  oops::Parameter<float> minLatitude{"min latitude", -80.0f, this};
+  oops::Parameter<float> maxLatitude{"max latitude", 80.0f, this};
+  oops::Parameter<float> minLongitude{"min longitude", -180.0f, this};
+  oops::Parameter<float> maxLongitude{"max longitude", 180.0f, this};
+};
+
+// -----------------------------------------------------------------------------
+
+/// \brief Application generating synthetic obs spaces and matching GeoVaLs of any size.
+///
+/// Meant for benchmarks and strong/weak scaling studies that should not depend on operational
+/// data. For each entry of the `observations` list, the application
+///
+///   * creates the obs space defined in the `obs space` section (whose `obsdatain` section is
+///     ignored and should be omitted) with the number of locations, stations and records set in
+///     the `generator` section (see SyntheticObsParameters). Records are sequences of
+///     consecutive locations made by the same station at increasing times and decreasing
+///     pressures; stations are spread regularly over the chosen latitude-longitude box;
+///   * fills MetaData/station_id (string), MetaData/record_number (int) and
+///     MetaData/air_pressure and the ObsValue and ObsError groups of all simulated variables
+///     (including channels, if the `channels` option is set), adding Gaussian noise with the
+///     chosen obs error to smooth fields;
+///   * saves the obs space to the file set in its `obsdataout` section;
+///   * if the `geovals` section is present, creates the GeoVaLs of the variables listed in
+///     `geovals.variables` (with `generator.levels` levels) and `geovals.surface variables`
+///     (with one level) at all locations, fills them with the `synthetic` AnalyticInit method
+///     (or the one set in the `analytic init` section) and writes them to the file set in the
+///     `geovals.output` section (see GeoVaLsParameters).
+///
+/// All values depend only on the location's index and not on the number of MPI tasks. Reading
+/// the files with `obsgrouping: {group variables: [record_number]}` restores the records.
+class GenerateSyntheticObs : public oops::Application {
+ public:
+// -----------------------------------------------------------------------------
+  explicit GenerateSyntheticObs(const eckit::mpi::Comm & comm = oops::mpi::world())
+    : Application(comm) {}
+// -----------------------------------------------------------------------------
+  virtual ~GenerateSyntheticObs() {}
+// -----------------------------------------------------------------------------
+  int execute(const eckit::Configuration & fullConfig, bool validate) const {
+    const util::DateTime winbgn(fullConfig.getString("window begin"));
+    const util::DateTime winend(fullConfig.getString("window end"));
+
+    std::vector<eckit::LocalConfiguration> confs;
+    fullConfig.get("observations", confs);
+    for (const eckit::LocalConfiguration & conf : confs) {
+      SyntheticObsParameters params;
+      params.validateAndDeserialize(conf.getSubConfiguration("generator"));
+      generate(conf, params, winbgn, winend);
+    }
+    return 0;
+  }
+// -----------------------------------------------------------------------------
+ private:
+  /// Position of one location in the synthetic obs space.
+  struct SyntheticLocation {
+    int station;
+    int record;
+    float latitude;
+    float longitude;
+    float pressure;    ///< Pa
+    int64_t seconds;   ///< since the start of the window
+  };
+// -----------------------------------------------------------------------------
+  static SyntheticLocation syntheticLocation(size_t index, const SyntheticObsParameters & params,
+                                             int64_t windowSeconds) {
+    const int nstations = params.stations;
+    const int locsPerRecord = params.locationsPerRecord;
+    const int nrecords = (params.locations + locsPerRecord - 1) / locsPerRecord;
+    const int ncycles = (nrecords + nstations - 1) / nstations;
+
+    SyntheticLocation loc;
+    loc.record = index / locsPerRecord;
+    loc.station = loc.record % nstations;
+    const int level = index % locsPerRecord;
+    // Stations are spread along a spiral covering the box.
+    const double latFraction = (loc.station + 0.5) / nstations;
+    const double lonFraction = std::fmod(loc.station * 0.6180339887, 1.0);
+    loc.latitude = params.minLatitude + latFraction * (params.maxLatitude - params.minLatitude);
+    loc.longitude = params.minLongitude +
+        lonFraction * (params.maxLongitude - params.minLongitude) + 0.01f * level;
+    loc.pressure = 100000.0f * (1.0f - 0.99f * level / locsPerRecord);
+    // Each station repeats its records at regular intervals; each location of a record is
+    // 10 s after the previous one.
+    const int cycle = loc.record / nstations;
+    loc.seconds = std::min<int64_t>(
+          static_cast<int64_t>(windowSeconds * (cycle + 0.5) / ncycles) + 10 * level,
+          windowSeconds);
+    return loc;
+  }
+// -----------------------------------------------------------------------------
+  /// Standard normal deviate depending only on \p seed, \p index and \p variable.
+  static double gaussianNoise(uint64_t seed, uint64_t index, uint64_t variable) {
+    const auto uniform = [](uint64_t x) {
+      // splitmix64
+      x += 0x9e3779b97f4a7c15ULL;
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      x ^= x >> 31;
+      return ((x >> 11) + 0.5) / 9007199254740992.0;  // in (0, 1)
+    };
+    const uint64_t key = (seed * 0x100000001b3ULL ^ index) * 0x100000001b3ULL ^ variable;
+    const double u1 = uniform(2 * key);
+    const double u2 = uniform(2 * key + 1);
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+  }
+// -----------------------------------------------------------------------------
+  void generate(const eckit::LocalConfiguration & conf, const SyntheticObsParameters & params,
+                const util::DateTime & winbgn, const util::DateTime & winend) const {
+    const int64_t windowSeconds = (winend - winbgn).toSeconds();
+    const size_t nlocs = params.locations;
+
+    // Generate the coordinates of all locations; ioda distributes them among the MPI tasks.
+    std::vector<double> lats(nlocs), lons(nlocs);
+    std::vector<long> times(nlocs);  // NOLINT(runtime/int)
+    for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+      const SyntheticLocation loc = syntheticLocation(jloc, params, windowSeconds);
+      lats[jloc] = loc.latitude;
+      lons[jloc] = loc.longitude;
+      times[jloc] = loc.seconds;
+    }
+    eckit::LocalConfiguration engine;
+    engine.set("type", "GenList");
+    engine.set("lats", lats);
+    engine.set("lons", lons);
+    engine.set("dateTimes", times);
+    engine.set("epoch", "seconds since " + winbgn.toString());
+    eckit::LocalConfiguration obsconf(conf, "obs space");
+    const oops::Variables simulated(obsconf, "simulated variables");
+    engine.set("obs errors", std::vector<double>(simulated.size(), params.obsError));
+    obsconf.set("obsdatain", eckit::LocalConfiguration().set("engine", engine));
+    ioda::ObsTopLevelParameters obsparams;
+    obsparams.validateAndDeserialize(obsconf);
+    ioda::ObsSpace odb(obsparams, this->getComm(), winbgn, winend, oops::mpi::myself());
+
+    // Fill the metadata and observations of the locations held on this task.
+    const std::vector<size_t> & index = odb.index();
+    const oops::Variables & obsvars = odb.obsvariables();
+    std::vector<std::string> stations(odb.nlocs());
+    std::vector<int> records(odb.nlocs());
+    std::vector<float> pressures(odb.nlocs());
+    std::vector<std::vector<float>> values(obsvars.size(), std::vector<float>(odb.nlocs()));
+    const double deg2rad = M_PI / 180.0;
+    for (size_t jloc = 0; jloc < odb.nlocs(); ++jloc) {
+      const SyntheticLocation loc = syntheticLocation(index[jloc], params, windowSeconds);
+      stations[jloc] = std::to_string(10000 + loc.station);
+      records[jloc] = loc.record;
+      pressures[jloc] = loc.pressure;
+      const double pattern = std::cos(loc.latitude * deg2rad) * std::cos(loc.longitude * deg2rad);
+      for (size_t jvar = 0; jvar < obsvars.size(); ++jvar) {
+        const double signal = obsvars[jvar].find("temperature") != std::string::npos ?
+              250.0 + 40.0 * pattern : 10.0 * (1.0 + 0.1 * pattern);
+        values[jvar][jloc] = signal + params.obsError *
+              gaussianNoise(params.randomSeed.value(), index[jloc], jvar);
+      }
+    }
+    odb.put_db("MetaData", "station_id", stations);
+    odb.put_db("MetaData", "record_number", records);
+    odb.put_db("MetaData", "air_pressure", pressures);
+    const std::vector<float> errors(odb.nlocs(), params.obsError);
+    for (size_t jvar = 0; jvar < obsvars.size(); ++jvar) {
+      odb.put_db("ObsValue", obsvars[jvar], values[jvar]);
+      odb.put_db("ObsError", obsvars[jvar], errors);
+    }
+    odb.save();
+    oops::Log::info() << "GenerateSyntheticObs: " << odb.obsname() << ": " << nlocs
+                      << " locations, " << obsvars.size() << " variables, "
+                      << params.stations.value() << " stations" << std::endl;
+
+    if (conf.has("geovals"))
+      generateGeoVaLs(conf, params, odb);
+  }
+// -----------------------------------------------------------------------------
+  void generateGeoVaLs(const eckit::LocalConfiguration & conf,
+                       const SyntheticObsParameters & params, const ioda::ObsSpace & odb) const {
+    const eckit::LocalConfiguration gconf(conf, "geovals");
+    const oops::Variables profileVars(gconf, "variables");
+    const oops::Variables surfaceVars(gconf.has("surface variables") ?
+          oops::Variables(gconf, "surface variables") : oops::Variables());
+    oops::Variables vars(profileVars);
+    vars += surfaceVars;
+    std::vector<size_t> nlevs(profileVars.size(), params.levels);
+    nlevs.resize(vars.size(), 1);
+
+    std::vector<float> lats(odb.nlocs()), lons(odb.nlocs());
+    std::vector<util::DateTime> times(odb.nlocs());
+    odb.get_db("MetaData", "latitude", lats);
+    odb.get_db("MetaData", "longitude", lons);
+    odb.get_db("MetaData", "dateTime", times);
+    const Locations locs(lons, lats, times, odb.distribution());
+    GeoVaLs geovals(locs, vars, nlevs);
+
+    AnalyticInitParameters initparams;
+    initparams.validateAndDeserialize(conf.has("analytic init") ?
+          conf.getSubConfiguration("analytic init") :
+          eckit::LocalConfiguration().set("method", "synthetic"));
+    AnalyticInit(initparams).fillGeoVaLs(locs, geovals);
+
+    GeoVaLsParameters geovalsparams;
+    geovalsparams.validateAndDeserialize(gconf.getSubConfiguration("output"));
+    geovals.write(geovalsparams);
+    oops::Log::info() << "GenerateSyntheticObs: " << odb.obsname() << ": GeoVaLs of "
+                      << vars.size() << " variables written" << std::endl;
+  }
+// -----------------------------------------------------------------------------
+  std::string appname() const {
+    return "ufo::GenerateSyntheticObs";
+  }
+// -----------------------------------------------------------------------------
+};
+
+}  // namespace ufo
+
+#endif  // MAINS_GENERATESYNTHETICOBS_H_
@@ -0,0 +1,15 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "./BenchObsOperator.h"
+#include "oops/runs/Run.h"
+
+int main(int argc,  char ** argv) {
+  oops::Run run(argc, argv);
+  ufo::BenchObsOperator bench;
+  return run.execute(bench);
+}
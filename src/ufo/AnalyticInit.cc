@@ -7,6 +7,12 @@
 
 #include "ufo/AnalyticInit.h"
 
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "oops/base/Variables.h"
 #include "oops/util/Logger.h"
 
 #include "ufo/GeoVaLs.h"
@@ -15,13 +21,14 @@
 
 namespace ufo {
 
-// Ideally, we would have five separate analytic init classes for the below cases,
+// Ideally, we would have six separate analytic init classes for the below cases,
 // but for now we'll use the same class to do all.
 static oops::AnalyticInitMaker<ObsTraits, AnalyticInit> makerAnalytic1_("invent_state");
 static oops::AnalyticInitMaker<ObsTraits, AnalyticInit> makerAnalytic2_("dcmip-test-1-1");
 static oops::AnalyticInitMaker<ObsTraits, AnalyticInit> makerAnalytic3_("dcmip-test-1-2");
 static oops::AnalyticInitMaker<ObsTraits, AnalyticInit> makerAnalytic4_("dcmip-test-3-1");
 static oops::AnalyticInitMaker<ObsTraits, AnalyticInit> makerAnalytic5_("dcmip-test-4-0");
+static oops::AnalyticInitMaker<ObsTraits, AnalyticInit> makerAnalytic6_("synthetic");
 
 // -----------------------------------------------------------------------------
 /// \brief Constructor for tests
@@ -43,8 +50,74 @@ AnalyticInit::AnalyticInit(const Parameters_ & options) : options_(options)
 void AnalyticInit::fillGeoVaLs(const Locations & locs, GeoVaLs & geovals) const
 {
   oops::Log::trace() << "AnalyticInit::analytic_init starting" << std::endl;
-  ufo_geovals_analytic_init_f90(geovals.toFortran(), locs, options_.toConfiguration());
+  if (options_.method.value() == "synthetic")
+    fillSyntheticGeoVaLs(locs, geovals);
+  else
+    ufo_geovals_analytic_init_f90(geovals.toFortran(), locs, options_.toConfiguration());
   oops::Log::trace() << "AnalyticInit::analytic_init done" << std::endl;
 }
 // -----------------------------------------------------------------------------
+/*! \brief Fill all GeoVaLs with smooth synthetic profiles
+ *
+ * \details Level 0 is the top of the model. The pressure of full levels (and of level
+ * interfaces, for variables whose name ends with `_levels`) increases linearly from
+ * `top pressure` to `surface pressure`. The other variables are recognized by their names:
+ * temperatures follow a lapse rate and heights the corresponding hydrostatic profile, humidities
+ * decay with height, winds depend on latitude; all other variables (including surface
+ * variables) are set to values of order one varying smoothly with latitude and longitude.
+ * The values depend only on the location and level, not on the MPI task holding the location.
+ */
+void AnalyticInit::fillSyntheticGeoVaLs(const Locations & locs, GeoVaLs & geovals) const
+{
+  const double psurf = options_.surfacePressure.value();
+  const double ptop = std::min(options_.topPressure.value(), psurf);
+  const double deg2rad = M_PI / 180.0;
+  const std::vector<float> & lats = locs.lats();
+  const std::vector<float> & lons = locs.lons();
+  const oops::Variables & vars = geovals.getVars();
+
+  for (size_t jvar = 0; jvar < vars.size(); ++jvar) {
+    const std::string & var = vars[jvar];
+    const GeoVaLsView view = geovals.view(var);
+    double * values = geovals.data(var);
+    if (values == nullptr)
+      continue;
+    const size_t nlevs = view.nlevs();
+    const size_t nlocs = std::min(view.nlocs(), lats.size());
+    const bool interfaces = var.size() > 7 && var.compare(var.size() - 7, 7, "_levels") == 0;
+    const auto has = [&var](const char * word) {return var.find(word) != std::string::npos;};
+
+    for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+      const double lat = lats[jloc] * deg2rad;
+      const double lon = lons[jloc] * deg2rad;
+      const double pattern = std::cos(lat) * std::cos(lon);
+      for (size_t jlev = 0; jlev < nlevs; ++jlev) {
+        // Fraction of the distance from the top to the surface.
+        const double sigma = nlevs == 1 ? 1.0 :
+            interfaces ? static_cast<double>(jlev) / (nlevs - 1) : (jlev + 0.5) / nlevs;
+        const double p = ptop + sigma * (psurf - ptop);
+        const double tsurf = 250.0 + 40.0 * std::cos(lat) + 2.0 * pattern;
+        // Temperature with a lapse rate of 6.5 K/km below the tropopause, isothermal above.
+        const double t = std::max(tsurf * std::pow(p / psurf, 0.19), 200.0);
+        double value;
+        if (has("pressure"))
+          value = p;
+        else if (has("temperature"))
+          value = t;
+        else if (has("height") || has("geopotential"))
+          value = 29.3 * 0.5 * (t + tsurf) * std::log(psurf / p);
+        else if (has("humidity") || has("mixing_ratio"))
+          value = 0.015 * std::cos(lat) * std::cos(lat) * std::pow(p / psurf, 3.0);
+        else if (has("eastward_wind"))
+          value = 20.0 * std::sin(2.0 * lat) * (1.0 - sigma) + 5.0 * pattern;
+        else if (has("northward_wind"))
+          value = 5.0 * std::sin(lon) * std::cos(lat);
+        else
+          value = (1.0 + 0.1 * pattern) * (1.0 + 0.1 * sigma);
+        values[jloc * nlevs + jlev] = value;
+      }
+    }
+  }
+}
+// -----------------------------------------------------------------------------
 }  // namespace ufo
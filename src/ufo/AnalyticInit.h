@@ -9,6 +9,8 @@
 #define UFO_ANALYTICINIT_H_
 
 #include "oops/interface/AnalyticInitBase.h"
+#include "oops/util/parameters/NumericConstraints.h"
+#include "oops/util/parameters/Parameter.h"
 
 #include "ufo/ObsTraits.h"
 
@@ -16,13 +18,24 @@ namespace ufo {
   class GeoVaLs;
   class Locations;
 
-/// Parameters for Analytic init (empty except for analytic init method defined
-/// in the base class)
+/// Parameters for Analytic init (the analytic init method is defined in the base class)
 class AnalyticInitParameters : public oops::AnalyticInitParametersBase {
   OOPS_CONCRETE_PARAMETERS(AnalyticInitParameters, AnalyticInitParametersBase)
+
+ public:
+  /// Surface pressure (Pa) used by the `synthetic` method.
+  oops::Parameter<double> surfacePressure{"surface pressure", 101325.0, this,
+                                          {oops::exclusiveMinConstraint(0.0)}};
+  /// Pressure (Pa) at the top of the model used by the `synthetic` method.
+  oops::Parameter<double> topPressure{"top pressure", 10.0, this,
+                                      {oops::exclusiveMinConstraint(0.0)}};
 };
 
 /// AnalyticInit: filling GeoVaLs with analytic formula
+///
+/// The `synthetic` method, meant for generating GeoVaLs of any size for benchmarks, fills all
+/// variables (not just temperature) with smooth, physically plausible profiles of latitude,
+/// longitude and level; see fillSyntheticGeoVaLs(). The other methods are implemented in Fortran.
 class AnalyticInit : public oops::interface::AnalyticInitBase<ObsTraits> {
  public:
   typedef AnalyticInitParameters Parameters_;
@@ -30,6 +43,8 @@ class AnalyticInit : public oops::interface::AnalyticInitBase<ObsTraits> {
   void fillGeoVaLs(const Locations &, GeoVaLs &) const override;
 
  private:
+  void fillSyntheticGeoVaLs(const Locations &, GeoVaLs &) const;
+
   const Parameters_ options_;
 };
 
@@ -8,11 +8,17 @@
 #include "ufo/GeoVaLs.h"
 
 #include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <string>
 #include <iomanip>
+#include <memory>
 #include <utility>
 #include <vector>
 
+#include "eckit/config/LocalConfiguration.h"
 #include "eckit/exception/Exceptions.h"
+#include "eckit/mpi/Comm.h"
 
 #include "ioda/distribution/Accumulator.h"
 #include "ioda/distribution/Distribution.h"
@@ -23,9 +29,82 @@
 
 #include "ufo/GeoVaLs.interface.h"
 #include "ufo/Locations.h"
+#include "ufo/utils/BackgroundTaskQueue.h"
+#include "ufo/utils/ReproducibleSum.h"
 
 namespace ufo {
 
+namespace {
+
+/// Sum of the squares of the \p n values starting at \p x.
+double sumOfSquares(const double * x, size_t n) {
+  double sum = 0.0;
+  #pragma omp simd reduction(+:sum)
+  for (size_t i = 0; i < n; ++i)
+    sum += x[i] * x[i];
+  return sum;
+}
+
+/// Call \p addTerm(jloc, term) for each location \p jloc of \p x, \p term being the sum of the
+/// products of the values of \p x and \p y at all levels of that location, skipping the pairs in
+/// which either value is missing.
+///
+/// If \p update is not null, it must point to the (modifiable) storage viewed by \p x; the
+/// values of \p inc multiplied by \p zz are then added to those of each location just before
+/// they are used.
+template <typename AddTerm>
+void dotProductByLocation(const GeoVaLsView & x, const GeoVaLsView & y, const double missing,
+                          const AddTerm & addTerm, double * update = nullptr,
+                          const double * inc = nullptr, const double zz = 0.0) {
+  const size_t nlevs = x.nlevs();
+  for (size_t jloc = 0; jloc < x.nlocs(); ++jloc) {
+    if (update != nullptr) {
+      double * xloc = update + jloc * x.locationStride();
+      const double * incloc = inc + jloc * x.locationStride();
+      #pragma omp simd
+      for (size_t jlev = 0; jlev < nlevs; ++jlev)
+        xloc[jlev] += zz * incloc[jlev];
+    }
+    const double * xloc = x.atLocation(jloc);
+    const double * yloc = y.atLocation(jloc);
+    double term = 0.0;
+    #pragma omp simd reduction(+:term)
+    for (size_t jlev = 0; jlev < nlevs; ++jlev)
+      term += (xloc[jlev] != missing && yloc[jlev] != missing) ? xloc[jlev] * yloc[jlev] : 0.0;
+    addTerm(jloc, term);
+  }
+}
+
+/// Sums of terms attributed to locations, reduced across tasks, computed exactly (see
+/// ReproducibleSum) so that they do not depend on the distribution of the locations. As with
+/// ioda accumulators, terms attributed to locations that are not patch obs of this task are
+/// ignored.
+class ReproducibleAccumulator {
+ public:
+  ReproducibleAccumulator(const ioda::Distribution & dist, size_t nlocs, size_t nsums)
+    : dist_(dist), isPatchObs_(nlocs), sums_(nsums) {
+    dist_.patchObs(isPatchObs_);
+  }
+
+  void addTerm(size_t jloc, size_t jsum, double term) {
+    if (isPatchObs_[jloc])
+      sums_[jsum].add(term);
+  }
+
+  std::vector<double> computeResult() const {
+    return allReduceValues(sums_, [this](std::vector<double> & packed) {
+      dist_.allReduceInPlace(packed, eckit::mpi::sum());
+    });
+  }
+
+ private:
+  const ioda::Distribution & dist_;
+  std::vector<bool> isPatchObs_;
+  std::vector<ReproducibleSum> sums_;
+};
+
+}  // namespace
+
 // -----------------------------------------------------------------------------
 /*! \brief Deprecated default constructor - does not allocate fields.
  *
@@ -66,13 +145,57 @@ GeoVaLs::GeoVaLs(const Locations & locs, const oops::Variables & vars)
  * applications.
  * Sizes of GeoVaLs for i-th variable at a single location are defined by i-th value
  * of \p nlevs.
+ *
+ * If the environment variable UFO_GEOVALS_SINGLE_PRECISION is set, the values are stored in
+ * single precision until they are first used by anything else than fill(), halving the memory
+ * taken by GeoVaLs waiting to be used by the observation operators while the model is
+ * integrated. The values are converted back to double precision before they are used by the
+ * operators and filters, so all calculations (including the accumulation of adjoint values)
+ * are still made in double precision; only the values passed to fill() are rounded.
+ *
+ * If \p locs list the levels used by the observation operator (see Locations::requiredLevels()),
+ * only these levels of the listed variables are stored; nlevs() then returns the number of
+ * stored levels, whereas fill() and fillAD() still take all levels passed by the model.
+ *
+ * If \p locs sample the paths of individual observations (see Locations::setPaths()), the
+ * variables listed by Locations::perPathVariables() are stored only at the path centres.
  */
 GeoVaLs::GeoVaLs(const Locations & locs, const oops::Variables & vars,
                  const std::vector<size_t> & nlevs)
   : keyGVL_(-1), vars_(vars), dist_(locs.distribution())
 {
   oops::Log::trace() << "GeoVaLs contructor starting" << std::endl;
-  ufo_geovals_setup_f90(keyGVL_, locs.size(), vars_, nlevs.size(), nlevs[0]);
+  const RequiredLevelsMap & requiredLevels = locs.requiredLevels();
+  if (requiredLevels.empty()) {
+    ufo_geovals_setup_f90(keyGVL_, locs.size(), vars_, nlevs.size(), nlevs[0]);
+  } else {
+    // Allocate only the levels used by the observation operator; fill() and fillAD() still
+    // expect all nlevs levels.
+    std::vector<size_t> storedNlevs(nlevs);
+    std::vector<size_t> offsets(nlevs.size(), 0);
+    for (size_t jv = 0; jv < vars_.size() && jv < nlevs.size(); ++jv) {
+      const auto it = requiredLevels.find(vars_[jv]);
+      if (it == requiredLevels.end() || it->second.numLevels >= nlevs[jv]) continue;
+      storedNlevs[jv] = it->second.numLevels;
+      if (it->second.nearSurface) offsets[jv] = nlevs[jv] - storedNlevs[jv];
+    }
+    ufo_geovals_setup_f90(keyGVL_, locs.size(), vars_, storedNlevs.size(), storedNlevs[0]);
+    ufo_geovals_subset_levels_f90(keyGVL_, nlevs.size(), nlevs[0], offsets[0]);
+  }
+  if (locs.npaths() > 0) {
+    std::vector<int> perPath(vars_.size(), 0);
+    for (const std::string & var : locs.perPathVariables())
+      if (vars_.has(var)) perPath[vars_.find(var)] = 1;
+    ufo_geovals_setup_paths_f90(keyGVL_, locs.npaths(), locs.pathOffsets()[0],
+                                locs.pathCentres()[0], perPath.size(), perPath[0]);
+    pathCentres_ = locs.pathCentres();
+  }
+  static const bool singlePrecision = std::getenv("UFO_GEOVALS_SINGLE_PRECISION") != nullptr;
+  if (singlePrecision) {
+    ufo_geovals_to_single_precision_f90(keyGVL_);
+    singlePrecision_ = true;
+  }
+  updateMemoryUsage();
   oops::Log::trace() << "GeoVaLs contructor key = " << keyGVL_ << std::endl;
 }
 
@@ -96,6 +219,7 @@ GeoVaLs::GeoVaLs(const Parameters_ & params,
     }
     ufo_geovals_read_file_f90(keyGVL_, params.toConfiguration(), obspace, vars_);
   }
+  updateMemoryUsage();
   oops::Log::trace() << "GeoVaLs contructor config key = " << keyGVL_ << std::endl;
 }
 // -----------------------------------------------------------------------------
@@ -108,20 +232,65 @@ GeoVaLs::GeoVaLs(const GeoVaLs & other, const int & index)
   : keyGVL_(-1), vars_(other.vars_), dist_(other.dist_)
 {
   oops::Log::trace() << "GeoVaLs copy one GeoVaLs constructor starting" << std::endl;
-  ufo_geovals_copy_one_f90(keyGVL_, other.keyGVL_, index);
+  ufo_geovals_copy_one_f90(keyGVL_, other.key(), index);
+  updateMemoryUsage();
   oops::Log::trace() << "GeoVaLs copy one GeoVaLs constructor key = " << keyGVL_ << std::endl;
 }
 // -----------------------------------------------------------------------------
+/*! \brief Constructor of zero GeoVaLs holding a subset of the variables of \p other
+ *
+ * \details Used instead of the copy constructor followed by zero() when only some variables
+ * are needed, so that the other (possibly large, multi-level) fields are neither allocated nor
+ * copied. All \p vars must be held by \p other.
+ */
+GeoVaLs::GeoVaLs(const GeoVaLs & other, const oops::Variables & vars)
+  : keyGVL_(-1), vars_(vars), dist_(other.dist_), pathCentres_(other.pathCentres_)
+{
+  oops::Log::trace() << "GeoVaLs zero subset constructor starting" << std::endl;
+  ufo_geovals_zero_subset_f90(other.key(), keyGVL_, vars_);
+  updateMemoryUsage();
+  oops::Log::trace() << "GeoVaLs zero subset constructor key = " << keyGVL_ << std::endl;
+}
+// -----------------------------------------------------------------------------
 /*! \brief Copy constructor */
 
 GeoVaLs::GeoVaLs(const GeoVaLs & other)
-  : keyGVL_(-1), vars_(other.vars_), dist_(other.dist_)
+  : keyGVL_(-1), vars_(other.vars_), dist_(other.dist_), pathCentres_(other.pathCentres_)
 {
   oops::Log::trace() << "GeoVaLs copy constructor starting" << std::endl;
-  ufo_geovals_copy_f90(other.keyGVL_, keyGVL_);
+  ufo_geovals_copy_f90(other.key(), keyGVL_);
+  updateMemoryUsage();
   oops::Log::trace() << "GeoVaLs copy constructor key = " << keyGVL_ << std::endl;
 }
 // -----------------------------------------------------------------------------
+const F90goms & GeoVaLs::key() const {
+  // The same GeoVaLs may be read concurrently (e.g. by the components of a composite operator or
+  // by threads processing chunks of locations), so only one thread converts the values and the
+  // others wait until it has finished.
+  if (singlePrecision_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(precisionMutex_);
+    if (singlePrecision_.load(std::memory_order_relaxed)) {
+      ufo_geovals_to_double_precision_f90(keyGVL_);
+      updateMemoryUsage();
+      singlePrecision_.store(false, std::memory_order_release);
+    }
+  }
+  return keyGVL_;
+}
+// -----------------------------------------------------------------------------
+void GeoVaLs::trackMemoryUsage(MemoryProfiler::Category category) const {
+  memoryUsage_.setCategory(category);
+  updateMemoryUsage();
+}
+// -----------------------------------------------------------------------------
+void GeoVaLs::updateMemoryUsage() const {
+  if (!MemoryProfiler::enabled())
+    return;
+  size_t nbytes = 0;
+  ufo_geovals_memory_bytes_f90(keyGVL_, nbytes);
+  memoryUsage_.update(dist_.get(), nbytes);
+}
+// -----------------------------------------------------------------------------
 /*? \brief Destructor */
 GeoVaLs::~GeoVaLs() {
   oops::Log::trace() << "GeoVaLs destructor starting" << std::endl;
@@ -132,21 +301,22 @@ GeoVaLs::~GeoVaLs() {
 void GeoVaLs::allocate(const int & nlevels, const oops::Variables & vars)
 {
   oops::Log::trace() << "GeoVaLs::allocate starting" << std::endl;
-  ufo_geovals_allocate_f90(keyGVL_, nlevels, vars);
+  ufo_geovals_allocate_f90(key(), nlevels, vars);
+  updateMemoryUsage();
   oops::Log::trace() << "GeoVaLs::allocate done" << std::endl;
 }
 // -----------------------------------------------------------------------------
 /*! \brief Zero out the GeoVaLs */
 void GeoVaLs::zero() {
   oops::Log::trace() << "GeoVaLs::zero starting" << std::endl;
-  ufo_geovals_zero_f90(keyGVL_);
+  ufo_geovals_zero_f90(key());
   oops::Log::trace() << "GeoVaLs::zero done" << std::endl;
 }
 // -----------------------------------------------------------------------------
 /*! \brief Reorder GeoVaLs in vertical dimension based on vertical coordinate variable */
 void GeoVaLs::reorderzdir(const std::string & varname, const std::string & vardir) {
   oops::Log::trace() << "GeoVaLs::reorderzdir starting" << std::endl;
-  ufo_geovals_reorderzdir_f90(keyGVL_, varname.size(), varname.c_str(),
+  ufo_geovals_reorderzdir_f90(key(), varname.size(), varname.c_str(),
                               vardir.size(), vardir.c_str());
   oops::Log::trace() << "GeoVaLs::reorderzdir done" << std::endl;
 }
@@ -154,18 +324,41 @@ void GeoVaLs::reorderzdir(const std::string & varname, const std::string & vardi
 /*! \brief Calculate rms */
 double GeoVaLs::rms() const {
   oops::Log::trace() << "GeoVaLs::rms starting" << std::endl;
-  double zz;
-  ufo_geovals_rms_f90(keyGVL_, zz);
+  double sumsq = 0.0;
+  size_t nvals = 0;
+  for (size_t jvar = 0; jvar < vars_.size(); ++jvar) {
+    const GeoVaLsView values = this->view(vars_[jvar]);
+    const size_t n = values.nlevs() * values.nlocs();
+    sumsq += sumOfSquares(values.data(), n);
+    nvals += n;
+  }
+  const double zz = nvals > 0 ? std::sqrt(sumsq / nvals) : 0.0;
   oops::Log::trace() << "GeoVaLs::rms done" << std::endl;
   return zz;
 }
 // -----------------------------------------------------------------------------
-/*! \brief Calculate normalized rms */
+/*! \brief Calculate normalized rms
+ *
+ * \details Each variable is normalized by the rms of the variable with the same index in
+ * \p other. The normalization is folded into the sums of squares, so that these GeoVaLs need
+ * not be copied.
+ */
 double GeoVaLs::normalizedrms(const GeoVaLs & other) const {
   oops::Log::trace() << "GeoVaLs::normalizerms starting" << std::endl;
-  GeoVaLs temp_gval(*this);
-  ufo_geovals_normalize_f90(temp_gval.keyGVL_, other.keyGVL_);
-  double zz = temp_gval.rms();
+  ASSERT(vars_.size() == other.vars_.size());
+  double sumsq = 0.0;
+  size_t nvals = 0;
+  for (size_t jvar = 0; jvar < vars_.size(); ++jvar) {
+    const GeoVaLsView values = this->view(vars_[jvar]);
+    const GeoVaLsView reference = other.view(other.vars_[jvar]);
+    const size_t nref = reference.nlevs() * reference.nlocs();
+    const double refsumsq = sumOfSquares(reference.data(), nref);
+    const size_t n = values.nlevs() * values.nlocs();
+    if (refsumsq > 0.0)
+      sumsq += sumOfSquares(values.data(), n) * (nref / refsumsq);
+    nvals += n;
+  }
+  const double zz = nvals > 0 ? std::sqrt(sumsq / nvals) : 0.0;
   oops::Log::trace() << "GeoVaLs::normalizerms done" << std::endl;
   return zz;
 }
@@ -173,14 +366,21 @@ double GeoVaLs::normalizedrms(const GeoVaLs & other) const {
 /*! \brief Randomize GeoVaLs */
 void GeoVaLs::random() {
   oops::Log::trace() << "GeoVaLs::random starting" << std::endl;
-  ufo_geovals_random_f90(keyGVL_);
+  ufo_geovals_random_f90(key());
   oops::Log::trace() << "GeoVaLs::random done" << std::endl;
 }
 // -----------------------------------------------------------------------------
 /*! \brief Multiply by a constant scalar */
 GeoVaLs & GeoVaLs::operator*=(const double zz) {
   oops::Log::trace() << "GeoVaLs::operator*= starting" << std::endl;
-  ufo_geovals_scalmult_f90(keyGVL_, zz);
+  for (size_t jvar = 0; jvar < vars_.size(); ++jvar) {
+    const GeoVaLsView values = this->view(vars_[jvar]);
+    const size_t n = values.nlevs() * values.nlocs();
+    double * x = this->data(vars_[jvar]);
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i)
+      x[i] *= zz;
+  }
   oops::Log::trace() << "GeoVaLs::operator*= done" << std::endl;
   return *this;
 }
@@ -189,10 +389,10 @@ GeoVaLs & GeoVaLs::operator*=(const double zz) {
 GeoVaLs & GeoVaLs::operator*=(const std::vector<float> & vals) {
   oops::Log::trace() << "GeoVaLs::operator*= starting" << std::endl;
   size_t nlocs;
-  ufo_geovals_nlocs_f90(keyGVL_, nlocs);
+  ufo_geovals_nlocs_f90(key(), nlocs);
   oops::Log::trace() << "vals, nlocs = " << vals.size() << "   " << nlocs << std::endl;
   ASSERT(vals.size() == nlocs);
-  ufo_geovals_profmult_f90(keyGVL_, nlocs, vals[0]);
+  ufo_geovals_profmult_f90(key(), nlocs, vals[0]);
   oops::Log::trace() << "GeoVaLs::operator*= done" << std::endl;
   return *this;
 }
@@ -200,15 +400,41 @@ GeoVaLs & GeoVaLs::operator*=(const std::vector<float> & vals) {
 /*! \brief Copy operator */
 GeoVaLs & GeoVaLs::operator=(const GeoVaLs & rhs) {
   oops::Log::trace() << "GeoVaLs::operator= starting" << std::endl;
-  ufo_geovals_assign_f90(keyGVL_, rhs.keyGVL_);
+  ufo_geovals_assign_f90(key(), rhs.key());
+  updateMemoryUsage();
   oops::Log::trace() << "GeoVaLs::operator= done" << std::endl;
   return *this;
 }
 // -----------------------------------------------------------------------------
+/*! \brief Combine each variable of these GeoVaLs with the same variable of \p other
+ *
+ * \details \p op is called with pointers to the values of both variables, which are stored
+ * contiguously, and their number. Variables missing from \p other are left unchanged.
+ */
+template <typename BinaryOp>
+void GeoVaLs::combineWith(const GeoVaLs & other, const char * opname, const BinaryOp & op) {
+  if (this->nlocs() != other.nlocs())
+    throw eckit::BadValue(std::string("GeoVaLs::") + opname +
+                          ": nlocs different between lhs and rhs", Here());
+  for (size_t jvar = 0; jvar < vars_.size(); ++jvar) {
+    if (!other.has(vars_[jvar])) continue;
+    const GeoVaLsView values = this->view(vars_[jvar]);
+    const GeoVaLsView other_values = other.view(vars_[jvar]);
+    if (values.nlevs() != other_values.nlevs())
+      throw eckit::BadValue(std::string("GeoVaLs::") + opname + ": nvals for var " +
+                            vars_[jvar] + " are different in lhs and rhs", Here());
+    op(this->data(vars_[jvar]), other_values.data(), values.nlevs() * values.nlocs());
+  }
+}
+// -----------------------------------------------------------------------------
 /*! \brief Add another GeoVaLs */
 GeoVaLs & GeoVaLs::operator+=(const GeoVaLs & other) {
   oops::Log::trace() << "GeoVaLs::operator+= starting" << std::endl;
-  ufo_geovals_add_f90(keyGVL_, other.keyGVL_);
+  combineWith(other, "operator+=", [](double * x, const double * y, size_t n) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i)
+      x[i] += y[i];
+  });
   oops::Log::trace() << "GeoVaLs::operator+= done" << std::endl;
   return *this;
 }
@@ -216,7 +442,11 @@ GeoVaLs & GeoVaLs::operator+=(const GeoVaLs & other) {
 /*! \brief Subtract another GeoVaLs */
 GeoVaLs & GeoVaLs::operator-=(const GeoVaLs & other) {
   oops::Log::trace() << "GeoVaLs::operator-= starting" << std::endl;
-  ufo_geovals_diff_f90(keyGVL_, other.keyGVL_);
+  combineWith(other, "operator-=", [](double * x, const double * y, size_t n) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i)
+      x[i] -= y[i];
+  });
   oops::Log::trace() << "GeoVaLs::operator-= done" << std::endl;
   return *this;
 }
@@ -224,45 +454,141 @@ GeoVaLs & GeoVaLs::operator-=(const GeoVaLs & other) {
 /*! \brief Multiply another GeoVaLs */
 GeoVaLs & GeoVaLs::operator*=(const GeoVaLs & other) {
   oops::Log::trace() << "GeoVaLs::operator*= starting" << std::endl;
-  ufo_geovals_schurmult_f90(keyGVL_, other.keyGVL_);
+  combineWith(other, "operator*=", [](double * x, const double * y, size_t n) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i)
+      x[i] *= y[i];
+  });
   oops::Log::trace() << "GeoVaLs::operator*= done" << std::endl;
   return *this;
 }
 // -----------------------------------------------------------------------------
+/*! \brief Add a multiple of another GeoVaLs */
+void GeoVaLs::axpy(const double zz, const GeoVaLs & other) {
+  oops::Log::trace() << "GeoVaLs::axpy starting" << std::endl;
+  combineWith(other, "axpy", [zz](double * x, const double * y, size_t n) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i)
+      x[i] += zz * y[i];
+  });
+  oops::Log::trace() << "GeoVaLs::axpy done" << std::endl;
+}
+// -----------------------------------------------------------------------------
 /*! \brief Scalar product of two GeoVaLs */
 double GeoVaLs::dot_product_with(const GeoVaLs & other) const {
   oops::Log::trace() << "GeoVaLs::dot_product_with starting" << std::endl;
   const size_t nlocs = this->nlocs();
-  assert(nlocs == other.nlocs());
-  assert(vars_ == other.vars_);
-  auto accumulator = dist_->createAccumulator<double>();
-  std::vector<double> this_values(nlocs), other_values(nlocs);
+  ASSERT(nlocs == other.nlocs());
+  ASSERT(vars_ == other.vars_);
+  // all variables contribute to the same accumulator, reduced across tasks only once
+  std::unique_ptr<ioda::Accumulator<double>> accumulator;
+  std::unique_ptr<ReproducibleAccumulator> exact;
+  if (reproducibleReductions())
+    exact.reset(new ReproducibleAccumulator(*dist_, nlocs, 1));
+  else
+    accumulator = dist_->createAccumulator<double>();
   const double missing = util::missingValue(missing);
-  // loop over all variables in geovals
   for (size_t jvar = 0; jvar < vars_.size(); ++jvar) {
-    const size_t nlevs = this->nlevs(vars_[jvar]);
-    assert(nlevs == other.nlevs(vars_[jvar]));
-    // loop over all levels for this variable
-    for (size_t jlev = 0; jlev < nlevs; ++jlev) {
-      this->getAtLevel(this_values, vars_[jvar], jlev);
-      other.getAtLevel(other_values, vars_[jvar], jlev);
-      // loop over all locations
-      for (size_t jloc = 0; jloc < nlocs; ++jloc) {
-        if ((this_values[jloc] != missing) && (other_values[jloc] != missing)) {
-          accumulator->addTerm(jloc, this_values[jloc]*other_values[jloc]);
-        }
-      }
-    }
+    const GeoVaLsView this_values = this->view(vars_[jvar]);
+    const GeoVaLsView other_values = other.view(vars_[jvar]);
+    ASSERT(this_values.nlevs() == other_values.nlevs());
+    // variables stored once per observation path are attributed to the path centres
+    const bool perPath = this_values.nlocs() != nlocs;
+    dotProductByLocation(this_values, other_values, missing, [&](size_t jloc, double term) {
+      const size_t loc = perPath ? pathCentres_[jloc] : jloc;
+      if (exact)
+        exact->addTerm(loc, 0, term);
+      else
+        accumulator->addTerm(loc, term);
+    });
   }
-  const double dotprod = accumulator->computeResult();
+  const double dotprod = exact ? exact->computeResult()[0] : accumulator->computeResult();
   oops::Log::trace() << "GeoVaLs::dot_product_with done" << std::endl;
   return dotprod;
 }
 // -----------------------------------------------------------------------------
+/*! \brief Scalar products of the individual variables of two GeoVaLs */
+std::vector<double> GeoVaLs::dot_products_with(const GeoVaLs & other) const {
+  oops::Log::trace() << "GeoVaLs::dot_products_with starting" << std::endl;
+  const size_t nlocs = this->nlocs();
+  ASSERT(nlocs == other.nlocs());
+  ASSERT(vars_ == other.vars_);
+  // one accumulator entry per variable, all reduced across tasks in a single collective
+  std::unique_ptr<ioda::Accumulator<std::vector<double>>> accumulator;
+  std::unique_ptr<ReproducibleAccumulator> exact;
+  if (reproducibleReductions())
+    exact.reset(new ReproducibleAccumulator(*dist_, nlocs, vars_.size()));
+  else
+    accumulator = dist_->createAccumulator<double>(vars_.size());
+  const double missing = util::missingValue(missing);
+  for (size_t jvar = 0; jvar < vars_.size(); ++jvar) {
+    const GeoVaLsView this_values = this->view(vars_[jvar]);
+    const GeoVaLsView other_values = other.view(vars_[jvar]);
+    ASSERT(this_values.nlevs() == other_values.nlevs());
+    const bool perPath = this_values.nlocs() != nlocs;
+    dotProductByLocation(this_values, other_values, missing, [&](size_t jloc, double term) {
+      const size_t loc = perPath ? pathCentres_[jloc] : jloc;
+      if (exact)
+        exact->addTerm(loc, jvar, term);
+      else
+        accumulator->addTerm(loc, jvar, term);
+    });
+  }
+  const std::vector<double> dotprods = exact ? exact->computeResult()
+                                             : accumulator->computeResult();
+  oops::Log::trace() << "GeoVaLs::dot_products_with done" << std::endl;
+  return dotprods;
+}
+// -----------------------------------------------------------------------------
+/*! \brief Add a multiple of another GeoVaLs, then return the scalar product with a third one
+ *
+ * \details Same as axpy(zz, inc) followed by dot_product_with(other), but each location is
+ * updated and multiplied while its values are still in cache.
+ */
+double GeoVaLs::axpy_dot_product_with(const double zz, const GeoVaLs & inc,
+                                      const GeoVaLs & other) {
+  oops::Log::trace() << "GeoVaLs::axpy_dot_product_with starting" << std::endl;
+  const size_t nlocs = this->nlocs();
+  ASSERT(nlocs == inc.nlocs());
+  ASSERT(nlocs == other.nlocs());
+  ASSERT(vars_ == other.vars_);
+  std::unique_ptr<ioda::Accumulator<double>> accumulator;
+  std::unique_ptr<ReproducibleAccumulator> exact;
+  if (reproducibleReductions())
+    exact.reset(new ReproducibleAccumulator(*dist_, nlocs, 1));
+  else
+    accumulator = dist_->createAccumulator<double>();
+  const double missing = util::missingValue(missing);
+  for (size_t jvar = 0; jvar < vars_.size(); ++jvar) {
+    const GeoVaLsView this_values = this->view(vars_[jvar]);
+    const GeoVaLsView other_values = other.view(vars_[jvar]);
+    ASSERT(this_values.nlevs() == other_values.nlevs());
+    const bool perPath = this_values.nlocs() != nlocs;
+    // variables missing from inc are left unchanged, as in axpy()
+    GeoVaLsView inc_values;
+    if (inc.has(vars_[jvar])) {
+      inc_values = inc.view(vars_[jvar]);
+      ASSERT(inc_values.nlevs() == this_values.nlevs());
+    }
+    dotProductByLocation(this_values, other_values, missing, [&](size_t jloc, double term) {
+      const size_t loc = perPath ? pathCentres_[jloc] : jloc;
+      if (exact)
+        exact->addTerm(loc, 0, term);
+      else
+        accumulator->addTerm(loc, term);
+    }, inc_values.empty() ? nullptr : this->data(vars_[jvar]), inc_values.data(), zz);
+  }
+  const double dotprod = exact ? exact->computeResult()[0] : accumulator->computeResult();
+  oops::Log::trace() << "GeoVaLs::axpy_dot_product_with done" << std::endl;
+  return dotprod;
+}
+// -----------------------------------------------------------------------------
 /*! \brief Split two GeoVaLs */
 void GeoVaLs::split(GeoVaLs & other1, GeoVaLs & other2) const {
   oops::Log::trace() << "GeoVaLs::split GeoVaLs into 2" << std::endl;
-  ufo_geovals_split_f90(keyGVL_, other1.keyGVL_, other2.keyGVL_);
+  ufo_geovals_split_f90(key(), other1.key(), other2.key());
+  other1.updateMemoryUsage();
+  other2.updateMemoryUsage();
   oops::Log::trace() << "GeoVaLs::split GeoVaLs into 2" << std::endl;
   return;
 }
@@ -270,11 +596,34 @@ void GeoVaLs::split(GeoVaLs & other1, GeoVaLs & other2) const {
 /*! \brief Merge two GeoVaLs */
 void GeoVaLs::merge(const GeoVaLs & other1, const GeoVaLs & other2) {
   oops::Log::trace() << "GeoVaLs::merge 2 GeoVaLs" << std::endl;
-  ufo_geovals_merge_f90(keyGVL_, other1.keyGVL_, other2.keyGVL_);
+  ufo_geovals_merge_f90(key(), other1.key(), other2.key());
+  updateMemoryUsage();
   oops::Log::trace() << "GeoVaLs::merge 2 GeoVaLs" << std::endl;
   return;
 }
 // -----------------------------------------------------------------------------
+/*! \brief Add the time slots of GeoVaLs with location-dependent weights */
+void GeoVaLs::timeSlotsWeightedSum(GeoVaLs & other, const std::vector<float> & weights,
+                                   size_t nslots) const {
+  oops::Log::trace() << "GeoVaLs::timeSlotsWeightedSum starting" << std::endl;
+  ASSERT(nslots > 0 && weights.size() % nslots == 0);
+  const int nlocs = weights.size() / nslots;
+  const int nslotsInt = nslots;
+  ufo_geovals_time_slots_weighted_sum_f90(key(), other.key(), nlocs, nslotsInt, weights[0]);
+  oops::Log::trace() << "GeoVaLs::timeSlotsWeightedSum done" << std::endl;
+}
+// -----------------------------------------------------------------------------
+/*! \brief Copy GeoVaLs into each time slot with location-dependent weights */
+void GeoVaLs::timeSlotsWeightedMerge(const GeoVaLs & other, const std::vector<float> & weights,
+                                     size_t nslots) {
+  oops::Log::trace() << "GeoVaLs::timeSlotsWeightedMerge starting" << std::endl;
+  ASSERT(nslots > 0 && weights.size() % nslots == 0);
+  const int nlocs = weights.size() / nslots;
+  const int nslotsInt = nslots;
+  ufo_geovals_time_slots_weighted_merge_f90(key(), other.key(), nlocs, nslotsInt, weights[0]);
+  oops::Log::trace() << "GeoVaLs::timeSlotsWeightedMerge done" << std::endl;
+}
+// -----------------------------------------------------------------------------
 /*! \brief Output GeoVaLs to a stream */
 void GeoVaLs::print(std::ostream & os) const {
   int nn;
@@ -283,7 +632,7 @@ void GeoVaLs::print(std::ostream & os) const {
   os << "GeoVaLs: variables = " << vars_ << std::endl;
   for (size_t jv = 0; jv < vars_.size(); ++jv) {
     int nv = jv;
-    ufo_geovals_minmaxavg_f90(keyGVL_, nn, nv, zmin, zmax, zrms);
+    ufo_geovals_minmaxavg_f90(key(), nn, nv, zmin, zmax, zrms);
     os << "GeoVaLs: nobs= " << nn << " " << vars_[jv] << " Min=" << zmin << ", Max=" << zmax
        << ", RMS=" << zrms << std::endl;
   }
@@ -301,7 +650,7 @@ void GeoVaLs::print(std::ostream & os) const {
     double mxval;
     int ivar, iobs;
 
-    ufo_geovals_maxloc_f90(keyGVL_, mxval, iobs, ivar);
+    ufo_geovals_maxloc_f90(key(), mxval, iobs, ivar);
 
     oops::Log::debug() << "GeoVaLs: Maximum Value (vertical rms) = "
                        << std::setprecision(4)
@@ -333,10 +682,9 @@ void GeoVaLs::get(std::vector<float> & vals, const std::string & var) const {
 /*! \brief Return all values for a specific variable and level */
 void GeoVaLs::getAtLevel(std::vector<double> & vals, const std::string & var, const int lev) const {
   oops::Log::trace() << "GeoVaLs::getAtLevel(double) starting" << std::endl;
-  size_t nlocs;
-  ufo_geovals_nlocs_f90(keyGVL_, nlocs);
+  const size_t nlocs = this->nlocs(var);
   ASSERT(vals.size() == nlocs);
-  ufo_geovals_getdouble_f90(keyGVL_, var.size(), var.c_str(), lev, nlocs, vals[0]);
+  ufo_geovals_getdouble_f90(key(), var.size(), var.c_str(), lev, nlocs, vals[0]);
   oops::Log::trace() << "GeoVaLs::getAtLevel(double) done" << std::endl;
 }
 // -----------------------------------------------------------------------------
@@ -361,10 +709,9 @@ void GeoVaLs::getAtLevel(std::vector<int> & vals, const std::string & var, const
 /*! \brief Return all values for a specific 2D variable */
 void GeoVaLs::get(std::vector<double> & vals, const std::string & var) const {
   oops::Log::trace() << "GeoVaLs::get 2D starting" << std::endl;
-  size_t nlocs;
-  ufo_geovals_nlocs_f90(keyGVL_, nlocs);
+  const size_t nlocs = this->nlocs(var);
   ASSERT(vals.size() == nlocs);
-  ufo_geovals_get2d_f90(keyGVL_, var.size(), var.c_str(), nlocs, vals[0]);
+  ufo_geovals_get2d_f90(key(), var.size(), var.c_str(), nlocs, vals[0]);
   oops::Log::trace() << "GeoVaLs::get 2D(double) done" << std::endl;
 }
 // -----------------------------------------------------------------------------
@@ -386,8 +733,8 @@ void GeoVaLs::getAtLocation(std::vector<double> & vals,
   oops::Log::trace() << "GeoVaLs::getAtLocation(double) starting" << std::endl;
   const size_t nlevs = this->nlevs(var);
   ASSERT(vals.size() == nlevs);
-  ASSERT(loc >= 0 && loc < this->nlocs());
-  ufo_geovals_get_loc_f90(keyGVL_, var.size(), var.c_str(), loc, nlevs, vals[0]);
+  ASSERT(loc >= 0 && loc < this->nlocs(var));
+  ufo_geovals_get_loc_f90(key(), var.size(), var.c_str(), loc, nlevs, vals[0]);
   oops::Log::trace() << "GeoVaLs::getAtLocation(double) done" << std::endl;
 }
 // -----------------------------------------------------------------------------
@@ -413,15 +760,50 @@ void GeoVaLs::getAtLocation(std::vector<int> & vals,
   oops::Log::trace() << "GeoVaLs::getAtLocation(int) done" << std::endl;
 }
 // -----------------------------------------------------------------------------
+/*! \brief Return a read-only view of all values of a specific variable
+ *
+ * \details No data are copied; the view points to the storage held by the Fortran GeoVaLs.
+ */
+GeoVaLsView GeoVaLs::view(const std::string & var) const {
+  oops::Log::trace() << "GeoVaLs::view starting" << std::endl;
+  const double * data = nullptr;
+  int nlevs = 0;
+  int nlocs = 0;
+  ufo_geovals_get_ptr_f90(key(), var.size(), var.c_str(), nlevs, nlocs, data);
+  oops::Log::trace() << "GeoVaLs::view done" << std::endl;
+  return GeoVaLsView(data, nlevs, nlocs);
+}
+// -----------------------------------------------------------------------------
+/*! \brief Return a pointer to the values of a variable, which may be modified in place */
+double * GeoVaLs::data(const std::string & var) {
+  const double * data = nullptr;
+  int nlevs = 0;
+  int nlocs = 0;
+  ufo_geovals_get_ptr_f90(key(), var.size(), var.c_str(), nlevs, nlocs, data);
+  // The Fortran storage is not itself constant; it is only exposed as such by view().
+  return const_cast<double *>(data);
+}
+// -----------------------------------------------------------------------------
+/*! \brief Return the values of several variables packed into a single array */
+void GeoVaLs::getPacked(std::vector<double> & vals, const oops::Variables & vars) const {
+  oops::Log::trace() << "GeoVaLs::getPacked starting" << std::endl;
+  size_t nlocs;
+  ufo_geovals_nlocs_f90(key(), nlocs);
+  const size_t nlevs = vars.size() > 0 ? this->nlevs(vars[0]) : 0;
+  vals.resize(vars.size() * nlevs * nlocs);
+  const int nvals = vals.size();
+  ufo_geovals_get_packed_f90(key(), vars, nvals, vals.data());
+  oops::Log::trace() << "GeoVaLs::getPacked done" << std::endl;
+}
+// -----------------------------------------------------------------------------
 /*! \brief Put double values for a specific variable and level */
 void GeoVaLs::putAtLevel(const std::vector<double> & vals,
                          const std::string & var,
                          const int lev) const {
   oops::Log::trace() << "GeoVaLs::putAtLevel(double) starting" << std::endl;
-  size_t nlocs;
-  ufo_geovals_nlocs_f90(keyGVL_, nlocs);
+  const size_t nlocs = this->nlocs(var);
   ASSERT(vals.size() == nlocs);
-  ufo_geovals_putdouble_f90(keyGVL_, var.size(), var.c_str(), lev, nlocs, vals[0]);
+  ufo_geovals_putdouble_f90(key(), var.size(), var.c_str(), lev, nlocs, vals[0]);
   oops::Log::trace() << "GeoVaLs::putAtLevel(double) done" << std::endl;
 }
 // -----------------------------------------------------------------------------
@@ -430,11 +812,10 @@ void GeoVaLs::putAtLevel(const std::vector<float> & vals,
                          const std::string & var,
                          const int lev) const {
   oops::Log::trace() << "GeoVaLs::putAtLevel(float) starting" << std::endl;
-  size_t nlocs;
-  ufo_geovals_nlocs_f90(keyGVL_, nlocs);
+  const size_t nlocs = this->nlocs(var);
   ASSERT(vals.size() == nlocs);
   std::vector<double> doubleVals(vals.begin(), vals.end());
-  ufo_geovals_putdouble_f90(keyGVL_, var.size(), var.c_str(), lev, nlocs, doubleVals[0]);
+  ufo_geovals_putdouble_f90(key(), var.size(), var.c_str(), lev, nlocs, doubleVals[0]);
   oops::Log::trace() << "GeoVaLs::putAtLevel(float) done" << std::endl;
 }
 // -----------------------------------------------------------------------------
@@ -443,11 +824,10 @@ void GeoVaLs::putAtLevel(const std::vector<int> & vals,
                          const std::string & var,
                          const int lev) const {
   oops::Log::trace() << "GeoVaLs::putAtLevel(int) starting" << std::endl;
-  size_t nlocs;
-  ufo_geovals_nlocs_f90(keyGVL_, nlocs);
+  const size_t nlocs = this->nlocs(var);
   ASSERT(vals.size() == nlocs);
   std::vector<double> doubleVals(vals.begin(), vals.end());
-  ufo_geovals_putdouble_f90(keyGVL_, var.size(), var.c_str(), lev, nlocs, doubleVals[0]);
+  ufo_geovals_putdouble_f90(key(), var.size(), var.c_str(), lev, nlocs, doubleVals[0]);
   oops::Log::trace() << "GeoVaLs::putAtLevel(int) done" << std::endl;
 }
 /*! \brief Put double values for a specific variable and location */
@@ -457,8 +837,8 @@ void GeoVaLs::putAtLocation(const std::vector<double> & vals,
   oops::Log::trace() << "GeoVaLs::putAtLocation(double) starting" << std::endl;
   const size_t nlevs = this->nlevs(var);
   ASSERT(vals.size() == nlevs);
-  ASSERT(loc >= 0 && loc < this->nlocs());
-  ufo_geovals_put_loc_f90(keyGVL_, var.size(), var.c_str(), loc, nlevs, vals[0]);
+  ASSERT(loc >= 0 && loc < this->nlocs(var));
+  ufo_geovals_put_loc_f90(key(), var.size(), var.c_str(), loc, nlevs, vals[0]);
   oops::Log::trace() << "GeoVaLs::putAtLocation(double) done" << std::endl;
 }
 /*! \brief Put float values for a specific variable and location */
@@ -468,9 +848,9 @@ void GeoVaLs::putAtLocation(const std::vector<float> & vals,
   oops::Log::trace() << "GeoVaLs::putAtLocation(float) starting" << std::endl;
   const size_t nlevs = this->nlevs(var);
   ASSERT(vals.size() == nlevs);
-  ASSERT(loc >= 0 && loc < this->nlocs());
+  ASSERT(loc >= 0 && loc < this->nlocs(var));
   std::vector<double> doubleVals(vals.begin(), vals.end());
-  ufo_geovals_put_loc_f90(keyGVL_, var.size(), var.c_str(), loc, nlevs, doubleVals[0]);
+  ufo_geovals_put_loc_f90(key(), var.size(), var.c_str(), loc, nlevs, doubleVals[0]);
   oops::Log::trace() << "GeoVaLs::putAtLocation(float) done" << std::endl;
 }
 /*! \brief Put int values for a specific variable and location */
@@ -480,9 +860,9 @@ void GeoVaLs::putAtLocation(const std::vector<int> & vals,
   oops::Log::trace() << "GeoVaLs::putAtLocation(int) starting" << std::endl;
   const size_t nlevs = this->nlevs(var);
   ASSERT(vals.size() == nlevs);
-  ASSERT(loc >= 0 && loc < this->nlocs());
+  ASSERT(loc >= 0 && loc < this->nlocs(var));
   std::vector<double> doubleVals(vals.begin(), vals.end());
-  ufo_geovals_put_loc_f90(keyGVL_, var.size(), var.c_str(), loc, nlevs, doubleVals[0]);
+  ufo_geovals_put_loc_f90(key(), var.size(), var.c_str(), loc, nlevs, doubleVals[0]);
   oops::Log::trace() << "GeoVaLs::putAtLocation(int) done" << std::endl;
 }
 // -----------------------------------------------------------------------------
@@ -509,11 +889,37 @@ void GeoVaLs::fillAD(const std::vector<size_t> & indx,
   std::vector<int> findx(indx.size());
   for (size_t jj = 0; jj < indx.size(); ++jj) findx[jj] = indx[jj];
 
-  ufo_geovals_fillad_f90(keyGVL_, npts, findx[0], nvals, vals[0], levelsTopDown);
+  ufo_geovals_fillad_f90(key(), npts, findx[0], nvals, vals[0], levelsTopDown);
 
   oops::Log::trace() << "GeoVaLs::fillAD done" << std::endl;
 }
 // -----------------------------------------------------------------------------
+void GeoVaLs::fillLocationMajor(const std::vector<size_t> & indx,
+                                const std::vector<double> & vals,
+                                const bool levelsTopDown) {
+  oops::Log::trace() << "GeoVaLs::fillLocationMajor starting" << std::endl;
+  const size_t npts = indx.size();
+  const size_t nvals = vals.size();
+  std::vector<int> findx(indx.begin(), indx.end());
+
+  ufo_geovals_fill_locmajor_f90(keyGVL_, npts, findx[0], nvals, vals[0], levelsTopDown);
+
+  oops::Log::trace() << "GeoVaLs::fillLocationMajor done" << std::endl;
+}
+// -----------------------------------------------------------------------------
+void GeoVaLs::fillADLocationMajor(const std::vector<size_t> & indx,
+                                  std::vector<double> & vals,
+                                  const bool levelsTopDown) const {
+  oops::Log::trace() << "GeoVaLs::fillADLocationMajor starting" << std::endl;
+  const size_t npts = indx.size();
+  const size_t nvals = vals.size();
+  std::vector<int> findx(indx.begin(), indx.end());
+
+  ufo_geovals_fillad_locmajor_f90(key(), npts, findx[0], nvals, vals[0], levelsTopDown);
+
+  oops::Log::trace() << "GeoVaLs::fillADLocationMajor done" << std::endl;
+}
+// -----------------------------------------------------------------------------
 /*! \brief Read GeoVaLs from the file */
 void GeoVaLs::read(const Parameters_ & params,
                    const ioda::ObsSpace & obspace) {
@@ -521,7 +927,8 @@ void GeoVaLs::read(const Parameters_ & params,
   if (params.filename.value() == boost::none) {
     throw eckit::UserError("geovals requires 'filename' section", Here());
   }
-  ufo_geovals_read_file_f90(keyGVL_, params.toConfiguration(), obspace, vars_);
+  ufo_geovals_read_file_f90(key(), params.toConfiguration(), obspace, vars_);
+  updateMemoryUsage();
   oops::Log::trace() << "GeoVaLs::read done" << std::endl;
 }
 // -----------------------------------------------------------------------------
@@ -531,11 +938,33 @@ void GeoVaLs::write(const Parameters_ & params) const {
   if (params.filename.value() == boost::none) {
     throw eckit::UserError("geovals requires 'filename' section", Here());
   }
-  ufo_geovals_write_file_f90(keyGVL_, params.toConfiguration(), dist_->rank());
+  ufo_geovals_write_file_f90(key(), params.toConfiguration(), dist_->rank());
   oops::Log::trace() << "GeoVaLs::write done" << std::endl;
 }
 // -----------------------------------------------------------------------------
+std::future<void> GeoVaLs::writeInBackground(const Parameters_ & params) const {
+  oops::Log::trace() << "GeoVaLs::writeInBackground starting" << std::endl;
+  if (params.filename.value() == boost::none) {
+    throw eckit::UserError("geovals requires 'filename' section", Here());
+  }
+  // The registry of Fortran GeoVaLs objects may be modified by the calling thread while the
+  // file is written, so it is only accessed here.
+  void * self = nullptr;
+  ufo_geovals_c_ptr_f90(key(), self);
+  const eckit::LocalConfiguration conf = params.toConfiguration();
+  const size_t rank = dist_->rank();
+  std::future<void> done = BackgroundTaskQueue::ioQueue().push([self, conf, rank] {
+      ufo_geovals_write_file_ptr_f90(self, conf, rank);
+    });
+  oops::Log::trace() << "GeoVaLs::writeInBackground done" << std::endl;
+  return done;
+}
+// -----------------------------------------------------------------------------
 /*! \brief Return the number of geovals */
+size_t GeoVaLs::nlocs(const std::string & var) const {
+  return this->view(var).nlocs();
+}
+// -----------------------------------------------------------------------------
 size_t GeoVaLs::nlocs() const {
   oops::Log::trace() << "GeoVaLs::nlocs starting" << std::endl;
   size_t nlocs;
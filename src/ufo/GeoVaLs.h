@@ -9,7 +9,10 @@
 #define UFO_GEOVALS_H_
 
 #include <algorithm>
+#include <atomic>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -23,6 +26,7 @@
 #include "oops/util/Printable.h"
 
 #include "ufo/Fortran.h"
+#include "ufo/MemoryProfiler.h"
 
 namespace ioda {
   class ObsSpace;
@@ -45,6 +49,59 @@ class GeoVaLsParameters : public oops::Parameters {
   /// a single location in the obs file. There needs to be at least
   /// loc_multiplier * obs_all_nlocs locations in the geovals file.
   oops::Parameter<int> loc_multiplier{"loc_multiplier", 1, this};
+  /// Compression level (0-9) of the variables written to the file; 0 disables compression.
+  oops::Parameter<int> deflate_level{"deflate_level", 0, this};
+  /// Number of locations per chunk of the variables written to the file (each chunk spans all
+  /// levels). If not positive, the variables are chunked only if they are compressed, and the
+  /// chunk sizes are chosen by the NetCDF library.
+  oops::Parameter<int> chunk_nlocs{"chunk_nlocs", 0, this};
+};
+
+// -----------------------------------------------------------------------------
+
+/// \brief Read-only, non-owning view of the GeoVaLs of a single variable.
+///
+/// \details The values are stored in Fortran order, i.e. all levels of the first location
+/// are followed by all levels of the second location and so on. The view gives direct access
+/// to that storage without copying it into a std::vector. It becomes invalid if the GeoVaLs it
+/// was obtained from are destroyed or the variable is (re)allocated.
+class GeoVaLsView {
+ public:
+  GeoVaLsView() = default;
+  GeoVaLsView(const double * data, size_t nlevs, size_t nlocs)
+    : data_(data), nlevs_(nlevs), nlocs_(nlocs) {}
+
+  size_t nlevs() const {return nlevs_;}
+  size_t nlocs() const {return nlocs_;}
+  bool empty() const {return data_ == nullptr || nlevs_ * nlocs_ == 0;}
+
+  /// Distance (in elements) between consecutive levels at the same location.
+  size_t levelStride() const {return 1;}
+  /// Distance (in elements) between consecutive locations on the same level.
+  size_t locationStride() const {return nlevs_;}
+
+  /// Value at location \p loc and level \p lev.
+  double operator()(size_t loc, size_t lev) const {
+    return data_[loc * locationStride() + lev * levelStride()];
+  }
+
+  /// Pointer to the first of nlevs() contiguous values at location \p loc.
+  const double * atLocation(size_t loc) const {return data_ + loc * locationStride();}
+  /// View of the \p count locations starting at \p begin, e.g. one time slot of GeoVaLs
+  /// concatenating several of them. No data are copied.
+  GeoVaLsView locations(size_t begin, size_t count) const {
+    return GeoVaLsView(atLocation(begin), nlevs_, count);
+  }
+  /// Pointer to the first of nlocs() values on level \p lev; consecutive values are
+  /// locationStride() elements apart.
+  const double * atLevel(size_t lev) const {return data_ + lev * levelStride();}
+
+  const double * data() const {return data_;}
+
+ private:
+  const double * data_ = nullptr;
+  size_t nlevs_ = 0;
+  size_t nlocs_ = 0;
 };
 
 // -----------------------------------------------------------------------------
@@ -68,6 +125,9 @@ class GeoVaLs : public util::Printable,
   GeoVaLs(const Parameters_ &, const ioda::ObsSpace &, const oops::Variables &);
 
   GeoVaLs(const GeoVaLs &, const int &);
+  /// Zero GeoVaLs holding only the variables \p vars of \p other, with the same locations and
+  /// numbers of levels. The values of \p other are not copied.
+  GeoVaLs(const GeoVaLs & other, const oops::Variables & vars);
   GeoVaLs(const GeoVaLs &);
 
   ~GeoVaLs();
@@ -79,8 +139,29 @@ class GeoVaLs : public util::Printable,
   GeoVaLs & operator -= (const GeoVaLs &);
   GeoVaLs & operator *= (const GeoVaLs &);
   double dot_product_with(const GeoVaLs &) const;
+  /// Scalar products of each variable with the same variable of \p other, in the order of
+  /// getVars(). All of them are reduced across tasks in a single collective operation.
+  std::vector<double> dot_products_with(const GeoVaLs & other) const;
+  /// Add \p zz times \p other to these GeoVaLs. Variables missing from \p other are unchanged.
+  void axpy(const double zz, const GeoVaLs & other);
+  /// Same as axpy(zz, inc) followed by dot_product_with(other), in a single pass over the values.
+  double axpy_dot_product_with(const double zz, const GeoVaLs & inc, const GeoVaLs & other);
   void split(GeoVaLs &, GeoVaLs &) const;
   void merge(const GeoVaLs &, const GeoVaLs &);
+  /// \brief Set \p other to the sum of the \p nslots time slots of these GeoVaLs weighted by
+  /// \p weights.
+  ///
+  /// These GeoVaLs hold one block of locations per time slot: the GeoVaLs of location \c jloc
+  /// in slot \c jslot are stored at location jslot * nlocs + jloc, where nlocs = weights.size() /
+  /// nslots is the number of locations of \p other, and their weight is
+  /// weights[jslot * nlocs + jloc]. With two slots this is the same as split() followed by two
+  /// multiplications and an addition.
+  void timeSlotsWeightedSum(GeoVaLs & other, const std::vector<float> & weights,
+                            size_t nslots) const;
+  /// Adjoint of timeSlotsWeightedSum(): set time slot \c jslot of these GeoVaLs to \p other
+  /// multiplied by the weights of that slot.
+  void timeSlotsWeightedMerge(const GeoVaLs & other, const std::vector<float> & weights,
+                              size_t nslots);
 
   /// \brief Deprecated method. Allocates GeoVaLs for \p vars variables with
   /// \p nlev number of levels
@@ -126,6 +207,19 @@ class GeoVaLs : public util::Printable,
   /// Get GeoVaLs at a specified location and convert to int
   void getAtLocation(std::vector<int> &, const std::string &, const int) const;
 
+  /// Get a read-only view of the GeoVaLs of variable \p var without copying them.
+  /// Returns an empty view if the variable has not been allocated.
+  GeoVaLsView view(const std::string & var) const;
+  /// Get a pointer to the values of variable \p var, stored in the order described in
+  /// GeoVaLsView, so that they can be modified in place. Returns a null pointer if the variable
+  /// has not been allocated.
+  double * data(const std::string & var);
+
+  /// Get the GeoVaLs of all variables \p vars, which must have the same number of levels, packed
+  /// into one array; the value of variable \c ivar at level \c lev and location \c loc is stored
+  /// in element ivar + nvars * (lev + nlevs * loc). \p vals is resized as necessary.
+  void getPacked(std::vector<double> & vals, const oops::Variables & vars) const;
+
   /// Put GeoVaLs for double variable \p var at level \p lev.
   void putAtLevel(const std::vector<double> & vals, const std::string & var, const int lev) const;
   /// Put GeoVaLs for float variable \p var at level \p lev.
@@ -143,16 +237,54 @@ class GeoVaLs : public util::Printable,
 
   void read(const Parameters_ &, const ioda::ObsSpace &);
   void write(const Parameters_ &) const;
+  /// \brief Write the GeoVaLs to a file on a background thread.
+  ///
+  /// \details The GeoVaLs must not be modified or destroyed until the returned future is ready.
+  /// Files are written one at a time, in the order in which this function was called.
+  std::future<void> writeInBackground(const Parameters_ &) const;
   size_t nlocs() const;
-
+  /// \brief Number of locations at which variable \p var is stored.
+  ///
+  /// This is nlocs(), unless the GeoVaLs were constructed for Locations sampling observation
+  /// paths and \p var is one of Locations::perPathVariables(); then it is the number of paths.
+  /// The get, put and view methods index such variables by path instead of location.
+  size_t nlocs(const std::string & var) const;
+
+  /// \brief Fill the GeoVaLs at locations \p indx with the values \p vals, which hold all
+  /// locations of the first level of the first variable, then all locations of the second level
+  /// and so on (level-major order).
   void fill(const std::vector<size_t> &, const std::vector<double> &, const bool);
+  /// \brief Adjoint of fill().
   void fillAD(const std::vector<size_t> &, std::vector<double> &, const bool) const;
-
-  int & toFortran() {return keyGVL_;}
-  const int & toFortran() const {return keyGVL_;}
+  /// \brief Same as fill(), but \p vals hold all levels of the first location of the first
+  /// variable, then all levels of the second location and so on (location-major order).
+  ///
+  /// This is the order in which the GeoVaLs are stored, so callers holding their values in this
+  /// order can skip the repacking needed by fill().
+  void fillLocationMajor(const std::vector<size_t> &, const std::vector<double> &, const bool);
+  /// \brief Adjoint of fillLocationMajor().
+  void fillADLocationMajor(const std::vector<size_t> &, std::vector<double> &, const bool) const;
+
+  int & toFortran() {key(); return keyGVL_;}
+  const int & toFortran() const {return key();}
+
+  /// \brief Account for the memory taken by the values under \p category if memory profiling
+  /// is enabled (see MemoryProfiler). GeoVaLs are accounted for under
+  /// MemoryProfiler::Category::GEOVALS unless this is called.
+  void trackMemoryUsage(MemoryProfiler::Category category) const;
 
  private:
   void print(std::ostream &) const;
+  /// Report the memory currently taken by the values to the MemoryProfiler, if enabled.
+  void updateMemoryUsage() const;
+  /// Return the key of the Fortran object, first converting the values to double precision if
+  /// they are stored in single precision. Safe to call from several threads at once.
+  const F90goms & key() const;
+  /// Call \p op(x, y, n) for each variable present in both these GeoVaLs and \p other, where
+  /// \p x and \p y point to the \p n contiguous values of the variable in these GeoVaLs and in
+  /// \p other. \p opname is used in error messages.
+  template <typename BinaryOp>
+  void combineWith(const GeoVaLs & other, const char * opname, const BinaryOp & op);
   // -----------------------------------------------------------------------------
   /*! \brief Take the input vector and recast to type<T> whilst respecting
              missing values */
@@ -172,6 +304,14 @@ class GeoVaLs : public util::Printable,
   F90goms keyGVL_;
   oops::Variables vars_;
   std::shared_ptr<const ioda::Distribution> dist_;   /// observations MPI distribution
+  /// True if the values are stored in single precision (see the constructor taking the numbers
+  /// of levels).
+  mutable std::atomic<bool> singlePrecision_{false};
+  /// Serializes the conversion of the values to double precision in key().
+  mutable std::mutex precisionMutex_;
+  /// Locations representing the observation paths (see Locations::setPaths()), if any.
+  std::vector<size_t> pathCentres_;
+  mutable MemoryProfiler::Usage memoryUsage_{MemoryProfiler::Category::GEOVALS};
 };
 
 // -----------------------------------------------------------------------------
@@ -47,6 +47,19 @@ extern "C" {
   void ufo_geovals_setup_f90(F90goms & key, const size_t & nlocs,
                              const oops::Variables & vars,
                              const size_t & nvars, const size_t & nlevs);
+  /// Declares that the allocated levels of each variable of GeoVaLs with key \p key hold the
+  /// levels starting from level \p offsets + 1 (counting from the top) of the \p nlevsModel
+  /// levels passed to ufo_geovals_fill_f90. \p nlevsModel and \p offsets are pointers to the
+  /// first elements of arrays of size \p nvars.
+  void ufo_geovals_subset_levels_f90(const F90goms & key, const int & nvars,
+                                     const size_t & nlevsModel, const size_t & offsets);
+  /// Declares that the locations of GeoVaLs with key \p key sample \p npaths observation paths,
+  /// path \c i consisting of locations \p offsets[i] to \p offsets[i+1] - 1 and being
+  /// represented by location \p centres[i]. The variables for which the corresponding element of
+  /// \p perPath (an array of size \p nvars) is nonzero are stored only at the path centres.
+  void ufo_geovals_setup_paths_f90(const F90goms & key, const int & npaths,
+                                   const size_t & offsets, const size_t & centres,
+                                   const int & nvars, const int & perPath);
   /// Deprecated, rely on ufo_geovals_setup_f90 to allocate GeoVaLs instead.
   /// Allocates GeoVaLs for \p vars variables with \p nlevels number of levels.
   /// If the GeoVaLs for this variable were allocated before with different size,
@@ -56,7 +69,15 @@ extern "C" {
   void ufo_geovals_delete_f90(F90goms &);
   void ufo_geovals_copy_f90(const F90goms &, F90goms &);
   void ufo_geovals_copy_one_f90(F90goms &, const F90goms &, const int &);
+  /// Creates Fortran GeoVaLs with key \p other holding the variables \p vars of the GeoVaLs
+  /// with key \p self, with the same locations and levels, set to zero.
+  void ufo_geovals_zero_subset_f90(const F90goms & self, F90goms & other,
+                                   const oops::Variables & vars);
   void ufo_geovals_zero_f90(const F90goms &);
+  void ufo_geovals_to_single_precision_f90(const F90goms &);
+  void ufo_geovals_to_double_precision_f90(const F90goms &);
+  /// Returns in \p nbytes the number of bytes taken by the values of the GeoVaLs.
+  void ufo_geovals_memory_bytes_f90(const F90goms &, size_t & nbytes);
   void ufo_geovals_reorderzdir_f90(const F90goms &, const int &, const char *,
                                    const int &, const char *);
   void ufo_geovals_abs_f90(const F90goms &);
@@ -73,6 +94,10 @@ extern "C" {
   void ufo_geovals_normalize_f90(const F90goms &, const F90goms &);
   void ufo_geovals_split_f90(const F90goms &, const F90goms &, const F90goms &);
   void ufo_geovals_merge_f90(const F90goms &, const F90goms &, const F90goms &);
+  void ufo_geovals_time_slots_weighted_sum_f90(const F90goms &, const F90goms &, const int &,
+                                               const int &, const float &);
+  void ufo_geovals_time_slots_weighted_merge_f90(const F90goms &, const F90goms &, const int &,
+                                                 const int &, const float &);
   void ufo_geovals_minmaxavg_f90(const F90goms &, int &, int &, double &, double &, double &);
   void ufo_geovals_maxloc_f90(const F90goms &, double &, int &, int &);
   void ufo_geovals_nlocs_f90(const F90goms &, size_t &);
@@ -83,6 +108,14 @@ extern "C" {
                            const int &, float &);
   void ufo_geovals_get_loc_f90(const F90goms &, const int &, const char *, const int &,
                                const int &, double &);
+  /// Returns in \p data the address of the values of variable \p var (stored as an
+  /// nlevs x nlocs Fortran array) or a null pointer if they are not allocated.
+  void ufo_geovals_get_ptr_f90(const F90goms &, const int &, const char *, int & nlevs,
+                               int & nlocs, const double * & data);
+  /// Copies into the array \p vals of size \p nvals the values of variables \p vars, which
+  /// must all have the same number of levels, stored as an nvars x nlevs x nlocs Fortran array.
+  void ufo_geovals_get_packed_f90(const F90goms &, const oops::Variables & vars,
+                                  const int & nvals, double * vals);
   void ufo_geovals_getdouble_f90(const F90goms &, const int &, const char *, const int &,
                                  const int &, double &);
   void ufo_geovals_putdouble_f90(const F90goms &, const int &, const char *, const int &,
@@ -93,10 +126,18 @@ extern "C" {
                                  const eckit::Configuration &,
                                  const ioda::ObsSpace &, const oops::Variables &);
   void ufo_geovals_write_file_f90(const F90goms &, const eckit::Configuration &, const size_t &);
+  /// Return the address of the Fortran GeoVaLs object (for use by ufo_geovals_write_file_ptr_f90
+  /// on threads that must not access the registry of GeoVaLs objects).
+  void ufo_geovals_c_ptr_f90(const F90goms &, void * &);
+  void ufo_geovals_write_file_ptr_f90(void *, const eckit::Configuration &, const size_t &);
   void ufo_geovals_fill_f90(const int &, const int &, const int &,
                             const int &, const double &, const bool &);
   void ufo_geovals_fillad_f90(const int &, const int &, const int &,
                               const int &, double &, const bool &);
+  void ufo_geovals_fill_locmajor_f90(const int &, const int &, const int &,
+                                     const int &, const double &, const bool &);
+  void ufo_geovals_fillad_locmajor_f90(const int &, const int &, const int &,
+                                       const int &, double &, const bool &);
 }  // extern C
 
 }  // namespace ufo
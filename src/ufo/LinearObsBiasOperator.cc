@@ -10,10 +10,13 @@
 #include <memory>
 #include <vector>
 
+#include "ioda/distribution/Accumulator.h"
+#include "ioda/distribution/Distribution.h"
 #include "ioda/ObsSpace.h"
 #include "ioda/ObsVector.h"
 
 #include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
 
 #include "ufo/ObsBias.h"
 #include "ufo/ObsBiasIncrement.h"
@@ -36,11 +39,19 @@ void LinearObsBiasOperator::setTrajectory(const GeoVaLs & geovals, const ObsBias
       bias.variablePredictors();
   const std::size_t npreds = variablePredictors.size();
 
-  predData_.resize(npreds, ioda::ObsVector(odb_));
+  ioda::ObsVector predictor(odb_);
+  nvars_ = predictor.nvars();
+  predData_.resize(npreds, predictor.nvars() * predictor.nlocs());
   for (std::size_t p = 0; p < npreds; ++p) {
-    variablePredictors[p]->compute(odb_, geovals, ydiags, bias, predData_[p]);
+    variablePredictors[p]->computeOrReuse(odb_, geovals, ydiags, bias, predictor);
+    for (std::size_t jj = 0; jj < predictor.nvars() * predictor.nlocs(); ++jj)
+      predData_(p, jj) = predictor[jj];
   }
 
+  varCorrected_.assign(nvars_, true);
+  for (int jch : bias.chlistNoBC())
+    varCorrected_[jch - 1] = false;
+
   oops::Log::trace() << "LinearObsBiasOperator::setTrajectory done." << std::endl;
 }
 
@@ -51,11 +62,22 @@ void LinearObsBiasOperator::computeObsBiasTL(const GeoVaLs & geovals,
                                              ioda::ObsVector & ybiasinc) const {
   oops::Log::trace() << "LinearObsBiasOperator::computeObsBiasTL starts." << std::endl;
 
-  const size_t npreds = predData_.size();
-
-  ybiasinc.zero();
-  for (size_t jpred = 0; jpred < npreds; ++jpred) {
-    ybiasinc.axpy(biascoeffinc.coefficients(jpred), predData_[jpred]);
+  const double missing = util::missingValue(missing);
+  const Eigen::Index npreds = predData_.rows();
+  const int nobs = predData_.cols();
+  // Coefficients of variable jvar are stored in column jvar.
+  const Eigen::Map<const Eigen::MatrixXd> coeffs(biascoeffinc.data().data(), npreds, nvars_);
+
+  // A missing predictor makes the bias correction missing.
+#pragma omp parallel for schedule(static)
+  for (int jobs = 0; jobs < nobs; ++jobs) {
+    const std::size_t jvar = jobs % nvars_;
+    if (!varCorrected_[jvar] || npreds == 0) {
+      ybiasinc[jobs] = 0.0;
+      continue;
+    }
+    const auto pred = predData_.col(jobs);
+    ybiasinc[jobs] = (pred.array() == missing).any() ? missing : pred.dot(coeffs.col(jvar));
   }
 
   oops::Log::trace() << "LinearObsBiasOperator::computeObsBiasTL done." << std::endl;
@@ -68,11 +90,26 @@ void LinearObsBiasOperator::computeObsBiasAD(GeoVaLs & geovals,
                                              const ioda::ObsVector & ybiasinc) const {
   oops::Log::trace() << "LinearObsBiasOperator::computeObsBiasAD starts." << std::endl;
 
-  const size_t npreds = predData_.size();
-
-  for (std::size_t jpred = 0; jpred < npreds; ++jpred) {
-    biascoeffinc.updateCoeff(jpred, predData_[jpred].multivar_dot_product_with(ybiasinc));
+  const double missing = util::missingValue(missing);
+  const std::size_t npreds = predData_.rows();
+  const std::size_t nobs = predData_.cols();
+
+  // Accumulate the contributions of all locations (counting each observation once across all
+  // MPI tasks) to all coefficients, skipping missing values, and reduce them in one go.
+  std::unique_ptr<ioda::Accumulator<std::vector<double>>> accumulator =
+      odb_.distribution()->createAccumulator<double>(npreds * nvars_);
+  for (std::size_t jobs = 0; jobs < nobs; ++jobs) {
+    const std::size_t jvar = jobs % nvars_;
+    if (!varCorrected_[jvar] || ybiasinc[jobs] == missing)
+      continue;
+    for (std::size_t jpred = 0; jpred < npreds; ++jpred) {
+      const double pred = predData_(jpred, jobs);
+      if (pred != missing)
+        accumulator->addTerm(jobs / nvars_, jvar * npreds + jpred, pred * ybiasinc[jobs]);
+    }
   }
+  const std::vector<double> increments = accumulator->computeResult();
+  biascoeffinc.data() += Eigen::Map<const Eigen::VectorXd>(increments.data(), increments.size());
 
   oops::Log::trace() << "LinearObsBiasOperator::computeAD done." << std::endl;
 }
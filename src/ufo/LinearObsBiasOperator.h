@@ -10,6 +10,8 @@
 
 #include <vector>
 
+#include <Eigen/Core>
+
 #include "oops/util/Printable.h"
 
 namespace ioda {
@@ -44,8 +46,15 @@ class LinearObsBiasOperator : public util::Printable {
   /// ObsSpace used for this bias correction
   ioda::ObsSpace & odb_;
 
-  /// predictors values; set in setTrajectory
-  std::vector<ioda::ObsVector> predData_;
+  /// Values of the variable predictors (npreds x (nlocs * nvars)); set in setTrajectory.
+  /// Column jloc * nvars + jvar holds the values of all predictors for variable jvar at
+  /// location jloc, so that it lines up with the ObsVector layout and the coefficients of each
+  /// variable are contiguous in ObsBias::data().
+  Eigen::MatrixXd predData_;
+  /// Number of variables in the ObsVectors.
+  std::size_t nvars_ = 0;
+  /// False for variables that are not bias corrected (listed in ObsBias::chlistNoBC()).
+  std::vector<bool> varCorrected_;
 };
 
 // -----------------------------------------------------------------------------
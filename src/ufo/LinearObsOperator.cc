@@ -12,17 +12,26 @@
 #include "ioda/ObsVector.h"
 #include "ufo/LinearObsBiasOperator.h"
 #include "ufo/LinearObsOperatorBase.h"
+#include "ufo/LinearObsOperatorMatrix.h"
 #include "ufo/Locations.h"
 #include "ufo/ObsBias.h"
 #include "ufo/ObsBiasIncrement.h"
 #include "ufo/ObsDiagnostics.h"
+#include "ufo/OperatorProfiler.h"
+#include "ufo/utils/LocationChunks.h"
 
 namespace ufo {
 
 // -----------------------------------------------------------------------------
 
 LinearObsOperator::LinearObsOperator(ioda::ObsSpace & os, const Parameters_ & params)
-  : oper_(LinearObsOperatorFactory::create(os, params.operatorParameters)), odb_(os)
+  : oper_(LinearObsOperatorFactory::create(os, params.operatorParameters)), odb_(os),
+    profiler_(OperatorProfiler::create(os, params.operatorParameters.value().name.value().value(),
+                                       {"setTrajectory", "simulateObsTL", "simulateObsAD"})),
+    memoryProfiler_(MemoryProfiler::forObsSpace(os)),
+    applyAsSparseMatrix_(params.operatorParameters.value().applyAsSparseMatrix),
+    maxNumLocationsPerChunk_(params.operatorParameters.value().maxNumLocationsPerChunk.value()
+                             .value_or(0))
 {
   // We use += rather than = to make sure the Variables objects contain no duplicate entries.
   oops::Variables operatorVars;
@@ -39,7 +48,14 @@ LinearObsOperator::LinearObsOperator(ioda::ObsSpace & os, const Parameters_ & pa
 
 // -----------------------------------------------------------------------------
 
+LinearObsOperator::~LinearObsOperator() {}
+
+// -----------------------------------------------------------------------------
+
 void LinearObsOperator::setTrajectory(const GeoVaLs & gvals, const ObsBias & bias) {
+  OperatorProfiler::Measurement measurement(profiler_.get(), 0, odb_.nlocs(),
+                                            odb_.assimvariables().size());
+  MemoryProfiler::Stage stage(memoryProfiler_.get(), "setTrajectory");
   oops::Variables vars;
   vars += bias.requiredHdiagnostics();
   std::vector<float> lons(odb_.nlocs());
@@ -50,17 +66,36 @@ void LinearObsOperator::setTrajectory(const GeoVaLs & gvals, const ObsBias & bia
   odb_.get_db("MetaData", "dateTime", times);
   ObsDiagnostics ydiags(odb_, Locations(lons, lats, times, odb_.distribution()), vars);
   oper_->setTrajectory(gvals, ydiags);
+  if (applyAsSparseMatrix_) {
+    matrix_ = oper_->matrix();
+    if (matrix_)
+      oops::Log::trace() << "LinearObsOperator: applying the operator as a sparse matrix with "
+                         << matrix_->nonZeros() << " non-zero elements" << std::endl;
+  }
   if (bias) {
     biasoper_.reset(new LinearObsBiasOperator(odb_));
     biasoper_->setTrajectory(gvals, bias, ydiags);
   }
+  if (memoryProfiler_)
+    trajectoryMemory_.update(odb_.distribution().get(), oper_->trajectoryMemoryBytes() +
+                             (matrix_ ? matrix_->memoryBytes() : 0));
 }
 
 // -----------------------------------------------------------------------------
 
 void LinearObsOperator::simulateObsTL(const GeoVaLs & gvals, ioda::ObsVector & yy,
                                       const ObsBiasIncrement & bias) const {
-  oper_->simulateObsTL(gvals, yy);
+  OperatorProfiler::Measurement measurement(profiler_.get(), 1, yy.nlocs(), yy.nvars());
+  MemoryProfiler::Stage stage(memoryProfiler_.get(), "simulateObsTL");
+  if (matrix_)
+    matrix_->multiply(gvals, yy);
+  else if (maxNumLocationsPerChunk_ > 0 && oper_->supportsLocationRanges())
+    forEachLocationChunk(yy.nlocs(), maxNumLocationsPerChunk_, oper_->isThreadSafe(),
+                         [&](size_t begin, size_t end) {
+                           oper_->simulateObsTLAtLocations(gvals, yy, begin, end);
+                         });
+  else
+    oper_->simulateObsTL(gvals, yy);
   if (bias) {
     ioda::ObsVector ybiasinc(odb_);
     biasoper_->computeObsBiasTL(gvals, bias, ybiasinc);
@@ -72,7 +107,17 @@ void LinearObsOperator::simulateObsTL(const GeoVaLs & gvals, ioda::ObsVector & y
 
 void LinearObsOperator::simulateObsAD(GeoVaLs & gvals, const ioda::ObsVector & yy,
                                       ObsBiasIncrement & bias) const {
-  oper_->simulateObsAD(gvals, yy);
+  OperatorProfiler::Measurement measurement(profiler_.get(), 2, yy.nlocs(), yy.nvars());
+  MemoryProfiler::Stage stage(memoryProfiler_.get(), "simulateObsAD");
+  if (matrix_)
+    matrix_->multiplyTransposed(gvals, yy);
+  else if (maxNumLocationsPerChunk_ > 0 && oper_->supportsLocationRanges())
+    forEachLocationChunk(yy.nlocs(), maxNumLocationsPerChunk_, oper_->isThreadSafe(),
+                         [&](size_t begin, size_t end) {
+                           oper_->simulateObsADAtLocations(gvals, yy, begin, end);
+                         });
+  else
+    oper_->simulateObsAD(gvals, yy);
   if (bias) {
     ioda::ObsVector ybiasinc(yy);
     biasoper_->computeObsBiasAD(gvals, bias, ybiasinc);
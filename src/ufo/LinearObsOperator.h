@@ -15,6 +15,7 @@
 #include "oops/util/Printable.h"
 #include "ufo/LinearObsBiasOperator.h"
 #include "ufo/LinearObsOperatorBase.h"
+#include "ufo/MemoryProfiler.h"
 
 // Forward declarations
 namespace oops {
@@ -28,8 +29,10 @@ namespace ioda {
 
 namespace ufo {
   class GeoVaLs;
+  class LinearObsOperatorMatrix;
   class ObsBias;
   class ObsBiasIncrement;
+  class OperatorProfiler;
 
 // -----------------------------------------------------------------------------
 
@@ -39,6 +42,7 @@ class LinearObsOperator : public util::Printable,
   typedef LinearObsOperatorParametersWrapper Parameters_;
 
   LinearObsOperator(ioda::ObsSpace &, const Parameters_ &);
+  ~LinearObsOperator();
 
 /// Obs Operator
   void setTrajectory(const GeoVaLs &, const ObsBias &);
@@ -53,6 +57,20 @@ class LinearObsOperator : public util::Printable,
   std::unique_ptr<LinearObsOperatorBase> oper_;
   std::unique_ptr<LinearObsBiasOperator> biasoper_;
   ioda::ObsSpace & odb_;
+  /// Null unless operator profiling is enabled.
+  std::unique_ptr<OperatorProfiler> profiler_;
+  /// Null unless memory profiling is enabled.
+  std::shared_ptr<MemoryProfiler> memoryProfiler_;
+  /// Memory taken by the trajectory of the operator and by matrix_.
+  MemoryProfiler::Usage trajectoryMemory_{MemoryProfiler::Category::TRAJECTORIES};
+  /// True if the operator should be applied as a sparse matrix when possible.
+  bool applyAsSparseMatrix_;
+  /// Maximum number of locations passed to each call to the operator's simulateObsTLAtLocations()
+  /// and simulateObsADAtLocations() methods (0 if the operator is applied to all locations at once).
+  size_t maxNumLocationsPerChunk_;
+  /// Matrix of the operator linearised about the current trajectory (null if the operator is
+  /// applied by calling its simulateObsTL() and simulateObsAD() methods).
+  std::unique_ptr<LinearObsOperatorMatrix> matrix_;
 };
 
 // -----------------------------------------------------------------------------
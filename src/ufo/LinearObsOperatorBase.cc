@@ -9,7 +9,9 @@
 
 #include <memory>
 
+#include "eckit/exception/Exceptions.h"
 #include "ioda/ObsSpace.h"
+#include "ufo/LinearObsOperatorMatrix.h"
 #include "oops/util/abor1_cpp.h"
 #include "oops/util/Logger.h"
 
@@ -23,6 +25,28 @@ oops::Variables LinearObsOperatorBase::simulatedVars() const {
 
 // -----------------------------------------------------------------------------
 
+std::unique_ptr<LinearObsOperatorMatrix> LinearObsOperatorBase::matrix() const {
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+void LinearObsOperatorBase::simulateObsTLAtLocations(const GeoVaLs &, ioda::ObsVector &,
+                                                     size_t, size_t) const {
+  throw eckit::NotImplemented("This linear observation operator cannot be applied at a "
+                              "subset of locations", Here());
+}
+
+// -----------------------------------------------------------------------------
+
+void LinearObsOperatorBase::simulateObsADAtLocations(GeoVaLs &, const ioda::ObsVector &,
+                                                     size_t, size_t) const {
+  throw eckit::NotImplemented("This linear observation operator cannot be applied at a "
+                              "subset of locations", Here());
+}
+
+// -----------------------------------------------------------------------------
+
 LinearObsOperatorFactory::LinearObsOperatorFactory(const std::string & name) {
   if (getMakers().find(name) != getMakers().end()) {
     oops::Log::error() << name << " already registered in ufo::LinearObsOperatorFactory."
@@ -33,6 +33,7 @@ class ObsVector;
 
 namespace ufo {
 class GeoVaLs;
+class LinearObsOperatorMatrix;
 class ObsDiagnostics;
 
 // -----------------------------------------------------------------------------
@@ -56,6 +57,37 @@ class LinearObsOperatorBase : public util::Printable,
   virtual void simulateObsTL(const GeoVaLs &, ioda::ObsVector &) const = 0;
   virtual void simulateObsAD(GeoVaLs &, const ioda::ObsVector &) const = 0;
 
+/// \brief Return true if simulateObsTLAtLocations() and simulateObsADAtLocations() are
+/// implemented, i.e. if the operator can be applied to a range of locations independently of
+/// all other locations.
+///
+/// The default implementation returns false.
+  virtual bool supportsLocationRanges() const {return false;}
+
+/// \brief Return true if simulateObsTLAtLocations() and simulateObsADAtLocations() may be
+/// called concurrently for disjoint ranges of locations.
+///
+/// The default implementation returns false.
+  virtual bool isThreadSafe() const {return false;}
+
+/// \brief Apply the tangent linear operator at locations \p begin to \p end - 1, leaving the
+/// other elements of the output vector unchanged.
+///
+/// Called by LinearObsOperator in place of simulateObsTL() if the `max number of locations per
+/// chunk` option is set and supportsLocationRanges() returns true. The default implementation
+/// throws an exception.
+  virtual void simulateObsTLAtLocations(const GeoVaLs &, ioda::ObsVector &,
+                                        size_t begin, size_t end) const;
+
+/// \brief Apply the adjoint operator at locations \p begin to \p end - 1, i.e. add the
+/// contributions of these elements of the input vector to the GeoVaLs at these locations.
+///
+/// Called by LinearObsOperator in place of simulateObsAD() if the `max number of locations per
+/// chunk` option is set and supportsLocationRanges() returns true. The default implementation
+/// throws an exception.
+  virtual void simulateObsADAtLocations(GeoVaLs &, const ioda::ObsVector &,
+                                        size_t begin, size_t end) const;
+
 /// Operator input required from Model
   virtual const oops::Variables & requiredVars() const = 0;
 
@@ -64,6 +96,21 @@ class LinearObsOperatorBase : public util::Printable,
 /// The default implementation returns the list of all simulated variables in the ObsSpace.
   virtual oops::Variables simulatedVars() const;
 
+/// \brief Return the matrix of the operator linearised about the trajectory passed to the last
+/// call to setTrajectory(), or a null pointer if the operator cannot provide it.
+///
+/// The matrix must produce the same results as simulateObsTL() and simulateObsAD(); it is used
+/// in their place by LinearObsOperator if the `apply as sparse matrix` option is set. The
+/// default implementation returns a null pointer.
+  virtual std::unique_ptr<LinearObsOperatorMatrix> matrix() const;
+
+/// \brief Return the number of bytes taken by the trajectory stored by the last call to
+/// setTrajectory() (e.g. Jacobians or interpolation weights), for memory profiling only (see
+/// MemoryProfiler).
+///
+/// The default implementation returns 0.
+  virtual size_t trajectoryMemoryBytes() const {return 0;}
+
 /// \brief The space containing the observations to be simulated by this operator.
   const ioda::ObsSpace &obsspace() const { return odb_; }
 
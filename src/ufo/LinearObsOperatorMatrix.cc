@@ -0,0 +1,187 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/LinearObsOperatorMatrix.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include "eckit/exception/Exceptions.h"
+#include "ioda/ObsVector.h"
+#include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
+#include "ufo/GeoVaLs.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+LinearObsOperatorMatrix::LinearObsOperatorMatrix(const std::vector<std::string> & variables,
+                                                 const std::vector<size_t> & nlevs,
+                                                 size_t nrows)
+  : variables_(variables), nlevs_(nlevs), nrows_(nrows), missingRows_(nrows, false)
+{
+  ASSERT(variables_.size() == nlevs_.size());
+}
+
+// -----------------------------------------------------------------------------
+
+void LinearObsOperatorMatrix::add(size_t row, size_t ivar, size_t lev, size_t loc,
+                                  double value) {
+  ASSERT(!finalised_);
+  ASSERT(row < nrows_ && ivar < variables_.size() && lev < nlevs_[ivar]);
+  triplets_.push_back(Triplet{row, ivar, loc * nlevs_[ivar] + lev, value});
+}
+
+// -----------------------------------------------------------------------------
+
+void LinearObsOperatorMatrix::setMissing(size_t row) {
+  ASSERT(!finalised_);
+  ASSERT(row < nrows_);
+  missingRows_[row] = true;
+}
+
+// -----------------------------------------------------------------------------
+
+void LinearObsOperatorMatrix::finalise() {
+  ASSERT(!finalised_);
+  finalised_ = true;
+
+  // Rows are sorted first, so that the elements of each row are in order of increasing level
+  // and the elements of each column in order of increasing row once the columns are sorted.
+  std::stable_sort(triplets_.begin(), triplets_.end(),
+                   [](const Triplet & a, const Triplet & b) {
+                     return std::tie(a.row, a.ivar, a.offset) < std::tie(b.row, b.ivar, b.offset);
+                   });
+  // Merge duplicate elements.
+  std::vector<Triplet> merged;
+  merged.reserve(triplets_.size());
+  for (const Triplet & t : triplets_) {
+    if (!merged.empty() && merged.back().row == t.row &&
+        merged.back().ivar == t.ivar && merged.back().offset == t.offset)
+      merged.back().value += t.value;
+    else
+      merged.push_back(t);
+  }
+  triplets_.clear();
+  triplets_.shrink_to_fit();
+
+  rowStart_.assign(nrows_ + 1, 0);
+  rowVariables_.reserve(merged.size());
+  rowOffsets_.reserve(merged.size());
+  rowValues_.reserve(merged.size());
+  for (const Triplet & t : merged) {
+    ++rowStart_[t.row + 1];
+    rowVariables_.push_back(t.ivar);
+    rowOffsets_.push_back(t.offset);
+    rowValues_.push_back(t.value);
+  }
+  for (size_t row = 0; row < nrows_; ++row)
+    rowStart_[row + 1] += rowStart_[row];
+
+  std::stable_sort(merged.begin(), merged.end(),
+                   [](const Triplet & a, const Triplet & b) {
+                     return std::tie(a.ivar, a.offset) < std::tie(b.ivar, b.offset);
+                   });
+  columnRows_.reserve(merged.size());
+  columnValues_.reserve(merged.size());
+  for (const Triplet & t : merged) {
+    if (columnVariables_.empty() || columnVariables_.back() != t.ivar ||
+        columnOffsets_.back() != t.offset) {
+      columnVariables_.push_back(t.ivar);
+      columnOffsets_.push_back(t.offset);
+      columnStart_.push_back(columnRows_.size());
+    }
+    columnRows_.push_back(t.row);
+    columnValues_.push_back(t.value);
+  }
+  columnStart_.push_back(columnRows_.size());
+
+  oops::Log::trace() << "LinearObsOperatorMatrix: " << nrows_ << " rows, "
+                     << rowValues_.size() << " non-zero elements" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+void LinearObsOperatorMatrix::multiply(const GeoVaLs & dx, ioda::ObsVector & dy) const {
+  ASSERT(finalised_);
+  ASSERT(dy.nvars() * dy.nlocs() == nrows_);
+  const double missing = util::missingValue(missing);
+
+  std::vector<const double *> data(variables_.size());
+  for (size_t ivar = 0; ivar < variables_.size(); ++ivar) {
+    const GeoVaLsView view = dx.view(variables_[ivar]);
+    ASSERT(view.nlevs() == nlevs_[ivar]);
+    data[ivar] = view.data();
+  }
+
+  const int nrows = nrows_;
+#pragma omp parallel for schedule(static)
+  for (int row = 0; row < nrows; ++row) {
+    if (missingRows_[row]) {
+      dy[row] = missing;
+      continue;
+    }
+    if (rowStart_[row] == rowStart_[row + 1])
+      continue;
+    double sum = 0.0;
+    for (size_t i = rowStart_[row]; i < rowStart_[row + 1]; ++i) {
+      const double x = data[rowVariables_[i]][rowOffsets_[i]];
+      if (x == missing) {
+        sum = missing;
+        break;
+      }
+      sum += rowValues_[i] * x;
+    }
+    dy[row] = sum;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void LinearObsOperatorMatrix::multiplyTransposed(GeoVaLs & dx,
+                                                 const ioda::ObsVector & dy) const {
+  ASSERT(finalised_);
+  ASSERT(dy.nvars() * dy.nlocs() == nrows_);
+  const double missing = util::missingValue(missing);
+
+  std::vector<double *> data(variables_.size());
+  for (size_t ivar = 0; ivar < variables_.size(); ++ivar) {
+    ASSERT(dx.nlevs(variables_[ivar]) == nlevs_[ivar]);
+    data[ivar] = dx.data(variables_[ivar]);
+  }
+
+  const int ncolumns = columnVariables_.size();
+#pragma omp parallel for schedule(static)
+  for (int col = 0; col < ncolumns; ++col) {
+    double & x = data[columnVariables_[col]][columnOffsets_[col]];
+    for (size_t i = columnStart_[col]; i < columnStart_[col + 1]; ++i) {
+      const size_t row = columnRows_[i];
+      if (missingRows_[row] || dy[row] == missing)
+        continue;
+      if (x == missing)
+        x = 0.0;
+      else
+        x += columnValues_[i] * dy[row];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+size_t LinearObsOperatorMatrix::memoryBytes() const {
+  const size_t nindices = rowStart_.capacity() + rowVariables_.capacity() +
+      rowOffsets_.capacity() + columnVariables_.capacity() + columnOffsets_.capacity() +
+      columnStart_.capacity() + columnRows_.capacity();
+  const size_t nvalues = rowValues_.capacity() + columnValues_.capacity();
+  return triplets_.capacity() * sizeof(Triplet) + missingRows_.capacity() / 8 +
+      nindices * sizeof(size_t) + nvalues * sizeof(double);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
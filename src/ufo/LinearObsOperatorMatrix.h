@@ -0,0 +1,113 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_LINEAROBSOPERATORMATRIX_H_
+#define UFO_LINEAROBSOPERATORMATRIX_H_
+
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace ioda {
+class ObsVector;
+}
+
+namespace ufo {
+class GeoVaLs;
+
+// -----------------------------------------------------------------------------
+/// \brief Sparse matrix representation of a linear observation operator.
+///
+/// \details Each row corresponds to an element of the ObsVector (location \c loc and variable
+/// \c jvar correspond to row loc * nvars + jvar) and each column to a single GeoVaLs value
+/// (a variable, level and location). The matrix is filled by calling add() and setMissing() in
+/// any order and then finalise(), which stores it in compressed sparse row (CSR) format for the
+/// tangent linear and also in compressed sparse column format for the adjoint, so that both
+/// can be applied in parallel without any race conditions.
+///
+/// The tangent linear, multiply(), sets each row with at least one element to the weighted sum
+/// of the GeoVaLs values in its columns, or to the missing value if any of those values is
+/// missing. Rows marked as missing with setMissing() are set to the missing value. Rows with no
+/// elements are left unchanged.
+///
+/// The adjoint, multiplyTransposed(), adds to each GeoVaLs value the weighted sum of the
+/// non-missing elements of the ObsVector in the corresponding rows, skipping rows marked as
+/// missing. The contributions to each value are added in the order of increasing row index,
+/// which is also the order in which the individual operators traverse the ObsVector; as in the
+/// vert_interp_apply_ad routine, a GeoVaLs value that is missing when a contribution is due is
+/// reset to zero instead.
+class LinearObsOperatorMatrix : private boost::noncopyable {
+ public:
+  /// \brief Create an empty matrix.
+  ///
+  /// \param variables
+  ///   Names of the GeoVaLs the operator acts on.
+  /// \param nlevs
+  ///   Number of levels of each of these GeoVaLs.
+  /// \param nrows
+  ///   Size of the ObsVector produced by the operator.
+  LinearObsOperatorMatrix(const std::vector<std::string> & variables,
+                          const std::vector<size_t> & nlevs, size_t nrows);
+
+  /// Add \p value to the element in row \p row and the column corresponding to level \p lev
+  /// of variable number \p ivar at location \p loc.
+  void add(size_t row, size_t ivar, size_t lev, size_t loc, double value);
+
+  /// Make the tangent linear set row \p row to the missing value.
+  void setMissing(size_t row);
+
+  /// Convert the elements added so far to the format used by multiply() and
+  /// multiplyTransposed(). Must be called once, after all elements have been added.
+  void finalise();
+
+  /// Tangent linear: set \p dy to the product of the matrix and \p dx.
+  void multiply(const GeoVaLs & dx, ioda::ObsVector & dy) const;
+  /// Adjoint: add the product of the transpose of the matrix and \p dy to \p dx.
+  void multiplyTransposed(GeoVaLs & dx, const ioda::ObsVector & dy) const;
+
+  size_t nrows() const {return nrows_;}
+  /// Number of (structurally) non-zero elements.
+  size_t nonZeros() const {return rowValues_.size();}
+  /// Number of bytes taken by the elements of the matrix.
+  size_t memoryBytes() const;
+
+ private:
+  struct Triplet {
+    size_t row;
+    size_t ivar;
+    size_t offset;
+    double value;
+  };
+
+  std::vector<std::string> variables_;
+  std::vector<size_t> nlevs_;
+  size_t nrows_;
+  std::vector<Triplet> triplets_;
+  std::vector<bool> missingRows_;
+  bool finalised_ = false;
+
+  // Compressed sparse row storage: the elements of row r are those with indices from
+  // rowStart_[r] to rowStart_[r + 1] - 1.
+  std::vector<size_t> rowStart_;
+  std::vector<size_t> rowVariables_;
+  std::vector<size_t> rowOffsets_;
+  std::vector<double> rowValues_;
+
+  // Compressed sparse column storage, covering only columns with at least one element.
+  std::vector<size_t> columnVariables_;
+  std::vector<size_t> columnOffsets_;
+  std::vector<size_t> columnStart_;
+  std::vector<size_t> columnRows_;
+  std::vector<double> columnValues_;
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
+
+#endif  // UFO_LINEAROBSOPERATORMATRIX_H_
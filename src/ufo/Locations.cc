@@ -7,20 +7,20 @@
 
 #include "ufo/Locations.h"
 
+#include <algorithm>
+#include <cmath>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "eckit/config/Configuration.h"
 #include "eckit/exception/Exceptions.h"
 
-#include "ioda/Engines/EngineUtils.h"
-#include "ioda/Group.h"
 #include "ioda/ObsSpace.h"
 
 #include "oops/mpi/mpi.h"
 #include "oops/util/DateTime.h"
 #include "oops/util/Logger.h"
-#include "oops/util/missingValues.h"
 
 namespace ufo {
 
@@ -29,31 +29,13 @@ namespace ufo {
 Locations::Locations(const std::vector<float> & lons, const std::vector<float> & lats,
                      const std::vector<util::DateTime> & times,
                      std::shared_ptr<const ioda::Distribution> dist)
-  : dist_(std::move(dist)), times_(std::move(times)), lons_(), lats_() {
+  : dist_(std::move(dist)), times_(std::move(times)), lonsFloat_(lons), latsFloat_(lats),
+    lons_(lons.begin(), lons.end()), lats_(lats.begin(), lats.end()) {
   oops::Log::trace() << "ufo::Locations::Locations start" << std::endl;
   const size_t nlocs = times_.size();
   ASSERT(nlocs == lons.size());
   ASSERT(nlocs == lats.size());
-  lons_.resize(nlocs);
-  lats_.resize(nlocs);
-  for (size_t jj = 0; jj < nlocs; ++jj) {
-    lons_[jj] = lons[jj];
-    lats_[jj] = lats[jj];
-  }
-
-  initializeObsGroup(nlocs);
-
-  // Set float_params that add safety in case of missing values and optimize the
-  // potential future use of hdf5's "memory file" as the ObsGroup backend.
-  const float floatMissing = util::missingValue(floatMissing);
-  ioda::VariableCreationParameters float_params;
-  float_params.chunk = true;
-  float_params.compressWithGZIP();
-  float_params.setFillValue<float>(floatMissing);
-
-  const ioda::Variable nlocsVar = og_.vars["nlocs"];
-  og_.vars.createWithScales<float>("longitude", {nlocsVar}, float_params).write(lons);
-  og_.vars.createWithScales<float>("latitude", {nlocsVar}, float_params).write(lats);
+  appendUnitVectors(0);
 
   oops::Log::trace() << "ufo::Locations::Locations done" << std::endl;
 }
@@ -80,7 +62,7 @@ Locations::Locations(const std::vector<float> & lons, const std::vector<float> &
 
 Locations::Locations(const eckit::Configuration & conf,
                      const eckit::mpi::Comm & comm)
-  : dist_(), times_(), lons_(), lats_() {
+  : dist_(), times_(), lonsFloat_(), latsFloat_(), lons_(), lats_() {
   const eckit::LocalConfiguration obsconf(conf, "obs space");
   const util::DateTime bgn = util::DateTime(conf.getString("window begin"));
   const util::DateTime end = util::DateTime(conf.getString("window end"));
@@ -91,28 +73,13 @@ Locations::Locations(const eckit::Configuration & conf,
   const size_t nlocs = obspace.nlocs();
   dist_ = obspace.distribution();
 
-  initializeObsGroup(nlocs);
-
-  // Set float_params that add safety in case of missing values and optimize the
-  // potential future use of hdf5's "memory file" as the ObsGroup backend.
-  const float floatMissing = util::missingValue(floatMissing);
-  ioda::VariableCreationParameters float_params;
-  float_params.chunk = true;
-  float_params.compressWithGZIP();
-  float_params.setFillValue<float>(floatMissing);
-
-  const ioda::Variable nlocsVar = og_.vars["nlocs"];
-  std::vector<float> buffer(nlocs);
-  lons_.resize(nlocs);
-  lats_.resize(nlocs);
-
-  obspace.get_db("MetaData", "longitude", buffer);
-  for (size_t jj = 0; jj < nlocs; ++jj) lons_[jj] = buffer[jj];
-  og_.vars.createWithScales<float>("longitude", {nlocsVar}, float_params).write(buffer);
-
-  obspace.get_db("MetaData", "latitude", buffer);
-  for (size_t jj = 0; jj < nlocs; ++jj) lats_[jj] = buffer[jj];
-  og_.vars.createWithScales<float>("latitude", {nlocsVar}, float_params).write(buffer);
+  lonsFloat_.resize(nlocs);
+  latsFloat_.resize(nlocs);
+  obspace.get_db("MetaData", "longitude", lonsFloat_);
+  obspace.get_db("MetaData", "latitude", latsFloat_);
+  lons_.assign(lonsFloat_.begin(), lonsFloat_.end());
+  lats_.assign(latsFloat_.begin(), latsFloat_.end());
+  appendUnitVectors(0);
 
   times_.resize(nlocs);
   obspace.get_db("MetaData", "dateTime", times_);
@@ -121,36 +88,86 @@ Locations::Locations(const eckit::Configuration & conf,
 // -------------------------------------------------------------------------------------------------
 
 Locations & Locations::operator+=(const Locations & other) {
-  // Resize ObsGroup to new total size
-  const ioda::Variable nlocsVar = og_.vars["nlocs"];
-  const size_t nlocs = nlocsVar.getDimensions().dimsCur[0];
-  const size_t other_nlocs = other.og_.vars["nlocs"].getDimensions().dimsCur[0];
-  const ioda::Dimensions_t total_nlocs = nlocs + other_nlocs;
+  const size_t nlocs = size();
+  lonsFloat_.insert(lonsFloat_.end(), other.lonsFloat_.begin(), other.lonsFloat_.end());
+  latsFloat_.insert(latsFloat_.end(), other.latsFloat_.begin(), other.latsFloat_.end());
+  times_.insert(times_.end(), other.times_.begin(), other.times_.end());
+  lats_.insert(lats_.end(), other.lats_.begin(), other.lats_.end());
+  lons_.insert(lons_.end(), other.lons_.begin(), other.lons_.end());
+  appendUnitVectors(nlocs);
+
+  // The concatenated locations no longer sample one path per observation.
+  pathOffsets_.clear();
+  pathCentres_.clear();
+  perPathVariables_.clear();
+
+  // Keep the level subset of a variable only if both sets of locations have one, widening it
+  // to cover both.
+  for (auto it = requiredLevels_.begin(); it != requiredLevels_.end();) {
+    const auto otherIt = other.requiredLevels_.find(it->first);
+    if (otherIt == other.requiredLevels_.end() ||
+        otherIt->second.nearSurface != it->second.nearSurface) {
+      it = requiredLevels_.erase(it);
+    } else {
+      it->second.numLevels = std::max(it->second.numLevels, otherIt->second.numLevels);
+      ++it;
+    }
+  }
 
-  og_.resize({std::make_pair(nlocsVar, total_nlocs)});
+  return *this;
+}
 
-  // Append variables from other's ObsGroup to end of local ObsGroup variables
-  const std::vector<ioda::Dimensions_t> start(1, nlocs);
-  const std::vector<ioda::Dimensions_t> other_start(1, 0);
-  const std::vector<ioda::Dimensions_t> counts(1, other_nlocs);
+// -------------------------------------------------------------------------------------------------
 
-  ioda::Selection feSelect;
-  feSelect.extent({total_nlocs}).select({ioda::SelectionOperator::SET, other_start, counts});
-  ioda::Selection beSelect;
-  beSelect.select({ioda::SelectionOperator::SET, start, counts});
+namespace {
 
-  std::vector<float> buffer(other_nlocs);
-  other.og_.vars["longitude"].read<float>(gsl::make_span(buffer));
-  og_.vars["longitude"].write<float>(buffer, feSelect, beSelect);
+/// Append \p ncopies - 1 copies of the elements of \p values to it.
+template <typename T>
+void repeatValues(std::vector<T> & values, size_t ncopies) {
+  const size_t n = values.size();
+  values.resize(n * ncopies);
+  for (size_t jcopy = 1; jcopy < ncopies; ++jcopy)
+    std::copy_n(values.begin(), n, values.begin() + jcopy * n);
+}
 
-  other.og_.vars["latitude"].read<float>(gsl::make_span(buffer));
-  og_.vars["latitude"].write<float>(buffer, feSelect, beSelect);
+}  // namespace
+
+void Locations::repeat(size_t ncopies) {
+  ASSERT(ncopies > 0);
+  repeatValues(lonsFloat_, ncopies);
+  repeatValues(latsFloat_, ncopies);
+  repeatValues(times_, ncopies);
+  repeatValues(lons_, ncopies);
+  repeatValues(lats_, ncopies);
+  repeatValues(x_, ncopies);
+  repeatValues(y_, ncopies);
+  repeatValues(z_, ncopies);
+
+  // The repeated locations no longer sample one path per observation.
+  if (ncopies > 1) {
+    pathOffsets_.clear();
+    pathCentres_.clear();
+    perPathVariables_.clear();
+  }
+}
 
-  times_.insert(times_.end(), other.times_.begin(), other.times_.end());
-  lats_.insert(lats_.end(), other.lats_.begin(), other.lats_.end());
-  lons_.insert(lons_.end(), other.lons_.begin(), other.lons_.end());
+// -------------------------------------------------------------------------------------------------
 
-  return *this;
+void Locations::setPaths(const std::vector<size_t> & pathOffsets,
+                         const std::vector<size_t> & pathCentres,
+                         const std::vector<std::string> & perPathVariables) {
+  const size_t npaths = pathCentres.size();
+  if (pathOffsets.size() != npaths + 1 || pathOffsets.front() != 0 ||
+      pathOffsets.back() != size())
+    throw eckit::BadParameter("Locations::setPaths: the paths must cover all locations", Here());
+  for (size_t jpath = 0; jpath < npaths; ++jpath) {
+    if (pathCentres[jpath] < pathOffsets[jpath] || pathCentres[jpath] >= pathOffsets[jpath + 1])
+      throw eckit::BadParameter("Locations::setPaths: the centre of path " +
+                                std::to_string(jpath) + " lies outside it", Here());
+  }
+  pathOffsets_ = pathOffsets;
+  pathCentres_ = pathCentres;
+  perPathVariables_ = perPathVariables;
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -172,32 +189,20 @@ size_t Locations::size() const {
 
 // -------------------------------------------------------------------------------------------------
 
-std::vector<float> Locations::lons() const {
-  ASSERT(og_.vars.exists("longitude"));
-  const size_t nlocs = size();
-  std::vector<float> lons(nlocs);
-  og_.vars["longitude"].read<float>(gsl::make_span(lons));
-  return lons;
-}
-
-// -------------------------------------------------------------------------------------------------
-
-std::vector<float> Locations::lats() const {
-  ASSERT(og_.vars.exists("latitude"));
-  const size_t nlocs = size();
-  std::vector<float> lats(nlocs);
-  og_.vars["latitude"].read<float>(gsl::make_span(lats));
-  return lats;
-}
-
-// -------------------------------------------------------------------------------------------------
-
-void Locations::initializeObsGroup(const size_t nlocs) {
-  ioda::Engines::BackendCreationParameters params;
-  ioda::Group g = constructBackend(ioda::Engines::BackendNames::ObsStore, params);
-  const ioda::NewDimensionScales_t dimScales{{
-      ioda::NewDimensionScale<int>("nlocs", nlocs, ioda::Unlimited, nlocs)}};
-  og_ = ioda::ObsGroup::generate(g, dimScales);
+void Locations::appendUnitVectors(const size_t first) {
+  static const double deg2rad = M_PI / 180.0;
+  const size_t nlocs = lons_.size();
+  x_.resize(nlocs);
+  y_.resize(nlocs);
+  z_.resize(nlocs);
+  for (size_t jj = first; jj < nlocs; ++jj) {
+    const double lon = lons_[jj] * deg2rad;
+    const double lat = lats_[jj] * deg2rad;
+    const double coslat = std::cos(lat);
+    x_[jj] = coslat * std::cos(lon);
+    y_[jj] = coslat * std::sin(lon);
+    z_[jj] = std::sin(lat);
+  }
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -16,12 +16,13 @@
 #include "eckit/mpi/Comm.h"
 
 #include "ioda/distribution/Distribution.h"
-#include "ioda/ObsGroup.h"
 
 #include "oops/util/DateTime.h"
 #include "oops/util/ObjectCounter.h"
 #include "oops/util/Printable.h"
 
+#include "ufo/RequiredLevels.h"
+
 namespace eckit {
   class Configuration;
 }
@@ -43,6 +44,12 @@ class Locations : public util::Printable,
 
   /// append locations with more locations
   Locations & operator+=(const Locations &);
+  /// \brief List each location \p ncopies times: the original locations are followed by
+  /// \p ncopies - 1 copies of them (e.g. one per model time slot used by time interpolation).
+  ///
+  /// Same as appending the original locations to themselves \p ncopies - 1 times, but the unit
+  /// vectors are copied rather than recomputed and each array is reallocated only once.
+  void repeat(size_t ncopies);
 
   /// find which observations are in the (\p t1, \p t2] time window
   std::vector<bool> isInTimeWindow(const util::DateTime & t1, const util::DateTime & t2) const;
@@ -52,27 +59,68 @@ class Locations : public util::Printable,
 
   /// accessor to the observations MPI distribution
   const std::shared_ptr<const ioda::Distribution> & distribution() const {return dist_;}
-  /// accessor to observation longitudes (on current MPI task) TO BE CONSOLIDATED
-  std::vector<float> lons() const;
+  /// accessors to observation longitudes (on current MPI task) in single and double precision
+  const std::vector<float> & lons() const {return lonsFloat_;}
   const std::vector<double> & longitudes() const {return lons_;}
-  /// accessor to observation latitudes (on current MPI task) TO BE CONSOLIDATED
-  std::vector<float> lats() const;
+  /// accessors to observation latitudes (on current MPI task) in single and double precision
+  const std::vector<float> & lats() const {return latsFloat_;}
   const std::vector<double> & latitudes() const {return lats_;}
+  /// \brief Cartesian components of the unit vectors pointing from the centre of the Earth to the
+  /// observations (on current MPI task).
+  ///
+  /// These are computed once, when the locations are constructed or appended, so that code
+  /// evaluating many distances between locations does not need to recompute the trigonometric
+  /// functions of their latitudes and longitudes.
+  const std::vector<double> & x() const {return x_;}
+  const std::vector<double> & y() const {return y_;}
+  const std::vector<double> & z() const {return z_;}
   /// accessor to DateTimes (on current MPI task)
   const std::vector<util::DateTime> & times() const {return times_;}
 
+  /// \brief Levels of GeoVaLs variables used by the observation operator that produced these
+  /// locations (see ObsOperatorBase::requiredLevels()).
+  ///
+  /// GeoVaLs constructed for these locations store only these levels of the listed variables.
+  const RequiredLevelsMap & requiredLevels() const {return requiredLevels_;}
+  void setRequiredLevels(const RequiredLevelsMap & levels) {requiredLevels_ = levels;}
+
+  /// \brief Declare that the locations sample the paths of individual observations (e.g.
+  /// slant paths or 2D planes).
+  ///
+  /// Observation \c i is simulated from the GeoVaLs at locations \p pathOffsets[i] to
+  /// \p pathOffsets[i+1] - 1, and location \p pathCentres[i] represents its path as a whole.
+  /// GeoVaLs constructed for these locations store the variables \p perPathVariables (e.g.
+  /// surface fields needed at a single point of each path) only at the locations
+  /// \p pathCentres, i.e. once per observation rather than at every sample.
+  ///
+  /// \p pathOffsets must start at 0, be non-decreasing and end at size(); each path must contain
+  /// its centre.
+  void setPaths(const std::vector<size_t> & pathOffsets, const std::vector<size_t> & pathCentres,
+                const std::vector<std::string> & perPathVariables);
+  /// Number of observation paths (0 unless setPaths() has been called).
+  size_t npaths() const {return pathCentres_.size();}
+  const std::vector<size_t> & pathOffsets() const {return pathOffsets_;}
+  const std::vector<size_t> & pathCentres() const {return pathCentres_;}
+  const std::vector<std::string> & perPathVariables() const {return perPathVariables_;}
+
  private:
-  void initializeObsGroup(size_t nlocs);
+  /// Compute the unit vectors of locations \p first onwards.
+  void appendUnitVectors(size_t first);
   void print(std::ostream & os) const override;
 
   std::shared_ptr<const ioda::Distribution> dist_;   /// observations MPI distribution
-  ioda::ObsGroup og_;  /// observations on current MPI task
-  // Note on implementation: at time of writing, the ObsGroup does not support the util::DateTime
-  // type, so instead of doing expensive conversions of times to/from string representations, we
-  // opt to keep the times outside the ObsGroup.
   std::vector<util::DateTime> times_;  /// times of observations on current MPI task
+  std::vector<float> lonsFloat_;  /// longitudes of observations on current MPI task
+  std::vector<float> latsFloat_;  /// latitudes of observations on current MPI task
   std::vector<double> lons_;  /// longitudes of observations on current MPI task
   std::vector<double> lats_;  /// latitudes of observations on current MPI task
+  std::vector<double> x_;  /// Cartesian components of the unit vectors of the observations
+  std::vector<double> y_;
+  std::vector<double> z_;
+  RequiredLevelsMap requiredLevels_;  /// levels of GeoVaLs variables that need to be stored
+  std::vector<size_t> pathOffsets_;  /// first location of each observation path (see setPaths)
+  std::vector<size_t> pathCentres_;  /// location representing each observation path
+  std::vector<std::string> perPathVariables_;  /// variables stored once per path
 };
 
 }  // namespace ufo
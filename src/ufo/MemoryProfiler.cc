@@ -0,0 +1,296 @@
+/*
+ * (C) Crown copyright 2023, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/MemoryProfiler.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <ostream>
+
+#include "eckit/log/JSON.h"
+#include "eckit/mpi/Comm.h"
+#include "ioda/distribution/Distribution.h"
+#include "ioda/ObsSpace.h"
+
+namespace ufo {
+
+namespace {
+
+const char *categoryName(size_t category) {
+  static const char *names[MemoryProfiler::numCategories] = {
+    "GeoVaLs", "ObsDiagnostics", "trajectories", "filter temporaries"
+  };
+  return names[category];
+}
+
+/// Peak resident set size of the process in bytes (0 if unknown).
+double peakResidentBytes() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0.0;
+#if defined(__APPLE__)
+  return static_cast<double>(usage.ru_maxrss);
+#else
+  return static_cast<double>(usage.ru_maxrss) * 1024.0;
+#endif
+}
+
+/// Profilers indexed by the distribution of their ObsSpace. The registry mutex also protects
+/// the profilers from being destroyed while in use by Usage objects.
+ProfilerRegistry<MemoryProfiler> &registry() {
+  static ProfilerRegistry<MemoryProfiler> profilers;
+  return profilers;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+bool MemoryProfiler::enabled() {
+  static const bool enabled = std::getenv("UFO_MEMORY_PROFILE") != nullptr;
+  return enabled;
+}
+
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<MemoryProfiler> MemoryProfiler::forObsSpace(const ioda::ObsSpace &obsdb) {
+  if (!enabled())
+    return nullptr;
+
+  return registry().getOrCreate(obsdb.distribution().get(), [&] {
+      return std::make_shared<MemoryProfiler>(obsdb, std::getenv("UFO_MEMORY_PROFILE"));
+    });
+}
+
+// -----------------------------------------------------------------------------
+
+MemoryProfiler::MemoryProfiler(const ioda::ObsSpace &obsdb, const std::string &output)
+  : ProfilerBase("MemoryProfiler", obsdb, output), dist_(obsdb.distribution().get())
+{
+  static std::atomic<size_t> lastId(0);
+  id_ = ++lastId;
+}
+
+// -----------------------------------------------------------------------------
+
+MemoryProfiler::~MemoryProfiler() {
+  registry().remove(dist_, this);
+  reportOnDestruction();
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryProfiler::change(Category category, size_t oldBytes, size_t newBytes) {
+  const size_t icat = static_cast<size_t>(category);
+  std::lock_guard<std::mutex> lock(mutex_);
+  bytes_[icat] = bytes_[icat] - oldBytes + newBytes;
+  totalBytes_ = totalBytes_ - oldBytes + newBytes;
+  peakBytes_[icat] = std::max(peakBytes_[icat], bytes_[icat]);
+  peakTotalBytes_ = std::max(peakTotalBytes_, totalBytes_);
+  updateStagePeaks(false);
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryProfiler::updateStagePeaks(bool sampleHeap) {
+  const double heapBytes = sampleHeap ? static_cast<double>(ProfilerBase::heapBytes()) : 0.0;
+  for (StageRecord &stage : stages_) {
+    if (stage.active == 0)
+      continue;
+    stage.peakBytes = std::max(stage.peakBytes, static_cast<double>(totalBytes_));
+    stage.peakHeapBytes = std::max(stage.peakHeapBytes, heapBytes);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+size_t MemoryProfiler::startStage(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t stage = 0;
+  while (stage < stages_.size() && stages_[stage].name != name)
+    ++stage;
+  if (stage == stages_.size()) {
+    stages_.emplace_back();
+    stages_.back().name = name;
+  }
+  ++stages_[stage].active;
+  updateStagePeaks(true);
+  return stage;
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryProfiler::endStage(size_t stage) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  updateStagePeaks(true);
+  --stages_[stage].active;
+}
+
+// -----------------------------------------------------------------------------
+
+MemoryProfiler::Usage::~Usage() {
+  if (bytes_ != 0)
+    update(nullptr, 0);
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryProfiler::Usage::setCategory(Category category) {
+  if (category == category_)
+    return;
+  if (bytes_ != 0) {
+    std::lock_guard<std::mutex> lock(registry().mutex());
+    MemoryProfiler *profiler = registry().find(dist_);
+    if (profiler != nullptr && profiler->id_ == profilerId_) {
+      profiler->change(category_, bytes_, 0);
+      profiler->change(category, 0, bytes_);
+    }
+  }
+  category_ = category;
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryProfiler::Usage::update(const ioda::Distribution *dist, size_t bytes) {
+  if (!enabled())
+    return;
+  std::lock_guard<std::mutex> lock(registry().mutex());
+  // The profiler to which the memory was attributed may have been destroyed since.
+  MemoryProfiler *oldProfiler = bytes_ != 0 ? registry().find(dist_) : nullptr;
+  if (oldProfiler != nullptr && oldProfiler->id_ != profilerId_)
+    oldProfiler = nullptr;
+  MemoryProfiler *newProfiler = bytes != 0 ? registry().find(dist) : nullptr;
+
+  if (oldProfiler == newProfiler) {
+    if (newProfiler != nullptr)
+      newProfiler->change(category_, bytes_, bytes);
+  } else {
+    if (oldProfiler != nullptr)
+      oldProfiler->change(category_, bytes_, 0);
+    if (newProfiler != nullptr)
+      newProfiler->change(category_, 0, bytes);
+  }
+  dist_ = dist;
+  bytes_ = newProfiler != nullptr ? bytes : 0;
+  profilerId_ = newProfiler != nullptr ? newProfiler->id_ : 0;
+}
+
+// -----------------------------------------------------------------------------
+
+MemoryProfiler::Stage::Stage(MemoryProfiler *profiler, const std::string &name)
+  : profiler_(profiler)
+{
+  if (profiler_ != nullptr)
+    stage_ = profiler_->startStage(name);
+}
+
+// -----------------------------------------------------------------------------
+
+MemoryProfiler::Stage::~Stage() {
+  if (profiler_ != nullptr)
+    profiler_->endStage(stage_);
+}
+
+// -----------------------------------------------------------------------------
+
+void MemoryProfiler::report() const {
+  std::vector<StageRecord> stages;
+  std::vector<double> values;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stages = stages_;
+    for (size_t icat = 0; icat < numCategories; ++icat)
+      values.push_back(peakBytes_[icat]);
+    values.push_back(peakTotalBytes_);
+  }
+  values.push_back(peakResidentBytes());
+
+  // All tasks go through the same stages, but not necessarily in the same order.
+  std::sort(stages.begin(), stages.end(), [](const StageRecord &a, const StageRecord &b) {
+      return a.name < b.name;
+    });
+  std::vector<std::string> names;
+  for (const StageRecord &stage : stages)
+    names.push_back(stage.name);
+  if (!sameKeysOnAllTasks(names, "the stages"))
+    return;
+
+  const size_t nfixed = values.size();
+  for (const StageRecord &stage : stages) {
+    values.push_back(stage.peakBytes);
+    values.push_back(stage.peakHeapBytes);
+  }
+  std::vector<double> maxima = values, sums = values;
+  comm_.allReduceInPlace(maxima.begin(), maxima.end(), eckit::mpi::max());
+  comm_.allReduceInPlace(sums.begin(), sums.end(), eckit::mpi::sum());
+
+  const double ntasks = comm_.size();
+  const size_t itotal = numCategories, irss = numCategories + 1;
+  auto writeJson = [&](eckit::JSON &json) {
+    json << "categories";
+    json.startList();
+    for (size_t icat = 0; icat < numCategories; ++icat) {
+      json.startObject();
+      json << "name" << categoryName(icat);
+      json << "peak mean bytes" << sums[icat] / ntasks;
+      json << "peak max bytes" << maxima[icat];
+      json.endObject();
+    }
+    json.endList();
+    json << "total peak mean bytes" << sums[itotal] / ntasks;
+    json << "total peak max bytes" << maxima[itotal];
+    json << "resident set peak mean bytes" << sums[irss] / ntasks;
+    json << "resident set peak max bytes" << maxima[irss];
+    json << "stages";
+    json.startList();
+    for (size_t i = 0; i < stages.size(); ++i) {
+      const size_t j = nfixed + 2 * i;
+      json.startObject();
+      json << "name" << stages[i].name;
+      json << "total peak mean bytes" << sums[j] / ntasks;
+      json << "total peak max bytes" << maxima[j];
+      json << "heap peak mean bytes" << sums[j + 1] / ntasks;
+      json << "heap peak max bytes" << maxima[j + 1];
+      json.endObject();
+    }
+    json.endList();
+  };
+  auto writeTable = [&](std::ostream &os) {
+    const double mb = 1.0 / (1024.0 * 1024.0);
+    os << "MemoryProfiler: " << obsname_ << " (" << comm_.size() << " tasks; high-water marks "
+       << "in MB: mean/max over tasks; heap and resident set: whole process)\n";
+    os << std::fixed << std::setprecision(1);
+    os << std::left << std::setw(28) << "category" << std::right
+       << std::setw(12) << "mean" << std::setw(12) << "max" << "\n";
+    for (size_t i = 0; i < nfixed; ++i) {
+      const char *name = i < numCategories ? categoryName(i)
+                                           : (i == itotal ? "total" : "resident set");
+      os << std::left << std::setw(28) << name << std::right
+         << std::setw(12) << sums[i] / ntasks * mb << std::setw(12) << maxima[i] * mb << "\n";
+    }
+    if (!stages.empty()) {
+      os << std::left << std::setw(28) << "stage" << std::right
+         << std::setw(24) << "total" << std::setw(24) << "heap" << "\n";
+      for (size_t i = 0; i < stages.size(); ++i) {
+        const size_t j = nfixed + 2 * i;
+        os << std::left << std::setw(28) << stages[i].name.substr(0, 27) << std::right
+           << std::setw(12) << sums[j] / ntasks * mb << std::setw(12) << maxima[j] * mb
+           << std::setw(12) << sums[j + 1] / ntasks * mb << std::setw(12) << maxima[j + 1] * mb
+           << "\n";
+      }
+    }
+  };
+  writeReport(writeJson, writeTable);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,142 @@
+/*
+ * (C) Crown copyright 2023, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_MEMORYPROFILER_H_
+#define UFO_MEMORYPROFILER_H_
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "ufo/ProfilerBase.h"
+
+namespace ioda {
+class Distribution;
+class ObsSpace;
+}
+
+namespace ufo {
+
+/// \brief Accounts for the memory held by the largest UFO objects associated with an ObsSpace
+/// and records its high-water marks.
+///
+/// \details Accounting is enabled by setting the environment variable `UFO_MEMORY_PROFILE`.
+/// A single instance of this class is then shared by the observation operators and processors
+/// acting on the same ObsSpace (see forObsSpace()) and kept alive by them. Objects holding
+/// large amounts of memory report the number of bytes they hold through a Usage member, which
+/// attributes them to the ObsSpace whose observations are distributed by the same
+/// ioda::Distribution (GeoVaLs know no more about their ObsSpace). The memory is divided into
+/// these categories:
+///
+/// * `GeoVaLs`: values held by GeoVaLs other than those of ObsDiagnostics;
+/// * `ObsDiagnostics`: values of the diagnostics computed by the observation operators;
+/// * `trajectories`: data kept by the linear observation operators between calls to
+///   setTrajectory() (see LinearObsOperatorBase::trajectoryMemoryBytes()); trajectories shared
+///   by several operators are counted once for each of them;
+/// * `filter temporaries`: ObsFunction values cached by ObsFunctionCache and ObsSpace variables
+///   prefetched by ObsFilterData.
+///
+/// The high-water mark of each category and of their total is recorded. In addition, code
+/// running at a particular stage (e.g. ObsOperator::simulateObs() or the prior filters) opens a
+/// Stage, and for each stage the profiler records the high-water mark of the total while the
+/// stage was active and the largest net heap size (glibc only) seen at its start or end.
+///
+/// When the last operator or processor acting on the ObsSpace is destroyed, the high-water
+/// marks are combined over all MPI tasks (mean and maximum) and written out, together with the
+/// peak resident set size of the process, as described in ProfilerBase.
+class MemoryProfiler : public ProfilerBase {
+ public:
+  enum class Category {GEOVALS, OBSDIAGNOSTICS, TRAJECTORIES, FILTER_TEMPORARIES};
+  static constexpr size_t numCategories = 4;
+
+  /// Return true if memory profiling is enabled.
+  static bool enabled();
+
+  /// \brief Return the profiler shared by all operators and processors acting on \p obsdb,
+  /// creating it if necessary, or null if profiling is disabled.
+  static std::shared_ptr<MemoryProfiler> forObsSpace(const ioda::ObsSpace &obsdb);
+
+  MemoryProfiler(const ioda::ObsSpace &obsdb, const std::string &output);
+  ~MemoryProfiler() override;
+
+  /// \brief The memory held by a single object.
+  ///
+  /// Does nothing unless profiling is enabled and a profiler exists for the ObsSpace the
+  /// memory is attributed to. Copies hold no memory until update() is called. Usage objects
+  /// do not keep profilers alive, so that the report is always written when the last operator
+  /// or processor is destroyed (on all MPI tasks at once).
+  class Usage {
+   public:
+    explicit Usage(Category category) : category_(category) {}
+    Usage(const Usage &other) : category_(other.category_) {}
+    Usage &operator=(const Usage &) {return *this;}
+    ~Usage();
+
+    Category category() const {return category_;}
+    /// Attribute the memory held from now on to the category \p category.
+    void setCategory(Category category);
+    /// \brief Record that the object now holds \p bytes bytes of memory used for the
+    /// observations distributed by \p dist.
+    void update(const ioda::Distribution *dist, size_t bytes);
+
+   private:
+    Category category_;
+    size_t bytes_ = 0;
+    /// Distribution and identifier of the profiler to which bytes_ were attributed.
+    const ioda::Distribution *dist_ = nullptr;
+    size_t profilerId_ = 0;
+  };
+
+  /// \brief Marks a stage as active, from construction to destruction.
+  ///
+  /// Does nothing if the profiler is null.
+  class Stage : private boost::noncopyable {
+   public:
+    Stage(MemoryProfiler *profiler, const std::string &name);
+    ~Stage();
+
+   private:
+    MemoryProfiler *profiler_;
+    size_t stage_ = 0;
+  };
+
+ private:
+  struct StageRecord {
+    std::string name;
+    /// Number of Stage objects currently marking this stage as active.
+    size_t active = 0;
+    double peakBytes = 0.0;
+    double peakHeapBytes = 0.0;
+  };
+
+  /// Record that the memory held in category \p category changed from \p oldBytes to
+  /// \p newBytes.
+  void change(Category category, size_t oldBytes, size_t newBytes);
+  size_t startStage(const std::string &name);
+  void endStage(size_t stage);
+  /// Update the high-water marks of the active stages. Must be called with mutex_ locked.
+  void updateStagePeaks(bool sampleHeap);
+  void report() const override;
+
+  const ioda::Distribution *dist_;
+  /// Distinguishes this profiler from any destroyed earlier for the same distribution.
+  size_t id_;
+  mutable std::mutex mutex_;
+  std::array<size_t, numCategories> bytes_{};
+  std::array<size_t, numCategories> peakBytes_{};
+  size_t totalBytes_ = 0;
+  size_t peakTotalBytes_ = 0;
+  std::vector<StageRecord> stages_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_MEMORYPROFILER_H_
@@ -13,6 +13,8 @@
 #include <iomanip>
 #include <set>
 
+#include "eckit/mpi/Comm.h"
+
 #include "ioda/Engines/EngineUtils.h"
 #include "ioda/Engines/HH.h"
 #include "ioda/Layout.h"
@@ -26,6 +28,7 @@
 
 #include "ufo/ObsBiasIncrement.h"
 #include "ufo/utils/IodaGroupIndices.h"
+#include "ufo/utils/RunOnRootTask.h"
 
 namespace ufo {
 
@@ -33,7 +36,7 @@ namespace ufo {
 
 ObsBias::ObsBias(ioda::ObsSpace & odb, const ObsBiasParameters & params)
   : numStaticPredictors_(0), numVariablePredictors_(0), vars_(odb.assimvariables()),
-    rank_(odb.distribution()->rank()) {
+    rank_(odb.distribution()->rank()), comm_(odb.comm()) {
   oops::Log::trace() << "ObsBias::create starting." << std::endl;
 
   // Predictor factory
@@ -73,8 +76,9 @@ ObsBias::ObsBias(const ObsBias & other, const bool copy)
     prednames_(other.prednames_),
     numStaticPredictors_(other.numStaticPredictors_),
     numVariablePredictors_(other.numVariablePredictors_),
+    chlistNoBC_(other.chlistNoBC_),
     vars_(other.vars_),
-    geovars_(other.geovars_), hdiags_(other.hdiags_), rank_(other.rank_) {
+    geovars_(other.geovars_), hdiags_(other.hdiags_), rank_(other.rank_), comm_(other.comm_) {
   oops::Log::trace() << "ObsBias::copy ctor starting." << std::endl;
 
   // Initialize the biascoeffs
@@ -105,6 +109,7 @@ ObsBias & ObsBias::operator=(const ObsBias & rhs) {
     vars_       = rhs.vars_;
     geovars_    = rhs.geovars_;
     hdiags_     = rhs.hdiags_;
+    chlistNoBC_ = rhs.chlistNoBC_;
     rank_       = rhs.rank_;
   }
   return *this;
@@ -116,39 +121,46 @@ void ObsBias::read(const Parameters_ & params) {
   oops::Log::trace() << "ObsBias::read and initialize from file, starting "<< std::endl;
 
   if (params.inputFile.value() != boost::none) {
-    // Open an hdf5 file with bias coefficients, read only
-    ioda::Engines::BackendNames  backendName = ioda::Engines::BackendNames::Hdf5File;
-    ioda::Engines::BackendCreationParameters backendParams;
-    backendParams.fileName = *params.inputFile.value();
-    backendParams.action   = ioda::Engines::BackendFileActions::Open;
-    backendParams.openMode = ioda::Engines::BackendOpenModes::Read_Only;
-
-    // Create the backend and attach it to an ObsGroup
-    // Use the None DataLyoutPolicy for now to accommodate the current file format
-    ioda::Group backend = constructBackend(backendName, backendParams);
-    ioda::ObsGroup obsgroup = ioda::ObsGroup(backend,
-                   ioda::detail::DataLayoutPolicy::generate(
-                         ioda::detail::DataLayoutPolicy::Policies::None));
-
-    // Read all coefficients into the Eigen array
-    ioda::Variable coeffvar = obsgroup.vars["bias_coefficients"];
-    Eigen::ArrayXXf allbiascoeffs;
-    coeffvar.readWithEigenRegular(allbiascoeffs);
-
-    // Find indices of predictors and variables/channels that we need in the data read from the file
-    const std::vector<int> pred_idx = getRequiredVariableIndices(obsgroup, "predictors",
-                                      prednames_.begin() + numStaticPredictors_, prednames_.end());
-    const std::vector<int> var_idx = getRequiredVarOrChannelIndices(obsgroup, vars_);
-
-    // Filter predictors and channels that we need
-    // FIXME: may be possible by indexing allbiascoeffs(pred_idx, chan_idx) when Eigen 3.4
-    // is available
-
-    for (size_t jpred = 0; jpred < pred_idx.size(); ++jpred) {
-      for (size_t jvar = 0; jvar < var_idx.size(); ++jvar) {
-         biascoeffs_[index(jpred, jvar)] = allbiascoeffs(pred_idx[jpred], var_idx[jvar]);
+    // Read the file on one task only (rather than on all tasks at once, which loads the file
+    // system when there are many tasks and ObsSpaces) and broadcast the coefficients.
+    const size_t root = 0;
+    runOnRootTask(comm_, root, [&] {
+      // Open an hdf5 file with bias coefficients, read only
+      ioda::Engines::BackendNames  backendName = ioda::Engines::BackendNames::Hdf5File;
+      ioda::Engines::BackendCreationParameters backendParams;
+      backendParams.fileName = *params.inputFile.value();
+      backendParams.action   = ioda::Engines::BackendFileActions::Open;
+      backendParams.openMode = ioda::Engines::BackendOpenModes::Read_Only;
+
+      // Create the backend and attach it to an ObsGroup
+      // Use the None DataLyoutPolicy for now to accommodate the current file format
+      ioda::Group backend = constructBackend(backendName, backendParams);
+      ioda::ObsGroup obsgroup = ioda::ObsGroup(backend,
+                     ioda::detail::DataLayoutPolicy::generate(
+                           ioda::detail::DataLayoutPolicy::Policies::None));
+
+      // Read all coefficients into the Eigen array
+      ioda::Variable coeffvar = obsgroup.vars["bias_coefficients"];
+      Eigen::ArrayXXf allbiascoeffs;
+      coeffvar.readWithEigenRegular(allbiascoeffs);
+
+      // Find indices of predictors and variables/channels that we need in the data read from
+      // the file
+      const std::vector<int> pred_idx = getRequiredVariableIndices(
+            obsgroup, "predictors", prednames_.begin() + numStaticPredictors_, prednames_.end());
+      const std::vector<int> var_idx = getRequiredVarOrChannelIndices(obsgroup, vars_);
+
+      // Filter predictors and channels that we need
+      // FIXME: may be possible by indexing allbiascoeffs(pred_idx, chan_idx) when Eigen 3.4
+      // is available
+
+      for (size_t jpred = 0; jpred < pred_idx.size(); ++jpred) {
+        for (size_t jvar = 0; jvar < var_idx.size(); ++jvar) {
+           biascoeffs_[index(jpred, jvar)] = allbiascoeffs(pred_idx[jpred], var_idx[jvar]);
+        }
       }
-    }
+    });
+    comm_.broadcast(biascoeffs_.data(), biascoeffs_.data() + biascoeffs_.size(), root);
   } else {
     if (numVariablePredictors_ > 0)
       oops::Log::warning() << "ObsBias::prior file is NOT available, starting from ZERO"
@@ -21,6 +21,12 @@
 #include "ufo/ObsBiasParameters.h"
 #include "ufo/predictors/PredictorBase.h"
 
+namespace eckit {
+  namespace mpi {
+    class Comm;
+  }
+}
+
 namespace ioda {
   class ObsSpace;
 }
@@ -44,7 +50,8 @@ class ObsBias : public util::Printable,
   ObsBias & operator+=(const ObsBiasIncrement &);
   ObsBias & operator=(const ObsBias &);
 
-  /// Read bias correction coefficients from file
+  /// Read bias correction coefficients from file. The file is read on one MPI task and the
+  /// coefficients are broadcast to the others.
   void read(const Parameters_ &);
   void write(const Parameters_ &) const;
   double norm() const;
@@ -119,6 +126,8 @@ class ObsBias : public util::Printable,
 
   /// MPI rank, used to determine whether the task should output bias coeffs to a file
   size_t rank_;
+  /// Communicator of the ObsSpace, used to broadcast the coefficients read from a file
+  const eckit::mpi::Comm & comm_;
 };
 
 // -----------------------------------------------------------------------------
@@ -6,6 +6,7 @@
  */
 
 #include <Eigen/Core>
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <memory>
@@ -14,7 +15,9 @@
 
 #include "ufo/ObsBiasCovariance.h"
 
-#include "ioda/distribution/Accumulator.h"
+#include "eckit/mpi/Comm.h"
+
+#include "ioda/distribution/Distribution.h"
 #include "ioda/Engines/EngineUtils.h"
 #include "ioda/Engines/HH.h"
 #include "ioda/Layout.h"
@@ -31,6 +34,8 @@
 #include "ufo/ObsBiasPreconditioner.h"
 #include "ufo/predictors/PredictorBase.h"
 #include "ufo/utils/IodaGroupIndices.h"
+#include "ufo/utils/ReproducibleSum.h"
+#include "ufo/utils/RunOnRootTask.h"
 
 namespace ufo {
 
@@ -135,45 +140,53 @@ void ObsBiasCovariance::read(const ObsBiasCovariancePriorParameters & params) {
   oops::Log::trace() << "ObsBiasCovariance::read from file " << std::endl;
 
   if (params.inputFile.value() != boost::none) {
-    // Open an hdf5 file, read only
-    ioda::Engines::BackendNames  backendName = ioda::Engines::BackendNames::Hdf5File;
-    ioda::Engines::BackendCreationParameters backendParams;
-    backendParams.fileName = *params.inputFile.value();
-    backendParams.action   = ioda::Engines::BackendFileActions::Open;
-    backendParams.openMode = ioda::Engines::BackendOpenModes::Read_Only;
-
-    // Create the backend and attach it to an ObsGroup
-    // Use the None DataLyoutPolicy for now to accommodate the current file format
-    ioda::Group backend = constructBackend(backendName, backendParams);
-    ioda::ObsGroup obsgroup = ioda::ObsGroup(backend,
-                   ioda::detail::DataLayoutPolicy::generate(
-                         ioda::detail::DataLayoutPolicy::Policies::None));
-
-    // Read coefficients error variances into the Eigen array
-    ioda::Variable bcerrvar = obsgroup.vars["bias_coeff_errors"];
-    Eigen::ArrayXXf allbcerrors;
-    bcerrvar.readWithEigenRegular(allbcerrors);
-
-    // Read nobs into Eigen array
-    ioda::Variable nobsvar = obsgroup.vars["number_obs_assimilated"];
-    Eigen::ArrayXf nobsassim;
-    nobsvar.readWithEigenRegular(nobsassim);
-
-    // Find indices of predictors and variables/channels that we need in the data read from the file
-    const std::vector<int> pred_idx = getRequiredVariableIndices(obsgroup, "predictors",
-                                              prednames_.begin(), prednames_.end());
-    const std::vector<int> var_idx = getRequiredVarOrChannelIndices(obsgroup, vars_);
-
-    // Filter predictors and channels that we need
-    // FIXME: may be possible by indexing allbcerrors(pred_idx, chan_idx) when Eigen 3.4
-    // is available
-    for (size_t jvar = 0; jvar < var_idx.size(); ++jvar) {
-      obs_num_[jvar] = nobsassim(var_idx[jvar]);
-      for (size_t jpred = 0; jpred < pred_idx.size(); ++jpred) {
-        analysis_variances_[jvar*pred_idx.size()+jpred] =
-             allbcerrors(pred_idx[jpred], var_idx[jvar]);
+    // Read the file on one task only and broadcast its contents to the others.
+    const eckit::mpi::Comm & comm = odb_.comm();
+    const size_t root = 0;
+    runOnRootTask(comm, root, [&] {
+      // Open an hdf5 file, read only
+      ioda::Engines::BackendNames  backendName = ioda::Engines::BackendNames::Hdf5File;
+      ioda::Engines::BackendCreationParameters backendParams;
+      backendParams.fileName = *params.inputFile.value();
+      backendParams.action   = ioda::Engines::BackendFileActions::Open;
+      backendParams.openMode = ioda::Engines::BackendOpenModes::Read_Only;
+
+      // Create the backend and attach it to an ObsGroup
+      // Use the None DataLyoutPolicy for now to accommodate the current file format
+      ioda::Group backend = constructBackend(backendName, backendParams);
+      ioda::ObsGroup obsgroup = ioda::ObsGroup(backend,
+                     ioda::detail::DataLayoutPolicy::generate(
+                           ioda::detail::DataLayoutPolicy::Policies::None));
+
+      // Read coefficients error variances into the Eigen array
+      ioda::Variable bcerrvar = obsgroup.vars["bias_coeff_errors"];
+      Eigen::ArrayXXf allbcerrors;
+      bcerrvar.readWithEigenRegular(allbcerrors);
+
+      // Read nobs into Eigen array
+      ioda::Variable nobsvar = obsgroup.vars["number_obs_assimilated"];
+      Eigen::ArrayXf nobsassim;
+      nobsvar.readWithEigenRegular(nobsassim);
+
+      // Find indices of predictors and variables/channels that we need in the data read from
+      // the file
+      const std::vector<int> pred_idx = getRequiredVariableIndices(obsgroup, "predictors",
+                                                prednames_.begin(), prednames_.end());
+      const std::vector<int> var_idx = getRequiredVarOrChannelIndices(obsgroup, vars_);
+
+      // Filter predictors and channels that we need
+      // FIXME: may be possible by indexing allbcerrors(pred_idx, chan_idx) when Eigen 3.4
+      // is available
+      for (size_t jvar = 0; jvar < var_idx.size(); ++jvar) {
+        obs_num_[jvar] = nobsassim(var_idx[jvar]);
+        for (size_t jpred = 0; jpred < pred_idx.size(); ++jpred) {
+          analysis_variances_[jvar*pred_idx.size()+jpred] =
+               allbcerrors(pred_idx[jpred], var_idx[jvar]);
+        }
       }
-    }
+    });
+    comm.broadcast(obs_num_.begin(), obs_num_.end(), root);
+    comm.broadcast(analysis_variances_.begin(), analysis_variances_.end(), root);
   }
   oops::Log::trace() << "ObsBiasCovariance::read is done " << std::endl;
 }
@@ -252,27 +265,34 @@ void ObsBiasCovariance::linearize(const ObsBias & bias, const eckit::Configurati
     // Retrieve the QC flags and do statistics from second outer loop
     const int jouter = innerConf.getInt("iteration");
     if (jouter >= 1) {
-      std::unique_ptr<ioda::Accumulator<std::vector<size_t>>> obs_num_accumulator =
-          odb_.distribution()->createAccumulator<size_t>(obs_num_.size());
+      const std::size_t nlocs = odb_.nlocs();
+      const std::size_t npreds = prednames_.size();
+      const std::size_t nhessian = ht_rinv_h_.size();
+
+      // Count each observation only once across all the MPI tasks.
+      std::vector<bool> patchObs(nlocs);
+      odb_.distribution()->patchObs(patchObs);
+
+      // Local contributions to ht_rinv_h_ followed by those to obs_num_ (stored as doubles, which
+      // represent them exactly), so that a single reduction is enough.
+      std::vector<double> sums(nhessian + obs_num_.size(), 0.0);
+      double * const obsNum = sums.data() + nhessian;
 
       // Retrieve the QC flags of previous outer loop and recalculate the number of effective obs.
       const std::string qc_group_name = "EffectiveQC" + std::to_string(jouter-1);
       const std::vector<std::string> vars = odb_.obsvariables().variables();
-      std::vector<int> qc_flags(odb_.nlocs(), 999);
+      std::vector<int> qc_flags(nlocs, 999);
       for (std::size_t jvar = 0; jvar < vars.size(); ++jvar) {
         if (odb_.has(qc_group_name, vars[jvar])) {
           odb_.get_db(qc_group_name, vars[jvar], qc_flags);
           for (std::size_t jloc = 0; jloc < qc_flags.size(); ++jloc)
-            if (qc_flags[jloc] == 0)
-              obs_num_accumulator->addTerm(jloc, jvar, 1);
+            if (qc_flags[jloc] == 0 && patchObs[jloc])
+              obsNum[jvar] += 1;
         } else {
           throw eckit::UserError("Unable to find QC flags : " + vars[jvar] + "@" + qc_group_name);
         }
       }
 
-      // Sum across the processors
-      obs_num_ = obs_num_accumulator->computeResult();
-
       const float missing = util::missingValue(missing);
 
       // compute the hessian contribution from Jo bias terms channel by channel
@@ -292,28 +312,72 @@ void ObsBiasCovariance::linearize(const ObsBias & bias, const eckit::Configurati
         }
       }
 
+      // retrieve the predictors
+      std::vector<ioda::ObsVector> predx;
+      predx.reserve(npreds);
+      for (std::size_t p = 0; p < npreds; ++p) {
+        predx.emplace_back(odb_, prednames_[p] + "Predictor");
+        ASSERT(r_inv.nlocs() == predx[p].nlocs());
+        ASSERT(r_inv.nvars() == predx[p].nvars());
+      }
+
       // compute \mathrm{H}_\beta^\intercal \mathrm{R}^{-1} \mathrm{H}_\beta
+      // (only keep the diagonal)
       // -----------------------------------------
-      std::unique_ptr<ioda::Accumulator<std::vector<double>>> ht_rinv_h_accumulator =
-          odb_.distribution()->createAccumulator<double>(ht_rinv_h_.size());
-      for (std::size_t p = 0; p < prednames_.size(); ++p) {
-        // retrieve the predictors
-        const ioda::ObsVector predx(odb_, prednames_[p] + "Predictor");
-
-        // for each variable
-        ASSERT(r_inv.nlocs() == predx.nlocs());
-        std::size_t nvars = predx.nvars();
-        // only keep the diagnoal
-        for (size_t vv = 0; vv < nvars; ++vv) {
-          for (size_t ii = 0; ii < predx.nlocs(); ++ii)
-            ht_rinv_h_accumulator->addTerm(ii,
-                                           vv*prednames_.size() + p,
-                                           pow(predx[ii*nvars + vv], 2) * r_inv[ii*nvars + vv]);
+      // The locations are split into blocks of a fixed size, summed in parallel, and the partial
+      // sums are then added in block order, so that the result does not depend on the number of
+      // threads. In the reproducible reduction mode the sums are exact, so that they do not
+      // depend on the number of tasks either.
+      const std::size_t blockSize = 1024;
+      const int nblocks = (r_inv.nlocs() + blockSize - 1) / blockSize;
+      auto addBlock = [&](int jblock, auto & blockSum) {
+        const std::size_t blockEnd = std::min((jblock + 1) * blockSize, r_inv.nlocs());
+        for (std::size_t ii = jblock * blockSize; ii < blockEnd; ++ii) {
+          if (!patchObs[ii])
+            continue;
+          for (std::size_t vv = 0; vv < nvars; ++vv)
+            for (std::size_t p = 0; p < npreds; ++p)
+              blockSum(vv*npreds + p, pow(predx[p][ii*nvars + vv], 2) * r_inv[ii*nvars + vv]);
         }
-      }
+      };
+
+      if (reproducibleReductions()) {
+        std::vector<ReproducibleSum> exactSums(sums.size());
+#pragma omp parallel
+        {
+          std::vector<ReproducibleSum> threadSums(nhessian);
+          auto blockSum = [&](std::size_t j, double term) { threadSums[j].add(term); };
+#pragma omp for schedule(dynamic) nowait
+          for (int jblock = 0; jblock < nblocks; ++jblock)
+            addBlock(jblock, blockSum);
+#pragma omp critical
+          for (std::size_t j = 0; j < nhessian; ++j)
+            exactSums[j] += threadSums[j];
+        }
+        for (std::size_t j = 0; j < obs_num_.size(); ++j)
+          exactSums[nhessian + j].add(obsNum[j]);
+        sums = allReduceValues(exactSums, [&](std::vector<double> & packed) {
+          odb_.distribution()->allReduceInPlace(packed, eckit::mpi::sum());
+        });
+      } else {
+        std::vector<double> blockSums(nblocks * nhessian, 0.0);
+#pragma omp parallel for schedule(dynamic)
+        for (int jblock = 0; jblock < nblocks; ++jblock) {
+          double * const blockSum = blockSums.data() + jblock * nhessian;
+          auto addTerm = [blockSum](std::size_t j, double term) { blockSum[j] += term; };
+          addBlock(jblock, addTerm);
+        }
+        for (int jblock = 0; jblock < nblocks; ++jblock)
+          for (std::size_t j = 0; j < nhessian; ++j)
+            sums[j] += blockSums[jblock * nhessian + j];
 
-      // Sum the hessian contributions across the tasks
-      ht_rinv_h_ = ht_rinv_h_accumulator->computeResult();
+        // Sum the hessian contributions and the numbers of effective obs across the tasks
+        odb_.distribution()->allReduceInPlace(sums, eckit::mpi::sum());
+      }
+      ht_rinv_h_.assign(sums.begin(), sums.begin() + nhessian);
+      const double * const totalObsNum = sums.data() + nhessian;
+      for (std::size_t j = 0; j < obs_num_.size(); ++j)
+        obs_num_[j] = static_cast<std::size_t>(totalObsNum[j]);
     }
 
     // reset variances for bias predictor coeff. based on current data count
@@ -11,8 +11,11 @@
 #include <string>
 #include <vector>
 
+#include "eckit/exception/Exceptions.h"
 #include "oops/base/Variables.h"
+#include "oops/util/missingValues.h"
 #include "ufo/Locations.h"
+#include "ufo/MemoryProfiler.h"
 
 #include "ioda/ObsSpace.h"
 
@@ -23,19 +26,40 @@ namespace ufo {
 ObsDiagnostics::ObsDiagnostics(const ioda::ObsSpace & os, const Locations & locs,
                                const oops::Variables & vars)
   : obsdb_(os), gdiags_(locs, vars)
-{}
+{
+  gdiags_.trackMemoryUsage(MemoryProfiler::Category::OBSDIAGNOSTICS);
+}
 
 // -----------------------------------------------------------------------------
 
 ObsDiagnostics::ObsDiagnostics(const Parameters_ & params, const ioda::ObsSpace & os,
                                const oops::Variables & vars)
   : obsdb_(os), gdiags_(params, os, vars)
-{}
+{
+  gdiags_.trackMemoryUsage(MemoryProfiler::Category::OBSDIAGNOSTICS);
+}
 
 // -----------------------------------------------------------------------------
 
 void ObsDiagnostics::allocate(const int nlev, const oops::Variables & vars) {
-  gdiags_.allocate(nlev, vars);
+  for (size_t jvar = 0; jvar < vars.size(); ++jvar) {
+    const std::string & var = vars[jvar];
+    if (!gdiags_.has(var))
+      throw eckit::BadParameter("ObsDiagnostics::allocate: " + var +
+                                " doesn't exist in ObsDiagnostics", Here());
+    const auto pending = pendingAllocations_.find(var);
+    if (pending != pendingAllocations_.end()) {
+      if (pending->second != nlev)
+        throw eckit::BadParameter("ObsDiagnostics::allocate: " + var + " was previously " +
+                                  "allocated with a different number of levels", Here());
+    } else if (gdiags_.nlevs(var) == 0) {
+      // Not allocated yet
+      pendingAllocations_[var] = nlev;
+    } else if (gdiags_.nlevs(var) != static_cast<size_t>(nlev)) {
+      throw eckit::BadParameter("ObsDiagnostics::allocate: " + var + " was previously " +
+                                "allocated with a different number of levels", Here());
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -43,17 +67,44 @@ void ObsDiagnostics::allocate(const int nlev, const oops::Variables & vars) {
 void ObsDiagnostics::save(const std::vector<double> & vals,
                           const std::string & var,
                           const int lev) {
+  const auto pending = pendingAllocations_.find(var);
+  if (pending != pendingAllocations_.end()) {
+    gdiags_.allocate(pending->second, oops::Variables({var}));
+    pendingAllocations_.erase(pending);
+    // Levels that are never saved must not hold undefined values.
+    const double missing = util::missingValue(missing);
+    const std::vector<double> missingVals(vals.size(), missing);
+    for (size_t jlev = 0; jlev < gdiags_.nlevs(var); ++jlev)
+      if (static_cast<int>(jlev) != lev)
+        gdiags_.putAtLevel(missingVals, var, jlev);
+  }
   gdiags_.putAtLevel(vals, var, lev);
 }
 
 // -----------------------------------------------------------------------------
 
 size_t ObsDiagnostics::nlevs(const std::string & var) const {
+  const auto pending = pendingAllocations_.find(var);
+  if (pending != pendingAllocations_.end())
+    return pending->second;
   return gdiags_.nlevs(var);
 }
 
 // -----------------------------------------------------------------------------
 
+void ObsDiagnostics::allocatePending() const {
+  const double missing = util::missingValue(missing);
+  for (const auto & pending : pendingAllocations_) {
+    gdiags_.allocate(pending.second, oops::Variables({pending.first}));
+    const std::vector<double> missingVals(gdiags_.nlocs(), missing);
+    for (int jlev = 0; jlev < pending.second; ++jlev)
+      gdiags_.putAtLevel(missingVals, pending.first, jlev);
+  }
+  pendingAllocations_.clear();
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsDiagnostics::print(std::ostream & os) const {
   os << "ObsDiagnostics not printing yet.";
 }
@@ -8,12 +8,16 @@
 #ifndef UFO_OBSDIAGNOSTICS_H_
 #define UFO_OBSDIAGNOSTICS_H_
 
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <vector>
 
 #include <boost/noncopyable.hpp>
 
+#include "oops/util/missingValues.h"
 #include "oops/util/Printable.h"
 #include "ufo/GeoVaLs.h"
 
@@ -47,32 +51,63 @@ class ObsDiagnostics : public util::Printable,
   ///          Fails if one of \p vars is already allocated with a number of levels
   ///          different than \p nlev; doesn't reallocate variables that are already
   ///          allocated with \p nlev.
+  ///
+  ///          The memory is only allocated when a value of the variable is first saved (or the
+  ///          diagnostics are written or copied); until then, get() returns missing values.
+  ///          Diagnostics computed for many channels, of which the filters only read a few,
+  ///          therefore cost no memory unless they are saved.
   void allocate(const int nlev, const oops::Variables & vars);
 
   void save(const std::vector<double> &, const std::string &, const int);
 
 // Interfaces
-  int & toFortran() {return gdiags_.toFortran();}
-  const int & toFortran() const {return gdiags_.toFortran();}
+  // Fortran code expects all variables passed to allocate() to be allocated.
+  int & toFortran() {allocatePending(); return gdiags_.toFortran();}
+  const int & toFortran() const {allocatePending(); return gdiags_.toFortran();}
 
   bool has(const std::string & var) const {return gdiags_.has(var);}
+  /// Return true if no diagnostics have been requested.
+  bool empty() const {return gdiags_.getVars().size() == 0;}
   size_t nlevs(const std::string &) const;
   template <typename T>
   void get(std::vector<T> & vals, const std::string & var, const int lev) const {
+    if (pendingAllocations_.count(var)) {
+      const T missing = util::missingValue(missing);
+      std::fill(vals.begin(), vals.end(), missing);
+      return;
+    }
     gdiags_.getAtLevel(vals, var, lev);
   }
   template <typename T>
   void get(std::vector<T> & vals, const std::string & var) const {
+    if (pendingAllocations_.count(var)) {
+      const T missing = util::missingValue(missing);
+      std::fill(vals.begin(), vals.end(), missing);
+      return;
+    }
     gdiags_.get(vals, var);
   }
 
   void write(const Parameters_ & params) const {
+    allocatePending();
     gdiags_.write(params);}
+  /// \brief Return a copy of the diagnostics (e.g. to be written in the background with
+  /// GeoVaLs::writeInBackground while these diagnostics are modified).
+  std::unique_ptr<GeoVaLs> snapshot() const {
+    allocatePending();
+    return std::unique_ptr<GeoVaLs>(new GeoVaLs(gdiags_));}
  private:
   void print(std::ostream &) const;
+  /// Allocate all variables passed to allocate() but not saved yet and fill them with missing
+  /// values.
+  void allocatePending() const;
+
   const ioda::ObsSpace & obsdb_;
 
-  GeoVaLs gdiags_;
+  // Mutable since variables whose allocation is pending are allocated by const methods.
+  mutable GeoVaLs gdiags_;
+  /// Number of levels of the variables passed to allocate() but not allocated yet.
+  mutable std::map<std::string, int> pendingAllocations_;
 };
 
 // -----------------------------------------------------------------------------
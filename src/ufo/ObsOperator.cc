@@ -7,6 +7,9 @@
 
 #include "ufo/ObsOperator.h"
 
+#include <utility>
+#include <vector>
+
 #include "ioda/ObsSpace.h"
 #include "ioda/ObsVector.h"
 
@@ -15,17 +18,29 @@
 
 #include "ufo/GeoVaLs.h"
 #include "ufo/Locations.h"
+#include "ufo/MemoryProfiler.h"
 #include "ufo/ObsBias.h"
 #include "ufo/ObsBiasOperator.h"
 #include "ufo/ObsDiagnostics.h"
 #include "ufo/ObsOperatorBase.h"
+#include "ufo/OperatorProfiler.h"
+#include "ufo/utils/GeoVaLsSnapshot.h"
+#include "ufo/utils/LocationChunks.h"
 
 namespace ufo {
 
 // -----------------------------------------------------------------------------
 
 ObsOperator::ObsOperator(ioda::ObsSpace & os, const Parameters_ & params)
-  : oper_(ObsOperatorFactory::create(os, params.operatorParameters)), odb_(os)
+  : oper_(ObsOperatorFactory::create(os, params.operatorParameters)), odb_(os),
+    profiler_(OperatorProfiler::create(os, params.operatorParameters.value().name.value().value(),
+                                       {"simulateObs"})),
+    memoryProfiler_(MemoryProfiler::forObsSpace(os)),
+    maxNumLocationsPerChunk_(params.operatorParameters.value().maxNumLocationsPerChunk.value()
+                             .value_or(0)),
+    recomputeOnlyChangedLocations_(
+      params.operatorParameters.value().recomputeOnlyChangedLocations),
+    relativeChangeThreshold_(params.operatorParameters.value().relativeChangeThreshold)
 {
   // We use += rather than = to make sure the Variables objects contain no duplicate entries.
   oops::Variables operatorVars;
@@ -42,10 +57,25 @@ ObsOperator::ObsOperator(ioda::ObsSpace & os, const Parameters_ & params)
 
 // -----------------------------------------------------------------------------
 
+ObsOperator::~ObsOperator() {}
+
+// -----------------------------------------------------------------------------
+
 void ObsOperator::simulateObs(const GeoVaLs & gvals, ioda::ObsVector & yy,
                               const ObsBias & biascoeff, ioda::ObsVector & ybias,
                               ObsDiagnostics & ydiags) const {
-  oper_->simulateObs(gvals, yy, ydiags);
+  OperatorProfiler::Measurement measurement(profiler_.get(), 0, yy.nlocs(), yy.nvars());
+  MemoryProfiler::Stage stage(memoryProfiler_.get(), "simulateObs");
+  if (recomputeOnlyChangedLocations_ && oper_->supportsLocationRanges() && ydiags.empty()) {
+    simulateObsAtChangedLocations(gvals, yy, ydiags);
+  } else if (maxNumLocationsPerChunk_ > 0 && oper_->supportsLocationRanges()) {
+    forEachLocationChunk(yy.nlocs(), maxNumLocationsPerChunk_, oper_->isThreadSafe(),
+                         [&](size_t begin, size_t end) {
+                           oper_->simulateObsAtLocations(gvals, yy, ydiags, begin, end);
+                         });
+  } else {
+    oper_->simulateObs(gvals, yy, ydiags);
+  }
   if (biascoeff) {
     ObsBiasOperator biasoper(odb_);
     biasoper.computeObsBias(gvals, ybias, biascoeff, ydiags);
@@ -56,6 +86,58 @@ void ObsOperator::simulateObs(const GeoVaLs & gvals, ioda::ObsVector & yy,
 
 // -----------------------------------------------------------------------------
 
+void ObsOperator::simulateObsAtChangedLocations(const GeoVaLs & gvals, ioda::ObsVector & yy,
+                                                ObsDiagnostics & ydiags) const {
+  const size_t nlocs = yy.nlocs();
+  const size_t nvars = yy.nvars();
+
+  // Ranges of consecutive locations at which the observations need to be simulated.
+  std::vector<std::pair<size_t, size_t>> ranges;
+  std::vector<bool> changed;
+  const bool reuse = previousGeoVaLs_ && previousHofX_.size() == nlocs * nvars &&
+      previousGeoVaLs_->changedLocations(gvals, relativeChangeThreshold_, changed);
+  if (reuse) {
+    for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+      if (changed[jloc]) {
+        if (!ranges.empty() && ranges.back().second == jloc)
+          ++ranges.back().second;
+        else
+          ranges.emplace_back(jloc, jloc + 1);
+      } else {
+        for (size_t jvar = 0; jvar < nvars; ++jvar)
+          yy[jloc * nvars + jvar] = previousHofX_[jloc * nvars + jvar];
+      }
+    }
+  } else {
+    ranges.emplace_back(0, nlocs);
+  }
+
+  forEachLocationRange(splitLocationRanges(ranges, maxNumLocationsPerChunk_),
+                       oper_->isThreadSafe(),
+                       [&](size_t begin, size_t end) {
+                         oper_->simulateObsAtLocations(gvals, yy, ydiags, begin, end);
+                       });
+
+  // Only the locations just recomputed are updated, so that slow changes smaller than the
+  // threshold cannot accumulate unnoticed.
+  if (!reuse) {
+    previousGeoVaLs_.reset(new GeoVaLsSnapshot(gvals, oper_->requiredVars().variables()));
+    previousHofX_.resize(nlocs * nvars);
+  } else {
+    previousGeoVaLs_->update(gvals, changed);
+  }
+  size_t nrecomputed = 0;
+  for (const std::pair<size_t, size_t> & range : ranges) {
+    nrecomputed += range.second - range.first;
+    for (size_t jval = range.first * nvars; jval < range.second * nvars; ++jval)
+      previousHofX_[jval] = yy[jval];
+  }
+  oops::Log::debug() << "ObsOperator: model equivalents recomputed at " << nrecomputed
+                     << " of " << nlocs << " locations" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
 const oops::Variables & ObsOperator::requiredVars() const {
   return oper_->requiredVars();
 }
@@ -63,7 +145,9 @@ const oops::Variables & ObsOperator::requiredVars() const {
 // -----------------------------------------------------------------------------
 
 std::unique_ptr<Locations> ObsOperator::locations() const {
-  return oper_->locations();
+  std::unique_ptr<Locations> locs = oper_->locations();
+  locs->setRequiredLevels(oper_->requiredLevels());
+  return locs;
 }
 
 // -----------------------------------------------------------------------------
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/noncopyable.hpp>
 
@@ -29,9 +30,12 @@ namespace ioda {
 
 namespace ufo {
   class GeoVaLs;
+  class GeoVaLsSnapshot;
   class Locations;
+  class MemoryProfiler;
   class ObsBias;
   class ObsDiagnostics;
+  class OperatorProfiler;
 
 // -----------------------------------------------------------------------------
 
@@ -41,6 +45,7 @@ class ObsOperator : public util::Printable,
   typedef ObsOperatorParametersWrapper Parameters_;
 
   ObsOperator(ioda::ObsSpace &, const Parameters_ &);
+  ~ObsOperator();
 
 /// Obs Operator
   void simulateObs(const GeoVaLs &, ioda::ObsVector &, const ObsBias &, ioda::ObsVector &,
@@ -54,8 +59,28 @@ class ObsOperator : public util::Printable,
 
  private:
   void print(std::ostream &) const;
+  /// Simulate the observations at locations where the GeoVaLs have changed since the previous
+  /// call and copy the previous model equivalents elsewhere.
+  void simulateObsAtChangedLocations(const GeoVaLs &, ioda::ObsVector &, ObsDiagnostics &) const;
+
   std::unique_ptr<ObsOperatorBase> oper_;
   ioda::ObsSpace & odb_;
+  /// Null unless operator profiling is enabled.
+  std::unique_ptr<OperatorProfiler> profiler_;
+  /// Null unless memory profiling is enabled.
+  std::shared_ptr<MemoryProfiler> memoryProfiler_;
+  /// Maximum number of locations passed to each call to the operator's simulateObsAtLocations()
+  /// method (0 if the operator is applied to all locations at once).
+  size_t maxNumLocationsPerChunk_;
+  /// True if the model equivalents should be recomputed only at locations where the GeoVaLs
+  /// have changed since the previous call to simulateObs().
+  bool recomputeOnlyChangedLocations_;
+  /// Relative change of a GeoVaL above which the model equivalent at its location is recomputed.
+  double relativeChangeThreshold_;
+  /// GeoVaLs from which the model equivalents stored in previousHofX_ were computed.
+  mutable std::unique_ptr<GeoVaLsSnapshot> previousGeoVaLs_;
+  /// Model equivalents (without bias correction) computed by the previous call to simulateObs().
+  mutable std::vector<double> previousHofX_;
 };
 
 // -----------------------------------------------------------------------------
@@ -9,6 +9,7 @@
 
 #include <vector>
 
+#include "eckit/exception/Exceptions.h"
 #include "ioda/ObsSpace.h"
 #include "oops/util/abor1_cpp.h"
 #include "oops/util/Logger.h"
@@ -30,6 +31,14 @@ std::unique_ptr<Locations> ObsOperatorBase::locations() const {
 
 // -----------------------------------------------------------------------------
 
+void ObsOperatorBase::simulateObsAtLocations(const GeoVaLs &, ioda::ObsVector &,
+                                             ObsDiagnostics &, size_t, size_t) const {
+  throw eckit::NotImplemented("This observation operator cannot simulate observations at a "
+                              "subset of locations", Here());
+}
+
+// -----------------------------------------------------------------------------
+
 oops::Variables ObsOperatorBase::simulatedVars() const {
   return odb_.assimvariables();
 }
@@ -21,6 +21,7 @@
 #include "oops/util/parameters/RequiredPolymorphicParameter.h"
 #include "oops/util/Printable.h"
 #include "ufo/ObsOperatorParametersBase.h"
+#include "ufo/RequiredLevels.h"
 
 #include "ufo/utils/VariableNameMap.h"
 
@@ -57,9 +58,39 @@ class ObsOperatorBase : public util::Printable,
 /// Obs Operator
   virtual void simulateObs(const GeoVaLs &, ioda::ObsVector &, ObsDiagnostics &) const = 0;
 
+/// \brief Return true if simulateObsAtLocations() is implemented, i.e. if the operator can
+/// simulate the observations at a range of locations independently of all other locations.
+///
+/// The default implementation returns false.
+  virtual bool supportsLocationRanges() const {return false;}
+
+/// \brief Return true if simulateObsAtLocations() may be called concurrently for disjoint
+/// ranges of locations.
+///
+/// The default implementation returns false.
+  virtual bool isThreadSafe() const {return false;}
+
+/// \brief Simulate the observations at locations \p begin to \p end - 1, leaving the other
+/// elements of the output vector unchanged.
+///
+/// Called by ObsOperator in place of simulateObs() if the `max number of locations per chunk`
+/// option is set and supportsLocationRanges() returns true. The default implementation throws
+/// an exception.
+  virtual void simulateObsAtLocations(const GeoVaLs &, ioda::ObsVector &, ObsDiagnostics &,
+                                      size_t begin, size_t end) const;
+
 /// Operator input required from Model
   virtual const oops::Variables & requiredVars() const = 0;
 
+/// \brief Levels of the required variables used by this operator.
+///
+/// GeoVaLs passed to simulateObs() (and to the corresponding linear operator, if any) store only
+/// these levels of the listed variables, reducing their size when the operator uses only a few
+/// levels of a model with many. Unlisted variables store all levels.
+///
+/// The default implementation returns an empty map.
+  virtual RequiredLevelsMap requiredLevels() const {return RequiredLevelsMap();}
+
 /// Locations for GeoVaLs
   virtual std::unique_ptr<Locations> locations() const;
 
@@ -10,6 +10,7 @@
 
 #include <string>
 
+#include "oops/util/parameters/NumericConstraints.h"
 #include "oops/util/parameters/OptionalParameter.h"
 #include "oops/util/parameters/Parameter.h"
 #include "oops/util/parameters/Parameters.h"
@@ -39,6 +40,33 @@ class ObsOperatorParametersBase : public oops::Parameters {
 
   /// \brief Parameter specifying path to yaml file containing Observation to GeoVaL name mapping
   oops::OptionalParameter<std::string> AliasFile{"observation alias file", this};
+
+  /// \brief If true, linear operators able to provide their matrix (see
+  /// LinearObsOperatorBase::matrix()) are applied by multiplying with that matrix rather than by
+  /// calling their simulateObsTL() and simulateObsAD() methods. Ignored by nonlinear operators.
+  oops::Parameter<bool> applyAsSparseMatrix{"apply as sparse matrix", false, this};
+
+  /// \brief If set, operators able to process a range of locations independently of the others
+  /// (see ObsOperatorBase::supportsLocationRanges()) are applied to consecutive chunks of at most
+  /// this many locations rather than to all locations at once. This bounds the size of the
+  /// operator's work arrays; chunks are processed concurrently by operators declaring themselves
+  /// thread-safe. Ignored by other operators.
+  oops::OptionalParameter<int> maxNumLocationsPerChunk{"max number of locations per chunk", this,
+                                                       {oops::minConstraint(1)}};
+
+  /// \brief If true, operators able to process a range of locations independently of the others
+  /// (see ObsOperatorBase::supportsLocationRanges()) and computing no diagnostics recompute the
+  /// model equivalents only at locations where the GeoVaLs have changed since the previous call
+  /// and reuse the previous model equivalents elsewhere. This requires a copy of the GeoVaLs
+  /// and model equivalents to be kept between calls. Ignored by linear operators.
+  oops::Parameter<bool> recomputeOnlyChangedLocations{"recompute only changed locations", false,
+                                                      this};
+
+  /// \brief Used if `recompute only changed locations` is true: the model equivalent at a
+  /// location is recomputed only if some GeoVaL at that location has changed by more than this
+  /// fraction of its previous absolute value. By default any change triggers recomputation.
+  oops::Parameter<double> relativeChangeThreshold{"relative change threshold", 0.0, this,
+                                                  {oops::minConstraint(0.0)}};
 };
 
 // -----------------------------------------------------------------------------
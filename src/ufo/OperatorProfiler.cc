@@ -0,0 +1,125 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/OperatorProfiler.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <ostream>
+
+#include "eckit/log/JSON.h"
+#include "eckit/mpi/Comm.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+std::unique_ptr<OperatorProfiler> OperatorProfiler::create(
+    const ioda::ObsSpace &obsdb, const std::string &name,
+    const std::vector<std::string> &methods) {
+  const char *output = std::getenv("UFO_OPERATOR_PROFILE");
+  if (output == nullptr)
+    return nullptr;
+  return std::make_unique<OperatorProfiler>(obsdb, name, methods, output);
+}
+
+// -----------------------------------------------------------------------------
+
+OperatorProfiler::OperatorProfiler(const ioda::ObsSpace &obsdb, const std::string &name,
+                                   const std::vector<std::string> &methods,
+                                   const std::string &output)
+  : ProfilerBase("OperatorProfiler", obsdb, output), name_(name), methods_(methods),
+    records_(methods.size())
+{}
+
+// -----------------------------------------------------------------------------
+
+OperatorProfiler::~OperatorProfiler() {
+  reportOnDestruction();
+}
+
+// -----------------------------------------------------------------------------
+
+OperatorProfiler::Measurement::Measurement(OperatorProfiler *profiler, size_t method,
+                                           size_t nlocs, size_t nvars)
+  : profiler_(profiler), method_(method)
+{
+  if (profiler_ == nullptr)
+    return;
+  Record &record = profiler_->records_.at(method_);
+  record.calls += 1;
+  record.locations += nlocs;
+  record.values += nlocs * nvars;
+  startTime_ = std::chrono::steady_clock::now();
+}
+
+// -----------------------------------------------------------------------------
+
+OperatorProfiler::Measurement::~Measurement() {
+  if (profiler_ == nullptr)
+    return;
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime_;
+  profiler_->records_[method_].seconds += elapsed.count();
+}
+
+// -----------------------------------------------------------------------------
+
+void OperatorProfiler::report() const {
+  const size_t n = records_.size();
+  std::vector<double> minima(n), maxima(n), sums(4 * n);
+  for (size_t i = 0; i < n; ++i) {
+    minima[i] = maxima[i] = sums[4 * i] = records_[i].seconds;
+    sums[4 * i + 1] = records_[i].calls;
+    sums[4 * i + 2] = records_[i].locations;
+    sums[4 * i + 3] = records_[i].values;
+  }
+  comm_.allReduceInPlace(minima.begin(), minima.end(), eckit::mpi::min());
+  comm_.allReduceInPlace(maxima.begin(), maxima.end(), eckit::mpi::max());
+  comm_.allReduceInPlace(sums.begin(), sums.end(), eckit::mpi::sum());
+
+  const double ntasks = comm_.size();
+  auto writeJson = [&](eckit::JSON &json) {
+    json << "operator" << name_;
+    json << "methods";
+    json.startList();
+    for (size_t i = 0; i < n; ++i) {
+      json.startObject();
+      json << "name" << methods_[i];
+      json << "calls" << sums[4 * i + 1] / ntasks;
+      json << "wall time min s" << minima[i];
+      json << "wall time mean s" << sums[4 * i] / ntasks;
+      json << "wall time max s" << maxima[i];
+      json << "locations" << sums[4 * i + 2];
+      json << "values" << sums[4 * i + 3];
+      json.endObject();
+    }
+    json.endList();
+  };
+  auto writeTable = [&](std::ostream &os) {
+    os << "OperatorProfiler: " << name_ << " operator for " << obsname_ << " ("
+       << comm_.size() << " tasks; wall time in s: min/mean/max over tasks; imbalance: max/mean; "
+       << "counts: totals over all calls and tasks)\n";
+    os << std::left << std::setw(16) << "method" << std::right << std::setw(8) << "calls"
+       << std::setw(30) << "wall time" << std::setw(11) << "imbalance"
+       << std::setw(14) << "locations" << std::setw(14) << "values" << "\n";
+    os << std::fixed;
+    for (size_t i = 0; i < n; ++i) {
+      const double mean = sums[4 * i] / ntasks;
+      os << std::left << std::setw(16) << methods_[i] << std::right << std::setprecision(0)
+         << std::setw(8) << sums[4 * i + 1] / ntasks << std::setprecision(4)
+         << std::setw(10) << minima[i] << std::setw(10) << mean << std::setw(10) << maxima[i]
+         << std::setprecision(2) << std::setw(11) << (mean > 0.0 ? maxima[i] / mean : 1.0)
+         << std::setprecision(0) << std::setw(14) << sums[4 * i + 2]
+         << std::setw(14) << sums[4 * i + 3] << "\n";
+    }
+  };
+  writeReport(writeJson, writeTable);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,83 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_OPERATORPROFILER_H_
+#define UFO_OPERATORPROFILER_H_
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "ufo/ProfilerBase.h"
+
+namespace ioda {
+class ObsSpace;
+}
+
+namespace ufo {
+
+/// \brief Collects the cost of the methods of an observation operator.
+///
+/// \details Profiling is enabled by setting the environment variable `UFO_OPERATOR_PROFILE`.
+/// ObsOperator and LinearObsOperator then own an instance of this class each. For each profiled
+/// method of the operator, it records the number of calls, the wall time and the number of
+/// locations and values (locations times variables or channels) processed.
+///
+/// When the operator is destroyed, the records are combined over all MPI tasks (minimum, mean
+/// and maximum of the wall time, to expose load imbalance, and totals of the counts) and written
+/// out as described in ProfilerBase.
+class OperatorProfiler : public ProfilerBase {
+ public:
+  /// \brief Return a new profiler for the operator \p name acting on \p obsdb, whose profiled
+  /// methods are called \p methods, or null if profiling is disabled.
+  static std::unique_ptr<OperatorProfiler> create(const ioda::ObsSpace &obsdb,
+                                                  const std::string &name,
+                                                  const std::vector<std::string> &methods);
+
+  OperatorProfiler(const ioda::ObsSpace &obsdb, const std::string &name,
+                   const std::vector<std::string> &methods, const std::string &output);
+  ~OperatorProfiler() override;
+
+  /// \brief Measures the cost of a call to a method, from construction to destruction.
+  ///
+  /// Does nothing if the profiler is null.
+  class Measurement : private boost::noncopyable {
+   public:
+    /// \param method
+    ///   Index of the method in the list passed to the profiler's constructor.
+    /// \param nlocs, nvars
+    ///   Number of locations and variables processed by the call.
+    Measurement(OperatorProfiler *profiler, size_t method, size_t nlocs, size_t nvars);
+    ~Measurement();
+
+   private:
+    OperatorProfiler *profiler_;
+    size_t method_;
+    std::chrono::steady_clock::time_point startTime_;
+  };
+
+ private:
+  struct Record {
+    double calls = 0.0;
+    double seconds = 0.0;
+    double locations = 0.0;
+    double values = 0.0;
+  };
+
+  void report() const override;
+
+  std::string name_;
+  std::vector<std::string> methods_;
+  std::vector<Record> records_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_OPERATORPROFILER_H_
@@ -0,0 +1,121 @@
+/*
+ * (C) Crown copyright 2023, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/ProfilerBase.h"
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+#include "eckit/log/JSON.h"
+#include "eckit/mpi/Comm.h"
+#include "ioda/ObsSpace.h"
+#include "oops/util/Logger.h"
+
+namespace ufo {
+
+namespace {
+
+bool endsWith(const std::string &s, const std::string &suffix) {
+  return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(),
+                                                suffix) == 0;
+}
+
+/// 64-bit FNV-1a hash of \p keys, each followed by a null character.
+uint64_t keysHash(const std::vector<std::string> &keys) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (const std::string &key : keys) {
+    for (const char c : key) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
+    }
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+ProfilerBase::ProfilerBase(const std::string &className, const ioda::ObsSpace &obsdb,
+                           const std::string &output)
+  : comm_(obsdb.comm()), className_(className), obsname_(obsdb.obsname()), output_(output)
+{}
+
+// -----------------------------------------------------------------------------
+
+long long ProfilerBase::heapBytes() {  // NOLINT(runtime/int)
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  const struct mallinfo2 info = mallinfo2();
+  return static_cast<long long>(info.uordblks + info.hblkhd);  // NOLINT(runtime/int)
+#else
+  return 0;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+
+void ProfilerBase::reportOnDestruction() const noexcept {
+  try {
+    report();
+  } catch (const std::exception &e) {
+    oops::Log::warning() << className_ << ": failed to write the report: " << e.what()
+                         << std::endl;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+bool ProfilerBase::sameKeysOnAllTasks(const std::vector<std::string> &keys,
+                                      const std::string &what) const {
+  // The hash is split into two halves, which are exactly representable as doubles.
+  const uint64_t hash = keysHash(keys);
+  std::vector<double> minima{static_cast<double>(keys.size()),
+                             static_cast<double>(hash >> 32),
+                             static_cast<double>(hash & 0xffffffffULL)};
+  std::vector<double> maxima = minima;
+  comm_.allReduceInPlace(minima.begin(), minima.end(), eckit::mpi::min());
+  comm_.allReduceInPlace(maxima.begin(), maxima.end(), eckit::mpi::max());
+  if (minima != maxima) {
+    oops::Log::warning() << className_ << ": " << what << " of " << obsname_ << " differ "
+                         << "between tasks; no profile written" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void ProfilerBase::writeReport(const std::function<void(eckit::JSON &)> &writeJson,
+                               const std::function<void(std::ostream &)> &writeTable) const {
+  if (comm_.rank() != 0)
+    return;
+
+  if (endsWith(output_, ".json")) {
+    std::ofstream file(output_, std::ios::app);
+    eckit::JSON json(file);
+    json.startObject();
+    json << "obs space" << obsname_;
+    json << "tasks" << comm_.size();
+    writeJson(json);
+    json.endObject();
+    file << std::endl;
+  } else {
+    std::ostringstream os;
+    writeTable(os);
+    oops::Log::info() << os.str() << std::flush;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
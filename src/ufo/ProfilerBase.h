@@ -0,0 +1,140 @@
+/*
+ * (C) Crown copyright 2023, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_PROFILERBASE_H_
+#define UFO_PROFILERBASE_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace eckit {
+class JSON;
+namespace mpi {
+class Comm;
+}
+}
+
+namespace ioda {
+class ObsSpace;
+}
+
+namespace ufo {
+
+/// \brief Base class of the profilers of UFO (FilterProfiler, OperatorProfiler and
+/// MemoryProfiler).
+///
+/// \details Each profiler is enabled by setting an environment variable and collects records
+/// about an ObsSpace. Its destructor calls reportOnDestruction(), which calls report() to
+/// combine the records over all MPI tasks (so profilers must be destroyed on all tasks at once)
+/// and write them by task 0 with writeReport(): as a table to the info log or, if the value of
+/// the environment variable ends with `.json`, as a single line of JSON appended to the file
+/// with that name.
+class ProfilerBase : private boost::noncopyable {
+ public:
+  /// Net number of bytes currently allocated on the heap (0 if unknown).
+  static long long heapBytes();  // NOLINT(runtime/int)
+
+ protected:
+  /// \param className
+  ///   Name of the profiler, used in messages.
+  /// \param output
+  ///   Value of the environment variable enabling the profiler.
+  ProfilerBase(const std::string &className, const ioda::ObsSpace &obsdb,
+               const std::string &output);
+  virtual ~ProfilerBase() = default;
+
+  /// \brief Call report(), logging rather than throwing any exception. To be called by the
+  /// destructors of the subclasses.
+  void reportOnDestruction() const noexcept;
+
+  /// \brief Return true if all MPI tasks hold records with the same \p keys (in the same
+  /// order) and can therefore be combined. Otherwise log a warning saying that the records of
+  /// \p what differ and return false.
+  ///
+  /// The number of keys and a hash of the keys are compared.
+  bool sameKeysOnAllTasks(const std::vector<std::string> &keys, const std::string &what) const;
+
+  /// \brief On task 0, write the report either as a JSON object (starting with the name of the
+  /// ObsSpace and the number of tasks, followed by the fields written by \p writeJson) or as
+  /// the table written by \p writeTable.
+  void writeReport(const std::function<void(eckit::JSON &)> &writeJson,
+                   const std::function<void(std::ostream &)> &writeTable) const;
+
+  /// Combine the records from all MPI tasks and write them out.
+  virtual void report() const = 0;
+
+  const eckit::mpi::Comm &comm_;
+  std::string className_;
+  std::string obsname_;
+  std::string output_;
+};
+
+/// \brief Registry of the profilers of type \p PROFILER shared by all objects acting on the
+/// same ObsSpace.
+///
+/// The profilers are created on demand and kept alive by the objects using them. Each profiler
+/// must remove itself from the registry in its destructor, so that find() never returns a
+/// destroyed profiler.
+template <typename PROFILER>
+class ProfilerRegistry : private boost::noncopyable {
+ public:
+  /// \brief Return the profiler registered under \p key (e.g. the address of the ObsSpace),
+  /// creating it by calling \p create if there is none.
+  template <typename CREATE>
+  std::shared_ptr<PROFILER> getOrCreate(const void *key, const CREATE &create) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry &entry = entries_[key];
+    std::shared_ptr<PROFILER> profiler = entry.shared.lock();
+    if (!profiler) {
+      profiler = create();
+      entry.shared = profiler;
+      entry.profiler = profiler.get();
+    }
+    return profiler;
+  }
+
+  /// \brief Return the profiler registered under \p key, or null if there is none.
+  ///
+  /// Must be called with mutex() locked, which prevents the profiler from being destroyed
+  /// while it is in use.
+  PROFILER *find(const void *key) const {
+    const auto it = entries_.find(key);
+    return it == entries_.end() ? nullptr : it->second.profiler;
+  }
+
+  /// Remove \p profiler from the registry, unless it has been replaced already.
+  void remove(const void *key, const PROFILER *profiler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = entries_.find(key);
+    if (it != entries_.end() && it->second.profiler == profiler)
+      entries_.erase(it);
+  }
+
+  std::mutex &mutex() {return mutex_;}
+
+ private:
+  struct Entry {
+    /// Keeps track of the instance shared by the users of the profiler.
+    std::weak_ptr<PROFILER> shared;
+    /// Remains valid until the profiler removes this entry in its destructor.
+    PROFILER *profiler = nullptr;
+  };
+
+  std::mutex mutex_;
+  std::map<const void *, Entry> entries_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_PROFILERBASE_H_
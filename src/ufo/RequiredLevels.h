@@ -0,0 +1,37 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_REQUIREDLEVELS_H_
+#define UFO_REQUIREDLEVELS_H_
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace ufo {
+
+/// \brief Contiguous range of model levels of a GeoVaLs variable used by an observation operator.
+struct RequiredLevels {
+  /// Number of levels used.
+  size_t numLevels = 0;
+  /// If true, the \c numLevels levels closest to the surface are used; otherwise the
+  /// \c numLevels topmost levels are used.
+  bool nearSurface = true;
+
+  bool operator==(const RequiredLevels & other) const {
+    return numLevels == other.numLevels && nearSurface == other.nearSurface;
+  }
+  bool operator!=(const RequiredLevels & other) const {return !(*this == other);}
+};
+
+/// Maps names of GeoVaLs variables to the levels of these variables used by an observation
+/// operator. All levels are used of the variables missing from the map.
+typedef std::map<std::string, RequiredLevels> RequiredLevelsMap;
+
+}  // namespace ufo
+
+#endif  // UFO_REQUIREDLEVELS_H_
@@ -8,6 +8,7 @@
 #include "ufo/errors/ObsErrorCrossVarCov.h"
 
 #include <math.h>
+#include <map>
 #include <vector>
 
 #include "ioda/Engines/EngineUtils.h"
@@ -105,37 +106,22 @@ void ObsErrorCrossVarCov::multiply(ioda::ObsVector & dy) const {
   dy *= stddev_;
 
   // C * D^{1/2} * dy
-  const size_t nlocs = dy.nlocs();
   const size_t nvars = dy.nvars();
-  const double missing = util::missingValue(double());
-  // preallocate data
-  std::vector<int> usedobs_indices(nvars);
-  Eigen::VectorXd dy_at_loc(nvars);
-  Eigen::MatrixXd corr = Eigen::MatrixXd::Identity(nvars, nvars);
-
-  // loop over all observations locations
-  for (size_t jloc = 0; jloc < nlocs; ++jloc) {
-    // find values to be used (the ones that passed QC), and create subset of used values
-    // at this location (dy_at_loc) and submatrix of correlations for the used values (corr)
-    size_t nused = 0;
-    for (size_t jvar = 0; jvar < nvars; ++jvar) {
-      if (dy[jloc*nvars + jvar] != missing) usedobs_indices[nused++] = jvar;
-    }
-    for (size_t jvar = 0; jvar < nused; ++jvar) {
-      int ind = usedobs_indices[jvar];
-      dy_at_loc(jvar) = dy[jloc*nvars + ind];
-      for (size_t jvar2 = jvar+1; jvar2 < nused; ++jvar2) {
-        int ind2 = usedobs_indices[jvar2];
-        corr(jvar, jvar2) = varcorrelations_(ind, ind2);
-        corr(jvar2, jvar) = varcorrelations_(ind2, ind);
-      }
-    }
+  // loop over groups of locations with the same variables passing QC
+  for (const auto & group : groupLocationsByUsedVariables(dy)) {
+    const std::vector<int> & usedvars = group.first;
+    const std::vector<size_t> & locs = group.second;
+    // copy the used values at all locations in the group to the columns of a matrix
+    Eigen::MatrixXd dy_in_group(usedvars.size(), locs.size());
+    for (size_t jloc = 0; jloc < locs.size(); ++jloc)
+      for (size_t jvar = 0; jvar < usedvars.size(); ++jvar)
+        dy_in_group(jvar, jloc) = dy[locs[jloc]*nvars + usedvars[jvar]];
     // multiply by C
-    dy_at_loc.head(nused) = corr.block(0, 0, nused, nused) * dy_at_loc.head(nused);
+    dy_in_group = correlations(usedvars) * dy_in_group;
     // save results in dy
-    for (size_t jvar = 0; jvar < nused; ++jvar) {
-      dy[jloc*nvars + usedobs_indices[jvar]] = dy_at_loc[jvar];
-    }
+    for (size_t jloc = 0; jloc < locs.size(); ++jloc)
+      for (size_t jvar = 0; jvar < usedvars.size(); ++jvar)
+        dy[locs[jloc]*nvars + usedvars[jvar]] = dy_in_group(jvar, jloc);
   }
 
   // D^{1/2} * C * D^{1/2} * dy
@@ -153,41 +139,72 @@ void ObsErrorCrossVarCov::inverseMultiply(ioda::ObsVector & dy) const {
   dy /= stddev_;
 
   // C^{-1} * D^{-1/2} * dy
+  const size_t nvars = dy.nvars();
+  // loop over groups of locations with the same variables passing QC
+  for (const auto & group : groupLocationsByUsedVariables(dy)) {
+    const std::vector<int> & usedvars = group.first;
+    const std::vector<size_t> & locs = group.second;
+    // copy the used values at all locations in the group to the columns of a matrix
+    Eigen::MatrixXd dy_in_group(usedvars.size(), locs.size());
+    for (size_t jloc = 0; jloc < locs.size(); ++jloc)
+      for (size_t jvar = 0; jvar < usedvars.size(); ++jvar)
+        dy_in_group(jvar, jloc) = dy[locs[jloc]*nvars + usedvars[jvar]];
+    // Multiply by inverse of C, using standard Cholesky decomposition from Eigen library
+    // https://eigen.tuxfamily.org/dox/classEigen_1_1LLT.html
+    choleskyFactorization(usedvars).solveInPlace(dy_in_group);
+    // save results in dy
+    for (size_t jloc = 0; jloc < locs.size(); ++jloc)
+      for (size_t jvar = 0; jvar < usedvars.size(); ++jvar)
+        dy[locs[jloc]*nvars + usedvars[jvar]] = dy_in_group(jvar, jloc);
+  }
+
+  // D^{-1/2} * C^{-1} * D^{-1/2} * dy
+  dy /= stddev_;
+}
+
+// -----------------------------------------------------------------------------
+
+ObsErrorCrossVarCov::LocationsByUsedVariables
+ObsErrorCrossVarCov::groupLocationsByUsedVariables(const ioda::ObsVector & dy) {
   const size_t nlocs = dy.nlocs();
   const size_t nvars = dy.nvars();
   const double missing = util::missingValue(double());
-  // preallocate data
-  std::vector<int> usedobs_indices(nvars);
-  Eigen::VectorXd dy_at_loc(nvars);
-  Eigen::MatrixXd corr = Eigen::MatrixXd::Identity(nvars, nvars);
-  // loop over all observations locations
+  LocationsByUsedVariables groups;
+  std::vector<int> usedvars;
+  usedvars.reserve(nvars);
   for (size_t jloc = 0; jloc < nlocs; ++jloc) {
-    // find values to be used (the ones that passed QC), and create subset of used values
-    // at this location (dy_at_loc) and submatrix of correlations for the used values (corr)
-    size_t nused = 0;
+    // find values to be used (the ones that passed QC)
+    usedvars.clear();
     for (size_t jvar = 0; jvar < nvars; ++jvar) {
-      if (dy[jloc*nvars + jvar] != missing) usedobs_indices[nused++] = jvar;
-    }
-    for (size_t jvar = 0; jvar < nused; ++jvar) {
-      int ind = usedobs_indices[jvar];
-      dy_at_loc(jvar) = dy[jloc*nvars + ind];
-      for (size_t jvar2 = jvar+1; jvar2 < nused; ++jvar2) {
-        int ind2 = usedobs_indices[jvar2];
-        // only need the lower triangle for llt() below; not filling upper triangle
-        corr(jvar2, jvar) = varcorrelations_(ind2, ind);
-      }
+      if (dy[jloc*nvars + jvar] != missing) usedvars.push_back(jvar);
     }
-    // Multiply by inverse of C, using standard Cholesky decomposition from Eigen library
-    // https://eigen.tuxfamily.org/dox/classEigen_1_1LLT.html
-    corr.topLeftCorner(nused, nused).llt().solveInPlace(dy_at_loc.head(nused));
-    // save results in dy
-    for (size_t jvar = 0; jvar < nused; ++jvar) {
-      dy[jloc*nvars + usedobs_indices[jvar]] = dy_at_loc[jvar];
+    if (!usedvars.empty()) groups[usedvars].push_back(jloc);
+  }
+  return groups;
+}
+
+// -----------------------------------------------------------------------------
+
+Eigen::MatrixXd ObsErrorCrossVarCov::correlations(const std::vector<int> & usedvars) const {
+  const size_t nused = usedvars.size();
+  Eigen::MatrixXd corr = Eigen::MatrixXd::Identity(nused, nused);
+  for (size_t jvar = 0; jvar < nused; ++jvar) {
+    for (size_t jvar2 = jvar+1; jvar2 < nused; ++jvar2) {
+      corr(jvar, jvar2) = varcorrelations_(usedvars[jvar], usedvars[jvar2]);
+      corr(jvar2, jvar) = varcorrelations_(usedvars[jvar2], usedvars[jvar]);
     }
   }
+  return corr;
+}
 
-  // D^{-1/2} * C^{-1} * D^{-1/2} * dy
-  dy /= stddev_;
+// -----------------------------------------------------------------------------
+
+const Eigen::LLT<Eigen::MatrixXd> & ObsErrorCrossVarCov::choleskyFactorization(
+    const std::vector<int> & usedvars) const {
+  auto it = choleskyFactorizations_.find(usedvars);
+  if (it == choleskyFactorizations_.end())
+    it = choleskyFactorizations_.emplace(usedvars, correlations(usedvars).llt()).first;
+  return it->second;
 }
 
 // -----------------------------------------------------------------------------
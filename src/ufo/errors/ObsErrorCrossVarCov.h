@@ -8,10 +8,13 @@
 #ifndef UFO_ERRORS_OBSERRORCROSSVARCOV_H_
 #define UFO_ERRORS_OBSERRORCROSSVARCOV_H_
 
+#include <Eigen/Cholesky>
 #include <Eigen/Core>
 
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "ioda/ObsVector.h"
 
@@ -46,6 +49,11 @@ class ObsErrorCrossVarCovParameters : public oops::ObsErrorParametersBase {
 ///          Full observation error covariance matrix is R = D^{1/2} * C * D^{1/2}
 ///          where D^{1/2} is a diagonal matrix with stddev_ (ObsError group)
 ///          on the diagonal, and C is the correlation matrix.
+///
+///          Locations are processed in groups sharing the same set of non-missing
+///          variables, so that C (or its Cholesky factor) can be applied to all of
+///          them with a single matrix-matrix operation. Cholesky factors of the
+///          submatrices of C are computed once for each such set and cached.
 class ObsErrorCrossVarCov : public oops::interface::ObsErrorBase<ObsTraits> {
  public:
   /// The type of parameters passed to the constructor.
@@ -87,6 +95,20 @@ class ObsErrorCrossVarCov : public oops::interface::ObsErrorBase<ObsTraits> {
   std::unique_ptr<ioda::ObsVector> getInverseVariance() const override;
 
  private:
+  /// Indices of locations grouped by the (sorted) indices of variables with non-missing values.
+  typedef std::map<std::vector<int>, std::vector<size_t>> LocationsByUsedVariables;
+
+  /// Group locations by the set of variables with non-missing values in \p dy.
+  static LocationsByUsedVariables groupLocationsByUsedVariables(const ioda::ObsVector & dy);
+
+  /// Return the submatrix of correlations between variables \p usedVars.
+  Eigen::MatrixXd correlations(const std::vector<int> & usedVars) const;
+
+  /// Return the Cholesky factorization of the submatrix of correlations between variables
+  /// \p usedVars, computing it if it isn't cached yet.
+  const Eigen::LLT<Eigen::MatrixXd> & choleskyFactorization(
+      const std::vector<int> & usedVars) const;
+
   /// Print covariance details (for logging)
   void print(std::ostream &) const override;
   /// Observation error standard deviations
@@ -95,6 +117,9 @@ class ObsErrorCrossVarCov : public oops::interface::ObsErrorBase<ObsTraits> {
   const oops::Variables vars_;
   /// Correlations between variables
   Eigen::MatrixXd varcorrelations_;
+  /// Cholesky factorizations of submatrices of varcorrelations_, indexed by the indices of
+  /// variables they correspond to
+  mutable std::map<std::vector<int>, Eigen::LLT<Eigen::MatrixXd>> choleskyFactorizations_;
 };
 
 // -----------------------------------------------------------------------------
@@ -9,7 +9,12 @@
 
 #include "eckit/config/Configuration.h"
 
+#include "ioda/distribution/Accumulator.h"
+#include "ioda/distribution/Distribution.h"
+#include "ioda/ObsSpace.h"
+
 #include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
 
 
 namespace ufo {
@@ -18,12 +23,13 @@ namespace ufo {
 
 ObsErrorDiagonal::ObsErrorDiagonal(const Parameters_ & options, ioda::ObsSpace & obsgeom,
                                    const eckit::mpi::Comm &timeComm)
-  : ObsErrorBase(timeComm),
+  : ObsErrorBase(timeComm), obsdb_(obsgeom),
     stddev_(obsgeom, "ObsError"), inverseVariance_(obsgeom), options_(options)
 {
   inverseVariance_ = stddev_;
   inverseVariance_ *= stddev_;
   inverseVariance_.invert();
+  packInverseVariance();
   oops::Log::trace() << "ObsErrorDiagonal:ObsErrorDiagonal constructed nobs = "
                      << stddev_.nobs() << std::endl;
 }
@@ -35,19 +41,89 @@ void ObsErrorDiagonal::update(const ioda::ObsVector & obserr) {
   inverseVariance_ = stddev_;
   inverseVariance_ *= stddev_;
   inverseVariance_.invert();
+  packInverseVariance();
   oops::Log::info() << "ObsErrorDiagonal covariance updated " << stddev_.nobs() << std::endl;
 }
 
 // -----------------------------------------------------------------------------
 
+void ObsErrorDiagonal::packInverseVariance() {
+  const double missing = util::missingValue(missing);
+  validIndices_.clear();
+  validInverseVariances_.clear();
+  invalidIndices_.clear();
+  for (size_t jj = 0; jj < inverseVariance_.size(); ++jj) {
+    if (inverseVariance_[jj] == missing) {
+      invalidIndices_.push_back(jj);
+    } else {
+      validIndices_.push_back(jj);
+      validInverseVariances_.push_back(inverseVariance_[jj]);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsErrorDiagonal::multiply(ioda::ObsVector & dy) const {
-  dy /= inverseVariance_;
+  const double missing = util::missingValue(missing);
+  for (size_t jj : invalidIndices_)
+    dy[jj] = missing;
+  for (size_t jv = 0; jv < validIndices_.size(); ++jv) {
+    double & value = dy[validIndices_[jv]];
+    if (value != missing)
+      value /= validInverseVariances_[jv];
+  }
 }
 
 // -----------------------------------------------------------------------------
 
 void ObsErrorDiagonal::inverseMultiply(ioda::ObsVector & dy) const {
-  dy *= inverseVariance_;
+  const double missing = util::missingValue(missing);
+  for (size_t jj : invalidIndices_)
+    dy[jj] = missing;
+  for (size_t jv = 0; jv < validIndices_.size(); ++jv) {
+    double & value = dy[validIndices_[jv]];
+    if (value != missing)
+      value *= validInverseVariances_[jv];
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+double ObsErrorDiagonal::inverseMultiplyAndDot(ioda::ObsVector & dy) const {
+  const double missing = util::missingValue(missing);
+  const size_t nvars = dy.nvars();
+  // The accumulator makes sure observations held on several tasks are only counted once.
+  std::unique_ptr<ioda::Accumulator<double>> accumulator =
+      obsdb_.distribution()->createAccumulator<double>();
+  for (size_t jj : invalidIndices_)
+    dy[jj] = missing;
+  for (size_t jv = 0; jv < validIndices_.size(); ++jv) {
+    const size_t jj = validIndices_[jv];
+    double & value = dy[jj];
+    if (value != missing) {
+      const double scaled = value * validInverseVariances_[jv];
+      accumulator->addTerm(jj / nvars, value * scaled);
+      value = scaled;
+    }
+  }
+  return accumulator->computeResult();
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsErrorDiagonal::multiplyAdd(ioda::ObsVector & y, double alpha,
+                                   const ioda::ObsVector & dy) const {
+  const double missing = util::missingValue(missing);
+  for (size_t jj : invalidIndices_)
+    y[jj] = missing;
+  for (size_t jv = 0; jv < validIndices_.size(); ++jv) {
+    const size_t jj = validIndices_[jv];
+    if (y[jj] == missing || dy[jj] == missing)
+      y[jj] = missing;
+    else
+      y[jj] += alpha * (dy[jj] / validInverseVariances_[jv]);
+  }
 }
 
 // -----------------------------------------------------------------------------
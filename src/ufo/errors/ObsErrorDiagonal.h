@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "ioda/ObsVector.h"
 
@@ -55,6 +56,13 @@ class ObsErrorDiagonal : public oops::interface::ObsErrorBase<ObsTraits> {
 /// Multiply a Departure by \f$R^{-1}\f$
   void inverseMultiply(ioda::ObsVector &) const override;
 
+/// Multiply a Departure \f$dy\f$ by \f$R^{-1}\f$ and return \f$dy^T R^{-1} dy\f$ (the dot
+/// product of the original and the scaled departure), in a single pass over the data
+  double inverseMultiplyAndDot(ioda::ObsVector & dy) const;
+
+/// Add \f$\alpha R dy\f$ to \p y, in a single pass over the data and without modifying \p dy
+  void multiplyAdd(ioda::ObsVector & y, double alpha, const ioda::ObsVector & dy) const;
+
 /// Generate random perturbation
   void randomize(ioda::ObsVector &) const override;
 
@@ -72,8 +80,19 @@ class ObsErrorDiagonal : public oops::interface::ObsErrorBase<ObsTraits> {
 
  private:
   void print(std::ostream &) const override;
+  /// Set up validIndices_, validInverseVariances_ and invalidIndices_ from inverseVariance_.
+  void packInverseVariance();
+
+  ioda::ObsSpace & obsdb_;
   ioda::ObsVector stddev_;
   ioda::ObsVector inverseVariance_;
+  /// Indices of the non-missing elements of inverseVariance_ (i.e. of the observations that
+  /// passed QC) and their values, so that the observations rejected by QC are skipped without
+  /// comparing each inverse variance with the missing value indicator.
+  std::vector<size_t> validIndices_;
+  std::vector<double> validInverseVariances_;
+  /// Indices of the missing elements of inverseVariance_.
+  std::vector<size_t> invalidIndices_;
   Parameters_ options_;
 };
 
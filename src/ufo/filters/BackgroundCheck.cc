@@ -83,12 +83,19 @@ void BackgroundCheck::applyFilter(const std::vector<bool> & apply,
   oops::Log::trace() << "BackgroundCheck postFilter" << std::endl;
   const oops::Variables observed = obsdb_.obsvariables();
   const float missing = util::missingValue(missing);
+  const size_t nlocs = obsdb_.nlocs();
   oops::Log::debug() << "BackgroundCheck obserr: " << *obserr_ << std::endl;
   ioda::ObsDataVector<float> obs(obsdb_, filtervars.toOopsVariables(), "ObsValue");
 
   std::string test_hofx = parameters_.test_hofx.value();
   Variables varhofx(filtervars, test_hofx);
 
+  // The loops over locations below are written without branches (and with the `apply` vector
+  // converted to chars) so that they can be vectorised. Locations that are not selected are
+  // masked out. The consistency checks are accumulated in `invalid` and verified after each loop.
+  const std::vector<char> applyChars(apply.begin(), apply.end());
+  std::vector<char> isFlagged(nlocs);
+
 // Get function absolute threshold
   if (parameters_.functionAbsoluteThreshold.value()) {
 //  Get function absolute threshold info from configuration
@@ -99,75 +106,76 @@ void BackgroundCheck::applyFilter(const std::vector<bool> & apply,
     for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
       size_t iv = observed.find(filtervars.variable(jv).variable());
       //    H(x)
-      std::vector<float> hofx;
-      data_.get(varhofx.variable(jv), hofx);
-      for (size_t jobs = 0; jobs < obsdb_.nlocs(); ++jobs) {
-        if (apply[jobs] && (*flags_)[iv][jobs] == QCflags::pass &&
-            (*obserr_)[iv][jobs] != util::missingValue((*obserr_)[iv][jobs])) {
-          ASSERT(obs[jv][jobs] != util::missingValue(obs[jv][jobs]));
-          ASSERT(hofx[jobs] != util::missingValue(hofx[jobs]));
-
-//        Threshold for current observation
-          float zz = function_abs_threshold[jv][jobs];
-//        Check distance from background
-          if (std::abs(static_cast<float>(hofx[jobs]) - obs[jv][jobs]) > zz) {
-            flagged[jv][jobs] = true;
-          }
-        }
+      const ObsFilterDataView<float> hofx = data_.getView<float>(varhofx.variable(jv));
+      const std::vector<float> &obsValues = obs[jv];
+      const std::vector<float> &obsErrors = (*obserr_)[iv];
+      const std::vector<int> &qcFlags = (*flags_)[iv];
+      const std::vector<float> &threshold = function_abs_threshold[jv];
+      bool invalid = false;
+      for (size_t jobs = 0; jobs < nlocs; ++jobs) {
+        const bool selected = applyChars[jobs] & (qcFlags[jobs] == QCflags::pass) &
+                              (obsErrors[jobs] != missing);
+        invalid |= selected & ((obsValues[jobs] == missing) | (hofx[jobs] == missing));
+//      Check distance from background
+        isFlagged[jobs] = selected & (std::abs(hofx[jobs] - obsValues[jobs]) > threshold[jobs]);
       }
+      ASSERT(!invalid);
+      for (size_t jobs = 0; jobs < nlocs; ++jobs)
+        if (isFlagged[jobs])
+          flagged[jv][jobs] = true;
     }
   } else {
     Variables varbias(filtervars, "ObsBiasData");
+    const bool thresholdWrtBGerror = parameters_.thresholdWrtBGerror.value();
+
+//  Thresholds (the same for all variables)
+    const ScalarOrFilterData noThreshold(std::numeric_limits<float>::max());
+    const ScalarOrFilterData abs_thr = parameters_.absoluteThreshold.value() ?
+      getScalarOrFilterDataView(*parameters_.absoluteThreshold.value(), data_) : noThreshold;
+    const ScalarOrFilterData thr = parameters_.threshold.value() ?
+      getScalarOrFilterDataView(*parameters_.threshold.value(), data_) : noThreshold;
+
     for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
       size_t iv = observed.find(filtervars.variable(jv).variable());
 //    H(x) (including bias correction)
-      std::vector<float> hofx;
-      data_.get(varhofx.variable(jv), hofx);
+      const ObsFilterDataView<float> hofx = data_.getView<float>(varhofx.variable(jv));
 //    H(x) error
       std::vector<float> hofxerr;
-      bool thresholdWrtBGerror = parameters_.thresholdWrtBGerror.value();
       if (thresholdWrtBGerror) {
         data_.get(backgrErrVariable(filtervars[jv]), hofxerr);
       }
 //    Bias correction (only read in if removeBiasCorrection is set to true, otherwise
 //    set to zero).
-      std::vector<float> bias(obsdb_.nlocs(), 0.0);
+      ObsFilterDataView<float> bias(std::vector<float>(nlocs, 0.0f));
       if (parameters_.removeBiasCorrection) {
-        data_.get(varbias.variable(jv), bias);
+        bias = data_.getView<float>(varbias.variable(jv));
       }
 
-//    Threshold for current variable
-      std::vector<float> abs_thr(obsdb_.nlocs(), std::numeric_limits<float>::max());
-      std::vector<float> thr(obsdb_.nlocs(), std::numeric_limits<float>::max());
-      if (parameters_.absoluteThreshold.value())
-        abs_thr = getScalarOrFilterData(*parameters_.absoluteThreshold.value(), data_);
-      if (parameters_.threshold.value())
-        thr = getScalarOrFilterData(*parameters_.threshold.value(), data_);
-
-      for (size_t jobs = 0; jobs < obsdb_.nlocs(); ++jobs) {
-        if (apply[jobs] && (*flags_)[iv][jobs] == QCflags::pass &&
-            (*obserr_)[iv][jobs] != util::missingValue((*obserr_)[iv][jobs])) {
-          ASSERT(obs[jv][jobs] != util::missingValue(obs[jv][jobs]));
-          ASSERT(hofx[jobs] != util::missingValue(hofx[jobs]));
-          ASSERT(bias[jobs] != util::missingValue(bias[jobs]));
-
-          const std::vector<float> &errorMultiplier = thresholdWrtBGerror ?
-                                                      hofxerr : (*obserr_)[iv];
-//        Threshold for current observation
-          float zz = (thr[jobs] == std::numeric_limits<float>::max()) ? abs_thr[jobs] :
-            std::min(abs_thr[jobs], thr[jobs] * errorMultiplier[jobs]);
-
-          ASSERT(zz < std::numeric_limits<float>::max() && zz > 0.0);
-
-//        Check distance from background. hofx includes bias correction.
-//        If removeBiasCorrection is set to true, `bias` contains bias correction, and
-//           it is removed from hofx.
-//        Otherwise, `bias` is set to zero, and bias correction is not removed from hofx.
-          if (std::abs(hofx[jobs] - obs[jv][jobs] - bias[jobs]) > zz) {
-            flagged[jv][jobs] = true;
-          }
-        }
+      const std::vector<float> &obsValues = obs[jv];
+      const std::vector<float> &obsErrors = (*obserr_)[iv];
+      const std::vector<int> &qcFlags = (*flags_)[iv];
+      const std::vector<float> &errorMultiplier = thresholdWrtBGerror ? hofxerr : obsErrors;
+      bool invalid = false;
+      for (size_t jobs = 0; jobs < nlocs; ++jobs) {
+        const bool selected = applyChars[jobs] & (qcFlags[jobs] == QCflags::pass) &
+                              (obsErrors[jobs] != missing);
+//      Threshold for current observation
+        const float zz = (thr[jobs] == std::numeric_limits<float>::max()) ? abs_thr[jobs] :
+          std::min(abs_thr[jobs], thr[jobs] * errorMultiplier[jobs]);
+        invalid |= selected & ((obsValues[jobs] == missing) | (hofx[jobs] == missing) |
+                               (bias[jobs] == missing) |
+                               !((zz < std::numeric_limits<float>::max()) & (zz > 0.0f)));
+
+//      Check distance from background. hofx includes bias correction.
+//      If removeBiasCorrection is set to true, `bias` contains bias correction, and
+//         it is removed from hofx.
+//      Otherwise, `bias` is set to zero, and bias correction is not removed from hofx.
+        isFlagged[jobs] = selected & (std::abs(hofx[jobs] - obsValues[jobs] - bias[jobs]) > zz);
       }
+      ASSERT(!invalid);
+      for (size_t jobs = 0; jobs < nlocs; ++jobs)
+        if (isFlagged[jobs])
+          flagged[jv][jobs] = true;
     }
   }
 }
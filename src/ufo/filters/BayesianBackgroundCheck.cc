@@ -60,33 +60,6 @@ Variable BayesianBackgroundCheck::backgrErrVariable(const Variable &filterVariab
   return Variable(filterVariable.variable() + "_background_error@ObsDiag");
 }
 
-// -----------------------------------------------------------------------------
-/// Reduce a vector to only the elements for which j_reduced=true.
-
-template <class T>
-std::vector<T> BayesianBackgroundCheck::reduceVector(const std::vector<T> &vector_full,
-                                                     const std::vector<size_t> &j_reduced) const {
-  size_t reduced_size = j_reduced.size();
-  std::vector<T> vector_reduced(reduced_size);
-  for (size_t i_reduced=0; i_reduced < reduced_size; ++i_reduced) {
-    vector_reduced[i_reduced] = vector_full[j_reduced[i_reduced]];
-  }
-  return vector_reduced;
-}
-
-// -----------------------------------------------------------------------------
-/// Copy a reduced vector back into the correct indices of the full vector.
-
-template <class T>
-void BayesianBackgroundCheck::unreduceVector(const std::vector<T> &vector_reduced,
-                                             std::vector<T> &vector_full,
-                                             const std::vector<size_t> &j_reduced) const {
-  size_t reduced_size = vector_reduced.size();
-  for (size_t i_reduced=0; i_reduced < reduced_size; ++i_reduced) {
-    vector_full[j_reduced[i_reduced]] = vector_reduced[i_reduced];
-  }
-}
-
 // -----------------------------------------------------------------------------
 /// Apply the Bayesian background check filter.
 
@@ -137,10 +110,8 @@ void BayesianBackgroundCheck::applyFilter(const std::vector<bool> & apply,
       // QC flags:
       std::vector<int> qcflags1(obsdb_.nlocs());
       std::vector<float> firstComponentObVal, secondComponentObVal;
-      // make note of conditions on apply and flags_:
-      std::vector<bool> applycondition(obsdb_.nlocs(), false);
-      // index mapping between full and reduced vectors:
-      std::vector<size_t> j_reduced;
+      // indices of locations at which the PGE is updated:
+      std::vector<size_t> selectedLocations;
 
       if (previousVariableWasFirstComponentOfTwo) {
         varname1 = filtervars.variable(filterVarIndex-1).variable();
@@ -163,8 +134,7 @@ void BayesianBackgroundCheck::applyFilter(const std::vector<bool> & apply,
         for (size_t jobs=0; jobs < obsdb_.nlocs(); ++jobs) {
           if (apply[jobs] && (*flags_)[iv1][jobs] == QCflags::pass
                           && (*flags_)[iv2][jobs] == QCflags::pass) {
-            applycondition[jobs] = true;
-            j_reduced.push_back(jobs);
+            selectedLocations.push_back(jobs);
           }
         }
       } else {
@@ -183,53 +153,29 @@ void BayesianBackgroundCheck::applyFilter(const std::vector<bool> & apply,
         obsdb_.get_db("GrossErrorProbability", varname1, PGE1);
         for (size_t jobs=0; jobs < obsdb_.nlocs(); ++jobs) {
           if (apply[jobs] && (*flags_)[iv1][jobs] == QCflags::pass) {
-            applycondition[jobs] = true;
-            j_reduced.push_back(jobs);
+            selectedLocations.push_back(jobs);
           }
         }
       }
 
-      // create reduced vectors, copied from full ones, fulfilling applycondition:
-      std::vector<float> firstComponentObVal_reduced = reduceVector(firstComponentObVal,
-                                                                    j_reduced);
-      std::vector<float> ObsErr_reduced = reduceVector((*obserr_)[varname1], j_reduced);
-      std::vector<float> hofx1_reduced = reduceVector(hofx1, j_reduced);
-      std::vector<float> hofxerr_reduced = reduceVector(hofxerr, j_reduced);
-      std::vector<float> PdBad_reduced = reduceVector(PdBad, j_reduced);
-      std::vector<int> qcflags1_reduced = reduceVector(qcflags1, j_reduced);
-      std::vector<float> PGE1_reduced = reduceVector(PGE1, j_reduced);
-      std::vector<float> secondComponentObVal_reduced;
-      std::vector<float> hofx2_reduced;
-      std::vector<float> TotalPd_reduced;
-      if (previousVariableWasFirstComponentOfTwo) {
-        secondComponentObVal_reduced = reduceVector(secondComponentObVal, j_reduced);
-        hofx2_reduced = reduceVector(hofx2, j_reduced);
-      }
-      if (parameters_.SaveTotalPd) {
-          TotalPd_reduced = reduceVector(TotalPd, j_reduced);
-      }
-
+      // update the PGE at the selected locations (in place):
       ufo::BayesianPGEUpdate(parameters_.PGEParameters,
-                             firstComponentObVal_reduced,
-                             ObsErr_reduced,
-                             hofx1_reduced,
-                             hofxerr_reduced,
-                             PdBad_reduced,
+                             selectedLocations,
+                             firstComponentObVal,
+                             (*obserr_)[varname1],
+                             hofx1,
+                             hofxerr,
+                             PdBad,
                              parameters_.PerformSDiffCheck.value(),
-                             qcflags1_reduced,
-                             PGE1_reduced,
+                             qcflags1,
+                             PGE1,
                              parameters_.ErrVarMax,
                              previousVariableWasFirstComponentOfTwo?
-                             &secondComponentObVal_reduced : nullptr,
+                             &secondComponentObVal : nullptr,
                              previousVariableWasFirstComponentOfTwo?
-                             &hofx2_reduced : nullptr,
+                             &hofx2 : nullptr,
                              parameters_.SaveTotalPd?
-                             &TotalPd_reduced : nullptr);
-
-      // write PGE-updated values from reduced vectors back into full ones:
-      unreduceVector(qcflags1_reduced, qcflags1, j_reduced);
-      unreduceVector(PGE1_reduced, PGE1, j_reduced);
-      unreduceVector(TotalPd_reduced, TotalPd, j_reduced);
+                             &TotalPd : nullptr);
 
       // Save PGE to obsdb
       obsdb_.put_db("GrossErrorProbability", varname1, PGE1);              // PGE
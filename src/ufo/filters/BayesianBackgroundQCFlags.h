@@ -72,6 +72,7 @@ class BayesianBackgroundQCFlags : public FilterBase,
   void applyFilter(const std::vector<bool> &, const Variables &,
                    std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override {return QCflags::bayesianQC;}
+  bool modifiesObsSpace() const override {return true;}
 
   /// Get the name of the variable whose PGE is tested in order to
   /// set the QC flags for the variable \p varname.
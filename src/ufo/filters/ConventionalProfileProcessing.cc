@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <exception>
 #include <iomanip>
 #include <limits>
 #include <vector>
@@ -87,6 +88,15 @@ namespace ufo {
    ProfileChecker &profileChecker,
    const CheckSubgroup &subGroupChecks) const
   {
+    if (options_.NumThreads.value() > 1 &&
+        !options_.PrintStationID.value() &&
+        !options_.compareWithOPS.value()) {
+      individualProfileChecksInParallel(profileDataHandler,
+                                        profileChecker,
+                                        subGroupChecks);
+      return;
+    }
+
     const int nprofs = static_cast <int> (obsdb_.nrecs());
 
     // Reset profile indices prior to looping through entire sample.
@@ -126,6 +136,54 @@ namespace ufo {
 
   // -----------------------------------------------------------------------------
 
+  void ConventionalProfileProcessing::individualProfileChecksInParallel
+  (ProfileDataHandler &profileDataHandler,
+   ProfileChecker &profileChecker,
+   const CheckSubgroup &subGroupChecks) const
+  {
+    // Determine the indices of all profiles in advance so that they can be visited in any order.
+    const std::vector <ProfileIndices::ProfileInfo> profiles =
+      profileDataHandler.getAllProfileIndices();
+    const int nprofs = static_cast <int> (profiles.size());
+
+    oops::Log::debug() << "Starting parallel loop over profiles..." << std::endl;
+
+    // Exceptions must not escape the parallel region; the first one is rethrown afterwards.
+    std::exception_ptr error;
+    bool basicCheckResult = true;
+    #pragma omp parallel num_threads(options_.NumThreads.value())
+    {
+      ProfileDataHandler threadDataHandler(profileDataHandler);
+      ProfileChecker threadChecker(profileChecker);
+      #pragma omp for schedule(dynamic)
+      for (int jprof = 0; jprof < nprofs; ++jprof) {
+        try {
+          threadDataHandler.initialiseProfile(profiles[jprof]);
+          threadChecker.runChecks(threadDataHandler,
+                                  subGroupChecks);
+          threadDataHandler.updateProfileInformation();
+        } catch (...) {
+          #pragma omp critical(ConventionalProfileProcessingError)
+          if (!error) error = std::current_exception();
+        }
+      }
+      #pragma omp critical(ConventionalProfileProcessingBasicCheck)
+      basicCheckResult = basicCheckResult && threadChecker.getBasicCheckResult();
+    }
+    if (error)
+      std::rethrow_exception(error);
+    if (!basicCheckResult)
+      profileChecker.setBasicCheckResult(false);
+
+    // Write various quantities to the obsdb.
+    profileDataHandler.writeQuantitiesToObsdb();
+
+    oops::Log::debug() << "... Finished parallel loop over profiles" << std::endl;
+    oops::Log::debug() << std::endl;
+  }
+
+  // -----------------------------------------------------------------------------
+
   void ConventionalProfileProcessing::entireSampleChecks
   (ProfileDataHandler &profileDataHandler,
    ProfileCheckValidator &profileCheckValidator,
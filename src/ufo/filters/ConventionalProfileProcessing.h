@@ -108,6 +108,13 @@ namespace ufo {
                                    ProfileChecker &profileChecker,
                                    const CheckSubgroup &subGroupChecks) const;
 
+      /// Run checks on individual profiles concurrently on \p NumThreads OpenMP threads.
+      /// Each thread has its own ProfileDataHandler and ProfileChecker, which share the
+      /// entire data sample of \p profileDataHandler.
+      void individualProfileChecksInParallel(ProfileDataHandler &profileDataHandler,
+                                             ProfileChecker &profileChecker,
+                                             const CheckSubgroup &subGroupChecks) const;
+
       /// Run checks that use all of the profiles at once.
       void entireSampleChecks(ProfileDataHandler &profileDataHandler,
                               ProfileCheckValidator &profileCheckValidator,
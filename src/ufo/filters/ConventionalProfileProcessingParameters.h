@@ -39,6 +39,12 @@ namespace ufo {
     /// Print station ID
     oops::Parameter<bool> PrintStationID {"PrintStationID", false, this};
 
+    /// Number of OpenMP threads used to run the checks on different profiles concurrently.
+    /// Each profile is written to its own elements of the entire sample, so the results do
+    /// not depend on the number of threads. Debug output from different profiles may be
+    /// interleaved. PrintStationID and compareWithOPS force a single thread.
+    oops::Parameter<int> NumThreads {"NumThreads", 1, this};
+
     /// @}
 
     /// @name Standard level-related parameters
@@ -7,10 +7,13 @@
 
 #include "ufo/filters/FilterBase.h"
 
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "eckit/config/Configuration.h"
+#include "eckit/mpi/Comm.h"
 
 #include "ioda/ObsDataVector.h"
 #include "ioda/ObsSpace.h"
@@ -19,10 +22,13 @@
 #include "oops/util/Logger.h"
 
 #include "ufo/filters/actions/FilterAction.h"
+#include "ufo/filters/actions/FilterActionBase.h"
 #include "ufo/filters/GenericFilterParameters.h"
 #include "ufo/filters/processWhere.h"
+#include "ufo/filters/QCflags.h"
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
+#include "ufo/utils/BitMask.h"
 
 namespace ufo {
 
@@ -36,10 +42,15 @@ FilterBase::FilterBase(ioda::ObsSpace & os,
     filtervars_(),
     whereParameters_(parameters.where),
     whereOperator_(parameters.whereOperator),
-    actionsParameters_(parameters.actions())
+    actionsParameters_(parameters.actions()),
+    actionsModifyOnlyPassedObs_(true)
 {
   oops::Log::trace() << "FilterBase constructor" << std::endl;
 
+  if (parameters.cacheObsFunctions)
+    data_.useCache(cache_);
+  prefetchObsSpaceVariables_ = parameters.prefetchObsSpaceVariables;
+
   // Identify filter variables
   if (parameters.filterVariables.value() != boost::none) {
   // read filter variables
@@ -67,6 +78,7 @@ FilterBase::FilterBase(ioda::ObsSpace & os,
                              "any other actions performed by the same filter", Here());
     }
     allvars_ += action.requiredVariables();
+    actionsModifyOnlyPassedObs_ = actionsModifyOnlyPassedObs_ && action.modifiesOnlyPassedObs();
   }
 }
 
@@ -92,9 +104,6 @@ FilterBase::~FilterBase() {
 void FilterBase::doFilter() const {
   oops::Log::trace() << "FilterBase doFilter begin" << std::endl;
 
-// Select locations to which the filter will be applied
-  std::vector<bool> apply = processWhere(whereParameters_, data_, whereOperator_);
-
   ufo::Variables vars;
   if (post_) {
     oops::Variables oopsfiltersimvars = filtersimvars_.toOopsVariables();
@@ -113,6 +122,25 @@ void FilterBase::doFilter() const {
     vars += filtervars_;
   }
 
+// Filters modifying only QC flags and obs errors are skipped if they cannot change any
+// observation: first (before any filter data are retrieved) if all their actions leave
+// observations that have not passed QC unchanged and no observations have passed QC, then if the
+// where clause selects no such observations.
+  const bool skippable = !modifiesObsSpace();
+  if (skippable && actionsModifyOnlyPassedObs_ &&
+      !selectsAnyObs(vars, std::vector<bool>(obsdb_.nlocs(), true), true)) {
+    oops::Log::debug() << "FilterBase: no observations passed QC so far, skipping "
+                       << *this << std::endl;
+    return;
+  }
+
+// Select locations to which the filter will be applied
+  std::vector<bool> apply = processWhere(whereParameters_, data_, whereOperator_);
+  if (skippable && !selectsAnyObs(vars, apply, actionsModifyOnlyPassedObs_)) {
+    oops::Log::debug() << "FilterBase: no observations selected, skipping " << *this << std::endl;
+    return;
+  }
+
 // Allocate flagged obs indicator (false by default)
   const size_t nvars = vars.nvars();
   std::vector<std::vector<bool>> flagged(nvars);
@@ -121,11 +149,35 @@ void FilterBase::doFilter() const {
 // Apply filter
   this->applyFilter(apply, vars, flagged);
 
-// Take actions
+// Pack the flags so that actions can skip 64 unflagged locations at a time
+  const std::vector<BitMask> flaggedMasks = toBitMasks(flagged);
+  profileSelection(BitMask(apply), flaggedMasks);
+
+// Take actions. The per-observation kernels of consecutive actions are fused into a single pass
+// over the flagged observations. An action requiring filter data starts a new pass, since this
+// data may depend on the QC flags and obs errors modified by the preceding actions.
+  std::vector<std::unique_ptr<FilterActionKernel>> kernels;
+  auto applyPendingKernels = [&] {
+    std::vector<const FilterActionKernel *> pending;
+    for (const std::unique_ptr<FilterActionKernel> &kernel : kernels)
+      pending.push_back(kernel.get());
+    applyKernels(pending, vars, flaggedMasks, *flags_, *obserr_);
+    kernels.clear();
+  };
   for (const std::unique_ptr<FilterActionParametersBase> &actionParameters : actionsParameters_) {
     FilterAction action(*actionParameters);
-    action.apply(vars, flagged, data_, this->qcFlag(), *flags_, *obserr_);
+    if (action.requiredVariables().size() > 0)
+      applyPendingKernels();
+    std::unique_ptr<FilterActionKernel> kernel =
+        action.makeKernel(vars, data_, this->qcFlag(), *obserr_);
+    if (kernel) {
+      kernels.push_back(std::move(kernel));
+    } else {
+      applyPendingKernels();
+      action.applyToMasks(vars, flaggedMasks, data_, this->qcFlag(), *flags_, *obserr_);
+    }
   }
+  applyPendingKernels();
 
 // Done
   oops::Log::trace() << "FilterBase doFilter end" << std::endl;
@@ -133,4 +185,38 @@ void FilterBase::doFilter() const {
 
 // -----------------------------------------------------------------------------
 
+bool FilterBase::selectsAnyObs(const Variables & vars, const std::vector<bool> & apply,
+                               bool onlyPassedObs) const {
+  std::vector<const std::vector<int> *> varFlags;
+  if (onlyPassedObs) {
+    for (size_t jv = 0; jv < vars.nvars(); ++jv) {
+      const std::string varname = vars.variable(jv).variable();
+      // Observations of variables without QC flags can't be ruled out
+      if (!flags_->varnames().has(varname)) {
+        onlyPassedObs = false;
+        break;
+      }
+      varFlags.push_back(&(*flags_)[varname]);
+    }
+  }
+
+  int selected = 0;
+  for (size_t jloc = 0; jloc < apply.size() && !selected; ++jloc) {
+    if (!apply[jloc])
+      continue;
+    if (!onlyPassedObs) {
+      selected = 1;
+    } else {
+      for (const std::vector<int> * flags : varFlags)
+        if ((*flags)[jloc] == QCflags::pass)
+          selected = 1;
+    }
+  }
+  // All ranks must take the same decision, since the filter may communicate between them
+  obsdb_.comm().allReduceInPlace(selected, eckit::mpi::max());
+  return selected != 0;
+}
+
+// -----------------------------------------------------------------------------
+
 }  // namespace ufo
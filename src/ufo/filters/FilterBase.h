@@ -71,14 +71,25 @@ class FilterBase : public ObsProcessorBase {
 
  private:
   void doFilter() const override;
+  /// Filters normally modify only QC flags and observation errors. Subclasses writing other
+  /// data to the ObsSpace must override this function to return true.
+  bool modifiesObsSpace() const override {return false;}
   void print(std::ostream &) const override = 0;
   virtual void applyFilter(const std::vector<bool> &, const Variables &,
                            std::vector<std::vector<bool>> &) const = 0;
   virtual int qcFlag() const = 0;
 
+  /// \brief Return true if the filter may change any observation on any MPI rank, i.e. if
+  /// \p apply selects at least one location at which (if \p onlyPassedObs is true) the QC flag
+  /// of at least one of the filter variables \p vars is `pass`.
+  bool selectsAnyObs(const Variables &vars, const std::vector<bool> &apply,
+                     bool onlyPassedObs) const;
+
   std::vector<WhereParameters> whereParameters_;
   WhereOperator whereOperator_;
   std::vector<std::unique_ptr<FilterActionParametersBase>> actionsParameters_;
+  /// True if all actions leave observations that have not passed QC so far unchanged.
+  bool actionsModifyOnlyPassedObs_;
 };
 
 }  // namespace ufo
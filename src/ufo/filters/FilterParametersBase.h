@@ -66,6 +66,17 @@ class FilterParametersBaseWithAbstractActions : public oops::ObsFilterParameters
   /// doesn't require any variables from the GeoVaLs or HofX groups).
   oops::Parameter<bool> deferToPost{"defer to post", false, this};
 
+  /// If set to true, values of ObsFunctions evaluated by this filter will be reused by (and
+  /// reuse values computed by) other filters acting on the same ObsSpace with this option
+  /// enabled, as long as the data these values depend on cannot have changed.
+  oops::Parameter<bool> cacheObsFunctions{"cache obs functions", false, this};
+
+  /// If set to true, the ObsSpace variables required by the filter (e.g. in its `where` clause
+  /// or actions) are read in one go before the filter runs and kept in memory until it
+  /// finishes, instead of being read from the ObsSpace each time they are retrieved. This is
+  /// ignored by filters that modify the ObsSpace.
+  oops::Parameter<bool> prefetchObsSpaceVariables{"prefetch obs space variables", false, this};
+
   /// Return parameters specifying the actions to be performed on observations flagged by the
   /// filter.
   virtual std::vector<std::unique_ptr<FilterActionParametersBase>> actions() const = 0;
@@ -0,0 +1,219 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/FilterProfiler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <ostream>
+#include <utility>
+
+#include "eckit/log/JSON.h"
+#include "eckit/mpi/Comm.h"
+
+namespace ufo {
+
+namespace {
+
+const char *stageName(oops::FilterStage stage) {
+  switch (stage) {
+  case oops::FilterStage::PRE:
+    return "pre";
+  case oops::FilterStage::PRIOR:
+    return "prior";
+  case oops::FilterStage::POST:
+    return "post";
+  default:
+    return "auto";
+  }
+}
+
+/// Name of the stage measured by \p record.
+template <typename Record>
+const char *recordStageName(const Record &record) {
+  return record.construction ? "init" : stageName(record.stage);
+}
+
+ProfilerRegistry<FilterProfiler> &registry() {
+  static ProfilerRegistry<FilterProfiler> profilers;
+  return profilers;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<FilterProfiler> FilterProfiler::forObsSpace(const ioda::ObsSpace &obsdb) {
+  const char *output = std::getenv("UFO_FILTER_PROFILE");
+  if (output == nullptr)
+    return nullptr;
+  return registry().getOrCreate(&obsdb, [&] {
+      return std::make_shared<FilterProfiler>(obsdb, output);
+    });
+}
+
+// -----------------------------------------------------------------------------
+
+FilterProfiler::FilterProfiler(const ioda::ObsSpace &obsdb, const std::string &output)
+  : ProfilerBase("FilterProfiler", obsdb, output), obsdb_(&obsdb)
+{}
+
+// -----------------------------------------------------------------------------
+
+FilterProfiler::~FilterProfiler() {
+  registry().remove(obsdb_, this);
+  reportOnDestruction();
+}
+
+// -----------------------------------------------------------------------------
+
+size_t FilterProfiler::addProcessor(const std::string &name) {
+  processorNames_.push_back(name);
+  return processorNames_.size() - 1;
+}
+
+// -----------------------------------------------------------------------------
+
+void FilterProfiler::addConstruction(size_t processor, double seconds, double heapBytes) {
+  Record record;
+  record.processor = processor;
+  record.stage = oops::FilterStage::AUTO;
+  record.construction = true;
+  record.seconds = seconds;
+  record.heapBytes = heapBytes;
+  records_.push_back(record);
+}
+
+// -----------------------------------------------------------------------------
+
+size_t FilterProfiler::record(size_t processor, oops::FilterStage stage) {
+  for (size_t i = 0; i < records_.size(); ++i)
+    if (records_[i].processor == processor && !records_[i].construction &&
+        records_[i].stage == stage)
+      return i;
+  Record record;
+  record.processor = processor;
+  record.stage = stage;
+  records_.push_back(record);
+  return records_.size() - 1;
+}
+
+// -----------------------------------------------------------------------------
+
+void FilterProfiler::addSelection(size_t processor, size_t considered, size_t flagged) {
+  // Selections are only made while a processor is being measured.
+  if (currentRecord_ < records_.size() && records_[currentRecord_].processor == processor) {
+    records_[currentRecord_].considered += considered;
+    records_[currentRecord_].flagged += flagged;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+FilterProfiler::Measurement::Measurement(FilterProfiler &profiler, size_t processor,
+                                         oops::FilterStage stage, const size_t &numGetCalls)
+  : profiler_(profiler), record_(profiler.record(processor, stage)),
+    numGetCalls_(numGetCalls), startNumGetCalls_(numGetCalls),
+    startHeapBytes_(ProfilerBase::heapBytes()),
+    startTime_(std::chrono::steady_clock::now())
+{
+  profiler_.currentRecord_ = record_;
+}
+
+// -----------------------------------------------------------------------------
+
+FilterProfiler::Measurement::~Measurement() {
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime_;
+  Record &record = profiler_.records_[record_];
+  record.seconds += elapsed.count();
+  record.heapBytes += ProfilerBase::heapBytes() - startHeapBytes_;
+  record.getCalls += numGetCalls_ - startNumGetCalls_;
+  profiler_.currentRecord_ = profiler_.records_.size();
+}
+
+// -----------------------------------------------------------------------------
+
+void FilterProfiler::report() const {
+  // All tasks run the same processors at the same stages, but not necessarily in the same order
+  // (e.g. if a processor was first run at the post stage). Sort the records so that
+  // corresponding records are reduced together. The construction record of each processor comes
+  // first.
+  std::vector<Record> records = records_;
+  std::stable_sort(records.begin(), records.end(), [](const Record &a, const Record &b) {
+      return std::make_pair(a.processor, a.construction ? -1 : static_cast<int>(a.stage)) <
+             std::make_pair(b.processor, b.construction ? -1 : static_cast<int>(b.stage));
+    });
+  std::vector<std::string> keys;
+  for (const Record &record : records)
+    keys.push_back(processorNames_.at(record.processor) + "/" + recordStageName(record));
+  if (!sameKeysOnAllTasks(keys, "the processor stages"))
+    return;
+
+  const size_t n = records.size();
+  std::vector<double> minima(2 * n), maxima(2 * n), sums(5 * n);
+  for (size_t i = 0; i < n; ++i) {
+    minima[2 * i] = maxima[2 * i] = sums[5 * i] = records[i].seconds;
+    minima[2 * i + 1] = maxima[2 * i + 1] = sums[5 * i + 1] = records[i].heapBytes;
+    sums[5 * i + 2] = records[i].considered;
+    sums[5 * i + 3] = records[i].flagged;
+    sums[5 * i + 4] = records[i].getCalls;
+  }
+  comm_.allReduceInPlace(minima.begin(), minima.end(), eckit::mpi::min());
+  comm_.allReduceInPlace(maxima.begin(), maxima.end(), eckit::mpi::max());
+  comm_.allReduceInPlace(sums.begin(), sums.end(), eckit::mpi::sum());
+
+  const double ntasks = comm_.size();
+  auto writeJson = [&](eckit::JSON &json) {
+    json << "processors";
+    json.startList();
+    for (size_t i = 0; i < n; ++i) {
+      json.startObject();
+      json << "index" << records[i].processor;
+      json << "name" << processorNames_.at(records[i].processor);
+      json << "stage" << recordStageName(records[i]);
+      json << "wall time min s" << minima[2 * i];
+      json << "wall time mean s" << sums[5 * i] / ntasks;
+      json << "wall time max s" << maxima[2 * i];
+      json << "heap growth min bytes" << minima[2 * i + 1];
+      json << "heap growth mean bytes" << sums[5 * i + 1] / ntasks;
+      json << "heap growth max bytes" << maxima[2 * i + 1];
+      json << "considered" << sums[5 * i + 2];
+      json << "flagged" << sums[5 * i + 3];
+      json << "get calls" << sums[5 * i + 4];
+      json.endObject();
+    }
+    json.endList();
+  };
+  auto writeTable = [&](std::ostream &os) {
+    os << "FilterProfiler: " << obsname_ << " (" << comm_.size() << " tasks; wall time in s "
+       << "and heap growth in MB: min/mean/max over tasks; counts: totals)\n";
+    os << std::setw(4) << "#" << "  " << std::left << std::setw(36) << "processor"
+       << std::setw(6) << "stage" << std::right
+       << std::setw(30) << "wall time" << std::setw(27) << "heap growth"
+       << std::setw(12) << "considered" << std::setw(12) << "flagged"
+       << std::setw(10) << "gets" << "\n";
+    os << std::fixed;
+    for (size_t i = 0; i < n; ++i) {
+      const double mb = 1.0 / (1024.0 * 1024.0);
+      os << std::setw(4) << records[i].processor << "  " << std::left << std::setw(36)
+         << processorNames_.at(records[i].processor).substr(0, 35)
+         << std::setw(6) << recordStageName(records[i]) << std::right << std::setprecision(4)
+         << std::setw(10) << minima[2 * i] << std::setw(10) << sums[5 * i] / ntasks
+         << std::setw(10) << maxima[2 * i] << std::setprecision(1)
+         << std::setw(9) << minima[2 * i + 1] * mb << std::setw(9) << sums[5 * i + 1] / ntasks * mb
+         << std::setw(9) << maxima[2 * i + 1] * mb << std::setprecision(0)
+         << std::setw(12) << sums[5 * i + 2] << std::setw(12) << sums[5 * i + 3]
+         << std::setw(10) << sums[5 * i + 4] << "\n";
+    }
+  };
+  writeReport(writeJson, writeTable);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,106 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_FILTERPROFILER_H_
+#define UFO_FILTERS_FILTERPROFILER_H_
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "oops/generic/ObsFilterParametersBase.h"
+#include "ufo/ProfilerBase.h"
+
+namespace ioda {
+class ObsSpace;
+}
+
+namespace ufo {
+
+/// \brief Collects the cost of each observation processor acting on an ObsSpace.
+///
+/// \details Profiling is enabled by setting the environment variable `UFO_FILTER_PROFILE`.
+/// A single instance of this class is then shared by all processors acting on the same ObsSpace
+/// (see forObsSpace()) and kept alive by them (see ObsProcessorBase). For each processor and
+/// each stage (pre, prior or post) at which it runs, it records the wall time, the number of
+/// locations selected by the `where` clause (`considered`), the number of filter variable values
+/// flagged, the number of variables retrieved from ObsFilterData and the net growth of the heap.
+/// It also records the wall time and heap growth of the construction of each processor (stage
+/// `init`), so that processors that are expensive to set up can be identified.
+///
+/// When the last processor acting on the ObsSpace is destroyed, the records are combined over
+/// all MPI tasks (minimum, mean and maximum of the wall time and heap growth, to expose load
+/// imbalance, and totals of the counts) and written out as described in ProfilerBase.
+class FilterProfiler : public ProfilerBase {
+ public:
+  /// \brief Return the profiler shared by all processors acting on \p obsdb, creating it if
+  /// necessary, or null if profiling is disabled.
+  static std::shared_ptr<FilterProfiler> forObsSpace(const ioda::ObsSpace &obsdb);
+
+  FilterProfiler(const ioda::ObsSpace &obsdb, const std::string &output);
+  ~FilterProfiler() override;
+
+  /// \brief Register a processor called \p name and return its index. Processors must be
+  /// registered in the same order on all MPI tasks.
+  size_t addProcessor(const std::string &name);
+
+  /// \brief Record the cost of constructing the processor \p processor.
+  void addConstruction(size_t processor, double seconds, double heapBytes);
+
+  /// \brief Measures the cost of running a processor at a particular stage, from construction
+  /// to destruction.
+  class Measurement : private boost::noncopyable {
+   public:
+    /// \param numGetCalls
+    ///   Number of variables retrieved from ObsFilterData by the processor so far.
+    Measurement(FilterProfiler &profiler, size_t processor, oops::FilterStage stage,
+                const size_t &numGetCalls);
+    ~Measurement();
+
+   private:
+    FilterProfiler &profiler_;
+    size_t record_;
+    const size_t &numGetCalls_;
+    size_t startNumGetCalls_;
+    long long startHeapBytes_;  // NOLINT(runtime/int)
+    std::chrono::steady_clock::time_point startTime_;
+  };
+
+  /// \brief Record the number of locations selected by the `where` clause and the number of
+  /// values flagged by the processor \p processor running at the current stage.
+  void addSelection(size_t processor, size_t considered, size_t flagged);
+
+ private:
+  struct Record {
+    size_t processor;
+    oops::FilterStage stage;
+    /// True if this record measures the construction of the processor rather than a stage.
+    bool construction = false;
+    double seconds = 0.0;
+    double heapBytes = 0.0;
+    double considered = 0.0;
+    double flagged = 0.0;
+    double getCalls = 0.0;
+  };
+
+  /// Return the index of the record of processor \p processor at the stage \p stage.
+  size_t record(size_t processor, oops::FilterStage stage);
+  void report() const override;
+
+  const ioda::ObsSpace *obsdb_;
+  std::vector<std::string> processorNames_;
+  std::vector<Record> records_;
+  /// Index of the record of the processor currently being measured.
+  size_t currentRecord_ = 0;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_FILTERPROFILER_H_
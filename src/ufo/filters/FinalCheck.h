@@ -50,6 +50,7 @@ class FinalCheck : public ObsProcessorBase,
 
  private:
   void print(std::ostream &) const override;
+  bool modifiesObsSpace() const override {return false;}
 };
 
 }  // namespace ufo
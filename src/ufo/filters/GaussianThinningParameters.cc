@@ -39,6 +39,21 @@ void GaussianThinningParameters::deserialize(util::CompositePath &path,
             path.path() + ": distance_norm must not be set to 'geodesic' when "
                           "ops_compatibility_mode is set to true", Here());
   }
+
+  if (distributeBinsAcrossRanks) {
+    if (selectMedian)
+      throw eckit::UserError(
+            path.path() + ": select_median must not be set to true when "
+                          "distribute_bins_across_ranks is set to true", Here());
+    if (opsCompatibilityMode)
+      throw eckit::UserError(
+            path.path() + ": ops_compatibility_mode must not be set to true when "
+                          "distribute_bins_across_ranks is set to true", Here());
+    if (recordsAreSingleObs)
+      throw eckit::UserError(
+            path.path() + ": records_are_single_obs must not be set to true when "
+                          "distribute_bins_across_ranks is set to true", Here());
+  }
 }
 
 }  // namespace ufo
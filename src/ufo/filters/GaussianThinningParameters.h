@@ -231,6 +231,22 @@ class GaussianThinningParameters : public FilterParametersBase {
   /// each record must contain only one value of the category variable.
   oops::Parameter<bool> recordsAreSingleObs{"records_are_single_obs", false, this};
 
+  /// Set this option to \c true to avoid gathering all observations on each MPI rank. Instead,
+  /// each bin is assigned to a single rank, which receives the observations lying in that bin
+  /// from all other ranks, selects the one to retain and informs the rank holding it. The
+  /// memory use and cost of thinning then scale with the number of observations held on each
+  /// rank rather than the total number of observations.
+  ///
+  /// The set of retained observations is the same as with this option set to \c false.
+  ///
+  /// This option is ignored if the filter is run on a single process, if the category variable
+  /// was used to group observations into records (since each process then thins its observations
+  /// independently from others) or if some observations are held on multiple processes (e.g. when
+  /// the Halo or InefficientDistribution distribution is used). It cannot be combined with the
+  /// \c select_median, \c ops_compatibility_mode and \c records_are_single_obs options, and
+  /// the category variable (if any) must be integer-valued.
+  oops::Parameter<bool> distributeBinsAcrossRanks{"distribute_bins_across_ranks", false, this};
+
  private:
   static float defaultHorizontalMesh() {
     return static_cast<float>(2 * M_PI * Constants::mean_earth_rad / 360.0);
@@ -8,12 +8,18 @@
 #include "ufo/filters/Gaussian_Thinning.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
 #include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include "eckit/mpi/Comm.h"
+#include "ioda/distribution/Distribution.h"
 #include "ioda/ObsDataVector.h"
 #include "ioda/ObsSpace.h"
 #include "oops/base/Variables.h"
@@ -37,6 +43,55 @@
 
 namespace ufo {
 
+namespace {
+
+/// Key identifying a bin: indices of the category, time bin, vertical bin, latitude bin and
+/// longitude bin (set to 0 if thinning along a particular direction is disabled).
+typedef std::array<int, 5> BinKey;
+
+/// Number of ints sent to the owner of a bin for each observation: the bin key and the priority.
+const size_t numIntsPerObs = std::tuple_size<BinKey>::value + 1;
+/// Number of 64-bit integers sent to the owner of a bin for each observation: the global location
+/// index and the observation time (in seconds since the start of the assimilation window).
+const size_t numIdsAndTimesPerObs = 2;
+
+/// Return the MPI rank owning the bin with key \p key.
+///
+/// Bins are assigned to ranks pseudo-randomly rather than in contiguous blocks (e.g. latitude
+/// bands) so that the workload stays balanced even if observations are concentrated in a small
+/// part of the globe.
+size_t binOwner(const BinKey &key, size_t numRanks) {
+  uint64_t hash = 14695981039346656037ull;
+  for (int component : key) {
+    hash ^= static_cast<uint32_t>(component);
+    hash *= 1099511628211ull;
+  }
+  return hash % numRanks;
+}
+
+/// Properties of an observation used to decide whether it should be retained.
+struct Candidate {
+  int priority;
+  float distanceToBinCenter;
+  int64_t time;
+  int64_t globalObsId;
+};
+
+/// Return true if \p a should be retained in preference to \p b. This reproduces the order
+/// in which observations are ranked by Gaussian_Thinning::makeObservationSortKeys(), with ties
+/// broken in favour of the observation with the smaller global location index.
+bool isBetter(const Candidate &a, const Candidate &b, bool tiebreakerPickLatest) {
+  if (a.priority != b.priority)
+    return a.priority > b.priority;
+  if (a.distanceToBinCenter != b.distanceToBinCenter)
+    return a.distanceToBinCenter < b.distanceToBinCenter;
+  if (tiebreakerPickLatest && a.time != b.time)
+    return a.time > b.time;
+  return a.globalObsId < b.globalObsId;
+}
+
+}  // namespace
+
 // -----------------------------------------------------------------------------
 
 Gaussian_Thinning::Gaussian_Thinning(ioda::ObsSpace & obsdb,
@@ -55,6 +110,11 @@ void Gaussian_Thinning::applyFilter(const std::vector<bool> & apply,
                                     std::vector<std::vector<bool>> & flagged) const {
   ObsAccessor obsAccessor = createObsAccessor();
 
+  if (shouldDistributeBins(obsAccessor)) {
+    applyFilterWithDistributedBins(apply, filtervars, flagged);
+    return;
+  }
+
   bool retainOnlyIfAllFilterVariablesAreValid =
           options_.retainOnlyIfAllFilterVariablesAreValid.value();
 
@@ -83,7 +143,8 @@ void Gaussian_Thinning::applyFilter(const std::vector<bool> & apply,
   if (options_.opsCompatibilityMode) {
     // Sort observations by latitude
     const std::vector<float> lat = obsAccessor.getFloatVariableFromObsSpace("MetaData", "latitude");
-    metOfficeSort(validObsIds.begin(), validObsIds.end(), [&lat] (size_t id) { return lat[id]; });
+    metOfficeSort(validObsIds.begin(), validObsIds.end(), [&lat] (size_t id) { return lat[id]; },
+                  MetOfficeSortAlgorithm::BUFFERED);
   }
 
   std::vector<float> distancesToBinCenter(validObsIds.size(), 0.f);
@@ -154,6 +215,162 @@ ObsAccessor Gaussian_Thinning::createObsAccessor() const {
 
 // -----------------------------------------------------------------------------
 
+bool Gaussian_Thinning::shouldDistributeBins(const ObsAccessor &obsAccessor) const {
+  if (!options_.distributeBinsAcrossRanks)
+    return false;
+
+  const eckit::mpi::Comm &comm = obsdb_.comm();
+  // Nothing to gain if there is a single rank or if each rank deals with its own records anyway.
+  if (comm.size() == 1 || !obsAccessor.areObservationsSharedByAllRanks())
+    return false;
+
+  // Bins can only be distributed if each location is held by a single rank (this is not the
+  // case e.g. for the Halo and InefficientDistribution distributions).
+  size_t numLocs = obsdb_.nlocs();
+  comm.allReduceInPlace(numLocs, eckit::mpi::sum());
+  if (numLocs != obsdb_.globalNumLocs()) {
+    oops::Log::debug() << "Gaussian_Thinning: some locations are held on multiple ranks; "
+                       << "bins will not be distributed" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void Gaussian_Thinning::applyFilterWithDistributedBins(
+    const std::vector<bool> & apply,
+    const Variables & filtervars,
+    std::vector<std::vector<bool>> & flagged) const {
+  const eckit::mpi::Comm &comm = obsdb_.comm();
+  const size_t numRanks = comm.size();
+
+  const bool retainOnlyIfAllFilterVariablesAreValid =
+          options_.retainOnlyIfAllFilterVariablesAreValid.value();
+
+  // All data retrieved through this accessor come from the current rank only.
+  const ObsAccessor obsAccessor = ObsAccessor::toObservationsHeldOnCurrentRank(obsdb_);
+
+  const std::vector<size_t> validObsIds = obsAccessor.getValidObservationIds(
+        apply, *flags_, filtervars, !retainOnlyIfAllFilterVariablesAreValid);
+  const size_t numValidObs = validObsIds.size();
+
+  std::vector<float> distancesToBinCenter(numValidObs, 0.f);
+  std::unique_ptr<DistanceCalculator> distanceCalculator = makeDistanceCalculator(options_);
+
+  std::vector<int> categories;
+  if (options_.categoryVariable.value() != boost::none) {
+    const Variable &categoryVariable = *options_.categoryVariable.value();
+    if (obsdb_.dtype(categoryVariable.group(), categoryVariable.variable()) !=
+        ioda::ObsDtype::Integer)
+      throw eckit::UserError(categoryVariable.fullName() + " must be an integer variable if "
+                             "distribute_bins_across_ranks is set to true", Here());
+    const std::vector<int> allCategories = obsAccessor.getIntVariableFromObsSpace(
+          categoryVariable.group(), categoryVariable.variable());
+    for (size_t obsId : validObsIds)
+      categories.push_back(allCategories[obsId]);
+  }
+  std::vector<int> verticalBins, timeBins, latBins, lonBins;
+  calculateVerticalBins(validObsIds, *distanceCalculator, obsAccessor,
+                        verticalBins, distancesToBinCenter);
+  calculateTimeBins(validObsIds, *distanceCalculator, obsAccessor,
+                    timeBins, distancesToBinCenter);
+  calculateSpatialBins(validObsIds, *distanceCalculator, obsAccessor,
+                       latBins, lonBins, distancesToBinCenter);
+  for (std::vector<int> *bins : {&categories, &verticalBins, &timeBins, &latBins, &lonBins})
+    bins->resize(numValidObs, 0);
+
+  std::vector<int> priorities(obsdb_.nlocs(), 0);
+  if (options_.priorityVariable.value() != boost::none) {
+    const ufo::Variable priorityVariable = options_.priorityVariable.value().get();
+    priorities = obsAccessor.getIntVariableFromObsSpace(
+          priorityVariable.group(), priorityVariable.variable());
+  }
+
+  std::vector<int64_t> times(obsdb_.nlocs(), 0);
+  if (options_.tiebreakerPickLatest) {
+    times = obsAccessor.getEpochSecondsFromObsSpace("MetaData", "dateTime");
+    const int64_t windowStart = ObsAccessor::toEpochSeconds(obsdb_.windowStart());
+    for (int64_t &time : times)
+      time -= windowStart;
+  }
+
+  // Send each valid observation to the owner of the bin it lies in.
+  std::vector<std::vector<int>> intsToSend(numRanks);
+  std::vector<std::vector<float>> floatsToSend(numRanks);
+  std::vector<std::vector<int64_t>> idsAndTimesToSend(numRanks);
+  // IDs of the observations sent to each rank, in the order in which they were sent.
+  std::vector<std::vector<size_t>> sentObsIds(numRanks);
+  const std::shared_ptr<const ioda::Distribution> distribution = obsdb_.distribution();
+  for (size_t validObsIndex = 0; validObsIndex < numValidObs; ++validObsIndex) {
+    const size_t obsId = validObsIds[validObsIndex];
+    const BinKey key{categories[validObsIndex], timeBins[validObsIndex],
+                     verticalBins[validObsIndex], latBins[validObsIndex], lonBins[validObsIndex]};
+    const size_t owner = binOwner(key, numRanks);
+    intsToSend[owner].insert(intsToSend[owner].end(), key.begin(), key.end());
+    intsToSend[owner].push_back(priorities[obsId]);
+    floatsToSend[owner].push_back(distancesToBinCenter[validObsIndex]);
+    idsAndTimesToSend[owner].push_back(distribution->globalUniqueConsecutiveLocationIndex(obsId));
+    idsAndTimesToSend[owner].push_back(times[obsId]);
+    sentObsIds[owner].push_back(obsId);
+  }
+
+  std::vector<std::vector<int>> receivedInts;
+  std::vector<std::vector<float>> receivedFloats;
+  std::vector<std::vector<int64_t>> receivedIdsAndTimes;
+  comm.allToAll(intsToSend, receivedInts);
+  comm.allToAll(floatsToSend, receivedFloats);
+  comm.allToAll(idsAndTimesToSend, receivedIdsAndTimes);
+
+  // Find the best observation in each bin owned by the current rank. Each observation is
+  // identified by the rank that sent it and its position in the list of observations sent
+  // by that rank.
+  typedef std::pair<size_t, size_t> SenderAndIndex;
+  std::map<BinKey, std::pair<SenderAndIndex, Candidate>> bestCandidates;
+  for (size_t sender = 0; sender < numRanks; ++sender) {
+    const size_t numReceivedObs = receivedFloats[sender].size();
+    ASSERT(receivedInts[sender].size() == numReceivedObs * numIntsPerObs);
+    ASSERT(receivedIdsAndTimes[sender].size() == numReceivedObs * numIdsAndTimesPerObs);
+    for (size_t index = 0; index < numReceivedObs; ++index) {
+      const int *ints = &receivedInts[sender][index * numIntsPerObs];
+      BinKey key;
+      std::copy(ints, ints + key.size(), key.begin());
+      const Candidate candidate{ints[key.size()], receivedFloats[sender][index],
+                                receivedIdsAndTimes[sender][index * numIdsAndTimesPerObs + 1],
+                                receivedIdsAndTimes[sender][index * numIdsAndTimesPerObs]};
+      const auto inserted = bestCandidates.emplace(
+            key, std::make_pair(SenderAndIndex(sender, index), candidate));
+      if (!inserted.second &&
+          isBetter(candidate, inserted.first->second.second, options_.tiebreakerPickLatest))
+        inserted.first->second = std::make_pair(SenderAndIndex(sender, index), candidate);
+    }
+  }
+
+  // Tell each rank which of the observations it sent should be retained.
+  std::vector<std::vector<int>> retainedIndicesToSend(numRanks);
+  for (const auto &keyAndBestCandidate : bestCandidates) {
+    const SenderAndIndex &senderAndIndex = keyAndBestCandidate.second.first;
+    retainedIndicesToSend[senderAndIndex.first].push_back(senderAndIndex.second);
+  }
+  std::vector<std::vector<int>> retainedIndices;
+  comm.allToAll(retainedIndicesToSend, retainedIndices);
+
+  std::vector<bool> isThinned(obsdb_.nlocs(), false);
+  for (size_t owner = 0; owner < numRanks; ++owner) {
+    for (size_t obsId : sentObsIds[owner])
+      isThinned[obsId] = true;
+    for (int index : retainedIndices[owner])
+      isThinned[sentObsIds[owner][index]] = false;
+  }
+  obsAccessor.flagRejectedObservations(isThinned, flagged);
+
+  // Optionally reject all filter variables if any has failed QC and ob is invalid for thinning
+  if (retainOnlyIfAllFilterVariablesAreValid)
+    obsAccessor.flagObservationsForAnyFilterVariableFailingQC(apply, *flags_, filtervars, flagged);
+}
+
+// -----------------------------------------------------------------------------
+
 std::unique_ptr<DistanceCalculator> Gaussian_Thinning::makeDistanceCalculator(
     const GaussianThinningParameters &options) {
   DistanceNorm distanceNorm = options.distanceNorm.value().value_or(DistanceNorm::GEODESIC);
@@ -181,9 +398,28 @@ void Gaussian_Thinning::groupObservationsBySpatialLocation(
     const ObsAccessor &obsAccessor,
     RecursiveSplitter &splitter,
     std::vector<float> &distancesToBinCenter) const {
+  std::vector<int> latBins;
+  std::vector<int> lonBins;
+  if (!calculateSpatialBins(validObsIds, distanceCalculator, obsAccessor,
+                            latBins, lonBins, distancesToBinCenter))
+    return;
+
+  splitter.groupBy(latBins);
+  splitter.groupBy(lonBins);
+}
+
+// -----------------------------------------------------------------------------
+
+bool Gaussian_Thinning::calculateSpatialBins(
+    const std::vector<size_t> &validObsIds,
+    const DistanceCalculator &distanceCalculator,
+    const ObsAccessor &obsAccessor,
+    std::vector<int> &latBins,
+    std::vector<int> &lonBins,
+    std::vector<float> &distancesToBinCenter) const {
   boost::optional<SpatialBinSelector> binSelector = makeSpatialBinSelector(options_);
   if (binSelector == boost::none)
-    return;
+    return false;
 
   oops::Log::debug() << "Gaussian_Thinning: zonal band width (degrees) = "
                      << binSelector->latitudeBinWidth() << std::endl;
@@ -202,8 +438,8 @@ void Gaussian_Thinning::groupObservationsBySpatialLocation(
         longitude += 360;
   }
 
-  std::vector<int> latBins;
-  std::vector<int> lonBins;
+  latBins.clear();
+  lonBins.clear();
   latBins.reserve(validObsIds.size());
   lonBins.reserve(validObsIds.size());
   for (size_t obsId : validObsIds) {
@@ -211,20 +447,27 @@ void Gaussian_Thinning::groupObservationsBySpatialLocation(
     latBins.push_back(latBin);
     lonBins.push_back(binSelector->longitudeBin(latBin, lon[obsId]));
   }
-  splitter.groupBy(latBins);
-  splitter.groupBy(lonBins);
 
-  for (size_t validObsIndex = 0; validObsIndex < validObsIds.size(); ++validObsIndex) {
+  // Gather the coordinates of valid observations and their bin centres into contiguous arrays
+  // so that the distances can be calculated in a single (vectorisable) pass.
+  const size_t numValidObs = validObsIds.size();
+  std::vector<float> validLat(numValidObs), validLon(numValidObs);
+  std::vector<float> latBinCenters(numValidObs), lonBinCenters(numValidObs);
+  std::vector<float> inverseLonBinWidths(numValidObs);
+  for (size_t validObsIndex = 0; validObsIndex < numValidObs; ++validObsIndex) {
     const size_t obsId = validObsIds[validObsIndex];
-    float component = distanceCalculator.spatialDistanceComponent(
-          lat[obsId], lon[obsId],
-          binSelector->latitudeBinCenter(latBins[validObsIndex]),
-          binSelector->longitudeBinCenter(latBins[validObsIndex], lonBins[validObsIndex]),
-          binSelector->inverseLatitudeBinWidth(),
-          binSelector->inverseLongitudeBinWidth(latBins[validObsIndex]));
-    distancesToBinCenter[validObsIndex] = distanceCalculator.combineDistanceComponents(
-          distancesToBinCenter[validObsIndex], component);
+    const int latBin = latBins[validObsIndex];
+    validLat[validObsIndex] = lat[obsId];
+    validLon[validObsIndex] = lon[obsId];
+    latBinCenters[validObsIndex] = binSelector->latitudeBinCenter(latBin);
+    lonBinCenters[validObsIndex] = binSelector->longitudeBinCenter(latBin,
+                                                                   lonBins[validObsIndex]);
+    inverseLonBinWidths[validObsIndex] = binSelector->inverseLongitudeBinWidth(latBin);
   }
+  distanceCalculator.accumulateSpatialDistanceComponents(
+        validLat, validLon, latBinCenters, lonBinCenters,
+        binSelector->inverseLatitudeBinWidth(), inverseLonBinWidths, distancesToBinCenter);
+  return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -282,9 +525,23 @@ void Gaussian_Thinning::groupObservationsByVerticalCoordinate(
     const ObsAccessor &obsAccessor,
     RecursiveSplitter &splitter,
     std::vector<float> &distancesToBinCenter) const {
+  std::vector<int> bins;
+  if (calculateVerticalBins(validObsIds, distanceCalculator, obsAccessor,
+                            bins, distancesToBinCenter))
+    splitter.groupBy(bins);
+}
+
+// -----------------------------------------------------------------------------
+
+bool Gaussian_Thinning::calculateVerticalBins(
+    const std::vector<size_t> &validObsIds,
+    const DistanceCalculator &distanceCalculator,
+    const ObsAccessor &obsAccessor,
+    std::vector<int> &bins,
+    std::vector<float> &distancesToBinCenter) const {
   std::unique_ptr<EquispacedBinSelectorBase> binSelector = makeVerticalBinSelector(options_);
   if (!binSelector)
-    return;
+    return false;
 
   if (binSelector->numBins() != boost::none)
     oops::Log::debug() << "Gaussian_Thinning: number of vertical bins = "
@@ -293,22 +550,21 @@ void Gaussian_Thinning::groupObservationsByVerticalCoordinate(
   std::vector<float> vcoord = obsAccessor.getFloatVariableFromObsSpace(
         options_.verticalGroup, options_.verticalCoord);
 
-  std::vector<int> bins;
+  bins.clear();
   bins.reserve(validObsIds.size());
+  std::vector<float> validVcoord, binCenters;
+  validVcoord.reserve(validObsIds.size());
+  binCenters.reserve(validObsIds.size());
   for (size_t obsId : validObsIds)
   {
     bins.push_back(binSelector->bin(vcoord[obsId]));
+    validVcoord.push_back(vcoord[obsId]);
+    binCenters.push_back(binSelector->binCenter(bins.back()));
   }
-  splitter.groupBy(bins);
 
-  for (size_t validObsIndex = 0; validObsIndex < validObsIds.size(); ++validObsIndex) {
-    const size_t obsId = validObsIds[validObsIndex];
-    const float component = distanceCalculator.nonspatialDistanceComponent(
-          vcoord[obsId], binSelector->binCenter(bins[validObsIndex]),
-          binSelector->inverseBinWidth());
-    distancesToBinCenter[validObsIndex] = distanceCalculator.combineDistanceComponents(
-          distancesToBinCenter[validObsIndex], component);
-  }
+  distanceCalculator.accumulateNonspatialDistanceComponents(
+        validVcoord, binCenters, binSelector->inverseBinWidth(), distancesToBinCenter);
+  return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -345,36 +601,50 @@ void Gaussian_Thinning::groupObservationsByTime(
     const ObsAccessor &obsAccessor,
     RecursiveSplitter &splitter,
     std::vector<float> &distancesToBinCenter) const {
+  std::vector<int> bins;
+  if (calculateTimeBins(validObsIds, distanceCalculator, obsAccessor,
+                        bins, distancesToBinCenter))
+    splitter.groupBy(bins);
+}
+
+// -----------------------------------------------------------------------------
+
+bool Gaussian_Thinning::calculateTimeBins(
+    const std::vector<size_t> &validObsIds,
+    const DistanceCalculator &distanceCalculator,
+    const ObsAccessor &obsAccessor,
+    std::vector<int> &bins,
+    std::vector<float> &distancesToBinCenter) const {
   util::DateTime timeOffset;
   std::unique_ptr<EquispacedBinSelectorBase> binSelector =
       makeTimeBinSelector(options_, obsdb_.windowStart(), obsdb_.windowEnd(), timeOffset);
   if (!binSelector)
-    return;
+    return false;
 
   if (binSelector->numBins() != boost::none)
     oops::Log::debug() << "Gaussian_Thinning: number of time bins = "
                        << *binSelector->numBins() << std::endl;
 
-  std::vector<util::DateTime> times = obsAccessor.getDateTimeVariableFromObsSpace(
+  const std::vector<int64_t> times = obsAccessor.getEpochSecondsFromObsSpace(
         "MetaData", "dateTime");
+  const int64_t epochSecondsAtTimeOffset = ObsAccessor::toEpochSeconds(timeOffset);
 
-  std::vector<int> bins;
+  bins.clear();
   bins.reserve(validObsIds.size());
+  std::vector<float> validTimes, binCenters;
+  validTimes.reserve(validObsIds.size());
+  binCenters.reserve(validObsIds.size());
   for (size_t obsId : validObsIds)
   {
-    bins.push_back(binSelector->bin((times[obsId] - timeOffset).toSeconds()));
+    const int64_t time = times[obsId] - epochSecondsAtTimeOffset;
+    bins.push_back(binSelector->bin(time));
+    validTimes.push_back(time);
+    binCenters.push_back(binSelector->binCenter(bins.back()));
   }
-  splitter.groupBy(bins);
 
-  for (size_t validObsIndex = 0; validObsIndex < validObsIds.size(); ++validObsIndex) {
-    const size_t obsId = validObsIds[validObsIndex];
-    const float component = distanceCalculator.nonspatialDistanceComponent(
-          (times[obsId] - timeOffset).toSeconds(),
-          binSelector->binCenter(bins[validObsIndex]),
-          binSelector->inverseBinWidth());
-    distancesToBinCenter[validObsIndex] = distanceCalculator.combineDistanceComponents(
-          distancesToBinCenter[validObsIndex], component);
-  }
+  distanceCalculator.accumulateNonspatialDistanceComponents(
+        validTimes, binCenters, binSelector->inverseBinWidth(), distancesToBinCenter);
+  return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -432,15 +702,18 @@ std::vector<bool> Gaussian_Thinning::identifyThinnedObservations(
     const std::vector<float> &distancesToBinCenter,
     const std::vector<int> &priorities) const {
 
-  std::function<bool(size_t, size_t)> comparator = makeObservationComparator(
+  const std::vector<ObservationSortKey> keys = makeObservationSortKeys(
         validObsIds, distancesToBinCenter, obsAccessor, priorities);
 
   size_t totalNumObs = obsAccessor.totalNumObservations();
 
   std::vector<bool> isThinned(totalNumObs, false);
   for (auto group : splitter.multiElementGroups()) {
-    const size_t bestValidObsIndex = *std::min_element(
-          std::begin(group), std::end(group), comparator);
+    // Find the first observation with the smallest key.
+    size_t bestValidObsIndex = *std::begin(group);
+    for (size_t validObsIndex : group)
+      if (keys[validObsIndex] < keys[bestValidObsIndex])
+        bestValidObsIndex = validObsIndex;
 
     for (size_t validObsIndex : group)
       if (validObsIndex != bestValidObsIndex)
@@ -503,62 +776,48 @@ std::vector<bool> Gaussian_Thinning::identifyThinnedObservationsMedian(
   return isThinned;
 }
 
-// Should return true if the first observation is "better" than the second one.
-std::function<bool(size_t, size_t)> Gaussian_Thinning::makeObservationComparator(
+std::vector<Gaussian_Thinning::ObservationSortKey> Gaussian_Thinning::makeObservationSortKeys(
     const std::vector<size_t> &validObsIds,
     const std::vector<float> &distancesToBinCenter,
     const ObsAccessor &obsAccessor,
     const std::vector<int> &priorities) const
 {
-  if (options_.priorityVariable.value() == boost::none) {
-    if (options_.tiebreakerPickLatest) {
-      // if tiebreakerPickLatest has been set then if distance to the bin center
-      // is equal it chooses the latest observation
-      std::vector<util::DateTime> times = obsAccessor.getDateTimeVariableFromObsSpace(
-           "MetaData", "dateTime");
-      return [times, &validObsIds, &distancesToBinCenter](
-               size_t validObsIndexA, size_t validObsIndexB){
-          const size_t obsIdA = validObsIds[validObsIndexA];
-          const size_t obsIdB = validObsIds[validObsIndexB];
-          return std::make_pair(-distancesToBinCenter[validObsIndexA],
-                                times[obsIdA]) >
-                 std::make_pair(-distancesToBinCenter[validObsIndexB],
-                                 times[obsIdB]);
-      };
-    }
-    return [&distancesToBinCenter](size_t validObsIndexA, size_t validObsIndexB) {
-      return distancesToBinCenter[validObsIndexA] < distancesToBinCenter[validObsIndexB];
-    };
+  // Map priorities and distances to unsigned integers preserving their order, so that the keys
+  // can be compared without branching on floating-point values or the filter options.
+  const auto orderedPriority = [](int priority) {
+    return static_cast<uint32_t>(priority) ^ UINT32_C(0x80000000);
+  };
+  const auto orderedDistance = [](float distance) {
+    distance += 0.0f;  // map -0 to +0
+    uint32_t bits;
+    std::memcpy(&bits, &distance, sizeof(bits));
+    return (bits & UINT32_C(0x80000000)) ? ~bits : (bits | UINT32_C(0x80000000));
+  };
+
+  const size_t numValidObs = validObsIds.size();
+  std::vector<ObservationSortKey> keys(numValidObs);
+  const bool usePriorities = options_.priorityVariable.value() != boost::none;
+  for (size_t validObsIndex = 0; validObsIndex < numValidObs; ++validObsIndex) {
+    // Prefer observations with large priorities and small distances...
+    const uint32_t invertedPriority =
+        usePriorities ? ~orderedPriority(priorities[validObsIds[validObsIndex]]) : 0;
+    keys[validObsIndex].primary = (static_cast<uint64_t>(invertedPriority) << 32) |
+                                  orderedDistance(distancesToBinCenter[validObsIndex]);
+    keys[validObsIndex].secondary = 0;
   }
 
-  // TODO(wsmigaj): In C++14, use move capture for 'priorities'.
   if (options_.tiebreakerPickLatest) {
-    std::vector<util::DateTime> times = obsAccessor.getDateTimeVariableFromObsSpace(
-          "MetaData", "dateTime");
-    return [&priorities, times, &validObsIds, &distancesToBinCenter](
-              size_t validObsIndexA, size_t validObsIndexB){
-        // Prefer observations with large priorities, small distance and later time if tied.
-        const size_t obsIdA = validObsIds[validObsIndexA];
-        const size_t obsIdB = validObsIds[validObsIndexB];
-        return std::make_tuple(priorities[obsIdA],
-                               -distancesToBinCenter[validObsIndexA],
-                               times[obsIdA]) >
-               std::make_tuple(priorities[obsIdB],
-                               -distancesToBinCenter[validObsIndexB],
-                               times[obsIdB]);
-    };
-  } else {
-  return [&priorities, &validObsIds, &distancesToBinCenter]
-         (size_t validObsIndexA, size_t validObsIndexB) {
-      // Prefer observations with large priorities and small distances
-      const size_t obsIdA = validObsIds[validObsIndexA];
-      const size_t obsIdB = validObsIds[validObsIndexB];
-      return std::make_pair(-priorities[obsIdA],
-                            distancesToBinCenter[validObsIndexA]) <
-             std::make_pair(-priorities[obsIdB],
-                            distancesToBinCenter[validObsIndexB]);
-    };
+    // ... and, if tied, later observations.
+    const std::vector<int64_t> times = obsAccessor.getEpochSecondsFromObsSpace(
+         "MetaData", "dateTime");
+    const int64_t windowStart = ObsAccessor::toEpochSeconds(obsdb_.windowStart());
+    for (size_t validObsIndex = 0; validObsIndex < numValidObs; ++validObsIndex) {
+      const int64_t time = times[validObsIds[validObsIndex]] - windowStart;
+      keys[validObsIndex].secondary = ~(static_cast<uint64_t>(time) ^ (UINT64_C(1) << 63));
+    }
   }
+
+  return keys;
 }
 
 // -----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #ifndef UFO_FILTERS_GAUSSIAN_THINNING_H_
 #define UFO_FILTERS_GAUSSIAN_THINNING_H_
 
+#include <cstdint>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -73,6 +74,17 @@ class Gaussian_Thinning : public FilterBase,
 
   ObsAccessor createObsAccessor() const;
 
+  /// Return true if bins should be distributed between MPI ranks (see the
+  /// `distribute_bins_across_ranks` option).
+  bool shouldDistributeBins(const ObsAccessor &obsAccessor) const;
+
+  /// Thin observations without gathering them on all MPI ranks. Each bin is owned by a single
+  /// rank, which receives the observations lying in that bin from other ranks, selects the one to
+  /// retain and returns its index to the rank holding it.
+  void applyFilterWithDistributedBins(const std::vector<bool> &apply,
+                                      const Variables &filtervars,
+                                      std::vector<std::vector<bool>> &flagged) const;
+
   void groupObservationsBySpatialLocation(const std::vector<size_t> &validObsIds,
                                           const DistanceCalculator &distanceCalculator,
                                           const ObsAccessor &obsAccessor,
@@ -91,6 +103,34 @@ class Gaussian_Thinning : public FilterBase,
                                RecursiveSplitter &splitter,
                                std::vector<float> &distancesToBinCenter) const;
 
+  /// Calculate the indices of the latitude and longitude bins containing the observations with
+  /// IDs \p validObsIds and update \p distancesToBinCenter accordingly. Return false (leaving the
+  /// output vectors unchanged) if thinning in the horizontal direction is disabled.
+  bool calculateSpatialBins(const std::vector<size_t> &validObsIds,
+                            const DistanceCalculator &distanceCalculator,
+                            const ObsAccessor &obsAccessor,
+                            std::vector<int> &latBins,
+                            std::vector<int> &lonBins,
+                            std::vector<float> &distancesToBinCenter) const;
+
+  /// Calculate the indices of the vertical bins containing the observations with IDs
+  /// \p validObsIds and update \p distancesToBinCenter accordingly. Return false (leaving the
+  /// output vectors unchanged) if thinning in the vertical direction is disabled.
+  bool calculateVerticalBins(const std::vector<size_t> &validObsIds,
+                             const DistanceCalculator &distanceCalculator,
+                             const ObsAccessor &obsAccessor,
+                             std::vector<int> &bins,
+                             std::vector<float> &distancesToBinCenter) const;
+
+  /// Calculate the indices of the time bins containing the observations with IDs
+  /// \p validObsIds and update \p distancesToBinCenter accordingly. Return false (leaving the
+  /// output vectors unchanged) if thinning in time is disabled.
+  bool calculateTimeBins(const std::vector<size_t> &validObsIds,
+                         const DistanceCalculator &distanceCalculator,
+                         const ObsAccessor &obsAccessor,
+                         std::vector<int> &bins,
+                         std::vector<float> &distancesToBinCenter) const;
+
   std::vector<bool> identifyThinnedObservations(
       const std::vector<size_t> &validObsIds,
       const ObsAccessor &obsAccessor,
@@ -105,7 +145,22 @@ class Gaussian_Thinning : public FilterBase,
       const std::vector<float> &obsval,
       const float &minNumObsPerBin) const;
 
-  std::function<bool(size_t, size_t)> makeObservationComparator(
+  /// \brief Composite sort key packing the properties used to rank observations lying in the
+  /// same bin: the priority, the distance to the bin center and (if `tiebreaker_pick_latest` is
+  /// set) the observation time. Observations with smaller keys are preferred.
+  struct ObservationSortKey {
+    uint64_t primary;    ///< Inverted priority (upper 32 bits) and distance (lower 32 bits).
+    uint64_t secondary;  ///< Inverted time (or 0).
+
+    bool operator<(const ObservationSortKey &other) const {
+      return primary < other.primary || (primary == other.primary && secondary < other.secondary);
+    }
+  };
+
+  /// Return the sort keys of the observations with IDs \p validObsIds, whose distances to the
+  /// centers of their bins are \p distancesToBinCenter. \p priorities should be empty if no
+  /// priority variable has been specified.
+  std::vector<ObservationSortKey> makeObservationSortKeys(
       const std::vector<size_t> &validObsIds,
       const std::vector<float> &distancesToBinCenter,
       const ObsAccessor &obsAccessor,
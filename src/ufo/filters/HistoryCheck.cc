@@ -7,9 +7,14 @@
 #include "ufo/filters/HistoryCheck.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <functional>
+#include <iomanip>
+#include <limits>
 #include <map>
 #include <set>
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -19,6 +24,7 @@
 #include <boost/optional.hpp>
 #include <boost/unordered_map.hpp>
 #include "eckit/config/Configuration.h"
+#include "eckit/exception/Exceptions.h"
 #include "ioda/ObsDataVector.h"
 #include "ioda/ObsSpace.h"
 #include "oops/base/Variables.h"
@@ -26,6 +32,7 @@
 #include "oops/util/DateTime.h"
 #include "oops/util/Duration.h"
 #include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
 #include "ufo/filters/HistoryCheckParameters.h"
 #include "ufo/filters/ObsAccessor.h"
 #include "ufo/filters/QCflags.h"
@@ -37,11 +44,63 @@
 
 namespace ufo {
 
+namespace {
+
+/// Summary of the streak of identical values of a filter variable in progress at a station.
+struct StreakSummary {
+  float value;
+  util::DateTime first;  ///< Time of the first observation of the streak.
+  util::DateTime last;   ///< Time of the last observation of the streak.
+  size_t length;
+};
+
+/// Streaks in progress, indexed by station id and variable name.
+typedef std::map<std::pair<std::string, std::string>, StreakSummary> StreakSummaries;
+
+/// Format the summary of a streak as a line of the state file.
+std::string formatStreakSummary(const StreakSummaries::value_type &entry) {
+  std::ostringstream os;
+  os << std::quoted(entry.first.first) << ' ' << entry.first.second << ' '
+     << std::setprecision(std::numeric_limits<float>::max_digits10) << entry.second.value << ' '
+     << entry.second.first << ' ' << entry.second.last << ' ' << entry.second.length;
+  return os.str();
+}
+
+/// Add the streaks described by the lines of \p is to \p summaries, replacing existing
+/// summaries of the same station and variable.
+void readStreakSummaries(std::istream &is, const std::string &source,
+                         StreakSummaries &summaries) {
+  std::string line;
+  while (std::getline(is, line)) {
+    if (line.empty())
+      continue;
+    std::istringstream ls(line);
+    std::string station, variable, first, last;
+    StreakSummary summary;
+    if (!(ls >> std::quoted(station) >> variable >> summary.value >> first >> last
+             >> summary.length))
+      throw eckit::UserError("HistoryCheck: invalid line in " + source + ": " + line, Here());
+    summary.first = util::DateTime(first);
+    summary.last = util::DateTime(last);
+    summaries[std::make_pair(station, variable)] = summary;
+  }
+}
+
+}  // namespace
+
 HistoryCheck::HistoryCheck(ioda::ObsSpace &obsdb, const Parameters_ &parameters,
                             std::shared_ptr<ioda::ObsDataVector<int> > flags,
                             std::shared_ptr<ioda::ObsDataVector<float> > obserr)
   : FilterBase(obsdb, parameters, flags, obserr), options_(parameters)
 {
+  const boost::optional<StuckCheckCoreParameters> &stuckOptions =
+      options_.stuckCheckParameters.value();
+  if (options_.stateFile.value() != boost::none && stuckOptions &&
+      (stuckOptions->percentageStuckTolerance.value() ||
+       !stuckOptions->numberStuckTolerance.value() || !stuckOptions->timeStuckTolerance.value()))
+    throw eckit::UserError("HistoryCheck: if the state file is set, the number stuck tolerance "
+                           "and time stuck tolerance (and not the percentage stuck tolerance) "
+                           "must be set", Here());
   oops::Log::debug() << "HistoryCheck: config = " << options_ << "\n";
 }
 
@@ -62,6 +121,32 @@ HistoryCheck::HistoryCheck(ioda::ObsSpace &obsdb,
 void HistoryCheck::applyFilter(const std::vector<bool> & apply,
                                const Variables & filtervars,
                                std::vector<std::vector<bool> > & flagged) const {
+  const oops::RequiredParameter<SurfaceObservationSubtype> &subtype =
+      options_.surfaceObservationSubtype;
+  const boost::optional<TrackCheckShipCoreParameters> &trackOptions =
+      options_.trackCheckShipParameters.value();
+  const boost::optional<StuckCheckCoreParameters> &stuckOptions =
+      options_.stuckCheckParameters;
+  // If the observation type is one which the track check ship filter should be run on and
+  // the necessary filter parameters were set within the configuration file
+  const bool runTrackCheck = subtype != SurfaceObservationSubtype::LNDSYB &&
+      subtype != SurfaceObservationSubtype::LNDSYN &&
+      trackOptions;
+  // If the stuck check filter parameters were set and if the observation subtype is one which
+  // the stuck check filter should be run on
+  const bool runStuckCheck = stuckOptions &&
+      subtype != SurfaceObservationSubtype::TEMP &&
+      subtype != SurfaceObservationSubtype::BATHY &&
+      subtype != SurfaceObservationSubtype::TESAC &&
+      subtype != SurfaceObservationSubtype::BUOYPROF;
+  const bool runIncrementalStuckCheck = runStuckCheck && options_.stateFile.value() != boost::none;
+  if (runIncrementalStuckCheck) {
+    applyIncrementalStuckCheck(apply, filtervars, flagged);
+    // The observations from before the window are then only needed by the track check.
+    if (!runTrackCheck)
+      return;
+  }
+
   util::DateTime widerWindowStart = obsdb_.windowStart() - options_.timeBeforeStartOfWindow.value();
   util::DateTime widerWindowEnd = obsdb_.windowEnd() - options_.timeAfterEndOfWindow.value();
   // In order to prevent the MPI from distributing the aux spaces's observations to different
@@ -89,15 +174,7 @@ void HistoryCheck::applyFilter(const std::vector<bool> & apply,
         new ioda::ObsDataVector<float>(widerObsSpace, widerObsSpace.obsvariables(), "ObsError"));
   std::shared_ptr<ioda::ObsDataVector<int>> qcflagsWide(
         new ioda::ObsDataVector<int>(widerObsSpace, widerObsSpace.obsvariables()));
-  const oops::RequiredParameter<SurfaceObservationSubtype> &subtype =
-      options_.surfaceObservationSubtype;
-  const boost::optional<TrackCheckShipCoreParameters> &trackOptions =
-      options_.trackCheckShipParameters.value();
-  // If the observation type is one which the track check ship filter should be run on and
-  // the necessary filter parameters were set within the configuration file
-  if (subtype != SurfaceObservationSubtype::LNDSYB &&
-      subtype != SurfaceObservationSubtype::LNDSYN &&
-      trackOptions) {
+  if (runTrackCheck) {
     // Collecting parameters relevant for running the track check ship filter on the wider obs space
     eckit::LocalConfiguration configTrackCheckShip =
         trackOptions->toConfiguration();
@@ -111,29 +188,21 @@ void HistoryCheck::applyFilter(const std::vector<bool> & apply,
                                    qcflagsWide, obserrWide);
     trackCheck.preProcess();
   }
-  const boost::optional<StuckCheckCoreParameters> &stuckOptions =
-      options_.stuckCheckParameters;
-  // If the stuck check filter parameters were set and if the stuck check filter has the potential
+  // If the stuck check filter should be run over the wider obs space and has the potential
   // to flag observations (number of observations is greater than the numberStuckTolerance value)
-  if (stuckOptions &&
+  if (runStuckCheck && !runIncrementalStuckCheck &&
       widerObsSpace.index().size() >
       stuckOptions->numberStuckTolerance.value().value()) {
-    // If the observation subtype is one which the stuck check filter should be run on
-    if (subtype != SurfaceObservationSubtype::TEMP &&
-        subtype != SurfaceObservationSubtype::BATHY &&
-        subtype != SurfaceObservationSubtype::TESAC &&
-        subtype != SurfaceObservationSubtype::BUOYPROF) {
-      // Collecting the relevant parameters for running the stuck check filter
-      eckit::LocalConfiguration configStuckCheck =
-          stuckOptions->toConfiguration();
-      options_.TrackCheckUtilsParameters::serialize(configStuckCheck);
-      ufo::StuckCheckParameters stuckParams;
-      stuckParams.deserialize(configStuckCheck);
-      // Setting up and running the stuck check filter on the wider obs space
-      ufo::StuckCheck stuckCheck(widerObsSpace, stuckParams,
-                                 qcflagsWide, obserrWide);
-      stuckCheck.preProcess();
-    }
+    // Collecting the relevant parameters for running the stuck check filter
+    eckit::LocalConfiguration configStuckCheck =
+        stuckOptions->toConfiguration();
+    options_.TrackCheckUtilsParameters::serialize(configStuckCheck);
+    ufo::StuckCheckParameters stuckParams;
+    stuckParams.deserialize(configStuckCheck);
+    // Setting up and running the stuck check filter on the wider obs space
+    ufo::StuckCheck stuckCheck(widerObsSpace, stuckParams,
+                               qcflagsWide, obserrWide);
+    stuckCheck.preProcess();
   }
   // Creating obs accessors for both obs spaces, assuming the same variable is used for grouping
   // into stations on both obs spaces. 3rd arg: recordsAreSingleObs=false always for History Check.
@@ -150,35 +219,33 @@ void HistoryCheck::applyFilter(const std::vector<bool> & apply,
   std::vector<float> wideLons = historicalObsAccessor.getFloatVariableFromObsSpace(
         "MetaData", "longitude");
 
-  std::map<std::string, int> stationIdMap;
-
-  // Create a "central source of truth" map of integer index values for each
-  // string-valued station id across both obs spaces.
-  const boost::optional<Variable> &statIdVar = options_.stationIdVariable.value();
-  // If the station id variable is in use, and the underlying ids are string-formatted.
-  if (statIdVar != boost::none &&
-      obsdb_.dtype(statIdVar->group(), statIdVar->variable()) == ioda::ObsDtype::String) {
-    // retrieve the station ids from both obs spaces
-    std::vector<std::string> wideIds = historicalObsAccessor.getStringVariableFromObsSpace(
-          statIdVar->group(), statIdVar->variable());
-    std::vector<std::string> windowIds = windowObsAccessor.getStringVariableFromObsSpace(
-          statIdVar->group(), statIdVar->variable());
-    // append the assimilation window ids to the end of the historical obs space's ids
-    std::move(windowIds.begin(), windowIds.end(), std::back_inserter(wideIds));
-    // remove all non-unique station ids from the collection of ids
-    std::sort(wideIds.begin(), wideIds.end());
-    const auto endOfUnique = std::unique(wideIds.begin(), wideIds.end());
-    wideIds.erase(endOfUnique, wideIds.end());
-    // map all unique station ids across both obs spaces to an integer index
-    int index = 0;
-    for (const std::string& value : wideIds)
-      stationIdMap[value] = index++;
+  // String-valued station ids are replaced by their positions in the sorted list of distinct ids
+  // found in either obs space, so that the same station has the same integer id in both.
+  std::vector<std::string> wideStationIdDictionary, windowStationIdDictionary;
+  std::vector<int> wideRecordIds = getStationIds(options_.stationIdVariable.value(),
+                                                 widerObsSpace, historicalObsAccessor,
+                                                 wideStationIdDictionary);
+  std::vector<int> windowStationIds = getStationIds(options_.stationIdVariable.value(),
+                                                    obsdb_, windowObsAccessor,
+                                                    windowStationIdDictionary);
+  if (!wideStationIdDictionary.empty() || !windowStationIdDictionary.empty()) {
+    std::vector<std::string> stationIdDictionary;
+    std::set_union(wideStationIdDictionary.begin(), wideStationIdDictionary.end(),
+                   windowStationIdDictionary.begin(), windowStationIdDictionary.end(),
+                   std::back_inserter(stationIdDictionary));
+    auto recode = [&stationIdDictionary](const std::vector<std::string> &dictionary,
+                                         std::vector<int> &codes) {
+      std::vector<int> newCodes(dictionary.size());
+      for (size_t i = 0; i < dictionary.size(); ++i)
+        newCodes[i] = std::lower_bound(stationIdDictionary.begin(), stationIdDictionary.end(),
+                                       dictionary[i]) - stationIdDictionary.begin();
+      for (int &code : codes)
+        code = newCodes[code];
+    };
+    recode(wideStationIdDictionary, wideRecordIds);
+    recode(windowStationIdDictionary, windowStationIds);
   }
 
-  std::vector<int> wideRecordIds = getStationIds(stationIdMap,
-                                                 options_.stationIdVariable.value(),
-                                                 widerObsSpace, historicalObsAccessor);
-
   // obsIdentifierData: all of the MetaData needed to uniquely identify each observation
   // MetaData in use: time stamp, lat/lon coordinates, the station id
   // (actual or integer equivalent), and an additional number for differentiating identical
@@ -209,10 +276,6 @@ void HistoryCheck::applyFilter(const std::vector<bool> & apply,
         "MetaData", "latitude");
   std::vector<float> windowLons = windowObsAccessor.getFloatVariableFromObsSpace(
         "MetaData", "longitude");
-  std::vector<int> windowStationIds = getStationIds(stationIdMap,
-                                                    options_.stationIdVariable.value(),
-                                                    obsdb_, windowObsAccessor);
-
   // Determine vector of locations at which this filter should be applied.
   // If each independent group of observations is stored entirely on a single MPI rank
   // then this vector will be determined separately for each rank.
@@ -249,24 +312,139 @@ void HistoryCheck::applyFilter(const std::vector<bool> & apply,
 
   // Iterate through flagged observations in the historical obs space,
   // finding the observations which are also in the assimilation obs space, and
-  // marking the associated indices to flag using the ObsAccessor flagRejectedObservations method.
-  // The globalApply vector is used to determine which locations should be flagged
+  // marking the associated indices to flag using the ObsAccessor flagRejectedObservationIds
+  // method. The globalApply vector is used to determine which locations should be flagged
   // based on the where clause.
-  std::vector<bool> globalObsToFlag(windowObsAccessor.totalNumObservations(), false);
+  std::vector<size_t> globalObsToFlag;
   for (const obsIdentifierData &id : wideFlaggedLocationIds) {
-    if (locationIdToIndex.find(id) != locationIdToIndex.end()) {
-      const size_t locToFlag = locationIdToIndex.at(id);
+    const auto it = locationIdToIndex.find(id);
+    if (it != locationIdToIndex.end()) {
+      const size_t locToFlag = it->second;
       if (globalApply[locToFlag])
-        globalObsToFlag.at(locToFlag) = true;
+        globalObsToFlag.push_back(locToFlag);
     }
   }
-  windowObsAccessor.flagRejectedObservations(globalObsToFlag, flagged);
+  windowObsAccessor.flagRejectedObservationIds(std::move(globalObsToFlag), flagged);
 }
 
-std::vector<int> HistoryCheck::getStationIds(const std::map<std::string, int> &stringMap,
-                                             const boost::optional<Variable> &stationIdVar,
+void HistoryCheck::applyIncrementalStuckCheck(const std::vector<bool> &apply,
+                                              const Variables &filtervars,
+                                              std::vector<std::vector<bool>> &flagged) const {
+  const std::string &stateFile = *options_.stateFile.value();
+  const StuckCheckCoreParameters &stuckOptions = *options_.stuckCheckParameters.value();
+  const size_t numberStuckTolerance = stuckOptions.numberStuckTolerance.value().value();
+  const util::Duration timeStuckTolerance = stuckOptions.timeStuckTolerance.value().value();
+
+  StreakSummaries summaries;
+  {
+    std::ifstream is(stateFile);
+    // If the file does not exist yet, all streaks start in the current window.
+    if (is)
+      readStreakSummaries(is, stateFile, summaries);
+  }
+
+  // 3rd arg: recordsAreSingleObs = false for Stuck Check.
+  ObsAccessor obsAccessor = TrackCheckUtils::createObsAccessor(options_.stationIdVariable,
+                                                               obsdb_, false);
+  const std::vector<size_t> validObsIds = obsAccessor.getValidObservationIds(apply);
+  const std::vector<util::DateTime> dateTimes = obsAccessor.getDateTimeVariableFromObsSpace(
+        "MetaData", "dateTime");
+  RecursiveSplitter splitter = obsAccessor.splitObservationsIntoIndependentGroups(validObsIds);
+  TrackCheckUtils::sortTracksChronologically(validObsIds, obsAccessor, splitter);
+
+  // Station ids must be the same from cycle to cycle, so string ids are stored as they are
+  // rather than as their integer codes.
+  const boost::optional<Variable> &statIdVar = options_.stationIdVariable.value();
+  const bool stringStationIds = statIdVar != boost::none &&
+      obsdb_.dtype(statIdVar->group(), statIdVar->variable()) == ioda::ObsDtype::String;
+  std::vector<std::string> stationIdDictionary;
+  const std::vector<int> intIds = getStationIds(statIdVar, obsdb_, obsAccessor,
+                                                stationIdDictionary);
+  auto stationId = [&](size_t obsId) {
+    return stringStationIds ? stationIdDictionary[intIds[obsId]] : std::to_string(intIds[obsId]);
+  };
+
+  const float missingFloat = util::missingValue(float());
+  std::vector<bool> isRejected(obsAccessor.totalNumObservations(), false);
+  std::vector<std::string> updatedSummaries;
+  for (const std::string &variable : filtervars.toOopsVariables().variables()) {
+    if (!obsdb_.has("ObsValue", variable))
+      throw eckit::UserError("HistoryCheck: ObsValue vector for " + variable + " not found",
+                             Here());
+    const std::vector<float> values = obsAccessor.getFloatVariableFromObsSpace(
+          "ObsValue", variable);
+    for (auto station : splitter.groups()) {
+      const auto key = std::make_pair(stationId(validObsIds[*station.begin()]), variable);
+      StreakSummaries::iterator streak = summaries.find(key);
+      // Members of the current streak taken in the assimilation window.
+      std::vector<size_t> streakObsIds;
+      bool streakRejected = false;
+      for (size_t index : station) {
+        const size_t obsId = validObsIds[index];
+        const float value = values[obsId];
+        if (value == missingFloat)
+          continue;
+        if (streak != summaries.end() && streak->second.value == value) {
+          ++streak->second.length;
+          streak->second.last = dateTimes[obsId];
+        } else {
+          streak = summaries.insert(std::make_pair(key, StreakSummary())).first;
+          streak->second = StreakSummary{value, dateTimes[obsId], dateTimes[obsId], 1};
+          streakObsIds.clear();
+          streakRejected = false;
+        }
+        streakObsIds.push_back(obsId);
+        // Both criteria can only become satisfied as the streak grows, so the streak can be
+        // rejected as soon as they are, without waiting for it to end.
+        if (streakRejected) {
+          isRejected[obsId] = true;
+        } else if (streak->second.length > numberStuckTolerance &&
+                   streak->second.last - streak->second.first > timeStuckTolerance) {
+          streakRejected = true;
+          for (size_t id : streakObsIds)
+            isRejected[id] = true;
+        }
+      }
+      if (streak != summaries.end())
+        updatedSummaries.push_back(formatStreakSummary(*streak));
+    }
+  }
+  obsAccessor.flagRejectedObservations(isRejected, flagged);
+
+  // If the stations are distributed over several MPI ranks, collect the streaks updated on
+  // all ranks.
+  if (!obsAccessor.areObservationsSharedByAllRanks()) {
+    obsdb_.distribution()->allGatherv(updatedSummaries);
+    std::ostringstream os;
+    for (const std::string &line : updatedSummaries)
+      os << line << '\n';
+    std::istringstream is(os.str());
+    readStreakSummaries(is, "the gathered state", summaries);
+  }
+  if (obsdb_.comm().rank() != 0)
+    return;
+
+  // Forget stations that have not reported recently enough to be included in the wider window.
+  const util::DateTime oldestRetained =
+      obsdb_.windowStart() - options_.timeBeforeStartOfWindow.value();
+  // Write to a temporary file first, so that the state is not lost if the job fails.
+  const std::string tmpFile = stateFile + ".tmp";
+  {
+    std::ofstream os(tmpFile);
+    for (const StreakSummaries::value_type &entry : summaries)
+      if (entry.second.last >= oldestRetained)
+        os << formatStreakSummary(entry) << '\n';
+    if (!os)
+      throw eckit::UserError("HistoryCheck: cannot write " + tmpFile, Here());
+  }
+  if (std::rename(tmpFile.c_str(), stateFile.c_str()) != 0)
+    throw eckit::UserError("HistoryCheck: cannot replace " + stateFile, Here());
+}
+
+std::vector<int> HistoryCheck::getStationIds(const boost::optional<Variable> &stationIdVar,
                                              const ioda::ObsSpace &obsdb,
-                                             const ObsAccessor &obsacc) const {
+                                             const ObsAccessor &obsacc,
+                                             std::vector<std::string> &dictionary) const {
   if (stationIdVar == boost::none) {
       if (obsdb.obs_group_vars().empty()) {
         // Observations were not grouped into records.
@@ -285,16 +463,8 @@ std::vector<int> HistoryCheck::getStationIds(const std::map<std::string, int> &s
     }
 
     case ioda::ObsDtype::String:
-      {
-        std::vector<std::string> stringIds =
-            obsacc.getStringVariableFromObsSpace(stationIdVar->group(),
-                                                 stationIdVar->variable());
-        std::vector<int> ints;
-        ints.reserve(stringIds.size());
-        std::transform(stringIds.begin(), stringIds.end(), std::back_inserter(ints),
-                       [&stringMap](const std::string& value) { return stringMap.at(value); });
-        return ints;
-      }
+      return obsacc.getStringVariableCodesFromObsSpace(stationIdVar->group(),
+                                                       stationIdVar->variable(), dictionary);
 
     default:
       throw eckit::UserError("Only integer and string variables may be used as station IDs",
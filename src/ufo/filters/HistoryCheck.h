@@ -60,19 +60,30 @@ class HistoryCheck: public FilterBase,
   int qcFlag() const override {
     return QCflags::history;
   }
+  bool modifiesObsSpace() const override {return true;}
 
   /// \brief Retrieve all station ids from the ObsAccessor. If string-labelled, ids will be
   /// converted to integers.
   ///
-  /// \p stringMap A previously-created map of all unique string station ids across obs spaces,
-  /// used as a "central source-of-truth" for the integer values the strings should be mapped to.
   /// \p stationIdVar The parameter used to specify which variable is used to store station ids.
   /// \p obsdb The ObsSpace which station ids will be needed for.
   /// \p obsacc The ObsAccessor used to access observations from the associated ObsSpace.
-  std::vector<int> getStationIds(const std::map<std::string, int> &stringMap,
-                                 const boost::optional<Variable> &stationIdVar,
+  /// \p dictionary If the station ids are strings, set to the sorted list of distinct ids, whose
+  /// positions are the returned integers. Otherwise left unchanged.
+  std::vector<int> getStationIds(const boost::optional<Variable> &stationIdVar,
                                  const ioda::ObsSpace &obsdb,
-                                 const ObsAccessor &obsacc) const;
+                                 const ObsAccessor &obsacc,
+                                 std::vector<std::string> &dictionary) const;
+
+  /// \brief Run the stuck check on the observations from the assimilation window only,
+  /// continuing the streaks stored in the `state file`, and update that file.
+  ///
+  /// A streak is rejected as soon as it satisfies the number and time criteria of the stuck check;
+  /// only its members lying in the current window are flagged (the others were flagged when they
+  /// were processed).
+  void applyIncrementalStuckCheck(const std::vector<bool> &apply,
+                                  const Variables &filtervars,
+                                  std::vector<std::vector<bool>> &flagged) const;
 };
 
 
@@ -7,11 +7,13 @@
 #ifndef UFO_FILTERS_HISTORYCHECKPARAMETERS_H_
 #define UFO_FILTERS_HISTORYCHECKPARAMETERS_H_
 
+#include <string>
 #include <utility>
 
 #include "ioda/ObsSpaceParameters.h"
 
 #include "oops/util/Duration.h"
+#include "oops/util/parameters/OptionalParameter.h"
 #include "oops/util/parameters/Parameter.h"
 #include "oops/util/parameters/Parameters.h"
 #include "oops/util/parameters/ParameterTraits.h"
@@ -75,6 +77,23 @@ class HistoryCheckParameters : public TrackCheckUtilsParameters {
     oops::Parameter<int> stationIdMaxStringLength {
       "station id max string length", 24, this
     };
+
+    /// Name of a file holding a compact summary of the stuck check's state at each station
+    /// (the value of each filter variable in the current streak, the times of the first and
+    /// last observations of that streak and its length) at the end of the previous cycle.
+    ///
+    /// If set, the stuck check is run incrementally: instead of reprocessing the observations
+    /// taken during the `time before start of window`, it processes only the observations from
+    /// the assimilation window, continuing the streaks stored in the file, and then replaces the
+    /// file with the updated summary. If the file does not exist, all streaks start in the
+    /// current window. Summaries of stations that have not reported since `time before start of
+    /// window` are discarded. The larger obs space is then only read if the ship track check is
+    /// also run. Stations are identified by the values of the `station_id_variable`, which should
+    /// therefore be set. Incompatible with `percentage stuck tolerance`, which depends on the
+    /// length of each station's whole record.
+    oops::OptionalParameter<std::string> stateFile {
+      "state file", this
+    };
 };
 
 }  // namespace ufo
@@ -19,6 +19,7 @@
 
 #include "oops/util/Logger.h"
 #include "ufo/filters/QCflags.h"
+#include "ufo/utils/LogUtils.h"
 
 namespace ufo {
 
@@ -79,11 +80,14 @@ void ImpactHeightCheck::applyFilter(const std::vector<bool> & apply,
 
   // For the benefits of debugging, output the refractivity for the first
   // observation
-  oops::Log::debug() << "Refractivity(first ob) ";
-  for (size_t iLevel = 0; iLevel < nRefLevels; ++iLevel) {
-    oops::Log::debug() << refractivity[iLevel][0] << " ";
+  const bool debug = isLogChannelEnabled(oops::Log::debug());
+  if (debug) {
+    oops::Log::debug() << "Refractivity(first ob) ";
+    for (size_t iLevel = 0; iLevel < nRefLevels; ++iLevel) {
+      oops::Log::debug() << refractivity[iLevel][0] << " ";
+    }
+    oops::Log::debug() << std::endl;
   }
-  oops::Log::debug() << std::endl;
 
   // Get the height of the levels on which the refractivity has been calculated.
   // Must be the same length as the array defining the refractivity.
@@ -104,11 +108,13 @@ void ImpactHeightCheck::applyFilter(const std::vector<bool> & apply,
 
   // For debugging, output the heights of the refractivity levels for the first
   // observation.
-  oops::Log::debug() << "Model heights (first ob) ";
-  for (size_t iLevel = 0; iLevel < nRefLevels; ++iLevel) {
-    oops::Log::debug() << modelHeights[iLevel][0] << " ";
+  if (debug) {
+    oops::Log::debug() << "Model heights (first ob) ";
+    for (size_t iLevel = 0; iLevel < nRefLevels; ++iLevel) {
+      oops::Log::debug() << modelHeights[iLevel][0] << " ";
+    }
+    oops::Log::debug() << std::endl;
   }
-  oops::Log::debug() << std::endl;
 
   // Read in the observation impact parameter for each observation
   Variable impactVariable = Variable("MetaData/impact_parameter");
@@ -123,10 +129,12 @@ void ImpactHeightCheck::applyFilter(const std::vector<bool> & apply,
   // Get the record numbers from the observation data.  These will be used to identify
   // which observations belong to which profile.
   const std::vector<size_t> & record_numbers = obsdb_.recidx_all_recnums();
-  oops::Log::debug() << "Unique record numbers" << std::endl;
-  for (size_t iProfile : record_numbers)
-    oops::Log::debug() << iProfile << ' ';
-  oops::Log::debug() << std::endl;
+  if (debug) {
+    oops::Log::debug() << "Unique record numbers" << std::endl;
+    for (size_t iProfile : record_numbers)
+      oops::Log::debug() << iProfile << ' ';
+    oops::Log::debug() << std::endl;
+  }
 
   // For each variable, perform the filter
   for (size_t iFilterVar = 0; iFilterVar < filtervars.nvars(); ++iFilterVar) {
@@ -174,7 +182,7 @@ void ImpactHeightCheck::applyFilter(const std::vector<bool> & apply,
 
       const std::vector<float> & gradient = calcVerticalGradient(refracProfile, heightProfile);
       // Output the calculated refractivity gradient for the first profile
-      if (iProfile == record_numbers[0]) {
+      if (debug && iProfile == record_numbers[0]) {
           oops::Log::debug() << "Gradient found to be" << std::endl;
           for (float grad : gradient)
               oops::Log::debug() << grad << "  ";
@@ -81,10 +81,8 @@ void MWCLWCheck::applyFilter(const std::vector<bool> & apply,
 //  H(x)
   const Variable var0(invars[0] + "@HofX");
   const Variable var1(invars[1] + "@HofX");
-  std::vector<float> hofx0;
-  data_.get(var0, hofx0);
-  std::vector<float> hofx1;
-  data_.get(var1, hofx1);
+  const ObsFilterDataView<float> hofx0 = data_.getView<float>(var0);
+  const ObsFilterDataView<float> hofx1 = data_.getView<float>(var1);
 
   auto clw_obs = [&](size_t jobs) { return amsua_clw(
     obs_for_calc[0][jobs], obs_for_calc[1][jobs], sza[0][jobs]); };
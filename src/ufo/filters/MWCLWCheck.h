@@ -69,6 +69,7 @@ class MWCLWCheck : public FilterBase,
   void applyFilter(const std::vector<bool> &, const Variables &,
                    std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override {return QCflags::clw;}
+  bool modifiesObsSpace() const override {return true;}
 
   Parameters_ parameters_;
 };
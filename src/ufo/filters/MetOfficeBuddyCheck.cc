@@ -11,7 +11,9 @@
 #include <cmath>
 #include <functional>
 #include <iomanip>
+#include <iterator>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -28,8 +30,10 @@
 #include "oops/util/sqr.h"
 #include "ufo/filters/FilterUtils.h"
 #include "ufo/filters/MetOfficeBuddyCheckParameters.h"
+#include "ufo/filters/MetOfficeBuddyHaloExchange.h"
 #include "ufo/filters/MetOfficeBuddyPair.h"
 #include "ufo/filters/MetOfficeBuddyPairFinder.h"
+#include "ufo/filters/MetOfficeBuddySearchIndex.h"
 #include "ufo/utils/PiecewiseLinearInterpolation.h"
 
 
@@ -271,6 +275,24 @@ MetOfficeBuddyCheck::MetOfficeBuddyCheck(ioda::ObsSpace& obsdb, const Parameters
   allvars_ += Variables(filtervars_, "HofX");
   for (size_t i = 0; i < filtervars_.size(); ++i)
     allvars_ += backgroundErrorVariable(filtervars_[i]);
+
+  if (options_.shareSearchIndex) {
+    // Buddy checks can share an index only if they sort observations in the same way.
+    std::stringstream key;
+    key << options_.numZonalBands.value() << "|" << options_.sortByPressure.value() << "|"
+        << options_.pressureGroup.value() << "/" << options_.pressureCoord.value() << "|"
+        << options_.numLevels.value().value_or(0);
+    searchIndex_ = MetOfficeBuddySearchIndex::forObsSpace(obsdb, key.str());
+  }
+
+  if (options_.haloExchange) {
+    if (options_.numLevels.value() != boost::none)
+      throw eckit::UserError("The halo_exchange option cannot be combined with num_levels",
+                             Here());
+    if (options_.shareSearchIndex)
+      throw eckit::UserError("The halo_exchange option cannot be combined with "
+                             "share_search_index", Here());
+  }
 }
 
 void MetOfficeBuddyCheck::applyFilter(const std::vector<bool> & apply,
@@ -284,13 +306,33 @@ void MetOfficeBuddyCheck::applyFilter(const std::vector<bool> & apply,
   if (numLevels)
     profileIndex = deriveIndices(obsdb_, *numLevels);
 
-  const std::vector<size_t> validObsIds = getValidObservationIds(apply, profileIndex);
-  MetaData obsData = collectMetaData(profileIndex);
+  // If set, observations held on other ranks are only retrieved if they may be buddies of
+  // observations held on this rank.
+  std::unique_ptr<MetOfficeBuddyHaloExchange> haloExchange;
+  if (options_.haloExchange) {
+    std::vector<float> latitudes(obsdb_.nlocs());
+    obsdb_.get_db("MetaData", "latitude", latitudes);
+    haloExchange.reset(new MetOfficeBuddyHaloExchange(obsdb_, latitudes, apply,
+                                                      options_.searchRadius));
+  }
+
+  const std::vector<size_t> validObsIds =
+      getValidObservationIds(apply, profileIndex, haloExchange.get());
+  MetaData obsData = collectMetaData(profileIndex, haloExchange.get());
+
+  // Observations received from other ranks are traced only by the ranks holding them.
+  std::vector<size_t> tracedObsIds;
+  if (haloExchange) {
+    std::copy_if(validObsIds.begin(), validObsIds.end(), std::back_inserter(tracedObsIds),
+                 [&](size_t obsId) { return obsId < haloExchange->numLocalObs(); });
+  } else {
+    tracedObsIds = validObsIds;
+  }
 
   const std::vector<float> bgErrorHorizCorrScales = calcBackgroundErrorHorizontalCorrelationScales(
         validObsIds, obsData.latitudes);
   const std::vector<bool> verbose = flagAndPrintVerboseObservations(
-        validObsIds, obsData.latitudes, obsData.longitudes, obsData.datetimes,
+        tracedObsIds, obsData.latitudes, obsData.longitudes, obsData.datetimes,
         obsData.pressures.get_ptr(), obsData.stationIds, bgErrorHorizCorrScales);
 
   // Identify buddy pairs
@@ -300,10 +342,21 @@ void MetOfficeBuddyCheck::applyFilter(const std::vector<bool> & apply,
   MetOfficeBuddyPairFinder buddyPairFinder(options_, obsData.latitudes, obsData.longitudes,
                                            obsData.datetimes, pressures,
                                            obsData.stationIds);
-  const std::vector<MetOfficeBuddyPair> buddyPairs = buddyPairFinder.findBuddyPairs(validObsIds);
+  const std::vector<MetOfficeBuddyPair> buddyPairs = searchIndex_ ?
+        buddyPairFinder.findBuddyPairs(validObsIds, *searchIndex_) :
+        buddyPairFinder.findBuddyPairs(validObsIds);
 
   std::shared_ptr<const ioda::Distribution> distribution = obsdb_.distribution();
 
+  // Return the elements of a vector of values at all processed locations associated with the
+  // locations held by this process.
+  auto getLocalValues = [&] (const std::vector<float> &values) {
+    if (haloExchange)
+      return std::vector<float>(values.begin(), values.begin() + haloExchange->numLocalObs());
+    else
+      return localValues(values, obsdb_.nlocs(), *distribution);
+  };
+
   // Fetch data/metadata required for buddy-check calculation.
 
   auto getFilterVariableName = [&] (size_t filterVarIndex) {
@@ -318,17 +371,18 @@ void MetOfficeBuddyCheck::applyFilter(const std::vector<bool> & apply,
 
     // Retrieve data.
     const std::vector<float> obsValues =
-        getGlobalVariable<float>("ObsValue", filterVar);
+        getGlobalVariable<float>("ObsValue", filterVar, haloExchange.get());
     const std::vector<float> obsErrors =
-        getGlobalVariable<float>("ObsErrorData", filterVar);
+        getGlobalVariable<float>("ObsErrorData", filterVar, haloExchange.get());
     const std::vector<float> bgValues =
-        getGlobalVariable<float>("HofX", filterVar);
+        getGlobalVariable<float>("HofX", filterVar, haloExchange.get());
     const std::vector<float> bgErrors =
-        getGlobalVariable<float>(backgroundErrorVariable(filtervars[filterVarIndex]));
+        getGlobalVariable<float>(backgroundErrorVariable(filtervars[filterVarIndex]),
+                                 haloExchange.get());
     const std::vector<int> flags =
-        getGlobalVariable<int>("QCflagsData", filterVar);
+        getGlobalVariable<int>("QCflagsData", filterVar, haloExchange.get());
     const std::vector<float> grossErrorProbabilities =
-        getGlobalVariable<float>("GrossErrorProbability", filterVar);
+        getGlobalVariable<float>("GrossErrorProbability", filterVar, haloExchange.get());
 
     // Store data in a ScalarVariableData object.
     ScalarVariableData data;
@@ -385,8 +439,8 @@ void MetOfficeBuddyCheck::applyFilter(const std::vector<bool> & apply,
       // Update the flat PGEs and extract those associated with locations held by this process.
       updateFlatData(firstComponentData.flatGrossErrorProbabilities,
                      firstComponentData.grossErrorProbabilities, profileIndex);
-      std::vector<float> localFlatGrossErrorProbabilities = localValues(
-            firstComponentData.flatGrossErrorProbabilities, obsdb_.nlocs(), *distribution);
+      std::vector<float> localFlatGrossErrorProbabilities = getLocalValues(
+            firstComponentData.flatGrossErrorProbabilities);
       calculatedGrossErrProbsByVarName[getFilterVariableName(filterVarIndex - 1)] =
           localFlatGrossErrorProbabilities;
       calculatedGrossErrProbsByVarName[getFilterVariableName(filterVarIndex)] =
@@ -409,8 +463,8 @@ void MetOfficeBuddyCheck::applyFilter(const std::vector<bool> & apply,
         // Update the flat PGEs and extract those associated with locations held by this process.
         updateFlatData(data.flatGrossErrorProbabilities,
                        data.grossErrorProbabilities, profileIndex);
-        std::vector<float> localFlatGrossErrorProbabilities = localValues(
-              data.flatGrossErrorProbabilities, obsdb_.nlocs(), *distribution);
+        std::vector<float> localFlatGrossErrorProbabilities = getLocalValues(
+              data.flatGrossErrorProbabilities);
         calculatedGrossErrProbsByVarName[getFilterVariableName(filterVarIndex)] =
             std::move(localFlatGrossErrorProbabilities);
       }
@@ -432,21 +486,23 @@ Variable MetOfficeBuddyCheck::backgroundErrorVariable(const Variable &filterVari
 }
 
 MetOfficeBuddyCheck::MetaData MetOfficeBuddyCheck::collectMetaData(
-    const boost::optional<Eigen::ArrayXXi> & profileIndex) const {
+    const boost::optional<Eigen::ArrayXXi> & profileIndex,
+    const MetOfficeBuddyHaloExchange *haloExchange) const {
   MetaData obsData;
 
   std::shared_ptr<const ioda::Distribution> distribution = obsdb_.distribution();
 
-  obsData.latitudes = getGlobalObsSpaceVariable<float>("MetaData", "latitude");
-  obsData.longitudes = getGlobalObsSpaceVariable<float>("MetaData", "longitude");
-  obsData.datetimes = getGlobalObsSpaceVariable<util::DateTime>("MetaData", "dateTime");
+  obsData.latitudes = getGlobalObsSpaceVariable<float>("MetaData", "latitude", haloExchange);
+  obsData.longitudes = getGlobalObsSpaceVariable<float>("MetaData", "longitude", haloExchange);
+  obsData.datetimes = getGlobalObsSpaceVariable<util::DateTime>("MetaData", "dateTime",
+                                                                haloExchange);
 
   if (obsdb_.has(options_.pressureGroup, options_.pressureCoord)) {
-    obsData.pressures =
-      getGlobalObsSpaceVariable<float>(options_.pressureGroup, options_.pressureCoord);
+    obsData.pressures = getGlobalObsSpaceVariable<float>(
+          options_.pressureGroup, options_.pressureCoord, haloExchange);
     obsData.pressuresML = unravel(*obsData.pressures, profileIndex);
   }
-  obsData.stationIds = getStationIds();
+  obsData.stationIds = getStationIds(haloExchange);
 
   if (profileIndex) {
     obsData.latitudes = extract1stLev(obsData.latitudes, profileIndex);
@@ -460,7 +516,8 @@ MetOfficeBuddyCheck::MetaData MetOfficeBuddyCheck::collectMetaData(
   return obsData;
 }
 
-std::vector<int> MetOfficeBuddyCheck::getStationIds() const {
+std::vector<int> MetOfficeBuddyCheck::getStationIds(
+    const MetOfficeBuddyHaloExchange *haloExchange) const {
   const boost::optional<Variable> &stationIdVariable = options_.stationIdVariable.value();
   if (stationIdVariable == boost::none) {
     std::vector<int> stationIds;
@@ -472,17 +529,18 @@ std::vector<int> MetOfficeBuddyCheck::getStationIds() const {
       const std::vector<size_t> &recordNumbers = obsdb_.recnum();
       stationIds.assign(recordNumbers.begin(), recordNumbers.end());
     }
-    obsdb_.distribution()->allGatherv(stationIds);
+    gatherValues(stationIds, haloExchange);
     return stationIds;
   } else {
     switch (obsdb_.dtype(stationIdVariable->group(), stationIdVariable->variable())) {
     case ioda::ObsDtype::Integer:
-      return getGlobalVariable<int>(stationIdVariable->group(), stationIdVariable->variable());
+      return getGlobalVariable<int>(stationIdVariable->group(), stationIdVariable->variable(),
+                                    haloExchange);
 
     case ioda::ObsDtype::String:
       {
         std::vector<std::string> stringIds = getGlobalVariable<std::string>(
-              stationIdVariable->group(), stationIdVariable->variable());
+              stationIdVariable->group(), stationIdVariable->variable(), haloExchange);
         return mapDistinctValuesToDistinctInts(stringIds);
       }
 
@@ -494,25 +552,37 @@ std::vector<int> MetOfficeBuddyCheck::getStationIds() const {
 }
 
 template <typename T>
-std::vector<T> MetOfficeBuddyCheck::getGlobalObsSpaceVariable(const std::string &group,
-                                                              const std::string &variable) const {
+void MetOfficeBuddyCheck::gatherValues(std::vector<T> &values,
+                                       const MetOfficeBuddyHaloExchange *haloExchange) const {
+  if (haloExchange)
+    values = haloExchange->extend(values);
+  else
+    obsdb_.distribution()->allGatherv(values);
+}
+
+template <typename T>
+std::vector<T> MetOfficeBuddyCheck::getGlobalObsSpaceVariable(
+    const std::string &group, const std::string &variable,
+    const MetOfficeBuddyHaloExchange *haloExchange) const {
   std::vector<T> values(obsdb_.nlocs());
   obsdb_.get_db(group, variable, values);
-  obsdb_.distribution()->allGatherv(values);
+  gatherValues(values, haloExchange);
   return values;
 }
 
 template <typename T>
-std::vector<T> MetOfficeBuddyCheck::getGlobalVariable(const std::string &group,
-                                                      const std::string &variable) const {
-  return getGlobalVariable<T>(Variable(group + "/" + variable));
+std::vector<T> MetOfficeBuddyCheck::getGlobalVariable(
+    const std::string &group, const std::string &variable,
+    const MetOfficeBuddyHaloExchange *haloExchange) const {
+  return getGlobalVariable<T>(Variable(group + "/" + variable), haloExchange);
 }
 
 template <typename T>
-std::vector<T> MetOfficeBuddyCheck::getGlobalVariable(const Variable &var) const {
+std::vector<T> MetOfficeBuddyCheck::getGlobalVariable(
+    const Variable &var, const MetOfficeBuddyHaloExchange *haloExchange) const {
   std::vector<T> values;
   data_.get(var, values);
-  obsdb_.distribution()->allGatherv(values);
+  gatherValues(values, haloExchange);
   return values;
 }
 
@@ -805,13 +875,14 @@ void MetOfficeBuddyCheck::checkVectorData(const std::vector<MetOfficeBuddyPair>
 
 std::vector<size_t> MetOfficeBuddyCheck::getValidObservationIds(
     const std::vector<bool> & apply,
-    const boost::optional<Eigen::ArrayXXi> & profileIndex) const {
+    const boost::optional<Eigen::ArrayXXi> & profileIndex,
+    const MetOfficeBuddyHaloExchange *haloExchange) const {
   std::vector<bool> isValid = apply;
   unselectRejectedLocations(isValid, filtervars_, *flags_,
                             UnselectLocationIf::ALL_FILTER_VARIABLES_REJECTED);
 
   std::vector<int> isValidAsInt(apply.begin(), apply.end());
-  obsdb_.distribution()->allGatherv(isValidAsInt);
+  gatherValues(isValidAsInt, haloExchange);
   isValid.assign(isValidAsInt.begin(), isValidAsInt.end());
 
   std::vector<size_t> validObsIds;
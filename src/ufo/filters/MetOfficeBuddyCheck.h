@@ -34,7 +34,9 @@ class DateTime;
 namespace ufo {
 
 class RecursiveSplitter;
+class MetOfficeBuddyHaloExchange;
 class MetOfficeBuddyPair;
+class MetOfficeBuddySearchIndex;
 
 /// \brief Met Office's implementation of the buddy check.
 ///
@@ -95,41 +97,58 @@ class MetOfficeBuddyCheck : public FilterBase,
   void applyFilter(const std::vector<bool> &, const Variables &,
                    std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override { return QCflags::buddy; }
+  bool modifiesObsSpace() const override {return true;}
 
   /// \brief Return the name of the variable containing the background error estimate of the
   /// specified filter variable.
   Variable backgroundErrorVariable(const Variable &filterVariable) const;
 
   /// \brief Returns a vector of IDs of all observations that should be buddy-checked.
+  ///
+  /// In this function and those below, \p haloExchange is null unless the \c halo_exchange option
+  /// is enabled. If it is not null, "all observations" and "all unique locations held on any MPI
+  /// rank" should be understood as the observations held on the current rank followed by those
+  /// received from other ranks.
   std::vector<size_t> getValidObservationIds(
       const std::vector<bool> & apply,
-      const boost::optional<Eigen::ArrayXXi> & profileIndex) const;
+      const boost::optional<Eigen::ArrayXXi> & profileIndex,
+      const MetOfficeBuddyHaloExchange *haloExchange) const;
 
   /// \brief Collects and returns metadata of all observations.
-  MetaData collectMetaData(const boost::optional<Eigen::ArrayXXi> & profileIndex) const;
+  MetaData collectMetaData(const boost::optional<Eigen::ArrayXXi> & profileIndex,
+                           const MetOfficeBuddyHaloExchange *haloExchange) const;
 
   /// \brief Returns a vector of integer-valued station IDs, obtained from the source indicated by
   /// the filter parameters.
-  std::vector<int> getStationIds() const;
+  std::vector<int> getStationIds(const MetOfficeBuddyHaloExchange *haloExchange) const;
+
+  /// \brief Replaces \p values, the values of a variable at the locations held on the current
+  /// rank, with the values of that variable at all unique locations held on any MPI rank.
+  template <typename T>
+  void gatherValues(std::vector<T> &values,
+                    const MetOfficeBuddyHaloExchange *haloExchange) const;
 
   /// \brief Returns the values of the given ObsSpace variable at all unique locations held on any
   /// MPI rank.
   template <typename T>
   std::vector<T> getGlobalObsSpaceVariable(const std::string &group,
-                                           const std::string &variable) const;
+                                           const std::string &variable,
+                                           const MetOfficeBuddyHaloExchange *haloExchange) const;
 
   /// \brief Returns the values of the given variable at all unique locations held on any MPI rank.
   ///
   /// Any variable accessible via the ObsFilterData object may be specified.
   template <typename T>
   std::vector<T> getGlobalVariable(const std::string &group,
-                                   const std::string &variable) const;
+                                   const std::string &variable,
+                                   const MetOfficeBuddyHaloExchange *haloExchange) const;
 
   /// \brief Returns the values of the given variable at all unique locations held on any MPI rank.
   ///
   /// Any variable accessible via the ObsFilterData object may be specified.
   template <typename T>
-  std::vector<T> getGlobalVariable(const ufo::Variable &var) const;
+  std::vector<T> getGlobalVariable(const ufo::Variable &var,
+                                   const MetOfficeBuddyHaloExchange *haloExchange) const;
 
   /// \brief Calculates and returns background error correlation scales at observation locations.
   ///
@@ -259,6 +278,9 @@ class MetOfficeBuddyCheck : public FilterBase,
 
  private:
   Parameters_ options_;
+  /// Search index shared with other buddy checks acting on the same ObsSpace (null unless the
+  /// \c share_search_index option is enabled).
+  std::shared_ptr<MetOfficeBuddySearchIndex> searchIndex_;
 };
 
 }  // namespace ufo
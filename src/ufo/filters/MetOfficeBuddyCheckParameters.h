@@ -101,6 +101,31 @@ class MetOfficeBuddyCheckParameters : public FilterParametersBase {
   /// pairs.
   oops::Parameter<bool> useLegacyBuddyCollector{"use_legacy_buddy_collector", false, this};
 
+  /// Set to true to share the search data structure built from the observation coordinates with
+  /// other buddy checks acting on the same ObsSpace with the same \c num_zonal_bands,
+  /// \c sort_by_pressure, \c pressure_group, \c pressure_coordinate and \c num_levels
+  /// settings (and also enabling this option).
+  ///
+  /// The data structure is then built from all observations once and reused until the
+  /// coordinates of observations change, instead of being built from the valid observations in
+  /// each run of each buddy check. This does not change the buddy pairs that are found.
+  oops::Parameter<bool> shareSearchIndex{"share_search_index", false, this};
+
+  /// Set to true to avoid gathering the observations held by all MPI ranks. Each rank then
+  /// receives from the other ranks only the valid observations lying within \c search_radius of
+  /// the range of latitudes spanned by its own valid observations (see MetOfficeBuddyHaloExchange)
+  /// and buddy-checks its observations locally.
+  ///
+  /// This reduces communication and memory use substantially if observations are distributed
+  /// across ranks according to their location (e.g. with the Halo distribution). The gross error
+  /// probabilities of observations lying close to partition boundaries may differ slightly from
+  /// those obtained without this option, since pairs of observations are processed in a different
+  /// order and the gross error probabilities of observations received from other ranks are
+  /// updated only by the checks performed on the receiving rank.
+  ///
+  /// Cannot be combined with the \c num_levels and \c share_search_index options.
+  oops::Parameter<bool> haloExchange{"halo_exchange", false, this};
+
   /// @}
   /// \name Parameters controlling gross error probability updates
   /// @{
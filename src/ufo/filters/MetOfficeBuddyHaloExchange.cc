@@ -0,0 +1,150 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/MetOfficeBuddyHaloExchange.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_set>
+
+#include "ioda/distribution/Distribution.h"
+#include "ioda/ObsSpace.h"
+#include "oops/util/Duration.h"
+#include "oops/util/Logger.h"
+#include "ufo/utils/Constants.h"
+
+namespace ufo {
+
+MetOfficeBuddyHaloExchange::MetOfficeBuddyHaloExchange(const ioda::ObsSpace &obsdb,
+                                                       const std::vector<float> &latitudes,
+                                                       const std::vector<bool> &isValid,
+                                                       float searchRadius)
+  : comm_(obsdb.comm()), numLocalObs_(latitudes.size())
+{
+  ASSERT(isValid.size() == numLocalObs_);
+  const size_t numRanks = comm_.size();
+  const size_t currentRank = comm_.rank();
+  const std::shared_ptr<const ioda::Distribution> distribution = obsdb.distribution();
+
+  // Find the range of latitudes spanned by the valid observations held on each rank.
+  // (Ranks without valid observations report an empty range.)
+  float minLatitude = std::numeric_limits<float>::max();
+  float maxLatitude = std::numeric_limits<float>::lowest();
+  for (size_t obsId = 0; obsId < numLocalObs_; ++obsId) {
+    if (isValid[obsId]) {
+      minLatitude = std::min(minLatitude, latitudes[obsId]);
+      maxLatitude = std::max(maxLatitude, latitudes[obsId]);
+    }
+  }
+  std::vector<std::vector<float>> rangesToSend(numRanks, {minLatitude, maxLatitude});
+  std::vector<std::vector<float>> latitudeRanges;
+  comm_.allToAll(rangesToSend, latitudeRanges);
+
+  // Buddies lie at most this many degrees of latitude apart.
+  const float haloWidth = searchRadius / Constants::mean_earth_rad * Constants::rad2deg;
+
+  std::vector<bool> isPatchObs(numLocalObs_);
+  distribution->patchObs(isPatchObs);
+
+  // Send each valid observation from the patch of the current rank to all other ranks whose
+  // latitude range, widened by the halo width, contains that observation.
+  sentObsIds_.resize(numRanks);
+  std::vector<std::vector<int64_t>> globalObsIdsToSend(numRanks);
+  for (size_t obsId = 0; obsId < numLocalObs_; ++obsId) {
+    if (!isValid[obsId] || !isPatchObs[obsId])
+      continue;
+    for (size_t rank = 0; rank < numRanks; ++rank) {
+      if (rank == currentRank)
+        continue;
+      if (latitudes[obsId] >= latitudeRanges[rank][0] - haloWidth &&
+          latitudes[obsId] <= latitudeRanges[rank][1] + haloWidth) {
+        sentObsIds_[rank].push_back(obsId);
+        globalObsIdsToSend[rank].push_back(
+              distribution->globalUniqueConsecutiveLocationIndex(obsId));
+      }
+    }
+  }
+  std::vector<std::vector<int64_t>> receivedGlobalObsIds;
+  comm_.allToAll(globalObsIdsToSend, receivedGlobalObsIds);
+
+  // Discard received observations that are also held on the current rank (outside its patch).
+  std::unordered_set<int64_t> localGlobalObsIds;
+  for (size_t obsId = 0; obsId < numLocalObs_; ++obsId)
+    localGlobalObsIds.insert(distribution->globalUniqueConsecutiveLocationIndex(obsId));
+
+  keptReceivedIndices_.resize(numRanks);
+  for (size_t rank = 0; rank < numRanks; ++rank) {
+    for (size_t index = 0; index < receivedGlobalObsIds[rank].size(); ++index) {
+      if (localGlobalObsIds.count(receivedGlobalObsIds[rank][index]) == 0) {
+        keptReceivedIndices_[rank].push_back(index);
+        ++numHaloObs_;
+      }
+    }
+  }
+
+  oops::Log::debug() << "MetOfficeBuddyHaloExchange: " << numHaloObs_
+                     << " halo observations received" << std::endl;
+}
+
+template <>
+std::vector<util::DateTime> MetOfficeBuddyHaloExchange::extend(
+    const std::vector<util::DateTime> &localValues) const {
+  const util::DateTime referenceTime(1970, 1, 1, 0, 0, 0);
+
+  std::vector<int64_t> localSeconds;
+  localSeconds.reserve(localValues.size());
+  for (const util::DateTime &datetime : localValues)
+    localSeconds.push_back((datetime - referenceTime).toSeconds());
+
+  const std::vector<int64_t> seconds = extend(localSeconds);
+
+  std::vector<util::DateTime> result(localValues);
+  result.reserve(seconds.size());
+  for (size_t i = localValues.size(); i < seconds.size(); ++i)
+    result.push_back(referenceTime + util::Duration(seconds[i]));
+  return result;
+}
+
+template <>
+std::vector<std::string> MetOfficeBuddyHaloExchange::extend(
+    const std::vector<std::string> &localValues) const {
+  ASSERT(localValues.size() == numLocalObs_);
+  const size_t numRanks = sentObsIds_.size();
+
+  std::vector<std::vector<char>> charsToSend(numRanks);
+  for (size_t rank = 0; rank < numRanks; ++rank) {
+    for (size_t obsId : sentObsIds_[rank]) {
+      const std::string &value = localValues[obsId];
+      charsToSend[rank].insert(charsToSend[rank].end(), value.begin(), value.end());
+      charsToSend[rank].push_back('\0');
+    }
+  }
+
+  std::vector<std::vector<char>> receivedChars;
+  comm_.allToAll(charsToSend, receivedChars);
+
+  std::vector<std::string> result(localValues);
+  result.reserve(numLocalObs_ + numHaloObs_);
+  for (size_t rank = 0; rank < numRanks; ++rank) {
+    // Split the received characters into strings.
+    std::vector<std::string> receivedValues;
+    auto begin = receivedChars[rank].begin();
+    while (begin != receivedChars[rank].end()) {
+      const auto end = std::find(begin, receivedChars[rank].end(), '\0');
+      ASSERT(end != receivedChars[rank].end());
+      receivedValues.emplace_back(begin, end);
+      begin = end + 1;
+    }
+    for (size_t index : keptReceivedIndices_[rank])
+      result.push_back(receivedValues[index]);
+  }
+  return result;
+}
+
+}  // namespace ufo
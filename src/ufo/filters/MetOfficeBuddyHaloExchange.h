@@ -0,0 +1,118 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_METOFFICEBUDDYHALOEXCHANGE_H_
+#define UFO_FILTERS_METOFFICEBUDDYHALOEXCHANGE_H_
+
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/mpi/Comm.h"
+#include "oops/util/DateTime.h"
+
+namespace ioda {
+class ObsSpace;
+}
+
+namespace ufo {
+
+/// \brief Exchanges the observations lying close to the boundaries of the regions covered by
+/// individual MPI ranks, so that each rank can identify all buddies of its own observations
+/// without gathering the observations held by all ranks.
+///
+/// Each rank finds the range of latitudes spanned by its valid observations. Any valid observation
+/// lying within the search radius of the latitude range of another rank is sent to that rank.
+/// The observations received by a rank in this way form its *halo*. Since two observations lying
+/// at most the search radius apart differ in latitude by at most the same distance, each rank ends
+/// up with all potential buddies of its own valid observations.
+///
+/// Only observations from the patch of the sending rank are sent, and received observations
+/// already held on the receiving rank are discarded, so no observation is present twice.
+///
+/// The amount of data exchanged is small if observations are distributed across ranks according
+/// to their location (e.g. with the Halo distribution); if each rank holds observations from the
+/// whole globe, the halo of each rank contains all valid observations held by the other ranks.
+class MetOfficeBuddyHaloExchange : private boost::noncopyable {
+ public:
+  /// \brief Determine the observations to exchange.
+  ///
+  /// \param obsdb
+  ///   The observation space.
+  /// \param latitudes
+  ///   Latitudes of the observations held on the current rank.
+  /// \param isValid
+  ///   Vector indicating which of the observations held on the current rank are valid (only
+  ///   valid observations are sent to other ranks).
+  /// \param searchRadius
+  ///   Maximum distance between buddies, in km.
+  MetOfficeBuddyHaloExchange(const ioda::ObsSpace &obsdb,
+                             const std::vector<float> &latitudes,
+                             const std::vector<bool> &isValid,
+                             float searchRadius);
+
+  /// Number of observations held on the current rank.
+  size_t numLocalObs() const { return numLocalObs_; }
+
+  /// Number of observations received from other ranks.
+  size_t numHaloObs() const { return numHaloObs_; }
+
+  /// \brief Return a vector made up of the elements of \p localValues (the values of a variable
+  /// at the observations held on the current rank) followed by the values of the same variable
+  /// at the observations received from other ranks.
+  ///
+  /// This function must be called on all ranks.
+  template <typename T>
+  std::vector<T> extend(const std::vector<T> &localValues) const;
+
+ private:
+  const eckit::mpi::Comm &comm_;
+  size_t numLocalObs_;
+  size_t numHaloObs_ = 0;
+  /// IDs of the observations sent to each rank.
+  std::vector<std::vector<size_t>> sentObsIds_;
+  /// Indices (in the list of observations received from each rank) of the received
+  /// observations that are not held on the current rank.
+  std::vector<std::vector<size_t>> keptReceivedIndices_;
+};
+
+template <typename T>
+std::vector<T> MetOfficeBuddyHaloExchange::extend(const std::vector<T> &localValues) const {
+  ASSERT(localValues.size() == numLocalObs_);
+  const size_t numRanks = sentObsIds_.size();
+
+  std::vector<std::vector<T>> valuesToSend(numRanks);
+  for (size_t rank = 0; rank < numRanks; ++rank)
+    for (size_t obsId : sentObsIds_[rank])
+      valuesToSend[rank].push_back(localValues[obsId]);
+
+  std::vector<std::vector<T>> receivedValues;
+  comm_.allToAll(valuesToSend, receivedValues);
+
+  std::vector<T> result(localValues);
+  result.reserve(numLocalObs_ + numHaloObs_);
+  for (size_t rank = 0; rank < numRanks; ++rank)
+    for (size_t index : keptReceivedIndices_[rank])
+      result.push_back(receivedValues[rank][index]);
+  return result;
+}
+
+/// Specialization exchanging observation times as numbers of seconds since a reference time.
+template <>
+std::vector<util::DateTime> MetOfficeBuddyHaloExchange::extend(
+    const std::vector<util::DateTime> &localValues) const;
+
+/// Specialization exchanging strings as null-terminated sequences of characters.
+template <>
+std::vector<std::string> MetOfficeBuddyHaloExchange::extend(
+    const std::vector<std::string> &localValues) const;
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_METOFFICEBUDDYHALOEXCHANGE_H_
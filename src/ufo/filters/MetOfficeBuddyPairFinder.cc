@@ -8,11 +8,13 @@
 #include "ufo/filters/MetOfficeBuddyPairFinder.h"
 
 #include <algorithm>
+#include <numeric>
 
 #include "oops/util/Logger.h"
 #include "ufo/filters/MetOfficeBuddyCheckParameters.h"
 #include "ufo/filters/MetOfficeBuddyCollectorV1.h"
 #include "ufo/filters/MetOfficeBuddyCollectorV2.h"
+#include "ufo/filters/MetOfficeBuddySearchIndex.h"
 #include "ufo/utils/RecursiveSplitter.h"
 
 #include <boost/make_unique.hpp>
@@ -45,6 +47,42 @@ std::vector<MetOfficeBuddyPair> MetOfficeBuddyPairFinder::findBuddyPairs(
   return pairObservations(validObsIdsInSortOrder, bandLbounds);
 }
 
+std::vector<MetOfficeBuddyPair> MetOfficeBuddyPairFinder::findBuddyPairs(
+    const std::vector<size_t> & validObsIds, MetOfficeBuddySearchIndex &index) {
+  const size_t numObs = latitudes_.size();
+  if (!index.isUpToDate(latitudes_, longitudes_, datetimes_, pressures_)) {
+    std::vector<size_t> allObsIds(numObs);
+    std::iota(allObsIds.begin(), allObsIds.end(), 0);
+    sortObservations(allObsIds, index.obsIdsInSortOrder, index.bandLbounds);
+    index.setCoordinates(latitudes_, longitudes_, datetimes_, pressures_);
+  } else {
+    oops::Log::trace() << "Buddy check: reusing search index" << std::endl;
+  }
+
+  // Since observations are sorted with a stable sort, removing invalid observations from the
+  // index yields the same order as sorting the valid observations alone.
+  std::vector<bool> isValid(numObs, false);
+  for (size_t obsId : validObsIds)
+    isValid[obsId] = true;
+
+  std::vector<int> validObsIdsInSortOrder;
+  validObsIdsInSortOrder.reserve(validObsIds.size());
+  std::vector<int> bandLbounds(options_.numZonalBands + 1, 0);
+  for (int band = 0; band < options_.numZonalBands; ++band) {
+    bandLbounds[band] = validObsIdsInSortOrder.size();
+    for (int i = index.bandLbounds[band]; i < index.bandLbounds[band + 1]; ++i) {
+      const int obsId = index.obsIdsInSortOrder[i];
+      if (isValid[obsId])
+        validObsIdsInSortOrder.push_back(obsId);
+    }
+  }
+  bandLbounds[options_.numZonalBands] = validObsIdsInSortOrder.size();
+
+  oops::Log::trace() << "Buddy check: " << validObsIds.size() << " input observations" << std::endl;
+
+  return pairObservations(validObsIdsInSortOrder, bandLbounds);
+}
+
 void MetOfficeBuddyPairFinder::sortObservations(const std::vector<size_t> & validObsIds,
                                                 std::vector<int> &validObsIdsInSortOrder,
                                                 std::vector<int> &bandLbounds)
@@ -103,7 +141,8 @@ std::vector<MetOfficeBuddyPair> MetOfficeBuddyPairFinder::pairObservations(
     const std::vector<int> &validObsIdsInSortOrder,
     const std::vector<int> &bandLbounds) {
 
-  std::vector<MetOfficeBuddyPair> pairs;
+  // Pairs found in each band.
+  std::vector<std::vector<MetOfficeBuddyPair>> pairsInBands(options_.numZonalBands);
 
   // Initialise variables
   const float bandWidth = zonalBandWidth(options_.numZonalBands);
@@ -123,21 +162,22 @@ std::vector<MetOfficeBuddyPair> MetOfficeBuddyPairFinder::pairObservations(
     bandEnds[bandIndex] = validObsIdsInSortOrder.begin() + bandLbounds[bandIndex + 1];
   }
 
-  std::vector<ObsIdIt> firstObsToCheckInBands(options_.numZonalBands);
-
-  // Collects buddies of a single observation. When we're done with that observation, the collected
-  // list of buddies is extracted into 'pairs' and the collector is reset.
-  std::unique_ptr<MetOfficeBuddyCollector> buddyCollector = makeBuddyCollector();
-
   // Iterate over all bands
+  #pragma omp parallel for schedule(dynamic)
   for (int jBandA = 0; jBandA < options_.numZonalBands; ++jBandA) {
+    std::vector<MetOfficeBuddyPair> &pairs = pairsInBands[jBandA];
+
+    // Collects buddies of a single observation. When we're done with that observation, the
+    // collected list of buddies is extracted into 'pairs' and the collector is reset.
+    std::unique_ptr<MetOfficeBuddyCollector> buddyCollector = makeBuddyCollector();
+
     const float lonSearchRangeHalfWidth = getLongitudeSearchRangeHalfWidth(jBandA, bandWidth);
 
     const int firstBandToSearch = jBandA;
     const int lastBandToSearch = std::min(options_.numZonalBands.value() - 1,
                                           jBandA + numSearchBands);
 
-    firstObsToCheckInBands = bandBegins;
+    std::vector<ObsIdIt> firstObsToCheckInBands = bandBegins;
 
     // Iterate over observations in (jBandA)th band
     for (ObsIdIt obsIdItA = bandBegins[jBandA]; obsIdItA != bandEnds[jBandA]; ++obsIdItA) {
@@ -223,6 +263,10 @@ FinishProcessingObsA:
     }  // end of main loop over observations (obsIdItA)
   }  // end of main loop over bands (jBandA)
 
+  std::vector<MetOfficeBuddyPair> pairs;
+  for (std::vector<MetOfficeBuddyPair> &pairsInBand : pairsInBands)
+    pairs.insert(pairs.end(), pairsInBand.begin(), pairsInBand.end());
+
   oops::Log::trace() << "Found " << pairs.size() << " buddy pairs.\n";
 
   return pairs;
@@ -21,6 +21,7 @@ namespace ufo {
 
 class MetOfficeBuddyCheckParameters;
 class MetOfficeBuddyCollector;
+class MetOfficeBuddySearchIndex;
 
 /// \brief Finds pairs of close observations ("buddies") to check against each other.
 class MetOfficeBuddyPairFinder {
@@ -39,6 +40,16 @@ class MetOfficeBuddyPairFinder {
   /// that should be checked against each other.
   std::vector<MetOfficeBuddyPair> findBuddyPairs(const std::vector<size_t> &validObsIds);
 
+  /// \brief Returns a list of MetOfficeBuddyPair objects representing pairs of "buddy" observations
+  /// that should be checked against each other, taking the order of observations from \p index
+  /// instead of sorting them.
+  ///
+  /// The index is (re)built from all observations if it was built from observations with
+  /// different coordinates. The buddy pairs found are the same as those returned by the other
+  /// overload of this function.
+  std::vector<MetOfficeBuddyPair> findBuddyPairs(const std::vector<size_t> &validObsIds,
+                                                 MetOfficeBuddySearchIndex &index);
+
  private:
   /// \brief Sorts observations in an order facilitating rapid search for buddies.
   ///
@@ -62,6 +73,9 @@ class MetOfficeBuddyPairFinder {
   ///
   /// See the OPS Scientific Documentation Paper 2, sections 3.4 and 3.5.
   ///
+  /// Zonal bands are processed in parallel if OpenMP is enabled; the pairs found in each band are
+  /// then concatenated in band order, so the result does not depend on the number of threads.
+  ///
   /// \param validObsIdsInSortOrder, bandLbounds
   ///   Outputs produced by sortObservations().
   ///
@@ -0,0 +1,66 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/MetOfficeBuddySearchIndex.h"
+
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "ioda/ObsSpace.h"
+
+namespace ufo {
+
+std::shared_ptr<MetOfficeBuddySearchIndex> MetOfficeBuddySearchIndex::forObsSpace(
+    const ioda::ObsSpace &obsdb, const std::string &key) {
+  typedef std::pair<const ioda::ObsSpace *, std::string> IndexKey;
+  static std::mutex mutex;
+  static std::map<IndexKey, std::weak_ptr<MetOfficeBuddySearchIndex>> indices;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  // Forget indices no longer used by any buddy check.
+  for (auto it = indices.begin(); it != indices.end(); ) {
+    if (it->second.expired())
+      it = indices.erase(it);
+    else
+      ++it;
+  }
+
+  std::weak_ptr<MetOfficeBuddySearchIndex> &weakIndex = indices[IndexKey(&obsdb, key)];
+  std::shared_ptr<MetOfficeBuddySearchIndex> index = weakIndex.lock();
+  if (!index) {
+    index = std::make_shared<MetOfficeBuddySearchIndex>();
+    weakIndex = index;
+  }
+  return index;
+}
+
+bool MetOfficeBuddySearchIndex::isUpToDate(const std::vector<float> &latitudes,
+                                           const std::vector<float> &longitudes,
+                                           const std::vector<util::DateTime> &datetimes,
+                                           const std::vector<float> *pressures) const {
+  return built_ &&
+      latitudes == latitudes_ && longitudes == longitudes_ && datetimes == datetimes_ &&
+      hasPressures_ == (pressures != nullptr) && (!pressures || *pressures == pressures_);
+}
+
+void MetOfficeBuddySearchIndex::setCoordinates(const std::vector<float> &latitudes,
+                                               const std::vector<float> &longitudes,
+                                               const std::vector<util::DateTime> &datetimes,
+                                               const std::vector<float> *pressures) {
+  latitudes_ = latitudes;
+  longitudes_ = longitudes;
+  datetimes_ = datetimes;
+  hasPressures_ = pressures != nullptr;
+  if (pressures)
+    pressures_ = *pressures;
+  else
+    pressures_.clear();
+  built_ = true;
+}
+
+}  // namespace ufo
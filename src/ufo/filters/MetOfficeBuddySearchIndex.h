@@ -0,0 +1,75 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_METOFFICEBUDDYSEARCHINDEX_H_
+#define UFO_FILTERS_METOFFICEBUDDYSEARCHINDEX_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "oops/util/DateTime.h"
+
+namespace ioda {
+class ObsSpace;
+}
+
+namespace ufo {
+
+/// \brief All observations held in an ObsSpace sorted in the order facilitating rapid search for
+/// buddies (see MetOfficeBuddyPairFinder::sortObservations()).
+///
+/// An instance of this class can be shared by all buddy checks acting on the same ObsSpace with
+/// the same search settings (see forObsSpace()) to avoid sorting the same observations again
+/// in each of them. The coordinates used to sort the observations are stored as well, so that
+/// the index can be rebuilt if they change.
+class MetOfficeBuddySearchIndex : private boost::noncopyable {
+ public:
+  /// \brief Return the index shared by all buddy checks acting on \p obsdb with settings
+  /// identified by \p key, creating it if necessary.
+  ///
+  /// The index is destroyed once no buddy check holds a pointer to it.
+  static std::shared_ptr<MetOfficeBuddySearchIndex> forObsSpace(const ioda::ObsSpace &obsdb,
+                                                                const std::string &key);
+
+  /// \brief Return true if the index was built from observations with the specified coordinates.
+  ///
+  /// \param pressures Optional -- may be null.
+  bool isUpToDate(const std::vector<float> &latitudes,
+                  const std::vector<float> &longitudes,
+                  const std::vector<util::DateTime> &datetimes,
+                  const std::vector<float> *pressures) const;
+
+  /// \brief Store the coordinates of the observations from which the index was built.
+  ///
+  /// \param pressures Optional -- may be null.
+  void setCoordinates(const std::vector<float> &latitudes,
+                      const std::vector<float> &longitudes,
+                      const std::vector<util::DateTime> &datetimes,
+                      const std::vector<float> *pressures);
+
+  /// IDs of all observations in sort order.
+  std::vector<int> obsIdsInSortOrder;
+  /// Vector of length (number of zonal bands + 1) such that
+  /// [bandLbounds[i], bandLbounds[i + 1]) is the half-open range of indices of elements of
+  /// obsIdsInSortOrder representing the IDs of observations from ith zonal band.
+  std::vector<int> bandLbounds;
+
+ private:
+  bool built_ = false;
+  std::vector<float> latitudes_;
+  std::vector<float> longitudes_;
+  std::vector<util::DateTime> datetimes_;
+  bool hasPressures_ = false;
+  std::vector<float> pressures_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_METOFFICEBUDDYSEARCHINDEX_H_
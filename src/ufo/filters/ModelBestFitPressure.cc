@@ -130,10 +130,18 @@ void ModelBestFitPressure::applyFilter(const std::vector<bool> & apply,
                            Here());
   }
 
-  // Vectors storing GeoVaL column for each location.
-  std::vector <float> model_pressure_profile(gvals->nlevs(model_pressure_name), 0.0);
-  std::vector <float> model_eastvec_profile(gvals->nlevs(model_eastvec_name), 0.0);
-  std::vector <float> model_northvec_profile(gvals->nlevs(model_northvec_name), 0.0);
+  // The GeoVaLs are read in place (the levels of each location are contiguous). Each column is
+  // converted to single precision once, together with the computation of the vector differences.
+  const GeoVaLsView model_pressure = gvals->view(model_pressure_name);
+  const GeoVaLsView model_eastvec = gvals->view(model_eastvec_name);
+  const GeoVaLsView model_northvec = gvals->view(model_northvec_name);
+  if (model_pressure.nlevs() < num_level || model_northvec.nlevs() < num_level) {
+    throw eckit::BadValue("The model pressure and northward wind have fewer levels than the "
+                          "eastward wind", Here());
+  }
+  std::vector <float> model_pressure_profile(num_level);
+  std::vector <float> model_eastvec_profile(num_level);
+  std::vector <float> model_northvec_profile(num_level);
   std::vector <float> vec_diff(num_level);
   // diagnostic variable to be summed over all processors at the end of the routine
   std::unique_ptr<ioda::Accumulator<size_t>> countAccumulator =
@@ -141,13 +149,23 @@ void ModelBestFitPressure::applyFilter(const std::vector<bool> & apply,
 
   for (size_t idata = 0; idata < nlocs; ++idata) {
     if (apply[idata]) {
-      // Get GeoVaLs at the specified location.
-      gvals->getAtLocation(model_pressure_profile, model_pressure_name, idata);
-      gvals->getAtLocation(model_eastvec_profile, model_eastvec_name, idata);
-      gvals->getAtLocation(model_northvec_profile, model_northvec_name, idata);
+      // Calculate vector difference between observed and background at all levels.
+      const double * pressure_column = model_pressure.atLocation(idata);
+      const double * eastvec_column = model_eastvec.atLocation(idata);
+      const double * northvec_column = model_northvec.atLocation(idata);
+      const float obs_east = obs_eastward[idata];
+      const float obs_north = obs_northward[idata];
+      for (size_t ilev = 0; ilev < num_level; ++ilev) {
+        model_pressure_profile[ilev] = pressure_column[ilev];
+        model_eastvec_profile[ilev] = eastvec_column[ilev];
+        model_northvec_profile[ilev] = northvec_column[ilev];
+        vec_diff[ilev] = std::hypot(obs_east - model_eastvec_profile[ilev],
+                                    obs_north - model_northvec_profile[ilev]);
+      }
 
       // Check GeoVaLs are in correct vertical order
-      if (model_pressure_profile.front() > model_pressure_profile.back()) {
+      if (static_cast<float>(pressure_column[0]) >
+          static_cast<float>(pressure_column[model_pressure.nlevs() - 1])) {
         throw eckit::BadValue("GeoVaLs are not ordered from model top to bottom", Here());
       }
 
@@ -155,10 +173,9 @@ void ModelBestFitPressure::applyFilter(const std::vector<bool> & apply,
       const size_t UNINITIALIZED = std::numeric_limits<size_t>::max();
       size_t imin = UNINITIALIZED;
 
-      // Calculate vector difference between observed and background at all levels and find minima
+      // Find the minimum of the vector difference below top_pressure (the lowest level in case
+      // of a tie).
       for (int ilev = num_level - 1; ilev >= 0; ilev--) {
-        vec_diff[ilev] = std::hypot(obs_eastward[idata] - model_eastvec_profile[ilev],
-                                    obs_northward[idata] - model_northvec_profile[ilev]);
         if (model_pressure_profile[ilev] < top_pressure) continue;
         if (vec_diff[ilev] < min_vector_diff) {
           min_vector_diff = vec_diff[ilev];
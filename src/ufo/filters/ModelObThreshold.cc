@@ -123,45 +123,40 @@ void ModelObThreshold::applyFilter(const std::vector<bool> & apply,
 // N.B. inputs to interp must be double precision
   ufo::PiecewiseLinearInterpolation interp_thresholds(coord_vals, thresholds);
 
+// The model columns are read in place from the GeoVaLs (the levels of each location are
+// contiguous) rather than copied location by location.
+  const GeoVaLsView model_profile = gvals->view(model_profile_name);
+  const GeoVaLsView model_vcoord = gvals->view(model_vcoord_name);
+  const size_t nlevs = model_vcoord.nlevs();
+  if (nlevs == 0 || model_profile.nlevs() != nlevs) {
+      errString << "The model profile and vertical coordinate must have the same, non-zero "
+                << "number of levels" << std::endl;
+      throw eckit::BadValue(errString.str());
+  }
+  const bool flagBelowThreshold = parameters_.threshold_type == ThresholdType::MIN;
+  const bool flagAboveThreshold = parameters_.threshold_type == ThresholdType::MAX;
+
 // Loop through locations
   for (size_t iloc=0; iloc < nlocs; ++iloc) {
-    // interpolate threshold values to observation height
-    float bg_threshold = interp_thresholds(obs_height[iloc]);
+    if (!apply[iloc]) continue;
 
-    // Vectors storing GeoVaL column for current location.
-    std::vector <double> model_profile_column;
-    std::vector <double> model_vcoord_column;
-    model_profile_column.assign(gvals->nlevs(model_profile_name), 0.0);
-    model_vcoord_column.assign(gvals->nlevs(model_vcoord_name), 0.0);
-    // Get GeoVaLs at the specified location.
-    gvals->getAtLocation(model_profile_column, model_profile_name, iloc);
-    gvals->getAtLocation(model_vcoord_column, model_vcoord_name, iloc);
+    // interpolate threshold values to observation height
+    const float bg_threshold = interp_thresholds(obs_height[iloc]);
 
     // interpolate model profile values to observation height
-    ufo::PiecewiseLinearInterpolation interp_model(model_vcoord_column, model_profile_column);
-    float bg_model = interp_model(obs_height[iloc]);
+    const float bg_model = ufo::PiecewiseLinearInterpolation::interpolate(
+          model_vcoord.atLocation(iloc), model_profile.atLocation(iloc), nlevs,
+          obs_height[iloc]);
 
     // Apply threshold
-    if (apply[iloc]) {
-      // check to see if one of the compared values is missing
-      if (bg_model == missing || bg_threshold == missing) {
-        for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
-          flagged[jv][iloc] = true;
-        }
-      } else {
-      // Check if model value is outside threshold and set flag
-        for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
-          if (parameters_.threshold_type == ThresholdType::MIN) {
-            if (bg_model < (bg_threshold)) {
-              flagged[jv][iloc] = true;
-            }
-          }
-          if (parameters_.threshold_type == ThresholdType::MAX) {
-            if (bg_model > (bg_threshold)) {
-              flagged[jv][iloc] = true;
-            }
-          }
-        }
+    // check to see if one of the compared values is missing
+    // and otherwise if model value is outside threshold
+    const bool flag = bg_model == missing || bg_threshold == missing ||
+                      (flagBelowThreshold && bg_model < bg_threshold) ||
+                      (flagAboveThreshold && bg_model > bg_threshold);
+    if (flag) {
+      for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
+        flagged[jv][iloc] = true;
       }
     }
   }
@@ -7,13 +7,16 @@
 
 #include "ufo/filters/ObsAccessor.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ioda/distribution/InefficientDistribution.h"
 #include "ioda/ObsSpace.h"
 #include "ufo/filters/FilterUtils.h"
+#include "ufo/filters/ObsAccessorCache.h"
 #include "ufo/filters/QCflags.h"
 #include "ufo/filters/Variables.h"
 #include "ufo/utils/RecursiveSplitter.h"
@@ -22,10 +25,15 @@ namespace ufo {
 
 namespace {
 
+/// If \p cache is not null, the values are taken from it (and gathered only if they have
+/// changed since they were last gathered).
 template <typename VariableType>
 std::vector<VariableType> getVariableFromObsSpaceImpl(
     const std::string &group, const std::string &variable,
-    const ioda::ObsSpace &obsdb, const ioda::Distribution &obsDistribution) {
+    const ioda::ObsSpace &obsdb, const ioda::Distribution &obsDistribution,
+    ObsAccessorCache *cache) {
+  if (cache)
+    return cache->getGlobalVariable<VariableType>(group, variable, obsdb, obsDistribution);
   std::vector<VariableType> result(obsdb.nlocs());
   obsdb.get_db(group, variable, result);
   obsDistribution.allGatherv(result);
@@ -43,23 +51,6 @@ std::vector<T> getValidObservationCategories(const std::vector<T> &categories,
   return validObsCategories;
 }
 
-template <typename VariableType>
-void groupObservationsByVariableImpl(
-    const Variable &variable,
-    const std::vector<size_t> &validObsIds,
-    const ioda::ObsSpace &obsdb,
-    const ioda::Distribution &obsDistribution,
-    RecursiveSplitter &splitter) {
-  std::vector<VariableType> obsCategories(obsdb.nlocs());
-  obsdb.get_db(variable.group(), variable.variable(), obsCategories);
-  obsDistribution.allGatherv(obsCategories);
-
-  const std::vector<VariableType> validObsCategories = getValidObservationCategories(
-        obsCategories, validObsIds);
-
-  splitter.groupBy(validObsCategories);
-}
-
 }  // namespace
 
 ObsAccessor::ObsAccessor(const ioda::ObsSpace &obsdb,
@@ -74,15 +65,16 @@ ObsAccessor::ObsAccessor(const ioda::ObsSpace &obsdb,
   if (groupBy_ == GroupBy::VARIABLE && wereRecordsGroupedByCategoryVariable())
     groupBy_ = GroupBy::RECORD_ID;
 
-  if (groupBy_ == GroupBy::RECORD_ID) {
-    // Each record is held by a single process, so there's no need to exchange data between
-    // processes and we can use an InefficientDistribution rather than the distribution taken from
+  if (groupBy_ == GroupBy::RECORD_ID || groupBy_ == GroupBy::CURRENT_RANK) {
+    // Each record is held by a single process (or only data held by the current process are
+    // needed), so there's no need to exchange data between processes and we can use an InefficientDistribution rather than the distribution taken from
     // obsdb_. Which in this case is *efficient*!
     obsDistribution_ = std::make_shared<ioda::InefficientDistribution>(obsdb_->comm(),
                                                         ioda::EmptyDistributionParameters());
     oops::Log::trace() << "ObservationAccessor: no MPI communication necessary" << std::endl;
   } else {
     obsDistribution_ = obsdb.distribution();
+    cache_ = ObsAccessorCache::forObsSpace(obsdb);
   }
 }
 
@@ -106,6 +98,11 @@ ObsAccessor ObsAccessor::toSingleObservationsSplitIntoIndependentGroupsByVariabl
   return ObsAccessor(obsdb, GroupBy::SINGLE_OBS, variable);
 }
 
+ObsAccessor ObsAccessor::toObservationsHeldOnCurrentRank(
+    const ioda::ObsSpace &obsdb) {
+  return ObsAccessor(obsdb, GroupBy::CURRENT_RANK, boost::none);
+}
+
 std::vector<bool> ObsAccessor::getGlobalApply(
     const std::vector<bool> &apply) const {
   std::vector<int> globalApply(apply.begin(), apply.end());
@@ -173,33 +170,95 @@ const std::vector<size_t> ObsAccessor::getValidObsIdsInProfile(const size_t & iP
   return validObsIds;
 }
 
+std::vector<std::vector<size_t>> ObsAccessor::getValidObsIdsInProfiles(
+    const std::vector<bool> & apply,
+    const ioda::ObsDataVector<int> &flags,
+    const Variables & filtervars,
+    bool candidateForRetentionIfAnyFilterVariablesPassedQC) const {
+  std::vector<bool> isValid = apply;
+  const UnselectLocationIf mode = candidateForRetentionIfAnyFilterVariablesPassedQC ?
+        UnselectLocationIf::ALL_FILTER_VARIABLES_REJECTED :
+        UnselectLocationIf::ANY_FILTER_VARIABLE_REJECTED;
+  unselectRejectedLocations(isValid, filtervars, flags, mode);
+  const std::vector<size_t> & recordNumbers = obsdb_->recidx_all_recnums();
+  std::vector<std::vector<size_t>> validObsIds(recordNumbers.size());
+  for (size_t iProfile = 0; iProfile < recordNumbers.size(); ++iProfile) {
+    for (size_t obsId : obsdb_->recidx_vector(recordNumbers[iProfile])) {
+      if (isValid[obsId]) {
+        validObsIds[iProfile].push_back(obsId);
+      }
+    }
+  }
+  return validObsIds;
+}
+
 
 std::vector<int> ObsAccessor::getIntVariableFromObsSpace(
     const std::string &group, const std::string &variable) const {
-  return getVariableFromObsSpaceImpl<int>(group, variable, *obsdb_, *obsDistribution_);
+  return getVariableFromObsSpaceImpl<int>(group, variable, *obsdb_, *obsDistribution_,
+                                          cache_.get());
 }
 
 std::vector<float> ObsAccessor::getFloatVariableFromObsSpace(
     const std::string &group, const std::string &variable) const {
-  return getVariableFromObsSpaceImpl<float>(group, variable, *obsdb_, *obsDistribution_);
+  return getVariableFromObsSpaceImpl<float>(group, variable, *obsdb_, *obsDistribution_,
+                                            cache_.get());
 }
 
 std::vector<double> ObsAccessor::getDoubleVariableFromObsSpace(
     const std::string &group, const std::string &variable) const {
-  return getVariableFromObsSpaceImpl<double>(group, variable, *obsdb_, *obsDistribution_);
+  return getVariableFromObsSpaceImpl<double>(group, variable, *obsdb_, *obsDistribution_,
+                                             cache_.get());
 }
 
 std::vector<std::string> ObsAccessor::getStringVariableFromObsSpace(
     const std::string &group, const std::string &variable) const {
-  return getVariableFromObsSpaceImpl<std::string>(group, variable, *obsdb_, *obsDistribution_);
+  return getVariableFromObsSpaceImpl<std::string>(group, variable, *obsdb_, *obsDistribution_,
+                                                  cache_.get());
 }
 
 std::vector<util::DateTime> ObsAccessor::getDateTimeVariableFromObsSpace(
       const std::string &group, const std::string &variable) const {
-  return getVariableFromObsSpaceImpl<util::DateTime>(group, variable, *obsdb_, *obsDistribution_);
+  return getVariableFromObsSpaceImpl<util::DateTime>(group, variable, *obsdb_, *obsDistribution_,
+                                                     cache_.get());
+}
+
+std::vector<int64_t> ObsAccessor::getEpochSecondsFromObsSpace(
+      const std::string &group, const std::string &variable) const {
+  if (cache_)
+    return cache_->getGlobalEpochSeconds(group, variable, *obsdb_, *obsDistribution_);
+  return ObsAccessorCache::toEpochSeconds(getDateTimeVariableFromObsSpace(group, variable));
+}
+
+int64_t ObsAccessor::toEpochSeconds(const util::DateTime &datetime) {
+  return ObsAccessorCache::toEpochSeconds(datetime);
+}
+
+std::vector<int> ObsAccessor::getStringVariableCodesFromObsSpace(
+    const std::string &group, const std::string &variable,
+    std::vector<std::string> &dictionary) const {
+  if (cache_) {
+    std::vector<int> codes = cache_->getGlobalStringCodes(group, variable, *obsdb_,
+                                                          *obsDistribution_);
+    dictionary = cache_->getGlobalStringDictionary(group, variable);
+    return codes;
+  }
+  // No MPI communication is necessary.
+  std::vector<std::string> values(obsdb_->nlocs());
+  obsdb_->get_db(group, variable, values);
+  dictionary = values;
+  std::sort(dictionary.begin(), dictionary.end());
+  dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+  std::vector<int> codes(values.size());
+  for (size_t loc = 0; loc < values.size(); ++loc)
+    codes[loc] = std::lower_bound(dictionary.begin(), dictionary.end(), values[loc]) -
+                 dictionary.begin();
+  return codes;
 }
 
 std::vector<size_t> ObsAccessor::getRecordIds() const {
+  if (cache_)
+    return cache_->getGlobalRecordIds(*obsdb_, *obsDistribution_);
   std::vector<size_t> recordIds = obsdb_->recnum();
   obsDistribution_->allGatherv(recordIds);
   return recordIds;
@@ -209,22 +268,27 @@ size_t ObsAccessor::totalNumObservations() const {
   return obsdb_->globalNumLocs();
 }
 
+bool ObsAccessor::areObservationsSharedByAllRanks() const {
+  return groupBy_ != GroupBy::RECORD_ID && groupBy_ != GroupBy::CURRENT_RANK;
+}
+
 RecursiveSplitter ObsAccessor::splitObservationsIntoIndependentGroups(
     const std::vector<size_t> &validObsIds, bool opsCompatibilityMode) const {
   RecursiveSplitter splitter(validObsIds.size(), opsCompatibilityMode);
   switch (groupBy_) {
   case GroupBy::NOTHING:
+  case GroupBy::CURRENT_RANK:
     // Nothing to do
     break;
   case GroupBy::RECORD_ID:
     groupObservationsByRecordNumber(validObsIds, splitter);
     break;
   case GroupBy::VARIABLE:
-    groupObservationsByCategoryVariable(validObsIds, splitter);
-    break;
   case GroupBy::SINGLE_OBS:
-    groupObservationsByCategoryVariable(validObsIds, splitter);
-    break;
+    // Observations are shared by all ranks, so the cache is available.
+    return cache_->splitByVariable(categoryVariable_->group(), categoryVariable_->variable(),
+                                   validObsIds, opsCompatibilityMode,
+                                   *obsdb_, *obsDistribution_);
   }
   return splitter;
 }
@@ -237,29 +301,19 @@ void ObsAccessor::groupObservationsByRecordNumber(const std::vector<size_t> &val
   splitter.groupBy(validObsCategories);
 }
 
-void ObsAccessor::groupObservationsByCategoryVariable(
-    const std::vector<size_t> &validObsIds,
-    RecursiveSplitter &splitter) const {
-  switch (obsdb_->dtype(categoryVariable_->group(), categoryVariable_->variable())) {
-  case ioda::ObsDtype::Integer:
-    groupObservationsByVariableImpl<int>(*categoryVariable_, validObsIds,
-                                         *obsdb_, *obsDistribution_, splitter);
-    break;
-
-  case ioda::ObsDtype::String:
-    groupObservationsByVariableImpl<std::string>(*categoryVariable_, validObsIds,
-                                                 *obsdb_, *obsDistribution_, splitter);
-    break;
-
-  default:
-    throw eckit::UserError(
-          categoryVariable_->variable() + "@" + categoryVariable_->group() +
-          " is neither an integer nor a string variable", Here());
-  }
+void ObsAccessor::flagRejectedObservations(
+    const std::vector<bool> &isRejected, std::vector<std::vector<bool> > &flagged) const {
+  flagRejectedObservationsImpl(isRejected, flagged);
 }
 
 void ObsAccessor::flagRejectedObservations(
-    const std::vector<bool> &isRejected, std::vector<std::vector<bool> > &flagged) const {
+    const std::vector<char> &isRejected, std::vector<std::vector<bool> > &flagged) const {
+  flagRejectedObservationsImpl(isRejected, flagged);
+}
+
+template <typename RejectionFlag>
+void ObsAccessor::flagRejectedObservationsImpl(
+    const std::vector<RejectionFlag> &isRejected, std::vector<std::vector<bool> > &flagged) const {
   const size_t localNumObs = obsdb_->nlocs();
   for (const std::vector<bool> & variableFlagged : flagged)
     ASSERT(variableFlagged.size() == localNumObs);
@@ -274,6 +328,35 @@ void ObsAccessor::flagRejectedObservations(
   }
 }
 
+void ObsAccessor::flagRejectedObservationIds(
+    std::vector<size_t> rejectedObsIds, std::vector<std::vector<bool> > &flagged) const {
+  const size_t localNumObs = obsdb_->nlocs();
+  for (const std::vector<bool> & variableFlagged : flagged)
+    ASSERT(variableFlagged.size() == localNumObs);
+  if (rejectedObsIds.empty())
+    return;
+
+  // Pairs (global index, local index) of the observations held on this rank, sorted by global
+  // index, so that both lists can be walked through in step.
+  std::vector<std::pair<size_t, size_t>> localObsIds(localNumObs);
+  for (size_t localObsId = 0; localObsId < localNumObs; ++localObsId)
+    localObsIds[localObsId] = std::make_pair(
+          obsDistribution_->globalUniqueConsecutiveLocationIndex(localObsId), localObsId);
+  std::sort(localObsIds.begin(), localObsIds.end());
+  std::sort(rejectedObsIds.begin(), rejectedObsIds.end());
+
+  auto rejectedIt = rejectedObsIds.begin();
+  for (const std::pair<size_t, size_t> &ids : localObsIds) {
+    rejectedIt = std::lower_bound(rejectedIt, rejectedObsIds.end(), ids.first);
+    if (rejectedIt == rejectedObsIds.end())
+      break;
+    if (*rejectedIt == ids.first) {
+      for (std::vector<bool> & variableFlagged : flagged)
+        variableFlagged[ids.second] = true;
+    }
+  }
+}
+
 void ObsAccessor::flagObservationsForAnyFilterVariableFailingQC(
     const std::vector<bool> &apply, const ioda::ObsDataVector<int> &flags,
     const ufo::Variables &filtervars, std::vector<std::vector<bool> > &flagged) const {
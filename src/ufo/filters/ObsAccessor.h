@@ -8,6 +8,7 @@
 #ifndef UFO_FILTERS_OBSACCESSOR_H_
 #define UFO_FILTERS_OBSACCESSOR_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -29,6 +30,7 @@ class DateTime;
 
 namespace ufo {
 
+class ObsAccessorCache;
 class Variables;
 class RecursiveSplitter;
 
@@ -56,6 +58,13 @@ class RecursiveSplitter;
 /// MPI rank (without any MPI communication); otherwise, these vectors will be constructed from
 /// data obtained from all MPI ranks.
 ///
+/// Variables and record IDs gathered from all MPI ranks are stored in an ObsAccessorCache shared by
+/// all accessors to the same ObsSpace, so that filters run one after another gather the same
+/// variables only once. The cache also holds the groups produced by
+/// splitObservationsIntoIndependentGroups() when observations are split by a variable; string
+/// variables are exchanged between ranks as integer codes (see
+/// ObsAccessorCache::getGlobalStringCodes()).
+///
 /// Call splitObservationsIntoIndependentGroups() to construct a RecursiveSplitter object whose
 /// groups() method will return groups of observations that can be processed independently from
 /// each other (according to the criterion specified when the ObsAccessor was constructed).
@@ -88,6 +97,12 @@ class ObsAccessor {
   static ObsAccessor toSingleObservationsSplitIntoIndependentGroupsByVariable(
       const ioda::ObsSpace &obsdb, const Variable &variable);
 
+  /// \brief Create an accessor to the observations held in \p obsdb on the current MPI rank only,
+  /// ignoring those held on other ranks.
+  ///
+  /// This is meant for filters exchanging data between ranks by themselves.
+  static ObsAccessor toObservationsHeldOnCurrentRank(const ioda::ObsSpace &obsdb);
+
 
   /// \brief Return the IDs of observation locations that should be treated as valid by a filter.
   ///
@@ -179,6 +194,20 @@ class ObsAccessor {
                                     const Variables & filtervars,
                                     bool retentionCandidateIfAnyFilterVariablePassedQC) const;
 
+  /// \brief Return the local IDs of valid observation locations in each profile held on the
+  /// current MPI rank, in the order of the profile indices returned by
+  /// \c ioda::ObsSpace::recidx_all_recnums().
+  ///
+  /// The parameters and the criterion used to determine whether a location is valid are the same
+  /// as in getValidObsIdsInProfile(). Calling this function is much cheaper than calling
+  /// getValidObsIdsInProfile() for each profile, since the QC flags of all locations are only
+  /// checked once.
+  std::vector<std::vector<size_t>> getValidObsIdsInProfiles(
+      const std::vector<bool> & apply,
+      const ioda::ObsDataVector<int> &flags,
+      const Variables & filtervars,
+      bool retentionCandidateIfAnyFilterVariablePassedQC) const;
+
   /// \brief Return a boolean vector indicating whether each location was selected by the
   /// \c where clause in the filter's configuration.
   /// If each independent group of observations is stored entirely on a single MPI rank
@@ -206,6 +235,32 @@ class ObsAccessor {
   std::vector<util::DateTime> getDateTimeVariableFromObsSpace(const std::string &group,
                                                               const std::string &variable) const;
 
+  /// \brief Return the values of the datetime variable \p group/\p variable at successive
+  /// observation locations, expressed as numbers of seconds since 1970-01-01T00:00:00Z.
+  ///
+  /// The returned vector covers the same locations as that returned by
+  /// getDateTimeVariableFromObsSpace(). Times in this form can be compared and subtracted with
+  /// plain integer arithmetic; when the datetimes are gathered from all ranks, they are
+  /// converted only once per ObsSpace.
+  std::vector<int64_t> getEpochSecondsFromObsSpace(const std::string &group,
+                                                   const std::string &variable) const;
+
+  /// \brief Return the number of seconds since 1970-01-01T00:00:00Z at \p datetime, i.e. the
+  /// representation of times used by getEpochSecondsFromObsSpace().
+  static int64_t toEpochSeconds(const util::DateTime &datetime);
+
+  /// \brief Return integer codes of the values of the string variable \p group/\p variable at
+  /// successive observation locations.
+  ///
+  /// On output, \p dictionary holds the sorted list of distinct values and the code of each
+  /// location is the position of its value in that list. The codes cover the same locations as
+  /// the vector returned by getStringVariableFromObsSpace(), but the strings of individual
+  /// locations are never exchanged between MPI ranks, and the codes can be grouped and compared
+  /// much faster than the strings.
+  std::vector<int> getStringVariableCodesFromObsSpace(const std::string &group,
+                                                      const std::string &variable,
+                                                      std::vector<std::string> &dictionary) const;
+
   /// \brief Return the vector of IDs of records successive observation locations belong to.
   ///
   /// If each independent group of observations is stored entirely on a single MPI rank, the
@@ -218,6 +273,11 @@ class ObsAccessor {
   /// of observation locations held on all ranks.
   size_t totalNumObservations() const;
 
+  /// Return true if the vectors returned by methods such as getValidObservationIds() and
+  /// getFloatVariableFromObsSpace() are the same on all MPI ranks, i.e. if they are constructed
+  /// from data obtained from all ranks (or if each rank holds all observations).
+  bool areObservationsSharedByAllRanks() const;
+
   /// Construct a RecursiveSplitter object whose groups() method will return groups of observations
   /// that can be processed independently from each other (according to the criterion specified when
   /// the ObsAccessor was constructed).
@@ -241,6 +301,30 @@ class ObsAccessor {
   ///   isRejected corresponding to jth observation location on the current rank is true.
   void flagRejectedObservations(const std::vector<bool> &isRejected,
                                 std::vector<std::vector<bool> > &flagged) const;
+  /// \overload
+  ///
+  /// Filters that record rejections in a vector of chars (so that threads can update distinct
+  /// elements concurrently) can pass it directly instead of converting it to a vector of bools.
+  void flagRejectedObservations(const std::vector<char> &isRejected,
+                                std::vector<std::vector<bool> > &flagged) const;
+
+  /// \brief Update flags of observations held on the current MPI rank.
+  ///
+  /// This is an alternative to flagRejectedObservations() for filters rejecting few of the
+  /// observations held on all MPI ranks: it takes the list of their indices rather than a vector
+  /// with an element per observation, and costs time proportional to the number of rejected
+  /// observations and of observations held on the current rank.
+  ///
+  /// \param rejectedObsIds
+  ///   Indices (in the range [0, totalNumObservations())) of the observations to reject, in any
+  ///   order. Duplicates are allowed.
+  ///
+  /// \param[inout] flagged
+  ///   A vector of vectors, each with as many elements as there are observation locations on the
+  ///   current MPI rank. On output, flagged[i][j] will be set to true for each i if the index of
+  ///   the jth observation location on the current rank is in \p rejectedObsIds.
+  void flagRejectedObservationIds(std::vector<size_t> rejectedObsIds,
+                                  std::vector<std::vector<bool> > &flagged) const;
 
   /// \brief Flags observations selected by a where clause and for which at least one filter
   /// filter variable has failed QC.
@@ -273,13 +357,15 @@ class ObsAccessor {
   /// SINGLE_OBS: records are treated as single obs, in which case the category variable
   /// may or may not have been used. If it was used, the behaviour is the same regardless of whether
   /// the category variable was used to divide the ObsSpace into records.
-  enum class GroupBy { NOTHING, RECORD_ID, VARIABLE, SINGLE_OBS };
+  /// CURRENT_RANK: no category variable used; only observations held on the current rank are
+  /// accessed.
+  enum class GroupBy { NOTHING, RECORD_ID, VARIABLE, SINGLE_OBS, CURRENT_RANK };
 
   /// Private constructor. Construct instances of this class by calling toAllObservations(),
   /// toObservationsSplitIntoIndependentGroupsByRecordId(),
-  /// toObservationsSplitIntoIndependentGroupsByVariable() or
-  /// toSingleObservationsSplitIntoIndependentGroupsByVariable()
-  /// instead.
+  /// toObservationsSplitIntoIndependentGroupsByVariable(),
+  /// toSingleObservationsSplitIntoIndependentGroupsByVariable() or
+  /// toObservationsHeldOnCurrentRank() instead.
   ObsAccessor(const ioda::ObsSpace &obsdb,
               GroupBy groupBy,
               boost::optional<Variable> categoryVariable);
@@ -289,8 +375,9 @@ class ObsAccessor {
   void groupObservationsByRecordNumber(const std::vector<size_t> &validObsIds,
                                        RecursiveSplitter &splitter) const;
 
-  void groupObservationsByCategoryVariable(const std::vector<size_t> &validObsIds,
-                                           RecursiveSplitter &splitter) const;
+  template <typename RejectionFlag>
+  void flagRejectedObservationsImpl(const std::vector<RejectionFlag> &isRejected,
+                                    std::vector<std::vector<bool> > &flagged) const;
 
  private:
   const ioda::ObsSpace *obsdb_;
@@ -298,6 +385,9 @@ class ObsAccessor {
 
   GroupBy groupBy_;
   boost::optional<Variable> categoryVariable_;
+  /// Values gathered from all ranks, shared by all accessors to the same ObsSpace. Null if
+  /// no MPI communication is necessary.
+  std::shared_ptr<ObsAccessorCache> cache_;
 };
 
 }  // namespace ufo
@@ -0,0 +1,246 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/ObsAccessorCache.h"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/mpi/Comm.h"
+#include "ioda/distribution/Distribution.h"
+#include "ioda/ObsSpace.h"
+#include "oops/mpi/mpi.h"
+#include "oops/util/Logger.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<ObsAccessorCache> ObsAccessorCache::forObsSpace(const ioda::ObsSpace &obsdb) {
+  static std::mutex mutex;
+  static std::map<const ioda::ObsSpace *, std::weak_ptr<ObsAccessorCache>> caches;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  // Forget caches belonging to ObsSpaces that no longer have any processors.
+  for (auto it = caches.begin(); it != caches.end(); ) {
+    if (it->second.expired())
+      it = caches.erase(it);
+    else
+      ++it;
+  }
+
+  std::weak_ptr<ObsAccessorCache> &weakCache = caches[&obsdb];
+  std::shared_ptr<ObsAccessorCache> cache = weakCache.lock();
+  if (!cache) {
+    cache = std::make_shared<ObsAccessorCache>();
+    weakCache = cache;
+  }
+  return cache;
+}
+
+// -----------------------------------------------------------------------------
+
+template <> std::map<std::string, ObsAccessorCache::Column<int>> &
+ObsAccessorCache::columns<int>() {return intColumns_;}
+template <> std::map<std::string, ObsAccessorCache::Column<float>> &
+ObsAccessorCache::columns<float>() {return floatColumns_;}
+template <> std::map<std::string, ObsAccessorCache::Column<double>> &
+ObsAccessorCache::columns<double>() {return doubleColumns_;}
+template <> std::map<std::string, ObsAccessorCache::Column<std::string>> &
+ObsAccessorCache::columns<std::string>() {return stringColumns_;}
+template <> std::map<std::string, ObsAccessorCache::Column<util::DateTime>> &
+ObsAccessorCache::columns<util::DateTime>() {return dateTimeColumns_;}
+template <> std::map<std::string, ObsAccessorCache::Column<size_t>> &
+ObsAccessorCache::columns<size_t>() {return sizeTColumns_;}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+const std::vector<T> &ObsAccessorCache::gather(const std::string &key,
+                                               std::vector<T> localValues,
+                                               const ioda::ObsSpace &obsdb,
+                                               const ioda::Distribution &distribution) {
+  auto it = columns<T>().find(key);
+  // All ranks must agree on whether to gather again, since allGatherv is a collective operation.
+  int stale = (it == columns<T>().end() || it->second.localValues != localValues);
+  obsdb.comm().allReduceInPlace(stale, eckit::mpi::max());
+  if (!stale) {
+    ++hits_;
+    return it->second.globalValues;
+  }
+
+  ++misses_;
+  Column<T> &column = columns<T>()[key];
+  column.globalValues = localValues;
+  distribution.allGatherv(column.globalValues);
+  column.localValues = std::move(localValues);
+  ++column.generation;
+  oops::Log::trace() << "ObsAccessorCache: gathered " << key << std::endl;
+  return column.globalValues;
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+const std::vector<T> &ObsAccessorCache::getGlobalVariable(const std::string &group,
+                                                          const std::string &variable,
+                                                          const ioda::ObsSpace &obsdb,
+                                                          const ioda::Distribution &distribution) {
+  std::vector<T> localValues(obsdb.nlocs());
+  obsdb.get_db(group, variable, localValues);
+  return gather(variable + "@" + group, std::move(localValues), obsdb, distribution);
+}
+
+// -----------------------------------------------------------------------------
+
+const std::vector<int64_t> &ObsAccessorCache::getGlobalEpochSeconds(
+    const std::string &group, const std::string &variable,
+    const ioda::ObsSpace &obsdb, const ioda::Distribution &distribution) {
+  const std::string key = variable + "@" + group;
+  const std::vector<util::DateTime> &datetimes =
+      getGlobalVariable<util::DateTime>(group, variable, obsdb, distribution);
+  const size_t generation = dateTimeColumns_.at(key).generation;
+
+  // All ranks see the same generation of the datetime column, so no reduction is needed here.
+  EpochSecondsColumn &column = epochSecondsColumns_[key];
+  if (column.generation != generation) {
+    column.values = toEpochSeconds(datetimes);
+    column.generation = generation;
+  }
+  return column.values;
+}
+
+// -----------------------------------------------------------------------------
+
+int64_t ObsAccessorCache::toEpochSeconds(const util::DateTime &datetime) {
+  return (datetime - util::DateTime(1970, 1, 1, 0, 0, 0)).toSeconds();
+}
+
+// -----------------------------------------------------------------------------
+
+std::vector<int64_t> ObsAccessorCache::toEpochSeconds(
+    const std::vector<util::DateTime> &datetimes) {
+  std::vector<int64_t> seconds(datetimes.size());
+  for (size_t i = 0; i < datetimes.size(); ++i)
+    seconds[i] = toEpochSeconds(datetimes[i]);
+  return seconds;
+}
+
+// -----------------------------------------------------------------------------
+
+const std::vector<size_t> &ObsAccessorCache::getGlobalRecordIds(
+    const ioda::ObsSpace &obsdb, const ioda::Distribution &distribution) {
+  return gather("record numbers", obsdb.recnum(), obsdb, distribution);
+}
+
+// -----------------------------------------------------------------------------
+
+const std::vector<int> &ObsAccessorCache::getGlobalStringCodes(
+    const std::string &group, const std::string &variable,
+    const ioda::ObsSpace &obsdb, const ioda::Distribution &distribution) {
+  const std::string key = variable + "@" + group;
+  std::vector<std::string> localValues(obsdb.nlocs());
+  obsdb.get_db(group, variable, localValues);
+
+  auto it = stringCodeColumns_.find(key);
+  int stale = (it == stringCodeColumns_.end() || it->second.localValues != localValues);
+  obsdb.comm().allReduceInPlace(stale, eckit::mpi::max());
+  if (!stale) {
+    ++hits_;
+    return it->second.globalCodes;
+  }
+
+  ++misses_;
+  // Build the sorted list of distinct values held on all ranks.
+  std::vector<std::string> dictionary = localValues;
+  std::sort(dictionary.begin(), dictionary.end());
+  dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+  oops::mpi::allGatherv(obsdb.comm(), dictionary);
+  std::sort(dictionary.begin(), dictionary.end());
+  dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+
+  StringCodeColumn &column = stringCodeColumns_[key];
+  column.globalCodes.resize(localValues.size());
+  for (size_t loc = 0; loc < localValues.size(); ++loc)
+    column.globalCodes[loc] = std::lower_bound(dictionary.begin(), dictionary.end(),
+                                               localValues[loc]) - dictionary.begin();
+  distribution.allGatherv(column.globalCodes);
+  column.localValues = std::move(localValues);
+  column.dictionary = std::move(dictionary);
+  ++column.generation;
+  oops::Log::trace() << "ObsAccessorCache: gathered codes of " << key << std::endl;
+  return column.globalCodes;
+}
+
+// -----------------------------------------------------------------------------
+
+const std::vector<std::string> &ObsAccessorCache::getGlobalStringDictionary(
+    const std::string &group, const std::string &variable) const {
+  return stringCodeColumns_.at(variable + "@" + group).dictionary;
+}
+
+// -----------------------------------------------------------------------------
+
+RecursiveSplitter ObsAccessorCache::splitByVariable(const std::string &group,
+                                                    const std::string &variable,
+                                                    const std::vector<size_t> &validObsIds,
+                                                    bool opsCompatibilityMode,
+                                                    const ioda::ObsSpace &obsdb,
+                                                    const ioda::Distribution &distribution) {
+  const std::string key = variable + "@" + group;
+  const std::vector<int> *categories = nullptr;
+  size_t generation = 0;
+  switch (obsdb.dtype(group, variable)) {
+  case ioda::ObsDtype::Integer:
+    categories = &getGlobalVariable<int>(group, variable, obsdb, distribution);
+    generation = intColumns_.at(key).generation;
+    break;
+
+  case ioda::ObsDtype::String:
+    categories = &getGlobalStringCodes(group, variable, obsdb, distribution);
+    generation = stringCodeColumns_.at(key).generation;
+    break;
+
+  default:
+    throw eckit::UserError(
+          key + " is neither an integer nor a string variable", Here());
+  }
+
+  // The IDs of valid observations are the same on all ranks, so no reduction is needed here.
+  Split &split = splits_[std::make_pair(key, opsCompatibilityMode)];
+  if (split.splitter && split.generation == generation && split.validObsIds == validObsIds)
+    return *split.splitter;
+
+  std::vector<int> validObsCategories(validObsIds.size());
+  for (size_t validObsIndex = 0; validObsIndex < validObsIds.size(); ++validObsIndex)
+    validObsCategories[validObsIndex] = (*categories)[validObsIds[validObsIndex]];
+  split.splitter = std::make_unique<RecursiveSplitter>(validObsIds.size(), opsCompatibilityMode);
+  split.splitter->groupBy(validObsCategories);
+  split.generation = generation;
+  split.validObsIds = validObsIds;
+  return *split.splitter;
+}
+
+// -----------------------------------------------------------------------------
+
+template const std::vector<int> &ObsAccessorCache::getGlobalVariable<int>(
+    const std::string &, const std::string &, const ioda::ObsSpace &, const ioda::Distribution &);
+template const std::vector<float> &ObsAccessorCache::getGlobalVariable<float>(
+    const std::string &, const std::string &, const ioda::ObsSpace &, const ioda::Distribution &);
+template const std::vector<double> &ObsAccessorCache::getGlobalVariable<double>(
+    const std::string &, const std::string &, const ioda::ObsSpace &, const ioda::Distribution &);
+template const std::vector<std::string> &ObsAccessorCache::getGlobalVariable<std::string>(
+    const std::string &, const std::string &, const ioda::ObsSpace &, const ioda::Distribution &);
+template const std::vector<util::DateTime> &
+ObsAccessorCache::getGlobalVariable<util::DateTime>(
+    const std::string &, const std::string &, const ioda::ObsSpace &, const ioda::Distribution &);
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,178 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_OBSACCESSORCACHE_H_
+#define UFO_FILTERS_OBSACCESSORCACHE_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "oops/util/DateTime.h"
+#include "ufo/utils/RecursiveSplitter.h"
+
+namespace ioda {
+class Distribution;
+class ObsSpace;
+}
+
+namespace ufo {
+
+/// \brief Values of ObsSpace variables gathered from all MPI ranks by ObsAccessor.
+///
+/// \details A single instance of this class is shared by all ObsAccessors created for the same
+/// ObsSpace (see forObsSpace()), so that filters such as the track checks and thinning filters
+/// gather metadata such as latitudes, longitudes, datetimes and station IDs from all ranks only
+/// once rather than each time they are run.
+///
+/// The local values from which each column was gathered are stored alongside the gathered values.
+/// Each request compares them with the current local values and uses a single reduction over all
+/// ranks to decide whether any rank's values have changed; only then are the values gathered
+/// again. The results are therefore the same as if the values were gathered every time.
+///
+/// The cache is kept alive by the observation processors acting on the ObsSpace (see
+/// ObsProcessorBase) and destroyed once none is left.
+class ObsAccessorCache : private boost::noncopyable {
+ public:
+  /// \brief Return the cache shared by all ObsAccessors gathering data from \p obsdb, creating it
+  /// if necessary.
+  static std::shared_ptr<ObsAccessorCache> forObsSpace(const ioda::ObsSpace &obsdb);
+
+  /// \brief Return the values of the variable \p group/\p variable held on all MPI ranks,
+  /// gathered with \p distribution (the distribution of \p obsdb).
+  template <typename T>
+  const std::vector<T> &getGlobalVariable(const std::string &group, const std::string &variable,
+                                          const ioda::ObsSpace &obsdb,
+                                          const ioda::Distribution &distribution);
+
+  /// \brief Return the values of the datetime variable \p group/\p variable held on all MPI
+  /// ranks, expressed as numbers of seconds since 1970-01-01T00:00:00Z.
+  ///
+  /// \details The conversion is done once for each set of gathered datetimes, so filters can
+  /// compare and subtract times with integer arithmetic rather than util::DateTime and
+  /// util::Duration operations.
+  const std::vector<int64_t> &getGlobalEpochSeconds(const std::string &group,
+                                                    const std::string &variable,
+                                                    const ioda::ObsSpace &obsdb,
+                                                    const ioda::Distribution &distribution);
+
+  /// \brief Convert \p datetime to the number of seconds since 1970-01-01T00:00:00Z.
+  static int64_t toEpochSeconds(const util::DateTime &datetime);
+
+  /// \brief Convert \p datetimes to numbers of seconds since 1970-01-01T00:00:00Z.
+  static std::vector<int64_t> toEpochSeconds(const std::vector<util::DateTime> &datetimes);
+
+  /// \brief Return the record numbers of the locations held on all MPI ranks.
+  const std::vector<size_t> &getGlobalRecordIds(const ioda::ObsSpace &obsdb,
+                                                const ioda::Distribution &distribution);
+
+  /// \brief Return integer codes of the values of the string variable \p group/\p variable held
+  /// on all MPI ranks.
+  ///
+  /// \details The code of each value is its position in the sorted list of distinct values held
+  /// on all ranks, so codes compare in the same way as the strings they stand for. Only the
+  /// distinct values held on each rank and the codes of individual locations are exchanged
+  /// between ranks, which is much cheaper than gathering the strings of all locations when (as is
+  /// the case for station IDs) each value is shared by many locations.
+  const std::vector<int> &getGlobalStringCodes(const std::string &group,
+                                               const std::string &variable,
+                                               const ioda::ObsSpace &obsdb,
+                                               const ioda::Distribution &distribution);
+
+  /// \brief Return the sorted list of distinct values of the string variable \p group/\p variable
+  /// held on all MPI ranks, i.e. the values whose positions are the codes last returned by
+  /// getGlobalStringCodes() for this variable.
+  const std::vector<std::string> &getGlobalStringDictionary(const std::string &group,
+                                                            const std::string &variable) const;
+
+  /// \brief Return a RecursiveSplitter grouping the observations with global IDs \p validObsIds
+  /// by the values of the integer or string variable \p group/\p variable.
+  ///
+  /// \details The groups (and the order of observations in each group) are the same as if the
+  /// values of the variable were gathered from all ranks and passed to
+  /// RecursiveSplitter::groupBy(). String values are replaced by the codes returned by
+  /// getGlobalStringCodes(). The splitter is reused as long as neither the variable nor
+  /// \p validObsIds change, so that filters applied one after another to the same observations
+  /// split them only once.
+  RecursiveSplitter splitByVariable(const std::string &group, const std::string &variable,
+                                    const std::vector<size_t> &validObsIds,
+                                    bool opsCompatibilityMode,
+                                    const ioda::ObsSpace &obsdb,
+                                    const ioda::Distribution &distribution);
+
+  /// Number of requests served without gathering the values again.
+  size_t hits() const {return hits_;}
+  /// Number of requests for which the values had to be gathered.
+  size_t misses() const {return misses_;}
+
+ private:
+  template <typename T>
+  struct Column {
+    /// Values held on the current rank when the column was last gathered.
+    std::vector<T> localValues;
+    /// Values held on all ranks.
+    std::vector<T> globalValues;
+    /// Incremented each time the values are gathered.
+    size_t generation = 0;
+  };
+
+  /// Codes of the values of a string variable (see getGlobalStringCodes()).
+  struct StringCodeColumn {
+    /// Values held on the current rank when the codes were last gathered.
+    std::vector<std::string> localValues;
+    /// Codes of the values held on all ranks.
+    std::vector<int> globalCodes;
+    /// Sorted distinct values held on all ranks.
+    std::vector<std::string> dictionary;
+    size_t generation = 0;
+  };
+
+  /// Datetimes converted to epoch seconds (see getGlobalEpochSeconds()).
+  struct EpochSecondsColumn {
+    /// Generation of the datetime column from which the values were converted.
+    size_t generation = 0;
+    std::vector<int64_t> values;
+  };
+
+  /// A splitter returned by splitByVariable().
+  struct Split {
+    /// Generation of the column from which the splitter was constructed.
+    size_t generation = 0;
+    std::vector<size_t> validObsIds;
+    std::unique_ptr<RecursiveSplitter> splitter;
+  };
+
+  template <typename T>
+  std::map<std::string, Column<T>> &columns();
+
+  template <typename T>
+  const std::vector<T> &gather(const std::string &key, std::vector<T> localValues,
+                               const ioda::ObsSpace &obsdb,
+                               const ioda::Distribution &distribution);
+
+  std::map<std::string, Column<int>> intColumns_;
+  std::map<std::string, Column<float>> floatColumns_;
+  std::map<std::string, Column<double>> doubleColumns_;
+  std::map<std::string, Column<std::string>> stringColumns_;
+  std::map<std::string, Column<util::DateTime>> dateTimeColumns_;
+  std::map<std::string, Column<size_t>> sizeTColumns_;
+  std::map<std::string, StringCodeColumn> stringCodeColumns_;
+  std::map<std::string, EpochSecondsColumn> epochSecondsColumns_;
+  /// Splitters indexed by the variable name and the OPS compatibility mode.
+  std::map<std::pair<std::string, bool>, Split> splits_;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_OBSACCESSORCACHE_H_
@@ -8,6 +8,7 @@
 #include "ufo/filters/ObsBoundsCheck.h"
 
 #include <algorithm>
+#include <limits>
 #include <set>
 #include <vector>
 
@@ -28,32 +29,37 @@ namespace {
 
 // -----------------------------------------------------------------------------
 
-/// Set each element of \p flagged to true if the corresponding element of \p apply is true
+/// Set each element of \p outOfBounds to 1 if the corresponding element of \p apply is nonzero
 /// and the corresponding element of \p testValues is a non-missing value lying outside the
-/// closed interval [\p minValue, \p maxValue].
-void flagWhereOutOfBounds(const std::vector<bool> & apply,
+/// closed interval [\p minValue, \p maxValue] (or is missing and \p treatMissingAsOutOfBounds is
+/// true). Other elements of \p outOfBounds are left unchanged.
+///
+/// Masks are stored as chars rather than bools and missing bounds are replaced by infinities,
+/// so that the loop is branch-free and can be vectorised.
+void flagWhereOutOfBounds(const std::vector<char> & apply,
                           const std::vector<float> & testValues,
                           const float minValue,
                           const float maxValue,
                           const bool treatMissingAsOutOfBounds,
-                          std::vector<bool> &flagged) {
+                          std::vector<char> &outOfBounds) {
   const size_t nlocs = testValues.size();
   ASSERT(apply.size() == nlocs);
-  ASSERT(flagged.size() == nlocs);
+  ASSERT(outOfBounds.size() == nlocs);
 
   const float missing = util::missingValue(missing);
+  const float lower = minValue != missing ? minValue : -std::numeric_limits<float>::infinity();
+  const float upper = maxValue != missing ? maxValue : std::numeric_limits<float>::infinity();
+  const char missingOutOfBounds = treatMissingAsOutOfBounds;
+
+  const char *applyData = apply.data();
+  const float *values = testValues.data();
+  char *outOfBoundsData = outOfBounds.data();
+#pragma omp simd
   for (size_t i = 0; i < nlocs; ++i) {
-    if (apply[i]) {
-      if (testValues[i] != missing) {
-        if (minValue != missing && testValues[i] < minValue)
-          flagged[i] = true;
-        if (maxValue != missing && testValues[i] > maxValue)
-          flagged[i] = true;
-      } else {
-        if (treatMissingAsOutOfBounds)
-          flagged[i] = true;
-      }
-    }
+    const float value = values[i];
+    const char out = value == missing ? missingOutOfBounds :
+                                        static_cast<char>((value < lower) | (value > upper));
+    outOfBoundsData[i] |= applyData[i] & out;
   }
 }
 
@@ -125,25 +131,28 @@ void ObsBoundsCheck::applyFilter(const std::vector<bool> & apply,
     // expanding out the channels and therefore it matches the testvars list
     const oops::Variables filtervarslist = filtervars.toOopsVariables();
     // Loop over all channels of all test variables and record all locations where any of these
-    // channels is out of bounds.
-    std::vector<bool> anyTestVarOutOfBounds(obsdb_.nlocs(), false);
+    // channels is out of bounds. Each multi-channel test variable is retrieved in one go.
+    const std::vector<char> applyMask(apply.begin(), apply.end());
+    std::vector<char> testAtLocations;
+    std::vector<char> anyTestVarOutOfBounds(obsdb_.nlocs(), 0);
     size_t ifiltervar = 0;
     for (PrimitiveVariable singleChannelTestVar : PrimitiveVariables(testvars, data_)) {
-      std::vector<bool> testAtLocations = apply;
+      const std::vector<char> *testMask = &applyMask;
       if (onlyTestGoodFilterVarsForFlagAllFilterVars) {
-        for (size_t iloc=0; iloc < testAtLocations.size(); iloc++)
-          if ((*flags_)[filtervarslist[ifiltervar]][iloc] != QCflags::pass) {
-            testAtLocations[iloc] = false;
-          }
+        const std::vector<int> &filterVarFlags = (*flags_)[filtervarslist[ifiltervar]];
+        testAtLocations.resize(applyMask.size());
+        for (size_t iloc = 0; iloc < testAtLocations.size(); iloc++)
+          testAtLocations[iloc] = applyMask[iloc] & (filterVarFlags[iloc] == QCflags::pass);
+        testMask = &testAtLocations;
       }
       const std::vector<float> & testValues = singleChannelTestVar.values();
-      flagWhereOutOfBounds(testAtLocations, testValues, vmin, vmax, treatMissingAsOutOfBounds,
+      flagWhereOutOfBounds(*testMask, testValues, vmin, vmax, treatMissingAsOutOfBounds,
                            anyTestVarOutOfBounds);
       ifiltervar++;
     }
     // Copy these flags to the flags of all filtered variables.
     for (std::vector<bool> &f : flagged)
-      f = anyTestVarOutOfBounds;
+      f.assign(anyTestVarOutOfBounds.begin(), anyTestVarOutOfBounds.end());
   } else {
     if (filtervars.nvars() != testvars.nvars())
       throw eckit::UserError("The number of 'primitive' (single-channel) test variables must match "
@@ -152,11 +161,18 @@ void ObsBoundsCheck::applyFilter(const std::vector<bool> & apply,
     // Loop over all channels of all test variables and for each locations where that channel is out
     // of bounds, flag the corresponding filter variable channel.
     ASSERT(filtervars.nvars() == flagged.size());
+    const std::vector<char> applyMask(apply.begin(), apply.end());
+    std::vector<char> outOfBounds;
     size_t ifiltervar = 0;
     for (PrimitiveVariable singleChannelTestVar : PrimitiveVariables(testvars, data_)) {
       const std::vector<float> & testValues = singleChannelTestVar.values();
-      flagWhereOutOfBounds(apply, testValues, vmin, vmax, treatMissingAsOutOfBounds,
-                           flagged[ifiltervar++]);
+      outOfBounds.assign(testValues.size(), 0);
+      flagWhereOutOfBounds(applyMask, testValues, vmin, vmax, treatMissingAsOutOfBounds,
+                           outOfBounds);
+      std::vector<bool> &f = flagged[ifiltervar++];
+      for (size_t iloc = 0; iloc < f.size(); ++iloc)
+        if (outOfBounds[iloc])
+          f[iloc] = true;
     }
   }
 }
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -42,63 +43,70 @@ ObsDerivativeCheck::~ObsDerivativeCheck() {}
 
 // -----------------------------------------------------------------------------
 
-void get_locs(const std::vector<std::size_t> & rSort, const size_t & i1, const size_t & i2,
-              const size_t & ilocs, size_t & ii1, size_t & ii2)
-// rSort - the vector of integers of indices of the sorted ObsDataVector
-//         used to get the size of the sorted record
-// i1 and i2 are by default 0 but can be defined in YAML to assign fixed indices
-//         for the derivative computed for each point in the record
-//         if i1 and i2 are both zero then a local derivative will be computed and indices
-//         will be computed by this function
-// ii1 and ii2 are the output indices from the function to use in computation of derivatives
-//         ii1=i1 and ii2=i2 for when i1 and i2 != 0
-//         ii1 and ii2 are computed below for all other cases
-{
-  if ( rSort.size() == 1 ) {
-    // set both ii1 and ii2 to 0 which will be used to indicate derivative is zero
-    ii1 = 0;
-    ii2 = 0;
-  } else if ( rSort.size() == 2 ) {
-    // set ii1 to 0 and ii2 to 1 because there are only 2 points in this group
-    ii1 = 0;
-    ii2 = 1;
-  } else {
-    if ( (i1 == 0) && (i2 == 0) ) {
-      // this means local derivatives will be computed for each point
-      if ( ilocs == 0 ) {
-        // special case for boundary condition 1
-        ii1 = 0;
-        ii2 = 1;
-      } else if ( ilocs == rSort.size()-1 ) {
-        // special case for boundary condition 2
-        ii1 = ilocs-1;
-        ii2 = ilocs;
-      } else {
-        // define local derivative normally as
-        // (y(i+1) - y(i-1)) / (x(i+1) - x(i-1))
-        ii1 = ilocs-1;
-        ii2 = ilocs+1;
-      }
-    } else {
-      // compute derivative for each point to be from indices provided in YAML
-      // note this may need to be more complex later to compute the indices desired
-      // set index to the last value if -1 defined in YAML
-      (i1 == -1) ? ii1 = rSort.size()-1 : ii1 = i1;
-      (i2 == -1) ? ii2 = rSort.size()-1 : ii2 = i2;
-      // set index to the last value if YAML greater than indices
-      (i1 > rSort.size()-1) ? ii1 = rSort.size()-1 : ii1 = i1;
-      (i2 > rSort.size()-1) ? ii2 = rSort.size()-1 : ii2 = i2;
-    }
+namespace {
+
+/// \brief Compute the derivatives at all points of a record sorted by the record ordering.
+///
+/// \param n the number of points in the record.
+/// \param i1, i2 indices (within the record) of the two points used to compute the derivative
+///   at all points. If both are 0, local derivatives are computed instead: centred differences
+///   at interior points and one-sided differences at the two ends of the record.
+/// \param dy, dx functors returning the differences of the dependent and independent variables
+///   between the points with indices given as the first and second argument.
+/// \param[out] dydx the derivative at each point of the record.
+///
+/// The derivative is zero at all points of records with one point and in records whose
+/// derivatives are computed between a point and itself.
+template <typename DeltaY, typename DeltaX>
+void recordDerivatives(size_t n, size_t i1, size_t i2, const DeltaY &dy, const DeltaX &dx,
+                       float *dydx) {
+  if (n == 1) {
+    dydx[0] = 0.0f;
+    return;
   }
+  if (n == 2 || i1 != 0 || i2 != 0) {
+    // the same derivative at all points of the record
+    const size_t j1 = n == 2 ? 0 : std::min(i1, n - 1);
+    const size_t j2 = n == 2 ? 1 : std::min(i2, n - 1);
+    const float value = j1 == j2 ? 0.0f : dy(j1, j2) / dx(j1, j2);
+    std::fill(dydx, dydx + n, value);
+    return;
+  }
+  dydx[0] = dy(0, 1) / dx(0, 1);
+  for (size_t i = 1; i < n - 1; ++i)
+    dydx[i] = dy(i - 1, i + 1) / dx(i - 1, i + 1);
+  dydx[n - 1] = dy(n - 2, n - 1) / dx(n - 2, n - 1);
+}
+
+/// Return the great circle distance (in m) between the points with longitudes \p lon1 and
+/// \p lon2 and latitudes \p lat1 and \p lat2.
+float greatCircleDistance(float lon1, float lat1, float lon2, float lat2) {
+  const double radiusEarth = Constants::mean_earth_rad*1000.0;
+  return static_cast<float>(eckit::geometry::Sphere::distance(
+                              radiusEarth, eckit::geometry::Point2(lon2, lat2),
+                              eckit::geometry::Point2(lon1, lat1)));
 }
 
+/// Copy the elements of \p values with indices \p indices to \p out (unless \p values is empty,
+/// i.e. the variable is not used).
+template <typename T>
+void gather(const std::vector<T> &values, const std::vector<size_t> &indices,
+            std::vector<T> &out) {
+  if (values.empty())
+    return;
+  out.resize(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i)
+    out[i] = values[indices[i]];
+}
+
+}  // namespace
+
 // -----------------------------------------------------------------------------
 
 void ObsDerivativeCheck::applyFilter(const std::vector<bool> & apply,
                                  const Variables & filtervars,
                                  std::vector<std::vector<bool>> & flagged) const {
   const float missing = util::missingValue(missing);
-  const double radiusEarth = Constants::mean_earth_rad*1000.0;
 
   // first we want to get the config of the two vars to use in computing the derivative
   const std::string strInd_ = parameters_.independent;
@@ -106,8 +114,6 @@ void ObsDerivativeCheck::applyFilter(const std::vector<bool> & apply,
   // specified indices to use if not local derivatives
   const size_t i1 = parameters_.i1;
   const size_t i2 = parameters_.i2;
-  size_t ii1 = 0;  // indices that will be used to compute derivativs
-  size_t ii2 = 0;
   // min/max value setup
   const float minddx = parameters_.minvalue;
   const float maxddx = parameters_.maxvalue;
@@ -130,100 +136,73 @@ void ObsDerivativeCheck::applyFilter(const std::vector<bool> & apply,
   // when x is distance:
   //       longitude and latitude are used to compute great circle distances
   //       for denominator
-  if ( strInd_ == "dateTime" ) {  // special case for datetime
-      std::vector<util::DateTime> varIndT_(nlocs_);
-      obsdb_.get_db("MetaData", strInd_, varIndT_);
-      ioda::ObsSpace::RecIdxIter irec;
-      if ( strDep_ == "distance" ) {  // special case for moving obs
-        ioda::ObsDataVector<float> varDepX_(obsdb_, "longitude", "MetaData");
-        ioda::ObsDataVector<float> varDepY_(obsdb_, "latitude", "MetaData");
-        for ( irec = obsdb_.recidx_begin(); irec != obsdb_.recidx_end(); ++irec ) {
-          std:: size_t rNum = obsdb_.recidx_recnum(irec);
-          std::vector<std::size_t> rSort = obsdb_.recidx_vector(irec);
-          for (size_t ilocs = 0; ilocs < rSort.size(); ++ilocs) {
-            get_locs(rSort, i1, i2, ilocs, ii1, ii2);
-            if ( ii1 == ii2 ) {
-              // no derivative if the indices are the same
-              dydx[rSort[ilocs]] = 0.0;
-            } else {
-              // compute distance for each lat lon pair
-              eckit::geometry::Point2 Ob1(varDepX_["longitude"][rSort[ii2]],
-                                          varDepY_["latitude"][rSort[ii2]]);
-              eckit::geometry::Point2 Ob2(varDepX_["longitude"][rSort[ii1]],
-                                          varDepY_["latitude"][rSort[ii1]]);
-              float dist_m = static_cast<float>(eckit::geometry::Sphere::distance(radiusEarth,
-                                                                                 Ob1, Ob2));
-              // compute derivative
-              dydx[rSort[ilocs]] = dist_m /
-                                   (varIndT_[rSort[ii2]] - varIndT_[rSort[ii1]]).toSeconds();
-            }
-          }
-        }
-      } else {
-        ioda::ObsDataVector<float> varDep_(obsdb_, strDep_, "MetaData");
-        for ( irec = obsdb_.recidx_begin(); irec != obsdb_.recidx_end(); ++irec ) {
-          std:: size_t rNum = obsdb_.recidx_recnum(irec);
-          std::vector<std::size_t> rSort = obsdb_.recidx_vector(irec);
-          for (size_t ilocs = 0; ilocs < rSort.size(); ++ilocs) {
-            get_locs(rSort, i1, i2, ilocs, ii1, ii2);
-            if ( ii1 == ii2 ) {
-              // no derivative if the indices are the same
-              dydx[rSort[ilocs]] = 0.0;
-            } else {
-              // compute derivative
-              dydx[rSort[ilocs]] = (varDep_[strDep_][rSort[ii2]] -
-                                    varDep_[strDep_][rSort[ii1]]) /
-                                   (varIndT_[rSort[ii2]] -
-                                    varIndT_[rSort[ii1]]).toSeconds();
-            }
-          }
-        }
-     }
-  // end if strInd_ == "datetime"
-  } else if ( strInd_ == "distance" ) {  // convert lat/lon change to distance
-      ioda::ObsDataVector<float> varDep_(obsdb_, strDep_, "MetaData");
-      ioda::ObsDataVector<float> varIndX_(obsdb_, "longitude", "MetaData");
-      ioda::ObsDataVector<float> varIndY_(obsdb_, "latitude", "MetaData");
-      ioda::ObsSpace::RecIdxIter irec;
-      for ( irec = obsdb_.recidx_begin(); irec != obsdb_.recidx_end(); ++irec ) {
-        std:: size_t rNum = obsdb_.recidx_recnum(irec);
-        std::vector<std::size_t> rSort = obsdb_.recidx_vector(irec);
-        for (size_t ilocs = 0; ilocs < rSort.size(); ++ilocs) {
-          get_locs(rSort, i1, i2, ilocs, ii1, ii2);
-          if ( ii1 == ii2 ) {
-            // no derivative if the indices are the same
-            dydx[rSort[ilocs]] = 0.0;
-          } else {
-            // compute distance for each lat lon pair
-            eckit::geometry::Point2 Ob1(varIndX_["longitude"][rSort[ii2]],
-                                        varIndY_["latitude"][rSort[ii2]]);
-            eckit::geometry::Point2 Ob2(varIndX_["longitude"][rSort[ii1]],
-                                        varIndY_["latitude"][rSort[ii1]]);
-            float dist_m = static_cast<float>(eckit::geometry::Sphere::distance(radiusEarth,
-                                                                               Ob1, Ob2));
-            dydx[rSort[ilocs]] = (varDep_[strDep_][rSort[ii2]] - varDep_[strDep_][rSort[ii1]]) /
-                                 dist_m;
-          }
-        }
-      }
-  // end if strInd_ == "distance"
-  } else {  // standard case where independent var is not datetime or distance
-      ioda::ObsDataVector<float> varDep_(obsdb_, strDep_, "MetaData");
-      ioda::ObsDataVector<float> varInd_(obsdb_, strInd_, "MetaData");
-      ioda::ObsSpace::RecIdxIter irec;
-      for ( irec = obsdb_.recidx_begin(); irec != obsdb_.recidx_end(); ++irec ) {
-        std:: size_t rNum = obsdb_.recidx_recnum(irec);
-        std::vector<std::size_t> rSort = obsdb_.recidx_vector(irec);
-        for (size_t ilocs = 0; ilocs < rSort.size(); ++ilocs) {
-          get_locs(rSort, i1, i2, ilocs, ii1, ii2);
-          if ( ii1 == ii2 ) {
-            dydx[rSort[ilocs]] = 0.0;
-          } else {
-            dydx[rSort[ilocs]] = (varDep_[strDep_][rSort[ii2]] - varDep_[strDep_][rSort[ii1]]) /
-                                 (varInd_[strInd_][rSort[ii2]] - varInd_[strInd_][rSort[ii1]]);
-          }
-        }
-      }
+  const bool xIsTime = strInd_ == "dateTime";
+  const bool xIsDistance = strInd_ == "distance";
+  const bool yIsDistance = xIsTime && strDep_ == "distance";
+
+  std::vector<int64_t> time;  // seconds since the earliest observation time
+  std::vector<float> lon, lat, varDep, varInd;
+  if (xIsTime) {
+    std::vector<util::DateTime> dateTime(nlocs_);
+    obsdb_.get_db("MetaData", strInd_, dateTime);
+    time.resize(nlocs_);
+    if (nlocs_ > 0) {
+      const util::DateTime reference = *std::min_element(dateTime.begin(), dateTime.end());
+      for (size_t jobs = 0; jobs < nlocs_; ++jobs)
+        time[jobs] = (dateTime[jobs] - reference).toSeconds();
+    }
+  }
+  if (xIsDistance || yIsDistance) {
+    lon.resize(nlocs_);
+    lat.resize(nlocs_);
+    obsdb_.get_db("MetaData", "longitude", lon);
+    obsdb_.get_db("MetaData", "latitude", lat);
+  }
+  if (!yIsDistance) {
+    varDep.resize(nlocs_);
+    obsdb_.get_db("MetaData", strDep_, varDep);
+  }
+  if (!xIsTime && !xIsDistance) {
+    varInd.resize(nlocs_);
+    obsdb_.get_db("MetaData", strInd_, varInd);
+  }
+
+  // Records are independent of each other, so their derivatives are computed concurrently. The
+  // variables are first copied into contiguous arrays sorted in the record order.
+  const std::vector<size_t> &recnums = obsdb_.recidx_all_recnums();
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t jrec = 0; jrec < recnums.size(); ++jrec) {
+    const std::vector<size_t> &rSort = obsdb_.recidx_vector(recnums[jrec]);
+    const size_t n = rSort.size();
+    if (n == 0)
+      continue;
+    std::vector<float> recDydx(n);
+    std::vector<int64_t> recTime;
+    std::vector<float> recLon, recLat, recDep, recInd;
+    gather(time, rSort, recTime);
+    gather(lon, rSort, recLon);
+    gather(lat, rSort, recLat);
+    gather(varDep, rSort, recDep);
+    gather(varInd, rSort, recInd);
+
+    const auto dyValue = [&recDep](size_t a, size_t b) {return recDep[b] - recDep[a];};
+    const auto dxValue = [&recInd](size_t a, size_t b) {return recInd[b] - recInd[a];};
+    const auto dTime = [&recTime](size_t a, size_t b) {return recTime[b] - recTime[a];};
+    const auto dDistance = [&recLon, &recLat](size_t a, size_t b) {
+      return greatCircleDistance(recLon[a], recLat[a], recLon[b], recLat[b]);
+    };
+
+    if (yIsDistance)
+      recordDerivatives(n, i1, i2, dDistance, dTime, recDydx.data());
+    else if (xIsTime)
+      recordDerivatives(n, i1, i2, dyValue, dTime, recDydx.data());
+    else if (xIsDistance)
+      recordDerivatives(n, i1, i2, dyValue, dDistance, recDydx.data());
+    else
+      recordDerivatives(n, i1, i2, dyValue, dxValue, recDydx.data());
+
+    for (size_t i = 0; i < n; ++i)
+      dydx[rSort[i]] = recDydx[i];
   }
 
   // determine if the derivative is outside the specified range
@@ -7,6 +7,9 @@
 
 #include "ufo/filters/ObsDiagnosticsWriter.h"
 
+#include <chrono>
+#include <utility>
+
 #include "oops/util/Logger.h"
 #include "ufo/filters/Variables.h"
 
@@ -33,6 +36,52 @@ ObsDiagnosticsWriter::ObsDiagnosticsWriter(
 
 // -----------------------------------------------------------------------------
 
+ObsDiagnosticsWriter::~ObsDiagnosticsWriter() {
+  try {
+    completeWrites(true);
+  } catch (const std::exception & e) {
+    oops::Log::error() << "ObsDiagnosticsWriter: failed to write diagnostics: " << e.what()
+                       << std::endl;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsDiagnosticsWriter::postFilter(const GeoVaLs &,
+                                      const ioda::ObsVector &,
+                                      const ioda::ObsVector &,
+                                      const ObsDiagnostics & diags) {
+  oops::Log::trace() << "ObsDiagnosticsWriter postFilter" << std::endl;
+  if (!params_.asynchronous) {
+    diags.write(params_.diags);
+    return;
+  }
+  completeWrites(false);
+  PendingWrite write;
+  write.diags = diags.snapshot();
+  write.done = write.diags->writeInBackground(params_.diags);
+  pendingWrites_.push_back(std::move(write));
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsDiagnosticsWriter::completeWrites(bool all) {
+  // The copies of the diagnostics are destroyed on this thread, since the registry of Fortran
+  // GeoVaLs objects must only be accessed by one thread.
+  for (auto it = pendingWrites_.begin(); it != pendingWrites_.end(); ) {
+    if (all || it->done.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+      it->done.wait();
+      std::future<void> done = std::move(it->done);
+      it = pendingWrites_.erase(it);
+      done.get();  // rethrows any exception thrown while writing the file
+    } else {
+      ++it;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsDiagnosticsWriter::print(std::ostream & os) const {
   os << "ObsDiagnosticsWriter: " << params_.toConfiguration();
 }
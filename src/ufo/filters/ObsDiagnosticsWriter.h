@@ -8,6 +8,7 @@
 #ifndef UFO_FILTERS_OBSDIAGNOSTICSWRITER_H_
 #define UFO_FILTERS_OBSDIAGNOSTICSWRITER_H_
 
+#include <future>
 #include <memory>
 #include <ostream>
 #include <vector>
@@ -15,6 +16,8 @@
 #include "oops/base/Variables.h"
 #include "oops/interface/ObsFilterBase.h"
 #include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
+#include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
 #include "ufo/ObsTraits.h"
 #include "ufo/utils/parameters/ParameterTraitsVariable.h"
@@ -26,7 +29,6 @@ namespace ioda {
 }
 
 namespace ufo {
-class GeoVaLs;
 
 /// \brief Parameters controlling ObsDiagnosticsWriter
 class ObsDiagnosticsWriterParameters : public oops::ObsFilterParametersBase {
@@ -37,6 +39,14 @@ class ObsDiagnosticsWriterParameters : public oops::ObsFilterParametersBase {
   oops::OptionalParameter<std::vector<Variable>> filterVariables{
     "filter variables", this};
 
+  /// If true, postFilter() will only copy the diagnostics and write the copy to a file on a
+  /// background thread, so that the next processors (e.g. filters acting on other ObsSpaces) can
+  /// run in the meantime. The writes are completed when the filter is destroyed at the latest.
+  ///
+  /// Note: this requires the NetCDF and HDF5 libraries to be thread-safe, since other files may
+  /// be read or written by the main thread at the same time.
+  oops::Parameter<bool> asynchronous{"asynchronous", false, this};
+
   ObsDiagnosticsParameters_ diags{this};
 };
 
@@ -47,16 +57,14 @@ class ObsDiagnosticsWriter : public oops::interface::ObsFilterBase<ObsTraits> {
   ObsDiagnosticsWriter(ioda::ObsSpace &, const Parameters_ &,
                        std::shared_ptr<ioda::ObsDataVector<int> >,
                        std::shared_ptr<ioda::ObsDataVector<float> >);
-  ~ObsDiagnosticsWriter() {}
+  ~ObsDiagnosticsWriter();
 
   void preProcess() override {}
   void priorFilter(const GeoVaLs &) override {}
   void postFilter(const GeoVaLs &,
                   const ioda::ObsVector &,
                   const ioda::ObsVector &,
-                  const ObsDiagnostics & diags) override {
-    diags.write(params_.diags);
-  }
+                  const ObsDiagnostics & diags) override;
   void checkFilterData(const oops::FilterStage filterStage) override {}
 
   oops::Variables requiredVars() const override {return nogeovals_;}
@@ -64,9 +72,20 @@ class ObsDiagnosticsWriter : public oops::interface::ObsFilterBase<ObsTraits> {
 
  private:
   void print(std::ostream &) const override;
+  /// Wait for the completion of writes started by postFilter() in the asynchronous mode; if
+  /// \p all is false, only for those that have already finished.
+  void completeWrites(bool all);
+
+  /// A copy of the diagnostics being written to a file in the background.
+  struct PendingWrite {
+    std::unique_ptr<GeoVaLs> diags;
+    std::future<void> done;
+  };
+
   Parameters_ params_;
   const oops::Variables nogeovals_;
   oops::Variables extradiagvars_;
+  std::vector<PendingWrite> pendingWrites_;
 };
 
 }  // namespace ufo
@@ -8,6 +8,7 @@
 #include "ufo/filters/ObsFilterData.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "eckit/utils/StringTools.h"
@@ -17,7 +18,9 @@
 #include "oops/util/missingValues.h"
 #include "ufo/filters/obsfunctions/ObsFunction.h"
 #include "ufo/filters/obsfunctions/ObsFunctionBase.h"
+#include "ufo/filters/ObsFunctionCache.h"
 #include "ufo/filters/Variable.h"
+#include "ufo/filters/Variables.h"
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
 
@@ -58,6 +61,117 @@ void ObsFilterData::associate(const ioda::ObsDataVector<int> & data, const std::
   dvecsi_[name] = &data;
 }
 
+// -----------------------------------------------------------------------------
+void ObsFilterData::useCache(std::shared_ptr<ObsFunctionCache> cache) {
+  cache_ = std::move(cache);
+}
+
+// -----------------------------------------------------------------------------
+void ObsFilterData::prefetch(const Variables & vars) const {
+  clearPrefetched();
+  for (size_t jv = 0; jv < vars.size(); ++jv) {
+    const Variable & variable = vars[jv];
+    const std::string & grp = variable.group();
+    for (size_t jch = 0; jch < variable.size(); ++jch) {
+      const std::string var = variable.variable(jch);
+      if (!isObsSpaceVariable(grp, var) || !obsdb_.has(grp, var))
+        continue;
+      const std::string key = grp + "/" + var;
+      const ioda::ObsDtype dtype = obsdb_.dtype(grp, var);
+      if (dtype == ioda::ObsDtype::Float && prefetchedFloats_.count(key) == 0) {
+        std::vector<float> & values = prefetchedFloats_[key];
+        values.resize(obsdb_.nlocs());
+        obsdb_.get_db(grp, var, values);
+      } else if (dtype == ioda::ObsDtype::Integer && prefetchedInts_.count(key) == 0) {
+        std::vector<int> & values = prefetchedInts_[key];
+        values.resize(obsdb_.nlocs());
+        obsdb_.get_db(grp, var, values);
+      }
+    }
+  }
+  if (MemoryProfiler::enabled()) {
+    size_t nbytes = 0;
+    for (const auto & prefetched : prefetchedFloats_)
+      nbytes += prefetched.second.capacity() * sizeof(float);
+    for (const auto & prefetched : prefetchedInts_)
+      nbytes += prefetched.second.capacity() * sizeof(int);
+    prefetchedMemory_.update(obsdb_.distribution().get(), nbytes);
+  }
+}
+
+// -----------------------------------------------------------------------------
+void ObsFilterData::clearPrefetched() const {
+  prefetchedFloats_.clear();
+  prefetchedInts_.clear();
+  prefetchedMemory_.update(obsdb_.distribution().get(), 0);
+}
+
+// -----------------------------------------------------------------------------
+bool ObsFilterData::isObsSpaceVariable(const std::string & grp, const std::string & var) const {
+  return grp != "VarMetaData" && grp != "GeoVaLs" && grp != "ObsDiag" && grp != "ObsBiasTerm" &&
+         !eckit::StringTools::endsWith(grp, "ObsFunction") && !this->hasVector(grp, var) &&
+         !this->hasDataVector(grp, var) && !this->hasDataVectorInt(grp, var);
+}
+
+// -----------------------------------------------------------------------------
+template <>
+const std::vector<float> *ObsFilterData::findPrefetched(const std::string & grp,
+                                                        const std::string & var) const {
+  const auto it = prefetchedFloats_.find(grp + "/" + var);
+  return it == prefetchedFloats_.end() ? nullptr : &it->second;
+}
+
+template <>
+const std::vector<int> *ObsFilterData::findPrefetched(const std::string & grp,
+                                                      const std::string & var) const {
+  const auto it = prefetchedInts_.find(grp + "/" + var);
+  return it == prefetchedInts_.end() ? nullptr : &it->second;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+bool ObsFilterData::getPrefetched(const std::string & grp,
+                                  ioda::ObsDataVector<T> & values) const {
+  const oops::Variables & vars = values.varnames();
+  for (size_t jv = 0; jv < vars.size(); ++jv)
+    if (findPrefetched<T>(grp, vars[jv]) == nullptr)
+      return false;
+  for (size_t jv = 0; jv < vars.size(); ++jv)
+    values[vars[jv]] = *findPrefetched<T>(grp, vars[jv]);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void ObsFilterData::recordAccess(const std::string & grp) const {
+  ++numGetCalls_;
+  if (cache_) cache_->recordAccess(grp);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void ObsFilterData::computeObsFunction(const Variable & varname,
+                                       ioda::ObsDataVector<T> & values) const {
+  if (!cache_) {
+    ObsFunction<T> obsfunc(varname);
+    obsfunc.compute(*this, values);
+    return;
+  }
+
+  const std::string key = ObsFunctionCache::key(varname);
+  if (cache_->find(key, values))
+    return;
+
+  cache_->startEvaluation();
+  try {
+    ObsFunction<T> obsfunc(varname);
+    obsfunc.compute(*this, values);
+  } catch (...) {
+    cache_->abandonEvaluation();
+    throw;
+  }
+  cache_->insert(key, values);
+}
+
 // -----------------------------------------------------------------------------
 /*! Associates ObsDiagnostics coming from ObsOperator with this ObsFilterData */
 void ObsFilterData::associate(const ObsDiagnostics & diags) {
@@ -77,8 +191,8 @@ size_t ObsFilterData::nlocs() const {
  *          false otherwise
  */
 bool ObsFilterData::has(const Variable & varname) const {
-  const std::string var = varname.variable();
-  const std::string grp = varname.group();
+  const std::string & var = varname.variable();
+  const std::string & grp = varname.group();
   if (grp == "GeoVaLs") {
     return (gvals_ && gvals_->has(var));
   } else if (grp == ObsFunctionTraits<float>::groupName) {
@@ -170,49 +284,149 @@ void ObsFilterData::get(const Variable & varname, std::vector<DiagnosticFlag> &
 template <typename T>
 void ObsFilterData::getVector(const Variable & varname, std::vector<T> & values,
                               bool skipDerived) const {
-  const std::string var = varname.variable(0);
-  const std::string grp = varname.group();
+  const std::string & var = varname.variable(0);
+  const std::string & grp = varname.group();
 
   if (grp == "VarMetaData") {
     values.resize(obsdb_.nvars());
     obsdb_.get_db(grp, var, values, {}, skipDerived);
   } else {
-    ioda::ObsDataVector<T> vec(obsdb_, varname.toOopsVariables(), grp, false);
+    ioda::ObsDataVector<T> vec(obsdb_, varname.toOopsVariables());
     this->get(varname, vec, skipDerived);
     values = vec[var];
   }
 }
 
 // -----------------------------------------------------------------------------
-// Overload of get() taking an std::vector<float> and a level index.
+// Retrieval of read-only views.
 // -----------------------------------------------------------------------------
-void ObsFilterData::get(const Variable & varname, const int level,
-                        std::vector<float> & values) const {
-  const std::string var = varname.variable();
-  const std::string grp = varname.group();
+template <typename T>
+ObsFilterDataView<T> ObsFilterData::getView(const Variable & varname, bool skipDerived) const {
+  ObsFilterDataView<T> view;
+  if (getViewDirectly(varname, view))
+    return view;
+
+  const std::string & var = varname.variable(0);
+  const std::string & grp = varname.group();
+  std::vector<T> values;
+  if (isObsSpaceVariable(grp, var) && obsdb_.has(grp, var)) {
+    // Read the variable straight from the ObsSpace (or view the prefetched values).
+    recordAccess(grp);
+    if (!skipDerived) {
+      if (const std::vector<T> *prefetched = findPrefetched<T>(grp, var))
+        return ObsFilterDataView<T>(*prefetched);
+    }
+    values.resize(obsdb_.nlocs());
+    obsdb_.get_db(grp, var, values, {}, skipDerived);
+  } else {
+    getVector(varname, values, skipDerived);
+  }
+  return ObsFilterDataView<T>(std::move(values));
+}
 
-  ASSERT(grp == "GeoVaLs" || grp == "ObsDiag" || grp == "ObsBiasTerm");
-  values.resize(obsdb_.nlocs());
-///  For GeoVaLs read from GeoVaLs (should be available)
+template ObsFilterDataView<float> ObsFilterData::getView(const Variable &, bool) const;
+template ObsFilterDataView<int> ObsFilterData::getView(const Variable &, bool) const;
+
+// -----------------------------------------------------------------------------
+bool ObsFilterData::getViewDirectly(const Variable & varname,
+                                    ObsFilterDataView<float> & view) const {
+  const std::string & var = varname.variable(0);
+  const std::string & grp = varname.group();
   if (grp == "GeoVaLs") {
     ASSERT(gvals_);
-    gvals_->getAtLevel(values, var, level);
-///  For ObsDiag get from ObsDiagnostics
-  } else if (grp == "ObsDiag" || grp == "ObsBiasTerm") {
-    ASSERT(diags_);
-    diags_->get(values, var, level);
+    recordAccess(grp);
+    std::vector<float> values(obsdb_.nlocs());
+    gvals_->get(values, var);
+    view = ObsFilterDataView<float>(std::move(values));
+    return true;
+  } else if (this->hasVector(grp, var)) {
+    // H(x)-like ObsVectors store the variables of each location contiguously and in double
+    // precision: convert just the requested variable.
+    recordAccess(grp);
+    const ioda::ObsVector & ovec = *ovecs_.at(grp);
+    const size_t nvars = ovec.nvars();
+    const size_t jvar = ovec.varnames().find(var);
+    const double missingDouble = util::missingValue(double());
+    const float missingFloat = util::missingValue(float());
+    std::vector<float> values(ovec.nlocs());
+    for (size_t jloc = 0; jloc < values.size(); ++jloc) {
+      const double value = ovec[jloc * nvars + jvar];
+      values[jloc] = (value == missingDouble) ? missingFloat : static_cast<float>(value);
+    }
+    view = ObsFilterDataView<float>(std::move(values));
+    return true;
+  } else if (this->hasDataVector(grp, var)) {
+    recordAccess(grp);
+    view = ObsFilterDataView<float>((*dvecsf_.at(grp))[var]);
+    return true;
   }
+  return false;
 }
 
 // -----------------------------------------------------------------------------
-// Overload of get() taking an std::vector<double> and a level index.
+bool ObsFilterData::getViewDirectly(const Variable & varname,
+                                    ObsFilterDataView<int> & view) const {
+  const std::string & var = varname.variable(0);
+  const std::string & grp = varname.group();
+  if (this->hasDataVectorInt(grp, var)) {
+    recordAccess(grp);
+    view = ObsFilterDataView<int>((*dvecsi_.at(grp))[var]);
+    return true;
+  }
+  return false;
+}
+
 // -----------------------------------------------------------------------------
-void ObsFilterData::get(const Variable & varname, const int level,
-                        std::vector<double> & values) const {
-  const std::string var = varname.variable();
-  const std::string grp = varname.group();
+// Retrieval of all channels of a variable at once.
+// -----------------------------------------------------------------------------
+template <typename T>
+void ObsFilterData::getChannelsImpl(const Variable & varname,
+                                    std::vector<std::vector<T>> & values,
+                                    bool skipDerived) const {
+  const std::string & grp = varname.group();
+  values.resize(varname.size());
+  if (grp == "GeoVaLs" || grp == "ObsDiag" || grp == "ObsBiasTerm") {
+    // GeoVaLs and ObsDiagnostics store each channel separately.
+    for (size_t ichan = 0; ichan < varname.size(); ++ichan)
+      getVector(varname[ichan], values[ichan], skipDerived);
+  } else {
+    ioda::ObsDataVector<T> vec(obsdb_, varname.toOopsVariables());
+    this->get(varname, vec, skipDerived);
+    for (size_t ichan = 0; ichan < varname.size(); ++ichan)
+      values[ichan] = std::move(vec[varname.variable(ichan)]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+void ObsFilterData::getChannels(const Variable & varname,
+                                std::vector<std::vector<float>> & values,
+                                bool skipDerived) const {
+  getChannelsImpl(varname, values, skipDerived);
+}
+
+// -----------------------------------------------------------------------------
+void ObsFilterData::getChannels(const Variable & varname,
+                                std::vector<std::vector<int>> & values,
+                                bool skipDerived) const {
+  getChannelsImpl(varname, values, skipDerived);
+}
 
+// -----------------------------------------------------------------------------
+void ObsFilterData::getChannels(const Variable & varname, const int level,
+                                std::vector<std::vector<float>> & values) const {
+  values.resize(varname.size());
+  for (size_t ichan = 0; ichan < varname.size(); ++ichan)
+    this->getChannel(varname, ichan, level, values[ichan]);
+}
+
+// -----------------------------------------------------------------------------
+// Retrieval of a single level.
+// -----------------------------------------------------------------------------
+template <typename T>
+void ObsFilterData::getAtLevel(const std::string & grp, const std::string & var,
+                               const int level, std::vector<T> & values) const {
   ASSERT(grp == "GeoVaLs" || grp == "ObsDiag" || grp == "ObsBiasTerm");
+  recordAccess(grp);
   values.resize(obsdb_.nlocs());
 ///  For GeoVaLs read from GeoVaLs (should be available)
   if (grp == "GeoVaLs") {
@@ -225,14 +439,39 @@ void ObsFilterData::get(const Variable & varname, const int level,
   }
 }
 
+// -----------------------------------------------------------------------------
+void ObsFilterData::get(const Variable & varname, const int level,
+                        std::vector<float> & values) const {
+  getAtLevel(varname.group(), varname.variable(), level, values);
+}
+
+// -----------------------------------------------------------------------------
+void ObsFilterData::get(const Variable & varname, const int level,
+                        std::vector<double> & values) const {
+  getAtLevel(varname.group(), varname.variable(), level, values);
+}
+
+// -----------------------------------------------------------------------------
+void ObsFilterData::getChannel(const Variable & varname, size_t channelIndex, const int level,
+                               std::vector<float> & values) const {
+  getAtLevel(varname.group(), varname.variable(channelIndex), level, values);
+}
+
+// -----------------------------------------------------------------------------
+void ObsFilterData::getChannel(const Variable & varname, size_t channelIndex, const int level,
+                               std::vector<double> & values) const {
+  getAtLevel(varname.group(), varname.variable(channelIndex), level, values);
+}
+
 // -----------------------------------------------------------------------------
 // Overloads of get() taking an ioda::ObsDataVector.
 
 // -----------------------------------------------------------------------------
 void ObsFilterData::get(const Variable & varname, ioda::ObsDataVector<float> & values,
                         bool skipDerived) const {
-  const std::string var = varname.variable(0);
-  const std::string grp = varname.group();
+  const std::string & var = varname.variable(0);
+  const std::string & grp = varname.group();
+  recordAccess(grp);
   /// For GeoVaLs read single variable and save in the relevant field
   if (grp == "GeoVaLs") {
     ASSERT(gvals_);
@@ -241,8 +480,7 @@ void ObsFilterData::get(const Variable & varname, ioda::ObsDataVector<float> & v
     values[var] = vec;
   /// For Function call compute
   } else if (grp == ObsFunctionTraits<float>::groupName) {
-    ObsFunction<float> obsfunc(varname);
-    obsfunc.compute(*this, values);
+    computeObsFunction(varname, values);
   ///  For HofX get from ObsVector H(x) (should be available)
   } else if (this->hasVector(grp, var)) {
     std::map<std::string, const ioda::ObsVector *>::const_iterator jv = ovecs_.find(grp);
@@ -267,7 +505,7 @@ void ObsFilterData::get(const Variable & varname, ioda::ObsDataVector<float> & v
     throw eckit::BadParameter("ObsFilterData::get(): " + varname.fullName() +
                               " is not a function producing values of type " +
                               ObsFunctionTraits<float>::valueTypeName, Here());
-  } else {
+  } else if (skipDerived || !getPrefetched(grp, values)) {
     values.read(grp, true, skipDerived);
   }
 }
@@ -275,12 +513,12 @@ void ObsFilterData::get(const Variable & varname, ioda::ObsDataVector<float> & v
 // -----------------------------------------------------------------------------
 void ObsFilterData::get(const Variable & varname, ioda::ObsDataVector<int> & values,
                         bool skipDerived) const {
-  const std::string var = varname.variable(0);
-  const std::string grp = varname.group();
+  const std::string & var = varname.variable(0);
+  const std::string & grp = varname.group();
+  recordAccess(grp);
   /// For Function call compute
   if (grp == ObsFunctionTraits<int>::groupName) {
-    ObsFunction<int> obsfunc(varname);
-    obsfunc.compute(*this, values);
+    computeObsFunction(varname, values);
   /// For ObsDataVector
   } else if (this->hasDataVectorInt(grp, var)) {
     std::map<std::string, const ioda::ObsDataVector<int> *>::const_iterator jv = dvecsi_.find(grp);
@@ -297,7 +535,7 @@ void ObsFilterData::get(const Variable & varname, ioda::ObsDataVector<int> & val
   } else if (grp == "GeoVaLs" || grp == "HofX" || grp == "ObsDiag" || grp == "ObsBiasTerm") {
     throw eckit::BadParameter("ObsFilterData::get(): variables from the group " + grp +
                               " are of type float", Here());
-  } else {
+  } else if (skipDerived || !getPrefetched(grp, values)) {
     values.read(grp, true, skipDerived);
   }
 }
@@ -320,6 +558,7 @@ void ObsFilterData::get(const Variable & varname,
                         ioda::ObsDataVector<DiagnosticFlag> & values,
                         bool skipDerived) const {
   const std::string &grp = varname.group();
+  recordAccess(grp);
   // There are no ObsFunctions producing flags yet
   if (eckit::StringTools::endsWith(grp, "ObsFunction")) {
     throw eckit::BadParameter("ObsFilterData::get(): " + varname.fullName() +
@@ -340,6 +579,7 @@ template <typename T>
 void ObsFilterData::getNonNumeric(const Variable & varname, ioda::ObsDataVector<T> & values,
                                   bool skipDerived) const {
   const std::string &grp = varname.group();
+  recordAccess(grp);
   /// For Function call compute
   if (grp == ObsFunctionTraits<T>::groupName) {
     ObsFunction<T> obsfunc(varname);
@@ -362,8 +602,8 @@ void ObsFilterData::getNonNumeric(const Variable & varname, ioda::ObsDataVector<
 
 // -----------------------------------------------------------------------------
 size_t ObsFilterData::nlevs(const Variable & varname) const {
-  const std::string var = varname.variable();
-  const std::string grp = varname.group();
+  const std::string & var = varname.variable();
+  const std::string & grp = varname.group();
   if (grp == "GeoVaLs") {
     ASSERT(gvals_);
     return gvals_->nlevs(var);
@@ -440,8 +680,8 @@ void ObsFilterData::print(std::ostream & os) const {
  *  \return data type (ioda::ObsDtype) associated with varname
  */
 ioda::ObsDtype ObsFilterData::dtype(const Variable & varname) const {
-  const std::string var = varname.variable();
-  const std::string grp = varname.group();
+  const std::string & var = varname.variable();
+  const std::string & grp = varname.group();
   // Default to float
   ioda::ObsDtype res = ioda::ObsDtype::Float;
   if (obsdb_.has(grp, var)) {
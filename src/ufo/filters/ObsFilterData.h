@@ -9,14 +9,17 @@
 #define UFO_FILTERS_OBSFILTERDATA_H_
 
 #include <map>
+#include <memory>
 #include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "oops/util/ObjectCounter.h"
 #include "oops/util/Printable.h"
 
 #include "ufo/filters/DiagnosticFlag.h"
+#include "ufo/MemoryProfiler.h"
 
 namespace util {
   class DateTime;
@@ -32,7 +35,46 @@ namespace ioda {
 namespace ufo {
   class GeoVaLs;
   class ObsDiagnostics;
+  class ObsFunctionCache;
   class Variable;
+  class Variables;
+
+// -----------------------------------------------------------------------------
+/// \brief Read-only view of the values of a variable at all locations, returned by
+/// ObsFilterData::getView().
+///
+/// \details If the source of the variable already holds its values in a contiguous array of the
+/// requested type (e.g. an associated ObsDataVector), the view refers to that array directly.
+/// Otherwise (e.g. if the values need to be converted from double to float) it owns a copy,
+/// which is shared by all copies of the view. A view referring to external data becomes invalid
+/// if that data is destroyed or resized.
+template <typename T>
+class ObsFilterDataView {
+ public:
+  ObsFilterDataView() = default;
+  /// Create a view of \p values, which must outlive it.
+  explicit ObsFilterDataView(const std::vector<T> & values)
+    : data_(values.data()), size_(values.size()) {}
+  /// Create a view owning \p values.
+  explicit ObsFilterDataView(std::vector<T> && values)
+    : owned_(std::make_shared<const std::vector<T>>(std::move(values))),
+      data_(owned_->data()), size_(owned_->size()) {}
+
+  size_t size() const {return size_;}
+  bool empty() const {return size_ == 0;}
+  const T & operator[](size_t i) const {return data_[i];}
+  const T * data() const {return data_;}
+  const T * begin() const {return data_;}
+  const T * end() const {return data_ + size_;}
+
+  /// True if the view holds a copy of the values rather than referring to their source.
+  bool ownsData() const {return owned_ != nullptr;}
+
+ private:
+  std::shared_ptr<const std::vector<T>> owned_;
+  const T * data_ = nullptr;
+  size_t size_ = 0;
+};
 
 // -----------------------------------------------------------------------------
 /*! \brief ObsFilterData provides access to all data related to an ObsFilter
@@ -61,6 +103,19 @@ class ObsFilterData : public util::Printable,
   void associate(const ioda::ObsDataVector<float> &, const std::string &);
   //! Associates ObsDataVector with this ObsFilterData (int)
   void associate(const ioda::ObsDataVector<int> &, const std::string &);
+  //! \brief Store values of float and int ObsFunctions in \p cache and reuse values stored there
+  //! (possibly by other filters) instead of recomputing them.
+  void useCache(std::shared_ptr<ObsFunctionCache> cache);
+  //! \brief Read the float and int ObsSpace variables among \p vars in one go and keep them
+  //! in memory until clearPrefetched() is called.
+  //!
+  //! Subsequent calls to get() and getView() retrieving these variables (without skipping
+  //! derived variables) take them from memory instead of the ObsSpace; getView() returns views
+  //! of the prefetched values without copying them. The prefetched values are not updated if
+  //! the ObsSpace is modified, so this must only be used while the ObsSpace does not change.
+  void prefetch(const Variables & vars) const;
+  //! Discard the values read by prefetch().
+  void clearPrefetched() const;
 
   //! \brief Fills a `std::vector` with values of the specified variable.
   //!
@@ -85,6 +140,19 @@ class ObsFilterData : public util::Printable,
   void get(const Variable &varname, std::vector<DiagnosticFlag> &values,
            bool skipDerived = false) const;
 
+  //! \brief Returns a read-only view of the values of the specified variable (of type float or
+  //! int).
+  //!
+  //! Unlike get(), this does not copy the values if their source already holds them in a
+  //! contiguous array of type \p T: this is the case for variables from associated
+  //! ObsDataVectors (e.g. ObsErrorData and QCflagsData). Values that need to be converted (e.g.
+  //! H(x) and GeoVaLs, stored as doubles) or read from the ObsSpace are copied once, directly
+  //! into the view, without going through a temporary ObsDataVector holding all variables.
+  //!
+  //! An exception is thrown if the requested variable does not exist or is not of the correct type.
+  template <typename T>
+  ObsFilterDataView<T> getView(const Variable &varname, bool skipDerived = false) const;
+
   //! \brief Fills a `std::vector` with values of the specified variable at a single level.
   //!
   //! \param varname
@@ -103,6 +171,18 @@ class ObsFilterData : public util::Printable,
   void get(const Variable & varname, const int level,
            std::vector<double> & values) const;
 
+  //! \brief Fills a `std::vector` with values of channel `varname[channelIndex]` of the specified
+  //! variable at a single level.
+  //!
+  //! Equivalent to `get(varname[channelIndex], level, values)`, but avoids creating a Variable
+  //! object for the channel. Intended for loops over the channels of a variable constructed
+  //! once outside the loop.
+  void getChannel(const Variable & varname, size_t channelIndex, const int level,
+                  std::vector<float> & values) const;
+  //! \overload
+  void getChannel(const Variable & varname, size_t channelIndex, const int level,
+                  std::vector<double> & values) const;
+
   //! brief Fills a `ioda::ObsDataVector` with values of the specified variable.
   //!
   //! \param varname
@@ -127,6 +207,23 @@ class ObsFilterData : public util::Printable,
   void get(const Variable &varname, ioda::ObsDataVector<DiagnosticFlag> &values,
            bool skipDerived = false) const;
 
+  //! \brief Fills \p values with the values of all channels of the specified variable:
+  //! `values[i]` is set to the values of channel `varname[i]` at all locations.
+  //!
+  //! This is equivalent to, but cheaper than, calling get() for each channel: data held in
+  //! location-major order (e.g. HofX stored in an ObsVector) are traversed only once rather than
+  //! once per channel, and the caller receives a contiguous block of values for each channel.
+  //! Multi-channel ObsFunctions should use it to retrieve all the channels they need at once.
+  void getChannels(const Variable &varname, std::vector<std::vector<float>> &values,
+                   bool skipDerived = false) const;
+  //! \overload
+  void getChannels(const Variable &varname, std::vector<std::vector<int>> &values,
+                   bool skipDerived = false) const;
+  //! \brief Fills \p values with the values of all channels of the specified variable, which
+  //! must belong to one of the groups GeoVaLs, ObsDiag and ObsBiasTerm, at level \p level.
+  void getChannels(const Variable &varname, const int level,
+                   std::vector<std::vector<float>> &values) const;
+
   //! Returns true if variable `varname` is known to ObsFilterData, false otherwise.
   bool has(const Variable &varname) const;
 
@@ -146,19 +243,50 @@ class ObsFilterData : public util::Printable,
   const GeoVaLs * getGeoVaLs() const {return gvals_;}
   //! Returns reference to ObsDiagnostics
   const ObsDiagnostics * getObsDiags() const {return diags_;}
+  //! Returns the number of variables retrieved with get() so far
+  size_t numGetCalls() const {return numGetCalls_;}
  private:
   void print(std::ostream &) const;
   bool hasVector(const std::string &, const std::string &) const;
   bool hasDataVector(const std::string &, const std::string &) const;
   bool hasDataVectorInt(const std::string &, const std::string &) const;
 
+  /// Called by getView() to retrieve variables that can be viewed or converted without going
+  /// through an ObsDataVector. Returns false if \p varname is not such a variable.
+  bool getViewDirectly(const Variable &varname, ObsFilterDataView<float> &view) const;
+  bool getViewDirectly(const Variable &varname, ObsFilterDataView<int> &view) const;
+
   template <typename T>
   void getVector(const Variable &varname, std::vector<T> &values,
                  bool skipDerived = false) const;
+  /// Called by the overloads of get() and getChannel() taking a level index.
+  template <typename T>
+  void getAtLevel(const std::string &grp, const std::string &var, const int level,
+                  std::vector<T> &values) const;
+  /// Called by the overloads of getChannels() not taking a level.
+  template <typename T>
+  void getChannelsImpl(const Variable &varname, std::vector<std::vector<T>> &values,
+                       bool skipDerived) const;
   /// Called by the overloads of get() taking an ioda::ObsDataVector of strings or datetimes.
   template <typename T>
   void getNonNumeric(const Variable &varname, ioda::ObsDataVector<T> &values,
                      bool skipDerived = false) const;
+  /// Called by the overloads of get() taking an ioda::ObsDataVector of floats or ints to
+  /// retrieve the value of an ObsFunction from the cache or compute it.
+  template <typename T>
+  void computeObsFunction(const Variable &varname, ioda::ObsDataVector<T> &values) const;
+  /// Records the retrieval of a variable from group \p grp in the cache (if any).
+  void recordAccess(const std::string &grp) const;
+  /// Returns true if variable \p var from group \p grp is read directly from the ObsSpace
+  /// rather than from an associated object or an ObsFunction.
+  bool isObsSpaceVariable(const std::string &grp, const std::string &var) const;
+  /// Returns the values of \p grp/\p var read by prefetch(), or nullptr if there are none.
+  template <typename T>
+  const std::vector<T> *findPrefetched(const std::string &grp, const std::string &var) const;
+  /// Fills \p values with prefetched values of all its variables from group \p grp and returns
+  /// true if they have all been prefetched; otherwise returns false.
+  template <typename T>
+  bool getPrefetched(const std::string &grp, ioda::ObsDataVector<T> &values) const;
 
   ioda::ObsSpace & obsdb_;                 //!< ObsSpace associated with this object
   const GeoVaLs mutable * gvals_;          //!< pointer to GeoVaLs associated with this object
@@ -166,6 +294,12 @@ class ObsFilterData : public util::Printable,
   const ObsDiagnostics mutable * diags_;   //!< pointer to ObsDiagnostics associated with object
   std::map<std::string, const ioda::ObsDataVector<float> *> dvecsf_;  //!< Associated ObsDataVectors
   std::map<std::string, const ioda::ObsDataVector<int> *> dvecsi_;  //!< Associated ObsDataVectors
+  std::shared_ptr<ObsFunctionCache> cache_;  //!< Cache of ObsFunction values (may be null)
+  mutable size_t numGetCalls_ = 0;         //!< Number of variables retrieved with get()
+  mutable std::map<std::string, std::vector<float>> prefetchedFloats_;  //!< Read by prefetch()
+  mutable std::map<std::string, std::vector<int>> prefetchedInts_;      //!< Read by prefetch()
+  //! Memory taken by the prefetched values
+  mutable MemoryProfiler::Usage prefetchedMemory_{MemoryProfiler::Category::FILTER_TEMPORARIES};
 };
 
 }  // namespace ufo
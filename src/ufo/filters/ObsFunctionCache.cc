@@ -0,0 +1,235 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/ObsFunctionCache.h"
+
+#include <mutex>
+#include <sstream>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/utils/StringTools.h"
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+#include "oops/util/Logger.h"
+#include "ufo/filters/Variable.h"
+
+namespace ufo {
+
+namespace {
+
+/// Number of bytes taken by the values of the entries \p entries.
+template <typename Entries>
+size_t valueBytes(const Entries & entries) {
+  size_t nbytes = 0;
+  for (const auto & entry : entries)
+    for (const auto & values : entry.second.values)
+      nbytes += values.capacity() * sizeof(values[0]);
+  return nbytes;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<ObsFunctionCache> ObsFunctionCache::forObsSpace(const ioda::ObsSpace & obsdb) {
+  static std::mutex mutex;
+  static std::map<const ioda::ObsSpace *, std::weak_ptr<ObsFunctionCache>> caches;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  // Forget caches belonging to ObsSpaces that no longer have any processors.
+  for (auto it = caches.begin(); it != caches.end(); ) {
+    if (it->second.expired())
+      it = caches.erase(it);
+    else
+      ++it;
+  }
+
+  std::weak_ptr<ObsFunctionCache> & weakCache = caches[&obsdb];
+  std::shared_ptr<ObsFunctionCache> cache = weakCache.lock();
+  if (!cache) {
+    cache = std::make_shared<ObsFunctionCache>(obsdb.obsname(), obsdb.distribution().get());
+    weakCache = cache;
+  }
+  return cache;
+}
+
+// -----------------------------------------------------------------------------
+
+ObsFunctionCache::ObsFunctionCache(const std::string & obsname,
+                                   const ioda::Distribution * dist)
+  : obsname_(obsname), dist_(dist), stage_(oops::FilterStage::AUTO) {
+  oops::Log::trace() << "ObsFunctionCache created" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+ObsFunctionCache::~ObsFunctionCache() {
+  if (hits_ + misses_ > 0) {
+    oops::Log::info() << obsname_ << ": ObsFunction cache hits: " << hits_
+                      << ", misses: " << misses_ << std::endl;
+  }
+  oops::Log::trace() << "ObsFunctionCache destructed" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+std::string ObsFunctionCache::key(const Variable & var) {
+  std::stringstream ss;
+  ss << var.fullName() << "|";
+  for (int channel : var.channels())
+    ss << channel << ",";
+  ss << "|" << var.options();
+  return ss.str();
+}
+
+// -----------------------------------------------------------------------------
+
+bool ObsFunctionCache::find(const std::string & key, ioda::ObsDataVector<float> & values) {
+  return findImpl(floatEntries_, key, values);
+}
+
+// -----------------------------------------------------------------------------
+
+bool ObsFunctionCache::find(const std::string & key, ioda::ObsDataVector<int> & values) {
+  return findImpl(intEntries_, key, values);
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+bool ObsFunctionCache::findImpl(std::map<std::string, Entry<T>> & entries,
+                                const std::string & key, ioda::ObsDataVector<T> & values) {
+  const auto it = entries.find(key);
+  if (it == entries.end() || it->second.values.size() != values.nvars()) {
+    ++misses_;
+    return false;
+  }
+
+  const Entry<T> & entry = it->second;
+  for (size_t jv = 0; jv < values.nvars(); ++jv)
+    values[jv] = entry.values[jv];
+  // The caller now depends on the same data as the cached function.
+  if (entry.dependsOnMutableData && !evaluationStack_.empty())
+    evaluationStack_.back() = true;
+  ++hits_;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsFunctionCache::startEvaluation() {
+  evaluationStack_.push_back(false);
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsFunctionCache::insert(const std::string & key, const ioda::ObsDataVector<float> & values) {
+  insertImpl(floatEntries_, key, values);
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsFunctionCache::insert(const std::string & key, const ioda::ObsDataVector<int> & values) {
+  insertImpl(intEntries_, key, values);
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+void ObsFunctionCache::insertImpl(std::map<std::string, Entry<T>> & entries,
+                                  const std::string & key,
+                                  const ioda::ObsDataVector<T> & values) {
+  ASSERT(!evaluationStack_.empty());
+  const bool dependsOnMutableData = evaluationStack_.back();
+  evaluationStack_.pop_back();
+  if (dependsOnMutableData && !evaluationStack_.empty())
+    evaluationStack_.back() = true;
+
+  Entry<T> & entry = entries[key];
+  entry.values.resize(values.nvars());
+  for (size_t jv = 0; jv < values.nvars(); ++jv)
+    entry.values[jv] = values[jv];
+  entry.dependsOnMutableData = dependsOnMutableData;
+  updateMemoryUsage();
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsFunctionCache::abandonEvaluation() {
+  ASSERT(!evaluationStack_.empty());
+  evaluationStack_.pop_back();
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsFunctionCache::recordAccess(const std::string & group) {
+  if (!evaluationStack_.empty() && !isImmutableGroup(group))
+    evaluationStack_.back() = true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool ObsFunctionCache::isImmutableGroup(const std::string & group) {
+  // Values of ObsFunctions are tracked separately (see findImpl() and insertImpl()).
+  return group == "MetaData" || group == "VarMetaData" ||
+         group == "ObsValue" || group == "ObsError" ||
+         group == "GeoVaLs" || group == "HofX" || group == "ObsDiag" ||
+         group == "ObsBiasData" || group == "ObsBiasTerm" ||
+         eckit::StringTools::endsWith(group, "ObsFunction");
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsFunctionCache::startStage(oops::FilterStage stage) {
+  if (stage != stage_) {
+    clear();
+    stage_ = stage;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsFunctionCache::processorFinished(bool modifiedObsSpace) {
+  if (modifiedObsSpace) {
+    clear();
+  } else {
+    eraseMutable(floatEntries_);
+    eraseMutable(intEntries_);
+    updateMemoryUsage();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+void ObsFunctionCache::eraseMutable(std::map<std::string, Entry<T>> & entries) {
+  for (auto it = entries.begin(); it != entries.end(); ) {
+    if (it->second.dependsOnMutableData)
+      it = entries.erase(it);
+    else
+      ++it;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsFunctionCache::clear() {
+  floatEntries_.clear();
+  intEntries_.clear();
+  updateMemoryUsage();
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsFunctionCache::updateMemoryUsage() {
+  if (MemoryProfiler::enabled())
+    memoryUsage_.update(dist_, valueBytes(floatEntries_) + valueBytes(intEntries_));
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,150 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_OBSFUNCTIONCACHE_H_
+#define UFO_FILTERS_OBSFUNCTIONCACHE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "oops/generic/ObsFilterParametersBase.h"
+#include "oops/util/ObjectCounter.h"
+#include "ufo/MemoryProfiler.h"
+
+namespace ioda {
+  class Distribution;
+  template <typename DATATYPE> class ObsDataVector;
+  class ObsSpace;
+}
+
+namespace ufo {
+  class Variable;
+
+/// \brief Values of ObsFunctions evaluated by the filters acting on a single ObsSpace.
+///
+/// \details A single instance of this class is shared by all observation processors acting
+/// on the same ObsSpace (see forObsSpace()). Filters that enable the `cache obs functions` option
+/// store the values of the float and int ObsFunctions they evaluate in it, and reuse values
+/// stored by earlier filters instead of recomputing them.
+///
+/// Cached values are discarded when they might have become stale:
+///
+/// * all of them when the filter stage (pre, prior, post) changes, since the GeoVaLs, H(x) and
+///   ObsDiagnostics may then have changed;
+/// * all of them after a processor that may modify the contents of the ObsSpace (e.g. the
+///   Variable Assignment filter) has run;
+/// * values depending (directly or through other ObsFunctions) on data from groups other than
+///   MetaData, ObsValue, ObsError, GeoVaLs, HofX, ObsDiag, ObsBiasData and ObsBiasTerm (for
+///   example QCflagsData, ObsErrorData or DerivedObsValue) after any other processor has run.
+///
+/// Data dependencies of ObsFunctions are tracked by recording the groups of all variables they
+/// retrieve through ObsFilterData while their values are being computed.
+class ObsFunctionCache : private boost::noncopyable,
+                         private util::ObjectCounter<ObsFunctionCache> {
+ public:
+  static const std::string classname() {return "ufo::ObsFunctionCache";}
+
+  /// \brief Return the cache shared by all processors acting on \p obsdb, creating it
+  /// if necessary.
+  static std::shared_ptr<ObsFunctionCache> forObsSpace(const ioda::ObsSpace & obsdb);
+
+  /// \param obsname
+  ///   Name of the ObsSpace.
+  /// \param dist
+  ///   Distribution of the observations of the ObsSpace, used to attribute the memory taken by
+  ///   the cached values to it (see MemoryProfiler).
+  explicit ObsFunctionCache(const std::string & obsname,
+                            const ioda::Distribution * dist = nullptr);
+  ~ObsFunctionCache();
+
+  /// \brief Return the key identifying the values of the ObsFunction \p var: its full name,
+  /// channels and options.
+  static std::string key(const Variable & var);
+
+  /// \brief If values stored under the key \p key are available, copy them to \p values and
+  /// return true. Otherwise return false.
+  bool find(const std::string & key, ioda::ObsDataVector<float> & values);
+  /// \overload
+  bool find(const std::string & key, ioda::ObsDataVector<int> & values);
+
+  /// \brief Signal that the computation of an ObsFunction has started. Must be followed by a
+  /// call to insert() or abandonEvaluation().
+  void startEvaluation();
+  /// \brief Store the values \p values of the ObsFunction whose computation has just finished
+  /// under the key \p key.
+  void insert(const std::string & key, const ioda::ObsDataVector<float> & values);
+  /// \overload
+  void insert(const std::string & key, const ioda::ObsDataVector<int> & values);
+  /// \brief Signal that the computation of an ObsFunction has failed.
+  void abandonEvaluation();
+
+  /// \brief Record that a variable from group \p group is being retrieved.
+  void recordAccess(const std::string & group);
+
+  /// \brief Signal that processors are about to be run at stage \p stage.
+  ///
+  /// Discards all cached values if the stage differs from the previous one. Since all
+  /// processors go through the pre stage at the start of each cycle, values computed in
+  /// one outer loop iteration are never reused in the next.
+  void startStage(oops::FilterStage stage);
+
+  /// \brief Signal that a processor has finished running.
+  ///
+  /// \param modifiedObsSpace
+  ///   True if the processor may have modified the contents of the ObsSpace, false if it only
+  ///   could have modified QC flags and observation errors.
+  void processorFinished(bool modifiedObsSpace);
+
+  /// Number of successful calls to find().
+  size_t hits() const {return hits_;}
+  /// Number of unsuccessful calls to find().
+  size_t misses() const {return misses_;}
+
+ private:
+  template <typename T>
+  struct Entry {
+    /// Values of each variable (channel) produced by the ObsFunction.
+    std::vector<std::vector<T>> values;
+    /// True if the ObsFunction read data that can be modified by any filter.
+    bool dependsOnMutableData = false;
+  };
+
+  template <typename T>
+  bool findImpl(std::map<std::string, Entry<T>> & entries, const std::string & key,
+                ioda::ObsDataVector<T> & values);
+  template <typename T>
+  void insertImpl(std::map<std::string, Entry<T>> & entries, const std::string & key,
+                  const ioda::ObsDataVector<T> & values);
+  template <typename T>
+  static void eraseMutable(std::map<std::string, Entry<T>> & entries);
+
+  static bool isImmutableGroup(const std::string & group);
+
+  void clear();
+  /// Report the memory taken by the cached values to the MemoryProfiler, if enabled.
+  void updateMemoryUsage();
+
+  std::string obsname_;
+  const ioda::Distribution * dist_;
+  std::map<std::string, Entry<float>> floatEntries_;
+  std::map<std::string, Entry<int>> intEntries_;
+  /// One element per ObsFunction being evaluated (ObsFunctions may depend on other
+  /// ObsFunctions), set to true once that function is found to read mutable data.
+  std::vector<bool> evaluationStack_;
+  oops::FilterStage stage_;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+  MemoryProfiler::Usage memoryUsage_{MemoryProfiler::Category::FILTER_TEMPORARIES};
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_OBSFUNCTIONCACHE_H_
@@ -7,6 +7,12 @@
 
 #include "ufo/filters/ObsProcessorBase.h"
 
+#include <cxxabi.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 
@@ -17,9 +23,15 @@
 #include "oops/util/Logger.h"
 
 #include "ufo/filters/actions/FilterAction.h"
+#include "ufo/filters/FilterProfiler.h"
 #include "ufo/filters/GenericFilterParameters.h"
+#include "ufo/filters/ObsAccessorCache.h"
+#include "ufo/filters/ObsFunctionCache.h"
+#include "ufo/filters/QCFlagsRegistry.h"
 #include "ufo/GeoVaLs.h"
+#include "ufo/MemoryProfiler.h"
 #include "ufo/ObsDiagnostics.h"
+#include "ufo/utils/BitMask.h"
 
 namespace ufo {
 
@@ -30,7 +42,10 @@ ObsProcessorBase::ObsProcessorBase(ioda::ObsSpace & os, bool deferToPost,
                                    std::shared_ptr<ioda::ObsDataVector<float> > obserr)
   : obsdb_(os),
     flags_(flags), obserr_(obserr),
-    data_(obsdb_), prior_(false), post_(false),
+    data_(obsdb_), cache_(ObsFunctionCache::forObsSpace(obsdb_)),
+    accessorCache_(ObsAccessorCache::forObsSpace(obsdb_)),
+    profiler_(FilterProfiler::forObsSpace(obsdb_)),
+    memoryProfiler_(MemoryProfiler::forObsSpace(obsdb_)), prior_(false), post_(false),
     deferToPost_(deferToPost)
 {
   oops::Log::trace() << "ObsProcessorBase constructor" << std::endl;
@@ -38,6 +53,7 @@ ObsProcessorBase::ObsProcessorBase(ioda::ObsSpace & os, bool deferToPost,
   ASSERT(obserr);
   data_.associate(*flags_, "QCflagsData");
   data_.associate(*obserr_, "ObsErrorData");
+  QCFlagsRegistry::registerFlags(obsdb_, flags_);
 }
 
 // -----------------------------------------------------------------------------
@@ -48,8 +64,29 @@ ObsProcessorBase::~ObsProcessorBase() {
 
 // -----------------------------------------------------------------------------
 
+void ObsProcessorBase::setConstructionCost(const std::type_info & type, double seconds,
+                                           double heapBytes) {
+  constructedType_ = &type;
+  constructionSeconds_ = seconds;
+  constructionHeapBytes_ = heapBytes;
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsProcessorBase::registerWithProfiler() const {
+  if (profiler_ && profilerIndex_ == noProfilerIndex) {
+    profilerIndex_ = profiler_->addProcessor(processorName());
+    profiler_->addConstruction(profilerIndex_, constructionSeconds_, constructionHeapBytes_);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsProcessorBase::preProcess() {
   oops::Log::trace() << "ObsProcessorBase preProcess begin" << std::endl;
+  cache_->startStage(oops::FilterStage::PRE);
+  if (profiler_)
+    registerWithProfiler();
 // Cannot determine earlier when to apply filter because subclass
 // constructors add to allvars
   if (allvars_.hasGroup("HofX") || allvars_.hasGroup("ObsDiag") ||
@@ -59,7 +96,7 @@ void ObsProcessorBase::preProcess() {
     if (allvars_.hasGroup("GeoVaLs")) {
       prior_ = true;
     } else {
-      this->doFilter();
+      this->runFilter(oops::FilterStage::PRE);
     }
   }
   oops::Log::trace() << "ObsProcessorBase preProcess end" << std::endl;
@@ -69,8 +106,9 @@ void ObsProcessorBase::preProcess() {
 
 void ObsProcessorBase::priorFilter(const GeoVaLs & gv) {
   oops::Log::trace() << "ObsProcessorBase priorFilter begin" << std::endl;
+  cache_->startStage(oops::FilterStage::PRIOR);
   if (prior_ || post_) data_.associate(gv);
-  if (prior_) this->doFilter();
+  if (prior_) this->runFilter(oops::FilterStage::PRIOR);
   oops::Log::trace() << "ObsProcessorBase priorFilter end" << std::endl;
 }
 
@@ -81,18 +119,68 @@ void ObsProcessorBase::postFilter(const GeoVaLs & gv,
                                   const ioda::ObsVector & bias,
                                   const ObsDiagnostics & diags) {
   oops::Log::trace() << "ObsProcessorBase postFilter begin" << std::endl;
+  cache_->startStage(oops::FilterStage::POST);
   if (post_) {
     data_.associate(gv);
     data_.associate(hofx, "HofX");
     data_.associate(bias, "ObsBiasData");
     data_.associate(diags);
-    this->doFilter();
+    this->runFilter(oops::FilterStage::POST);
   }
   oops::Log::trace() << "ObsProcessorBase postFilter end" << std::endl;
 }
 
 // -----------------------------------------------------------------------------
 
+void ObsProcessorBase::runFilter(oops::FilterStage stage) const {
+  // Variables read from the ObsSpace can only be kept in memory while the ObsSpace is unchanged.
+  const bool prefetch = prefetchObsSpaceVariables_ && !this->modifiesObsSpace();
+  MemoryProfiler::Stage memoryStage(memoryProfiler_.get(),
+                                    stage == oops::FilterStage::PRE ? "pre filters" :
+                                    stage == oops::FilterStage::PRIOR ? "prior filters" :
+                                    "post filters");
+  auto filter = [&] {
+    if (prefetch) data_.prefetch(allvars_);
+    this->doFilter();
+    if (prefetch) data_.clearPrefetched();
+  };
+  if (profiler_) {
+    registerWithProfiler();
+    FilterProfiler::Measurement measurement(*profiler_, profilerIndex_, stage,
+                                            data_.numGetCalls());
+    filter();
+  } else {
+    filter();
+  }
+  cache_->processorFinished(this->modifiesObsSpace());
+}
+
+// -----------------------------------------------------------------------------
+
+void ObsProcessorBase::profileSelection(const BitMask & apply,
+                                        const std::vector<BitMask> & flagged) const {
+  if (!profiler_ || profilerIndex_ == noProfilerIndex)
+    return;
+  size_t nflagged = 0;
+  for (const BitMask & varFlagged : flagged)
+    nflagged += varFlagged.count();
+  profiler_->addSelection(profilerIndex_, apply.count(), nflagged);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string ObsProcessorBase::processorName() const {
+  // Processors created by the factory are wrapped in TimedConstruction; report the wrapped type.
+  const char * mangled = constructedType_ ? constructedType_->name() : typeid(*this).name();
+  int status = 0;
+  char * demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+  const std::string name = (status == 0 && demangled != nullptr) ? demangled : mangled;
+  std::free(demangled);
+  return name;
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsProcessorBase::checkFilterData(const oops::FilterStage filterStage) {
   // Return if filters have been automatically designated as pre, prior or post.
   if (filterStage == oops::FilterStage::AUTO)
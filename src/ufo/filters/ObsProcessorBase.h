@@ -8,7 +8,11 @@
 #ifndef UFO_FILTERS_OBSPROCESSORBASE_H_
 #define UFO_FILTERS_OBSPROCESSORBASE_H_
 
+#include <limits>
 #include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
 
 #include "oops/base/Variables.h"
 #include "oops/interface/ObsFilterBase.h"
@@ -23,8 +27,13 @@ namespace ioda {
 }
 
 namespace ufo {
+  class BitMask;
   class GeoVaLs;
   class ObsDiagnostics;
+  class FilterProfiler;
+  class MemoryProfiler;
+  class ObsAccessorCache;
+  class ObsFunctionCache;
 
 /// \brief Base class for UFO observation processors (including QC filters).
 ///
@@ -57,11 +66,53 @@ class ObsProcessorBase : public oops::interface::ObsFilterBase<ObsTraits> {
   std::shared_ptr<ioda::ObsDataVector<float>> obserr_;
   ufo::Variables allvars_;
   ObsFilterData data_;
+  /// Cache of ObsFunction values shared by all processors acting on `obsdb_`.
+  std::shared_ptr<ObsFunctionCache> cache_;
+  /// Variables gathered from all MPI ranks by ObsAccessors acting on `obsdb_`, kept alive for as
+  /// long as any processor acting on `obsdb_` exists.
+  std::shared_ptr<ObsAccessorCache> accessorCache_;
+  /// Profiler shared by all processors acting on `obsdb_` (null unless profiling is enabled).
+  std::shared_ptr<FilterProfiler> profiler_;
+  /// Memory profiler shared by all operators and processors acting on `obsdb_` (null unless
+  /// memory profiling is enabled).
+  std::shared_ptr<MemoryProfiler> memoryProfiler_;
   bool prior_;
   bool post_;
+  /// If true, the ObsSpace variables in `allvars_` are read in one go before the processor
+  /// runs (unless it modifies the ObsSpace) and kept in `data_` until it finishes.
+  bool prefetchObsSpaceVariables_ = false;
+
+  /// \brief Record the locations selected by the `where` clause (\p apply) and the values
+  /// flagged by the processor (\p flagged) in the profile, if profiling is enabled.
+  void profileSelection(const BitMask & apply, const std::vector<BitMask> & flagged) const;
+
+  /// \brief Record that the construction of this processor, of type \p type, took \p seconds
+  /// seconds and grew the heap by \p heapBytes bytes (see TimedConstruction).
+  void setConstructionCost(const std::type_info & type, double seconds, double heapBytes);
 
  private:
   virtual void doFilter() const = 0;
+  /// \brief Return true if this processor may modify the contents of the ObsSpace (and not just
+  /// the QC flags and observation errors). If it does, all cached ObsFunction values are
+  /// discarded after it runs.
+  virtual bool modifiesObsSpace() const {return true;}
+  /// Call doFilter() at the stage \p stage (prefetching the required ObsSpace variables if
+  /// requested) and discard cached ObsFunction values that may have become stale.
+  void runFilter(oops::FilterStage stage) const;
+  /// Name of the processor's class, used in the profile.
+  std::string processorName() const;
+  /// Add this processor and the cost of its construction to the profile (if profiling is enabled
+  /// and this has not been done yet).
+  void registerWithProfiler() const;
+
+  static constexpr size_t noProfilerIndex = std::numeric_limits<size_t>::max();
+  /// Index of this processor in the profile.
+  mutable size_t profilerIndex_ = noProfilerIndex;
+  /// Type of the processor whose construction was measured (null if it was not measured).
+  const std::type_info * constructedType_ = nullptr;
+  /// Wall time and heap growth measured during the construction of this processor.
+  double constructionSeconds_ = 0.0;
+  double constructionHeapBytes_ = 0.0;
 
   // Variables extracted from the filter parameters.
   bool deferToPost_;
@@ -9,12 +9,17 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <exception>
 #include <limits>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "eckit/container/KDTree.h"
+#include "eckit/mpi/Comm.h"
 #include "ioda/ObsDataVector.h"
 #include "ioda/ObsSpace.h"
 #include "oops/base/Variables.h"
@@ -26,6 +31,7 @@
 #include "ufo/filters/ObsAccessor.h"
 #include "ufo/filters/PoissonDiskThinningParameters.h"
 #include "ufo/utils/Constants.h"
+#include "ufo/utils/DistributedSort.h"
 #include "ufo/utils/RecursiveSplitter.h"
 
 namespace ufo {
@@ -122,6 +128,145 @@ bool KDTree<numDims_>::isAnyPointInCylinderInterior(
   return util::isAnyPointInCylinderInterior(tree_, lbound, ubound, numSpatialDims);
 }
 
+/// \brief An implementation of PointIndex storing points in a hash table of cells of a
+/// uniform grid.
+///
+/// The cell size in each direction must be no smaller than the semi-axis of any exclusion
+/// volume in that direction, so that each query inspects at most three cells in each direction.
+template <int numDims_>
+class GridIndex : public PointIndex<numDims_> {
+ public:
+  typedef PointIndex<numDims_> Base;
+
+  typedef typename Base::CoordType CoordType;
+  typedef typename Base::Point Point;
+  typedef typename Base::Extent Extent;
+
+  static const int numDims = Base::numDims;
+
+  explicit GridIndex(const Extent &cellSizes);
+
+  void insert(const Point &point) override;
+
+  bool isAnyPointInCylinderInterior(const Point &center,
+                                    const Extent &semiAxes,
+                                    int numSpatialDims) const override;
+
+  bool isAnyPointInEllipsoidInterior(const Point &center,
+                                     const Extent &semiAxes) const override;
+
+ private:
+  typedef std::array<std::int64_t, numDims> Cell;
+
+  struct CellHash {
+    size_t operator()(const Cell &cell) const {
+      size_t hash = 0;
+      for (std::int64_t index : cell)
+        hash = hash * 1000003 ^ std::hash<std::int64_t>()(index);
+      return hash;
+    }
+  };
+
+  /// Call \p predicate for each point stored in cells overlapping the bounding box of the
+  /// volume with centre \p center and semi-axes \p semiAxes until it returns true.
+  template <typename Predicate>
+  bool anyPointInBoundingBox(const Point &center, const Extent &semiAxes,
+                             const Predicate &predicate) const;
+
+  std::int64_t cellIndex(CoordType coord, int dim) const {
+    return static_cast<std::int64_t>(std::floor(coord * invCellSizes_[dim]));
+  }
+
+  Extent invCellSizes_;
+  std::unordered_map<Cell, std::vector<Point>, CellHash> cells_;
+};
+
+template <int numDims_>
+GridIndex<numDims_>::GridIndex(const Extent &cellSizes) {
+  for (int d = 0; d < numDims; ++d)
+    // Points can't lie in the interior of volumes with zero extent, so the cell size in
+    // directions in which all volumes have zero extent is irrelevant.
+    invCellSizes_[d] = cellSizes[d] > 0 ? 1 / cellSizes[d] : 1;
+}
+
+template <int numDims_>
+void GridIndex<numDims_>::insert(const Point &point) {
+  Cell cell;
+  for (int d = 0; d < numDims; ++d)
+    cell[d] = cellIndex(point[d], d);
+  cells_[cell].push_back(point);
+}
+
+template <int numDims_>
+template <typename Predicate>
+bool GridIndex<numDims_>::anyPointInBoundingBox(const Point &center, const Extent &semiAxes,
+                                                const Predicate &predicate) const {
+  Cell lower, upper;
+  for (int d = 0; d < numDims; ++d) {
+    if (!(semiAxes[d] > 0))
+      return false;
+    lower[d] = cellIndex(center[d] - semiAxes[d], d);
+    upper[d] = cellIndex(center[d] + semiAxes[d], d);
+  }
+
+  // Iterate over all cells in the range [lower, upper].
+  Cell cell = lower;
+  while (true) {
+    const auto it = cells_.find(cell);
+    if (it != cells_.end())
+      for (const Point &point : it->second)
+        if (predicate(point))
+          return true;
+
+    int d = 0;
+    while (d < numDims && cell[d] == upper[d]) {
+      cell[d] = lower[d];
+      ++d;
+    }
+    if (d == numDims)
+      return false;
+    ++cell[d];
+  }
+}
+
+template <int numDims_>
+bool GridIndex<numDims_>::isAnyPointInEllipsoidInterior(
+    const Point &center, const Extent &semiAxes) const {
+  return anyPointInBoundingBox(center, semiAxes, [&](const Point &point) {
+      CoordType sum = 0;
+      for (int d = 0; d < numDims; ++d) {
+        const CoordType x = (point[d] - center[d]) / semiAxes[d];
+        sum += x * x;
+      }
+      return sum < 1;
+    });
+}
+
+template <int numDims_>
+bool GridIndex<numDims_>::isAnyPointInCylinderInterior(
+    const Point &center, const Extent &semiAxes, int numSpatialDims) const {
+  return anyPointInBoundingBox(center, semiAxes, [&](const Point &point) {
+      CoordType sum = 0;
+      for (int d = 0; d < numSpatialDims; ++d) {
+        const CoordType x = (point[d] - center[d]) / semiAxes[d];
+        sum += x * x;
+      }
+      if (numSpatialDims > 0 && !(sum < 1))
+        return false;
+      for (int d = numSpatialDims; d < numDims; ++d)
+        if (!(std::abs(point[d] - center[d]) < semiAxes[d]))
+          return false;
+      return true;
+    });
+}
+
+/// \brief Return the latitude band (of \p numBands bands of equal width) containing
+/// latitude \p latitude.
+int latitudeBand(float latitude, int numBands) {
+  const int band = static_cast<int>(std::floor((latitude + 90.0f) / 180.0f * numBands));
+  return std::max(0, std::min(numBands - 1, band));
+}
+
 }  // namespace
 
 struct PoissonDiskThinning::ObsData
@@ -176,7 +321,7 @@ void PoissonDiskThinning::applyFilter(const std::vector<bool> & apply,
   int numSpatialDims, numNonspatialDims;
   ObsData obsData = getObsData(obsAccessor, numSpatialDims, numNonspatialDims);
 
-  std::vector<bool> isThinned(obsData.totalNumObs, false);
+  std::vector<char> isThinned(obsData.totalNumObs, false);
 
   if (options_.shuffle) {
     // If the same observations will be processed on multiple ranks, they must use random number
@@ -199,8 +344,16 @@ void PoissonDiskThinning::applyFilter(const std::vector<bool> & apply,
   // Thin points from each category separately.
   RecursiveSplitter categorySplitter =
       obsAccessor.splitObservationsIntoIndependentGroups(validObsIds);
+  const bool useDomainDecomposition = options_.domainDecomposition &&
+      obsData.minHorizontalSpacings != boost::none &&
+      obsdb_.comm().size() > 1 && obsAccessor.areObservationsSharedByAllRanks();
+  // Set up all categories first: this consumes random numbers (if shuffle is selected) in the
+  // same order as in a serial run, so the results do not depend on the number of threads.
+  std::vector<std::vector<size_t>> obsIdsInCategories;
+  std::vector<RecursiveSplitter> prioritySplitters;
   for (auto categoryGroup : categorySplitter.multiElementGroups()) {
     std::vector<size_t> obsIdsInCategory;
+    obsIdsInCategory.reserve(categoryGroup.end() - categoryGroup.begin());
     for (size_t validObsIndex : categoryGroup) {
       obsIdsInCategory.push_back(validObsIds[validObsIndex]);
     }
@@ -214,7 +367,7 @@ void PoissonDiskThinning::applyFilter(const std::vector<bool> & apply,
       prioritySplitter.shuffleGroups();
     } else if (options_.sortVertical.value() != boost::none &&
                obsData.minVerticalSpacings != boost::none) {
-      const std::vector<float> pressures = *obsData.pressures;
+      const std::vector<float> &pressures = *obsData.pressures;
       if (options_.sortVertical.value().value() == "ascending") {
         prioritySplitter.sortGroupsBy([&pressures, &obsIdsInCategory](size_t ind)
                                       {return pressures[obsIdsInCategory[ind]];});
@@ -223,9 +376,31 @@ void PoissonDiskThinning::applyFilter(const std::vector<bool> & apply,
                                       {return -1.0*pressures[obsIdsInCategory[ind]];});
       }
     }
-    // Select points to retain within the category.
-    thinCategory(obsData, obsIdsInCategory, prioritySplitter, numSpatialDims, numNonspatialDims,
-                 isThinned);
+    obsIdsInCategories.push_back(std::move(obsIdsInCategory));
+    prioritySplitters.push_back(std::move(prioritySplitter));
+  }
+
+  if (useDomainDecomposition) {
+    thinCategoriesInLatitudeBands(obsData, obsIdsInCategories, prioritySplitters,
+                                  numSpatialDims, numNonspatialDims, isThinned);
+  } else {
+    // Categories are independent of each other, so they are thinned concurrently. Exceptions
+    // must not escape the parallel region; the first one is rethrown afterwards.
+    std::exception_ptr error;
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t category = 0; category < obsIdsInCategories.size(); ++category) {
+      try {
+        thinCategory(obsData, obsIdsInCategories[category], prioritySplitters[category],
+                     numSpatialDims, numNonspatialDims,
+                     {} /* all observations are candidates */, {} /* none retained already */,
+                     isThinned);
+      } catch (...) {
+        #pragma omp critical(PoissonDiskThinningError)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error)
+      std::rethrow_exception(error);
   }
 
   obsAccessor.flagRejectedObservations(isThinned, flagged);
@@ -315,9 +490,13 @@ std::vector<size_t> PoissonDiskThinning::getValidObservationIds(
     // produces the same results regardless of the number of MPI ranks by ordering the observations
     // to be processed as if we were running in serial: by record ID.
     const std::vector<size_t> recordIds = obsAccessor.getRecordIds();
-    std::stable_sort(validObsIds.begin(), validObsIds.end(),
-                     [&recordIds](size_t obsIdA, size_t obsIdB)
-                     { return recordIds[obsIdA] < recordIds[obsIdB]; });
+    const auto byRecordId = [&recordIds](size_t obsIdA, size_t obsIdB)
+                            { return recordIds[obsIdA] < recordIds[obsIdB]; };
+    if (obsAccessor.areObservationsSharedByAllRanks())
+      // All ranks hold the same observations, so they can share the sorting work.
+      stableSortReplicated(validObsIds, obsdb_.comm(), byRecordId);
+    else
+      std::stable_sort(validObsIds.begin(), validObsIds.end(), byRecordId);
   }
 
   return validObsIds;
@@ -369,20 +548,27 @@ void PoissonDiskThinning::thinCategory(const ObsData &obsData,
                                        const RecursiveSplitter &prioritySplitter,
                                        int numSpatialDims,
                                        int numNonspatialDims,
-                                       std::vector<bool> &isThinned) const {
+                                       const std::vector<bool> &isCandidate,
+                                       const std::vector<size_t> &previouslyRetainedObsIds,
+                                       std::vector<char> &isThinned) const {
   switch (numSpatialDims + numNonspatialDims) {
   case 0:
     return;  // nothing to do
   case 1:
-    return thinCategory<1>(obsData, obsIdsInCategory, prioritySplitter, numSpatialDims, isThinned);
+    return thinCategory<1>(obsData, obsIdsInCategory, prioritySplitter, numSpatialDims,
+                           isCandidate, previouslyRetainedObsIds, isThinned);
   case 2:
-    return thinCategory<2>(obsData, obsIdsInCategory, prioritySplitter, numSpatialDims, isThinned);
+    return thinCategory<2>(obsData, obsIdsInCategory, prioritySplitter, numSpatialDims,
+                           isCandidate, previouslyRetainedObsIds, isThinned);
   case 3:
-    return thinCategory<3>(obsData, obsIdsInCategory, prioritySplitter, numSpatialDims, isThinned);
+    return thinCategory<3>(obsData, obsIdsInCategory, prioritySplitter, numSpatialDims,
+                           isCandidate, previouslyRetainedObsIds, isThinned);
   case 4:
-    return thinCategory<4>(obsData, obsIdsInCategory, prioritySplitter, numSpatialDims, isThinned);
+    return thinCategory<4>(obsData, obsIdsInCategory, prioritySplitter, numSpatialDims,
+                           isCandidate, previouslyRetainedObsIds, isThinned);
   case 5:
-    return thinCategory<5>(obsData, obsIdsInCategory, prioritySplitter, numSpatialDims, isThinned);
+    return thinCategory<5>(obsData, obsIdsInCategory, prioritySplitter, numSpatialDims,
+                           isCandidate, previouslyRetainedObsIds, isThinned);
   }
 
   ABORT("Unexpected number of thinning dimensions");
@@ -393,23 +579,117 @@ void PoissonDiskThinning::thinCategory(const ObsData &obsData,
                                        const std::vector<size_t> &obsIdsInCategory,
                                        const RecursiveSplitter &prioritySplitter,
                                        int numSpatialDims,
-                                       std::vector<bool> &isThinned) const {
-  KDTree<numDims> pointIndex;
+                                       const std::vector<bool> &isCandidate,
+                                       const std::vector<size_t> &previouslyRetainedObsIds,
+                                       std::vector<char> &isThinned) const {
+  std::unique_ptr<PointIndex<numDims>> pointIndex;
+  if (options_.pointIndex == PointIndexType::GRID) {
+    // Exclusion volumes of lower-priority observations are the largest, but it's simplest
+    // to find the largest semi-axes by inspecting all observations.
+    std::array<float, numDims> cellSizes;
+    cellSizes.fill(0.0f);
+    for (size_t obsId : obsIdsInCategory) {
+      const std::array<float, numDims> semiAxes =
+          getExclusionVolumeSemiAxes<numDims>(obsId, obsData);
+      for (int d = 0; d < numDims; ++d)
+        cellSizes[d] = std::max(cellSizes[d], semiAxes[d]);
+    }
+    pointIndex.reset(new GridIndex<numDims>(cellSizes));
+  } else {
+    pointIndex.reset(new KDTree<numDims>());
+  }
+
+  for (size_t obsId : previouslyRetainedObsIds)
+    pointIndex->insert(getObservationPosition<numDims>(obsId, obsData));
 
   for (auto priorityGroup : prioritySplitter.groups()) {
     for (size_t obsIndex : priorityGroup) {
       const size_t obsId = obsIdsInCategory[obsIndex];
+      if (!isCandidate.empty() && !isCandidate[obsId])
+        continue;
       std::array<float, numDims> point = getObservationPosition<numDims>(obsId, obsData);
       std::array<float, numDims> semiAxes = getExclusionVolumeSemiAxes<numDims>(obsId, obsData);
       if ((options_.exclusionVolumeShape == ExclusionVolumeShape::CYLINDER &&
-           pointIndex.isAnyPointInCylinderInterior(point, semiAxes, numSpatialDims)) ||
+           pointIndex->isAnyPointInCylinderInterior(point, semiAxes, numSpatialDims)) ||
           (options_.exclusionVolumeShape == ExclusionVolumeShape::ELLIPSOID &&
-           pointIndex.isAnyPointInEllipsoidInterior(point, semiAxes))) {
+           pointIndex->isAnyPointInEllipsoidInterior(point, semiAxes))) {
         isThinned[obsId] = true;
       } else {
-        pointIndex.insert(point);
+        pointIndex->insert(point);
+      }
+    }
+  }
+}
+
+void PoissonDiskThinning::thinCategoriesInLatitudeBands(
+    const ObsData &obsData,
+    const std::vector<std::vector<size_t>> &obsIdsInCategories,
+    const std::vector<RecursiveSplitter> &prioritySplitters,
+    int numSpatialDims,
+    int numNonspatialDims,
+    std::vector<char> &isThinned) const {
+  const eckit::mpi::Comm &comm = obsdb_.comm();
+  const int numRanks = comm.size();
+  const int rank = comm.rank();
+
+  // The largest horizontal exclusion volume is that of the lowest-priority observations.
+  float maxHorizontalSpacing = 0.0f;
+  if (obsData.minHorizontalSpacings->isScalar()) {
+    maxHorizontalSpacing = obsData.minHorizontalSpacings->at(0);
+  } else {
+    for (const auto &prioritySpacing : *obsData.minHorizontalSpacings)
+      maxHorizontalSpacing = std::max(maxHorizontalSpacing, prioritySpacing.second);
+  }
+
+  // Observations whose latitudes differ by at least haloWidth (in degrees) are separated by at
+  // least maxHorizontalSpacing, so they can't lie in each other's exclusion volumes.
+  const float haloWidth = static_cast<float>(
+        maxHorizontalSpacing / Constants::mean_earth_rad * Constants::rad2deg) * 1.001f;
+  int numBands = 2 * numRanks;
+  if (haloWidth > 0)
+    numBands = std::max(1, std::min(numBands, static_cast<int>(180.0f / haloWidth)));
+  const float bandWidth = 180.0f / numBands;
+  auto bandOwner = [numRanks](int band) { return band % numRanks; };
+
+  const std::vector<float> &latitudes = *obsData.latitudes;
+  std::vector<int> bands(latitudes.size());
+  for (size_t obsId = 0; obsId < latitudes.size(); ++obsId)
+    bands[obsId] = latitudeBand(latitudes[obsId], numBands);
+
+  std::vector<bool> isCandidate(latitudes.size());
+  for (int parity = 0; parity < 2; ++parity) {
+    for (size_t category = 0; category < obsIdsInCategories.size(); ++category) {
+      const std::vector<size_t> &obsIdsInCategory = obsIdsInCategories[category];
+
+      std::fill(isCandidate.begin(), isCandidate.end(), false);
+      std::vector<size_t> previouslyRetainedObsIds;
+      for (size_t obsId : obsIdsInCategory) {
+        const int band = bands[obsId];
+        if (band % 2 == parity) {
+          isCandidate[obsId] = bandOwner(band) == rank;
+        } else if (parity == 1 && !isThinned[obsId]) {
+          // Observation retained in the first stage. Keep it if it lies in the halo of
+          // an odd-numbered band owned by this rank.
+          const float bandStart = -90.0f + band * bandWidth;
+          const float bandEnd = bandStart + bandWidth;
+          if ((band > 0 && bandOwner(band - 1) == rank &&
+               latitudes[obsId] < bandStart + haloWidth) ||
+              (band + 1 < numBands && bandOwner(band + 1) == rank &&
+               latitudes[obsId] >= bandEnd - haloWidth))
+            previouslyRetainedObsIds.push_back(obsId);
+        }
       }
+
+      thinCategory(obsData, obsIdsInCategory, prioritySplitters[category],
+                   numSpatialDims, numNonspatialDims, isCandidate, previouslyRetainedObsIds,
+                   isThinned);
     }
+
+    // Each observation has been processed by one rank only; share the results.
+    std::vector<int> isThinnedOnAnyRank(isThinned.begin(), isThinned.end());
+    comm.allReduceInPlace(isThinnedOnAnyRank.begin(), isThinnedOnAnyRank.end(),
+                          eckit::mpi::max());
+    std::copy(isThinnedOnAnyRank.begin(), isThinnedOnAnyRank.end(), isThinned.begin());
   }
 }
 
@@ -93,20 +93,45 @@ class PoissonDiskThinning : public FilterBase,
                                    const ObsAccessor &obsAccessor,
                                    RecursiveSplitter &splitter) const;
 
+  /// Thin observations belonging to a single category.
+  ///
+  /// \param isCandidate
+  ///   If non-empty, a vector indexed by observation IDs indicating which observations from
+  ///   \p obsIdsInCategory should be considered for retention. Other observations are left
+  ///   untouched.
+  /// \param previouslyRetainedObsIds
+  ///   IDs of observations retained earlier, whose exclusion volumes must be respected.
+  /// \param isThinned
+  ///   Vector indexed by observation IDs; the elements corresponding to the observations thinned
+  ///   are set to true. Only elements corresponding to observations from \p obsIdsInCategory are
+  ///   accessed, so different categories may be thinned concurrently (this is why the vector is
+  ///   not a std::vector<bool>).
   void thinCategory(const ObsData &obsData,
                     const std::vector<size_t> &obsIdsInCategory,
                     const RecursiveSplitter &prioritySplitter,
                     int numSpatialDims,
                     int numNonspatialDims,
-                    std::vector<bool> &isThinned) const;
+                    const std::vector<bool> &isCandidate,
+                    const std::vector<size_t> &previouslyRetainedObsIds,
+                    std::vector<char> &isThinned) const;
 
-  /// Thin observations belonging to a single category.
   template <int numDims>
   void thinCategory(const ObsData &obsData,
                     const std::vector<size_t> &obsIdsInCategory,
                     const RecursiveSplitter &prioritySplitter,
                     int numSpatialDims,
-                    std::vector<bool> &isThinned) const;
+                    const std::vector<bool> &isCandidate,
+                    const std::vector<size_t> &previouslyRetainedObsIds,
+                    std::vector<char> &isThinned) const;
+
+  /// Thin observations from all categories, dividing the work between MPI ranks by
+  /// latitude bands (see the domain_decomposition option).
+  void thinCategoriesInLatitudeBands(const ObsData &obsData,
+                                     const std::vector<std::vector<size_t>> &obsIdsInCategories,
+                                     const std::vector<RecursiveSplitter> &prioritySplitters,
+                                     int numSpatialDims,
+                                     int numNonspatialDims,
+                                     std::vector<char> &isThinned) const;
 
   template <int numDims>
   std::array<float, numDims> getObservationPosition(
@@ -13,4 +13,7 @@ namespace ufo {
 constexpr char ExclusionVolumeShapeParameterTraitsHelper::enumTypeName[];
 constexpr util::NamedEnumerator<ExclusionVolumeShape>
   ExclusionVolumeShapeParameterTraitsHelper::namedValues[];
+constexpr char PointIndexTypeParameterTraitsHelper::enumTypeName[];
+constexpr util::NamedEnumerator<PointIndexType>
+  PointIndexTypeParameterTraitsHelper::namedValues[];
 }  // namespace ufo
@@ -35,6 +35,19 @@ struct ExclusionVolumeShapeParameterTraitsHelper {
   };
 };
 
+enum class PointIndexType {
+  KD_TREE, GRID
+};
+
+struct PointIndexTypeParameterTraitsHelper {
+  typedef PointIndexType EnumType;
+  static constexpr char enumTypeName[] = "PointIndexType";
+  static constexpr util::NamedEnumerator<PointIndexType> namedValues[] = {
+    { PointIndexType::KD_TREE, "kd_tree" },
+    { PointIndexType::GRID, "grid" }
+  };
+};
+
 }  // namespace ufo
 
 namespace oops {
@@ -44,6 +57,11 @@ struct ParameterTraits<ufo::ExclusionVolumeShape> :
     public EnumParameterTraits<ufo::ExclusionVolumeShapeParameterTraitsHelper>
 {};
 
+template <>
+struct ParameterTraits<ufo::PointIndexType> :
+    public EnumParameterTraits<ufo::PointIndexTypeParameterTraitsHelper>
+{};
+
 }  // namespace oops
 
 namespace ufo {
@@ -122,6 +140,35 @@ class PoissonDiskThinningParameters : public FilterParametersBase {
   oops::Parameter<ExclusionVolumeShape> exclusionVolumeShape{"exclusion_volume_shape",
                                                              ExclusionVolumeShape::CYLINDER, this};
 
+  // Implementation
+
+  /// Data structure used to find retained observations lying close to each candidate.
+  ///
+  /// Allowed values:
+  /// - \c kd_tree: a kd-tree.
+  /// - \c grid: a hash table of cells of a uniform grid whose spacing in each direction is the
+  ///   largest size of the exclusion volume in that direction. Usually faster than the kd-tree if
+  ///   all observations have exclusion volumes of similar sizes and the spacing of observations
+  ///   isn't much smaller than the exclusion volume size. Exclusion volumes with a zero extent
+  ///   in any direction are treated as empty.
+  oops::Parameter<PointIndexType> pointIndex{"point_index", PointIndexType::KD_TREE, this};
+
+  /// If true and min_horizontal_spacing is set, observations thinned together but held on
+  /// different MPI ranks are not all thinned on every rank. Instead, the globe is divided into
+  /// latitude bands at least as wide as the largest horizontal exclusion volume, which are
+  /// assigned to ranks in a round-robin fashion. In the first stage each rank thins the
+  /// observations lying in its even-numbered bands; in the second it thins those lying in its
+  /// odd-numbered bands, taking into account the observations retained in the first stage in
+  /// the halo surrounding each band. Bands thinned in the same stage are separated by at least
+  /// the exclusion volume size, so that observations retained in the end still satisfy the
+  /// spacing constraints, but the set of retained observations generally differs from that
+  /// obtained with this option disabled (observations from even-numbered bands are given
+  /// precedence over those from odd-numbered bands lying close to band boundaries).
+  ///
+  /// Has no effect if each group of observations thinned together is held on a single rank
+  /// (see category_variable).
+  oops::Parameter<bool> domainDecomposition{"domain_decomposition", false, this};
+
   // Observation categories
 
   /// A string-valued or integer-valued variable. Observations with different values of that
@@ -6,10 +6,18 @@
  */
 
 #include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/mpi/Comm.h"
 
 #include "ioda/ObsDataVector.h"
 #include "ioda/ObsSpace.h"
@@ -18,9 +26,67 @@
 #include "oops/util/missingValues.h"
 
 #include "ufo/filters/PrintFilterData.h"
+#include "ufo/utils/BackgroundTaskQueue.h"
+#include "ufo/utils/LogUtils.h"
 
 namespace ufo {
 
+namespace {
+
+void writeCount(std::ostream & os, std::uint64_t count) {
+  os.write(reinterpret_cast<const char *>(&count), sizeof(count));
+}
+
+void writeString(std::ostream & os, const std::string & str) {
+  writeCount(os, str.size());
+  os.write(str.data(), str.size());
+}
+
+/// Writes a vector of filter data in the format described in the documentation of the
+/// `binary output file` option.
+class BinaryWriteVisitor : public boost::static_visitor<void> {
+ public:
+  explicit BinaryWriteVisitor(std::ostream & os) : os_(os) {}
+
+  void operator()(const std::vector<int> & values) const {
+    writeValues('i', values);
+  }
+
+  void operator()(const std::vector<float> & values) const {
+    writeValues('f', values);
+  }
+
+  void operator()(const std::vector<std::string> & values) const {
+    os_.put('s');
+    writeCount(os_, values.size());
+    for (const std::string & value : values)
+      writeString(os_, value);
+  }
+
+  void operator()(const std::vector<util::DateTime> & values) const {
+    os_.put('d');
+    writeCount(os_, values.size());
+    for (const util::DateTime & value : values)
+      writeString(os_, value.toString());
+  }
+
+  void operator()(const std::vector<bool> & values) const {
+    writeValues('b', std::vector<std::int32_t>(values.begin(), values.end()));
+  }
+
+ private:
+  template <typename T>
+  void writeValues(char tag, const std::vector<T> & values) const {
+    os_.put(tag);
+    writeCount(os_, values.size());
+    os_.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+  }
+
+  std::ostream & os_;
+};
+
+}  // namespace
+
 PrintFilterData::PrintFilterData(ioda::ObsSpace & obsdb, const Parameters_ & parameters,
                                  std::shared_ptr<ioda::ObsDataVector<int> > flags,
                                  std::shared_ptr<ioda::ObsDataVector<float> > obserr)
@@ -259,6 +325,11 @@ void PrintFilterData::printAllData() const {
   if (!parameters_.printRank0)
     obsdb_.distribution()->allGatherv(globalApply);
 
+  // The data have been gathered on all ranks, but only need to be formatted where they will
+  // be written out.
+  if (!isLogChannelEnabled(oops::Log::info()))
+    return;
+
   // Loop over each group of locations and print the contents of each variable.
   for (int locgroup = locmin; locgroup < locmax; locgroup += nlocsPerRow) {
     // Print table header.
@@ -326,10 +397,46 @@ void PrintFilterData::printAllData() const {
   }
 }
 
+void PrintFilterData::writeBinaryOutput() const {
+  // Rethrow any exception thrown while writing the previous record.
+  if (binaryOutputWritten_.valid())
+    binaryOutputWritten_.get();
+
+  // The filter data are replaced on the next invocation, so the background task takes them over.
+  std::map<std::string, FilterDataVector> data(std::make_move_iterator(filterData_.begin()),
+                                               std::make_move_iterator(filterData_.end()));
+  filterData_.clear();
+  const std::string fileName = *parameters_.binaryOutputFile.value();
+  auto task = [fileName, data = std::move(data)] {
+    std::ofstream os(fileName, std::ios::binary | std::ios::app);
+    if (!os)
+      throw eckit::UserError("PrintFilterData: cannot open " + fileName, Here());
+    writeCount(os, data.size());
+    const BinaryWriteVisitor visitor(os);
+    for (const auto & nameAndValues : data) {
+      writeString(os, nameAndValues.first);
+      boost::apply_visitor(visitor, nameAndValues.second);
+    }
+    if (!os)
+      throw eckit::UserError("PrintFilterData: cannot write " + fileName, Here());
+  };
+  binaryOutputWritten_ = BackgroundTaskQueue::ioQueue().push(std::move(task));
+}
+
 void PrintFilterData::doFilter() const {
   oops::Log::trace() << "PrintFilterData doFilter started" << std::endl;
   oops::Log::debug() << *this;
 
+  // All ranks take part in gathering the data, so skip it only if they would be printed or
+  // written out nowhere.
+  int dataRequired = isLogChannelEnabled(oops::Log::info()) ||
+    (parameters_.binaryOutputFile.value() != boost::none && obsdb_.comm().rank() == 0);
+  obsdb_.comm().allReduceInPlace(dataRequired, eckit::mpi::max());
+  if (!dataRequired) {
+    oops::Log::trace() << "PrintFilterData doFilter finished (nothing to print)" << std::endl;
+    return;
+  }
+
   // Print welcome message.
   oops::Log::info() << std::endl;
   oops::Log::info() << "############################" << std::endl;
@@ -340,15 +447,28 @@ void PrintFilterData::doFilter() const {
   if (parameters_.message.value() != boost::none)
     oops::Log::info() << *parameters_.message.value() << std::endl << std::endl;
 
-  if (parameters_.summary)
+  if (parameters_.summary && isLogChannelEnabled(oops::Log::info()))
     oops::Log::info() << data_;
 
   this->getAllData();
   this->printAllData();
+  if (parameters_.binaryOutputFile.value() != boost::none && obsdb_.comm().rank() == 0)
+    this->writeBinaryOutput();
 
   oops::Log::trace() << "PrintFilterData doFilter finished" << std::endl;
 }
 
+PrintFilterData::~PrintFilterData() {
+  if (binaryOutputWritten_.valid()) {
+    try {
+      binaryOutputWritten_.get();
+    } catch (const std::exception & e) {
+      oops::Log::error() << "PrintFilterData: failed to write the binary output file: "
+                         << e.what() << std::endl;
+    }
+  }
+}
+
 void PrintFilterData::print(std::ostream & os) const {
   os << "PrintFilterData: config = " << parameters_ << std::endl;
 }
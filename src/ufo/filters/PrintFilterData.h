@@ -8,6 +8,7 @@
 #ifndef UFO_FILTERS_PRINTFILTERDATA_H_
 #define UFO_FILTERS_PRINTFILTERDATA_H_
 
+#include <future>
 #include <memory>
 #include <set>
 #include <string>
@@ -112,6 +113,17 @@ class PrintFilterDataParameters : public oops::ObsFilterParametersBase {
   /// retrieved. If the Derived group is not present, data from the original group will then be
   /// retrieved.
   oops::Parameter<bool> skipDerived{"skip derived", true, this};
+
+  /// If set, rank 0 also appends the gathered filter data to a binary file with this name. The
+  /// file is written on a background thread, so the filters that follow do not wait for it.
+  ///
+  /// Each invocation of the filter appends one record made of the number of variables followed
+  /// by, for each variable (in alphabetical order), its name, a type tag ('i' for int, 'f' for
+  /// float, 's' for string, 'd' for datetime and 'b' for bool), the number of values and the
+  /// values. Counts are stored as 64-bit unsigned integers; strings (including names and
+  /// datetimes in ISO 8601 format) are stored as their length followed by their characters;
+  /// bools are stored as 32-bit integers. All numbers are written in the native byte order.
+  oops::OptionalParameter<std::string> binaryOutputFile{"binary output file", this};
 };
 
 /// Type identifier used in calls to getData.
@@ -133,21 +145,27 @@ class PrintFilterData : public ObsProcessorBase,
   PrintFilterData(ioda::ObsSpace & obsdb, const Parameters_ & parameters,
                   std::shared_ptr<ioda::ObsDataVector<int> > flags,
                   std::shared_ptr<ioda::ObsDataVector<float> > obserr);
+  ~PrintFilterData() override;
 
  private:  // variables
   Parameters_ parameters_;
 
+  typedef boost::variant<std::vector <int>,
+                         std::vector <float>,
+                         std::vector <std::string>,
+                         std::vector <util::DateTime>,
+                         std::vector <bool>> FilterDataVector;
+
   /// Collection of filter data.
-  mutable std::unordered_map<std::string, boost::variant
-                             <std::vector <int>,
-                              std::vector <float>,
-                              std::vector <std::string>,
-                              std::vector <util::DateTime>,
-                              std::vector <bool>>> filterData_;
+  mutable std::unordered_map<std::string, FilterDataVector> filterData_;
+
+  /// Completion of the latest write to the binary output file.
+  mutable std::future<void> binaryOutputWritten_;
 
  private:  // functions
   void print(std::ostream &) const override;
   void doFilter() const override;
+  bool modifiesObsSpace() const override {return false;}
 
   /// Get the name of multi-level data at a particular level.
   std::string getVariableNameAtLevel(const std::string & varname, const int level) const;
@@ -181,6 +199,9 @@ class PrintFilterData : public ObsProcessorBase,
   /// Print all data.
   void printAllData() const;
 
+  /// Append the filter data to the binary output file on a background thread.
+  void writeBinaryOutput() const;
+
   /// Print the requested variable.
   /// Specialisation to bool is required because ioda::Distribution does not handle that type.
   template <typename VariableType>
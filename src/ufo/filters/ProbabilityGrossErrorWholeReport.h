@@ -112,6 +112,7 @@ class ProbabilityGrossErrorWholeReport : public FilterBase,
   void applyFilter(const std::vector<bool> &, const Variables &,
                    std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override {return QCflags::bayesianQC;}
+  bool modifiesObsSpace() const override {return true;}
 
   Parameters_ parameters_;
 };
@@ -22,6 +22,7 @@
 
 #include "ufo/filters/getScalarOrFilterData.h"
 #include "ufo/filters/QCflags.h"
+#include "ufo/utils/LogUtils.h"
 
 namespace ufo {
 
@@ -78,25 +79,25 @@ void ProfileBackgroundCheck::applyFilter(const std::vector<bool> & apply,
   // Get the record numbers from the observation data.  These will be used to identify
   // which observations belong to which profile.
   const std::vector<size_t> &unique = obsdb_.recidx_all_recnums();
-  oops::Log::debug() << "Unique record numbers" << std::endl;
-  for (size_t iUnique : unique)
-    oops::Log::debug() << iUnique << ' ';
-  oops::Log::debug() << std::endl;
+  if (isLogChannelEnabled(oops::Log::debug())) {
+    oops::Log::debug() << "Unique record numbers" << std::endl;
+    for (size_t iUnique : unique)
+      oops::Log::debug() << iUnique << ' ';
+    oops::Log::debug() << std::endl;
+  }
 
   // Threshold for all variables
-  std::vector<float> abs_thr(obsdb_.nlocs(), std::numeric_limits<float>::max());
-  std::vector<float> rel_thr(obsdb_.nlocs(), std::numeric_limits<float>::max());
-  if (parameters_.absoluteThreshold.value())
-    abs_thr = getScalarOrFilterData(*parameters_.absoluteThreshold.value(), data_);
-  if (parameters_.relativeThreshold.value())
-    rel_thr = getScalarOrFilterData(*parameters_.relativeThreshold.value(), data_);
+  const ScalarOrFilterData noThreshold(std::numeric_limits<float>::max());
+  const ScalarOrFilterData abs_thr = parameters_.absoluteThreshold.value() ?
+    getScalarOrFilterDataView(*parameters_.absoluteThreshold.value(), data_) : noThreshold;
+  const ScalarOrFilterData rel_thr = parameters_.relativeThreshold.value() ?
+    getScalarOrFilterDataView(*parameters_.relativeThreshold.value(), data_) : noThreshold;
 
   Variables varhofx(filtervars_, "HofX");
   for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
     size_t iv = observed.find(filtervars.variable(jv).variable());
     // H(x)
-    std::vector<float> hofx;
-    data_.get(varhofx.variable(jv), hofx);
+    const ObsFilterDataView<float> hofx = data_.getView<float>(varhofx.variable(jv));
 
     // Loop over the unique profiles
     for (const auto& iprofile : unique) {
@@ -16,6 +16,7 @@
 
 #include "oops/util/Logger.h"
 #include "ufo/filters/QCflags.h"
+#include "ufo/utils/LogUtils.h"
 
 namespace ufo {
 
@@ -55,10 +56,12 @@ void ProfileFewObsCheck::applyFilter(const std::vector<bool> & apply,
   // Get the record numbers from the observation data.  These will be used to identify
   // which observations belong to which profile.
   const std::vector<size_t> & record_numbers = obsdb_.recidx_all_recnums();
-  oops::Log::debug() << "Unique record numbers" << std::endl;
-  for (size_t iProfile : record_numbers)
-    oops::Log::debug() << iProfile << ' ';
-  oops::Log::debug() << std::endl;
+  if (isLogChannelEnabled(oops::Log::debug())) {
+    oops::Log::debug() << "Unique record numbers" << std::endl;
+    for (size_t iProfile : record_numbers)
+      oops::Log::debug() << iProfile << ' ';
+    oops::Log::debug() << std::endl;
+  }
 
   // For each variable, check the number of observations in the profile
   for (size_t iFilterVar = 0; iFilterVar < filtervars.nvars(); ++iFilterVar) {
@@ -0,0 +1,84 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/QCFlagsRegistry.h"
+
+#include <map>
+#include <mutex>
+
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+#include "oops/base/Variables.h"
+#include "ufo/filters/QCflags.h"
+
+namespace ufo {
+
+namespace {
+
+std::mutex & registryMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<const ioda::ObsSpace *, std::weak_ptr<ioda::ObsDataVector<int>>> & registry() {
+  static std::map<const ioda::ObsSpace *, std::weak_ptr<ioda::ObsDataVector<int>>> flags;
+  return flags;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+void QCFlagsRegistry::registerFlags(const ioda::ObsSpace &obsdb,
+                                    const std::shared_ptr<ioda::ObsDataVector<int>> &flags) {
+  std::lock_guard<std::mutex> lock(registryMutex());
+  // Forget flags belonging to ObsSpaces that no longer have any processors.
+  for (auto it = registry().begin(); it != registry().end(); ) {
+    if (it->second.expired())
+      it = registry().erase(it);
+    else
+      ++it;
+  }
+  registry()[&obsdb] = flags;
+}
+
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<const ioda::ObsDataVector<int>> QCFlagsRegistry::flags(
+    const ioda::ObsSpace &obsdb) {
+  std::lock_guard<std::mutex> lock(registryMutex());
+  const auto it = registry().find(&obsdb);
+  if (it == registry().end())
+    return nullptr;
+  return it->second.lock();
+}
+
+// -----------------------------------------------------------------------------
+
+std::vector<int> QCFlagsRegistry::passedMask(const ioda::ObsSpace &obsdb,
+                                             const oops::Variables &vars) {
+  const std::shared_ptr<const ioda::ObsDataVector<int>> qcflags = flags(obsdb);
+  if (!qcflags)
+    return std::vector<int>();
+
+  const size_t nvars = vars.size();
+  const size_t nlocs = obsdb.nlocs();
+  std::vector<int> mask(nvars * nlocs, 1);
+  for (size_t jvar = 0; jvar < nvars; ++jvar) {
+    if (!qcflags->has(vars[jvar]))
+      continue;
+    const ioda::ObsDataRow<int> &varFlags = (*qcflags)[vars[jvar]];
+    for (size_t jloc = 0; jloc < nlocs; ++jloc)
+      if (varFlags[jloc] != QCflags::pass)
+        mask[jloc * nvars + jvar] = 0;
+  }
+  return mask;
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
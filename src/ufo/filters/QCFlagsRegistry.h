@@ -0,0 +1,55 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_QCFLAGSREGISTRY_H_
+#define UFO_FILTERS_QCFLAGSREGISTRY_H_
+
+#include <memory>
+#include <vector>
+
+namespace ioda {
+template <typename DATATYPE> class ObsDataVector;
+class ObsSpace;
+}
+
+namespace oops {
+class Variables;
+}
+
+namespace ufo {
+
+/// \brief Gives observation operators access to the QC flags set by the filters acting on the
+/// same ObsSpace.
+///
+/// \details The QC flags are owned by the filters; each observation processor registers them
+/// when it is constructed (see ObsProcessorBase). Only a weak reference is kept, so the
+/// registry never extends the lifetime of the flags.
+///
+/// Operators can use the flags to avoid simulating values that have already been rejected by
+/// the filters run before the operator (e.g. channels rejected by the prior filters).
+class QCFlagsRegistry {
+ public:
+  /// Register \p flags as the QC flags of observations held in \p obsdb.
+  static void registerFlags(const ioda::ObsSpace &obsdb,
+                            const std::shared_ptr<ioda::ObsDataVector<int>> &flags);
+
+  /// Return the QC flags registered for \p obsdb, or null if there are none.
+  static std::shared_ptr<const ioda::ObsDataVector<int>> flags(const ioda::ObsSpace &obsdb);
+
+  /// \brief Return a mask indicating which of the variables \p vars have not been rejected at
+  /// each location of \p obsdb.
+  ///
+  /// The mask is stored location by location: element `jloc * vars.size() + jvar` is 1 if
+  /// variable \p jvar at location \p jloc has passed QC so far and 0 otherwise. Returns an
+  /// empty vector if no QC flags have been registered for \p obsdb. Variables without QC flags
+  /// are treated as not rejected.
+  static std::vector<int> passedMask(const ioda::ObsSpace &obsdb, const oops::Variables &vars);
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_QCFLAGSREGISTRY_H_
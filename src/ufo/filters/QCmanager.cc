@@ -7,6 +7,8 @@
 
 #include "ufo/filters/QCmanager.h"
 
+#include <algorithm>
+#include <memory>
 #include <numeric>
 #include <string>
 #include <utility>
@@ -160,18 +162,35 @@ void QCmanager::print(std::ostream & os) const {
   const size_t gnlocs = obsdb_.globalNumLocs();
 
   const oops::Variables &allObservedVars = obsdb_.obsvariables();
-
-  for (size_t jvar = 0; jvar < allObservedVars.size(); ++jvar) {
-    std::unique_ptr<ioda::Accumulator<std::vector<size_t>>> accumulator =
-        obsdb_.distribution()->createAccumulator<size_t>(cases.size());
-
+  const size_t nvars = allObservedVars.size();
+  const size_t ncases = cases.size();
+
+  // Map each recognized flag value to the index of the corresponding case.
+  const size_t noCase = ncases;
+  int maxCaseFlag = 0;
+  for (const auto &flagAndDescription : cases)
+    maxCaseFlag = std::max(maxCaseFlag, flagAndDescription.first);
+  std::vector<size_t> caseOfFlag(maxCaseFlag + 1, noCase);
+  for (size_t jcase = 0; jcase < ncases; ++jcase)
+    caseOfFlag[cases[jcase].first] = jcase;
+
+  // Count the observations with each flag for all variables at once, so that only a single
+  // collective reduction is needed.
+  std::unique_ptr<ioda::Accumulator<std::vector<size_t>>> accumulator =
+      obsdb_.distribution()->createAccumulator<size_t>(nvars * ncases);
+  for (size_t jvar = 0; jvar < nvars; ++jvar) {
+    const std::vector<int> &varFlags = (*flags_)[jvar];
     for (size_t jobs = 0; jobs < nlocs; ++jobs) {
-      const int actualFlag = (*flags_)[jvar][jobs];
-      for (size_t jcase = 0; jcase < cases.size(); ++jcase)
-        if (actualFlag == cases[jcase].first)
-          accumulator->addTerm(jobs, jcase, 1);
+      const int actualFlag = varFlags[jobs];
+      if (actualFlag >= 0 && actualFlag <= maxCaseFlag && caseOfFlag[actualFlag] != noCase)
+        accumulator->addTerm(jobs, jvar * ncases + caseOfFlag[actualFlag], 1);
     }
-    const std::vector<std::size_t> counts = accumulator->computeResult();
+  }
+  const std::vector<std::size_t> allCounts = accumulator->computeResult();
+
+  for (size_t jvar = 0; jvar < nvars; ++jvar) {
+    const std::vector<std::size_t> counts(allCounts.begin() + jvar * ncases,
+                                          allCounts.begin() + (jvar + 1) * ncases);
 
     if (obsdb_.comm().rank() == 0) {
       const std::string info = "QC " + flags_->obstype() + " " + allObservedVars[jvar] + ": ";
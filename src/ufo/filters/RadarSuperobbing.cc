@@ -0,0 +1,223 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/RadarSuperobbing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "eckit/exception/Exceptions.h"
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+#include "oops/base/Variables.h"
+#include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
+#include "ufo/filters/ObsAccessor.h"
+#include "ufo/utils/RecursiveSplitter.h"
+
+namespace ufo {
+
+namespace {
+
+/// Return the index of the bin of width \p width containing \p value and add the square of the
+/// distance of \p value from the bin centre, in units of \p width, to \p distanceSquared.
+int binIndex(float value, float width, float &distanceSquared) {
+  const float scaled = value / width;
+  const float index = std::floor(scaled);
+  const float offset = scaled - index - 0.5f;
+  distanceSquared += offset * offset;
+  return static_cast<int>(index);
+}
+
+/// Resolution used to tell apart the elevation angles of different sweeps (degrees).
+constexpr float elevationResolution = 0.01f;
+
+}  // namespace
+
+RadarSuperobbing::RadarSuperobbing(ioda::ObsSpace & obsdb, const Parameters_ & parameters,
+                                   std::shared_ptr<ioda::ObsDataVector<int> > flags,
+                                   std::shared_ptr<ioda::ObsDataVector<float> > obserr)
+  : FilterBase(obsdb, parameters, flags, obserr), options_(parameters)
+{
+  oops::Log::debug() << "RadarSuperobbing: config = " << options_ << std::endl;
+  if (options_.elevationBinWidth.value() != boost::none &&
+      *options_.elevationBinWidth.value() <= 0.0f)
+    throw eckit::BadParameter("RadarSuperobbing: elevation_bin_width must be positive", Here());
+}
+
+// Required for the correct destruction of options_.
+RadarSuperobbing::~RadarSuperobbing()
+{}
+
+void RadarSuperobbing::applyFilter(const std::vector<bool> & apply,
+                                   const Variables & filtervars,
+                                   std::vector<std::vector<bool>> & flagged) const {
+  ObsAccessor obsAccessor = ObsAccessor::toObservationsHeldOnCurrentRank(obsdb_);
+
+  const float missing = util::missingValue(missing);
+  const Variable &rangeVariable = options_.rangeVariable.value();
+  const Variable &azimuthVariable = options_.azimuthVariable.value();
+  const Variable &elevationVariable = options_.elevationVariable.value();
+  const std::vector<float> range = obsAccessor.getFloatVariableFromObsSpace(
+        rangeVariable.group(), rangeVariable.variable());
+  const std::vector<float> azimuth = obsAccessor.getFloatVariableFromObsSpace(
+        azimuthVariable.group(), azimuthVariable.variable());
+  const std::vector<float> elevation = obsAccessor.getFloatVariableFromObsSpace(
+        elevationVariable.group(), elevationVariable.variable());
+
+  // Observations with missing coordinates are left unchanged.
+  std::vector<size_t> validObsIds =
+      obsAccessor.getValidObservationIds(apply, *flags_, filtervars);
+  validObsIds.erase(std::remove_if(validObsIds.begin(), validObsIds.end(),
+                                   [&](size_t obsId) {
+                                     return range[obsId] == missing ||
+                                            azimuth[obsId] == missing ||
+                                            elevation[obsId] == missing;
+                                   }),
+                    validObsIds.end());
+
+  RecursiveSplitter splitter(validObsIds.size());
+  std::vector<float> distancesToBinCenter;
+  groupObservationsByStation(validObsIds, obsAccessor, splitter);
+  groupObservationsByBin(validObsIds, range, azimuth, elevation, splitter, distancesToBinCenter);
+
+  const oops::Variables observed = obsdb_.obsvariables();
+  ioda::ObsDataVector<float> obs(obsdb_, filtervars.toOopsVariables(), "ObsValue");
+  const size_t minNumObsPerBin = options_.minNumObsPerBin.value();
+
+  std::vector<bool> isThinned(obsAccessor.totalNumObservations(), false);
+  size_t numSuperobs = 0;
+  for (auto group : splitter.groups()) {
+    // Retain the observation closest to the bin centre (the first one in case of a tie).
+    size_t numObsInBin = 0;
+    size_t retainedValidObsIndex = 0;
+    float minDistance = std::numeric_limits<float>::max();
+    for (size_t validObsIndex : group) {
+      ++numObsInBin;
+      if (distancesToBinCenter[validObsIndex] < minDistance) {
+        minDistance = distancesToBinCenter[validObsIndex];
+        retainedValidObsIndex = validObsIndex;
+      }
+    }
+    const size_t retainedObsId = validObsIds[retainedValidObsIndex];
+    for (size_t validObsIndex : group)
+      if (validObsIndex != retainedValidObsIndex || numObsInBin < minNumObsPerBin)
+        isThinned[validObsIds[validObsIndex]] = true;
+    if (numObsInBin < minNumObsPerBin || numObsInBin == 1)
+      continue;
+    ++numSuperobs;
+
+    // Average the values and errors of all observations in the bin that passed QC so far.
+    for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
+      const size_t iv = observed.find(filtervars.variable(jv).variable());
+      const std::vector<int> &qcFlags = (*flags_)[iv];
+      std::vector<float> &obsErrors = (*obserr_)[iv];
+      std::vector<float> &obsValues = obs[jv];
+      double sumValues = 0.0;
+      double sumErrors = 0.0;
+      size_t numValid = 0;
+      for (size_t validObsIndex : group) {
+        const size_t obsId = validObsIds[validObsIndex];
+        if (qcFlags[obsId] == QCflags::pass && obsValues[obsId] != missing &&
+            obsErrors[obsId] != missing) {
+          sumValues += obsValues[obsId];
+          sumErrors += obsErrors[obsId];
+          ++numValid;
+        }
+      }
+      if (numValid > 0) {
+        obsValues[retainedObsId] = sumValues / numValid;
+        obsErrors[retainedObsId] = sumErrors / numValid;
+      }
+    }
+  }
+
+  for (size_t jv = 0; jv < filtervars.nvars(); ++jv)
+    obsdb_.put_db("DerivedObsValue", filtervars.variable(jv).variable(), obs[jv]);
+
+  obsAccessor.flagRejectedObservations(isThinned, flagged);
+  oops::Log::debug() << "RadarSuperobbing: " << validObsIds.size() << " observations combined into "
+                     << numSuperobs << " superobservations" << std::endl;
+}
+
+void RadarSuperobbing::groupObservationsByStation(const std::vector<size_t> &validObsIds,
+                                                  const ObsAccessor &obsAccessor,
+                                                  RecursiveSplitter &splitter) const {
+  const Variable &stationVariable = options_.stationVariable.value();
+  switch (obsdb_.dtype(stationVariable.group(), stationVariable.variable())) {
+  case ioda::ObsDtype::Integer:
+    {
+      const std::vector<int> stations = obsAccessor.getIntVariableFromObsSpace(
+            stationVariable.group(), stationVariable.variable());
+      std::vector<int> validObsStations(validObsIds.size());
+      for (size_t i = 0; i < validObsIds.size(); ++i)
+        validObsStations[i] = stations[validObsIds[i]];
+      splitter.groupBy(validObsStations);
+    }
+    break;
+
+  case ioda::ObsDtype::String:
+    {
+      const std::vector<std::string> stations = obsAccessor.getStringVariableFromObsSpace(
+            stationVariable.group(), stationVariable.variable());
+      std::vector<std::string> validObsStations(validObsIds.size());
+      for (size_t i = 0; i < validObsIds.size(); ++i)
+        validObsStations[i] = stations[validObsIds[i]];
+      splitter.groupBy(validObsStations);
+    }
+    break;
+
+  default:
+    throw eckit::UserError(
+          stationVariable.variable() + "@" + stationVariable.group() +
+          " is neither an integer nor a string variable", Here());
+  }
+}
+
+void RadarSuperobbing::groupObservationsByBin(const std::vector<size_t> &validObsIds,
+                                              const std::vector<float> &range,
+                                              const std::vector<float> &azimuth,
+                                              const std::vector<float> &elevation,
+                                              RecursiveSplitter &splitter,
+                                              std::vector<float> &distancesToBinCenter) const {
+  const float rangeBinWidth = options_.rangeBinWidth.value();
+  const float azimuthBinWidth = options_.azimuthBinWidth.value();
+  const boost::optional<float> &elevationBinWidth = options_.elevationBinWidth.value();
+
+  const size_t nvalid = validObsIds.size();
+  std::vector<int> rangeBins(nvalid), azimuthBins(nvalid), elevationBins(nvalid);
+  distancesToBinCenter.assign(nvalid, 0.0f);
+  for (size_t i = 0; i < nvalid; ++i) {
+    const size_t obsId = validObsIds[i];
+    float distanceSquared = 0.0f;
+    rangeBins[i] = binIndex(range[obsId], rangeBinWidth, distanceSquared);
+    float az = std::fmod(azimuth[obsId], 360.0f);
+    if (az < 0.0f)
+      az += 360.0f;
+    azimuthBins[i] = binIndex(az, azimuthBinWidth, distanceSquared);
+    if (elevationBinWidth)
+      elevationBins[i] = binIndex(elevation[obsId], *elevationBinWidth, distanceSquared);
+    else
+      elevationBins[i] = static_cast<int>(std::round(elevation[obsId] / elevationResolution));
+    distancesToBinCenter[i] = std::sqrt(distanceSquared);
+  }
+
+  splitter.groupBy(elevationBins);
+  splitter.groupBy(azimuthBins);
+  splitter.groupBy(rangeBins);
+}
+
+void RadarSuperobbing::print(std::ostream & os) const {
+  os << "RadarSuperobbing: config = " << options_ << std::endl;
+}
+
+}  // namespace ufo
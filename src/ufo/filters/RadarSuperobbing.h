@@ -0,0 +1,88 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_RADARSUPEROBBING_H_
+#define UFO_FILTERS_RADARSUPEROBBING_H_
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "oops/util/ObjectCounter.h"
+#include "ufo/filters/FilterBase.h"
+#include "ufo/filters/QCflags.h"
+#include "ufo/filters/RadarSuperobbingParameters.h"
+
+namespace ioda {
+  template <typename DATATYPE> class ObsDataVector;
+  class ObsSpace;
+}
+
+namespace ufo {
+
+class ObsAccessor;
+class RecursiveSplitter;
+
+/// \brief Combine radar observations lying in the same range-azimuth-elevation bin into a
+/// single superobservation.
+///
+/// The valid observations made by each radar are grouped into bins of the polar coordinates
+/// (range, azimuth and elevation) of the radar's volume scan. In each bin, the observation
+/// lying closest to the bin centre is retained and becomes the superobservation: its values of
+/// the filter variables are replaced by the averages of the values of all observations in the
+/// bin that passed QC so far (and saved in the DerivedObsValue group) and its observation errors
+/// by the averages of their errors. All other observations in the bin are thinned.
+///
+/// Observations are binned separately on each MPI rank. Group the observations into records
+/// by station (using the `obs space.obsdatain.obsgrouping.group variables` option) to make
+/// sure all observations from each radar are combined.
+///
+/// See RadarSuperobbingParameters for the documentation of the available options.
+class RadarSuperobbing : public FilterBase,
+                         private util::ObjectCounter<RadarSuperobbing> {
+ public:
+  typedef RadarSuperobbingParameters Parameters_;
+
+  static const std::string classname() {return "ufo::RadarSuperobbing";}
+
+  RadarSuperobbing(ioda::ObsSpace &obsdb, const Parameters_ &parameters,
+                   std::shared_ptr<ioda::ObsDataVector<int> > flags,
+                   std::shared_ptr<ioda::ObsDataVector<float> > obserr);
+
+  ~RadarSuperobbing() override;
+
+ private:
+  void print(std::ostream &) const override;
+  void applyFilter(const std::vector<bool> &, const Variables &,
+                   std::vector<std::vector<bool>> &) const override;
+  int qcFlag() const override { return QCflags::thinned; }
+  bool modifiesObsSpace() const override {return true;}
+
+  /// Split the groups of observations with IDs \p validObsIds into groups of observations lying
+  /// in the same bin of \p range, \p azimuth and \p elevation. On output,
+  /// \p distancesToBinCenter holds the distance of each of these observations from the centre
+  /// of its bin, in units of the bin widths.
+  void groupObservationsByBin(const std::vector<size_t> &validObsIds,
+                              const std::vector<float> &range,
+                              const std::vector<float> &azimuth,
+                              const std::vector<float> &elevation,
+                              RecursiveSplitter &splitter,
+                              std::vector<float> &distancesToBinCenter) const;
+
+  /// Group the observations with IDs \p validObsIds by the values of the station variable.
+  void groupObservationsByStation(const std::vector<size_t> &validObsIds,
+                                  const ObsAccessor &obsAccessor,
+                                  RecursiveSplitter &splitter) const;
+
+ private:
+  Parameters_ options_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_RADARSUPEROBBING_H_
@@ -0,0 +1,59 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_RADARSUPEROBBINGPARAMETERS_H_
+#define UFO_FILTERS_RADARSUPEROBBINGPARAMETERS_H_
+
+#include "oops/util/parameters/NumericConstraints.h"
+#include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/RequiredParameter.h"
+#include "ufo/filters/FilterParametersBase.h"
+#include "ufo/filters/Variable.h"
+#include "ufo/utils/parameters/ParameterTraitsVariable.h"
+
+namespace ufo {
+
+/// \brief Options controlling the operation of the RadarSuperobbing filter.
+class RadarSuperobbingParameters : public FilterParametersBase {
+  OOPS_CONCRETE_PARAMETERS(RadarSuperobbingParameters, FilterParametersBase)
+
+ public:
+  /// A string- or integer-valued variable identifying the radar that made each observation.
+  /// Observations from different radars are never combined.
+  oops::RequiredParameter<Variable> stationVariable{"station_variable", this};
+
+  /// Variable storing the distance of each gate from the radar along the beam (m).
+  oops::RequiredParameter<Variable> rangeVariable{"range_variable", this};
+
+  /// Variable storing the azimuth of the beam (degrees clockwise from north).
+  oops::RequiredParameter<Variable> azimuthVariable{"azimuth_variable", this};
+
+  /// Variable storing the elevation angle of the beam (degrees).
+  oops::RequiredParameter<Variable> elevationVariable{"elevation_variable", this};
+
+  /// Width of the range bins (m).
+  oops::Parameter<float> rangeBinWidth{"range_bin_width", 5000.0f, this,
+                                       {oops::exclusiveMinConstraint(0.0f)}};
+
+  /// Width of the azimuth bins (degrees).
+  oops::Parameter<float> azimuthBinWidth{"azimuth_bin_width", 5.0f, this,
+                                         {oops::exclusiveMinConstraint(0.0f)}};
+
+  /// Width of the elevation bins (degrees). If not set, observations are only combined with
+  /// observations made at the same elevation angle (to within 0.01 degrees), i.e. in the same
+  /// sweep of a volume scan.
+  oops::OptionalParameter<float> elevationBinWidth{"elevation_bin_width", this};
+
+  /// Bins containing fewer valid observations are rejected as a whole.
+  oops::Parameter<int> minNumObsPerBin{"min_num_obs_per_bin", 1, this,
+                                       {oops::minConstraint(1)}};
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_RADARSUPEROBBINGPARAMETERS_H_
@@ -84,6 +84,7 @@ class SatName : public FilterBase,
   void applyFilter(const std::vector<bool> &, const Variables &,
   std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override {return QCflags::pass;}
+  bool modifiesObsSpace() const override {return true;}
   Parameters_ parameters_;
 };
 }  // namespace ufo
@@ -0,0 +1,168 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/SatelliteSuperobbing.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+#include "oops/base/Variables.h"
+#include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
+#include "ufo/filters/ObsAccessor.h"
+#include "ufo/utils/RecursiveSplitter.h"
+
+namespace ufo {
+
+namespace {
+
+/// Return the index of the box of \p boxSize consecutive integers containing \p value and add
+/// the square of the distance of \p value from the box centre, in units of \p boxSize,
+/// to \p distanceSquared.
+int boxIndex(int value, int boxSize, float &distanceSquared) {
+  // Round towards minus infinity.
+  const int index = value >= 0 ? value / boxSize : -((-value - 1) / boxSize) - 1;
+  const float offset = (value - index * boxSize - 0.5f * (boxSize - 1)) / boxSize;
+  distanceSquared += offset * offset;
+  return index;
+}
+
+}  // namespace
+
+SatelliteSuperobbing::SatelliteSuperobbing(ioda::ObsSpace & obsdb,
+                                           const Parameters_ & parameters,
+                                           std::shared_ptr<ioda::ObsDataVector<int> > flags,
+                                           std::shared_ptr<ioda::ObsDataVector<float> > obserr)
+  : FilterBase(obsdb, parameters, flags, obserr), options_(parameters)
+{
+  oops::Log::debug() << "SatelliteSuperobbing: config = " << options_ << std::endl;
+}
+
+// Required for the correct destruction of options_.
+SatelliteSuperobbing::~SatelliteSuperobbing()
+{}
+
+void SatelliteSuperobbing::applyFilter(const std::vector<bool> & apply,
+                                       const Variables & filtervars,
+                                       std::vector<std::vector<bool>> & flagged) const {
+  ObsAccessor obsAccessor = ObsAccessor::toObservationsHeldOnCurrentRank(obsdb_);
+
+  const int missingInt = util::missingValue(missingInt);
+  const Variable &scanPositionVariable = options_.scanPositionVariable.value();
+  const std::vector<int> scanPositions = obsAccessor.getIntVariableFromObsSpace(
+        scanPositionVariable.group(), scanPositionVariable.variable());
+  const std::vector<int> scanLines = getScanLines(obsAccessor);
+
+  // Observations with missing scan positions or lines are left unchanged.
+  std::vector<size_t> validObsIds =
+      obsAccessor.getValidObservationIds(apply, *flags_, filtervars);
+  validObsIds.erase(std::remove_if(validObsIds.begin(), validObsIds.end(),
+                                   [&](size_t obsId) {
+                                     return scanPositions[obsId] == missingInt ||
+                                            scanLines[obsId] == missingInt;
+                                   }),
+                    validObsIds.end());
+
+  // Split the observations into boxes.
+  const int scanPositionBoxSize = options_.scanPositionBoxSize.value();
+  const int scanLineBoxSize = options_.scanLineBoxSize.value();
+  const size_t nvalid = validObsIds.size();
+  std::vector<int> scanPositionBoxes(nvalid), scanLineBoxes(nvalid);
+  std::vector<float> distancesToBoxCenter(nvalid);
+  for (size_t i = 0; i < nvalid; ++i) {
+    const size_t obsId = validObsIds[i];
+    float distanceSquared = 0.0f;
+    scanLineBoxes[i] = boxIndex(scanLines[obsId], scanLineBoxSize, distanceSquared);
+    scanPositionBoxes[i] = boxIndex(scanPositions[obsId], scanPositionBoxSize, distanceSquared);
+    distancesToBoxCenter[i] = distanceSquared;
+  }
+  RecursiveSplitter splitter(nvalid);
+  splitter.groupBy(scanLineBoxes);
+  splitter.groupBy(scanPositionBoxes);
+
+  const float missing = util::missingValue(missing);
+  const oops::Variables observed = obsdb_.obsvariables();
+  ioda::ObsDataVector<float> obs(obsdb_, filtervars.toOopsVariables(), "ObsValue");
+  const size_t minNumObsPerBox = options_.minNumObsPerBox.value();
+
+  std::vector<bool> isThinned(obsAccessor.totalNumObservations(), false);
+  size_t numSuperobs = 0;
+  for (auto group : splitter.groups()) {
+    // Retain the observation closest to the box centre (the first one in case of a tie).
+    size_t numObsInBox = 0;
+    size_t retainedValidObsIndex = 0;
+    float minDistance = std::numeric_limits<float>::max();
+    for (size_t validObsIndex : group) {
+      ++numObsInBox;
+      if (distancesToBoxCenter[validObsIndex] < minDistance) {
+        minDistance = distancesToBoxCenter[validObsIndex];
+        retainedValidObsIndex = validObsIndex;
+      }
+    }
+    const size_t retainedObsId = validObsIds[retainedValidObsIndex];
+    for (size_t validObsIndex : group)
+      if (validObsIndex != retainedValidObsIndex || numObsInBox < minNumObsPerBox)
+        isThinned[validObsIds[validObsIndex]] = true;
+    if (numObsInBox < minNumObsPerBox || numObsInBox == 1)
+      continue;
+    ++numSuperobs;
+
+    // Average the values and errors of all observations in the box that passed QC so far
+    // (separately for each channel).
+    for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
+      const size_t iv = observed.find(filtervars.variable(jv).variable());
+      const std::vector<int> &qcFlags = (*flags_)[iv];
+      std::vector<float> &obsErrors = (*obserr_)[iv];
+      std::vector<float> &obsValues = obs[jv];
+      double sumValues = 0.0;
+      double sumErrors = 0.0;
+      size_t numValid = 0;
+      for (size_t validObsIndex : group) {
+        const size_t obsId = validObsIds[validObsIndex];
+        if (qcFlags[obsId] == QCflags::pass && obsValues[obsId] != missing &&
+            obsErrors[obsId] != missing) {
+          sumValues += obsValues[obsId];
+          sumErrors += obsErrors[obsId];
+          ++numValid;
+        }
+      }
+      if (numValid > 0) {
+        obsValues[retainedObsId] = sumValues / numValid;
+        obsErrors[retainedObsId] = sumErrors / numValid;
+      }
+    }
+  }
+
+  for (size_t jv = 0; jv < filtervars.nvars(); ++jv)
+    obsdb_.put_db("DerivedObsValue", filtervars.variable(jv).variable(), obs[jv]);
+
+  obsAccessor.flagRejectedObservations(isThinned, flagged);
+  oops::Log::debug() << "SatelliteSuperobbing: " << nvalid << " observations combined into "
+                     << numSuperobs << " superobservations" << std::endl;
+}
+
+std::vector<int> SatelliteSuperobbing::getScanLines(const ObsAccessor &obsAccessor) const {
+  const boost::optional<Variable> &scanLineVariable = options_.scanLineVariable.value();
+  if (scanLineVariable)
+    return obsAccessor.getIntVariableFromObsSpace(scanLineVariable->group(),
+                                                  scanLineVariable->variable());
+
+  const std::vector<size_t> &recnum = obsdb_.recnum();
+  return std::vector<int>(recnum.begin(), recnum.end());
+}
+
+void SatelliteSuperobbing::print(std::ostream & os) const {
+  os << "SatelliteSuperobbing: config = " << options_ << std::endl;
+}
+
+}  // namespace ufo
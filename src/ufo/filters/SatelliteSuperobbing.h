@@ -0,0 +1,75 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_SATELLITESUPEROBBING_H_
+#define UFO_FILTERS_SATELLITESUPEROBBING_H_
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "oops/util/ObjectCounter.h"
+#include "ufo/filters/FilterBase.h"
+#include "ufo/filters/QCflags.h"
+#include "ufo/filters/SatelliteSuperobbingParameters.h"
+
+namespace ioda {
+  template <typename DATATYPE> class ObsDataVector;
+  class ObsSpace;
+}
+
+namespace ufo {
+
+class ObsAccessor;
+
+/// \brief Combine neighbouring fields of view of a scanning satellite instrument into
+/// superobservations.
+///
+/// The valid observations are grouped into boxes of `scan_line_box_size` consecutive scan lines
+/// and `scan_position_box_size` consecutive scan positions. In each box, the observation lying
+/// closest to the box centre is retained and becomes the superobservation: its values of the
+/// filter variables (e.g. the brightness temperatures of all channels) are replaced by the
+/// averages of the values of all observations in the box that passed QC so far (and saved in
+/// the DerivedObsValue group) and its observation errors by the averages of their errors. All
+/// other observations in the box are thinned.
+///
+/// Observations are boxed separately on each MPI rank, so the observations should be grouped
+/// into records by scan line (as is also needed if the scan line numbers are taken from the
+/// record numbers).
+///
+/// See SatelliteSuperobbingParameters for the documentation of the available options.
+class SatelliteSuperobbing : public FilterBase,
+                             private util::ObjectCounter<SatelliteSuperobbing> {
+ public:
+  typedef SatelliteSuperobbingParameters Parameters_;
+
+  static const std::string classname() {return "ufo::SatelliteSuperobbing";}
+
+  SatelliteSuperobbing(ioda::ObsSpace &obsdb, const Parameters_ &parameters,
+                       std::shared_ptr<ioda::ObsDataVector<int> > flags,
+                       std::shared_ptr<ioda::ObsDataVector<float> > obserr);
+
+  ~SatelliteSuperobbing() override;
+
+ private:
+  void print(std::ostream &) const override;
+  void applyFilter(const std::vector<bool> &, const Variables &,
+                   std::vector<std::vector<bool>> &) const override;
+  int qcFlag() const override { return QCflags::thinned; }
+  bool modifiesObsSpace() const override {return true;}
+
+  /// Return the scan line number of each observation.
+  std::vector<int> getScanLines(const ObsAccessor &obsAccessor) const;
+
+ private:
+  Parameters_ options_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_SATELLITESUPEROBBING_H_
@@ -0,0 +1,50 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_SATELLITESUPEROBBINGPARAMETERS_H_
+#define UFO_FILTERS_SATELLITESUPEROBBINGPARAMETERS_H_
+
+#include "oops/util/parameters/NumericConstraints.h"
+#include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/RequiredParameter.h"
+#include "ufo/filters/FilterParametersBase.h"
+#include "ufo/filters/Variable.h"
+#include "ufo/utils/parameters/ParameterTraitsVariable.h"
+
+namespace ufo {
+
+/// \brief Options controlling the operation of the SatelliteSuperobbing filter.
+class SatelliteSuperobbingParameters : public FilterParametersBase {
+  OOPS_CONCRETE_PARAMETERS(SatelliteSuperobbingParameters, FilterParametersBase)
+
+ public:
+  /// An integer-valued variable storing the position of each field of view in its scan line
+  /// (e.g. set by the RemapScanPosition variable transform).
+  oops::RequiredParameter<Variable> scanPositionVariable{"scan_position_variable", this};
+
+  /// An integer-valued variable storing the number of the scan line of each field of view.
+  /// If not set, the observations are expected to be grouped into records by scan line and the
+  /// record numbers are used instead.
+  oops::OptionalParameter<Variable> scanLineVariable{"scan_line_variable", this};
+
+  /// Number of consecutive scan positions combined into a superobservation.
+  oops::Parameter<int> scanPositionBoxSize{"scan_position_box_size", 3, this,
+                                           {oops::minConstraint(1)}};
+
+  /// Number of consecutive scan lines combined into a superobservation.
+  oops::Parameter<int> scanLineBoxSize{"scan_line_box_size", 3, this,
+                                       {oops::minConstraint(1)}};
+
+  /// Boxes containing fewer valid observations are rejected as a whole.
+  oops::Parameter<int> minNumObsPerBox{"min_num_obs_per_box", 1, this,
+                                       {oops::minConstraint(1)}};
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_SATELLITESUPEROBBINGPARAMETERS_H_
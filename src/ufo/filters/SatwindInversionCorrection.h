@@ -82,6 +82,7 @@ class SatwindInversionCorrection : public FilterBase,
   void applyFilter(const std::vector<bool> &, const Variables &,
                    std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override {return QCflags::pass;}
+  bool modifiesObsSpace() const override {return true;}
 
   Parameters_ parameters_;
 };
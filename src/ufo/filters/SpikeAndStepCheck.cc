@@ -114,37 +114,39 @@ void SpikeAndStepCheck::applyFilter(const std::vector<bool> & apply,
     obsAccessor.getFloatVariableFromObsSpace(parameters_.xVar.value().group(),
                                              xVarName);
 
-  std::vector<bool> isThinned(totalNumObs, false);
-  std::vector<bool> spikeFlag(totalNumObs, false);
-  std::vector<bool> stepFlag(totalNumObs, false);
+  std::vector<bool> spikeFlagBool(totalNumObs, false);
+  std::vector<bool> stepFlagBool(totalNumObs, false);
   // get diagnostic flags from ObsSpace (can't create them in the code, must do in YAML...
   //  ...must be there when ObsSpace constructed)
   if (obsdb_.has("DiagnosticFlags/spike", yVarName)) {
-    obsdb_.get_db("DiagnosticFlags/spike", yVarName, spikeFlag);
+    obsdb_.get_db("DiagnosticFlags/spike", yVarName, spikeFlagBool);
   } else {
     throw eckit::UserError("Variable 'DiagnosticFlags/spike/" + yVarName + "' does not exist yet. "
                            "It needs to be set up with the 'Create Diagnostic Flags' filter "
                            "prior to using the 'set' or 'unset' action.");
   }
   if (obsdb_.has("DiagnosticFlags/step", yVarName)) {
-    obsdb_.get_db("DiagnosticFlags/step", yVarName, stepFlag);
+    obsdb_.get_db("DiagnosticFlags/step", yVarName, stepFlagBool);
   } else {
     throw eckit::UserError("Variable 'DiagnosticFlags/step/" + yVarName + "' does not exist yet. "
                            "It needs to be set up with the 'Create Diagnostic Flags' filter "
                            "prior to using the 'set' or 'unset' action.");
   }
-  // Get vector of all record numbers:
-  const std::vector<size_t> & record_numbers = obsdb_.recidx_all_recnums();
-  // Loop over record numbers (i.e. profile to profile):
-  for (size_t iProfile : record_numbers) {
-    // Get non-missing where-included obs indices for this profile
-    // (candidateForRetentionIfAnyFilterVariablesPassedQC false - i.e. unselect location
-    //  if any filter variable fails QC):
-    const std::vector<size_t> obs_indices = obsAccessor.getValidObsIdsInProfile(iProfile,
-                                                                                apply,
-                                                                                *flags_,
-                                                                                filtervars,
-                                                                                false);
+  // Get non-missing where-included obs indices for each profile
+  // (candidateForRetentionIfAnyFilterVariablesPassedQC false - i.e. unselect location
+  //  if any filter variable fails QC):
+  const std::vector<std::vector<size_t>> obsIndicesInProfiles =
+      obsAccessor.getValidObsIdsInProfiles(apply, *flags_, filtervars, false);
+
+  // Profiles are independent of each other, so they are checked concurrently. Each observation
+  // belongs to a single profile, so threads write to disjoint elements of the flag vectors
+  // (which are therefore not std::vector<bool>s).
+  std::vector<char> isThinned(totalNumObs, false);
+  std::vector<char> spikeFlag(spikeFlagBool.begin(), spikeFlagBool.end());
+  std::vector<char> stepFlag(stepFlagBool.begin(), stepFlagBool.end());
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t iProfile = 0; iProfile < obsIndicesInProfiles.size(); ++iProfile) {
+    const std::vector<size_t> &obs_indices = obsIndicesInProfiles[iProfile];
     // Struct of y, x, dy, dx, dy/dx:
     xyStruct xy;
 
@@ -170,8 +172,10 @@ void SpikeAndStepCheck::applyFilter(const std::vector<bool> & apply,
                                 parameters_);
   }  // for each record
   obsAccessor.flagRejectedObservations(isThinned, flagged);
-  obsdb_.put_db("DiagnosticFlags/spike", yVarName, spikeFlag);
-  obsdb_.put_db("DiagnosticFlags/step", yVarName, stepFlag);
+  spikeFlagBool.assign(spikeFlag.begin(), spikeFlag.end());
+  stepFlagBool.assign(stepFlag.begin(), stepFlag.end());
+  obsdb_.put_db("DiagnosticFlags/spike", yVarName, spikeFlagBool);
+  obsdb_.put_db("DiagnosticFlags/step", yVarName, stepFlagBool);
 }
 
 // -----------------------------------------------------------------------------
@@ -303,9 +307,9 @@ std::vector<float> SpikeAndStepCheck::set_tolerances(const std::vector<float> &x
 /// Go through the obs in the record (group), finding which are spikes and steps,
 ///  according to given conditions, flag as appropriate, and increment respective counters.
 
-void SpikeAndStepCheck::identifyThinnedObservations(std::vector<bool> &isThinned,
-                                          std::vector<bool> &spikeFlag,
-                                          std::vector<bool> &stepFlag,
+void SpikeAndStepCheck::identifyThinnedObservations(std::vector<char> &isThinned,
+                                          std::vector<char> &spikeFlag,
+                                          std::vector<char> &stepFlag,
                                           xyStruct &xy,
                                           const std::vector<float> &tolerances,
                                           const std::vector<size_t> &obs_indices,
@@ -329,6 +333,7 @@ void SpikeAndStepCheck::identifyThinnedObservations(std::vector<bool> &isThinned
     boundaryRange = parameters_.boundaryOptions.value().value().boundaryRange.value();
     stepTolRange = parameters_.boundaryOptions.value().value().stepTolRange.value();
   }
+  #pragma omp critical(SpikeAndStepCheckLog)
   oops::Log::debug() << "Identifying spikes and steps:" << std::endl;
   size_t lastChecked = 0;
   for (size_t ind = 0; ind < obs_indices.size(); ++ind) {
@@ -342,6 +347,7 @@ void SpikeAndStepCheck::identifyThinnedObservations(std::vector<bool> &isThinned
           isThinned[obs_indices[ind+1]] = true;  // spike
           spikeFlag[obs_indices[ind+1]] = true;
           lastChecked = ind+1;
+          #pragma omp critical(SpikeAndStepCheckLog)
           oops::Log::debug() << "Large spike at " << obs_indices[ind+1] << std::endl;
         } else {  // if (dx[i]+dx[i+1]) can be a denominator:
           if (std::abs(xy.xdiff[ind] + xy.xdiff[ind+1]) > std::numeric_limits<float>::epsilon()) {
@@ -362,6 +368,7 @@ void SpikeAndStepCheck::identifyThinnedObservations(std::vector<bool> &isThinned
               isThinned[obs_indices[ind+1]] = false;  // not a spike after all
               spikeFlag[obs_indices[ind+1]] = false;
               lastChecked = ind+1;  // OPS bug - should be lastChecked = ind;
+              #pragma omp critical(SpikeAndStepCheckLog)
               oops::Log::debug() << "Not spike at " << obs_indices[ind+1] << std::endl;
             }  // not a spike after all
           }  // can (dx[i]+dx[i+1]) be a denominator or not
@@ -375,6 +382,7 @@ void SpikeAndStepCheck::identifyThinnedObservations(std::vector<bool> &isThinned
         isThinned[obs_indices[ind+1]] = true;  // smaller spike
         spikeFlag[obs_indices[ind+1]] = true;
         lastChecked = ind+1;
+        #pragma omp critical(SpikeAndStepCheckLog)
         oops::Log::debug() << "Small spike at " << obs_indices[ind+1] << std::endl;
       }  // spike or not
     }  // count spikes
@@ -389,6 +397,7 @@ void SpikeAndStepCheck::identifyThinnedObservations(std::vector<bool> &isThinned
         if (ind < xy.ydiff.size()-1) {  // only flag start of step if not final level
           isThinned[obs_indices[ind]] = true;  // start of step
         }
+        #pragma omp critical(SpikeAndStepCheckLog)
         oops::Log::debug() << "Step at " << obs_indices[ind] << " and " <<
                               obs_indices[ind+1] << std::endl;
         // unless thermocline/halocline/other expected sharp change:
@@ -404,6 +413,7 @@ void SpikeAndStepCheck::identifyThinnedObservations(std::vector<bool> &isThinned
           if (ind < xy.ydiff.size()-1) {  // only unflag start of step if not final level
             isThinned[obs_indices[ind]] = false;  // not step after all
           }
+          #pragma omp critical(SpikeAndStepCheckLog)
           oops::Log::debug() << "Not step after all at " << obs_indices[ind] <<
                                 " and " << obs_indices[ind+1] << std::endl;
         }  // thermocline/halocline/etc., not suspect step
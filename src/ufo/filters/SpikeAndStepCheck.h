@@ -189,6 +189,7 @@ class SpikeAndStepCheck : public FilterBase,
 
   /// \brief Return track flag for observations rejected by spike and step check.
   int qcFlag() const override {return QCflags::track;}
+  bool modifiesObsSpace() const override {return true;}
 
   /// \brief Given x (independent variable) and y (dependent variable),
   ///  set x, y, dx, dy and dy/dx for the given record (group).
@@ -206,9 +207,10 @@ class SpikeAndStepCheck : public FilterBase,
 
   /// \brief Go through the obs in the record (group), finding which are spikes and steps,
   ///  according to given conditions, flag as appropriate.
-  void identifyThinnedObservations(std::vector<bool> &isThinned,
-                                   std::vector<bool> &spikeFlag,
-                                   std::vector<bool> &stepFlag,
+  /// Profiles may be processed concurrently, so the flags are not std::vector<bool>s.
+  void identifyThinnedObservations(std::vector<char> &isThinned,
+                                   std::vector<char> &spikeFlag,
+                                   std::vector<char> &stepFlag,
                                    xyStruct &xy,
                                    const std::vector<float> &tolerances,
                                    const std::vector<size_t> &obs_indices,
@@ -7,6 +7,7 @@
 
 #include "ufo/filters/StuckCheck.h"
 
+#include <cstdint>
 #include <memory>
 #include <ostream>
 #include <stdexcept>
@@ -20,6 +21,7 @@
 #include "oops/util/DateTime.h"
 #include "oops/util/Duration.h"
 #include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
 #include "ufo/filters/ObsAccessor.h"
 #include "ufo/filters/StuckCheckParameters.h"
 #include "ufo/filters/TrackCheckUtils.h"
@@ -48,7 +50,7 @@ StuckCheck::StuckCheck(ioda::ObsSpace &obsdb, const Parameters_ &parameters,
             then both number stuck tolerance and time stuck tolerance must be set.)", Here());
     }
   }
-  obsGroupDateTimes_.reset(new std::vector<util::DateTime>);
+  obsGroupDateTimes_.reset(new std::vector<int64_t>);
   oops::Log::debug() << "StuckCheck: config = " << options_ << '\n';
 }
 
@@ -69,17 +71,22 @@ void StuckCheck::applyFilter(const std::vector<bool> & apply,
                                                                obsdb_,
                                                                false);
   const std::vector<size_t> validObsIds = obsAccessor.getValidObservationIds(apply);
-  *obsGroupDateTimes_ = obsAccessor.getDateTimeVariableFromObsSpace(
+  *obsGroupDateTimes_ = obsAccessor.getEpochSecondsFromObsSpace(
         "MetaData", "dateTime");
   // Create groups based on record number (assumed station ID) or category variable
   // (stationIdVariable) or otherwise assume observations all taken by the same station (1 group)
   RecursiveSplitter splitter = obsAccessor.splitObservationsIntoIndependentGroups(validObsIds);
   TrackCheckUtils::sortTracksChronologically(validObsIds, obsAccessor, splitter);
-  std::vector<bool> isRejected(validObsIds.size(), false);
+  // Stations are independent of each other, so they are checked concurrently. Each observation
+  // belongs to a single station, so threads write to disjoint elements of isRejected (which is
+  // therefore not a std::vector<bool>).
+  std::vector<RecursiveSplitter::Group> stations;
+  for (auto station : splitter.multiElementGroups())
+    stations.push_back(station);
+  std::vector<char> isRejected(obsGroupDateTimes_->size(), false);
   std::vector<std::string> filterVariables = filtervars.toOopsVariables().variables();
   // Iterates through observations to see how long each variable is stuck on one observation
   for (std::string const& variable : filterVariables) {
-    size_t stationNumber = 0;
     if (!obsdb_.has("ObsValue", variable)) {
       std::string errorMessage =
           "StuckCheck Error: ObsValue vector for " + variable + " not found.\n";
@@ -87,77 +94,61 @@ void StuckCheck::applyFilter(const std::vector<bool> & apply,
     }
     const std::vector<float> variableValues = obsAccessor.getFloatVariableFromObsSpace(
           "ObsValue", variable);
-    const float missingFloat = util::missingValue(float());
-    for (auto station : splitter.multiElementGroups()) {
-      std::string stationId = std::to_string(stationNumber);
-      std::vector<float> variableDataStation = collectStationVariableData(
-            station.begin(), station.end(), validObsIds, variableValues);
-      // the working variable's value associated with the prior observation
-      float previousObservationValue;
-      float currentObservationValue;
-      size_t firstSameValueIndex = 0;  // the first observation in the current streak
-      for (size_t observationIndex = 0; observationIndex < variableDataStation.size();
-           observationIndex++) {
-        currentObservationValue = variableDataStation.at(observationIndex);
-        if (currentObservationValue == missingFloat) {
-          continue;
-        }
-        if (observationIndex == 0) {
-          previousObservationValue = currentObservationValue;
-        } else {
-          if (currentObservationValue == previousObservationValue) {
-            // If the last observation of the track is part of a streak, the full streak will need
-            // to be checked at this point.
-            if (observationIndex == variableDataStation.size() - 1) {
-              StuckCheck::potentiallyRejectStreak(station.begin(),
-                                                  station.end(),
-                                                  validObsIds,
-                                                  firstSameValueIndex,
-                                                  observationIndex,
-                                                  isRejected,
-                                                  stationId);
-            }
-          } else {  // streak ended in the previous observation
-            StuckCheck::potentiallyRejectStreak(station.begin(),
-                                                station.end(),
-                                                validObsIds,
-                                                firstSameValueIndex,
-                                                observationIndex - 1,
-                                                isRejected,
-                                                stationId);
-            // start the streak with the current observation and reset the count to 1
-            firstSameValueIndex = observationIndex;
-            previousObservationValue = currentObservationValue;
-          }
-        }
-      }
-      stationNumber++;
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t stationNumber = 0; stationNumber < stations.size(); ++stationNumber) {
+      identifyStreaksAtStation(stations[stationNumber].begin(), stations[stationNumber].end(),
+                               validObsIds, variableValues, isRejected,
+                               std::to_string(stationNumber));
     }
   }
   obsAccessor.flagRejectedObservations(isRejected, flagged);
 }
 
-void StuckCheck::print(std::ostream & os) const {
-  os << "StuckCheck: config = " << options_ << '\n';
-}
-
-/// \returns a vector containing all of the necessary data to run this filter for each observation,
-/// stored by observation.
-std::vector<float> StuckCheck::collectStationVariableData(
-    std::vector<size_t>::const_iterator stationObsIndicesBegin,
-    std::vector<size_t>::const_iterator stationObsIndicesEnd,
+/// Scans the chronologically sorted observations of a station in a single pass, keeping only
+/// the start of the current streak and its value, and passes each completed streak (and the
+/// streak containing the last observation) to potentiallyRejectStreak().
+void StuckCheck::identifyStreaksAtStation(
+    std::vector<size_t>::const_iterator stationIndicesBegin,
+    std::vector<size_t>::const_iterator stationIndicesEnd,
     const std::vector<size_t> &validObsIds,
-    const std::vector<float> &globalData) const {
-  std::vector<float> stationData;
-  stationData.reserve(stationObsIndicesEnd - stationObsIndicesBegin);
-  size_t observationNumber = 0;
-  for (std::vector<size_t>::const_iterator it = stationObsIndicesBegin;
-       it != stationObsIndicesEnd; ++it) {
-    const size_t obsId = validObsIds.at(*it);
-    stationData.push_back(globalData[obsId]);
-    observationNumber++;
+    const std::vector<float> &variableValues,
+    std::vector<char> &isRejected,
+    const std::string &stationId) const {
+  const float missingFloat = util::missingValue(float());
+  const size_t stationLength = stationIndicesEnd - stationIndicesBegin;
+  bool streakStarted = false;
+  // the working variable's value associated with the prior observation
+  float previousObservationValue = missingFloat;
+  size_t firstSameValueIndex = 0;  // the first observation in the current streak
+  for (size_t observationIndex = 0; observationIndex < stationLength; observationIndex++) {
+    const float currentObservationValue =
+        variableValues[validObsIds[*(stationIndicesBegin + observationIndex)]];
+    if (currentObservationValue == missingFloat) {
+      continue;
+    }
+    if (!streakStarted) {
+      streakStarted = true;
+      firstSameValueIndex = observationIndex;
+      previousObservationValue = currentObservationValue;
+    } else if (currentObservationValue == previousObservationValue) {
+      // If the last observation of the track is part of a streak, the full streak will need
+      // to be checked at this point.
+      if (observationIndex == stationLength - 1) {
+        potentiallyRejectStreak(stationIndicesBegin, stationIndicesEnd, validObsIds,
+                                firstSameValueIndex, observationIndex, isRejected, stationId);
+      }
+    } else {  // streak ended in the previous observation
+      potentiallyRejectStreak(stationIndicesBegin, stationIndicesEnd, validObsIds,
+                              firstSameValueIndex, observationIndex - 1, isRejected, stationId);
+      // start the streak with the current observation and reset the count to 1
+      firstSameValueIndex = observationIndex;
+      previousObservationValue = currentObservationValue;
+    }
   }
-  return stationData;
+}
+
+void StuckCheck::print(std::ostream & os) const {
+  os << "StuckCheck: config = " << options_ << '\n';
 }
 
 void StuckCheck::potentiallyRejectStreak(
@@ -166,11 +157,11 @@ void StuckCheck::potentiallyRejectStreak(
     const std::vector<size_t> &validObsIds,
     size_t startOfStreakIndex,
     size_t endOfStreakIndex,
-    std::vector<bool> &isRejected,
-    std::string stationId = "") const {
+    std::vector<char> &isRejected,
+    const std::string &stationId) const {
 
   auto getObservationTime = [this, &stationIndicesBegin, &validObsIds] (
-      size_t offsetFromBeginning)->util::DateTime{
+      size_t offsetFromBeginning)->int64_t{
     const size_t obsIndex = validObsIds.at(*(stationIndicesBegin + offsetFromBeginning));
     return obsGroupDateTimes_->at(obsIndex);
   };
@@ -199,10 +190,10 @@ void StuckCheck::potentiallyRejectStreak(
 
   if (!(options_.core.percentageStuckTolerance.value())) {
     if (streakLength < stationLength) {
-      const util::DateTime firstStreakObservationTime = getObservationTime(startOfStreakIndex);
-      const util::DateTime lastStreakObservationTime = getObservationTime(endOfStreakIndex);
-      const util::Duration streakDuration = lastStreakObservationTime - firstStreakObservationTime;
-      if (streakDuration <= options_.core.timeStuckTolerance.value().value()) {
+      const int64_t firstStreakObservationTime = getObservationTime(startOfStreakIndex);
+      const int64_t lastStreakObservationTime = getObservationTime(endOfStreakIndex);
+      const int64_t streakDuration = lastStreakObservationTime - firstStreakObservationTime;
+      if (streakDuration <= options_.core.timeStuckTolerance.value().value().toSeconds()) {
         return;
       }
     }
@@ -9,6 +9,7 @@
 #ifndef UFO_FILTERS_STUCKCHECK_H_
 #define UFO_FILTERS_STUCKCHECK_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -19,10 +20,6 @@
 #include "ufo/filters/StuckCheckParameters.h"
 #include "ufo/filters/TrackCheckUtils.h"
 
-namespace util {
-class DateTime;
-}
-
 namespace ioda {
 template <typename DATATYPE> class ObsDataVector;
 class ObsSpace;
@@ -56,24 +53,30 @@ class StuckCheck: public FilterBase,
  private:
   Parameters_ options_;
   // Instantiate object for accessing observations that may be held on multiple MPI ranks.
-  std::unique_ptr<std::vector<util::DateTime>> obsGroupDateTimes_;
+  // Observation times (seconds since 1970-01-01T00:00:00Z).
+  std::unique_ptr<std::vector<int64_t>> obsGroupDateTimes_;
 
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
                    std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override {return QCflags::track;}
-  std::vector<float> collectStationVariableData(
-      std::vector<size_t>::const_iterator stationObsIndicesBegin,
-      std::vector<size_t>::const_iterator stationObsIndicesEnd,
-      const std::vector<size_t> &validObsIds,
-      const std::vector<float> &globalData) const;
+  /// Find the streaks of identical values of a variable at the station whose observations
+  /// indices (in chronological order) are pointed to by \p stationIndicesBegin and
+  /// \p stationIndicesEnd and set the elements of \p isRejected corresponding to the
+  /// observations belonging to streaks that should be rejected.
+  void identifyStreaksAtStation(std::vector<size_t>::const_iterator stationIndicesBegin,
+                                std::vector<size_t>::const_iterator stationIndicesEnd,
+                                const std::vector<size_t> &validObsIds,
+                                const std::vector<float> &variableValues,
+                                std::vector<char> &isRejected,
+                                const std::string &stationId) const;
   void potentiallyRejectStreak(std::vector<size_t>::const_iterator stationIndicesBegin,
                                std::vector<size_t>::const_iterator stationIndicesEnd,
                                const std::vector<size_t> &validObsIds,
                                size_t startOfStreakIndex,
                                size_t endOfStreakIndex,
-                               std::vector<bool> &isRejected,
-                               std::string stationId) const;
+                               std::vector<char> &isRejected,
+                               const std::string &stationId) const;
 };
 
 }  // namespace ufo
@@ -9,7 +9,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
+#include <limits>
 #include <string>
 #include <utility>
 #include <vector>
@@ -31,7 +34,8 @@ namespace {
 
 struct Observation {
   size_t id;
-  util::DateTime time;
+  /// Observation time (seconds since 1970-01-01T00:00:00Z).
+  int64_t time;
   int priority = 0;
 };
 
@@ -39,7 +43,7 @@ struct Observation {
 class TemporalThinner {
  public:
   TemporalThinner(const std::vector<size_t> &validObsIds,
-                  const std::vector<util::DateTime> &times,
+                  const std::vector<int64_t> &times,
                   const std::vector<int> *priorities,
                   const RecursiveSplitter &splitter,
                   const TemporalThinningParameters &options);
@@ -59,7 +63,7 @@ class TemporalThinner {
     return obs;
   }
 
-  util::DateTime getTime(size_t validObsIndex) const {
+  int64_t getTime(size_t validObsIndex) const {
     return times_[validObsIds_[validObsIndex]];
   }
 
@@ -76,14 +80,14 @@ class TemporalThinner {
   /// to retain must be taken at or after \p deadline.
   void thinRangeForwards(ForwardValidObsIndexIterator validIndicesBegin,
                          ForwardValidObsIndexIterator validIndicesEnd,
-                         util::DateTime deadline,
+                         int64_t deadline,
                          std::vector<bool> &isThinned) const;
 
   /// Thin the valid observations with indices from the specified range. The first observation
   /// to retain must be taken at or before \p deadline.
   void thinRangeBackwards(BackwardValidObsIndexIterator validIndicesBegin,
                           BackwardValidObsIndexIterator validIndicesEnd,
-                          util::DateTime deadline,
+                          int64_t deadline,
                           std::vector<bool> &isThinned) const;
 
   /// \brief Common implementation shared by thinRangeForwards() and thinRangeBackwards().
@@ -92,20 +96,19 @@ class TemporalThinner {
   ///   Iterator visiting indices of observations in chronological (reverse chronological) order
   ///   when thinning forwards (backwards).
   /// \tparam IsPast
-  ///   Binary functor taking two parameters of type util::DateTime and returning true if and only
-  ///   if the first argument is later (earlier) than the second when thinning forwards (backwards).
+  ///   Binary functor taking two times and returning true if and only if the first argument is
+  ///   later (earlier) than the second when thinning forwards (backwards).
   /// \tparam IsAtOrPast
-  ///   Binary functor taking two parameters of type util::DateTime and returning true if and only
-  ///   if the first argument is later (earlier) than or equal to the second when thinning forwards
-  ///   (backwards).
+  ///   Binary functor taking two times and returning true if and only if the first argument is
+  ///   later (earlier) than or equal to the second when thinning forwards (backwards).
   /// \tparam Advance
-  ///   Binary functor taking two parameters of types util::DateTime and util::Duration and
-  ///   returning the datetime obtained by adding (subtracting) the second argument to (from) the
-  ///   first argument when thinning forwards (backwards).
+  ///   Binary functor taking a time and a duration (both in seconds) and returning the time
+  ///   obtained by adding (subtracting) the second argument to (from) the first argument when
+  ///   thinning forwards (backwards).
   template <typename Iterator, typename IsPast, typename IsAtOrPast, typename Advance>
   void thinRange(Iterator validIndicesBegin,
                  Iterator validIndicesEnd,
-                 util::DateTime deadline,
+                 int64_t deadline,
                  IsPast isPast,
                  IsAtOrPast isAtOrPast,
                  Advance advance,
@@ -115,25 +118,29 @@ class TemporalThinner {
   ForwardValidObsIndexIterator findSeed(
       ForwardValidObsIndexIterator validObsIndicesBegin,
       ForwardValidObsIndexIterator validObsIndicesEnd,
-      util::DateTime seedTime) const;
+      int64_t seedTime) const;
 
   /// Return an iterator to the valid observation taken at a time closest to \p targetTime.
   /// In case of a tie, the later (more recent) observation is selected.
   ForwardValidObsIndexIterator findNearest(
       ForwardValidObsIndexIterator validObsIndicesBegin,
       ForwardValidObsIndexIterator validObsIndicesEnd,
-      util::DateTime targetTime) const;
+      int64_t targetTime) const;
 
  private:
   const std::vector<size_t> &validObsIds_;
-  const std::vector<util::DateTime> &times_;
+  /// Observation times (seconds since 1970-01-01T00:00:00Z).
+  const std::vector<int64_t> &times_;
   const std::vector<int> *priorities_;
   const RecursiveSplitter &splitter_;
   const TemporalThinningParameters &options_;
+  /// The `min_spacing` and `tolerance` options in seconds.
+  int64_t minSpacing_;
+  int64_t tolerance_;
 };
 
 TemporalThinner::TemporalThinner(const std::vector<size_t> &validObsIds,
-                                 const std::vector<util::DateTime> &times,
+                                 const std::vector<int64_t> &times,
                                  const std::vector<int> *priorities,
                                  const RecursiveSplitter &splitter,
                                  const TemporalThinningParameters &options) :
@@ -141,7 +148,9 @@ TemporalThinner::TemporalThinner(const std::vector<size_t> &validObsIds,
   times_(times),
   priorities_(priorities),
   splitter_(splitter),
-  options_(options)
+  options_(options),
+  minSpacing_(options.minSpacing.value().toSeconds()),
+  tolerance_(options.tolerance.value().toSeconds())
 {}
 
 std::vector<bool> TemporalThinner::identifyThinnedObservations(size_t totalNumObservations) const {
@@ -149,20 +158,20 @@ std::vector<bool> TemporalThinner::identifyThinnedObservations(size_t totalNumOb
 
   for (RecursiveSplitter::Group group : splitter_.multiElementGroups()) {
     if (options_.seedTime.value() == boost::none) {
-      util::DateTime deadline = getTime(*group.begin());
+      int64_t deadline = getTime(*group.begin());
       thinRangeForwards(group.begin(), group.end(), deadline, isThinned);
     } else {
       const ForwardValidObsIndexIterator seedIt = findSeed(
-            group.begin(), group.end(), *options_.seedTime.value());
+            group.begin(), group.end(), ObsAccessor::toEpochSeconds(*options_.seedTime.value()));
       Observation seed = getObservation(*seedIt);
       {
-        util::DateTime deadline = seed.time + options_.minSpacing;
+        int64_t deadline = seed.time + minSpacing_;
         thinRangeForwards(seedIt + 1, group.end(), deadline, isThinned);
       }
       {
         const BackwardValidObsIndexIterator seedRevIt(seedIt + 1);
         const BackwardValidObsIndexIterator revEnd(group.begin());
-        util::DateTime deadline = seed.time - options_.minSpacing;
+        int64_t deadline = seed.time - minSpacing_;
         thinRangeBackwards(seedRevIt, revEnd, seed.time, isThinned);
       }
     }
@@ -173,32 +182,31 @@ std::vector<bool> TemporalThinner::identifyThinnedObservations(size_t totalNumOb
 
 void TemporalThinner::thinRangeForwards(ForwardValidObsIndexIterator validIndicesBegin,
                                         ForwardValidObsIndexIterator validIndicesEnd,
-                                        util::DateTime deadline,
+                                        int64_t deadline,
                                         std::vector<bool> &isThinned) const {
   thinRange(validIndicesBegin, validIndicesEnd, deadline,
-            std::greater<util::DateTime>(),
-            std::greater_equal<util::DateTime>(),
-            // Unfortunately in C++11 std::plus requires both arguments to be of the same type
-            [](const util::DateTime &time, const util::Duration &offset) { return time + offset; },
+            std::greater<int64_t>(),
+            std::greater_equal<int64_t>(),
+            std::plus<int64_t>(),
             isThinned);
 }
 
 void TemporalThinner::thinRangeBackwards(
     BackwardValidObsIndexIterator validIndicesBegin,
     BackwardValidObsIndexIterator validIndicesEnd,
-    util::DateTime deadline,
+    int64_t deadline,
     std::vector<bool> &isThinned) const {
   thinRange(validIndicesBegin, validIndicesEnd, deadline,
-            std::less<util::DateTime>(),
-            std::less_equal<util::DateTime>(),
-            [](const util::DateTime &time, const util::Duration &offset) { return time - offset; },
+            std::less<int64_t>(),
+            std::less_equal<int64_t>(),
+            std::minus<int64_t>(),
             isThinned);
 }
 
 template <typename Iterator, typename IsPast, typename IsAtOrPast, typename Advance>
 void TemporalThinner::thinRange(Iterator validIndicesBegin,
                                 Iterator validIndicesEnd,
-                                util::DateTime deadline,
+                                int64_t deadline,
                                 IsPast isPast,
                                 IsAtOrPast isAtOrPast,
                                 Advance advance,
@@ -211,7 +219,7 @@ void TemporalThinner::thinRange(Iterator validIndicesBegin,
       // We're looking for a higher-priority observation at or before the deadline
       if (isPast(current.time, deadline)) {
         // We haven't found one
-        deadline = advance(best->time, options_.minSpacing);
+        deadline = advance(best->time, minSpacing_);
         best = boost::none;
         // The decision whether to thin 'current' will be taken in the next if statement
       } else {
@@ -228,7 +236,7 @@ void TemporalThinner::thinRange(Iterator validIndicesBegin,
       // We're looking for an observation at or after the deadline
       if (isAtOrPast(current.time, deadline)) {
         best = current;
-        deadline = advance(best->time, options_.tolerance);
+        deadline = advance(best->time, tolerance_);
       } else {
         isThinned[current.id] = true;
       }
@@ -239,24 +247,24 @@ void TemporalThinner::thinRange(Iterator validIndicesBegin,
 typename TemporalThinner::ForwardValidObsIndexIterator TemporalThinner::findSeed(
     ForwardValidObsIndexIterator validObsIndicesBegin,
     ForwardValidObsIndexIterator validObsIndicesEnd,
-    util::DateTime seedTime) const {
+    int64_t seedTime) const {
   const ForwardValidObsIndexIterator nearestToSeedIt = findNearest(
         validObsIndicesBegin, validObsIndicesEnd, seedTime);
   if (!hasPriorities()) {
     return nearestToSeedIt;
   }
 
-  util::DateTime nearestToSeedTime = getObservation(*nearestToSeedIt).time;
+  int64_t nearestToSeedTime = getObservation(*nearestToSeedIt).time;
 
   ForwardValidObsIndexIterator acceptableBegin = std::lower_bound(
         validObsIndicesBegin, nearestToSeedIt,
-        nearestToSeedTime - options_.tolerance,
-        [&](size_t validObsIndexA, const util::DateTime &timeB)
+        nearestToSeedTime - tolerance_,
+        [&](size_t validObsIndexA, int64_t timeB)
         { return getTime(validObsIndexA) < timeB; });
   ForwardValidObsIndexIterator acceptableEnd = std::upper_bound(
         acceptableBegin, validObsIndicesEnd,
-        nearestToSeedTime + options_.tolerance,
-        [&](const util::DateTime &timeA, size_t validObsIndexB)
+        nearestToSeedTime + tolerance_,
+        [&](int64_t timeA, size_t validObsIndexB)
         { return timeA < getTime(validObsIndexB); });
 
   // Find the element with highest priority in the acceptable range.
@@ -268,11 +276,11 @@ typename TemporalThinner::ForwardValidObsIndexIterator TemporalThinner::findSeed
 typename TemporalThinner::ForwardValidObsIndexIterator TemporalThinner::findNearest(
     ForwardValidObsIndexIterator validObsIndicesBegin,
     ForwardValidObsIndexIterator validObsIndicesEnd,
-    util::DateTime targetTime) const {
+    int64_t targetTime) const {
   ASSERT_MSG(validObsIndicesEnd - validObsIndicesBegin != 0,
              "The range of observation indices must not be empty");
 
-  auto isEarlierThan = [&](size_t validObsIndexA, const util::DateTime &timeB) {
+  auto isEarlierThan = [&](size_t validObsIndexA, int64_t timeB) {
     return getTime(validObsIndexA) < timeB;
   };
   const ForwardValidObsIndexIterator firstGreaterOrEqualToTargetIt =
@@ -293,14 +301,79 @@ typename TemporalThinner::ForwardValidObsIndexIterator TemporalThinner::findNear
   Observation lastLessThanTarget = getObservation(*lastLessThanTargetIt);
 
   // Prefer the later observation if there's a tie
-  if ((firstGreaterOrEqualToTarget.time - targetTime).toSeconds() <=
-      (targetTime - lastLessThanTarget.time).toSeconds()) {
+  if (firstGreaterOrEqualToTarget.time - targetTime <=
+      targetTime - lastLessThanTarget.time) {
     return firstGreaterOrEqualToTargetIt;
   } else {
     return lastLessThanTargetIt;
   }
 }
 
+/// \brief Thin observations in each group (multi-element group of \p splitter) by retaining at
+/// most one observation in each time slot, as described in the documentation of the `bucketed`
+/// option.
+///
+/// \param times
+///   Observation times, in seconds since the centre of slot 0.
+std::vector<bool> identifyThinnedObservationsInSlots(const std::vector<size_t> &validObsIds,
+                                                     const std::vector<int64_t> &times,
+                                                     const std::vector<int> *priorities,
+                                                     const RecursiveSplitter &splitter,
+                                                     int64_t slotWidth) {
+  ASSERT_MSG(slotWidth > 0, "min_spacing must be positive");
+
+  // Groups are independent of each other, so they are thinned concurrently. Each observation
+  // belongs to a single group, so threads write to disjoint elements of isThinned (which is
+  // therefore not a std::vector<bool>).
+  std::vector<RecursiveSplitter::Group> groups;
+  for (auto group : splitter.multiElementGroups())
+    groups.push_back(group);
+  std::vector<char> isThinned(times.size(), false);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t igroup = 0; igroup < groups.size(); ++igroup) {
+    // Slot index of each observation and the range of slots occupied by the group.
+    std::vector<int64_t> slots;
+    for (size_t validObsIndex : groups[igroup]) {
+      // Round to the nearest slot centre (floor division, since time differences may be negative)
+      const int64_t shifted = times[validObsIds[validObsIndex]] + slotWidth / 2;
+      slots.push_back(shifted / slotWidth - (shifted % slotWidth < 0 ? 1 : 0));
+    }
+    const int64_t minSlot = *std::min_element(slots.begin(), slots.end());
+    const int64_t maxSlot = *std::max_element(slots.begin(), slots.end());
+
+    // Returns true if the observation with ID a is preferable to that with ID b.
+    auto isBetter = [&](size_t a, size_t b, int64_t slot) {
+      if (priorities && (*priorities)[a] != (*priorities)[b])
+        return (*priorities)[a] > (*priorities)[b];
+      const int64_t distanceA = std::abs(times[a] - slot * slotWidth);
+      const int64_t distanceB = std::abs(times[b] - slot * slotWidth);
+      if (distanceA != distanceB)
+        return distanceA < distanceB;
+      return times[a] > times[b];
+    };
+
+    // ID of the best observation found so far in each slot.
+    const size_t none = std::numeric_limits<size_t>::max();
+    std::vector<size_t> best(maxSlot - minSlot + 1, none);
+    size_t i = 0;
+    for (size_t validObsIndex : groups[igroup]) {
+      const size_t obsId = validObsIds[validObsIndex];
+      size_t &slotBest = best[slots[i] - minSlot];
+      if (slotBest == none || isBetter(obsId, slotBest, slots[i])) {
+        if (slotBest != none)
+          isThinned[slotBest] = true;
+        slotBest = obsId;
+      } else {
+        isThinned[obsId] = true;
+      }
+      ++i;
+    }
+  }
+
+  return std::vector<bool>(isThinned.begin(), isThinned.end());
+}
+
 }  // namespace
 
 TemporalThinning::TemporalThinning(ioda::ObsSpace & obsdb, const Parameters_ & parameters,
@@ -360,6 +433,11 @@ ObsAccessor TemporalThinning::createObsAccessor() const {
       return ObsAccessor::toAllObservations(obsdb_);
     }
   } else if (options_.categoryVariable.value() != boost::none) {
+    if (areRecordsGroupedByCategoryVariable()) {
+      // Each record contains all observations with a particular value of the category variable
+      // and is held on a single rank, so there is no need to gather observations from all ranks.
+      return ObsAccessor::toObservationsSplitIntoIndependentGroupsByRecordId(obsdb_);
+    }
     return ObsAccessor::toObservationsSplitIntoIndependentGroupsByVariable(
           obsdb_, *options_.categoryVariable.value() );
   } else if (!obsdb_.obs_group_vars().empty()) {
@@ -371,6 +449,15 @@ ObsAccessor TemporalThinning::createObsAccessor() const {
   }
 }
 
+bool TemporalThinning::areRecordsGroupedByCategoryVariable() const {
+  if (options_.categoryVariable.value() == boost::none)
+    return false;
+  const Variable &categoryVariable = *options_.categoryVariable.value();
+  const std::vector<std::string> groupingVars = obsdb_.obs_group_vars();
+  return categoryVariable.group() == "MetaData" && groupingVars.size() == 1 &&
+      groupingVars[0] == categoryVariable.variable();
+}
+
 std::vector<bool> TemporalThinning::identifyThinnedObservations(
     const std::vector<bool> & apply,
     const Variables & filtervars,
@@ -380,8 +467,22 @@ std::vector<bool> TemporalThinning::identifyThinnedObservations(
 
   RecursiveSplitter splitter = obsAccessor.splitObservationsIntoIndependentGroups(validObsIds);
 
-  std::vector<util::DateTime> times = obsAccessor.getDateTimeVariableFromObsSpace(
+  const std::vector<int64_t> times = obsAccessor.getEpochSecondsFromObsSpace(
         "MetaData", "dateTime");
+
+  if (options_.bucketed) {
+    const int64_t slot0Center = ObsAccessor::toEpochSeconds(
+          options_.seedTime.value() != boost::none ?
+            *options_.seedTime.value() : obsdb_.windowStart());
+    std::vector<int64_t> secondsFromSlot0Center(times.size());
+    for (size_t obsId = 0; obsId < times.size(); ++obsId)
+      secondsFromSlot0Center[obsId] = times[obsId] - slot0Center;
+    boost::optional<std::vector<int>> priorities = getObservationPriorities(obsAccessor);
+    return identifyThinnedObservationsInSlots(validObsIds, secondsFromSlot0Center,
+                                              priorities.get_ptr(), splitter,
+                                              options_.minSpacing.value().toSeconds());
+  }
+
   splitter.sortGroupsBy([&times, &validObsIds](size_t obsIndex)
                         { return times[validObsIds[obsIndex]]; });
 
@@ -58,6 +58,9 @@ class TemporalThinning : public FilterBase,
 
   ObsAccessor createObsAccessor() const;
 
+  /// Return true if observations were grouped into records using only the category variable.
+  bool areRecordsGroupedByCategoryVariable() const;
+
   std::vector<bool> identifyThinnedObservations(const std::vector<bool> &apply,
                                                 const Variables &filtervars,
                                                 const ObsAccessor &obsAccessor) const;
@@ -70,6 +70,19 @@ class TemporalThinningParameters : public FilterParametersBase {
   /// If `records_are_single_obs` is true and a category variable is defined then
   /// each record must contain only one value of the category variable.
   oops::Parameter<bool> recordsAreSingleObs{"records_are_single_obs", false, this};
+
+  /// If true, a faster but approximate algorithm is used: the time axis is divided into slots of
+  /// width \c min_spacing centred at \c seed_time (or, if that option is not set, at the start of
+  /// the assimilation window) plus integer multiples of \c min_spacing, and in each slot only
+  /// a single observation is retained: the one with the highest priority (if
+  /// \c priority_variable is set) or, in case of a tie, the one taken closest to the slot centre
+  /// (or, if there is still a tie, the later one). Observations do not need to be sorted
+  /// chronologically and groups of observations are thinned concurrently.
+  ///
+  /// Unlike the default algorithm, this one does not guarantee that retained observations are
+  /// separated by at least \c min_spacing (observations retained in neighbouring slots may be
+  /// closer). \c tolerance is ignored.
+  oops::Parameter<bool> bucketed{"bucketed", false, this};
 };
 
 }  // namespace ufo
@@ -0,0 +1,64 @@
+/*
+ * (C) Crown copyright 2023, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_TIMEDCONSTRUCTION_H_
+#define UFO_FILTERS_TIMEDCONSTRUCTION_H_
+
+#include <chrono>
+#include <cstdlib>
+#include <typeinfo>
+#include <utility>
+
+#include "ufo/filters/FilterProfiler.h"
+
+namespace ufo {
+
+/// \brief Measures the wall time and heap growth from its construction until it is read, if
+/// filter profiling is enabled (see FilterProfiler).
+class ConstructionTimer {
+ public:
+  ConstructionTimer() : enabled_(std::getenv("UFO_FILTER_PROFILE") != nullptr) {
+    if (enabled_) {
+      startHeapBytes_ = FilterProfiler::heapBytes();
+      startTime_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  bool enabled() const {return enabled_;}
+  double elapsedSeconds() const {
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime_;
+    return elapsed.count();
+  }
+  double heapGrowth() const {return FilterProfiler::heapBytes() - startHeapBytes_;}
+
+ private:
+  bool enabled_;
+  long long startHeapBytes_ = 0;  // NOLINT(runtime/int)
+  std::chrono::steady_clock::time_point startTime_;
+};
+
+/// \brief An observation processor of type \p PROCESSOR whose construction is measured.
+///
+/// The processor factory creates processors of this type. The ConstructionTimer base is
+/// constructed before \p PROCESSOR and read at the end of this constructor, so the measurement
+/// covers the constructors of \p PROCESSOR and of all its bases and nothing else. It is
+/// reported in the profile as the cost of the construction of \p PROCESSOR.
+template <typename PROCESSOR>
+class TimedConstruction final : private ConstructionTimer, public PROCESSOR {
+ public:
+  template <typename... Args>
+  explicit TimedConstruction(Args &&... args)
+    : ConstructionTimer(), PROCESSOR(std::forward<Args>(args)...) {
+    if (ConstructionTimer::enabled())
+      this->setConstructionCost(typeid(PROCESSOR), ConstructionTimer::elapsedSeconds(),
+                                ConstructionTimer::heapGrowth());
+  }
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_TIMEDCONSTRUCTION_H_
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <map>
 #include <string>
 #include <utility>
@@ -31,8 +32,10 @@
 namespace ufo {
 
 TrackCheck::TrackObservation::TrackObservation(float latitude, float longitude,
-                                               const util::DateTime &time, float pressure)
+                                               int64_t time, float pressure,
+                                               float maxValidSpeed)
   : obsLocationTime_(latitude, longitude, time),  pressure_(pressure),
+    maxValidSpeed_(maxValidSpeed),
     rejectedInPreviousSweep_(false), rejectedBeforePreviousSweep_(false),
     numNeighborsVisitedInPreviousSweep_{NO_PREVIOUS_SWEEP, NO_PREVIOUS_SWEEP}
 {}
@@ -40,27 +43,27 @@ TrackCheck::TrackObservation::TrackObservation(float latitude, float longitude,
 void TrackCheck::TrackObservation::checkAgainstBuddy(
     const TrackObservation &buddyObs,
     const TrackCheckParameters &options,
-    const PiecewiseLinearInterpolation &maxValidSpeedAtPressure,
-    float referencePressure,
+    float maxValidSpeed,
     CheckResults & results) const {
   results = CheckResults();
-  util::Duration temporalDistance = abs(buddyObs.obsLocationTime_.time() -
-                                        this->obsLocationTime_.time());
+  const int64_t temporalDistance = std::abs(buddyObs.obsLocationTime_.time() -
+                                            this->obsLocationTime_.time());
+  const int64_t temporalResolution = options.temporalResolution.value().toSeconds();
   const float spatialDistance = TrackCheckUtils::distance(this->obsLocationTime_.location(),
                                                           buddyObs.obsLocationTime_.location());
 
   // Estimate the speed and check if it is within the allowed range
   const float conservativeSpeedEstimate =
       (spatialDistance - options.spatialResolution) /
-      (temporalDistance + options.temporalResolution).toSeconds();
-  const float maxSpeed = maxValidSpeedAtPressure(referencePressure);
-  results.speedCheckResult = TrackCheckUtils::CheckResult(conservativeSpeedEstimate <= maxSpeed);
+      (temporalDistance + temporalResolution);
+  results.speedCheckResult =
+      TrackCheckUtils::CheckResult(conservativeSpeedEstimate <= maxValidSpeed);
 
   // Estimate the climb rate and check if it is within the allowed range
   if (options.maxClimbRate.value() != boost::none) {
     const float pressureDiff = std::abs(pressure_ - buddyObs.pressure_);
     const float conservativeClimbRateEstimate =
-        pressureDiff / (temporalDistance + options.temporalResolution).toSeconds();
+        pressureDiff / (temporalDistance + temporalResolution);
     results.climbRateCheckResult =
         TrackCheckUtils::CheckResult
         (conservativeClimbRateEstimate <= *options.maxClimbRate.value());
@@ -68,7 +71,7 @@ void TrackCheck::TrackObservation::checkAgainstBuddy(
 
   const int resolutionMultiplier = options.distinctBuddyResolutionMultiplier;
   results.isBuddyDistinct =
-      temporalDistance > resolutionMultiplier * options.temporalResolution &&
+      temporalDistance > resolutionMultiplier * temporalResolution &&
       spatialDistance > resolutionMultiplier * options.spatialResolution;
 
   return;
@@ -123,9 +126,16 @@ void TrackCheck::applyFilter(const std::vector<bool> & apply,
   ObsGroupPressureLocationTime obsPressureLoc = collectObsPressuresLocationsTimes(obsAccessor);
   PiecewiseLinearInterpolation maxSpeedByPressure = makeMaxSpeedByPressureInterpolation();
 
-  std::vector<bool> isRejected(obsPressureLoc.pressures.size(), false);
-  for (auto track : splitter.multiElementGroups()) {
-    identifyRejectedObservationsInTrack(track.begin(), track.end(), validObsIds,
+  // Tracks are independent of each other, so they are checked concurrently. Each observation
+  // belongs to a single track, so threads write to disjoint elements of isRejected (which is
+  // therefore not a std::vector<bool>).
+  std::vector<RecursiveSplitter::Group> tracks;
+  for (auto track : splitter.multiElementGroups())
+    tracks.push_back(track);
+  std::vector<char> isRejected(obsPressureLoc.pressures.size(), false);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t itrack = 0; itrack < tracks.size(); ++itrack) {
+    identifyRejectedObservationsInTrack(tracks[itrack].begin(), tracks[itrack].end(), validObsIds,
                                         obsPressureLoc, maxSpeedByPressure, isRejected);
   }
   obsAccessor.flagRejectedObservations(isRejected, flagged);
@@ -165,13 +175,14 @@ void TrackCheck::identifyRejectedObservationsInTrack(
     const std::vector<size_t> &validObsIds,
     const ObsGroupPressureLocationTime &obsPressureLoc,
     const PiecewiseLinearInterpolation &maxValidSpeedAtPressure,
-    std::vector<bool> &isRejected) const {
+    std::vector<char> &isRejected) const {
 
   std::vector<TrackObservation> trackObservations = collectTrackObservations(
-        trackObsIndicesBegin, trackObsIndicesEnd, validObsIds, obsPressureLoc);
+        trackObsIndicesBegin, trackObsIndicesEnd, validObsIds, obsPressureLoc,
+        maxValidSpeedAtPressure);
 
   std::vector<float> workspace;
-  while (sweepOverObservations(trackObservations, maxValidSpeedAtPressure, workspace) ==
+  while (sweepOverObservations(trackObservations, workspace) ==
          TrackCheckUtils::SweepResult::ANOTHER_SWEEP_REQUIRED) {
     // can't exit the loop yet
   }
@@ -184,7 +195,17 @@ std::vector<TrackCheck::TrackObservation> TrackCheck::collectTrackObservations(
     std::vector<size_t>::const_iterator trackObsIndicesBegin,
     std::vector<size_t>::const_iterator trackObsIndicesEnd,
     const std::vector<size_t> &validObsIds,
-    const ObsGroupPressureLocationTime &obsPressureLoc) const {
+    const ObsGroupPressureLocationTime &obsPressureLoc,
+    const PiecewiseLinearInterpolation &maxValidSpeedAtPressure) const {
+  // The pressures of successive observations in a track usually change monotonically (or
+  // slowly), so evaluating all maximum speeds in one go is much cheaper than a bisection per check.
+  std::vector<double> pressures;
+  pressures.reserve(trackObsIndicesEnd - trackObsIndicesBegin);
+  for (std::vector<size_t>::const_iterator it = trackObsIndicesBegin;
+       it != trackObsIndicesEnd; ++it)
+    pressures.push_back(obsPressureLoc.pressures[validObsIds[*it]]);
+  const std::vector<double> maxValidSpeeds = maxValidSpeedAtPressure(pressures);
+
   std::vector<TrackObservation> trackObservations;
   trackObservations.reserve(trackObsIndicesEnd - trackObsIndicesBegin);
   for (std::vector<size_t>::const_iterator it = trackObsIndicesBegin;
@@ -192,15 +213,15 @@ std::vector<TrackCheck::TrackObservation> TrackCheck::collectTrackObservations(
     const size_t obsId = validObsIds[*it];
     trackObservations.push_back(TrackObservation(obsPressureLoc.locationTimes.latitudes[obsId],
                                                  obsPressureLoc.locationTimes.longitudes[obsId],
-                                                 obsPressureLoc.locationTimes.datetimes[obsId],
-                                                 obsPressureLoc.pressures[obsId]));
+                                                 obsPressureLoc.locationTimes.times[obsId],
+                                                 obsPressureLoc.pressures[obsId],
+                                                 maxValidSpeeds[it - trackObsIndicesBegin]));
   }
   return trackObservations;
 }
 
 TrackCheckUtils::SweepResult TrackCheck::sweepOverObservations(
     std::vector<TrackObservation> &trackObservations,
-    const PiecewiseLinearInterpolation &maxValidSpeedAtPressure,
     std::vector<float> &workspace) const {
 
   TrackCheck::CheckResults results;
@@ -227,7 +248,18 @@ TrackCheckUtils::SweepResult TrackCheck::sweepOverObservations(
           return &trackObservations[neighborObsIdx];
       };
 
+      // The maximum speed is evaluated at the minimum pressure of all observations between obs
+      // and its buddy, which is always the pressure of one of these observations.
       float minPressureBetween = obs.pressure();
+      float maxValidSpeed = obs.maxValidSpeed();
+      auto updateMinPressureBetween = [&minPressureBetween, &maxValidSpeed]
+          (const TrackObservation &neighbor) {
+        if (neighbor.pressure() < minPressureBetween) {
+          minPressureBetween = neighbor.pressure();
+          maxValidSpeed = neighbor.maxValidSpeed();
+        }
+      };
+
       int neighborIdx = 1;
       const TrackObservation *neighborObs = getNthNeighbor(neighborIdx);
       for (; neighborIdx <= numNeighborsVisitedInPreviousSweep && neighborObs != nullptr;
@@ -236,10 +268,9 @@ TrackCheckUtils::SweepResult TrackCheck::sweepOverObservations(
         // been rejected. However, that would force us to check each pair of observations anew
         // whenever an observation between them is rejected, whereas as things stand, we only
         // need to "undo" checks against rejected observations.
-        minPressureBetween = std::min(minPressureBetween, neighborObs->pressure());
+        updateMinPressureBetween(*neighborObs);
         if (neighborObs->rejectedInPreviousSweep()) {
-          obs.checkAgainstBuddy(*neighborObs, options_, maxValidSpeedAtPressure,
-                                minPressureBetween, results);
+          obs.checkAgainstBuddy(*neighborObs, options_, maxValidSpeed, results);
           obs.unregisterCheckResults(results);
           if (results.isBuddyDistinct) {
             // The rejected distinct buddy needs to be replaced with another
@@ -250,10 +281,9 @@ TrackCheckUtils::SweepResult TrackCheck::sweepOverObservations(
 
       for (; numNewDistinctBuddiesToVisit > 0 && neighborObs != nullptr;
            neighborObs = getNthNeighbor(++neighborIdx)) {
-        minPressureBetween = std::min(minPressureBetween, neighborObs->pressure());
+        updateMinPressureBetween(*neighborObs);
         if (!neighborObs->rejected()) {
-          obs.checkAgainstBuddy(*neighborObs, options_, maxValidSpeedAtPressure,
-                                minPressureBetween, results);
+          obs.checkAgainstBuddy(*neighborObs, options_, maxValidSpeed, results);
           obs.registerCheckResults(results);
           if (results.isBuddyDistinct)
             --numNewDistinctBuddiesToVisit;
@@ -287,7 +317,7 @@ void TrackCheck::flagRejectedTrackObservations(
     std::vector<size_t>::const_iterator trackObsIndicesEnd,
     const std::vector<size_t> &validObsIds,
     const std::vector<TrackObservation> &trackObservations,
-    std::vector<bool> &isRejected) const {
+    std::vector<char> &isRejected) const {
   auto trackObsIndexIt = trackObsIndicesBegin;
   auto trackObsIt = trackObservations.begin();
   for (; trackObsIndexIt != trackObsIndicesEnd; ++trackObsIndexIt, ++trackObsIt)
@@ -8,6 +8,7 @@
 #ifndef UFO_FILTERS_TRACKCHECK_H_
 #define UFO_FILTERS_TRACKCHECK_H_
 
+#include <cstdint>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -88,8 +89,12 @@ class TrackCheck : public FilterBase,
   /// \brief Attributes of an observation belonging to a track.
   class TrackObservation {
    public:
-    TrackObservation(float latitude, float longitude, const util::DateTime &time, float pressure);
+    /// \param time Observation time (seconds since 1970-01-01T00:00:00Z).
+    /// \param maxValidSpeed Maximum realistic speed (in km/s) at the observation's pressure.
+    TrackObservation(float latitude, float longitude, int64_t time, float pressure,
+                     float maxValidSpeed);
     float pressure() const { return pressure_; }
+    float maxValidSpeed() const { return maxValidSpeed_; }
     bool rejectedInPreviousSweep() const { return rejectedInPreviousSweep_; }
     bool rejectedBeforePreviousSweep() const { return rejectedBeforePreviousSweep_; }
     bool rejected() const {
@@ -109,16 +114,14 @@ class TrackCheck : public FilterBase,
     ///
     /// \param buddyObs Observation to compare against.
     /// \param options Track check options.
-    /// \param maxValidSpeedAtPressure
-    ///   Function mapping air pressure (in Pa) to the maximum realistic speed (in m/s).
-    /// \param referencePressure
-    ///   Pressure at which the maximum speed should be evaluated.
+    /// \param maxValidSpeed
+    ///   Maximum realistic speed (in km/s) at the reference pressure of the check, i.e. the
+    ///   minimum pressure of all observations between this observation and \p buddyObs.
     ///
     /// \returns An object enapsulating the check results.
     void checkAgainstBuddy(const TrackObservation &buddyObs,
                            const TrackCheckParameters &options,
-                           const PiecewiseLinearInterpolation &maxValidSpeedAtPressure,
-                           float referencePressure,
+                           float maxValidSpeed,
                            CheckResults &results) const;
     void registerCheckResults(const CheckResults &result);
     void unregisterCheckResults(const CheckResults &result);
@@ -129,6 +132,7 @@ class TrackCheck : public FilterBase,
     TrackCheckUtils::ObsLocationTime obsLocationTime_;
     TrackCheckUtils::CheckCounter checkCounter_;
     float pressure_;
+    float maxValidSpeed_;
     bool rejectedInPreviousSweep_;
     bool rejectedBeforePreviousSweep_;
     int numNeighborsVisitedInPreviousSweep_[NUM_DIRECTIONS];
@@ -139,7 +143,7 @@ class TrackCheck : public FilterBase,
       std::vector<size_t>::const_iterator trackObsIndicesEnd,
       const std::vector<size_t> &validObsIds,
       const std::vector<TrackObservation> &trackObservations,
-      std::vector<bool> &isRejected) const;
+      std::vector<char> &isRejected) const;
 
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
@@ -157,27 +161,27 @@ class TrackCheck : public FilterBase,
       const std::vector<size_t> &validObsIds,
       const ObsGroupPressureLocationTime &obsPressureLoc,
       const PiecewiseLinearInterpolation &maxSpeedByPressure,
-      std::vector<bool> &isRejected) const;
+      std::vector<char> &isRejected) const;
 
+  /// Returns the attributes of all observations in a track, including the maximum realistic
+  /// speed at the pressure of each of them, which is evaluated for all of them in one go.
   std::vector<TrackObservation> collectTrackObservations(
       std::vector<size_t>::const_iterator trackObsIndicesBegin,
       std::vector<size_t>::const_iterator trackObsIndicesEnd,
       const std::vector<size_t> &validObsIds,
-      const ObsGroupPressureLocationTime &obsPressureLoc) const;
+      const ObsGroupPressureLocationTime &obsPressureLoc,
+      const PiecewiseLinearInterpolation &maxValidSpeedAtPressure) const;
 
   /// Iterate once over all observations in \p trackObservations, rejecting those inconsistent
   /// with nearby observations.
   ///
   /// \param[inout] trackObservations
   ///   Attributes of all observations in a track. Modified in place.
-  /// \param[in]
-  ///   Dependence of the expected maximum speed on air pressure (and thus height).
   /// \param[inout] workspace
   ///   A vector used internally by the function, passed by parameter to avoid repeated memory
   ///   allocations and deallocations.
   TrackCheckUtils::SweepResult sweepOverObservations(
       std::vector<TrackObservation> &trackObservations,
-      const PiecewiseLinearInterpolation &maxValidSpeedAtPressure,
       std::vector<float> &workspace) const;
 
  private:
@@ -14,6 +14,7 @@
 #include <cmath>
 #include <functional>
 #include <map>
+#include <set>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -60,16 +61,14 @@ double TrackCheckShip::speedEstimate(
     const TrackCheckShip::TrackObservation &obs1,
     const TrackCheckShip::TrackObservation &obs2,
     const TrackCheckShipParameters& options) {
-  util::Duration temporalDistance = abs(obs1.getTime() -
-                                        obs2.getTime());
-  util::Duration tempRes = options.core.temporalResolution;
+  const int64_t temporalDistance = std::abs(obs1.getTime() - obs2.getTime());
+  const int64_t tempRes = options.core.temporalResolution.value().toSeconds();
   auto dist = distance(obs1, obs2);
   auto spatialRes = options.core.spatialResolution;
   double speedEst = 0.0;
   if (dist > spatialRes) {
     speedEst = (dist - 0.5 * spatialRes) /
-        std::max(temporalDistance.toSeconds(),
-                 (tempRes.toSeconds()));
+        std::max(temporalDistance, tempRes);
     speedEst *= 1000.0;  // convert units from km/s to m/s
   }
   return speedEst;
@@ -100,7 +99,7 @@ const TrackCheckShipDiagnostics* TrackCheckShip::diagnostics() const
 
 TrackCheckShip::TrackObservation::TrackObservation(
     double latitude, double longitude,
-    const util::DateTime &time,
+    int64_t time,
     std::shared_ptr<TrackStatistics> const& ts,
     std::shared_ptr<TrackCheckUtils::CheckCounter> const &checkCounter,
     size_t observationNumber)
@@ -124,14 +123,14 @@ TrackCheckShip::~TrackCheckShip()
 /// positions
 /// \param trackObservations the full vector of observations within
 /// the single track
-/// \param isRejected the boolean vector whose indices correspond to all of
+/// \param isRejected the vector whose indices correspond to all of
 /// the rejected observations in the full input dataset
 void TrackCheckShip::flagRejectedTrackObservations(
     std::vector<size_t>::const_iterator trackObsIndicesBegin,
     std::vector<size_t>::const_iterator trackObsIndicesEnd,
     const std::vector<size_t> &validObsIds,
     const std::vector<TrackObservation> &trackObservations,
-    std::vector<bool> &isRejected) const {
+    std::vector<char> &isRejected) const {
   auto trackObsIndexIt = trackObsIndicesBegin;
   auto trackObsIt = trackObservations.begin();
   for (; trackObsIndexIt != trackObsIndicesEnd; ++trackObsIndexIt, ++trackObsIt)
@@ -187,11 +186,18 @@ void TrackCheckShip::applyFilter(const std::vector<bool> & apply,
   TrackCheckUtils::ObsGroupLocationTimes obsLocTime =
       TrackCheckUtils::collectObservationsLocations(obsAccessor);
 
-  std::vector<bool> isRejected(obsLocTime.latitudes.size(), false);
-  size_t trackNumber = 0;
-  for (auto track : splitter.multiElementGroups()) {
-    trackNumber++;
-    std::string stationId = std::to_string(trackNumber);
+  // Tracks are independent of each other, so they are checked concurrently (except in testing
+  // mode, where diagnostics are stored in the order the tracks are processed). Each observation
+  // belongs to a single track, so threads write to disjoint elements of isRejected (which is
+  // therefore not a std::vector<bool>).
+  std::vector<RecursiveSplitter::Group> tracks;
+  for (auto track : splitter.multiElementGroups())
+    tracks.push_back(track);
+  std::vector<char> isRejected(obsLocTime.latitudes.size(), false);
+  #pragma omp parallel for schedule(dynamic) if (!options_.testingMode.value())
+  for (size_t itrack = 0; itrack < tracks.size(); ++itrack) {
+    const RecursiveSplitter::Group &track = tracks[itrack];
+    std::string stationId = std::to_string(itrack + 1);
     std::vector<TrackObservation> trackObservations = collectTrackObservations(
           track.begin(), track.end(), validObsIds, obsLocTime);
     std::vector<std::reference_wrapper<TrackObservation>> trackObservationsReferences;
@@ -207,15 +213,21 @@ void TrackCheckShip::applyFilter(const std::vector<bool> & apply,
         TrackCheckShip::earlyBreak(trackObservationsReferences, stationId)) {
       continue;
     }
+      // Observations ordered by decreasing speed and then by increasing observation number, so
+      // that the first element corresponds to the first of the fastest segments of the track.
+      std::set<std::pair<double, size_t>> observationsBySpeed;
+      for (const TrackObservation &obs : trackObservationsReferences)
+        observationsBySpeed.emplace(-obs.getObservationStatistics().speed,
+                                    obs.getObservationNumber());
       bool firstIterativeRemoval = true;
       while (trackObservationsReferences.size() >= 3) {
         // Initial loop: fastest (as determined by set of comparisons) observation removed
         // until all segments show slower speed than max threshold
-        auto maxSpeedReferenceIterator = std::max_element(
+        auto maxSpeedReferenceIterator = std::lower_bound(
               trackObservationsReferences.begin(), trackObservationsReferences.end(),
-              [](TrackObservation a, TrackObservation b) {
-            return a.getObservationStatistics().speed <
-            b.getObservationStatistics().speed;});
+              observationsBySpeed.begin()->second,
+              [](const TrackObservation &obs, size_t observationNumber) {
+            return obs.getObservationNumber() < observationNumber;});
         auto maxSpeedValue = maxSpeedReferenceIterator->get().getObservationStatistics().speed;
         if (maxSpeedValue <= (0.8 * options_.core.maxSpeed.value())) {
           break;
@@ -227,15 +239,32 @@ void TrackCheckShip::applyFilter(const std::vector<bool> & apply,
             break;
           }
         }
+        // Only the observations surrounding the fastest segment are removed or have their
+        // properties changed by the removal.
+        const size_t fastestPosition =
+            maxSpeedReferenceIterator - trackObservationsReferences.begin();
+        const std::vector<std::reference_wrapper<TrackObservation>> affectedObservations(
+              maxSpeedReferenceIterator - 1,
+              std::min(maxSpeedReferenceIterator + 2, trackObservationsReferences.end()));
+        for (const TrackObservation &obs : affectedObservations)
+          observationsBySpeed.erase({-obs.getObservationStatistics().speed,
+                                     obs.getObservationNumber()});
         removeFaultyObservation(
               trackObservationsReferences, maxSpeedReferenceIterator, firstIterativeRemoval,
               stationId);
         firstIterativeRemoval = false;
-        calculateTrackSegmentProperties(trackObservationsReferences, CalculationMethod::MAINLOOP);
+        updateTrackSegmentProperties(trackObservationsReferences,
+                                     affectedObservations.front().get().rejected() ?
+                                       fastestPosition - 1 : fastestPosition);
+        for (const TrackObservation &obs : affectedObservations)
+          if (!obs.rejected())
+            observationsBySpeed.emplace(-obs.getObservationStatistics().speed,
+                                        obs.getObservationNumber());
       }
       auto rejectedCount = std::count_if(trackObservations.begin(), trackObservations.end(),
                     [](const TrackObservation& a) {return a.rejected();});
       if (rejectedCount >= options_.core.rejectionThreshold.value() * trackObservations.size()) {
+        #pragma omp critical(TrackCheckShipLog)
         oops::Log::trace() << "CheckShipTrack: track " << stationId << " NumRej " <<
                               rejectedCount << " out of " << trackObservations.size() <<
                               " reports rejected. *** Reject whole track ***\n";
@@ -245,8 +274,9 @@ void TrackCheckShip::applyFilter(const std::vector<bool> & apply,
       flagRejectedTrackObservations(track.begin(), track.end(),
                                     validObsIds, trackObservations, isRejected);
   }
+  const std::vector<bool> isRejectedBool(isRejected.begin(), isRejected.end());
   obsAccessor.flagRejectedObservations(options_.recordsAreSingleObs ?
-    recordHandler.changeThinnedIfRecordsAreSingleObs(isRejected) : isRejected,
+    recordHandler.changeThinnedIfRecordsAreSingleObs(isRejectedBool) : isRejectedBool,
     flagged);
 }
 
@@ -267,7 +297,7 @@ std::vector<TrackCheckShip::TrackObservation> TrackCheckShip::collectTrackObserv
     const size_t obsId = validObsIds[*it];
     trackObservations.push_back(TrackObservation(obsLocTime.latitudes[obsId],
                                                  obsLocTime.longitudes[obsId],
-                                                 obsLocTime.datetimes[obsId], trackStatistics,
+                                                 obsLocTime.times[obsId], trackStatistics,
                                                  checkCounter,
                                                  observationNumber));
     observationNumber++;
@@ -296,6 +326,7 @@ bool TrackCheckShip::earlyBreak(const std::vector<std::reference_wrapper<TrackOb
              options_.inputCategory.value() != SurfaceObservationSubtype::BUOYPROF)
             * trackStats.numShort_ + trackStats.numFast_) + trackStats.numBends_)
       >= (trackObs.size() - 1)) {
+    #pragma omp critical(TrackCheckShipLog)
     oops::Log::trace() << "ShipTrackCheck: " << trackId << "\n" <<
                           "Time difference < 1 hour: " << trackStats.numShort_ << "\n" <<
                           "Fast: " << trackStats.numFast_ << "\n" <<
@@ -318,7 +349,7 @@ void TrackCheckShip::removeFaultyObservation(
     &observationAfterFastestSegment,
     bool firstIterativeRemoval, const std::string trackId) const {
   int errorCategory = 0;
-  util::Duration four_days{"P4D"};
+  const int64_t four_days = util::Duration("P4D").toSeconds();
   auto rejectedObservation = observationAfterFastestSegment;
   // lambda function to "fail" an observation that should be rejected
   auto fail = [&rejectedObservation](
@@ -417,13 +448,13 @@ void TrackCheckShip::removeFaultyObservation(
     double distanceCurrentObsOmitted =
           neighborObservationStatistics(-1).distance +
         neighborObservationStatistics(0).distanceAveraged;
-    util::Duration timeSum = (observationAfterFastestSegment + 1)->get().getTime() - (
+    const int64_t timeSum = (observationAfterFastestSegment + 1)->get().getTime() - (
           observationAfterFastestSegment - 2)->get().getTime();
     if (options_.testingMode.value()) {
       diagnostics_->storeDistanceSum(distanceSum);
       diagnostics_->storeDistancePrevObsOmitted(distancePrevObsOmitted);
       diagnostics_->storeDistanceCurrentObsOmitted(distanceCurrentObsOmitted);
-      double timeDouble = timeSum.toSeconds();
+      double timeDouble = timeSum;
       diagnostics_->storeTimeSum(timeDouble);
     }
     if (distancePrevObsOmitted < distanceCurrentObsOmitted - std::max(
@@ -435,7 +466,7 @@ void TrackCheckShip::removeFaultyObservation(
                    options_.core.spatialResolution.value(), 0.1 * distanceSum))) {
       fail(observationAfterFastestSegment);
       errorCategory = 9;
-    } else if (timeSum <= four_days && timeSum.toSeconds() > 0 &&
+    } else if (timeSum <= four_days && timeSum > 0 &&
                std::min(distancePrevObsOmitted, distanceCurrentObsOmitted) > 0.0) {
       double previousSegmentDistanceProportion =
           // Prev segment dist/(prev segment distance + distAveragedCurrentObservation)
@@ -446,13 +477,13 @@ void TrackCheckShip::removeFaultyObservation(
           neighborObservationStatistics(-1).
           distanceAveraged / distancePrevObsOmitted;
       double previousSegmentTimeProportion =
-          static_cast<double>(((observationAfterFastestSegment - 1)->get().getTime() -
-           (observationAfterFastestSegment - 2)->get().getTime()).toSeconds()) /
-          timeSum.toSeconds();
+          static_cast<double>((observationAfterFastestSegment - 1)->get().getTime() -
+                              (observationAfterFastestSegment - 2)->get().getTime()) /
+          timeSum;
       double previousAndFastestSegmentTimeProportion =
-          static_cast<double>(((observationAfterFastestSegment->get().getTime()) -
-            (observationAfterFastestSegment - 2)->get().getTime()).toSeconds()) /
-          timeSum.toSeconds();
+          static_cast<double>(observationAfterFastestSegment->get().getTime() -
+                              (observationAfterFastestSegment - 2)->get().getTime()) /
+          timeSum;
       if (options_.testingMode.value()) {
         diagnostics_->storePreviousSegmentDistanceProportion(previousSegmentDistanceProportion);
         diagnostics_->storePreviousObservationDistanceAveragedProportion(
@@ -479,6 +510,7 @@ void TrackCheckShip::removeFaultyObservation(
       } else {
         fail(observationAfterFastestSegment);
       }
+      #pragma omp critical(TrackCheckShipLog)
       oops::Log::trace() << "CheckShipTrack: proportions " << previousSegmentDistanceProportion <<
                             " " << previousSegmentTimeProportion <<
                             " " << previousObservationDistanceAveragedProportion << " "
@@ -488,6 +520,7 @@ void TrackCheckShip::removeFaultyObservation(
                             neighborObservationStatistics(1).speed << " [m/s]" << std::endl;
     }
     if (errorCategory == 9 || std::min(distancePrevObsOmitted, distanceCurrentObsOmitted) == 0.0) {
+      #pragma omp critical(TrackCheckShipLog)
       oops::Log::trace() << "CheckShipTrack: Dist check, station id: " <<
                             trackId << std::endl <<
                             " error category: " << errorCategory << std::endl <<
@@ -503,6 +536,7 @@ void TrackCheckShip::removeFaultyObservation(
   if (errorCategory == 0 || ((rejectedObservation->get().getObservationStatistics().
                               speedAveraged) >
                              options_.core.maxSpeed.value())) {
+    #pragma omp critical(TrackCheckShipLog)
     oops::Log::trace() << "CheckShipTrack: cannot decide between station id " <<
                           trackId << " observations " <<
                           (observationAfterFastestSegment - 1)->get().getObservationNumber() <<
@@ -527,6 +561,7 @@ void TrackCheckShip::removeFaultyObservation(
             std::make_pair(rejectedObservationNumber,
                            errorCategory));
     }
+    #pragma omp critical(TrackCheckShipLog)
     oops::Log::trace() << "CheckShipTrack: rejecting station " << trackId << " observation " <<
                           rejectedObservation->get().getObservationNumber() << "\n" <<
                           "Error category: " << errorCategory << "\n" <<
@@ -637,11 +672,34 @@ void TrackCheckShip::calculateTrackSegmentProperties(
   }
 }
 
+/// Produces the same results as \p calculateTrackSegmentProperties called with the MAINLOOP
+/// method, but only recalculates the properties that depend on the observations that became
+/// adjacent when the observations preceding position \p firstChangedPosition were removed.
+void TrackCheckShip::updateTrackSegmentProperties(
+    const std::vector<std::reference_wrapper<TrackObservation>> &trackObservations,
+    size_t firstChangedPosition) const {
+  const size_t numObservations = trackObservations.size();
+  if (numObservations == 0)
+    return;
+  if (firstChangedPosition == 0) {
+    trackObservations[0].get().resetObservationCalculations();
+    return;
+  }
+  if (firstChangedPosition < numObservations)
+    trackObservations[firstChangedPosition].get().calculateTwoObservationValues(
+          trackObservations[firstChangedPosition - 1].get(), false, options_);
+  for (size_t obsIdx = std::max<size_t>(firstChangedPosition - 1, 1);
+       obsIdx <= firstChangedPosition && obsIdx + 1 < numObservations; ++obsIdx)
+    trackObservations[obsIdx].get().calculateThreeObservationValues(
+          trackObservations[obsIdx - 1].get(), trackObservations[obsIdx + 1].get(),
+          false, options_);
+}
+
 /// \brief Keeps track of 0-distanced, short, and fast track segments,
 /// as well as incrementing \p sumSpeed_ for normal track segments.
 void TrackCheckShip::TrackObservation::adjustTwoObservationStatistics
 (const TrackCheckShipParameters &options) const {
-  util::Duration hour{"PT1H"};
+  const int64_t hour = util::Duration("PT1H").toSeconds();
   if (getObservationStatistics().timeDifference < hour) {
     getFullTrackStatistics()->numShort_++;
   } else if (getObservationStatistics().speed >= options.core.maxSpeed) {
@@ -672,7 +730,7 @@ TrackCheckShip::TrackObservation::getFullTrackStatistics() const
 void TrackCheckShip::TrackObservation::setDistance(double dist) {
   this->observationStatistics_.distance = dist;
 }
-void TrackCheckShip::TrackObservation::setTimeDifference(util::Duration tDiff) {
+void TrackCheckShip::TrackObservation::setTimeDifference(int64_t tDiff) {
   this->observationStatistics_.timeDifference = tDiff;
 }
 void TrackCheckShip::TrackObservation::setSpeed(double speed) {
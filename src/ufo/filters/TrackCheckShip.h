@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <list>
@@ -72,8 +73,8 @@ class TrackCheckShip: public FilterBase,
   /// of adjacent/alternating observations
   struct ObservationStatistics {
     /// \brief \p timeDifference between the same-index observation and the
-    /// previous one.
-    util::Duration timeDifference{};
+    /// previous one (in seconds).
+    int64_t timeDifference{};
     /// \p distance between the same-index observation and the
     /// previous-index observation.
     double distance{};
@@ -120,18 +121,19 @@ class TrackCheckShip: public FilterBase,
   class TrackObservation {
    public:
     TrackObservation(double latitude, double longitude,
-                     const util::DateTime &time,
+                     int64_t time,
                      const std::shared_ptr<TrackStatistics> & trackStatistics,
                      const std::shared_ptr<TrackCheckUtils::CheckCounter> & checkCounter,
                      size_t observationNumber);
     const TrackCheckUtils::Point& getLocation() const {
       return obsLocationTime_.location();
     }
-    const util::DateTime& getTime() const {
+    /// Observation time (seconds since 1970-01-01T00:00:00Z).
+    int64_t getTime() const {
       return obsLocationTime_.time();
     }
     void setDistance(double dist);
-    void setTimeDifference(util::Duration tDiff);
+    void setTimeDifference(int64_t tDiff);
     void setSpeed(double speed);
     void setAngle(double angle);
     void setDistanceAveraged(double distAvg);
@@ -194,7 +196,7 @@ class TrackCheckShip: public FilterBase,
       std::vector<size_t>::const_iterator trackObsIndicesEnd,
       const std::vector<size_t> &validObsIds,
       const std::vector<TrackObservation> &trackObservations,
-      std::vector<bool> &isRejected) const;
+      std::vector<char> &isRejected) const;
 
   void print(std::ostream &) const override;
   void applyFilter(const std::vector<bool> &, const Variables &,
@@ -207,6 +209,12 @@ class TrackCheckShip: public FilterBase,
       const std::vector<std::reference_wrapper<TrackObservation>> &trackObservations,
       CalculationMethod calculationMethod = MAINLOOP) const;
 
+  /// Recalculate the properties of the track segments affected by the removal of the
+  /// observations that preceded position \p firstChangedPosition of \p trackObservations.
+  void updateTrackSegmentProperties(
+      const std::vector<std::reference_wrapper<TrackObservation>> &trackObservations,
+      size_t firstChangedPosition) const;
+
   std::vector<TrackObservation> collectTrackObservations(
       std::vector<size_t>::const_iterator trackObsIndicesBegin,
       std::vector<size_t>::const_iterator trackObsIndicesEnd,
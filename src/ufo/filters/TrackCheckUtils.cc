@@ -78,7 +78,7 @@ ObsAccessor TrackCheckUtils::createObsAccessor(const boost::optional<Variable> &
 void TrackCheckUtils::sortTracksChronologically(const std::vector<size_t> &validObsIds,
                                                 const ObsAccessor &obsAccessor,
                                                 RecursiveSplitter &splitter) {
-  const std::vector<util::DateTime> times = obsAccessor.getDateTimeVariableFromObsSpace(
+  const std::vector<int64_t> times = obsAccessor.getEpochSecondsFromObsSpace(
         "MetaData", "dateTime");
   splitter.sortGroupsBy([&times, &validObsIds](size_t obsIndex)
   { return times[validObsIds[obsIndex]]; });
@@ -90,13 +90,13 @@ TrackCheckUtils::ObsGroupLocationTimes
 
   locationTimes.latitudes = obsAccessor.getFloatVariableFromObsSpace("MetaData", "latitude");
   locationTimes.longitudes = obsAccessor.getFloatVariableFromObsSpace("MetaData", "longitude");
-  locationTimes.datetimes = obsAccessor.getDateTimeVariableFromObsSpace("MetaData", "dateTime");
+  locationTimes.times = obsAccessor.getEpochSecondsFromObsSpace("MetaData", "dateTime");
 
   return locationTimes;
 }
 
 TrackCheckUtils::ObsLocationTime::ObsLocationTime(float latitude, float longitude,
-                                                                  const util::DateTime &time)
+                                                  int64_t time)
   :  location_(pointFromLatLon(latitude, longitude)), time_(time)
 {}
 
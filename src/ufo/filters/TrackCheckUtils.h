@@ -9,6 +9,7 @@
 #define UFO_FILTERS_TRACKCHECKUTILS_H_
 
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -50,18 +51,20 @@ class ObsGroupLocationTimes {
  public:
   std::vector<float> latitudes;
   std::vector<float> longitudes;
-  std::vector<util::DateTime> datetimes;
+  /// Observation times (seconds since 1970-01-01T00:00:00Z).
+  std::vector<int64_t> times;
 };
 
 class ObsLocationTime {
  public:
-  ObsLocationTime(float latitude, float longitude,
-                          const util::DateTime &time);
+  /// \param time Observation time (seconds since 1970-01-01T00:00:00Z).
+  ObsLocationTime(float latitude, float longitude, int64_t time);
   const Point &location() const { return location_; }
-  const util::DateTime &time() const { return time_; }
+  /// Observation time (seconds since 1970-01-01T00:00:00Z).
+  int64_t time() const { return time_; }
  private:
   Point location_;
-  util::DateTime time_;
+  int64_t time_;
 };
 
 class CheckCounter {
@@ -41,6 +41,7 @@ Variable::Variable(const eckit::Configuration & conf)
     std::set<int> channelset = oops::parseIntSet(chlist);
     std::copy(channelset.begin(), channelset.end(), std::back_inserter(channels_));
   }
+  setChannelVarnames();
   oops::Log::trace() << "ufo::Variable(conf) done" << std::endl;
 }
 
@@ -59,6 +60,7 @@ Variable::Variable(const std::string & fullname, const std::vector<int> & channe
   : varname_(), grpname_(), channels_(channels), options_() {
   oops::Log::trace() << "ufo::Variable(name, channels) start " << std::endl;
   splitVarGroup(fullname, varname_, grpname_);
+  setChannelVarnames();
   oops::Log::trace() << "ufo::Variable(name, channels) done" << std::endl;
 }
 
@@ -66,7 +68,14 @@ Variable::Variable(const std::string & fullname, const std::vector<int> & channe
 
 Variable::Variable(const Variable & var, const std::string & group)
   : varname_(var.varname_), grpname_(group), channels_(var.channels_),
-    options_(var.options_) {
+    channelVarnames_(var.channelVarnames_), options_(var.options_) {
+}
+
+// -----------------------------------------------------------------------------
+
+Variable::Variable(const std::string & varname, const std::string & grpname,
+                   const eckit::LocalConfiguration & options)
+  : varname_(varname), grpname_(grpname), channels_(), options_(options) {
 }
 
 // -----------------------------------------------------------------------------
@@ -87,12 +96,7 @@ size_t Variable::size() const {
 // -----------------------------------------------------------------------------
 
 Variable Variable::operator[](const size_t jch) const {
-  ASSERT(jch < this->size());
-  std::string var;
-  if (grpname_ != "")        var += grpname_ + "/";
-  var += varname_;
-  if (channels_.size() > 0)  var += "_" + std::to_string(channels_[jch]);
-  return Variable(var, options_);
+  return Variable(this->variable(jch), grpname_, options_);
 }
 
 
@@ -104,17 +108,26 @@ const std::string & Variable::variable() const {
 
 // -----------------------------------------------------------------------------
 
-std::string Variable::variable(const size_t jch) const {
+const std::string & Variable::variable(const size_t jch) const {
   ASSERT(jch < this->size());
-  if (jch == 0 && channels_.size() == 0) {
+  if (channels_.size() == 0) {
     return varname_;
   } else {
-    return varname_ + "_" + std::to_string(channels_[jch]);
+    return channelVarnames_[jch];
   }
 }
 
 // -----------------------------------------------------------------------------
 
+void Variable::setChannelVarnames() {
+  channelVarnames_.clear();
+  channelVarnames_.reserve(channels_.size());
+  for (int channel : channels_)
+    channelVarnames_.push_back(varname_ + "_" + std::to_string(channel));
+}
+
+// -----------------------------------------------------------------------------
+
 const std::string & Variable::group() const {
   return grpname_;
 }
@@ -162,7 +175,7 @@ void Variable::print(std::ostream & os) const {
         os << ", ";
       if (!grpname_.empty())
         os << grpname_ << '/';
-      os << varname_ << '_' << std::to_string(channels_[jj]);
+      os << channelVarnames_[jj];
     }
   }
 }
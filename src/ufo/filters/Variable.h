@@ -35,9 +35,14 @@ class Variable: public util::Printable {
   ~Variable();
 
   size_t size() const;
-  Variable operator[](const size_t) const;
+  /// Return the variable corresponding to channel \p jch (or the variable itself if it has no
+  /// channels). Its name is taken from the list of channel names computed on construction.
+  Variable operator[](const size_t jch) const;
   const std::string & variable() const;
-  std::string variable(const size_t) const;
+  /// Return the name of the variable corresponding to channel \p jch, e.g.
+  /// `brightness_temperature_123` (or the variable name if it has no channels). The names of all
+  /// channels are computed once, on construction.
+  const std::string & variable(const size_t jch) const;
   const std::string & group() const;
   const std::vector<int> & channels() const;
 
@@ -50,10 +55,16 @@ class Variable: public util::Printable {
   const eckit::LocalConfiguration & options() const {return options_;}
 
  private:
+  /// Construct a variable without channels from its name, group and options.
+  Variable(const std::string & varname, const std::string & grpname,
+           const eckit::LocalConfiguration & options);
   void print(std::ostream &) const;
+  /// Fill channelVarnames_ with the names of the variables corresponding to channels_.
+  void setChannelVarnames();
   std::string varname_;
   std::string grpname_;
   std::vector<int> channels_;
+  std::vector<std::string> channelVarnames_;
   eckit::LocalConfiguration options_;
 };
 
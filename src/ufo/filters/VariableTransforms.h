@@ -60,6 +60,7 @@ class VariableTransforms : public FilterBase,
   void applyFilter(const std::vector<bool> &, const Variables &,
                    std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override { return QCflags::pass; }
+  bool modifiesObsSpace() const override { return true; }
 };
 
 }  // namespace ufo
@@ -0,0 +1,91 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <utility>
+#include <vector>
+
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+
+#include "oops/util/Logger.h"
+
+#include "ufo/filters/VariableTransformParametersBase.h"
+#include "ufo/filters/VariableTransformsPipeline.h"
+#include "ufo/variabletransforms/TransformBase.h"
+#include "ufo/variabletransforms/TransformColumns.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+VariableTransformsPipeline::VariableTransformsPipeline(
+    ioda::ObsSpace& obsdb, const Parameters_ & parameters,
+    std::shared_ptr<ioda::ObsDataVector<int>> flags,
+    std::shared_ptr<ioda::ObsDataVector<float>> obserr)
+  : FilterBase(obsdb, parameters, flags, obserr), parameters_(parameters)
+{
+  allvars_ += Variables(filtervars_);
+  for (const eckit::LocalConfiguration &config : parameters_.transforms.value()) {
+    std::unique_ptr<VariableTransformParametersBase> transformParameters =
+        TransformFactory::createParameters(config.getString("Transform"));
+    transformParameters->validateAndDeserialize(config);
+
+    // Add any required transform variables to allvars_
+    std::unique_ptr<TransformBase> transform =
+        TransformFactory::create(transformParameters->Transform.value(), *transformParameters,
+                                 data_, flags_, obserr_);
+    allvars_ += transform->requiredVariables();
+
+    transformParameters_.push_back(std::move(transformParameters));
+  }
+
+  oops::Log::debug() << this << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+VariableTransformsPipeline::~VariableTransformsPipeline() {}
+
+// -----------------------------------------------------------------------------
+
+void VariableTransformsPipeline::applyFilter(
+    const std::vector<bool>& apply, const Variables&,
+    std::vector<std::vector<bool>>&) const {
+  print(oops::Log::trace());
+
+  // Do not perform transformation if there are no observations present.
+  if (data_.nlocs() == 0) {
+    oops::Log::debug() << " --> No observations present. "
+                       << "Transformation will not be performed." << std::endl;
+    return;
+  }
+
+  TransformColumns columns(obsdb_);
+  for (const std::unique_ptr<VariableTransformParametersBase> &transformParameters :
+         transformParameters_) {
+    // Create the transform again, since data_ is updated by the filter but not by the copy
+    // held by the variable transform.
+    std::unique_ptr<TransformBase> transform =
+        TransformFactory::create(transformParameters->Transform.value(), *transformParameters,
+                                 data_, flags_, obserr_);
+    transform->setColumns(&columns);
+    oops::Log::debug() << "         estimate: " << transformParameters->Transform.value()
+                       << std::endl;
+    transform->runTransform(apply);
+  }
+  columns.commit();
+}
+
+// -----------------------------------------------------------------------------
+
+void VariableTransformsPipeline::print(std::ostream& os) const {
+  os << "VariableTransformsPipeline: config = " << parameters_ << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
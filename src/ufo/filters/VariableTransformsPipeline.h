@@ -0,0 +1,90 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_VARIABLETRANSFORMSPIPELINE_H_
+#define UFO_FILTERS_VARIABLETRANSFORMSPIPELINE_H_
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+
+#include "oops/util/ObjectCounter.h"
+#include "oops/util/parameters/RequiredParameter.h"
+
+#include "ufo/filters/FilterBase.h"
+#include "ufo/filters/QCflags.h"
+
+namespace ioda {
+template <typename DATATYPE>
+class ObsDataVector;
+class ObsSpace;
+}
+
+namespace ufo {
+class VariableTransformParametersBase;
+}
+
+namespace ufo {
+
+/// \brief Options controlling the VariableTransformsPipeline filter.
+class VariableTransformsPipelineParameters : public FilterParametersBase {
+  OOPS_CONCRETE_PARAMETERS(VariableTransformsPipelineParameters, FilterParametersBase)
+
+ public:
+  /// Transforms to run, in this order. Each item accepts the same options as the
+  /// `Variable Transforms` filter (`Transform`, `Method`, `UseValidDataOnly` and the options of
+  /// the chosen transform). Generic filter options such as `where` or `filter variables` must be
+  /// set at the level of the pipeline; they are ignored in the items.
+  oops::RequiredParameter<std::vector<eckit::LocalConfiguration>> transforms{"transforms", this};
+};
+
+/// \brief Filter running a sequence of variable transforms and saving their results in the
+/// ObsSpace once all of them have run.
+///
+/// Example:
+///
+///     - filter: Variable Transforms Pipeline
+///       transforms:
+///       - Transform: WindSpeedAndDirection
+///       - Transform: WindComponents
+///         group: DerivedObsValue
+///
+/// The transforms share the variables they derive in memory: a transform reading a variable
+/// saved by an earlier transform of the pipeline gets it without a round trip through the
+/// ObsSpace, and each derived variable is written to the ObsSpace only once, at the end, even if
+/// several transforms update it. The results are the same as those of a sequence of
+/// `Variable Transforms` filters with the same options (and the same `where` clause).
+class VariableTransformsPipeline : public FilterBase,
+                                   private util::ObjectCounter<VariableTransformsPipeline> {
+ public:
+  static const std::string classname() { return "ufo::VariableTransformsPipeline"; }
+
+  typedef VariableTransformsPipelineParameters Parameters_;
+
+  VariableTransformsPipeline(ioda::ObsSpace &, const Parameters_ &,
+                             std::shared_ptr<ioda::ObsDataVector<int>>,
+                             std::shared_ptr<ioda::ObsDataVector<float>>);
+  ~VariableTransformsPipeline();
+
+ private:
+  void print(std::ostream &) const override;
+  void applyFilter(const std::vector<bool> &, const Variables &,
+                   std::vector<std::vector<bool>> &) const override;
+  int qcFlag() const override { return QCflags::pass; }
+  bool modifiesObsSpace() const override { return true; }
+
+  Parameters_ parameters_;
+  /// Options of the successive transforms.
+  std::vector<std::unique_ptr<VariableTransformParametersBase>> transformParameters_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_VARIABLETRANSFORMSPIPELINE_H_
@@ -7,14 +7,35 @@
 
 #include "ufo/filters/actions/AcceptObs.h"
 
+#include <memory>
+
 #include "ioda/ObsDataVector.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/QCflags.h"
+#include "ufo/utils/BitMask.h"
 
 namespace ufo {
 
 // -----------------------------------------------------------------------------
 
+namespace {
+
+/// Accepts observations that have not been flagged as missing, pre-QC-rejected or failed by
+/// the H(x) operator.
+class AcceptFlagged : public FilterActionKernel {
+ public:
+  void apply(size_t, size_t, int &qcFlag, float &) const override {
+    if (qcFlag != QCflags::missing &&
+        qcFlag != QCflags::preQC &&
+        qcFlag != QCflags::Hfailed)
+      qcFlag = QCflags::pass;
+  }
+};
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
 static FilterActionMaker<AcceptObs> acceptObsMaker_("accept");
 
 // -----------------------------------------------------------------------------
@@ -27,22 +48,31 @@ AcceptObs::AcceptObs(const Parameters_ &)
 
 void AcceptObs::apply(const Variables & vars,
                       const std::vector<std::vector<bool>> & flagged,
-                      const ObsFilterData &,
-                      int /*filterQCflag*/,
+                      const ObsFilterData & data,
+                      int filterQCflag,
                       ioda::ObsDataVector<int> & flags,
-                      ioda::ObsDataVector<float> &) const {
-  for (size_t ifiltervar = 0; ifiltervar < vars.nvars(); ++ifiltervar) {
-    const size_t iallvar = flags.varnames().find(vars.variable(ifiltervar).variable());
-    for (size_t jobs = 0; jobs < flags.nlocs(); ++jobs) {
-      if (flagged[ifiltervar][jobs]) {
-        int &currentFlag = flags[iallvar][jobs];
-        if (currentFlag != QCflags::missing &&
-            currentFlag != QCflags::preQC &&
-            currentFlag != QCflags::Hfailed)
-          currentFlag = QCflags::pass;
-      }
-    }
-  }
+                      ioda::ObsDataVector<float> & obserr) const {
+  applyToMasks(vars, toBitMasks(flagged), data, filterQCflag, flags, obserr);
+}
+
+// -----------------------------------------------------------------------------
+
+void AcceptObs::applyToMasks(const Variables & vars,
+                             const std::vector<BitMask> & flagged,
+                             const ObsFilterData & data,
+                             int filterQCflag,
+                             ioda::ObsDataVector<int> & flags,
+                             ioda::ObsDataVector<float> & obserr) const {
+  const std::unique_ptr<FilterActionKernel> kernel = makeKernel(vars, data, filterQCflag, obserr);
+  applyKernels({kernel.get()}, vars, flagged, flags, obserr);
+}
+
+// -----------------------------------------------------------------------------
+
+std::unique_ptr<FilterActionKernel> AcceptObs::makeKernel(
+    const Variables &, const ObsFilterData &, int,
+    const ioda::ObsDataVector<float> &) const {
+  return boost::make_unique<AcceptFlagged>();
 }
 
 // -----------------------------------------------------------------------------
@@ -8,18 +8,67 @@
 #include "ufo/filters/actions/AssignError.h"
 
 #include <algorithm>
+#include <memory>
+#include <numeric>
 #include <set>
+#include <utility>
 
 #include "ioda/ObsDataVector.h"
 #include "oops/base/Variables.h"
 #include "oops/util/missingValues.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/QCflags.h"
+#include "ufo/utils/BitMask.h"
 
 namespace ufo {
 
 // -----------------------------------------------------------------------------
 
+namespace {
+
+/// Sets the errors of observations that passed QC so far to a constant depending only on the
+/// filter variable.
+class AssignConstantErrors : public FilterActionKernel {
+ public:
+  /// \param errors Error assigned to each filter variable.
+  explicit AssignConstantErrors(std::vector<float> &&errors) : errors_(std::move(errors)) {}
+
+  void apply(size_t jv, size_t, int &qcFlag, float &obsError) const override {
+    if (qcFlag == QCflags::pass)
+      obsError = errors_[jv];
+  }
+
+ private:
+  std::vector<float> errors_;
+};
+
+/// Sets the errors of observations that passed QC so far to the non-missing values of an error
+/// function.
+class AssignErrorsFromVariable : public FilterActionKernel {
+ public:
+  /// \param errors Values of the error function, one vector per error variable.
+  /// \param errorIndices Index of the error variable used for each filter variable.
+  AssignErrorsFromVariable(std::vector<std::vector<float>> &&errors,
+                           std::vector<size_t> &&errorIndices)
+    : errors_(std::move(errors)), errorIndices_(std::move(errorIndices)),
+      missing_(util::missingValue(missing_)) {}
+
+  void apply(size_t jv, size_t jobs, int &qcFlag, float &obsError) const override {
+    const float error = errors_[errorIndices_[jv]][jobs];
+    if (qcFlag == QCflags::pass && error != missing_)
+      obsError = error;
+  }
+
+ private:
+  std::vector<std::vector<float>> errors_;
+  std::vector<size_t> errorIndices_;
+  float missing_;
+};
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
 static FilterActionMaker<AssignError> makerAssignErr_("assign error");
 
 // -----------------------------------------------------------------------------
@@ -53,64 +102,70 @@ AssignError::AssignError(const Parameters_ & parameters)
 void AssignError::apply(const Variables & vars,
                         const std::vector<std::vector<bool>> &mask,
                         const ObsFilterData & data,
-                        int /*filterQCflag*/,
+                        int filterQCflag,
                         ioda::ObsDataVector<int> & qcFlags,
                         ioda::ObsDataVector<float> & obserr) const {
+  applyToMasks(vars, toBitMasks(mask), data, filterQCflag, qcFlags, obserr);
+}
+
+// -----------------------------------------------------------------------------
+
+void AssignError::applyToMasks(const Variables & vars,
+                               const std::vector<BitMask> &mask,
+                               const ObsFilterData & data,
+                               int filterQCflag,
+                               ioda::ObsDataVector<int> & qcFlags,
+                               ioda::ObsDataVector<float> & obserr) const {
   oops::Log::debug() << " AssignError input obserr: " << obserr << std::endl;
-  const float missing = util::missingValue(missing);
+  const std::unique_ptr<FilterActionKernel> kernel = makeKernel(vars, data, filterQCflag, obserr);
+  applyKernels({kernel.get()}, vars, mask, qcFlags, obserr);
+  oops::Log::debug() << " AssignError output obserr: " << obserr << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+std::unique_ptr<FilterActionKernel> AssignError::makeKernel(
+    const Variables & vars, const ObsFilterData & data, int,
+    const ioda::ObsDataVector<float> & obserr) const {
   // If float error is specified
   if (parameters_.errorParameter.value() != boost::none) {
-    float error = *parameters_.errorParameter.value();
-    for (size_t jv = 0; jv < vars.nvars(); ++jv) {
-      size_t iv = obserr.varnames().find(vars.variable(jv).variable());
-      size_t kv = qcFlags.varnames().find(vars.variable(jv).variable());
-      for (size_t jobs = 0; jobs < obserr.nlocs(); ++jobs) {
-        if (mask[jv][jobs] && qcFlags[kv][jobs] == QCflags::pass) obserr[iv][jobs] = error;
-      }
-    }
-    // If variable is specified
-  } else if (parameters_.errorParameterVector.value() != boost::none) {
-    std::vector<float> errorvector = *parameters_.errorParameterVector.value();
-    for (size_t jv = 0; jv < vars.nvars(); ++jv) {
-      size_t iv = obserr.varnames().find(vars.variable(jv).variable());
-      size_t kv = qcFlags.varnames().find(vars.variable(jv).variable());
-      for (size_t jobs = 0; jobs < obserr.nlocs(); ++jobs) {
-        if (mask[jv][jobs] && qcFlags[kv][jobs] == QCflags::pass) {
-          obserr[iv][jobs] = errorvector[iv];
-        }
-      }
-    }
-    // If variable is specified
-  } else if (parameters_.errorFunction.value() != boost::none) {
-    const Variable &errorvar = *parameters_.errorFunction.value();
-    ASSERT(errorvar.size() == 1 || errorvar.size() == vars.nvars());
-    ioda::ObsDataVector<float> errors(data.obsspace(), errorvar.toOopsVariables(),
-                                      errorvar.group(), false);
-    data.get(errorvar, errors);
-
-    // if assigned error function is 1D variable, apply the same error to all variables
-    // error_jv = {0, 0, 0, ..., 0} for all nvars
-    std::vector<size_t> error_jv(vars.nvars(), 0);
-    // if multiple variables are in the assigned error function, apply different error to different
-    // variables
-    // error_jv = {0, 1, 2, ..., nvars-1}
-    if (errorvar.size() == vars.nvars()) {
-      std::iota(error_jv.begin(), error_jv.end(), 0);
-    }
+    return boost::make_unique<AssignConstantErrors>(
+          std::vector<float>(vars.nvars(), *parameters_.errorParameter.value()));
+  }
 
-    // loop over all variables to update
+  // If variable is specified
+  if (parameters_.errorParameterVector.value() != boost::none) {
+    const std::vector<float> &errorvector = *parameters_.errorParameterVector.value();
+    std::vector<float> errors(vars.nvars());
     for (size_t jv = 0; jv < vars.nvars(); ++jv) {
-      // find current variable index in obserr
       size_t iv = obserr.varnames().find(vars.variable(jv).variable());
-      size_t kv = qcFlags.varnames().find(vars.variable(jv).variable());
-      for (size_t jobs = 0; jobs < obserr.nlocs(); ++jobs) {
-        if (mask[jv][jobs] && qcFlags[kv][jobs] == QCflags::pass
-                              && errors[error_jv[jv]][jobs] != missing)
-          obserr[iv][jobs] = errors[error_jv[jv]][jobs];
-      }
+      errors[jv] = errorvector[iv];
     }
+    return boost::make_unique<AssignConstantErrors>(std::move(errors));
   }
-  oops::Log::debug() << " AssignError output obserr: " << obserr << std::endl;
+
+  // If variable is specified
+  const Variable &errorvar = *parameters_.errorFunction.value();
+  ASSERT(errorvar.size() == 1 || errorvar.size() == vars.nvars());
+  ioda::ObsDataVector<float> errors(data.obsspace(), errorvar.toOopsVariables(),
+                                    errorvar.group(), false);
+  data.get(errorvar, errors);
+
+  // if assigned error function is 1D variable, apply the same error to all variables
+  // error_jv = {0, 0, 0, ..., 0} for all nvars
+  std::vector<size_t> error_jv(vars.nvars(), 0);
+  // if multiple variables are in the assigned error function, apply different error to different
+  // variables
+  // error_jv = {0, 1, 2, ..., nvars-1}
+  if (errorvar.size() == vars.nvars()) {
+    std::iota(error_jv.begin(), error_jv.end(), 0);
+  }
+
+  std::vector<std::vector<float>> errorValues(errors.nvars());
+  for (size_t jerr = 0; jerr < errors.nvars(); ++jerr)
+    errorValues[jerr] = std::move(errors[jerr]);
+  return boost::make_unique<AssignErrorsFromVariable>(std::move(errorValues),
+                                                      std::move(error_jv));
 }
 
 // -----------------------------------------------------------------------------
@@ -31,6 +31,23 @@ void FilterAction::apply(const Variables & vars, const std::vector<std::vector<b
 
 // -----------------------------------------------------------------------------
 
+void FilterAction::applyToMasks(const Variables & vars, const std::vector<BitMask> & mask,
+                                const ObsFilterData & data, int filterQCflag,
+                                ioda::ObsDataVector<int> & flags,
+                                ioda::ObsDataVector<float> & err) const {
+  action_->applyToMasks(vars, mask, data, filterQCflag, flags, err);
+}
+
+// -----------------------------------------------------------------------------
+
+std::unique_ptr<FilterActionKernel> FilterAction::makeKernel(
+    const Variables & vars, const ObsFilterData & data, int filterQCflag,
+    const ioda::ObsDataVector<float> & err) const {
+  return action_->makeKernel(vars, data, filterQCflag, err);
+}
+
+// -----------------------------------------------------------------------------
+
 const ufo::Variables & FilterAction::requiredVariables() const {
   return action_->requiredVariables();
 }
@@ -43,4 +60,10 @@ bool FilterAction::modifiesQCFlags() const {
 
 // -----------------------------------------------------------------------------
 
+bool FilterAction::modifiesOnlyPassedObs() const {
+  return action_->modifiesOnlyPassedObs();
+}
+
+// -----------------------------------------------------------------------------
+
 }  // namespace ufo
@@ -18,7 +18,9 @@ namespace ioda {
 }
 
 namespace ufo {
+  class BitMask;
   class FilterActionBase;
+  class FilterActionKernel;
   class FilterActionParametersBase;
   class ObsFilterData;
   class Variables;
@@ -47,6 +49,16 @@ class FilterAction : private boost::noncopyable {
   void apply(const ufo::Variables &vars, const std::vector<std::vector<bool>> &flagged,
              const ObsFilterData &data, int filterQCflag,
              ioda::ObsDataVector<int> &flags, ioda::ObsDataVector<float> &obserr) const;
+  /// \brief Perform the action on the observations flagged in the bit-packed masks \p flagged
+  /// (one per filter variable). See FilterActionBase::applyToMasks().
+  void applyToMasks(const ufo::Variables &vars, const std::vector<BitMask> &flagged,
+                    const ObsFilterData &data, int filterQCflag,
+                    ioda::ObsDataVector<int> &flags, ioda::ObsDataVector<float> &obserr) const;
+  /// \brief Return the per-observation kernel of the action or a null pointer if it has none.
+  /// See FilterActionBase::makeKernel().
+  std::unique_ptr<FilterActionKernel> makeKernel(const ufo::Variables &vars,
+                                                 const ObsFilterData &data, int filterQCflag,
+                                                 const ioda::ObsDataVector<float> &obserr) const;
   const ufo::Variables & requiredVariables() const;
 
   /// \brief Return true if this action modifies QC flags.
@@ -54,6 +66,10 @@ class FilterAction : private boost::noncopyable {
   /// When a filter executes multiple actions, only the last is allowed to modify QC flags.
   bool modifiesQCFlags() const;
 
+  /// \brief Return true if this action leaves observations that have not passed QC so far
+  /// unchanged.
+  bool modifiesOnlyPassedObs() const;
+
  private:
   std::unique_ptr<FilterActionBase> action_;
 };
@@ -10,13 +10,58 @@
 #include <map>
 #include <string>
 
+#include "ioda/ObsDataVector.h"
 #include "oops/util/abor1_cpp.h"
 #include "oops/util/Logger.h"
+#include "ufo/filters/Variables.h"
+#include "ufo/utils/BitMask.h"
 
 namespace ufo {
 
 // -----------------------------------------------------------------------------
 
+void FilterActionBase::applyToMasks(const Variables & vars, const std::vector<BitMask> & flagged,
+                                    const ObsFilterData & data, int filterQCflag,
+                                    ioda::ObsDataVector<int> & flags,
+                                    ioda::ObsDataVector<float> & obserr) const {
+  std::vector<std::vector<bool>> unpacked;
+  unpacked.reserve(flagged.size());
+  for (const BitMask & mask : flagged)
+    unpacked.push_back(mask.toVector());
+  apply(vars, unpacked, data, filterQCflag, flags, obserr);
+}
+
+// -----------------------------------------------------------------------------
+
+std::unique_ptr<FilterActionKernel> FilterActionBase::makeKernel(
+    const Variables &, const ObsFilterData &, int, const ioda::ObsDataVector<float> &) const {
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+void applyKernels(const std::vector<const FilterActionKernel *> & kernels,
+                  const Variables & vars, const std::vector<BitMask> & flagged,
+                  ioda::ObsDataVector<int> & flags, ioda::ObsDataVector<float> & obserr) {
+  if (kernels.empty())
+    return;
+  for (size_t ifiltervar = 0; ifiltervar < vars.nvars(); ++ifiltervar) {
+    if (!flagged[ifiltervar].any())
+      continue;
+    const std::string varname = vars.variable(ifiltervar).variable();
+    ioda::ObsDataRow<int> & varFlags = flags[flags.varnames().find(varname)];
+    ioda::ObsDataRow<float> & varErrors = obserr[obserr.varnames().find(varname)];
+    flagged[ifiltervar].forEachSetBit([&](size_t jobs) {
+        int & qcFlag = varFlags[jobs];
+        float & obsError = varErrors[jobs];
+        for (const FilterActionKernel * kernel : kernels)
+          kernel->apply(ifiltervar, jobs, qcFlag, obsError);
+      });
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 FilterActionFactory::FilterActionFactory(const std::string & name) {
   if (getMakers().find(name) != getMakers().end()) {
     oops::Log::error() << name << " already registered in ufo::FilterActionFactory." << std::endl;
@@ -25,7 +25,9 @@ template <typename T> class ObsDataVector;
 
 namespace ufo {
 
+class BitMask;
 class FilterActionFactory;
+class FilterActionKernel;
 class ObsFilterData;
 class Variables;
 
@@ -77,6 +79,28 @@ class FilterActionBase : private boost::noncopyable {
                      const ObsFilterData &data, int filterQCflag,
                      ioda::ObsDataVector<int> &flags, ioda::ObsDataVector<float> &obserr) const = 0;
 
+  /// \brief Perform the action on the observations flagged in the bit-packed masks \p flagged
+  /// (one per filter variable).
+  ///
+  /// The other parameters have the same meaning as in apply(). The default implementation
+  /// unpacks the masks and calls apply(). Actions that only touch flagged observations should
+  /// override it to visit the set bits of each mask, skipping 64 unflagged locations at a time.
+  virtual void applyToMasks(const ufo::Variables &vars, const std::vector<BitMask> &flagged,
+                            const ObsFilterData &data, int filterQCflag,
+                            ioda::ObsDataVector<int> &flags,
+                            ioda::ObsDataVector<float> &obserr) const;
+
+  /// \brief Return the per-observation kernel of the action, or a null pointer if the action
+  /// cannot be expressed as one (the default).
+  ///
+  /// A kernel changes only the QC flag and the obs error of the observation it is applied to,
+  /// which allows FilterBase to fuse the kernels of consecutive actions into a single pass over
+  /// the flagged observations. Any filter data needed by the kernel must be retrieved here. The
+  /// parameters have the same meaning as in apply().
+  virtual std::unique_ptr<FilterActionKernel> makeKernel(
+      const ufo::Variables &vars, const ObsFilterData &data, int filterQCflag,
+      const ioda::ObsDataVector<float> &obserr) const;
+
   /// \brief Return the list of variables required by the action.
   ///
   /// This list must in particular contain any required variables that become available to
@@ -88,8 +112,34 @@ class FilterActionBase : private boost::noncopyable {
   ///
   /// When a filter executes multiple actions, only the last is allowed to modify QC flags.
   virtual bool modifiesQCFlags() const = 0;
+
+  /// \brief Return true if this action leaves observations that have not passed QC so far
+  /// unchanged.
+  ///
+  /// A filter all of whose actions have this property is skipped when none of the observations
+  /// it could select have passed QC.
+  virtual bool modifiesOnlyPassedObs() const { return false; }
+};
+
+// -----------------------------------------------------------------------------
+/// Part of a filter action applied separately to each flagged observation.
+class FilterActionKernel : private boost::noncopyable {
+ public:
+  virtual ~FilterActionKernel() {}
+
+  /// \brief Apply the action to the \p jobs th observation of the \p ifiltervar th filter
+  /// variable, whose QC flag is \p qcFlag and obs error is \p obsError.
+  virtual void apply(size_t ifiltervar, size_t jobs, int &qcFlag, float &obsError) const = 0;
 };
 
+/// \brief Apply the \p kernels, in turn, to each observation flagged in the bit-packed masks
+/// \p flagged (one per filter variable from \p vars), visiting each observation once.
+///
+/// Filter variables without any flagged observations are skipped.
+void applyKernels(const std::vector<const FilterActionKernel *> &kernels,
+                  const ufo::Variables &vars, const std::vector<BitMask> &flagged,
+                  ioda::ObsDataVector<int> &flags, ioda::ObsDataVector<float> &obserr);
+
 // -----------------------------------------------------------------------------
 
 /// Filter action factory.
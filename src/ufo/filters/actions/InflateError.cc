@@ -8,17 +8,61 @@
 #include "ufo/filters/actions/InflateError.h"
 
 #include <algorithm>
+#include <memory>
+#include <numeric>
+#include <utility>
 
 #include "ioda/ObsDataVector.h"
 #include "oops/base/Variables.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/QCflags.h"
 #include "ufo/filters/Variables.h"
+#include "ufo/utils/BitMask.h"
 
 namespace ufo {
 
 // -----------------------------------------------------------------------------
 
+namespace {
+
+/// Multiplies the errors of observations that passed QC so far by a constant factor.
+class InflateErrorByFactor : public FilterActionKernel {
+ public:
+  explicit InflateErrorByFactor(float factor) : factor_(factor) {}
+
+  void apply(size_t, size_t, int &qcFlag, float &obsError) const override {
+    if (qcFlag == QCflags::pass)
+      obsError *= factor_;
+  }
+
+ private:
+  float factor_;
+};
+
+/// Multiplies the errors of observations that passed QC so far by factors varying with the
+/// filter variable and location.
+class InflateErrorByVariable : public FilterActionKernel {
+ public:
+  /// \param factors Inflation factors, one vector per inflation variable.
+  /// \param factorIndices Index of the inflation variable used for each filter variable.
+  InflateErrorByVariable(std::vector<std::vector<float>> &&factors,
+                         std::vector<size_t> &&factorIndices)
+    : factors_(std::move(factors)), factorIndices_(std::move(factorIndices)) {}
+
+  void apply(size_t ifiltervar, size_t jobs, int &qcFlag, float &obsError) const override {
+    if (qcFlag == QCflags::pass)
+      obsError *= factors_[factorIndices_[ifiltervar]][jobs];
+  }
+
+ private:
+  std::vector<std::vector<float>> factors_;
+  std::vector<size_t> factorIndices_;
+};
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
 static FilterActionMaker<InflateError> makerInflateErr_("inflate error");
 
 // -----------------------------------------------------------------------------
@@ -58,51 +102,57 @@ InflateError::InflateError(const Parameters_ & parameters)
 void InflateError::apply(const Variables & vars,
                          const std::vector<std::vector<bool>> & flagged,
                          const ObsFilterData & data,
-                         int /*filterQCflag*/,
+                         int filterQCflag,
                          ioda::ObsDataVector<int> & flags,
                          ioda::ObsDataVector<float> & obserr) const {
+  applyToMasks(vars, toBitMasks(flagged), data, filterQCflag, flags, obserr);
+}
+
+// -----------------------------------------------------------------------------
+
+void InflateError::applyToMasks(const Variables & vars,
+                                const std::vector<BitMask> & flagged,
+                                const ObsFilterData & data,
+                                int filterQCflag,
+                                ioda::ObsDataVector<int> & flags,
+                                ioda::ObsDataVector<float> & obserr) const {
   oops::Log::debug() << " InflateError input obserr: " << obserr << std::endl;
+  const std::unique_ptr<FilterActionKernel> kernel = makeKernel(vars, data, filterQCflag, obserr);
+  applyKernels({kernel.get()}, vars, flagged, flags, obserr);
+  oops::Log::debug() << " InflateError output obserr: " << obserr << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+std::unique_ptr<FilterActionKernel> InflateError::makeKernel(
+    const Variables & vars, const ObsFilterData & data, int,
+    const ioda::ObsDataVector<float> &) const {
   // If float factor is specified
-  if (parameters_.inflationFactor.value() != boost::none) {
-    float factor = *parameters_.inflationFactor.value();
-    for (size_t ifiltervar = 0; ifiltervar < vars.nvars(); ++ifiltervar) {
-      size_t iallvar = obserr.varnames().find(vars.variable(ifiltervar).variable());
-      for (size_t jobs = 0; jobs < obserr.nlocs(); ++jobs) {
-        if (flagged[ifiltervar][jobs] && flags[iallvar][jobs] == QCflags::pass) {
-          obserr[iallvar][jobs] *= factor;
-        }
-      }
-    }
+  if (parameters_.inflationFactor.value() != boost::none)
+    return boost::make_unique<InflateErrorByFactor>(*parameters_.inflationFactor.value());
+
   // If variable is specified
-  } else if (parameters_.inflationVariable.value() != boost::none) {
-    const Variable &factorvar = *parameters_.inflationVariable.value();
-    ASSERT(factorvar.size() == 1 || factorvar.size() == vars.nvars());
-    ioda::ObsDataVector<float> factors(data.obsspace(), factorvar.toOopsVariables());
-    data.get(factorvar, factors);
-
-    // if inflation factor is 1D variable, apply the same inflation factor to all variables
-    // factor_indices = {0, 0, 0, ..., 0} for all nvars
-    std::vector<size_t> factor_indices(vars.nvars(), 0);
-
-    // if multiple variables are in the inflation factor, apply different factors to different
-    // variables
-    // factor_indices = {0, 1, 2, ..., nvars-1}
-    if (factorvar.size() == vars.nvars()) {
-      std::iota(factor_indices.begin(), factor_indices.end(), 0);
-    }
-
-    // loop over all variables to update
-    for (size_t ifiltervar = 0; ifiltervar < vars.nvars(); ++ifiltervar) {
-      // find current variable index in obserr
-      size_t iallvar = obserr.varnames().find(vars.variable(ifiltervar).variable());
-      for (size_t jobs = 0; jobs < obserr.nlocs(); ++jobs) {
-        if (flagged[ifiltervar][jobs] && flags[iallvar][jobs] == QCflags::pass) {
-          obserr[iallvar][jobs] *= factors[factor_indices[ifiltervar]][jobs];
-        }
-      }
-    }
+  const Variable &factorvar = *parameters_.inflationVariable.value();
+  ASSERT(factorvar.size() == 1 || factorvar.size() == vars.nvars());
+  ioda::ObsDataVector<float> factors(data.obsspace(), factorvar.toOopsVariables());
+  data.get(factorvar, factors);
+
+  // if inflation factor is 1D variable, apply the same inflation factor to all variables
+  // factor_indices = {0, 0, 0, ..., 0} for all nvars
+  std::vector<size_t> factor_indices(vars.nvars(), 0);
+
+  // if multiple variables are in the inflation factor, apply different factors to different
+  // variables
+  // factor_indices = {0, 1, 2, ..., nvars-1}
+  if (factorvar.size() == vars.nvars()) {
+    std::iota(factor_indices.begin(), factor_indices.end(), 0);
   }
-  oops::Log::debug() << " InflateError output obserr: " << obserr << std::endl;
+
+  std::vector<std::vector<float>> factorValues(factors.nvars());
+  for (size_t ifactorvar = 0; ifactorvar < factors.nvars(); ++ifactorvar)
+    factorValues[ifactorvar] = std::move(factors[ifactorvar]);
+  return boost::make_unique<InflateErrorByVariable>(std::move(factorValues),
+                                                    std::move(factor_indices));
 }
 
 // -----------------------------------------------------------------------------
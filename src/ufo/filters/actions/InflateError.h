@@ -8,6 +8,7 @@
 #ifndef UFO_FILTERS_ACTIONS_INFLATEERROR_H_
 #define UFO_FILTERS_ACTIONS_INFLATEERROR_H_
 
+#include <memory>
 #include <vector>
 
 #include "oops/util/parameters/OptionalParameter.h"
@@ -59,10 +60,17 @@ class InflateError : public FilterActionBase {
   void apply(const Variables &, const std::vector<std::vector<bool>> &,
              const ObsFilterData &, int,
              ioda::ObsDataVector<int> &, ioda::ObsDataVector<float> &) const override;
+  void applyToMasks(const Variables &, const std::vector<BitMask> &,
+                    const ObsFilterData &, int,
+                    ioda::ObsDataVector<int> &, ioda::ObsDataVector<float> &) const override;
+  std::unique_ptr<FilterActionKernel> makeKernel(
+      const Variables &, const ObsFilterData &, int,
+      const ioda::ObsDataVector<float> &) const override;
 
   const ufo::Variables & requiredVariables() const override {return allvars_;}
 
   bool modifiesQCFlags() const override { return false; }
+  bool modifiesOnlyPassedObs() const override { return true; }
 
  private:
   Variables allvars_;            /// variables required to compute inflation
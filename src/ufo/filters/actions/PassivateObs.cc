@@ -7,14 +7,32 @@
 
 #include "ufo/filters/actions/PassivateObs.h"
 
+#include <memory>
+
 #include "ioda/ObsDataVector.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/QCflags.h"
+#include "ufo/utils/BitMask.h"
 
 namespace ufo {
 
 // -----------------------------------------------------------------------------
 
+namespace {
+
+/// Makes observations that passed QC so far passive.
+class PassivateFlagged : public FilterActionKernel {
+ public:
+  void apply(size_t, size_t, int &qcFlag, float &) const override {
+    if (qcFlag == QCflags::pass)
+      qcFlag = QCflags::passive;
+  }
+};
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
 static FilterActionMaker<PassivateObs> makerPassivateObs_("passivate");
 
 // -----------------------------------------------------------------------------
@@ -27,17 +45,31 @@ static FilterActionMaker<PassivateObs> makerPassivateObs_("passivate");
 
 void PassivateObs::apply(const Variables & vars,
                       const std::vector<std::vector<bool>> & flagged,
-                      const ObsFilterData &,
-                      int,
+                      const ObsFilterData & data,
+                      int filterQCflag,
                       ioda::ObsDataVector<int> & flags,
-                      ioda::ObsDataVector<float> &) const {
-  for (size_t ifiltervar = 0; ifiltervar < vars.nvars(); ++ifiltervar) {
-    size_t iallvar = flags.varnames().find(vars.variable(ifiltervar).variable());
-    for (size_t jobs = 0; jobs < flags.nlocs(); ++jobs) {
-      if (flagged[ifiltervar][jobs] && flags[iallvar][jobs] == QCflags::pass)
-        flags[iallvar][jobs] = QCflags::passive;
-    }
-  }
+                      ioda::ObsDataVector<float> & obserr) const {
+  applyToMasks(vars, toBitMasks(flagged), data, filterQCflag, flags, obserr);
+}
+
+// -----------------------------------------------------------------------------
+
+void PassivateObs::applyToMasks(const Variables & vars,
+                                const std::vector<BitMask> & flagged,
+                                const ObsFilterData & data,
+                                int filterQCflag,
+                                ioda::ObsDataVector<int> & flags,
+                                ioda::ObsDataVector<float> & obserr) const {
+  const std::unique_ptr<FilterActionKernel> kernel = makeKernel(vars, data, filterQCflag, obserr);
+  applyKernels({kernel.get()}, vars, flagged, flags, obserr);
+}
+
+// -----------------------------------------------------------------------------
+
+std::unique_ptr<FilterActionKernel> PassivateObs::makeKernel(
+    const Variables &, const ObsFilterData &, int,
+    const ioda::ObsDataVector<float> &) const {
+  return boost::make_unique<PassivateFlagged>();
 }
 
 // -----------------------------------------------------------------------------
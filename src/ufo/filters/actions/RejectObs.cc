@@ -7,14 +7,37 @@
 
 #include "ufo/filters/actions/RejectObs.h"
 
+#include <memory>
+
 #include "ioda/ObsDataVector.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/QCflags.h"
+#include "ufo/utils/BitMask.h"
 
 namespace ufo {
 
 // -----------------------------------------------------------------------------
 
+namespace {
+
+/// Rejects observations that passed QC so far.
+class RejectFlagged : public FilterActionKernel {
+ public:
+  explicit RejectFlagged(int filterQCflag) : filterQCflag_(filterQCflag) {}
+
+  void apply(size_t, size_t, int &qcFlag, float &) const override {
+    if (qcFlag == QCflags::pass)
+      qcFlag = filterQCflag_;
+  }
+
+ private:
+  int filterQCflag_;
+};
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
 static FilterActionMaker<RejectObs> makerRejectObs_("reject");
 
 // -----------------------------------------------------------------------------
@@ -27,17 +50,31 @@ RejectObs::RejectObs(const RejectObsParameters &parameters)
 
 void RejectObs::apply(const Variables & vars,
                       const std::vector<std::vector<bool>> & flagged,
-                      const ObsFilterData &,
+                      const ObsFilterData & data,
                       int filterQCflag,
                       ioda::ObsDataVector<int> & flags,
-                      ioda::ObsDataVector<float> &) const {
-  for (size_t jv = 0; jv < vars.nvars(); ++jv) {
-    size_t iv = flags.varnames().find(vars.variable(jv).variable());
-    for (size_t jobs = 0; jobs < flags.nlocs(); ++jobs) {
-      if (flagged[jv][jobs] && flags[iv][jobs] == QCflags::pass)
-        flags[iv][jobs] = filterQCflag;
-    }
-  }
+                      ioda::ObsDataVector<float> & obserr) const {
+  applyToMasks(vars, toBitMasks(flagged), data, filterQCflag, flags, obserr);
+}
+
+// -----------------------------------------------------------------------------
+
+void RejectObs::applyToMasks(const Variables & vars,
+                             const std::vector<BitMask> & flagged,
+                             const ObsFilterData & data,
+                             int filterQCflag,
+                             ioda::ObsDataVector<int> & flags,
+                             ioda::ObsDataVector<float> & obserr) const {
+  const std::unique_ptr<FilterActionKernel> kernel = makeKernel(vars, data, filterQCflag, obserr);
+  applyKernels({kernel.get()}, vars, flagged, flags, obserr);
+}
+
+// -----------------------------------------------------------------------------
+
+std::unique_ptr<FilterActionKernel> RejectObs::makeKernel(
+    const Variables &, const ObsFilterData &, int filterQCflag,
+    const ioda::ObsDataVector<float> &) const {
+  return boost::make_unique<RejectFlagged>(filterQCflag);
 }
 
 // -----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #ifndef UFO_FILTERS_ACTIONS_REJECTOBS_H_
 #define UFO_FILTERS_ACTIONS_REJECTOBS_H_
 
+#include <memory>
 #include <vector>
 
 #include "ufo/filters/actions/FilterActionBase.h"
@@ -40,8 +41,15 @@ class RejectObs : public FilterActionBase {
   void apply(const Variables &, const std::vector<std::vector<bool>> &,
              const ObsFilterData &, int,
              ioda::ObsDataVector<int> &, ioda::ObsDataVector<float> &) const override;
+  void applyToMasks(const Variables &, const std::vector<BitMask> &,
+                    const ObsFilterData &, int,
+                    ioda::ObsDataVector<int> &, ioda::ObsDataVector<float> &) const override;
+  std::unique_ptr<FilterActionKernel> makeKernel(
+      const Variables &, const ObsFilterData &, int,
+      const ioda::ObsDataVector<float> &) const override;
   const ufo::Variables & requiredVariables() const override {return allvars_;}
   bool modifiesQCFlags() const override { return true; }
+  bool modifiesOnlyPassedObs() const override { return true; }
 
  private:
   Variables allvars_;
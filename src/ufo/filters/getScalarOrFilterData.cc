@@ -16,34 +16,63 @@
 
 namespace ufo {
 
+namespace {
+
+// -----------------------------------------------------------------------------
+/// Return true and set \p factor if \p strfactor contains a single float. Otherwise
+/// return false.
+bool readScalar(const std::string & strfactor, float & factor) {
+  std::istringstream iss(strfactor);
+  iss >> factor;
+  return iss.eof() && !iss.fail();
+}
+
+// -----------------------------------------------------------------------------
+/// Return the variable named \p strfactor, aborting if it is not available in \p data.
+Variable getFilterDataVariable(const std::string & strfactor, const ObsFilterData & data) {
+  Variable var(strfactor);
+  oops::Log::debug() << "processing data: " << var << std::endl;
+  if (!data.has(var)) {
+    oops::Log::error() << "getScalarOrFilterData: either a value or a valid variable from "
+                       << "data available to filter should be specified instead of "
+                       << strfactor << std::endl;
+    ABORT("getScalarOrFilterData: either a value or a valid variable should be specified");
+  }
+  return var;
+}
+
+}  // namespace
+
 // -----------------------------------------------------------------------------
 
 std::vector<float> getScalarOrFilterData(const std::string & strfactor,
                                          const ObsFilterData & data) {
-  std::istringstream iss(strfactor);
   std::vector<float> factors(data.nlocs());
   float factor;
-  iss >> factor;
 // Check float was read:
-  if (iss.eof() && !iss.fail()) {
+  if (readScalar(strfactor, factor)) {
 //  single float in the config:
     oops::Log::debug() << "processing a float: " << factor << std::endl;
     std::fill(factors.begin(), factors.end(), factor);
   } else {
 //  it's a string; get from ObsFilterData
-    Variable var(strfactor);
-    oops::Log::debug() << "processing data: " << var << std::endl;
-    if (!data.has(var)) {
-      oops::Log::error() << "getScalarOrFilterData: either a value or a valid variable from "
-                         << "data available to filter should be specified instead of "
-                         << strfactor << std::endl;
-      ABORT("getScalarOrFilterData: either a value or a valid variable should be specified");
-    }
-    data.get(var, factors);
+    data.get(getFilterDataVariable(strfactor, data), factors);
   }
   return factors;
 }
 
 // -----------------------------------------------------------------------------
 
+ScalarOrFilterData getScalarOrFilterDataView(const std::string & strfactor,
+                                             const ObsFilterData & data) {
+  float factor;
+  if (readScalar(strfactor, factor)) {
+    oops::Log::debug() << "processing a float: " << factor << std::endl;
+    return ScalarOrFilterData(factor);
+  }
+  return ScalarOrFilterData(data.getView<float>(getFilterDataVariable(strfactor, data)));
+}
+
+// -----------------------------------------------------------------------------
+
 }  // namespace ufo
@@ -10,11 +10,34 @@
 
 
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "ufo/filters/ObsFilterData.h"
+
 namespace ufo {
 
-class ObsFilterData;
+/// Values of a quantity that is either the same at all locations or taken from a variable
+/// from ObsFilterData (see getScalarOrFilterDataView()). A scalar is stored as a single float
+/// rather than broadcast to all locations.
+class ScalarOrFilterData {
+ public:
+  explicit ScalarOrFilterData(float scalar) : scalar_(scalar) {}
+  explicit ScalarOrFilterData(ObsFilterDataView<float> values)
+    : values_(std::move(values)), isScalar_(false) {}
+
+  bool isScalar() const {return isScalar_;}
+  /// Value of the scalar (only meaningful if isScalar() is true).
+  float scalar() const {return scalar_;}
+  /// Value at location \p jloc.
+  float operator[](size_t jloc) const {return isScalar_ ? scalar_ : values_[jloc];}
+
+ private:
+  float scalar_ = 0.0f;
+  ObsFilterDataView<float> values_;
+  bool isScalar_ = true;
+};
+
 /// Function to fill in a vector with either a scalar or data from ObsFilterData
 //  - if input string contains a float, output vector would be filled in with that number
 //    for nlocs size (e.g. if string is "4.0", output vector would contain nlocs x 4.0)
@@ -24,6 +47,12 @@ class ObsFilterData;
 //  To be used in error inflation, thresholds for BackgroundCheck, etc
 std::vector<float> getScalarOrFilterData(const std::string &, const ObsFilterData &);
 
+/// Same as getScalarOrFilterData(), but a scalar is not broadcast to all locations and data from
+/// ObsFilterData are retrieved with ObsFilterData::getView() (so they are not copied if their
+/// source holds them as floats, and ObsFunction values are reused from the ObsFunction cache if
+/// the filter uses one).
+ScalarOrFilterData getScalarOrFilterDataView(const std::string &, const ObsFilterData &);
+
 }  // namespace ufo
 
 #endif  // UFO_FILTERS_GETSCALARORFILTERDATA_H_
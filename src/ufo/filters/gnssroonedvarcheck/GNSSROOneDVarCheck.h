@@ -67,6 +67,7 @@ class GNSSROOneDVarCheck : public FilterBase,
                    const Variables &,
                    std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override {return QCflags::onedvar;}
+  bool modifiesObsSpace() const override {return true;}
 
   F90onedvarcheck key_;
   GNSSROOneDVarCheckParameters parameters_;
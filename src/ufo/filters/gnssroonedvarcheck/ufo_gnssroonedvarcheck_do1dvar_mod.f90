@@ -50,8 +50,7 @@ use ufo_gnssroonedvarcheck_utils_mod, only: &
 use ufo_gnssroonedvarcheck_rootsolv_mod, only: &
     Ops_GPSRO_rootsolv_BA
 
-use ufo_utils_refractivity_calculator, only: &
-    ufo_calculate_refractivity
+use ufo_utils_refractivity_cache, only: ufo_calculate_refractivity_cached
 
 IMPLICIT NONE
 
@@ -126,19 +125,19 @@ Ob % BendingAngle(:) % PGEFinal = 1.0
 ! Calculate refractivity on theta levels, to find appropriate
 ! impact height vertical range
 
-CALL ufo_calculate_refractivity (nlevp,                  &
-                                 nlevq,                  &
-                                 Back % za,              &
-                                 Back % zb,              &
-                                 Back % p,               &
-                                 Back % q,               &
-                                 GPSRO_pseudo_ops,       &
-                                 GPSRO_vert_interp_ops,  &
-                                 GPSRO_min_temp_grad,    &
-                                 BAerr,                  &
-                                 nRefLevels,             &
-                                 refractivity,           &
-                                 model_heights)
+CALL ufo_calculate_refractivity_cached (nlevp,                  &
+                                        nlevq,                  &
+                                        Back % za,              &
+                                        Back % zb,              &
+                                        Back % p,               &
+                                        Back % q,               &
+                                        GPSRO_pseudo_ops,       &
+                                        GPSRO_vert_interp_ops,  &
+                                        GPSRO_min_temp_grad,    &
+                                        BAerr,                  &
+                                        nRefLevels,             &
+                                        refractivity,           &
+                                        model_heights)
 
 ! Set the background vector
 xb(1:nlevp) = 1.0E-2 * Back % p(:)          ! in hPa
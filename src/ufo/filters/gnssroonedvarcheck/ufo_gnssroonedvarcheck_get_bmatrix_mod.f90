@@ -22,27 +22,28 @@ type Bmatrix_type
   INTEGER       :: nstate
   INTEGER       :: nband
   INTEGER       :: nseason
-  REAL(kind_real), POINTER :: band_up_lim(:)      ! band_up_lim(nband)
-  REAL(kind_real), POINTER :: sigma(:,:,:)        ! sigma(nseason,nband,nstate)
-  REAL(kind_real), POINTER :: inverse(:,:,:,:)    ! inverse(nseason,nband,nstate,nstate)
+  REAL(kind_real), POINTER :: band_up_lim(:) => null()    ! band_up_lim(nband)
+  ! The matrices for each band and season are stored contiguously, so they can be passed to
+  ! the 1D-Var without being copied
+  REAL(kind_real), POINTER :: sigma(:,:,:) => null()      ! sigma(nstate,nband,nseason)
+  REAL(kind_real), POINTER :: inverse(:,:,:,:) => null()  ! inverse(nstate,nstate,nband,nseason)
   CONTAINS
     procedure :: get => Ops_GPSRO_GetBmatrix
+    procedure :: check => Ops_GPSRO_CheckBmatrix
+    procedure :: band => Ops_GPSRO_BmatrixBand
+    procedure :: delete => Ops_GPSRO_DeleteBmatrix
 end type
 
 contains
 
 SUBROUTINE Ops_GPSRO_GetBmatrix (Bmatrix, &
-                                 filename, &
-                                 cx_nlevp, &
-                                 cx_nlevq)
+                                 filename)
 
 IMPLICIT NONE
 
 ! Subroutine arguments:
 CLASS(Bmatrix_type), INTENT(OUT) :: Bmatrix    !< The background errors read in
 CHARACTER(LEN=*)                 :: filename   !< The name of the file to be read in
-INTEGER, INTENT(IN)              :: cx_nlevp   !< The number of pressure levels in the model
-INTEGER, INTENT(IN)              :: cx_nlevq   !< The number of temperature levels in the model
 
 ! Local declarations:
 CHARACTER(len=*), PARAMETER      :: RoutineName = "Ops_GPSRO_GetBmatrix"
@@ -81,24 +82,6 @@ end if
 
 READ (fileunit, '(5I5)') nlevp, nlevq, nstate, nband, nseason
 
-IF (cx_nlevp /= nlevp) THEN
-
-  WRITE (ErrorMessage, '(A,I0,A,I0)')'nlevp = ', nlevp, ' cx_nlevp = ', cx_nlevp
-  call fckit_log % error(ErrorMessage)
-  ErrorMessage = 'no. of pressure levels in vector and bmatrix not the same'
-  call abor1_ftn(ErrorMessage)
-
-END IF
-
-IF (cx_nlevq /= nlevq) THEN
-
-  WRITE (ErrorMessage, '(A,I0,A,I0)') 'nlevq = ', nlevq, ' cx_nlevq = ', cx_nlevq
-  call fckit_log % error(ErrorMessage)
-  ErrorMessage = 'no. of humidity levels in vector and bmatrix not the same'
-  call abor1_ftn(ErrorMessage)
-
-END IF
-
 ! Allocate storage variables
 
 Bmatrix % nlevp = nlevp
@@ -110,8 +93,8 @@ Bmatrix % nseason = nseason
 ! Allocate the arrays in Bmatrix type
 
 ALLOCATE (Bmatrix % band_up_lim(nband))
-ALLOCATE (Bmatrix % sigma(nseason,nband,nstate))
-ALLOCATE (Bmatrix % inverse(nseason,nband,nstate,nstate))
+ALLOCATE (Bmatrix % sigma(nstate,nband,nseason))
+ALLOCATE (Bmatrix % inverse(nstate,nstate,nband,nseason))
 
 ! Read the band upper limit
 
@@ -125,14 +108,14 @@ DO n = 1,nseason
 
     ! Read in the sigma values
 
-    READ (fileunit, '(10E15.6)') (Bmatrix % sigma (n,m,i), i = 1, nstate)
+    READ (fileunit, '(10E15.6)') (Bmatrix % sigma (i,m,n), i = 1, nstate)
 
     ! Read in the inverse B matrix
 
     DO i = 1,nstate
 
       READ (fileunit, *)  ! space
-      READ (fileunit, '(10E15.6)') (Bmatrix % inverse (n,m,i,j), j = 1, nstate)
+      READ (fileunit, '(10E15.6)') (Bmatrix % inverse (i,j,m,n), j = 1, nstate)
 
     END DO ! each B matrix
 
@@ -146,4 +129,79 @@ CLOSE(fileunit)
 
 END SUBROUTINE Ops_GPSRO_GetBmatrix
 
+!-------------------------------------------------------------------------------
+! Check the B-matrix matches the number of levels in the model
+!-------------------------------------------------------------------------------
+SUBROUTINE Ops_GPSRO_CheckBmatrix (Bmatrix,  &
+                                   cx_nlevp, &
+                                   cx_nlevq)
+
+IMPLICIT NONE
+
+! Subroutine arguments:
+CLASS(Bmatrix_type), INTENT(IN)  :: Bmatrix    !< The background errors
+INTEGER, INTENT(IN)              :: cx_nlevp   !< The number of pressure levels in the model
+INTEGER, INTENT(IN)              :: cx_nlevq   !< The number of temperature levels in the model
+
+! Local declarations:
+CHARACTER(len=256)               :: ErrorMessage
+
+IF (cx_nlevp /= Bmatrix % nlevp) THEN
+
+  WRITE (ErrorMessage, '(A,I0,A,I0)')'nlevp = ', Bmatrix % nlevp, ' cx_nlevp = ', cx_nlevp
+  call fckit_log % error(ErrorMessage)
+  ErrorMessage = 'no. of pressure levels in vector and bmatrix not the same'
+  call abor1_ftn(ErrorMessage)
+
+END IF
+
+IF (cx_nlevq /= Bmatrix % nlevq) THEN
+
+  WRITE (ErrorMessage, '(A,I0,A,I0)') 'nlevq = ', Bmatrix % nlevq, ' cx_nlevq = ', cx_nlevq
+  call fckit_log % error(ErrorMessage)
+  ErrorMessage = 'no. of humidity levels in vector and bmatrix not the same'
+  call abor1_ftn(ErrorMessage)
+
+END IF
+
+END SUBROUTINE Ops_GPSRO_CheckBmatrix
+
+!-------------------------------------------------------------------------------
+! Choose the latitude band of the B-matrix to use for an observation
+!-------------------------------------------------------------------------------
+FUNCTION Ops_GPSRO_BmatrixBand (Bmatrix, &
+                                latitude) RESULT(iband)
+
+IMPLICIT NONE
+
+! Function arguments:
+CLASS(Bmatrix_type), INTENT(IN)  :: Bmatrix    !< The background errors
+REAL(kind_real), INTENT(IN)      :: latitude   !< Latitude of the observation
+INTEGER                          :: iband      !< Selected latitude band
+
+iband = 1
+DO
+  IF (Bmatrix % band_up_lim(iband) > latitude .OR. &
+      iband == Bmatrix % nband) EXIT
+  iband = iband + 1
+END DO
+
+END FUNCTION Ops_GPSRO_BmatrixBand
+
+!-------------------------------------------------------------------------------
+! Free the memory used by the B-matrix
+!-------------------------------------------------------------------------------
+SUBROUTINE Ops_GPSRO_DeleteBmatrix (Bmatrix)
+
+IMPLICIT NONE
+
+! Subroutine arguments:
+CLASS(Bmatrix_type), INTENT(INOUT) :: Bmatrix    !< The background errors
+
+IF (ASSOCIATED(Bmatrix % band_up_lim)) DEALLOCATE (Bmatrix % band_up_lim)
+IF (ASSOCIATED(Bmatrix % sigma)) DEALLOCATE (Bmatrix % sigma)
+IF (ASSOCIATED(Bmatrix % inverse)) DEALLOCATE (Bmatrix % inverse)
+
+END SUBROUTINE Ops_GPSRO_DeleteBmatrix
+
 end module ufo_gnssroonedvarcheck_get_bmatrix_mod
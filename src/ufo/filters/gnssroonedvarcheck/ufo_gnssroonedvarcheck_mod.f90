@@ -47,6 +47,7 @@ type, public :: ufo_gnssroonedvarcheck
   logical                   :: pseudo_ops        !< Whether to use pseudo levels in forward operator
   logical                   :: vert_interp_ops   !< Whether to use ln(p) or exner in vertical interpolation
   real(kind_real)           :: min_temp_grad     !< The minimum vertical temperature gradient allowed
+  type(bmatrix_type)        :: b_matrix          !< Background-error covariance matrix, read on first use
 end type ufo_gnssroonedvarcheck
 
 ! ------------------------------------------------------------------------------
@@ -138,6 +139,8 @@ subroutine ufo_gnssroonedvarcheck_delete(self)
   implicit none
   type(ufo_gnssroonedvarcheck), intent(inout) :: self !< gnssroonedvarcheck main object
 
+  call self % b_matrix % delete()
+
 end subroutine ufo_gnssroonedvarcheck_delete
 
 ! ------------------------------------------------------------------------------
@@ -161,18 +164,12 @@ subroutine ufo_gnssroonedvarcheck_apply(self, geovals, apply)
   type(ufo_geovals), intent(in)              :: geovals  !< model values at observation space
   logical, intent(in)                        :: apply(:) !< qc manager flags
 
-  ! Local parameters
-  logical, parameter :: verboseOutput = .FALSE.          ! Whether to output extra debugging information
-
   ! Local variables
   integer :: nobs                                        ! Number of observations to be processed
   type(ufo_geoval), pointer          :: q                ! Model background values of specific humidity
   type(ufo_geoval), pointer          :: prs              ! Model background values of air pressure
   type(ufo_geoval), pointer          :: theta_heights    ! Model heights of levels containing specific humidity
   type(ufo_geoval), pointer          :: rho_heights      ! Model heights of levels containing air pressure
-  type(singlebg_type)                :: Back             ! Model background fields
-  type(singleob_type)                :: Ob               ! The profile of observations
-  type(bmatrix_type)                 :: b_matrix         ! Background-error covariance matrix
   real(kind_real), allocatable       :: obsLat(:)             ! Latitude of the observation
   real(kind_real), allocatable       :: obsLon(:)             ! Longitude of the observation
   real(kind_real), allocatable       :: impact_param(:)       ! Impact parameter of the observation
@@ -187,19 +184,9 @@ subroutine ufo_gnssroonedvarcheck_apply(self, geovals, apply)
   real(kind_real), allocatable       :: sort_key(:)           ! Key for the sorting (based on record number and impact parameter)
   integer, allocatable               :: index_vals(:)         ! Indices of sorted observation
   integer, allocatable               :: unique(:)             ! Set of unique profile numbers
-  integer                            :: start_point           ! Starting index of the current profile
+  integer, allocatable               :: profile_start(:)      ! Starting index of each profile (and one past the last)
   integer                            :: current_point         ! Ending index of the current profile
   integer                            :: iprofile              ! Loop variable, profile number
-  integer                            :: nobs_profile          ! Number of observations in the profile
-  character(len=800)                 :: Message               ! Message to be output
-  logical                            :: BAerr                 ! Has there been an error in the bending angle calculation?
-  integer                            :: iband                 ! Selected latitude band of the B-matrix
-  integer                            :: iseason               ! Selected season of the B-matrix
-  integer                            :: ipoint                ! Loop variable, observation point
-  real(kind_real)                    :: dfs                   ! Degrees of freedom for signal in profile
-  real(kind_real)                    :: O_Bdiff               ! Average RMS(O-B) for profile
-  real(kind_real), allocatable       :: Tb(:)                 ! Calculated background temperature (derived from p,q)
-  real(kind_real), allocatable       :: Ts(:)                 ! 1DVar solution temperature
 
   ! Get the obs-space information
   nobs = obsspace_get_nlocs(self % obsdb)
@@ -233,10 +220,12 @@ subroutine ufo_gnssroonedvarcheck_apply(self, geovals, apply)
   call ufo_geovals_get_var(geovals, var_z, theta_heights)   ! Geopotential height of the normal model levels
   call ufo_geovals_get_var(geovals, var_zi, rho_heights)    ! Geopotential height of the pressure levels
 
-  ! Read in the B-matrix and background profiles
-  call b_matrix % get(self % bmatrix_filename, prs % nval, q % nval)
-  call allocate_singlebg(Back, prs % nval, q % nval)
-  allocate(Tb(q % nval), Ts(q % nval))
+  ! Read in the B-matrix the first time the filter is applied (so that filters that are
+  ! constructed but never run do not read it) and keep it for later calls
+  if (.not. associated(self % b_matrix % sigma)) call self % b_matrix % get(self % bmatrix_filename)
+
+  ! Check the B-matrix matches the background profiles
+  call self % b_matrix % check(prs % nval, q % nval)
 
   ! Read through the record numbers in order to find a profile of observations
   ! Each profile shares the same record number
@@ -245,115 +234,192 @@ subroutine ufo_gnssroonedvarcheck_apply(self, geovals, apply)
   call Ops_RealSortQuick(sort_key, index_vals)
   call find_unique(record_number, unique)
 
-  ! For every profile that we have found, perform a 1DVar minimisation
+  ! Work out which observations belong to each profile
+  allocate(profile_start(size(unique) + 1))
   current_point = 1
   do iprofile = 1, size(unique)
-    start_point = current_point
-    WRITE (Message, '(A,I0)') 'ObNumber ', iprofile
-    call fckit_log % info(Message)
-    WRITE (Message, '(A,F12.2)') 'Latitude ', obsLat(index_vals(start_point))
-    call fckit_log % info(Message)
-    WRITE (Message, '(A,F12.2)') 'Longitude ', obsLon(index_vals(start_point))
-    call fckit_log % info(Message)
-    WRITE (Message, '(A,I0)') 'Processing centre ', obsOrigC(index_vals(start_point))
-    call fckit_log % info(Message)
-    WRITE (Message, '(A,I0)') 'Sat ID ', obsSatid(index_vals(start_point))
-    call fckit_log % info(Message)
-
-    ! Work out which observations belong to the current profile
-    do current_point = start_point, nobs
+    profile_start(iprofile) = current_point
+    do current_point = profile_start(iprofile), nobs
       if (unique(iprofile) /= record_number(index_vals(current_point))) exit
     end do
+  end do
+  profile_start(size(unique) + 1) = current_point
 
-    ! Load the geovals into the background structure
-    ! Reverse the order of the geovals, since this routine (and the forward
-    ! operator) works bottom-to-top
-    Back % za(:) = rho_heights % vals(prs%nval:1:-1, index_vals(start_point))
-    Back % zb(:) = theta_heights % vals(q%nval:1:-1, index_vals(start_point))
-    Back % p(:) = prs % vals(prs % nval:1:-1, index_vals(start_point))
-    Back % q(:) = q % vals(q%nval:1:-1, index_vals(start_point))
-
-    ! Allocate the observations structure
-    nobs_profile = current_point - start_point
-    call allocate_singleob(Ob, nobs_profile, prs % nval, q % nval)
-
-    ! Load the observations information into the obsevations structure
-    Ob % id = record_number(index_vals(start_point))
-    Ob % latitude = obsLat(index_vals(start_point))
-    Ob % longitude = obsLon(index_vals(start_point))
-    Ob % niter = 0  ! We haven't yet run 1DVar
-    Ob % jcost = missing_value(Ob % jcost)
-    Ob % bendingangle(:) % value = obs_bending_angle(index_vals(start_point:current_point-1))
-    Ob % bendingangle(:) % oberr = obs_err(index_vals(start_point:current_point-1))
-    Ob % impactparam(:) % value = impact_param(index_vals(start_point:current_point-1))
-    Ob % qc_flags(:) = qc_flags(index_vals(start_point:current_point-1))
-    Ob % ro_rad_curv % value = radius_curv(index_vals(start_point))
-    Ob % ro_geoid_und % value = undulation(index_vals(start_point))
-
-    ! Choose the latitude band and season of the B-matrix information
-    iseason = 1    ! Temporary -only one season at present!
-    iband = 1
-    DO
-      IF (b_matrix % band_up_lim(iband) > Ob % latitude .OR. &
-          iband == b_matrix % nband) EXIT
-      iband = iband + 1
-    END DO
-
-!   Call the code to set up the 1D-Var calculation
-    call Ops_GPSRO_Do1DVar_BA(prs % nval,              &   ! Number of pressure levels
-                              q % nval,                &   ! Number of specific humidity levels
-                              b_matrix % inverse(iseason,iband,:,:), &  ! Inverse of the b-matrix
-                              b_matrix % sigma(iseason,iband,:), &      ! Standard deviations of the b-matrix
-                              Back,                    &   ! Structure containing the model background information
-                              Ob,                      &   ! Structure containing the observation information
-                              self % pseudo_ops,       &   ! Whether to use pseudo-levels in calculation
-                              self % vert_interp_ops,  &   ! Whether to interpolate using ln(p) or exner
-                              self % min_temp_grad,    &   ! Minimum vertical temperature gradient allowed
-                              self % cost_funct_test,  &   ! Threshold value for the cost function convergence test
-                              self % y_test,           &   ! Threshold value for the yobs-ysol tes
-                              self % n_iteration_test, &   ! Maximum number of iterations
-                              self % Delta_factor,     &   ! Delta
-                              self % Delta_ct2,        &   ! Delta observations
-                              self % OB_test,          &   ! Threshold value for the O-B test
-                              self % capsupersat,      &   ! Whether to remove super-saturation
-                              BAerr,                   &   ! Whether there are errors in the bending angle calculation
-                              Tb,                      &   ! Calculated background temperature
-                              Ts,                      &   ! 1DVar solution temperature
-                              O_Bdiff,                 &   ! Difference between observations and background for profile
-                              DFS)                         ! Estimated degrees of freedom for signal
-
-    ! Flag bad profiles
-    do ipoint = 0, nobs_profile-1
-      if (qc_flags(start_point + ipoint) > 0) then
-        ! Do nothing, since the data are already flagged
-      else if (Ob % bendingangle(ipoint+1) % PGEFinal > 0.5) then
-        qc_flags(start_point + ipoint) = self % onedvarflag
-        Ob % qc_flags(ipoint+1) = self % onedvarflag
-      end if
-    end do
-
-    write(Message,'(A,2I5,2F10.3,I5,E16.8)') 'Profile stats: ', obsSatid(index_vals(start_point)), &
-        obsOrigC(index_vals(start_point)), Ob % latitude, Ob % longitude, &
-        Ob % niter, Ob % jcost
-    call fckit_log % debug(Message)
-    
-    if (verboseOutput) then
-      do ipoint = 0, nobs_profile-1, 20
-          write(Message,'(20I5)') qc_flags(index_vals(start_point+ipoint: &
-                                                      min(start_point+ipoint+19, current_point-1)))
-          call fckit_log % debug(Message)
-      end do
-      do ipoint = 0, nobs_profile-1, 10
-          write(Message,'(10E16.5)') obs_bending_angle(index_vals(start_point+ipoint: &
-                                                               min(start_point+ipoint+9, current_point-1)))
-          call fckit_log % debug(Message)
-      end do
-    end if
-
-    call deallocate_singleob(Ob)
+  ! For every profile that we have found, perform a 1DVar minimisation. The profiles
+  ! are independent and each one only updates the QC flags of its own observations,
+  ! so they are distributed across OpenMP threads.
+  !$omp parallel do schedule(dynamic) default(shared) private(iprofile)
+  do iprofile = 1, size(unique)
+    call ufo_gnssroonedvarcheck_process_profile(self, iprofile,                          &
+                                                profile_start(iprofile),                 &
+                                                profile_start(iprofile + 1),             &
+                                                index_vals, q, prs, theta_heights,       &
+                                                rho_heights, obsLat, obsLon,             &
+                                                impact_param, radius_curv, undulation,   &
+                                                obs_bending_angle, obs_err, record_number, &
+                                                obsSatid, obsOrigC, qc_flags)
   end do
+  !$omp end parallel do
+
   call obsspace_put_db(self % obsdb, "FortranQC", "bending_angle", qc_flags)
 
 end subroutine ufo_gnssroonedvarcheck_apply
 
+! ------------------------------------------------------------------------------
+!> Perform the 1D-Var minimisation for a single profile of observations
+!!
+!! \details The observations start_point to current_point-1 (in the order given
+!! by index_vals) make up the profile.  Only the QC flags of these observations
+!! are updated, and all the work arrays are local, so different profiles can be
+!! processed concurrently.
+!!
+!! \author Met Office
+!!
+!! \date 14/10/2022: Created
+!!
+subroutine ufo_gnssroonedvarcheck_process_profile(self, iprofile, start_point, current_point, &
+                                                  index_vals, q, prs, theta_heights,          &
+                                                  rho_heights, obsLat, obsLon, impact_param,  &
+                                                  radius_curv, undulation, obs_bending_angle, &
+                                                  obs_err, record_number, obsSatid, obsOrigC, &
+                                                  qc_flags)
+
+  implicit none
+
+  ! Subroutine arguments
+  type(ufo_gnssroonedvarcheck), intent(in) :: self         !< gnssroonedvarcheck main object
+  integer, intent(in)                  :: iprofile          !< Profile number
+  integer, intent(in)                  :: start_point       !< Starting index of the profile
+  integer, intent(in)                  :: current_point     !< One past the ending index of the profile
+  integer, intent(in)                  :: index_vals(:)     !< Indices of sorted observation
+  type(ufo_geoval), intent(in)         :: q                 !< Model background values of specific humidity
+  type(ufo_geoval), intent(in)         :: prs               !< Model background values of air pressure
+  type(ufo_geoval), intent(in)         :: theta_heights     !< Model heights of levels containing specific humidity
+  type(ufo_geoval), intent(in)         :: rho_heights       !< Model heights of levels containing air pressure
+  real(kind_real), intent(in)          :: obsLat(:)         !< Latitude of the observation
+  real(kind_real), intent(in)          :: obsLon(:)         !< Longitude of the observation
+  real(kind_real), intent(in)          :: impact_param(:)   !< Impact parameter of the observation
+  real(kind_real), intent(in)          :: radius_curv(:)    !< Earth's radius of curvature at the observation tangent point
+  real(kind_real), intent(in)          :: undulation(:)     !< Undulation - height of the geoid above the ellipsoid
+  real(kind_real), intent(in)          :: obs_bending_angle(:) !< Observed bending angle
+  real(kind_real), intent(in)          :: obs_err(:)        !< Observation error, taken from a previous filter
+  integer(c_size_t), intent(in)        :: record_number(:)  !< Number used to identify unique profiles in the data
+  integer, intent(in)                  :: obsSatid(:)       !< Satellite identifier for each observation
+  integer, intent(in)                  :: obsOrigC(:)       !< Originating centre for each observation
+  integer, intent(inout)               :: qc_flags(:)       !< QC flags to be updated
+
+  ! Local parameters
+  logical, parameter :: verboseOutput = .FALSE.          ! Whether to output extra debugging information
+
+  ! Local variables
+  type(singlebg_type)                :: Back             ! Model background fields
+  type(singleob_type)                :: Ob               ! The profile of observations
+  integer                            :: nobs_profile          ! Number of observations in the profile
+  character(len=800)                 :: Message               ! Message to be output
+  logical                            :: BAerr                 ! Has there been an error in the bending angle calculation?
+  integer                            :: iband                 ! Selected latitude band of the B-matrix
+  integer                            :: iseason               ! Selected season of the B-matrix
+  integer                            :: ipoint                ! Loop variable, observation point
+  real(kind_real)                    :: dfs                   ! Degrees of freedom for signal in profile
+  real(kind_real)                    :: O_Bdiff               ! Average RMS(O-B) for profile
+  real(kind_real)                    :: Tb(q % nval)          ! Calculated background temperature (derived from p,q)
+  real(kind_real)                    :: Ts(q % nval)          ! 1DVar solution temperature
+
+  WRITE (Message, '(A,I0)') 'ObNumber ', iprofile
+  call fckit_log % info(Message)
+  WRITE (Message, '(A,F12.2)') 'Latitude ', obsLat(index_vals(start_point))
+  call fckit_log % info(Message)
+  WRITE (Message, '(A,F12.2)') 'Longitude ', obsLon(index_vals(start_point))
+  call fckit_log % info(Message)
+  WRITE (Message, '(A,I0)') 'Processing centre ', obsOrigC(index_vals(start_point))
+  call fckit_log % info(Message)
+  WRITE (Message, '(A,I0)') 'Sat ID ', obsSatid(index_vals(start_point))
+  call fckit_log % info(Message)
+
+  ! Load the geovals into the background structure
+  ! Reverse the order of the geovals, since this routine (and the forward
+  ! operator) works bottom-to-top
+  call allocate_singlebg(Back, prs % nval, q % nval)
+  Back % za(:) = rho_heights % vals(prs%nval:1:-1, index_vals(start_point))
+  Back % zb(:) = theta_heights % vals(q%nval:1:-1, index_vals(start_point))
+  Back % p(:) = prs % vals(prs % nval:1:-1, index_vals(start_point))
+  Back % q(:) = q % vals(q%nval:1:-1, index_vals(start_point))
+
+  ! Allocate the observations structure
+  nobs_profile = current_point - start_point
+  call allocate_singleob(Ob, nobs_profile, prs % nval, q % nval)
+
+  ! Load the observations information into the obsevations structure
+  Ob % id = record_number(index_vals(start_point))
+  Ob % latitude = obsLat(index_vals(start_point))
+  Ob % longitude = obsLon(index_vals(start_point))
+  Ob % niter = 0  ! We haven't yet run 1DVar
+  Ob % jcost = missing_value(Ob % jcost)
+  Ob % bendingangle(:) % value = obs_bending_angle(index_vals(start_point:current_point-1))
+  Ob % bendingangle(:) % oberr = obs_err(index_vals(start_point:current_point-1))
+  Ob % impactparam(:) % value = impact_param(index_vals(start_point:current_point-1))
+  Ob % qc_flags(:) = qc_flags(index_vals(start_point:current_point-1))
+  Ob % ro_rad_curv % value = radius_curv(index_vals(start_point))
+  Ob % ro_geoid_und % value = undulation(index_vals(start_point))
+
+  ! Choose the latitude band and season of the B-matrix information
+  iseason = 1    ! Temporary -only one season at present!
+  iband = self % b_matrix % band(Ob % latitude)
+
+! Call the code to set up the 1D-Var calculation
+  call Ops_GPSRO_Do1DVar_BA(prs % nval,              &   ! Number of pressure levels
+                            q % nval,                &   ! Number of specific humidity levels
+                            self % b_matrix % inverse(:,:,iband,iseason), &  ! Inverse of the b-matrix
+                            self % b_matrix % sigma(:,iband,iseason), &      ! Standard deviations of the b-matrix
+                            Back,                    &   ! Structure containing the model background information
+                            Ob,                      &   ! Structure containing the observation information
+                            self % pseudo_ops,       &   ! Whether to use pseudo-levels in calculation
+                            self % vert_interp_ops,  &   ! Whether to interpolate using ln(p) or exner
+                            self % min_temp_grad,    &   ! Minimum vertical temperature gradient allowed
+                            self % cost_funct_test,  &   ! Threshold value for the cost function convergence test
+                            self % y_test,           &   ! Threshold value for the yobs-ysol tes
+                            self % n_iteration_test, &   ! Maximum number of iterations
+                            self % Delta_factor,     &   ! Delta
+                            self % Delta_ct2,        &   ! Delta observations
+                            self % OB_test,          &   ! Threshold value for the O-B test
+                            self % capsupersat,      &   ! Whether to remove super-saturation
+                            BAerr,                   &   ! Whether there are errors in the bending angle calculation
+                            Tb,                      &   ! Calculated background temperature
+                            Ts,                      &   ! 1DVar solution temperature
+                            O_Bdiff,                 &   ! Difference between observations and background for profile
+                            DFS)                         ! Estimated degrees of freedom for signal
+
+  ! Flag bad profiles
+  do ipoint = 0, nobs_profile-1
+    if (qc_flags(index_vals(start_point + ipoint)) > 0) then
+      ! Do nothing, since the data are already flagged
+    else if (Ob % bendingangle(ipoint+1) % PGEFinal > 0.5) then
+      qc_flags(index_vals(start_point + ipoint)) = self % onedvarflag
+      Ob % qc_flags(ipoint+1) = self % onedvarflag
+    end if
+  end do
+
+  write(Message,'(A,2I5,2F10.3,I5,E16.8)') 'Profile stats: ', obsSatid(index_vals(start_point)), &
+      obsOrigC(index_vals(start_point)), Ob % latitude, Ob % longitude, &
+      Ob % niter, Ob % jcost
+  call fckit_log % debug(Message)
+
+  if (verboseOutput) then
+    do ipoint = 0, nobs_profile-1, 20
+        write(Message,'(20I5)') qc_flags(index_vals(start_point+ipoint: &
+                                                    min(start_point+ipoint+19, current_point-1)))
+        call fckit_log % debug(Message)
+    end do
+    do ipoint = 0, nobs_profile-1, 10
+        write(Message,'(10E16.5)') obs_bending_angle(index_vals(start_point+ipoint: &
+                                                             min(start_point+ipoint+9, current_point-1)))
+        call fckit_log % debug(Message)
+    end do
+  end if
+
+  call deallocate_singleob(Ob)
+  call deallocate_singlebg(Back)
+
+end subroutine ufo_gnssroonedvarcheck_process_profile
+
 end module ufo_gnssroonedvarcheck_mod
@@ -13,6 +13,7 @@
 #include "ioda/ObsDataVector.h"
 #include "oops/base/Variables.h"
 #include "ufo/filters/ObsFilterData.h"
+#include "ufo/filters/Variable.h"
 #include "ufo/filters/obsfunctions/CLWRetMW.h"
 #include "ufo/utils/Constants.h"
 
@@ -45,7 +46,9 @@ void CLWRetSymmetricMW::compute(const ObsFilterData & in,
   CLWRetMW clwretfunc(conf_);
   oops::Variables clwvars(clwretfunc.clwVariableGroups());
   ioda::ObsDataVector<float> clwret(in.obsspace(), clwvars, "ObsFunction", false);
-  clwretfunc.compute(in, clwret);
+  // Retrieve them through ObsFilterData, so that they are taken from the ObsFunction cache (if
+  // any) when they have already been computed with the same options, e.g. by another filter.
+  in.get(Variable("CLWRetMW@ObsFunction", conf_), clwret);
 
   // Get symmetric CLW amount
   for (size_t iloc = 0; iloc < nlocs; ++iloc) {
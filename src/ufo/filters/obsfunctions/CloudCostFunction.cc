@@ -7,6 +7,8 @@
 
 #include <Eigen/Dense>
 #include <algorithm>
+#include <map>
+#include <memory>
 #include <set>
 
 #include "ioda/ObsDataVector.h"
@@ -17,12 +19,20 @@
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/metoffice/MetOfficeBMatrixStatic.h"
 #include "ufo/utils/metoffice/MetOfficeRMatrixRadiance.h"
+#include "ufo/utils/SharedResource.h"
 #include "ufo/utils/ufo_utils.interface.h"
 
 namespace ufo {
 
 static ObsFunctionMaker<CloudCostFunction> makerCloudCostFunction_("CloudCostFunction");
 
+namespace {
+
+/// Maximum number of locations whose Jacobians are multiplied by B in a single matrix product.
+const size_t maxBatchSize = 256;
+
+}  // namespace
+
 CloudCostFunction::CloudCostFunction(const eckit::LocalConfiguration & conf)
   : invars_() {
   // Initialize options
@@ -79,16 +89,30 @@ void CloudCostFunction::compute(const ObsFilterData & in,
   ASSERT(out.nvars() == 1);
   if (nlocs == 0) return;
 
-  // B, R error covariance objects
-  eckit::LocalConfiguration bMatrixConf;
-  bMatrixConf.set("BMatrix", options_.bmatrix_filepath.value());
-  bMatrixConf.set("background fields", options_.field_names.value());
-  bMatrixConf.set("qtotal", options_.qtotal_lnq_gkg.value());
-  MetOfficeBMatrixStatic staticB(bMatrixConf);
-
-  eckit::LocalConfiguration rMatrixConf;
-  rMatrixConf.set("RMatrix", options_.rmatrix_filepath.value());
-  MetOfficeRMatrixRadiance staticR(rMatrixConf);
+  // B, R error covariance objects. They are read from file once and shared by all instances of
+  // this function using the same files and options.
+  std::string bMatrixKey = "MetOfficeBMatrixStatic " + options_.bmatrix_filepath.value() +
+      (options_.qtotal_lnq_gkg.value() ? " qtotal" : "");
+  for (const std::string &field : options_.field_names.value())
+    bMatrixKey += " " + field;
+  const std::shared_ptr<const MetOfficeBMatrixStatic> sharedB =
+      SharedResource<MetOfficeBMatrixStatic>::get(bMatrixKey, [&]() {
+        eckit::LocalConfiguration bMatrixConf;
+        bMatrixConf.set("BMatrix", options_.bmatrix_filepath.value());
+        bMatrixConf.set("background fields", options_.field_names.value());
+        bMatrixConf.set("qtotal", options_.qtotal_lnq_gkg.value());
+        return std::make_shared<const MetOfficeBMatrixStatic>(bMatrixConf);
+      });
+  const std::shared_ptr<const MetOfficeRMatrixRadiance> sharedR =
+      SharedResource<MetOfficeRMatrixRadiance>::get(
+        "MetOfficeRMatrixRadiance " + options_.rmatrix_filepath.value(), [&]() {
+          eckit::LocalConfiguration rMatrixConf;
+          rMatrixConf.set("RMatrix", options_.rmatrix_filepath.value());
+          return std::make_shared<const MetOfficeRMatrixRadiance>(rMatrixConf);
+        });
+  const MetOfficeRMatrixRadiance &staticR = *sharedR;
+  // Copy of B scaled for the skin temperature error, if required.
+  std::unique_ptr<MetOfficeBMatrixStatic> scaledB;
 
   const std::string clw_name = "mass_content_of_cloud_liquid_water_in_atmosphere_layer";
   const std::string ciw_name = "mass_content_of_cloud_ice_in_atmosphere_layer";
@@ -107,8 +131,10 @@ void CloudCostFunction::compute(const ObsFilterData & in,
       skinTempIndex += in.nlevs(Variable(
                       "brightness_temperature_jacobian_"+fields_[ifield]+"@ObsDiag", channels_)[0]);
     }
-    staticB.scale(skinTempIndex, options_.skinTempError.value().value());
+    scaledB.reset(new MetOfficeBMatrixStatic(*sharedB));
+    scaledB->scale(skinTempIndex, options_.skinTempError.value().value());
   }
+  const MetOfficeBMatrixStatic &staticB = scaledB ? *scaledB : *sharedB;
 
   bool split_rain = options_.qtotal_split_rain.value();
 
@@ -125,19 +151,34 @@ void CloudCostFunction::compute(const ObsFilterData & in,
   ASSERT(gv_pres_N[0] != missing);
   bool p_ascending = (gv_pres_N[0] > gv_pres_1[0]);
 
-  // Assemble combined Jacobian from component fields
-  std::vector<std::vector<std::vector<float>>>
-       jac_vec(nlocs, std::vector<std::vector<float>>(nchans, std::vector<float>()));
+  // Assemble combined Jacobian from component fields. Column iloc * nchans + ichan of
+  // HmatrixT holds the row of the Jacobian H for location iloc and channel ichan, so that the
+  // Jacobians of any set of locations can be multiplied by B in a single matrix product.
+  const size_t sizeB = staticB.getsize();
+  Eigen::MatrixXf HmatrixT = Eigen::MatrixXf::Zero(sizeB, nlocs * nchans);
+  size_t ielem = 0;  // index of the B-matrix element corresponding to the current level
   for (size_t ifield = 0; ifield < fields_.size(); ++ifield) {
     if (options_.qtotal_lnq_gkg.value() &&
             (fields_[ifield] == clw_name || fields_[ifield] == ciw_name)) {
       // qtotal ln(g/kg) Jacobian calculated when "specific_humidity" is reached in field list
       continue;
     }
-    std::string jac_name = "brightness_temperature_jacobian_"+fields_[ifield]+"@ObsDiag";
-    size_t nlevs = in.nlevs(Variable(jac_name, channels_)[0]);
+    const Variable jac_var("brightness_temperature_jacobian_"+fields_[ifield]+"@ObsDiag",
+                           channels_);
+    const Variable jac_clw_var("brightness_temperature_jacobian_"+clw_name+"@ObsDiag", channels_);
+    const Variable jac_ciw_var("brightness_temperature_jacobian_"+ciw_name+"@ObsDiag", channels_);
+    size_t nlevs = in.nlevs(jac_var[0]);
     std::vector<float> jac_store(nlocs);
     for (size_t ilev = 0; ilev < nlevs; ++ilev) {
+      // B-matrix contains emissivity error covariances only for selected surface-sensitive
+      // channels j, separate from the set of cost channels i. The Jacobian with respect to
+      // emissivity sample channels, d[brightness_temperature_i]/d[surface_emissivity_j],
+      // is set to zero, so HmatrixT is left unchanged.
+      if (fields_[ifield] == "surface_emissivity") {
+        ielem += emissMap_.size();
+        continue;
+      }
+      ASSERT(ielem < sizeB);
       const int level_gv = (p_ascending ? ilev : nlevs-ilev-1);
       const int level_jac = (options_.reverse_Jacobian.value() ? nlevs-level_gv-1 : level_gv);
       if (fields_[ifield] == "specific_humidity" && options_.qtotal_lnq_gkg.value()) {
@@ -171,14 +212,12 @@ void CloudCostFunction::compute(const ObsFilterData & in,
       }
 
       for (size_t ichan = 0; ichan < nchans; ++ichan) {
-        in.get(Variable(jac_name, channels_)[ichan], level_jac, jac_store);
+        in.getChannel(jac_var, ichan, level_jac, jac_store);
 
         if (fields_[ifield] == "specific_humidity" && options_.qtotal_lnq_gkg.value()) {
           std::vector<float> jac_clw(nlocs), jac_ciw(nlocs);
-          in.get(Variable("brightness_temperature_jacobian_"+clw_name+"@ObsDiag", channels_)[ichan],
-                 level_jac, jac_clw);
-          in.get(Variable("brightness_temperature_jacobian_"+ciw_name+"@ObsDiag", channels_)[ichan],
-                 level_jac, jac_ciw);
+          in.getChannel(jac_clw_var, ichan, level_jac, jac_clw);
+          in.getChannel(jac_ciw_var, ichan, level_jac, jac_ciw);
           std::vector<float> dq_dqtotal(nlocs), dql_dqtotal(nlocs), dqi_dqtotal(nlocs);
           int qsplit_derivative_mode = 2;  // compute derivatives
           ufo_ops_satrad_qsplit_f90(qsplit_derivative_mode, static_cast<int>(nlocs), gv_pres.data(),
@@ -216,40 +255,26 @@ void CloudCostFunction::compute(const ObsFilterData & in,
           }
         }
 
-        for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-          if (fields_[ifield] == "surface_emissivity") {
-            // B-matrix contains emissivity error covariances only for selected surface-sensitive
-            // channels j, separate from the set of cost channels i. The Jacobian with respect to
-            // emissivity sample channels, d[brightness_temperature_i]/d[surface_emissivity_j],
-            // is set to zero.
-            for (size_t jemiss = 0; jemiss < emissMap_.size(); ++jemiss)
-              jac_vec[iloc][ichan].push_back(0.0f);
-          } else {
-            jac_vec[iloc][ichan].push_back(jac_store[iloc]);
-          }
-        }
+        for (size_t iloc = 0; iloc < nlocs; ++iloc)
+          HmatrixT(ielem, iloc * nchans + ichan) = jac_store[iloc];
       }
+      ++ielem;
     }
   }
-
-  const size_t sizeB = staticB.getsize();
-  for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    for (size_t ichan = 0; ichan < nchans; ++ichan) {
-      ASSERT(jac_vec[iloc][ichan].size() == sizeB);
-    }
-  }
+  ASSERT(ielem == sizeB);
 
   // Get departures = ObsValue - HofX (where HofX is bias corrected)
-  std::vector<std::vector<float>> departures(nlocs, std::vector<float>(nchans));
+  Eigen::MatrixXf departures(nchans, nlocs);
   std::vector<float> obsvalues(nlocs);
   std::vector<float> bgvalues(nlocs);
   std::vector<bool> is_out_of_bounds(nlocs, false);
+  const Variable obsvalue_var("brightness_temperature@ObsValue", channels_);
+  const Variable hofx_var("brightness_temperature@"+options_.HofXGroup.value(), channels_);
   for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature@ObsValue", channels_)[ichan], obsvalues);
-    in.get(Variable("brightness_temperature@"+options_.HofXGroup.value(), channels_)[ichan],
-           bgvalues);
+    in.get(obsvalue_var[ichan], obsvalues);
+    in.get(hofx_var[ichan], bgvalues);
     for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-      departures[iloc][ichan] = obsvalues[iloc] - bgvalues[iloc];
+      departures(ichan, iloc) = obsvalues[iloc] - bgvalues[iloc];
       // Flag observations outside expected bounds
       if (obsvalues[iloc] < options_.minTb.value() || obsvalues[iloc] > options_.maxTb.value()) {
         is_out_of_bounds[iloc] = true;
@@ -259,41 +284,59 @@ void CloudCostFunction::compute(const ObsFilterData & in,
 
   std::vector<float> latitude(nlocs);
   in.get(Variable("latitude@MetaData"), latitude);
-  Eigen::MatrixXf Hmatrix(nchans, sizeB);
 
+  // Group the locations to process by B-matrix latitude band.
+  std::map<size_t, std::vector<size_t>> locsByBand;
   for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    if (is_out_of_bounds[iloc]) {
+    if (is_out_of_bounds[iloc])
       out[0][iloc] = options_.maxCost.value();
-      continue;
-    }
-    for (size_t ichan = 0; ichan < nchans; ++ichan) {
-      Hmatrix.row(ichan) = Eigen::Map<Eigen::VectorXf>(jac_vec[iloc][ichan].data(), sizeB);
-    }
+    else
+      locsByBand[staticB.getindex(latitude[iloc])].push_back(iloc);
+  }
 
-    // Matrix of departures dy
-    Eigen::Map<Eigen::VectorXf> dy(departures[iloc].data(), nchans);
-
-    // Calculate Scratch_matrix = H.B.H^T + R
-    Eigen::MatrixXf BHT;
-    staticB.multiply(latitude[iloc], Hmatrix.transpose(), BHT);
-    Eigen::MatrixXf HBHT = Hmatrix*BHT;
-    Eigen::MatrixXf Scratch_matrix;
-    staticR.add(channels_, HBHT, Scratch_matrix);
-
-    // Calculate Scratch_matrix2 = Scratch_matrix^-1.dy using Cholesky decomposition
-    Eigen::LLT<Eigen::MatrixXf> decomposition(Scratch_matrix);
-    if (decomposition.info() == Eigen::NumericalIssue) {
-      oops::Log::warning() <<
-        "CloudCostFunction Scratch_matrix appears not to be positive definite" << std::endl;
-      out[0][iloc] = options_.maxCost.value();
-      continue;
-    }
-    Eigen::VectorXf Scratch_matrix2 = decomposition.solve(dy);
+  // The same channels are used at all locations, so R is the same everywhere.
+  const Eigen::VectorXf & rVariances = staticR.variances(channels_);
+
+  Eigen::MatrixXf HmatrixTBatch, BHT;
+  for (const auto & bandAndLocs : locsByBand) {
+    const std::vector<size_t> & bandLocs = bandAndLocs.second;
+    const Eigen::MatrixXf & Bmatrix = staticB.matrix(latitude[bandLocs.front()]);
+    for (size_t batchStart = 0; batchStart < bandLocs.size(); batchStart += maxBatchSize) {
+      const size_t batchSize = std::min(maxBatchSize, bandLocs.size() - batchStart);
+
+      // Calculate B.H^T for all locations in the batch with a single matrix product
+      HmatrixTBatch.resize(sizeB, batchSize * nchans);
+      for (size_t ibatch = 0; ibatch < batchSize; ++ibatch)
+        HmatrixTBatch.middleCols(ibatch * nchans, nchans) =
+          HmatrixT.middleCols(bandLocs[batchStart + ibatch] * nchans, nchans);
+      BHT.noalias() = Bmatrix * HmatrixTBatch;
+
+      for (size_t ibatch = 0; ibatch < batchSize; ++ibatch) {
+        const size_t iloc = bandLocs[batchStart + ibatch];
+
+        // Calculate Scratch_matrix = H.B.H^T + R
+        Eigen::MatrixXf Scratch_matrix(nchans, nchans);
+        Scratch_matrix.noalias() = HmatrixTBatch.middleCols(ibatch * nchans, nchans).transpose() *
+                                   BHT.middleCols(ibatch * nchans, nchans);
+        Scratch_matrix.diagonal() += rVariances;
+
+        // Calculate Scratch_matrix2 = Scratch_matrix^-1.dy using Cholesky decomposition
+        Eigen::LLT<Eigen::MatrixXf> decomposition(Scratch_matrix);
+        if (decomposition.info() == Eigen::NumericalIssue) {
+          oops::Log::warning() <<
+            "CloudCostFunction Scratch_matrix appears not to be positive definite" << std::endl;
+          out[0][iloc] = options_.maxCost.value();
+          continue;
+        }
+        const auto dy = departures.col(iloc);
+        Eigen::VectorXf Scratch_matrix2 = decomposition.solve(dy);
 
-    // Final cost
-    float Cost_final = 0.5*dy.transpose()*Scratch_matrix2;
-    Cost_final /= static_cast<float>(nchans);  // normalise by number of channels
-    out[0][iloc] = std::min(Cost_final, options_.maxCost.value());
+        // Final cost
+        float Cost_final = 0.5*dy.transpose()*Scratch_matrix2;
+        Cost_final /= static_cast<float>(nchans);  // normalise by number of channels
+        out[0][iloc] = std::min(Cost_final, options_.maxCost.value());
+      }
+    }
   }
 }
 
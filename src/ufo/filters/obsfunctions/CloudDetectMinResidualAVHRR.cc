@@ -20,6 +20,7 @@
 #include "ioda/ObsDataVector.h"
 #include "oops/util/IntSetParser.h"
 #include "oops/util/missingValues.h"
+#include "ufo/filters/obsfunctions/SurfaceClassRad.h"
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/Constants.h"
 
@@ -60,11 +61,8 @@ CloudDetectMinResidualAVHRR::CloudDetectMinResidualAVHRR(const eckit::LocalConfi
   invars_ += Variable("brightness_temperature@ObsValue", channels_);
   invars_ += Variable("brightness_temperature@ObsError", channels_);
 
-  // Include list of required data from GeoVaLs
-  invars_ += Variable("water_area_fraction@GeoVaLs");
-  invars_ += Variable("land_area_fraction@GeoVaLs");
-  invars_ += Variable("ice_area_fraction@GeoVaLs");
-  invars_ += Variable("surface_snow_area_fraction@GeoVaLs");
+  // Include dominant surface types (derived from GeoVaLs)
+  invars_ += SurfaceClassRad::variable();
   invars_ += Variable("average_surface_temperature_within_field_of_view@GeoVaLs");
   invars_ += Variable("air_pressure@GeoVaLs");
   invars_ += Variable("air_temperature@GeoVaLs");
@@ -181,15 +179,9 @@ void CloudDetectMinResidualAVHRR::compute(const ObsFilterData & in,
   std::vector<float> tsavg(nlocs);
   in.get(Variable("average_surface_temperature_within_field_of_view@GeoVaLs"), tsavg);
 
-  // Get area fraction of each surface type
-  std::vector<float> water_frac(nlocs);
-  std::vector<float> land_frac(nlocs);
-  std::vector<float> ice_frac(nlocs);
-  std::vector<float> snow_frac(nlocs);
-  in.get(Variable("water_area_fraction@GeoVaLs"), water_frac);
-  in.get(Variable("land_area_fraction@GeoVaLs"), land_frac);
-  in.get(Variable("ice_area_fraction@GeoVaLs"), ice_frac);
-  in.get(Variable("surface_snow_area_fraction@GeoVaLs"), snow_frac);
+  // Get dominant surface types in each FOV
+  std::vector<int> surfclass(nlocs);
+  in.get(SurfaceClassRad::variable(), surfclass);
 
   // Determine dominant surface type in each FOV
   std::vector<bool> land(nlocs, false);
@@ -198,11 +190,11 @@ void CloudDetectMinResidualAVHRR::compute(const ObsFilterData & in,
   std::vector<bool> snow(nlocs, false);
   std::vector<bool> mixed(nlocs, false);
   for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    sea[iloc] = water_frac[iloc] >= 0.99;
-    land[iloc] = land_frac[iloc] >= 0.99;
-    ice[iloc] = ice_frac[iloc] >= 0.99;
-    snow[iloc] = snow_frac[iloc] >= 0.99;
-    mixed[iloc] = (!sea[iloc] && !land[iloc] && !ice[iloc] && !snow[iloc]);
+    sea[iloc] = surfclass[iloc] & SurfaceClassRadBits::sea;
+    land[iloc] = surfclass[iloc] & SurfaceClassRadBits::land;
+    ice[iloc] = surfclass[iloc] & SurfaceClassRadBits::ice;
+    snow[iloc] = surfclass[iloc] & SurfaceClassRadBits::snow;
+    mixed[iloc] = surfclass[iloc] & SurfaceClassRadBits::mixed;
   }
 
   // Setup weight given to each surface type
@@ -15,11 +15,13 @@
 #include <iostream>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ioda/ObsDataVector.h"
 #include "oops/util/IntSetParser.h"
 #include "oops/util/missingValues.h"
+#include "ufo/filters/obsfunctions/SurfaceClassRad.h"
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/Constants.h"
 
@@ -58,11 +60,8 @@ CloudDetectMinResidualIR::CloudDetectMinResidualIR(const eckit::LocalConfigurati
   invars_ += Variable("brightness_temperature@ObsValue", channels_);
   invars_ += Variable("brightness_temperature@ObsError", channels_);
 
-  // Include list of required data from GeoVaLs
-  invars_ += Variable("water_area_fraction@GeoVaLs");
-  invars_ += Variable("land_area_fraction@GeoVaLs");
-  invars_ += Variable("ice_area_fraction@GeoVaLs");
-  invars_ += Variable("surface_snow_area_fraction@GeoVaLs");
+  // Include dominant surface types (derived from GeoVaLs)
+  invars_ += SurfaceClassRad::variable();
   invars_ += Variable("average_surface_temperature_within_field_of_view@GeoVaLs");
   invars_ += Variable("air_pressure@GeoVaLs");
   invars_ += Variable("air_temperature@GeoVaLs");
@@ -96,53 +95,55 @@ void CloudDetectMinResidualIR::compute(const ObsFilterData & in,
 
   // Get variables from ObsDiag
   // Load surface temperature jacobian
-  std::vector<std::vector<float>> dbtdts(nchans, std::vector<float>(nlocs));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature_jacobian_surface_temperature@ObsDiag",
-                     channels_)[ichan], dbtdts[ichan]);
-  }
+  std::vector<std::vector<float>> dbtdts;
+  in.getChannels(Variable("brightness_temperature_jacobian_surface_temperature@ObsDiag",
+                          channels_), dbtdts);
 
   // Get temperature jacobian
   std::vector<std::vector<std::vector<float>>>
-       dbtdt(nchans, std::vector<std::vector<float>>(nlevs, std::vector<float>(nlocs)));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    for (size_t ilev = 0; ilev < nlevs; ++ilev) {
-      const int level = nlevs - ilev - 1;
-      in.get(Variable("brightness_temperature_jacobian_air_temperature@ObsDiag",
-                       channels_)[ichan], level, dbtdt[ichan][ilev]);
-    }
+       dbtdt(nchans, std::vector<std::vector<float>>(nlevs));
+  std::vector<std::vector<float>> dbtdtAtLevel;
+  for (size_t ilev = 0; ilev < nlevs; ++ilev) {
+    const int level = nlevs - ilev - 1;
+    in.getChannels(Variable("brightness_temperature_jacobian_air_temperature@ObsDiag", channels_),
+                   level, dbtdtAtLevel);
+    for (size_t ichan = 0; ichan < nchans; ++ichan)
+      dbtdt[ichan][ilev] = std::move(dbtdtAtLevel[ichan]);
   }
 
   // Get layer-to-space transmittance
   std::vector<std::vector<std::vector<float>>>
-       tao(nchans, std::vector<std::vector<float>>(nlevs, std::vector<float>(nlocs)));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    for (size_t ilev = 0; ilev < nlevs; ++ilev) {
-      const int level = nlevs - ilev - 1;
-      in.get(Variable("transmittances_of_atmosphere_layer@ObsDiag",
-             channels_)[ichan], level,  tao[ichan][ilev]);
-    }
+       tao(nchans, std::vector<std::vector<float>>(nlevs));
+  std::vector<std::vector<float>> taoAtLevel;
+  for (size_t ilev = 0; ilev < nlevs; ++ilev) {
+    const int level = nlevs - ilev - 1;
+    in.getChannels(Variable("transmittances_of_atmosphere_layer@ObsDiag", channels_),
+                   level, taoAtLevel);
+    for (size_t ichan = 0; ichan < nchans; ++ichan)
+      tao[ichan][ilev] = std::move(taoAtLevel[ichan]);
   }
 
   // Get pressure level at the peak of the weighting function
-  std::vector<float> values(nlocs, 0.0);
-  std::vector<std::vector<float>> wfunc_pmaxlev(nchans, std::vector<float>(nlocs));
+  std::vector<std::vector<float>> wfunc_pmaxlev;
+  in.getChannels(Variable("pressure_level_at_peak_of_weightingfunction@ObsDiag", channels_),
+                 wfunc_pmaxlev);
   for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("pressure_level_at_peak_of_weightingfunction@ObsDiag",
-                     channels_)[ichan], values);
     for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-      wfunc_pmaxlev[ichan][iloc] = nlevs - values[iloc] + 1;
+      wfunc_pmaxlev[ichan][iloc] = nlevs - wfunc_pmaxlev[ichan][iloc] + 1;
     }
   }
 
   // Get variables from ObsSpace
   // Get effective observation error and convert it to inverse of the error variance
   const float missing = util::missingValue(missing);
-  std::vector<int> qcflag(nlocs, 0);
   std::vector<std::vector<float>> varinv_use(nchans, std::vector<float>(nlocs, 0.0));
+  std::vector<std::vector<float>> obserrdata;
+  std::vector<std::vector<int>> qcflagdata;
+  in.getChannels(Variable("brightness_temperature@"+errgrp, channels_), obserrdata);
+  in.getChannels(Variable("brightness_temperature@"+flaggrp, channels_), qcflagdata);
   for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature@"+errgrp, channels_)[ichan], values);
-    in.get(Variable("brightness_temperature@"+flaggrp, channels_)[ichan], qcflag);
+    std::vector<float> &values = obserrdata[ichan];
+    std::vector<int> &qcflag = qcflagdata[ichan];
     for (size_t iloc = 0; iloc < nlocs; ++iloc) {
       if (flaggrp == "PreQC") values[iloc] == missing ? qcflag[iloc] = 100 : qcflag[iloc] = 0;
       (qcflag[iloc] == 0) ? (values[iloc] = 1.0 / pow(values[iloc], 2)) : (values[iloc] = 0.0);
@@ -152,20 +153,18 @@ void CloudDetectMinResidualIR::compute(const ObsFilterData & in,
   }
 
   // Get bias corrected innovation (tbobs - hofx) (hofx includes bias correction)
-  std::vector<std::vector<float>> innovation(nchans, std::vector<float>(nlocs));
+  std::vector<std::vector<float>> innovation, hofx;
+  in.getChannels(Variable("brightness_temperature@ObsValue", channels_), innovation);
+  in.getChannels(Variable("brightness_temperature@"+hofxgrp, channels_), hofx);
   for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature@ObsValue", channels_)[ichan], innovation[ichan]);
-    in.get(Variable("brightness_temperature@"+hofxgrp, channels_)[ichan], values);
     for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-      innovation[ichan][iloc] = innovation[ichan][iloc] - values[iloc];
+      innovation[ichan][iloc] = innovation[ichan][iloc] - hofx[ichan][iloc];
     }
   }
 
   // Get original observation error (uninflated) from ObsSpaec
-  std::vector<std::vector<float>> obserr(nchans, std::vector<float>(nlocs));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature@ObsError", channels_)[ichan], obserr[ichan]);
-  }
+  std::vector<std::vector<float>> obserr;
+  in.getChannels(Variable("brightness_temperature@ObsError", channels_), obserr);
 
   // Get variables from GeoVaLS
   // Get tropopause pressure [Pa]
@@ -176,15 +175,9 @@ void CloudDetectMinResidualIR::compute(const ObsFilterData & in,
   std::vector<float> tsavg(nlocs);
   in.get(Variable("average_surface_temperature_within_field_of_view@GeoVaLs"), tsavg);
 
-  // Get area fraction of each surface type
-  std::vector<float> water_frac(nlocs);
-  std::vector<float> land_frac(nlocs);
-  std::vector<float> ice_frac(nlocs);
-  std::vector<float> snow_frac(nlocs);
-  in.get(Variable("water_area_fraction@GeoVaLs"), water_frac);
-  in.get(Variable("land_area_fraction@GeoVaLs"), land_frac);
-  in.get(Variable("ice_area_fraction@GeoVaLs"), ice_frac);
-  in.get(Variable("surface_snow_area_fraction@GeoVaLs"), snow_frac);
+  // Get dominant surface types in each FOV
+  std::vector<int> surfclass(nlocs);
+  in.get(SurfaceClassRad::variable(), surfclass);
 
   // Determine dominant surface type in each FOV
   std::vector<bool> land(nlocs, false);
@@ -193,11 +186,11 @@ void CloudDetectMinResidualIR::compute(const ObsFilterData & in,
   std::vector<bool> snow(nlocs, false);
   std::vector<bool> mixed(nlocs, false);
   for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    sea[iloc] = water_frac[iloc] >= 0.99;
-    land[iloc] = land_frac[iloc] >= 0.99;
-    ice[iloc] = ice_frac[iloc] >= 0.99;
-    snow[iloc] = snow_frac[iloc] >= 0.99;
-    mixed[iloc] = (!sea[iloc] && !land[iloc] && !ice[iloc] && !snow[iloc]);
+    sea[iloc] = surfclass[iloc] & SurfaceClassRadBits::sea;
+    land[iloc] = surfclass[iloc] & SurfaceClassRadBits::land;
+    ice[iloc] = surfclass[iloc] & SurfaceClassRadBits::ice;
+    snow[iloc] = surfclass[iloc] & SurfaceClassRadBits::snow;
+    mixed[iloc] = surfclass[iloc] & SurfaceClassRadBits::mixed;
   }
 
   // Setup weight given to each surface type
@@ -6,6 +6,7 @@
  */
 
 #include <string>
+#include <vector>
 
 #include "ioda/ObsDataVector.h"
 #include "oops/util/missingValues.h"
@@ -45,17 +46,29 @@ void Conditional<FunctionValue>::compute(const ObsFilterData & in,
   // Assign values based on the where clauses from the configuration.
   // if firstmatchingcase is true, the first case that is true assigns the value.
   // if firstmatchingcase is false, the last matching case will assign the value.
+  // The cases are visited in order in the first situation and in reverse order in the second, so
+  // that in both each location takes the value of the first matching case visited. Locations
+  // that have been assigned a value are not considered again, and the remaining cases are not
+  // evaluated at all once every location has been assigned a value.
+  const std::vector<LocalConditionalParameters<FunctionValue>> &cases = options_.cases.value();
+  const size_t ncases = cases.size();
+  // Values of the variables used in the where clauses, retrieved once for all cases.
+  WhereData whereData(in);
   std::vector<bool> applied(out.nlocs(), false);
-  for (const LocalConditionalParameters<FunctionValue> &lcp : options_.cases.value()) {
-    std::vector<bool> apply = processWhere(lcp.where, in, lcp.whereOperator);
+  size_t nunassigned = out.nlocs();
+  for (size_t icase = 0; icase < ncases && nunassigned > 0; ++icase) {
+    const LocalConditionalParameters<FunctionValue> &lcp =
+        cases[options_.firstmatchingcase.value() ? icase : ncases - 1 - icase];
+    const std::vector<bool> apply = processWhere(lcp.where, whereData, lcp.whereOperator);
     for (size_t iloc = 0; iloc < out.nlocs(); ++iloc) {
-      if (apply[iloc] && applied[iloc] == false) {
+      if (apply[iloc] && !applied[iloc]) {
         for (size_t ivar = 0; ivar < out.nvars(); ++ivar)
           out[ivar][iloc] = lcp.value.value();
-        if (options_.firstmatchingcase.value()) applied[iloc] = true;
+        applied[iloc] = true;
+        --nunassigned;
       }  // if apply
     }  // iloc
-  }  // lcp
+  }  // icase
 }  // compute
 
 // -----------------------------------------------------------------------------
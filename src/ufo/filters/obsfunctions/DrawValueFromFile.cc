@@ -197,7 +197,28 @@ void DrawValueFromFile<T>::compute(const ObsFilterData & in,
   // Finalise (apply) sort by calling with no arguments.
   interpolator.sort();
 
+  // Values of the coordinates at all locations, in the order in which they were passed to
+  // scheduleSort(). The channel number, if present, is filled in separately for each variable.
+  const bool haveChannels = options_.chlist.value() != boost::none;
+  std::vector<typename DataExtractor<T>::ObsValues> obValues;
+  if (haveChannels)
+    obValues.emplace_back(std::vector<int>());
+  for (const auto &varAndValues : obData)
+    obValues.push_back(varAndValues.second);
+
   for (size_t jvar = 0; jvar < out.nvars(); ++jvar) {
+    if (haveChannels)
+      obValues.front() = std::vector<int>(in.nlocs(), channels_[jvar]);
+    try {
+      const std::vector<T> values = interpolator.extractBatch(obValues, in.nlocs());
+      for (size_t iloc = 0; iloc < in.nlocs(); ++iloc)
+        out[jvar][iloc] = values[iloc];
+      continue;
+    } catch (const std::exception &) {
+      // Repeat the extraction location by location below to identify and report the location at
+      // which it fails.
+    }
+
     for (size_t iloc = 0; iloc < in.nlocs(); ++iloc) {
       try {
         if (options_.chlist.value() != boost::none)
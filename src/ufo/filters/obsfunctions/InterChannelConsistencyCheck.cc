@@ -73,12 +73,14 @@ void InterChannelConsistencyCheck::compute(const ObsFilterData & in,
   // Get effective observation error and qcflag from ObsSpace
   // Convert effective observation error to inverse of the error variance
   const float missing = util::missingValue(missing);
-  std::vector<int> qcflagdata(nlocs);
-  std::vector<float> obserrdata(nlocs);
+  std::vector<std::vector<int>> qcflagdataAll;
+  std::vector<std::vector<float>> obserrdataAll;
+  in.getChannels(Variable("brightness_temperature@"+errgrp, channels_), obserrdataAll);
+  in.getChannels(Variable("brightness_temperature@"+flaggrp, channels_), qcflagdataAll);
   std::vector<std::vector<float>> varinv(nchans, std::vector<float>(nlocs, 0.0));
   for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature@"+errgrp, channels_)[ichan], obserrdata);
-    in.get(Variable("brightness_temperature@"+flaggrp, channels_)[ichan], qcflagdata);
+    const std::vector<float> &obserrdata = obserrdataAll[ichan];
+    std::vector<int> &qcflagdata = qcflagdataAll[ichan];
     for (size_t iloc = 0; iloc < nlocs; ++iloc) {
       if (flaggrp == "PreQC") obserrdata[iloc] == missing ? qcflagdata[iloc] = 100
                                                            : qcflagdata[iloc] = 0;
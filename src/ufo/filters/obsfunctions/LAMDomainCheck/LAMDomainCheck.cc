@@ -100,21 +100,19 @@ void LAMDomainCheck::compute(const ObsFilterData & in,
     const float dy = options_.esg_dy.value();
     const int npx = options_.esg_npx.value();
     const int npy = options_.esg_npy.value();
-    for (size_t jj = 0; jj < nlocs; ++jj) {
-      lam_domaincheck_esg_f90(a, k, plat, plon, pazi, npx, npy,
-                         dx, dy, latitude[jj], longitude[jj], iidx[jj]);
-      out[0][jj] = static_cast<float>(iidx[jj]);
-    }
+    const int n = nlocs;
+    if (n > 0)
+      lam_domaincheck_esg_batch_f90(a, k, plat, plon, pazi, npx, npy,
+                                    dx, dy, n, latitude[0], longitude[0], iidx[0]);
   } else if (options_.mapproj.value() == "circle") {
     const float cenlat = options_.cenlat.value();
     const float cenlon = options_.cenlon.value();
     const float radius = options_.radius.value();
-    for (size_t jj = 0; jj < nlocs; ++jj) {
-      // calculate great-circle distance on sphere
-      lam_domaincheck_circle_f90(cenlat, cenlon, radius,
-                         latitude[jj], longitude[jj], iidx[jj]);
-      out[0][jj] = static_cast<float>(iidx[jj]);
-    }
+    const int n = nlocs;
+    // calculate great-circle distance on sphere
+    if (n > 0)
+      lam_domaincheck_circle_batch_f90(cenlat, cenlon, radius,
+                                       n, latitude[0], longitude[0], iidx[0]);
   } else {
     // throw exception for unsupported projection
     std::string errString = " is not a supported map projection. Fatal error!!!";
@@ -122,6 +120,10 @@ void LAMDomainCheck::compute(const ObsFilterData & in,
     throw eckit::BadValue(errString);
   }
 
+  for (size_t jj = 0; jj < nlocs; ++jj) {
+    out[0][jj] = static_cast<float>(iidx[jj]);
+  }
+
   if (options_.save) {
     out.save("DerivedValue");
   }
@@ -25,6 +25,16 @@ extern "C" {
   void lam_domaincheck_circle_f90(const float &, const float &, const float &,
                                   const float &, const float &, int &);
 
+// batched versions checking nlocs locations in one call
+
+  void lam_domaincheck_esg_batch_f90(const float &, const float &, const float &, const float &,
+                                     const float &, const int &, const int &,
+                                     const float &, const float &, const int &,
+                                     const float &, const float &, int &);
+
+  void lam_domaincheck_circle_batch_f90(const float &, const float &, const float &,
+                                        const int &, const float &, const float &, int &);
+
 }  // extern C
 
 }  // namespace ufo
@@ -12,6 +12,7 @@
 #include "oops/util/missingValues.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/obsfunctions/ModelHeightAdjustedAirTemperature.h"
+#include "ufo/filters/obsfunctions/ModelHeightDifference.h"
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/Constants.h"
 
@@ -23,16 +24,13 @@ static ObsFunctionMaker<ModelHeightAdjustedAirTemperature>
 // -----------------------------------------------------------------------------
 
 ModelHeightAdjustedAirTemperature::ModelHeightAdjustedAirTemperature(
-        const eckit::LocalConfiguration & conf): invars_() {
+        const eckit::LocalConfiguration & conf)
+  : invars_(), heightDifference_(ModelHeightDifference::variable(conf)) {
+  parameters_.validateAndDeserialize(conf);
   // Required observation data
   invars_ += Variable("airTemperatureAt2M@ObsValue");
-  // Required model surface altitude
-  invars_ += Variable("surface_altitude@GeoVaLs");
-
-  // Required observation station height
-  parameters_.validateAndDeserialize(conf);
-  const Variable elevation = parameters_.elevation.value();
-  invars_ += elevation;
+  // Required height of the station above the model surface
+  invars_ += heightDifference_;
 }
 
 // -----------------------------------------------------------------------------
@@ -41,22 +39,17 @@ void ModelHeightAdjustedAirTemperature::compute(const ObsFilterData & in,
                                 ioda::ObsDataVector<float> & out) const {
   const size_t nlocs = in.nlocs();
   std::vector<float> t2(nlocs);
-  std::vector<float> ModelHeight(nlocs);
-  std::vector<float> StationHeight(nlocs);
+  std::vector<float> HeightDiff(nlocs);
 
   in.get(Variable("airTemperatureAt2M@ObsValue"), t2);
-  in.get(Variable("surface_altitude@GeoVaLs"), ModelHeight);
-  in.get(parameters_.elevation.value(), StationHeight);
+  in.get(heightDifference_, HeightDiff);
 
   const float missing = util::missingValue(missing);
 
   // compute temperature correction and adjusted temperature.
   for (size_t jj = 0; jj < nlocs; ++jj) {
-    if (StationHeight[jj] == missing || ModelHeight[jj] == missing || t2[jj] == missing) {
-      out[0][jj] = missing;
-    } else {
-      out[0][jj] = t2[jj] + Constants::Lclr*(StationHeight[jj] - ModelHeight[jj]);
-    }
+    const bool valid = HeightDiff[jj] != missing && t2[jj] != missing;
+    out[0][jj] = valid ? t2[jj] + Constants::Lclr*HeightDiff[jj] : missing;
   }
 }
 
@@ -12,6 +12,7 @@
 #include <string>
 
 #include "ufo/filters/obsfunctions/ObsFunctionBase.h"
+#include "ufo/filters/Variable.h"
 #include "ufo/filters/Variables.h"
 
 #include "oops/util/parameters/Parameters.h"
@@ -46,6 +47,8 @@ class ModelHeightAdjustedAirTemperature : public ObsFunctionBase<float> {
  private:
     ModelHeightAdjustedAirTemperatureParameters parameters_;
     ufo::Variables invars_;
+    /// ModelHeightDifference ObsFunction giving the height of the station above the model surface
+    ufo::Variable heightDifference_;
 };
 }  // namespace ufo
 
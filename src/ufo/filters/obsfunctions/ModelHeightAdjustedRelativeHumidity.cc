@@ -13,6 +13,7 @@
 #include "oops/util/missingValues.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/obsfunctions/ModelHeightAdjustedRelativeHumidity.h"
+#include "ufo/filters/obsfunctions/ModelHeightDifference.h"
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/Constants.h"
 
@@ -24,18 +25,15 @@ static ObsFunctionMaker<ModelHeightAdjustedRelativeHumidity>
 // -----------------------------------------------------------------------------
 
 ModelHeightAdjustedRelativeHumidity::ModelHeightAdjustedRelativeHumidity(
-        const eckit::LocalConfiguration & conf): invars_() {
-  // Retrieve observation data  // Required observation data
-  invars_ += Variable("relativeHumidityAt2M@ObsValue");
-  // Required model surface altitude
-  invars_ += Variable("surface_altitude@GeoVaLs");
-
-  // Required observation station height and temperature
+        const eckit::LocalConfiguration & conf)
+  : invars_(), heightDifference_(ModelHeightDifference::variable(conf)) {
   parameters_.validateAndDeserialize(conf);
-  const Variable elevation = parameters_.elevation.value();
-  const Variable temperature = parameters_.temperature.value();
-  invars_ += elevation;
-  invars_ += temperature;
+  // Required observation data
+  invars_ += Variable("relativeHumidityAt2M@ObsValue");
+  // Required height of the station above the model surface
+  invars_ += heightDifference_;
+  // Required temperature
+  invars_ += parameters_.temperature.value();
 }
 
 // -----------------------------------------------------------------------------
@@ -45,13 +43,11 @@ void ModelHeightAdjustedRelativeHumidity::compute(const ObsFilterData & in,
   const size_t nlocs = in.nlocs();
   std::vector<float> rh(nlocs);
   std::vector<float> T(nlocs);
-  std::vector<float> ModelHeight(nlocs);
-  std::vector<float> StationHeight(nlocs);
+  std::vector<float> HeightDiff(nlocs);
 
   in.get(Variable("relativeHumidityAt2M@ObsValue"), rh);
   in.get(parameters_.temperature.value(), T);
-  in.get(Variable("surface_altitude@GeoVaLs"), ModelHeight);
-  in.get(parameters_.elevation.value(), StationHeight);
+  in.get(heightDifference_, HeightDiff);
 
   const float missing = util::missingValue(missing);
 
@@ -66,12 +62,12 @@ void ModelHeightAdjustedRelativeHumidity::compute(const ObsFilterData & in,
 
   // compute relative humidity correction and adjusted relative humidity.
   for (size_t jj = 0; jj < nlocs; ++jj) {
-    if (StationHeight[jj] == missing || ModelHeight[jj] == missing || rh[jj] == missing) {
+    if (HeightDiff[jj] == missing || rh[jj] == missing) {
       out[0][jj] = missing;
     } else {
       int Tbin = std::ceil(Constants::t0c - T[jj]);
       Tbin = std::max(0, std::min(40, Tbin));
-      float CorrectedRH = std::max(rh[jj] - 0.01*(StationHeight[jj] - ModelHeight[jj]), 0.0);
+      float CorrectedRH = std::max(rh[jj] - 0.01*HeightDiff[jj], 0.0);
       CorrectedRH = std::min(CorrectedRH, rhmax[Tbin]);
       out[0][jj] = CorrectedRH;
     }
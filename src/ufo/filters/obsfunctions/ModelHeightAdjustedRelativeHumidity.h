@@ -10,6 +10,7 @@
 #define UFO_FILTERS_OBSFUNCTIONS_MODELHEIGHTADJUSTEDRELATIVEHUMIDITY_H_
 
 #include "ufo/filters/obsfunctions/ObsFunctionBase.h"
+#include "ufo/filters/Variable.h"
 #include "ufo/filters/Variables.h"
 
 #include "oops/util/parameters/Parameters.h"
@@ -48,6 +49,8 @@ class ModelHeightAdjustedRelativeHumidity : public ObsFunctionBase<float> {
  private:
     ModelHeightAdjustedRelativeHumidityParameters parameters_;
     ufo::Variables invars_;
+    /// ModelHeightDifference ObsFunction giving the height of the station above the model surface
+    ufo::Variable heightDifference_;
 };
 }  // namespace ufo
 
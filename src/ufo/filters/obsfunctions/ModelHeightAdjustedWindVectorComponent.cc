@@ -13,6 +13,7 @@
 #include "oops/util/missingValues.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/obsfunctions/ModelHeightAdjustedWindVectorComponent.h"
+#include "ufo/filters/obsfunctions/ModelHeightDifference.h"
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/Constants.h"
 
@@ -28,7 +29,9 @@ static ObsFunctionMaker<ModelHeightAdjustedWindVectorComponent<true>>
 // -----------------------------------------------------------------------------
 template <bool northwardWind>
 ModelHeightAdjustedWindVectorComponent<northwardWind>::ModelHeightAdjustedWindVectorComponent(
-        const eckit::LocalConfiguration & conf): invars_() {
+        const eckit::LocalConfiguration & conf)
+  : invars_(), heightDifference_(ModelHeightDifference::variable(conf)) {
+  parameters_.validateAndDeserialize(conf);
   // Required observation data
   if (northwardWind) {
     invars_ += Variable("windNorthwardAt10M@ObsValue");
@@ -36,13 +39,8 @@ ModelHeightAdjustedWindVectorComponent<northwardWind>::ModelHeightAdjustedWindVe
     invars_ += Variable("windEastwardAt10M@ObsValue");
   }
 
-  // Required model surface altitude
-  invars_ += Variable("surface_altitude@GeoVaLs");
-
-  // Required observation station height
-  parameters_.validateAndDeserialize(conf);
-  const Variable elevation = parameters_.elevation.value();
-  invars_ += elevation;
+  // Required height of the station above the model surface
+  invars_ += heightDifference_;
 }
 
 // -----------------------------------------------------------------------------
@@ -52,34 +50,27 @@ void ModelHeightAdjustedWindVectorComponent<northwardWind>::compute(const ObsFil
                                 ioda::ObsDataVector<float> & out) const {
   const size_t nlocs = in.nlocs();
   std::vector<float> WindComponent(nlocs);
-  std::vector<float> ModelHeight(nlocs);
-  std::vector<float> StationHeight(nlocs);
+  std::vector<float> HeightDiff(nlocs);
 
   if (northwardWind) {
     in.get(Variable("windNorthwardAt10M@ObsValue"), WindComponent);
   } else {
     in.get(Variable("windEastwardAt10M@ObsValue"), WindComponent);
   }
-  in.get(Variable("surface_altitude@GeoVaLs"), ModelHeight);
-  in.get(parameters_.elevation.value(), StationHeight);
+  in.get(heightDifference_, HeightDiff);
 
   const float missing = util::missingValue(missing);
 
   // compute wind correction and adjusted winds.
   for (size_t jj = 0; jj < nlocs; ++jj) {
-    if (StationHeight[jj] == missing || ModelHeight[jj] == missing
-            || WindComponent[jj] == missing) {
+    if (HeightDiff[jj] == missing || WindComponent[jj] == missing) {
       out[0][jj] = missing;
+    } else if (HeightDiff[jj] > 100.0) {
+      float ScaleFactor;
+      ScaleFactor = 1.0/(1.0 + std::min(2.0, (HeightDiff[jj] - 100.0) * 0.002));
+      out[0][jj] = WindComponent[jj]*ScaleFactor;
     } else {
-      float HeightDiff;
-      HeightDiff = StationHeight[jj] - ModelHeight[jj];
-      if (HeightDiff > 100.0) {
-        float ScaleFactor;
-        ScaleFactor = 1.0/(1.0 + std::min(2.0, (HeightDiff - 100.0) * 0.002));
-        out[0][jj] = WindComponent[jj]*ScaleFactor;
-      } else {
-        out[0][jj] = WindComponent[jj];
-      }
+      out[0][jj] = WindComponent[jj];
     }
   }
 }
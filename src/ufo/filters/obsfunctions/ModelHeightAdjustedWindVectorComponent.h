@@ -13,6 +13,7 @@
 #include <string>
 
 #include "ufo/filters/obsfunctions/ObsFunctionBase.h"
+#include "ufo/filters/Variable.h"
 #include "ufo/filters/Variables.h"
 
 #include "oops/util/parameters/Parameters.h"
@@ -52,6 +53,8 @@ class ModelHeightAdjustedWindVectorComponent : public ObsFunctionBase<float> {
  private:
     ModelHeightAdjustedWindVectorParameters parameters_;
     ufo::Variables invars_;
+    /// ModelHeightDifference ObsFunction giving the height of the station above the model surface
+    ufo::Variable heightDifference_;
 };
 }  // namespace ufo
 
@@ -0,0 +1,71 @@
+/* -----------------------------------------------------------------------------
+ * (C) British Crown Copyright 2021 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * -----------------------------------------------------------------------------
+ */
+
+#include <vector>
+
+#include "ioda/ObsDataVector.h"
+#include "oops/util/missingValues.h"
+#include "ufo/filters/ObsFilterData.h"
+#include "ufo/filters/obsfunctions/ModelHeightDifference.h"
+#include "ufo/filters/Variable.h"
+
+namespace ufo {
+
+static ObsFunctionMaker<ModelHeightDifference>
+        makerModelHeightDifference_("ModelHeightDifference");
+
+// -----------------------------------------------------------------------------
+
+ModelHeightDifference::ModelHeightDifference(const eckit::LocalConfiguration & conf)
+  : invars_() {
+  // Required model surface altitude
+  invars_ += Variable("surface_altitude@GeoVaLs");
+
+  // Required observation station height
+  parameters_.validateAndDeserialize(conf);
+  invars_ += parameters_.elevation.value();
+}
+
+// -----------------------------------------------------------------------------
+
+void ModelHeightDifference::compute(const ObsFilterData & in,
+                                    ioda::ObsDataVector<float> & out) const {
+  const size_t nlocs = in.nlocs();
+  std::vector<float> ModelHeight(nlocs);
+  std::vector<float> StationHeight(nlocs);
+
+  in.get(Variable("surface_altitude@GeoVaLs"), ModelHeight);
+  in.get(parameters_.elevation.value(), StationHeight);
+
+  const float missing = util::missingValue(missing);
+
+  for (size_t jj = 0; jj < nlocs; ++jj) {
+    const bool valid = StationHeight[jj] != missing && ModelHeight[jj] != missing;
+    out[0][jj] = valid ? StationHeight[jj] - ModelHeight[jj] : missing;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+const ufo::Variables & ModelHeightDifference::requiredVariables() const {
+  return invars_;
+}
+
+// -----------------------------------------------------------------------------
+
+Variable ModelHeightDifference::variable(const eckit::LocalConfiguration & conf) {
+  // Pass on only the options the height difference depends on, so that all ModelHeightAdjusted*
+  // functions using the same station height share a single cached evaluation.
+  eckit::LocalConfiguration options;
+  options.set("elevation", conf.getSubConfiguration("elevation"));
+  return Variable("ModelHeightDifference@ObsFunction", options);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,57 @@
+/* -----------------------------------------------------------------------------
+ * (C) British Crown Copyright 2021 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef UFO_FILTERS_OBSFUNCTIONS_MODELHEIGHTDIFFERENCE_H_
+#define UFO_FILTERS_OBSFUNCTIONS_MODELHEIGHTDIFFERENCE_H_
+
+#include "ufo/filters/obsfunctions/ObsFunctionBase.h"
+#include "ufo/filters/Variable.h"
+#include "ufo/filters/Variables.h"
+
+#include "oops/util/parameters/Parameters.h"
+#include "oops/util/parameters/RequiredParameter.h"
+#include "ufo/utils/parameters/ParameterTraitsVariable.h"
+
+namespace ufo {
+
+/// \brief Options controlling ModelHeightDifference ObsFunction
+class ModelHeightDifferenceParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(ModelHeightDifferenceParameters, Parameters)
+
+ public:
+  /// Input observation station height to be used
+  oops::RequiredParameter<Variable> elevation{"elevation", this};
+};
+
+/// \brief Function returning the height of the observing station above the model surface
+/// (station height minus surface_altitude@GeoVaLs), or the missing value if either height is
+/// missing.
+///
+/// This is the geometry shared by the ModelHeightAdjusted* ObsFunctions. They retrieve it through
+/// ObsFilterData, so if ObsFunction values are cached (`cache obs functions: true`) it is computed
+/// only once per ObsSpace and filter stage.
+class ModelHeightDifference : public ObsFunctionBase<float> {
+ public:
+    explicit ModelHeightDifference(const eckit::LocalConfiguration &
+                                   = eckit::LocalConfiguration());
+
+    void compute(const ObsFilterData &,
+                       ioda::ObsDataVector<float> &) const;
+    const ufo::Variables & requiredVariables() const;
+
+    /// \brief Return the ModelHeightDifference ObsFunction using the "elevation" option of
+    /// \p conf (the options of a ModelHeightAdjusted* ObsFunction).
+    static Variable variable(const eckit::LocalConfiguration & conf);
+
+ private:
+    ModelHeightDifferenceParameters parameters_;
+    ufo::Variables invars_;
+};
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_OBSFUNCTIONS_MODELHEIGHTDIFFERENCE_H_
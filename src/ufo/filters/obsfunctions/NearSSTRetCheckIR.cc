@@ -14,6 +14,7 @@
 #include <iostream>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ioda/ObsDataVector.h"
@@ -83,37 +84,34 @@ void NearSSTRetCheckIR::compute(const ObsFilterData & in,
   const std::string &errgrp = options_.testObserr.value();
   const std::string &hofxgrp = options_.testHofX.value();
 
-  // Setup vectors to get 2D variables
-  std::vector<float> values(nlocs);
-
   // Get variables from ObsDiag
   // Get surface temperature jacobian
-  std::vector<std::vector<float>> dbtdts(nchans, std::vector<float>(nlocs));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature_jacobian_surface_temperature@ObsDiag",
-                     channels_)[ichan], dbtdts[ichan]);
-  }
+  std::vector<std::vector<float>> dbtdts;
+  in.getChannels(Variable("brightness_temperature_jacobian_surface_temperature@ObsDiag",
+                          channels_), dbtdts);
 
   // Get temperature jacobian
   std::vector<std::vector<std::vector<float>>>
-       dbtdt(nchans, std::vector<std::vector<float>>(nlevs, std::vector<float>(nlocs)));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    for (size_t ilev = 0; ilev < nlevs; ++ilev) {
-      const int level = nlevs - ilev - 1;
-      in.get(Variable("brightness_temperature_jacobian_air_temperature@ObsDiag",
-                       channels_)[ichan], level, dbtdt[ichan][ilev]);
-    }
+       dbtdt(nchans, std::vector<std::vector<float>>(nlevs));
+  std::vector<std::vector<float>> dbtdtAtLevel;
+  for (size_t ilev = 0; ilev < nlevs; ++ilev) {
+    const int level = nlevs - ilev - 1;
+    in.getChannels(Variable("brightness_temperature_jacobian_air_temperature@ObsDiag", channels_),
+                   level, dbtdtAtLevel);
+    for (size_t ichan = 0; ichan < nchans; ++ichan)
+      dbtdt[ichan][ilev] = std::move(dbtdtAtLevel[ichan]);
   }
 
   // Get moisture jacobian
   std::vector<std::vector<std::vector<float>>>
-       dbtdq(nchans, std::vector<std::vector<float>>(nlevs, std::vector<float>(nlocs)));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    for (size_t ilev = 0; ilev < nlevs; ++ilev) {
-      const int level = nlevs - ilev - 1;
-      in.get(Variable("brightness_temperature_jacobian_humidity_mixing_ratio@ObsDiag",
-                       channels_)[ichan], level, dbtdq[ichan][ilev]);
-    }
+       dbtdq(nchans, std::vector<std::vector<float>>(nlevs));
+  std::vector<std::vector<float>> dbtdqAtLevel;
+  for (size_t ilev = 0; ilev < nlevs; ++ilev) {
+    const int level = nlevs - ilev - 1;
+    in.getChannels(Variable("brightness_temperature_jacobian_humidity_mixing_ratio@ObsDiag",
+                            channels_), level, dbtdqAtLevel);
+    for (size_t ichan = 0; ichan < nchans; ++ichan)
+      dbtdq[ichan][ilev] = std::move(dbtdqAtLevel[ichan]);
   }
 
   // Get variables from ObsSpace
@@ -123,11 +121,14 @@ void NearSSTRetCheckIR::compute(const ObsFilterData & in,
 
   // Get effective observation error and convert it to inverse of the error variance
   const float missing = util::missingValue(missing);
-  std::vector<int> qcflag(nlocs, 0);
   std::vector<std::vector<float>> varinv(nchans, std::vector<float>(nlocs));
+  std::vector<std::vector<float>> obserrdata;
+  std::vector<std::vector<int>> qcflagdata;
+  in.getChannels(Variable("brightness_temperature@"+errgrp, channels_), obserrdata);
+  in.getChannels(Variable("brightness_temperature@"+flaggrp, channels_), qcflagdata);
   for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature@"+errgrp, channels_)[ichan], values);
-    in.get(Variable("brightness_temperature@"+flaggrp, channels_)[ichan], qcflag);
+    std::vector<float> &values = obserrdata[ichan];
+    std::vector<int> &qcflag = qcflagdata[ichan];
     for (size_t iloc = 0; iloc < nlocs; ++iloc) {
       if (flaggrp == "PreQC") values[iloc] == missing ? qcflag[iloc] = 100 : qcflag[iloc] = 0;
       (qcflag[iloc] == 0) ? (varinv[ichan][iloc] = 1.0 / pow(values[iloc], 2))
@@ -136,20 +137,18 @@ void NearSSTRetCheckIR::compute(const ObsFilterData & in,
   }
 
   // Get bias corrected innovation (tbobs - hofx) (hofx includes bias correction)
-  std::vector<std::vector<float>> innovation(nchans, std::vector<float>(nlocs));
+  std::vector<std::vector<float>> innovation, hofx;
+  in.getChannels(Variable("brightness_temperature@ObsValue", channels_), innovation);
+  in.getChannels(Variable("brightness_temperature@"+hofxgrp, channels_), hofx);
   for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature@ObsValue", channels_)[ichan], innovation[ichan]);
-    in.get(Variable("brightness_temperature@"+hofxgrp, channels_)[ichan], values);
     for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-      innovation[ichan][iloc] = innovation[ichan][iloc] - values[iloc];
+      innovation[ichan][iloc] = innovation[ichan][iloc] - hofx[ichan][iloc];
     }
   }
 
   // Get original observation error (uninflated)
-  std::vector<std::vector<float>> obserr(nchans, std::vector<float>(nlocs));
-  for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature@ObsError", channels_)[ichan], obserr[ichan]);
-  }
+  std::vector<std::vector<float>> obserr;
+  in.getChannels(Variable("brightness_temperature@ObsError", channels_), obserr);
 
   // Get variables from GeoVaLS
   // Get solar zenith angle
@@ -78,17 +78,20 @@ void ObsErrorBoundIR::compute(const ObsFilterData & in,
   in.get(obserrtaotop, errftaotop);
 
   // Output integrated error bound for gross check
-  std::vector<float> obserr(nlocs);      //!< original obs error
-  std::vector<float> obserrdata(nlocs);  //!< effective obs err
-  std::vector<int> qcflagdata(nlocs);    //!< effective qcflag
   const std::string &errgrp = options_.testObserr.value();
   const std::string &flaggrp = options_.testQCflag.value();
+  std::vector<std::vector<float>> obserrAll;      //!< original obs error
+  std::vector<std::vector<float>> obserrdataAll;  //!< effective obs err
+  std::vector<std::vector<int>> qcflagdataAll;    //!< effective qcflag
+  in.getChannels(Variable("brightness_temperature@"+flaggrp, channels_), qcflagdataAll);
+  in.getChannels(Variable("brightness_temperature@"+errgrp, channels_), obserrdataAll);
+  in.getChannels(Variable("brightness_temperature@ObsError", channels_), obserrAll);
   const float missing = util::missingValue(missing);
   float varinv = 0.0;
   for (size_t ichan = 0; ichan < nchans; ++ichan) {
-    in.get(Variable("brightness_temperature@"+flaggrp, channels_)[ichan], qcflagdata);
-    in.get(Variable("brightness_temperature@"+errgrp, channels_)[ichan], obserrdata);
-    in.get(Variable("brightness_temperature@ObsError", channels_)[ichan], obserr);
+    const std::vector<float> &obserr = obserrAll[ichan];
+    const std::vector<float> &obserrdata = obserrdataAll[ichan];
+    std::vector<int> &qcflagdata = qcflagdataAll[ichan];
     for (size_t iloc = 0; iloc < nlocs; ++iloc) {
       if (flaggrp == "PreQC") obserrdata[iloc] == missing ? qcflagdata[iloc] = 100
                                                            : qcflagdata[iloc] = 0;
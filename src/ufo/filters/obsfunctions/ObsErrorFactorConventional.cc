@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <set>
 #include <string>
 #include <vector>
@@ -122,8 +123,67 @@ void ObsErrorFactorConventional::compute(const ObsFilterData & data,
 
   // Get GeoVaLs of air pressure [Pa] in vertical column
   std::vector<std::vector<float>> prsl(nlevs, std::vector<float>(nlocs));
+  const Variable modelPressure("GeoVaLs/air_pressure");
   for (size_t geolev = 0; geolev < nlevs; ++geolev) {
-    data.get(Variable("GeoVaLs/air_pressure"), geolev, prsl[geolev]);
+    data.get(modelPressure, geolev, prsl[geolev]);
+  }
+
+  // Collect the observations of each record (profile), using the obs grouping/sorting indices.
+  std::vector<std::vector<std::size_t>> records;
+  size_t pointCount = 0;
+  for (ioda::ObsSpace::RecIdxIter irec = obsdb.recidx_begin(); irec != obsdb.recidx_end();
+       ++irec) {
+    records.push_back(obsdb.recidx_vector(irec));
+    pointCount += records.back().size();
+  }
+  if (pointCount != nlocs) {
+    std::string errString = "The data should be sorted or total number of observations "
+                            "after sorting is not consistent with nlocs: ";
+    oops::Log::error() << errString << pointCount << ", "<< nlocs << std::endl;
+    throw eckit::BadValue(errString);
+  }
+
+  // vmag: observations within a pressure interval <= vmag will be inflated. It depends only on
+  // the observed and model pressures, so it is shared by all variables.
+  std::vector<float> vmag(nlocs);
+  // Set for records in which observed pressures are monotonic. In these records, the search for
+  // neighbouring observations can stop as soon as the pressure difference reaches vmag.
+  std::vector<bool> isMonotonic(records.size());
+  // Note: if an observation lies below model level 1, thislev is carried over from the
+  // previous observation, as in GSI.
+  int thislev = 0;
+  for (size_t irec = 0; irec < records.size(); ++irec) {
+    const std::vector<std::size_t> &rSort = records[irec];
+    bool isIncreasing = true, isDecreasing = true;
+    for (size_t thisPoint = 0; thisPoint < rSort.size(); ++thisPoint) {
+      const size_t iloc = rSort[thisPoint];
+      if (thisPoint > 0) {
+        isIncreasing = isIncreasing && ob_pressure[iloc] >= ob_pressure[rSort[thisPoint - 1]];
+        isDecreasing = isDecreasing && ob_pressure[iloc] <= ob_pressure[rSort[thisPoint - 1]];
+      }
+
+      for (size_t geolev = 1; geolev < nlevs-1; ++geolev) {
+        if (ob_pressure[iloc] < prsl[geolev][iloc]) {
+          thislev = geolev;
+        }
+      }
+      // Background pressure level interval [cb]
+      const float dprsl = (prsl[thislev][iloc]-prsl[thislev+1][iloc])*0.001f;
+
+      // pre1: half of the vertical pressure inverval
+      // pre2: 2% of the value of pressure
+      // conpre: the pressure interval (delt_p) for a height inverval (delt_h)=500m
+      //         delt_p=rho*g*h=(p/rT)*g*delt_h where delt_h=500m, T=273.K
+      // vmag: = pre1 or pre2, whichever is bigger, if not go beyond 500m in terms
+      //         of layer depth in meter, or
+      //       = the pressure interval with 500m in depth assuming T=273K
+      const float pre1 = 0.5f*dprsl;
+      const float pre2 = 0.02f*0.001f*prsl[thislev][iloc];
+      const float maxpre = std::max(pre1, pre2);
+      const float conpre = con_g_rd*0.001f*ob_pressure[iloc];
+      vmag[iloc] = std::min(maxpre, conpre);
+    }
+    isMonotonic[irec] = isIncreasing || isDecreasing;
   }
 
   for (size_t ivar = 0; ivar < varsize; ++ivar) {   // Variable loop
@@ -138,130 +198,77 @@ void ObsErrorFactorConventional::compute(const ObsFilterData & data,
           ob_QCflag[iloc] = 0 : ob_QCflag[iloc] = 100;
     }
 
-    // Define variables to be used
-    std::vector<float> dprsl(nlevs-1);
-    float error_factor;
-    float pre1, pre2, maxpre, conpre, vmag, pdiffu, pdiffd, pdifftotal, tmp;
-    float dist_x, dist_y, dist_z, dist, dist_chord, central_angle;
-    float rlat_this, rlon_this, rlat_next, rlon_next;
-    int nextPoint;
     int passCount = 0;
-    int pointCount = 0;
-    int profCount = 0;
-    int thislev = 0;
+    std::vector<float> &error_factor = obserr[ivar];
 
-    ioda::ObsSpace::RecIdxIter irec;   // Using obs grouping/sorting indices
-    // record (profile) loop
-    for ( irec = obsdb.recidx_begin(); irec != obsdb.recidx_end(); ++irec ) {
-      std:: size_t rNum = obsdb.recidx_recnum(irec);
-      std::vector<std::size_t> rSort = obsdb.recidx_vector(irec);
-
-      profCount++;
+    // Records are independent of each other, so they are processed concurrently.
+    #pragma omp parallel for schedule(dynamic) reduction(+:passCount)
+    for (size_t irec = 0; irec < records.size(); ++irec) {   // record (profile) loop
+      const std::vector<std::size_t> &rSort = records[irec];
+      const std::ptrdiff_t npoints = rSort.size();
 
       // loop over the vertical obs profile
-      for (size_t thisPoint = 0; thisPoint < rSort.size(); ++thisPoint) {
-        pointCount++;
-
-        for (size_t geolev = 0; geolev < nlevs-1; ++geolev) {
-          // Background pressure level intervals [cb]
-          dprsl[geolev] = (prsl[geolev][rSort[thisPoint]]-prsl[geolev+1][rSort[thisPoint]])*0.001f;
-        }
-
-        for (size_t geolev = 1; geolev < nlevs-1; ++geolev) {
-          if (ob_pressure[rSort[thisPoint]] < prsl[geolev][rSort[thisPoint]]) {
-            thislev = geolev;
-          }
-        }
+      for (std::ptrdiff_t thisPoint = 0; thisPoint < npoints; ++thisPoint) {
+        const size_t iloc = rSort[thisPoint];
+        const float vmagThis = vmag[iloc];
+        float rlat_this = 0.0f, rlon_this = 0.0f;
         if (distthres > 0.) {
-          rlat_this = ob_lat[rSort[thisPoint]]*Constants::deg2rad;
-          rlon_this = ob_lon[rSort[thisPoint]]*Constants::deg2rad;
+          rlat_this = ob_lat[iloc]*Constants::deg2rad;
+          rlon_this = ob_lon[iloc]*Constants::deg2rad;
         }
 
-        // pre1: half of the vertical pressure inverval
-        // pre2: 2% of the value of pressure
-        // conpre: the pressure interval (delt_p) for a height inverval (delt_h)=500m
-        //         delt_p=rho*g*h=(p/rT)*g*delt_h where delt_h=500m, T=273.K
-        // vmag: observations within a pressure interval <= vmag will be inflated.
-        //       = pre1 or pre2, whichever is bigger, if not go beyond 500m in terms
-        //         of layer depth in meter, or
-        //       = the pressure interval with 500m in depth assuming T=273K
-        pre1 = 0.5f*dprsl[thislev];
-        pre2 = 0.02f*0.001f*prsl[thislev][rSort[thisPoint]];
-        maxpre = std::max(pre1, pre2);
-        conpre = con_g_rd*0.001f*ob_pressure[rSort[thisPoint]];
-        vmag = std::min(maxpre, conpre);
-
-        pdiffu = vmag;
-        pdiffd = vmag;
-
-        if (ob_QCflag[rSort[thisPoint]] == 0) {
-          passCount++;
-          // Search obs from upper levels. If there are multiple observations
-          // inside the same model interval, use the topmost one to compute
-          // the pressure interval, pdiffu
-          nextPoint = thisPoint+1;
-          while (nextPoint < rSort.size()) {
-            tmp = abs(ob_pressure[rSort[thisPoint]]-ob_pressure[rSort[nextPoint]])*0.001f;
-            if (ob_QCflag[rSort[nextPoint]] == 0 && tmp < vmag) {
-              pdiffu = tmp;
+        // Return the pressure interval between the current observation and the nearest
+        // observation passing QC found by stepping through the profile in direction `step`,
+        // or vmag if there is none within vmag (or it is too far away horizontally).
+        auto pressureIntervalToNeighbour = [&](std::ptrdiff_t step) {
+          for (std::ptrdiff_t nextPoint = thisPoint + step;
+               nextPoint >= 0 && nextPoint < npoints; nextPoint += step) {
+            const size_t inext = rSort[nextPoint];
+            const float tmp = abs(ob_pressure[iloc]-ob_pressure[inext])*0.001f;
+            if (ob_QCflag[inext] == 0 && tmp < vmagThis) {
               if (distthres > 0.0f) {
-                rlat_next = ob_lat[rSort[nextPoint]]*Constants::deg2rad;
-                rlon_next = ob_lon[rSort[nextPoint]]*Constants::deg2rad;
-                dist_x = cos(rlat_this)*cos(rlon_this)-cos(rlat_next)*cos(rlon_next);
-                dist_y = cos(rlat_this)*sin(rlon_this)-cos(rlat_next)*sin(rlon_next);
-                dist_z = sin(rlat_this)-sin(rlat_next);
-                dist = std::min(1.0f, sqrt(dist_x*dist_x+dist_y*dist_y+dist_z*dist_z));
-                central_angle = 2.0f*asin(dist/2.0f);
-                dist_chord = rearth_equator*central_angle;
-                if (dist_chord > distthres) pdiffu = vmag;
+                const float rlat_next = ob_lat[inext]*Constants::deg2rad;
+                const float rlon_next = ob_lon[inext]*Constants::deg2rad;
+                const float dist_x = cos(rlat_this)*cos(rlon_this)-cos(rlat_next)*cos(rlon_next);
+                const float dist_y = cos(rlat_this)*sin(rlon_this)-cos(rlat_next)*sin(rlon_next);
+                const float dist_z = sin(rlat_this)-sin(rlat_next);
+                const float dist = std::min(1.0f, sqrt(dist_x*dist_x+dist_y*dist_y+dist_z*dist_z));
+                const float central_angle = 2.0f*asin(dist/2.0f);
+                const float dist_chord = rearth_equator*central_angle;
+                if (dist_chord > distthres) return vmagThis;
               }
-              break;
+              return tmp;
             }
-            nextPoint++;
+            if (isMonotonic[irec] && tmp >= vmagThis)
+              break;  // all remaining observations lie even further away
           }
+          return vmagThis;
+        };
 
+        float pdiffu = vmagThis;
+        float pdiffd = vmagThis;
+        if (ob_QCflag[iloc] == 0) {
+          passCount++;
+          // Search obs from upper levels. If there are multiple observations
+          // inside the same model interval, use the topmost one to compute
+          // the pressure interval, pdiffu
+          pdiffu = pressureIntervalToNeighbour(1);
           // Search obs from lower levels. If there are multiple observations
           // inside the same model interval, use the lowest one to compute
           // the pressure interval, pdiffd
-          nextPoint = thisPoint-1;
-          while (nextPoint >= 0) {
-            tmp = abs(ob_pressure[rSort[nextPoint]]-ob_pressure[rSort[thisPoint]])*0.001f;
-            if (ob_QCflag[rSort[nextPoint]] == 0 && tmp < vmag) {
-              pdiffd = tmp;
-              if (distthres > 0.0f) {
-                rlat_next = ob_lat[rSort[nextPoint]]*Constants::deg2rad;
-                rlon_next = ob_lon[rSort[nextPoint]]*Constants::deg2rad;
-                dist_x = cos(rlat_this)*cos(rlon_this)-cos(rlat_next)*cos(rlon_next);
-                dist_y = cos(rlat_this)*sin(rlon_this)-cos(rlat_next)*sin(rlon_next);
-                dist_z = sin(rlat_this)-sin(rlat_next);
-                dist = std::min(1.0f, sqrt(dist_x*dist_x+dist_y*dist_y+dist_z*dist_z));
-                central_angle = 2.0f*asin(dist/2.0f);
-                dist_chord = rearth_equator*central_angle;
-                if (dist_chord > distthres) pdiffd = vmag;
-              }
-              break;
-            }
-            nextPoint--;
-          }
+          pdiffd = pressureIntervalToNeighbour(-1);
         }
 
         // When there are multiple observations inside the same model interval, the error_factor
         // will be bigger than 1 based on the spacing of the these observations
-        pdifftotal = std::max(pdiffd+pdiffu, 5.0f * tiny_float);
-        error_factor = sqrt(2.0f*vmag/pdifftotal);
+        const float pdifftotal = std::max(pdiffd+pdiffu, 5.0f * tiny_float);
 
         // Output
-        obserr[ivar][rSort[thisPoint]] = error_factor;
-      }
-    }  // thisPoint (observations for single profile) loop
-    if (pointCount != nlocs) {
-      std::string errString = "The data should be sorted or total number of observations "
-                              "after sorting is not consistent with nlocs: ";
-      oops::Log::error() << errString << pointCount << ", "<< nlocs << std::endl;
-      throw eckit::BadValue(errString);
+        error_factor[iloc] = sqrt(2.0f*vmagThis/pdifftotal);
+      }  // thisPoint (observations for single profile) loop
     }  // irec (profile) loop
     oops::Log::debug() << "ObsErrorFactorCon: inflate var, # of profiles, total obs, "
-            "filtered obs = " << inflatevars[ivar] << " " << profCount << " "<< nlocs
+            "filtered obs = " << inflatevars[ivar] << " " << records.size() << " "<< nlocs
             << " " << passCount << std::endl;
   }  // ivar (variable) loop
 }
@@ -18,6 +18,7 @@
 #include "oops/util/IntSetParser.h"
 #include "oops/util/missingValues.h"
 #include "ufo/filters/ObsFilterData.h"
+#include "ufo/filters/obsfunctions/SurfaceClassRad.h"
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/Constants.h"
 #include "ufo/utils/StringUtils.h"
@@ -52,11 +53,8 @@ ObsErrorFactorSurfJacobianRad::ObsErrorFactorSurfJacobianRad(const eckit::LocalC
   invars_ += Variable("brightness_temperature@"+errgrp, channels_);
   invars_ += Variable("brightness_temperature@"+flaggrp, channels_);
 
-  // Include list of required data from GeoVaLs
-  invars_ += Variable("water_area_fraction@GeoVaLs");
-  invars_ += Variable("land_area_fraction@GeoVaLs");
-  invars_ += Variable("ice_area_fraction@GeoVaLs");
-  invars_ += Variable("surface_snow_area_fraction@GeoVaLs");
+  // Include dominant surface types (derived from GeoVaLs)
+  invars_ += SurfaceClassRad::variable();
 
   // Include list of optional data
   if (options_.useBiasTerm.value() != boost::none) {
@@ -93,15 +91,9 @@ void ObsErrorFactorSurfJacobianRad::compute(const ObsFilterData & in,
     ich890 = 16;
   }
 
-  // Load area fraction of each surface type
-  std::vector<float> water_frac(nlocs);
-  std::vector<float> land_frac(nlocs);
-  std::vector<float> ice_frac(nlocs);
-  std::vector<float> snow_frac(nlocs);
-  in.get(Variable("water_area_fraction@GeoVaLs"), water_frac);
-  in.get(Variable("land_area_fraction@GeoVaLs"), land_frac);
-  in.get(Variable("ice_area_fraction@GeoVaLs"), ice_frac);
-  in.get(Variable("surface_snow_area_fraction@GeoVaLs"), snow_frac);
+  // Load dominant surface types in each FOV
+  std::vector<int> surfclass(nlocs);
+  in.get(SurfaceClassRad::variable(), surfclass);
 
   // Get observation tuning parameters over sea/land/oce/snow/mixed from options
   const std::vector<float> &demisf_in = options_.obserrScaleFactorEsfc.value();
@@ -113,11 +105,11 @@ void ObsErrorFactorSurfJacobianRad::compute(const ObsFilterData & in,
 
   // Determine surface type and weight for current obs
   for (size_t iloc = 0; iloc < nlocs; iloc++) {
-    bool sea = water_frac[iloc] >= 0.99;
-    bool land = land_frac[iloc] >= 0.99;
-    bool ice = ice_frac[iloc] >= 0.99;
-    bool snow = snow_frac[iloc] >= 0.99;
-    bool mixed = (!sea && !land && !ice && !snow);
+    bool sea = surfclass[iloc] & SurfaceClassRadBits::sea;
+    bool land = surfclass[iloc] & SurfaceClassRadBits::land;
+    bool ice = surfclass[iloc] & SurfaceClassRadBits::ice;
+    bool snow = surfclass[iloc] & SurfaceClassRadBits::snow;
+    bool mixed = surfclass[iloc] & SurfaceClassRadBits::mixed;
     if (sea) {
       demisf[iloc] = demisf_in[0];
       dtempf[iloc] = dtempf_in[0];
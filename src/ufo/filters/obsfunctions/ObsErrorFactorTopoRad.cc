@@ -91,15 +91,15 @@ void ObsErrorFactorTopoRad::compute(const ObsFilterData & in,
 
   // Inflate obs error as a function of terrian height (>2000) and surface-to-space transmittance
   if (inst == "iasi" || inst == "cris-fsr" || inst == "airs" || inst == "avhrr3") {
-    std::vector<float> tao_sfc(nlocs);
+    std::vector<std::vector<float>> tao_sfc;
+    in.getChannels(Variable("transmittances_of_atmosphere_layer@ObsDiag", channels_),
+                   nlevs - 1, tao_sfc);
     for (size_t ich = 0; ich < nchans; ++ich) {
-      in.get(Variable("transmittances_of_atmosphere_layer@ObsDiag", channels_)[ich],
-             nlevs - 1, tao_sfc);
       for (size_t iloc = 0; iloc < nlocs; ++iloc) {
         out[ich][iloc] = 1.0;
         if (zsges[iloc] > 2000.0) {
           float factor = pow((2000.0/zsges[iloc]), 4);
-          out[ich][iloc] = sqrt(1.0 / (1.0 - (1.0 - factor) * tao_sfc[iloc]));
+          out[ich][iloc] = sqrt(1.0 / (1.0 - (1.0 - factor) * tao_sfc[ich][iloc]));
         }
       }
     }
@@ -126,17 +126,19 @@ void ObsErrorFactorTopoRad::compute(const ObsFilterData & in,
     }
 
     float factor;
-    std::vector<int> qcflagdata;
-    std::vector<float> obserrdata;
     const std::string &errgrp = options_.testObserr.value();
     const std::string &flaggrp = options_.testQCflag.value();
     const float missing = util::missingValue(missing);
+    std::vector<std::vector<float>> obserrdataAll;
+    std::vector<std::vector<int>> qcflagdataAll;
+    in.getChannels(Variable("brightness_temperature@"+errgrp, channels_), obserrdataAll);
+    in.getChannels(Variable("brightness_temperature@"+flaggrp, channels_), qcflagdataAll);
 
     // Calculate error factors (error_factors) for each channel
     for (size_t ichan = 0; ichan < nchans; ++ichan) {
       size_t channel = ichan + 1;
-      in.get(Variable("brightness_temperature@"+errgrp, channels_)[ichan], obserrdata);
-      in.get(Variable("brightness_temperature@"+flaggrp, channels_)[ichan], qcflagdata);
+      const std::vector<float> &obserrdata = obserrdataAll[ichan];
+      std::vector<int> &qcflagdata = qcflagdataAll[ichan];
       for (size_t iloc = 0; iloc < nlocs; ++iloc) {
         out[ichan][iloc] = 1.0;
         if (flaggrp == "PreQC") obserrdata[iloc] == missing ? qcflagdata[iloc] = 100
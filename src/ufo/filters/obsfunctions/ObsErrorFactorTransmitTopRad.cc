@@ -53,11 +53,11 @@ void ObsErrorFactorTransmitTopRad::compute(const ObsFilterData & in,
   size_t nchans = channels_.size();
 
   // Inflate obs error as a function of model top-to-spaec transmittance
-  std::vector<float> tao_top(nlocs);
+  std::vector<std::vector<float>> tao_top;
+  in.getChannels(Variable("transmittances_of_atmosphere_layer@ObsDiag", channels_), 0, tao_top);
   for (size_t ich = 0; ich < nchans; ++ich) {
-    in.get(Variable("transmittances_of_atmosphere_layer@ObsDiag", channels_)[ich], 0, tao_top);
     for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-      out[ich][iloc] = sqrt(1.0 / tao_top[iloc]);
+      out[ich][iloc] = sqrt(1.0 / tao_top[ich][iloc]);
     }
   }
 }
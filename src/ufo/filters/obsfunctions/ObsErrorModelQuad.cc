@@ -68,6 +68,26 @@ ObsErrorModelQuad::ObsErrorModelQuad(const eckit::LocalConfiguration & config)
     ASSERT(err1[i] > 0.0);
     ASSERT(err1[i] >= err0[i]);
   }
+
+  // Precompute the inflection point x-values (x0, x1) and quadratic apex y-value (c)
+  // of each variable.
+  quads_.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    Quad &quad = quads_[i];
+    quad.a = a[i];
+    quad.b = b[i];
+    quad.err0 = err0[i];
+    quad.err1 = err1[i];
+    if (a[i] < 0.0f) {
+      quad.c = err1[i];
+      quad.x1 = b[i];
+      quad.x0 = quad.x1 - sqrt((err0[i] - quad.c) / a[i]);
+    } else {
+      quad.c = err0[i];
+      quad.x0 = b[i];
+      quad.x1 = quad.x0 + sqrt((err1[i] - quad.c) / a[i]);
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -80,14 +100,8 @@ void ObsErrorModelQuad::compute(const ObsFilterData & in,
                                    ioda::ObsDataVector<float> & out) const {
   const float missing = util::missingValue(missing);
 
-  // Get piece-wise parameters from options
-  const std::vector<float> &a = options_.a.value();
-  const std::vector<float> &b = options_.b.value();
-  const std::vector<float> &err0 = options_.err0.value();
-  const std::vector<float> &err1 = options_.err1.value();
-
   // Check out size
-  ASSERT(out.nvars() == a.size());
+  ASSERT(out.nvars() == quads_.size());
 
   // Compute x values
   const Variable &xvar = options_.xvar.value();
@@ -97,34 +111,25 @@ void ObsErrorModelQuad::compute(const ObsFilterData & in,
   // Optional save of the xfunc values
   if (options_.save) xvals.save("ObsFunction");
 
-  float x0, x1, c;
-
+  const size_t nlocs = in.nlocs();
   for (size_t jvar = 0; jvar < out.nvars(); ++jvar) {
-    size_t ivar = std::min(jvar, xvar.size() - 1);
-
-    // Calculate the inflection point x-values (x0, x1)
-    // and quadratic apex y-value (c)
-    if (a[jvar] < 0.0f) {
-      c = err1[jvar];
-      x1 = b[jvar];
-      x0 = x1 - sqrt((err0[jvar] - c) / a[jvar]);
-    } else {
-      c = err0[jvar];
-      x0 = b[jvar];
-      x1 = x0 + sqrt((err1[jvar] - c) / a[jvar]);
-    }
+    const size_t ivar = std::min(jvar, xvar.size() - 1);
+    const Quad &quad = quads_[jvar];
+    const std::vector<float> &x = xvals[ivar];
+    std::vector<float> &err = out[jvar];
 
     // Calculate piece-wise function value across locations
-    for (size_t iloc = 0; iloc < in.nlocs(); ++iloc) {
-      out[jvar][iloc] = missing;
-      if (xvals[ivar][iloc] != missing) {
-        if (xvals[ivar][iloc] <= x0) {
-          out[jvar][iloc] = err0[jvar];
-        } else if (xvals[ivar][iloc] < x1) {
-          out[jvar][iloc] = a[jvar] * pow(xvals[ivar][iloc] - b[jvar], 2) + c;
-        } else {
-          out[jvar][iloc] = err1[jvar];
-        }
+    for (size_t iloc = 0; iloc < nlocs; ++iloc) {
+      const float xloc = x[iloc];
+      if (xloc == missing) {
+        err[iloc] = missing;
+      } else if (xloc <= quad.x0) {
+        err[iloc] = quad.err0;
+      } else if (xloc < quad.x1) {
+        const double dx = xloc - quad.b;
+        err[iloc] = quad.a * (dx * dx) + quad.c;
+      } else {
+        err[iloc] = quad.err1;
       }
     }
   }
@@ -127,8 +127,20 @@ class ObsErrorModelQuad : public ObsFunctionBase<float> {
                ioda::ObsDataVector<float> &) const;
   const ufo::Variables & requiredVariables() const;
  private:
+  /// Parameters of the error model of a single variable.
+  struct Quad {
+    float a, b;
+    float err0, err1;
+    /// Inflection point x-values.
+    float x0, x1;
+    /// Quadratic apex y-value.
+    float c;
+  };
+
   ufo::Variables invars_;
   ObsErrorModelQuadParameters options_;
+  /// Error model of each variable.
+  std::vector<Quad> quads_;
 };
 
 // -----------------------------------------------------------------------------
@@ -68,6 +68,28 @@ ObsErrorModelRamp::ObsErrorModelRamp(const eckit::LocalConfiguration config)
       ASSERT(x2[i] >= x1[i]);
       ASSERT(err2[i] > 0.0);
     }
+    hasSecondRamp_ = true;
+  }
+
+  // Precompute the error model of each variable.
+  const float missing = util::missingValue(missing);
+  ramps_.resize(yvar.size());
+  for (size_t i = 0; i < yvar.size(); ++i) {
+    Ramp &ramp = ramps_[i];
+    ramp.x0 = x0[i];
+    ramp.x1 = x1[i];
+    ramp.err0 = err0[i];
+    ramp.err1 = err1[i];
+    ramp.slope = x1[i] > x0[i] ? (err1[i] - err0[i]) / (x1[i] - x0[i]) : missing;
+    ramp.x2 = missing;
+    ramp.err2 = missing;
+    ramp.slope2 = missing;
+    if (hasSecondRamp_) {
+      ramp.x2 = options_.x2.value().get()[i];
+      ramp.err2 = options_.err2.value().get()[i];
+      if (ramp.x2 > ramp.x1)
+        ramp.slope2 = (ramp.err2 - ramp.err1) / (ramp.x2 - ramp.x1);
+    }
   }
 }
 
@@ -81,14 +103,8 @@ void ObsErrorModelRamp::compute(const ObsFilterData & in,
                                    ioda::ObsDataVector<float> & out) const {
   const float missing = util::missingValue(missing);
 
-  // Get piece-wise parameters from options
-  const std::vector<float> &x0 = options_.x0.value();
-  const std::vector<float> &x1 = options_.x1.value();
-  const std::vector<float> &err0 = options_.err0.value();
-  const std::vector<float> &err1 = options_.err1.value();
-
   // Check out size
-  ASSERT(out.nvars() == x0.size());
+  ASSERT(out.nvars() == ramps_.size());
 
   // Compute x values
   const Variable &xvar = options_.xvar.value();
@@ -98,53 +114,31 @@ void ObsErrorModelRamp::compute(const ObsFilterData & in,
   // Optional save of the xfunc values
   if (options_.save) xvals.save("ObsFunction");
 
-  float slope;
-
-  // Optional extra ramp function
-  std::vector<float> x2;
-  std::vector<float> err2;
-  bool cal_err2_x2 = false;
-  float slope2 = missing;
-  if (options_.x2.value() != boost::none && options_.err2.value() != boost::none) {
-    x2 = options_.x2.value().get();
-    err2 = options_.err2.value().get();
-    cal_err2_x2 = true;
-  }
   // Loop over selected variables
+  const size_t nlocs = in.nlocs();
   for (size_t jvar = 0; jvar < out.nvars(); ++jvar) {
-    size_t ivar = std::min(jvar, xvar.size() - 1);
-
-    // Calculate slope of ramp for this variable
-    if (x1[jvar] > x0[jvar]) {
-      slope = (err1[jvar] - err0[jvar]) / (x1[jvar] - x0[jvar]);
-    } else {
-      slope = missing;
-    }
-    if (cal_err2_x2) {
-      if (x2[jvar] > x1[jvar]) {
-        slope2 = (err2[jvar] - err1[jvar]) / (x2[jvar] - x1[jvar]);
-      } else {
-        slope2 = missing;
-      }
-    }
+    const size_t ivar = std::min(jvar, xvar.size() - 1);
+    const Ramp &ramp = ramps_[jvar];
+    const std::vector<float> &x = xvals[ivar];
+    std::vector<float> &err = out[jvar];
 
     // Calculate piece-wise function value across locations
-    for (size_t iloc = 0; iloc < in.nlocs(); ++iloc) {
-      out[jvar][iloc] = missing;
-      if (xvals[ivar][iloc] != missing) {
-        if (xvals[ivar][iloc] <= x0[jvar]) {
-          out[jvar][iloc] = err0[jvar];
-        } else if (xvals[ivar][iloc] < x1[jvar] && slope != missing) {
-          out[jvar][iloc] = err0[jvar] + slope * (xvals[ivar][iloc] - x0[jvar]);
-        } else if (cal_err2_x2) {
-            if (xvals[ivar][iloc] < x2[jvar] && slope2 != missing) {
-              out[jvar][iloc] = err1[jvar] + slope2 * (xvals[ivar][iloc] - x1[jvar]);
-            } else {
-              out[jvar][iloc] = err2[jvar];
-            }
+    for (size_t iloc = 0; iloc < nlocs; ++iloc) {
+      const float xloc = x[iloc];
+      if (xloc == missing) {
+        err[iloc] = missing;
+      } else if (xloc <= ramp.x0) {
+        err[iloc] = ramp.err0;
+      } else if (xloc < ramp.x1 && ramp.slope != missing) {
+        err[iloc] = ramp.err0 + ramp.slope * (xloc - ramp.x0);
+      } else if (hasSecondRamp_) {
+        if (xloc < ramp.x2 && ramp.slope2 != missing) {
+          err[iloc] = ramp.err1 + ramp.slope2 * (xloc - ramp.x1);
         } else {
-          out[jvar][iloc] = err1[jvar];
+          err[iloc] = ramp.err2;
         }
+      } else {
+        err[iloc] = ramp.err1;
       }
     }
   }
@@ -185,8 +185,20 @@ class ObsErrorModelRamp : public ObsFunctionBase<float> {
                ioda::ObsDataVector<float> &) const;
   const ufo::Variables & requiredVariables() const;
  private:
+  /// Parameters of the error model of a single variable.
+  struct Ramp {
+    float x0, x1, x2;
+    float err0, err1, err2;
+    /// Slopes of the first and second ramps (missing if the ramp has zero width).
+    float slope, slope2;
+  };
+
   ufo::Variables invars_;
   ObsErrorModelRampParameters options_;
+  /// Set if the optional second ramp (x2, err2) is used.
+  bool hasSecondRamp_ = false;
+  /// Error model of each variable.
+  std::vector<Ramp> ramps_;
 };
 
 // -----------------------------------------------------------------------------
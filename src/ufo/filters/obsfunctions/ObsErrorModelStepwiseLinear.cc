@@ -5,6 +5,8 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <boost/optional/optional_io.hpp>
 
@@ -81,6 +83,12 @@ ObsErrorModelStepwiseLinear::ObsErrorModelStepwiseLinear(const eckit::LocalConfi
       throw eckit::BadValue(errString.str());
     }
   }
+
+  // Precompute the slopes of the linear segments.
+  slopes_.resize(xvals.size() - 1);
+  for (size_t kv = 1; kv < xvals.size(); ++kv)
+    slopes_[kv-1] = (errors[kv] - errors[kv-1]) / (xvals[kv] - xvals[kv-1]);
+
   oops::Log::debug() << "ObsErrorModelStepwiseLinear: config (constructor) = "
                      << config << std::endl;
 }
@@ -94,9 +102,6 @@ ObsErrorModelStepwiseLinear::~ObsErrorModelStepwiseLinear() {}
 void ObsErrorModelStepwiseLinear::compute(const ObsFilterData & data,
                                      ioda::ObsDataVector<float> & obserr) const {
   const float missing = util::missingValue(missing);
-  // Linearly interpolate from y0 to y1 at xstar between x0 and x1 to arrive at error
-  float x0, x1, y0, y1;
-  float xstar, error;
 
   // Get the x-variable name and piece-wise parameters from options
   const Variable &xvar = options_.xvar.value();
@@ -134,37 +139,42 @@ void ObsErrorModelStepwiseLinear::compute(const ObsFilterData & data,
     throw eckit::BadValue(errString.str());
   }
 
-  for (size_t jobs = 0; jobs < testdata[iv].size(); ++jobs) {
-    error = 0.0;
-    obserr[iv][jobs] = missing;
-    if (testdata[iv][jobs] == missing) {
+  const std::vector<float> &xstars = testdata[iv];
+  std::vector<float> &errout = obserr[iv];
+  // Index of the breakpoint found for the previous observation. Successive observations (e.g. the
+  // levels of a profile) often fall in the same interval, which is then reused without a search.
+  size_t kv = 1;
+  for (size_t jobs = 0; jobs < xstars.size(); ++jobs) {
+    errout[jobs] = missing;
+    const float xstar = xstars[jobs];
+    if (xstar == missing) {
       continue;
     }
-    xstar = testdata[iv][jobs];
+    float error;
     if ((xstar <= xvals[0] && isAscending_) || (xstar >= xvals[0] && !isAscending_)) {
       error = errors[0];
     } else if ((xstar >= xvals.back() && isAscending_)
               || (xstar <= xvals.back() && !isAscending_)) {
       error = errors[errors.size()-1];
     } else {
-      for (size_t kv = 1; kv < xvals.size(); ++kv) {
-        if ((isAscending_ && (xstar > xvals[kv-1]) && (xstar <= xvals[kv])) ||
-              (!isAscending_ && (xstar < xvals[kv-1]) && (xstar >= xvals[kv]))) {
-          x0 = xvals[kv-1];
-          x1 = xvals[kv];
-          y0 = errors[kv-1];
-          y1 = errors[kv];
-          error = y0 + (xstar-x0)*((y1-y0)/(x1-x0));
-          break;
-        }
-      }
+      // Find the first breakpoint at or beyond xstar and linearly interpolate from the
+      // preceding one.
+      const bool inPreviousInterval = isAscending_ ?
+            xvals[kv-1] < xstar && xstar <= xvals[kv] :
+            xvals[kv-1] > xstar && xstar >= xvals[kv];
+      if (!inPreviousInterval)
+        kv = isAscending_ ?
+              std::lower_bound(xvals.begin(), xvals.end(), xstar) - xvals.begin() :
+              std::lower_bound(xvals.begin(), xvals.end(), xstar, std::greater<float>()) -
+              xvals.begin();
+      error = errors[kv-1] + (xstar-xvals[kv-1])*slopes_[kv-1];
     }
     // TODO(gthompsn):  probably need this next line for when filtervariable is flagged missing
     // if (!flagged_[jv][jobs]) obserr[jv][jobs] = error;
     if (multiplicative_) {
-      obserr[iv][jobs] = error*(*obvalues)[iv][jobs];
+      errout[jobs] = error*(*obvalues)[iv][jobs];
     } else {
-      obserr[iv][jobs] = error;
+      errout[jobs] = error;
     }
   }
 }
@@ -103,6 +103,8 @@ class ObsErrorModelStepwiseLinear : public ObsFunctionBase<float> {
   ObsErrorModelStepwiseLinearParameters options_;
   bool isAscending_ = true;
   bool multiplicative_ = false;
+  /// Slopes of the error model between consecutive elements of xvals.
+  std::vector<float> slopes_;
 };
 
 // -----------------------------------------------------------------------------
@@ -7,8 +7,13 @@
 
 #include "ufo/filters/obsfunctions/ObsFunctionArithmetic.h"
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
 #include <vector>
 
+#include "eckit/utils/StringTools.h"
 #include "ioda/ObsDataVector.h"
 #include "oops/util/missingValues.h"
 #include "ufo/filters/ObsFilterData.h"
@@ -25,6 +30,30 @@ static ObsFunctionMaker<Arithmetic<int>> LinearCombinationintMaker("LinearCombin
 
 // -----------------------------------------------------------------------------
 
+/// An expression total_coeff * (sum_i coef_i * input_i^exponent_i)^total_exponent + intercept.
+template <typename FunctionValue>
+struct Arithmetic<FunctionValue>::Expression {
+  struct Term {
+    Variable variable;
+    FunctionValue coef;
+    FunctionValue exponent;
+    /// Expression computing the input if the variable is a nested Arithmetic ObsFunction,
+    /// otherwise null.
+    std::unique_ptr<Expression> nested;
+    /// Index of the input in the list of variables read directly (if nested is null).
+    size_t input;
+  };
+
+  std::vector<Term> terms;
+  FunctionValue totalExponent;
+  FunctionValue totalCoeff;
+  FunctionValue intercept;
+  bool useChannelNumber;
+  std::vector<int> channels;
+};
+
+// -----------------------------------------------------------------------------
+
 template <typename FunctionValue>
 Arithmetic<FunctionValue>::Arithmetic(const eckit::LocalConfiguration & conf)
   : invars_() {
@@ -35,49 +64,56 @@ Arithmetic<FunctionValue>::Arithmetic(const eckit::LocalConfiguration & conf)
   for (const Variable & var : options_.variables.value()) {
     invars_ += var;
   }
+
+  expression_ = makeExpression(options_, inputs_);
 }
 
 // -----------------------------------------------------------------------------
 
 template <typename FunctionValue>
-void Arithmetic<FunctionValue>::compute(const ObsFilterData & in,
-                                               ioda::ObsDataVector<FunctionValue> & out) const {
-  // dimension
-  const size_t nlocs = in.nlocs();
+Arithmetic<FunctionValue>::~Arithmetic() {}
 
-  // number of input variables
-  const size_t nv = invars_.size();
+// -----------------------------------------------------------------------------
 
-  // get exponent coefficients
+template <typename FunctionValue>
+std::unique_ptr<typename Arithmetic<FunctionValue>::Expression>
+Arithmetic<FunctionValue>::makeExpression(const ArithmeticParameters<FunctionValue> & options,
+                                          std::vector<Variable> & inputs) {
+  const std::vector<Variable> & variables = options.variables.value();
+  const size_t nv = variables.size();
+
+  // get coefficients
   std::vector<FunctionValue> coefs(nv, 1);
-  if (options_.coefs.value() != boost::none)
-    coefs = options_.coefs.value().get();
+  if (options.coefs.value() != boost::none)
+    coefs = options.coefs.value().get();
 
   // get exponent coefficients
   std::vector<FunctionValue> exponents(nv, 1);
-  if (options_.exponents.value() != boost::none)
-    exponents = options_.exponents.value().get();
+  if (options.exponents.value() != boost::none)
+    exponents = options.exponents.value().get();
+
+  std::unique_ptr<Expression> expression(new Expression);
 
   // get total exponent
-  FunctionValue total_exponent = static_cast<FunctionValue>(1);
-  if (options_.total_exponent.value() != boost::none)
-    total_exponent = options_.total_exponent.value().get();
+  expression->totalExponent = static_cast<FunctionValue>(1);
+  if (options.total_exponent.value() != boost::none)
+    expression->totalExponent = options.total_exponent.value().get();
 
   // get total multiplicative coefficient
-  FunctionValue total_coeff = static_cast<FunctionValue>(1);
-    if (options_.total_coeff.value() != boost::none)
-    total_coeff = options_.total_coeff.value().get();
+  expression->totalCoeff = static_cast<FunctionValue>(1);
+  if (options.total_coeff.value() != boost::none)
+    expression->totalCoeff = options.total_coeff.value().get();
 
   // set intercept
-  FunctionValue intercept = static_cast<FunctionValue>(0);
-  if (options_.intercept.value() != boost::none)
-    intercept = options_.intercept.value().get();
+  expression->intercept = static_cast<FunctionValue>(0);
+  if (options.intercept.value() != boost::none)
+    expression->intercept = options.intercept.value().get();
 
   // use channels not obs
-  std::vector<int> channels;
-  if (options_.useChannelNumber) {
-    channels = invars_[0].channels();
-    ASSERT(channels.size() > 0);
+  expression->useChannelNumber = options.useChannelNumber;
+  if (expression->useChannelNumber) {
+    expression->channels = variables[0].channels();
+    ASSERT(expression->channels.size() > 0);
   }
 
   // sanity checks
@@ -88,54 +124,94 @@ void Arithmetic<FunctionValue>::compute(const ObsFilterData & in,
     abs_exponents.push_back(std::abs(exponents[ivar]));
   }
   if (*std::max_element(abs_exponents.begin(), abs_exponents.end()) > 10
-          || std::abs(total_exponent) > 25) {
+          || std::abs(expression->totalExponent) > 25) {
       oops::Log::warning() << "There is at least one large exponent (>25). "
                               "This may result in overflow errors."
                            << std::endl;
   }
 
-  // initialize
-  out.zero();
+  for (size_t ivar = 0; ivar < nv; ++ivar) {
+    const Variable & var = variables[ivar];
+    typename Expression::Term term{var, coefs[ivar], exponents[ivar], nullptr, 0};
+    if (var.group() == ObsFunctionTraits<FunctionValue>::groupName &&
+        (var.variable() == "Arithmetic" || var.variable() == "LinearCombination")) {
+      ArithmeticParameters<FunctionValue> nestedOptions;
+      nestedOptions.validateAndDeserialize(var.options());
+      term.nested = makeExpression(nestedOptions, inputs);
+    } else {
+      // Variables other than ObsFunctions are read only once. (ObsFunctions may depend on
+      // options and are cached by ObsFilterData if that is enabled.)
+      const bool isFunction = eckit::StringTools::endsWith(var.group(), "ObsFunction");
+      const auto sameVariable = [&var, isFunction](const Variable & other) {
+          return !isFunction && other.fullName() == var.fullName() &&
+              other.channels() == var.channels();
+        };
+      term.input = std::find_if(inputs.begin(), inputs.end(), sameVariable) - inputs.begin();
+      if (term.input == inputs.size())
+        inputs.push_back(var);
+    }
+    expression->terms.push_back(std::move(term));
+  }
+  return expression;
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename FunctionValue>
+void Arithmetic<FunctionValue>::compute(const ObsFilterData & in,
+                                               ioda::ObsDataVector<FunctionValue> & out) const {
+  // dimension
+  const size_t nlocs = in.nlocs();
+
+  // get all variables read by the expression and its nested expressions
+  std::vector<std::vector<std::vector<FunctionValue>>> inputs(inputs_.size());
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    in.getChannels(inputs_[i], inputs[i]);
+    ASSERT(inputs[i].size() == out.nvars());
+  }
 
-  // compute linear combination of input variables
+  // evaluate the expression in a single pass
+  for (size_t ichan = 0; ichan < out.nvars(); ++ichan) {
+    ioda::ObsDataRow<FunctionValue> & outRow = out[ichan];
+    for (size_t iloc = 0; iloc < nlocs; ++iloc)
+      outRow[iloc] = evaluate(*expression_, ichan, iloc, inputs);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename FunctionValue>
+FunctionValue Arithmetic<FunctionValue>::evaluate(
+    const Expression & expression, size_t ichan, size_t iloc,
+    const std::vector<std::vector<std::vector<FunctionValue>>> & inputs) const {
   const FunctionValue missing = util::missingValue(missing);
-  for (size_t ivar = 0; ivar < nv; ++ivar) {
-    ioda::ObsDataVector<FunctionValue> varin(in.obsspace(), invars_[ivar].toOopsVariables());
-    in.get(invars_[ivar], varin);
-    ASSERT(varin.nvars() == out.nvars());
-    for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-      for (size_t ichan = 0; ichan < out.nvars(); ++ichan) {
-        if ( varin[ichan][iloc] == missing || out[ichan][iloc] == missing ) {
-          out[ichan][iloc] = missing;
-        } else if (varin[ichan][iloc] < 0 && static_cast<int>(exponents[ivar]) != exponents[ivar]) {
-            out[ichan][iloc] = missing;
-            oops::Log::warning() << "coefficient exponent "
-                                    "Trying to raise a negative number to a non-integer exponent. "
-                                    "Output for " << invars_[ivar] << " at location " << iloc <<
-                                    " set to missing." << std::endl;
-        } else {
-          if (options_.useChannelNumber) {
-            out[ichan][iloc] += coefs[ivar] * power(channels[ichan], exponents[ivar]);
-          } else {
-            out[ichan][iloc] += coefs[ivar] * power(varin[ichan][iloc], exponents[ivar]);
-          }
-          if (ivar == nv - 1) {
-            if (out[ichan][iloc] < 0 && static_cast<int>(total_exponent) != total_exponent
-                && out[ichan][iloc] != missing) {
-                out[ichan][iloc] = missing;
-                oops::Log::warning() << "total coefficient exponent "
-                                        "Trying to raise a negative number to a non-integer "
-                                        "exponent. Output for " << invars_[ivar] <<
-                                        " at location " << iloc << " set to missing." << std::endl;
-            } else {
-                out[ichan][iloc] = total_coeff*power(out[ichan][iloc], total_exponent)
-                                 + intercept;
-            }
-          }
-        }
-      }  // ichan
-    }  // nlocs
-  }  // nvars
+  FunctionValue sum = 0;
+  for (const typename Expression::Term & term : expression.terms) {
+    const FunctionValue value = term.nested ? evaluate(*term.nested, ichan, iloc, inputs)
+                                            : inputs[term.input][ichan][iloc];
+    if (value == missing)
+      return missing;
+    if (value < 0 && static_cast<int>(term.exponent) != term.exponent) {
+      oops::Log::warning() << "coefficient exponent "
+                              "Trying to raise a negative number to a non-integer exponent. "
+                              "Output for " << term.variable << " at location " << iloc <<
+                              " set to missing." << std::endl;
+      return missing;
+    }
+    if (expression.useChannelNumber) {
+      sum += term.coef * power(expression.channels[ichan], term.exponent);
+    } else {
+      sum += term.coef * power(value, term.exponent);
+    }
+  }
+  if (sum < 0 && static_cast<int>(expression.totalExponent) != expression.totalExponent) {
+    oops::Log::warning() << "total coefficient exponent "
+                            "Trying to raise a negative number to a non-integer "
+                            "exponent. Output for " << expression.terms.back().variable <<
+                            " at location " << iloc << " set to missing." << std::endl;
+    return missing;
+  }
+  return expression.totalCoeff * power(sum, expression.totalExponent) + expression.intercept;
 }
 
 // -----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #ifndef UFO_FILTERS_OBSFUNCTIONS_OBSFUNCTIONARITHMETIC_H_
 #define UFO_FILTERS_OBSFUNCTIONS_OBSFUNCTIONARITHMETIC_H_
 
+#include <memory>
 #include <vector>
 
 #include "oops/util/parameters/OptionalParameter.h"
@@ -115,19 +116,40 @@ class ArithmeticParameters : public oops::Parameters {
 /// will return 3.6 +
 ///             0.5 * channels
 ///
+/// Input variables that are themselves Arithmetic or LinearCombination ObsFunctions (of the same
+/// value type) are not computed separately: the nested expressions are evaluated together with
+/// the enclosing one in a single loop over locations and channels. Each of the remaining input
+/// variables is retrieved from ObsFilterData only once, even if it is used in several nested
+/// expressions.
 ///
 template <typename FunctionValue>
 class Arithmetic : public ObsFunctionBase<FunctionValue> {
  public:
   explicit Arithmetic(const eckit::LocalConfiguration &);
+  ~Arithmetic();
 
   void compute(const ObsFilterData &,
                ioda::ObsDataVector<FunctionValue> &) const;
   FunctionValue power(FunctionValue, FunctionValue) const;
   const ufo::Variables & requiredVariables() const;
  private:
+  struct Expression;
+
+  /// Build the expression defined by \p options (nesting the expressions of input variables
+  /// that are Arithmetic ObsFunctions). Input variables read directly are appended to \p inputs.
+  static std::unique_ptr<Expression> makeExpression(
+      const ArithmeticParameters<FunctionValue> &options, std::vector<Variable> &inputs);
+  /// Evaluate \p expression at channel \p ichan and location \p iloc, given the values of the
+  /// variables read directly (indexed by input, channel and location).
+  FunctionValue evaluate(const Expression &expression, size_t ichan, size_t iloc,
+                         const std::vector<std::vector<std::vector<FunctionValue>>> &inputs)
+                         const;
+
   ArithmeticParameters<FunctionValue> options_;
   ufo::Variables invars_;
+  std::unique_ptr<Expression> expression_;
+  /// Variables read directly by expression_ and its nested expressions.
+  std::vector<Variable> inputs_;
 };
 
 // -----------------------------------------------------------------------------
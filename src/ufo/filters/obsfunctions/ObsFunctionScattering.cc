@@ -11,8 +11,10 @@
 #include <vector>
 
 #include "ioda/ObsDataVector.h"
+#include "oops/util/Logger.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/Variable.h"
+#include "ufo/utils/LogUtils.h"
 
 namespace ufo {
 
@@ -40,10 +42,12 @@ void ObsFunctionScattering::compute(const ObsFilterData & input,
   input.get(Variable("brightness_temperature_1@ObsValue"), bt1);
   input.get(Variable("brightness_temperature_2@ObsValue"), bt2);
   input.get(Variable("brightness_temperature_15@ObsValue"), bt15);
+  const bool debug = isLogChannelEnabled(oops::Log::debug());
   for (size_t jj = 0; jj < nlocs; ++jj) {
     out[0][jj] = -113.2+(2.41-0.0049*bt1[jj])*bt1[jj]+0.454*bt2[jj]-bt15[jj];
-    oops::Log::debug() << "Tb1, Tb2, Tb15: " << bt1[jj] << ", " << bt2[jj] << ", " << bt15[jj]
-                       << ", scattering=" << out[0][jj] << std::endl;
+    if (debug)
+      oops::Log::debug() << "Tb1, Tb2, Tb15: " << bt1[jj] << ", " << bt2[jj] << ", " << bt15[jj]
+                         << ", scattering=" << out[0][jj] << std::endl;
   }
 }
 
@@ -15,6 +15,7 @@
 #include "oops/util/Logger.h"
 #include "oops/util/missingValues.h"
 #include "ufo/filters/ObsFilterData.h"
+#include "ufo/utils/GroupedStatistics.h"
 #include "ufo/utils/RecursiveSplitter.h"
 
 namespace ufo {
@@ -73,66 +74,91 @@ void SelectStatistic::compute(const ObsFilterData & in, ioda::ObsDataVector<int>
   in.get(invars_[0], varin);
   oops::Log::debug() << "out.nvars(): " << out.nvars() << std::endl;
 
-  for (ufo::RecursiveSplitter::Group recordGroup : splitter.groups()) {
-    // Get input vector of valid values in channel ichan:
-    for (size_t ichan = 0; ichan < nchans; ++ichan) {
-      oops::Log::debug() << "ichan: " << ichan << std::endl;
-      std::vector<float> inputVec;
-      std::vector<float> obs_indices;
-      // std::vector<float> all_inputVec;
-      std::vector<float> all_obs_indices;
-      // Loop over obs within a profile:
+  const ufo::RecursiveSplitter::GroupRange records = splitter.groups();
+  size_t numRecords = 0;
+  for (auto it = records.begin(); it != records.end(); ++it)
+    ++numRecords;
+
+  std::vector<float> inputVec;
+  std::vector<size_t> obs_indices;
+  std::vector<size_t> idx;
+  for (size_t ichan = 0; ichan < nchans; ++ichan) {
+    oops::Log::debug() << "ichan: " << ichan << std::endl;
+    const std::vector<float> &values = varin[ichan];
+    std::vector<int> &selected = out[ichan];
+
+    // Statistics of the valid values in each record, computed in a single pass.
+    GroupedStatistics<float> stats(numRecords);
+    size_t irecord = 0;
+    for (ufo::RecursiveSplitter::Group recordGroup : records) {
       for (size_t validObsIndex : recordGroup) {
-        all_obs_indices.push_back(validObsIndex);  // include missing vals
-        if (varin[ichan][validObsIds[validObsIndex]] != missing) {
-          inputVec.push_back(varin[ichan][validObsIds[validObsIndex]]);
-          obs_indices.push_back(validObsIndex);
-        }
+        const float value = values[validObsIds[validObsIndex]];
+        if (value != missing)
+          stats.add(irecord, value);
       }
-      if (inputVec.size() > 0) {  // leave output as 0's if input var all missing for whole record
-        if (options_.selectMax) {
-          oops::Log::debug() << "Select max." << std::endl;
-          const size_t maxInd = std::distance(inputVec.begin(),
-                                              std::max_element(inputVec.begin(), inputVec.end()));
-          out[ichan][validObsIds[obs_indices[maxInd]]] = 1;
-        }
-        if (options_.selectMin) {
-          oops::Log::debug() << "Select min." << std::endl;
-          const size_t minInd = std::distance(inputVec.begin(),
-                                              std::min_element(inputVec.begin(), inputVec.end()));
-          out[ichan][validObsIds[obs_indices[minInd]]] = 1;
-        }
+      ++irecord;
+    }
+
+    irecord = 0;
+    for (ufo::RecursiveSplitter::Group recordGroup : records) {
+      const size_t record = irecord++;
+      if (stats.count(record) == 0) {
+        // Input var all missing for whole record: leave output as 0's unless forced to select.
+        if (options_.forceSelect)
+          selected[validObsIds[*recordGroup.begin()]] = 1;
+        continue;
+      }
+
+      // Select the first observations with the maximum and minimum values and the first
+      // observation with the value closest to the mean.
+      const float inputMean = stats.sum(record) / stats.count(record);
+      const size_t noObs = validObsIds.size();
+      size_t maxObsId = noObs, minObsId = noObs, meanObsId = noObs;
+      float minDistanceFromMean = 0.0f;
+      for (size_t validObsIndex : recordGroup) {
+        const size_t obsId = validObsIds[validObsIndex];
+        const float value = values[obsId];
+        if (value == missing)
+          continue;
+        if (maxObsId == noObs && value == stats.max(record))
+          maxObsId = obsId;
+        if (minObsId == noObs && value == stats.min(record))
+          minObsId = obsId;
         if (options_.selectMean) {
-          oops::Log::debug() << "Select mean." << std::endl;
-          size_t inputSize = inputVec.size();
-          const float inputMean = std::accumulate(inputVec.begin(), inputVec.end(), 0.0) /
-                                                  inputSize;
-          auto i = std::min_element(inputVec.begin(), inputVec.end(), [=] (float x, float y)
-          {
-              return abs(x - inputMean) < abs(y - inputMean);
-          });
-          const size_t meanInd = std::distance(inputVec.begin(), i);
-          out[ichan][validObsIds[obs_indices[meanInd]]] = 1;
-        }
-        if (options_.selectMedian) {
-          oops::Log::debug() << "Select median." << std::endl;
-          size_t inputSize = inputVec.size();
-          std::vector<size_t> idx(inputSize);
-          std::iota(idx.begin(), idx.end(), 0);
-          std::stable_sort(idx.begin(), idx.end(), [&inputVec](size_t i1, size_t i2)
-                                                   {return inputVec[i1] < inputVec[i2];});
-          const size_t medianInd = idx[(inputSize-1)/2];
-          out[ichan][validObsIds[obs_indices[medianInd]]] = 1;
+          const float distanceFromMean = abs(value - inputMean);
+          if (meanObsId == noObs || distanceFromMean < minDistanceFromMean) {
+            meanObsId = obsId;
+            minDistanceFromMean = distanceFromMean;
+          }
         }
-      } else {  // inputVec all missing
-        if (options_.forceSelect) {
-          oops::Log::debug() <<
-              "All missing values in this record, but force to select one obs." << std::endl;
-          out[ichan][validObsIds[all_obs_indices[0]]] = 1;
+      }
+      if (options_.selectMax)
+        selected[maxObsId] = 1;
+      if (options_.selectMin)
+        selected[minObsId] = 1;
+      if (options_.selectMean)
+        selected[meanObsId] = 1;
+
+      if (options_.selectMedian) {
+        inputVec.clear();
+        obs_indices.clear();
+        for (size_t validObsIndex : recordGroup) {
+          const size_t obsId = validObsIds[validObsIndex];
+          if (values[obsId] != missing) {
+            inputVec.push_back(values[obsId]);
+            obs_indices.push_back(obsId);
+          }
         }
-      }  // record all missing values or not
-    }  // for each channel
-  }  // for each record
+        size_t inputSize = inputVec.size();
+        idx.resize(inputSize);
+        std::iota(idx.begin(), idx.end(), 0);
+        std::stable_sort(idx.begin(), idx.end(), [&inputVec](size_t i1, size_t i2)
+                                                 {return inputVec[i1] < inputVec[i2];});
+        const size_t medianInd = idx[(inputSize-1)/2];
+        selected[obs_indices[medianInd]] = 1;
+      }
+    }  // for each record
+  }  // for each channel
 }
 
 // -----------------------------------------------------------------------------
@@ -43,33 +43,29 @@ void StringManipulation::compute(const ObsFilterData & in,
   // dimension
   const size_t nlocs = in.nlocs();
 
-  // variables
-  int startIndex;
-  int cutLength;
-
-  const std::string missing = util::missingValue(missing);
   ioda::ObsDataVector<std::string> varin(in.obsspace(), invars_.toOopsVariables());
   in.get(invars_[0], varin);
+  const std::vector<std::string> & input = varin[0];
+  std::vector<std::string> & output = out[0];
 
   // apply string operation to all locations
-  for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    switch (options_.stringManipOption.value()) {
-      case StringManipOption::STRINGCUT: {
-        if (options_.startIndex.value() != boost::none &&
-            options_.cutLength.value() != boost::none) {
-          // index to go from
-          startIndex = options_.startIndex.value().get();
-          // index to go to
-          cutLength = options_.cutLength.value().get();
-          // cut the input string from startIndex to a length cutLength
-          out[0][iloc] = varin[0][iloc].substr(startIndex, cutLength);
-        } else {
-          throw eckit::Exception("startIndex and cutLength need to be set for stringcut");
-        }
-      }
+  switch (options_.stringManipOption.value()) {
+    case StringManipOption::STRINGCUT: {
+      if (options_.startIndex.value() == boost::none ||
+          options_.cutLength.value() == boost::none)
+        throw eckit::Exception("startIndex and cutLength need to be set for stringcut");
+      // index to go from
+      const int startIndex = options_.startIndex.value().get();
+      // index to go to
+      const int cutLength = options_.cutLength.value().get();
+      // cut the input string from startIndex to a length cutLength, copying the characters
+      // straight into the output string rather than through a temporary substring
+      for (size_t iloc = 0; iloc < nlocs; ++iloc)
+        output[iloc].assign(input[iloc], startIndex, cutLength);
     }
   }
 }
+
 // -----------------------------------------------------------------------------
 
 const ufo::Variables & StringManipulation::requiredVariables() const {
@@ -61,15 +61,18 @@ void Velocity<FunctionValue>::compute(const ObsFilterData & in,
   ioda::ObsDataVector<FunctionValue> v(in.obsspace(), invars_[1].toOopsVariables());
   in.get(invars_[0], u);
   in.get(invars_[1], v);
-  for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    for (size_t ichan = 0; ichan < nchans; ++ichan) {
-      if (u[ichan][iloc] != missing && v[ichan][iloc] != missing) {
-        out[ichan][iloc] = sqrt(u[ichan][iloc]*u[ichan][iloc] + v[ichan][iloc]*v[ichan][iloc]);
+  for (size_t ichan = 0; ichan < nchans; ++ichan) {
+    const std::vector<FunctionValue> &uchan = u[ichan];
+    const std::vector<FunctionValue> &vchan = v[ichan];
+    std::vector<FunctionValue> &outchan = out[ichan];
+    for (size_t iloc = 0; iloc < nlocs; ++iloc) {
+      if (uchan[iloc] != missing && vchan[iloc] != missing) {
+        outchan[iloc] = sqrt(uchan[iloc]*uchan[iloc] + vchan[iloc]*vchan[iloc]);
       } else {
-        out[ichan][iloc] = missing;
+        outchan[iloc] = missing;
       }
-    }  // nchans
-  }  // nlocs
+    }  // nlocs
+  }  // nchans
 }
 
 // -----------------------------------------------------------------------------
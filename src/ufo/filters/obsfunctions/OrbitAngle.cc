@@ -9,16 +9,31 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <map>
 #include <string>
 #include <vector>
 
 #include "ioda/ObsDataVector.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Duration.h"
 #include "ufo/filters/ObsFilterData.h"
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/Constants.h"
 
 namespace ufo {
 
+namespace {
+
+/// Quantities needed by OrbitAngle that depend only on the date (not time).
+struct OrbitAngleDay {
+  int year;
+  /// Day of year (1 on 1 January).
+  double doy;
+};
+
+}  // namespace
+
 static ObsFunctionMaker<OrbitAngle> maker_("OrbitAngle");
 
 OrbitAngle::OrbitAngle(const eckit::LocalConfiguration & conf) {
@@ -38,6 +53,7 @@ void OrbitAngle::compute(const ObsFilterData & in, ioda::ObsDataVector<float> &
   const util::DateTime missingDateTime = util::missingValue(util::DateTime());
 
   const util::DateTime firstjan2000(2000, 1, 1, 0, 0, 0);
+  const int64_t secondsPerDay = 86400;
 
   const float ecliptic_npole_RA_hours = 18.0;
   const float ecliptic_npole_dec = 66.55 * Constants::deg2rad;
@@ -75,6 +91,9 @@ void OrbitAngle::compute(const ObsFilterData & in, ioda::ObsDataVector<float> &
   size_t numOutOfRangeDatetimes = 0;
   size_t numInvalidDateTimes = 0;
 
+  // Values dependent on day only, computed once for each distinct day (identified by the
+  // number of days elapsed since firstjan2000)
+  std::map<int64_t, OrbitAngleDay> days;
 
   for (size_t loc = 0; loc < nlocs; ++loc) {
     // check for useable input data
@@ -118,11 +137,30 @@ void OrbitAngle::compute(const ObsFilterData & in, ioda::ObsDataVector<float> &
       continue;
     }
 
-    const util::DateTime &datetime = datetimes[loc];
-
-    // convert date to constituent parts
-    int year, month, day, hour, minute, second;
-    datetime.toYYYYMMDDhhmmss(year, month, day, hour, minute, second);
+    // split the time into the day and the time of day
+    const int64_t secondsSince2000 = (datetimes[loc] - firstjan2000).toSeconds();
+    int64_t daysSince2000 = secondsSince2000 / secondsPerDay;
+    if (secondsSince2000 % secondsPerDay < 0)
+      --daysSince2000;
+    const int64_t secondsSinceStartOfDay = secondsSince2000 - daysSince2000 * secondsPerDay;
+
+    auto dayIt = days.find(daysSince2000);
+    if (dayIt == days.end()) {
+      // convert date to constituent parts
+      const util::DateTime startofday =
+          firstjan2000 + util::Duration(daysSince2000 * secondsPerDay);
+      int year, month, day, hour, minute, second;
+      startofday.toYYYYMMDDhhmmss(year, month, day, hour, minute, second);
+
+      // now work out day of year
+      const util::DateTime startofyear(year, 1, 1, 0, 0, 0);
+      OrbitAngleDay orbitAngleDay;
+      orbitAngleDay.year = year;
+      orbitAngleDay.doy = floor((startofday - startofyear).toSeconds() * daysPerSecond)+1;
+      dayIt = days.emplace(daysSince2000, orbitAngleDay).first;
+    }
+    const int year = dayIt->second.year;
+    const double doy = dayIt->second.doy;
 
     // equation is only valid for years between 1950 and 2200
     if (year < 1950 || year > 2200) {
@@ -132,11 +170,6 @@ void OrbitAngle::compute(const ObsFilterData & in, ioda::ObsDataVector<float> &
       continue;
     }
 
-    // now work out day of year
-    util::DateTime startofyear(year, 1, 1, 0, 0, 0);
-
-    double doy = floor((datetime - startofyear).toSeconds() * daysPerSecond)+1;
-
     // check date range is meaningful
     if (doy < 1 || doy > 366) {
       ++numInvalidDateTimes;
@@ -146,16 +179,16 @@ void OrbitAngle::compute(const ObsFilterData & in, ioda::ObsDataVector<float> &
     }
 
     // convert emphermis positions to cartesian
-    std::vector<float> evector1 = OrbitAngle::ll_to_xyz(ephem_lat1[loc], ephem_lon1[loc]);
-    std::vector<float> evector2 = OrbitAngle::ll_to_xyz(ephem_lat2[loc], ephem_lon2[loc]);
+    const Vector3 evector1 = OrbitAngle::ll_to_xyz(ephem_lat1[loc], ephem_lon1[loc]);
+    const Vector3 evector2 = OrbitAngle::ll_to_xyz(ephem_lat2[loc], ephem_lon2[loc]);
 
     // now compute position and vel vectors - these define orbit plane
-    std::vector<float> posvector(3);
+    Vector3 posvector;
     for (size_t vloc = 0; vloc < posvector.size(); ++vloc) {
       posvector[vloc] = 0.5*(evector1[vloc]+evector2[vloc]);
     }
 
-    std::vector<float> velvector(3);
+    Vector3 velvector;
     for (size_t vloc = 0; vloc < velvector.size(); ++vloc) {
       velvector[vloc] = evector2[vloc]-evector1[vloc];
     }
@@ -164,9 +197,7 @@ void OrbitAngle::compute(const ObsFilterData & in, ioda::ObsDataVector<float> &
     // long jday=floor((datetime - firstjan2000).toSeconds() / secondsPerDay)+1
     // but i have chosen the OPS method for exact comparison
 
-    util::DateTime startofday(year, month, day, 0, 0, 0);
-
-    double hour_of_day = (datetime - startofday).toSeconds()*hoursPerSecond;
+    double hour_of_day = secondsSinceStartOfDay*hoursPerSecond;
 
     // check hour of day is meaningful
     if (hour_of_day < 0 || hour_of_day >= 24) {
@@ -194,15 +225,15 @@ void OrbitAngle::compute(const ObsFilterData & in, ioda::ObsDataVector<float> &
 
 
     // now derive the solarplane using local sidereal time
-    std::vector<float> solarplane_vector(3);
+    Vector3 solarplane_vector;
     solarplane_vector[0] =  std::cos(hour_angle) * std::cos(ecliptic_npole_dec);
     solarplane_vector[1] = -std::sin(hour_angle) * std::cos(ecliptic_npole_dec);
     solarplane_vector[2] = std::sin(ecliptic_npole_dec);
 
     // cross products  which define each plane
-    std::vector<float> orbitplane_vector =
+    const Vector3 orbitplane_vector =
                         OrbitAngle::crossprod_xyz(posvector, velvector);
-    std::vector<float> refplane_vector =
+    const Vector3 refplane_vector =
                         OrbitAngle::crossprod_xyz(solarplane_vector, orbitplane_vector);
 
     // use dot product to generate angle between ref plane and satellite pos
@@ -261,7 +292,7 @@ const ufo::Variables & OrbitAngle::requiredVariables() const {
 }
 
 // Return the modulus of a vector
-float OrbitAngle::vectormod(const std::vector<float> &a) const {
+float OrbitAngle::vectormod(const Vector3 &a) const {
   float sumsq = 0.0;
   for (size_t vloc = 0; vloc < a.size(); ++vloc) {
     sumsq += a[vloc]*a[vloc];
@@ -270,9 +301,9 @@ float OrbitAngle::vectormod(const std::vector<float> &a) const {
 }
 
 // Return the lat long location in cartesian coordinates
-std::vector<float> OrbitAngle::ll_to_xyz(const float &lat,
-                                        const float &lon) const {
-  std::vector<float> xyz(3);
+OrbitAngle::Vector3 OrbitAngle::ll_to_xyz(const float &lat,
+                                         const float &lon) const {
+  Vector3 xyz;
   float coslat = std::cos(lat * Constants::deg2rad);
   xyz[0] = std::cos(lon * Constants::deg2rad) * coslat;
   xyz[1] = std::sin(lon * Constants::deg2rad) * coslat;
@@ -281,9 +312,9 @@ std::vector<float> OrbitAngle::ll_to_xyz(const float &lat,
 }
 
 // Return the cross product of xyz vector
-std::vector<float> OrbitAngle::crossprod_xyz(const std::vector<float> &a,
-                                            const std::vector<float> &b) const {
-  std::vector<float> crossprod(3);
+OrbitAngle::Vector3 OrbitAngle::crossprod_xyz(const Vector3 &a,
+                                             const Vector3 &b) const {
+  Vector3 crossprod;
   crossprod[0] = a[1] * b[2] - a[2] * b[1];
   crossprod[1] = a[2] * b[0] - a[0] * b[2];
   crossprod[2] = a[0] * b[1] - a[1] * b[0];
@@ -291,8 +322,8 @@ std::vector<float> OrbitAngle::crossprod_xyz(const std::vector<float> &a,
 }
 
 // Return the dot product of a vector
-float OrbitAngle::dotproduct(const std::vector<float> &a,
-                            const std::vector<float> &b) const {
+float OrbitAngle::dotproduct(const Vector3 &a,
+                             const Vector3 &b) const {
   float dotp = 0.0;
   for (size_t vloc = 0; vloc < a.size(); ++vloc) {
     dotp += a[vloc]*b[vloc];
@@ -8,7 +8,7 @@
 #ifndef UFO_FILTERS_OBSFUNCTIONS_ORBITANGLE_H_
 #define UFO_FILTERS_OBSFUNCTIONS_ORBITANGLE_H_
 
-#include <vector>
+#include <array>
 
 #include "ufo/filters/obsfunctions/ObsFunctionBase.h"
 #include "ufo/filters/Variables.h"
@@ -32,12 +32,14 @@ class OrbitAngle : public ObsFunctionBase<float> {
   const ufo::Variables & requiredVariables() const;
 
  private:
-  float vectormod(const std::vector<float> &a) const;
-  float dotproduct(const std::vector<float> &a,
-                  const std::vector<float> &b) const;
-  std::vector<float> ll_to_xyz(const float &lat, const float &lon) const;
-  std::vector<float> crossprod_xyz(const std::vector<float> &a,
-                                   const std::vector<float> &b) const;
+  typedef std::array<float, 3> Vector3;
+
+  float vectormod(const Vector3 &a) const;
+  float dotproduct(const Vector3 &a,
+                  const Vector3 &b) const;
+  Vector3 ll_to_xyz(const float &lat, const float &lon) const;
+  Vector3 crossprod_xyz(const Vector3 &a,
+                        const Vector3 &b) const;
 
  private:
   ufo::Variables invars_;
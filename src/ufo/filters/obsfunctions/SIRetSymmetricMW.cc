@@ -10,6 +10,7 @@
 #include "ioda/ObsDataVector.h"
 #include "oops/base/Variables.h"
 #include "ufo/filters/ObsFilterData.h"
+#include "ufo/filters/Variable.h"
 #include "ufo/filters/obsfunctions/SIRetMW.h"
 #include "ufo/utils/Constants.h"
 
@@ -42,7 +43,9 @@ void SIRetSymmetricMW::compute(const ObsFilterData & in,
   SIRetMW siretfunc(conf_);
   oops::Variables sivars(siretfunc.siVariableGroups());
   ioda::ObsDataVector<float> siret(in.obsspace(), sivars, "ObsFunction", false);
-  siretfunc.compute(in, siret);
+  // Retrieve them through ObsFilterData, so that they are taken from the ObsFunction cache (if
+  // any) when they have already been computed with the same options, e.g. by another filter.
+  in.get(Variable("SIRetMW@ObsFunction", conf_), siret);
 
   // Get symmetric SI amount
   for (size_t iloc = 0; iloc < nlocs; ++iloc) {
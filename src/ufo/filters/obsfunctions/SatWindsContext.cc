@@ -0,0 +1,65 @@
+/*
+ * (C) Copyright 2020 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/obsfunctions/SatWindsContext.h"
+
+#include <cmath>
+
+#include "oops/util/missingValues.h"
+#include "ufo/filters/ObsFilterData.h"
+#include "ufo/filters/Variable.h"
+#include "ufo/filters/Variables.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+void SatWindsContext::addRequiredVariables(const std::string & hofxGroup, Variables & vars) {
+  vars += Variable("eastward_wind@ObsValue");
+  vars += Variable("northward_wind@ObsValue");
+  vars += Variable("eastward_wind@" + hofxGroup);
+  vars += Variable("northward_wind@" + hofxGroup);
+}
+
+// -----------------------------------------------------------------------------
+
+SatWindsContext::SatWindsContext(const ObsFilterData & in, const std::string & hofxGroup) {
+  const size_t nlocs = in.nlocs();
+  const float missing = util::missingValue(missing);
+
+  in.get(Variable("eastward_wind@ObsValue"), u);
+  in.get(Variable("northward_wind@ObsValue"), v);
+  in.get(Variable("eastward_wind@" + hofxGroup), um);
+  in.get(Variable("northward_wind@" + hofxGroup), vm);
+
+  valid.resize(nlocs);
+  obsSpeedSquared.resize(nlocs);
+  obsSpeed.resize(nlocs);
+  modelSpeed.resize(nlocs);
+  vectorDifference.resize(nlocs);
+
+  for (size_t jj = 0; jj < nlocs; ++jj)
+    valid[jj] = u[jj] != missing && v[jj] != missing;
+
+  // The derived quantities are computed at all locations so that this loop has no branches and
+  // can be vectorised. Zeros are substituted for the wind components at invalid locations to
+  // avoid floating-point overflows there.
+  for (size_t jj = 0; jj < nlocs; ++jj) {
+    const float uo = valid[jj] ? u[jj] : 0.0f;
+    const float vo = valid[jj] ? v[jj] : 0.0f;
+    const float ub = valid[jj] ? um[jj] : 0.0f;
+    const float vb = valid[jj] ? vm[jj] : 0.0f;
+    obsSpeedSquared[jj] = uo*uo + vo*vo;
+    obsSpeed[jj] = std::sqrt(obsSpeedSquared[jj]);
+    modelSpeed[jj] = std::sqrt(ub*ub + vb*vb);
+    vectorDifference[jj] = std::sqrt((uo-ub)*(uo-ub) + (vo-vb)*(vo-vb));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
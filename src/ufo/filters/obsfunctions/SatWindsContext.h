@@ -0,0 +1,54 @@
+/*
+ * (C) Copyright 2020 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_OBSFUNCTIONS_SATWINDSCONTEXT_H_
+#define UFO_FILTERS_OBSFUNCTIONS_SATWINDSCONTEXT_H_
+
+#include <string>
+#include <vector>
+
+namespace ufo {
+class ObsFilterData;
+class Variables;
+
+/// \brief Observed and model wind components of SatWinds observations and the quantities derived
+/// from them that are used by several SatWinds checks.
+///
+/// All derived quantities are computed at once, in a loop without branches over all locations,
+/// so the checks only need to combine them. They are set to zero-wind values at invalid locations.
+class SatWindsContext {
+ public:
+  /// \brief Add the variables needed to build a SatWindsContext to \p vars.
+  ///
+  /// \param hofxGroup
+  ///   Group holding the model wind components (normally HofX).
+  static void addRequiredVariables(const std::string & hofxGroup, Variables & vars);
+
+  SatWindsContext(const ObsFilterData & in, const std::string & hofxGroup);
+
+  /// True if both observed wind components are present at location \p jloc.
+  bool isValid(size_t jloc) const { return valid[jloc] != 0; }
+
+  /// Observed wind components.
+  std::vector<float> u, v;
+  /// Model wind components.
+  std::vector<float> um, vm;
+  /// 1 at locations with both observed wind components present, 0 elsewhere.
+  std::vector<char> valid;
+  /// Squared observed wind speed.
+  std::vector<float> obsSpeedSquared;
+  /// Observed wind speed.
+  std::vector<float> obsSpeed;
+  /// Model wind speed.
+  std::vector<float> modelSpeed;
+  /// Magnitude of the difference between the observed and model wind vectors.
+  std::vector<float> vectorDifference;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_OBSFUNCTIONS_SATWINDSCONTEXT_H_
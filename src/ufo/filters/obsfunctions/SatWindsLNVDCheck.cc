@@ -7,12 +7,12 @@
 
 #include "ufo/filters/obsfunctions/SatWindsLNVDCheck.h"
 
-#include <math.h>
-#include <vector>
+#include <cmath>
 
 #include "ioda/ObsDataVector.h"
 #include "oops/util/missingValues.h"
 #include "ufo/filters/ObsFilterData.h"
+#include "ufo/filters/obsfunctions/SatWindsContext.h"
 #include "ufo/filters/Variable.h"
 
 namespace ufo {
@@ -27,14 +27,9 @@ SatWindsLNVDCheck::SatWindsLNVDCheck(const eckit::LocalConfiguration & conf)
   // Initialize options
   options_.deserialize(conf);
 
-  // We need to retrieve the observed wind components.
-  invars_ += Variable("eastward_wind@ObsValue");
-  invars_ += Variable("northward_wind@ObsValue");
-
+  // We need to retrieve the observed and model wind components.
   // Typical use would be HofX group, but during testing, we include option for GsiHofX
-  std::string test_hofx = options_.test_hofx.value();
-  invars_ += Variable("eastward_wind@" + test_hofx);
-  invars_ += Variable("northward_wind@" + test_hofx);
+  SatWindsContext::addRequiredVariables(options_.test_hofx.value(), invars_);
 
   // TODO(gthompsn): Need to include a check that whatever HofX group name used actually exists.
 }
@@ -53,23 +48,15 @@ void SatWindsLNVDCheck::compute(const ObsFilterData & in,
   // Ensure that only one output variable is expected.
   ASSERT(out.nvars() == 1);
 
-  // Retrieve SatWinds observations of wind components
-  std::vector<float> u, v;
-  in.get(Variable("eastward_wind@ObsValue"), u);
-  in.get(Variable("northward_wind@ObsValue"), v);
-  // Retrieve Model HofX wind components
-  std::string test_hofx = options_.test_hofx.value();
-  std::vector<float> um, vm;
-  in.get(Variable("eastward_wind@" + test_hofx), um);
-  in.get(Variable("northward_wind@" + test_hofx), vm);
+  // Retrieve SatWinds observed and model wind components and derived quantities
+  const SatWindsContext winds(in, options_.test_hofx.value());
 
   for (size_t jj = 0; jj < nlocs; ++jj) {
-    if (u[jj] != missing && v[jj] != missing) {
-      if ((u[jj]*u[jj] + v[jj]*v[jj]) > 1.01f) {
-        out[0][jj] = sqrt((u[jj]-um[jj])*(u[jj]-um[jj]) + (v[jj]-vm[jj])*(v[jj]-vm[jj]))
-                    / log(sqrt(u[jj]*u[jj] + v[jj]*v[jj]));
+    if (winds.isValid(jj)) {
+      if (winds.obsSpeedSquared[jj] > 1.01f) {
+        out[0][jj] = winds.vectorDifference[jj] / std::log(winds.obsSpeed[jj]);
       } else {
-        out[0][jj] = sqrt((u[jj]-um[jj])*(u[jj]-um[jj]) + (v[jj]-vm[jj])*(v[jj]-vm[jj]));
+        out[0][jj] = winds.vectorDifference[jj];
       }
     } else {
       out[0][jj] = missing;
@@ -8,12 +8,11 @@
 #include "ufo/filters/obsfunctions/SatWindsSPDBCheck.h"
 
 #include <algorithm>
-#include <cmath>
 #include <vector>
 
 #include "ioda/ObsDataVector.h"
-#include "oops/util/missingValues.h"
 #include "ufo/filters/ObsFilterData.h"
+#include "ufo/filters/obsfunctions/SatWindsContext.h"
 #include "ufo/filters/Variable.h"
 
 namespace ufo {
@@ -33,14 +32,9 @@ SatWindsSPDBCheck::SatWindsSPDBCheck(const eckit::LocalConfiguration & conf)
   const float error_max = options_.error_max.value();
   ASSERT(error_min < error_max);
 
-  // We need to retrieve the observed wind components.
-  invars_ += Variable("eastward_wind@ObsValue");
-  invars_ += Variable("northward_wind@ObsValue");
-
+  // We need to retrieve the observed and model wind components.
   // Typical use would be HofX group, but during testing, we include option for GsiHofX
-  std::string test_hofx = options_.test_hofx.value();
-  invars_ += Variable("eastward_wind@" + test_hofx);
-  invars_ += Variable("northward_wind@" + test_hofx);
+  SatWindsContext::addRequiredVariables(options_.test_hofx.value(), invars_);
 
   // The starting (un-inflated) value of obserror. If running in sequence of filters,
   // then it is probably found in ObsErrorData, otherwise, it is probably ObsError.
@@ -59,9 +53,6 @@ SatWindsSPDBCheck::~SatWindsSPDBCheck() {}
 void SatWindsSPDBCheck::compute(const ObsFilterData & in,
                                   ioda::ObsDataVector<float> & out) const {
   const size_t nlocs = in.nlocs();
-  const float missing = util::missingValue(missing);
-  float spdb = 0.0f;
-  float residual = 0.0f;
   float obserr = 1.0f;
 
   // Ensure that only one output variable is expected.
@@ -71,15 +62,8 @@ void SatWindsSPDBCheck::compute(const ObsFilterData & in,
   const float error_min = options_.error_min.value();
   const float error_max = options_.error_max.value();
 
-  // Retrieve SatWinds observations of wind components
-  std::vector<float> u, v;
-  in.get(Variable("eastward_wind@ObsValue"), u);
-  in.get(Variable("northward_wind@ObsValue"), v);
-  // Retrieve Model HofX wind components
-  std::string test_hofx = options_.test_hofx.value();
-  std::vector<float> um, vm;
-  in.get(Variable("eastward_wind@" + test_hofx), um);
-  in.get(Variable("northward_wind@" + test_hofx), vm);
+  // Retrieve SatWinds observed and model wind components and derived quantities
+  const SatWindsContext winds(in, options_.test_hofx.value());
 
   // Get original ObsError of eastward_wind (would make little sense if diff from northward)
   std::vector<float> currentObserr(nlocs);
@@ -88,13 +72,12 @@ void SatWindsSPDBCheck::compute(const ObsFilterData & in,
 
   for (size_t jj = 0; jj < nlocs; ++jj) {
     out[0][jj] = 0.0f;
-    if (u[jj] != missing && v[jj] != missing) {
-      spdb = sqrt(u[jj]*u[jj]+v[jj]*v[jj]) - sqrt(um[jj]*um[jj]+vm[jj]*vm[jj]);
+    if (winds.isValid(jj)) {
+      const float spdb = winds.obsSpeed[jj] - winds.modelSpeed[jj];
       if (spdb < 0.0f) {
         obserr = currentObserr[jj];
         obserr = std::max(error_min, std::min(obserr, error_max));
-        residual = sqrt((u[jj]-um[jj])*(u[jj]-um[jj]) + (v[jj]-vm[jj])*(v[jj]-vm[jj]));
-        out[0][jj] = residual/obserr;
+        out[0][jj] = winds.vectorDifference[jj]/obserr;
       }
     }
   }
@@ -9,6 +9,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -40,6 +42,53 @@ std::vector<bool> identifyRejectedObservations(const ObsFilterData &data) {
   return rejected;
 }
 
+/// Quantities needed by SolarZenith that depend only on the date (not time).
+struct SolarDayConstants {
+  /// Equation of time (hours).
+  double eqnt;
+  /// Sine and cosine of the solar declination.
+  double sinDecl;
+  double cosDecl;
+};
+
+/// Return the solar constants for the day \p centuryDay days after 31 Dec 1899 ("0 Jan 1900").
+/// (Used instead of 1 Jan 1900 since 2000 was a leap year.)
+SolarDayConstants solarDayConstants(int64_t centuryDay) {
+  const double centuriesPerDay = 1.0 / 36525.0;
+  const double hoursPerSecond = 1.0 / 3600.0;
+  const double one_over_360 = 1.0 / 360.0;
+
+  const double rcd = centuryDay * centuriesPerDay;  // Fraction of days elapsed this century
+  const double rcd2 = rcd * rcd;
+  double ydeg = (rcd * 36000.769 + 279.697) * one_over_360;
+  ydeg = std::fmod(ydeg, 1.0) * 360.0;
+  const double yrad = ydeg * Constants::deg2rad;
+
+  // Compute equation of time (in seconds) for this day
+  // (No reference for this but it gives the correct answers
+  // when compared with table in Norton's Star Atlas.)
+  // The linter protests about extra spaces used for alignment, so is disabled.
+  const double eqnt =
+         - (( 93.0 + 14.23 * rcd - 0.0144 * rcd2) * std::sin(yrad))         // NOLINT
+         - ((432.5 - 3.71  * rcd - 0.2063 * rcd2) * std::cos(yrad))         // NOLINT
+         + ((596.9 - 0.81  * rcd - 0.0096 * rcd2) * std::sin(2.0 * yrad))   // NOLINT
+         - ((  1.4 + 0.28  * rcd)                 * std::cos(2.0 * yrad))   // NOLINT
+         + ((  3.8 + 0.6   * rcd)                 * std::sin(3.0 * yrad))   // NOLINT
+         + (( 19.5 - 0.21  * rcd - 0.0103 * rcd2) * std::cos(3.0 * yrad))   // NOLINT
+         - (( 12.8 - 0.03  * rcd)                 * std::sin(4.0 * yrad));  // NOLINT
+
+  // Get solar declination for given day (radians)
+  const double sinalp = std::sin((ydeg - eqnt / 240.0) * Constants::deg2rad);
+  const double taneqn = 0.43382 - 0.00027 * rcd;
+  const double decl = std::atan(taneqn * sinalp);
+
+  SolarDayConstants constants;
+  constants.eqnt = eqnt * hoursPerSecond;  // Convert to hours
+  constants.sinDecl = std::sin(decl);
+  constants.cosDecl = std::cos(decl);
+  return constants;
+}
+
 }  // namespace
 
 static ObsFunctionMaker<SolarZenith> maker_("SolarZenith");
@@ -57,14 +106,17 @@ void SolarZenith::compute(const ObsFilterData & in, ioda::ObsDataVector<float> &
   const float missingFloat = util::missingValue(float());
   const util::DateTime missingDateTime = util::missingValue(util::DateTime());
 
-  const int secondsPerDay = 60 * 60 * 24;
-  const double centuriesPerDay = 1.0 / 36525.0;
+  const int64_t secondsPerDay = 60 * 60 * 24;
   const double hoursPerSecond = 1.0 / 3600.0;
   const double degreesLongitudePerHour = 15.0;
   const double hoursPerDegreeLongitude = 1.0 / degreesLongitudePerHour;
-  const double one_over_360 = 1.0 / 360.0;
 
   const util::DateTime startOfLastDayOf19thCentury(1899, 12, 31, 0, 0, 0);
+  // The formulas are valid for years from 1951 to 2200.
+  const int64_t firstValidSecond =
+      (util::DateTime(1951, 1, 1, 0, 0, 0) - startOfLastDayOf19thCentury).toSeconds();
+  const int64_t lastValidSecond =
+      (util::DateTime(2201, 1, 1, 0, 0, 0) - startOfLastDayOf19thCentury).toSeconds() - 1;
 
   const size_t nlocs = in.nlocs();
 
@@ -92,13 +144,18 @@ void SolarZenith::compute(const ObsFilterData & in, ioda::ObsDataVector<float> &
   size_t numOutOfRangeLats = 0;
   size_t numOutOfRangeDatetimes = 0;
 
-  // Values dependent on day only (reused for all consecutive datetimes from the same day)
-  util::DateTime dayStart = missingDateTime;
-  util::DateTime dayEnd = missingDateTime;
-  // Equation of time (more details below)
-  double eqnt;
-  // Sine and cosine of declination
-  double sinDecl, cosDecl;
+  // Locations at which the zenith angle can be computed, the days on which they were observed
+  // (indices in dayConstants) and the numbers of seconds elapsed since the start of these days.
+  std::vector<size_t> validLocs;
+  std::vector<size_t> validLocDays;
+  std::vector<int64_t> validLocSecondsSinceDayStart;
+  validLocs.reserve(nlocs);
+  validLocDays.reserve(nlocs);
+  validLocSecondsSinceDayStart.reserve(nlocs);
+
+  // Values dependent on day only, computed once for each distinct day
+  std::vector<SolarDayConstants> dayConstants;
+  std::map<int64_t, size_t> dayConstantsIndex;
 
   for (size_t loc = 0; loc < nlocs; ++loc) {
     if (skipRejected && rejected[loc]) {
@@ -132,55 +189,30 @@ void SolarZenith::compute(const ObsFilterData & in, ioda::ObsDataVector<float> &
       continue;
     }
 
-    const util::DateTime &datetime = datetimes[loc];
-
-    if (datetime < dayStart || datetime >= dayEnd) {
-      // Calculate quantities dependent only on the date (not time).
-      int year, month, day, hour, minute, second;
-      datetime.toYYYYMMDDhhmmss(year, month, day, hour, minute, second);
-      if (year > 1950 && year <= 2200) {
-        dayStart = util::DateTime(year, month, day, 0, 0, 0);
-        dayEnd = dayStart + util::Duration(secondsPerDay);
-
-        // Day since 31 Dec 1899 ("0 Jan 1900")
-        // (Used instead of 1 Jan 1900 since 2000 was a leap year.)
-        const std::size_t centuryDay =
-            (dayStart - startOfLastDayOf19thCentury).toSeconds() / secondsPerDay;
-        const double rcd = centuryDay * centuriesPerDay;  // Fraction of days elapsed this century
-        const double rcd2 = rcd * rcd;
-        double ydeg = (rcd * 36000.769 + 279.697) * one_over_360;
-        ydeg = std::fmod(ydeg, 1.0) * 360.0;
-        const double yrad = ydeg * Constants::deg2rad;
-
-        // Compute equation of time (in seconds) for this day
-        // (No reference for this but it gives the correct answers
-        // when compared with table in Norton's Star Atlas.)
-        // The linter protests about extra spaces used for alignment, so is disabled.
-        eqnt = - (( 93.0 + 14.23 * rcd - 0.0144 * rcd2) * std::sin(yrad))         // NOLINT
-               - ((432.5 - 3.71  * rcd - 0.2063 * rcd2) * std::cos(yrad))         // NOLINT
-               + ((596.9 - 0.81  * rcd - 0.0096 * rcd2) * std::sin(2.0 * yrad))   // NOLINT
-               - ((  1.4 + 0.28  * rcd)                 * std::cos(2.0 * yrad))   // NOLINT
-               + ((  3.8 + 0.6   * rcd)                 * std::sin(3.0 * yrad))   // NOLINT
-               + (( 19.5 - 0.21  * rcd - 0.0103 * rcd2) * std::cos(3.0 * yrad))   // NOLINT
-               - (( 12.8 - 0.03  * rcd)                 * std::sin(4.0 * yrad));  // NOLINT
-
-        // Get solar declination for given day (radians)
-        const double sinalp = std::sin((ydeg - eqnt / 240.0) * Constants::deg2rad);
-        const double taneqn = 0.43382 - 0.00027 * rcd;
-        const double decl = std::atan(taneqn * sinalp);
-        eqnt *= hoursPerSecond;  // Convert to hours
-
-        // Sine and cosine of declination
-        sinDecl = std::sin(decl);
-        cosDecl = std::cos(decl);
-      } else {
-        ++numOutOfRangeDatetimes;
-        oops::Log::debug() << "SolarZenith: date/time " << datetime << " of ob " << loc
-                           << "is out of range. Output set to missing data\n";
-        continue;
-      }
+    const int64_t secondsSinceCenturyStart =
+        (datetimes[loc] - startOfLastDayOf19thCentury).toSeconds();
+    if (secondsSinceCenturyStart < firstValidSecond ||
+        secondsSinceCenturyStart > lastValidSecond) {
+      ++numOutOfRangeDatetimes;
+      oops::Log::debug() << "SolarZenith: date/time " << datetimes[loc] << " of ob " << loc
+                         << "is out of range. Output set to missing data\n";
+      continue;
     }
 
+    const int64_t centuryDay = secondsSinceCenturyStart / secondsPerDay;
+    auto inserted = dayConstantsIndex.emplace(centuryDay, dayConstants.size());
+    if (inserted.second)
+      dayConstants.push_back(solarDayConstants(centuryDay));
+
+    validLocs.push_back(loc);
+    validLocDays.push_back(inserted.first->second);
+    validLocSecondsSinceDayStart.push_back(secondsSinceCenturyStart - centuryDay * secondsPerDay);
+  }
+
+  for (size_t i = 0; i < validLocs.size(); ++i) {
+    const size_t loc = validLocs[i];
+    const SolarDayConstants &day = dayConstants[validLocDays[i]];
+
     const double lat = lats[loc];
     const double lon = lons[loc];
 
@@ -188,15 +220,15 @@ void SolarZenith::compute(const ObsFilterData & in, ioda::ObsDataVector<float> &
     const double sinLat = std::sin(latInRadians);
     const double cosLat = std::cos(latInRadians);
 
-    const std::int64_t secondsSinceDayStart = (datetime - dayStart).toSeconds();
-    const double hoursSinceDayStart = secondsSinceDayStart * hoursPerSecond;
-    const double localSolarTimeInHours = lon * hoursPerDegreeLongitude + eqnt + hoursSinceDayStart;
+    const double hoursSinceDayStart = validLocSecondsSinceDayStart[i] * hoursPerSecond;
+    const double localSolarTimeInHours =
+        lon * hoursPerDegreeLongitude + day.eqnt + hoursSinceDayStart;
     // Local hour angle (when longitude is 0, this is the Greenwich hour angle given in the
     // Air Almanac)
     const double hourAngleInRadians =
         (localSolarTimeInHours * degreesLongitudePerHour + 180.0) * Constants::deg2rad;
 
-    const double sinEv = sinDecl * sinLat + cosDecl * cosLat * std::cos(hourAngleInRadians);
+    const double sinEv = day.sinDecl * sinLat + day.cosDecl * cosLat * std::cos(hourAngleInRadians);
     zenith[loc] = (M_PI / 2 - std::asin(sinEv)) * Constants::rad2deg;
   }
 
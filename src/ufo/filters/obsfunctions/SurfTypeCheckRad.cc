@@ -20,6 +20,7 @@
 #include "ioda/ObsDataVector.h"
 #include "oops/util/IntSetParser.h"
 #include "oops/util/missingValues.h"
+#include "ufo/filters/obsfunctions/SurfaceClassRad.h"
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/Constants.h"
 
@@ -48,11 +49,8 @@ SurfTypeCheckRad::SurfTypeCheckRad(const eckit::LocalConfiguration & conf)
   invars_ += Variable("brightness_temperature@"+errgrp, channels_);
   invars_ += Variable("brightness_temperature@"+flaggrp, channels_);
 
-  // Include list of required data from GeoVaLs
-  invars_ += Variable("water_area_fraction@GeoVaLs");
-  invars_ += Variable("land_area_fraction@GeoVaLs");
-  invars_ += Variable("ice_area_fraction@GeoVaLs");
-  invars_ += Variable("surface_snow_area_fraction@GeoVaLs");
+  // Include dominant surface types (derived from GeoVaLs)
+  invars_ += SurfaceClassRad::variable();
 }
 
 // -----------------------------------------------------------------------------
@@ -71,21 +69,10 @@ void SurfTypeCheckRad::compute(const ObsFilterData & in,
   size_t nlocs = in.nlocs();
   size_t nchans = channels_.size();
 
-  // Get area fraction of each surface type
-  std::vector<float> water_frac(nlocs);
-  std::vector<float> land_frac(nlocs);
-  std::vector<float> ice_frac(nlocs);
-  std::vector<float> snow_frac(nlocs);
-  in.get(Variable("water_area_fraction@GeoVaLs"), water_frac);
-  in.get(Variable("land_area_fraction@GeoVaLs"), land_frac);
-  in.get(Variable("ice_area_fraction@GeoVaLs"), ice_frac);
-  in.get(Variable("surface_snow_area_fraction@GeoVaLs"), snow_frac);
-
-  bool sea = true;
-  bool land = false;
-  bool ice = false;
-  bool snow = false;
-  bool mixed = false;
+  // Get dominant surface types in each FOV
+  std::vector<int> surfclass(nlocs);
+  in.get(SurfaceClassRad::variable(), surfclass);
+
   size_t iwater_det = 0;
   size_t iland_det = 0;
   size_t isnow_det = 0;
@@ -127,22 +114,18 @@ void SurfTypeCheckRad::compute(const ObsFilterData & in,
        iice_det = bin[4];
        iwater_det = bin[5];
 
+       // Surface types over which this channel is rejected
+       const int rejectedSurfaces = (iwater_det > 0) * SurfaceClassRadBits::sea |
+                                    (iland_det > 0) * SurfaceClassRadBits::land |
+                                    (isnow_det > 0) * SurfaceClassRadBits::snow |
+                                    (iice_det > 0) * SurfaceClassRadBits::ice |
+                                    (imix_det > 0) * SurfaceClassRadBits::mixed;
+
        for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-         sea = water_frac[iloc] >= 0.99;
-         land = land_frac[iloc] >= 0.99;
-         ice = ice_frac[iloc] >= 0.99;
-         snow = snow_frac[iloc] >= 0.99;
-         mixed = (!sea && !land && !ice && !snow);
          if (flaggrp == "PreQC")
                   obserrdata[iloc] == missing ? qcflagdata[iloc] = 100 : qcflagdata[iloc] = 0;
          (qcflagdata[iloc] == 0) ? (varinv = 1.0 / pow(obserrdata[iloc], 2)) : (varinv = 0.0);
-         if (varinv > 0.0) {
-           if (sea && iwater_det > 0)  out[ichan][iloc] = 1.0;
-           else if (land && iland_det > 0)  out[ichan][iloc] = 1.0;
-           else if (snow && isnow_det > 0)  out[ichan][iloc] = 1.0;
-           else if (ice && iice_det > 0)  out[ichan][iloc] = 1.0;
-           else if (mixed && imix_det > 0)  out[ichan][iloc] = 1.0;
-         }
+         if (varinv > 0.0 && (surfclass[iloc] & rejectedSurfaces))  out[ichan][iloc] = 1.0;
        }
     }
   }
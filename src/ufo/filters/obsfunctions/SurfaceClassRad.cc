@@ -0,0 +1,68 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/filters/obsfunctions/SurfaceClassRad.h"
+
+#include <vector>
+
+#include "ioda/ObsDataVector.h"
+#include "ufo/filters/Variable.h"
+
+namespace ufo {
+
+static ObsFunctionMaker<SurfaceClassRad> makerSurfaceClassRad_("SurfaceClassRad");
+
+// -----------------------------------------------------------------------------
+
+SurfaceClassRad::SurfaceClassRad(const eckit::LocalConfiguration & conf)
+  : invars_() {
+  // Include list of required data from GeoVaLs
+  invars_ += Variable("water_area_fraction@GeoVaLs");
+  invars_ += Variable("land_area_fraction@GeoVaLs");
+  invars_ += Variable("ice_area_fraction@GeoVaLs");
+  invars_ += Variable("surface_snow_area_fraction@GeoVaLs");
+}
+
+// -----------------------------------------------------------------------------
+
+SurfaceClassRad::~SurfaceClassRad() {}
+
+// -----------------------------------------------------------------------------
+
+void SurfaceClassRad::compute(const ObsFilterData & in,
+                              ioda::ObsDataVector<int> & out) const {
+  const size_t nlocs = in.nlocs();
+
+  // Get area fraction of each surface type
+  std::vector<float> water_frac(nlocs);
+  std::vector<float> land_frac(nlocs);
+  std::vector<float> ice_frac(nlocs);
+  std::vector<float> snow_frac(nlocs);
+  in.get(Variable("water_area_fraction@GeoVaLs"), water_frac);
+  in.get(Variable("land_area_fraction@GeoVaLs"), land_frac);
+  in.get(Variable("ice_area_fraction@GeoVaLs"), ice_frac);
+  in.get(Variable("surface_snow_area_fraction@GeoVaLs"), snow_frac);
+
+  // Set the bit of each dominant surface type without branching
+  for (size_t iloc = 0; iloc < nlocs; ++iloc) {
+    const int surfclass = (water_frac[iloc] >= 0.99) * SurfaceClassRadBits::sea |
+                          (land_frac[iloc] >= 0.99) * SurfaceClassRadBits::land |
+                          (ice_frac[iloc] >= 0.99) * SurfaceClassRadBits::ice |
+                          (snow_frac[iloc] >= 0.99) * SurfaceClassRadBits::snow;
+    out[0][iloc] = surfclass | (surfclass == 0) * SurfaceClassRadBits::mixed;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+const ufo::Variables & SurfaceClassRad::requiredVariables() const {
+  return invars_;
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
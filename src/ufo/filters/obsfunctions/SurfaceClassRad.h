@@ -0,0 +1,66 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_FILTERS_OBSFUNCTIONS_SURFACECLASSRAD_H_
+#define UFO_FILTERS_OBSFUNCTIONS_SURFACECLASSRAD_H_
+
+#include <string>
+
+#include "ufo/filters/ObsFilterData.h"
+#include "ufo/filters/obsfunctions/ObsFunctionBase.h"
+#include "ufo/filters/Variable.h"
+#include "ufo/filters/Variables.h"
+
+namespace ufo {
+
+/// Bits of the surface class computed by the SurfaceClassRad ObsFunction.
+namespace SurfaceClassRadBits {
+  /// Water area fraction >= 0.99.
+  constexpr int sea = 1;
+  /// Land area fraction >= 0.99.
+  constexpr int land = 2;
+  /// Ice area fraction >= 0.99.
+  constexpr int ice = 4;
+  /// Snow area fraction >= 0.99.
+  constexpr int snow = 8;
+  /// None of the above.
+  constexpr int mixed = 16;
+}  // namespace SurfaceClassRadBits
+
+///
+/// \brief Classify the surface in the field of view of radiance observations using the model
+/// area fractions of water, land, ice and snow.
+///
+/// The output at each location is the bitwise OR of the SurfaceClassRadBits constants of all
+/// surface types covering at least 99% of the area (or SurfaceClassRadBits::mixed if there are
+/// none). Each radiance ObsFunction using this classification decides for itself which type
+/// prevails if several bits are set.
+///
+/// Filters enabling the `cache obs functions` option compute the classification only once per
+/// ObsSpace and filter stage, however many ObsFunctions use it.
+///
+class SurfaceClassRad : public ObsFunctionBase<int> {
+ public:
+  explicit SurfaceClassRad(const eckit::LocalConfiguration & = eckit::LocalConfiguration());
+  ~SurfaceClassRad();
+
+  void compute(const ObsFilterData &,
+               ioda::ObsDataVector<int> &) const;
+  const ufo::Variables & requiredVariables() const;
+
+  /// The variable identifying this ObsFunction.
+  static Variable variable() {return Variable("SurfaceClassRad@IntObsFunction");}
+
+ private:
+  ufo::Variables invars_;
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
+
+#endif  // UFO_FILTERS_OBSFUNCTIONS_SURFACECLASSRAD_H_
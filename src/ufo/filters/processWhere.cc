@@ -7,20 +7,23 @@
 
 #include "ufo/filters/processWhere.h"
 
+#include <algorithm>
 #include <bitset>
+#include <map>
 #include <regex>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "eckit/types/FloatCompare.h"
 #include "ioda/ObsSpace.h"
-#include "oops/util/IntSetParser.h"
 #include "oops/util/Logger.h"
 #include "oops/util/missingValues.h"
-#include "oops/util/wildcard.h"
 #include "ufo/filters/DiagnosticFlag.h"
 #include "ufo/filters/ObsFilterData.h"
+#include "ufo/filters/ObsFunctionCache.h"
 #include "ufo/filters/Variables.h"
 
 namespace ufo {
@@ -38,6 +41,36 @@ ufo::Variables getAllWhereVariables(const std::vector<WhereParameters> & params)
   return vars;
 }
 
+// -----------------------------------------------------------------------------
+template <typename T>
+const std::vector<T> & WhereData::get(const Variable & varname) {
+  std::map<std::string, std::vector<T>> & values = this->values<T>();
+  const std::string key = ObsFunctionCache::key(varname);
+  auto it = values.find(key);
+  if (it == values.end()) {
+    it = values.emplace(key, std::vector<T>()).first;
+    filterdata_.get(varname, it->second);
+  }
+  return it->second;
+}
+
+template <>
+std::map<std::string, std::vector<int>> & WhereData::values<int>() {return intValues_;}
+template <>
+std::map<std::string, std::vector<float>> & WhereData::values<float>() {return floatValues_;}
+template <>
+std::map<std::string, std::vector<std::string>> & WhereData::values<std::string>() {
+  return stringValues_;
+}
+template <>
+std::map<std::string, std::vector<util::DateTime>> & WhereData::values<util::DateTime>() {
+  return dateTimeValues_;
+}
+template <>
+std::map<std::string, std::vector<DiagnosticFlag>> & WhereData::values<DiagnosticFlag>() {
+  return flagValues_;
+}
+
 
 // -----------------------------------------------------------------------------
 template<typename T>
@@ -73,12 +106,11 @@ void processWhereMinMax(const std::vector<util::DateTime> & data,
 
 // -----------------------------------------------------------------------------
 template<typename T>
-void processWhereIsDefined(const ObsFilterData & filterdata,
+void processWhereIsDefined(WhereData & whereData,
                            const Variable & varname,
                            std::vector<bool> & mask) {
   const T missing = util::missingValue(missing);
-  std::vector<T> data;
-  filterdata.get(varname, data);
+  const std::vector<T> & data = whereData.get<T>(varname);
   for (size_t jj = 0; jj < data.size(); ++jj) {
     if (data[jj] == missing) mask[jj] = false;
   }
@@ -86,24 +118,39 @@ void processWhereIsDefined(const ObsFilterData & filterdata,
 
 // -----------------------------------------------------------------------------
 template<typename T>
-void processWhereIsNotDefined(const ObsFilterData & filterdata,
+void processWhereIsNotDefined(WhereData & whereData,
                               const Variable & varname,
                               std::vector<bool> & mask) {
   const T missing = util::missingValue(missing);
-  std::vector<T> data;
-  filterdata.get(varname, data);
+  const std::vector<T> & data = whereData.get<T>(varname);
   for (size_t jj = 0; jj < data.size(); ++jj) {
     if (data[jj] != missing) mask[jj] = false;
   }
 }
 
 // -----------------------------------------------------------------------------
-template <class T>
-void processWhereIsIn(const std::vector<T> & data,
-                      const std::set<T> & whitelist,
-                      std::vector<bool> & mask) {
+/// \brief Set to `false` all elements of `where` corresponding to elements of `data` for which
+/// `test` returns false.
+///
+/// `test` is evaluated only once per distinct value of `data` (e.g. once per station ID rather
+/// than once per observation). Elements equal to the preceding one, as in data grouped into
+/// records, reuse its result without a lookup.
+template <class T, class Test>
+void processWhereDistinctValues(const std::vector<T> & data, const Test & test,
+                                std::vector<bool> & where) {
+  std::unordered_map<T, bool> results;
+  const T * previous = nullptr;
+  bool previousResult = true;
   for (size_t jj = 0; jj < data.size(); ++jj) {
-    if (!oops::contains(whitelist, data[jj])) mask[jj] = false;
+    if (!where[jj]) continue;
+    if (previous == nullptr || data[jj] != *previous) {
+      auto it = results.find(data[jj]);
+      if (it == results.end())
+        it = results.emplace(data[jj], test(data[jj])).first;
+      previous = &data[jj];
+      previousResult = it->second;
+    }
+    if (!previousResult) where[jj] = false;
   }
 }
 
@@ -132,26 +179,6 @@ void processWhereIsClose(const std::vector<float> & data,
   }  // jj
 }
 
-// -----------------------------------------------------------------------------
-template <class T>
-void processWhereIsNotIn(const std::vector<T> & data,
-                         const std::set<T> & blacklist,
-                         std::vector<bool> & mask) {
-  const T missing = util::missingValue(missing);
-  for (size_t jj = 0; jj < data.size(); ++jj) {
-    if (data[jj] == missing || oops::contains(blacklist, data[jj])) mask[jj] = false;
-  }
-}
-
-// -----------------------------------------------------------------------------
-void processWhereIsNotIn(const std::vector<std::string> & data,
-                         const std::set<std::string> & blacklist,
-                         std::vector<bool> & mask) {
-  for (size_t jj = 0; jj < data.size(); ++jj) {
-    if (oops::contains(blacklist, data[jj])) mask[jj] = false;
-  }
-}
-
 // -----------------------------------------------------------------------------
 void processWhereIsNotClose(const std::vector<float> & data,
                             const float tolerance, const bool relative,
@@ -199,7 +226,7 @@ void processWhereIsFalse(const std::vector<DiagnosticFlag> & data,
 // -----------------------------------------------------------------------------
 template <typename T>
 void applyMinMax(std::vector<bool> & where, WhereParameters const & parameters,
-                 ObsFilterData const & filterdata, Variable const & varname) {
+                 WhereData & whereData, Variable const & varname) {
   const T not_set_value = util::missingValue(not_set_value);
 
   // Set vmin to the value of the 'minvalue' option if it exists; if not, leave vmin unchanged.
@@ -213,8 +240,7 @@ void applyMinMax(std::vector<bool> & where, WhereParameters const & parameters,
 
   // Apply mask min/max
   if (vmin != not_set_value || vmax != not_set_value) {
-    std::vector<T> data;
-    filterdata.get(varname, data);
+    const std::vector<T> & data = whereData.get<T>(varname);
     processWhereMinMax(data, vmin, vmax, where);
   }
 }
@@ -222,7 +248,7 @@ void applyMinMax(std::vector<bool> & where, WhereParameters const & parameters,
 // -----------------------------------------------------------------------------
 template <>
 void applyMinMax<util::DateTime>(std::vector<bool> & where, WhereParameters const & parameters,
-                                 ObsFilterData const & filterdata, Variable const & varname) {
+                                 WhereData & whereData, Variable const & varname) {
   util::PartialDateTime vmin {}, vmax {}, not_set_value {};
   if (parameters.minvalue.value() != boost::none)
     vmin = parameters.minvalue.value()->as<util::PartialDateTime>();
@@ -231,8 +257,7 @@ void applyMinMax<util::DateTime>(std::vector<bool> & where, WhereParameters cons
 
   // Apply mask min/max
   if (vmin != not_set_value || vmax != not_set_value) {
-    std::vector<util::DateTime> data;
-    filterdata.get(varname, data);
+    const std::vector<util::DateTime> & data = whereData.get<util::DateTime>(varname);
     processWhereMinMax(data, vmin, vmax, where);
   }
 }
@@ -305,10 +330,8 @@ void processWhereMatchesRegex(const std::vector<std::string> & data,
                               const std::string & pattern,
                               std::vector<bool> & where) {
   std::regex regex(pattern);
-  for (size_t jj = 0; jj < data.size(); ++jj) {
-    if (where[jj] && !std::regex_match(data[jj], regex))
-      where[jj] = false;
-  }
+  processWhereDistinctValues(data, [&regex] (const std::string & value)
+                             { return std::regex_match(value, regex); }, where);
 }
 
 /// \brief Process a `matches_regex` keyword in a `where` clause.
@@ -320,23 +343,90 @@ void processWhereMatchesRegex(const std::vector<int> & data,
                               const std::string & pattern,
                               std::vector<bool> & where) {
   std::regex regex(pattern);
-  for (size_t jj = 0; jj < data.size(); ++jj) {
-    if (where[jj] && !std::regex_match(std::to_string(data[jj]), regex))
-      where[jj] = false;
-  }
+  processWhereDistinctValues(data, [&regex] (int value)
+                             { return std::regex_match(std::to_string(value), regex); }, where);
 }
 
 // -----------------------------------------------------------------------------
-/// Returns true if `string` matches any of the patterns from the list `patterns`.
+/// \brief A pattern that may contain wildcards `*` (matching any sequence of characters) and `?`
+/// (matching a single character), analysed once so that it can be matched against many strings
+/// cheaply.
 ///
-/// The patterns may contain wildcards `*` (matching any sequence of characters) and `?` (matching
-/// a single character).
+/// Patterns without wildcards are matched by a string comparison and patterns whose only wildcard
+/// is a single leading or trailing `*` by comparing a suffix or prefix. Other patterns are matched
+/// by a linear scan with backtracking to the last `*`, without building a regular expression.
+class WildcardPattern {
+ public:
+  explicit WildcardPattern(const std::string & pattern) : pattern_(pattern) {
+    const size_t numStars = std::count(pattern_.begin(), pattern_.end(), '*');
+    const bool hasQuestionMarks = pattern_.find('?') != std::string::npos;
+    if (numStars == 0 && !hasQuestionMarks) {
+      kind_ = Kind::EXACT;
+    } else if (numStars == 1 && !hasQuestionMarks && pattern_.back() == '*') {
+      kind_ = Kind::PREFIX;
+      fixed_ = pattern_.substr(0, pattern_.size() - 1);
+    } else if (numStars == 1 && !hasQuestionMarks && pattern_.front() == '*') {
+      kind_ = Kind::SUFFIX;
+      fixed_ = pattern_.substr(1);
+    } else {
+      kind_ = Kind::GENERAL;
+    }
+  }
+
+  /// Returns true if the whole of `string` matches the pattern.
+  bool matches(const std::string & string) const {
+    switch (kind_) {
+    case Kind::EXACT:
+      return string == pattern_;
+    case Kind::PREFIX:
+      return string.compare(0, fixed_.size(), fixed_) == 0;
+    case Kind::SUFFIX:
+      return string.size() >= fixed_.size() &&
+             string.compare(string.size() - fixed_.size(), fixed_.size(), fixed_) == 0;
+    case Kind::GENERAL:
+      break;
+    }
+
+    size_t is = 0, ip = 0;
+    // Positions just after the last `*` met in the pattern and of the character of the string
+    // it was last assumed to stop matching at.
+    size_t starPos = std::string::npos, starMatch = 0;
+    while (is < string.size()) {
+      if (ip < pattern_.size() && (pattern_[ip] == '?' || pattern_[ip] == string[is])) {
+        ++is;
+        ++ip;
+      } else if (ip < pattern_.size() && pattern_[ip] == '*') {
+        starPos = ++ip;
+        starMatch = is;
+      } else if (starPos != std::string::npos) {
+        // Let the last `*` match one more character and try again.
+        ip = starPos;
+        is = ++starMatch;
+      } else {
+        return false;
+      }
+    }
+    while (ip < pattern_.size() && pattern_[ip] == '*')
+      ++ip;
+    return ip == pattern_.size();
+  }
+
+ private:
+  enum class Kind {EXACT, PREFIX, SUFFIX, GENERAL};
+
+  std::string pattern_;
+  /// Non-wildcard part of PREFIX and SUFFIX patterns.
+  std::string fixed_;
+  Kind kind_;
+};
+
+/// Returns true if `string` matches any of the patterns from the list `patterns`.
 bool stringMatchesAnyWildcardPattern(const std::string &string,
-                                     const std::vector<std::string> & patterns) {
+                                     const std::vector<WildcardPattern> & patterns) {
   return std::any_of(patterns.begin(),
                      patterns.end(),
-                     [&string] (const std::string &pattern)
-                     { return util::matchesWildcardPattern(string, pattern); });
+                     [&string] (const WildcardPattern &pattern)
+                     { return pattern.matches(string); });
 }
 
 /// \brief Function used to process a `matches_wildcard` or `matches_any_wildcard` keyword in a
@@ -347,57 +437,60 @@ bool stringMatchesAnyWildcardPattern(const std::string &string,
 /// `*` (matching any sequence of characters) and `?` (matching a single character). The vectors
 /// `data` and `where` must be of the same length.
 void processWhereMatchesAnyWildcardPattern(const std::vector<std::string> & data,
-                                           const std::vector<std::string> & patterns,
+                                           const std::vector<std::string> & patternStrings,
                                            std::vector<bool> & where) {
-  for (size_t jj = 0; jj < data.size(); ++jj) {
-    if (where[jj] && !stringMatchesAnyWildcardPattern(data[jj], patterns))
-      where[jj] = false;
-  }
+  const std::vector<WildcardPattern> patterns(patternStrings.begin(), patternStrings.end());
+  processWhereDistinctValues(data, [&patterns] (const std::string & value)
+                             { return stringMatchesAnyWildcardPattern(value, patterns); }, where);
 }
 
 /// \overload Same as the function above, but taking a vector of integers rather than strings.
 /// The integers are converted to strings before pattern matching.
 void processWhereMatchesAnyWildcardPattern(const std::vector<int> & data,
-                                           const std::vector<std::string> & patterns,
+                                           const std::vector<std::string> & patternStrings,
                                            std::vector<bool> & where) {
-  for (size_t jj = 0; jj < data.size(); ++jj) {
-    if (where[jj] && !stringMatchesAnyWildcardPattern(std::to_string(data[jj]), patterns))
-      where[jj] = false;
-  }
+  const std::vector<WildcardPattern> patterns(patternStrings.begin(), patternStrings.end());
+  processWhereDistinctValues(data, [&patterns] (int value)
+                             { return stringMatchesAnyWildcardPattern(std::to_string(value),
+                                                                      patterns); }, where);
 }
 
 // -----------------------------------------------------------------------------
 void isInString(std::vector<bool> & where, std::vector<std::string> const & allowedValues,
-                ObsFilterData const & filterdata, Variable const & varname) {
-  std::vector<std::string> data;
-  std::set<std::string> whitelist(allowedValues.begin(), allowedValues.end());
-  filterdata.get(varname, data);
-  processWhereIsIn(data, whitelist, where);
+                WhereData & whereData, Variable const & varname) {
+  const std::unordered_set<std::string> whitelist(allowedValues.begin(), allowedValues.end());
+  const std::vector<std::string> & data = whereData.get<std::string>(varname);
+  processWhereDistinctValues(data, [&whitelist] (const std::string & value)
+                             { return whitelist.count(value) != 0; }, where);
 }
 
 // -----------------------------------------------------------------------------
 void isInInteger(std::vector<bool> & where, std::set<int> const & allowedValues,
-                 ObsFilterData const & filterdata, Variable const & varname) {
-  std::vector<int> data;
-  filterdata.get(varname, data);
-  processWhereIsIn(data, allowedValues, where);
+                 WhereData & whereData, Variable const & varname) {
+  const std::unordered_set<int> whitelist(allowedValues.begin(), allowedValues.end());
+  const std::vector<int> & data = whereData.get<int>(varname);
+  processWhereDistinctValues(data, [&whitelist] (int value)
+                             { return whitelist.count(value) != 0; }, where);
 }
 
 // -----------------------------------------------------------------------------
 void isNotInString(std::vector<bool> & where, std::vector<std::string> const & forbiddenValues,
-                   ObsFilterData const & filterdata, Variable const & varname) {
-  std::vector<std::string> data;
-  std::set<std::string> blacklist(forbiddenValues.begin(), forbiddenValues.end());
-  filterdata.get(varname, data);
-  processWhereIsNotIn(data, blacklist, where);
+                   WhereData & whereData, Variable const & varname) {
+  const std::unordered_set<std::string> blacklist(forbiddenValues.begin(),
+                                                  forbiddenValues.end());
+  const std::vector<std::string> & data = whereData.get<std::string>(varname);
+  processWhereDistinctValues(data, [&blacklist] (const std::string & value)
+                             { return blacklist.count(value) == 0; }, where);
 }
 
 // -----------------------------------------------------------------------------
 void isNotInInteger(std::vector<bool> & where, std::set<int> const & forbiddenValues,
-                    ObsFilterData const & filterdata, Variable const & varname) {
-  std::vector<int> data;
-  filterdata.get(varname, data);
-  processWhereIsNotIn(data, forbiddenValues, where);
+                    WhereData & whereData, Variable const & varname) {
+  const int missing = util::missingValue(missing);
+  const std::unordered_set<int> blacklist(forbiddenValues.begin(), forbiddenValues.end());
+  const std::vector<int> & data = whereData.get<int>(varname);
+  processWhereDistinctValues(data, [&blacklist, missing] (int value)
+                             { return value != missing && blacklist.count(value) == 0; }, where);
 }
 
 void setWhereVector(std::vector<bool> & where,
@@ -425,6 +518,15 @@ void applyWhereOperator(const WhereOperator & whereOperator,
 std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
                                const ObsFilterData & filterdata,
                                const WhereOperator & whereOperator) {
+  WhereData whereData(filterdata);
+  return processWhere(params, whereData, whereOperator);
+}
+
+// -----------------------------------------------------------------------------
+std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
+                               WhereData & whereData,
+                               const WhereOperator & whereOperator) {
+  const ObsFilterData & filterdata = whereData.filterData();
   const size_t nlocs = filterdata.nlocs();
 
   // Vector to which all selection operations are applied.
@@ -444,6 +546,20 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
   if (params.empty())
     setWhereVector(where, true);
 
+  // Vector to which each operation is applied individually when the operator is `or`.
+  // With `and` the operations are applied directly to `where`, since each of them can only
+  // deselect locations; this avoids a separate pass to combine the result of each test.
+  std::vector<bool> whereTestOr(whereOperator == WhereOperator::OR ? nlocs : 0);
+  auto startTest = [&]() -> std::vector<bool> & {
+    if (whereOperator == WhereOperator::AND) return where;
+    setWhereVector(whereTestOr, true);
+    return whereTestOr;
+  };
+  auto finishTest = [&]() {
+    if (whereOperator == WhereOperator::OR)
+      applyWhereOperator(whereOperator, whereTestOr, where);
+  };
+
   for (const WhereParameters &currentParams : params) {
     const Variable &var = currentParams.variable;
     for (size_t jvar = 0; jvar < var.size(); ++jvar) {
@@ -451,34 +567,30 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
         const Variable varname = var[jvar];
         ioda::ObsDtype dtype = filterdata.dtype(varname);
 
-        // Vector to which each operation is applied individually.
-        // Set to `true` at the start of each test.
-        std::vector<bool> whereTest(nlocs);
-
 //      Apply mask min/max
         if (currentParams.minvalue.value() ||
             currentParams.maxvalue.value()) {
-          setWhereVector(whereTest, true);
+          std::vector<bool> & whereTest = startTest();
           if (dtype == ioda::ObsDtype::DateTime) {
-            applyMinMax<util::DateTime>(whereTest, currentParams, filterdata, varname);
+            applyMinMax<util::DateTime>(whereTest, currentParams, whereData, varname);
           } else if (dtype == ioda::ObsDtype::Integer) {
-            applyMinMax<int>(whereTest, currentParams, filterdata, varname);
+            applyMinMax<int>(whereTest, currentParams, whereData, varname);
           } else {
-            applyMinMax<float>(whereTest, currentParams, filterdata, varname);
+            applyMinMax<float>(whereTest, currentParams, whereData, varname);
           }
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
 
 //      Apply mask is_defined
         if (currentParams.isDefined.value()) {
-          setWhereVector(whereTest, true);
+          std::vector<bool> & whereTest = startTest();
           if (filterdata.has(varname)) {
             if (dtype == ioda::ObsDtype::Integer) {
-              processWhereIsDefined<int>(filterdata, varname, whereTest);
+              processWhereIsDefined<int>(whereData, varname, whereTest);
             } else if (dtype == ioda::ObsDtype::Float) {
-              processWhereIsDefined<float>(filterdata, varname, whereTest);
+              processWhereIsDefined<float>(whereData, varname, whereTest);
             } else if (dtype == ioda::ObsDtype::String) {
-              processWhereIsDefined<std::string>(filterdata, varname, whereTest);
+              processWhereIsDefined<std::string>(whereData, varname, whereTest);
             } else {
               throw eckit::UserError(
                 "Only integer, float and string variables may be used for processWhere "
@@ -488,50 +600,49 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
           } else {
             std::fill(whereTest.begin(), whereTest.end(), false);
           }
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
 
 //      Apply mask is_not_defined
         if (currentParams.isNotDefined.value()) {
-          setWhereVector(whereTest, true);
+          std::vector<bool> & whereTest = startTest();
           if (dtype == ioda::ObsDtype::Integer) {
-            processWhereIsNotDefined<int>(filterdata, varname, whereTest);
+            processWhereIsNotDefined<int>(whereData, varname, whereTest);
           } else if (dtype == ioda::ObsDtype::Float) {
-            processWhereIsNotDefined<float>(filterdata, varname, whereTest);
+            processWhereIsNotDefined<float>(whereData, varname, whereTest);
           } else if (dtype == ioda::ObsDtype::String) {
-            processWhereIsNotDefined<std::string>(filterdata, varname, whereTest);
+            processWhereIsNotDefined<std::string>(whereData, varname, whereTest);
           } else {
             throw eckit::UserError(
               "Only integer, float and string variables may be used for processWhere "
               "'is_not_defined'",
               Here());
           }
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
 
 //      Apply mask is_in
         if (currentParams.isIn.value() != boost::none) {
-          setWhereVector(whereTest, true);
+          std::vector<bool> & whereTest = startTest();
           if (dtype == ioda::ObsDtype::String) {
             isInString(whereTest, currentParams.isIn.value()->as<std::vector<std::string>>(),
-                       filterdata, varname);
+                       whereData, varname);
           } else if (dtype == ioda::ObsDtype::Integer) {
             isInInteger(whereTest, currentParams.isIn.value()->as<std::set<int>>(),
-                        filterdata, varname);
+                        whereData, varname);
           } else {
             throw eckit::UserError(
               "Only integer and string variables may be used for processWhere 'is_in'",
               Here());
           }
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
 
 //      Apply mask is_close
         if (currentParams.isClose.value() != boost::none) {
-          setWhereVector(whereTest, true);
+          std::vector<bool> & whereTest = startTest();
           if (dtype == ioda::ObsDtype::Float) {
-            std::vector<float> data;
-            filterdata.get(varname, data);
+            const std::vector<float> & data = whereData.get<float>(varname);
             if (currentParams.relativetolerance.value() == boost::none &&
                 currentParams.absolutetolerance.value() != boost::none) {
               processWhereIsClose(data, currentParams.absolutetolerance.value().get(),
@@ -550,32 +661,31 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
               "Only float variables may be used for processWhere 'is_close'",
               Here());
           }
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
 
 //      Apply mask is_not_in
         if (currentParams.isNotIn.value() != boost::none) {
-          setWhereVector(whereTest, true);
+          std::vector<bool> & whereTest = startTest();
           if (dtype == ioda::ObsDtype::String) {
             isNotInString(whereTest, currentParams.isNotIn.value()->as<std::vector<std::string>>(),
-                          filterdata, varname);
+                          whereData, varname);
           } else if (dtype == ioda::ObsDtype::Integer) {
             isNotInInteger(whereTest, currentParams.isNotIn.value()->as<std::set<int>>(),
-                           filterdata, varname);
+                           whereData, varname);
           } else {
             throw eckit::UserError(
               "Only integer and string variables may be used for processWhere 'is_not_in'",
               Here());
           }
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
 
 //      Apply mask is_not_close
         if (currentParams.isNotClose.value() != boost::none) {
-          setWhereVector(whereTest, true);
+          std::vector<bool> & whereTest = startTest();
           if (dtype == ioda::ObsDtype::Float) {
-            std::vector<float> data;
-            filterdata.get(varname, data);
+            const std::vector<float> & data = whereData.get<float>(varname);
             if (currentParams.relativetolerance.value() == boost::none &&
                 currentParams.absolutetolerance.value() != boost::none) {
               processWhereIsNotClose(data, currentParams.absolutetolerance.value().get(),
@@ -594,120 +704,110 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
               "Only float variables may be used for processWhere 'is_not_close'",
               Here());
           }
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
 
 //      Apply mask is_set
         if (currentParams.isTrue.value()) {
-          setWhereVector(whereTest, true);
+          std::vector<bool> & whereTest = startTest();
           if (filterdata.has(varname)) {
-            std::vector<DiagnosticFlag> data;
-            filterdata.get(varname, data);
+            const std::vector<DiagnosticFlag> & data = whereData.get<DiagnosticFlag>(varname);
             processWhereIsTrue(data, whereTest);
           } else {
             std::fill(whereTest.begin(), whereTest.end(), false);
           }
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
 
 //      Apply mask is_not_set
         if (currentParams.isFalse.value()) {
-          setWhereVector(whereTest, true);
-          std::vector<DiagnosticFlag> data;
-          filterdata.get(varname, data);
+          std::vector<bool> & whereTest = startTest();
+          const std::vector<DiagnosticFlag> & data = whereData.get<DiagnosticFlag>(varname);
           processWhereIsFalse(data, whereTest);
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
 
 //      Apply mask any_bit_set_of
         if (currentParams.anyBitSetOf.value() != boost::none) {
-          setWhereVector(whereTest, true);
+          std::vector<bool> & whereTest = startTest();
           if (dtype == ioda::ObsDtype::Integer) {
-            std::vector<int> data;
             const std::set<int> &bitIndices = *currentParams.anyBitSetOf.value();
-            filterdata.get(varname, data);
+            const std::vector<int> & data = whereData.get<int>(varname);
             processWhereAnyBitSetOf(data, bitIndices, whereTest);
           } else {
             throw eckit::UserError(
               "Only integer variables may be used for processWhere 'any_bit_set_of'",
               Here());
           }
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
 
 //      Apply mask any_bit_unset_of
         if (currentParams.anyBitUnsetOf.value() != boost::none) {
-          setWhereVector(whereTest, true);
+          std::vector<bool> & whereTest = startTest();
           if (dtype == ioda::ObsDtype::Integer) {
-            std::vector<int> data;
             const std::set<int> &bitIndices = *currentParams.anyBitUnsetOf.value();
-            filterdata.get(varname, data);
+            const std::vector<int> & data = whereData.get<int>(varname);
             processWhereAnyBitUnsetOf(data, bitIndices, whereTest);
           } else {
             throw eckit::UserError(
               "Only integer variables may be used for processWhere 'any_bit_unset_of'",
               Here());
           }
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
 
 //      Apply mask matches_regex
         if (currentParams.matchesRegex.value() != boost::none) {
-          setWhereVector(whereTest, true);
+          std::vector<bool> & whereTest = startTest();
           const std::string pattern = *currentParams.matchesRegex.value();
           // Select observations for which the variable 'varname' matches the regular expression
           // 'pattern'.
           if (dtype == ioda::ObsDtype::Integer) {
-            std::vector<int> data;
-            filterdata.get(varname, data);
+            const std::vector<int> & data = whereData.get<int>(varname);
             processWhereMatchesRegex(data, pattern, whereTest);
           } else if (dtype == ioda::ObsDtype::String) {
-            std::vector<std::string> data;
-            filterdata.get(varname, data);
+            const std::vector<std::string> & data = whereData.get<std::string>(varname);
             processWhereMatchesRegex(data, pattern, whereTest);
           } else {
             throw eckit::UserError(
               "Only string and integer variables may be used for processWhere 'matches_regex'",
               Here());
           }
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
 
 //      Apply mask matches_wildcard
         if (currentParams.matchesWildcard.value() != boost::none) {
-          setWhereVector(whereTest, true);
+          std::vector<bool> & whereTest = startTest();
           const std::string &pattern = *currentParams.matchesWildcard.value();
           // Select observations for which the variable 'varname' matches the pattern
           // 'pattern', which may contain the * and ? wildcards.
           if (dtype == ioda::ObsDtype::Integer) {
-            std::vector<int> data;
-            filterdata.get(varname, data);
+            const std::vector<int> & data = whereData.get<int>(varname);
             processWhereMatchesAnyWildcardPattern(data, {pattern}, whereTest);
           } else if (dtype == ioda::ObsDtype::String) {
-            std::vector<std::string> data;
-            filterdata.get(varname, data);
+            const std::vector<std::string> & data = whereData.get<std::string>(varname);
             processWhereMatchesAnyWildcardPattern(data, {pattern}, whereTest);
           } else {
             throw eckit::UserError(
               "Only string and integer variables may be used for processWhere 'matches_wildcard'",
               Here());
           }
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
 
 //      Apply mask matches_any_wildcard
         if (currentParams.matchesAnyWildcard.value() != boost::none) {
-          setWhereVector(whereTest, true);
+          std::vector<bool> & whereTest = startTest();
           const std::vector<std::string> &patterns = *currentParams.matchesAnyWildcard.value();
           // Select observations for which the variable 'varname' matches any of the patterns
           // 'patterns'; these may contain the * and ? wildcards.
           if (dtype == ioda::ObsDtype::Integer) {
-            std::vector<int> data;
-            filterdata.get(varname, data);
+            const std::vector<int> & data = whereData.get<int>(varname);
             processWhereMatchesAnyWildcardPattern(data, patterns, whereTest);
           } else if (dtype == ioda::ObsDtype::String) {
-            std::vector<std::string> data;
-            filterdata.get(varname, data);
+            const std::vector<std::string> & data = whereData.get<std::string>(varname);
             processWhereMatchesAnyWildcardPattern(data, patterns, whereTest);
           } else {
             throw eckit::UserError(
@@ -715,7 +815,7 @@ std::vector<bool> processWhere(const std::vector<WhereParameters> & params,
               "'matches_any_wildcard'",
               Here());
           }
-          applyWhereOperator(whereOperator, whereTest, where);
+          finishTest();
         }
       }
     }
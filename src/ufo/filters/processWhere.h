@@ -8,17 +8,20 @@
 #ifndef UFO_FILTERS_PROCESSWHERE_H_
 #define UFO_FILTERS_PROCESSWHERE_H_
 
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
 
 #include "oops/util/AnyOf.h"
+#include "oops/util/DateTime.h"
 #include "oops/util/parameters/OptionalParameter.h"
 #include "oops/util/parameters/Parameter.h"
 #include "oops/util/parameters/Parameters.h"
 #include "oops/util/parameters/ParameterTraitsAnyOf.h"
 #include "oops/util/parameters/RequiredParameter.h"
 #include "oops/util/PartialDateTime.h"
+#include "ufo/filters/DiagnosticFlag.h"
 #include "ufo/filters/Variable.h"
 #include "ufo/utils/parameters/ParameterTraitsVariable.h"
 
@@ -135,9 +138,41 @@ class WhereParameters : public oops::Parameters {
   oops::OptionalParameter<std::string> matchesRegex{"matches_regex", this};
 };
 
+/// \brief Values of the variables referenced by `where` clauses.
+///
+/// Each variable is retrieved from ObsFilterData at most once during the lifetime of this object,
+/// however many conditions or calls to processWhere() refer to it. An object of this class
+/// can therefore be shared by several calls to processWhere() as long as the data they refer to
+/// do not change in the meantime.
+class WhereData {
+ public:
+  explicit WhereData(const ObsFilterData & filterdata) : filterdata_(filterdata) {}
+
+  const ObsFilterData & filterData() const {return filterdata_;}
+
+  /// Return the values of \p varname, retrieving them if this has not been done yet.
+  template <typename T>
+  const std::vector<T> & get(const Variable & varname);
+
+ private:
+  template <typename T>
+  std::map<std::string, std::vector<T>> & values();
+
+  const ObsFilterData & filterdata_;
+  std::map<std::string, std::vector<int>> intValues_;
+  std::map<std::string, std::vector<float>> floatValues_;
+  std::map<std::string, std::vector<std::string>> stringValues_;
+  std::map<std::string, std::vector<util::DateTime>> dateTimeValues_;
+  std::map<std::string, std::vector<DiagnosticFlag>> flagValues_;
+};
+
 ufo::Variables getAllWhereVariables(const std::vector<WhereParameters> &);
 std::vector<bool> processWhere(const std::vector<WhereParameters> &, const ObsFilterData &,
                                const WhereOperator & whereOperator);
+/// Same as above, but takes the values of the variables referenced by the `where` clauses from
+/// (and stores them in) \p whereData.
+std::vector<bool> processWhere(const std::vector<WhereParameters> &, WhereData & whereData,
+                               const WhereOperator & whereOperator);
 
 }  // namespace ufo
 
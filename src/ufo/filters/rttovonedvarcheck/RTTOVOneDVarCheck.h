@@ -63,6 +63,7 @@ class RTTOVOneDVarCheck : public FilterBase,
   void applyFilter(const std::vector<bool> &, const Variables &,
                    std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override {return QCflags::onedvar;}
+  bool modifiesObsSpace() const override {return true;}
 
   F90obfilter keyRTTOVOneDVarCheck_;
   std::vector<int> channels_;
@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 
+#include "oops/util/parameters/NumericConstraints.h"
 #include "oops/util/parameters/Parameter.h"
 #include "oops/util/parameters/Parameters.h"
 #include "oops/util/parameters/RequiredParameter.h"
@@ -199,6 +200,15 @@ class RTTOVOneDVarCheckParameters : public FilterParametersBase {
   /// Cost threshold for convergence check when cost function value is used for convergence
   oops::Parameter<double> CostConvergenceFactor{"CostConvergenceFactor", 0.01, this};
 
+  /// If greater than zero, the Jacobian is not recalculated at the next iteration (only the
+  /// brightness temperatures are) when no element of the profile changed by more than
+  /// JacobianReuseFactor * the background error standard deviation of that element during the
+  /// current iteration. The K-matrix is by far the most expensive part of an iteration, so this
+  /// speeds up the minimisation at the cost of slightly different retrievals. Zero (the default)
+  /// recalculates the Jacobian at every iteration.
+  oops::Parameter<double> JacobianReuseFactor{"JacobianReuseFactor", 0.0, this,
+                                              {oops::minConstraint(0.0)}};
+
   /// The fraction of the Jacobian that is permitted to be below the cloud_top_pressure for the
   /// IR cloudy channel selection.  The Jacobian is integrated from the toa -> surface and a
   /// maximum of 1 % of the integrated Jacobian is allowed to be below the cloud top.
@@ -214,6 +224,12 @@ class RTTOVOneDVarCheckParameters : public FilterParametersBase {
   /// Max IWP in check the cloudy iteration in kg/m2
   oops::Parameter<double> maxIWPForCloudyCheck{"MaxIWPForCloudyCheck", 2.0, this};
 
+  /// Number of OpenMP threads used to run the 1D-Var on different observations concurrently.
+  /// Each thread has its own RTTOV operator, so setting RTTOV_share_coefficients in the obs
+  /// options avoids reading the coefficients once per thread. The results do not depend on
+  /// the number of threads. FullDiagnostics forces a single thread.
+  oops::Parameter<int> NumThreads{"NumThreads", 1, this};
+
   /// -------------------------------
   /// Variables purely for testing
   /// -------------------------------
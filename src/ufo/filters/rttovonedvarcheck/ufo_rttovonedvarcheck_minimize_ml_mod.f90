@@ -95,7 +95,7 @@ subroutine ufo_rttovonedvarcheck_minimize_ml(config,    &
 
 implicit none
 
-type(ufo_rttovonedvarcheck), intent(inout) :: config !< structure containing settings
+type(ufo_rttovonedvarcheck), intent(in)    :: config !< structure containing settings
 type(ufo_rttovonedvarcheck_ob), intent(inout) :: ob  !< satellite metadata
 type(ufo_rttovonedvarcheck_rsubmatrix), intent(inout) :: r_matrix !< observation error covariance
 real(kind_real), intent(in)       :: b_matrix(:,:)   !< state error covariance
@@ -113,6 +113,7 @@ integer                         :: inversionstatus ! status of minimisation
 logical                         :: outOfRange      ! out of range flag for check iteration
 logical                         :: Converged       ! converged flag
 logical                         :: Error           ! error flag
+logical                         :: ReuseJacobian   ! true if H_matrix is kept from the previous iteration
 integer                         :: iter            ! iteration counter
 integer                         :: RTerrorcode     ! error code for RTTOV
 integer                         :: nchans          ! number of satellite channels used
@@ -131,6 +132,7 @@ real(kind_real), allocatable    :: GuessProfile(:)
 real(kind_real), allocatable    :: GuessProfileBefore(:)
 real(kind_real), allocatable    :: BackProfile(:)
 real(kind_real), allocatable    :: H_matrix(:,:)
+real(kind_real), allocatable    :: H_matrix_T(:,:)
 real(kind_real), allocatable    :: Diffprofile(:)
 real(kind_real), allocatable    :: AbsDiffProfile(:)
 real(kind_real), allocatable    :: Ydiff(:)
@@ -149,6 +151,7 @@ type(ufo_geoval), pointer       :: geoval
 Converged = .false.
 onedvar_success = .false.
 Error = .false.
+ReuseJacobian = .false.
 nchans = size(ob % channels_used)
 Gamma = 1.0e-4_kind_real
 Jcost = 1.0e4_kind_real
@@ -159,6 +162,7 @@ allocate(GuessProfile(nprofelements))
 allocate(GuessProfileBefore(nprofelements))
 allocate(BackProfile(nprofelements))
 allocate(H_matrix(nchans,nprofelements))
+allocate(H_matrix_T(nprofelements,nchans))
 allocate(Diffprofile(nprofelements))
 allocate(AbsDiffprofile(nprofelements))
 allocate(Ydiff(nchans))
@@ -195,10 +199,17 @@ Iterations: do iter = 1, config % max1DVarIterations
   ! Save current profile
   OldProfile(:) = GuessProfile(:)
 
-  ! Get jacobian and new hofx
-  call ufo_rttovonedvarcheck_get_jacobian(config, geovals, ob, ob % channels_used, &
-                                       profile_index, GuessProfile(:), &
-                                       hofxdiags, rttov_simobs, Y(:), H_matrix)
+  ! Get jacobian and new hofx, or only hofx if the profile has hardly changed since the
+  ! jacobian was last calculated
+  if (ReuseJacobian) then
+    call ufo_rttovonedvarcheck_get_bts(config, geovals, ob, ob % channels_used, &
+                                       rttov_simobs, Y(:))
+  else
+    call ufo_rttovonedvarcheck_get_jacobian(config, geovals, ob, ob % channels_used, &
+                                         profile_index, GuessProfile(:), &
+                                         hofxdiags, rttov_simobs, Y(:), H_matrix)
+    H_matrix_T = transpose(H_matrix)
+  end if
 
   if (iter == 1) then
     RTerrorcode = 0
@@ -284,7 +295,7 @@ Iterations: do iter = 1, config % max1DVarIterations
                                   nChans,              &
                                   ob,                  &
                                   H_Matrix,            &
-                                  transpose(H_Matrix), &
+                                  H_Matrix_T,          &
                                   nprofelements,       &
                                   profile_index,       &
                                   DiffProfile,         &
@@ -352,6 +363,13 @@ Iterations: do iter = 1, config % max1DVarIterations
     end if
   end if
 
+  ! Decide whether the next iteration can reuse the jacobian
+  ReuseJacobian = .false.
+  if ((.not. outOfRange) .and. config % JacobianReuseFactor > zero) then
+    ReuseJacobian = all(abs(GuessProfile(:) - OldProfile(:)) <= &
+                        B_sigma(:) * config % JacobianReuseFactor)
+  end if
+
   !---------------------
   ! 4. output diagnostics
   !---------------------
@@ -452,6 +470,7 @@ if (allocated(GuessProfile))       deallocate(GuessProfile)
 if (allocated(GuessProfileBefore)) deallocate(GuessProfileBefore)
 if (allocated(BackProfile))        deallocate(BackProfile)
 if (allocated(H_matrix))           deallocate(H_matrix)
+if (allocated(H_matrix_T))         deallocate(H_matrix_T)
 if (allocated(Diffprofile))        deallocate(Diffprofile)
 if (allocated(AbsDiffprofile))     deallocate(AbsDiffprofile)
 if (allocated(Ydiff))              deallocate(Ydiff)
@@ -93,7 +93,7 @@ subroutine ufo_rttovonedvarcheck_minimize_newton(config,  &
 
 implicit none
 
-type(ufo_rttovonedvarcheck), intent(inout) :: config !< Main 1D-Var object
+type(ufo_rttovonedvarcheck), intent(in)    :: config !< Main 1D-Var object
 type(ufo_rttovonedvarcheck_ob), intent(inout) :: ob  !< satellite metadata
 type(ufo_rttovonedvarcheck_rsubmatrix), intent(inout) :: r_matrix !< observation error covariance
 real(kind_real), intent(in)       :: b_matrix(:,:)   !< state error covariance
@@ -111,6 +111,7 @@ integer                         :: inversionstatus
 logical                         :: outOfRange
 logical                         :: Converged
 logical                         :: Error
+logical                         :: ReuseJacobian ! true if H_matrix is kept from the previous iteration
 integer                         :: iter
 integer                         :: RTerrorcode
 integer                         :: nchans
@@ -126,6 +127,7 @@ real(kind_real), allocatable    :: OldProfile(:)
 real(kind_real), allocatable    :: GuessProfile(:)
 real(kind_real), allocatable    :: BackProfile(:)
 real(kind_real), allocatable    :: H_matrix(:,:)
+real(kind_real), allocatable    :: H_matrix_T(:,:)
 real(kind_real), allocatable    :: Diffprofile(:)
 real(kind_real), allocatable    :: AbsDiffProfile(:)
 real(kind_real), allocatable    :: Xdiff(:)
@@ -146,6 +148,7 @@ integer                         :: ii, jj
 Converged = .false.
 onedvar_success = .false.
 Error = .false.
+ReuseJacobian = .false.
 nchans = size(ob % channels_used)
 inversionstatus = 0
 nprofelements = profile_index % nprofelements
@@ -153,6 +156,7 @@ allocate(OldProfile(nprofelements))
 allocate(GuessProfile(nprofelements))
 allocate(BackProfile(nprofelements))
 allocate(H_matrix(nchans,nprofelements))
+allocate(H_matrix_T(nprofelements,nchans))
 allocate(Diffprofile(nprofelements))
 allocate(AbsDiffprofile(nprofelements))
 allocate(Xdiff(nprofelements))
@@ -210,10 +214,17 @@ Iterations: do iter = 1, config % max1DVarIterations
   ! Save current profile
   OldProfile(:) = GuessProfile(:)
 
-  ! Get jacobian and hofx
-  call ufo_rttovonedvarcheck_get_jacobian(config, geovals, ob, ob % channels_used, &
-                                          profile_index, GuessProfile(:), &
-                                          hofxdiags, rttov_simobs, Y(:), H_matrix)
+  ! Get jacobian and hofx, or only hofx if the profile has hardly changed since the
+  ! jacobian was last calculated
+  if (ReuseJacobian) then
+    call ufo_rttovonedvarcheck_get_bts(config, geovals, ob, ob % channels_used, &
+                                       rttov_simobs, Y(:))
+  else
+    call ufo_rttovonedvarcheck_get_jacobian(config, geovals, ob, ob % channels_used, &
+                                            profile_index, GuessProfile(:), &
+                                            hofxdiags, rttov_simobs, Y(:), H_matrix)
+    H_matrix_T = transpose(H_matrix)
+  end if
 
   if (iter == 1) then
     BackProfile(:) = GuessProfile(:)
@@ -313,7 +324,7 @@ Iterations: do iter = 1, config % max1DVarIterations
     call ufo_rttovonedvarcheck_NewtonManyChans (Ydiff,          &
                                      nchans,                    &
                                      H_matrix(:,:),             & ! in
-                                     transpose (H_matrix(:,:)), & ! in
+                                     H_matrix_T(:,:),           & ! in
                                      nprofelements,             &
                                      Diffprofile,               &
                                      b_inv,                     &
@@ -324,7 +335,7 @@ Iterations: do iter = 1, config % max1DVarIterations
     call ufo_rttovonedvarcheck_NewtonFewChans (Ydiff,          &
                                     nchans,                    &
                                     H_matrix(:,:),             & ! in
-                                    transpose (H_matrix(:,:)), & ! in
+                                    H_matrix_T(:,:),           & ! in
                                     nprofelements,             &
                                     Diffprofile,               &
                                     b_matrix,                  &
@@ -388,6 +399,13 @@ Iterations: do iter = 1, config % max1DVarIterations
     end if
   end if
 
+  ! Decide whether the next iteration can reuse the jacobian
+  ReuseJacobian = .false.
+  if ((.NOT. outOfRange) .and. config % JacobianReuseFactor > zero) then
+    ReuseJacobian = all(abs(GuessProfile(:) - OldProfile(:)) <= &
+                        B_sigma(:) * config % JacobianReuseFactor)
+  end if
+
   !---------------------
   ! 4. output diagnostics
   !---------------------
@@ -488,6 +506,7 @@ if (allocated(OldProfile))         deallocate(OldProfile)
 if (allocated(GuessProfile))       deallocate(GuessProfile)
 if (allocated(BackProfile))        deallocate(BackProfile)
 if (allocated(H_matrix))           deallocate(H_matrix)
+if (allocated(H_matrix_T))         deallocate(H_matrix_T)
 if (allocated(Diffprofile))        deallocate(Diffprofile)
 if (allocated(AbsDiffprofile))     deallocate(AbsDiffprofile)
 if (allocated(Xdiff))              deallocate(Xdiff)
@@ -35,6 +35,7 @@ public ufo_rttovonedvarcheck_hofxdiags_levels
 public ufo_rttovonedvarcheck_cloudy_channel_rejection
 
 character(len=max_string) :: message
+!$omp threadprivate(message)
 
 contains
 
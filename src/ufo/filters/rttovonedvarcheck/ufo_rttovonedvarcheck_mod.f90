@@ -30,6 +30,7 @@ use ufo_rttovonedvarcheck_rsubmatrix_mod
 use ufo_rttovonedvarcheck_setup_mod
 use ufo_rttovonedvarcheck_utils_mod
 use ufo_vars_mod
+!$ use omp_lib, only: omp_get_thread_num
 
 implicit none
 private
@@ -109,36 +110,20 @@ subroutine ufo_rttovonedvarcheck_apply(self, f_conf, vars, hofxdiags_vars, geova
 
   type(ufo_rttovonedvarcheck_obs)        :: obs             ! data for all observations read from db
   type(ufo_metoffice_bmatrixstatic)      :: full_bmatrix    ! full bmatrix read from file
-  type(ufo_geovals)                      :: firstguess_geovals ! geoval for one observation
-  type(ufo_rttovonedvarcheck_ob)         :: ob              ! observation data for a single observation
   type(ufo_rttovonedvarcheck_profindex)  :: prof_index      ! index for mapping geovals to 1d-var state profile
-  type(ufo_rttovonedvarcheck_profindex)  :: local_profindex ! local copy of prof_index needed since the intro. of mwemiss
   type(ufo_metoffice_rmatrixradiance)    :: full_rmatrix    ! full r_matrix read from file
-  type(ufo_rttovonedvarcheck_rsubmatrix) :: r_submatrix     ! r_submatrix object
-  type(ufo_geovals)                      :: hofxdiags       ! hofxdiags containing jacobian
-  type(ufo_geoval), pointer          :: geoval
-  character(len=max_string)          :: var
-  character(len=max_string)          :: varname
+  type(ufo_rttovonedvarcheck_rsubmatrix_cache) :: rsubmatrix_cache ! r sub-matrices of the channel selections
   character(len=max_string)          :: message
-  integer                            :: jvar, ivar, jobs, band, ii, irej, jnew ! counters
-  integer                            :: nchans_used      ! counter for number of channels used for an ob
-  integer                            :: jchans_used
-  integer                            :: fileunit        ! unit number for reading in files
+  integer                            :: jobs            ! counter
+  integer                            :: nthreads        ! number of threads running the 1d-var
+  integer                            :: ithread         ! index of the current thread (from 1)
   integer                            :: apply_count ! number of profiles that the 1dvar has been applied to
   integer                            :: failed_1dvar_count ! number of profiles that failed to converge
   integer                            :: failed_retrievedBTcheck_count ! number of profiles with retrieved BTs outside error
-  integer                            :: nprofelements   ! number of elements in 1d-var state profile
-  integer, allocatable               :: fields_in(:)
   real(kind_real)                    :: missing         ! missing value
-  real(kind_real)                    :: t1, t2          ! timing
-  real(kind_real), allocatable       :: b_matrix(:,:)   ! 1d-var profile b matrix
-  real(kind_real), allocatable       :: b_inverse(:,:)  ! inverse for each 1d-var profile b matrix
-  real(kind_real), allocatable       :: b_sigma(:)      ! b_matrix diagonal error
-  real(kind_real), allocatable       :: max_error(:)    ! max_error = error(stdev) * factor
-  logical                            :: file_exists     ! check if a file exists logical
-  logical                            :: onedvar_success
-  logical                            :: reject_profile
-  type(ufo_radiancerttov)            :: rttov_simobs
+  logical                            :: failed_1dvar    ! true if the 1d-var failed to converge
+  logical                            :: failed_retrievedBTcheck ! true if retrieved BTs outside error
+  type(ufo_radiancerttov), allocatable :: rttov_simobs(:) ! one rttov operator per thread
   integer(c_size_t), allocatable     :: ret_nlevs(:)
 
   ! ------------------------------------------
@@ -146,8 +131,16 @@ subroutine ufo_rttovonedvarcheck_apply(self, f_conf, vars, hofxdiags_vars, geova
   ! ------------------------------------------
   missing = missing_value(missing)
 
-  ! Setup rttov simobs
-  call rttov_simobs % setup(f_conf, self % channels)
+  ! The full diagnostics are written to stdout, so keep them in observation order
+  nthreads = self % nthreads
+  if (self % FullDiagnostics) nthreads = 1
+
+  ! Setup rttov simobs.  Each thread needs its own operator because the operator
+  ! holds the RTTOV profile, radiance and jacobian buffers.
+  allocate(rttov_simobs(nthreads))
+  do ithread = 1, nthreads
+    call rttov_simobs(ithread) % setup(f_conf, self % channels)
+  end do
 
   ! Setup full B matrix object
   call full_bmatrix % setup(self % retrieval_variables, self % b_matrix_path, &
@@ -180,9 +173,6 @@ subroutine ufo_rttovonedvarcheck_apply(self, f_conf, vars, hofxdiags_vars, geova
   call obs % setup(self, prof_index, geovals, vars)
 
   ! Initialize data arrays
-  allocate(b_matrix(prof_index % nprofelements,prof_index % nprofelements))
-  allocate(b_inverse(prof_index % nprofelements,prof_index % nprofelements))
-  allocate(b_sigma(prof_index % nprofelements))
   allocate(ret_nlevs(hofxdiags_vars % nvars()))
 
   ! Decide on loop parameters - testing
@@ -199,220 +189,37 @@ subroutine ufo_rttovonedvarcheck_apply(self, f_conf, vars, hofxdiags_vars, geova
   ! ------------------------------------------
   ! 2. Beginning main observation loop
   ! ------------------------------------------
+  ! Each observation is retrieved independently and only writes to its own column of
+  ! the obs arrays, so the results do not depend on the order in which the threads
+  ! process the observations.
   write(*,*) "Beginning loop over observations: ",trim(self%qcname)
   apply_count = 0
   failed_1dvar_count = 0
   failed_retrievedBTcheck_count = 0
+  !$omp parallel do num_threads(nthreads) schedule(dynamic) default(shared) &
+  !$omp&   private(jobs, ithread, failed_1dvar, failed_retrievedBTcheck) &
+  !$omp&   reduction(+:apply_count, failed_1dvar_count, failed_retrievedBTcheck_count)
   obs_loop: do jobs = self % StartOb, self % FinishOb
     if (apply(jobs)) then
 
-      obs % output_to_db(jobs) = .true.
       apply_count = apply_count + 1
-      write(message, *) "starting obs number    ",jobs
-      call fckit_log % debug(message)
-
-      ! Needs copying for each ob since mwemiss introduced
-      call local_profindex % copy(prof_index)
-      !---------------------------------------------------
-      ! 2.1 Setup Jb terms
-      !---------------------------------------------------
-      ! create one ob geovals from full obs geovals and check
-      ! to make sure the values are within sensible bounds.
-      call ufo_geovals_copy_one(firstguess_geovals, geovals, jobs)
-      call ufo_rttovonedvarcheck_check_geovals(self, firstguess_geovals, &
-              local_profindex, obs % surface_type(jobs))
-
-      ! create b matrix arrays for this single observation location
-      call full_bmatrix % reset( obs % lat(jobs), & ! in
-                    b_matrix, b_inverse, b_sigma  ) ! out
-
-      ! adjust b matrix based on tskin error and if mwemiss is in local_profindex
-      ! check that we are over land
-      call ufo_rttovonedvarcheck_adjust_bmatrix(local_profindex, & ! inout
-           obs, jobs, self,                                      & ! in
-           b_matrix, b_inverse, b_sigma)                           ! inout
-
-      !---------------------------------------------------
-      ! 2.2 Setup Jo terms
-      !---------------------------------------------------
-      ! Channel selection based on previous filters flags
-      nchans_used = 0
-      do jvar = 1, self%nchans
-        if( obs % QCflags(jvar,jobs) == self % passflag ) then
-          nchans_used = nchans_used + 1
-        end if
-      end do
-      if (nchans_used == 0) then
-        write(message, *) "No channels selected for observation number ", &
-               jobs, " : skipping"
-        call fckit_log % debug(message)
-        cycle obs_loop
-      end if
+      ithread = 1
+      !$ ithread = omp_get_thread_num() + 1
 
-      ! setup ob data for this observation
-      call ob % setup(nchans_used, self %  nlevels, local_profindex % nprofelements, self % nchans, &
-           self % Store1DVarCLW, self % Store1DVarTransmittance)
-      
-      ob % forward_mod_name = self % forward_mod_name
-      ob % latitude = obs % lat(jobs)
-      ob % longitude = obs % lon(jobs)
-      ob % date = obs % date(jobs)
-      ob % elevation = obs % elevation(jobs)
-      ob % sensor_zenith_angle = obs % sat_zen(jobs)
-      ob % sensor_azimuth_angle = obs % sat_azi(jobs)
-      ob % solar_zenith_angle = obs % sol_zen(jobs)
-      ob % solar_azimuth_angle = obs % sol_azi(jobs)
-      ob % channels_all = self % channels
-      ob % surface_type = obs % surface_type(jobs)
-      ob % calc_emiss = obs % calc_emiss(jobs)
-      ob % emiss(:) = obs % emiss(:, jobs)
-      if(self % cloud_retrieval) ob % retrievecloud = .true.
-      if(self % cloud_retrieval) ob % cloudtopp = obs % cloudtopp(jobs)
-      if(self % cloud_retrieval) ob % cloudfrac = obs % cloudfrac(jobs)
-      if(self % RTTOV_mwscattSwitch) ob % mwscatt = .true.
-      if(self % RTTOV_usetotalice) ob % mwscatt_totalice = .true.
-      if(associated(obs % pcemiss_object)) then
-        ob % pcemiss_object => obs % pcemiss_object
-        allocate(ob % pcemiss(size(obs % pcemiss, 1)))
-        ob % pcemiss(:) = obs % pcemiss(:, jobs)
-      end if
+      call ufo_rttovonedvarcheck_process_ob(self, jobs, geovals, hofxdiags_vars, ret_nlevs, &
+                                            full_bmatrix, full_rmatrix, rsubmatrix_cache, &
+                                            prof_index, rttov_simobs(ithread), obs,       &
+                                            failed_1dvar, failed_retrievedBTcheck)
 
-      ! Check if ctp very close to model pressure level.  If so
-      ! make them exactly equal to match OPS behaviour for RTTOV
-      ! jacobian calculation.
-      if(self % cloud_retrieval) then
-        call ufo_rttovonedvarcheck_check_ctp(ob % cloudtopp, firstguess_geovals, self %  nlevels)
-      end if
-
-      ! Store background T in ob data space
-      call ufo_geovals_get_var(firstguess_geovals, var_ts, geoval)
-      ob % background_T(:) = geoval%vals(:, 1) ! K
-
-      ! Create ob vector and r matrix
-      jchans_used = 0
-      do jvar = 1, self%nchans
-        if( obs % QCflags(jvar,jobs) == self % passflag ) then
-          jchans_used = jchans_used + 1
-          ob % yobs(jchans_used) = obs % yobs(jvar, jobs)
-          ob % channels_used(jchans_used) = self % channels(jvar)
-        end if
-      end do
-      call r_submatrix % setup(nchans_used, ob % channels_used, full_rmatrix=full_rmatrix)
-
-      ! Setup hofxdiags for this retrieval
-      call ufo_geovals_setup(hofxdiags, hofxdiags_vars, 1, hofxdiags_vars % nvars(), ret_nlevs)
-
-      if (self % FullDiagnostics) then
-        call ob % info()
-        call r_submatrix % info()
-        write(*, *) "Observations used = ",ob % yobs(:)
-        write(*,*) "ob % emiss = ",ob % emiss
-        write(*,*) "ob % calc_emiss = ",ob % calc_emiss
-        write(*,*) "Channel selection = "
-        write(*,'(15I5)') ob % channels_used
-        write(*,*) "All Channels = "
-        write(*,'(15I5)') ob % channels_all
-        call local_profindex % info()
-      end if
-
-      !---------------------------------------------------
-      ! 2.3 Call minimization
-      !---------------------------------------------------
-      if (self % UseMLMinimization) then
-        call ufo_rttovonedvarcheck_minimize_ml(self, ob, &
-                                      r_submatrix, b_matrix, b_inverse, b_sigma, &
-                                      firstguess_geovals, hofxdiags, rttov_simobs, &
-                                      local_profindex, onedvar_success)
-      else
-        call ufo_rttovonedvarcheck_minimize_newton(self, ob, &
-                                      r_submatrix, b_matrix, b_inverse, b_sigma, &
-                                      firstguess_geovals, hofxdiags, rttov_simobs, &
-                                      local_profindex, onedvar_success)
-      end if
-
-      obs % output_BT(:, jobs) = ob % output_BT(:)
-      obs % background_BT(:, jobs) = ob % background_BT(:)
-      obs % output_profile(:,jobs) = ob % output_profile(:)
-      obs % emiss(:, jobs) = ob % emiss(:)
-      obs % final_cost(jobs) = ob % final_cost
-      obs % LWP(jobs) = ob % LWP
-      obs % IWP(jobs) = ob % IWP
-      if (self % store1dvarclw) obs % CLW(:,jobs) = ob % CLW(:)
-      if (self % store1dvartransmittance) obs % transmittance(:, jobs) = ob % transmittance(:)
-      if (self % cloud_retrieval) obs % cloudtopp(jobs) = ob % cloudtopp
-      if (self % cloud_retrieval) obs % cloudfrac(jobs) = ob % cloudfrac
-      if (self % RecalculateBT) obs % recalc_BT(:, jobs) = ob % recalc_BT(:)
-      obs % niter(jobs) = ob % niter
-
-      ! Set QCflags based on output from minimization
-      if (.NOT. onedvar_success) then
-        failed_1dvar_count = failed_1dvar_count + 1
-        do jvar = 1, self%nchans
-          if( obs % QCflags(jvar,jobs) == 0 ) then
-            obs % QCflags(jvar,jobs) = self % onedvarflag
-          end if
-        end do
-      end if
-
-      ! Remove channels that have been removed because of slow convergence
-      if (ob % QC_SlowConvChans) then
-        do jvar = 1, self % nchans
-          if( obs % QCflags(jvar,jobs) == 0 .and. &
-              any( self % ConvergeCheckChans == obs % channels(jvar) ) ) then
-            obs % QCflags(jvar,jobs) = self % onedvarflag
-          end if
-        end do
-      end if
-
-      ! Reject channels that have failed the ctp check
-      if (allocated(ob % rejected_channels_ctp)) then
-        jnew = 1
-        rejected: do irej = 1, size(ob % rejected_channels_ctp)
-          jvar = jnew
-          do while ( jvar <= size(obs % channels) )
-            if (ob % rejected_channels_ctp(irej) == obs % channels(jvar)) then
-              obs % QCflags(jvar, jobs) = self % onedvarflag
-              cycle rejected
-            end if
-            jvar = jvar + 1
-          end do
-        end do rejected
-      end if
-
-      ! Check the BTs are within a factor of the error.  This only applies to channels that are still
-      ! active.
-      if (self % RetrievedErrorFactor > zero .and. any(obs % QCflags(:,jobs) == self % passflag)) then
-        allocate(max_error(size(ob % channels_used)))
-        call r_submatrix % multiply_factor_by_stdev(self % RetrievedErrorFactor, max_error)
-        reject_profile = .false.
-        chanloop: do jvar = 1, size(ob % channels_used)
-          if (allocated(ob % rejected_channels_ctp)) then
-            if(any(ob % rejected_channels_ctp == ob % channels_used(jvar))) cycle chanloop
-          end if
-          if (abs(ob % final_bt_diff(jvar)) > max_error(jvar)) reject_profile = .true.
-        end do chanloop
-        if (reject_profile) then
-          failed_retrievedBTcheck_count = failed_retrievedBTcheck_count + 1
-          do jvar = 1, self % nchans
-            if( obs % QCflags(jvar,jobs) == self % passflag ) then
-              obs % QCflags(jvar,jobs) = self % onedvarflag
-            end if
-          end do
-        end if
-        deallocate(max_error)
-      end if
-
-      ! Tidy up memory specific to a single observation
-      call ufo_geovals_delete(firstguess_geovals)
-      call ufo_geovals_delete(hofxdiags)
-      call ob % delete()
-      call r_submatrix % delete()
+      if (failed_1dvar) failed_1dvar_count = failed_1dvar_count + 1
+      if (failed_retrievedBTcheck) failed_retrievedBTcheck_count = failed_retrievedBTcheck_count + 1
 
     else
       call fckit_log % debug("Final 1Dvar cost, apply = F")
 
     endif
   end do obs_loop
+  !$omp end parallel do
 
   !---------------------------------------------------
   ! 3.0 Return variables and tidy up
@@ -433,13 +240,279 @@ subroutine ufo_rttovonedvarcheck_apply(self, f_conf, vars, hofxdiags_vars, geova
   ! Tidy up memory used for all observations
   call full_bmatrix % delete()
   call full_rmatrix % delete()
+  call rsubmatrix_cache % delete()
   call obs % delete()
-  if (allocated(b_matrix))  deallocate(b_matrix)
-  if (allocated(b_inverse)) deallocate(b_inverse)
-  if (allocated(b_sigma))   deallocate(b_sigma)
   if (allocated(ret_nlevs)) deallocate(ret_nlevs)
-  call rttov_simobs % delete()
+  do ithread = 1, nthreads
+    call rttov_simobs(ithread) % delete()
+  end do
+  deallocate(rttov_simobs)
 
 end subroutine ufo_rttovonedvarcheck_apply
 
+! ------------------------------------------------------------------------------
+!> Run the 1D-Var for a single observation
+!!
+!! \details Heritage : Ops_SatRad_Do1DVar_RTTOV12.f90
+!!
+!! Sets up the background, B and R matrices for observation \p jobs, performs
+!! the minimization and stores the results and updated QC flags in column
+!! \p jobs of \p obs.  All the work arrays are local, so this can be called for
+!! different observations concurrently provided each caller passes its own
+!! \p rttov_simobs.
+!!
+!! \author Met Office
+!!
+!! \date 14/10/2022: Created
+!!
+subroutine ufo_rttovonedvarcheck_process_ob(self, jobs, geovals, hofxdiags_vars, ret_nlevs, &
+                                            full_bmatrix, full_rmatrix, rsubmatrix_cache, &
+                                            prof_index, rttov_simobs, obs,                &
+                                            failed_1dvar, failed_retrievedBTcheck)
+
+  implicit none
+  type(ufo_rttovonedvarcheck), intent(in)           :: self         !< rttovonedvarcheck main object
+  integer, intent(in)                               :: jobs         !< observation number
+  type(ufo_geovals), intent(in)                     :: geovals      !< model values at observation space
+  type(oops_variables), intent(in)                  :: hofxdiags_vars !< retrieval variables for 1D-Var
+  integer(c_size_t), intent(in)                     :: ret_nlevs(:) !< number of levels of each hofxdiags variable
+  type(ufo_metoffice_bmatrixstatic), intent(in)     :: full_bmatrix !< full bmatrix read from file
+  type(ufo_metoffice_rmatrixradiance), intent(in)   :: full_rmatrix !< full r_matrix read from file
+  type(ufo_rttovonedvarcheck_rsubmatrix_cache), intent(inout) :: rsubmatrix_cache !< r sub-matrices shared by the threads
+  type(ufo_rttovonedvarcheck_profindex), intent(in) :: prof_index   !< index for mapping geovals to 1d-var state profile
+  type(ufo_radiancerttov), intent(inout)            :: rttov_simobs !< rttov operator used by this thread
+  type(ufo_rttovonedvarcheck_obs), intent(inout)    :: obs          !< data for all observations
+  logical, intent(out)                              :: failed_1dvar !< true if the 1d-var failed to converge
+  logical, intent(out)                              :: failed_retrievedBTcheck !< true if retrieved BTs outside error
+
+  type(ufo_geovals)                      :: firstguess_geovals ! geoval for one observation
+  type(ufo_rttovonedvarcheck_ob)         :: ob              ! observation data for a single observation
+  type(ufo_rttovonedvarcheck_profindex)  :: local_profindex ! local copy of prof_index needed since the intro. of mwemiss
+  type(ufo_rttovonedvarcheck_rsubmatrix) :: r_submatrix     ! r_submatrix object
+  type(ufo_geovals)                      :: hofxdiags       ! hofxdiags containing jacobian
+  type(ufo_geoval), pointer          :: geoval
+  character(len=max_string)          :: message
+  integer                            :: jvar, irej, jnew ! counters
+  integer                            :: nchans_used      ! counter for number of channels used for an ob
+  integer                            :: jchans_used
+  real(kind_real), allocatable       :: b_matrix(:,:)   ! 1d-var profile b matrix
+  real(kind_real), allocatable       :: b_inverse(:,:)  ! inverse for each 1d-var profile b matrix
+  real(kind_real), allocatable       :: b_sigma(:)      ! b_matrix diagonal error
+  real(kind_real), allocatable       :: max_error(:)    ! max_error = error(stdev) * factor
+  logical                            :: onedvar_success
+  logical                            :: reject_profile
+
+  failed_1dvar = .false.
+  failed_retrievedBTcheck = .false.
+
+  obs % output_to_db(jobs) = .true.
+  write(message, *) "starting obs number    ",jobs
+  call fckit_log % debug(message)
+
+  ! Needs copying for each ob since mwemiss introduced
+  call local_profindex % copy(prof_index)
+
+  ! Initialize data arrays
+  allocate(b_matrix(prof_index % nprofelements,prof_index % nprofelements))
+  allocate(b_inverse(prof_index % nprofelements,prof_index % nprofelements))
+  allocate(b_sigma(prof_index % nprofelements))
+
+  !---------------------------------------------------
+  ! 1. Setup Jb terms
+  !---------------------------------------------------
+  ! create one ob geovals from full obs geovals and check
+  ! to make sure the values are within sensible bounds.
+  call ufo_geovals_copy_one(firstguess_geovals, geovals, jobs)
+  call ufo_rttovonedvarcheck_check_geovals(self, firstguess_geovals, &
+          local_profindex, obs % surface_type(jobs))
+
+  ! create b matrix arrays for this single observation location
+  call full_bmatrix % reset( obs % lat(jobs), & ! in
+                b_matrix, b_inverse, b_sigma  ) ! out
+
+  ! adjust b matrix based on tskin error and if mwemiss is in local_profindex
+  ! check that we are over land
+  call ufo_rttovonedvarcheck_adjust_bmatrix(local_profindex, & ! inout
+       obs, jobs, self,                                      & ! in
+       b_matrix, b_inverse, b_sigma)                           ! inout
+
+  !---------------------------------------------------
+  ! 2. Setup Jo terms
+  !---------------------------------------------------
+  ! Channel selection based on previous filters flags
+  nchans_used = 0
+  do jvar = 1, self%nchans
+    if( obs % QCflags(jvar,jobs) == self % passflag ) then
+      nchans_used = nchans_used + 1
+    end if
+  end do
+  if (nchans_used == 0) then
+    write(message, *) "No channels selected for observation number ", &
+           jobs, " : skipping"
+    call fckit_log % debug(message)
+    call ufo_geovals_delete(firstguess_geovals)
+    return
+  end if
+
+  ! setup ob data for this observation
+  call ob % setup(nchans_used, self %  nlevels, local_profindex % nprofelements, self % nchans, &
+       self % Store1DVarCLW, self % Store1DVarTransmittance)
+  
+  ob % forward_mod_name = self % forward_mod_name
+  ob % latitude = obs % lat(jobs)
+  ob % longitude = obs % lon(jobs)
+  ob % date = obs % date(jobs)
+  ob % elevation = obs % elevation(jobs)
+  ob % sensor_zenith_angle = obs % sat_zen(jobs)
+  ob % sensor_azimuth_angle = obs % sat_azi(jobs)
+  ob % solar_zenith_angle = obs % sol_zen(jobs)
+  ob % solar_azimuth_angle = obs % sol_azi(jobs)
+  ob % channels_all = self % channels
+  ob % surface_type = obs % surface_type(jobs)
+  ob % calc_emiss = obs % calc_emiss(jobs)
+  ob % emiss(:) = obs % emiss(:, jobs)
+  if(self % cloud_retrieval) ob % retrievecloud = .true.
+  if(self % cloud_retrieval) ob % cloudtopp = obs % cloudtopp(jobs)
+  if(self % cloud_retrieval) ob % cloudfrac = obs % cloudfrac(jobs)
+  if(self % RTTOV_mwscattSwitch) ob % mwscatt = .true.
+  if(self % RTTOV_usetotalice) ob % mwscatt_totalice = .true.
+  if(associated(obs % pcemiss_object)) then
+    ob % pcemiss_object => obs % pcemiss_object
+    allocate(ob % pcemiss(size(obs % pcemiss, 1)))
+    ob % pcemiss(:) = obs % pcemiss(:, jobs)
+  end if
+
+  ! Check if ctp very close to model pressure level.  If so
+  ! make them exactly equal to match OPS behaviour for RTTOV
+  ! jacobian calculation.
+  if(self % cloud_retrieval) then
+    call ufo_rttovonedvarcheck_check_ctp(ob % cloudtopp, firstguess_geovals, self %  nlevels)
+  end if
+
+  ! Store background T in ob data space
+  call ufo_geovals_get_var(firstguess_geovals, var_ts, geoval)
+  ob % background_T(:) = geoval%vals(:, 1) ! K
+
+  ! Create ob vector and r matrix
+  jchans_used = 0
+  do jvar = 1, self%nchans
+    if( obs % QCflags(jvar,jobs) == self % passflag ) then
+      jchans_used = jchans_used + 1
+      ob % yobs(jchans_used) = obs % yobs(jvar, jobs)
+      ob % channels_used(jchans_used) = self % channels(jvar)
+    end if
+  end do
+  call rsubmatrix_cache % get(nchans_used, ob % channels_used, full_rmatrix, r_submatrix)
+
+  ! Setup hofxdiags for this retrieval
+  call ufo_geovals_setup(hofxdiags, hofxdiags_vars, 1, hofxdiags_vars % nvars(), ret_nlevs)
+
+  if (self % FullDiagnostics) then
+    call ob % info()
+    call r_submatrix % info()
+    write(*, *) "Observations used = ",ob % yobs(:)
+    write(*,*) "ob % emiss = ",ob % emiss
+    write(*,*) "ob % calc_emiss = ",ob % calc_emiss
+    write(*,*) "Channel selection = "
+    write(*,'(15I5)') ob % channels_used
+    write(*,*) "All Channels = "
+    write(*,'(15I5)') ob % channels_all
+    call local_profindex % info()
+  end if
+
+  !---------------------------------------------------
+  ! 3. Call minimization
+  !---------------------------------------------------
+  if (self % UseMLMinimization) then
+    call ufo_rttovonedvarcheck_minimize_ml(self, ob, &
+                                  r_submatrix, b_matrix, b_inverse, b_sigma, &
+                                  firstguess_geovals, hofxdiags, rttov_simobs, &
+                                  local_profindex, onedvar_success)
+  else
+    call ufo_rttovonedvarcheck_minimize_newton(self, ob, &
+                                  r_submatrix, b_matrix, b_inverse, b_sigma, &
+                                  firstguess_geovals, hofxdiags, rttov_simobs, &
+                                  local_profindex, onedvar_success)
+  end if
+
+  obs % output_BT(:, jobs) = ob % output_BT(:)
+  obs % background_BT(:, jobs) = ob % background_BT(:)
+  obs % output_profile(:,jobs) = ob % output_profile(:)
+  obs % emiss(:, jobs) = ob % emiss(:)
+  obs % final_cost(jobs) = ob % final_cost
+  obs % LWP(jobs) = ob % LWP
+  obs % IWP(jobs) = ob % IWP
+  if (self % store1dvarclw) obs % CLW(:,jobs) = ob % CLW(:)
+  if (self % store1dvartransmittance) obs % transmittance(:, jobs) = ob % transmittance(:)
+  if (self % cloud_retrieval) obs % cloudtopp(jobs) = ob % cloudtopp
+  if (self % cloud_retrieval) obs % cloudfrac(jobs) = ob % cloudfrac
+  if (self % RecalculateBT) obs % recalc_BT(:, jobs) = ob % recalc_BT(:)
+  obs % niter(jobs) = ob % niter
+
+  ! Set QCflags based on output from minimization
+  if (.NOT. onedvar_success) then
+    failed_1dvar = .true.
+    do jvar = 1, self%nchans
+      if( obs % QCflags(jvar,jobs) == 0 ) then
+        obs % QCflags(jvar,jobs) = self % onedvarflag
+      end if
+    end do
+  end if
+
+  ! Remove channels that have been removed because of slow convergence
+  if (ob % QC_SlowConvChans) then
+    do jvar = 1, self % nchans
+      if( obs % QCflags(jvar,jobs) == 0 .and. &
+          any( self % ConvergeCheckChans == obs % channels(jvar) ) ) then
+        obs % QCflags(jvar,jobs) = self % onedvarflag
+      end if
+    end do
+  end if
+
+  ! Reject channels that have failed the ctp check
+  if (allocated(ob % rejected_channels_ctp)) then
+    jnew = 1
+    rejected: do irej = 1, size(ob % rejected_channels_ctp)
+      jvar = jnew
+      do while ( jvar <= size(obs % channels) )
+        if (ob % rejected_channels_ctp(irej) == obs % channels(jvar)) then
+          obs % QCflags(jvar, jobs) = self % onedvarflag
+          cycle rejected
+        end if
+        jvar = jvar + 1
+      end do
+    end do rejected
+  end if
+
+  ! Check the BTs are within a factor of the error.  This only applies to channels that are still
+  ! active.
+  if (self % RetrievedErrorFactor > zero .and. any(obs % QCflags(:,jobs) == self % passflag)) then
+    allocate(max_error(size(ob % channels_used)))
+    call r_submatrix % multiply_factor_by_stdev(self % RetrievedErrorFactor, max_error)
+    reject_profile = .false.
+    chanloop: do jvar = 1, size(ob % channels_used)
+      if (allocated(ob % rejected_channels_ctp)) then
+        if(any(ob % rejected_channels_ctp == ob % channels_used(jvar))) cycle chanloop
+      end if
+      if (abs(ob % final_bt_diff(jvar)) > max_error(jvar)) reject_profile = .true.
+    end do chanloop
+    if (reject_profile) then
+      failed_retrievedBTcheck = .true.
+      do jvar = 1, self % nchans
+        if( obs % QCflags(jvar,jobs) == self % passflag ) then
+          obs % QCflags(jvar,jobs) = self % onedvarflag
+        end if
+      end do
+    end if
+    deallocate(max_error)
+  end if
+
+  ! Tidy up memory specific to a single observation
+  call ufo_geovals_delete(firstguess_geovals)
+  call ufo_geovals_delete(hofxdiags)
+  call ob % delete()
+  call r_submatrix % delete()
+
+end subroutine ufo_rttovonedvarcheck_process_ob
+
 end module ufo_rttovonedvarcheck_mod
@@ -357,10 +357,8 @@ if (allocated(self % output_BT))      deallocate(self % output_BT)
 if (allocated(self % recalc_BT))      deallocate(self % recalc_BT)
 if (allocated(self % background_BT))  deallocate(self % background_BT)
 if (allocated(self % calc_emiss))     deallocate(self % calc_emiss)
-if (associated(self % pcemiss_object)) then
-  call self % pcemiss_object % delete()
-  self % pcemiss_object => null()
-end if
+! The PC emissivity object is shared (see ufo_rttovonedvarcheck_pcemis_shared)
+self % pcemiss_object => null()
 if (allocated(self % pcemiss))        deallocate(self % pcemiss)
 
 end subroutine ufo_rttovonedvarcheck_obs_delete
@@ -433,14 +431,11 @@ integer :: emis_y
 self % emiss(:,:) = zero
 self % calc_emiss(:) = .true.
 allocate(self % pcemiss(nemisspc, self % iloc))
-allocate(self % pcemiss_object)
 
-! Setup pc emissivity object and initialise atlas (if needed)
-if (len(trim(config % EmisAtlas)) > 0) then
-  call self % pcemiss_object % setup(config % EmisEigVecPath, config % EmisAtlas)
-else
-  call self % pcemiss_object % setup(config % EmisEigVecPath)
-end if
+! Get the pc emissivity object, with the atlas (if needed), reading the files only if no
+! earlier observation object has used them
+call ufo_rttovonedvarcheck_pcemis_shared(self % pcemiss_object, config % EmisEigVecPath, &
+                                         config % EmisAtlas)
 
 !-------------------------
 ! 1.2 Principal components
@@ -474,8 +469,8 @@ if (self % pcemiss_object % initialised) then
         ! If the atlas is valid at this point, then use it,
         ! otherwise use PCGuess. NB: missing or sea points are
         ! flagged as -9.99 in the atlas.
-        if (any (self % pcemiss_object % emis_atlas % EmisPC(emis_x,emis_y,:) > -9.99_kind_real)) then
-          self % pcemiss(:,i) = self % pcemiss_object % emis_atlas % EmisPC(emis_x,emis_y,1:nemisspc)
+        if (any (self % pcemiss_object % emis_atlas % EmisPC(:,emis_x,emis_y) > -9.99_kind_real)) then
+          self % pcemiss(:,i) = self % pcemiss_object % emis_atlas % EmisPC(1:nemisspc,emis_x,emis_y)
         else
           self % pcemiss(:,i) = self % pcemiss_object % emis_eigen % PCGuess(1:nemisspc)
           !! Flag invalid atlas points over land as bad surface
@@ -31,6 +31,7 @@ type :: ufo_rttovonedvarcheck_EmisEigenvec
    real(kind_real), allocatable :: PCguess(:)
    real(kind_real), allocatable :: EV(:,:)
    real(kind_real), allocatable :: EV_Inverse(:,:)
+   integer, allocatable :: ChannelLookup(:) !< index in Channels of each channel number (0 if absent)
 end type ufo_rttovonedvarcheck_EmisEigenvec
 
 !< Emissivity eigen vector atlas type definition
@@ -39,7 +40,7 @@ type :: ufo_rttovonedvarcheck_EmisAtlas
    integer          :: Nlon
    integer          :: Npc
    real(kind_real)  :: gridstep
-   real(kind_real), allocatable :: EmisPC(:,:,:)
+   real(kind_real), allocatable :: EmisPC(:,:,:) !< (Npc, Nlon, Nlat) so each grid cell is contiguous
 end type ufo_rttovonedvarcheck_EmisAtlas
 
 !< Principal component emissivity type definition
@@ -62,8 +63,69 @@ contains
 
 end type ufo_rttovonedvarcheck_pcemis
 
+!< PC emissivity object shared by all observation objects using the same files
+type :: ufo_rttovonedvarcheck_pcemis_entry
+  character(len=2*max_string+1) :: key
+  type(ufo_rttovonedvarcheck_pcemis), pointer :: pcemis => null()
+end type ufo_rttovonedvarcheck_pcemis_entry
+
+type(ufo_rttovonedvarcheck_pcemis_entry), allocatable, save :: shared_pcemis(:)
+
+public :: ufo_rttovonedvarcheck_pcemis_shared
+
 contains
 
+!-------------------------------------------------------------------------------
+!> Return a PC emissivity object set up from the eigenvector file and (optionally) the
+!! atlas, reading the files only the first time they are requested in this process.
+!!
+!! Reading the atlas is much more expensive than the 1D-Var setup of a typical batch of
+!! observations, so the object is kept until the end of the process and shared by all the
+!! observation objects (and filters) using the same files. It must not be deleted by its users.
+!!
+!! \author Met Office
+!!
+!! \date 15/10/2026: Created
+!!
+subroutine ufo_rttovonedvarcheck_pcemis_shared(pcemis, filepath, atlaspath)
+
+implicit none
+
+! subroutine arguments:
+type(ufo_rttovonedvarcheck_pcemis), pointer, intent(out) :: pcemis !< shared PC emissivity object
+character(len=*), intent(in) :: filepath
+character(len=*), intent(in) :: atlaspath !< empty if no atlas is used
+
+character(len=2*max_string+1) :: key
+type(ufo_rttovonedvarcheck_pcemis_entry), allocatable :: entries(:)
+integer :: i, nentries
+
+key = trim(filepath) // "|" // trim(atlaspath)
+
+nentries = 0
+if (allocated(shared_pcemis)) nentries = size(shared_pcemis)
+do i = 1, nentries
+  if (shared_pcemis(i) % key == key) then
+    pcemis => shared_pcemis(i) % pcemis
+    return
+  end if
+end do
+
+allocate(pcemis)
+if (len_trim(atlaspath) > 0) then
+  call pcemis % setup(filepath, atlaspath)
+else
+  call pcemis % setup(filepath)
+end if
+
+allocate(entries(nentries + 1))
+if (nentries > 0) entries(1:nentries) = shared_pcemis(:)
+entries(nentries + 1) % key = key
+entries(nentries + 1) % pcemis => pcemis
+call move_alloc(entries, shared_pcemis)
+
+end subroutine ufo_rttovonedvarcheck_pcemis_shared
+
 !-------------------------------------------------------------------------------
 !> Initialize PC emissivity object
 !!
@@ -168,6 +230,15 @@ do i = 1, self % emis_eigen % NumEV
   read (fileunit, *, iostat = readstatus) self % emis_eigen % EV(i,:)
 end do
 
+! Lookup table from channel number to position in the file, so that channel lists can be
+! mapped without searching
+allocate (self % emis_eigen % ChannelLookup(minval(self % emis_eigen % Channels): &
+                                            maxval(self % emis_eigen % Channels)))
+self % emis_eigen % ChannelLookup(:) = 0
+do i = 1, self % emis_eigen % Nchans
+  self % emis_eigen % ChannelLookup(self % emis_eigen % Channels(i)) = i
+end do
+
 ! Has there been an error in the read?
 if (readstatus /= 0) then
   write(message,*) RoutineName,  &
@@ -232,9 +303,9 @@ read (fileunit, *, iostat = readstatus) self % emis_atlas % Nlat, &
                                         self % emis_atlas % Npc, &
                                         self % emis_atlas % gridstep
 
-allocate (self % emis_atlas % EmisPC(self % emis_atlas % Nlon, &
-                                     self % emis_atlas % Nlat, &
-                                     self % emis_atlas % Npc))
+allocate (self % emis_atlas % EmisPC(self % emis_atlas % Npc, &
+                                     self % emis_atlas % Nlon, &
+                                     self % emis_atlas % Nlat))
 
 !--------------------------------------------------------
 ! 2. Read the emissivity PCs
@@ -242,7 +313,7 @@ allocate (self % emis_atlas % EmisPC(self % emis_atlas % Nlon, &
 
 do i = 1, self % emis_atlas % nlon
   do j = 1, self % emis_atlas % nlat
-    read (fileunit, '(12F10.6)', iostat = readstatus) self % emis_atlas % EmisPC(i,j,:)
+    read (fileunit, '(12F10.6)', iostat = readstatus) self % emis_atlas % EmisPC(:,i,j)
   end do
 end do
 
@@ -287,6 +358,7 @@ if (allocated (self % emis_eigen % PCmax)) deallocate (self % emis_eigen % PCmax
 if (allocated (self % emis_eigen % PCguess)) deallocate (self % emis_eigen % PCguess)
 if (allocated (self % emis_eigen % EV)) deallocate (self % emis_eigen % EV)
 if (allocated (self % emis_eigen % EV_Inverse)) deallocate (self % emis_eigen % EV_Inverse)
+if (allocated (self % emis_eigen % ChannelLookup)) deallocate (self % emis_eigen % ChannelLookup)
 
 if (allocated (self % emis_atlas % EmisPC)) deallocate(self % emis_atlas % EmisPC)
 
@@ -400,8 +472,7 @@ real(kind_real), intent(out) :: Emissivity(:)
 
 ! Local declarations:
 character(len=*), parameter :: RoutineName = "ufo_rttovonedvarcheck_PCToEmis"
-real(kind_real)             :: BigEOF(NumChans,NumChans)
-real(kind_real)             :: BigPC(NumChans)
+integer                     :: ichan
 integer                     :: ChannelIndex(NumChans)
 
 ! Check the input
@@ -417,19 +488,14 @@ if (size(Emissivity) /= NumChans) &
 ! Create the input channel to pc emissivity index mapping
 call self % mapchannels(Channels, ChannelIndex)
 
-! Populate PC array with nchans elements
-BigPC(:) = 0.0_kind_real
-BigPC(1:NumPC) = PC(:)
-
-! Populate EOF array with nchans elements
-BigEOF(:,:) = 0.0_kind_real
-BigEOF(1:NumPC,:) = self % emis_eigen % EV(1:NumPC,ChannelIndex)
-
-! Calculate reconstructed emissivity spectrum
-Emissivity = matmul(BigPC, BigEOF)
-
-! Add means (these may have been subtracted off, otherwise they are zero)
-Emissivity(:) = Emissivity(:) + self % emis_eigen % Mean(ChannelIndex)
+! Calculate reconstructed emissivity spectrum and add means (these may have been
+! subtracted off, otherwise they are zero). The eigenvectors of each channel are
+! contiguous in EV.
+do ichan = 1, NumChans
+  Emissivity(ichan) = dot_product(PC(1:NumPC), &
+                                  self % emis_eigen % EV(1:NumPC,ChannelIndex(ichan))) + &
+                      self % emis_eigen % Mean(ChannelIndex(ichan))
+end do
 
 ! Convert from sine transform to physical emissivity
 Emissivity(1:NumChans) = half * (sin(Emissivity(1:NumChans)) + one)
@@ -501,7 +567,12 @@ end do
 end subroutine ufo_rttovonedvarcheck_EmisKToPC
 
 !-------------------------------------------------------------------------------
-
+!> Find the position of each channel of TestChannels in the eigenvector file.
+!!
+!! \author Met Office
+!!
+!! \date 04/08/2020: Created
+!!
 subroutine ufo_rttovonedvarcheck_channelmapping(self, TestChannels, ChannelIndex)
 
 implicit none
@@ -510,23 +581,25 @@ class(ufo_rttovonedvarcheck_pcemis), intent(inout) :: self !< PC emissivity type
 integer, intent(in)  :: TestChannels(:)
 integer, intent(out) :: ChannelIndex(:)
 
-integer :: ichan, ochan, jnew
+integer :: ichan
+character(len=max_string) :: message
 
 if (size(ChannelIndex) /= size(TestChannels)) then
   call abor1_ftn("rttovonedvarcheck pcemiss mod: ChannelIndex not the same size as TestChannels => aborting")
 end if
 
-jnew = 1
-outer: do ichan = 1, size(TestChannels)
-  ochan = jnew
-  do while ( ochan <= self % emis_eigen % NChans )
-    if (TestChannels(ichan) == self % emis_eigen % Channels(ochan)) then
-      ChannelIndex(ichan) = ochan
-      cycle outer
-    end if
-    ochan = ochan + 1
-  end do
-end do outer
+do ichan = 1, size(TestChannels)
+  ChannelIndex(ichan) = 0
+  if (TestChannels(ichan) >= lbound(self % emis_eigen % ChannelLookup, 1) .and. &
+      TestChannels(ichan) <= ubound(self % emis_eigen % ChannelLookup, 1)) then
+    ChannelIndex(ichan) = self % emis_eigen % ChannelLookup(TestChannels(ichan))
+  end if
+  if (ChannelIndex(ichan) == 0) then
+    write(message, '(A,I0,A)') "rttovonedvarcheck pcemiss mod: channel ", TestChannels(ichan), &
+                               " not in the emissivity eigenvector file => aborting"
+    call abor1_ftn(message)
+  end if
+end do
 
 end subroutine ufo_rttovonedvarcheck_channelmapping
 
@@ -39,6 +39,22 @@ contains
 
 end type ufo_rttovonedvarcheck_rsubmatrix
 
+!> Cache of the r sub-matrices already set up for a channel selection
+!!
+!! After cloud detection most observations use one of a few channel selections, so
+!! the sub-matrix of each selection is only extracted from the full r-matrix once
+!! and then copied.  The cache can be used by several threads at the same time.
+type, public :: ufo_rttovonedvarcheck_rsubmatrix_cache
+
+  integer :: nentries = 0 !< number of channel selections stored
+  type(ufo_rttovonedvarcheck_rsubmatrix), allocatable :: entries(:) !< r sub-matrix of each selection
+
+contains
+  procedure :: get    => rsubmatrix_cache_get
+  procedure :: delete => rsubmatrix_cache_delete
+
+end type ufo_rttovonedvarcheck_rsubmatrix_cache
+
 ! ------------------------------------------------------------------------------
 contains
 ! ------------------------------------------------------------------------------
@@ -342,6 +358,81 @@ end if
 
 end subroutine rsubmatrix_reset_errors
 
+! ------------------------------------------------------------------------------
+!> Setup r_submatrix for the channels used, reusing the sub-matrix set up for an
+!! earlier observation using the same channels if there is one.
+!!
+!! \author Met Office
+!!
+!! \date 15/10/2026: Created
+!!
+subroutine rsubmatrix_cache_get(self, nchans, channels, full_rmatrix, r_submatrix)
+
+implicit none
+class(ufo_rttovonedvarcheck_rsubmatrix_cache), intent(inout) :: self
+integer, intent(in)                                   :: nchans
+integer, intent(in)                                   :: channels(:)
+type(ufo_metoffice_rmatrixradiance), intent(in)       :: full_rmatrix
+type(ufo_rttovonedvarcheck_rsubmatrix), intent(inout) :: r_submatrix !< copy of the cached matrix
+
+type(ufo_rttovonedvarcheck_rsubmatrix), allocatable :: entries(:)
+integer :: ientry
+logical :: found
+
+call r_submatrix % delete()
+
+!$omp critical (rsubmatrix_cache)
+found = .false.
+do ientry = 1, self % nentries
+  if (self % entries(ientry) % nchans == nchans) then
+    if (all(self % entries(ientry) % channels(:) == channels(1:nchans))) then
+      found = .true.
+      exit
+    end if
+  end if
+end do
+
+if (.not. found) then
+  if (self % nentries == 0) then
+    if (.not. allocated(self % entries)) allocate(self % entries(8))
+  else if (self % nentries == size(self % entries)) then
+    allocate(entries(2 * self % nentries))
+    entries(1:self % nentries) = self % entries(:)
+    call move_alloc(entries, self % entries)
+  end if
+  ientry = self % nentries + 1
+  call self % entries(ientry) % setup(nchans, channels, full_rmatrix)
+  self % nentries = ientry
+end if
+
+! The copy is modified by the minimisers (see reset_errors)
+r_submatrix = self % entries(ientry)
+!$omp end critical (rsubmatrix_cache)
+
+end subroutine rsubmatrix_cache_get
+
+! ------------------------------------------------------------------------------
+!> Delete method for the r sub-matrix cache
+!!
+!! \author Met Office
+!!
+!! \date 15/10/2026: Created
+!!
+subroutine rsubmatrix_cache_delete(self)
+
+implicit none
+class(ufo_rttovonedvarcheck_rsubmatrix_cache), intent(inout) :: self
+
+integer :: ientry
+
+do ientry = 1, self % nentries
+  call self % entries(ientry) % delete()
+end do
+if (allocated(self % entries)) deallocate(self % entries)
+self % nentries = 0
+
+end subroutine rsubmatrix_cache_delete
+
 ! ------------------------------------------------------------------------------
 !> Print the contents of the r-matrix
 !!
@@ -45,6 +45,7 @@ type, public :: ufo_rttovonedvarcheck
   integer, allocatable             :: ChannelToEmissMap(:) !< integer list to map channels to emissivity elements
   integer                          :: StartOb !< starting ob number for testing
   integer                          :: FinishOb !< finishing ob number for testing
+  integer                          :: nthreads !< number of threads running the 1D-Var
   logical                          :: qtotal !< flag to enable total humidity retrievals
   logical                          :: UseQtsplitRain !< flag to choose whether to split rain in qsplit routine
   logical                          :: RTTOV_mwscattSwitch !< flag to switch on RTTOV-scatt
@@ -72,6 +73,7 @@ type, public :: ufo_rttovonedvarcheck
   real(kind_real)                  :: RetrievedErrorFactor !< check retrieved BTs all within factor * stdev of obs
   real(kind_real)                  :: ConvergenceFactor !< 1d-var convergence if using change in profile
   real(kind_real)                  :: Cost_ConvergenceFactor !< 1d-var convergence if using % change in cost
+  real(kind_real)                  :: JacobianReuseFactor !< reuse the jacobian if the profile change is below this * stdev
   real(kind_real)                  :: MaxLWPForCloudyCheck !< Maximum lwp when performing the cloudy check
   real(kind_real)                  :: MaxIWPForCloudyCheck !< Maximum iwp when performing the cloudy check
   real(kind_real)                  :: EmissSeaDefault !< default emissivity value to use over sea
@@ -212,6 +214,10 @@ call f_conf % get_or_die("ConvergenceFactor", self % ConvergenceFactor)
 ! Cost threshold for convergence check when cost function value is used for convergence
 call f_conf % get_or_die("CostConvergenceFactor", self % Cost_ConvergenceFactor)
 
+! Reuse the jacobian of the previous iteration if the profile changed by less than
+! this factor * background error standard deviation (0 = always recalculate)
+call f_conf % get_or_die("JacobianReuseFactor", self % JacobianReuseFactor)
+
 ! Maximum lwp when performing the cloudy check in kg/m2
 call f_conf % get_or_die("MaxLWPForCloudyCheck", self % MaxLWPForCloudyCheck)
 
@@ -244,6 +250,10 @@ end if
 ! is done because the value has to be positive.
 call f_conf % get_or_die("SkinTempErrorLand", self % SkinTempErrorLand)
 
+! Number of threads running the 1D-Var on different observations
+call f_conf % get_or_die("NumThreads", self % nthreads)
+self % nthreads = max(1, self % nthreads)
+
 ! Starting observation number for loop - used for testing
 call f_conf % get_or_die("StartOb", self % StartOb)
 
@@ -375,6 +385,7 @@ write(*,*) "JConvergenceOption = ",self % JConvergenceOption
 write(*,*) "IterNumForLWPCheck = ",self % IterNumForLWPCheck
 write(*,*) "ConvergenceFactor = ",self % ConvergenceFactor
 write(*,*) "CostConvergenceFactor = ",self % Cost_ConvergenceFactor
+write(*,*) "JacobianReuseFactor = ",self % JacobianReuseFactor
 write(*,*) "MaxLWPForCloudyCheck = ",self % MaxLWPForCloudyCheck
 write(*,*) "MaxIWPForCloudyCheck = ",self % MaxIWPForCloudyCheck
 write(*,*) "MaxMLIterations = ",self % MaxMLIterations
@@ -389,6 +400,7 @@ write(*,*) "Store1DVarLWP = ",self % Store1DVarLWP
 write(*,*) "Store1DVarIWP = ",self % Store1DVarIWP
 write(*,*) "Store1DVarCLW = ",self % Store1DVarCLW
 write(*,*) "Store1DvarTransmittance = ",self % Store1DVarTransmittance
+write(*,*) "NumThreads = ",self % nthreads
 write(*,*) "Emissivity variables:"
 write(*,*) "emissivity type = ",self % EmissivityType
 write(*,*) "EmissSeaDefault = ",self % EmissSeaDefault
@@ -30,6 +30,7 @@ public ufo_rttovonedvarcheck_all_to_subset_by_channels
 public ufo_rttovonedvarcheck_subset_to_all_by_channels
 
 character(len=max_string) :: message
+!$omp threadprivate(message)
 
 contains
 
@@ -23,10 +23,17 @@ void ufo_fov_delete_f90(F90fov &);
 void ufo_fov_ellipse_f90(const F90fov &, const int &, const char *,
                          const double &, const double &, const double &,
                          const double &, const int &, double &, double &);
+void ufo_fov_ellipses_f90(const F90fov &, const int &, const char *, const int &,
+                          const double &, const double &, const double &,
+                          const double &, const int &, double &, double &);
 void ufo_antenna_power_within_fov_f90(const F90fov &, const int &, const char *,
                                       const double &, const double &, const double &,
                                       const double &, const double &, const double &,
                                       double &);
+void ufo_antenna_powers_within_fov_f90(const F90fov &, const int &, const char *,
+                                       const double &, const double &, const double &,
+                                       const double &, const int &, const double &,
+                                       const double &, double &);
 
 // -----------------------------------------------------------------------------
 
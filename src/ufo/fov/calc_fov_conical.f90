@@ -26,6 +26,9 @@
 !   def  rmax                  - major axis of ellipse
 !   def  rmin                  - minor axis of ellipse
 !   def  eccen                 - fov eccentricity
+!   def  cospsi, sinpsi        - cosine and sine of psi
+!   def  cosr, sinr            - cosine and sine of the angular distance from the fov
+!                                center to each vertex of the fov polygon, for each channel
 !   def  maxinstr              - maximum number of instruments
 !   def  npoly                 - number of vertices in the fov polygon
 !   def  radius                - radius of earth in km
@@ -65,6 +68,10 @@
  real(r_kind), private :: rmin(nchan)
  real(r_kind), private :: eccen(nchan)
  real(r_kind), private :: psi(npoly)
+ real(r_kind), private :: cospsi(npoly)
+ real(r_kind), private :: sinpsi(npoly)
+ real(r_kind), private :: cosr(npoly,nchan)
+ real(r_kind), private :: sinr(npoly,nchan)
 
 ! These SSMIS values are the average of the 0 and 90 deg cuts as determined by
 ! plot_test_conical_fov.f90
@@ -637,7 +644,7 @@ subroutine instrument_init(instr,satid,expansion,valid)
 !$$$
 
  use calc_fov_crosstrk, only : get_sat_height
- use ufo_constants_mod, only : pi, one, two, half, zero
+ use ufo_constants_mod, only : pi, one, two, half, zero, deg2rad
 
  implicit none
 
@@ -650,6 +657,7 @@ subroutine instrument_init(instr,satid,expansion,valid)
 ! Declare local variables.
  integer                            :: i, jchan, minstr
  real(r_kind)                       :: ata, cta, atf, ctf, ratio, height
+ real(r_kind)                       :: r(npoly)
 
  valid=.true.
 
@@ -685,6 +693,8 @@ subroutine instrument_init(instr,satid,expansion,valid)
  do i = 1 , npoly
     psi(i) = two*pi*(i-1)/(npoly-1)  ! will connect npoly points
  enddo
+ cospsi = cos(psi)
+ sinpsi = sin(psi)
 
  call get_sat_height(satid, height, valid)
  if(.not.valid) return
@@ -706,6 +716,14 @@ subroutine instrument_init(instr,satid,expansion,valid)
 
  if(instr == 25) eccen = zero  ! default circular fov
 
+! The fov polygon only depends on the channel and the satellite azimuth, so the angular
+! distance from the fov center to each vertex is tabulated here for each channel.
+ do jchan = 1 , nchan
+    r(:) = rmax(jchan) * sqrt( (one - eccen(jchan)**2)/(one - eccen(jchan)**2 *cospsi(:)**2) )
+    cosr(:,jchan) = cos(r(:)*deg2rad)
+    sinr(:,jchan) = sin(r(:)*deg2rad)
+ enddo
+
  return
 
 end subroutine instrument_init
@@ -871,7 +889,7 @@ subroutine fov_ellipse_conical(ichan,satellite_azimuth,lat,lon,elats,elons)
 !
 !$$$
 
- use ufo_constants_mod, only : one, rad2deg
+ use ufo_constants_mod, only : one, rad2deg, deg2rad
 
  implicit none
 
@@ -886,22 +904,27 @@ subroutine fov_ellipse_conical(ichan,satellite_azimuth,lat,lon,elats,elons)
 ! Declare local variables
  integer                        :: i ! loop counters
  real(r_kind)                   :: pos_ang ! rotation angle of the ellipse
- real(r_kind), dimension(npoly) :: psip
- real(r_kind), dimension(npoly) :: r
+ real(r_kind)                   :: cos_pos_ang, sin_pos_ang, coscolat, sincolat
+ real(r_kind), dimension(npoly) :: cospsip
+ real(r_kind), dimension(npoly) :: sinpsip
  real(r_kind), dimension(npoly) :: cosc
  real(r_kind), dimension(npoly) :: c
  real(r_kind), dimension(npoly) :: sinb
  real(r_kind), dimension(npoly) :: b
 
  pos_ang = satellite_azimuth 
- psip    = psi + pos_ang/rad2deg 
- r       = rmax(ichan) * sqrt( (one - eccen(ichan)**2)/(one - eccen(ichan)**2 *cos(psi)**2) )
- cosc    = cos((90._r_kind-lat)/rad2deg)*cos(r/rad2deg) + &
-           sin((90._r_kind-lat)/rad2deg)*sin(r/rad2deg)*cos(psip)
+ ! psip = psi + pos_ang; the vertex distances r are tabulated in instrument_init
+ cos_pos_ang = cos(pos_ang*deg2rad)
+ sin_pos_ang = sin(pos_ang*deg2rad)
+ cospsip  = cospsi*cos_pos_ang - sinpsi*sin_pos_ang
+ sinpsip  = sinpsi*cos_pos_ang + cospsi*sin_pos_ang
+ coscolat = cos((90._r_kind-lat)/rad2deg)
+ sincolat = sin((90._r_kind-lat)/rad2deg)
+ cosc    = coscolat*cosr(:,ichan) + sincolat*sinr(:,ichan)*cospsip
  c       = acos(cosc)*rad2deg
 
  elats(1:npoly) = 90._r_kind - c
- sinb = sin(r/rad2deg)*sin(psip)/sin(c/rad2deg)
+ sinb = sinr(:,ichan)*sinpsip/sin(c/rad2deg)
 
 ! handle numeric imprecision 
  do i = 1 , npoly
@@ -41,6 +41,9 @@
 !   def  psi                   - angle of each vertex of fov polygon
 !   def  rmax                  - major axis of ellipse
 !   def  rmin                  - minor axis of ellipse
+!   def  cospsi, sinpsi        - cosine and sine of psi
+!   def  cosr, sinr            - cosine and sine of the angular distance from the fov
+!                                center to each vertex of the fov polygon, for each fov
 !
 !$$$ end documentation block
 
@@ -73,6 +76,10 @@
  real(r_kind) , dimension(:), allocatable, private :: rmin
  real(r_kind) , dimension(:), allocatable, private :: eccen
  real(r_kind) , private                            :: psi(npoly)
+ real(r_kind) , private                            :: cospsi(npoly)
+ real(r_kind) , private                            :: sinpsi(npoly)
+ real(r_kind) , dimension(:,:), allocatable, private :: cosr
+ real(r_kind) , dimension(:,:), allocatable, private :: sinr
 
  public get_sat_height
  public instrument_init
@@ -751,7 +758,7 @@
 !
 !$$$
 
- use ufo_constants_mod, only : pi, half, one, two
+ use ufo_constants_mod, only : pi, half, one, two, deg2rad
 
  implicit none
 
@@ -764,6 +771,7 @@
 ! Declare local variables.
  integer                            :: i, ifov
  real(r_kind)                       :: ata, cta, atf, ctf, ratio, height
+ real(r_kind)                       :: r(npoly)
 
  valid=.true.
  if (instr < 1 .or. instr > maxinstr) then
@@ -790,10 +798,14 @@
  allocate (rmax(1:maxfov(instr)))
  allocate (rmin(1:maxfov(instr)))
  allocate (eccen(1:maxfov(instr)))
+ allocate (cosr(npoly,1:maxfov(instr)))
+ allocate (sinr(npoly,1:maxfov(instr)))
  
  do i = 1, npoly
     psi(i) = two*pi*float(i-1)/float(npoly-1) ! Will connect Npoly points
  enddo
+ cospsi = cos(psi)
+ sinpsi = sin(psi)
  
 ! Precompute angles and sizes for speed. For accurate representation of fov, 
 ! this computation should go with the height from the 1B.
@@ -815,6 +827,14 @@
     eccen(i) = sqrt(one - ratio)
  enddo
 
+! The fov polygon only depends on the fov and the satellite azimuth, so the angular
+! distance from the fov center to each vertex is tabulated here for each fov.
+ do ifov = 1 , maxfov(instr)
+    r(:) = rmax(ifov) * sqrt( (one - eccen(ifov)**2)/(one - eccen(ifov)**2 *cospsi(:)**2) )
+    cosr(:,ifov) = cos(r(:)*deg2rad)
+    sinr(:,ifov) = sin(r(:)*deg2rad)
+ enddo
+
 ! set antenna power coefficients for amsu-a sensor.  each satellite
 ! has different coefficients.  i had to create separate data
 ! statements becuase a single data statement had too many elements
@@ -905,6 +925,8 @@
  if(allocated(rmax))              deallocate (rmax)
  if(allocated(rmin))              deallocate (rmin)
  if(allocated(eccen))             deallocate (eccen)
+ if(allocated(cosr))              deallocate (cosr)
+ if(allocated(sinr))              deallocate (sinr)
 
  end subroutine fov_cleanup
  subroutine fov_ellipse_crosstrk (ifov, instr, satellite_azimuth,  &
@@ -977,7 +999,7 @@
 !
 !$$$
 
- use ufo_constants_mod, only : rad2deg, one
+ use ufo_constants_mod, only : rad2deg, deg2rad, one
 
  implicit none
 
@@ -994,7 +1016,8 @@
  integer :: i ! loop counters
  integer :: fov
  real(r_kind):: pos_ang ! rotation angle of the ellipse
- real(r_kind):: psip(npoly), r(npoly), cosc(npoly), c(npoly), sinb(npoly), b(npoly)
+ real(r_kind):: cos_pos_ang, sin_pos_ang, coscolat, sincolat
+ real(r_kind):: cospsip(npoly), sinpsip(npoly), cosc(npoly), c(npoly), sinb(npoly), b(npoly)
 
  fov = ifov
  if(instr == 18) then   ! iasi
@@ -1005,15 +1028,19 @@
  if(pos_ang > 180._r_kind)  pos_ang = pos_ang-360._r_kind
  if(pos_ang < -180._r_kind) pos_ang = 360._r_kind + pos_ang
 
- psip    = psi + pos_ang/rad2deg
- r       = rmax(fov) * sqrt( (one - eccen(fov)**2)/(one - eccen(fov)**2 *cos(psi)**2) ) 
- cosc    = cos((90._r_kind-lat)/rad2deg)*cos(r/rad2deg) + &
-           sin((90._r_kind-lat)/rad2deg)*sin(r/rad2deg)*cos(psip)
+ ! psip = psi + pos_ang; the vertex distances r are tabulated in instrument_init
+ cos_pos_ang = cos(pos_ang*deg2rad)
+ sin_pos_ang = sin(pos_ang*deg2rad)
+ cospsip  = cospsi*cos_pos_ang - sinpsi*sin_pos_ang
+ sinpsip  = sinpsi*cos_pos_ang + cospsi*sin_pos_ang
+ coscolat = cos((90._r_kind-lat)/rad2deg)
+ sincolat = sin((90._r_kind-lat)/rad2deg)
+ cosc    = coscolat*cosr(:,fov) + sincolat*sinr(:,fov)*cospsip
  c       = acos(cosc)*rad2deg
 
  elats(1:npoly) = 90._r_kind - c
 
- sinb = sin(r/rad2deg)*sin(psip)/sin(c/rad2deg)
+ sinb = sinr(:,fov)*sinpsip/sin(c/rad2deg)
  do i = 1 , npoly  ! handle numeric imprecision
     if(sinb(i) >  one) sinb(i) =  one
     if(sinb(i) < -(one)) sinb(i) = -(one)
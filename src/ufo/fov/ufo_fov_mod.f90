@@ -27,7 +27,9 @@ module ufo_fov_mod
     procedure :: setup  => ufo_fov_setup
     procedure :: delete => ufo_fov_delete
     procedure :: fov_ellipse => ufo_fov_ellipse
+    procedure :: fov_ellipses => ufo_fov_ellipses
     procedure :: antenna_power_within_fov => ufo_fov_inside_fov
+    procedure :: antenna_powers_within_fov => ufo_fov_inside_fov_batch
   end type ufo_fov
 
 contains
@@ -141,6 +143,34 @@ contains
 
   end subroutine ufo_fov_ellipse
 
+  ! ------------------------------------------------------------------------------
+  !> Compute the field of view ellipses of \p nobs observations; see ufo_fov_ellipse. The
+  !> ellipse geometry that only depends on the scan position is tabulated at setup, so each
+  !> ellipse only costs the trigonometry depending on the azimuth and the fov center.
+  subroutine ufo_fov_ellipses(self, sensor, nobs, scan_positions, sat_azimuth_angles, &
+                              fov_center_lons, fov_center_lats, fov_ellipse_lons, fov_ellipse_lats)
+    use calc_fov_crosstrk, only: npoly
+
+    class(ufo_fov), intent(in) :: self
+    character(len=*), intent(in) :: sensor
+    integer, intent(in) :: nobs
+    real(kind_real), intent(in) :: scan_positions(nobs)
+    real(kind_real), intent(in) :: sat_azimuth_angles(nobs)
+    real(kind_real), intent(in) :: fov_center_lons(nobs)
+    real(kind_real), intent(in) :: fov_center_lats(nobs)
+    real(kind_real), intent(out) :: fov_ellipse_lons(npoly, nobs)
+    real(kind_real), intent(out) :: fov_ellipse_lats(npoly, nobs)
+
+    integer :: iobs
+
+    do iobs = 1, nobs
+      call self%fov_ellipse(sensor, scan_positions(iobs), sat_azimuth_angles(iobs), &
+                            fov_center_lons(iobs), fov_center_lats(iobs), &
+                            fov_ellipse_lons(:, iobs), fov_ellipse_lats(:, iobs))
+    end do
+
+  end subroutine ufo_fov_ellipses
+
   ! ------------------------------------------------------------------------------
   !> Compute the antenna power for a test point within a field of view. The result is the relative
   !> antenna power in [0-1], or 0 if the test point is outside the field of view ellipse.
@@ -175,5 +205,32 @@ contains
   end subroutine ufo_fov_inside_fov
 
   ! ------------------------------------------------------------------------------
+  !> Compute the antenna power at \p ntest test points for a single field of view; see
+  !> ufo_fov_inside_fov.
+  subroutine ufo_fov_inside_fov_batch(self, sensor, scan_position, sat_azimuth_angle, &
+                                      fov_center_lon, fov_center_lat, ntest, test_lons, &
+                                      test_lats, antenna_powers)
+    class(ufo_fov), intent(in) :: self
+    character(len=*), intent(in) :: sensor
+    real(kind_real), intent(in) :: scan_position
+    real(kind_real), intent(in) :: sat_azimuth_angle
+    real(kind_real), intent(in) :: fov_center_lon
+    real(kind_real), intent(in) :: fov_center_lat
+    integer, intent(in) :: ntest
+    real(kind_real), intent(in) :: test_lons(ntest)
+    real(kind_real), intent(in) :: test_lats(ntest)
+    real(kind_real), intent(out) :: antenna_powers(ntest)
+
+    integer :: itest
+
+    do itest = 1, ntest
+      call self%antenna_power_within_fov(sensor, scan_position, sat_azimuth_angle, &
+                                         fov_center_lon, fov_center_lat, &
+                                         test_lons(itest), test_lats(itest), antenna_powers(itest))
+    end do
+
+  end subroutine ufo_fov_inside_fov_batch
+
+  ! ------------------------------------------------------------------------------
 
 end module ufo_fov_mod
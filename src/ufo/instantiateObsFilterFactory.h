@@ -41,16 +41,20 @@
 #include "ufo/filters/ProfileBackgroundCheck.h"
 #include "ufo/filters/ProfileFewObsCheck.h"
 #include "ufo/filters/QCmanager.h"
+#include "ufo/filters/RadarSuperobbing.h"
 #include "ufo/filters/SatName.h"
+#include "ufo/filters/SatelliteSuperobbing.h"
 #include "ufo/filters/SatwindInversionCorrection.h"
 #include "ufo/filters/SpikeAndStepCheck.h"
 #include "ufo/filters/StuckCheck.h"
 #include "ufo/filters/TemporalThinning.h"
+#include "ufo/filters/TimedConstruction.h"
 #include "ufo/filters/Thinning.h"
 #include "ufo/filters/TrackCheck.h"
 #include "ufo/filters/TrackCheckShip.h"
 #include "ufo/filters/VariableAssignment.h"
 #include "ufo/filters/VariableTransforms.h"
+#include "ufo/filters/VariableTransformsPipeline.h"
 #include "ufo/operators/gnssro/QC/BackgroundCheckRONBAM.h"
 #include "ufo/operators/gnssro/QC/ROobserror.h"
 
@@ -63,105 +67,112 @@
 namespace ufo {
 void instantiateObsFilterFactory() {
   oops::instantiateObsFilterFactory<ObsTraits>();
-  static oops::interface::FilterMaker<ObsTraits, AcceptList>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<AcceptList>>
            acceptListMaker("AcceptList");
-  static oops::interface::FilterMaker<ObsTraits, BackgroundCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<BackgroundCheck>>
            backgroundCheckMaker("Background Check");
-  static oops::interface::FilterMaker<ObsTraits, BackgroundCheckRONBAM>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<BackgroundCheckRONBAM>>
            backgroundCheckRONBAMMaker("Background Check RONBAM");
-  static oops::interface::FilterMaker<ObsTraits, BayesianBackgroundCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<BayesianBackgroundCheck>>
            BayesianBackgroundCheckMaker("Bayesian Background Check");
-  static oops::interface::FilterMaker<ObsTraits, BayesianBackgroundQCFlags>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<BayesianBackgroundQCFlags>>
            BayesianBackgroundQCFlagsMaker("Bayesian Background QC Flags");
-  static oops::interface::FilterMaker<ObsTraits, ProbabilityGrossErrorWholeReport>
+  static oops::interface::FilterMaker<ObsTraits,
+                                      TimedConstruction<ProbabilityGrossErrorWholeReport>>
            ProbabilityGrossErrorWholeReportMaker("Bayesian Whole Report");
-  static oops::interface::FilterMaker<ObsTraits, BlackList>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<BlackList>>
            blackListMaker("BlackList");  // same as RejectList
-  static oops::interface::FilterMaker<ObsTraits, ObsBoundsCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<ObsBoundsCheck>>
            boundsCheckMaker("Bounds Check");
-  static oops::interface::FilterMaker<ObsTraits, ConventionalProfileProcessing>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<ConventionalProfileProcessing>>
            conventionalProfileProcessingMaker("Conventional Profile Processing");
-  static oops::interface::FilterMaker<ObsTraits, CreateDiagnosticFlags>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<CreateDiagnosticFlags>>
              CreateDiagnosticFlagsMaker("Create Diagnostic Flags");
-  static oops::interface::FilterMaker<ObsTraits, ObsDerivativeCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<ObsDerivativeCheck>>
            DerivativeCheckMaker("Derivative Check");
-  static oops::interface::FilterMaker<ObsTraits, DifferenceCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<DifferenceCheck>>
            differenceCheckMaker("Difference Check");
-  static oops::interface::FilterMaker<ObsTraits, ObsDomainCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<ObsDomainCheck>>
            domainCheckMaker("Domain Check");
-  static oops::interface::FilterMaker<ObsTraits, ObsDomainErrCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<ObsDomainErrCheck>>
            domainErrCheckMaker("DomainErr Check");
-  static oops::interface::FilterMaker<ObsTraits, FinalCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<FinalCheck>>
            finalCheckMaker("Final Check");
-  static oops::interface::FilterMaker<ObsTraits, Gaussian_Thinning>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<Gaussian_Thinning>>
            gaussianThinningMaker("Gaussian Thinning");
-  static oops::interface::FilterMaker<ObsTraits, GNSSROOneDVarCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<GNSSROOneDVarCheck>>
            GNSSROOneDVarCheckMaker("GNSS-RO 1DVar Check");
-  static oops::interface::FilterMaker<ObsTraits, ImpactHeightCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<ImpactHeightCheck>>
            ImpactHeightCheckMaker("GNSSRO Impact Height Check");
-  static oops::interface::FilterMaker<ObsTraits, HistoryCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<HistoryCheck>>
            historyCheckMaker("History Check");
-  static oops::interface::FilterMaker<ObsTraits, MetOfficeBuddyCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<MetOfficeBuddyCheck>>
            MetOfficeBuddyCheckMaker("Met Office Buddy Check");
-  static oops::interface::FilterMaker<ObsTraits, ModelBestFitPressure>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<ModelBestFitPressure>>
            ModelBestFitPressureMaker("Model Best Fit Pressure");
-  static oops::interface::FilterMaker<ObsTraits, ModelObThreshold>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<ModelObThreshold>>
            ModelObThresholdMaker("ModelOb Threshold");
-  static oops::interface::FilterMaker<ObsTraits, MWCLWCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<MWCLWCheck>>
            MWCLWCheckMaker("MWCLW Check");
-  static oops::interface::FilterMaker<ObsTraits, PerformAction>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<PerformAction>>
            performActionMaker("Perform Action");
-  static oops::interface::FilterMaker<ObsTraits, PoissonDiskThinning>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<PoissonDiskThinning>>
            poissonDiskThinningMaker("Poisson Disk Thinning");
-  static oops::interface::FilterMaker<ObsTraits, PreQC>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<PreQC>>
            preQCMaker("PreQC");
-  static oops::interface::FilterMaker<ObsTraits, PrintFilterData>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<PrintFilterData>>
            printFilterDataMaker("Print Filter Data");
-  static oops::interface::FilterMaker<ObsTraits, ProcessAMVQI>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<ProcessAMVQI>>
              ProcessAMVQIMaker("Process AMV QI");
-  static oops::interface::FilterMaker<ObsTraits, ProfileBackgroundCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<ProfileBackgroundCheck>>
            ProfileBackgroundCheckMaker("Profile Background Check");
-  static oops::interface::FilterMaker<ObsTraits, ProfileFewObsCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<ProfileFewObsCheck>>
            ProfileFewObsCheckMaker("Profile Few Observations Check");
-  static oops::interface::FilterMaker<ObsTraits, BlackList>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<RadarSuperobbing>>
+           radarSuperobbingMaker("Radar Superobbing");
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<BlackList>>
            rejectListMaker("RejectList");  // same as BlackList
-  static oops::interface::FilterMaker<ObsTraits, ROobserror>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<ROobserror>>
            ROobserrorMaker("ROobserror");
-  static oops::interface::FilterMaker<ObsTraits, QCmanager>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<QCmanager>>
            qcManagerMaker("QCmanager");
-  static oops::interface::FilterMaker<ObsTraits, SatName>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<SatName>>
            satnameCheckMaker("satname");
-  static oops::interface::FilterMaker<ObsTraits, SatwindInversionCorrection>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<SatelliteSuperobbing>>
+           satelliteSuperobbingMaker("Satellite Superobbing");
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<SatwindInversionCorrection>>
              SatwindInversionCorrectionMaker("Satwind Inversion Correction");
-  static oops::interface::FilterMaker<ObsTraits, TrackCheckShip>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<TrackCheckShip>>
            ShipTrackCheckMaker("Ship Track Check");
-  static oops::interface::FilterMaker<ObsTraits, SpikeAndStepCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<SpikeAndStepCheck>>
            SpikeAndStepCheckMaker("Spike and Step Check");
-  static oops::interface::FilterMaker<ObsTraits, StuckCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<StuckCheck>>
            StuckCheckMaker("Stuck Check");
-  static oops::interface::FilterMaker<ObsTraits, TemporalThinning>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<TemporalThinning>>
            temporalThinningMaker("Temporal Thinning");
-  static oops::interface::FilterMaker<ObsTraits, Thinning>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<Thinning>>
            thinningMaker("Thinning");
-  static oops::interface::FilterMaker<ObsTraits, TrackCheck>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<TrackCheck>>
            TrackCheckMaker("Track Check");
-  static oops::interface::FilterMaker<ObsTraits, VariableAssignment>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<VariableAssignment>>
            variableAssignmentMaker("Variable Assignment");
-  static oops::interface::FilterMaker<ObsTraits, VariableTransforms>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<VariableTransforms>>
            VariableTransformsMaker("Variable Transforms");
-  static oops::interface::FilterMaker<ObsTraits, ObsDiagnosticsWriter>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<VariableTransformsPipeline>>
+           VariableTransformsPipelineMaker("Variable Transforms Pipeline");
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<ObsDiagnosticsWriter>>
            YDIAGsaverMaker("YDIAGsaver");
 
   // Only include this filter if rttov is present
   #if defined(RTTOV_FOUND)
-    static oops::interface::FilterMaker<ObsTraits, RTTOVOneDVarCheck>
+    static oops::interface::FilterMaker<ObsTraits, TimedConstruction<RTTOVOneDVarCheck>>
              RTTOVOneDVarCheckMaker("RTTOV OneDVar Check");
   #endif
 
   // For backward compatibility, register some filters under legacy names used in the past
-  static oops::interface::FilterMaker<ObsTraits, Gaussian_Thinning>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<Gaussian_Thinning>>
            legacyGaussianThinningMaker("Gaussian_Thinning");
-  static oops::interface::FilterMaker<ObsTraits, TemporalThinning>
+  static oops::interface::FilterMaker<ObsTraits, TimedConstruction<TemporalThinning>>
            legacyTemporalThinningMaker("TemporalThinning");
 }
 
@@ -12,6 +12,7 @@
 #include "ufo/obslocalization/ObsHorLocalization.h"
 #include "ufo/obslocalization/ObsHorLocGC99.h"
 #include "ufo/obslocalization/ObsHorLocSOAR.h"
+#include "ufo/obslocalization/ObsHorVertLocalization.h"
 #include "ufo/obslocalization/ObsVertLocalization.h"
 #include "ufo/ObsTraits.h"
 
@@ -25,6 +26,8 @@ template<typename MODEL> void instantiateObsLocFactory() {
            makerBoxCar_("Horizontal Box car");
   static oops::ObsLocalizationMaker<MODEL, ObsTraits, ufo::ObsVertLocalization<MODEL>>
            makerVertLoc_("Vertical localization");
+  static oops::ObsLocalizationMaker<MODEL, ObsTraits, ufo::ObsHorVertLocalization<MODEL>>
+           makerHorVertLoc_("Horizontal and vertical localization");
 }
 
 }  // namespace ufo
@@ -22,14 +22,14 @@ std::size_t locations_get_nlocs_f(const Locations & locs) {
 void locations_get_lons_f(const Locations & locs,
                           const std::size_t & nlocs, double * lons) {
   ASSERT(nlocs == locs.size());
-  const std::vector<float> & data = locs.lons();
+  const std::vector<double> & data = locs.longitudes();
   std::copy(data.begin(), data.end(), lons);
 }
 // -----------------------------------------------------------------------------
 void locations_get_lats_f(const Locations & locs,
                           const std::size_t & nlocs, double * lats) {
   ASSERT(nlocs == locs.size());
-  const std::vector<float> & data = locs.lats();
+  const std::vector<double> & data = locs.latitudes();
   std::copy(data.begin(), data.end(), lats);
 }
 // -----------------------------------------------------------------------------
@@ -0,0 +1,195 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/obslocalization/LocalObsIndex.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "oops/util/Logger.h"
+
+namespace ufo {
+
+namespace {
+
+const char tag[8] = {'U', 'F', 'O', 'L', 'O', 'B', 'S', '2'};
+
+bool keyLess(const LocalObsIndex::Key &a, const LocalObsIndex::Key &b) {
+  return a.lon < b.lon || (a.lon == b.lon && a.lat < b.lat);
+}
+
+/// Size in bytes of an index with the sizes given in \p header.
+size_t fileSize(const LocalObsIndex::Header &header) {
+  return sizeof(tag) + sizeof(LocalObsIndex::Header) +
+      header.npoints * sizeof(LocalObsIndex::Key) + (header.npoints + 1) * sizeof(uint64_t) +
+      header.nlocal * (sizeof(double) + sizeof(int32_t));
+}
+
+template <typename T>
+void writeArray(std::ofstream &os, const T *values, size_t count) {
+  os.write(reinterpret_cast<const char *>(values), count * sizeof(T));
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+bool LocalObsIndex::Header::sameSettings(const Header &other) const {
+  return nlocs == other.nlocs && locationsChecksum == other.locationsChecksum &&
+      windowStart == other.windowStart && windowEnd == other.windowEnd &&
+      lengthscale == other.lengthscale &&
+      searchMethod == other.searchMethod && distanceType == other.distanceType &&
+      maxnobs == other.maxnobs;
+}
+
+// -----------------------------------------------------------------------------
+
+uint64_t LocalObsIndex::locationsChecksum(const std::vector<float> &lons,
+                                          const std::vector<float> &lats) {
+  // 64-bit FNV-1a hash of the bytes of the longitudes followed by those of the latitudes.
+  uint64_t hash = 14695981039346656037ULL;
+  auto add = [&hash](const std::vector<float> &values) {
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(values.data());
+    for (size_t i = 0; i < values.size() * sizeof(float); ++i) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+    }
+  };
+  add(lons);
+  add(lats);
+  return hash;
+}
+
+// -----------------------------------------------------------------------------
+
+std::unique_ptr<const LocalObsIndex> LocalObsIndex::open(const std::string &fileName,
+                                                         const Header &settings) {
+  const int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+    return nullptr;
+  struct stat st;
+  void *mapping = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && st.st_size > 0)
+    mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the file is closed.
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    oops::Log::warning() << "LocalObsIndex: cannot map " << fileName << std::endl;
+    return nullptr;
+  }
+
+  std::unique_ptr<LocalObsIndex> index(new LocalObsIndex());
+  index->mapping_ = mapping;
+  index->mappingSize_ = st.st_size;
+
+  const char *bytes = static_cast<const char *>(mapping);
+  if (index->mappingSize_ < sizeof(tag) + sizeof(Header) ||
+      std::memcmp(bytes, tag, sizeof(tag)) != 0) {
+    oops::Log::warning() << "LocalObsIndex: " << fileName << " is not a local obs index"
+                         << std::endl;
+    return nullptr;
+  }
+  bytes += sizeof(tag);
+  std::memcpy(&index->header_, bytes, sizeof(Header));
+  bytes += sizeof(Header);
+  if (fileSize(index->header_) != index->mappingSize_) {
+    oops::Log::warning() << "LocalObsIndex: " << fileName << " is truncated" << std::endl;
+    return nullptr;
+  }
+  if (!index->header_.sameSettings(settings)) {
+    oops::Log::info() << "LocalObsIndex: " << fileName << " was saved for different "
+                      << "observations or localization settings and will not be used"
+                      << std::endl;
+    return nullptr;
+  }
+
+  // All arrays start at multiples of 8 bytes from the start of the page-aligned mapping.
+  index->keys_ = reinterpret_cast<const Key *>(bytes);
+  bytes += index->header_.npoints * sizeof(Key);
+  index->offsets_ = reinterpret_cast<const uint64_t *>(bytes);
+  bytes += (index->header_.npoints + 1) * sizeof(uint64_t);
+  index->distance_ = reinterpret_cast<const double *>(bytes);
+  bytes += index->header_.nlocal * sizeof(double);
+  index->index_ = reinterpret_cast<const int32_t *>(bytes);
+
+  oops::Log::info() << "LocalObsIndex: using the local obs of " << index->header_.npoints
+                    << " search points saved in " << fileName << std::endl;
+  return std::unique_ptr<const LocalObsIndex>(index.release());
+}
+
+// -----------------------------------------------------------------------------
+
+void LocalObsIndex::save(const std::string &fileName, const Header &settings,
+                         const std::vector<Key> &keys, const std::vector<size_t> &offsets,
+                         const std::vector<double> &distance, const std::vector<int> &index) {
+  ASSERT(offsets.size() == keys.size() + 1);
+  ASSERT(distance.size() == offsets.back());
+  ASSERT(index.size() == offsets.back());
+
+  Header header = settings;
+  header.npoints = keys.size();
+  header.nlocal = distance.size();
+  const std::vector<uint64_t> offsets64(offsets.begin(), offsets.end());
+  const std::vector<int32_t> index32(index.begin(), index.end());
+
+  const std::string tmpFileName = fileName + ".tmp";
+  {
+    std::ofstream os(tmpFileName, std::ios::binary | std::ios::trunc);
+    writeArray(os, tag, sizeof(tag));
+    writeArray(os, &header, 1);
+    writeArray(os, keys.data(), keys.size());
+    writeArray(os, offsets64.data(), offsets64.size());
+    writeArray(os, distance.data(), distance.size());
+    writeArray(os, index32.data(), index32.size());
+    if (!os)
+      throw eckit::WriteError(tmpFileName, Here());
+  }
+  if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+    throw eckit::WriteError(fileName, Here());
+}
+
+// -----------------------------------------------------------------------------
+
+LocalObsIndex::~LocalObsIndex() {
+  if (mapping_ != nullptr)
+    munmap(mapping_, mappingSize_);
+}
+
+// -----------------------------------------------------------------------------
+
+LocalObsIndex::Entry LocalObsIndex::entry(size_t jp) const {
+  Entry entry;
+  entry.size = offsets_[jp + 1] - offsets_[jp];
+  entry.distance = distance_ + offsets_[jp];
+  entry.index = index_ + offsets_[jp];
+  return entry;
+}
+
+// -----------------------------------------------------------------------------
+
+bool LocalObsIndex::find(double lon, double lat, Entry &entry) const {
+  const Key key{lon, lat};
+  const Key *end = keys_ + header_.npoints;
+  const Key *it = std::lower_bound(keys_, end, key, keyLess);
+  if (it == end || it->lon != lon || it->lat != lat)
+    return false;
+  entry = this->entry(it - keys_);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,122 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_OBSLOCALIZATION_LOCALOBSINDEX_H_
+#define UFO_OBSLOCALIZATION_LOCALOBSINDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ufo {
+
+/// \brief Local observations of a set of search points, saved in a binary file so that they can
+/// be reused by a later run (typically the solver of an LETKF run split into separate observer
+/// and solver jobs) without reading the observation locations or searching for them again.
+///
+/// The file is memory-mapped when it is opened, so only the pages holding the search points
+/// actually looked up are read.
+///
+/// File layout (native byte order): the 8-byte tag "UFOLOBS2", a Header, the sorted Keys of
+/// the search points, the offsets (uint64) of the local obs of each point in the next two
+/// arrays, followed by one extra element, the distances (double) and the indices (int32) of the
+/// local obs.
+class LocalObsIndex {
+ public:
+  /// Observations and settings the local obs depend on. An index is only used if it was saved
+  /// for exactly the same observations and settings.
+  struct Header {
+    uint64_t nlocs = 0;
+    /// Checksum of the observation locations (see locationsChecksum()).
+    uint64_t locationsChecksum = 0;
+    /// Assimilation window bounds, in seconds since 1970-01-01T00:00:00Z.
+    int64_t windowStart = 0;
+    int64_t windowEnd = 0;
+    double lengthscale = 0.0;
+    int32_t searchMethod = 0;
+    int32_t distanceType = 0;
+    /// Maximum number of local obs per search point, or -1 if unlimited.
+    int32_t maxnobs = -1;
+    int32_t unused = 0;
+    /// Number of search points and of local obs (filled in by save()).
+    uint64_t npoints = 0;
+    uint64_t nlocal = 0;
+
+    /// Return true if the settings (but not the sizes) of \p other are the same as these.
+    bool sameSettings(const Header &other) const;
+  };
+
+  /// \brief Checksum of the observation locations \p lons and \p lats.
+  ///
+  /// Any change in the order or the bit pattern of the locations changes it (barring a 64-bit
+  /// hash collision).
+  static uint64_t locationsChecksum(const std::vector<float> &lons,
+                                    const std::vector<float> &lats);
+
+  /// Longitude and latitude of a search point.
+  struct Key {
+    double lon;
+    double lat;
+  };
+
+  /// Local obs of one search point, pointing into the mapped file.
+  struct Entry {
+    size_t size = 0;
+    const double *distance = nullptr;
+    const int32_t *index = nullptr;
+  };
+
+  /// \brief Map the index saved in \p fileName.
+  ///
+  /// Returns a null pointer if the file does not exist, is not a valid index or was saved
+  /// with settings different from \p settings.
+  static std::unique_ptr<const LocalObsIndex> open(const std::string &fileName,
+                                                   const Header &settings);
+
+  /// \brief Save an index to \p fileName.
+  ///
+  /// \p keys must be sorted in the order used by std::pair<double, double>. The local obs of
+  /// keys[jp] are stored in elements offsets[jp] to offsets[jp + 1] - 1 of \p distance and
+  /// \p index. The file is written under a temporary name and then renamed, so that it is
+  /// never seen partly written.
+  static void save(const std::string &fileName, const Header &settings,
+                   const std::vector<Key> &keys, const std::vector<size_t> &offsets,
+                   const std::vector<double> &distance, const std::vector<int> &index);
+
+  ~LocalObsIndex();
+  LocalObsIndex(const LocalObsIndex &) = delete;
+  LocalObsIndex &operator=(const LocalObsIndex &) = delete;
+
+  /// Number of search points in the index.
+  size_t size() const { return header_.npoints; }
+  /// Key of the search point \p jp.
+  const Key &key(size_t jp) const { return keys_[jp]; }
+  /// Local obs of the search point \p jp.
+  Entry entry(size_t jp) const;
+
+  /// \brief Find the local obs of the search point (\p lon, \p lat).
+  ///
+  /// Returns false if the point is not in the index.
+  bool find(double lon, double lat, Entry &entry) const;
+
+ private:
+  LocalObsIndex() = default;
+
+  void *mapping_ = nullptr;
+  size_t mappingSize_ = 0;
+  Header header_;
+  const Key *keys_ = nullptr;
+  const uint64_t *offsets_ = nullptr;
+  const double *distance_ = nullptr;
+  const int32_t *index_ = nullptr;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_OBSLOCALIZATION_LOCALOBSINDEX_H_
@@ -0,0 +1,95 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/obslocalization/LocalizationTaper.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "eckit/exception/Exceptions.h"
+#include "ioda/ObsVector.h"
+#include "oops/util/missingValues.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+void gc99Taper(const std::vector<double> & dist, double lengthscale,
+               std::vector<double> & taper) {
+  const size_t n = dist.size();
+  taper.resize(n);
+  const double * d = dist.data();
+  double * t = taper.data();
+  const double rlengthscale = 1.0 / lengthscale;
+
+  // Both pieces of the polynomial are evaluated (in Horner form) and the right one selected, so
+  // that the loop has no branches. The outer piece is evaluated at x >= 0.5 to avoid a division
+  // by zero at x = 0.
+#pragma omp simd
+  for (size_t j = 0; j < n; ++j) {
+    const double x = d[j] * rlengthscale;
+    const double inner = x * x * (((-8.0 * x + 8.0) * x + 5.0) * x - 20.0 / 3.0) + 1.0;
+    const double xo = std::max(x, 0.5);
+    const double outer = (((((8.0 / 3.0) * xo - 8.0) * xo + 5.0) * xo + 20.0 / 3.0) * xo
+                          - 10.0) * xo + 4.0 - 1.0 / (3.0 * xo);
+    t[j] = x < 0.5 ? inner : (x < 1.0 ? outer : 0.0);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void soarTaper(const std::vector<double> & dist, double SOARexpDecay,
+               std::vector<double> & taper) {
+  const size_t n = dist.size();
+  taper.resize(n);
+  const double * d = dist.data();
+  double * t = taper.data();
+#pragma omp simd
+  for (size_t j = 0; j < n; ++j) {
+    const double x = d[j] * SOARexpDecay;
+    t[j] = (1.0 + x) * std::exp(-x);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void localizationTaper(const std::string & function, const std::vector<double> & dist,
+                       double lengthscale, double SOARexpDecay,
+                       std::vector<double> & taper) {
+  if (function == "Box Car") {
+    taper.assign(dist.size(), 1.0);
+  } else if (function == "Gaspari Cohn") {
+    gc99Taper(dist, lengthscale, taper);
+  } else if (function == "SOAR") {
+    if (SOARexpDecay == util::missingValue(double()))
+      throw eckit::BadParameter("soar decay parameter is not specified");
+    soarTaper(dist, SOARexpDecay, taper);
+  } else {
+    throw eckit::BadParameter("Localization function not recognized " + function);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void applyTaper(const std::vector<int> & index, const std::vector<double> & taper,
+                ioda::ObsVector & locvector) {
+  const double missing = util::missingValue(double());
+  const size_t nvars = locvector.nvars();
+  const size_t nlocal = index.size();
+  // The variables of each location are contiguous in locvector
+  for (size_t jlocal = 0; jlocal < nlocal; ++jlocal) {
+    const double locFactor = taper[jlocal];
+    double * loc = &locvector[index[jlocal] * nvars];
+    for (size_t jvar = 0; jvar < nvars; ++jvar) {
+      loc[jvar] = loc[jvar] == missing ? missing : loc[jvar] * locFactor;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,49 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_OBSLOCALIZATION_LOCALIZATIONTAPER_H_
+#define UFO_OBSLOCALIZATION_LOCALIZATIONTAPER_H_
+
+#include <string>
+#include <vector>
+
+namespace ioda {
+  class ObsVector;
+}
+
+namespace ufo {
+
+/// \file LocalizationTaper.h
+/// Batched evaluation of the localization functions used by the horizontal and vertical
+/// localizations. The functions are evaluated for all local obs of a search point at once, in
+/// branch-free loops that the compiler can vectorise, rather than one ob at a time.
+
+/// Evaluate the Gaspari-Cohn function oops::gc99(\p dist[j] / \p lengthscale) for all
+/// distances \p dist and store the results in \p taper.
+void gc99Taper(const std::vector<double> & dist, double lengthscale,
+               std::vector<double> & taper);
+
+/// Evaluate the SOAR function oops::soar(\p dist[j] * \p SOARexpDecay) for all distances
+/// \p dist and store the results in \p taper.
+void soarTaper(const std::vector<double> & dist, double SOARexpDecay,
+               std::vector<double> & taper);
+
+/// Evaluate the localization function \p function ("Box Car", "Gaspari Cohn" or "SOAR") for all
+/// distances \p dist and store the results in \p taper. \p lengthscale is used by Gaspari Cohn
+/// and \p SOARexpDecay by SOAR. Throws an exception if \p function is not recognized.
+void localizationTaper(const std::string & function, const std::vector<double> & dist,
+                       double lengthscale, double SOARexpDecay,
+                       std::vector<double> & taper);
+
+/// Multiply the localization values of all variables of the local obs \p index[j] in
+/// \p locvector by \p taper[j]. Missing values are left unchanged.
+void applyTaper(const std::vector<int> & index, const std::vector<double> & taper,
+                ioda::ObsVector & locvector);
+
+}  // namespace ufo
+
+#endif  // UFO_OBSLOCALIZATION_LOCALIZATIONTAPER_H_
@@ -14,8 +14,7 @@
 #include "ioda/ObsSpace.h"
 #include "ioda/ObsVector.h"
 
-#include "oops/generic/gc99.h"
-
+#include "ufo/obslocalization/LocalizationTaper.h"
 #include "ufo/obslocalization/ObsHorLocalization.h"
 #include "ufo/obslocalization/ObsHorLocParameters.h"
 
@@ -63,16 +62,9 @@ void ObsHorLocGC99<MODEL>::localizeLocalObs(const GeometryIterator_ & i,
   ObsHorLocalization<MODEL>::localizeLocalObs(i, locvector, localobs);
 
   // Apply Gaspari-Cohn localization
-  const size_t nvars = locvector.nvars();
-  const size_t nlocal = localobs.index.size();
-  for (size_t jlocal = 0; jlocal < nlocal; ++jlocal) {
-    double locFactor = oops::gc99(localobs.distance[jlocal] / localobs.lengthscale);
-
-    // obsdist is calculated at each location; need to update R for each variable
-    for (size_t jvar = 0; jvar < nvars; ++jvar) {
-      locvector[jvar + localobs.index[jlocal] * nvars] *= locFactor;
-    }
-  }
+  static thread_local std::vector<double> taper;
+  gc99Taper(localobs.distance, localobs.lengthscale, taper);
+  applyTaper(localobs.index, taper, locvector);
 }
 
 // -----------------------------------------------------------------------------
@@ -86,6 +86,22 @@ class ObsHorLocParameters : public oops::ObsLocalizationParametersBase {
   /// Default: geodesic
   oops::Parameter<DistanceType> distanceType{"distance type", DistanceType::GEODESIC, this};
 
+  /// If true, the local obs found for each search point are stored and reused when
+  /// localization is requested again for the same point (e.g. by the observer and solver
+  /// phases of LETKF), so that each search is done only once per cycle.
+  /// Default: false
+  oops::Parameter<bool> cacheLocalObs{"cache local obs", false, this};
+
+  /// If set, the local obs found for each search point are also saved in a binary file named
+  /// after this option and the MPI rank (`<local obs index file>.<rank>`) when the
+  /// localization object is destroyed, and loaded from that file when it is created. A run
+  /// finding its local obs in the file (e.g. the solver of an LETKF split into separate
+  /// observer and solver jobs) does not build the search tree unless it needs a search point
+  /// missing from the file. The file is ignored if it was saved for observations at different
+  /// locations (checked with a checksum of their latitudes and longitudes), for a different
+  /// assimilation window or with different localization settings.
+  oops::OptionalParameter<std::string> localObsIndexFile{"local obs index file", this};
+
   /// returns distance between points \p p1 and \p p2, depending on the
   /// distance calculation type distanceType
   double distance(const eckit::geometry::Point3 & p1, const eckit::geometry::Point3 & p2) const {
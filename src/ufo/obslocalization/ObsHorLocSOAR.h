@@ -14,8 +14,7 @@
 #include "ioda/ObsSpace.h"
 #include "ioda/ObsVector.h"
 
-#include "oops/generic/soar.h"
-
+#include "ufo/obslocalization/LocalizationTaper.h"
 #include "ufo/obslocalization/ObsHorLocalization.h"
 #include "ufo/obslocalization/ObsHorLocSOARParameters.h"
 
@@ -65,15 +64,9 @@ void ObsHorLocSOAR<MODEL>::localizeLocalObs(const GeometryIterator_ & i,
   ObsHorLocalization<MODEL>::localizeLocalObs(i, locvector, localobs);
 
   // Apply SOAR localization
-  const double SOARexpDecayH = options_.SOARexpDecayH;
-  const size_t nvars = locvector.nvars();
-  for (size_t jlocal = 0; jlocal < localobs.index.size(); ++jlocal) {
-    double locFactor = oops::soar(localobs.distance[jlocal]*SOARexpDecayH);
-    // obsdist is calculated at each location; need to update R for each variable
-    for (size_t jvar = 0; jvar < nvars; ++jvar) {
-      locvector[jvar + localobs.index[jlocal] * nvars] = locFactor;
-    }
-  }
+  static thread_local std::vector<double> taper;
+  soarTaper(localobs.distance, options_.SOARexpDecayH, taper);
+  applyTaper(localobs.index, taper, locvector);
 }
 
 // -----------------------------------------------------------------------------
@@ -9,7 +9,10 @@
 #define UFO_OBSLOCALIZATION_OBSHORLOCALIZATION_H_
 
 #include <algorithm>
+#include <exception>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -26,8 +29,11 @@
 #include "ioda/ObsVector.h"
 
 #include "oops/base/ObsLocalizationBase.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Duration.h"
 #include "oops/util/missingValues.h"
 
+#include "ufo/obslocalization/LocalObsIndex.h"
 #include "ufo/obslocalization/ObsHorLocParameters.h"
 #include "ufo/ObsTraits.h"
 
@@ -42,6 +48,7 @@ class ObsHorLocalization: public oops::ObsLocalizationBase<MODEL, ObsTraits> {
   typedef ObsHorLocParameters Parameters_;
 
   ObsHorLocalization(const Parameters_ &, const ioda::ObsSpace &);
+  ~ObsHorLocalization();
 
   /// Compute localization and save localization values in \p locvector.
   /// Missing values indicate that observation is outside of localization.
@@ -49,6 +56,31 @@ class ObsHorLocalization: public oops::ObsLocalizationBase<MODEL, ObsTraits> {
   void computeLocalization(const GeometryIterator_ &,
                            ioda::ObsVector & locvector) const override;
 
+  /// Local observations of a block of search points, stored in compressed sparse row format.
+  struct LocalObsBatch {
+    /// Local obs of the search point jp are stored at positions offsets[jp] to
+    /// offsets[jp + 1] - 1 of \c index and \c distance (offsets has one element more than
+    /// the number of search points).
+    std::vector<size_t> offsets;
+
+    /// The list of indexes for ObsVector pointing to the valid local obs.
+    std::vector<int> index;
+
+    /// The horizontal distance of each local ob from its search point.
+    std::vector<double> distance;
+
+    /// The maximum search distance that was used for this local obs search.
+    double lengthscale;
+  };
+
+  /// For a given distance, returns the local observations and their distances for each of the
+  /// search points \p points (elements of a GeometryIterator), for example all points of a
+  /// solver tile. The searches are distributed across OpenMP threads. If the `cache local obs`
+  /// or `local obs index file` option is set, the results are also stored for use by later
+  /// calls to \c computeLocalization() (and by later runs in the second case).
+  LocalObsBatch getLocalObsBatch(const std::vector<eckit::geometry::Point3> & points,
+                                 double lengthscale) const;
+
  protected:
   struct LocalObs {
     /// The list of indexes for ObsVector pointing to the valid local obs.
@@ -81,56 +113,135 @@ class ObsHorLocalization: public oops::ObsLocalizationBase<MODEL, ObsTraits> {
 
   void print(std::ostream &) const override;
 
+  /// Throw an exception if local obs can't be searched for with this lengthscale and
+  /// obs distribution.
+  void checkSearchIsValid(double lengthscale) const;
+
+  /// Log the search method used by findLocalObs() (which can be called by several threads at
+  /// once, so does not log anything itself).
+  void traceSearchMethod() const;
+
+  /// Search for the local obs of a single point.
+  LocalObs findLocalObs(const eckit::geometry::Point3 & refPoint, double lengthscale) const;
+
+  /// Return true if the local obs found for each search point are kept.
+  bool storesLocalObs() const {
+    return options_.cacheLocalObs || !indexFileName_.empty();
+  }
+
+  /// Fill \p localobs with the local obs of \p refPoint found in the local obs index or the
+  /// cache, and return true, if they are there; return false otherwise.
+  bool findStoredLocalObs(const eckit::geometry::Point3 & refPoint, double lengthscale,
+                          LocalObs & localobs) const;
+
+  /// Build the KD-tree, if this has not been done yet.
+  void buildSearchStructures() const;
+
+  /// Settings identifying the local obs index suitable for these options and observations.
+  LocalObsIndex::Header indexHeader() const;
+
+  /// Save the local obs held in the index and the cache to the local obs index file.
+  void saveLocalObsIndex() const;
+
   /// KD-tree for searching for local obs
   struct TreeTrait {
     typedef eckit::geometry::Point3 Point;
     typedef double                  Payload;
   };
   typedef eckit::KDTreeMemory<TreeTrait> KDTree;
-  std::unique_ptr<KDTree> kd_;
+  const ioda::ObsSpace & obsspace_;
+  size_t nlocs_;
+  /// The KD-tree is only built when a search is needed (immediately unless a local obs index
+  /// has been loaded).
+  mutable std::unique_ptr<KDTree> kd_;
   std::vector<float> lats_;
   std::vector<float> lons_;
+  mutable std::once_flag searchStructuresBuilt_;
+
+  /// Name of the local obs index file of this MPI task (empty if not used).
+  std::string indexFileName_;
+  /// Local obs loaded from that file (null if there were none suitable).
+  std::unique_ptr<const LocalObsIndex> index_;
 
   /// TODO(travis) distribution name is needed for temporary fix, should be removed eventually
   std::string distName_;
+
+  /// Local obs found so far (and not loaded from the index), indexed by the longitude and
+  /// latitude of the search point (used only if storesLocalObs() is true).
+  mutable std::map<std::pair<double, double>, LocalObs> cache_;
+  mutable std::mutex cacheMutex_;
 };
 
 // -----------------------------------------------------------------------------
 
 /*!
- * \details Creates a KDTree class member that can be used for searching for local obs
+ * \details Loads the local obs index if there is a suitable one, and otherwise creates a
+ * KDTree class member that can be used for searching for local obs. The observation locations
+ * are always read, since the index is only suitable if they have not changed.
  */
 template<typename MODEL>
 ObsHorLocalization<MODEL>::ObsHorLocalization(const Parameters_ & params,
                                               const ioda::ObsSpace & obsspace)
-  : lats_(obsspace.nlocs()), lons_(obsspace.nlocs()), options_(params)
+  : options_(params), obsspace_(obsspace), nlocs_(obsspace.nlocs())
 {
   // check that this distribution supports local obs space
   // TODO(travis) this has been moved to computeLocalization as a quick fix for a bug.
   distName_ = obsspace.distribution()->name();
 
-  const size_t nlocs = obsspace.nlocs();
   // Get latitudes and longitudes of all observations.
-  obsspace.get_db("MetaData", "longitude", lons_);
-  obsspace.get_db("MetaData", "latitude", lats_);
-
-  if (options_.searchMethod == SearchMethod::KDTREE) {
-    kd_ = std::unique_ptr<KDTree> ( new KDTree() );
-    // Define points list from lat/lon values
-    typedef typename KDTree::PointType Point;
-    std::vector<typename KDTree::Value> points;
-    for (unsigned int i = 0; i < nlocs; i++) {
-      eckit::geometry::Point2 lonlat(lons_[i], lats_[i]);
-      Point xyz = Point();
-      // FIXME: get geometry from yaml, for now assume spherical Earth radius.
-      atlas::util::Earth::convertSphericalToCartesian(lonlat, xyz);
-      double index = static_cast<double>(i);
-      typename KDTree::Value v(xyz, index);
-      points.push_back(v);
-    }
-    // Create KDTree class member from points list.
-    kd_->build(points.begin(), points.end());
+  lons_.resize(nlocs_);
+  lats_.resize(nlocs_);
+  obsspace_.get_db("MetaData", "longitude", lons_);
+  obsspace_.get_db("MetaData", "latitude", lats_);
+
+  if (options_.localObsIndexFile.value() != boost::none) {
+    indexFileName_ = *options_.localObsIndexFile.value() + "." +
+                     std::to_string(obsspace.comm().rank());
+    index_ = LocalObsIndex::open(indexFileName_, indexHeader());
   }
+
+  if (!index_)
+    buildSearchStructures();
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+ObsHorLocalization<MODEL>::~ObsHorLocalization() {
+  // Nothing to save if no search was made since the index was loaded.
+  if (indexFileName_.empty() || cache_.empty())
+    return;
+  try {
+    saveLocalObsIndex();
+  } catch (const std::exception & e) {
+    oops::Log::error() << "ObsHorLocalization: failed to save the local obs index "
+                       << indexFileName_ << ": " << e.what() << std::endl;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+void ObsHorLocalization<MODEL>::buildSearchStructures() const {
+  std::call_once(searchStructuresBuilt_, [this]() {
+    if (options_.searchMethod == SearchMethod::KDTREE) {
+      kd_ = std::unique_ptr<KDTree> ( new KDTree() );
+      // Define points list from lat/lon values
+      typedef typename KDTree::PointType Point;
+      std::vector<typename KDTree::Value> points;
+      for (unsigned int i = 0; i < nlocs_; i++) {
+        eckit::geometry::Point2 lonlat(lons_[i], lats_[i]);
+        Point xyz = Point();
+        // FIXME: get geometry from yaml, for now assume spherical Earth radius.
+        atlas::util::Earth::convertSphericalToCartesian(lonlat, xyz);
+        double index = static_cast<double>(i);
+        typename KDTree::Value v(xyz, index);
+        points.push_back(v);
+      }
+      // Create KDTree class member from points list.
+      kd_->build(points.begin(), points.end());
+    }
+  });
 }
 
 // -----------------------------------------------------------------------------
@@ -181,6 +292,105 @@ ObsHorLocalization<MODEL>::getLocalObs(const GeometryIterator_ & i,
                                     double lengthscale) const {
   oops::Log::trace() << "ObsHorLocalization::getLocalObs" << std::endl;
 
+  checkSearchIsValid(lengthscale);
+
+  const eckit::geometry::Point3 refPoint = *i;
+  LocalObs localobs;
+  if (storesLocalObs() && findStoredLocalObs(refPoint, lengthscale, localobs))
+    return localobs;
+  traceSearchMethod();
+  localobs = findLocalObs(refPoint, lengthscale);
+  if (!storesLocalObs())
+    return localobs;
+  std::lock_guard<std::mutex> lock(cacheMutex_);
+  cache_[std::make_pair(refPoint[0], refPoint[1])] = localobs;
+  return localobs;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+bool ObsHorLocalization<MODEL>::findStoredLocalObs(const eckit::geometry::Point3 & refPoint,
+                                                   double lengthscale,
+                                                   LocalObs & localobs) const {
+  LocalObsIndex::Entry entry;
+  if (index_ && lengthscale == options_.lengthscale &&
+      index_->find(refPoint[0], refPoint[1], entry)) {
+    localobs.index.assign(entry.index, entry.index + entry.size);
+    localobs.distance.assign(entry.distance, entry.distance + entry.size);
+    localobs.lengthscale = lengthscale;
+    return true;
+  }
+
+  std::lock_guard<std::mutex> lock(cacheMutex_);
+  const auto it = cache_.find(std::make_pair(refPoint[0], refPoint[1]));
+  if (it != cache_.end() && it->second.lengthscale == lengthscale) {
+    localobs = it->second;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+typename ObsHorLocalization<MODEL>::LocalObsBatch
+ObsHorLocalization<MODEL>::getLocalObsBatch(const std::vector<eckit::geometry::Point3> & points,
+                                         double lengthscale) const {
+  oops::Log::trace() << "ObsHorLocalization::getLocalObsBatch" << std::endl;
+
+  checkSearchIsValid(lengthscale);
+
+  const std::ptrdiff_t npoints = points.size();
+  std::vector<LocalObs> localobs(npoints);
+  // Points whose local obs were found in the index or the cache.
+  std::vector<char> stored(npoints, false);
+  std::ptrdiff_t nstored = 0;
+  if (storesLocalObs()) {
+    for (std::ptrdiff_t jp = 0; jp < npoints; ++jp) {
+      stored[jp] = findStoredLocalObs(points[jp], lengthscale, localobs[jp]);
+      nstored += stored[jp];
+    }
+  }
+  if (nstored < npoints) {
+    buildSearchStructures();
+    traceSearchMethod();
+  }
+
+#pragma omp parallel for schedule(dynamic, 64)
+  for (std::ptrdiff_t jp = 0; jp < npoints; ++jp) {
+    if (!stored[jp])
+      localobs[jp] = findLocalObs(points[jp], lengthscale);
+  }
+
+  LocalObsBatch batch;
+  batch.lengthscale = lengthscale;
+  batch.offsets.resize(npoints + 1);
+  batch.offsets[0] = 0;
+  for (std::ptrdiff_t jp = 0; jp < npoints; ++jp)
+    batch.offsets[jp + 1] = batch.offsets[jp] + localobs[jp].index.size();
+  batch.index.reserve(batch.offsets.back());
+  batch.distance.reserve(batch.offsets.back());
+  for (std::ptrdiff_t jp = 0; jp < npoints; ++jp) {
+    batch.index.insert(batch.index.end(), localobs[jp].index.begin(), localobs[jp].index.end());
+    batch.distance.insert(batch.distance.end(),
+                          localobs[jp].distance.begin(), localobs[jp].distance.end());
+  }
+
+  if (storesLocalObs() && nstored < npoints) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    for (std::ptrdiff_t jp = 0; jp < npoints; ++jp)
+      if (!stored[jp])
+        cache_[std::make_pair(points[jp][0], points[jp][1])] = std::move(localobs[jp]);
+  }
+
+  return batch;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+void ObsHorLocalization<MODEL>::checkSearchIsValid(double lengthscale) const {
   if ( lengthscale <= 0.0 ) {
     throw eckit::BadParameter("lengthscale parameter should be >= 0.0");
   }
@@ -193,87 +403,155 @@ ObsHorLocalization<MODEL>::getLocalObs(const GeometryIterator_ & i,
     throw eckit::BadParameter(message);
   }
 
+  if ( options_.searchMethod == SearchMethod::KDTREE && nlocs_ > 0 &&
+       options_.distanceType == DistanceType::CARTESIAN)
+    ABORT("ObsHorLocalization:: search method must be 'brute_force' when using"
+          " 'cartesian' distance");
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+void ObsHorLocalization<MODEL>::traceSearchMethod() const {
+  if (options_.searchMethod == SearchMethod::BRUTEFORCE)
+    oops::Log::trace() << "Local obs searching via brute force." << std::endl;
+  else
+    oops::Log::trace() << "Local obs searching via KDTree" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+typename ObsHorLocalization<MODEL>::LocalObs
+ObsHorLocalization<MODEL>::findLocalObs(const eckit::geometry::Point3 & refPoint,
+                                     double lengthscale) const {
+  buildSearchStructures();
+
   LocalObs localobs;
   localobs.lengthscale = lengthscale;
-  eckit::geometry::Point3 refPoint = *i;
   eckit::geometry::Point2 refPoint2(refPoint[0], refPoint[1]);
   size_t nlocs = lons_.size();
   if ( options_.searchMethod == SearchMethod::BRUTEFORCE ) {
-    oops::Log::trace() << "Local obs searching via brute force." << std::endl;
-
+    // (distance, index) pairs of the obs within the lengthscale, held in a buffer reused by all
+    // searches made by the current thread
+    static thread_local std::vector<std::pair<double, int>> candidates;
+    candidates.clear();
     for (unsigned int jj = 0; jj < nlocs; ++jj) {
       eckit::geometry::Point3 searchPoint(lons_[jj], lats_[jj], 0.0);
       double localDist = options_.distance(refPoint, searchPoint);
       if ( localDist < lengthscale ) {
-        localobs.index.push_back(jj);
-        localobs.distance.push_back(localDist);
+        candidates.emplace_back(localDist, jj);
       }
     }
-    const boost::optional<int> & maxnobs = options_.maxnobs;
-    if ( (maxnobs != boost::none) && (localobs.index.size() > *maxnobs ) ) {
-      for (unsigned int jj = 0; jj < localobs.index.size(); ++jj) {
-          oops::Log::debug() << "Before sort [i, d]: " << localobs.index[jj]
-              << " , " << localobs.distance[jj] << std::endl;
-      }
-      // Construct a temporary paired vector to do the sorting
-      std::vector<std::pair<std::size_t, double>> localObsIndDistPair;
-      for (unsigned int jj = 0; jj < localobs.distance.size(); ++jj) {
-        localObsIndDistPair.push_back(std::make_pair(localobs.index[jj], localobs.distance[jj]));
-      }
 
-      // Use a lambda function to implement an ascending sort.
-      sort(localObsIndDistPair.begin(), localObsIndDistPair.end(),
-           [](const std::pair<std::size_t, double> & p1,
-              const std::pair<std::size_t, double> & p2){
-                return(p1.second < p2.second);
-              });
-
-      // Unpair the sorted pair vector
-      for (unsigned int jj = 0; jj < localobs.distance.size(); ++jj) {
-        localobs.index[jj] = localObsIndDistPair[jj].first;
-        localobs.distance[jj] = localObsIndDistPair[jj].second;
-      }
+    size_t nlocal = candidates.size();
+    const boost::optional<int> & maxnobs = options_.maxnobs;
+    if ( (maxnobs != boost::none) && (nlocal > *maxnobs) ) {
+      // Keep the maxnobs closest obs: partial selection followed by a sort of the survivors
+      // (ties are broken by the obs index so that the selection is reproducible).
+      nlocal = *maxnobs;
+      std::nth_element(candidates.begin(), candidates.begin() + nlocal, candidates.end());
+      std::sort(candidates.begin(), candidates.begin() + nlocal);
+    }
 
-      // Truncate to maxNobs length
-      localobs.index.resize(*maxnobs);
-      localobs.distance.resize(*maxnobs);
+    localobs.index.reserve(nlocal);
+    localobs.distance.reserve(nlocal);
+    for (size_t jj = 0; jj < nlocal; ++jj) {
+      localobs.index.push_back(candidates[jj].second);
+      localobs.distance.push_back(candidates[jj].first);
     }
   } else if (nlocs > 0) {
     // Check (nlocs > 0) is needed,
     // otherwise, it will cause ASERT check fail in kdtree.findInSphere, and hang.
 
-    oops::Log::trace() << "Local obs searching via KDTree" << std::endl;
-
-    if ( options_.distanceType == DistanceType::CARTESIAN)
-      ABORT("ObsHorLocalization:: search method must be 'brute_force' when using"
-            " 'cartesian' distance");
-
     // Using the radius of the earth
     eckit::geometry::Point3 refPoint3DTemp;
     atlas::util::Earth::convertSphericalToCartesian(refPoint2, refPoint3DTemp);
     double alpha =  (lengthscale / options_.radius_earth)/ 2.0;  // angle in radians
     double chordLength = 2.0*options_.radius_earth * sin(alpha);  // search radius in 3D space
 
-    auto closePoints = kd_->findInSphere(refPoint3DTemp, chordLength);
+    // If maxnobs is set, search for the maxnobs nearest obs and discard those outside the
+    // search radius rather than collecting (and sorting) all obs within the radius.
+    // The obs are sorted by distance in both kdtree calls.
+    const boost::optional<int> & maxnobs = options_.maxnobs;
+    const auto closePoints = (maxnobs != boost::none) ?
+          kd_->kNearestNeighbours(refPoint3DTemp, std::min<size_t>(*maxnobs, nlocs)) :
+          kd_->findInSphere(refPoint3DTemp, chordLength);
 
     // put closePoints back into localobs and obsdist
     localobs.index.reserve(closePoints.size());
     localobs.distance.reserve(closePoints.size());
     for (unsigned int jloc = 0; jloc < closePoints.size(); ++jloc) {
+       if (closePoints[jloc].distance() > chordLength) break;
        localobs.index.push_back(closePoints[jloc].payload());  // observation
        localobs.distance.push_back(closePoints[jloc].distance());  // distance
     }
+  }
 
-    // The obs are sorted in the kdtree call
-    const boost::optional<int> & maxnobs = options_.maxnobs;
-    if ( (maxnobs != boost::none) && (localobs.index.size() > *maxnobs ) ) {
-      // Truncate to maxNobs length
-      localobs.index.resize(*maxnobs);
-      localobs.distance.resize(*maxnobs);
+  return localobs;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+LocalObsIndex::Header ObsHorLocalization<MODEL>::indexHeader() const {
+  LocalObsIndex::Header header;
+  header.nlocs = nlocs_;
+  header.locationsChecksum = LocalObsIndex::locationsChecksum(lons_, lats_);
+  const util::DateTime epoch(1970, 1, 1, 0, 0, 0);
+  header.windowStart = (obsspace_.windowStart() - epoch).toSeconds();
+  header.windowEnd = (obsspace_.windowEnd() - epoch).toSeconds();
+  header.lengthscale = options_.lengthscale;
+  header.searchMethod = static_cast<int32_t>(options_.searchMethod.value());
+  header.distanceType = static_cast<int32_t>(options_.distanceType.value());
+  const boost::optional<int> & maxnobs = options_.maxnobs;
+  header.maxnobs = (maxnobs != boost::none) ? *maxnobs : -1;
+  return header;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+void ObsHorLocalization<MODEL>::saveLocalObsIndex() const {
+  std::vector<LocalObsIndex::Key> keys;
+  std::vector<size_t> offsets(1, 0);
+  std::vector<double> distance;
+  std::vector<int> index;
+  auto append = [&](double lon, double lat, size_t size,
+                    const int * localIndex, const double * localDistance) {
+    keys.push_back(LocalObsIndex::Key{lon, lat});
+    index.insert(index.end(), localIndex, localIndex + size);
+    distance.insert(distance.end(), localDistance, localDistance + size);
+    offsets.push_back(index.size());
+  };
+  auto appendIndexed = [&](size_t jp) {
+    const LocalObsIndex::Entry entry = index_->entry(jp);
+    append(index_->key(jp).lon, index_->key(jp).lat, entry.size, entry.index, entry.distance);
+  };
+
+  // Merge the local obs loaded from the index with those found since, both sorted by
+  // (longitude, latitude). Only those found with the lengthscale of the options are saved.
+  const size_t nindexed = index_ ? index_->size() : 0;
+  size_t jp = 0;
+  std::lock_guard<std::mutex> lock(cacheMutex_);
+  for (const auto & item : cache_) {
+    if (item.second.lengthscale != options_.lengthscale)
+      continue;
+    for (; jp < nindexed; ++jp) {
+      const LocalObsIndex::Key & key = index_->key(jp);
+      if (std::make_pair(key.lon, key.lat) >= item.first)
+        break;
+      appendIndexed(jp);
     }
+    append(item.first.first, item.first.second, item.second.index.size(),
+           item.second.index.data(), item.second.distance.data());
   }
+  for (; jp < nindexed; ++jp)
+    appendIndexed(jp);
 
-  return localobs;
+  LocalObsIndex::save(indexFileName_, indexHeader(), keys, offsets, distance, index);
+  oops::Log::info() << "ObsHorLocalization: saved the local obs of " << keys.size()
+                    << " search points in " << indexFileName_ << std::endl;
 }
 
 // -----------------------------------------------------------------------------
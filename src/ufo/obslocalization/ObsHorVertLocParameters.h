@@ -0,0 +1,72 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_OBSLOCALIZATION_OBSHORVERTLOCPARAMETERS_H_
+#define UFO_OBSLOCALIZATION_OBSHORVERTLOCPARAMETERS_H_
+
+#include <cmath>
+#include <string>
+
+#include "oops/util/missingValues.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/RequiredParameter.h"
+#include "ufo/obslocalization/ObsHorLocParameters.h"
+
+namespace ufo {
+
+/// \brief Options controlling combined horizontal and vertical obs localization. Inherits
+/// the options controlling the horizontal search from general horizontal obs localization.
+class ObsHorVertLocParameters : public ObsHorLocParameters {
+  OOPS_CONCRETE_PARAMETERS(ObsHorVertLocParameters, ObsHorLocParameters)
+
+ public:
+  /// Horizontal localization function (Box Car, Gaspari Cohn or SOAR)
+  oops::Parameter<std::string> horizontalLocalizationFunction{
+    "horizontal localization function", "Box Car", this};
+
+  /// The SOAR function decay parameter of the horizontal localization
+  oops::Parameter<double> SOARexpDecayH{"soar horizontal decay",
+                                        util::missingValue(double()), this};
+
+  /// Vertical localization lengthscale (obs further from the reference point are not local)
+  oops::RequiredParameter<double> verticalLengthscale{"vertical lengthscale", this};
+
+  /// Vertical localization function (Box Car, Gaspari Cohn or SOAR)
+  oops::Parameter<std::string> verticalLocalizationFunction{
+    "vertical localization function", "Box Car", this};
+
+  /// The SOAR function decay parameter of the vertical localization
+  oops::Parameter<double> SOARexpDecayV{"soar vertical decay",
+                                        util::missingValue(double()), this};
+
+  /// Apply the vertical localization to the logarithm of the vertical coordinate
+  oops::Parameter<bool> logTransform{"apply log transformation", false, this};
+
+  /// Group in the ioda file that stores the vertical coordinate
+  oops::Parameter<std::string> iodaVerticalCoordinateGroup{"ioda vertical coordinate group",
+                                                           "MetaData", this};
+
+  /// Variable in the ioda file that stores the vertical coordinate
+  oops::Parameter<std::string> iodaVerticalCoordinate{"ioda vertical coordinate", "", this};
+
+  /// Assign a constant vertical coordinate to all obs (e.g. for surface obs)
+  oops::Parameter<bool> assignConstantVcoordToObs{"assign constant vertical coordinate to obs",
+                                                  false, this};
+
+  /// Value of the constant vertical coordinate
+  oops::Parameter<float> constantVcoordValue{"constant vertical coordinate value",
+                                             util::missingValue(float()), this};
+
+  /// returns vertical distance between coordinates \p vCoord1 and \p vCoord2
+  double verticalDistance(double vCoord1, double vCoord2) const {
+    return std::abs(vCoord1 - vCoord2);
+  }
+};
+
+}  // namespace ufo
+
+#endif  // UFO_OBSLOCALIZATION_OBSHORVERTLOCPARAMETERS_H_
@@ -0,0 +1,209 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_OBSLOCALIZATION_OBSHORVERTLOCALIZATION_H_
+#define UFO_OBSLOCALIZATION_OBSHORVERTLOCALIZATION_H_
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/geometry/Point3.h"
+
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+
+#include "oops/util/missingValues.h"
+
+#include "ufo/obslocalization/LocalizationTaper.h"
+#include "ufo/obslocalization/ObsHorLocalization.h"
+#include "ufo/obslocalization/ObsHorVertLocParameters.h"
+
+namespace ufo {
+
+/// \brief Combined horizontal and vertical observation space localization.
+///
+/// \details The local obs are found by a single search: the horizontal search of
+/// ObsHorLocalization (kd-tree or brute force) whose results are filtered by the vertical
+/// distance from the search point. The localization value of each local ob is the product of
+/// the horizontal and vertical localization functions.
+///
+/// This gives the same result as the horizontal localization followed by ObsVertLocalization,
+/// but only the obs found by the horizontal search are visited, rather than all obs in the
+/// ObsSpace. getLocalObsValues() returns the localization in sparse form.
+template<class MODEL>
+class ObsHorVertLocalization: public ufo::ObsHorLocalization<MODEL> {
+  typedef typename MODEL::GeometryIterator   GeometryIterator_;
+  typedef typename ObsHorLocalization<MODEL>::LocalObs LocalObs_;
+
+ public:
+  typedef ObsHorVertLocParameters Parameters_;
+
+  ObsHorVertLocalization(const Parameters_ &, const ioda::ObsSpace &);
+
+  /// Localization values of the local obs of a search point.
+  struct LocalObsValues {
+    /// The list of indexes for ObsVector pointing to the local obs, in ascending order.
+    std::vector<int> index;
+
+    /// The localization value of each local ob (the same for all variables).
+    std::vector<double> value;
+  };
+
+  /// Return the local obs of the search point \p i and their localization values. Obs not
+  /// listed are outside of localization.
+  LocalObsValues getLocalObsValues(const GeometryIterator_ & i) const;
+
+  /// Compute localization and save localization values in \p locvector.
+  /// Missing values indicate that observation is outside of localization.
+  void computeLocalization(const GeometryIterator_ &,
+                           ioda::ObsVector & locvector) const override;
+
+ private:
+  void print(std::ostream &) const override;
+
+  /// Throw an exception if \p function is not a supported localization function.
+  static void checkLocalizationFunction(const std::string & function, double SOARexpDecay);
+
+  ObsHorVertLocParameters options_;
+  std::vector<float> vCoord_;
+};
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+ObsHorVertLocalization<MODEL>::ObsHorVertLocalization(const Parameters_ & params,
+                                                      const ioda::ObsSpace & obsspace):
+       ObsHorLocalization<MODEL>::ObsHorLocalization(params, obsspace), options_(params) {
+  checkLocalizationFunction(options_.horizontalLocalizationFunction, options_.SOARexpDecayH);
+  checkLocalizationFunction(options_.verticalLocalizationFunction, options_.SOARexpDecayV);
+  if (options_.verticalLengthscale <= 0.0)
+    throw eckit::BadParameter("vertical lengthscale parameter should be > 0.0");
+
+  // Get vertical coordinate of all observations.
+  if (options_.assignConstantVcoordToObs.value()) {
+    vCoord_.resize(obsspace.nlocs(), options_.constantVcoordValue.value());
+  } else {
+    obsspace.get_db(options_.iodaVerticalCoordinateGroup, options_.iodaVerticalCoordinate,
+                    vCoord_);
+  }
+  if (options_.logTransform.value()) {
+    for (float & vCoord : vCoord_) {
+      if (vCoord == 0) { vCoord = FLT_EPSILON; }
+      vCoord = log(vCoord);
+    }
+  }
+  oops::Log::debug() << *this;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+typename ObsHorVertLocalization<MODEL>::LocalObsValues
+ObsHorVertLocalization<MODEL>::getLocalObsValues(const GeometryIterator_ & i) const {
+  oops::Log::trace() << "ObsHorVertLocalization::getLocalObsValues" << std::endl;
+
+  const LocalObs_ & localobs = this->getLocalObs(i, this->lengthscale());
+
+  eckit::geometry::Point3 refPoint = *i;
+  double vCoordAtIterator = refPoint[2];
+  if (options_.logTransform.value()) {
+    if (vCoordAtIterator == 0) { vCoordAtIterator = FLT_EPSILON; }
+    vCoordAtIterator = log(vCoordAtIterator);
+  }
+
+  // Filter the obs found by the horizontal search by their vertical distance
+  std::vector<std::pair<int, size_t>> local;
+  std::vector<double> hDist, vDist;
+  local.reserve(localobs.index.size());
+  const double vLengthscale = options_.verticalLengthscale;
+  for (size_t jlocal = 0; jlocal < localobs.index.size(); ++jlocal) {
+    const int jloc = localobs.index[jlocal];
+    const double dist = options_.verticalDistance(vCoordAtIterator, vCoord_[jloc]);
+    if (dist < vLengthscale) {
+      local.emplace_back(jloc, hDist.size());
+      hDist.push_back(localobs.distance[jlocal]);
+      vDist.push_back(dist);
+    }
+  }
+
+  // Evaluate the horizontal and vertical localization functions for all these obs at once
+  std::vector<double> hTaper, vTaper;
+  localizationTaper(options_.horizontalLocalizationFunction, hDist, localobs.lengthscale,
+                    options_.SOARexpDecayH, hTaper);
+  localizationTaper(options_.verticalLocalizationFunction, vDist, vLengthscale,
+                    options_.SOARexpDecayV, vTaper);
+
+  std::sort(local.begin(), local.end());
+  LocalObsValues result;
+  result.index.reserve(local.size());
+  result.value.reserve(local.size());
+  for (const std::pair<int, size_t> & ob : local) {
+    result.index.push_back(ob.first);
+    result.value.push_back(hTaper[ob.second] * vTaper[ob.second]);
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+void ObsHorVertLocalization<MODEL>::computeLocalization(const GeometryIterator_ & i,
+                                                        ioda::ObsVector & locvector) const {
+  oops::Log::trace() << "ObsHorVertLocalization::computeLocalization" << std::endl;
+
+  const LocalObsValues local = getLocalObsValues(i);
+
+  // The values already in locvector (e.g. set by other localizations) are multiplied by the
+  // localization values; the local obs are sorted, so this needs a single pass over locvector.
+  const double missing = util::missingValue(double());
+  const size_t nvars = locvector.nvars();
+  const size_t nlocs = locvector.nlocs();
+  size_t jlocal = 0;
+  for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+    if (jlocal < local.index.size() && static_cast<size_t>(local.index[jlocal]) == jloc) {
+      const double value = local.value[jlocal++];
+      for (size_t jvar = 0; jvar < nvars; ++jvar) {
+        double & loc = locvector[jvar + jloc * nvars];
+        if (loc != missing) loc *= value;
+      }
+    } else {
+      for (size_t jvar = 0; jvar < nvars; ++jvar)
+        locvector[jvar + jloc * nvars] = missing;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+void ObsHorVertLocalization<MODEL>::checkLocalizationFunction(const std::string & function,
+                                                              double SOARexpDecay) {
+  if (function != "Box Car" && function != "Gaspari Cohn" && function != "SOAR")
+    throw eckit::BadParameter("Localization function not recognized " + function);
+  if (function == "SOAR" && SOARexpDecay == util::missingValue(double()))
+    throw eckit::BadParameter("soar decay parameter is not specified");
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename MODEL>
+void ObsHorVertLocalization<MODEL>::print(std::ostream & os) const {
+  os << "ObsHorVertLocalization with " << options_.horizontalLocalizationFunction.value()
+     << " horizontal localization (" << options_.lengthscale << " lengthscale) and "
+     << options_.verticalLocalizationFunction.value() << " vertical localization ("
+     << options_.verticalLengthscale << " lengthscale)" << std::endl;
+}
+
+}  // namespace ufo
+
+#endif  // UFO_OBSLOCALIZATION_OBSHORVERTLOCALIZATION_H_
@@ -22,10 +22,13 @@
 #include "ioda/ObsVector.h"
 
 #include "oops/base/ObsLocalizationBase.h"
+#include "oops/util/Logger.h"
 #include "oops/util/missingValues.h"
 
+#include "ufo/obslocalization/LocalizationTaper.h"
 #include "ufo/obslocalization/ObsVertLocParameters.h"
 #include "ufo/ObsTraits.h"
+#include "ufo/utils/LogUtils.h"
 
 namespace ufo {
 
@@ -132,53 +135,23 @@ void ObsVertLocalization<MODEL>::localizeLocalObs(const GeometryIterator_ & i,
                                               const LocalObs & localobs) const {
   oops::Log::trace() << "ObsVertLocalization::computeLocalization(lengthscale)" << std::endl;
 
+  // set the obs outside of localization distance to missing
   const double missing = util::missingValue(double());
   const size_t nvars = locvector.nvars();
-  const size_t nlocal = localobs.index.size();
-
-  ioda::ObsVector locvectorTmp(locvector);
-  for (size_t jj = 0; jj < locvector.size(); ++jj) {
-    locvector[jj] = missing;
-  }
-
-  if (options_.localizationFunction.value().compare("Box Car") == 0) {
-      for (size_t jlocal = 0; jlocal < nlocal; ++jlocal) {
-        for (size_t jvar = 0; jvar < nvars; ++jvar) {
-          locvector[jvar + localobs.index[jlocal] * nvars] =
-            locvectorTmp[jvar + localobs.index[jlocal] * nvars];
-        }
-      }
-  } else if (options_.localizationFunction.value().compare("Gaspari Cohn") == 0) {
-      for (size_t jlocal = 0; jlocal < nlocal; ++jlocal) {
-        double locFactor = oops::gc99(localobs.distance[jlocal] / localobs.lengthscale);
-        for (size_t jvar = 0; jvar < nvars; ++jvar) {
-          locvector[jvar + localobs.index[jlocal] * nvars] = locFactor*
-            locvectorTmp[jvar + localobs.index[jlocal] * nvars];
-        }
-      }
-  } else if (options_.localizationFunction.value().compare("SOAR") == 0) {
-      const double SOARexpDecayH = options_.SOARexpDecayH;
-      if (SOARexpDecayH == util::missingValue(double())) {
-        std::string message = "soar horizontal decay parameter is not specified";
-        throw eckit::BadParameter(message);
-      }
-      for (size_t jlocal = 0; jlocal < nlocal; ++jlocal) {
-        double locFactor = oops::soar(localobs.distance[jlocal]*SOARexpDecayH);
-        for (size_t jvar = 0; jvar < nvars; ++jvar) {
-          locvector[jvar + localobs.index[jlocal] * nvars] = locFactor*
-            locvectorTmp[jvar + localobs.index[jlocal] * nvars];
-        }
-      }
-  } else {
-      std::string message = "Vertical correlation function not recognized "
-                            +options_.localizationFunction.value();
-      throw eckit::BadParameter(message);
+  std::vector<bool> isLocal(locvector.nlocs(), false);
+  for (const int jloc : localobs.index) isLocal[jloc] = true;
+  for (size_t jloc = 0; jloc < isLocal.size(); ++jloc) {
+    if (!isLocal[jloc]) {
+      for (size_t jvar = 0; jvar < nvars; ++jvar) locvector[jvar + jloc * nvars] = missing;
+    }
   }
 
-  // make sure that locvector has the same missing value as on input
-  for (size_t jj = 0; jj < locvector.size(); ++jj) {
-    if (locvectorTmp[jj] == missing) {locvector[jj] = missing;}
-  }
+  // multiply the localization of the local obs by the vertical localization function
+  // (missing values on input stay missing)
+  static thread_local std::vector<double> taper;
+  localizationTaper(options_.localizationFunction, localobs.distance, localobs.lengthscale,
+                    options_.SOARexpDecayH, taper);
+  applyTaper(localobs.index, taper, locvector);
 }
 
 template<typename MODEL>
@@ -219,9 +192,11 @@ ObsVertLocalization<MODEL>::getLocalObs(const GeometryIterator_ & i,
   // truncate to maxnobs if needed
   const boost::optional<int> & maxnobs = options_.maxnobs;
   if ( (maxnobs != boost::none) && (localobs.index.size() > *maxnobs ) ) {
-    for (unsigned int jj = 0; jj < localobs.index.size(); ++jj) {
-        oops::Log::debug() << "Before sort [i, d]: " << localobs.index[jj]
-            << " , " << localobs.distance[jj] << std::endl;
+    if (isLogChannelEnabled(oops::Log::debug())) {
+      for (unsigned int jj = 0; jj < localobs.index.size(); ++jj) {
+          oops::Log::debug() << "Before sort [i, d]: " << localobs.index[jj]
+              << " , " << localobs.distance[jj] << std::endl;
+      }
     }
     // Construct a temporary paired vector to do the sorting
     std::vector<std::pair<std::size_t, double>> localObsIndDistPair;
@@ -7,6 +7,7 @@
 
 #include "ufo/operators/atmvertinterp/ObsAtmVertInterp.h"
 
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -17,7 +18,9 @@
 #include "ufo/filters/Variables.h"
 #include "ufo/GeoVaLs.h"
 #include "ufo/operators/atmvertinterp/ObsAtmVertInterp.interface.h"
+#include "ufo/operators/atmvertinterp/ObsAtmVertInterpUtil.h"
 #include "ufo/utils/OperatorUtils.h"  // for getOperatorVariables
+#include "ufo/utils/VertInterpStencil.h"
 
 namespace ufo {
 
@@ -28,7 +31,7 @@ static ObsOperatorMaker<ObsAtmVertInterp> makerVertInterp_("VertInterp");
 ObsAtmVertInterp::ObsAtmVertInterp(const ioda::ObsSpace & odb,
                                    const Parameters_ & params)
   : ObsOperatorBase(odb), keyOperAtmVertInterp_(0),
-    odb_(odb), varin_()
+    odb_(odb), params_(params), varin_()
 {
   std::vector<int> operatorVarIndices;
   getOperatorVariables(params.variables.value(), odb.assimvariables(),
@@ -54,8 +57,10 @@ void ObsAtmVertInterp::simulateObs(const GeoVaLs & gom, ioda::ObsVector & ovec,
                                    ObsDiagnostics &) const {
   oops::Log::trace() << "ObsAtmVertInterp::simulateObs entered" << std::endl;
 
+  const std::shared_ptr<const VertInterpStencil> stencil = atmVertInterpStencil(odb_, gom, params_);
   ufo_atmvertinterp_simobs_f90(keyOperAtmVertInterp_, gom.toFortran(), odb_,
-                               ovec.nvars(), ovec.nlocs(), ovec.toFortran());
+                               ovec.nvars(), ovec.nlocs(), ovec.toFortran(),
+                               stencil->indices().data(), stencil->weights().data());
 
   oops::Log::trace() << "ObsAtmVertInterp::simulateObs exit" << std::endl;
 }
@@ -54,6 +54,7 @@ class ObsAtmVertInterp : public ObsOperatorBase,
   void print(std::ostream &) const override;
   F90hop keyOperAtmVertInterp_;
   const ioda::ObsSpace& odb_;
+  Parameters_ params_;
   oops::Variables varin_;
   oops::Variables operatorVars_;
 };
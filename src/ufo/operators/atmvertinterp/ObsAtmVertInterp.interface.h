@@ -55,8 +55,11 @@ extern "C" {
                                    const int *operatorVarIndices, const int numOperatorVarIndices,
                                    oops::Variables &requiredVars);
   void ufo_atmvertinterp_delete_f90(F90hop &);
+  /// \param wi, wf
+  ///   Interpolation indices and weights at each location (see VertInterpStencil).
   void ufo_atmvertinterp_simobs_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
-                                 const int &, const int &, double &);
+                                 const int &, const int &, double &,
+                                 const int *wi, const double *wf);
 // -----------------------------------------------------------------------------
 
 }  // extern C
@@ -84,6 +84,13 @@ class ObsAtmVertInterpParameters : public ObsOperatorParametersBase {
     {"apply near surface wind scaling",
      "apply near surface wind scaling",
      this};
+
+  oops::Parameter<bool> PackGeoVaLs
+    {"pack geovals",
+     "copy the GeoVaLs of all simulated variables into one contiguous (nvars, nlevs, nlocs) "
+     "array and interpolate them together; the results are unchanged",
+     false,
+     this};
 };
 
 }  // namespace ufo
@@ -7,6 +7,7 @@
 
 #include "ufo/operators/atmvertinterp/ObsAtmVertInterpTLAD.h"
 
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -17,8 +18,11 @@
 #include "oops/util/Logger.h"
 
 #include "ufo/GeoVaLs.h"
+#include "ufo/LinearObsOperatorMatrix.h"
 #include "ufo/operators/atmvertinterp/ObsAtmVertInterpTLAD.interface.h"
+#include "ufo/operators/atmvertinterp/ObsAtmVertInterpUtil.h"
 #include "ufo/utils/OperatorUtils.h"  // for getOperatorVariables
+#include "ufo/utils/VertInterpStencil.h"
 
 namespace ufo {
 
@@ -28,15 +32,14 @@ static LinearObsOperatorMaker<ObsAtmVertInterpTLAD> makerVertInterpTL_("VertInte
 
 ObsAtmVertInterpTLAD::ObsAtmVertInterpTLAD(const ioda::ObsSpace & odb,
                                            const Parameters_ & params)
-  : LinearObsOperatorBase(odb), keyOperAtmVertInterp_(0), varin_()
+  : LinearObsOperatorBase(odb), keyOperAtmVertInterp_(0), params_(params), varin_()
 {
-  std::vector<int> operatorVarIndices;
   getOperatorVariables(params.variables.value(), odb.assimvariables(),
-                       operatorVars_, operatorVarIndices);
+                       operatorVars_, operatorVarIndices_);
 
   ufo_atmvertinterp_tlad_setup_f90(keyOperAtmVertInterp_, params.toConfiguration(),
                                    operatorVars_,
-                                   operatorVarIndices.data(), operatorVarIndices.size(),
+                                   operatorVarIndices_.data(), operatorVarIndices_.size(),
                                    varin_);
 
   oops::Log::trace() << "ObsAtmVertInterpTLAD created" << std::endl;
@@ -54,7 +57,7 @@ ObsAtmVertInterpTLAD::~ObsAtmVertInterpTLAD() {
 void ObsAtmVertInterpTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics &) {
   oops::Log::trace() << "ObsAtmVertInterpTLAD::setTrajectory entering" << std::endl;
 
-  ufo_atmvertinterp_tlad_settraj_f90(keyOperAtmVertInterp_, geovals.toFortran(), obsspace());
+  stencil_ = atmVertInterpStencil(obsspace(), geovals, params_);
 
   oops::Log::trace() << "ObsAtmVertInterpTLAD::setTrajectory exiting" << std::endl;
 }
@@ -63,7 +66,8 @@ void ObsAtmVertInterpTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics
 
 void ObsAtmVertInterpTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector & ovec) const {
   ufo_atmvertinterp_simobs_tl_f90(keyOperAtmVertInterp_, geovals.toFortran(), obsspace(),
-                                  ovec.nvars(), ovec.nlocs(), ovec.toFortran());
+                                  ovec.nvars(), ovec.nlocs(), ovec.toFortran(),
+                                  stencil_->indices().data(), stencil_->weights().data());
 
   oops::Log::trace() << "ObsAtmVertInterpTLAD::simulateObsTL exiting" << std::endl;
 }
@@ -72,13 +76,28 @@ void ObsAtmVertInterpTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVecto
 
 void ObsAtmVertInterpTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVector & ovec) const {
   ufo_atmvertinterp_simobs_ad_f90(keyOperAtmVertInterp_, geovals.toFortran(), obsspace(),
-                                  ovec.nvars(), ovec.nlocs(), ovec.toFortran());
+                                  ovec.nvars(), ovec.nlocs(), ovec.toFortran(),
+                                  stencil_->indices().data(), stencil_->weights().data());
 
   oops::Log::trace() << "ObsAtmVertInterpTLAD::simulateObsAD exiting" << std::endl;
 }
 
 // -----------------------------------------------------------------------------
 
+std::unique_ptr<LinearObsOperatorMatrix> ObsAtmVertInterpTLAD::matrix() const {
+  const size_t nvars = obsspace().assimvariables().size();
+  const std::vector<std::string> &variables = operatorVars_.variables();
+  std::unique_ptr<LinearObsOperatorMatrix> matrix(new LinearObsOperatorMatrix(
+      variables, std::vector<size_t>(variables.size(), stencil_->nlevs()),
+      stencil_->nlocs() * nvars));
+  for (size_t ivar = 0; ivar < variables.size(); ++ivar)
+    stencil_->addToMatrix(*matrix, ivar, operatorVarIndices_[ivar], nvars);
+  matrix->finalise();
+  return matrix;
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsAtmVertInterpTLAD::print(std::ostream & os) const {
   os << "ObsAtmVertInterpTLAD::print not implemented" << std::endl;
 }
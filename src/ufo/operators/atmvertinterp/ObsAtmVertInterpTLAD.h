@@ -8,8 +8,10 @@
 #ifndef UFO_OPERATORS_ATMVERTINTERP_OBSATMVERTINTERPTLAD_H_
 #define UFO_OPERATORS_ATMVERTINTERP_OBSATMVERTINTERPTLAD_H_
 
+#include <memory>
 #include <ostream>
 #include <string>
+#include <vector>
 
 #include "oops/base/Variables.h"
 #include "oops/util/ObjectCounter.h"
@@ -26,6 +28,7 @@ namespace ioda {
 namespace ufo {
   class GeoVaLs;
   class ObsDiagnostics;
+  class VertInterpStencil;
 
 // -----------------------------------------------------------------------------
 /// AtmVertInterp observation operator
@@ -43,6 +46,8 @@ class ObsAtmVertInterpTLAD : public LinearObsOperatorBase,
   void setTrajectory(const GeoVaLs &, ObsDiagnostics &) override;
   void simulateObsTL(const GeoVaLs &, ioda::ObsVector &) const override;
   void simulateObsAD(GeoVaLs &, const ioda::ObsVector &) const override;
+  std::unique_ptr<LinearObsOperatorMatrix> matrix() const override;
+  size_t trajectoryMemoryBytes() const override {return stencil_ ? stencil_->memoryBytes() : 0;}
 
   // Other
   const oops::Variables & requiredVars() const override {return varin_;}
@@ -55,8 +60,12 @@ class ObsAtmVertInterpTLAD : public LinearObsOperatorBase,
  private:
   void print(std::ostream &) const override;
   F90hop keyOperAtmVertInterp_;
+  Parameters_ params_;
   oops::Variables varin_;
   oops::Variables operatorVars_;
+  std::vector<int> operatorVarIndices_;
+  /// Interpolation indices and weights computed from the trajectory.
+  std::shared_ptr<const VertInterpStencil> stencil_;
 };
 
 // -----------------------------------------------------------------------------
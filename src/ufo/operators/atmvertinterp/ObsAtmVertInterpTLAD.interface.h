@@ -56,11 +56,15 @@ extern "C" {
                                         const int numOperatorVarIndices,
                                         oops::Variables &requiredVars);
   void ufo_atmvertinterp_tlad_delete_f90(F90hop &);
-  void ufo_atmvertinterp_tlad_settraj_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &);
+  /// \param wi, wf
+  ///   Interpolation indices and weights at each location, computed from the trajectory
+  ///   (see VertInterpStencil).
   void ufo_atmvertinterp_simobs_tl_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
-                                    const int &, const int &, double &);
+                                    const int &, const int &, double &,
+                                    const int *wi, const double *wf);
   void ufo_atmvertinterp_simobs_ad_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
-                                    const int &, const int &, const double &);
+                                    const int &, const int &, const double &,
+                                    const int *wi, const double *wf);
 
 // -----------------------------------------------------------------------------
 
@@ -0,0 +1,51 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/operators/atmvertinterp/ObsAtmVertInterpUtil.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ioda/ObsSpace.h"
+
+#include "ufo/GeoVaLs.h"
+#include "ufo/operators/atmvertinterp/ObsAtmVertInterpParameters.h"
+#include "ufo/utils/VertInterpStencil.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<const VertInterpStencil> atmVertInterpStencil(
+    const ioda::ObsSpace & odb, const GeoVaLs & geovals,
+    const ObsAtmVertInterpParameters & params) {
+  const std::string & modelCoord = params.VertCoord.value();
+  const std::string obsCoord = params.ObsVertCoord.value().value_or(modelCoord);
+  const std::string obsGroup = params.ObsVertGroup.value().value_or("MetaData");
+
+  // Same choice as in ufo_atmvertinterp(_tlad)_setup.
+  const InterpolationMethod method = params.interpMethod.value();
+  const bool useLog = method == InterpolationMethod::LOGLINEAR ||
+      (method == InterpolationMethod::AUTOMATIC &&
+       (modelCoord == "air_pressure" || modelCoord == "air_pressure_levels" ||
+        modelCoord == "air_pressure_levels_minus_one"));
+
+  std::vector<double> obsCoordValues(odb.nlocs());
+  odb.get_db(obsGroup, obsCoord, obsCoordValues);
+
+  const GeoVaLsView modelCoordValues = geovals.view(modelCoord);
+  return VertInterpStencil::get(odb, "VertInterp " + modelCoord + " " + obsGroup + "/" + obsCoord,
+                                modelCoordValues.data(), modelCoordValues.nlevs(),
+                                std::move(obsCoordValues),
+                                useLog ? VertInterpStencil::Transform::LOG
+                                       : VertInterpStencil::Transform::NONE);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,33 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_OPERATORS_ATMVERTINTERP_OBSATMVERTINTERPUTIL_H_
+#define UFO_OPERATORS_ATMVERTINTERP_OBSATMVERTINTERPUTIL_H_
+
+#include <memory>
+
+namespace ioda {
+  class ObsSpace;
+}
+
+namespace ufo {
+  class GeoVaLs;
+  class ObsAtmVertInterpParameters;
+  class VertInterpStencil;
+
+/// \brief Return the stencil used by the VertInterp operators configured with \p params to
+/// interpolate \p geovals to the observation locations of \p odb.
+///
+/// The stencil is shared by all VertInterp operators (nonlinear and linear) using the same
+/// coordinates in \p odb and is recomputed only when the model or observation coordinate changes.
+std::shared_ptr<const VertInterpStencil> atmVertInterpStencil(
+    const ioda::ObsSpace & odb, const GeoVaLs & geovals,
+    const ObsAtmVertInterpParameters & params);
+
+}  // namespace ufo
+
+#endif  // UFO_OPERATORS_ATMVERTINTERP_OBSATMVERTINTERPUTIL_H_
@@ -8,6 +8,7 @@
 #include "ufo/operators/categoricaloper/ObsCategorical.h"
 
 #include <algorithm>
+#include <map>
 #include <ostream>
 #include <utility>
 #include <vector>
@@ -51,13 +52,20 @@ void ObsCategorical::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
 
   oops::Log::debug() << "Running operators" << std::endl;
 
+  // If only one operator is run, it is used at all locations.
+  if (data_.activeComponents().size() == 1) {
+    data_.activeComponents().front().second->simulateObs(gv, ovec, ydiags);
+    oops::Log::trace() << "ObsCategorical: simulateObs finished" <<  std::endl;
+    return;
+  }
+
   // Container of ObsVectors produced by each operator.
   std::map <std::string, ioda::ObsVector> ovecs;
   // Run each operator and store output in ovecs.
-  for (const auto& component : data_.components()) {
+  for (const auto& component : data_.activeComponents()) {
     ioda::ObsVector ovecTemp(ovec);
     component.second->simulateObs(gv, ovecTemp, ydiags);
-    ovecs.insert({component.first, ovecTemp});
+    ovecs.emplace(component.first, std::move(ovecTemp));
   }
 
   oops::Log::debug() << "Producing final ObsVector" << std::endl;
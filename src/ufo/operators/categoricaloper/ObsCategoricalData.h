@@ -16,6 +16,10 @@
 #include <utility>
 #include <vector>
 
+#include "eckit/mpi/Comm.h"
+
+#include "ioda/distribution/Distribution.h"
+#include "ioda/ObsSpace.h"
 #include "ioda/ObsVector.h"
 
 #include "oops/base/Variables.h"
@@ -152,6 +156,28 @@ class ObsCategoricalData  {
                              "the 'operator labels' configuration option to differentiate between "
                              "them", Here());
     }
+
+    // Group the locations by operator.
+    for (const auto &component : components_)
+      operatorLocations_[component.first];
+    for (size_t jloc = 0; jloc < locOperNames_.size(); ++jloc)
+      operatorLocations_[locOperNames_[jloc]].push_back(jloc);
+
+    // Select the operators to run. Operators may communicate between MPI tasks, so the decision
+    // whether to skip an operator must be the same on all tasks.
+    std::vector<size_t> numLocations;
+    for (const auto &component : components_)
+      numLocations.push_back(operatorLocations_.at(component.first).size());
+    if (parameters.skipUnusedOperators)
+      odb.distribution()->allReduceInPlace(numLocations, eckit::mpi::sum());
+    size_t jop = 0;
+    for (const auto &component : components_) {
+      if (!parameters.skipUnusedOperators || numLocations[jop] > 0)
+        activeComponents_.emplace_back(component.first, component.second.get());
+      else
+        oops::Log::debug() << "Operator " << component.first << " is not used" << std::endl;
+      ++jop;
+    }
   }
 
   /// Return required variables for the operator.
@@ -160,20 +186,34 @@ class ObsCategoricalData  {
   /// Return component operators.
   const std::map<std::string, std::unique_ptr<OPBASE>> & components() const {return components_;}
 
+  /// Return the component operators that need to be run, with their names. All operators are
+  /// run unless the `skip unused operators` option is set.
+  const std::vector<std::pair<std::string, OPBASE *>> & activeComponents() const {
+    return activeComponents_;
+  }
+
   /// Return list of operator names to use at each location.
   const std::vector<std::string> & locOperNames() const {return locOperNames_;}
 
+  /// Return the locations at which the operator \p operName is used.
+  const std::vector<size_t> & operatorLocations(const std::string & operName) const {
+    return operatorLocations_.at(operName);
+  }
+
   /// Fill final H(x) vector from a list of components.
   void fillHofX(const std::map <std::string, ioda::ObsVector> & ovecs,
                 ioda::ObsVector & ovec) const {
     // Insert values into ovec according to the categorical variable.
     // Use the fallback operator when necessary.
-    for (size_t jloc = 0; jloc < ovec.nlocs(); ++jloc) {
-      const auto &ovecloc = ovecs.at(locOperNames_[jloc]);
-      // Loop over each variable at this location.
-      for (size_t jvar = 0; jvar < ovec.nvars(); ++jvar) {
-        const size_t idx = jloc * ovec.nvars() + jvar;
-        ovec[idx] = ovecloc[idx];
+    const size_t nvars = ovec.nvars();
+    for (const auto &ovecoper : ovecs) {
+      const ioda::ObsVector &ovecloc = ovecoper.second;
+      for (size_t jloc : operatorLocations_.at(ovecoper.first)) {
+        // Loop over each variable at this location.
+        for (size_t jvar = 0; jvar < nvars; ++jvar) {
+          const size_t idx = jloc * nvars + jvar;
+          ovec[idx] = ovecloc[idx];
+        }
       }
     }
   }
@@ -202,6 +242,12 @@ class ObsCategoricalData  {
 
   /// Operator name at each location.
   std::vector<std::string> locOperNames_;
+
+  /// Locations at which each operator is used.
+  std::map<std::string, std::vector<size_t>> operatorLocations_;
+
+  /// Operators to run.
+  std::vector<std::pair<std::string, OPBASE *>> activeComponents_;
 };
 
 }  // namespace ufo
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
 #include "oops/util/parameters/RequiredParameter.h"
 #include "ufo/ObsOperatorParametersBase.h"
 
@@ -48,6 +49,10 @@ class ObsCategoricalParameters : public ObsOperatorParametersBase {
   /// ordering of operators in the `operator configurations` parameter.
   oops::OptionalParameter<std::vector<std::string>>
     operatorLabels{"operator labels", this};
+
+  /// If true, component operators that are not selected at any location (on any MPI task)
+  /// are not run at all. Note that such operators then do not fill any diagnostics.
+  oops::Parameter<bool> skipUnusedOperators{"skip unused operators", false, this};
 };
 
 }  // namespace ufo
@@ -11,6 +11,7 @@
 #include <map>
 #include <ostream>
 #include <utility>
+#include <vector>
 
 #include "ioda/ObsVector.h"
 
@@ -49,7 +50,7 @@ void ObsCategoricalTLAD::setTrajectory(const GeoVaLs & geovals,
   oops::Log::trace() << "ObsCategoricalTLAD: setTrajectory entered" << std::endl;
 
   // Set trajectory for each operator.
-  for (const auto& component : data_.components())
+  for (const auto& component : data_.activeComponents())
     component.second->setTrajectory(geovals, ydiags);
 
   oops::Log::trace() << "ObsCategoricalTLAD: setTrajectory finished" <<  std::endl;
@@ -62,13 +63,20 @@ void ObsCategoricalTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector
 
   oops::Log::debug() << "Running TL operators" << std::endl;
 
+  // If only one TL operator is run, it is used at all locations.
+  if (data_.activeComponents().size() == 1) {
+    data_.activeComponents().front().second->simulateObsTL(geovals, ovec);
+    oops::Log::trace() << "ObsCategoricalTLAD: simulateObsTL finished" <<  std::endl;
+    return;
+  }
+
   // Container of ObsVectors produced by each TL operator.
   std::map <std::string, ioda::ObsVector> ovecs;
   // Run each TL operator and store output in ovecs.
-  for (const auto& component : data_.components()) {
+  for (const auto& component : data_.activeComponents()) {
     ioda::ObsVector ovecTemp(ovec);
     component.second->simulateObsTL(geovals, ovecTemp);
-    ovecs.insert({component.first, ovecTemp});
+    ovecs.emplace(component.first, std::move(ovecTemp));
   }
 
   oops::Log::debug() << "Producing final TL" << std::endl;
@@ -88,10 +96,10 @@ void ObsCategoricalTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVector
   // Container of GeoVaLs produced by each AD operator.
   std::map <std::string, GeoVaLs> gvals;
   // Run each AD operator and store output in gvals.
-  for (const auto& component : data_.components()) {
+  for (const auto& component : data_.activeComponents()) {
     GeoVaLs gvalTemp(geovals);
     component.second->simulateObsAD(gvalTemp, ovec);
-    gvals.insert({component.first, gvalTemp});
+    gvals.emplace(component.first, std::move(gvalTemp));
   }
 
   oops::Log::debug() << "Producing final AD" << std::endl;
@@ -100,14 +108,14 @@ void ObsCategoricalTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVector
   // Use the fallback operator when necessary.
   const std::vector<std::string> &varnames = ovec.varnames().variables();
   std::vector <double> vecgv;
-  for (size_t jloc = 0; jloc < ovec.nlocs(); ++jloc) {
-    const auto &operName = data_.locOperNames()[jloc];
-    const auto &gvaloper = gvals.at(operName);
-    // Loop over each variable at this location.
-    for (const auto& varname : varnames) {
-      vecgv.resize(gvaloper.nlevs(varname));
-      gvaloper.getAtLocation(vecgv, varname, jloc);
-      geovals.putAtLocation(vecgv, varname, jloc);
+  for (const auto& gvaloper : gvals) {
+    for (size_t jloc : data_.operatorLocations(gvaloper.first)) {
+      // Loop over each variable at this location.
+      for (const auto& varname : varnames) {
+        vecgv.resize(gvaloper.second.nlevs(varname));
+        gvaloper.second.getAtLocation(vecgv, varname, jloc);
+        geovals.putAtLocation(vecgv, varname, jloc);
+      }
     }
   }
 
@@ -21,6 +21,7 @@
 #include "ufo/Locations.h"
 #include "ufo/ObsDiagnostics.h"
 #include "ufo/operators/compositeoper/ObsCompositeParameters.h"
+#include "ufo/operators/compositeoper/ObsCompositeUtils.h"
 
 namespace ufo {
 
@@ -29,7 +30,7 @@ static ObsOperatorMaker<ObsComposite> obsCompositeMaker_("Composite");
 // -----------------------------------------------------------------------------
 
 ObsComposite::ObsComposite(const ioda::ObsSpace & odb, const Parameters_ & parameters)
-  : ObsOperatorBase(odb), odb_(odb)
+  : ObsOperatorBase(odb), odb_(odb), parallelComponents_(parameters.parallelComponents)
 {
   oops::Log::trace() << "ObsComposite constructor starting" << std::endl;
 
@@ -57,8 +58,9 @@ void ObsComposite::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
                               ObsDiagnostics & ydiags) const {
   oops::Log::trace() << "ObsComposite: simulateObs entered" << std::endl;
 
-  for (const std::unique_ptr<ObsOperatorBase> &component : components_)
-    component->simulateObs(gv, ovec, ydiags);
+  // Each component writes to different rows of ovec, so the components can run concurrently.
+  forEachComponent(components_.size(), parallelComponents_,
+                   [&](int i) {components_[i]->simulateObs(gv, ovec, ydiags);});
 
   oops::Log::trace() << "ObsComposite: simulateObs exit " <<  std::endl;
 }
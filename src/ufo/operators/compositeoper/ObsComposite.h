@@ -50,6 +50,9 @@ namespace ufo {
 ///         variables:
 ///         - name: surface_pressure
 ///
+/// If the `parallel components` option is set to true, the components are run concurrently
+/// on separate OpenMP threads.
+///
 /// \note Only some operators (currently VertInterp and Identity) currently support the `variables`
 /// option and thus can be used to simulate only a subset of variables.
 class ObsComposite : public ObsOperatorBase,
@@ -77,6 +80,7 @@ class ObsComposite : public ObsOperatorBase,
   const ioda::ObsSpace& odb_;
   std::vector<std::unique_ptr<ObsOperatorBase>> components_;
   oops::Variables requiredVars_;
+  bool parallelComponents_;
 };
 
 // -----------------------------------------------------------------------------
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
 #include "oops/util/parameters/RequiredParameter.h"
 #include "ufo/ObsOperatorParametersBase.h"
 
@@ -24,6 +25,12 @@ class ObsCompositeParameters : public ObsOperatorParametersBase {
  public:
   /// A list of configuration options for each operator used to simulate a subset of variables.
   oops::RequiredParameter<std::vector<eckit::LocalConfiguration>> components{"components", this};
+
+  /// If true, the components are run concurrently on separate OpenMP threads. Each component
+  /// writes to its own rows of the ObsVector; in the adjoint, each component accumulates into
+  /// its own copy of the GeoVaLs and the copies are added together afterwards. Only use this
+  /// option with components that are safe to run concurrently.
+  oops::Parameter<bool> parallelComponents{"parallel components", false, this};
 };
 
 }  // namespace ufo
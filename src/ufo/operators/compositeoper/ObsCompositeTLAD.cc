@@ -7,17 +7,22 @@
 
 #include "ufo/operators/compositeoper/ObsCompositeTLAD.h"
 
+#include <memory>
 #include <ostream>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "ioda/ObsSpace.h"
 #include "ioda/ObsVector.h"
 
 #include "oops/base/Variables.h"
 #include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
 
 #include "ufo/GeoVaLs.h"
 #include "ufo/operators/compositeoper/ObsCompositeParameters.h"
+#include "ufo/operators/compositeoper/ObsCompositeUtils.h"
 
 namespace ufo {
 
@@ -26,7 +31,7 @@ static LinearObsOperatorMaker<ObsCompositeTLAD> makerCompositeTL_("Composite");
 // -----------------------------------------------------------------------------
 
 ObsCompositeTLAD::ObsCompositeTLAD(const ioda::ObsSpace & odb, const Parameters_ & parameters)
-  : LinearObsOperatorBase(odb)
+  : LinearObsOperatorBase(odb), parallelComponents_(parameters.parallelComponents)
 {
   oops::Log::trace() << "ObsCompositeTLAD constructor starting" << std::endl;
 
@@ -64,8 +69,8 @@ void ObsCompositeTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics & y
 void ObsCompositeTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector & ovec) const {
   oops::Log::trace() << "ObsCompositeTLAD: simulateObsTL entered" << std::endl;
 
-  for (const std::unique_ptr<LinearObsOperatorBase> &component : components_)
-    component->simulateObsTL(geovals, ovec);
+  forEachComponent(components_.size(), parallelComponents_,
+                   [&](int i) {components_[i]->simulateObsTL(geovals, ovec);});
 
   oops::Log::trace() << "ObsCompositeTLAD: simulateObsTL exit " <<  std::endl;
 }
@@ -75,14 +80,52 @@ void ObsCompositeTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector &
 void ObsCompositeTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVector & ovec) const {
   oops::Log::trace() << "ObsCompositeTLAD: simulateObsAD entered" << std::endl;
 
-  for (const std::unique_ptr<LinearObsOperatorBase> &component : components_)
-    component->simulateObsAD(geovals, ovec);
+  if (!parallelComponents_ || components_.size() < 2) {
+    for (const std::unique_ptr<LinearObsOperatorBase> &component : components_)
+      component->simulateObsAD(geovals, ovec);
+  } else {
+    // Components may require the same variables, so all but the first one accumulate their
+    // contributions in separate (initially zero) GeoVaLs, which are added to geovals at the end.
+    // These GeoVaLs only hold the variables required by their component.
+    std::vector<std::unique_ptr<GeoVaLs>> increments(components_.size());
+    for (size_t i = 1; i < components_.size(); ++i)
+      increments[i].reset(new GeoVaLs(geovals, components_[i]->requiredVars()));
+    forEachComponent(components_.size(), true,
+                     [&](int i) {
+                       components_[i]->simulateObsAD(i == 0 ? geovals : *increments[i], ovec);
+                     });
+    for (size_t i = 1; i < components_.size(); ++i)
+      addIncrement(geovals, *increments[i], components_[i]->requiredVars());
+  }
 
   oops::Log::trace() << "ObsCompositeTLAD: simulateObsAD exit " <<  std::endl;
 }
 
 // -----------------------------------------------------------------------------
 
+void ObsCompositeTLAD::addIncrement(GeoVaLs & geovals, const GeoVaLs & increment,
+                                    const oops::Variables & vars) {
+  const double missing = util::missingValue(missing);
+  for (size_t jvar = 0; jvar < vars.size(); ++jvar) {
+    const std::string & var = vars[jvar];
+    if (!geovals.has(var))
+      continue;
+    double * dst = geovals.data(var);
+    const GeoVaLsView src = increment.view(var);
+    const size_t n = src.nlevs() * src.nlocs();
+    for (size_t k = 0; k < n; ++k) {
+      const double inc = src.data()[k];
+      if (inc == 0.0 || inc == missing)
+        continue;
+      // As in the adjoints of the individual operators, a missing value receiving a
+      // contribution is treated as zero.
+      dst[k] = (dst[k] == missing) ? inc : dst[k] + inc;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 oops::Variables ObsCompositeTLAD::simulatedVars() const {
   // Merge the lists of variables simulated by all components, ensuring that there are
   // no overlaps.
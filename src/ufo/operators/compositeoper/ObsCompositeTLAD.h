@@ -31,6 +31,8 @@ namespace ufo {
 
 // -----------------------------------------------------------------------------
 /// Composite TL/AD observation operator class
+///
+/// If the `parallel components` option is set to true, the components are run concurrently.
 class ObsCompositeTLAD : public LinearObsOperatorBase,
                         private util::ObjectCounter<ObsCompositeTLAD> {
  public:
@@ -54,9 +56,15 @@ class ObsCompositeTLAD : public LinearObsOperatorBase,
  private:
   void print(std::ostream &) const override;
 
+  /// Add the adjoint contributions \p increment of a component requiring variables \p vars
+  /// to \p geovals.
+  static void addIncrement(GeoVaLs & geovals, const GeoVaLs & increment,
+                           const oops::Variables & vars);
+
  private:
   std::vector<std::unique_ptr<LinearObsOperatorBase>> components_;
   oops::Variables requiredVars_;
+  bool parallelComponents_;
 };
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,46 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_OPERATORS_COMPOSITEOPER_OBSCOMPOSITEUTILS_H_
+#define UFO_OPERATORS_COMPOSITEOPER_OBSCOMPOSITEUTILS_H_
+
+#include <exception>
+
+namespace ufo {
+
+/// \brief Call \p f(i) for each component index \p i from 0 to \p ncomponents - 1.
+///
+/// If \p parallel is true, the calls are distributed between OpenMP threads. The first
+/// exception thrown by any of them is rethrown once all calls have finished.
+template <typename Function>
+void forEachComponent(int ncomponents, bool parallel, const Function & f) {
+  if (!parallel) {
+    for (int i = 0; i < ncomponents; ++i)
+      f(i);
+    return;
+  }
+
+  std::exception_ptr exception;
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int i = 0; i < ncomponents; ++i) {
+    try {
+      f(i);
+    } catch (...) {
+#pragma omp critical (ufo_composite_exception)
+      {
+        if (!exception)
+          exception = std::current_exception();
+      }
+    }
+  }
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
+}  // namespace ufo
+
+#endif  // UFO_OPERATORS_COMPOSITEOPER_OBSCOMPOSITEUTILS_H_
@@ -13,6 +13,7 @@
 
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
+#include "ufo/filters/QCFlagsRegistry.h"
 #include "ufo/operators/crtm/ObsRadianceCRTM.interface.h"
 
 namespace ufo {
@@ -50,6 +51,14 @@ ObsRadianceCRTM::~ObsRadianceCRTM() {
 
 void ObsRadianceCRTM::simulateObs(const GeoVaLs & gom, ioda::ObsVector & ovec,
                                   ObsDiagnostics & dvec) const {
+  if (parameters_.obsOptions.value().SkipRejectedChannels.value()) {
+    // An empty mask (no QC flags registered) makes CRTM simulate all profiles.
+    const std::vector<int> active = QCFlagsRegistry::passedMask(odb_, ovec.varnames());
+    const int nlocs = active.empty() ? 0 : ovec.nlocs();
+    const int dummy = 0;
+    ufo_radiancecrtm_set_active_channels_f90(keyOperRadianceCRTM_, ovec.nvars(), nlocs,
+                                             active.empty() ? dummy : active[0]);
+  }
   ufo_radiancecrtm_simobs_f90(keyOperRadianceCRTM_, gom.toFortran(), odb_,
                           ovec.nvars(), ovec.nlocs(), ovec.toFortran(),
                           dvec.toFortran());
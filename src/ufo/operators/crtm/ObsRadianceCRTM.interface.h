@@ -39,6 +39,8 @@ extern "C" {
                                   const int &, const int &,
                                   oops::Variables &);
   void ufo_radiancecrtm_delete_f90(F90hop &);
+  void ufo_radiancecrtm_set_active_channels_f90(const F90hop &, const int &, const int &,
+                                                const int &);
   void ufo_radiancecrtm_simobs_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
                                const size_t &, const size_t &, double &, const F90goms &);
 // -----------------------------------------------------------------------------
@@ -70,6 +70,14 @@ void ObsRadianceCRTMTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVector
 
 // -----------------------------------------------------------------------------
 
+size_t ObsRadianceCRTMTLAD::trajectoryMemoryBytes() const {
+  size_t nbytes = 0;
+  ufo_radiancecrtm_tlad_memory_bytes_f90(keyOperRadianceCRTM_, nbytes);
+  return nbytes;
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsRadianceCRTMTLAD::print(std::ostream & os) const {
   os << "ObsRadianceCRTMTLAD::print not implemented" << std::endl;
 }
@@ -46,6 +46,7 @@ class ObsRadianceCRTMTLAD : public LinearObsOperatorBase,
 
   // Other
   const oops::Variables & requiredVars() const override {return varin_;}
+  size_t trajectoryMemoryBytes() const override;
 
   int & toFortran() {return keyOperRadianceCRTM_;}
   const int & toFortran() const {return keyOperRadianceCRTM_;}
@@ -46,6 +46,7 @@ extern "C" {
                                   const int &, const int &, double &);
   void ufo_radiancecrtm_simobs_ad_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
                                   const int &, const int &, const double &);
+  void ufo_radiancecrtm_tlad_memory_bytes_f90(const F90hop &, size_t &);
 // -----------------------------------------------------------------------------
 
 }  // extern C
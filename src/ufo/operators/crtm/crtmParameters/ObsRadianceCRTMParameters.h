@@ -26,6 +26,16 @@ namespace ufo
    public:
     /// InspectProfileNumber
     oops::OptionalParameter<int> InspectProfile{"InspectProfileNumber", this};
+    /// Maximum number of profiles passed to each CRTM call. The chunks of profiles are
+    /// processed concurrently by OpenMP threads. If not set, all profiles are processed at once.
+    oops::OptionalParameter<int> ProfileChunkSize{"ProfileChunkSize", this};
+    /// If true, the linearized operator keeps the Jacobians on the OpenMP target device (e.g. a
+    /// GPU) and applies them there. Has an effect only if ufo is built with OpenMP offloading;
+    /// otherwise the Jacobians are applied on the host.
+    oops::Parameter<bool> OffloadJacobians{"OffloadJacobians", false, this};
+    /// If true, the forward operator skips the profiles at which all channels have already been
+    /// rejected by the filters acting on the ObsSpace; their H(x) is set to missing.
+    oops::Parameter<bool> SkipRejectedChannels{"SkipRejectedChannels", false, this};
     /// Sensor_ID
     oops::RequiredParameter<std::string> Sensor_ID{"Sensor_ID", this};
     /// EndianType
@@ -78,6 +88,10 @@ namespace ufo
     oops::OptionalParameter<std::vector<std::string> > Clouds{"Clouds", this};
     /// Cloud_Fraction
     oops::OptionalParameter<float> Cloud_Fraction{"Cloud_Fraction", this};
+    /// If set, profiles whose column-integrated condensate (summed over all Clouds, in kg/m2)
+    /// does not exceed this threshold are simulated without clouds, skipping the scattering
+    /// calculations. Their cloud Jacobians are then zero.
+    oops::OptionalParameter<float> Clear_Sky_Threshold{"Clear_Sky_Threshold", this};
     /// Salinity
     oops::OptionalParameter<bool> Salinity{"Salinity", this};
     /// Obs Options
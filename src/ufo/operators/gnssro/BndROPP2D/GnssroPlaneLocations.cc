@@ -0,0 +1,60 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/operators/gnssro/BndROPP2D/GnssroPlaneLocations.h"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include "ioda/ObsSpace.h"
+#include "oops/util/Logger.h"
+#include "ufo/operators/gnssro/BndROPP2D/ObsGnssroBndROPP2D.h"
+#include "ufo/operators/gnssro/BndROPP2D/ObsGnssroBndROPP2D.interface.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+std::shared_ptr<const GnssroPlaneLocations> sharedGnssroPlaneLocations(
+    const ioda::ObsSpace & odb, const GnssroBndROPP2DOptionsParameters & options) {
+  typedef std::tuple<const ioda::ObsSpace *, size_t, double> Key;
+  static std::mutex mutex;
+  static std::map<Key, std::weak_ptr<const GnssroPlaneLocations>> cache;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  // Forget locations no longer used by any operator.
+  for (auto it = cache.begin(); it != cache.end(); ) {
+    if (it->second.expired())
+      it = cache.erase(it);
+    else
+      ++it;
+  }
+
+  std::weak_ptr<const GnssroPlaneLocations> & weakLocations =
+      cache[Key(&odb, options.nHoriz.value(), options.res.value())];
+  std::shared_ptr<const GnssroPlaneLocations> locations = weakLocations.lock();
+  if (!locations) {
+    oops::Log::trace() << "sharedGnssroPlaneLocations: computing the 2D plane locations"
+                       << std::endl;
+    auto newLocations = std::make_shared<GnssroPlaneLocations>();
+    newLocations->nhoriz = options.nHoriz;
+    const int nlocsExt = odb.nlocs() * options.nHoriz;
+    newLocations->lons.resize(nlocsExt);
+    newLocations->lats.resize(nlocsExt);
+    if (nlocsExt > 0)
+      ufo_gnssro_2d_plane_locs_f90(options.toConfiguration(), odb, nlocsExt,
+                                   newLocations->lons[0], newLocations->lats[0]);
+    locations = std::move(newLocations);
+    weakLocations = locations;
+  }
+  return locations;
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,40 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_OPERATORS_GNSSRO_BNDROPP2D_GNSSROPLANELOCATIONS_H_
+#define UFO_OPERATORS_GNSSRO_BNDROPP2D_GNSSROPLANELOCATIONS_H_
+
+#include <memory>
+#include <vector>
+
+namespace ioda {
+  class ObsSpace;
+}
+
+namespace ufo {
+  class GnssroBndROPP2DOptionsParameters;
+
+/// \brief Locations of the model columns along the 2D occultation plane of each observation.
+struct GnssroPlaneLocations {
+  /// Number of columns in each plane.
+  size_t nhoriz = 0;
+  /// Longitudes and latitudes (in degrees) of the columns, [nlocs][nhoriz].
+  std::vector<double> lons;
+  std::vector<double> lats;
+};
+
+/// \brief Return the locations of the 2D planes of the observations held in \p odb.
+///
+/// The locations are computed the first time they are requested and then shared by the
+/// nonlinear and linear GnssroBndROPP2D operators acting on \p odb with the same number of
+/// columns and resolution, for as long as any of them exists.
+std::shared_ptr<const GnssroPlaneLocations> sharedGnssroPlaneLocations(
+    const ioda::ObsSpace & odb, const GnssroBndROPP2DOptionsParameters & options);
+
+}  // namespace ufo
+
+#endif  // UFO_OPERATORS_GNSSRO_BNDROPP2D_GNSSROPLANELOCATIONS_H_
@@ -29,7 +29,8 @@ static ObsOperatorMaker<ObsGnssroBndROPP2D> makerGnssroBndROPP2D_("GnssroBndROPP
 ObsGnssroBndROPP2D::ObsGnssroBndROPP2D(const ioda::ObsSpace & odb,
                                        const Parameters_ & params)
   : ObsOperatorBase(odb), keyOperGnssroBndROPP2D_(0), odb_(odb), varin_(),
-    nhoriz_(params.options.value().nHoriz)
+    nhoriz_(params.options.value().nHoriz),
+    planeLocations_(sharedGnssroPlaneLocations(odb, params.options.value()))
 {
   const std::vector<std::string> vv{"air_temperature", "specific_humidity", "air_pressure",
                                     "geopotential_height", "surface_altitude"};
@@ -57,8 +58,8 @@ void ObsGnssroBndROPP2D::simulateObs(const GeoVaLs & gom, ioda::ObsVector & ovec
 
 // -----------------------------------------------------------------------------
 std::unique_ptr<Locations> ObsGnssroBndROPP2D::locations() const {
-  std::vector<float> lons(odb_.nlocs()*nhoriz_);
-  std::vector<float> lats(odb_.nlocs()*nhoriz_);
+  const std::vector<float> lons(planeLocations_->lons.begin(), planeLocations_->lons.end());
+  const std::vector<float> lats(planeLocations_->lats.begin(), planeLocations_->lats.end());
   std::vector<util::DateTime> times(odb_.nlocs()*nhoriz_);
 
   std::vector<util::DateTime> times_notduplicated(odb_.nlocs());
@@ -68,9 +69,21 @@ std::unique_ptr<Locations> ObsGnssroBndROPP2D::locations() const {
       times[jloc*nhoriz_ + jhoriz] = times_notduplicated[jloc];
     }
   }
-  ufo_gnssro_2d_locs_init_f90(keyOperGnssroBndROPP2D_, odb_, lons.size(), lons[0], lats[0]);
+  if (!lons.empty())
+    ufo_gnssro_2d_locs_set_f90(keyOperGnssroBndROPP2D_, lons.size(), lons[0], lats[0]);
   std::unique_ptr<Locations> locs(new Locations(lons, lats, times, odb_.distribution()));
 
+  // Each observation is simulated from the nhoriz_ columns of its 2D plane, but the surface
+  // altitude is only needed at the central column.
+  std::vector<size_t> pathOffsets(odb_.nlocs() + 1);
+  std::vector<size_t> pathCentres(odb_.nlocs());
+  for (size_t jloc = 0; jloc < odb_.nlocs(); ++jloc) {
+    pathOffsets[jloc] = jloc*nhoriz_;
+    pathCentres[jloc] = jloc*nhoriz_ + (nhoriz_ - 1)/2;
+  }
+  pathOffsets[odb_.nlocs()] = odb_.nlocs()*nhoriz_;
+  locs->setPaths(pathOffsets, pathCentres, {"surface_altitude"});
+
   return locs;
 }
 
@@ -15,6 +15,7 @@
 #include "oops/base/Variables.h"
 #include "oops/util/ObjectCounter.h"
 #include "ufo/ObsOperatorBase.h"
+#include "ufo/operators/gnssro/BndROPP2D/GnssroPlaneLocations.h"
 #include "ufo/operators/gnssro/BndROPP2D/ObsGnssroBndROPP2D.interface.h"
 
 namespace ioda {
@@ -71,6 +72,7 @@ class ObsGnssroBndROPP2D : public ObsOperatorBase,
   const ioda::ObsSpace& odb_;
   std::unique_ptr<const oops::Variables> varin_;
   const size_t nhoriz_;
+  std::shared_ptr<const GnssroPlaneLocations> planeLocations_;
 };
 
 // -----------------------------------------------------------------------------
@@ -23,8 +23,9 @@ extern "C" {
 // -----------------------------------------------------------------------------
 // Gnssro bending angle observation operators - (ROPP2D)
 // -----------------------------------------------------------------------------
-  void ufo_gnssro_2d_locs_init_f90(const F90hop &, const ioda::ObsSpace &, const int &,
-                                   float &, float &);
+  void ufo_gnssro_2d_plane_locs_f90(const eckit::Configuration &, const ioda::ObsSpace &,
+                                    const int &, double &, double &);
+  void ufo_gnssro_2d_locs_set_f90(const F90hop &, const int &, const float &, const float &);
   void ufo_gnssro_bndropp2d_setup_f90(F90hop &, const eckit::Configuration &, const int &);
   void ufo_gnssro_bndropp2d_delete_f90(F90hop &);
   void ufo_gnssro_bndropp2d_simobs_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
@@ -28,7 +28,8 @@ static LinearObsOperatorMaker<ObsGnssroBndROPP2DTLAD> makerGnssroBndROPP2DTL_("G
 
 ObsGnssroBndROPP2DTLAD::ObsGnssroBndROPP2DTLAD(const ioda::ObsSpace & odb,
                                                const Parameters_ & params)
-  : LinearObsOperatorBase(odb), keyOperGnssroBndROPP2D_(0), varin_()
+  : LinearObsOperatorBase(odb), keyOperGnssroBndROPP2D_(0), varin_(),
+    planeLocations_(sharedGnssroPlaneLocations(odb, params.options.value()))
 {
   ufo_gnssro_bndropp2d_tlad_setup_f90(keyOperGnssroBndROPP2D_,
                                       params.options.value().toConfiguration());
@@ -50,6 +51,10 @@ ObsGnssroBndROPP2DTLAD::~ObsGnssroBndROPP2DTLAD() {
 
 void ObsGnssroBndROPP2DTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics &) {
   ufo_gnssro_bndropp2d_tlad_settraj_f90(keyOperGnssroBndROPP2D_, geovals.toFortran(), obsspace());
+  const int nlocsExt = planeLocations_->lons.size();
+  if (nlocsExt > 0)
+    ufo_gnssro_bndropp2d_tlad_set_plane_f90(keyOperGnssroBndROPP2D_, nlocsExt,
+                                            planeLocations_->lons[0], planeLocations_->lats[0]);
 }
 
 // -----------------------------------------------------------------------------
@@ -15,6 +15,7 @@
 #include "oops/base/Variables.h"
 #include "oops/util/ObjectCounter.h"
 #include "ufo/LinearObsOperatorBase.h"
+#include "ufo/operators/gnssro/BndROPP2D/GnssroPlaneLocations.h"
 #include "ufo/operators/gnssro/BndROPP2D/ObsGnssroBndROPP2D.h"
 #include "ufo/operators/gnssro/BndROPP2D/ObsGnssroBndROPP2DTLAD.interface.h"
 
@@ -55,6 +56,7 @@ class ObsGnssroBndROPP2DTLAD : public LinearObsOperatorBase,
   void print(std::ostream &) const override;
   F90hop keyOperGnssroBndROPP2D_;
   std::unique_ptr<const oops::Variables> varin_;
+  std::shared_ptr<const GnssroPlaneLocations> planeLocations_;
 };
 
 // -----------------------------------------------------------------------------
@@ -27,6 +27,8 @@ extern "C" {
   void ufo_gnssro_bndropp2d_tlad_delete_f90(F90hop &);
   void ufo_gnssro_bndropp2d_tlad_settraj_f90(const F90hop &, const F90goms &,
                                              const ioda::ObsSpace &);
+  void ufo_gnssro_bndropp2d_tlad_set_plane_f90(const F90hop &, const int &, const double &,
+                                               const double &);
   void ufo_gnssro_bndropp2d_simobs_tl_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
                                           const int &, double &);
   void ufo_gnssro_bndropp2d_simobs_ad_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
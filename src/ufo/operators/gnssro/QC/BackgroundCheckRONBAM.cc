@@ -25,6 +25,42 @@
 
 namespace ufo {
 
+namespace {
+
+/// NBAM background check threshold, as a fraction of the observed value, at impact height
+/// \p imp (km) and latitude \p lat (radians), with background virtual temperature \p tmp.
+float nbamCutoff(float imp, float lat, float tmp) {
+  float cutoff   = std::numeric_limits<float>::max();
+  float cutoff1  = std::numeric_limits<float>::max();
+  float cutoff2  = std::numeric_limits<float>::max();
+  float cutoff3  = std::numeric_limits<float>::max();
+  float cutoff4  = std::numeric_limits<float>::max();
+  float cutoff12 = std::numeric_limits<float>::max();
+  float cutoff23 = std::numeric_limits<float>::max();
+  float cutoff34 = std::numeric_limits<float>::max();
+
+  cutoff = 0.0;
+  cutoff1  = (-4.725+0.045*imp+0.005*imp*imp)*2.0/3.0;
+  cutoff2  = 1.5+cos(lat);
+  cutoff3  = 4.0/3.0;
+  if (tmp > 240.0) cutoff3  = ( 0.005*tmp*tmp-2.3*tmp+266.0 )*2.0/3.0;
+  cutoff4  = (4.0+8.0*cos(lat))*2.0/3.0;
+  cutoff12 = ( (36.0-imp)/2.0)*cutoff2 + ((imp-34.0)/2.0)*cutoff1;
+  cutoff23 = ( (11.0-imp)/2.0)*cutoff3 + ((imp-9.0)/2.0)*cutoff2;
+  cutoff34 = ( (6.0-imp)/2.0)*cutoff4 + ((imp-4.0)/2.0)*cutoff3;
+  if (imp > 36.0) cutoff = cutoff1;
+  if (imp <= 36.0 && imp > 34.0) cutoff = cutoff12;
+  if (imp <= 34.0 && imp > 11.0) cutoff = cutoff2;
+  if (imp <= 11.0 && imp > 9.0)  cutoff = cutoff23;
+  if (imp <= 9.0  && imp > 6.0)  cutoff = cutoff3;
+  if (imp <= 6.0  && imp > 4.0)  cutoff = cutoff34;
+  if (imp <= 4.0) cutoff = cutoff4;
+
+  return 0.03*cutoff;
+}
+
+}  // namespace
+
 // -----------------------------------------------------------------------------
 
 BackgroundCheckRONBAM::BackgroundCheckRONBAM(ioda::ObsSpace & obsdb,
@@ -65,6 +101,17 @@ void BackgroundCheckRONBAM::applyFilter(const std::vector<bool> & apply,
 
   Variables varhofx(filtervars, "HofX");
 
+// Threshold at each location, which does not depend on the variable
+  std::vector<float> cutoffs(obsdb_.nlocs(), 0.0f);
+  for (size_t jobs = 0; jobs < obsdb_.nlocs(); ++jobs) {
+    if (apply[jobs]) {
+      float imp = impactparameter[0][jobs]/1000.0 - earthradius[0][jobs]/1000.0;
+      float lat = latitude[0][jobs]*0.01745329251;  // deg2rad
+      float tmp = temperature[0][jobs];
+      cutoffs[jobs] = nbamCutoff(imp, lat, tmp);
+    }
+  }
+
   for (size_t jv = 0; jv < filtervars.nvars(); ++jv) {
     size_t iv = observed.find(filtervars.variable(jv).variable());
 
@@ -78,38 +125,7 @@ void BackgroundCheckRONBAM::applyFilter(const std::vector<bool> & apply,
         ASSERT(hofx[jobs] != util::missingValue(hofx[jobs]));
         ASSERT(impactparameter[0][jobs] != util::missingValue(impactparameter[0][jobs]));
 
-        float imp = impactparameter[0][jobs]/1000.0 - earthradius[0][jobs]/1000.0;
-        float lat = latitude[0][jobs]*0.01745329251;  // deg2rad
-        float tmp = temperature[0][jobs];
-
-//      Threshold for current observation
-        float cutoff   = std::numeric_limits<float>::max();
-        float cutoff1  = std::numeric_limits<float>::max();
-        float cutoff2  = std::numeric_limits<float>::max();
-        float cutoff3  = std::numeric_limits<float>::max();
-        float cutoff4  = std::numeric_limits<float>::max();
-        float cutoff12 = std::numeric_limits<float>::max();
-        float cutoff23 = std::numeric_limits<float>::max();
-        float cutoff34 = std::numeric_limits<float>::max();
-
-        cutoff = 0.0;
-        cutoff1  = (-4.725+0.045*imp+0.005*imp*imp)*2.0/3.0;
-        cutoff2  = 1.5+cos(lat);
-        cutoff3  = 4.0/3.0;
-        if (tmp > 240.0) cutoff3  = ( 0.005*tmp*tmp-2.3*tmp+266.0 )*2.0/3.0;
-        cutoff4  = (4.0+8.0*cos(lat))*2.0/3.0;
-        cutoff12 = ( (36.0-imp)/2.0)*cutoff2 + ((imp-34.0)/2.0)*cutoff1;
-        cutoff23 = ( (11.0-imp)/2.0)*cutoff3 + ((imp-9.0)/2.0)*cutoff2;
-        cutoff34 = ( (6.0-imp)/2.0)*cutoff4 + ((imp-4.0)/2.0)*cutoff3;
-        if (imp > 36.0) cutoff = cutoff1;
-        if (imp <= 36.0 && imp > 34.0) cutoff = cutoff12;
-        if (imp <= 34.0 && imp > 11.0) cutoff = cutoff2;
-        if (imp <= 11.0 && imp > 9.0)  cutoff = cutoff23;
-        if (imp <= 9.0  && imp > 6.0)  cutoff = cutoff3;
-        if (imp <= 6.0  && imp > 4.0)  cutoff = cutoff34;
-        if (imp <= 4.0) cutoff = cutoff4;
-
-        cutoff = 0.03*cutoff;
+        const float cutoff = cutoffs[jobs];
         ASSERT(cutoff < std::numeric_limits<float>::max() && cutoff > 0.0);
 
 //      Apply bias correction
@@ -47,6 +47,7 @@ class ROobserror : public FilterBase,
   void applyFilter(const std::vector<bool> &, const Variables &,
                    std::vector<std::vector<bool>> &) const override;
   int qcFlag() const override {return 76;}
+  bool modifiesObsSpace() const override {return true;}
   Eigen::ArrayXXf get_geovals(const std::string&) const;
   int n_horiz = 1;
 
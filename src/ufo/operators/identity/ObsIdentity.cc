@@ -10,6 +10,8 @@
 #include <ostream>
 #include <vector>
 
+#include "eckit/exception/Exceptions.h"
+
 #include "ioda/ObsVector.h"
 
 #include "oops/util/Logger.h"
@@ -48,26 +50,41 @@ ObsIdentity::~ObsIdentity() {
 // -----------------------------------------------------------------------------
 
 void ObsIdentity::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
-                              ObsDiagnostics &) const {
+                              ObsDiagnostics & ydiags) const {
   oops::Log::trace() << "ObsIdentity: simulateObs starting" << std::endl;
+  simulateObsAtLocations(gv, ovec, ydiags, 0, ovec.nlocs());
+  oops::Log::trace() << "ObsIdentity: simulateObs finished" << std::endl;
+}
 
-  std::vector<double> vec(ovec.nlocs());
-  for (int jvar : operatorVarIndices_) {
-    const std::string varname = nameMap_.convertName(ovec.varnames().variables()[jvar]);
-    // Get GeoVaL at the level closest to the Earth's surface.
-    if (levelIndexZeroAtSurface_) {
-      gv.getAtLevel(vec, varname, 0);
-      oops::Log::info() << "WARNING: Bottom up GeoVaLs will eventually be deprecated."
-                        << std::endl;}
-    else
-      gv.getAtLevel(vec, varname, gv.nlevs(varname) - 1);
-    for (size_t jloc = 0; jloc < ovec.nlocs(); ++jloc) {
-      const size_t idx = jloc * ovec.nvars() + jvar;
-      ovec[idx] = vec[jloc];
-    }
+// -----------------------------------------------------------------------------
+
+void ObsIdentity::simulateObsAtLocations(const GeoVaLs & gv, ioda::ObsVector & ovec,
+                                         ObsDiagnostics &, size_t begin, size_t end) const {
+  const size_t nvars = ovec.nvars();
+  if (begin >= end || operatorVarIndices_.empty())
+    return;
+  if (levelIndexZeroAtSurface_ && begin == 0)
+    oops::Log::info() << "WARNING: Bottom up GeoVaLs will eventually be deprecated."
+                      << std::endl;
+
+  // Locate the GeoVaLs at the level closest to the Earth's surface of each simulated variable.
+  const size_t nopvars = operatorVarIndices_.size();
+  std::vector<const double *> src(nopvars);
+  std::vector<size_t> srcStride(nopvars);
+  for (size_t jop = 0; jop < nopvars; ++jop) {
+    const std::string varname =
+        nameMap_.convertName(ovec.varnames().variables()[operatorVarIndices_[jop]]);
+    const GeoVaLsView values = gv.view(varname);
+    ASSERT(!values.empty());
+    src[jop] = values.atLevel(levelIndexZeroAtSurface_ ? 0 : values.nlevs() - 1);
+    srcStride[jop] = values.locationStride();
   }
 
-  oops::Log::trace() << "ObsIdentity: simulateObs finished" << std::endl;
+  // Copy them into the (location-major) ObsVector in a single pass.
+  for (size_t jloc = begin; jloc < end; ++jloc) {
+    for (size_t jop = 0; jop < nopvars; ++jop)
+      ovec[jloc * nvars + operatorVarIndices_[jop]] = src[jop][jloc * srcStride[jop]];
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -51,6 +51,10 @@ class ObsIdentity : public ObsOperatorBase,
   ~ObsIdentity() override;
 
   void simulateObs(const GeoVaLs &, ioda::ObsVector &, ObsDiagnostics &) const override;
+  bool supportsLocationRanges() const override {return true;}
+  bool isThreadSafe() const override {return true;}
+  void simulateObsAtLocations(const GeoVaLs &, ioda::ObsVector &, ObsDiagnostics &,
+                              size_t begin, size_t end) const override;
 
   const oops::Variables & requiredVars() const override { return requiredVars_; }
 
@@ -10,6 +10,8 @@
 #include <ostream>
 #include <vector>
 
+#include "eckit/exception/Exceptions.h"
+
 #include "ioda/ObsSpace.h"
 #include "ioda/ObsVector.h"
 
@@ -59,53 +61,72 @@ void ObsIdentityTLAD::setTrajectory(const GeoVaLs &, ObsDiagnostics &) {
 
 void ObsIdentityTLAD::simulateObsTL(const GeoVaLs & dx, ioda::ObsVector & dy) const {
   oops::Log::trace() << "ObsIdentityTLAD: TL observation operator starting" << std::endl;
+  simulateObsTLAtLocations(dx, dy, 0, dy.nlocs());
+  oops::Log::trace() << "ObsIdentityTLAD: TL observation operator finished" << std::endl;
+}
 
-  std::vector<double> vec(dy.nlocs());
-  for (int jvar : operatorVarIndices_) {
-    const std::string& varname = dy.varnames().variables()[jvar];
-    // Fill dy with dx at the level closest to the Earth's surface.
-    if (levelIndexZeroAtSurface_)
-      dx.getAtLevel(vec, varname, 0);
-    else
-      dx.getAtLevel(vec, varname, dx.nlevs(varname) - 1);
-    for (size_t jloc = 0; jloc < dy.nlocs(); ++jloc) {
-      const size_t idx = jloc * dy.nvars() + jvar;
-      dy[idx] = vec[jloc];
-    }
-  }
+// -----------------------------------------------------------------------------
 
-  oops::Log::trace() << "ObsIdentityTLAD: TL observation operator finished" << std::endl;
+void ObsIdentityTLAD::simulateObsTLAtLocations(const GeoVaLs & dx, ioda::ObsVector & dy,
+                                               size_t begin, size_t end) const {
+  const size_t nvars = dy.nvars();
+  if (begin >= end)
+    return;
+
+  // Fill dy with dx at the level closest to the Earth's surface, for all variables in one pass.
+  const size_t nopvars = operatorVarIndices_.size();
+  std::vector<const double *> src(nopvars);
+  std::vector<size_t> srcStride(nopvars);
+  for (size_t jop = 0; jop < nopvars; ++jop) {
+    const GeoVaLsView values = dx.view(dy.varnames().variables()[operatorVarIndices_[jop]]);
+    ASSERT(!values.empty());
+    src[jop] = values.atLevel(levelIndexZeroAtSurface_ ? 0 : values.nlevs() - 1);
+    srcStride[jop] = values.locationStride();
+  }
+  for (size_t jloc = begin; jloc < end; ++jloc) {
+    for (size_t jop = 0; jop < nopvars; ++jop)
+      dy[jloc * nvars + operatorVarIndices_[jop]] = src[jop][jloc * srcStride[jop]];
+  }
 }
 
 // -----------------------------------------------------------------------------
 
 void ObsIdentityTLAD::simulateObsAD(GeoVaLs & dx, const ioda::ObsVector & dy) const {
   oops::Log::trace() << "ObsIdentityTLAD: adjoint observation operator starting" << std::endl;
+  simulateObsADAtLocations(dx, dy, 0, dy.nlocs());
+  oops::Log::trace() << "ObsIdentityTLAD: adjoint observation operator finished" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
 
+void ObsIdentityTLAD::simulateObsADAtLocations(GeoVaLs & dx, const ioda::ObsVector & dy,
+                                               size_t begin, size_t end) const {
   const double missing = util::missingValue(missing);
 
-  std::vector<double> vec(dy.nlocs());
-  for (int jvar : operatorVarIndices_) {
-    const std::string& varname = dy.varnames().variables()[jvar];
-    // Get current value of dx at the level closest to the Earth's surface.
-    if (levelIndexZeroAtSurface_)
-      dx.getAtLevel(vec, varname, 0);
-    else
-      dx.getAtLevel(vec, varname, dx.nlevs(varname) - 1);
-    // Increment dx with non-missing values of dy.
-    for (size_t jloc = 0; jloc < dy.nlocs(); ++jloc) {
-      const size_t idx = jloc * dy.nvars() + jvar;
-      if (dy[idx] != missing)
-        vec[jloc] += dy[idx];
+  const size_t nvars = dy.nvars();
+  if (begin >= end)
+    return;
+
+  // Increment dx at the level closest to the Earth's surface with non-missing values of dy,
+  // for all variables in one pass. The GeoVaLs are stored location by location.
+  const size_t nopvars = operatorVarIndices_.size();
+  std::vector<double *> dst(nopvars);
+  std::vector<size_t> dstStride(nopvars);
+  for (size_t jop = 0; jop < nopvars; ++jop) {
+    const std::string& varname = dy.varnames().variables()[operatorVarIndices_[jop]];
+    const size_t nlevs = dx.nlevs(varname);
+    dst[jop] = dx.data(varname);
+    ASSERT(dst[jop] != nullptr);
+    dst[jop] += levelIndexZeroAtSurface_ ? 0 : nlevs - 1;
+    dstStride[jop] = nlevs;
+  }
+  for (size_t jloc = begin; jloc < end; ++jloc) {
+    for (size_t jop = 0; jop < nopvars; ++jop) {
+      const double value = dy[jloc * nvars + operatorVarIndices_[jop]];
+      if (value != missing)
+        dst[jop][jloc * dstStride[jop]] += value;
     }
-    // Store new value of dx.
-    if (levelIndexZeroAtSurface_)
-      dx.putAtLevel(vec, varname, 0);
-    else
-      dx.putAtLevel(vec, varname, dx.nlevs(varname) - 1);
   }
-
-  oops::Log::trace() << "ObsIdentityTLAD: adjoint observation operator finished" << std::endl;
 }
 
 // -----------------------------------------------------------------------------
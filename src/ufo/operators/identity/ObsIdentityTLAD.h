@@ -42,6 +42,12 @@ class ObsIdentityTLAD : public LinearObsOperatorBase,
   void setTrajectory(const GeoVaLs &, ObsDiagnostics &) override;
   void simulateObsTL(const GeoVaLs &, ioda::ObsVector &) const override;
   void simulateObsAD(GeoVaLs &, const ioda::ObsVector &) const override;
+  bool supportsLocationRanges() const override {return true;}
+  bool isThreadSafe() const override {return true;}
+  void simulateObsTLAtLocations(const GeoVaLs &, ioda::ObsVector &,
+                                size_t begin, size_t end) const override;
+  void simulateObsADAtLocations(GeoVaLs &, const ioda::ObsVector &,
+                                size_t begin, size_t end) const override;
 
   const oops::Variables & requiredVars() const override {return requiredVars_;}
 
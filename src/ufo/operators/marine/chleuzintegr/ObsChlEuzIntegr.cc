@@ -7,6 +7,7 @@
 
 #include "ufo/operators/marine/chleuzintegr/ObsChlEuzIntegr.h"
 
+#include <cmath>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -44,37 +45,35 @@ ObsChlEuzIntegr::~ObsChlEuzIntegr() {
 // -----------------------------------------------------------------------------
 void ObsChlEuzIntegr::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
                                   ObsDiagnostics &) const {
-  int nlocs = ovec.size();
-  int nlevs = gv.nlevs("mass_concentration_of_chlorophyll_in_sea_water");
-
-  // common vectors storage
-  std::vector <double> tmp(nlocs, 0.0);
-
-  // Retrieve the chlorophyll and cell thickness
-  std::vector<std::vector<double>> chl;
-  std::vector<std::vector<double>> h;
-  for ( std::size_t k = 0; k < nlevs; ++k ) {
-    gv.getAtLevel(tmp, "sea_water_cell_thickness", k);
-    h.push_back(tmp);
-    gv.getAtLevel(tmp, "mass_concentration_of_chlorophyll_in_sea_water", k);
-    chl.push_back(tmp);
-  }
+  const size_t nlocs = ovec.size();
+
+  // Chlorophyll and cell thickness profiles, contiguous at each location
+  const GeoVaLsView chl = gv.view("mass_concentration_of_chlorophyll_in_sea_water");
+  const GeoVaLsView h = gv.view("sea_water_cell_thickness");
+  const size_t nlevs = chl.nlevs();
 
-  // Calculate mean chlorophyll averaged over euphotic layer (euz_mod)
-  for ( std::size_t i = 0; i < nlocs; ++i ) {
-    double euz = Constants::euzc_0 * pow(chl[0][i], Constants::euzc_1);
+  // Calculate mean chlorophyll averaged over euphotic layer (euz_mod). Locations are independent.
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < nlocs; ++i) {
+    const double * chlProfile = chl.atLocation(i);
+    const double * hProfile = h.atLocation(i);
+    const double euz = Constants::euzc_0 * pow(chlProfile[0], Constants::euzc_1);
+
+    // Depth of the euphotic layer, rounded up to the bottom of a cell, and number of cells in it
     double euz_mod = 0.0;
-    int elev = 0;
-    for ( std::size_t k = 0; k < nlevs; ++k ) {
+    size_t elev = 0;
+    for (size_t k = 0; k < nlevs; ++k) {
       if (euz_mod < euz) {
-        euz_mod += h[k][i];
+        euz_mod += hProfile[k];
         elev++;
       }
     }
-    ovec[i] = 0.0;
-    for ( std::size_t k = 0; k < elev; ++k ) {
-      ovec[i] += chl[k][i] * h[k][i] / euz_mod;
+
+    double mean = 0.0;
+    for (size_t k = 0; k < elev; ++k) {
+      mean += chlProfile[k] * hProfile[k] / euz_mod;
     }
+    ovec[i] = mean;
   }
   oops::Log::trace() << "ObsChlEuzIntegr: observation operator run" << std::endl;
 }
@@ -7,6 +7,7 @@
 
 #include "ufo/operators/marine/marinevertinterp/ObsMarineVertInterp.h"
 
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -16,7 +17,9 @@
 
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
+#include "ufo/operators/marine/marinevertinterp/ObsMarineVertInterpUtil.h"
 #include "ufo/utils/OperatorUtils.h"  // for getOperatorVariables
+#include "ufo/utils/VertInterpStencil.h"
 namespace ufo {
 
 // -----------------------------------------------------------------------------
@@ -48,8 +51,10 @@ ObsMarineVertInterp::~ObsMarineVertInterp() {
 
 void ObsMarineVertInterp::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
                                       ObsDiagnostics &) const {
+  const std::shared_ptr<const VertInterpStencil> stencil = marineVertInterpStencil(odb_, gv);
   ufo_marinevertinterp_simobs_f90(keyOper_, gv.toFortran(), odb_, ovec.nvars(),
-                                  ovec.nlocs(), ovec.toFortran());
+                                  ovec.nlocs(), ovec.toFortran(),
+                                  stencil->indices().data(), stencil->weights().data());
   oops::Log::trace() << "ObsMarineVertInterp: observation operator run" << std::endl;
 }
 
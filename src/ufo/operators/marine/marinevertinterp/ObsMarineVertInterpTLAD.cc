@@ -7,6 +7,7 @@
 
 #include "ufo/operators/marine/marinevertinterp/ObsMarineVertInterpTLAD.h"
 
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -15,7 +16,10 @@
 #include "oops/base/Variables.h"
 #include "oops/util/Logger.h"
 #include "ufo/GeoVaLs.h"
+#include "ufo/LinearObsOperatorMatrix.h"
+#include "ufo/operators/marine/marinevertinterp/ObsMarineVertInterpUtil.h"
 #include "ufo/utils/OperatorUtils.h"  // for getOperatorVariables
+#include "ufo/utils/VertInterpStencil.h"
 
 namespace ufo {
 
@@ -27,12 +31,11 @@ ObsMarineVertInterpTLAD::ObsMarineVertInterpTLAD(const ioda::ObsSpace & odb,
                                                  const ObsMarineVertInterpParameters & params)
   : LinearObsOperatorBase(odb), keyOper_(0), varin_()
 {
-  std::vector<int> operatorVarIndices;
   getOperatorVariables(params.variables.value(), odb.assimvariables(),
-    operatorVars_, operatorVarIndices);
+    operatorVars_, operatorVarIndices_);
 
   ufo_marinevertinterp_tlad_setup_f90(keyOper_, params.toConfiguration(),
-    operatorVars_, operatorVarIndices.data(), operatorVarIndices.size(), varin_);
+    operatorVars_, operatorVarIndices_.data(), operatorVarIndices_.size(), varin_);
 
   oops::Log::trace() << "ObsMarineVertInterpTLAD created" << std::endl;
 }
@@ -47,7 +50,7 @@ ObsMarineVertInterpTLAD::~ObsMarineVertInterpTLAD() {
 // -----------------------------------------------------------------------------
 
 void ObsMarineVertInterpTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics &) {
-  ufo_marinevertinterp_tlad_settraj_f90(keyOper_, geovals.toFortran(), obsspace());
+  stencil_ = marineVertInterpStencil(obsspace(), geovals);
   oops::Log::trace() << "ObsMarineVertInterpTLAD: trajectory set" << std::endl;
 }
 
@@ -55,7 +58,8 @@ void ObsMarineVertInterpTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnost
 
 void ObsMarineVertInterpTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector & ovec) const {
   ufo_marinevertinterp_simobs_tl_f90(keyOper_, geovals.toFortran(), obsspace(),
-                                     ovec.nvars(), ovec.nlocs(), ovec.toFortran());
+                                     ovec.nvars(), ovec.nlocs(), ovec.toFortran(),
+                                     stencil_->indices().data(), stencil_->weights().data());
   oops::Log::trace() << "ObsMarineVertInterpTLAD: TL observation operator run" << std::endl;
 }
 
@@ -63,12 +67,27 @@ void ObsMarineVertInterpTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVe
 
 void ObsMarineVertInterpTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVector & ovec) const {
   ufo_marinevertinterp_simobs_ad_f90(keyOper_, geovals.toFortran(), obsspace(),
-                                     ovec.nvars(), ovec.nlocs(), ovec.toFortran());
+                                     ovec.nvars(), ovec.nlocs(), ovec.toFortran(),
+                                     stencil_->indices().data(), stencil_->weights().data());
   oops::Log::trace() << "ObsMarineVertInterpTLAD: adjoint observation operator run" << std::endl;
 }
 
 // -----------------------------------------------------------------------------
 
+std::unique_ptr<LinearObsOperatorMatrix> ObsMarineVertInterpTLAD::matrix() const {
+  const size_t nvars = obsspace().assimvariables().size();
+  const std::vector<std::string> &variables = operatorVars_.variables();
+  std::unique_ptr<LinearObsOperatorMatrix> matrix(new LinearObsOperatorMatrix(
+      variables, std::vector<size_t>(variables.size(), stencil_->nlevs()),
+      stencil_->nlocs() * nvars));
+  for (size_t ivar = 0; ivar < variables.size(); ++ivar)
+    stencil_->addToMatrix(*matrix, ivar, operatorVarIndices_[ivar], nvars);
+  matrix->finalise();
+  return matrix;
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsMarineVertInterpTLAD::print(std::ostream & os) const {
   os << "ObsMarinevertinterpTLAD::print not implemented" << std::endl;
 }
@@ -8,8 +8,10 @@
 #ifndef UFO_OPERATORS_MARINE_MARINEVERTINTERP_OBSMARINEVERTINTERPTLAD_H_
 #define UFO_OPERATORS_MARINE_MARINEVERTINTERP_OBSMARINEVERTINTERPTLAD_H_
 
+#include <memory>
 #include <ostream>
 #include <string>
+#include <vector>
 
 #include "oops/base/Variables.h"
 #include "oops/util/ObjectCounter.h"
@@ -28,6 +30,7 @@ namespace ioda {
 namespace ufo {
   class GeoVaLs;
   class ObsDiagnostics;
+  class VertInterpStencil;
 
 // -----------------------------------------------------------------------------
 
@@ -45,6 +48,7 @@ class ObsMarineVertInterpTLAD : public LinearObsOperatorBase,
   void setTrajectory(const GeoVaLs &, ObsDiagnostics &) override;
   void simulateObsTL(const GeoVaLs &, ioda::ObsVector &) const override;
   void simulateObsAD(GeoVaLs &, const ioda::ObsVector &) const override;
+  std::unique_ptr<LinearObsOperatorMatrix> matrix() const override;
 
   // Other
   const oops::Variables & requiredVars() const override {return varin_;}
@@ -55,6 +59,9 @@ class ObsMarineVertInterpTLAD : public LinearObsOperatorBase,
   F90hop keyOper_;
   oops::Variables varin_;
   oops::Variables operatorVars_;
+  std::vector<int> operatorVarIndices_;
+  /// Interpolation indices and weights computed from the trajectory.
+  std::shared_ptr<const VertInterpStencil> stencil_;
 };
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,45 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/operators/marine/marinevertinterp/ObsMarineVertInterpUtil.h"
+
+#include <utility>
+#include <vector>
+
+#include "ioda/ObsSpace.h"
+
+#include "ufo/GeoVaLs.h"
+#include "ufo/utils/VertInterpStencil.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<const VertInterpStencil> marineVertInterpStencil(const ioda::ObsSpace & odb,
+                                                                 const GeoVaLs & geovals) {
+  std::vector<double> obsDepth(odb.nlocs());
+  odb.get_db("MetaData", "depth", obsDepth);
+
+  // Depth of the centre of each cell.
+  const GeoVaLsView thickness = geovals.view("sea_water_cell_thickness");
+  const size_t nlevs = thickness.nlevs();
+  std::vector<double> depth(nlevs * thickness.nlocs());
+  for (size_t loc = 0; loc < thickness.nlocs(); ++loc) {
+    double top = 0.0;
+    for (size_t lev = 0; lev < nlevs; ++lev) {
+      depth[loc * nlevs + lev] = top + 0.5 * thickness(loc, lev);
+      top += thickness(loc, lev);
+    }
+  }
+
+  return VertInterpStencil::get(odb, "MarineVertInterp", depth.data(), nlevs,
+                                std::move(obsDepth), VertInterpStencil::Transform::NONE);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
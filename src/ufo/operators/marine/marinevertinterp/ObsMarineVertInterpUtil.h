@@ -0,0 +1,32 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_OPERATORS_MARINE_MARINEVERTINTERP_OBSMARINEVERTINTERPUTIL_H_
+#define UFO_OPERATORS_MARINE_MARINEVERTINTERP_OBSMARINEVERTINTERPUTIL_H_
+
+#include <memory>
+
+namespace ioda {
+  class ObsSpace;
+}
+
+namespace ufo {
+  class GeoVaLs;
+  class VertInterpStencil;
+
+/// \brief Return the stencil used by the MarineVertInterp operators to interpolate \p geovals
+/// to the depths of the observations held in \p odb.
+///
+/// The model depths are the depths of the centres of the cells whose thicknesses are given by
+/// the sea_water_cell_thickness GeoVaLs. The stencil is shared by the nonlinear and linear
+/// operators and recomputed only when the cell thicknesses or observation depths change.
+std::shared_ptr<const VertInterpStencil> marineVertInterpStencil(const ioda::ObsSpace & odb,
+                                                                 const GeoVaLs & geovals);
+
+}  // namespace ufo
+
+#endif  // UFO_OPERATORS_MARINE_MARINEVERTINTERP_OBSMARINEVERTINTERPUTIL_H_
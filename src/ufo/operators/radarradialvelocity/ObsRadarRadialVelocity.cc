@@ -7,6 +7,7 @@
 
 #include "ufo/operators/radarradialvelocity/ObsRadarRadialVelocity.h"
 
+#include <memory>
 #include <ostream>
 
 #include "ioda/ObsVector.h"
@@ -14,6 +15,8 @@
 #include "oops/base/Variables.h"
 
 #include "ufo/GeoVaLs.h"
+#include "ufo/operators/radarradialvelocity/ObsRadarRadialVelocityUtil.h"
+#include "ufo/utils/VertInterpStencil.h"
 
 namespace ufo {
 
@@ -23,7 +26,7 @@ static ObsOperatorMaker<ObsRadarRadialVelocity> makerRadarRadialVelocity_("Radar
 
 ObsRadarRadialVelocity::ObsRadarRadialVelocity(const ioda::ObsSpace & odb,
                        const ObsRadarRadialVelocityParameters & params)
-  : ObsOperatorBase(odb), keyOper_(0), odb_(odb), varin_()
+  : ObsOperatorBase(odb), keyOper_(0), odb_(odb), params_(params), varin_()
 {
   ufo_radarradialvelocity_setup_f90(keyOper_, params.toConfiguration(),
                                     odb.assimvariables(), varin_);
@@ -42,8 +45,10 @@ ObsRadarRadialVelocity::~ObsRadarRadialVelocity() {
 
 void ObsRadarRadialVelocity::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
                                          ObsDiagnostics &) const {
+  const std::shared_ptr<const VertInterpStencil> stencil =
+      radarRadialVelocityStencil(odb_, gv, params_);
   ufo_radarradialvelocity_simobs_f90(keyOper_, gv.toFortran(), odb_, ovec.nvars(), ovec.nlocs(),
-                         ovec.toFortran());
+                         ovec.toFortran(), stencil->indices().data(), stencil->weights().data());
   oops::Log::trace() << "ObsRadarRadialVelocity: observation operator run" << std::endl;
 }
 
@@ -60,6 +60,7 @@ class ObsRadarRadialVelocity : public ObsOperatorBase,
   void print(std::ostream &) const override;
   F90hop keyOper_;
   const ioda::ObsSpace& odb_;
+  Parameters_ params_;
   oops::Variables varin_;
 };
 
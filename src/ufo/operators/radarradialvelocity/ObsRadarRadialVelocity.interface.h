@@ -23,8 +23,11 @@ extern "C" {
   void ufo_radarradialvelocity_setup_f90(F90hop &, const eckit::Configuration &,
                              const oops::Variables &, oops::Variables &);
   void ufo_radarradialvelocity_delete_f90(F90hop &);
+  /// \param wi, wf
+  ///   Interpolation indices and weights at each location (see VertInterpStencil).
   void ufo_radarradialvelocity_simobs_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
-                               const int &, const int &, double &);
+                               const int &, const int &, double &,
+                               const int *wi, const double *wf);
 
 // -----------------------------------------------------------------------------
 
@@ -7,6 +7,7 @@
 
 #include "ufo/operators/radarradialvelocity/ObsRadarRadialVelocityTLAD.h"
 
+#include <memory>
 #include <ostream>
 
 #include "ioda/ObsSpace.h"
@@ -16,6 +17,8 @@
 #include "oops/util/Logger.h"
 
 #include "ufo/GeoVaLs.h"
+#include "ufo/operators/radarradialvelocity/ObsRadarRadialVelocityUtil.h"
+#include "ufo/utils/VertInterpStencil.h"
 
 namespace ufo {
 
@@ -26,7 +29,8 @@ static LinearObsOperatorMaker<ObsRadarRadialVelocityTLAD>
 
 ObsRadarRadialVelocityTLAD::ObsRadarRadialVelocityTLAD(const ioda::ObsSpace & odb,
                                            const Parameters_ & params)
-  : LinearObsOperatorBase(odb), keyOperRadarRadialVelocity_(0), varin_()
+  : LinearObsOperatorBase(odb), keyOperRadarRadialVelocity_(0), params_(params),
+    varin_()
 {
   ufo_radarradialvelocity_tlad_setup_f90(keyOperRadarRadialVelocity_,
                                          params.toConfiguration(), odb.assimvariables(), varin_);
@@ -49,6 +53,7 @@ void ObsRadarRadialVelocityTLAD::setTrajectory(const GeoVaLs & geovals,
 
   ufo_radarradialvelocity_tlad_settraj_f90(keyOperRadarRadialVelocity_, geovals.toFortran(),
                                            obsspace());
+  stencil_ = radarRadialVelocityStencil(obsspace(), geovals, params_);
 
   oops::Log::trace() << "ObsRadarRadialVelocityTLAD::setTrajectory exiting" << std::endl;
 }
@@ -58,7 +63,8 @@ void ObsRadarRadialVelocityTLAD::setTrajectory(const GeoVaLs & geovals,
 void ObsRadarRadialVelocityTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector & ovec)
                                  const {
   ufo_radarradialvelocity_simobs_tl_f90(keyOperRadarRadialVelocity_, geovals.toFortran(),
-                                        obsspace(), ovec.nvars(), ovec.nlocs(), ovec.toFortran());
+                                        obsspace(), ovec.nvars(), ovec.nlocs(), ovec.toFortran(),
+                                        stencil_->indices().data(), stencil_->weights().data());
 
   oops::Log::trace() << "ObsRadarRadialVelocityTLAD::simulateObsTL exiting" << std::endl;
 }
@@ -68,7 +74,8 @@ void ObsRadarRadialVelocityTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::Ob
 void ObsRadarRadialVelocityTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVector & ovec)
                                  const {
   ufo_radarradialvelocity_simobs_ad_f90(keyOperRadarRadialVelocity_, geovals.toFortran(),
-                                        obsspace(), ovec.nvars(), ovec.nlocs(), ovec.toFortran());
+                                        obsspace(), ovec.nvars(), ovec.nlocs(), ovec.toFortran(),
+                                        stencil_->indices().data(), stencil_->weights().data());
 
   oops::Log::trace() << "ObsRadarRadialVelocityTLAD::simulateObsAD exiting" << std::endl;
 }
@@ -9,6 +9,7 @@
 #define UFO_OPERATORS_RADARRADIALVELOCITY_OBSRADARRADIALVELOCITYTLAD_H_
 
 
+#include <memory>
 #include <ostream>
 #include <string>
 
@@ -27,6 +28,7 @@ namespace ioda {
 namespace ufo {
   class GeoVaLs;
   class ObsDiagnostics;
+  class VertInterpStencil;
 
 // -----------------------------------------------------------------------------
 /// RadarRadialVelocity observation operator
@@ -54,7 +56,10 @@ class ObsRadarRadialVelocityTLAD : public LinearObsOperatorBase,
  private:
   void print(std::ostream &) const override;
   F90hop keyOperRadarRadialVelocity_;
+  Parameters_ params_;
   oops::Variables varin_;
+  /// Interpolation indices and weights computed from the trajectory.
+  std::shared_ptr<const VertInterpStencil> stencil_;
 };
 
 // -----------------------------------------------------------------------------
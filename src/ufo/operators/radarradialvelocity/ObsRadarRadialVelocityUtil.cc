@@ -0,0 +1,40 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/operators/radarradialvelocity/ObsRadarRadialVelocityUtil.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ioda/ObsSpace.h"
+
+#include "ufo/GeoVaLs.h"
+#include "ufo/operators/radarradialvelocity/ObsRadarRadialVelocity.h"
+#include "ufo/utils/VertInterpStencil.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<const VertInterpStencil> radarRadialVelocityStencil(
+    const ioda::ObsSpace & odb, const GeoVaLs & geovals,
+    const ObsRadarRadialVelocityParameters & params) {
+  const std::string & modelCoord = params.VertCoord.value();
+
+  std::vector<double> gateHeight(odb.nlocs());
+  odb.get_db("MetaData", "geometric_height", gateHeight);
+
+  const GeoVaLsView modelHeight = geovals.view(modelCoord);
+  return VertInterpStencil::get(odb, "RadarRadialVelocity " + modelCoord,
+                                modelHeight.data(), modelHeight.nlevs(),
+                                std::move(gateHeight), VertInterpStencil::Transform::NONE);
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
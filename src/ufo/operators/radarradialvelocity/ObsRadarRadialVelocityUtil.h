@@ -0,0 +1,34 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_OPERATORS_RADARRADIALVELOCITY_OBSRADARRADIALVELOCITYUTIL_H_
+#define UFO_OPERATORS_RADARRADIALVELOCITY_OBSRADARRADIALVELOCITYUTIL_H_
+
+#include <memory>
+
+namespace ioda {
+  class ObsSpace;
+}
+
+namespace ufo {
+  class GeoVaLs;
+  class ObsRadarRadialVelocityParameters;
+  class VertInterpStencil;
+
+/// \brief Return the stencil used by the RadarRadialVelocity operators to interpolate \p geovals
+/// to the heights of the radar gates held in \p odb.
+///
+/// The model heights are taken from the GeoVaL selected by the VertCoord option. The stencil is
+/// shared by the nonlinear and linear operators and recomputed only when the model or gate
+/// heights change.
+std::shared_ptr<const VertInterpStencil> radarRadialVelocityStencil(
+    const ioda::ObsSpace & odb, const GeoVaLs & geovals,
+    const ObsRadarRadialVelocityParameters & params);
+
+}  // namespace ufo
+
+#endif  // UFO_OPERATORS_RADARRADIALVELOCITY_OBSRADARRADIALVELOCITYUTIL_H_
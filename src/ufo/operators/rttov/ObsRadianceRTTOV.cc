@@ -8,6 +8,7 @@
 #include "ufo/operators/rttov/ObsRadianceRTTOV.h"
 
 #include <algorithm>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <string>
@@ -20,6 +21,7 @@
 
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
+#include "ufo/filters/QCFlagsRegistry.h"
 
 namespace ufo {
 
@@ -28,15 +30,24 @@ static ObsOperatorMaker<ObsRadianceRTTOV> makerRTTOV_("RTTOV");
 
 // -----------------------------------------------------------------------------
 
+std::mutex & rttovInterfaceMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// -----------------------------------------------------------------------------
+
 ObsRadianceRTTOV::ObsRadianceRTTOV(const ioda::ObsSpace & odb,
                                    const Parameters_ & parameters)
-  : ObsOperatorBase(odb), keyOperRadianceRTTOV_(0), odb_(odb), varin_()
+  : ObsOperatorBase(odb), keyOperRadianceRTTOV_(0), odb_(odb), varin_(),
+    skipRejectedChannels_(parameters.obsOptions.value().skipRejectedChannels.value())
 {
   // parse channels from the config and create variable names
   const oops::Variables & observed = odb.assimvariables();
   std::vector<int> channels_list = observed.channels();
 
   // call Fortran setup routine
+  std::lock_guard<std::mutex> lock(rttovInterfaceMutex());
   ufo_radiancerttov_setup_f90(keyOperRadianceRTTOV_, parameters.toConfiguration(),
                              channels_list.size(), channels_list[0], varin_);
 
@@ -51,6 +62,7 @@ ObsRadianceRTTOV::ObsRadianceRTTOV(const ioda::ObsSpace & odb,
 // -----------------------------------------------------------------------------
 
 ObsRadianceRTTOV::~ObsRadianceRTTOV() {
+  std::lock_guard<std::mutex> lock(rttovInterfaceMutex());
   ufo_radiancerttov_delete_f90(keyOperRadianceRTTOV_);
   oops::Log::trace() << "ObsRadianceRTTOV destructed" << std::endl;
 }
@@ -59,6 +71,16 @@ ObsRadianceRTTOV::~ObsRadianceRTTOV() {
 
 void ObsRadianceRTTOV::simulateObs(const GeoVaLs & gom, ioda::ObsVector & ovec,
                                   ObsDiagnostics & dvec) const {
+  // An empty mask (no QC flags registered) makes RTTOV simulate all channels.
+  const std::vector<int> active = skipRejectedChannels_ ?
+        QCFlagsRegistry::passedMask(odb_, ovec.varnames()) : std::vector<int>();
+  std::lock_guard<std::mutex> lock(rttovInterfaceMutex());
+  if (skipRejectedChannels_) {
+    const int nlocs = active.empty() ? 0 : ovec.nlocs();
+    const int dummy = 0;
+    ufo_radiancerttov_set_active_channels_f90(keyOperRadianceRTTOV_, ovec.nvars(), nlocs,
+                                              active.empty() ? dummy : active[0]);
+  }
   ufo_radiancerttov_simobs_f90(keyOperRadianceRTTOV_, gom.toFortran(), odb_,
                           ovec.nvars(), ovec.nlocs(), ovec.toFortran(),
                           dvec.toFortran());
@@ -8,6 +8,7 @@
 #ifndef UFO_OPERATORS_RTTOV_OBSRADIANCERTTOV_H_
 #define UFO_OPERATORS_RTTOV_OBSRADIANCERTTOV_H_
 
+#include <mutex>
 #include <ostream>
 #include <string>
 
@@ -27,6 +28,14 @@ namespace ufo {
   class GeoVaLs;
   class ObsDiagnostics;
 
+// -----------------------------------------------------------------------------
+/// \brief Return the mutex serialising calls to the Fortran RTTOV interface.
+///
+/// The interface keeps per-call state (e.g. the profile lists and diagnostics) in module
+/// variables shared by all instances of ObsRadianceRTTOV and ObsRadianceRTTOVTLAD, so operators
+/// acting on different ObsSpaces must not call it concurrently.
+std::mutex & rttovInterfaceMutex();
+
 // -----------------------------------------------------------------------------
 /// RadianceRTTOV observation for UFO.
 class ObsRadianceRTTOV : public ObsOperatorBase,
@@ -52,6 +61,7 @@ class ObsRadianceRTTOV : public ObsOperatorBase,
   F90hop keyOperRadianceRTTOV_;
   const ioda::ObsSpace& odb_;
   oops::Variables varin_;
+  bool skipRejectedChannels_;
 };
 
 // -----------------------------------------------------------------------------
@@ -29,6 +29,8 @@ extern "C" {
                                   const int &, const int &,
                                   oops::Variables &);
   void ufo_radiancerttov_delete_f90(F90hop &);
+  void ufo_radiancerttov_set_active_channels_f90(const F90hop &, const int &, const int &,
+                                                 const int &);
   void ufo_radiancerttov_simobs_f90(const F90hop &, const F90goms &, const ioda::ObsSpace &,
                                const int &, const int &, double &, const F90goms &);
 // -----------------------------------------------------------------------------
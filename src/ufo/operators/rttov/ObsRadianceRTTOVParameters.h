@@ -73,6 +73,17 @@ class RTTOVObsOptionsParameters : public oops::Parameters {
   /// (nchan_max_sim)
   oops::Parameter<int> maxChanPerBatch{"max_channels_per_batch", 10000, this};
 
+  /// Number of OpenMP threads used by RTTOV to process the profiles of each batch. If greater
+  /// than 1 the rttov_parallel_direct and rttov_parallel_k interfaces are called instead of
+  /// rttov_direct and rttov_k. Not used by RTTOV-SCATT, which is always run serially.
+  oops::Parameter<int> nThreads{"RTTOV_nthreads", 1, this};
+
+  /// If true, the coefficients read by this operator are shared with all other RTTOV operators
+  /// (including linear operators) in the same process that simulate the same instruments with
+  /// the same coefficient path and cloud, aerosol and PC options, instead of each operator
+  /// reading its own copy.
+  oops::Parameter<bool> shareCoefficients{"RTTOV_share_coefficients", false, this};
+
   /// If performing the qsplit calculation for qtotal within the interface this option
   /// allows for the inclusion of rain in the calculation.  Although the default is false
   /// it is turned to true in the interface if simulating a microwave instrument with
@@ -95,6 +106,10 @@ class RTTOVObsOptionsParameters : public oops::Parameters {
   /// RTTOV to use surface emissivity from the ObsSpace
   oops::Parameter<std::string> surfaceEmissivityGroup{"surface emissivity group", "", this};
 
+  /// If true, channels that have already been rejected by the filters acting on the ObsSpace
+  /// are not passed to RTTOV by the forward operator; their H(x) is set to missing.
+  oops::Parameter<bool> skipRejectedChannels{"SkipRejectedChannels", false, this};
+
   /// -----------------------------------------------------------------------------------
   /// RTTOV options all of these are loaded using set_options_rttov and are not required
   /// because there are defaults within the RTTOV code.  The values are taken from
@@ -374,10 +389,32 @@ class RTTOVObsOptionsParameters : public oops::Parameters {
 
   /// ----------------------------------------------------------------------
   /// Principal Components-only radiative transfer options: ops % rt_ir % pc
-  /// This is being deliberately omitted because the interface is currently
-  /// not setup to deal with PC's
+  /// PC-RTTOV runs RTTOV for the predictor channels only. If RTTOV_addradrec is
+  /// false H(x) holds the PC scores and the channels of the ObsSpace are the
+  /// indices of the PC scores (1 to RTTOV_npcscores); otherwise H(x) holds the
+  /// reconstructed brightness temperatures of the channels of the ObsSpace.
+  /// Jacobians for the linear operator are those of these outputs. Cannot be
+  /// used with the 1D-Var or "surface emissivity group", and no diagnostics
+  /// are produced.
   /// ----------------------------------------------------------------------
 
+  /// If true PC-RTTOV is used (only for hyperspectral sounders with PC
+  /// coefficient files). Default is false
+  oops::OptionalParameter<bool> RTTOVAddPC{"RTTOV_addpc", this};
+
+  /// Index of the spectral band of the PC coefficients
+  oops::OptionalParameter<int> RTTOVIPCBnd{"RTTOV_ipcbnd", this};
+
+  /// Index of the predictor channel set of the PC coefficients
+  oops::OptionalParameter<int> RTTOVIPCReg{"RTTOV_ipcreg", this};
+
+  /// Number of PC scores to compute
+  oops::OptionalParameter<int> RTTOVNPCScores{"RTTOV_npcscores", this};
+
+  /// If true reconstructed radiances are computed from the PC scores. Default
+  /// is false
+  oops::OptionalParameter<bool> RTTOVAddRadRec{"RTTOV_addradrec", this};
+
   /// ----------------------------------------------------------------------
   /// Options related to HTFRTC: ops % htfrtc_opts
   /// This is being deliberately omitted because the interface is currently
@@ -8,6 +8,7 @@
 #include "ufo/operators/rttov/ObsRadianceRTTOVTLAD.h"
 
 #include <algorithm>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <vector>
@@ -19,6 +20,7 @@
 #include "oops/util/Logger.h"
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
+#include "ufo/operators/rttov/ObsRadianceRTTOV.h"
 
 namespace ufo {
 
@@ -35,6 +37,7 @@ ObsRadianceRTTOVTLAD::ObsRadianceRTTOVTLAD(const ioda::ObsSpace & odb,
   std::vector<int> channels_list = observed.channels();
 
   // call Fortran setup routine
+  std::lock_guard<std::mutex> lock(rttovInterfaceMutex());
   ufo_radiancerttov_tlad_setup_f90(keyOperRadianceRTTOV_, parameters.toConfiguration(),
                                   channels_list.size(), channels_list[0], varin_);
 
@@ -44,6 +47,7 @@ ObsRadianceRTTOVTLAD::ObsRadianceRTTOVTLAD(const ioda::ObsSpace & odb,
 // -----------------------------------------------------------------------------
 
 ObsRadianceRTTOVTLAD::~ObsRadianceRTTOVTLAD() {
+  std::lock_guard<std::mutex> lock(rttovInterfaceMutex());
   ufo_radiancerttov_tlad_delete_f90(keyOperRadianceRTTOV_);
   oops::Log::trace() << "ObsRadianceRTTOVTLAD destructed" << std::endl;
 }
@@ -51,6 +55,7 @@ ObsRadianceRTTOVTLAD::~ObsRadianceRTTOVTLAD() {
 // -----------------------------------------------------------------------------
 
 void ObsRadianceRTTOVTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics & ydiags) {
+  std::lock_guard<std::mutex> lock(rttovInterfaceMutex());
   ufo_radiancerttov_tlad_settraj_f90(keyOperRadianceRTTOV_, geovals.toFortran(), obsspace(),
                                     ydiags.toFortran());
   oops::Log::trace() << "ObsRadianceRTTOVTLAD::setTrajectory done" << std::endl;
@@ -59,6 +64,7 @@ void ObsRadianceRTTOVTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics
 // -----------------------------------------------------------------------------
 
 void ObsRadianceRTTOVTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector & ovec) const {
+  std::lock_guard<std::mutex> lock(rttovInterfaceMutex());
   ufo_radiancerttov_simobs_tl_f90(keyOperRadianceRTTOV_, geovals.toFortran(), obsspace(),
                              ovec.nvars(), ovec.nlocs(), ovec.toFortran());
   oops::Log::trace() << "ObsRadianceRTTOVTLAD::simulateObsTL done" << std::endl;
@@ -67,6 +73,7 @@ void ObsRadianceRTTOVTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVecto
 // -----------------------------------------------------------------------------
 
 void ObsRadianceRTTOVTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVector & ovec) const {
+  std::lock_guard<std::mutex> lock(rttovInterfaceMutex());
   ufo_radiancerttov_simobs_ad_f90(keyOperRadianceRTTOV_, geovals.toFortran(), obsspace(),
                              ovec.nvars(), ovec.nlocs(), ovec.toFortran());
   oops::Log::trace() << "ObsRadianceRTTOVTLAD::simulateObsAD done" << std::endl;
@@ -74,6 +81,14 @@ void ObsRadianceRTTOVTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVecto
 
 // -----------------------------------------------------------------------------
 
+size_t ObsRadianceRTTOVTLAD::trajectoryMemoryBytes() const {
+  size_t nbytes = 0;
+  ufo_radiancerttov_tlad_memory_bytes_f90(keyOperRadianceRTTOV_, nbytes);
+  return nbytes;
+}
+
+// -----------------------------------------------------------------------------
+
 void ObsRadianceRTTOVTLAD::print(std::ostream & os) const {
   os << "ObsRadianceRTTOVTLAD::print not implemented" << std::endl;
 }
@@ -46,6 +46,7 @@ class ObsRadianceRTTOVTLAD : public LinearObsOperatorBase,
 
   // Other
   const oops::Variables & requiredVars() const override {return varin_;}
+  size_t trajectoryMemoryBytes() const override;
 
   int & toFortran() {return keyOperRadianceRTTOV_;}
   const int & toFortran() const {return keyOperRadianceRTTOV_;}
@@ -31,24 +31,7 @@ ObsRadianceRTTOVCPP::ObsRadianceRTTOVCPP(const ioda::ObsSpace & odb,
                                          const Parameters_ & parameters)
   : ObsOperatorBase(odb), odb_(odb), varin_()
 {
-  // Fields to be requested from getvalues and stored in geovals
-  // need to be consistent with those defined in ufo_variables_mod.F90
-  //-----------------------------------------------------------------------------
-  const std::vector<std::string> vv{
-    "air_pressure",
-    "air_temperature",
-    "specific_humidity",
-    "surface_pressure",
-    "surface_temperature",   // this is actually var_sfc_t2m
-    "specific_humidity_at_two_meters_above_surface",
-    "uwind_at_10m",
-    "vwind_at_10m",
-    "skin_temperature",
-    "seaice_fraction",
-    "landmask",
-    "surface_geopotential_height"
-  };
-
+  const std::vector<std::string> & vv = rttovcppInputVariables();
   for (size_t jvar = 0; jvar < vv.size(); ++jvar) {
      varin_.push_back(vv[jvar]);  // set private data member varin_
   }
@@ -61,6 +44,8 @@ ObsRadianceRTTOVCPP::ObsRadianceRTTOVCPP(const ioda::ObsSpace & odb,
   const std::string CoefPath = parameters.CoefPath;
   const std::string SensorID = parameters.SensorID;
   CoefFileName = CoefPath + "rtcoef_" + SensorID + ".dat";
+  runOptions_.nthreads = parameters.nthreads;
+  runOptions_.nprofsPerCall = parameters.nprofsPerCall;
   oops::Log::info() << CoefFileName << std::endl;
 
   oops::Log::trace() << "ObsRadianceRTTOVCPP created." << std::endl;
@@ -77,15 +62,17 @@ ObsRadianceRTTOVCPP::~ObsRadianceRTTOVCPP() {
 void ObsRadianceRTTOVCPP::simulateObs(const GeoVaLs & geovals, ioda::ObsVector & hofx,
                                    ObsDiagnostics &) const {
 //
-  std::vector<bool>  skip_profile;
-  ufo::rttovcpp_interface(geovals, odb_, aRttov_, CoefFileName, channels_,
-                          nlevels, skip_profile);
+  // Keep the trajectory so that the linear operator can reuse it.
+  trajectory_ = rttovcppTrajectory(geovals, odb_, CoefFileName, channels_,
+                                   runOptions_);
+  rttov::RttovSafe & aRttov = trajectory_->aRttov;
+  const std::vector<bool> & skip_profile = trajectory_->skip_profile;
 
 // ------------------------------------------------------------------------
 // Obtain calculated brightness temperature for all profiles/channels
 // ------------------------------------------------------------------------
   std::size_t nprofiles = geovals.nlocs();
-  std::size_t nchannels = aRttov_.getNchannels();
+  std::size_t nchannels = aRttov.getNchannels();
 
   ASSERT(geovals.nlocs() == hofx.nlocs());
   hofx.zero();  // this may not be necessary
@@ -97,7 +84,7 @@ void ObsRadianceRTTOVCPP::simulateObs(const GeoVaLs & geovals, ioda::ObsVector &
   for (size_t p = 0; p < nprofiles; p++) {
       for (size_t c = 0; c < nchannels; c++) hofx[p*nchannels+c] = missing;
       if (skip_profile[p]) continue;
-      bt = aRttov_.getBtRefl(p);
+      bt = aRttov.getBtRefl(p);
       for (size_t c = 0; c < nchannels; c++) hofx[p*nchannels+c] = bt[c];
   }
 
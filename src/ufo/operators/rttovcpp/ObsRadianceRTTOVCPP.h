@@ -8,6 +8,7 @@
 #ifndef UFO_OPERATORS_RTTOVCPP_OBSRADIANCERTTOVCPP_H_
 #define UFO_OPERATORS_RTTOVCPP_OBSRADIANCERTTOVCPP_H_
 
+#include <memory>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "oops/util/ObjectCounter.h"
 #include "ufo/ObsOperatorBase.h"
 #include "ufo/operators/rttovcpp/ObsRadianceRTTOVCPPParameters.h"
+#include "ufo/operators/rttovcpp/rttovcpp_interface.h"
 
 #include "rttov/wrapper/RttovSafe.h"
 
@@ -55,10 +57,11 @@ class ObsRadianceRTTOVCPP : public ObsOperatorBase,
   oops::Variables varin_;
   std::string        CoefFileName;
   std::vector<int>   channels_;
-  mutable std::size_t        nlevels;  // need this in order to allocate dx
+  RttovCppRunOptions runOptions_;
 
-// Declare a RttovSafe object for one single sensor
-  mutable rttov::RttovSafe  aRttov_ = rttov::RttovSafe();
+// Output of the RTTOV K model for the GeoVaLs passed to the last call to simulateObs(),
+// kept so that it can be reused by the linear operator
+  mutable std::shared_ptr<RttovCppTrajectory> trajectory_;
 };
 
 // -----------------------------------------------------------------------------
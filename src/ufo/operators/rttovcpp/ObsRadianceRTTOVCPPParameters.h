@@ -11,6 +11,8 @@
 #include <string>
 #include <vector>
 
+#include "oops/util/parameters/NumericConstraints.h"
+#include "oops/util/parameters/Parameter.h"
 #include "oops/util/parameters/RequiredParameter.h"
 #include "ufo/ObsOperatorParametersBase.h"
 
@@ -30,6 +32,20 @@ class ObsRadianceRTTOVCPPParameters : public ObsOperatorParametersBase {
     {"SensorID",
      "Name of optical depth coefficients file",
      this};
+
+  oops::Parameter<int> nthreads
+    {"RTTOV threads",
+     "Number of OpenMP threads used by the RTTOV parallel interface",
+     1,
+     this,
+     {oops::minConstraint(1)}};
+
+  oops::Parameter<int> nprofsPerCall
+    {"RTTOV profiles per call",
+     "Number of profiles passed to each call made by the RTTOV parallel interface",
+     1,
+     this,
+     {oops::minConstraint(1)}};
 };
 
 }  // namespace ufo
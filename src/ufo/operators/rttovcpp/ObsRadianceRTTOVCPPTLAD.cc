@@ -21,6 +21,7 @@
 #include "ufo/ObsDiagnostics.h"
 #include "ufo/operators/rttovcpp/ObsRadianceRTTOVCPPTLAD.h"
 #include "ufo/operators/rttovcpp/rttovcpp_interface.h"
+#include "ufo/utils/LocationChunks.h"
 
 namespace ufo {
 
@@ -50,6 +51,8 @@ ObsRadianceRTTOVCPPTLAD::ObsRadianceRTTOVCPPTLAD(const ioda::ObsSpace & odb,
   const std::string CoefPath = parameters.CoefPath;
   const std::string SensorID = parameters.SensorID;
   CoefFileName = CoefPath + "rtcoef_" + SensorID + ".dat";
+  runOptions_.nthreads = parameters.nthreads;
+  runOptions_.nprofsPerCall = parameters.nprofsPerCall;
 
   oops::Log::trace() << "ObsRadianceRTTOVCPPTLAD created." << std::endl;
 }
@@ -64,8 +67,8 @@ ObsRadianceRTTOVCPPTLAD::~ObsRadianceRTTOVCPPTLAD() {
 
 void ObsRadianceRTTOVCPPTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics &) {
 //
-  ufo::rttovcpp_interface(geovals, obsspace(), aRttov_, CoefFileName, channels_,
-                          nlevels, skip_profile);
+  trajectory_ = rttovcppTrajectory(geovals, obsspace(), CoefFileName, channels_,
+                                   runOptions_);
 
   oops::Log::trace() << "ObsRadianceRTTOVCPPTLAD::setTrajectory done" << std::endl;
 }
@@ -74,44 +77,39 @@ void ObsRadianceRTTOVCPPTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnost
 
 void ObsRadianceRTTOVCPPTLAD::simulateObsTL(const GeoVaLs & dx, ioda::ObsVector & dy) const {
 //
+  const std::size_t nlevels = trajectory_->nlevels;
+  const std::size_t nchannels = trajectory_->nchannels;
+  const std::vector<bool> & skip_profile = trajectory_->skip_profile;
+  const std::vector<double> & kT = trajectory_->kT;
+  const std::vector<double> & kQ = trajectory_->kQ;
   std::size_t nprofiles = dy.nlocs();
-  std::size_t nchannels = aRttov_.getNchannels();
 
-  std::vector<double>  tmpvar2d(nprofiles, 0.0);  // one single level field
-  std::vector<std::vector<double>> dT;  // [nlevels][nprofiles]
-  std::vector<std::vector<double>> dQ;  // [nlevels][nprofiles]
-
-  // Retrieve temperature increment in K
-  for (std::size_t i = 0; i < nlevels; ++i) {
-      dx.getAtLevel(tmpvar2d, "air_temperature", i);  // get one level T
-      dT.push_back(tmpvar2d);  // push one level T into 3D T
-  }
-
-  // Retrieve specific humidity increment in kg/kg
-  for (std::size_t i = 0; i < nlevels; ++i) {
-      dx.getAtLevel(tmpvar2d, "specific_humidity", i);  // get one level Q
-      dQ.push_back(tmpvar2d);  // push one level Q into 3D Q
-  }
+  // Temperature (K) and specific humidity (kg/kg) increments, one contiguous profile per location
+  const GeoVaLsView dT = dx.view("air_temperature");
+  const GeoVaLsView dQ = dx.view("specific_humidity");
 
 //-------------------------------------------
   ASSERT(dx.nlocs() == dy.nlocs());
   ASSERT(nchannels == dy.nvars());
+  ASSERT(dT.nlevs() == nlevels && dQ.nlevs() == nlevels);
   dy.zero();
 
-  std::vector <double> var_k(nlevels, 0.0);
-
-  for (size_t p = 0; p < nprofiles; p++) {
-    if (skip_profile[p]) continue;
-    for (size_t c = 0; c < nchannels; c++) {
-      var_k = aRttov_.getTK(p, c);              // T Jacobian for a single profile/channel
-      for (size_t l = 0; l < nlevels; l++)
-          dy[p*nchannels+c] += var_k[l]*dT[l][p];
-
-      var_k = aRttov_.getItemK(rttov::Q, p, c);   // Q Jacobian
-      for (size_t l = 0; l < nlevels; l++)
-          dy[p*nchannels+c] += var_k[l]*dQ[l][p];
+  forEachLocationChunk(nprofiles, rttovcppProfilesPerChunk, true,
+                       [&](std::size_t begin, std::size_t end) {
+    for (size_t p = begin; p < end; p++) {
+      if (skip_profile[p]) continue;
+      const double * dTp = dT.data() + p*nlevels;
+      const double * dQp = dQ.data() + p*nlevels;
+      for (size_t c = 0; c < nchannels; c++) {
+        const double * kTpc = kT.data() + (p*nchannels+c)*nlevels;  // T Jacobian
+        const double * kQpc = kQ.data() + (p*nchannels+c)*nlevels;  // Q Jacobian
+        double sum = 0.0;
+        for (size_t l = 0; l < nlevels; l++)
+          sum += kTpc[l]*dTp[l] + kQpc[l]*dQp[l];
+        dy[p*nchannels+c] = sum;
+      }
     }
-  }
+  });
 
   oops::Log::trace() << "ObsRadianceRTTOVCPPTLAD::simulateObsTL done" << std::endl;
 }
@@ -120,66 +118,42 @@ void ObsRadianceRTTOVCPPTLAD::simulateObsTL(const GeoVaLs & dx, ioda::ObsVector
 
 void ObsRadianceRTTOVCPPTLAD::simulateObsAD(GeoVaLs & dx, const ioda::ObsVector & dy) const {
 //
+  const std::size_t nlevels = trajectory_->nlevels;
+  const std::size_t nchannels = trajectory_->nchannels;
+  const std::vector<bool> & skip_profile = trajectory_->skip_profile;
+  const std::vector<double> & kT = trajectory_->kT;
+  const std::vector<double> & kQ = trajectory_->kQ;
   std::size_t nprofiles = dy.nlocs();
-  std::size_t nchannels = aRttov_.getNchannels();
-
-  std::vector<double>  tmpvar2d(nprofiles, 0.0);  // one single level field
-  std::vector<std::vector<double>> dT;  // [nlevels][nprofiles]
-  std::vector<std::vector<double>> dQ;  // [nlevels][nprofiles]
 
-  // Retrieve temperature increment in K
-  for (std::size_t i = 0; i < nlevels; ++i) {
-      dx.getAtLevel(tmpvar2d, "air_temperature", i);  // get one level T
-      dT.push_back(tmpvar2d);  // push one level T into 3D T
-  }
-
-  // Retrieve specific humidity increment in kg/kg
-  for (std::size_t i = 0; i < nlevels; ++i) {
-      dx.getAtLevel(tmpvar2d, "specific_humidity", i);  // get one level Q
-      dQ.push_back(tmpvar2d);  // push one level Q into 3D Q
-  }
+  // Temperature (K) and specific humidity (kg/kg) increments, updated in place
+  double * dT = dx.data("air_temperature");
+  double * dQ = dx.data("specific_humidity");
 
 //-------------------------------------------
   ASSERT(dx.nlocs() == dy.nlocs());
+  ASSERT(dx.nlevs("air_temperature") == nlevels && dx.nlevs("specific_humidity") == nlevels);
 
   double missing = util::missingValue(missing);
 
-  std::vector <double> var_k(nlevels, 0.0);
-
-  for (size_t p = 0; p < nprofiles; p++) {
-    if (skip_profile[p]) continue;
-    for (size_t c = 0; c < nchannels; c++) {
-      var_k = aRttov_.getTK(p, c);               // T Jacobian, nlevels
-      for (size_t l = 0; l < nlevels; ++l) {
-        if (dy[p*nchannels+c] != missing) {
-            dT[l][p] += dy[p*nchannels+c] * var_k[l];
-        }
-      }
-
-      var_k = aRttov_.getItemK(rttov::Q, p, c);  // Q Jacobian, nlevels
-      for (size_t l = 0; l < nlevels; l++) {
-        if (dy[p*nchannels+c] != missing) {
-            dQ[l][p] += dy[p*nchannels+c] * var_k[l];
+  // Each profile only updates its own location, so the profiles can be processed in parallel
+  forEachLocationChunk(nprofiles, rttovcppProfilesPerChunk, true,
+                       [&](std::size_t begin, std::size_t end) {
+    for (size_t p = begin; p < end; p++) {
+      if (skip_profile[p]) continue;
+      double * dTp = dT + p*nlevels;
+      double * dQp = dQ + p*nlevels;
+      for (size_t c = 0; c < nchannels; c++) {
+        const double dyc = dy[p*nchannels+c];
+        if (dyc == missing) continue;
+        const double * kTpc = kT.data() + (p*nchannels+c)*nlevels;  // T Jacobian
+        const double * kQpc = kQ.data() + (p*nchannels+c)*nlevels;  // Q Jacobian
+        for (size_t l = 0; l < nlevels; ++l) {
+          dTp[l] += dyc * kTpc[l];
+          dQp[l] += dyc * kQpc[l];
         }
       }
     }
-  }
-
-  // Put temperature increment in kg/kg
-  for (std::size_t l = 0; l < nlevels; ++l) {
-      for (size_t p = 0; p < nprofiles; p++) {
-          tmpvar2d[p] = dT[l][p];
-      }
-      dx.putAtLevel(tmpvar2d, "air_temperature", l);  // put one level T
-  }
-
-  // Put specific humidity increment in kg/kg
-  for (std::size_t l = 0; l < nlevels; ++l) {
-      for (size_t p = 0; p < nprofiles; p++) {
-          tmpvar2d[p] = dQ[l][p];
-      }
-      dx.putAtLevel(tmpvar2d, "specific_humidity", l);  // put one level Q
-  }
+  });
 
   oops::Log::trace() << "ObsRadianceRTTOVCPPTLAD::simulateObsAD done" << std::endl;
 }
@@ -8,6 +8,7 @@
 #ifndef UFO_OPERATORS_RTTOVCPP_OBSRADIANCERTTOVCPPTLAD_H_
 #define UFO_OPERATORS_RTTOVCPP_OBSRADIANCERTTOVCPPTLAD_H_
 
+#include <memory>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "oops/util/ObjectCounter.h"
 #include "ufo/LinearObsOperatorBase.h"
 #include "ufo/operators/rttovcpp/ObsRadianceRTTOVCPPParameters.h"
+#include "ufo/operators/rttovcpp/rttovcpp_interface.h"
 
 #include "rttov/wrapper/RttovSafe.h"
 
@@ -58,11 +60,10 @@ class ObsRadianceRTTOVCPPTLAD : public LinearObsOperatorBase,
   oops::Variables varin_;
   std::string        CoefFileName;
   std::vector<int>   channels_;
-  mutable std::size_t        nlevels;  // need this in order to allocate dx
-  std::vector<bool>  skip_profile;
+  RttovCppRunOptions runOptions_;
 
-// Declare a RttovSafe object for one single sensor
-  mutable rttov::RttovSafe  aRttov_ = rttov::RttovSafe();
+// Output of the RTTOV K model for the trajectory
+  std::shared_ptr<RttovCppTrajectory> trajectory_;
 };
 
 // -----------------------------------------------------------------------------
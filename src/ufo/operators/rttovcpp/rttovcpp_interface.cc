@@ -7,10 +7,14 @@
 
 #include "ufo/operators/rttovcpp/rttovcpp_interface.h"
 
+#include <cmath>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <vector>
 
+#include "eckit/exception/Exceptions.h"
+
 #include "ioda/ObsSpace.h"
 #include "ioda/ObsVector.h"
 
@@ -22,6 +26,8 @@
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsBias.h"
 #include "ufo/ObsDiagnostics.h"
+#include "ufo/utils/LocationChunks.h"
+#include "ufo/utils/SharedTrajectory.h"
 
 #include "rttov/wrapper/Profile.h"
 #include "rttov/wrapper/RttovSafe.h"
@@ -49,9 +55,9 @@ namespace ufo {
 * \param[in] odb_ reference to the input observational information
 * \param[in] CoefFileName rttov coef file to be loaded
 * \param[in] channels_ indexes for a subset of channels for a single sensor
-* \param[out] nlevels number of model vertical levels
-* \param[out] aRttov_ reference to the output rttov object
-* \param[out] skip_profile logical to determine if a profile is used or not
+* \param[in] runOptions options of the RTTOV parallel interface
+* \param[out] trajectory rttov object, number of model vertical levels and channels,
+*             Jacobians and logicals to determine if a profile is used or not
 *
 * \author Zhiquan (Jake) Liu (NCAR/MMM), initial version for clear-sky DA 
 *
@@ -59,9 +65,10 @@ namespace ufo {
 *
 */
 void rttovcpp_interface(const GeoVaLs & geovals, const ioda::ObsSpace & odb_,
-                        rttov::RttovSafe & aRttov_, const std::string CoefFileName,
-                        const std::vector<int> channels_, std::size_t & nlevels,
-                        std::vector<bool> & skip_profile) {
+                        const std::string & CoefFileName, const std::vector<int> & channels_,
+                        const RttovCppRunOptions & runOptions, RttovCppTrajectory & trajectory) {
+  rttov::RttovSafe & aRttov_ = trajectory.aRttov;
+
   // 1. Set options for a RttovSafe instance:
   //-----------------------------------------------
   // 1.1 general setting for all sensors: clear-sky
@@ -79,7 +86,12 @@ void rttovcpp_interface(const GeoVaLs & geovals, const ioda::ObsSpace & odb_,
   aRttov_.options.setSupplyFoamFraction(false);
   aRttov_.options.setApplyBandCorrection(true);
 
-  // 1.3 Load coef for subset channels of an instrument
+  // 1.3 RTTOV parallel interface: the profiles are split into chunks processed by separate
+  // threads
+  aRttov_.options.setNthreads(runOptions.nthreads);
+  aRttov_.options.setNprofsPerCall(runOptions.nprofsPerCall);
+
+  // 1.4 Load coef for subset channels of an instrument
   //-------------------------------------------------
   try {
       aRttov_.loadInst(channels_);
@@ -92,71 +104,25 @@ void rttovcpp_interface(const GeoVaLs & geovals, const ioda::ObsSpace & odb_,
 
   // 2. Allocate profiles
   //---------------------------------------------------------------------------------
-  nlevels   = geovals.nlevs("air_temperature");   // set private data member
-  std::size_t nprofiles = odb_.nlocs();
-  std::size_t nchannels = aRttov_.getNchannels();
-
-  std::vector <rttov::Profile> profiles;   // RTTOV Profile object
-  for (std::size_t p = 0; p < nprofiles; p++) {
-      rttov::Profile aProfile(nlevels);
-      profiles.push_back(aProfile);
-  }
+  const std::size_t nlevels = geovals.nlevs("air_temperature");
+  const std::size_t nprofiles = odb_.nlocs();
+  const std::size_t nchannels = aRttov_.getNchannels();
+  trajectory.nlevels = nlevels;
+  trajectory.nchannels = nchannels;
 
-  // global scope for it accessable by reflectance* cos(sunzen)
-  std::vector<double> sunzen(nprofiles, 0.0);
+  std::vector <rttov::Profile> profiles(nprofiles, rttov::Profile(nlevels));
 
   // 3. Populate the profiles object
   //---------------------------------------------------------------------------------
   try {
-      std::vector<double>  tmpvar1d(nlevels, 0.0);    // one single vertical profile
-      std::vector<double>  tmpvar2d(nprofiles, 0.0);  // one single level field
-
-  // 3.1 Common 3D fields needed
+  // 3.1 Common 3D fields needed: pressure (converted to hPa), temperature (K) and specific
+  //     humidity (kg/kg). Each profile is stored contiguously in the GeoVaLs, with the rttov
+  //     level index going from top to bottom.
   //----------------------------------------------------
-    // 3.1.1 Retrieve pressure in hPa
-      std::vector<std::vector<double>> tmpvar3d;    // [nlevels][nprofiles]
-      for (std::size_t i = 0; i < nlevels; ++i) {
-         geovals.getAtLevel(tmpvar2d, "air_pressure", i);  // get one level P
-         tmpvar3d.push_back(tmpvar2d);  // push one level P into 3D P
-      }
-      for (std::size_t i = 0; i < nprofiles; ++i) {
-          for (std::size_t k = 0; k < nlevels; ++k) {
-            // get one vertical profile, rttov level index is from top to bottom
-              tmpvar1d[k] = tmpvar3d[k][i]*0.01;
-          }
-          profiles[i].setP(tmpvar1d);
-      }
-     // release memory of tmpvar3d variable
-      std::vector<std::vector<double>>().swap(tmpvar3d);
-
-    // 3.1.2 Retrieve temperature in K
-      std::vector<std::vector<double>> tmpvar3d_T;  // [nlevels][nprofiles]
-      for (std::size_t i = 0; i < nlevels; ++i) {
-         geovals.getAtLevel(tmpvar2d, "air_temperature", i);  // get one level T
-         tmpvar3d_T.push_back(tmpvar2d);   // push one level T into 3D T
-      }
-      for (std::size_t i = 0; i < nprofiles; ++i) {
-          for (std::size_t k = 0; k < nlevels; ++k) {
-              tmpvar1d[k] = tmpvar3d_T[k][i];
-          }
-          profiles[i].setT(tmpvar1d);
-      }
-      std::vector<std::vector<double>>().swap(tmpvar3d_T);
-
-    // 3.1.3 Retrieve specific humidity in kg/kg
-      std::vector<std::vector<double>> tmpvar3d_Q;  // [nlevels][nprofiles]
-      for (std::size_t i = 0; i < nlevels; ++i) {
-         geovals.getAtLevel(tmpvar2d, "specific_humidity", i);
-         tmpvar3d_Q.push_back(tmpvar2d);
-      }
-      for (std::size_t i = 0; i < nprofiles; ++i) {
-          profiles[i].setGasUnits(rttov::kg_per_kg);
-          for (std::size_t k = 0; k < nlevels; ++k) {
-              tmpvar1d[k] = tmpvar3d_Q[k][i];
-          }
-          profiles[i].setQ(tmpvar1d);
-      }
-      std::vector<std::vector<double>>().swap(tmpvar3d_Q);
+      const GeoVaLsView pres = geovals.view("air_pressure");
+      const GeoVaLsView temp = geovals.view("air_temperature");
+      const GeoVaLsView humid = geovals.view("specific_humidity");
+      ASSERT(pres.nlevs() == nlevels && humid.nlevs() == nlevels);
 
     // 3.2 2D surface fields at obs locations
     //-------------------------------------------
@@ -183,6 +149,7 @@ void rttovcpp_interface(const GeoVaLs & geovals, const ioda::ObsSpace & odb_,
     //-----------------------------------------------
       std::vector<double> satzen(nprofiles, 0.0);  // always needed
       std::vector<double> satazi(nprofiles, 0.0);  // not always needed
+      std::vector<double> sunzen(nprofiles, 0.0);  // not always needed
       std::vector<double> sunazi(nprofiles, 0.0);  // not always needed
       std::vector<double> lat(nprofiles, 0.0);
       std::vector<double> lon(nprofiles, 0.0);
@@ -198,40 +165,49 @@ void rttovcpp_interface(const GeoVaLs & geovals, const ioda::ObsSpace & odb_,
       odb_.get_db("MetaData", "height_above_mean_sea_level", elev);  // in m
       odb_.get_db("MetaData", "dateTime", times);
 
-  // 4. Call rttov set functions
+  // 4. Call rttov set functions; the profiles are independent, so they are set up by
+  //    several threads
   //---------------------------------------------------------------------------------
-      util::DateTime time1;
-      int year, month, day, hour, minute, second;
-      int surftype;
-
-      for (std::size_t i = 0; i < nprofiles; i++) {
-         profiles[i].setGasUnits(rttov::kg_per_kg);
-
-         // convert mpas landmask/xice to rttov surface type
-         // may need to make this more generic for different models
-         if ( landmask[i] == 0 )      surftype=1;  // sea
-         if ( landmask[i] == 1 )      surftype=0;  // land
-         if ( seaice_frac[i] >= 0.5 ) surftype=2;  // sea-ice
-         profiles[i].setSurfGeom(lat[i], lon[i], 0.001*elev[i]);
-
-         time1 = times[i];
-         time1.toYYYYMMDDhhmmss(year, month, day, hour, minute, second);
-         profiles[i].setDateTimes(year, month, day, hour, minute, second);
-
-         // 0:land, 1:sea, 2:sea-ice, (sea, fresh water) temporary
-         profiles[i].setSurfType(surftype, 0);
-
-         // Ps (hPa), t2m (k), q2m (kg/kg), u10/v10 (m/s), wind fetch
-         profiles[i].setS2m(ps[i]*0.01, t2m[i], q2m[i], u10[i], v10[i], 100000.);
-
-         // tskin (k), salinity (35), snow_fraction, foam_fraction, fastem_coef_1-5, specularity
-         // over sea/land
-         profiles[i].setSkin(tskin[i], 35., 0., 0., 3.0, 5.0, 15.0, 0.1, 0.3, 0.);
-         if ( surftype == 2 )  // over seaice, newice(no snow)
-           profiles[i].setSkin(tskin[i], 35., 0., 0., 2.9, 3.4, 27.0, 0.0, 0.0, 0.);
-
-         profiles[i].setAngles(satzen[i], satazi[i], sunzen[i], sunazi[i]);
-      }
+      forEachLocationChunk(nprofiles, rttovcppProfilesPerChunk, true,
+                           [&](std::size_t begin, std::size_t end) {
+        std::vector<double> tmpvar1d(nlevels);  // one single vertical profile
+        int year, month, day, hour, minute, second;
+        for (std::size_t i = begin; i < end; i++) {
+           const double * p = pres.data() + i * nlevels;
+           for (std::size_t k = 0; k < nlevels; ++k) tmpvar1d[k] = p[k] * 0.01;
+           profiles[i].setP(tmpvar1d);
+           const double * t = temp.data() + i * nlevels;
+           profiles[i].setT(std::vector<double>(t, t + nlevels));
+           profiles[i].setGasUnits(rttov::kg_per_kg);
+           const double * q = humid.data() + i * nlevels;
+           profiles[i].setQ(std::vector<double>(q, q + nlevels));
+
+           // convert mpas landmask/xice to rttov surface type
+           // may need to make this more generic for different models
+           int surftype = 1;
+           if ( landmask[i] == 0 )      surftype=1;  // sea
+           if ( landmask[i] == 1 )      surftype=0;  // land
+           if ( seaice_frac[i] >= 0.5 ) surftype=2;  // sea-ice
+           profiles[i].setSurfGeom(lat[i], lon[i], 0.001*elev[i]);
+
+           times[i].toYYYYMMDDhhmmss(year, month, day, hour, minute, second);
+           profiles[i].setDateTimes(year, month, day, hour, minute, second);
+
+           // 0:land, 1:sea, 2:sea-ice, (sea, fresh water) temporary
+           profiles[i].setSurfType(surftype, 0);
+
+           // Ps (hPa), t2m (k), q2m (kg/kg), u10/v10 (m/s), wind fetch
+           profiles[i].setS2m(ps[i]*0.01, t2m[i], q2m[i], u10[i], v10[i], 100000.);
+
+           // tskin (k), salinity (35), snow_fraction, foam_fraction, fastem_coef_1-5,
+           // specularity over sea/land
+           profiles[i].setSkin(tskin[i], 35., 0., 0., 3.0, 5.0, 15.0, 0.1, 0.3, 0.);
+           if ( surftype == 2 )  // over seaice, newice(no snow)
+             profiles[i].setSkin(tskin[i], 35., 0., 0., 2.9, 3.4, 27.0, 0.0, 0.0, 0.);
+
+           profiles[i].setAngles(satzen[i], satazi[i], sunzen[i], sunazi[i]);
+        }
+      });
   }  // end try
   catch (std::exception& e) {
       oops::Log::error() << "Error defining the profile data " << e.what() << std::endl;
@@ -249,18 +225,11 @@ void rttovcpp_interface(const GeoVaLs & geovals, const ioda::ObsSpace & odb_,
   // 5. Set the surface emissivity/reflectance arrays
   //    and associate with the Rttov objects
   //--------------------------------------------------
-  double surfemisrefl[2][nprofiles][nchannels];
-
-  aRttov_.setSurfEmisRefl(reinterpret_cast<double *>(surfemisrefl));
-
 // Surface emissivity/reflectance arrays must be initialised *before every call to RTTOV*
 // Negative values will cause RTTOV to supply emissivity/BRDF values (i.e. equivalent to
 // calcemis/calcrefl TRUE - see RTTOV user guide)
-  for (int i = 0; i < nprofiles; i++) {
-      for (int j = 0; j < 2; j++) {
-          for (int c = 0; c < nchannels; c++) surfemisrefl[j][i][c] = -1.;
-      }
-  }
+  trajectory.surfemisrefl.assign(2 * nprofiles * nchannels, -1.);
+  aRttov_.setSurfEmisRefl(trajectory.surfemisrefl.data());
 
 // 6. Call the RTTOV K model for one instrument for all profiles:
 // no arguments are supplied so all 'loaded' channels are simulated
@@ -272,23 +241,75 @@ void rttovcpp_interface(const GeoVaLs & geovals, const ioda::ObsSpace & odb_,
       oops::Log::error() << "Error running RTTOV K model " << e.what() << std::endl;
   }
 
-// 7. Check if Jacobian has any NaN and set to skip bad profiles
+// 7. Copy the Jacobians into contiguous buffers and check if they have any NaN to skip
+//    bad profiles
 //----------------------------------------------------------------------
-  std::vector<double> var_k(nlevels, 0.0);
+  trajectory.skip_profile.assign(nprofiles, false);
+  trajectory.kT.resize(nprofiles * nchannels * nlevels);
+  trajectory.kQ.resize(nprofiles * nchannels * nlevels);
+
+  forEachLocationChunk(nprofiles, rttovcppProfilesPerChunk, true,
+                       [&](std::size_t begin, std::size_t end) {
+    for (size_t p = begin; p < end; p++) {
+      bool skip = false;
+      for (size_t c = 0; c < nchannels; c++) {
+        const size_t offset = (p * nchannels + c) * nlevels;
+        // T Jacobian for a single profile/channel
+        const std::vector<double> tk = aRttov_.getTK(p, c);
+        // Q Jacobian for a single profile/channel
+        const std::vector<double> qk = aRttov_.getItemK(rttov::Q, p, c);
+        for (size_t l = 0; l < nlevels; ++l) {
+          trajectory.kT[offset + l] = tk[l];
+          trajectory.kQ[offset + l] = qk[l];
+          if (std::isnan(tk[l]) || std::isnan(qk[l])) skip = true;
+        }
+      }
+      trajectory.skip_profile[p] = skip;
+    }
+  });
 
-  for (size_t p = 0; p < nprofiles; p++) skip_profile.push_back(false);
+  oops::Log::trace() << "rttovcpp_interface done" << std::endl;
+}
 
-  for (size_t p = 0; p < nprofiles; p++) {
-    for (size_t c = 0; c < nchannels; c++) {
-      var_k = aRttov_.getTK(p, c);               // T Jacobian for a single profile/channel
-      for (size_t l = 0; l < nlevels; ++l) if (std::isnan(var_k[l])) {skip_profile[p] = true;}
+// -----------------------------------------------------------------------------
 
-      var_k = aRttov_.getItemK(rttov::Q, p, c);  // Q Jacobian for a single profile/channel
-      for (size_t l = 0; l < nlevels; ++l) if (std::isnan(var_k[l])) {skip_profile[p] = true;}
-    }
-  }
+const std::vector<std::string> & rttovcppInputVariables() {
+  // Fields to be requested from getvalues and stored in geovals
+  // need to be consistent with those defined in ufo_variables_mod.F90
+  static const std::vector<std::string> vars{
+    "air_pressure",
+    "air_temperature",
+    "specific_humidity",
+    "surface_pressure",
+    "surface_temperature",   // this is actually var_sfc_t2m
+    "specific_humidity_at_two_meters_above_surface",
+    "uwind_at_10m",
+    "vwind_at_10m",
+    "skin_temperature",
+    "seaice_fraction",
+    "landmask",
+    "surface_geopotential_height"
+  };
+  return vars;
+}
 
-  oops::Log::trace() << "rttovcpp_interface done" << std::endl;
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<RttovCppTrajectory> rttovcppTrajectory(const GeoVaLs & geovals,
+                                                       const ioda::ObsSpace & odb_,
+                                                       const std::string & CoefFileName,
+                                                       const std::vector<int> & channels_,
+                                                       const RttovCppRunOptions & runOptions) {
+  std::string key = "RTTOVCPP " + CoefFileName;
+  for (int channel : channels_)
+    key += " " + std::to_string(channel);
+  return SharedTrajectory<RttovCppTrajectory>::get(
+        odb_, key, geovals, rttovcppInputVariables(),
+        [&]() {
+          auto trajectory = std::make_shared<RttovCppTrajectory>();
+          rttovcpp_interface(geovals, odb_, CoefFileName, channels_, runOptions, *trajectory);
+          return trajectory;
+        });
 }
 
 // -----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #ifndef UFO_OPERATORS_RTTOVCPP_RTTOVCPP_INTERFACE_H_
 #define UFO_OPERATORS_RTTOVCPP_RTTOVCPP_INTERFACE_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -38,10 +39,49 @@ namespace ufo {
 
 namespace ufo {
 
+/// \brief Output of rttovcpp_interface() for a particular set of GeoVaLs.
+struct RttovCppTrajectory {
+  rttov::RttovSafe aRttov = rttov::RttovSafe();
+  std::size_t nlevels = 0;
+  std::size_t nchannels = 0;
+  std::vector<bool> skip_profile;
+  /// Surface emissivity/reflectance used by aRttov, [2][nprofiles][nchannels].
+  std::vector<double> surfemisrefl;
+  /// Jacobians of the brightness temperatures with respect to temperature (kT) and specific
+  /// humidity (kQ), [nprofiles][nchannels][nlevels], copied out of aRttov once so that the TL
+  /// and AD do not need to call RTTOV.
+  std::vector<double> kT;
+  std::vector<double> kQ;
+};
+
+/// \brief Options of the RTTOV parallel interface.
+struct RttovCppRunOptions {
+  /// Number of OpenMP threads used by RTTOV.
+  int nthreads = 1;
+  /// Number of profiles passed to each call made by RTTOV's parallel interface.
+  int nprofsPerCall = 1;
+};
+
+/// \brief Number of profiles handled by each OpenMP task in the loops over profiles.
+constexpr std::size_t rttovcppProfilesPerChunk = 64;
+
 void rttovcpp_interface(const GeoVaLs &, const ioda::ObsSpace & odb_,
-                        rttov::RttovSafe & aRttov_, const std::string CoefFileName,
-                        const std::vector<int> channels_, std::size_t & nlevels,
-                        std::vector<bool> & skip_profile);
+                        const std::string & CoefFileName, const std::vector<int> & channels_,
+                        const RttovCppRunOptions & runOptions, RttovCppTrajectory & trajectory);
+
+/// \brief Names of the GeoVaLs used by rttovcpp_interface().
+const std::vector<std::string> & rttovcppInputVariables();
+
+/// \brief Return the output of rttovcpp_interface() called with the specified arguments.
+///
+/// The RTTOV K model is only run if it has not already been run on exactly the same GeoVaLs for
+/// the same ObsSpace, coefficient file and channels, so the nonlinear and linear operators
+/// share a single run at the start of each outer loop.
+std::shared_ptr<RttovCppTrajectory> rttovcppTrajectory(const GeoVaLs &,
+                                                       const ioda::ObsSpace & odb_,
+                                                       const std::string & CoefFileName,
+                                                       const std::vector<int> & channels_,
+                                                       const RttovCppRunOptions & runOptions);
 
 // -----------------------------------------------------------------------------
 
@@ -24,6 +24,7 @@ namespace ioda {
 }
 
 namespace ufo {
+  class ColumnIntegrator;
   class GeoVaLs;
   class ObsDiagnostics;
 
@@ -42,6 +43,9 @@ namespace ufo {
   * geoval input of pressure needs to be on staggered levels relative to specific
   * humidity so that \f$\|\Delta P|\f$ is at the same height as specific humidity.
   *
+  * The layer weights \f$|\Delta P(k)|/g\f$ are computed by a ColumnIntegrator shared with
+  * the linear operator (SatTCWVTLAD).
+  *
   * \date Sept. 2021: Created by J. Hocking (Met Office)
   */
   // -----------------------------------------------------------------------------
@@ -68,10 +72,20 @@ class SatTCWV : public ObsOperatorBase,
  private:
   void print(std::ostream &) const override;
   std::unique_ptr<const oops::Variables> varin_;  // list of the required geovals
+  const ioda::ObsSpace & odb_;
+  /// Layer weights, kept so that the linear operator can reuse them.
+  mutable std::shared_ptr<const ColumnIntegrator> integrator_;
 };
 
 // -----------------------------------------------------------------------------
 
+/// Return the layer weights used by SatTCWV for \p geovals, computing them only if they are not
+/// held already by another SatTCWV operator for the same GeoVaLs and observations \p odb.
+std::shared_ptr<const ColumnIntegrator> sattcwvIntegrator(const GeoVaLs & geovals,
+                                                          const ioda::ObsSpace & odb);
+
+// -----------------------------------------------------------------------------
+
 }  // namespace ufo
 
 #endif  // UFO_OPERATORS_SATTCWV_SATTCWV_H_
@@ -16,11 +16,11 @@
 
 #include "oops/base/Variables.h"
 #include "oops/util/Logger.h"
-#include "oops/util/missingValues.h"
 
 #include "ufo/GeoVaLs.h"
 #include "ufo/ObsDiagnostics.h"
-#include "ufo/utils/Constants.h"
+#include "ufo/operators/sattcwv/SatTCWV.h"
+#include "ufo/utils/ColumnIntegrator.h"
 
 namespace ufo {
 
@@ -30,7 +30,7 @@ static LinearObsOperatorMaker<SatTCWVTLAD> makerSatTCWVTL_("SatTCWV");
 
 SatTCWVTLAD::SatTCWVTLAD(const ioda::ObsSpace & odb,
                          const Parameters_ & params)
-  : LinearObsOperatorBase(odb), varin_(), k_matrix(), traj_init(false)
+  : LinearObsOperatorBase(odb), varin_()
 {
   const std::vector<std::string> vv{"air_pressure_levels", "specific_humidity",
                                     "surface_pressure"};
@@ -42,58 +42,13 @@ SatTCWVTLAD::SatTCWVTLAD(const ioda::ObsSpace & odb,
 // -----------------------------------------------------------------------------
 
 SatTCWVTLAD::~SatTCWVTLAD() {
-  traj_init = false;
   oops::Log::trace() << "SatTCWVTLAD destructed" << std::endl;
 }
 
 // -----------------------------------------------------------------------------
 
 void SatTCWVTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics &) {
-  // Get number of obs locations & number of model pressure levels
-  nprofiles = geovals.nlocs();
-  nlevels   = geovals.nlevs("air_pressure_levels");  // number of full (rho) levels
-
-  // (Re)initialise the Jacobian matrix
-  if (!k_matrix.empty()) k_matrix.clear();
-  k_matrix.resize(nlevels-1, std::vector<double>(nprofiles));
-
-  // Get 2-D surface pressure
-  std::vector<float> ps(nprofiles);  // surface pressure (Pa)
-  geovals.get(ps, "surface_pressure");
-
-  // Get 3-D air pressure on rho levels (Pa), one level at a time
-  std::vector<std::vector<float>> plev(nlevels, std::vector<float>(nprofiles));
-  for (std::size_t lev = 0; lev < nlevels; ++lev) {
-    geovals.getAtLevel(plev[lev], "air_pressure_levels", lev);
-  }
-
-  // Get 3-D specific humidity on theta levels (kg/kg), one level at a time
-  std::vector<std::vector<float>> q(nlevels-1, std::vector<float>(nprofiles));
-  for (std::size_t lev = 0; lev < nlevels-1; ++lev) {
-    geovals.getAtLevel(q[lev], "specific_humidity", lev);
-  }
-
-  // Check model fields are top-down
-  if (plev.front() > plev.back()) {
-    // Bottom-up: fail as JEDI should be top-down
-    throw eckit::BadValue("model fields must be ordered from the top down", Here());
-  }
-
-  // Calculate partial derivatives d(TCWV)/d(q) for each profile element
-
-  // Loop over profiles
-
-  for (size_t prof = 0; prof < nprofiles; ++prof) {
-    k_matrix[nlevels - 2][prof] = (ps[prof] - plev[nlevels - 2][prof]) /
-                                    Constants::grav;
-
-    // Loop over the rest of the model layers
-    for (size_t lev = 0; lev < nlevels - 2; ++lev) {
-      k_matrix[lev][prof] = (plev[lev+1][prof] - plev[lev][prof]) /
-                            Constants::grav;
-    }
-  }
-  traj_init = true;
+  k_matrix_ = sattcwvIntegrator(geovals, obsspace());
 }
 
 // -----------------------------------------------------------------------------
@@ -101,28 +56,17 @@ void SatTCWVTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics &) {
 void SatTCWVTLAD::simulateObsTL(
         const GeoVaLs & geovals, ioda::ObsVector & hofx) const {
   // Ensure trajectory has already been calculated
-  ASSERT(traj_init);
+  ASSERT(k_matrix_);
 
   // Check dimensions against trajectory
-  ASSERT(geovals.nlocs() == nprofiles);
-  ASSERT(geovals.nlevs("air_pressure_levels") == nlevels);
+  ASSERT(geovals.nlocs() == k_matrix_->nlocs());
+  ASSERT(geovals.nlevs("air_pressure_levels") == k_matrix_->nlayers() + 1);
 
-  // Check hofx size and initialise hofx to zero
+  // Check hofx size
   ASSERT(geovals.nlocs() == hofx.nlocs());
-  hofx.zero();
-
-  // Get 3-D specific humidity increments on theta levels (kg/kg), one level at a time
-  std::vector<std::vector<double>> q_d(nlevels-1, std::vector<double>(nprofiles));
-  for (std::size_t lev = 0; lev < nlevels-1; ++lev) {
-    geovals.getAtLevel(q_d[lev], "specific_humidity", lev);
-  }
-
-  // Loop through the obs, calculating the increment to the observation hofx
-  for (size_t prof = 0; prof < nprofiles; ++prof) {
-    for (size_t lev = 0; lev < nlevels-1; ++lev) {
-      hofx[prof] += k_matrix[lev][prof] * q_d[lev][prof];
-    }
-  }
+
+  // Calculate the increment to the observation hofx
+  k_matrix_->integrate(geovals, "specific_humidity", hofx);
 }
 
 // -----------------------------------------------------------------------------
@@ -130,37 +74,17 @@ void SatTCWVTLAD::simulateObsTL(
 void SatTCWVTLAD::simulateObsAD(
         GeoVaLs & geovals, const ioda::ObsVector & hofx) const {
   // Ensure trajectory has already been calculated
-  ASSERT(traj_init);
+  ASSERT(k_matrix_);
 
   // Check dimensions against trajectory
-  ASSERT(geovals.nlocs() == nprofiles);
-  ASSERT(geovals.nlevs("air_pressure_levels") == nlevels);
+  ASSERT(geovals.nlocs() == k_matrix_->nlocs());
+  ASSERT(geovals.nlevs("air_pressure_levels") == k_matrix_->nlayers() + 1);
 
   // Check hofx size
   ASSERT(geovals.nlocs() == hofx.nlocs());
 
-  // Get 3-D specific humidity increments on theta levels (kg/kg), one level at a time
-  std::vector<std::vector<double>> q_d(nlevels-1, std::vector<double>(nprofiles));
-  for (std::size_t lev = 0; lev < nlevels-1; ++lev) {
-    geovals.getAtLevel(q_d[lev], "specific_humidity", lev);
-  }
-
-  // Get the missing value indicator
-  const double missing = util::missingValue(missing);
-
-  // Loop through the obs, adding the increment to the model state
-  for (size_t prof = 0; prof < nprofiles; ++prof) {
-    if (hofx[prof] != missing) {
-      for (size_t lev = 0; lev < nlevels-1; ++lev) {
-        q_d[lev][prof] += k_matrix[lev][prof] * hofx[prof];
-      }
-    }
-  }
-
-  // Store the updated model state increments
-  for (std::size_t lev = 0; lev < nlevels-1; ++lev) {
-    geovals.putAtLevel(q_d[lev], "specific_humidity", lev);
-  }
+  // Add the increment to the model state, skipping missing obs
+  k_matrix_->integrateAD(hofx, geovals, "specific_humidity");
 }
 
 // -----------------------------------------------------------------------------
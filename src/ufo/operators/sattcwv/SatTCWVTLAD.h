@@ -25,6 +25,7 @@ namespace ioda {
 }
 
 namespace ufo {
+  class ColumnIntegrator;
   class GeoVaLs;
   class ObsDiagnostics;
 
@@ -48,7 +49,8 @@ class SatTCWVTLAD : public LinearObsOperatorBase,
   *
   * \details This is based on Roger Saunders' Fortran original "sattcwv" 
   * observation operator code. This method must be called before calling the TL/AD
-  * methods.
+  * methods. The Jacobian (the layer weights) computed by the nonlinear operator for
+  * the same GeoVaLs is reused if available.
   *
   * \date Sept. 2021: Created by J. Hocking (Met Office)
   */
@@ -86,10 +88,8 @@ class SatTCWVTLAD : public LinearObsOperatorBase,
   void print(std::ostream &) const override;
   std::unique_ptr<const oops::Variables> varin_;
 
-  std::vector<std::vector<double>> k_matrix;
-  bool traj_init;
-  size_t nlevels;
-  size_t nprofiles;
+  /// Layer weights d(TCWV)/d(q); null until setTrajectory() is called.
+  std::shared_ptr<const ColumnIntegrator> k_matrix_;
 };
 
 // -----------------------------------------------------------------------------
@@ -37,7 +37,7 @@ ObsTimeOper::ObsTimeOper(const ioda::ObsSpace & odb,
                       odb,
                       oops::validateAndDeserialize<ObsOperatorParametersWrapper>(
                         parameters.obsOperator.value()).operatorParameters)),
-    odb_(odb), timeWeights_(timeWeightCreate(odb, parameters))
+    odb_(odb), timeWeights_(sharedTimeWeights(odb, parameters))
 {
   oops::Log::trace() << "ObsTimeOper creating" << std::endl;
 
@@ -66,8 +66,8 @@ std::unique_ptr<Locations> ObsTimeOper::locations() const {
   oops::Log::trace() << "entered ObsOperatorTime::locations" << std::endl;
 
   std::unique_ptr<Locations> locs = actualoperator_->locations();
-  // concatenate locations with itself (double the size)
-  *locs += *locs;
+  // list the locations once per time slot
+  locs->repeat(timeWeights_->nslots);
 
   return locs;
 }
@@ -81,16 +81,10 @@ void ObsTimeOper::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
   oops::Log::trace() << gv <<  std::endl;
 
   GeoVaLs gv1(odb_.distribution(), gv.getVars());
-  GeoVaLs gv2(odb_.distribution(), gv.getVars());
-
-  gv.split(gv1, gv2);
+  gv.timeSlotsWeightedSum(gv1, timeWeights_->weights, timeWeights_->nslots);
 
   oops::Log::trace() << gv1 << std::endl;
-  oops::Log::trace() << gv2 << std::endl;
 
-  gv1 *= timeWeights_[0];
-  gv2 *= timeWeights_[1];
-  gv1 += gv2;
   actualoperator_->simulateObs(gv1, ovec, ydiags);
 
   oops::Log::trace() << "ObsTimeOper: simulateObs exit " <<  std::endl;
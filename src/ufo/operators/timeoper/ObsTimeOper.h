@@ -17,6 +17,7 @@
 
 #include "ufo/ObsOperatorBase.h"
 #include "ufo/operators/timeoper/ObsTimeOperParameters.h"
+#include "ufo/operators/timeoper/ObsTimeOperUtil.h"
 
 /// Forward declarations
 namespace oops {
@@ -58,7 +59,7 @@ class ObsTimeOper : public ObsOperatorBase,
   void print(std::ostream &) const override;
   std::unique_ptr<ObsOperatorBase> actualoperator_;
   const ioda::ObsSpace& odb_;
-  std::vector<std::vector<float>> timeWeights_;
+  std::shared_ptr<const TimeSlotWeights> timeWeights_;
 };
 
 // -----------------------------------------------------------------------------
@@ -35,7 +35,7 @@ ObsTimeOperTLAD::ObsTimeOperTLAD(const ioda::ObsSpace & odb,
                       odb,
                       oops::validateAndDeserialize<LinearObsOperatorParametersWrapper>(
                         parameters.obsOperator.value()).operatorParameters)),
-    timeWeights_(timeWeightCreate(odb, parameters))
+    timeWeights_(sharedTimeWeights(odb, parameters))
 {
   oops::Log::trace() << "ObsTimeOperTLAD created" << std::endl;
 }
@@ -56,18 +56,7 @@ void ObsTimeOperTLAD::setTrajectory(const GeoVaLs & geovals,
                      << geovals << std::endl;
 
   GeoVaLs gv1(obsspace().distribution(), geovals.getVars());
-  GeoVaLs gv2(obsspace().distribution(), geovals.getVars());
-  geovals.split(gv1, gv2);
-
-  oops::Log::debug() << "ObsTimeOperTLAD::setTrajectory split geovals gv1 "
-                     << gv1 << std::endl;
-
-  oops::Log::debug() << "ObsTimeOperTLAD::setTrajectory split geovals gv2 "
-                     << gv2 << std::endl;
-
-  gv1 *= timeWeights_[0];
-  gv2 *= timeWeights_[1];
-  gv1 += gv2;
+  geovals.timeSlotsWeightedSum(gv1, timeWeights_->weights, timeWeights_->nslots);
 
   oops::Log::debug() << "ObsTimeOperTLAD::setTrajectory final geovals gv1 "
                      << gv1 << std::endl;
@@ -88,18 +77,7 @@ void ObsTimeOperTLAD::simulateObsTL(const GeoVaLs & geovals, ioda::ObsVector & o
                      << geovals << std::endl;
 
   GeoVaLs gv1(obsspace().distribution(), geovals.getVars());
-  GeoVaLs gv2(obsspace().distribution(), geovals.getVars());
-  geovals.split(gv1, gv2);
-
-  oops::Log::debug() << "ObsTimeOperTLAD::simulateObsTL split geovals gv1 "
-                     << gv1 << std::endl;
-
-  oops::Log::debug() << "ObsTimeOperTLAD::simulateObsTL split geovals gv2 "
-                     << gv2 << std::endl;
-
-  gv1 *= timeWeights_[0];
-  gv2 *= timeWeights_[1];
-  gv1 += gv2;
+  geovals.timeSlotsWeightedSum(gv1, timeWeights_->weights, timeWeights_->nslots);
 
   oops::Log::debug() << "ObsTimeOperTLAD::simulateObsTL final geovals gv1 "
                      << gv1 << std::endl;
@@ -129,11 +107,7 @@ void ObsTimeOperTLAD::simulateObsAD(GeoVaLs & geovals, const ioda::ObsVector & o
 
   actualoperator_->simulateObsAD(gv1, ovec);
 
-  gv2 = gv1;
-  gv1 *= timeWeights_[0];
-  gv2 *= timeWeights_[1];
-
-  geovals.merge(gv1, gv2);
+  geovals.timeSlotsWeightedMerge(gv1, timeWeights_->weights, timeWeights_->nslots);
 
   oops::Log::debug() << "ObsTimeOperTLAD::simulateObsAD final geovals "
                      << geovals << std::endl;
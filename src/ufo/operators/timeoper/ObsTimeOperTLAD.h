@@ -54,7 +54,7 @@ class ObsTimeOperTLAD : public LinearObsOperatorBase,
  private:
   void print(std::ostream &) const override;
   std::unique_ptr<LinearObsOperatorBase> actualoperator_;
-  std::vector<std::vector<float>> timeWeights_;
+  std::shared_ptr<const TimeSlotWeights> timeWeights_;
 };
 
 // -----------------------------------------------------------------------------
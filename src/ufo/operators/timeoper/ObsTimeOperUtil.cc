@@ -7,8 +7,12 @@
 
 
 #include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ioda/ObsVector.h"
@@ -18,13 +22,14 @@
 #include "oops/util/Logger.h"
 #include "ufo/operators/timeoper/ObsTimeOperParameters.h"
 #include "ufo/operators/timeoper/ObsTimeOperUtil.h"
+#include "ufo/utils/LogUtils.h"
 
 namespace ufo {
 
 
 //--------------------------------------------------------------------------------------------------
-std::vector<std::vector<float>> timeWeightCreate(const ioda::ObsSpace & odb_,
-                                    const ObsTimeOperParameters & parameters) {
+TimeSlotWeights timeWeightCreate(const ioda::ObsSpace & odb_,
+                                 const ObsTimeOperParameters & parameters) {
   util::DateTime windowBegin(odb_.windowStart());
   const util::Duration windowSub = parameters.windowSub.value();
   int64_t windowSubSec = windowSub.toSeconds();
@@ -38,7 +43,9 @@ std::vector<std::vector<float>> timeWeightCreate(const ioda::ObsSpace & odb_,
   std::vector<util::DateTime> dateTimeIn(nlocs);
   odb_.get_db("MetaData", "dateTime", dateTimeIn);
 
-  oops::Log::debug() << "dateTime =  " << dateTimeIn[0].toString() << std::endl;
+  const bool debug = isLogChannelEnabled(oops::Log::debug());
+  if (debug && nlocs > 0)
+    oops::Log::debug() << "dateTime =  " << dateTimeIn[0].toString() << std::endl;
 
   for (std::size_t i = 0; i < nlocs; ++i) {
     util::Duration timeFromStart = dateTimeIn[i] - windowBegin;
@@ -52,34 +59,63 @@ std::vector<std::vector<float>> timeWeightCreate(const ioda::ObsSpace & odb_,
                                                        StateTimeFromStartSec)/
                                          static_cast<float>(windowSubSec);
     }
-    oops::Log::debug() << " timeFromStartSec = " << timeFromStartSec
-                       << " windowSubSec = " << windowSubSec
-                       << " StateTimeFromStartSec = " << StateTimeFromStartSec
-                       << std::endl;
+    if (debug)
+      oops::Log::debug() << " timeFromStartSec = " << timeFromStartSec
+                         << " windowSubSec = " << windowSubSec
+                         << " StateTimeFromStartSec = " << StateTimeFromStartSec
+                         << std::endl;
   }
-  for (std::size_t i=0; i < TimeWeightObsAfterState.size(); ++i) {
-    oops::Log::debug() << "timeweights [" << i << "] = "
-                       << TimeWeightObsAfterState[i] << std::endl;
+  if (debug) {
+    for (std::size_t i=0; i < TimeWeightObsAfterState.size(); ++i) {
+      oops::Log::debug() << "timeweights [" << i << "] = "
+                         << TimeWeightObsAfterState[i] << std::endl;
+    }
   }
 
-  std::vector<float> TimeWeightObsBeforeState(nlocs, 0.0);
-  transform(TimeWeightObsAfterState.cbegin(), TimeWeightObsAfterState.cend(),
-            TimeWeightObsBeforeState.begin(),
-            [] (float element) {return 1.0f - element;});
-
-  std::vector<std::vector<float>> timeWeights;
-  timeWeights.push_back(TimeWeightObsAfterState);
-  timeWeights.push_back(TimeWeightObsBeforeState);
-
-  for (auto i : timeWeights[0]) {
-    oops::Log::debug() << "TimeOperUtil::timeWeights[0] = " << i << std::endl;
-  }
-  for (auto i : timeWeights[1]) {
-    oops::Log::debug() << "TimeOperUtil::timeWeights[1] = " << i << std::endl;
+  // the weights of the state before each observation follow those of the state after it
+  TimeSlotWeights timeWeights;
+  timeWeights.nslots = 2;
+  timeWeights.weights = std::move(TimeWeightObsAfterState);
+  timeWeights.weights.resize(2 * nlocs);
+  std::transform(timeWeights.weights.cbegin(), timeWeights.weights.cbegin() + nlocs,
+                 timeWeights.weights.begin() + nlocs,
+                 [] (float element) {return 1.0f - element;});
+
+  if (debug) {
+    for (std::size_t i = 0; i < timeWeights.weights.size(); ++i) {
+      oops::Log::debug() << "TimeOperUtil::timeWeights[" << i / nlocs << "] = "
+                         << timeWeights.weights[i] << std::endl;
+    }
   }
 
   return timeWeights;
 }
 // -----------------------------------------------------------------------------
+std::shared_ptr<const TimeSlotWeights> sharedTimeWeights(
+    const ioda::ObsSpace & odb, const ObsTimeOperParameters & parameters) {
+  typedef std::pair<const ioda::ObsSpace *, int64_t> Key;
+  static std::mutex mutex;
+  static std::map<Key, std::weak_ptr<const TimeSlotWeights>> cache;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  // Forget weights no longer used by any operator.
+  for (auto it = cache.begin(); it != cache.end(); ) {
+    if (it->second.expired())
+      it = cache.erase(it);
+    else
+      ++it;
+  }
+
+  std::weak_ptr<const TimeSlotWeights> & weakWeights =
+      cache[Key(&odb, parameters.windowSub.value().toSeconds())];
+  std::shared_ptr<const TimeSlotWeights> weights = weakWeights.lock();
+  if (!weights) {
+    weights = std::make_shared<const TimeSlotWeights>(
+          timeWeightCreate(odb, parameters));
+    weakWeights = weights;
+  }
+  return weights;
+}
+// -----------------------------------------------------------------------------
 
 }  // namespace ufo
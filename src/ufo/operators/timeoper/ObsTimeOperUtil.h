@@ -10,6 +10,7 @@
 #define UFO_OPERATORS_TIMEOPER_OBSTIMEOPERUTIL_H_
 
 #include <algorithm>
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -23,8 +24,29 @@ namespace ufo {
 
 class ObsTimeOperParameters;
 
-std::vector<std::vector<float>> timeWeightCreate(const ioda::ObsSpace & odb_,
-                                                 const ObsTimeOperParameters & parameters);
+/// \brief Weights with which the GeoVaLs of the model time slots bracketing each observation
+/// are combined.
+///
+/// The weight of time slot \c jslot at location \c jloc is stored in element
+/// jslot * nlocs + jloc of \c weights, matching the layout of the GeoVaLs expected by
+/// GeoVaLs::timeSlotsWeightedSum(), in which the locations are repeated once per time slot.
+struct TimeSlotWeights {
+  size_t nslots = 0;
+  std::vector<float> weights;
+};
+
+/// \brief Compute the weights of the two time slots (at the start and the end of the
+/// sub-window containing each observation) used for linear interpolation in time.
+TimeSlotWeights timeWeightCreate(const ioda::ObsSpace & odb_,
+                                 const ObsTimeOperParameters & parameters);
+
+/// \brief Return the weights produced by timeWeightCreate() for \p odb and \p parameters.
+///
+/// The weights are computed the first time they are requested and then shared by all the
+/// nonlinear and linear time interpolation operators acting on \p odb with the same sub-window
+/// length, for as long as any of them exists.
+std::shared_ptr<const TimeSlotWeights> sharedTimeWeights(
+    const ioda::ObsSpace & odb, const ObsTimeOperParameters & parameters);
 
 // -----------------------------------------------------------------------------
 
@@ -41,8 +41,10 @@ void CosineOfLatitudeTimesOrbitNode::compute(const ioda::ObsSpace & odb,
   odb.get_db("MetaData", "sensor_azimuth_angle", node);
 
   for (std::size_t jloc = 0; jloc < nlocs; ++jloc) {
+    // the same for all channels
+    const double value = node[jloc] * cos(cenlat[jloc] * Constants::deg2rad);
     for (std::size_t jvar = 0; jvar < nvars; ++jvar) {
-      out[jloc*nvars+jvar] = node[jloc] * cos(cenlat[jloc] * Constants::deg2rad);
+      out[jloc*nvars+jvar] = value;
     }
   }
 }
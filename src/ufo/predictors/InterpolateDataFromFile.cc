@@ -76,6 +76,9 @@ InterpolateDataFromFile::InterpolateDataFromFile(const Parameters_ & parameters,
     const ufo::Variables &requiredVariables = obsFunction.requiredVariables();
     geovars_ += requiredVariables.allFromGroup("GeoVaLs").toOopsVariables();
     hdiags_ += requiredVariables.allFromGroup("ObsDiag").toOopsVariables();
+    for (size_t i = 0; i < requiredVariables.size(); ++i)
+      if (requiredVariables[i].group() != "MetaData")
+        dependsOnTrajectory_ = true;
   }
 }
 
@@ -83,7 +83,12 @@ class InterpolateDataFromFile : public PredictorBase {
                const ObsDiagnostics &, const ObsBias &,
                ioda::ObsVector &) const override;
 
+  bool dependsOnTrajectory() const override {return dependsOnTrajectory_;}
+
  private:
+  /// True if any of the ObsFunctions uses variables other than observation metadata.
+  bool dependsOnTrajectory_ = false;
+
   /// `obsFunctions_[varName]` is the ObsFunction that will calculate the predictions for variable
   /// `varName`.
   // The map is storing unique_ptrs to make it possible to compile this code with GCC 4.8.5,
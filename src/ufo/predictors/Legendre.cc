@@ -5,6 +5,7 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <cmath>
 #include <string>
 #include <vector>
 
@@ -42,26 +43,34 @@ void Legendre::compute(const ioda::ObsSpace & odb,
 
   // retrieve the sensor scan position and total number of scan positions (const for inst type)
   std::vector<int> scan_position(nlocs, 0);
-  std::vector<double> LegPoly(order_+1, 0);
-
   odb.get_db("MetaData", "scan_position", scan_position);
+
+  // Transformed variable for the scan position in the range -1 to 1.
+  std::vector<double> xscan(nlocs);
+  for (std::size_t jl = 0; jl < nlocs; ++jl)
+    xscan[jl] = -1.0 + 2.0 * (scan_position[jl] - 1) / (nscan_ - 1);
+
+  // Calculate the Legendre polynomial of the required order at all scan positions, applying
+  // the recurrence relation to all locations at once. It does not depend on the channel.
+  std::vector<double> prevPoly(nlocs, 1.0);
+  std::vector<double> legPoly(order_ > 0 ? xscan : prevPoly);
+  for (int iorder = 1; iorder < order_; ++iorder) {
+    double * p = legPoly.data();
+    double * q = prevPoly.data();
+    for (std::size_t jl = 0; jl < nlocs; ++jl) {
+      const double next = ((2*iorder+1)*xscan[jl]*p[jl] - iorder*q[jl])/(iorder+1);
+      q[jl] = p[jl];
+      p[jl] = next;
+    }
+  }
+
+  // Broadcast the normalised polynomial to all channels
+  const double norm = std::sqrt(2*order_+1);
   const std::size_t nvars = vars_.size();
   for (std::size_t jl = 0; jl < nlocs; ++jl) {
-    double xscan{-1.0 + 2.0 * (scan_position[jl] - 1) / (nscan_ - 1)};
-    // Transformed variable for the scan position in the range -1 to 1.
-    // Calculate Legendre Polynomial for current scan position
-    LegPoly[0] = 1.0;
-    LegPoly[1] = xscan;
-    for (std::size_t iorder=1; iorder < order_; ++iorder) {
-        LegPoly[iorder+1] = ((2*iorder+1)*xscan*LegPoly[iorder]
-        -iorder*LegPoly[iorder-1])/(iorder+1);
-    }
-    for (std::size_t iorder=0; iorder < order_+1; ++iorder) {
-        LegPoly[iorder] = sqrt(2*iorder+1)*LegPoly[iorder];
-    }
-    for (std::size_t jb = 0; jb < nvars; ++jb) {
-        out[jl*nvars+jb] = LegPoly[order_];
-    }
+    const double value = norm * legPoly[jl];
+    for (std::size_t jb = 0; jb < nvars; ++jb)
+      out[jl*nvars+jb] = value;
   }
 }
 
@@ -48,25 +48,25 @@ void OrbitalAngle::compute(const ioda::ObsSpace & odb,
   std::vector<double> orbital_angle(nlocs, 0.0);
   odb.get_db("MetaData", "satellite_orbital_angle", orbital_angle);
 
+  // the Fourier term does not depend on the channel: evaluate it once per location
+  std::vector<double> term(nlocs);
   switch (component_)
   {
     case FourierTermType::COS:
-      for (std::size_t jl = 0; jl < nlocs; ++jl) {
-        double cos_oa{ std::cos(orbital_angle[jl]*order_*Constants::deg2rad)};
-        for (std::size_t jb = 0; jb < nvars; ++jb) {
-          out[jl*nvars+jb] = cos_oa;
-        }
-      }
+      for (std::size_t jl = 0; jl < nlocs; ++jl)
+        term[jl] = std::cos(orbital_angle[jl]*order_*Constants::deg2rad);
       break;
     case FourierTermType::SIN:
-      for (std::size_t jl = 0; jl < nlocs; ++jl) {
-        double sin_oa{ std::sin(orbital_angle[jl]*order_*Constants::deg2rad)};
-        for (std::size_t jb = 0; jb < nvars; ++jb) {
-          out[jl*nvars+jb] = sin_oa;
-        }
-      }
+      for (std::size_t jl = 0; jl < nlocs; ++jl)
+        term[jl] = std::sin(orbital_angle[jl]*order_*Constants::deg2rad);
       break;
   }
+
+  for (std::size_t jl = 0; jl < nlocs; ++jl) {
+    for (std::size_t jb = 0; jb < nvars; ++jb) {
+      out[jl*nvars+jb] = term[jl];
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -11,6 +11,9 @@
 
 #include "eckit/config/LocalConfiguration.h"
 
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+
 #include "oops/util/abor1_cpp.h"
 #include "oops/util/Logger.h"
 
@@ -26,6 +29,31 @@ PredictorBase::PredictorBase(const PredictorParametersBase & parameters,
 
 // -----------------------------------------------------------------------------
 
+PredictorBase::~PredictorBase() = default;
+
+// -----------------------------------------------------------------------------
+
+void PredictorBase::computeOrReuse(const ioda::ObsSpace & odb,
+                                   const GeoVaLs & geovals,
+                                   const ObsDiagnostics & ydiags,
+                                   const ObsBias & bias,
+                                   ioda::ObsVector & out) const {
+  if (dependsOnTrajectory()) {
+    this->compute(odb, geovals, ydiags, bias, out);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(cacheMutex_);
+  if (cache_ && &cache_->space() == &odb && cache_->nvars() == out.nvars()) {
+    out = *cache_;
+  } else {
+    this->compute(odb, geovals, ydiags, bias, out);
+    cache_.reset(new ioda::ObsVector(out));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 PredictorFactory::PredictorFactory(const std::string & name) {
   if (predictorExists(name)) {
     oops::Log::error() << name << " already registered in ufo::PredictorFactory."
@@ -12,6 +12,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -63,7 +64,7 @@ class EmptyPredictorParameters : public PredictorParametersBase {
 class PredictorBase : private boost::noncopyable {
  public:
   explicit PredictorBase(const PredictorParametersBase &, const oops::Variables &);
-  virtual ~PredictorBase() = default;
+  virtual ~PredictorBase();
 
   /// compute the predictor
   virtual void compute(const ioda::ObsSpace &,
@@ -72,6 +73,25 @@ class PredictorBase : private boost::noncopyable {
                        const ObsBias &,
                        ioda::ObsVector &) const = 0;
 
+  /// \brief Compute the predictor, reusing the values computed by a previous call if they cannot
+  /// have changed since.
+  ///
+  /// Predictors that do not depend on the trajectory are computed only once per ObsSpace; their
+  /// values are cached and copied into \p out by subsequent calls. Trajectory-dependent
+  /// predictors are recomputed on each call.
+  void computeOrReuse(const ioda::ObsSpace &,
+                      const GeoVaLs &,
+                      const ObsDiagnostics &,
+                      const ObsBias &,
+                      ioda::ObsVector &) const;
+
+  /// \brief Return true if the predictor values may depend on the trajectory (the GeoVaLs and
+  /// ObsDiagnostics passed to compute()) and false if they depend only on quantities, such as
+  /// observation metadata, that do not change between outer loops.
+  ///
+  /// By default, predictors requiring any GeoVaLs or ObsDiagnostics depend on the trajectory.
+  virtual bool dependsOnTrajectory() const {return geovars_.size() > 0 || hdiags_.size() > 0;}
+
   /// geovars names required to compute the predictor
   const oops::Variables & requiredGeovars() const {return geovars_;}
 
@@ -89,6 +109,10 @@ class PredictorBase : private boost::noncopyable {
 
  private:
   std::string func_name_;        ///<  predictor name
+
+  /// Values of a trajectory-independent predictor computed by the first call to computeOrReuse()
+  mutable std::unique_ptr<ioda::ObsVector> cache_;
+  mutable std::mutex cacheMutex_;
 };
 
 typedef std::vector<std::shared_ptr<PredictorBase>> Predictors;
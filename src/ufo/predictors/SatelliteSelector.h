@@ -68,6 +68,8 @@ class SatelliteSelector : public PredictorBase {
                const ObsBias &,
                ioda::ObsVector &) const override;
 
+  bool dependsOnTrajectory() const override {return predictor_->dependsOnTrajectory();}
+
  private:
   /// The local predictor specified from yaml
   std::unique_ptr<PredictorBase> predictor_;
@@ -46,8 +46,10 @@ void ScanAngle::compute(const ioda::ObsSpace & odb,
   odb.get_db("MetaData", var_name_, view_angle);
 
   for (std::size_t jloc = 0; jloc < nlocs; ++jloc) {
+    // the same for all channels
+    const double value = pow(view_angle[jloc] * Constants::deg2rad, order_);
     for (std::size_t jvar = 0; jvar < nvars; ++jvar) {
-      out[jloc*nvars+jvar] = pow(view_angle[jloc] * Constants::deg2rad, order_);
+      out[jloc*nvars+jvar] = value;
     }
   }
 }
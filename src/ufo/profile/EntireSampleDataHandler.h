@@ -30,6 +30,7 @@
 #include "ufo/filters/Variable.h"
 
 #include "ufo/profile/DataHandlerParameters.h"
+#include "ufo/profile/ProfileVariableHandle.h"
 
 #include "ufo/utils/metoffice/MetOfficeQCFlags.h"
 #include "ufo/utils/StringUtils.h"
@@ -60,14 +61,6 @@ namespace ufo {
     template <typename T>
       std::vector<T>& get(const std::string &fullname)
       {
-        // Determine variable and group names, optional, and number of entries per profile.
-        std::string varname;
-        std::string groupname;
-        ufo::splitVarGroup(fullname, varname, groupname);
-        const bool optional = options_.getOptional(groupname);
-        const size_t entriesPerProfile = options_.getEntriesPerProfile(groupname);
-
-        std::vector <T> vec_all;  // Vector storing data for entire sample.
         auto it_entireSampleData = entireSampleData_.find(fullname);
         if (it_entireSampleData != entireSampleData_.end()) {
           // If the vector is already present, return it.
@@ -79,7 +72,17 @@ namespace ufo {
             throw eckit::BadParameter("Template parameter passed to boost::get for " +
                                       fullname + " probably has the wrong type", Here());
           }
-        } else if (data_.has(Variable(fullname)) || optional) {
+        }
+
+        // Determine variable and group names, optional, and number of entries per profile.
+        std::string varname;
+        std::string groupname;
+        ufo::splitVarGroup(fullname, varname, groupname);
+        const bool optional = options_.getOptional(groupname);
+        const size_t entriesPerProfile = options_.getEntriesPerProfile(groupname);
+
+        std::vector <T> vec_all;  // Vector storing data for entire sample.
+        if (data_.has(Variable(fullname)) || optional) {
           // Initially fill the vector with the default value for the type T.
           if (entriesPerProfile == 0) {
             vec_all.assign(obsdb_.nlocs(), defaultValue(vec_all, groupname));
@@ -97,8 +100,26 @@ namespace ufo {
         }
 
         // Add vector to map.
-        entireSampleData_.emplace(fullname, std::move(vec_all));
-        return boost::get<std::vector<T>> (entireSampleData_[fullname]);
+        it_entireSampleData = entireSampleData_.emplace(fullname, std::move(vec_all)).first;
+        return boost::get<std::vector<T>> (it_entireSampleData->second);
+      }
+
+    /// Retrieve a vector containing the variable referred to by \p handle for the entire
+    /// data sample. This behaves in the same way as the function that takes the name of the
+    /// variable, but the location of the vector is cached the first time it is requested.
+    template <typename T>
+      std::vector<T>& get(const ProfileVariableHandle<T> &handle)
+      {
+        const size_t id = handle.id();
+        if (id < dataVectorsById_.size() && dataVectorsById_[id] != nullptr)
+          return boost::get<std::vector<T>> (*dataVectorsById_[id]);
+        std::vector<T> &vec_all = get<T>(handle.fullname());
+        if (id >= dataVectorsById_.size())
+          dataVectorsById_.resize(id + 1, nullptr);
+        // Elements of an unordered_map are not moved when elements are added, so the address
+        // remains valid.
+        dataVectorsById_[id] = &entireSampleData_.find(handle.fullname())->second;
+        return vec_all;
       }
 
     /// Write various quantities to the obsdb so they can be used in future QC checks.
@@ -167,12 +188,18 @@ namespace ufo {
     /// Default value used to fill vector of booleans.
     bool defaultValue(const std::vector <bool> &vec, const std::string &groupname);
 
+    /// Vector of values of one variable.
+    typedef boost::variant <std::vector <int>,
+                            std::vector <float>,
+                            std::vector <std::string>,
+                            std::vector <bool>> DataVector;
+
     /// Container of each variable in the entire data set.
-    std::unordered_map <std::string, boost::variant
-                        <std::vector <int>,
-                         std::vector <float>,
-                         std::vector <std::string>,
-                         std::vector <bool>>> entireSampleData_;
+    std::unordered_map <std::string, DataVector> entireSampleData_;
+
+    /// Elements of entireSampleData_ indexed by the identifiers of the variables
+    /// (see ProfileVariableHandle). Null if the variable has not been requested with a handle.
+    std::vector <DataVector*> dataVectorsById_;
 
     /// Missing value (int)
     const int missingValueInt = util::missingValue(missingValueInt);
@@ -49,51 +49,17 @@ void ObsProfileAverage::simulateObs(const GeoVaLs & gv, ioda::ObsVector & ovec,
   // Cache the input GeoVaLs for use in the slant path location algorithm.
   data_.cacheGeoVaLs(gv);
 
-  // Get correspondence between record numbers and indices in the total sample.
-  const std::vector<std::size_t> &recnums = odb_.recidx_all_recnums();
-
-  // Number of profiles in the original ObsSpace.
-  const std::size_t nprofs = recnums.size() / 2;
-
-  // Loop over profiles.
-  for (std::size_t jprof = 0; jprof < nprofs; ++jprof) {
-    oops::Log::debug() << "Profile " << (jprof + 1) << " / " << nprofs << std::endl;
-
-    // Get locations of profile in the original ObsSpace and
-    // the corresponding profile in the extended ObsSpace.
-    // Assuming the extended ObsSpace has been configured correctly, which is
-    // checked in the constructor of the data_ member variable,
-    // the profile in the extended ObsSpace is always located
-    // nprofs positions further on than the profile in the original ObsSpace.
-    const std::vector<std::size_t> &locsOriginal = odb_.recidx_vector(recnums[jprof]);
-    const std::vector<std::size_t> &locsExtended = odb_.recidx_vector(recnums[jprof + nprofs]);
-
-    // Retrieve slant path locations.
-    const std::vector<std::size_t>& slant_path_location =
-      data_.getSlantPathLocations(locsOriginal, locsExtended);
-
-    // Fill H(x) vector for each variable.
-    for (int jvar : data_.operatorVarIndices()) {
-      const auto& variable = ovec.varnames().variables()[jvar];
-      // Number of levels for this variable.
-      const std::size_t nlevs_var = gv.nlevs(variable);
-      // GeoVaL vector for this variable.
-      std::vector<double> var_gv(nlevs_var);
-      // For each level:
-      // - get the relevant slant path location,
-      // - retrieve the GeoVaL at that location,
-      // - fill H(x) with the relevant level in the GeoVaL.
-      for (std::size_t mlev = 0; mlev < nlevs_var; ++mlev) {
-        const std::size_t jloc = slant_path_location[mlev];
-        gv.getAtLocation(var_gv, variable, jloc);
-        if (data_.geovalsObsSameDir()) {  // geovals and observations are the same way round:
-          ovec[locsExtended[mlev] * ovec.nvars() + jvar] = var_gv[mlev];
-        } else {  // reverse geovals so they're the same way round in extended space as
-          // observations / H(x) in original space:
-          ovec[locsExtended[mlev] * ovec.nvars() + jvar] = var_gv[nlevs_var - 1 - mlev];
-        }
-      }
-    }
+  // Fill H(x) vector for each variable by selecting the relevant GeoVaL element for each
+  // location of the extended ObsSpace. The GeoVaLs are read in place rather than copied out
+  // one location at a time.
+  std::vector<std::size_t> locsExtended, geovalElements;
+  for (int jvar : data_.operatorVarIndices()) {
+    const auto& variable = ovec.varnames().variables()[jvar];
+    const GeoVaLsView view = gv.view(variable);
+    data_.getGeoVaLElements(view.nlevs(), locsExtended, geovalElements);
+    const double * values = view.data();
+    for (std::size_t i = 0; i < locsExtended.size(); ++i)
+      ovec[locsExtended[i] * ovec.nvars() + jvar] = values[geovalElements[i]];
   }
 
   oops::Log::trace() << "ObsProfileAverage: simulateObs finished" <<  std::endl;
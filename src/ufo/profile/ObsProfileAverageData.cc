@@ -5,6 +5,11 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+
 #include "oops/util/FloatCompare.h"
 #include "oops/util/missingValues.h"
 
@@ -14,6 +19,28 @@
 
 namespace ufo {
 
+  struct ObsProfileAverageData::SlantPathTable {
+    /// Options (other than the GeoVaLs) that the slant path locations depend on.
+    std::string settings;
+    /// Model vertical coordinate at all locations, used to compute the slant path locations.
+    std::vector<float> modelVerticalCoord;
+    /// Slant path locations of each profile.
+    std::vector<std::vector<std::size_t>> locations;
+  };
+
+  namespace {
+    /// Return true if the values in \p a and \p b differ by at most \p tolerance.
+    bool withinTolerance(const std::vector<float> & a, const std::vector<float> & b,
+                         float tolerance) {
+      if (a.size() != b.size())
+        return false;
+      for (std::size_t i = 0; i < a.size(); ++i)
+        if (!(a[i] == b[i] || std::fabs(a[i] - b[i]) <= tolerance))
+          return false;
+      return true;
+    }
+  }  // namespace
+
   ObsProfileAverageData::ObsProfileAverageData(const ioda::ObsSpace & odb,
                                                const ObsProfileAverageParameters & parameters)
     : odb_(odb),
@@ -80,38 +107,133 @@ namespace ufo {
       cachedGeoVaLs_.reset(new GeoVaLs(gv));
   }
 
-  std::vector<std::size_t> ObsProfileAverageData::getSlantPathLocations
-  (const std::vector<std::size_t> & locsOriginal,
-   const std::vector<std::size_t> & locsExtended) const
+  const std::vector<std::size_t> & ObsProfileAverageData::getSlantPathLocations
+  (std::size_t jprof) const
+  {
+    if (!slantPathTable_)
+      slantPathTable_ = this->makeSlantPathTable();
+    return slantPathTable_->locations.at(jprof);
+  }
+
+  void ObsProfileAverageData::getGeoVaLElements(std::size_t nlevs,
+                                                std::vector<std::size_t> & locsExtended,
+                                                std::vector<std::size_t> & geovalElements) const
   {
-    const std::vector<std::size_t> slant_path_location =
-      ufo::getSlantPathLocations(odb_,
-                                 *cachedGeoVaLs_,
-                                 locsOriginal,
-                                 options_.pressureGroup.value() +
-                                 std::string("/") +
-                                 options_.pressureCoord.value(),
-                                 modelVerticalCoord_,
-                                 options_.numIntersectionIterations.value() - 1);
-
-    // If required, compare slant path locations and slant pressure with OPS output.
-    if (options_.compareWithOPS.value()) {
-      // Vector of slanted pressures, used for comparisons with OPS.
-      std::vector<float> slant_pressure;
-      // Number of levels for model pressure.
-      const std::size_t nlevs_p = cachedGeoVaLs_->nlevs(modelVerticalCoord_);
-      // Vector used to store different pressure GeoVaLs.
-      std::vector <float> pressure_gv(nlevs_p);
-      for (std::size_t mlev = 0; mlev < nlevs_p; ++mlev) {
-        cachedGeoVaLs_->getAtLocation(pressure_gv, modelVerticalCoord_, slant_path_location[mlev]);
-        slant_pressure.push_back(pressure_gv[nlevs_p - 1 - mlev]);
+    // Get correspondence between record numbers and indices in the total sample.
+    const std::vector<std::size_t> &recnums = odb_.recidx_all_recnums();
+    // Number of profiles in the original ObsSpace.
+    const std::size_t nprofs = recnums.size() / 2;
+
+    locsExtended.clear();
+    geovalElements.clear();
+    locsExtended.reserve(nprofs * nlevs);
+    geovalElements.reserve(nprofs * nlevs);
+    for (std::size_t jprof = 0; jprof < nprofs; ++jprof) {
+      // The profile in the extended ObsSpace is located nprofs positions further on than the
+      // profile in the original ObsSpace.
+      const std::vector<std::size_t> &locsProfile = odb_.recidx_vector(recnums[jprof + nprofs]);
+      const std::vector<std::size_t> &slant_path_location = getSlantPathLocations(jprof);
+      for (std::size_t mlev = 0; mlev < nlevs; ++mlev) {
+        // If the geovals are reversed relative to the observations, take the level that puts
+        // them the same way round in extended space as the observations in original space.
+        const std::size_t jlev = geovalsObsSameDir_ ? mlev : nlevs - 1 - mlev;
+        locsExtended.push_back(locsProfile[mlev]);
+        geovalElements.push_back(slant_path_location[mlev] * nlevs + jlev);
+      }
+    }
+  }
+
+  std::shared_ptr<const ObsProfileAverageData::SlantPathTable>
+  ObsProfileAverageData::makeSlantPathTable() const
+  {
+    auto table = std::make_shared<SlantPathTable>();
+    const std::string obsVerticalCoord = options_.pressureGroup.value() + std::string("/") +
+      options_.pressureCoord.value();
+    const int itermax = options_.numIntersectionIterations.value() - 1;
+    table->settings = obsVerticalCoord + "\n" + modelVerticalCoord_ + "\n" +
+      std::to_string(itermax);
+
+    // Model vertical coordinate at all locations.
+    const std::size_t nlevs_p = cachedGeoVaLs_->nlevs(modelVerticalCoord_);
+    std::vector<float> pressure_gv(nlevs_p);
+    table->modelVerticalCoord.reserve(cachedGeoVaLs_->nlocs() * nlevs_p);
+    for (std::size_t jloc = 0; jloc < cachedGeoVaLs_->nlocs(); ++jloc) {
+      cachedGeoVaLs_->getAtLocation(pressure_gv, modelVerticalCoord_, jloc);
+      table->modelVerticalCoord.insert(table->modelVerticalCoord.end(),
+                                       pressure_gv.begin(), pressure_gv.end());
+    }
+
+    // Tables computed for each ObsSpace. They are kept alive by the operators using them.
+    static std::mutex mutex;
+    static std::map<const ioda::ObsSpace *,
+                    std::vector<std::weak_ptr<const SlantPathTable>>> allTables;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Forget tables that are no longer used by any operator.
+    for (auto it = allTables.begin(); it != allTables.end(); ) {
+      auto &tablesInObsSpace = it->second;
+      tablesInObsSpace.erase(std::remove_if(tablesInObsSpace.begin(), tablesInObsSpace.end(),
+                                            [](const std::weak_ptr<const SlantPathTable> & t)
+                                            {return t.expired();}),
+                             tablesInObsSpace.end());
+      if (tablesInObsSpace.empty())
+        it = allTables.erase(it);
+      else
+        ++it;
+    }
+    std::vector<std::weak_ptr<const SlantPathTable>> &tables = allTables[&odb_];
+
+    // Reuse the locations computed by another operator if possible. They are always
+    // recomputed if a comparison with OPS is requested, since it is made while computing them.
+    const float tolerance = options_.slantPathPressureTolerance.value();
+    if (tolerance >= 0.0f && !options_.compareWithOPS.value()) {
+      for (const auto & weakTable : tables) {
+        std::shared_ptr<const SlantPathTable> other = weakTable.lock();
+        if (other->settings == table->settings &&
+            withinTolerance(other->modelVerticalCoord, table->modelVerticalCoord, tolerance)) {
+          oops::Log::debug() << "ObsProfileAverage: reusing slant path locations" << std::endl;
+          return other;
+        }
+      }
+    }
+
+    // Observed vertical coordinate at all locations.
+    std::vector<float> pressure_obs(odb_.nlocs());
+    odb_.get_db(options_.pressureGroup.value(), options_.pressureCoord.value(), pressure_obs);
+
+    // Get correspondence between record numbers and indices in the total sample.
+    const std::vector<std::size_t> &recnums = odb_.recidx_all_recnums();
+    // Number of profiles in the original ObsSpace.
+    const std::size_t nprofs = recnums.size() / 2;
+    table->locations.reserve(nprofs);
+    for (std::size_t jprof = 0; jprof < nprofs; ++jprof) {
+      const std::vector<std::size_t> &locsOriginal = odb_.recidx_vector(recnums[jprof]);
+      table->locations.push_back(ufo::getSlantPathLocations(pressure_obs,
+                                                            *cachedGeoVaLs_,
+                                                            locsOriginal,
+                                                            modelVerticalCoord_,
+                                                            itermax));
+      // If required, compare slant path locations and slant pressure with OPS output.
+      if (options_.compareWithOPS.value()) {
+        const std::vector<std::size_t> &slant_path_location = table->locations.back();
+        const std::vector<std::size_t> &locsExtended =
+          odb_.recidx_vector(recnums[jprof + nprofs]);
+        // Vector of slanted pressures, used for comparisons with OPS.
+        std::vector<float> slant_pressure;
+        for (std::size_t mlev = 0; mlev < nlevs_p; ++mlev) {
+          cachedGeoVaLs_->getAtLocation(pressure_gv, modelVerticalCoord_,
+                                        slant_path_location[mlev]);
+          slant_pressure.push_back(pressure_gv[nlevs_p - 1 - mlev]);
+        }
+        this->compareAuxiliaryReferenceVariables(locsExtended,
+                                                 slant_path_location,
+                                                 slant_pressure);
       }
-      this->compareAuxiliaryReferenceVariables(locsExtended,
-                                               slant_path_location,
-                                               slant_pressure);
     }
 
-    return slant_path_location;
+    if (tolerance >= 0.0f)
+      tables.push_back(table);
+    return table;
   }
 
   void ObsProfileAverageData::setUpAuxiliaryReferenceVariables() {
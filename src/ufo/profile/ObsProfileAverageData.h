@@ -40,11 +40,25 @@ namespace ufo {
     /// Cache the initial values of the GeoVaLs.
     void cacheGeoVaLs(const GeoVaLs & gv) const;
 
-    /// Get slant path locations. This determines, for each model level, the location that
+    /// Get slant path locations of profile \p jprof (counted in the order given by
+    /// ObsSpace::recidx_all_recnums()). For each model level, this is the location that
     /// corresponds to the intersection of the observed profile with that level.
-    std::vector<std::size_t> getSlantPathLocations
-      (const std::vector<std::size_t> & locsOriginal,
-       const std::vector<std::size_t> & locsExtended) const;
+    ///
+    /// The locations of all profiles are computed together, from the cached GeoVaLs, the first
+    /// time this function is called. They are shared with other operators acting on the same
+    /// ObsSpace (e.g. the nonlinear and linear operators) whose model pressures are within
+    /// the \p slant path pressure tolerance option of the cached ones.
+    const std::vector<std::size_t> & getSlantPathLocations(std::size_t jprof) const;
+
+    /// Get the positions in the extended ObsSpace at which the operator places the values of a
+    /// variable with \p nlevs levels, and the elements of the GeoVaLs of that variable (indices
+    /// into the storage described in GeoVaLsView) from which these values are taken.
+    ///
+    /// The operator (and therefore its TL and AD) simply selects a single GeoVaL element for each
+    /// location of the extended ObsSpace, so it is fully described by these two vectors.
+    void getGeoVaLElements(std::size_t nlevs,
+                           std::vector<std::size_t> & locsExtended,
+                           std::vector<std::size_t> & geovalElements) const;
 
     /// Print operator configuration options.
     void print(std::ostream & os) const;
@@ -57,6 +71,13 @@ namespace ufo {
     const bool geovalsObsSameDir() const {return geovalsObsSameDir_;}
 
    private:
+    /// Slant path locations of all profiles and the data used to compute them.
+    struct SlantPathTable;
+
+    /// Compute the slant path locations of all profiles or find a compatible set computed
+    /// by another operator.
+    std::shared_ptr<const SlantPathTable> makeSlantPathTable() const;
+
     /// Set up auxiliary reference variables that are used for comparison with OPS.
     /// These reference variables are called MetOfficeHofX/slant_path_location and
     /// MetOfficeHofX/slant_pressure. If a comparison with OPS is to be performed
@@ -90,6 +111,9 @@ namespace ufo {
     /// Cached GeoVaLs.
     mutable std::unique_ptr<GeoVaLs> cachedGeoVaLs_;
 
+    /// Slant path locations of all profiles, computed from the cached GeoVaLs.
+    mutable std::shared_ptr<const SlantPathTable> slantPathTable_;
+
     /// Reference values of slant path locations.
     std::vector<int> slant_path_location_ref_;
 
@@ -72,6 +72,17 @@ class ObsProfileAverageParameters : public ObsOperatorParametersBase {
                                              "Name of air pressure group",
                                              "ObsValue",
                                              this};
+
+  oops::Parameter<float> slantPathPressureTolerance{
+    "slant path pressure tolerance",
+    "Slant path locations computed by another ProfileAverage operator acting on the same "
+    "ObsSpace (such as the nonlinear operator, or the linear operator in an earlier outer "
+    "loop) are reused if the model vertical coordinate used to compute them differs from the "
+    "current one by at most this amount at every location and level. With the default value "
+    "of zero they are only reused if the model vertical coordinate is unchanged. A negative "
+    "value disables the reuse.",
+    0.0f,
+    this};
 };
 
 }  // namespace ufo
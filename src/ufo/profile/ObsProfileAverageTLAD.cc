@@ -44,6 +44,14 @@ ObsProfileAverageTLAD::~ObsProfileAverageTLAD() {
 void ObsProfileAverageTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostics &) {
   // Cache the model trajectory for use in the slant path location algorithm.
   data_.cacheGeoVaLs(geovals);
+
+  // The TL and AD select the same GeoVaL elements for every increment, so find them once.
+  const oops::Variables & operatorVars = data_.simulatedVars();
+  locsExtended_.resize(operatorVars.size());
+  geovalElements_.resize(operatorVars.size());
+  for (std::size_t jop = 0; jop < operatorVars.size(); ++jop)
+    data_.getGeoVaLElements(geovals.nlevs(operatorVars[jop]),
+                            locsExtended_[jop], geovalElements_[jop]);
   oops::Log::trace() << "ObsProfileAverageTLAD: trajectory set" << std::endl;
 }
 
@@ -52,36 +60,15 @@ void ObsProfileAverageTLAD::setTrajectory(const GeoVaLs & geovals, ObsDiagnostic
 void ObsProfileAverageTLAD::simulateObsTL(const GeoVaLs & dx, ioda::ObsVector & dy) const {
   oops::Log::trace() << "ObsProfileAverageTLAD: simulateObsTL started" << std::endl;
 
-  // Get correspondence between record numbers and indices in the total sample.
-  const std::vector<std::size_t> &recnums = odb_.recidx_all_recnums();
-
-  // Number of profiles in the original ObsSpace.
-  const std::size_t nprofs = recnums.size() / 2;
-
-  // Loop over profiles.
-  for (std::size_t jprof = 0; jprof < nprofs; ++jprof) {
-    const std::vector<std::size_t> &locsOriginal = odb_.recidx_vector(recnums[jprof]);
-    const std::vector<std::size_t> &locsExtended = odb_.recidx_vector(recnums[jprof + nprofs]);
-
-    // Retrieve slant path locations.
-    const std::vector<std::size_t>& slant_path_location =
-      data_.getSlantPathLocations(locsOriginal, locsExtended);
-
-    for (int jvar : data_.operatorVarIndices()) {
-      const auto& variable = dy.varnames().variables()[jvar];
-      const std::size_t nlevs_var = dx.nlevs(variable);
-      std::vector<double> var_gv(nlevs_var);
-      for (std::size_t mlev = 0; mlev < nlevs_var; ++mlev) {
-        const std::size_t jloc = slant_path_location[mlev];
-        dx.getAtLocation(var_gv, variable, jloc);
-        if (data_.geovalsObsSameDir()) {  // geovals and observations are the same way round:
-          dy[locsExtended[mlev] * dy.nvars() + jvar] = var_gv[mlev];
-        } else {  // reverse geovals so they're the same way round in extended space as
-          // observations / H(x) in original space:
-          dy[locsExtended[mlev] * dy.nvars() + jvar] = var_gv[nlevs_var - 1 - mlev];
-        }
-      }
-    }
+  const std::vector<int> & operatorVarIndices = data_.operatorVarIndices();
+  for (std::size_t jop = 0; jop < operatorVarIndices.size(); ++jop) {
+    const int jvar = operatorVarIndices[jop];
+    const auto& variable = dy.varnames().variables()[jvar];
+    const double * values = dx.view(variable).data();
+    const std::vector<std::size_t> & locsExtended = locsExtended_[jop];
+    const std::vector<std::size_t> & geovalElements = geovalElements_[jop];
+    for (std::size_t i = 0; i < locsExtended.size(); ++i)
+      dy[locsExtended[i] * dy.nvars() + jvar] = values[geovalElements[i]];
   }
 
   oops::Log::trace() << "ObsProfileAverageTLAD: simulateObsTL finished" <<  std::endl;
@@ -94,43 +81,17 @@ void ObsProfileAverageTLAD::simulateObsAD(GeoVaLs & dx, const ioda::ObsVector &
 
   const double missing = util::missingValue(missing);
 
-  // Get correspondence between record numbers and indices in the total sample.
-  const std::vector<std::size_t> &recnums = odb_.recidx_all_recnums();
-
-  // Number of profiles in the original ObsSpace.
-  const std::size_t nprofs = recnums.size() / 2;
-
-  // Loop over profiles.
-  for (std::size_t jprof = 0; jprof < nprofs; ++jprof) {
-    const std::vector<std::size_t> &locsOriginal = odb_.recidx_vector(recnums[jprof]);
-    const std::vector<std::size_t> &locsExtended = odb_.recidx_vector(recnums[jprof + nprofs]);
-
-    // Retrieve slant path locations.
-    const std::vector<std::size_t>& slant_path_location =
-      data_.getSlantPathLocations(locsOriginal, locsExtended);
-
-    for (int jvar : data_.operatorVarIndices()) {
-      const auto& variable = dy.varnames().variables()[jvar];
-      const std::size_t nlevs_var = dx.nlevs(variable);
-      std::vector<double> var_gv(nlevs_var);
-      for (std::size_t mlev = 0; mlev < nlevs_var; ++mlev) {
-        const std::size_t jloc = slant_path_location[mlev];
-        // Get the current value of dx.
-        dx.getAtLocation(var_gv, variable, jloc);
-        const std::size_t idx = locsExtended[mlev] * dy.nvars() + jvar;
-        if (dy[idx] != missing) {
-          if (data_.geovalsObsSameDir()) {
-            // geovals and observations are the same way round:
-            var_gv[mlev] += dy[idx];
-          } else {
-            // geovals reversed relative to obs
-            // write dy into correct index of geoval
-            var_gv[nlevs_var - 1 - mlev] += dy[idx];
-          }
-        }
-        // Store the new value of dx.
-        dx.putAtLocation(var_gv, variable, jloc);
-      }
+  const std::vector<int> & operatorVarIndices = data_.operatorVarIndices();
+  for (std::size_t jop = 0; jop < operatorVarIndices.size(); ++jop) {
+    const int jvar = operatorVarIndices[jop];
+    const auto& variable = dy.varnames().variables()[jvar];
+    double * values = dx.data(variable);
+    const std::vector<std::size_t> & locsExtended = locsExtended_[jop];
+    const std::vector<std::size_t> & geovalElements = geovalElements_[jop];
+    for (std::size_t i = 0; i < locsExtended.size(); ++i) {
+      const std::size_t idx = locsExtended[i] * dy.nvars() + jvar;
+      if (dy[idx] != missing)
+        values[geovalElements[i]] += dy[idx];
     }
   }
 
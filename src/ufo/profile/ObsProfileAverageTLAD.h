@@ -58,6 +58,11 @@ class ObsProfileAverageTLAD : public LinearObsOperatorBase,
 
   /// Data handler for the ProfileAverage operator and TL/AD code.
   ObsProfileAverageData data_;
+
+  /// For each operator variable: locations in the extended ObsSpace filled by the operator and
+  /// the GeoVaL elements (see ObsProfileAverageData::getGeoVaLElements) they are taken from.
+  std::vector<std::vector<std::size_t>> locsExtended_;
+  std::vector<std::vector<std::size_t>> geovalElements_;
 };
 
 // -----------------------------------------------------------------------------
@@ -8,6 +8,26 @@
 #include "ufo/profile/ProfileCheckBackgroundGeopotentialHeight.h"
 
 namespace ufo {
+  // Handles to the variables used below.
+  namespace handles {
+    const ProfileVariableHandle<float> Zstation(ufo::VariableNames::Zstation);
+    const ProfileVariableHandle<float> obs_air_pressure(ufo::VariableNames::obs_air_pressure);
+    const ProfileVariableHandle<float> obs_geopotential_height
+      (ufo::VariableNames::obs_geopotential_height);
+    const ProfileVariableHandle<float> obserr_geopotential_height
+      (ufo::VariableNames::obserr_geopotential_height);
+    const ProfileVariableHandle<float> hofx_geopotential_height
+      (ufo::VariableNames::hofx_geopotential_height);
+    const ProfileVariableHandle<float> pge_geopotential_height
+      (ufo::VariableNames::pge_geopotential_height);
+    const ProfileVariableHandle<int> qcflags_geopotential_height
+      (ufo::VariableNames::qcflags_geopotential_height);
+    const ProfileVariableHandle<int> qcflags_air_temperature
+      (ufo::VariableNames::qcflags_air_temperature);
+    const ProfileVariableHandle<float> obscorrection_geopotential_height
+      (ufo::VariableNames::obscorrection_geopotential_height);
+    const ProfileVariableHandle<int> extended_obs_space(ufo::VariableNames::extended_obs_space);
+  }  // namespace handles
 
   static ProfileCheckMaker<ProfileCheckBackgroundGeopotentialHeight>
   makerProfileCheckBackgroundGeopotentialHeight_("BackgroundGeopotentialHeight");
@@ -23,25 +43,25 @@ namespace ufo {
 
     const size_t numProfileLevels = profileDataHandler.getNumProfileLevels();
     const std::vector <float> &Zstation =
-      profileDataHandler.get<float>(ufo::VariableNames::Zstation);
+      profileDataHandler.get(handles::Zstation);
     const std::vector <float> &pressures =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+      profileDataHandler.get(handles::obs_air_pressure);
     const std::vector <float> &zObs =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_geopotential_height);
+      profileDataHandler.get(handles::obs_geopotential_height);
     const std::vector <float> &zObsErr =
-      profileDataHandler.get<float>(ufo::VariableNames::obserr_geopotential_height);
+      profileDataHandler.get(handles::obserr_geopotential_height);
     const std::vector <float> &zBkg =
-      profileDataHandler.get<float>(ufo::VariableNames::hofx_geopotential_height);
+      profileDataHandler.get(handles::hofx_geopotential_height);
     std::vector <float> &zPGE =
-      profileDataHandler.get<float>(ufo::VariableNames::pge_geopotential_height);
+      profileDataHandler.get(handles::pge_geopotential_height);
     std::vector <int> &zFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_geopotential_height);
+      profileDataHandler.get(handles::qcflags_geopotential_height);
     const std::vector <int> &tFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+      profileDataHandler.get(handles::qcflags_air_temperature);
     const std::vector <float> &zObsCorrection =
-       profileDataHandler.get<float>(ufo::VariableNames::obscorrection_geopotential_height);
+       profileDataHandler.get(handles::obscorrection_geopotential_height);
     const std::vector <int> &extended_obs_space =
-      profileDataHandler.get<int>(ufo::VariableNames::extended_obs_space);
+      profileDataHandler.get(handles::extended_obs_space);
     const bool ModelLevels = std::find(extended_obs_space.begin(), extended_obs_space.end(), 1)
       != extended_obs_space.end();
 
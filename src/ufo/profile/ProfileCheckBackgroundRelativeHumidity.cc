@@ -8,6 +8,22 @@
 #include "ufo/profile/ProfileCheckBackgroundRelativeHumidity.h"
 
 namespace ufo {
+  // Handles to the variables used below.
+  namespace handles {
+    const ProfileVariableHandle<float> obs_relative_humidity
+      (ufo::VariableNames::obs_relative_humidity);
+    const ProfileVariableHandle<float> obserr_relative_humidity
+      (ufo::VariableNames::obserr_relative_humidity);
+    const ProfileVariableHandle<float> hofx_relative_humidity
+      (ufo::VariableNames::hofx_relative_humidity);
+    const ProfileVariableHandle<float> bkgerr_relative_humidity
+      (ufo::VariableNames::bkgerr_relative_humidity);
+    const ProfileVariableHandle<float> pge_relative_humidity
+      (ufo::VariableNames::pge_relative_humidity);
+    const ProfileVariableHandle<int> qcflags_relative_humidity
+      (ufo::VariableNames::qcflags_relative_humidity);
+    const ProfileVariableHandle<int> extended_obs_space(ufo::VariableNames::extended_obs_space);
+  }  // namespace handles
 
   static ProfileCheckMaker<ProfileCheckBackgroundRelativeHumidity>
   makerProfileCheckBackgroundRelativeHumidity_("BackgroundRelativeHumidity");
@@ -23,19 +39,19 @@ namespace ufo {
 
     const size_t numProfileLevels = profileDataHandler.getNumProfileLevels();
     const std::vector <float> &rhObs =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_relative_humidity);
+      profileDataHandler.get(handles::obs_relative_humidity);
     const std::vector <float> &rhObsErr =
-      profileDataHandler.get<float>(ufo::VariableNames::obserr_relative_humidity);
+      profileDataHandler.get(handles::obserr_relative_humidity);
     const std::vector <float> &rhBkg =
-      profileDataHandler.get<float>(ufo::VariableNames::hofx_relative_humidity);
+      profileDataHandler.get(handles::hofx_relative_humidity);
     const std::vector <float> &rhBkgErr =
-      profileDataHandler.get<float>(ufo::VariableNames::bkgerr_relative_humidity);
+      profileDataHandler.get(handles::bkgerr_relative_humidity);
     std::vector <float> &rhPGE =
-      profileDataHandler.get<float>(ufo::VariableNames::pge_relative_humidity);
+      profileDataHandler.get(handles::pge_relative_humidity);
     std::vector <int> &rhFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_relative_humidity);
+      profileDataHandler.get(handles::qcflags_relative_humidity);
     const std::vector <int> &extended_obs_space =
-      profileDataHandler.get<int>(ufo::VariableNames::extended_obs_space);
+      profileDataHandler.get(handles::extended_obs_space);
     const bool ModelLevels = std::find(extended_obs_space.begin(), extended_obs_space.end(), 1)
       != extended_obs_space.end();
 
@@ -8,6 +8,24 @@
 #include "ufo/profile/ProfileCheckBackgroundTemperature.h"
 
 namespace ufo {
+  // Handles to the variables used below.
+  namespace handles {
+    const ProfileVariableHandle<float> Latitude(ufo::VariableNames::Latitude);
+    const ProfileVariableHandle<float> obs_air_pressure(ufo::VariableNames::obs_air_pressure);
+    const ProfileVariableHandle<float> obs_air_temperature(ufo::VariableNames::obs_air_temperature);
+    const ProfileVariableHandle<float> obserr_air_temperature
+      (ufo::VariableNames::obserr_air_temperature);
+    const ProfileVariableHandle<float> hofx_air_temperature
+      (ufo::VariableNames::hofx_air_temperature);
+    const ProfileVariableHandle<float> bkgerr_air_temperature
+      (ufo::VariableNames::bkgerr_air_temperature);
+    const ProfileVariableHandle<float> pge_air_temperature(ufo::VariableNames::pge_air_temperature);
+    const ProfileVariableHandle<int> qcflags_air_temperature
+      (ufo::VariableNames::qcflags_air_temperature);
+    const ProfileVariableHandle<float> obscorrection_air_temperature
+      (ufo::VariableNames::obscorrection_air_temperature);
+    const ProfileVariableHandle<int> extended_obs_space(ufo::VariableNames::extended_obs_space);
+  }  // namespace handles
 
   static ProfileCheckMaker<ProfileCheckBackgroundTemperature>
   makerProfileCheckBackgroundTemperature_("BackgroundTemperature");
@@ -23,25 +41,25 @@ namespace ufo {
 
     const size_t numProfileLevels = profileDataHandler.getNumProfileLevels();
     const std::vector <float> &Latitude =
-      profileDataHandler.get<float>(ufo::VariableNames::Latitude);
+      profileDataHandler.get(handles::Latitude);
     const std::vector <float> &pressures =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+      profileDataHandler.get(handles::obs_air_pressure);
     const std::vector <float> &tObs =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_air_temperature);
+      profileDataHandler.get(handles::obs_air_temperature);
     const std::vector <float> &tObsErr =
-      profileDataHandler.get<float>(ufo::VariableNames::obserr_air_temperature);
+      profileDataHandler.get(handles::obserr_air_temperature);
     const std::vector <float> &tBkg =
-      profileDataHandler.get<float>(ufo::VariableNames::hofx_air_temperature);
+      profileDataHandler.get(handles::hofx_air_temperature);
     const std::vector <float> &tBkgErr =
-      profileDataHandler.get<float>(ufo::VariableNames::bkgerr_air_temperature);
+      profileDataHandler.get(handles::bkgerr_air_temperature);
     std::vector <float> &tPGE =
-      profileDataHandler.get<float>(ufo::VariableNames::pge_air_temperature);
+      profileDataHandler.get(handles::pge_air_temperature);
     std::vector <int> &tFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+      profileDataHandler.get(handles::qcflags_air_temperature);
     const std::vector <float> &tObsCorrection =
-       profileDataHandler.get<float>(ufo::VariableNames::obscorrection_air_temperature);
+       profileDataHandler.get(handles::obscorrection_air_temperature);
     const std::vector <int> &extended_obs_space =
-      profileDataHandler.get<int>(ufo::VariableNames::extended_obs_space);
+      profileDataHandler.get(handles::extended_obs_space);
     const bool ModelLevels = std::find(extended_obs_space.begin(), extended_obs_space.end(), 1)
       != extended_obs_space.end();
 
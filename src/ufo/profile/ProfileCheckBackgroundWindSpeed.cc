@@ -8,6 +8,28 @@
 #include "ufo/profile/ProfileCheckBackgroundWindSpeed.h"
 
 namespace ufo {
+  // Handles to the variables used below.
+  namespace handles {
+    const ProfileVariableHandle<float> obs_eastward_wind(ufo::VariableNames::obs_eastward_wind);
+    const ProfileVariableHandle<float> obserr_eastward_wind
+      (ufo::VariableNames::obserr_eastward_wind);
+    const ProfileVariableHandle<float> hofx_eastward_wind(ufo::VariableNames::hofx_eastward_wind);
+    const ProfileVariableHandle<float> bkgerr_eastward_wind
+      (ufo::VariableNames::bkgerr_eastward_wind);
+    const ProfileVariableHandle<float> pge_eastward_wind(ufo::VariableNames::pge_eastward_wind);
+    const ProfileVariableHandle<int> qcflags_eastward_wind
+      (ufo::VariableNames::qcflags_eastward_wind);
+    const ProfileVariableHandle<float> obs_northward_wind(ufo::VariableNames::obs_northward_wind);
+    const ProfileVariableHandle<float> obserr_northward_wind
+      (ufo::VariableNames::obserr_northward_wind);
+    const ProfileVariableHandle<float> hofx_northward_wind(ufo::VariableNames::hofx_northward_wind);
+    const ProfileVariableHandle<float> bkgerr_northward_wind
+      (ufo::VariableNames::bkgerr_northward_wind);
+    const ProfileVariableHandle<float> pge_northward_wind(ufo::VariableNames::pge_northward_wind);
+    const ProfileVariableHandle<int> qcflags_northward_wind
+      (ufo::VariableNames::qcflags_northward_wind);
+    const ProfileVariableHandle<int> extended_obs_space(ufo::VariableNames::extended_obs_space);
+  }  // namespace handles
 
   static ProfileCheckMaker<ProfileCheckBackgroundWindSpeed>
   makerProfileCheckBackgroundWindSpeed_("BackgroundWindSpeed");
@@ -23,31 +45,31 @@ namespace ufo {
 
     const size_t numProfileLevels = profileDataHandler.getNumProfileLevels();
     const std::vector <float> &uObs =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_eastward_wind);
+      profileDataHandler.get(handles::obs_eastward_wind);
     const std::vector <float> &uObsErr =
-      profileDataHandler.get<float>(ufo::VariableNames::obserr_eastward_wind);
+      profileDataHandler.get(handles::obserr_eastward_wind);
     const std::vector <float> &uBkg =
-      profileDataHandler.get<float>(ufo::VariableNames::hofx_eastward_wind);
+      profileDataHandler.get(handles::hofx_eastward_wind);
     const std::vector <float> &uBkgErr =
-      profileDataHandler.get<float>(ufo::VariableNames::bkgerr_eastward_wind);
+      profileDataHandler.get(handles::bkgerr_eastward_wind);
     std::vector <float> &uPGE =
-      profileDataHandler.get<float>(ufo::VariableNames::pge_eastward_wind);
+      profileDataHandler.get(handles::pge_eastward_wind);
     std::vector <int> &uFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_eastward_wind);
+      profileDataHandler.get(handles::qcflags_eastward_wind);
     const std::vector <float> &vObs =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_northward_wind);
+      profileDataHandler.get(handles::obs_northward_wind);
     const std::vector <float> &vObsErr =
-      profileDataHandler.get<float>(ufo::VariableNames::obserr_northward_wind);
+      profileDataHandler.get(handles::obserr_northward_wind);
     const std::vector <float> &vBkg =
-      profileDataHandler.get<float>(ufo::VariableNames::hofx_northward_wind);
+      profileDataHandler.get(handles::hofx_northward_wind);
     const std::vector <float> &vBkgErr =
-      profileDataHandler.get<float>(ufo::VariableNames::bkgerr_northward_wind);
+      profileDataHandler.get(handles::bkgerr_northward_wind);
     std::vector <float> &vPGE =
-      profileDataHandler.get<float>(ufo::VariableNames::pge_northward_wind);
+      profileDataHandler.get(handles::pge_northward_wind);
     std::vector <int> &vFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_northward_wind);
+      profileDataHandler.get(handles::qcflags_northward_wind);
     const std::vector <int> &extended_obs_space =
-      profileDataHandler.get<int>(ufo::VariableNames::extended_obs_space);
+      profileDataHandler.get(handles::extended_obs_space);
     const bool ModelLevels = std::find(extended_obs_space.begin(), extended_obs_space.end(), 1)
       != extended_obs_space.end();
 
@@ -9,6 +9,18 @@
 #include "ufo/profile/VariableNames.h"
 
 namespace ufo {
+  // Handles to the variables used below.
+  namespace handles {
+    const ProfileVariableHandle<float> obs_air_pressure(ufo::VariableNames::obs_air_pressure);
+    const ProfileVariableHandle<int> qcflags_air_temperature
+      (ufo::VariableNames::qcflags_air_temperature);
+    const ProfileVariableHandle<int> qcflags_eastward_wind
+      (ufo::VariableNames::qcflags_eastward_wind);
+    const ProfileVariableHandle<int> qcflags_northward_wind
+      (ufo::VariableNames::qcflags_northward_wind);
+    const ProfileVariableHandle<int> qcflags_relative_humidity
+      (ufo::VariableNames::qcflags_relative_humidity);
+  }  // namespace handles
 
   static ProfileCheckMaker<ProfileCheckBasic> makerProfileCheckBasic_("Basic");
 
@@ -32,17 +44,13 @@ namespace ufo {
 
     const int numProfileLevels = profileDataHandler.getNumProfileLevels();
     const std::vector <float> &pressures =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+      profileDataHandler.get(handles::obs_air_pressure);
     // All QC flags are retrieved for the basic checks.
     // (Some might be empty; that is checked before they are used.)
-    std::vector <int> &tFlags = profileDataHandler.get<int>
-      (ufo::VariableNames::qcflags_air_temperature);
-    std::vector <int> &uFlags = profileDataHandler.get<int>
-      (ufo::VariableNames::qcflags_eastward_wind);
-    std::vector <int> &vFlags = profileDataHandler.get<int>
-      (ufo::VariableNames::qcflags_northward_wind);
-    std::vector <int> &rhFlags = profileDataHandler.get<int>
-      (ufo::VariableNames::qcflags_relative_humidity);
+    std::vector <int> &tFlags = profileDataHandler.get(handles::qcflags_air_temperature);
+    std::vector <int> &uFlags = profileDataHandler.get(handles::qcflags_eastward_wind);
+    std::vector <int> &vFlags = profileDataHandler.get(handles::qcflags_northward_wind);
+    std::vector <int> &rhFlags = profileDataHandler.get(handles::qcflags_relative_humidity);
 
     // Warn and exit if pressures vector is empty
     if (pressures.empty()) {
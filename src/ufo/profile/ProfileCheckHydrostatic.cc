@@ -9,6 +9,32 @@
 #include "ufo/profile/VariableNames.h"
 
 namespace ufo {
+  // Handles to the variables used below.
+  namespace handles {
+    const ProfileVariableHandle<float> obs_air_pressure(ufo::VariableNames::obs_air_pressure);
+    const ProfileVariableHandle<float> obs_air_temperature(ufo::VariableNames::obs_air_temperature);
+    const ProfileVariableHandle<float> hofx_air_temperature
+      (ufo::VariableNames::hofx_air_temperature);
+    const ProfileVariableHandle<float> obs_geopotential_height
+      (ufo::VariableNames::obs_geopotential_height);
+    const ProfileVariableHandle<float> hofx_geopotential_height
+      (ufo::VariableNames::hofx_geopotential_height);
+    const ProfileVariableHandle<int> qcflags_air_temperature
+      (ufo::VariableNames::qcflags_air_temperature);
+    const ProfileVariableHandle<int> qcflags_geopotential_height
+      (ufo::VariableNames::qcflags_geopotential_height);
+    const ProfileVariableHandle<int> counter_NumAnyErrors(ufo::VariableNames::counter_NumAnyErrors);
+    const ProfileVariableHandle<int> counter_Num925Miss(ufo::VariableNames::counter_Num925Miss);
+    const ProfileVariableHandle<int> counter_Num100Miss(ufo::VariableNames::counter_Num100Miss);
+    const ProfileVariableHandle<int> counter_NumStdMiss(ufo::VariableNames::counter_NumStdMiss);
+    const ProfileVariableHandle<int> counter_NumHydErrObs(ufo::VariableNames::counter_NumHydErrObs);
+    const ProfileVariableHandle<int> counter_NumIntHydErrors
+      (ufo::VariableNames::counter_NumIntHydErrors);
+    const ProfileVariableHandle<float> obscorrection_air_temperature
+      (ufo::VariableNames::obscorrection_air_temperature);
+    const ProfileVariableHandle<float> obscorrection_geopotential_height
+      (ufo::VariableNames::obscorrection_geopotential_height);
+  }  // namespace handles
 
   static ProfileCheckMaker<ProfileCheckHydrostatic> makerProfileCheckHydrostatic_("Hydrostatic");
 
@@ -25,35 +51,35 @@ namespace ufo {
     const int numProfileLevels = profileDataHandler.getNumProfileLevels();
 
     const std::vector <float> &pressures =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+       profileDataHandler.get(handles::obs_air_pressure);
     const std::vector <float> &tObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_temperature);
+       profileDataHandler.get(handles::obs_air_temperature);
     const std::vector <float> &tBkg =
-       profileDataHandler.get<float>(ufo::VariableNames::hofx_air_temperature);
+       profileDataHandler.get(handles::hofx_air_temperature);
     const std::vector <float> &zObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_geopotential_height);
+       profileDataHandler.get(handles::obs_geopotential_height);
     const std::vector <float> &zBkg =
-       profileDataHandler.get<float>(ufo::VariableNames::hofx_geopotential_height);
+       profileDataHandler.get(handles::hofx_geopotential_height);
     std::vector <int> &tFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+       profileDataHandler.get(handles::qcflags_air_temperature);
     std::vector <int> &zFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::qcflags_geopotential_height);
+       profileDataHandler.get(handles::qcflags_geopotential_height);
     std::vector <int> &NumAnyErrors =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_NumAnyErrors);
+       profileDataHandler.get(handles::counter_NumAnyErrors);
     std::vector <int> &Num925Miss =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_Num925Miss);
+       profileDataHandler.get(handles::counter_Num925Miss);
     std::vector <int> &Num100Miss =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_Num100Miss);
+       profileDataHandler.get(handles::counter_Num100Miss);
     std::vector <int> &NumStdMiss =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_NumStdMiss);
+       profileDataHandler.get(handles::counter_NumStdMiss);
     std::vector <int> &NumHydErrObs =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_NumHydErrObs);
+       profileDataHandler.get(handles::counter_NumHydErrObs);
     std::vector <int> &NumIntHydErrors =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_NumIntHydErrors);
+       profileDataHandler.get(handles::counter_NumIntHydErrors);
     const std::vector <float> &tObsCorrection =
-       profileDataHandler.get<float>(ufo::VariableNames::obscorrection_air_temperature);
+       profileDataHandler.get(handles::obscorrection_air_temperature);
     std::vector <float> &zObsCorrection =
-       profileDataHandler.get<float>(ufo::VariableNames::obscorrection_geopotential_height);
+       profileDataHandler.get(handles::obscorrection_geopotential_height);
 
     if (!oops::allVectorsSameNonZeroSize(pressures, tObs, tBkg, zObs, zBkg, tFlags, zFlags,
                                          tObsCorrection, zObsCorrection)) {
@@ -8,6 +8,22 @@
 #include "ufo/profile/ProfileCheckPermanentReject.h"
 
 namespace ufo {
+  // Handles to the variables used below.
+  namespace handles {
+    const ProfileVariableHandle<int> qcflags_air_temperature
+      (ufo::VariableNames::qcflags_air_temperature);
+    const ProfileVariableHandle<int> qcflags_relative_humidity
+      (ufo::VariableNames::qcflags_relative_humidity);
+    const ProfileVariableHandle<int> qcflags_eastward_wind
+      (ufo::VariableNames::qcflags_eastward_wind);
+    const ProfileVariableHandle<int> qcflags_northward_wind
+      (ufo::VariableNames::qcflags_northward_wind);
+    const ProfileVariableHandle<int> qcflags_geopotential_height
+      (ufo::VariableNames::qcflags_geopotential_height);
+    const ProfileVariableHandle<int> qcflags_observation_report
+      (ufo::VariableNames::qcflags_observation_report);
+    const ProfileVariableHandle<int> extended_obs_space(ufo::VariableNames::extended_obs_space);
+  }  // namespace handles
 
   static ProfileCheckMaker<ProfileCheckPermanentReject>
   makerProfileCheckPermanentReject_("PermanentReject");
@@ -23,19 +39,19 @@ namespace ufo {
 
     const size_t numProfileLevels = profileDataHandler.getNumProfileLevels();
     std::vector <int> &tFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+      profileDataHandler.get(handles::qcflags_air_temperature);
     std::vector <int> &rhFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_relative_humidity);
+      profileDataHandler.get(handles::qcflags_relative_humidity);
     std::vector <int> &uFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_eastward_wind);
+      profileDataHandler.get(handles::qcflags_eastward_wind);
     std::vector <int> &vFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_northward_wind);
+      profileDataHandler.get(handles::qcflags_northward_wind);
     std::vector <int> &zFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_geopotential_height);
+      profileDataHandler.get(handles::qcflags_geopotential_height);
     std::vector <int> &ReportFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_observation_report);
+      profileDataHandler.get(handles::qcflags_observation_report);
     const std::vector <int> &extended_obs_space =
-      profileDataHandler.get<int>(ufo::VariableNames::extended_obs_space);
+      profileDataHandler.get(handles::extended_obs_space);
     const bool ModelLevels = std::find(extended_obs_space.begin(), extended_obs_space.end(), 1)
       != extended_obs_space.end();
 
@@ -9,6 +9,30 @@
 #include "ufo/profile/VariableNames.h"
 
 namespace ufo {
+  // Handles to the variables used below.
+  namespace handles {
+    const ProfileVariableHandle<float> obs_air_pressure(ufo::VariableNames::obs_air_pressure);
+    const ProfileVariableHandle<float> obs_air_temperature(ufo::VariableNames::obs_air_temperature);
+    const ProfileVariableHandle<float> hofx_air_temperature
+      (ufo::VariableNames::hofx_air_temperature);
+    const ProfileVariableHandle<float> obs_relative_humidity
+      (ufo::VariableNames::obs_relative_humidity);
+    const ProfileVariableHandle<float> hofx_relative_humidity
+      (ufo::VariableNames::hofx_relative_humidity);
+    const ProfileVariableHandle<float> obs_dew_point_temperature
+      (ufo::VariableNames::obs_dew_point_temperature);
+    const ProfileVariableHandle<int> qcflags_air_temperature
+      (ufo::VariableNames::qcflags_air_temperature);
+    const ProfileVariableHandle<int> qcflags_relative_humidity
+      (ufo::VariableNames::qcflags_relative_humidity);
+    const ProfileVariableHandle<float> obscorrection_air_temperature
+      (ufo::VariableNames::obscorrection_air_temperature);
+    const ProfileVariableHandle<int> counter_TotCProfs(ufo::VariableNames::counter_TotCProfs);
+    const ProfileVariableHandle<int> counter_TotHProfs(ufo::VariableNames::counter_TotHProfs);
+    const ProfileVariableHandle<int> counter_TotCFlags(ufo::VariableNames::counter_TotCFlags);
+    const ProfileVariableHandle<int> counter_TotHFlags(ufo::VariableNames::counter_TotHFlags);
+    const ProfileVariableHandle<int> counter_TotLFlags(ufo::VariableNames::counter_TotLFlags);
+  }  // namespace handles
 
   static ProfileCheckMaker<ProfileCheckRH> makerProfileCheckRH_("RH");
 
@@ -23,34 +47,34 @@ namespace ufo {
 
     const int numProfileLevels = profileDataHandler.getNumProfileLevels();
     const std::vector <float> &pressures =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+       profileDataHandler.get(handles::obs_air_pressure);
     const std::vector <float> &tObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_air_temperature);
+       profileDataHandler.get(handles::obs_air_temperature);
     const std::vector <float> &tBkg =
-       profileDataHandler.get<float>(ufo::VariableNames::hofx_air_temperature);
+       profileDataHandler.get(handles::hofx_air_temperature);
     const std::vector <float> &RHObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_relative_humidity);
+       profileDataHandler.get(handles::obs_relative_humidity);
     const std::vector <float> &RHBkg =
-       profileDataHandler.get<float>(ufo::VariableNames::hofx_relative_humidity);
+       profileDataHandler.get(handles::hofx_relative_humidity);
     const std::vector <float> &tdObs =
-       profileDataHandler.get<float>(ufo::VariableNames::obs_dew_point_temperature);
+       profileDataHandler.get(handles::obs_dew_point_temperature);
     const std::vector <int> &tFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+       profileDataHandler.get(handles::qcflags_air_temperature);
     std::vector <int> &RHFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::qcflags_relative_humidity);
+       profileDataHandler.get(handles::qcflags_relative_humidity);
     const std::vector <float> &tObsCorrection =
-       profileDataHandler.get<float>(ufo::VariableNames::obscorrection_air_temperature);
+       profileDataHandler.get(handles::obscorrection_air_temperature);
 
     std::vector <int> &TotCProfs =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_TotCProfs);
+       profileDataHandler.get(handles::counter_TotCProfs);
     std::vector <int> &TotHProfs =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_TotHProfs);
+       profileDataHandler.get(handles::counter_TotHProfs);
     std::vector <int> &TotCFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_TotCFlags);
+       profileDataHandler.get(handles::counter_TotCFlags);
     std::vector <int> &TotHFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_TotHFlags);
+       profileDataHandler.get(handles::counter_TotHFlags);
     std::vector <int> &TotLFlags =
-       profileDataHandler.get<int>(ufo::VariableNames::counter_TotLFlags);
+       profileDataHandler.get(handles::counter_TotLFlags);
 
     if (!oops::allVectorsSameNonZeroSize(pressures, tObs, tBkg, RHObs, RHBkg,
                                          tdObs, tFlags, RHFlags, tObsCorrection)) {
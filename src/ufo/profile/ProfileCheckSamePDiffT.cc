@@ -9,6 +9,20 @@
 #include "ufo/profile/VariableNames.h"
 
 namespace ufo {
+  // Handles to the variables used below.
+  namespace handles {
+    const ProfileVariableHandle<float> obs_air_pressure(ufo::VariableNames::obs_air_pressure);
+    const ProfileVariableHandle<float> obs_air_temperature(ufo::VariableNames::obs_air_temperature);
+    const ProfileVariableHandle<float> hofx_air_temperature
+      (ufo::VariableNames::hofx_air_temperature);
+    const ProfileVariableHandle<int> qcflags_air_temperature
+      (ufo::VariableNames::qcflags_air_temperature);
+    const ProfileVariableHandle<int> counter_NumAnyErrors(ufo::VariableNames::counter_NumAnyErrors);
+    const ProfileVariableHandle<int> counter_NumSamePErrObs
+      (ufo::VariableNames::counter_NumSamePErrObs);
+    const ProfileVariableHandle<float> obscorrection_air_temperature
+      (ufo::VariableNames::obscorrection_air_temperature);
+  }  // namespace handles
 
   static ProfileCheckMaker<ProfileCheckSamePDiffT> makerProfileCheckSamePDiffT_("SamePDiffT");
 
@@ -26,19 +40,19 @@ namespace ufo {
     const int numProfileLevels = profileDataHandler.getNumProfileLevels();
 
     const std::vector <float> &pressures =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+      profileDataHandler.get(handles::obs_air_pressure);
     const std::vector <float> &tObs =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_air_temperature);
+      profileDataHandler.get(handles::obs_air_temperature);
     const std::vector <float> &tBkg =
-      profileDataHandler.get<float>(ufo::VariableNames::hofx_air_temperature);
+      profileDataHandler.get(handles::hofx_air_temperature);
     std::vector <int> &tFlags =
-      profileDataHandler.get<int>(ufo::VariableNames::qcflags_air_temperature);
+      profileDataHandler.get(handles::qcflags_air_temperature);
     std::vector <int> &NumAnyErrors =
-      profileDataHandler.get<int>(ufo::VariableNames::counter_NumAnyErrors);
+      profileDataHandler.get(handles::counter_NumAnyErrors);
     std::vector <int> &NumSamePErrObs =
-      profileDataHandler.get<int>(ufo::VariableNames::counter_NumSamePErrObs);
+      profileDataHandler.get(handles::counter_NumSamePErrObs);
     const std::vector <float> &tObsCorrection =
-      profileDataHandler.get<float>(ufo::VariableNames::obscorrection_air_temperature);
+      profileDataHandler.get(handles::obscorrection_air_temperature);
 
     if (!oops::allVectorsSameNonZeroSize(pressures, tObs, tBkg, tFlags, tObsCorrection)) {
       oops::Log::debug() << "At least one vector is the wrong size. "
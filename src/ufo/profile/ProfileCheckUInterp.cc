@@ -9,6 +9,20 @@
 #include "ufo/profile/VariableNames.h"
 
 namespace ufo {
+  // Handles to the variables used below.
+  namespace handles {
+    const ProfileVariableHandle<float> obs_air_pressure(ufo::VariableNames::obs_air_pressure);
+    const ProfileVariableHandle<float> obs_eastward_wind(ufo::VariableNames::obs_eastward_wind);
+    const ProfileVariableHandle<float> obs_northward_wind(ufo::VariableNames::obs_northward_wind);
+    const ProfileVariableHandle<int> counter_NumSamePErrObs
+      (ufo::VariableNames::counter_NumSamePErrObs);
+    const ProfileVariableHandle<int> counter_NumInterpErrObs
+      (ufo::VariableNames::counter_NumInterpErrObs);
+    const ProfileVariableHandle<bool> diagflags_profile_interpolation_eastward_wind
+      (ufo::VariableNames::diagflags_profile_interpolation_eastward_wind);
+    const ProfileVariableHandle<bool> diagflags_profile_standard_level_eastward_wind
+      (ufo::VariableNames::diagflags_profile_standard_level_eastward_wind);
+  }  // namespace handles
 
   static ProfileCheckMaker<ProfileCheckUInterp> makerProfileCheckUInterp_("UInterp");
 
@@ -24,21 +38,19 @@ namespace ufo {
 
     const int numProfileLevels = profileDataHandler.getNumProfileLevels();
     const std::vector <float> &pressures =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
+      profileDataHandler.get(handles::obs_air_pressure);
     const std::vector <float> &uObs =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_eastward_wind);
+      profileDataHandler.get(handles::obs_eastward_wind);
     const std::vector <float> &vObs =
-      profileDataHandler.get<float>(ufo::VariableNames::obs_northward_wind);
+      profileDataHandler.get(handles::obs_northward_wind);
     std::vector <int> &NumSamePErrObs =
-      profileDataHandler.get<int>(ufo::VariableNames::counter_NumSamePErrObs);
+      profileDataHandler.get(handles::counter_NumSamePErrObs);
     std::vector <int> &NumInterpErrObs =
-      profileDataHandler.get<int>(ufo::VariableNames::counter_NumInterpErrObs);
+      profileDataHandler.get(handles::counter_NumInterpErrObs);
     std::vector <bool> &uDiagFlagsProfileInterp =
-      profileDataHandler.get<bool>
-      (ufo::VariableNames::diagflags_profile_interpolation_eastward_wind);
+      profileDataHandler.get(handles::diagflags_profile_interpolation_eastward_wind);
     const std::vector <bool> &uDiagFlagsProfileStdLev =
-      profileDataHandler.get<bool>
-      (ufo::VariableNames::diagflags_profile_standard_level_eastward_wind);
+      profileDataHandler.get(handles::diagflags_profile_standard_level_eastward_wind);
 
     if (!oops::allVectorsSameNonZeroSize(pressures, uObs, vObs,
                                          uDiagFlagsProfileInterp,
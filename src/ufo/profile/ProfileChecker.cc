@@ -6,6 +6,7 @@
  */
 
 #include <algorithm>
+#include <memory>
 #include <set>
 #include <utility>
 
@@ -85,9 +86,22 @@ namespace ufo {
   {
     // Run all checks requested
     for (const auto& check : subGroupChecks.checkNames) {
-      std::unique_ptr<ProfileCheckBase> profileCheck =
-        ProfileCheckFactory::create(check,
-                                    options_);
+      // Checks run on individual profiles are reused for all profiles, except when their
+      // results are compared with OPS: the validation data are filled from the checks' work
+      // arrays, which must not retain the values computed for a previous profile.
+      std::unique_ptr<ProfileCheckBase> newProfileCheck;
+      ProfileCheckBase *profileCheck = nullptr;
+      if (!subGroupChecks.runOnEntireSample && !options_.compareWithOPS.value()) {
+        std::unique_ptr<ProfileCheckBase> &instance = checkInstances_.instances[check];
+        if (!instance)
+          instance = ProfileCheckFactory::create(check,
+                                                 options_);
+        profileCheck = instance.get();
+      } else {
+        newProfileCheck = ProfileCheckFactory::create(check,
+                                                      options_);
+        profileCheck = newProfileCheck.get();
+      }
       if (profileCheck) {
         // Ensure correct type of check has been requested.
         if (profileCheck->runOnEntireSample() == subGroupChecks.runOnEntireSample) {
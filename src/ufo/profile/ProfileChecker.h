@@ -8,6 +8,7 @@
 #ifndef UFO_PROFILE_PROFILECHECKER_H_
 #define UFO_PROFILE_PROFILECHECKER_H_
 
+#include <map>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -15,6 +16,7 @@
 #include <vector>
 
 #include "ufo/filters/ConventionalProfileProcessingParameters.h"
+#include "ufo/profile/ProfileCheckBase.h"
 
 namespace ufo {
   class ProfileDataHandler;
@@ -90,6 +92,21 @@ namespace ufo {
 
     /// Names of all required obs diagnostics.
     oops::Variables obsDiagNames_;
+
+    /// Instances of the checks run on individual profiles, created when first needed and reused
+    /// for all subsequent profiles, so that their work arrays keep their capacity from one
+    /// profile to the next. Copies of the checker (such as those made for each thread) start
+    /// without any instances, so that no check is shared between threads.
+    struct CheckInstances {
+      CheckInstances() = default;
+      CheckInstances(const CheckInstances &) {}
+      CheckInstances &operator=(const CheckInstances &) {
+        instances.clear();
+        return *this;
+      }
+      std::map <std::string, std::unique_ptr<ProfileCheckBase>> instances;
+    };
+    CheckInstances checkInstances_;
   };
 }  // namespace ufo
 
@@ -18,6 +18,14 @@
 #include "ufo/profile/VariableNames.h"
 
 namespace ufo {
+  // Handles to the variables used below.
+  namespace handles {
+    const ProfileVariableHandle<int> qcflags_observation_report
+      (ufo::VariableNames::qcflags_observation_report);
+    const ProfileVariableHandle<int> counter_NumAnyErrors
+      (ufo::VariableNames::counter_NumAnyErrors);
+  }  // namespace handles
+
   ProfileDataHandler::ProfileDataHandler(const ObsFilterData &data,
                                          ioda::ObsDataVector<int> &flags,
                                          const DataHandlerParameters &options,
@@ -28,10 +36,12 @@ namespace ufo {
       flags_(flags),
       options_(options),
       filtervars_(filtervars),
-      flagged_(flagged)
+      flagged_(flagged),
+      entireSampleMutex_(std::make_shared<std::mutex>()),
+      obsPressure_(std::make_shared<std::vector<float>>())
   {
     if (data.getGeoVaLs() && data.getGeoVaLs()->nlocs() > 0) {
-      geovals_.reset(new GeoVaLs(*(data.getGeoVaLs())));
+      geovals_ = std::make_shared<const GeoVaLs>(*(data.getGeoVaLs()));
       if (geovals_->has(ufo::VariableNames::geovals_pressure)) {
         std::vector<float> vec_gv(geovals_->nlevs(ufo::VariableNames::geovals_pressure));
         geovals_->getAtLocation(vec_gv, ufo::VariableNames::geovals_pressure, 0);
@@ -51,9 +61,23 @@ namespace ufo {
     entireSampleDataHandler_.reset(new EntireSampleDataHandler(data, options));
   }
 
+  ProfileDataHandler::ProfileDataHandler(const ProfileDataHandler &other)
+    : obsdb_(other.obsdb_),
+      geovals_(other.geovals_),
+      flags_(other.flags_),
+      options_(other.options_),
+      filtervars_(other.filtervars_),
+      flagged_(other.flagged_),
+      entireSampleDataHandler_(other.entireSampleDataHandler_),
+      entireSampleMutex_(other.entireSampleMutex_),
+      obsPressure_(other.obsPressure_),
+      profileIndices_(new ProfileIndices(*other.profileIndices_))
+  {}
+
   void ProfileDataHandler::resetProfileInformation()
   {
     profileData_.clear();
+    ++generation_;
     GeoVaLData_.clear();
   }
 
@@ -63,6 +87,12 @@ namespace ufo {
     profileIndices_->updateNextProfileIndices();
   }
 
+  void ProfileDataHandler::initialiseProfile(const ProfileIndices::ProfileInfo &profile)
+  {
+    resetProfileInformation();
+    profileIndices_->setCurrentProfile(profile);
+  }
+
   void ProfileDataHandler::updateProfileInformation()
   {
     // Set final report flags in this profile.
@@ -101,6 +131,7 @@ namespace ufo {
 
   void ProfileDataHandler::updateEntireSampleData()
   {
+    std::lock_guard<std::mutex> lock(*entireSampleMutex_);
     for (const auto &it_profile : profileData_) {
       std::string fullname = it_profile.first;
       std::string varname;
@@ -146,8 +177,8 @@ namespace ufo {
 
   void ProfileDataHandler::setFinalReportFlags()
   {
-    std::vector <int> &ReportFlags = get<int>(ufo::VariableNames::qcflags_observation_report);
-    const std::vector <int> &NumAnyErrors = get<int>(ufo::VariableNames::counter_NumAnyErrors);
+    std::vector <int> &ReportFlags = get(handles::qcflags_observation_report);
+    const std::vector <int> &NumAnyErrors = get(handles::counter_NumAnyErrors);
     if (!NumAnyErrors.empty() && NumAnyErrors[0] > options_.nErrorsFail.value()) {
       oops::Log::debug() << " " << NumAnyErrors[0]
                          << " errors detected, whole profile rejected" << std::endl;
@@ -161,6 +192,8 @@ namespace ufo {
   {
     oops::Log::debug() << "   Flagging observations" << std::endl;
 
+    std::lock_guard<std::mutex> lock(*entireSampleMutex_);
+
     for (const auto& it_profile : profileData_) {
       std::string fullname = it_profile.first;
       std::string varname;
@@ -243,12 +276,20 @@ namespace ufo {
       if (geovals_ &&
           obsdb_.nlocs() > 0 &&
           geovals_->has(variableName)) {
+        std::lock_guard<std::mutex> lock(*entireSampleMutex_);
+        // Observed pressures are read once and reused for all profiles.
+        if (obsPressure_->empty()) {
+          std::string varname;
+          std::string groupname;
+          ufo::splitVarGroup(ufo::VariableNames::obs_air_pressure, varname, groupname);
+          obsPressure_->resize(obsdb_.nlocs());
+          obsdb_.get_db(groupname, varname, *obsPressure_);
+        }
         // Locations at which to retrieve the GeoVaL.
         const std::vector<std::size_t> slant_path_location =
-          ufo::getSlantPathLocations(obsdb_,
+          ufo::getSlantPathLocations(*obsPressure_,
                                      *geovals_,
                                      profileIndices_->getProfileIndices(),
-                                     ufo::VariableNames::obs_air_pressure,
                                      this->getAssociatedVerticalCoordinate(variableName));
         // Vector storing GeoVaL data for current profile.
         vec_GeoVaL_column.assign(geovals_->nlevs(variableName), 0.0);
@@ -277,8 +318,7 @@ namespace ufo {
         }
       }
       // Add GeoVaL vector to map (even if it is empty).
-      GeoVaLData_.emplace(variableName, std::move(vec_GeoVaL_column));
-      return GeoVaLData_[variableName];
+      return GeoVaLData_.emplace(variableName, std::move(vec_GeoVaL_column)).first->second;
     }
   }
 
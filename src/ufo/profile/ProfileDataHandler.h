@@ -9,6 +9,7 @@
 #define UFO_PROFILE_PROFILEDATAHANDLER_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -28,6 +29,7 @@
 #include "ufo/profile/DataHandlerParameters.h"
 #include "ufo/profile/EntireSampleDataHandler.h"
 #include "ufo/profile/ProfileIndices.h"
+#include "ufo/profile/ProfileVariableHandle.h"
 
 #include "ufo/utils/metoffice/MetOfficeQCFlags.h"
 #include "ufo/utils/StringUtils.h"
@@ -46,6 +48,11 @@ namespace ufo {
   /// \brief Retrieve and store data for individual profiles.
   /// To do this, first the vector of values in the entire data sample is retrieved
   /// then the relevant data corresponding to this profile are extracted.
+  ///
+  /// Several handlers can share the same entire data sample in order to process different
+  /// profiles concurrently (see the copy constructor). Accesses to the entire sample, the GeoVaLs
+  /// and the 'flagged' vector are then serialised; data for the current profile are private to
+  /// each handler.
   class ProfileDataHandler {
    public:
     ProfileDataHandler(const ObsFilterData &data,
@@ -55,6 +62,11 @@ namespace ufo {
                        const Variables &filtervars,
                        std::vector<std::vector<bool>> &flagged);
 
+    /// Create a handler that shares the entire data sample, GeoVaLs and 'flagged' vector
+    /// of \p other. The new handler has its own current profile, which is set with
+    /// initialiseProfile().
+    ProfileDataHandler(const ProfileDataHandler &other);
+
     /// Retrieve a vector containing the requested variable for the current profile.
     ///    -# If the variable has previously been placed in a vector, return the vector.
     ///    -# Otherwise obtain the vector from the entire data sample, as long as the entire sample
@@ -63,11 +75,6 @@ namespace ufo {
     template <typename T>
       std::vector<T>& get(const std::string &fullname)
       {
-        // Determine variable and group names
-        std::string varname;
-        std::string groupname;
-        ufo::splitVarGroup(fullname, varname, groupname);
-
         auto it_profileData = profileData_.find(fullname);
         if (it_profileData != profileData_.end()) {
           // If the vector is already present, return it.
@@ -80,18 +87,67 @@ namespace ufo {
                                       fullname + " probably has the wrong type", Here());
           }
         } else {
+          // Determine variable and group names
+          std::string varname;
+          std::string groupname;
+          ufo::splitVarGroup(fullname, varname, groupname);
+
+          std::vector <T> vec_prof;  // Vector storing data for current profile.
+          {
+            std::lock_guard<std::mutex> lock(*entireSampleMutex_);
+            // Retrieve variable vector from entire sample.
+            const std::vector <T> &vec_all = entireSampleDataHandler_->get<T>(fullname);
+            // Only proceed if the vector is not empty.
+            if (!vec_all.empty()) {
+              getProfileIndicesInEntireSample(groupname);
+              vec_prof.reserve(profileIndicesInEntireSample_.size());
+              for (const auto& profileIndex : profileIndicesInEntireSample_)
+                vec_prof.emplace_back(vec_all[profileIndex]);
+            }
+          }
+          // Add vector to map (even if it is empty).
+          it_profileData = profileData_.emplace(fullname, std::move(vec_prof)).first;
+          return boost::get<std::vector<T>> (it_profileData->second);
+        }
+      }
+
+    /// Retrieve a vector containing the variable referred to by \p handle for the current
+    /// profile. This behaves in the same way as the function that takes the name of the
+    /// variable, but once the variable has been retrieved for the current profile no further
+    /// string lookups are required.
+    template <typename T>
+      std::vector<T>& get(const ProfileVariableHandle<T> &handle)
+      {
+        const size_t id = handle.id();
+        if (id < profileDataById_.size() && profileDataById_[id].generation == generation_)
+          return boost::get<std::vector<T>> (*profileDataById_[id].data);
+
+        auto it_profileData = profileData_.find(handle.fullname());
+        if (it_profileData == profileData_.end()) {
           std::vector <T> vec_prof;  // Vector storing data for current profile.
-          // Retrieve variable vector from entire sample.
-          const std::vector <T> &vec_all = entireSampleDataHandler_->get<T>(fullname);
-          // Only proceed if the vector is not empty.
-          if (!vec_all.empty()) {
-            getProfileIndicesInEntireSample(groupname);
-            for (const auto& profileIndex : profileIndicesInEntireSample_)
-              vec_prof.emplace_back(vec_all[profileIndex]);
+          {
+            std::lock_guard<std::mutex> lock(*entireSampleMutex_);
+            // Retrieve variable vector from entire sample.
+            const std::vector <T> &vec_all = entireSampleDataHandler_->get(handle);
+            // Only proceed if the vector is not empty.
+            if (!vec_all.empty()) {
+              getProfileIndicesInEntireSample(handle.groupname());
+              vec_prof.reserve(profileIndicesInEntireSample_.size());
+              for (const auto& profileIndex : profileIndicesInEntireSample_)
+                vec_prof.emplace_back(vec_all[profileIndex]);
+            }
           }
           // Add vector to map (even if it is empty).
-          profileData_.emplace(fullname, std::move(vec_prof));
-          return boost::get<std::vector<T>> (profileData_[fullname]);
+          it_profileData = profileData_.emplace(handle.fullname(), std::move(vec_prof)).first;
+        }
+        if (id >= profileDataById_.size())
+          profileDataById_.resize(id + 1);
+        profileDataById_[id] = {&it_profileData->second, generation_};
+        try {
+          return boost::get<std::vector<T>> (it_profileData->second);
+        } catch (boost::bad_get) {
+          throw eckit::BadParameter("Template parameter passed to boost::get for " +
+                                    handle.fullname() + " probably has the wrong type", Here());
         }
       }
 
@@ -116,11 +172,12 @@ namespace ufo {
           // Add vector to map.
           profileData_.emplace(fullname, std::move(vec_in));
         }
+        const std::vector <T>& profileData = this->get<T>(fullname);
+        std::lock_guard<std::mutex> lock(*entireSampleMutex_);
         entireSampleDataHandler_->initialiseVector<T>(fullname);
         // Transfer this profile's data into the entire sample.
         getProfileIndicesInEntireSample(groupname);
         std::vector <T>& entireSampleData = entireSampleDataHandler_->get<T>(fullname);
-        const std::vector <T>& profileData = this->get<T>(fullname);
         size_t idx = 0;
         for (const auto& profileIndex : profileIndicesInEntireSample_) {
           updateValueIfPresent(profileData, idx, entireSampleData, profileIndex);
@@ -132,6 +189,14 @@ namespace ufo {
     /// Clears \p profileData_ and determines the \p profileIndices_ for the next profile.
     void initialiseNextProfile();
 
+    /// Initialise the profile \p profile (obtained from getAllProfileIndices()) prior to
+    /// applying checks. Profiles can be initialised in any order.
+    void initialiseProfile(const ProfileIndices::ProfileInfo &profile);
+
+    /// Return the indices of every profile in the sample.
+    std::vector <ProfileIndices::ProfileInfo> getAllProfileIndices()
+      {return profileIndices_->getAllProfileIndices();}
+
     /// Update information for this profile.
     /// This function calls three other functions which take the following actions:
     /// 1. Set final report flags in this profile,
@@ -207,12 +272,28 @@ namespace ufo {
     std::string getAssociatedVerticalCoordinate(const std::string & variableName) const;
 
    private:  // members
+    /// Vector of values of one variable.
+    typedef boost::variant <std::vector <int>,
+                            std::vector <float>,
+                            std::vector <std::string>,
+                            std::vector <bool>> DataVector;
+
+    /// Location of a variable in \p profileData_, valid while \p generation is equal to
+    /// \p generation_.
+    struct CachedDataVector {
+      DataVector *data = nullptr;
+      size_t generation = 0;
+    };
+
     /// Container of each variable in the current profile.
-    std::unordered_map <std::string, boost::variant
-                        <std::vector <int>,
-                         std::vector <float>,
-                         std::vector <std::string>,
-                         std::vector <bool>>> profileData_;
+    std::unordered_map <std::string, DataVector> profileData_;
+
+    /// Elements of \p profileData_ indexed by the identifiers of the variables
+    /// (see ProfileVariableHandle).
+    std::vector <CachedDataVector> profileDataById_;
+
+    /// Incremented whenever \p profileData_ is cleared, invalidating \p profileDataById_.
+    size_t generation_ = 1;
 
     /// Container of GeoVaLs in the current profile.
     std::unordered_map <std::string, std::vector <float>> GeoVaLData_;
@@ -221,7 +302,7 @@ namespace ufo {
     ioda::ObsSpace &obsdb_;
 
     /// GeoVaLs.
-    std::unique_ptr<GeoVaLs> geovals_;
+    std::shared_ptr<const GeoVaLs> geovals_;
 
     /// Filter flags
     ioda::ObsDataVector<int> &flags_;
@@ -236,7 +317,15 @@ namespace ufo {
     std::vector<std::vector<bool>> &flagged_;
 
     /// Class that handles the entire data sample.
-    std::unique_ptr <EntireSampleDataHandler> entireSampleDataHandler_;
+    std::shared_ptr <EntireSampleDataHandler> entireSampleDataHandler_;
+
+    /// Mutex serialising accesses to the entire data sample, the GeoVaLs and the
+    /// 'flagged' vector by handlers that share them.
+    std::shared_ptr <std::mutex> entireSampleMutex_;
+
+    /// Observed pressures in the entire sample, used to find slant path locations.
+    /// Filled once requested.
+    std::shared_ptr <std::vector <float>> obsPressure_;
 
     /// Class that handles profile indices.
     std::unique_ptr <ProfileIndices> profileIndices_;
@@ -22,7 +22,10 @@ namespace ufo {
     this->reset();
 
     // Determine unique profile numbers.
-    uniqueProfileNums_.insert(profileNums_.begin(), profileNums_.end());
+    uniqueProfileNums_ = profileNums_;
+    std::sort(uniqueProfileNums_.begin(), uniqueProfileNums_.end());
+    uniqueProfileNums_.erase(std::unique(uniqueProfileNums_.begin(), uniqueProfileNums_.end()),
+                             uniqueProfileNums_.end());
 
     // If not sorting observations, ensure number of profiles is consistent
     // with quantity reported by obsdb.
@@ -122,9 +125,29 @@ namespace ufo {
     }
   }
 
+  std::vector <ProfileIndices::ProfileInfo> ProfileIndices::getAllProfileIndices()
+  {
+    std::vector <ProfileInfo> profiles;
+    this->reset();
+    for (size_t jprof = 0; jprof < obsdb_.nrecs(); ++jprof) {
+      this->updateNextProfileIndices();
+      profiles.push_back({profileIndices_, numProfileLevels_, profileNumCurrent_});
+    }
+    this->reset();
+    return profiles;
+  }
+
+  void ProfileIndices::setCurrentProfile(const ProfileInfo &profile)
+  {
+    profileIndices_ = profile.indices;
+    numProfileLevels_ = profile.numProfileLevels;
+    profileNumCurrent_ = profile.profileNum;
+  }
+
   size_t ProfileIndices::getProfileNumCurrent() const
   {
-    const auto &it = uniqueProfileNums_.find(profileNumCurrent_);
+    const auto it = std::lower_bound(uniqueProfileNums_.begin(), uniqueProfileNums_.end(),
+                                     profileNumCurrent_);
     return std::distance(uniqueProfileNums_.begin(), it);
   }
 
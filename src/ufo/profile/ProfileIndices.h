@@ -11,7 +11,6 @@
 #include <map>
 #include <memory>
 #include <ostream>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -43,9 +42,26 @@ namespace ufo {
                    const DataHandlerParameters &options,
                    const std::vector <bool> &apply);
 
+    /// Indices in the entire sample of the observations in one profile.
+    struct ProfileInfo {
+      /// Indices of the observations in the profile.
+      std::vector <size_t> indices;
+      /// Number of levels to which QC checks should be applied.
+      int numProfileLevels;
+      /// Record number of the profile.
+      size_t profileNum;
+    };
+
     /// Determine indices in entire sample for the next profile.
     void updateNextProfileIndices();
 
+    /// Determine the indices of every profile in the sample, in the order in which they are
+    /// visited by updateNextProfileIndices(). The profile indices are reset afterwards.
+    std::vector <ProfileInfo> getAllProfileIndices();
+
+    /// Make \p profile (obtained from getAllProfileIndices()) the current profile.
+    void setCurrentProfile(const ProfileInfo &profile);
+
     /// Return indices for the current profile.
     const std::vector <size_t> &getProfileIndices() const {return profileIndices_;}
 
@@ -75,8 +91,8 @@ namespace ufo {
     /// Profile numbers for the entire sample.
     const std::vector <size_t> profileNums_;
 
-    /// Unique profile numbers for the entire sample.
-    std::set <size_t> uniqueProfileNums_;
+    /// Unique profile numbers for the entire sample, sorted in ascending order.
+    std::vector <size_t> uniqueProfileNums_;
 
     /// Profile index map.
     typedef std::map<std::size_t, std::vector<std::size_t>> ProfIdxMap;
@@ -94,10 +110,10 @@ namespace ufo {
     std::vector <size_t> profileIndices_;
 
     /// Number of profile levels to which QC checks should be applied.
-    int numProfileLevels_;
+    int numProfileLevels_ = 0;
 
     /// Current profile number in the sample.
-    size_t profileNumCurrent_;
+    size_t profileNumCurrent_ = 0;
 
     /// Next profile number to find in the sample.
     size_t profileNumToFind_;
@@ -0,0 +1,22 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <mutex>
+#include <unordered_map>
+
+#include "ufo/profile/ProfileVariableHandle.h"
+
+namespace ufo {
+  size_t getProfileVariableId(const std::string &fullname)
+  {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, size_t> ids;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return ids.emplace(fullname, ids.size()).first->second;
+  }
+}  // namespace ufo
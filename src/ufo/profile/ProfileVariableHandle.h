@@ -0,0 +1,58 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_PROFILE_PROFILEVARIABLEHANDLE_H_
+#define UFO_PROFILE_PROFILEVARIABLEHANDLE_H_
+
+#include <string>
+
+#include "ufo/utils/StringUtils.h"
+
+namespace ufo {
+
+  /// Return the identifier of the variable \p fullname, assigning a new one if the variable
+  /// has not been seen before. Identifiers are small consecutive integers starting from zero.
+  /// This function is thread-safe.
+  size_t getProfileVariableId(const std::string &fullname);
+
+  /// \brief Handle to a variable of type \p T stored by ProfileDataHandler and
+  /// EntireSampleDataHandler.
+  ///
+  /// The full name of the variable is split into variable and group names, and an
+  /// identifier is assigned to it, once, when the handle is created. The data handlers use
+  /// the identifier to look up the cached location of the variable's data; retrieving a
+  /// variable with a handle therefore does not involve any string processing once the
+  /// variable has been accessed for the current profile.
+  ///
+  /// Handles are usually created once per check, for example as static objects.
+  template <typename T>
+  class ProfileVariableHandle {
+   public:
+    explicit ProfileVariableHandle(const std::string &fullname)
+      : fullname_(fullname), id_(getProfileVariableId(fullname))
+    {
+      ufo::splitVarGroup(fullname_, varname_, groupname_);
+    }
+
+    /// Full name of the variable (e.g. air_temperature@ObsValue).
+    const std::string &fullname() const {return fullname_;}
+
+    /// Group of the variable (e.g. ObsValue).
+    const std::string &groupname() const {return groupname_;}
+
+    /// Identifier of the variable.
+    size_t id() const {return id_;}
+
+   private:
+    std::string fullname_;
+    std::string varname_;
+    std::string groupname_;
+    size_t id_;
+  };
+}  // namespace ufo
+
+#endif  // UFO_PROFILE_PROFILEVARIABLEHANDLE_H_
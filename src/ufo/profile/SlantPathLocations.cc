@@ -23,13 +23,21 @@ namespace ufo {
                                                  const std::string & obsVerticalCoord,
                                                  const std::string & modelVerticalCoord,
                                                  const int itermax) {
-    const float missing = util::missingValue(missing);
-
     // Get observed pressure.
     std::vector<float> pressure_obs(odb.nlocs());
     std::string obsVar, obsGroup;
     splitVarGroup(obsVerticalCoord, obsVar, obsGroup);
     odb.get_db(obsGroup, obsVar, pressure_obs);
+    return getSlantPathLocations(pressure_obs, gv, locs, modelVerticalCoord, itermax);
+  }
+
+  std::vector<std::size_t> getSlantPathLocations(const std::vector<float> & pressure_obs,
+                                                 const GeoVaLs & gv,
+                                                 const std::vector<std::size_t> & locs,
+                                                 const std::string & modelVerticalCoord,
+                                                 const int itermax) {
+    const float missing = util::missingValue(missing);
+
     // Number of levels for model pressure.
     const std::size_t nlevs_p = gv.nlevs(modelVerticalCoord);
     // Vector storing location for each level along the slant path.
@@ -44,6 +44,15 @@ namespace ufo {
                                                  const std::string & modelVerticalCoord,
                                                  const std::string & obsVerticalCoord,
                                                  const int itermax = 3);
+
+  /// Get slant path locations given the values of the observed vertical coordinate at all
+  /// locations in the sample, \p obsVerticalCoordValues. This avoids reading the vertical
+  /// coordinate from the ObsSpace when the slant path is determined for many profiles.
+  std::vector<std::size_t> getSlantPathLocations(const std::vector<float> & obsVerticalCoordValues,
+                                                 const GeoVaLs & gv,
+                                                 const std::vector<std::size_t> & locs,
+                                                 const std::string & modelVerticalCoord,
+                                                 const int itermax = 3);
 }  // namespace ufo
 
 #endif  // UFO_PROFILE_SLANTPATHLOCATIONS_H_
@@ -0,0 +1,71 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/BackgroundTaskQueue.h"
+
+#include <utility>
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+BackgroundTaskQueue &BackgroundTaskQueue::ioQueue() {
+  static BackgroundTaskQueue queue;
+  return queue;
+}
+
+// -----------------------------------------------------------------------------
+
+BackgroundTaskQueue::BackgroundTaskQueue()
+  : thread_(&BackgroundTaskQueue::run, this)
+{}
+
+// -----------------------------------------------------------------------------
+
+BackgroundTaskQueue::~BackgroundTaskQueue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_one();
+  thread_.join();
+}
+
+// -----------------------------------------------------------------------------
+
+std::future<void> BackgroundTaskQueue::push(std::function<void()> task) {
+  std::packaged_task<void()> packagedTask(std::move(task));
+  std::future<void> result = packagedTask.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(packagedTask));
+  }
+  condition_.notify_one();
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+
+void BackgroundTaskQueue::run() {
+  while (true) {
+    std::packaged_task<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      // Tasks submitted before the destructor was called are run before the thread exits.
+      if (tasks_.empty())
+        return;
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
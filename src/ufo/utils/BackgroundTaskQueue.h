@@ -0,0 +1,53 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_BACKGROUNDTASKQUEUE_H_
+#define UFO_UTILS_BACKGROUNDTASKQUEUE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include <boost/noncopyable.hpp>
+
+namespace ufo {
+
+/// \brief Runs tasks one after another, in the order in which they were submitted, on a
+/// background thread.
+///
+/// Exceptions thrown by a task are stored in the future returned by push(). The destructor
+/// waits for all submitted tasks to finish.
+class BackgroundTaskQueue : private boost::noncopyable {
+ public:
+  /// \brief Return the queue shared by all tasks writing files.
+  ///
+  /// \details The I/O libraries used by UFO (e.g. NetCDF) are not guaranteed to be thread-safe,
+  /// so tasks calling them must not run concurrently with each other.
+  static BackgroundTaskQueue &ioQueue();
+
+  BackgroundTaskQueue();
+  ~BackgroundTaskQueue();
+
+  /// \brief Submit \p task to be run on the background thread.
+  std::future<void> push(std::function<void()> task);
+
+ private:
+  void run();
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::packaged_task<void()>> tasks_;
+  bool stop_ = false;
+  std::thread thread_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_BACKGROUNDTASKQUEUE_H_
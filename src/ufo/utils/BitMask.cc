@@ -0,0 +1,95 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/BitMask.h"
+
+#include <algorithm>
+#include <bitset>
+
+#include "eckit/exception/Exceptions.h"
+
+namespace ufo {
+
+BitMask::BitMask(size_t size, bool value)
+  : size_(size), words_((size + bitsPerWord - 1) / bitsPerWord, value ? ~Word(0) : Word(0)) {
+  clearPaddingBits();
+}
+
+BitMask::BitMask(const std::vector<bool> &bits)
+  : size_(bits.size()), words_((bits.size() + bitsPerWord - 1) / bitsPerWord, Word(0)) {
+  for (size_t iword = 0; iword < words_.size(); ++iword) {
+    const size_t begin = iword * bitsPerWord;
+    const size_t end = std::min(begin + bitsPerWord, size_);
+    Word word = 0;
+    for (size_t i = begin; i < end; ++i)
+      word |= Word(bits[i]) << (i - begin);
+    words_[iword] = word;
+  }
+}
+
+size_t BitMask::count() const {
+  size_t n = 0;
+  for (Word word : words_)
+    n += std::bitset<bitsPerWord>(word).count();
+  return n;
+}
+
+bool BitMask::any() const {
+  for (Word word : words_)
+    if (word != 0)
+      return true;
+  return false;
+}
+
+BitMask &BitMask::operator&=(const BitMask &other) {
+  ASSERT(size_ == other.size_);
+  for (size_t iword = 0; iword < words_.size(); ++iword)
+    words_[iword] &= other.words_[iword];
+  return *this;
+}
+
+BitMask &BitMask::operator|=(const BitMask &other) {
+  ASSERT(size_ == other.size_);
+  for (size_t iword = 0; iword < words_.size(); ++iword)
+    words_[iword] |= other.words_[iword];
+  return *this;
+}
+
+BitMask &BitMask::andNot(const BitMask &other) {
+  ASSERT(size_ == other.size_);
+  for (size_t iword = 0; iword < words_.size(); ++iword)
+    words_[iword] &= ~other.words_[iword];
+  return *this;
+}
+
+void BitMask::flip() {
+  for (Word &word : words_)
+    word = ~word;
+  clearPaddingBits();
+}
+
+std::vector<bool> BitMask::toVector() const {
+  std::vector<bool> bits(size_, false);
+  forEachSetBit([&bits](size_t i) {bits[i] = true;});
+  return bits;
+}
+
+void BitMask::clearPaddingBits() {
+  const size_t numUsedBitsInLastWord = size_ % bitsPerWord;
+  if (numUsedBitsInLastWord != 0)
+    words_.back() &= (Word(1) << numUsedBitsInLastWord) - 1;
+}
+
+std::vector<BitMask> toBitMasks(const std::vector<std::vector<bool>> &flagged) {
+  std::vector<BitMask> masks;
+  masks.reserve(flagged.size());
+  for (const std::vector<bool> &varFlagged : flagged)
+    masks.emplace_back(varFlagged);
+  return masks;
+}
+
+}  // namespace ufo
@@ -0,0 +1,97 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_BITMASK_H_
+#define UFO_UTILS_BITMASK_H_
+
+#include <cstddef>  // for size_t
+#include <cstdint>
+#include <vector>
+
+namespace ufo {
+
+/// \brief A fixed-size sequence of bits (e.g. one per observation location) stored 64 per word.
+///
+/// Unlike std::vector<bool>, which offers only access to individual bits, this class combines
+/// masks, counts their set bits and finds them a whole word (64 locations) at a time. In
+/// particular, forEachSetBit() skips blocks of 64 unset bits in a single step, so loops over
+/// the locations flagged by a filter cost little if these are few.
+class BitMask {
+ public:
+  typedef std::uint64_t Word;
+  static constexpr size_t bitsPerWord = 64;
+
+  /// Create a mask of \p size bits, all set to \p value.
+  explicit BitMask(size_t size = 0, bool value = false);
+  /// Create a mask whose ith bit is set if and only if bits[i] is true.
+  explicit BitMask(const std::vector<bool> &bits);
+
+  size_t size() const {return size_;}
+
+  bool test(size_t i) const {return (words_[i / bitsPerWord] >> (i % bitsPerWord)) & 1u;}
+  void set(size_t i) {words_[i / bitsPerWord] |= Word(1) << (i % bitsPerWord);}
+  void reset(size_t i) {words_[i / bitsPerWord] &= ~(Word(1) << (i % bitsPerWord));}
+
+  /// Return the number of set bits.
+  size_t count() const;
+  /// Return true if any bit is set.
+  bool any() const;
+
+  /// Bitwise AND, OR and AND NOT (clearing the bits set in \p other). Both masks must have the
+  /// same size.
+  BitMask &operator&=(const BitMask &other);
+  BitMask &operator|=(const BitMask &other);
+  BitMask &andNot(const BitMask &other);
+  /// Invert all bits.
+  void flip();
+
+  /// Return the bits as a std::vector<bool>.
+  std::vector<bool> toVector() const;
+
+  /// Call \p f(i) for each index \p i of a set bit, in increasing order.
+  template <typename Function>
+  void forEachSetBit(const Function &f) const {
+    for (size_t iword = 0; iword < words_.size(); ++iword) {
+      for (Word word = words_[iword]; word != 0; word &= word - 1)
+        f(iword * bitsPerWord + lowestSetBit(word));
+    }
+  }
+
+  const std::vector<Word> &words() const {return words_;}
+
+ private:
+  /// Return the position of the lowest set bit of the nonzero word \p word.
+  static size_t lowestSetBit(Word word) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    size_t position = 0;
+    while (!(word & 1u)) {
+      word >>= 1;
+      ++position;
+    }
+    return position;
+#endif
+  }
+
+  /// Clear the unused bits of the last word, so that whole words can be counted and compared.
+  void clearPaddingBits();
+
+  size_t size_;
+  std::vector<Word> words_;
+};
+
+inline BitMask operator&(BitMask lhs, const BitMask &rhs) {return lhs &= rhs;}
+inline BitMask operator|(BitMask lhs, const BitMask &rhs) {return lhs |= rhs;}
+
+/// Pack each of the \p flagged vectors (e.g. the locations flagged by a filter for each filter
+/// variable) into a BitMask.
+std::vector<BitMask> toBitMasks(const std::vector<std::vector<bool>> &flagged);
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_BITMASK_H_
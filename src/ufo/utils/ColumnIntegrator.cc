@@ -0,0 +1,99 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/ColumnIntegrator.h"
+
+#include "eckit/exception/Exceptions.h"
+
+#include "ioda/ObsVector.h"
+
+#include "oops/util/missingValues.h"
+
+#include "ufo/GeoVaLs.h"
+#include "ufo/utils/Constants.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+ColumnIntegrator::ColumnIntegrator(const GeoVaLs &geovals, const std::string &pressureLevels,
+                                   const std::string &surfacePressure)
+  : nlocs_(geovals.nlocs()), nlayers_(0) {
+  const GeoVaLsView plev = geovals.view(pressureLevels);
+  const GeoVaLsView ps = geovals.view(surfacePressure);
+  ASSERT(plev.nlevs() >= 2);
+  nlayers_ = plev.nlevs() - 1;
+
+  // Check model fields are top-down, fail if not. As before, the first location whose top and
+  // bottom levels differ decides.
+  for (size_t loc = 0; loc < nlocs_; ++loc) {
+    const double top = plev(loc, 0);
+    const double bottom = plev(loc, nlayers_);
+    if (top == bottom) continue;
+    if (top > bottom)
+      throw eckit::BadValue("model fields must be ordered from the top down", Here());
+    break;
+  }
+
+  weights_.resize(nlocs_ * nlayers_);
+  #pragma omp parallel for schedule(static)
+  for (size_t loc = 0; loc < nlocs_; ++loc) {
+    const double *p = plev.atLocation(loc);
+    double *w = weights_.data() + loc * nlayers_;
+    for (size_t lev = 0; lev < nlayers_ - 1; ++lev)
+      w[lev] = (p[lev + 1] - p[lev]) / Constants::grav;
+    // The lowest layer extends down to the surface, with the value of the integrand in that
+    // layer (e.g. no use is made of the 2m humidity).
+    w[nlayers_ - 1] = (ps(loc, 0) - p[nlayers_ - 1]) / Constants::grav;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ColumnIntegrator::integrate(const GeoVaLs &geovals, const std::string &var,
+                                 ioda::ObsVector &result, size_t jvar) const {
+  const GeoVaLsView field = geovals.view(var);
+  ASSERT(field.nlocs() == nlocs_);
+  ASSERT(field.nlevs() >= nlayers_);
+  ASSERT(result.nlocs() == nlocs_);
+  const size_t nvars = result.nvars();
+  #pragma omp parallel for schedule(static)
+  for (size_t loc = 0; loc < nlocs_; ++loc) {
+    const double *w = weights(loc);
+    const double *f = field.atLocation(loc);
+    double sum = 0.0;
+    for (size_t lev = 0; lev < nlayers_; ++lev)
+      sum += w[lev] * f[lev];
+    result[loc * nvars + jvar] = sum;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void ColumnIntegrator::integrateAD(const ioda::ObsVector &result, GeoVaLs &geovals,
+                                   const std::string &var, size_t jvar) const {
+  ASSERT(geovals.nlocs() == nlocs_);
+  ASSERT(result.nlocs() == nlocs_);
+  const size_t nlevs = geovals.nlevs(var);
+  ASSERT(nlevs >= nlayers_);
+  double *field = geovals.data(var);
+  const double missing = util::missingValue(missing);
+  const size_t nvars = result.nvars();
+  #pragma omp parallel for schedule(static)
+  for (size_t loc = 0; loc < nlocs_; ++loc) {
+    const double value = result[loc * nvars + jvar];
+    if (value == missing) continue;
+    const double *w = weights(loc);
+    double *f = field + loc * nlevs;
+    for (size_t lev = 0; lev < nlayers_; ++lev)
+      f[lev] += w[lev] * value;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
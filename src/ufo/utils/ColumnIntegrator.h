@@ -0,0 +1,78 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_COLUMNINTEGRATOR_H_
+#define UFO_UTILS_COLUMNINTEGRATOR_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ioda {
+  class ObsVector;
+}
+
+namespace ufo {
+
+class GeoVaLs;
+
+/// \brief Mass-weighted vertical integral of layer quantities over the model column.
+///
+/// The weight of layer \c k at each location is the pressure thickness of that layer divided by
+/// the gravitational acceleration, \f$(p_{k+1} - p_k)/g\f$, where \f$p\f$ are the pressures at
+/// the model levels bounding the layers, ordered from the top down. The bottom layer extends to
+/// the surface pressure instead of the lowest model level. Integrating the specific humidity
+/// with these weights gives the total column water vapour, for example.
+///
+/// The weights depend only on the pressures, so they are computed once, when the object is
+/// constructed, and can be shared between the nonlinear, tangent linear and adjoint operators
+/// (see SharedTrajectory). They are stored contiguously for each location, in the same order as
+/// the GeoVaLs, so the integrals are computed with unit-stride loops.
+class ColumnIntegrator {
+ public:
+  /// \brief Compute the layer weights at all locations of \p geovals.
+  ///
+  /// \param geovals
+  ///   Model values at observation locations.
+  /// \param pressureLevels
+  ///   Name of the variable holding the pressures at the nlevs levels bounding the layers,
+  ///   ordered from the top down. An exception is thrown if they are ordered from the bottom up.
+  /// \param surfacePressure
+  ///   Name of the variable holding the surface pressure.
+  ColumnIntegrator(const GeoVaLs &geovals, const std::string &pressureLevels,
+                   const std::string &surfacePressure);
+
+  /// Number of locations.
+  size_t nlocs() const { return nlocs_; }
+  /// Number of layers (one fewer than the number of pressure levels).
+  size_t nlayers() const { return nlayers_; }
+  /// Pointer to the nlayers() contiguous weights at location \p loc.
+  const double *weights(size_t loc) const { return weights_.data() + loc * nlayers_; }
+
+  /// \brief Set element \p jvar of \p result at each location to the integral of the values
+  /// of variable \p var of \p geovals in the nlayers() layers at that location.
+  void integrate(const GeoVaLs &geovals, const std::string &var, ioda::ObsVector &result,
+                 size_t jvar = 0) const;
+
+  /// \brief Adjoint of integrate(): add the product of the layer weights and element \p jvar of
+  /// \p result at each location to the values of variable \p var of \p geovals in the
+  /// nlayers() layers at that location.
+  ///
+  /// Locations where \p result is missing are skipped.
+  void integrateAD(const ioda::ObsVector &result, GeoVaLs &geovals, const std::string &var,
+                   size_t jvar = 0) const;
+
+ private:
+  size_t nlocs_;
+  size_t nlayers_;
+  /// Weights of layer k at location loc, stored in element k + nlayers_ * loc.
+  std::vector<double> weights_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_COLUMNINTEGRATOR_H_
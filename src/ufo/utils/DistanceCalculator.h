@@ -8,6 +8,9 @@
 #ifndef UFO_UTILS_DISTANCECALCULATOR_H_
 #define UFO_UTILS_DISTANCECALCULATOR_H_
 
+#include <cstddef>
+#include <vector>
+
 namespace ufo
 {
 
@@ -30,6 +33,9 @@ namespace ufo
 ///                   nonspatialDistanceComponent(x, y, s) = (s*(x - y))**2
 ///                        combineDistanceComponents(x, y) = x + y
 ///                                            finalise(x) = sqrt(x).
+///
+/// The accumulate...() functions apply these operations to whole arrays of points at once.
+/// Subclasses override them with loops free of virtual calls, which the compiler can vectorise.
 class DistanceCalculator {
  public:
   virtual ~DistanceCalculator() {}
@@ -45,6 +51,46 @@ class DistanceCalculator {
   virtual float combineDistanceComponents(float componentA, float componentB) const = 0;
 
   virtual float finalise(float combinedComponents) const = 0;
+
+  /// \brief Combine the spatial distance components of a number of points with the distances
+  /// accumulated so far.
+  ///
+  /// For each i, \p distances[i] is replaced with
+  ///
+  ///   combineDistanceComponents(distances[i], spatialDistanceComponent(
+  ///     obsLatitudes[i], obsLongitudes[i], latitudeBinCenters[i], longitudeBinCenters[i],
+  ///     inverseLatitudeBinWidth, inverseLongitudeBinWidths[i])).
+  ///
+  /// All vectors must have the same length.
+  virtual void accumulateSpatialDistanceComponents(
+      const std::vector<float> &obsLatitudes, const std::vector<float> &obsLongitudes,
+      const std::vector<float> &latitudeBinCenters, const std::vector<float> &longitudeBinCenters,
+      float inverseLatitudeBinWidth, const std::vector<float> &inverseLongitudeBinWidths,
+      std::vector<float> &distances) const {
+    for (size_t i = 0; i < distances.size(); ++i)
+      distances[i] = combineDistanceComponents(
+            distances[i], spatialDistanceComponent(obsLatitudes[i], obsLongitudes[i],
+                                                   latitudeBinCenters[i], longitudeBinCenters[i],
+                                                   inverseLatitudeBinWidth,
+                                                   inverseLongitudeBinWidths[i]));
+  }
+
+  /// \brief Combine a nonspatial distance component of a number of points with the distances
+  /// accumulated so far.
+  ///
+  /// For each i, \p distances[i] is replaced with
+  ///
+  ///   combineDistanceComponents(distances[i], nonspatialDistanceComponent(
+  ///     obs[i], binCenters[i], inverseBinWidth)).
+  ///
+  /// All vectors must have the same length.
+  virtual void accumulateNonspatialDistanceComponents(
+      const std::vector<float> &obs, const std::vector<float> &binCenters,
+      float inverseBinWidth, std::vector<float> &distances) const {
+    for (size_t i = 0; i < distances.size(); ++i)
+      distances[i] = combineDistanceComponents(
+            distances[i], nonspatialDistanceComponent(obs[i], binCenters[i], inverseBinWidth));
+  }
 };
 
 }  // namespace ufo
@@ -0,0 +1,162 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_DISTRIBUTEDSORT_H_
+#define UFO_UTILS_DISTRIBUTEDSORT_H_
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "eckit/mpi/Comm.h"
+
+namespace ufo {
+
+namespace distributedsortdetail {
+
+/// Send the values in `valuesToSend[rank]` to each rank of \p comm and return the values
+/// received from each rank. The values are exchanged as raw bytes.
+template <typename T>
+std::vector<std::vector<T>> exchange(const std::vector<std::vector<T>> &valuesToSend,
+                                     const eckit::mpi::Comm &comm) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Only trivially copyable values can be exchanged");
+  std::vector<std::vector<char>> bytesToSend(valuesToSend.size());
+  for (size_t rank = 0; rank < valuesToSend.size(); ++rank) {
+    bytesToSend[rank].resize(valuesToSend[rank].size() * sizeof(T));
+    if (!valuesToSend[rank].empty())
+      std::memcpy(bytesToSend[rank].data(), valuesToSend[rank].data(), bytesToSend[rank].size());
+  }
+
+  std::vector<std::vector<char>> receivedBytes;
+  comm.allToAll(bytesToSend, receivedBytes);
+
+  std::vector<std::vector<T>> receivedValues(receivedBytes.size());
+  for (size_t rank = 0; rank < receivedBytes.size(); ++rank) {
+    receivedValues[rank].resize(receivedBytes[rank].size() / sizeof(T));
+    if (!receivedBytes[rank].empty())
+      std::memcpy(receivedValues[rank].data(), receivedBytes[rank].data(),
+                  receivedBytes[rank].size());
+  }
+  return receivedValues;
+}
+
+/// Concatenate the sorted ranges \p runs and merge them into a single sorted range.
+///
+/// Adjacent runs are merged pairwise, so elements of earlier runs precede equivalent elements
+/// of later runs.
+template <typename T, typename Compare>
+std::vector<T> mergeRuns(std::vector<std::vector<T>> &&runs, const Compare &comp) {
+  std::vector<size_t> bounds(1, 0);
+  size_t totalSize = 0;
+  for (const std::vector<T> &run : runs)
+    bounds.push_back(totalSize += run.size());
+
+  std::vector<T> result;
+  result.reserve(totalSize);
+  for (std::vector<T> &run : runs)
+    result.insert(result.end(), run.begin(), run.end());
+
+  for (size_t width = 1; width + 1 < bounds.size(); width *= 2)
+    for (size_t first = 0; first + width + 1 < bounds.size(); first += 2 * width) {
+      const size_t last = std::min(first + 2 * width, bounds.size() - 1);
+      std::inplace_merge(result.begin() + bounds[first], result.begin() + bounds[first + width],
+                         result.begin() + bounds[last], comp);
+    }
+  return result;
+}
+
+}  // namespace distributedsortdetail
+
+/// \brief Sort the values held on all ranks of \p comm using the sample sort algorithm.
+///
+/// On input, \p values contains the values held on the current rank. On output, it contains
+/// the current rank's part of the sorted sequence of all values: the values held on each rank
+/// are sorted and no value held on rank r is ordered before any value held on rank r - 1.
+/// The number of values held on each rank may change. Each rank only sorts about 1/P of the
+/// values (P being the number of ranks), unlike in the gather-then-sort approach.
+///
+/// The sort is not stable. To make the result deterministic, make sure the comparator \p comp
+/// defines a total ordering (e.g. by including a global observation index in the values and
+/// using it to break ties).
+///
+/// \tparam T
+///   A trivially copyable type.
+/// \param comp
+///   Binary function object returning true if its first argument should be ordered before the
+///   second.
+template <typename T, typename Compare = std::less<T>>
+void sampleSort(std::vector<T> &values, const eckit::mpi::Comm &comm,
+                const Compare &comp = Compare()) {
+  std::sort(values.begin(), values.end(), comp);
+  const size_t numRanks = comm.size();
+  if (numRanks == 1)
+    return;
+
+  // Pick numRanks - 1 evenly spaced samples of the local values and share them with all ranks.
+  std::vector<T> localSamples;
+  if (!values.empty())
+    for (size_t i = 1; i < numRanks; ++i)
+      localSamples.push_back(values[i * values.size() / numRanks]);
+  std::vector<std::vector<T>> receivedSamples =
+      distributedsortdetail::exchange(std::vector<std::vector<T>>(numRanks, localSamples), comm);
+
+  // Choose numRanks - 1 splitters, evenly spaced in the sorted list of all samples. All ranks
+  // receive the same samples, so they choose the same splitters.
+  std::vector<T> samples = distributedsortdetail::mergeRuns(std::move(receivedSamples), comp);
+  std::vector<T> splitters;
+  if (!samples.empty())
+    for (size_t i = 1; i < numRanks; ++i)
+      splitters.push_back(samples[i * samples.size() / numRanks]);
+
+  // Send the values lying between splitters r - 1 and r to rank r.
+  std::vector<std::vector<T>> valuesToSend(numRanks);
+  auto begin = values.begin();
+  for (size_t rank = 0; rank < numRanks; ++rank) {
+    const auto end = rank < splitters.size() ?
+          std::upper_bound(begin, values.end(), splitters[rank], comp) : values.end();
+    valuesToSend[rank].assign(begin, end);
+    begin = end;
+  }
+  values = distributedsortdetail::mergeRuns(
+        distributedsortdetail::exchange(valuesToSend, comm), comp);
+}
+
+/// \brief Stably sort a vector of values held in full on all ranks of \p comm, sharing the
+/// work between the ranks.
+///
+/// Each rank stably sorts a contiguous block of about 1/P of the values (P being the number of
+/// ranks), the sorted blocks are exchanged and merged. The result is identical to that of
+/// std::stable_sort called on each rank, but the O(N log N) sorting work is not replicated.
+///
+/// \tparam T
+///   A trivially copyable type.
+/// \param comp
+///   Binary function object returning true if its first argument should be ordered before the
+///   second.
+template <typename T, typename Compare = std::less<T>>
+void stableSortReplicated(std::vector<T> &values, const eckit::mpi::Comm &comm,
+                          const Compare &comp = Compare()) {
+  const size_t numRanks = comm.size();
+  if (numRanks == 1) {
+    std::stable_sort(values.begin(), values.end(), comp);
+    return;
+  }
+
+  const size_t rank = comm.rank();
+  std::vector<T> block(values.begin() + rank * values.size() / numRanks,
+                       values.begin() + (rank + 1) * values.size() / numRanks);
+  std::stable_sort(block.begin(), block.end(), comp);
+  values = distributedsortdetail::mergeRuns(
+        distributedsortdetail::exchange(std::vector<std::vector<T>>(numRanks, block), comm), comp);
+}
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_DISTRIBUTEDSORT_H_
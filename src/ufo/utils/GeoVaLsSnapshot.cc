@@ -0,0 +1,100 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/GeoVaLsSnapshot.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "oops/util/missingValues.h"
+#include "ufo/GeoVaLs.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+GeoVaLsSnapshot::GeoVaLsSnapshot(const GeoVaLs &geovals, const std::vector<std::string> &vars)
+  : vars_(vars), nlevs_(vars.size(), 0), values_(vars.size())
+{
+  for (size_t jvar = 0; jvar < vars_.size(); ++jvar) {
+    if (!geovals.has(vars_[jvar]))
+      continue;
+    const GeoVaLsView view = geovals.view(vars_[jvar]);
+    nlevs_[jvar] = view.nlevs();
+    values_[jvar].assign(view.data(), view.data() + view.nlevs() * view.nlocs());
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+bool GeoVaLsSnapshot::matches(const GeoVaLs &geovals) const {
+  for (size_t jvar = 0; jvar < vars_.size(); ++jvar) {
+    if (!geovals.has(vars_[jvar])) {
+      if (!values_[jvar].empty())
+        return false;
+      continue;
+    }
+    const GeoVaLsView view = geovals.view(vars_[jvar]);
+    if (view.nlevs() * view.nlocs() != values_[jvar].size() ||
+        !std::equal(values_[jvar].begin(), values_[jvar].end(), view.data()))
+      return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool GeoVaLsSnapshot::changedLocations(const GeoVaLs &geovals, double relativeTolerance,
+                                       std::vector<bool> &changed) const {
+  const double missing = util::missingValue(missing);
+  const size_t nlocs = geovals.nlocs();
+  changed.assign(nlocs, false);
+  for (size_t jvar = 0; jvar < vars_.size(); ++jvar) {
+    if (!geovals.has(vars_[jvar]))
+      return false;
+    const GeoVaLsView view = geovals.view(vars_[jvar]);
+    const size_t nlevs = nlevs_[jvar];
+    if (view.nlevs() != nlevs || view.nlocs() != nlocs || values_[jvar].size() != nlevs * nlocs)
+      return false;
+    for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+      if (changed[jloc])
+        continue;
+      const double *oldColumn = values_[jvar].data() + jloc * nlevs;
+      const double *newColumn = view.atLocation(jloc);
+      for (size_t jlev = 0; jlev < nlevs; ++jlev) {
+        const double oldValue = oldColumn[jlev];
+        const double newValue = newColumn[jlev];
+        if (oldValue == newValue)
+          continue;
+        if (oldValue == missing || newValue == missing ||
+            !(std::abs(newValue - oldValue) <= relativeTolerance * std::abs(oldValue))) {
+          changed[jloc] = true;
+          break;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void GeoVaLsSnapshot::update(const GeoVaLs &geovals, const std::vector<bool> &changed) {
+  for (size_t jvar = 0; jvar < vars_.size(); ++jvar) {
+    const GeoVaLsView view = geovals.view(vars_[jvar]);
+    const size_t nlevs = nlevs_[jvar];
+    for (size_t jloc = 0; jloc < changed.size(); ++jloc) {
+      if (changed[jloc])
+        std::copy(view.atLocation(jloc), view.atLocation(jloc) + nlevs,
+                  values_[jvar].begin() + jloc * nlevs);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
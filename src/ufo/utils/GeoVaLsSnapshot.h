@@ -0,0 +1,58 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_GEOVALSSNAPSHOT_H_
+#define UFO_UTILS_GEOVALSSNAPSHOT_H_
+
+#include <string>
+#include <vector>
+
+namespace ufo {
+
+class GeoVaLs;
+
+/// \brief Copy of the values of selected variables of a GeoVaLs object, used to recognise
+/// GeoVaLs holding the same values later on.
+class GeoVaLsSnapshot {
+ public:
+  GeoVaLsSnapshot(const GeoVaLs &geovals, const std::vector<std::string> &vars);
+
+  /// Return true if \p geovals holds the same values of the same variables as the GeoVaLs from
+  /// which the snapshot was taken.
+  bool matches(const GeoVaLs &geovals) const;
+
+  /// \brief Find the locations at which the values held by \p geovals differ from those held
+  /// by the snapshot.
+  ///
+  /// A location is considered changed if the absolute difference between the old and new
+  /// values of any variable at any level exceeds \p relativeTolerance times the absolute old
+  /// value (so any difference counts if \p relativeTolerance is 0), or if only one of them is
+  /// missing.
+  ///
+  /// \returns false (leaving \p changed unspecified) if \p geovals does not store the variables
+  /// of the snapshot on the same number of levels and locations. Otherwise returns true and
+  /// sets \p changed to a vector with one element per location, set to true at changed
+  /// locations.
+  bool changedLocations(const GeoVaLs &geovals, double relativeTolerance,
+                        std::vector<bool> &changed) const;
+
+  /// \brief Replace the values stored at the locations where \p changed is true with those
+  /// held by \p geovals.
+  ///
+  /// \p geovals must store the variables of the snapshot on the same number of levels and
+  /// locations (i.e. changedLocations() must have returned true).
+  void update(const GeoVaLs &geovals, const std::vector<bool> &changed);
+
+ private:
+  std::vector<std::string> vars_;
+  std::vector<size_t> nlevs_;
+  std::vector<std::vector<double>> values_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_GEOVALSSNAPSHOT_H_
@@ -9,6 +9,7 @@
 #define UFO_UTILS_GEODESICDISTANCECALCULATOR_H_
 
 #include <cmath>
+#include <vector>
 
 #include "ufo/utils/Constants.h"
 #include "ufo/utils/DistanceCalculator.h"
@@ -48,6 +49,35 @@ class GeodesicDistanceCalculator : public DistanceCalculator {
   float finalise(float combinedComponents) const override {
     return combinedComponents;
   }
+
+  void accumulateSpatialDistanceComponents(
+      const std::vector<float> &obsLatitudes, const std::vector<float> &obsLongitudes,
+      const std::vector<float> &latitudeBinCenters, const std::vector<float> &longitudeBinCenters,
+      float /*inverseLatitudeBinWidth*/, const std::vector<float> &/*inverseLongitudeBinWidths*/,
+      std::vector<float> &distances) const override {
+    const float deg2rad = static_cast<float>(Constants::deg2rad);
+    const float re = static_cast<float>(Constants::mean_earth_rad);  // km
+
+    const size_t n = distances.size();
+    const float *lat = obsLatitudes.data();
+    const float *lon = obsLongitudes.data();
+    const float *latCenter = latitudeBinCenters.data();
+    const float *lonCenter = longitudeBinCenters.data();
+    float *d = distances.data();
+    for (size_t i = 0; i < n; ++i) {
+      // Same expression as in spatialDistanceComponent(), so the results are identical.
+      const float q1 = std::cos((lon[i] - lonCenter[i]) * deg2rad);
+      const float q2 = std::cos((lat[i] - latCenter[i]) * deg2rad);
+      const float q3 = std::cos((lat[i] + latCenter[i]) * deg2rad);
+      d[i] += re * std::acos(0.5f*((1.0f+q1)*q2 - (1.0f-q1)*q3)) + 1.0f;
+    }
+  }
+
+  void accumulateNonspatialDistanceComponents(
+      const std::vector<float> &/*obs*/, const std::vector<float> &/*binCenters*/,
+      float /*inverseBinWidth*/, std::vector<float> &/*distances*/) const override {
+    // Nonspatial components are zero and leave the distances unchanged.
+  }
 };
 
 }  // namespace ufo
@@ -0,0 +1,71 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_GROUPEDSTATISTICS_H_
+#define UFO_UTILS_GROUPEDSTATISTICS_H_
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace ufo {
+
+/// \brief Minimum, maximum, sum and count of the values belonging to each of a set of groups
+/// (e.g. records), accumulated in a single pass over the values.
+///
+/// Typical usage:
+///
+///     GroupedStatistics<float> stats(numGroups);
+///     for (size_t i = 0; i < values.size(); ++i)
+///       if (values[i] != missing)
+///         stats.add(groupOfValue[i], values[i]);
+///     ... stats.max(group) ...
+///
+/// \tparam T
+///   An arithmetic type.
+template <typename T>
+class GroupedStatistics {
+ public:
+  explicit GroupedStatistics(size_t numGroups)
+    : sums_(numGroups, 0.0), counts_(numGroups, 0),
+      minima_(numGroups, std::numeric_limits<T>::max()),
+      maxima_(numGroups, std::numeric_limits<T>::lowest())
+  {}
+
+  /// Add \p value to the group \p group.
+  void add(size_t group, T value) {
+    sums_[group] += value;
+    ++counts_[group];
+    minima_[group] = std::min(minima_[group], value);
+    maxima_[group] = std::max(maxima_[group], value);
+  }
+
+  size_t numGroups() const { return counts_.size(); }
+
+  /// Number of values added to the group \p group.
+  size_t count(size_t group) const { return counts_[group]; }
+
+  /// Sum of the values added to the group \p group, accumulated in double precision in the order
+  /// in which they were added.
+  double sum(size_t group) const { return sums_[group]; }
+
+  /// Minimum value added to the group \p group (undefined if count(group) == 0).
+  T min(size_t group) const { return minima_[group]; }
+
+  /// Maximum value added to the group \p group (undefined if count(group) == 0).
+  T max(size_t group) const { return maxima_[group]; }
+
+ private:
+  std::vector<double> sums_;
+  std::vector<size_t> counts_;
+  std::vector<T> minima_;
+  std::vector<T> maxima_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_GROUPEDSTATISTICS_H_
@@ -0,0 +1,75 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_LOCATIONCHUNKS_H_
+#define UFO_UTILS_LOCATIONCHUNKS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <utility>
+#include <vector>
+
+namespace ufo {
+
+/// \brief Call \p f(begin, end) for each range [begin, end) of locations in \p ranges.
+///
+/// If \p parallel is true, the calls are distributed between OpenMP threads. The first
+/// exception thrown by any of them is rethrown once all calls have finished.
+template <typename Function>
+void forEachLocationRange(const std::vector<std::pair<size_t, size_t>> & ranges, bool parallel,
+                          const Function & f) {
+  const size_t nranges = ranges.size();
+  if (!parallel) {
+    for (size_t jrange = 0; jrange < nranges; ++jrange)
+      f(ranges[jrange].first, ranges[jrange].second);
+    return;
+  }
+
+  std::exception_ptr exception;
+#pragma omp parallel for schedule(dynamic, 1)
+  for (size_t jrange = 0; jrange < nranges; ++jrange) {
+    try {
+      f(ranges[jrange].first, ranges[jrange].second);
+    } catch (...) {
+#pragma omp critical (ufo_location_chunk_exception)
+      {
+        if (!exception)
+          exception = std::current_exception();
+      }
+    }
+  }
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
+/// \brief Split each range [begin, end) of locations in \p ranges into consecutive ranges of
+/// at most \p chunkSize locations (if \p chunkSize is positive) and return the result.
+inline std::vector<std::pair<size_t, size_t>> splitLocationRanges(
+    const std::vector<std::pair<size_t, size_t>> & ranges, size_t chunkSize) {
+  if (chunkSize == 0)
+    return ranges;
+  std::vector<std::pair<size_t, size_t>> chunks;
+  for (const std::pair<size_t, size_t> & range : ranges)
+    for (size_t begin = range.first; begin < range.second; begin += chunkSize)
+      chunks.emplace_back(begin, std::min(range.second, begin + chunkSize));
+  return chunks;
+}
+
+/// \brief Call \p f(begin, end) for consecutive ranges [begin, end) of at most \p chunkSize
+/// locations covering all locations from 0 to \p nlocs - 1.
+///
+/// If \p parallel is true, the calls are distributed between OpenMP threads. The first
+/// exception thrown by any of them is rethrown once all calls have finished.
+template <typename Function>
+void forEachLocationChunk(size_t nlocs, size_t chunkSize, bool parallel, const Function & f) {
+  forEachLocationRange(splitLocationRanges({{0, nlocs}}, chunkSize), parallel, f);
+}
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_LOCATIONCHUNKS_H_
@@ -0,0 +1,21 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/LogUtils.h"
+
+#include "eckit/log/Channel.h"
+
+namespace ufo {
+
+bool isLogChannelEnabled(const std::ostream &channel) {
+  // The oops::Log channels are eckit::Channels, which know whether they have any targets.
+  // Any other stream is assumed to be enabled.
+  const eckit::Channel *eckitChannel = dynamic_cast<const eckit::Channel *>(&channel);
+  return eckitChannel == nullptr || static_cast<bool>(*eckitChannel);
+}
+
+}  // namespace ufo
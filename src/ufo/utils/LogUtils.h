@@ -0,0 +1,29 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_LOGUTILS_H_
+#define UFO_UTILS_LOGUTILS_H_
+
+#include <ostream>
+
+namespace ufo {
+
+/// \brief Return true if text written to \p channel (one of the oops::Log channels, e.g.
+/// oops::Log::debug()) is output anywhere.
+///
+/// Code gathering or formatting data only in order to log them should check this first and skip
+/// the work if the channel is disabled, as it is for example for the debug channel in production
+/// runs and for all channels but the error channel on most MPI tasks:
+///
+///     if (isLogChannelEnabled(oops::Log::debug()))
+///       for (size_t i = 0; i < values.size(); ++i)
+///         oops::Log::debug() << values[i] << std::endl;
+bool isLogChannelEnabled(const std::ostream &channel);
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_LOGUTILS_H_
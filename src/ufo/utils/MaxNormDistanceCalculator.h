@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include "ufo/utils/DistanceCalculator.h"
 
@@ -44,6 +45,36 @@ class MaxNormDistanceCalculator : public DistanceCalculator
   float finalise(float combinedComponents) const override {
     return combinedComponents;
   }
+
+  void accumulateSpatialDistanceComponents(
+      const std::vector<float> &obsLatitudes, const std::vector<float> &obsLongitudes,
+      const std::vector<float> &latitudeBinCenters, const std::vector<float> &longitudeBinCenters,
+      float inverseLatitudeBinWidth, const std::vector<float> &inverseLongitudeBinWidths,
+      std::vector<float> &distances) const override {
+    const size_t n = distances.size();
+    const float *lat = obsLatitudes.data();
+    const float *lon = obsLongitudes.data();
+    const float *latCenter = latitudeBinCenters.data();
+    const float *lonCenter = longitudeBinCenters.data();
+    const float *invLonWidth = inverseLongitudeBinWidths.data();
+    float *d = distances.data();
+    for (size_t i = 0; i < n; ++i) {
+      const float latitudeComponent = std::abs(lat[i] - latCenter[i]) * inverseLatitudeBinWidth;
+      const float longitudeComponent = std::abs(lon[i] - lonCenter[i]) * invLonWidth[i];
+      d[i] = std::max(d[i], std::max(latitudeComponent, longitudeComponent));
+    }
+  }
+
+  void accumulateNonspatialDistanceComponents(
+      const std::vector<float> &obs, const std::vector<float> &binCenters,
+      float inverseBinWidth, std::vector<float> &distances) const override {
+    const size_t n = distances.size();
+    const float *x = obs.data();
+    const float *center = binCenters.data();
+    float *d = distances.data();
+    for (size_t i = 0; i < n; ++i)
+      d[i] = std::max(d[i], std::abs(x[i] - center[i]) * inverseBinWidth);
+  }
 };
 
 }  // namespace ufo
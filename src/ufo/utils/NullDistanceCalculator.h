@@ -8,6 +8,9 @@
 #ifndef UFO_UTILS_NULLDISTANCECALCULATOR_H_
 #define UFO_UTILS_NULLDISTANCECALCULATOR_H_
 
+#include <algorithm>
+#include <vector>
+
 #include "ufo/utils/DistanceCalculator.h"
 
 namespace ufo {
@@ -36,6 +39,20 @@ class NullDistanceCalculator : public DistanceCalculator {
   float finalise(float combinedComponents) const override {
     return 0.0;
   }
+
+  void accumulateSpatialDistanceComponents(
+      const std::vector<float> &obsLatitudes, const std::vector<float> &obsLongitudes,
+      const std::vector<float> &latitudeBinCenters, const std::vector<float> &longitudeBinCenters,
+      float inverseLatitudeBinWidth, const std::vector<float> &inverseLongitudeBinWidths,
+      std::vector<float> &distances) const override {
+    std::fill(distances.begin(), distances.end(), 0.0f);
+  }
+
+  void accumulateNonspatialDistanceComponents(
+      const std::vector<float> &obs, const std::vector<float> &binCenters,
+      float inverseBinWidth, std::vector<float> &distances) const override {
+    std::fill(distances.begin(), distances.end(), 0.0f);
+  }
 };
 
 }  // namespace ufo
@@ -17,6 +17,14 @@ extern "C" {
   const float gsw_rho_t_exact_f90(const float & sal, const float & temp, const float & pressure);
   const float gsw_p_from_z_f90(const float & depth, const float & latitude);
   const float gsw_pt_from_t_f90(const float & sal, const float & temp, const float & pressure);
+  // Array versions of the above, converting \p n values per call (in parallel, if OpenMP is
+  // enabled).
+  void gsw_rho_t_exact_array_f90(const int & n, const float * sal, const float * temp,
+                                 const float * pressure, float * density);
+  void gsw_p_from_z_array_f90(const int & n, const float * depth, const float * latitude,
+                              float * pressure);
+  void gsw_pt_from_t_array_f90(const int & n, const float * sal, const float * temp,
+                               const float * pressure, float * theta);
 }  // extern C
 
 }  // namespace ufo
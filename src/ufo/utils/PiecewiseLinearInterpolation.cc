@@ -8,6 +8,7 @@
 #include <stdexcept>
 #include <utility>
 
+#include "oops/util/missingValues.h"
 #include "ufo/utils/PiecewiseLinearInterpolation.h"
 #include "ufo/utils/VertInterp.interface.h"
 
@@ -29,20 +30,60 @@ double PiecewiseLinearInterpolation::operator()(double abscissa) const {
   return interpolate(abscissas_, ordinates_, abscissa);
 }
 
+std::vector<double> PiecewiseLinearInterpolation::operator()(
+    const std::vector<double> &abscissas) const {
+  const size_t nobs = abscissas.size();
+  std::vector<double> values(nobs, ordinates_[0]);
+  if (abscissas_.size() == 1 || nobs == 0) {
+    // The Fortran functions don't handle the first case correctly.
+    return values;
+  }
+
+  const int nlev = abscissas_.size();
+  const int nabscissas = nobs;
+  std::vector<int> wi(nobs);
+  std::vector<double> wf(nobs);
+  vert_interp_weights_sorted_f90(nlev, nabscissas, abscissas.data(), abscissas_.data(),
+                                 wi.data(), wf.data());
+
+  // Same as vert_interp_apply_f90, without a call per abscissa.
+  const int missingIndex = util::missingValue(missingIndex);
+  const double missing = util::missingValue(missing);
+  for (size_t i = 0; i < nobs; ++i) {
+    if (wi[i] == missingIndex) {
+      values[i] = missing;
+      continue;
+    }
+    // wi holds 1-based (Fortran) indices.
+    const double lower = ordinates_[wi[i] - 1];
+    const double upper = ordinates_[wi[i]];
+    values[i] = (lower == missing || upper == missing) ?
+          missing : lower * wf[i] + upper * (1.0 - wf[i]);
+  }
+  return values;
+}
+
 double PiecewiseLinearInterpolation::interpolate(const std::vector<double> &sortedAbscissas,
                                                  const std::vector<double> &ordinates,
                                                  double abscissa) {
-  if (sortedAbscissas.size() == 1) {
+  return interpolate(sortedAbscissas.data(), ordinates.data(), sortedAbscissas.size(), abscissa);
+}
+
+double PiecewiseLinearInterpolation::interpolate(const double *sortedAbscissas,
+                                                 const double *ordinates, size_t n,
+                                                 double abscissa) {
+  if (n == 1) {
     // The Fortran functions don't handle this case correctly.
     return ordinates[0];
   }
 
+  const int nlev = n;
   int wi = 0;
   double wf = 0.0;
-  vert_interp_weights_f90(sortedAbscissas.size(), abscissa, sortedAbscissas.data(), wi, wf);
+  vert_interp_weights_bisect_f90(nlev, abscissa, sortedAbscissas, wi, wf);
 
   double f = 0.0;
-  vert_interp_apply_f90(ordinates.size(), ordinates.data(), f, wi, wf);
+  vert_interp_apply_f90(nlev, ordinates, f, wi, wf);
 
   return f;
 }
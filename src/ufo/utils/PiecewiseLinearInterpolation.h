@@ -8,6 +8,7 @@
 #ifndef UFO_UTILS_PIECEWISELINEARINTERPOLATION_H_
 #define UFO_UTILS_PIECEWISELINEARINTERPOLATION_H_
 
+#include <cstddef>
 #include <vector>
 
 namespace ufo {
@@ -27,12 +28,28 @@ class PiecewiseLinearInterpolation
   /// \brief Evaluate the interpolated function at \p abscissa.
   double operator()(double abscissa) const;
 
+  /// \brief Evaluate the interpolated function at each element of \p abscissas.
+  ///
+  /// The results are identical to those of calls to the single-point operator() on each element.
+  /// The search for the interval bracketing each abscissa starts from the interval found for the
+  /// previous one, so sorted (or nearly sorted) abscissas are processed in time proportional to
+  /// the number of abscissas plus the number of interpolation points, rather than with a bisection
+  /// per abscissa.
+  std::vector<double> operator()(const std::vector<double> &abscissas) const;
+
   /// \brief Convenience function interpolating the data points (sortedAbscissas[i], ordinates[i])
   /// at \p abscissa without creating a PiecewiseLinearInterpolation object.
   static double interpolate(const std::vector<double> &sortedAbscissas,
                             const std::vector<double> &ordinates,
                             double abscissa);
 
+  /// \overload
+  ///
+  /// Interpolates the \p n data points (sortedAbscissas[i], ordinates[i]) held in existing arrays
+  /// (e.g. model columns viewed in place in the GeoVaLs), which must be non-empty.
+  static double interpolate(const double *sortedAbscissas, const double *ordinates, size_t n,
+                            double abscissa);
+
  private:
   std::vector<double> abscissas_;
   std::vector<double> ordinates_;
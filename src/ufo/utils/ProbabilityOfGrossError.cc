@@ -8,19 +8,24 @@
 #include "ufo/utils/ProbabilityOfGrossError.h"
 
 namespace ufo {
-  void BayesianPGEUpdate(const ProbabilityOfGrossErrorParameters &options,
-                         const std::vector<float> &obsVal,
-                         const std::vector<float> &obsErr,
-                         const std::vector<float> &bkgVal,
-                         const std::vector<float> &bkgErr,
-                         const std::vector<float> &PdBad,
-                         const bool PerformSDiffCheck,
-                         std::vector<int> &flags,
-                         std::vector<float> &PGE,
-                         float ErrVarMax,
-                         const std::vector<float> *obsVal2,
-                         const std::vector<float> *bkgVal2,
-                         std::vector<float> *TotalPd)
+namespace {
+  /// Update the PGE at the locations `location(i)`, i = 0, ..., numLocs - 1.
+  template <typename LocationFunction>
+  void bayesianPGEUpdateImpl(const ProbabilityOfGrossErrorParameters &options,
+                             const size_t numLocs,
+                             const LocationFunction &location,
+                             const std::vector<float> &obsVal,
+                             const std::vector<float> &obsErr,
+                             const std::vector<float> &bkgVal,
+                             const std::vector<float> &bkgErr,
+                             const std::vector<float> &PdBad,
+                             const bool PerformSDiffCheck,
+                             std::vector<int> &flags,
+                             std::vector<float> &PGE,
+                             float ErrVarMax,
+                             const std::vector<float> *obsVal2,
+                             const std::vector<float> *bkgVal2,
+                             std::vector<float> *TotalPd)
   {
     const float missingValueFloat = util::missingValue(1.0f);
     // PGE multiplication factor used to store PGE values for later use.
@@ -41,9 +46,6 @@ namespace ufo {
     const double SDiffCrit = obsVal2 && bkgVal2 ?
       options.PGE_SDiffCrit.value() * 2.0 :
       options.PGE_SDiffCrit.value();
-    // Number of levels in profile, or total number of single-level obs.
-    const size_t numLocs = obsVal.size();
-
     // Combined (obs and bkg) error variance.
     float ErrVar = 0.0;
     // Squared difference from background / ErrVar.
@@ -53,8 +55,10 @@ namespace ufo {
 
     const bool obsErrEmpty = obsErr.empty();
     const bool bkgErrEmpty = bkgErr.empty();
+    const bool isVector = obsVal2 && bkgVal2;
 
-    for (size_t jloc = 0; jloc < numLocs; ++jloc) {
+    for (size_t iloc = 0; iloc < numLocs; ++iloc) {
+      const size_t jloc = location(iloc);
       // Calculate combined error variance.
       if (!obsErrEmpty && !bkgErrEmpty &&
           obsErr[jloc] >= 0 && bkgErr[jloc] >= 0) {
@@ -72,7 +76,7 @@ namespace ufo {
       if (obsVal[jloc] != missingValueFloat &&
           bkgVal[jloc] != missingValueFloat &&
           ErrVar != missingValueFloat) {
-        if (obsVal2 && bkgVal2 &&
+        if (isVector &&
             (*obsVal2)[jloc] != missingValueFloat &&
             (*bkgVal2)[jloc] != missingValueFloat) {  // Vector observable.
           SDiff = (std::pow(obsVal[jloc] - bkgVal[jloc], 2) +
@@ -114,4 +118,47 @@ namespace ufo {
       }
     }
   }
+}  // namespace
+
+  void BayesianPGEUpdate(const ProbabilityOfGrossErrorParameters &options,
+                         const std::vector<float> &obsVal,
+                         const std::vector<float> &obsErr,
+                         const std::vector<float> &bkgVal,
+                         const std::vector<float> &bkgErr,
+                         const std::vector<float> &PdBad,
+                         const bool PerformSDiffCheck,
+                         std::vector<int> &flags,
+                         std::vector<float> &PGE,
+                         float ErrVarMax,
+                         const std::vector<float> *obsVal2,
+                         const std::vector<float> *bkgVal2,
+                         std::vector<float> *TotalPd)
+  {
+    // Number of levels in profile, or total number of single-level obs.
+    const size_t numLocs = obsVal.size();
+    bayesianPGEUpdateImpl(options, numLocs, [](size_t iloc) {return iloc;},
+                          obsVal, obsErr, bkgVal, bkgErr, PdBad, PerformSDiffCheck,
+                          flags, PGE, ErrVarMax, obsVal2, bkgVal2, TotalPd);
+  }
+
+  void BayesianPGEUpdate(const ProbabilityOfGrossErrorParameters &options,
+                         const std::vector<size_t> &locations,
+                         const std::vector<float> &obsVal,
+                         const std::vector<float> &obsErr,
+                         const std::vector<float> &bkgVal,
+                         const std::vector<float> &bkgErr,
+                         const std::vector<float> &PdBad,
+                         const bool PerformSDiffCheck,
+                         std::vector<int> &flags,
+                         std::vector<float> &PGE,
+                         float ErrVarMax,
+                         const std::vector<float> *obsVal2,
+                         const std::vector<float> *bkgVal2,
+                         std::vector<float> *TotalPd)
+  {
+    bayesianPGEUpdateImpl(options, locations.size(),
+                          [&locations](size_t iloc) {return locations[iloc];},
+                          obsVal, obsErr, bkgVal, bkgErr, PdBad, PerformSDiffCheck,
+                          flags, PGE, ErrVarMax, obsVal2, bkgVal2, TotalPd);
+  }
 }  // namespace ufo
@@ -52,6 +52,31 @@ namespace ufo {
                          const std::vector<float> *obsVal2 = nullptr,
                          const std::vector<float> *bkgVal2 = nullptr,
                          std::vector<float> *TotalPd = nullptr);
+
+  /// \brief Bayesian update of probability of gross error (PGE) at selected locations.
+  /// \details Equivalent to calling the overload taking no \p locations with vectors made of
+  /// the elements of \p obsVal etc. at indices \p locations, and copying the updated \p flags,
+  /// \p PGE and \p TotalPd back, but without making these copies. Elements of \p flags, \p PGE
+  /// and \p TotalPd at other indices are left unchanged.
+  ///
+  /// \param[in] locations: Indices of the locations at which to update the PGE.
+  ///
+  /// The other parameters are as above, except that all vectors (except \p obsErr and
+  /// \p bkgErr, which may be empty) must be indexable by each element of \p locations.
+  void BayesianPGEUpdate(const ProbabilityOfGrossErrorParameters &options,
+                         const std::vector<size_t> &locations,
+                         const std::vector<float> &obsVal,
+                         const std::vector<float> &obsErr,
+                         const std::vector<float> &bkgVal,
+                         const std::vector<float> &bkgErr,
+                         const std::vector<float> &PdBad,
+                         const bool ModelLevels,
+                         std::vector<int> &flags,
+                         std::vector<float> &PGE,
+                         float ErrVarMax = -1,
+                         const std::vector<float> *obsVal2 = nullptr,
+                         const std::vector<float> *bkgVal2 = nullptr,
+                         std::vector<float> *TotalPd = nullptr);
 }  // namespace ufo
 
 #endif  // UFO_UTILS_PROBABILITYOFGROSSERROR_H_
@@ -5,7 +5,6 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
-#include <algorithm>
 #include <string>
 
 #include "ioda/ObsSpace.h"
@@ -24,7 +23,28 @@ namespace ufo {
       filtervars_(filtervars),
       flags_(flags),
       retainOnlyIfAllFilterVariablesAreValid_(retainOnlyIfAllFilterVariablesAreValid)
-  {}
+  {
+    buildRecordLayout();
+  }
+
+void RecordHandler::buildRecordLayout() {
+  // Get correspondence between record numbers and indices in the total sample.
+  const std::vector<std::size_t> &recnums = obsdb_.recidx_all_recnums();
+
+  recordOffsets_.reserve(recnums.size() + 1);
+  recordLocations_.reserve(obsdb_.nlocs());
+  recordOffsets_.push_back(0);
+  for (std::size_t recnum : recnums) {
+    const std::vector<std::size_t> & locs = obsdb_.recidx_vector(recnum);
+    recordLocations_.insert(recordLocations_.end(), locs.begin(), locs.end());
+    recordOffsets_.push_back(recordLocations_.size());
+  }
+
+  recordGlobalLocations_.reserve(recordLocations_.size());
+  for (std::size_t loc : recordLocations_)
+    recordGlobalLocations_.push_back(
+          obsdb_.distribution()->globalUniqueConsecutiveLocationIndex(loc));
+}
 
 std::vector<std::size_t> RecordHandler::getLaunchPositions() const {
   const util::DateTime missingDateTime = util::missingValue(missingDateTime);
@@ -40,59 +60,58 @@ std::vector<std::size_t> RecordHandler::getLaunchPositions() const {
     indexOfFilterVariableInFlags.push_back(flags_.varnames().find(filterVariableName));
   }
 
+  // Returns true if a sufficient number of filter variables have QC flags equal to pass at
+  // location `jloc`. If `retainOnlyIfAllFilterVariablesAreValid` is true, all filter variables
+  // must have QC flags equal to pass. If it is false then at least one must have a QC flag equal
+  // to pass.
+  auto filterVarsOK = [&](size_t jloc) {
+    if (retainOnlyIfAllFilterVariablesAreValid_) {
+      for (const int idx : indexOfFilterVariableInFlags)
+        if (QCflags::isRejected(flags_[idx][jloc]))
+          return false;
+      return true;
+    } else {
+      for (const int idx : indexOfFilterVariableInFlags)
+        if (!QCflags::isRejected(flags_[idx][jloc]))
+          return true;
+      return false;
+    }
+  };
+
   // Vector of locations corresponding to profile launch positions.
-  std::vector<std::size_t> launchPositions;
+  const std::size_t numRecords = recordOffsets_.size() - 1;
+  std::vector<std::size_t> launchPositions(numRecords);
 
-  // Get correspondence between record numbers and indices in the total sample.
-  const std::vector<std::size_t> &recnums = obsdb_.recidx_all_recnums();
   // Loop over profiles.
-  for (std::size_t jprof = 0; jprof < recnums.size(); ++jprof) {
-    // Get locations corresponding to this profile.
-    std::vector<std::size_t> locs = obsdb_.recidx_vector(recnums[jprof]);
-    // Sort locs according to values of dateTime, ignoring missing values.
-    std::stable_sort(locs.begin(),
-                     locs.end(),
-                     [&](int a, int b)
-                     {return dateTimes[a] == missingDateTime ?
-                         false :
-                         (dateTimes[b] == missingDateTime ?
-                          true :
-                          dateTimes[a] < dateTimes[b]);});
-
+  for (std::size_t jprof = 0; jprof < numRecords; ++jprof) {
     // Find the location corresponding to the launch position.
     // This is defined as the location with the earliest non-missing datetime
     // and a certain number of filter variables with QC flags equal to pass.
-    // If `retainOnlyIfAllFilterVariablesAreValid` is true, all filter variables must
-    // have QC flags equal to pass. If it is false then at least one must have a
-    // QC flag equal to pass.
-    size_t launchPosition = locs.front();
-    for (const size_t jloc : locs) {
+    // Ties are resolved in favour of the location stored first in the record. If there is no such
+    // location, the location with the earliest non-missing datetime is used regardless of the
+    // QC flags (or the first location of the record if all datetimes are missing).
+    // A single pass over the record is enough to find either location.
+    const std::size_t begin = recordOffsets_[jprof];
+    const std::size_t end = recordOffsets_[jprof + 1];
+    std::size_t earliestPosition = recordLocations_[begin];
+    std::size_t launchPosition = 0;
+    bool foundEarliest = false;
+    bool foundLaunch = false;
+    for (std::size_t i = begin; i < end; ++i) {
+      const std::size_t jloc = recordLocations_[i];
       // Skip location if dateTime is missing.
       if (dateTimes[jloc] == missingDateTime) continue;
-      // Skip location if a certain number of filter variables are missing.
-      bool filterVarsOK = true;
-      if (retainOnlyIfAllFilterVariablesAreValid_) {
-        for (const int idx : indexOfFilterVariableInFlags) {
-          if (QCflags::isRejected(flags_[idx][jloc])) {
-            filterVarsOK = false;
-            break;
-          }
-        }
-      } else {
-        filterVarsOK = false;
-        for (const int idx : indexOfFilterVariableInFlags) {
-          if (!QCflags::isRejected(flags_[idx][jloc])) {
-            filterVarsOK = true;
-            break;
-          }
-        }
+      if (!foundEarliest || dateTimes[jloc] < dateTimes[earliestPosition]) {
+        earliestPosition = jloc;
+        foundEarliest = true;
       }
-      if (!filterVarsOK) continue;
-      // Launch position is current location.
+      if (foundLaunch && !(dateTimes[jloc] < dateTimes[launchPosition])) continue;
+      // Skip location if a certain number of filter variables are missing.
+      if (!filterVarsOK(jloc)) continue;
       launchPosition = jloc;
-      break;
+      foundLaunch = true;
     }
-    launchPositions.push_back(launchPosition);
+    launchPositions[jprof] = foundLaunch ? launchPosition : earliestPosition;
   }
 
   return launchPositions;
@@ -110,19 +129,16 @@ std::vector<bool> RecordHandler::changeApplyIfRecordsAreSingleObs
   // that record. All other values in the vector are set to false.
   std::vector<bool> applyRecord(obsdb_.nlocs(), false);
 
-  // Get correspondence between record numbers and indices in the total sample.
-  const std::vector<std::size_t> &recnums = obsdb_.recidx_all_recnums();
-
   // Loop over profiles.
   const std::vector<std::size_t> launchPositions = getLaunchPositions();
-  for (std::size_t jprof = 0; jprof < recnums.size(); ++jprof) {
-    // Get locations corresponding to this profile.
-    const std::vector<std::size_t> & locs = obsdb_.recidx_vector(recnums[jprof]);
+  for (std::size_t jprof = 0; jprof < launchPositions.size(); ++jprof) {
     // Logical `or` of values of apply in the entire record.
     bool applyLogicalOr = false;
-    for (std::size_t loc : locs) {
-      applyLogicalOr = applyLogicalOr || apply[loc];
-      if (applyLogicalOr) break;
+    for (std::size_t i = recordOffsets_[jprof]; i < recordOffsets_[jprof + 1]; ++i) {
+      if (apply[recordLocations_[i]]) {
+        applyLogicalOr = true;
+        break;
+      }
     }
     // Set apply at launch position to logical `or` of apply values.
     applyRecord[launchPositions[jprof]] = applyLogicalOr;
@@ -142,25 +158,24 @@ std::vector<bool> RecordHandler::changeThinnedIfRecordsAreSingleObs
   // in each record are set to logical `or` of the isThinned values in that record.
   std::vector<bool> isThinnedRecord(isThinned.size(), false);
 
-  // Get correspondence between record numbers and indices in the total sample.
-  const std::vector<std::size_t> &recnums = obsdb_.recidx_all_recnums();
-
   // Loop over profiles.
-  for (std::size_t jprof = 0; jprof < recnums.size(); ++jprof) {
-    // Get locations corresponding to this profile.
-    const std::vector<std::size_t> & locs = obsdb_.recidx_vector(recnums[jprof]);
+  const std::size_t numRecords = recordOffsets_.size() - 1;
+  for (std::size_t jprof = 0; jprof < numRecords; ++jprof) {
+    const std::size_t begin = recordOffsets_[jprof];
+    const std::size_t end = recordOffsets_[jprof + 1];
     // Logical `or` of values of isThinned in the entire record.
     bool isThinnedLogicalOr = false;
-    for (std::size_t loc : locs) {
-      const std::size_t gloc = obsdb_.distribution()->globalUniqueConsecutiveLocationIndex(loc);
-      isThinnedLogicalOr = isThinnedLogicalOr || isThinned[gloc];
-      if (isThinnedLogicalOr) break;
+    for (std::size_t i = begin; i < end; ++i) {
+      if (isThinned[recordGlobalLocations_[i]]) {
+        isThinnedLogicalOr = true;
+        break;
+      }
     }
     // Set isThinned at all locations in record to logical `or` of isThinned values.
-    for (std::size_t loc : locs) {
-      const std::size_t gloc = obsdb_.distribution()->globalUniqueConsecutiveLocationIndex(loc);
-      isThinnedRecord[gloc] = isThinnedLogicalOr;
-    }
+    // Locations are false already, so only thinned records need to be visited again.
+    if (isThinnedLogicalOr)
+      for (std::size_t i = begin; i < end; ++i)
+        isThinnedRecord[recordGlobalLocations_[i]] = true;
   }
 
   return isThinnedRecord;
@@ -189,15 +204,11 @@ void RecordHandler::checkRecordCategoriesImpl(const Variable & categoryVariableN
                 categoryVariableName.variable(),
                 categoryVariable);
 
-  // Get correspondence between record numbers and indices in the total sample.
-  const std::vector<std::size_t> &recnums = obsdb_.recidx_all_recnums();
-
   // Loop over profiles.
-  for (std::size_t jprof = 0; jprof < recnums.size(); ++jprof) {
-    // Get locations corresponding to this profile.
-    const std::vector<std::size_t> & locs = obsdb_.recidx_vector(recnums[jprof]);
-    for (std::size_t loc : locs) {
-      if (categoryVariable[loc] != categoryVariable[locs.front()]) {
+  for (std::size_t jprof = 0; jprof + 1 < recordOffsets_.size(); ++jprof) {
+    const VariableType &firstCategory = categoryVariable[recordLocations_[recordOffsets_[jprof]]];
+    for (std::size_t i = recordOffsets_[jprof] + 1; i < recordOffsets_[jprof + 1]; ++i) {
+      if (categoryVariable[recordLocations_[i]] != firstCategory) {
         throw eckit::UserError("Cannot have multiple categories per record", Here());
       }
     }
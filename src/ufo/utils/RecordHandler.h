@@ -8,6 +8,7 @@
 #ifndef UFO_UTILS_RECORDHANDLER_H_
 #define UFO_UTILS_RECORDHANDLER_H_
 
+#include <cstddef>
 #include <vector>
 
 #include "ioda/ObsDataVector.h"
@@ -74,6 +75,21 @@ class RecordHandler
   /// The default value of this parameter is false.
   const bool retainOnlyIfAllFilterVariablesAreValid_;
 
+  /// Locations of all records held on this MPI rank, stored contiguously record by record
+  /// (in the order of ObsSpace::recidx_all_recnums()). The locations of the jth record are
+  /// recordLocations_[recordOffsets_[j]], ..., recordLocations_[recordOffsets_[j + 1] - 1].
+  std::vector<std::size_t> recordLocations_;
+
+  /// Global indices of the locations stored in recordLocations_.
+  std::vector<std::size_t> recordGlobalLocations_;
+
+  /// Offsets of the first location of each record in recordLocations_, followed by the total
+  /// number of locations.
+  std::vector<std::size_t> recordOffsets_;
+
+  /// Fill recordLocations_, recordGlobalLocations_ and recordOffsets_.
+  void buildRecordLayout();
+
   /// Obtain 'launch' position associated with each record, which is the location in the record
   /// with the earliest non-missing datetime.
   std::vector<std::size_t> getLaunchPositions() const;
@@ -8,7 +8,9 @@
 #include "ufo/utils/RecursiveSplitter.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <numeric>
+#include <utility>
 
 #include "oops/util/Random.h"
 
@@ -34,31 +36,150 @@ void RecursiveSplitter::initializeEncodedGroups() {
   }
 }
 
-template <typename T>
-void RecursiveSplitter::groupByImpl(const std::vector<T> &categories) {
-  auto orderedCategory = [&](size_t index) { return categories[orderedIds_[index]]; };
+namespace {
 
-  const auto numIds = orderedIds_.size();
-  ptrdiff_t lastIndexInGroup = -1;
-  ptrdiff_t lastIndexInLastGroup = -1;
-  while (lastIndexInGroup + 1 < numIds) {
-    const size_t firstIndexInGroup = encodedGroups_[lastIndexInGroup + 1];
-    if (firstIndexInGroup + 1 >= numIds)
-      break;
-    lastIndexInGroup = encodedGroups_[firstIndexInGroup + 1];
+/// Minimum number of elements in multi-element groups for which groupBy() orders elements with
+/// integer categories by a radix sort rather than std::stable_sort.
+const size_t minNumIdsForRadixSort = 1024;
+
+/// Map \p value to an unsigned key preserving the order of values not smaller than \p minValue.
+uint64_t radixKey(int value, int minValue) {
+  return static_cast<uint64_t>(static_cast<int64_t>(value) - static_cast<int64_t>(minValue));
+}
+
+uint64_t radixKey(size_t value, size_t minValue) {
+  return static_cast<uint64_t>(value - minValue);
+}
+
+}  // namespace
 
+std::vector<std::pair<size_t, size_t>> RecursiveSplitter::multiElementGroupBounds() const {
+  std::vector<std::pair<size_t, size_t>> bounds;
+  for (Group group : multiElementGroups())
+    bounds.emplace_back(group.begin() - orderedIds_.cbegin(), group.end() - orderedIds_.cbegin());
+  return bounds;
+}
+
+template <typename T>
+void RecursiveSplitter::sortGroupsByCategory(
+    const std::vector<T> &categories, const std::vector<std::pair<size_t, size_t>> &bounds) {
+  const ptrdiff_t numGroups = bounds.size();
+  // Groups occupy disjoint ranges of orderedIds_, so they can be sorted concurrently.
+#pragma omp parallel for schedule(dynamic) if (numGroups > 1)
+  for (ptrdiff_t igroup = 0; igroup < numGroups; ++igroup) {
+    const std::vector<size_t>::iterator groupBegin = orderedIds_.begin() + bounds[igroup].first;
+    const std::vector<size_t>::iterator groupEnd = orderedIds_.begin() + bounds[igroup].second;
     if (opsCompatibilityMode_) {
-      metOfficeSort(orderedIds_.begin() + firstIndexInGroup,
-                    orderedIds_.begin() + lastIndexInGroup + 1,
-                    [&categories](size_t id) { return categories[id]; });
+      metOfficeSort(groupBegin, groupEnd, [&categories](size_t id) { return categories[id]; });
     } else {
-      std::stable_sort(orderedIds_.begin() + firstIndexInGroup,
-                       orderedIds_.begin() + lastIndexInGroup + 1,
+      std::stable_sort(groupBegin, groupEnd,
                        [&categories](size_t idA, size_t idB)
                        { return categories[idA] < categories[idB]; });
     }
+  }
+}
+
+template <typename T>
+void RecursiveSplitter::radixSortGroupsByCategory(
+    const std::vector<T> &categories, const std::vector<std::pair<size_t, size_t>> &bounds) {
+  // Ids of all elements belonging to multi-element groups, in their current order, and the index
+  // of the first element of the group to which each of them belongs.
+  std::vector<size_t> ids;
+  std::vector<size_t> groupBeginOfId(orderedIds_.size());
+  for (const std::pair<size_t, size_t> &group : bounds)
+    for (size_t index = group.first; index < group.second; ++index) {
+      ids.push_back(orderedIds_[index]);
+      groupBeginOfId[orderedIds_[index]] = group.first;
+    }
+  if (ids.empty())
+    return;
+
+  const auto minmax = std::minmax_element(ids.begin(), ids.end(),
+                                          [&categories](size_t idA, size_t idB)
+                                          { return categories[idA] < categories[idB]; });
+  const T minValue = categories[*minmax.first];
+  const uint64_t maxKey = radixKey(categories[*minmax.second], minValue);
+
+  // Sort all ids by category with a least-significant-digit radix sort using 8-bit digits. Each
+  // pass is stable, so ids with equal categories stay in their current order. Only as many passes
+  // as there are significant digits in the largest key are made.
+  const int bitsPerDigit = 8;
+  const size_t numBuckets = size_t(1) << bitsPerDigit;
+  std::vector<uint64_t> keys(ids.size());
+  for (size_t i = 0; i < ids.size(); ++i)
+    keys[i] = radixKey(categories[ids[i]], minValue);
+  std::vector<size_t> sortedIds(ids.size());
+  std::vector<uint64_t> sortedKeys(ids.size());
+  std::vector<size_t> bucketBegin(numBuckets);
+  for (int shift = 0; shift < 64 && (maxKey >> shift) != 0; shift += bitsPerDigit) {
+    std::fill(bucketBegin.begin(), bucketBegin.end(), 0);
+    for (uint64_t key : keys)
+      ++bucketBegin[(key >> shift) & (numBuckets - 1)];
+    size_t offset = 0;
+    for (size_t &begin : bucketBegin) {
+      const size_t count = begin;
+      begin = offset;
+      offset += count;
+    }
+    for (size_t i = 0; i < ids.size(); ++i) {
+      const size_t destination = bucketBegin[(keys[i] >> shift) & (numBuckets - 1)]++;
+      sortedIds[destination] = ids[i];
+      sortedKeys[destination] = keys[i];
+    }
+    ids.swap(sortedIds);
+    keys.swap(sortedKeys);
+  }
+
+  // Return each id to its group. Since ids are visited in ascending order of categories, each
+  // group ends up sorted in the same way as by std::stable_sort.
+  std::vector<size_t> nextIndexInGroup(orderedIds_.size());
+  for (const std::pair<size_t, size_t> &group : bounds)
+    nextIndexInGroup[group.first] = group.first;
+  for (size_t id : ids)
+    orderedIds_[nextIndexInGroup[groupBeginOfId[id]]++] = id;
+}
+
+template <typename T>
+void RecursiveSplitter::sortGroupsByIntegerCategory(
+    const std::vector<T> &categories, const std::vector<std::pair<size_t, size_t>> &bounds) {
+  size_t numIdsInGroups = 0;
+  for (const std::pair<size_t, size_t> &group : bounds)
+    numIdsInGroups += group.second - group.first;
+  if (!opsCompatibilityMode_ && numIdsInGroups >= minNumIdsForRadixSort)
+    radixSortGroupsByCategory(categories, bounds);
+  else
+    sortGroupsByCategory(categories, bounds);
+}
+
+void RecursiveSplitter::sortGroups(const std::vector<int> &categories,
+                                   const std::vector<std::pair<size_t, size_t>> &bounds) {
+  sortGroupsByIntegerCategory(categories, bounds);
+}
+
+void RecursiveSplitter::sortGroups(const std::vector<size_t> &categories,
+                                   const std::vector<std::pair<size_t, size_t>> &bounds) {
+  sortGroupsByIntegerCategory(categories, bounds);
+}
+
+void RecursiveSplitter::sortGroups(const std::vector<std::string> &categories,
+                                   const std::vector<std::pair<size_t, size_t>> &bounds) {
+  sortGroupsByCategory(categories, bounds);
+}
+
+template <typename T>
+void RecursiveSplitter::groupByImpl(const std::vector<T> &categories) {
+  auto orderedCategory = [&](size_t index) { return categories[orderedIds_[index]]; };
+
+  const std::vector<std::pair<size_t, size_t>> bounds = multiElementGroupBounds();
+  sortGroups(categories, bounds);
+
+  // Now update the groups
+  const auto numIds = orderedIds_.size();
+  ptrdiff_t lastIndexInLastGroup = -1;
+  for (const std::pair<size_t, size_t> &group : bounds) {
+    const size_t firstIndexInGroup = group.first;
+    const size_t lastIndexInGroup = group.second - 1;
 
-    // Now update the group
     size_t newFirstIndex = firstIndexInGroup;
     for (size_t newLastIndex = firstIndexInGroup;
          newLastIndex <= lastIndexInGroup;
@@ -12,6 +12,7 @@
 #include <cassert>
 #include <cstddef>  // for size_t
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ufo/utils/ArrowProxy.h"
@@ -278,6 +279,11 @@ class RecursiveSplitter
   ///
   ///   E_i'th element is equivalent to E_j'th element if and only if
   ///   categories[E_i] == categories[E_j].
+  ///
+  /// Unless OPS compatibility mode is on, elements with integer categories are ordered by a radix
+  /// sort if the existing multi-element classes are large enough for this to be worthwhile. The
+  /// classes are otherwise sorted concurrently on OpenMP threads. Either way the result is the
+  /// same as if each class was sorted in turn with std::stable_sort.
   void groupBy(const std::vector<size_t> &categories) {
       return groupByImpl(categories);
   }
@@ -302,6 +308,9 @@ class RecursiveSplitter
   ///
   /// The elements are ranked by keys produced by the unary function \p key taking the index
   /// of an element of the partitioned array.
+  ///
+  /// The equivalence classes are sorted concurrently on OpenMP threads, so \p key must be safe
+  /// to call from multiple threads at once.
   template <typename UnaryOperation>
   void sortGroupsBy(const UnaryOperation &key);
 
@@ -324,6 +333,29 @@ class RecursiveSplitter
   template <typename T>
   void groupByImpl(const std::vector<T> &categories);
 
+  /// Return the ranges [begin, end) of indices into orderedIds_ of multi-element classes.
+  std::vector<std::pair<size_t, size_t>> multiElementGroupBounds() const;
+
+  /// Sort the ids in each of the ranges \p bounds of orderedIds_ by category.
+  void sortGroups(const std::vector<int> &categories,
+                  const std::vector<std::pair<size_t, size_t>> &bounds);
+  void sortGroups(const std::vector<size_t> &categories,
+                  const std::vector<std::pair<size_t, size_t>> &bounds);
+  void sortGroups(const std::vector<std::string> &categories,
+                  const std::vector<std::pair<size_t, size_t>> &bounds);
+
+  template <typename T>
+  void sortGroupsByIntegerCategory(const std::vector<T> &categories,
+                                   const std::vector<std::pair<size_t, size_t>> &bounds);
+
+  template <typename T>
+  void sortGroupsByCategory(const std::vector<T> &categories,
+                            const std::vector<std::pair<size_t, size_t>> &bounds);
+
+  template <typename T>
+  void radixSortGroupsByCategory(const std::vector<T> &categories,
+                                 const std::vector<std::pair<size_t, size_t>> &bounds);
+
   bool opsCompatibilityMode_;
   /// Indices of elements of the partitioned array ordered by equivalence class.
   std::vector<size_t> orderedIds_;
@@ -333,15 +365,16 @@ class RecursiveSplitter
 
 template <typename UnaryOperation>
 void RecursiveSplitter::sortGroupsBy(const UnaryOperation &key) {
-  for (Group group : multiElementGroups()) {
-    std::vector<size_t>::iterator nonConstGroupBegin =
-        orderedIds_.begin() + (group.begin() - orderedIds_.cbegin());
-    std::vector<size_t>::iterator nonConstGroupEnd =
-        orderedIds_.begin() + (group.end() - orderedIds_.cbegin());
+  const std::vector<std::pair<size_t, size_t>> bounds = multiElementGroupBounds();
+  const ptrdiff_t numGroups = bounds.size();
+#pragma omp parallel for schedule(dynamic) if (numGroups > 1)
+  for (ptrdiff_t igroup = 0; igroup < numGroups; ++igroup) {
+    const std::vector<size_t>::iterator groupBegin = orderedIds_.begin() + bounds[igroup].first;
+    const std::vector<size_t>::iterator groupEnd = orderedIds_.begin() + bounds[igroup].second;
     if (opsCompatibilityMode_)
-      metOfficeSort(nonConstGroupBegin, nonConstGroupEnd, key);
+      metOfficeSort(groupBegin, groupEnd, key);
     else
-      std::stable_sort(nonConstGroupBegin, nonConstGroupEnd,
+      std::stable_sort(groupBegin, groupEnd,
                        [&key] (size_t a, size_t b) { return key(a) < key(b); });
   }
 }
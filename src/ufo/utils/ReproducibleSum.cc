@@ -0,0 +1,166 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/ReproducibleSum.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+
+namespace ufo {
+
+namespace {
+
+std::atomic<bool> &reproducibleFlag() {
+  static std::atomic<bool> flag(std::getenv("UFO_REPRODUCIBLE_REDUCTIONS") != nullptr);
+  return flag;
+}
+
+constexpr int64_t radix = int64_t(1) << ReproducibleSum::digitBits;
+
+/// Each term adds less than radix to each digit, so this many terms can be added before the
+/// digits need to be normalized without any risk of overflow.
+constexpr int64_t maxUnnormalized = int64_t(1) << 24;
+
+/// Weights of the digits, from the most to the least significant, and their inverses.
+struct Weights {
+  Weights() {
+    for (int i = 0; i < ReproducibleSum::ndigits; ++i) {
+      const int exponent = ReproducibleSum::minExponent +
+          ReproducibleSum::digitBits * (ReproducibleSum::ndigits - 1 - i);
+      weight[i] = std::ldexp(1.0, exponent);
+      inverse[i] = std::ldexp(1.0, -exponent);
+    }
+    limit = weight[0] * static_cast<double>(radix);
+  }
+
+  double weight[ReproducibleSum::ndigits];
+  double inverse[ReproducibleSum::ndigits];
+  /// Terms must be smaller than this in magnitude to be represented by digits.
+  double limit;
+};
+
+const Weights &weights() {
+  static const Weights weights;
+  return weights;
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+bool reproducibleReductions() {
+  return reproducibleFlag().load();
+}
+
+// -----------------------------------------------------------------------------
+
+void setReproducibleReductions(bool reproducible) {
+  reproducibleFlag().store(reproducible);
+}
+
+// -----------------------------------------------------------------------------
+
+void ReproducibleSum::add(double x) {
+  const Weights &w = weights();
+  // (isless is false for NaNs and does not raise floating-point exceptions.)
+  if (!std::isless(std::fabs(x), w.limit)) {
+    outOfRange_ += x;
+    return;
+  }
+  // Peel off the digits from the most significant. Multiplications by powers of 2 and the
+  // subtraction of the leading bits of the remainder are exact.
+  double remainder = x;
+  for (int i = 0; i < ndigits; ++i) {
+    const double digit = std::trunc(remainder * w.inverse[i]);
+    digits_[i] += static_cast<int64_t>(digit);
+    remainder -= digit * w.weight[i];
+  }
+  if (++nunnormalized_ == maxUnnormalized)
+    normalize();
+}
+
+// -----------------------------------------------------------------------------
+
+ReproducibleSum &ReproducibleSum::operator+=(const ReproducibleSum &other) {
+  ReproducibleSum normalizedOther = other;
+  normalizedOther.normalize();
+  normalize();
+  for (int i = 0; i < ndigits; ++i)
+    digits_[i] += normalizedOther.digits_[i];
+  // Each digit is now as large as if two terms had been added since normalization.
+  nunnormalized_ = 2;
+  outOfRange_ += other.outOfRange_;
+  return *this;
+}
+
+// -----------------------------------------------------------------------------
+
+void ReproducibleSum::normalize() {
+  for (int i = ndigits - 1; i > 0; --i) {
+    const int64_t carry = digits_[i] / radix;
+    digits_[i] -= carry * radix;
+    digits_[i - 1] += carry;
+  }
+  nunnormalized_ = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+double ReproducibleSum::value() const {
+  ReproducibleSum sum = *this;
+  sum.normalize();
+
+  // Give all digits the sign of the most significant non-zero one, so that the conversion
+  // below involves no cancellation.
+  int i = 0;
+  while (i < ndigits && sum.digits_[i] == 0)
+    ++i;
+  if (i < ndigits) {
+    const bool positive = sum.digits_[i] > 0;
+    for (int j = ndigits - 1; j > i; --j) {
+      if (positive && sum.digits_[j] < 0) {
+        sum.digits_[j] += radix;
+        sum.digits_[j - 1] -= 1;
+      } else if (!positive && sum.digits_[j] > 0) {
+        sum.digits_[j] -= radix;
+        sum.digits_[j - 1] += 1;
+      }
+    }
+  }
+
+  const Weights &w = weights();
+  double result = 0.0;
+  for (int j = ndigits - 1; j >= 0; --j)
+    result += static_cast<double>(sum.digits_[j]) * w.weight[j];
+  return result + outOfRange_;
+}
+
+// -----------------------------------------------------------------------------
+
+void ReproducibleSum::pack(double *packed) const {
+  ReproducibleSum sum = *this;
+  sum.normalize();
+  for (int i = 0; i < ndigits; ++i)
+    packed[i] = static_cast<double>(sum.digits_[i]);
+  packed[ndigits] = outOfRange_;
+}
+
+// -----------------------------------------------------------------------------
+
+ReproducibleSum ReproducibleSum::unpack(const double *packed) {
+  ReproducibleSum sum;
+  for (int i = 0; i < ndigits; ++i)
+    sum.digits_[i] = static_cast<int64_t>(packed[i]);
+  sum.outOfRange_ = packed[ndigits];
+  sum.normalize();
+  return sum;
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
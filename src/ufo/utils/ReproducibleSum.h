@@ -0,0 +1,107 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_REPRODUCIBLESUM_H_
+#define UFO_UTILS_REPRODUCIBLESUM_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ufo {
+
+/// \brief Return true if sums across threads and MPI tasks are to be computed so that they do
+/// not depend on the number of threads and tasks (see ReproducibleSum), and false if the
+/// faster floating-point reductions are to be used.
+///
+/// The reproducible mode is selected by setting the UFO_REPRODUCIBLE_REDUCTIONS environment
+/// variable or by calling setReproducibleReductions().
+bool reproducibleReductions();
+
+/// \brief Select the reproducible (true) or fast (false) reduction mode.
+void setReproducibleReductions(bool reproducible);
+
+/// \brief Sum of floating-point numbers that does not depend on the order in which they are
+/// added.
+///
+/// Each number is split exactly into `ndigits` signed integer digits in base
+/// 2<sup>digitBits</sup>, the least significant one having the weight 2<sup>minExponent</sup>,
+/// and the digits are summed in 64-bit integers (the fixed-point method of Hallberg and Adcroft,
+/// 2014). Integer additions are exact, so the sum is the same whatever the order of the terms,
+/// their split between threads (combined with operator+=) or between MPI tasks (combined with
+/// allReduceValues()).
+///
+/// Terms smaller in magnitude than 2<sup>minExponent</sup> (about 1.8e-46) are truncated to
+/// that resolution. Terms that cannot be represented (magnitude of 2<sup>152</sup>, about
+/// 5.7e45, or more, infinities and NaNs) are summed in floating point instead and added to the
+/// result, which is then no longer reproducible.
+class ReproducibleSum {
+ public:
+  static constexpr int digitBits = 38;
+  static constexpr int ndigits = 8;
+  static constexpr int minExponent = -4 * digitBits;
+  /// Number of doubles written by pack().
+  static constexpr size_t packedSize = ndigits + 1;
+
+  ReproducibleSum() { digits_.fill(0); }
+
+  /// Add \p x to the sum.
+  void add(double x);
+
+  /// Add the terms of \p other to this sum.
+  ReproducibleSum &operator+=(const ReproducibleSum &other);
+
+  /// Return the sum, rounded to double precision.
+  double value() const;
+
+  /// \brief Store the sum in the \c packedSize elements starting at \p packed.
+  ///
+  /// The digits are stored as doubles with integral values small enough for sums of the packed
+  /// representations of up to 2<sup>15</sup> objects to be exact, whatever the order in which
+  /// they are added. Such a sum, passed to unpack(), represents the sum of all their terms.
+  void pack(double *packed) const;
+
+  /// Return the sum stored by pack() (or the sum of several such representations) at \p packed.
+  static ReproducibleSum unpack(const double *packed);
+
+ private:
+  /// Propagate the carries so that all digits but the most significant are smaller in
+  /// magnitude than 2<sup>digitBits</sup>.
+  void normalize();
+
+  std::array<int64_t, ndigits> digits_;
+  /// Number of terms added since the last normalization.
+  int64_t nunnormalized_ = 0;
+  /// Sum of the terms that could not be represented by digits.
+  double outOfRange_ = 0.0;
+};
+
+/// \brief Sum each element of \p sums across MPI tasks and return the results.
+///
+/// \param sums
+///   Local sums.
+/// \param allReduceInPlace
+///   Function taking a std::vector<double> and replacing each of its elements with its sum over
+///   all tasks, for example a lambda calling ioda::Distribution::allReduceInPlace() or
+///   eckit::mpi::Comm::allReduceInPlace(). The sums it is given are exact in any order.
+template <typename AllReduceInPlace>
+std::vector<double> allReduceValues(const std::vector<ReproducibleSum> &sums,
+                                    const AllReduceInPlace &allReduceInPlace) {
+  std::vector<double> packed(sums.size() * ReproducibleSum::packedSize);
+  for (size_t i = 0; i < sums.size(); ++i)
+    sums[i].pack(packed.data() + i * ReproducibleSum::packedSize);
+  allReduceInPlace(packed);
+  std::vector<double> values(sums.size());
+  for (size_t i = 0; i < sums.size(); ++i)
+    values[i] = ReproducibleSum::unpack(packed.data() + i * ReproducibleSum::packedSize).value();
+  return values;
+}
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_REPRODUCIBLESUM_H_
@@ -0,0 +1,48 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_RUNONROOTTASK_H_
+#define UFO_UTILS_RUNONROOTTASK_H_
+
+#include <cstddef>
+#include <exception>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/mpi/Comm.h"
+
+namespace ufo {
+
+/// \brief Call \p task on the task of rank \p root of \p comm only.
+///
+/// This is meant for reading small files (such as bias correction coefficients) on one task
+/// and broadcasting their contents, rather than opening them on every task at the same time.
+///
+/// The call is collective. If \p task throws an exception, the exception is rethrown on the root
+/// task and an eckit::SeriousBug is thrown on the others, so that they do not wait for a
+/// broadcast that will never come.
+template <typename Task>
+void runOnRootTask(const eckit::mpi::Comm & comm, size_t root, const Task & task) {
+  std::exception_ptr exception;
+  int failed = 0;
+  if (comm.rank() == root) {
+    try {
+      task();
+    } catch (...) {
+      exception = std::current_exception();
+      failed = 1;
+    }
+  }
+  comm.broadcast(failed, root);
+  if (exception)
+    std::rethrow_exception(exception);
+  if (failed)
+    throw eckit::SeriousBug("runOnRootTask: the task has failed on the root task", Here());
+}
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_RUNONROOTTASK_H_
@@ -0,0 +1,90 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_SHAREDRESOURCE_H_
+#define UFO_UTILS_SHAREDRESOURCE_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "oops/util/Logger.h"
+
+namespace ufo {
+
+/// \brief Immutable resources loaded from files (for example covariance matrices or
+/// coefficients) that can be shared by all objects in the process using the same file and
+/// options, for instance by the filters of several ObsSpaces holding data from the same sensor.
+///
+/// Unlike SharedTrajectory, resources are kept until the end of the process (or until clear()
+/// is called): ObsFunctions are constructed anew for each evaluation, so a resource held only
+/// by its users would be loaded again by each of them.
+///
+/// \tparam Resource
+///   Type of the resource.
+template <typename Resource>
+class SharedResource {
+ public:
+  /// \brief Return the resource identified by \p key, calling \p load to load it if it has not
+  /// been loaded before.
+  ///
+  /// \param key
+  ///   String identifying the file and all options the resource depends on.
+  /// \param load
+  ///   Function taking no arguments and returning a std::shared_ptr<const Resource> (or
+  ///   std::shared_ptr<Resource>) to a newly loaded resource.
+  template <typename Load>
+  static std::shared_ptr<const Resource> get(const std::string &key, const Load &load);
+
+  /// \brief Forget all resources loaded so far. Resources still held by their users remain
+  /// valid.
+  static void clear() {
+    std::lock_guard<std::mutex> lock(mutex());
+    resources().clear();
+  }
+
+ private:
+  static std::mutex &mutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  static std::map<std::string, std::shared_ptr<const Resource>> &resources() {
+    static std::map<std::string, std::shared_ptr<const Resource>> resources;
+    return resources;
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+template <typename Resource>
+template <typename Load>
+std::shared_ptr<const Resource> SharedResource<Resource>::get(const std::string &key,
+                                                              const Load &load) {
+  {
+    std::lock_guard<std::mutex> lock(mutex());
+    auto it = resources().find(key);
+    if (it != resources().end()) {
+      oops::Log::trace() << "SharedResource: reusing " << key << std::endl;
+      return it->second;
+    }
+  }
+
+  // Loading may be expensive, so it is done without holding the lock. If another thread loads
+  // the same resource in the meantime, the copy loaded first is kept.
+  std::shared_ptr<const Resource> resource = load();
+  std::lock_guard<std::mutex> lock(mutex());
+  auto inserted = resources().emplace(key, std::move(resource));
+  oops::Log::trace() << "SharedResource: loaded " << key << std::endl;
+  return inserted.first->second;
+}
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_SHAREDRESOURCE_H_
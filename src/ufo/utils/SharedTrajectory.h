@@ -0,0 +1,125 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_SHAREDTRAJECTORY_H_
+#define UFO_UTILS_SHAREDTRAJECTORY_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "oops/util/Logger.h"
+#include "ufo/utils/GeoVaLsSnapshot.h"
+
+namespace ioda {
+class ObsSpace;
+}
+
+namespace ufo {
+
+class GeoVaLs;
+
+/// \brief Intermediate results computed by an observation operator from a GeoVaLs object
+/// (for example the output of the forward or Jacobian model) that can be handed over to other
+/// operators processing the same GeoVaLs, typically from the nonlinear operator to the
+/// linear operator at the start of each outer loop.
+///
+/// \tparam Trajectory
+///   Type of the intermediate results.
+template <typename Trajectory>
+class SharedTrajectory {
+ public:
+  /// \brief Return the trajectory computed from \p geovals for the observations held in
+  /// \p obsdb.
+  ///
+  /// \param obsdb
+  ///   ObsSpace holding the observations.
+  /// \param key
+  ///   String identifying the operator settings the trajectory depends on, used together with
+  ///   \p obsdb to look up trajectories computed previously.
+  /// \param geovals
+  ///   Model values at observation locations.
+  /// \param vars
+  ///   Variables of \p geovals the trajectory depends on.
+  /// \param compute
+  ///   Function taking no arguments and returning a std::shared_ptr<Trajectory> to a
+  ///   newly computed trajectory.
+  ///
+  /// A previously computed trajectory is returned if it was computed from exactly the same
+  /// values of \p vars; otherwise \p compute is called and its result replaces the old
+  /// trajectory for subsequent requests. As for VertInterpStencil, trajectories are kept alive
+  /// only as long as someone holds them.
+  template <typename Compute>
+  static std::shared_ptr<Trajectory> get(const ioda::ObsSpace &obsdb, const std::string &key,
+                                         const GeoVaLs &geovals,
+                                         const std::vector<std::string> &vars,
+                                         const Compute &compute);
+
+ private:
+  struct Entry {
+    std::shared_ptr<const GeoVaLsSnapshot> snapshot;
+    std::weak_ptr<Trajectory> trajectory;
+  };
+  typedef std::pair<const ioda::ObsSpace *, std::string> Key;
+
+  static std::mutex &mutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  static std::map<Key, Entry> &entries() {
+    static std::map<Key, Entry> entries;
+    return entries;
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+template <typename Trajectory>
+template <typename Compute>
+std::shared_ptr<Trajectory> SharedTrajectory<Trajectory>::get(
+    const ioda::ObsSpace &obsdb, const std::string &key, const GeoVaLs &geovals,
+    const std::vector<std::string> &vars, const Compute &compute) {
+  {
+    std::lock_guard<std::mutex> lock(mutex());
+    // Forget trajectories no longer used by any operator.
+    for (auto it = entries().begin(); it != entries().end(); ) {
+      if (it->second.trajectory.expired())
+        it = entries().erase(it);
+      else
+        ++it;
+    }
+
+    auto it = entries().find(Key(&obsdb, key));
+    if (it != entries().end()) {
+      std::shared_ptr<Trajectory> trajectory = it->second.trajectory.lock();
+      if (trajectory && it->second.snapshot->matches(geovals)) {
+        oops::Log::trace() << "SharedTrajectory: reusing trajectory for " << key << std::endl;
+        return trajectory;
+      }
+    }
+  }
+
+  // The computation may be expensive, so it is done without holding the lock.
+  auto snapshot = std::make_shared<const GeoVaLsSnapshot>(geovals, vars);
+  std::shared_ptr<Trajectory> trajectory = compute();
+  {
+    std::lock_guard<std::mutex> lock(mutex());
+    Entry &entry = entries()[Key(&obsdb, key)];
+    entry.snapshot = std::move(snapshot);
+    entry.trajectory = trajectory;
+  }
+  oops::Log::trace() << "SharedTrajectory: computed trajectory for " << key << std::endl;
+  return trajectory;
+}
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_SHAREDTRAJECTORY_H_
@@ -16,6 +16,15 @@ extern "C" {
 void vert_interp_weights_f90(const int &nlev, const double &obl, const double *vec,
                              int &wi, double &wf);
 
+/// Same as vert_interp_weights_f90, but uses bisection; \p vec must be monotonic.
+void vert_interp_weights_bisect_f90(const int &nlev, const double &obl, const double *vec,
+                                    int &wi, double &wf);
+
+/// Calculates weights for \p nobs observations located in the same monotonic column \p vec.
+/// Fastest if the observations are sorted along the column.
+void vert_interp_weights_sorted_f90(const int &nlev, const int &nobs, const double *obl,
+                                    const double *vec, int *wi, double *wf);
+
 void vert_interp_apply_f90(const int &nlev, const double *fvec,
                            double &f,
                            const int &wi, const double &wf);
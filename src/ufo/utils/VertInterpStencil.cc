@@ -0,0 +1,140 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/VertInterpStencil.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
+#include "ufo/LinearObsOperatorMatrix.h"
+#include "ufo/utils/VertInterp.interface.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<const VertInterpStencil> VertInterpStencil::get(const ioda::ObsSpace &obsdb,
+                                                                const std::string &key,
+                                                                const double *modelCoord,
+                                                                size_t nlevs,
+                                                                std::vector<double> obsCoord,
+                                                                Transform transform) {
+  typedef std::tuple<const ioda::ObsSpace *, std::string, Transform> Key;
+  static std::mutex mutex;
+  static std::map<Key, std::weak_ptr<const VertInterpStencil>> stencils;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  // Forget stencils no longer used by any operator.
+  for (auto it = stencils.begin(); it != stencils.end(); ) {
+    if (it->second.expired())
+      it = stencils.erase(it);
+    else
+      ++it;
+  }
+
+  std::weak_ptr<const VertInterpStencil> &weakStencil = stencils[Key(&obsdb, key, transform)];
+  std::shared_ptr<const VertInterpStencil> stencil = weakStencil.lock();
+  if (!stencil || !stencil->matches(modelCoord, nlevs, obsCoord)) {
+    stencil = std::make_shared<const VertInterpStencil>(modelCoord, nlevs, std::move(obsCoord),
+                                                        transform);
+    weakStencil = stencil;
+    oops::Log::trace() << "VertInterpStencil: computed stencil for " << key << std::endl;
+  }
+  return stencil;
+}
+
+// -----------------------------------------------------------------------------
+
+VertInterpStencil::VertInterpStencil(const double *modelCoord, size_t nlevs,
+                                     std::vector<double> obsCoord, Transform transform)
+  : nlevs_(nlevs), modelCoord_(modelCoord, modelCoord + nlevs * obsCoord.size()),
+    obsCoord_(std::move(obsCoord)), indices_(obsCoord_.size()), weights_(obsCoord_.size())
+{
+  const double missing = util::missingValue(missing);
+  const int nlev = nlevs_;
+  const std::ptrdiff_t nlocs = obsCoord_.size();
+
+  // Consecutive locations with identical model columns (e.g. the levels of a profile, all
+  // sampling the GeoVaLs of the same column) form a group whose weights are found in a single
+  // walk along the column rather than by a separate bisection for each location.
+  std::vector<char> startsGroup(nlocs, 1);
+#pragma omp parallel for schedule(static)
+  for (std::ptrdiff_t loc = 1; loc < nlocs; ++loc) {
+    const double *modelColumn = modelCoord_.data() + loc * nlevs_;
+    startsGroup[loc] = !std::equal(modelColumn, modelColumn + nlevs_, modelColumn - nlevs_);
+  }
+  std::vector<std::ptrdiff_t> groupBegin;
+  for (std::ptrdiff_t loc = 0; loc < nlocs; ++loc)
+    if (startsGroup[loc])
+      groupBegin.push_back(loc);
+  groupBegin.push_back(nlocs);
+  const std::ptrdiff_t ngroups = groupBegin.size() - 1;
+
+  // Groups are independent, so large ObsSpaces (e.g. radar volume scans) are split between
+  // threads.
+#pragma omp parallel
+  {
+    std::vector<double> column(nlevs_);
+    std::vector<double> transformedObsCoord;
+#pragma omp for schedule(guided)
+    for (std::ptrdiff_t group = 0; group < ngroups; ++group) {
+      const std::ptrdiff_t first = groupBegin[group];
+      const int nobs = groupBegin[group + 1] - first;
+      const double *modelColumn = modelCoord_.data() + first * nlevs_;
+      const double *obl = obsCoord_.data() + first;
+      if (transform == Transform::LOG) {
+        std::transform(modelColumn, modelColumn + nlevs_, column.begin(),
+                       [](double x) {return std::log(x);});
+        transformedObsCoord.assign(obl, obl + nobs);
+        for (double &x : transformedObsCoord)
+          if (x != missing)
+            x = std::log(x);
+        modelColumn = column.data();
+        obl = transformedObsCoord.data();
+      }
+      vert_interp_weights_sorted_f90(nlev, nobs, obl, modelColumn,
+                                     indices_.data() + first, weights_.data() + first);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+bool VertInterpStencil::matches(const double *modelCoord, size_t nlevs,
+                                const std::vector<double> &obsCoord) const {
+  return nlevs == nlevs_ && obsCoord == obsCoord_ &&
+      std::equal(modelCoord_.begin(), modelCoord_.end(), modelCoord);
+}
+
+// -----------------------------------------------------------------------------
+
+void VertInterpStencil::addToMatrix(LinearObsOperatorMatrix &matrix, size_t ivar, size_t jvar,
+                                    size_t nvars) const {
+  const int missingIndex = util::missingValue(missingIndex);
+  for (size_t loc = 0; loc < nlocs(); ++loc) {
+    const size_t row = loc * nvars + jvar;
+    if (indices_[loc] == missingIndex) {
+      matrix.setMissing(row);
+      continue;
+    }
+    const size_t lev = indices_[loc] - 1;
+    matrix.add(row, ivar, lev, loc, weights_[loc]);
+    matrix.add(row, ivar, lev + 1, loc, 1.0 - weights_[loc]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
@@ -0,0 +1,112 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_VERTINTERPSTENCIL_H_
+#define UFO_UTILS_VERTINTERPSTENCIL_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace ioda {
+class ObsSpace;
+}
+
+namespace ufo {
+class LinearObsOperatorMatrix;
+
+/// \brief Indices and weights used to interpolate model columns linearly to the vertical
+/// positions of the observations held in an ObsSpace.
+///
+/// \details For each location \c loc, indices()[loc] is the (1-based) index of the first of the
+/// two model levels bracketing the observation and weights()[loc] is the weight of that level;
+/// the next level gets the weight 1 - weights()[loc]. These are the values produced by the
+/// Fortran routine vert_interp_weights_bisect, so they can be passed directly to the
+/// vert_interp_apply* routines. Applying them, and their adjoint, is then a pure gather/scatter
+/// operation.
+///
+/// Consecutive locations sharing the same model column (such as the levels of an ocean or sonde
+/// profile) are processed together by vert_interp_weights_sorted, which walks along the column
+/// once for all of them.
+///
+/// Stencils obtained from get() are shared by all operators interpolating in the same coordinate
+/// in the same ObsSpace, so that e.g. the nonlinear and linear operators compute them only once
+/// per outer loop.
+class VertInterpStencil : private boost::noncopyable {
+ public:
+  /// Transformation applied to both the model and the observation coordinates before the
+  /// weights are computed.
+  enum class Transform {NONE, LOG};
+
+  /// \brief Return a stencil for interpolating from the model coordinate \p modelCoord to the
+  /// observation coordinate \p obsCoord.
+  ///
+  /// \param obsdb
+  ///   ObsSpace holding the observations.
+  /// \param key
+  ///   String identifying the pair of coordinates (e.g. their names), used together with
+  ///   \p obsdb and \p transform to look up stencils computed previously.
+  /// \param modelCoord
+  ///   Model coordinate: \p nlevs values at each of the obsCoord.size() locations, stored
+  ///   location by location (the layout of the GeoVaLs).
+  /// \param nlevs
+  ///   Number of model levels.
+  /// \param obsCoord
+  ///   Observation coordinate at each location. Missing values produce missing weights.
+  /// \param transform
+  ///   Transformation applied to both coordinates.
+  ///
+  /// A previously computed stencil is returned if it was calculated from exactly the same model
+  /// and observation coordinates; otherwise a new stencil is computed and replaces the old one
+  /// for subsequent requests. Stencils are kept alive only as long as someone holds them.
+  static std::shared_ptr<const VertInterpStencil> get(const ioda::ObsSpace &obsdb,
+                                                      const std::string &key,
+                                                      const double *modelCoord, size_t nlevs,
+                                                      std::vector<double> obsCoord,
+                                                      Transform transform);
+
+  /// Compute the stencil (without looking for a shared one). Parameters as in get().
+  VertInterpStencil(const double *modelCoord, size_t nlevs, std::vector<double> obsCoord,
+                    Transform transform);
+
+  /// Return true if the stencil was computed from the coordinates \p modelCoord and \p obsCoord.
+  bool matches(const double *modelCoord, size_t nlevs, const std::vector<double> &obsCoord) const;
+
+  size_t nlevs() const {return nlevs_;}
+  size_t nlocs() const {return obsCoord_.size();}
+
+  /// Index (1-based) of the first model level used at each location.
+  const std::vector<int> &indices() const {return indices_;}
+  /// Weight of the level indices()[loc] at each location.
+  const std::vector<double> &weights() const {return weights_;}
+
+  /// Number of bytes taken by the stencil and the coordinates it was computed from.
+  size_t memoryBytes() const {
+    return (modelCoord_.capacity() + obsCoord_.capacity() + weights_.capacity()) *
+        sizeof(double) + indices_.capacity() * sizeof(int);
+  }
+
+  /// \brief Add the interpolation of GeoVaL number \p ivar of \p matrix to variable number
+  /// \p jvar of an ObsVector holding \p nvars variables to \p matrix.
+  ///
+  /// Rows of locations with a missing observation coordinate are marked as missing.
+  void addToMatrix(LinearObsOperatorMatrix &matrix, size_t ivar, size_t jvar,
+                   size_t nvars) const;
+
+ private:
+  size_t nlevs_;
+  std::vector<double> modelCoord_;
+  std::vector<double> obsCoord_;
+  std::vector<int> indices_;
+  std::vector<double> weights_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_VERTINTERPSTENCIL_H_
@@ -6,9 +6,13 @@
  */
 
 #include <algorithm>           // sort
+#include <cstdint>             // uint32_t
+#include <cstring>             // memcpy
 #include <functional>          // greater
 #include <limits>              // std::numeric_limits
 #include <list>                // list
+#include <map>
+#include <mutex>
 #include <sstream>             // stringstream
 #include <utility>             // pair
 
@@ -71,6 +75,112 @@ class SortVisitor : public boost::static_visitor<void> {
 };
 
 
+/// \brief Boost visitor returning the size of a vector.
+class SizeVisitor : public boost::static_visitor<size_t> {
+ public:
+  template <typename T>
+  size_t operator()(const std::vector<T> &values) const {
+    return values.size();
+  }
+};
+
+
+/// \brief Boost visitor which allows us to group observation locations by the values of a
+/// variable.
+class GroupLocationsVisitor : public boost::static_visitor<void> {
+ public:
+  explicit GroupLocationsVisitor(ufo::RecursiveSplitter &splitter) : splitter(splitter) {}
+
+  template <typename T>
+  void operator()(const std::vector<T> &values) {
+    splitter.groupBy(values);
+  }
+
+  void operator()(const std::vector<float> &values) {
+    // Group by bit pattern, so that only locations with identical values share a group.
+    std::vector<size_t> bits(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      std::uint32_t valueBits;
+      std::memcpy(&valueBits, &values[i], sizeof(valueBits));
+      bits[i] = valueBits;
+    }
+    splitter.groupBy(bits);
+  }
+
+  ufo::RecursiveSplitter &splitter;
+};
+
+
+/// \brief Boost visitor checking if a variable has identical values at two observation locations.
+class SameValuesVisitor : public boost::static_visitor<bool> {
+ public:
+  SameValuesVisitor(size_t iloc, size_t jloc) : iloc(iloc), jloc(jloc) {}
+
+  template <typename T>
+  bool operator()(const std::vector<T> &values) const {
+    return values[iloc] == values[jloc];
+  }
+
+  bool operator()(const std::vector<float> &values) const {
+    // Compare bit patterns, consistently with GroupLocationsVisitor.
+    return std::memcmp(&values[iloc], &values[jloc], sizeof(float)) == 0;
+  }
+
+  size_t iloc;
+  size_t jloc;
+};
+
+
+/// \brief Boost visitor passing the values of variables at an observation location to
+/// DataExtractor::extract().
+template <typename ExtractedValue>
+class ExtractAtLocationVisitor : public boost::static_visitor<void> {
+ public:
+  ExtractAtLocationVisitor(ufo::DataExtractor<ExtractedValue> &extractor, size_t iloc) :
+    extractor(extractor), iloc(iloc) {}
+
+  template <typename T>
+  void operator()(const std::vector<T> &values) {
+    extractor.extract(values[iloc]);
+  }
+
+  template <typename T, typename R>
+  void operator()(const std::vector<T> &values1, const std::vector<R> &values2) {
+    extractor.extract(values1[iloc], values2[iloc]);
+  }
+
+  ufo::DataExtractor<ExtractedValue> &extractor;
+  size_t iloc;
+};
+
+
+/// \brief Process-wide cache of the data loaded and sorted by DataExtractors producing values of
+/// type `ExtractedValue`.
+///
+/// Sorted data are kept until the end of the process. Unsorted data are kept only while they are
+/// held by a DataExtractor, since they are needed only to sort the data in a new way.
+template <typename ExtractedValue>
+struct DataExtractorCache {
+  typedef std::shared_ptr<const DataExtractorInput<ExtractedValue>> InputPtr;
+
+  static DataExtractorCache &instance() {
+    static DataExtractorCache cache;
+    return cache;
+  }
+
+  /// \brief Return the key identifying data loaded from group \p group of file \p filepath.
+  static std::string loadKey(const std::string &filepath, const std::string &group) {
+    return filepath + '\n' + group;
+  }
+
+  std::mutex mutex;
+  /// Unsorted data, keyed by loadKey().
+  std::map<std::string, std::weak_ptr<const DataExtractorInput<ExtractedValue>>> loaded;
+  /// Sorted data, keyed by loadKey() followed by the names of the coordinates sorted by.
+  std::map<std::string, InputPtr> sorted;
+};
+
+
 /// \brief Update our extract constraint based on an exact match against the specified coordinate
 /// indexing a dimension of the payload array.
 ///
@@ -411,34 +521,42 @@ float linearInterpolation(
 
 template <typename ExtractedValue>
 DataExtractor<ExtractedValue>::DataExtractor(const std::string &filepath,
-                                             const std::string &group) {
-  // Read the data from the file
-  load(filepath, group);
+                                             const std::string &group)
+  : filepath_(filepath), group_(group) {
+  typedef DataExtractorCache<ExtractedValue> Cache;
+  Cache &cache = Cache::instance();
+  const std::string loadKey = Cache::loadKey(filepath, group);
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    input_ = cache.loaded[loadKey].lock();
+    if (!input_) {
+      // Until sort() is called, the data are used only to validate the calls to scheduleSort(),
+      // so data sorted by a different DataExtractor will do.
+      const auto sortedIt = cache.sorted.lower_bound(loadKey + '\n');
+      if (sortedIt != cache.sorted.end() &&
+          sortedIt->first.compare(0, loadKey.size() + 1, loadKey + '\n') == 0) {
+        input_ = sortedIt->second;
+      } else {
+        // Read the data from the file
+        input_ = load(filepath, group);
+        cache.loaded[loadKey] = input_;
+      }
+    }
+  }
+  // Set the unconstrained size of matching ranges along all axes of the payload array.
+  for (size_t i = 0; i < constrainedRanges_.size(); ++i)
+    constrainedRanges_[i] = ConstrainedRange(input_->payloadArray.shape()[i]);
   // Start by constraining to the full range of our data
   resetExtract();
-  // Initialise splitter for each dimension
-  splitter_.emplace_back(ufo::RecursiveSplitter(interpolatedArray_.shape()[0]));
-  splitter_.emplace_back(ufo::RecursiveSplitter(interpolatedArray_.shape()[1]));
-  splitter_.emplace_back(ufo::RecursiveSplitter(interpolatedArray_.shape()[2]));
 }
 
 
 template <typename ExtractedValue>
-void DataExtractor<ExtractedValue>::load(const std::string &filepath,
-                                         const std::string &interpolatedArrayGroup) {
+std::shared_ptr<const DataExtractorInput<ExtractedValue>> DataExtractor<ExtractedValue>::load(
+    const std::string &filepath, const std::string &interpolatedArrayGroup) {
   std::unique_ptr<DataExtractorBackend<ExtractedValue>> backend = createBackendFor(filepath);
-  DataExtractorInput<ExtractedValue> input = backend->loadData(interpolatedArrayGroup);
-  coord2DimMapping_ = std::move(input.coord2DimMapping);
-  dim2CoordMapping_ = std::move(input.dim2CoordMapping);
-  coordNDims_ = std::move(input.coordNDims);
-  coordsVals_ = std::move(input.coordsVals);
-  interpolatedArray_.resize(boost::extents[input.payloadArray.shape()[0]]
-                                            [input.payloadArray.shape()[1]]
-                                            [input.payloadArray.shape()[2]]);
-  interpolatedArray_ = std::move(input.payloadArray);
-  // Set the unconstrained size of matching ranges along both axes of the payload array.
-  for (size_t i = 0; i < constrainedRanges_.size(); ++i)
-    constrainedRanges_[i] = ConstrainedRange(input.payloadArray.shape()[i]);
+  return std::make_shared<DataExtractorInput<ExtractedValue>>(
+        backend->loadData(interpolatedArrayGroup));
 }
 
 
@@ -459,24 +577,69 @@ DataExtractor<ExtractedValue>::createBackendFor(const std::string &filepath) {
 
 template <typename ExtractedValue>
 void DataExtractor<ExtractedValue>::sort() {
-  DataExtractorPayload<ExtractedValue> sortedArray = interpolatedArray_;
-  nextCoordToExtractBy_ = coordsToExtractBy_.begin();
+  typedef DataExtractorCache<ExtractedValue> Cache;
+  Cache &cache = Cache::instance();
+  const std::string loadKey = Cache::loadKey(filepath_, group_);
+  std::string sortKey = loadKey;
+  for (const Coordinate &coord : coordsToExtractBy_)
+    sortKey += '\n' + ioda::convertV1PathToV2Path(coord.name);
+
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    const auto sortedIt = cache.sorted.find(sortKey);
+    if (sortedIt != cache.sorted.end()) {
+      input_ = sortedIt->second;
+    } else {
+      typename Cache::InputPtr loadedInput = cache.loaded[loadKey].lock();
+      if (!loadedInput) {
+        loadedInput = load(filepath_, group_);
+        cache.loaded[loadKey] = loadedInput;
+      }
+      input_ = sortedCopy(*loadedInput);
+      cache.sorted[sortKey] = input_;
+    }
+  }
+
+  // Point the coordinates at their sorted values.
+  for (Coordinate &coord : coordsToExtractBy_)
+    coord.values = &input_->coordsVals.at(ioda::convertV1PathToV2Path(coord.name));
+  sorted_ = true;
+  resetExtract();
+}
 
-  for (size_t dim = 0; dim < dim2CoordMapping_.size(); ++dim) {
-    if (interpolatedArray_.shape()[dim] == 1)  // Avoid sorting scalar coordinates
+
+template <typename ExtractedValue>
+std::shared_ptr<const DataExtractorInput<ExtractedValue>> DataExtractor<ExtractedValue>::sortedCopy(
+    const DataExtractorInput<ExtractedValue> &input) const {
+  std::shared_ptr<DataExtractorInput<ExtractedValue>> sortedInput =
+      std::make_shared<DataExtractorInput<ExtractedValue>>(input);
+  DataExtractorPayload<ExtractedValue> &interpolatedArray = sortedInput->payloadArray;
+  DataExtractorPayload<ExtractedValue> sortedArray = interpolatedArray;
+
+  // Initialise splitter for each dimension and split it by the successive coordinates
+  std::vector<ufo::RecursiveSplitter> splitter;
+  for (size_t dim = 0; dim < interpolatedArray.dimensionality; ++dim)
+    splitter.emplace_back(ufo::RecursiveSplitter(interpolatedArray.shape()[dim]));
+  for (const Coordinate &coord : coordsToExtractBy_) {
+    SortUpdateVisitor visitor(splitter[static_cast<size_t>(coord.payloadDim)]);
+    boost::apply_visitor(visitor, input.coordsVals.at(ioda::convertV1PathToV2Path(coord.name)));
+  }
+
+  for (size_t dim = 0; dim < sortedInput->dim2CoordMapping.size(); ++dim) {
+    if (interpolatedArray.shape()[dim] == 1)  // Avoid sorting scalar coordinates
       continue;
 
     // Reorder coordinates
-    for (auto &coord : dim2CoordMapping_[dim]) {
-      auto &coordVal = coordsVals_[coord];
-      SortVisitor visitor(splitter_[dim]);
+    for (auto &coord : sortedInput->dim2CoordMapping[dim]) {
+      auto &coordVal = sortedInput->coordsVals[coord];
+      SortVisitor visitor(splitter[dim]);
       boost::apply_visitor(visitor, coordVal);
     }
 
     // Reorder the array to be interpolated
     int ind = 0;
     std::array<size_t, 2> otherDims;
-    for (size_t odim = 0; odim < interpolatedArray_.dimensionality; ++odim) {
+    for (size_t odim = 0; odim < interpolatedArray.dimensionality; ++odim) {
       if (odim != dim) {
         otherDims[ind] = odim;
         ind++;
@@ -484,16 +647,16 @@ void DataExtractor<ExtractedValue>::sort() {
     }
 
     ind = 0;
-    for (const auto &group : splitter_[dim].groups()) {
+    for (const auto &group : splitter[dim].groups()) {
       for (const auto &index : group) {
-        for (size_t j = 0; j < interpolatedArray_.shape()[otherDims[0]]; j++) {
-          for (size_t k = 0; k < interpolatedArray_.shape()[otherDims[1]]; k++) {
+        for (size_t j = 0; j < interpolatedArray.shape()[otherDims[0]]; j++) {
+          for (size_t k = 0; k < interpolatedArray.shape()[otherDims[1]]; k++) {
             if (dim == 0) {
-              sortedArray[ind][j][k] = interpolatedArray_[index][j][k];
+              sortedArray[ind][j][k] = interpolatedArray[index][j][k];
             } else if (dim == 1) {
-              sortedArray[j][ind][k] = interpolatedArray_[j][index][k];
+              sortedArray[j][ind][k] = interpolatedArray[j][index][k];
             } else if (dim == 2) {
-              sortedArray[j][k][ind] = interpolatedArray_[j][k][index];
+              sortedArray[j][k][ind] = interpolatedArray[j][k][index];
             } else {
               // We shouldn't ever end up here (exception should be thrown eariler).
               throw eckit::Exception("Unable to reorder the array to be interpolated: "
@@ -505,8 +668,9 @@ void DataExtractor<ExtractedValue>::sort() {
       }
     }
     // Replace the unsorted array with the sorted one.
-    interpolatedArray_ = sortedArray;
+    interpolatedArray = sortedArray;
   }
+  return sortedInput;
 }
 
 
@@ -528,9 +692,9 @@ void DataExtractor<ExtractedValue>::scheduleSort(const std::string &varName,
   // Map any names of the form var@Group to Group/var
   const std::string canonicalVarName = ioda::convertV1PathToV2Path(varName);
 
-  const CoordinateValues &coordVal = coordsVals_.at(canonicalVarName);
-  const std::vector<int> &dimIndices = coord2DimMapping_.at(canonicalVarName);
-  const size_t coordDim = coordNDims_.at(canonicalVarName);
+  const CoordinateValues &coordVal = input_->coordsVals.at(canonicalVarName);
+  const std::vector<int> &dimIndices = input_->coord2DimMapping.at(canonicalVarName);
+  const size_t coordDim = input_->coordNDims.at(canonicalVarName);
 
   if (coordDim != dimIndices.size())
     throw eckit::Exception("Variable: '" + varName + "' has one or more dimension mappings not "
@@ -544,12 +708,11 @@ void DataExtractor<ExtractedValue>::scheduleSort(const std::string &varName,
 
   const int dimIndex = dimIndices[0];
 
-  SortUpdateVisitor visitor(splitter_[static_cast<size_t>(dimIndex)]);
-  boost::apply_visitor(visitor, coordVal);
-
-  // Update our map between coordinate (variable) and interpolation/extract method
-  coordsToExtractBy_.emplace_back(Coordinate{varName, coordVal, method, extrapMode,
+  // Update our map between coordinate (variable) and interpolation/extract method.
+  // The coordinate will be pointed at its sorted values by sort().
+  coordsToExtractBy_.emplace_back(Coordinate{varName, &coordVal, method, extrapMode,
                                              equidistantChoice, dimIndex});
+  sorted_ = false;
 }
 
 
@@ -574,6 +737,7 @@ void DataExtractor<ExtractedValue>::extract(const std::string &obVal) {
 template <typename ExtractedValue>
 template <typename T>
 void DataExtractor<ExtractedValue>::extractImpl(const T &obVal) {
+  ensureSorted();
   if (nextCoordToExtractBy_ == coordsToExtractBy_.cend())
     throw eckit::UserError("Too many extract() calls made for the expected number of variables.",
                            Here());
@@ -586,7 +750,7 @@ void DataExtractor<ExtractedValue>::extractImpl(const T &obVal) {
     maybeExtractByLinearInterpolation(obValN);
   else
     match(nextCoordToExtractBy_->method, nextCoordToExtractBy_->name,
-          boost::get<std::vector<T>>(nextCoordToExtractBy_->values), obValN,
+          boost::get<std::vector<T>>(*nextCoordToExtractBy_->values), obValN,
           nextCoordToExtractBy_->equidistantChoice,
           constrainedRanges_[nextCoordToExtractBy_->payloadDim]);
 
@@ -609,11 +773,11 @@ template <>
 template <typename T>
 void DataExtractor<float>::maybeExtractByLinearInterpolation(const T &obVal) {
   int dimIndex = nextCoordToExtractBy_->payloadDim;
-  const auto &interpolatedArray = get1DSlice(interpolatedArray_,
+  const auto &interpolatedArray = get1DSlice(input_->payloadArray,
                                              dimIndex,
                                              constrainedRanges_);
   result_ = linearInterpolation(nextCoordToExtractBy_->name,
-                                boost::get<std::vector<T>>(nextCoordToExtractBy_->values),
+                                boost::get<std::vector<T>>(*nextCoordToExtractBy_->values),
                                 obVal, constrainedRanges_[dimIndex], interpolatedArray);
   resultSet_ = true;
 }
@@ -658,7 +822,7 @@ ExtractedValue DataExtractor<ExtractedValue>::getUniqueMatch() const {
       throw eckit::Exception("Extraction criteria were not sufficient to identify a unique match "
                              "in the interpolation array.", Here());
   }
-  return interpolatedArray_[constrainedRanges_[0].begin()]
+  return input_->payloadArray[constrainedRanges_[0].begin()]
                            [constrainedRanges_[1].begin()]
                            [constrainedRanges_[2].begin()];
 }
@@ -673,6 +837,91 @@ void DataExtractor<ExtractedValue>::resetExtract() {
 }
 
 
+template <typename ExtractedValue>
+std::vector<ExtractedValue> DataExtractor<ExtractedValue>::extractBatch(
+    const std::vector<ObsValues> &obValues, size_t nlocs) {
+  ensureSorted();
+  if (obValues.size() != coordsToExtractBy_.size())
+    throw eckit::BadParameter("The values of each coordinate passed to scheduleSort() must be "
+                              "supplied to extractBatch().", Here());
+  for (const ObsValues &values : obValues)
+    if (boost::apply_visitor(SizeVisitor(), values) != nlocs)
+      throw eckit::BadParameter("The values supplied to extractBatch() must be defined at all "
+                                "locations.", Here());
+
+  // Number of leading coordinates matched without interpolation (e.g. station IDs or channel
+  // numbers). The ranges they select are reused at all locations sharing their values.
+  size_t numMatchedCoords = 0;
+  while (numMatchedCoords < coordsToExtractBy_.size() &&
+         coordsToExtractBy_[numMatchedCoords].method != InterpMethod::LINEAR &&
+         coordsToExtractBy_[numMatchedCoords].method != InterpMethod::BILINEAR)
+    ++numMatchedCoords;
+
+  // Sort the locations by the values of successive coordinates, grouping locations at which
+  // these values are identical. Locations sharing the values of the matched coordinates are
+  // therefore contiguous.
+  ufo::RecursiveSplitter splitter(nlocs);
+  for (const ObsValues &values : obValues) {
+    GroupLocationsVisitor visitor(splitter);
+    boost::apply_visitor(visitor, values);
+  }
+
+  // State of the extraction after matching the leading coordinates at location `matchedLoc`.
+  bool haveMatchedState = false;
+  size_t matchedLoc = 0;
+  std::array<ConstrainedRange, 3> matchedRanges;
+  ExtractedValue matchedResult = result_;
+  bool matchedResultSet = false;
+
+  std::vector<ExtractedValue> result(nlocs);
+  try {
+    for (const auto &group : splitter.groups()) {
+      // Extract the value at the first location of the group...
+      const size_t iloc = *group.begin();
+      ExtractAtLocationVisitor<ExtractedValue> visitor(*this, iloc);
+
+      bool sameMatchedValues = haveMatchedState;
+      for (size_t ind = 0; sameMatchedValues && ind < numMatchedCoords; ++ind)
+        sameMatchedValues = boost::apply_visitor(SameValuesVisitor(iloc, matchedLoc),
+                                                 obValues[ind]);
+      if (sameMatchedValues) {
+        // Restore the ranges selected by the matched coordinates at the previous group.
+        constrainedRanges_ = matchedRanges;
+        result_ = matchedResult;
+        resultSet_ = matchedResultSet;
+        nextCoordToExtractBy_ = coordsToExtractBy_.begin() + numMatchedCoords;
+      } else {
+        for (size_t ind = 0; ind < numMatchedCoords; ++ind)
+          boost::apply_visitor(visitor, obValues[ind]);
+        haveMatchedState = true;
+        matchedLoc = iloc;
+        matchedRanges = constrainedRanges_;
+        matchedResult = result_;
+        matchedResultSet = resultSet_;
+      }
+
+      for (size_t ind = numMatchedCoords; ind < obValues.size(); ++ind) {
+        if ((coordsToExtractBy_[ind].method == InterpMethod::BILINEAR) &&
+            (ind + 2 == obValues.size())) {
+          boost::apply_visitor(visitor, obValues[ind], obValues[ind + 1]);
+          break;
+        } else {
+          boost::apply_visitor(visitor, obValues[ind]);
+        }
+      }
+      const ExtractedValue value = getResult();
+      // ... and use it at all locations of the group.
+      for (const auto &iloc : group)
+        result[iloc] = value;
+    }
+  } catch (...) {
+    resetExtract();
+    throw;
+  }
+  return result;
+}
+
+
 // Explicit instantiations
 template class DataExtractor<float>;
 template class DataExtractor<int>;
@@ -10,7 +10,7 @@
 
 #include <array>
 #include <limits>              // std::numeric_limits
-#include <memory>              // unique_ptr
+#include <memory>              // shared_ptr, unique_ptr
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -24,6 +24,7 @@
 #include "oops/util/missingValues.h"
 
 #include "ufo/utils/dataextractor/ConstrainedRange.h"
+#include "ufo/utils/dataextractor/DataExtractorInput.h"
 #include "ufo/utils/RecursiveSplitter.h"
 
 
@@ -459,10 +460,14 @@ enum class EquidistantChoice {
 ///   array and the matching method to be used for this coordinate. This will determine the order
 ///   in which coordinates will be matched.
 /// * Call sort(). This will prepare internal data structures required for a rapid search for
-///   matching coordinates.
+///   matching coordinates. The data loaded from each file and the data sorted for each sequence of
+///   coordinates are cached for the lifetime of the process, so DataExtractors reading the same
+///   file (for example, created by different filters or by successive runs of the same filter)
+///   load it and sort it only once.
 /// * To extract a value from the payload array for a particular data point, pass the values of
 ///   successive coordinates of that point to calls to extract() (in the order matching the order of
 ///   the preceding calls to scheduleSort()). Then call getResult() to retrieve the extracted value.
+///   Alternatively, call extractBatch() to extract values for many data points at once.
 ///
 /// Here is a summary of particulars to the extraction/interpolation algorithms available:
 /// - Nearest neighbour 'interpolation' chooses the **first** nearest value to be found in the case
@@ -511,7 +516,9 @@ class DataExtractor
   /// function, we now physically sort the array itself along with all coordinates which
   /// describe it.
   /// \internal Applies the RecursiveSplitter object and necessarily creates copies to achieve
-  /// this sort.
+  /// this sort. The sorted data are cached, keyed by the file path, the payload group and the
+  /// sequence of coordinates passed to scheduleSort(), and reused by DataExtractors sorting the
+  /// same file in the same way.
   void sort();
 
   /// \brief Perform extract, given an observation value for the coordinate associated with this
@@ -538,6 +545,7 @@ class DataExtractor
   /// to the second coordinate utilised by the underlying method.
   template <typename T, typename R>
   void extract(T obValDim0, R obValDim1) {
+    ensureSorted();
     if (nextCoordToExtractBy_ == coordsToExtractBy_.cend())
       throw eckit::UserError("Too many extract() calls made for the expected number of variables.",
                              Here());
@@ -555,6 +563,32 @@ class DataExtractor
   /// value to return.
   ExtractedValue getResult();
 
+  /// \brief Values of a variable at a sequence of observation locations.
+  typedef boost::variant<std::vector<int>,
+                         std::vector<float>,
+                         std::vector<std::string>> ObsValues;
+
+  /// \brief Extract values for many observation locations at once.
+  /// \details The result is the same as if extract() (or its two-argument overload for successive
+  /// coordinates using bilinear interpolation) were called for each location with the values of
+  /// successive coordinates at that location, followed by getResult(). However, the locations
+  /// are first sorted by these values and locations with identical values share a single
+  /// extraction. In addition, the ranges of the payload array selected by the coordinates
+  /// preceding the first one used for interpolation (for example, station IDs or channel numbers)
+  /// are selected once for all locations sharing the values of these coordinates; only the
+  /// interpolation is then repeated at each of these locations.
+  ///
+  /// If extraction fails at any location, the exception is rethrown once the extraction state has
+  /// been reset; call extract() at individual locations to find which one is at fault.
+  ///
+  /// \param[in] obValues
+  ///   Vector whose ith element contains the values at all locations of the coordinate passed
+  ///   to the ith call to scheduleSort().
+  /// \param[in] nlocs
+  ///   Number of locations.
+  /// \returns Vector of values extracted at these locations.
+  std::vector<ExtractedValue> extractBatch(const std::vector<ObsValues> &obValues, size_t nlocs);
+
  private:
   /// \brief Common implementation of the overloaded public function extract().
   template <typename T>
@@ -571,7 +605,7 @@ class DataExtractor
     if (resultSet_)
       return obVal;
 
-    const std::vector<T> varValues = boost::get<std::vector<T>>(nextCoordToExtractBy_->values);
+    const std::vector<T> &varValues = boost::get<std::vector<T>>(*nextCoordToExtractBy_->values);
     ConstrainedRange &range = constrainedRanges_[nextCoordToExtractBy_->payloadDim];
     const std::string &varName = nextCoordToExtractBy_->name;
 
@@ -633,43 +667,51 @@ class DataExtractor
   void resetExtract();
 
   /// \brief Load all data from the input file.
-  void load(const std::string &filepath, const std::string &interpolatedArrayGroup);
+  static std::shared_ptr<const DataExtractorInput<ExtractedValue>> load(
+      const std::string &filepath, const std::string &interpolatedArrayGroup);
+
+  /// \brief Return a copy of \p input sorted as requested by the preceding calls to
+  /// scheduleSort().
+  std::shared_ptr<const DataExtractorInput<ExtractedValue>> sortedCopy(
+      const DataExtractorInput<ExtractedValue> &input) const;
+
+  /// \brief Sort the data if sort() hasn't been called yet.
+  void ensureSorted() {
+    if (!sorted_)
+      sort();
+  }
 
   /// \brief Create a backend able to read file \p filepath.
   static std::unique_ptr<DataExtractorBackend<ExtractedValue>> createBackendFor(
       const std::string &filepath);
 
+  // Path to the input file.
+  std::string filepath_;
+  // Group containing the payload variable.
+  std::string group_;
+
   // Object represent the extraction range in both dimensions.
   std::array<ConstrainedRange, 3> constrainedRanges_;
 
-  // Container holding coordinate arrays (of all supported types) loaded from the input file.
-  typedef boost::variant<std::vector<int>,
-                         std::vector<float>,
-                         std::vector<std::string>> CoordinateValues;
-  std::unordered_map<std::string, CoordinateValues> coordsVals_;
-  // The array to be interpolated (the payload array).
-  DataExtractorPayload<ExtractedValue> interpolatedArray_;
+  // Coordinate arrays (of all supported types) loaded from the input file.
+  typedef DataExtractorInputBase::Coordinate CoordinateValues;
+  // Coordinate arrays and the array to be interpolated (the payload array), sorted by sort().
+  // Shared with other DataExtractors reading the same file.
+  std::shared_ptr<const DataExtractorInput<ExtractedValue>> input_;
+  // Set to true once sort() has been called.
+  bool sorted_ = false;
   // Interpolation result.  Used when utilising linear/bilinear interpolation and also with
   // extrapolation (where applicable).
   ExtractedValue result_;
   // Set to true if result_ is a valid value.
   bool resultSet_;
-  // Container for re-ordering our data
-  std::vector<ufo::RecursiveSplitter> splitter_;
-
-  /// Maps coordinate names to dimensions (0 or 1) of the payload array
-  std::unordered_map<std::string, std::vector<int>> coord2DimMapping_;
-  /// Maps dimensions of the payload array (0 or 1) to coordinate names
-  std::vector<std::vector<std::string>> dim2CoordMapping_;
-  /// Maps coordinate names to their dimensionality.
-  std::unordered_map<std::string, size_t> coordNDims_;
 
   /// Coordinate used for data extraction from the payload array.
   struct Coordinate {
     /// Coordinate name
     std::string name;
-    /// Coordinate values
-    const CoordinateValues &values;
+    /// Coordinate values (held by input_)
+    const CoordinateValues *values;
     /// Extraction method to use
     InterpMethod method;
     /// Extrapolation mode to use
@@ -698,7 +740,7 @@ void DataExtractor<float>::maybeExtractByBiLinearInterpolation(
     return;
   const size_t dimIndex0 = nextCoordToExtractBy_->payloadDim;
   const std::string &varName0 = nextCoordToExtractBy_->name;
-  const std::vector<T> &varValues0 = boost::get<std::vector<T>>(nextCoordToExtractBy_->values);
+  const std::vector<T> &varValues0 = boost::get<std::vector<T>>(*nextCoordToExtractBy_->values);
   ++nextCoordToExtractBy_;  // Consume variable
 
   if (nextCoordToExtractBy_->method != InterpMethod::BILINEAR)
@@ -709,9 +751,9 @@ void DataExtractor<float>::maybeExtractByBiLinearInterpolation(
     return;
   const size_t dimIndex1 = nextCoordToExtractBy_->payloadDim;
   const std::string &varName1 = nextCoordToExtractBy_->name;
-  const std::vector<R> &varValues1 = boost::get<std::vector<R>>(nextCoordToExtractBy_->values);
+  const std::vector<R> &varValues1 = boost::get<std::vector<R>>(*nextCoordToExtractBy_->values);
 
-  auto interpolatedArray = get2DSlice(interpolatedArray_, dimIndex0, dimIndex1,
+  auto interpolatedArray = get2DSlice(input_->payloadArray, dimIndex0, dimIndex1,
                                       ranges);
   if (dimIndex1 > dimIndex0) {
     result_ = bilinearInterpolation(varName0, varValues0, obValDim0N, ranges[dimIndex0],
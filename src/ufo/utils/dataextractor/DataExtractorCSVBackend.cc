@@ -5,22 +5,26 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
 #include <string>
 #include <unordered_map>
-#include <utility>  // for move
+#include <utility>  // for move, pair
 #include <vector>
 
 #include <boost/multi_array.hpp>
 #include <boost/variant.hpp>
 
 #include "eckit/exception/Exceptions.h"
-#include "eckit/parser/CSVParser.h"
 #include "eckit/utils/StringTools.h"
 
 #include "ioda/Misc/StringFuncs.h"   // for convertV1PathToV2Path
 #include "ioda/ObsSpace.h"  // for ObsDtype
 
 #include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
 
 #include "ufo/utils/dataextractor/DataExtractorCSVBackend.h"
 #include "ufo/utils/dataextractor/DataExtractorInput.h"
@@ -36,44 +40,176 @@ const size_t numHeaderRows = 2;
 /// Representation of missing values in CSV files (same as in NetCDF's CDL).
 const char *missingValuePlaceholder = "_";
 
-/// Visitor whose operator() takes a vector and appends to it the value passed to the constructor
-/// (treating "_" as a placeholder for "missing value").
-class AppendValueVisitor : public boost::static_visitor<void> {
- public:
-  explicit AppendValueVisitor(const eckit::Value &value) :
-    value_(value)
-  {}
-
-  void operator()(std::vector<int> &values) const {
-    int value;
-    if (value_.as<std::string>() == missingValuePlaceholder)
-      value = util::missingValue(value);
-    else
-      // NOLINTNEXTLINE(runtime/int): It's not our fault that eckit uses the 'long long' type...
-      value = static_cast<int>(value_.as<long long>());
-    values.push_back(value);
+/// \brief A field of a line of a CSV file.
+struct Field {
+  /// Start of the text of an unquoted field.
+  const char *begin = nullptr;
+  /// End of the text of an unquoted field.
+  const char *end = nullptr;
+  /// True if the field was surrounded by double quotes.
+  bool quoted = false;
+  /// Text of a quoted field, without the surrounding quotes and with escaped quotes ("")
+  /// replaced by single quotes.
+  std::string unescaped;
+
+  std::string text() const {
+    return quoted ? unescaped : std::string(begin, end);
   }
+};
 
-  void operator()(std::vector<float> &values) const {
-    float value;
-    if (value_.as<std::string>() == missingValuePlaceholder)
-      value = util::missingValue(value);
-    else
-      value = static_cast<float>(value_.as<double>());
-    values.push_back(value);
+/// \brief Split the line [\p begin, \p end) into comma-separated fields.
+///
+/// Fields may be surrounded by double quotes; quoted fields may contain commas and double quotes
+/// escaped by doubling them. Unquoted fields are stored without any copying.
+void splitLine(const char *begin, const char *end, std::vector<Field> &fields,
+               size_t lineNumber) {
+  fields.clear();
+  const char *pos = begin;
+  while (true) {
+    fields.emplace_back();
+    Field &field = fields.back();
+    field.quoted = (pos != end && *pos == '"');
+    if (field.quoted) {
+      ++pos;
+      while (true) {
+        const char *quote = std::find(pos, end, '"');
+        if (quote == end)
+          throw eckit::UserError("Unterminated quoted field in line " +
+                                 std::to_string(lineNumber), Here());
+        field.unescaped.append(pos, quote);
+        pos = quote + 1;
+        if (pos == end || *pos != '"')
+          break;
+        field.unescaped.push_back('"');
+        ++pos;
+      }
+      if (pos != end && *pos != ',')
+        throw eckit::UserError("Unexpected characters after a quoted field in line " +
+                               std::to_string(lineNumber), Here());
+    } else {
+      field.begin = pos;
+      pos = std::find(pos, end, ',');
+      field.end = pos;
+    }
+    if (pos == end)
+      break;
+    ++pos;  // skip the comma
   }
+}
+
+/// \brief Strip leading and trailing whitespace from the range [\p begin, \p end).
+void trim(const char *&begin, const char *&end) {
+  while (begin != end && std::isspace(static_cast<unsigned char>(*begin)))
+    ++begin;
+  while (end != begin && std::isspace(static_cast<unsigned char>(end[-1])))
+    --end;
+}
 
-  void operator()(std::vector<std::string> &values) const {
-    std::string value = value_.as<std::string>();
-    if (value == missingValuePlaceholder)
-      value = util::missingValue(value);
-    values.push_back(value);
+/// \brief Return true if \p field is the placeholder for a missing value.
+bool isMissing(const Field &field) {
+  return !field.quoted && field.end - field.begin == 1 && *field.begin == *missingValuePlaceholder;
+}
+
+/// \brief Parse the numeric field \p field with the function \p parse (e.g. std::strtod),
+/// throwing an exception unless the whole field (except surrounding whitespace) is consumed.
+template <typename Number, typename Parse>
+Number parseNumber(const Field &field, const Parse &parse, size_t lineNumber) {
+  const char *begin = field.quoted ? field.unescaped.c_str() : field.begin;
+  const char *end = field.quoted ? begin + field.unescaped.size() : field.end;
+  trim(begin, end);
+  // The trimmed field starts with a non-blank character and is followed by a comma, a blank
+  // character or the null character terminating the file contents, none of which can be part of
+  // a number, so the parsing function stops at the end of the field at the latest.
+  char *parsedEnd = nullptr;
+  const Number value = begin == end ? Number() : parse(begin, &parsedEnd);
+  if (begin == end || parsedEnd != end)
+    throw eckit::UserError("Invalid number '" + field.text() + "' in line " +
+                           std::to_string(lineNumber), Here());
+  return value;
+}
+
+/// \brief Parses fields of a column of a CSV file and appends their values to a vector of the
+/// column's type.
+class ColumnParser {
+ public:
+  explicit ColumnParser(DataExtractorInputBase::Coordinate &column)
+    : ints_(boost::get<std::vector<int>>(&column)),
+      floats_(boost::get<std::vector<float>>(&column)),
+      strings_(boost::get<std::vector<std::string>>(&column))
+  {}
+
+  void append(const Field &field, size_t lineNumber) const {
+    if (ints_ != nullptr) {
+      if (isMissingNumber(field))
+        ints_->push_back(util::missingValue(int()));
+      else
+        ints_->push_back(static_cast<int>(parseNumber<long long>(  // NOLINT(runtime/int)
+          field, [](const char *str, char **end) { return std::strtoll(str, end, 10); },
+          lineNumber)));
+    } else if (floats_ != nullptr) {
+      if (isMissingNumber(field))
+        floats_->push_back(util::missingValue(float()));
+      else
+        // Parsed in double precision and then rounded, like the values read by eckit.
+        floats_->push_back(static_cast<float>(parseNumber<double>(
+          field, [](const char *str, char **end) { return std::strtod(str, end); },
+          lineNumber)));
+    } else {
+      if (isMissing(field))
+        strings_->push_back(util::missingValue(std::string()));
+      else
+        strings_->push_back(field.text());
+    }
   }
 
  private:
-  const eckit::Value &value_;
+  /// Numeric fields may be surrounded by whitespace.
+  static bool isMissingNumber(const Field &field) {
+    if (field.quoted)
+      return false;
+    const char *begin = field.begin, *end = field.end;
+    trim(begin, end);
+    return end - begin == 1 && *begin == *missingValuePlaceholder;
+  }
+
+  std::vector<int> *ints_;
+  std::vector<float> *floats_;
+  std::vector<std::string> *strings_;
 };
 
+/// \brief Return the contents of the file \p filepath, read in a single operation.
+std::string readFile(const std::string &filepath) {
+  std::ifstream file(filepath, std::ios::in | std::ios::binary);
+  if (!file)
+    throw eckit::CantOpenFile(filepath, Here());
+  file.seekg(0, std::ios::end);
+  std::string contents(static_cast<size_t>(file.tellg()), '\0');
+  file.seekg(0, std::ios::beg);
+  file.read(&contents[0], contents.size());
+  if (!file)
+    throw eckit::ReadError(filepath, Here());
+  return contents;
+}
+
+/// \brief Split \p contents into lines, stripping line terminators (\\n or \\r\\n).
+///
+/// Returns the start and end of each line.
+std::vector<std::pair<const char *, const char *>> splitLines(const std::string &contents) {
+  std::vector<std::pair<const char *, const char *>> lines;
+  lines.reserve(std::count(contents.begin(), contents.end(), '\n') + 1);
+  const char *pos = contents.data();
+  const char *const end = pos + contents.size();
+  while (pos != end) {
+    const char *lineEnd = std::find(pos, end, '\n');
+    const char *next = lineEnd == end ? end : lineEnd + 1;
+    if (lineEnd != pos && lineEnd[-1] == '\r')
+      --lineEnd;
+    lines.emplace_back(pos, lineEnd);
+    pos = next;
+  }
+  return lines;
+}
+
 template <typename Source, typename Destination>
 void convertVectorToColumnArray(const std::vector<Source> &source,
                                     boost::multi_array<Destination, 3> &destination) {
@@ -182,8 +318,11 @@ DataExtractorInput<ExtractedValue> DataExtractorCSVBackend<ExtractedValue>::load
     const std::string &interpolatedArrayGroup) const {
   DataExtractorInput<ExtractedValue> result;
 
-  const eckit::Value contents = eckit::CSVParser::decodeFile(filepath_, false /* hasHeader? */);
-  const size_t numRows = contents.size();
+  // The file is read in one go and the values are parsed straight into vectors of the types of
+  // their columns, without creating an intermediate representation of the whole file.
+  const std::string contents = readFile(filepath_);
+  const std::vector<std::pair<const char *, const char *>> lines = splitLines(contents);
+  const size_t numRows = lines.size();
   // Ensure we have at least three lines:
   // * column names
   // * data types
@@ -193,12 +332,12 @@ DataExtractorInput<ExtractedValue> DataExtractorCSVBackend<ExtractedValue>::load
   const size_t numValues = numRows - numHeaderRows;
 
   // Read column names from the first line
-  const eckit::Value nameHeader = contents[0];
-  const size_t numColumns = nameHeader.size();
+  std::vector<Field> fields;
+  splitLine(lines[0].first, lines[0].second, fields, 1);
+  const size_t numColumns = fields.size();
   std::vector<std::string> columnNames(numColumns);
-  columnNames.reserve(numColumns);
   for (size_t column = 0; column < numColumns; ++column)
-    columnNames[column] = nameHeader[column].as<std::string>();
+    columnNames[column] = fields[column].text();
 
   const size_t payloadColumnIndex = findPayloadColumn(columnNames, interpolatedArrayGroup);
 
@@ -208,14 +347,14 @@ DataExtractorInput<ExtractedValue> DataExtractorCSVBackend<ExtractedValue>::load
     columnName = ioda::convertV1PathToV2Path(columnName);
 
   // Read data types from the second line
-  const eckit::Value typeHeader = contents[1];
-  if (typeHeader.size() != numColumns)
+  splitLine(lines[1].first, lines[1].second, fields, 2);
+  if (fields.size() != numColumns)
     throw eckit::UserError("The number of columns in line 2 differs from that in line 1", Here());
 
   // Allocate vectors for values to be loaded from subsequent lines
   std::vector<DataExtractorInputBase::Coordinate> columns(numColumns);
   for (size_t column = 0; column < numColumns; ++column) {
-    const std::string type = typeHeader[column];
+    const std::string type = fields[column].text();
     if (column == payloadColumnIndex)
       checkPayloadColumnType<ExtractedValue>(type);
     if (type == "string" || type == "datetime") {
@@ -228,17 +367,20 @@ DataExtractorInput<ExtractedValue> DataExtractorCSVBackend<ExtractedValue>::load
       throw eckit::UserError("Unsupported data type '" + type + "'", Here());
     }
   }
+  // Constructed only now, since assignments to the elements of `columns` invalidate pointers to
+  // the vectors they hold.
+  std::vector<ColumnParser> parsers(columns.begin(), columns.end());
 
   // Load values from the rest of the CSV file
   for (size_t row = numHeaderRows; row < numRows; ++row) {
-    const eckit::Value rowContents = contents[row];
-    if (rowContents.size() == 1 && rowContents[0] == "")
+    if (lines[row].first == lines[row].second)
       continue;  // empty line
-    if (rowContents.size() != numColumns)
+    splitLine(lines[row].first, lines[row].second, fields, 1 + row);
+    if (fields.size() != numColumns)
       throw eckit::UserError("The number of columns in line " + std::to_string(1 + row) +
                              " differs from that in line 1", Here());
     for (size_t column = 0; column < numColumns; ++column)
-      boost::apply_visitor(AppendValueVisitor(rowContents[column]), columns[column]);
+      parsers[column].append(fields[column], 1 + row);
   }
 
   // Store the loaded data in the result object
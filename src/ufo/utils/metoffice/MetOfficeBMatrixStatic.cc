@@ -13,7 +13,7 @@ namespace ufo {
 // -----------------------------------------------------------------------------
 /// \brief Constructor
 MetOfficeBMatrixStatic::MetOfficeBMatrixStatic(const eckit::Configuration & config):
-    nbands_(0), nelements_(0), southlimits_(), northlimits_(), elements_()
+    nbands_(0), nelements_(0), southlimits_(), northlimits_(), elements_(), factors_()
 {
   oops::Log::trace() << "MetOfficeBMatrixStatic constructor starting" << std::endl;
 
@@ -35,6 +35,7 @@ MetOfficeBMatrixStatic::MetOfficeBMatrixStatic(const eckit::Configuration & conf
                                      nelements_, nelements_);
     elements_.push_back(bmap);
   }
+  this->factorise();
 
   // Remove the Fortran object because it is no longer needed
   ufo_metoffice_bmatrixstatic_delete_f90(keyMetOfficeBMatrixStatic_);
@@ -60,6 +61,18 @@ void MetOfficeBMatrixStatic::multiply(const float lat,
   size_t index = this->getindex(lat);
   out = elements_[index] * in;
 }
+// -----------------------------------------------------------------------------
+/// \brief Return the bmatrix for the band containing a given latitude
+const Eigen::MatrixXf & MetOfficeBMatrixStatic::matrix(const float lat) const {
+  return elements_[this->getindex(lat)];
+}
+// -----------------------------------------------------------------------------
+/// \brief Return the Cholesky factorisation of the bmatrix for the band containing
+/// a given latitude.  Callers should check info() before using it to solve.
+const Eigen::LLT<Eigen::MatrixXf> &
+MetOfficeBMatrixStatic::factorisation(const float lat) const {
+  return factors_[this->getindex(lat)];
+}
 
 // -----------------------------------------------------------------------------
 /// \brief Scale elements of bmatrix array to user-defined standard deviation
@@ -69,6 +82,20 @@ void MetOfficeBMatrixStatic::scale(const size_t elem, const float stdev) {
     elements_[iband].row(elem) *= scaling;
     elements_[iband].col(elem) *= scaling;
   }
+  this->factorise();
+}
+// -----------------------------------------------------------------------------
+/// \brief Compute the Cholesky factorisation of the bmatrix for each band
+void MetOfficeBMatrixStatic::factorise() {
+  factors_.clear();
+  factors_.reserve(nbands_);
+  for (size_t iband = 0; iband < nbands_; ++iband) {
+    factors_.emplace_back(elements_[iband]);
+    if (factors_.back().info() == Eigen::NumericalIssue) {
+      oops::Log::warning() << "MetOfficeBMatrixStatic: bmatrix for band " << iband
+                           << " appears not to be positive definite" << std::endl;
+    }
+  }
 }
 // -----------------------------------------------------------------------------
 /// \brief Print
@@ -29,7 +29,9 @@ namespace ufo {
 /// MetOfficeBMatrixStatic: Met Office static model covariance
 /// This class provides access to the static b matrix used for radiance
 /// processing by the Met Office.  The objects main method is to multiply
-/// an eigen matrix by the bmatrix
+/// an eigen matrix by the bmatrix.  The Cholesky factorisation of the matrix
+/// for each latitude band is computed once, when the matrix is read or scaled,
+/// so that callers solving with B do not need to refactorise it per observation.
 // -----------------------------------------------------------------------------
 
 class MetOfficeBMatrixStatic : public util::Printable,
@@ -43,15 +45,19 @@ class MetOfficeBMatrixStatic : public util::Printable,
   size_t getsize(void) const;
   void multiply(const float, const Eigen::MatrixXf &, Eigen::MatrixXf &) const;
   void scale(const size_t elem, const float stdev);
+  const Eigen::MatrixXf & matrix(const float) const;
+  const Eigen::LLT<Eigen::MatrixXf> & factorisation(const float) const;
 
  private:
   void print(std::ostream &) const override;
+  void factorise();
   F90obfilter keyMetOfficeBMatrixStatic_;  // key to Fortran for B
   size_t nbands_;                          // number of latitude bands for B
   size_t nelements_;                       // number of elements in each dimension of B
   std::vector<float> southlimits_;         // southern latitude limit per band
   std::vector<float> northlimits_;         // northern latitude limit per band
   std::vector<Eigen::MatrixXf> elements_;  // container for B contents
+  std::vector<Eigen::LLT<Eigen::MatrixXf>> factors_;  // Cholesky factors of B per band
 };
 
 }  // namespace ufo
@@ -6,6 +6,8 @@
  */
 
 #include <assert.h>
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "oops/util/abor1_cpp.h"
@@ -17,7 +19,7 @@ namespace ufo {
 // -----------------------------------------------------------------------------
 /// \brief Constructor
 MetOfficeRMatrixRadiance::MetOfficeRMatrixRadiance(const eckit::Configuration & config):
-    nchans_(0), wmoid_(0), rtype_(0), channels_(), errors_()
+    nchans_(0), wmoid_(0), rtype_(0), channels_(), errors_(), variances_()
 {
   oops::Log::trace() << "MetOfficeRMatrixRadiance constructor starting" << std::endl;
 
@@ -55,6 +57,19 @@ void MetOfficeRMatrixRadiance::add(const std::vector<int> & chans_used,
   assert(matrows == chans_used.size());
   assert(matcols == chans_used.size());
   out = in;
+  out.diagonal() += this->variances(chans_used);
+}
+// -----------------------------------------------------------------------------
+/// \brief Return the r matrix variances (the diagonal of the r sub-matrix) for the
+/// channels used.  The result is computed on the first call for each list of channels
+/// and cached; the reference remains valid for the lifetime of the object.
+const Eigen::VectorXf &
+MetOfficeRMatrixRadiance::variances(const std::vector<int> & chans_used) const {
+  std::lock_guard<std::mutex> lock(variancesMutex_);
+  auto cached = variances_.find(chans_used);
+  if (cached != variances_.end()) return cached->second;
+
+  Eigen::VectorXf vars(chans_used.size());
   if (rtype_ == 2) {
     for (size_t ichan = 0; ichan < chans_used.size(); ++ichan) {
       auto it = std::find(channels_.begin(), channels_.end(), chans_used[ichan]);
@@ -64,12 +79,13 @@ void MetOfficeRMatrixRadiance::add(const std::vector<int> & chans_used,
         ABORT("Invalid channel specified for R-matrix");
       } else {
         size_t index = it - channels_.begin();
-        out(ichan, ichan) += errors_[index] * errors_[index];
+        vars(ichan) = errors_[index] * errors_[index];
       }
     }
   } else {
     ABORT("R-matrix type not currently in use - only diagonal");
   }
+  return variances_.emplace(chans_used, std::move(vars)).first->second;
 }
 // -----------------------------------------------------------------------------
 /// \brief Print
@@ -9,6 +9,8 @@
 #define UFO_UTILS_METOFFICE_METOFFICERMATRIXRADIANCE_H_
 
 #include <Eigen/Dense>
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -26,7 +28,9 @@ namespace ufo {
 // -----------------------------------------------------------------------------
 /// MetOfficeRMatrixStatic: Met Office static model covariance
 /// This class provides access to the static r matrix used for radiance
-/// processing by the Met Office.
+/// processing by the Met Office.  The variances for each list of channels
+/// requested are cached, so repeated calls with the same channels (typically
+/// one per observation) do not search the channel list again.
 // -----------------------------------------------------------------------------
 
 class MetOfficeRMatrixRadiance : public util::Printable,
@@ -37,6 +41,7 @@ class MetOfficeRMatrixRadiance : public util::Printable,
   explicit MetOfficeRMatrixRadiance(const eckit::Configuration &);
 
   void add(const std::vector<int> &, const Eigen::MatrixXf &, Eigen::MatrixXf &) const;
+  const Eigen::VectorXf & variances(const std::vector<int> &) const;
 
  private:
   void print(std::ostream &) const override;
@@ -46,6 +51,8 @@ class MetOfficeRMatrixRadiance : public util::Printable,
   size_t rtype_;
   std::vector<int> channels_;
   std::vector<float> errors_;
+  mutable std::map<std::vector<int>, Eigen::VectorXf> variances_;  // cache keyed by channels
+  mutable std::mutex variancesMutex_;
 };
 
 }  // namespace ufo
@@ -8,10 +8,28 @@
 #ifndef UFO_UTILS_METOFFICE_METOFFICESORT_H_
 #define UFO_UTILS_METOFFICE_METOFFICESORT_H_
 
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace ufo {
 
+/// \brief Implementations of metOfficeSort().
+///
+/// Both produce exactly the same permutation of the sorted range.
+enum class MetOfficeSortAlgorithm {
+  /// Sort the range in place with the heap sort used by OPS.
+  HEAP_SORT,
+  /// Copy the elements and their keys into a contiguous buffer, which is then sorted with
+  /// std::sort if all keys are distinct (the sorted order is then unique) and with the OPS heap
+  /// sort otherwise, and copy the elements back. Faster than HEAP_SORT on long ranges,
+  /// especially if the keys are expensive to evaluate or scattered in memory, at the cost of
+  /// temporary storage. Ranges shorter than 32 elements are sorted in place.
+  BUFFERED
+};
+
 namespace metofficesortdetail {
 
 /// Sink element `parentIndex` of the heap starting at `heapStart` with `heapLength` elements
@@ -72,6 +90,51 @@ void sortHeap(RandomIt first, RandomIt last, const UnaryOperation &key) {
   }
 }
 
+/// Ranges shorter than this are sorted in place even if the BUFFERED algorithm is requested.
+constexpr std::ptrdiff_t minBufferedSortLength = 32;
+
+/// Sort the range `[first, last)` in the order of ascending keys using the BUFFERED algorithm.
+template <typename RandomIt, typename UnaryOperation>
+void bufferedSort(RandomIt first, RandomIt last, const UnaryOperation &key) {
+  typedef typename std::iterator_traits<RandomIt>::value_type Value;
+  typedef typename std::decay<decltype(key(*first))>::type Key;
+  typedef std::pair<Key, Value> Item;
+
+  const auto fillBuffer = [&first, &last, &key](std::vector<Item> &buffer) {
+    buffer.clear();
+    for (RandomIt it = first; it != last; ++it)
+      buffer.emplace_back(key(*it), *it);
+  };
+  const auto bufferKey = [](const Item &item) -> const Key & { return item.first; };
+  const auto lessKey = [](const Item &a, const Item &b) { return a.first < b.first; };
+
+  std::vector<Item> buffer;
+  buffer.reserve(last - first);
+  fillBuffer(buffer);
+
+  // Keys not equal to themselves (NaNs) don't define a strict weak ordering, so std::sort
+  // can't be used.
+  bool useStdSort = std::all_of(buffer.begin(), buffer.end(),
+                                [](const Item &item) { return item.first == item.first; });
+  if (useStdSort) {
+    std::sort(buffer.begin(), buffer.end(), lessKey);
+    // The heap sort orders elements with equal keys in a way that can't be reproduced without
+    // running it, so fall back to it if there are any.
+    useStdSort = std::adjacent_find(buffer.begin(), buffer.end(),
+                                    [](const Item &a, const Item &b)
+                                    { return !(a.first < b.first); }) == buffer.end();
+    if (!useStdSort)
+      fillBuffer(buffer);
+  }
+  if (!useStdSort) {
+    makeHeap(buffer.begin(), buffer.end(), bufferKey);
+    sortHeap(buffer.begin(), buffer.end(), bufferKey);
+  }
+
+  std::transform(buffer.begin(), buffer.end(), first,
+                 [](Item &item) { return std::move(item.second); });
+}
+
 }  // namespace metofficesortdetail
 
 /// \brief Sort the range `[first, last)` in the order of ascending keys using the same algorithm as
@@ -82,10 +145,18 @@ void sortHeap(RandomIt first, RandomIt last, const UnaryOperation &key) {
 /// \param key
 ///   An unary functor taking an element of the range (a dereferenced iterator `RandomIt`)
 ///   and returning a key used as the sorting criterion.
+/// \param algorithm
+///   Implementation to use. The result does not depend on it.
 template <typename RandomIt, typename UnaryOperation>
-void metOfficeSort(RandomIt first, RandomIt last, const UnaryOperation &key) {
-  metofficesortdetail::makeHeap(first, last, key);
-  metofficesortdetail::sortHeap(first, last, key);
+void metOfficeSort(RandomIt first, RandomIt last, const UnaryOperation &key,
+                   MetOfficeSortAlgorithm algorithm = MetOfficeSortAlgorithm::HEAP_SORT) {
+  if (algorithm == MetOfficeSortAlgorithm::BUFFERED &&
+      last - first >= metofficesortdetail::minBufferedSortLength) {
+    metofficesortdetail::bufferedSort(first, last, key);
+  } else {
+    metofficesortdetail::makeHeap(first, last, key);
+    metofficesortdetail::sortHeap(first, last, key);
+  }
 }
 
 /// \brief Sort the range `[first, last)` in ascending order using the same algorithm as
@@ -93,9 +164,12 @@ void metOfficeSort(RandomIt first, RandomIt last, const UnaryOperation &key) {
 ///
 /// \param first, last
 ///   The range of elements to sort.
+/// \param algorithm
+///   Implementation to use. The result does not depend on it.
 template <typename RandomIt>
-void metOfficeSort(RandomIt first, RandomIt last) {
-  metOfficeSort(first, last, [](const auto &x) { return x; });
+void metOfficeSort(RandomIt first, RandomIt last,
+                   MetOfficeSortAlgorithm algorithm = MetOfficeSortAlgorithm::HEAP_SORT) {
+  metOfficeSort(first, last, [](const auto &x) { return x; }, algorithm);
 }
 
 }  // namespace ufo
@@ -0,0 +1,131 @@
+! (C) Copyright 2022 UCAR
+!
+! This software is licensed under the terms of the Apache Licence Version 2.0
+! which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+
+!> Implementation of the registry declared in ufo/utils/registry_i.f
+
+! ------------------------------------------------------------------------------
+!> Initialise the registry (does nothing if it is already initialised)
+subroutine registry_init_(self)
+implicit none
+class(registry_t), intent(inout) :: self
+
+!$omp critical (ufo_registry)
+if (.not. self%l_init) then
+  allocate(self%blocks(registry_max_blocks))
+  allocate(self%free_keys(64))
+  self%count = 0
+  self%nkeys = 0
+  self%nfree = 0
+  self%l_init = .true.
+end if
+!$omp end critical (ufo_registry)
+
+end subroutine registry_init_
+
+! ------------------------------------------------------------------------------
+!> Allocate a new object and return its key
+subroutine registry_add_(self, key)
+implicit none
+class(registry_t), intent(inout) :: self
+integer, intent(inout)           :: key
+
+integer :: iblock, islot
+
+!$omp critical (ufo_registry)
+if (self%nfree > 0) then
+  key = self%free_keys(self%nfree)
+  self%nfree = self%nfree - 1
+else
+  if (self%nkeys >= registry_block_size * registry_max_blocks) &
+    call abor1_ftn("registry_t%add: too many objects")
+  self%nkeys = self%nkeys + 1
+  key = self%nkeys
+end if
+iblock = (key - 1) / registry_block_size + 1
+islot = mod(key - 1, registry_block_size) + 1
+if (.not. associated(self%blocks(iblock)%slots)) &
+  allocate(self%blocks(iblock)%slots(registry_block_size))
+allocate(self%blocks(iblock)%slots(islot)%element)
+self%count = self%count + 1
+!$omp end critical (ufo_registry)
+
+end subroutine registry_add_
+
+! ------------------------------------------------------------------------------
+!> Point ptr at the object with the given key
+subroutine registry_get_(self, key, ptr)
+implicit none
+class(registry_t), intent(in) :: self
+integer, intent(in)           :: key
+type(LISTED_TYPE), pointer    :: ptr
+
+integer :: iblock
+
+ptr => null()
+if (self%l_init .and. key >= 1 .and. key <= self%nkeys) then
+  iblock = (key - 1) / registry_block_size + 1
+  if (associated(self%blocks(iblock)%slots)) &
+    ptr => self%blocks(iblock)%slots(mod(key - 1, registry_block_size) + 1)%element
+end if
+if (.not. associated(ptr)) call abor1_ftn("registry_t%get: key not found")
+
+end subroutine registry_get_
+
+! ------------------------------------------------------------------------------
+!> Deallocate the object with the given key
+subroutine registry_remove_(self, key)
+implicit none
+class(registry_t), intent(inout) :: self
+integer, intent(inout)           :: key
+
+integer :: iblock, islot
+integer, allocatable :: free_keys(:)
+
+!$omp critical (ufo_registry)
+if (.not. self%l_init .or. key < 1 .or. key > self%nkeys) &
+  call abor1_ftn("registry_t%remove: key not found")
+iblock = (key - 1) / registry_block_size + 1
+islot = mod(key - 1, registry_block_size) + 1
+if (.not. associated(self%blocks(iblock)%slots(islot)%element)) &
+  call abor1_ftn("registry_t%remove: key not found")
+deallocate(self%blocks(iblock)%slots(islot)%element)
+if (self%nfree == size(self%free_keys)) then
+  allocate(free_keys(2 * self%nfree))
+  free_keys(1:self%nfree) = self%free_keys
+  call move_alloc(free_keys, self%free_keys)
+end if
+self%nfree = self%nfree + 1
+self%free_keys(self%nfree) = key
+self%count = self%count - 1
+!$omp end critical (ufo_registry)
+
+end subroutine registry_remove_
+
+! ------------------------------------------------------------------------------
+!> Initialise the registry, allocate a new object and point ptr at it
+subroutine registry_setup_(self, key, ptr)
+implicit none
+class(registry_t), intent(inout) :: self
+integer, intent(inout)           :: key
+type(LISTED_TYPE), pointer       :: ptr
+
+call self%init()
+call self%add(key)
+call self%get(key, ptr)
+
+end subroutine registry_setup_
+
+! ------------------------------------------------------------------------------
+!> Deallocate the object with the given key and nullify ptr
+subroutine registry_delete_(self, key, ptr)
+implicit none
+class(registry_t), intent(inout) :: self
+integer, intent(inout)           :: key
+type(LISTED_TYPE), pointer       :: ptr
+
+call self%remove(key)
+ptr => null()
+
+end subroutine registry_delete_
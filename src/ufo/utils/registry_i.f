@@ -0,0 +1,45 @@
+! (C) Copyright 2022 UCAR
+!
+! This software is licensed under the terms of the Apache Licence Version 2.0
+! which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+
+!> \brief Registry of LISTED_TYPE objects referred to from C++ by integer keys.
+!!
+!! \details Drop-in replacement for the linked list of oops/util/linkedList_i.f, with the same
+!! type-bound procedures (init, add, get, remove, setup and delete). The objects are held in
+!! blocks of slots indexed directly by the key, so get() takes constant time. Blocks never
+!! move once allocated, so get() takes no lock; init(), add() and remove() modify the registry
+!! in a critical section shared by all registries. Objects can therefore be created, used and
+!! destroyed from several threads when UFO is built with OpenMP.
+!!
+!! Include this file in the specification part of a module after defining LISTED_TYPE, and
+!! ufo/utils/registry_c.f in its contains part.
+
+!> Number of slots per block
+integer, parameter :: registry_block_size = 4096
+!> Maximum number of blocks (the largest key is registry_block_size * registry_max_blocks)
+integer, parameter :: registry_max_blocks = 1024
+
+type :: registry_slot_t
+  type(LISTED_TYPE), pointer :: element => null()
+end type registry_slot_t
+
+type :: registry_block_t
+  type(registry_slot_t), pointer :: slots(:) => null()
+end type registry_block_t
+
+type :: registry_t
+  logical :: l_init = .false.
+  integer :: count = 0                                 !< number of registered objects
+  integer :: nkeys = 0                                 !< largest key issued so far
+  type(registry_block_t), allocatable :: blocks(:)
+  integer, allocatable :: free_keys(:)                 !< keys of removed objects, for reuse
+  integer :: nfree = 0
+contains
+  procedure :: init => registry_init_
+  procedure :: add => registry_add_
+  procedure :: get => registry_get_
+  procedure :: remove => registry_remove_
+  procedure :: setup => registry_setup_
+  procedure :: delete => registry_delete_
+end type registry_t
@@ -0,0 +1,46 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ufo/utils/reproduciblesum_f.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "eckit/mpi/Comm.h"
+
+#include "ioda/ObsSpace.h"
+
+#include "ufo/utils/ReproducibleSum.h"
+
+namespace ufo {
+
+// -----------------------------------------------------------------------------
+void ufo_reproducible_sums_f(const ioda::ObsSpace & obsspace, const std::size_t & nsums,
+                             const std::size_t & nterms, const double * terms, double * sums) {
+  if (!reproducibleReductions()) {
+    // Same as local sums followed by an allreduce in Fortran.
+    std::vector<double> localSums(nsums, 0.0);
+    for (std::size_t j = 0; j < nterms; ++j)
+      for (std::size_t i = 0; i < nsums; ++i)
+        localSums[i] += terms[j * nsums + i];
+    obsspace.comm().allReduceInPlace(localSums.begin(), localSums.end(), eckit::mpi::sum());
+    std::copy(localSums.begin(), localSums.end(), sums);
+    return;
+  }
+
+  std::vector<ReproducibleSum> localSums(nsums);
+  for (std::size_t j = 0; j < nterms; ++j)
+    for (std::size_t i = 0; i < nsums; ++i)
+      localSums[i].add(terms[j * nsums + i]);
+  const std::vector<double> values = allReduceValues(localSums, [&](std::vector<double> & v) {
+    obsspace.comm().allReduceInPlace(v.begin(), v.end(), eckit::mpi::sum());
+  });
+  std::copy(values.begin(), values.end(), sums);
+}
+// -----------------------------------------------------------------------------
+
+}  // namespace ufo
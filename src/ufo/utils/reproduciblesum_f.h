@@ -0,0 +1,32 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_UTILS_REPRODUCIBLESUM_F_H_
+#define UFO_UTILS_REPRODUCIBLESUM_F_H_
+
+#include <cstddef>
+
+namespace ioda {
+  class ObsSpace;
+}
+
+// -----------------------------------------------------------------------------
+// These functions provide a Fortran-callable interface to ReproducibleSum
+// -----------------------------------------------------------------------------
+namespace ufo {
+
+extern "C" {
+  /// Set sums(i) to the sum of terms(i, j) over all j and all tasks of the communicator of
+  /// obsspace, reproducibly if reproducibleReductions() is true (terms is stored in the
+  /// Fortran order, with nsums rows and nterms columns).
+  void ufo_reproducible_sums_f(const ioda::ObsSpace & obsspace, const std::size_t & nsums,
+                               const std::size_t & nterms, const double * terms, double * sums);
+}
+
+}  // namespace ufo
+
+#endif  // UFO_UTILS_REPRODUCIBLESUM_F_H_
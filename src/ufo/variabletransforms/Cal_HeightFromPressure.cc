@@ -82,7 +82,7 @@ void Cal_HeightFromPressure::runTransform(const std::vector<bool> &apply) {
 
   if (hasBeenUpdated) {
     // If the geopotential height was updated, save it as a DerivedValue.
-    obsdb_.put_db(getDerivedGroup(heightGroup_), heightCoord_, geopotentialHeight);
+    putObsSpaceVariable(getDerivedGroup(heightGroup_), heightCoord_, geopotentialHeight);
   }
 }
 }  // namespace ufo
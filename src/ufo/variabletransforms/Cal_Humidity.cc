@@ -107,9 +107,9 @@ void Cal_RelativeHumidity::methodUKMO(const std::vector<bool> &apply) {
   // Compulsory surface observation
   //     First looking for surface observation
   //     Then looking for upperair data
-  if (obsdb_.has("ObsValue", pressureat2mvariable_) &&
-      obsdb_.has("ObsValue", temperatureat2mvariable_) &&
-      obsdb_.has("ObsValue", dewpointtemperatureat2mvariable_)) {
+  if (hasObsSpaceVariable("ObsValue", pressureat2mvariable_) &&
+      hasObsSpaceVariable("ObsValue", temperatureat2mvariable_) &&
+      hasObsSpaceVariable("ObsValue", dewpointtemperatureat2mvariable_)) {
     getObservation("ObsValue", pressureat2mvariable_,
                    airPressure, true);
     getObservation("ObsValue", temperatureat2mvariable_,
@@ -301,6 +301,9 @@ void Cal_RelativeHumidity::methodUKMOmixingratio(const std::vector<bool> &apply)
                           "P, T and MixingRatio", Here());
   }
 
+  // Find the obs with valid inputs in each record
+  std::vector<size_t> validObs;
+  std::vector<float> validPressure, validTemperature;
   for (ioda::ObsSpace::RecIdxIter irec = obsdb_.recidx_begin();
        irec != obsdb_.recidx_end(); ++irec) {
     const std::vector<std::size_t> &rSort = obsdb_.recidx_vector(irec);
@@ -309,39 +312,46 @@ void Cal_RelativeHumidity::methodUKMOmixingratio(const std::vector<bool> &apply)
     for (size_t iloc : rSort) {
       if (!apply[iloc]) continue;
 
-      // Store some variables
       const float pressure = airPressure[iloc];
       const float temperature = airTemperature[iloc];
-      const float mixRatio = mixingRatio[iloc];
-
       if (pressure > 0  &&
           pressure != missingValueFloat &&
           temperature != missingValueFloat &&
-          mixRatio != missingValueFloat) {
-        // Sat. vapor pressure from Drybulb temperature  - wrt ice
-        float e_sub_s_ice = formulas::SatVaporPres_fromTemp(temperature,
-                                                            formulation());
-        e_sub_s_ice = formulas::SatVaporPres_correction(e_sub_s_ice,
-                                                        temperature,
-                                                        pressure,
-                                                        formulation());
-        // Convert sat. vapor pressure (wrt ice) to saturated specific humidity (ice)
-        const float Q_sub_s_ice = formulas::Qsat_From_Psat(e_sub_s_ice, pressure);
-
-        // Calculate RH
-        if (mixRatio >= 0 && Q_sub_s_ice > 0) {
-          relativeHumidity[iloc] = (mixRatio / Q_sub_s_ice) * 100.0f;
-        } else {
-          relativeHumidity[iloc] = missingValueFloat;
-        }
-        hasBeenUpdated = true;
-        if (relativeHumidity[iloc] != missingValueFloat &&
-            !allowSuperSaturation_) {
-          relativeHumidity[iloc] = std::min(100.0f, relativeHumidity[iloc]);
-        }
+          mixingRatio[iloc] != missingValueFloat) {
+        validObs.push_back(iloc);
+        validPressure.push_back(pressure);
+        validTemperature.push_back(temperature);
       }
     }
   }
+
+  if (!validObs.empty()) {
+    // Sat. vapor pressure from Drybulb temperature  - wrt ice
+    std::vector<float> e_sub_s_ice;
+    formulas::SatVaporPres_fromTemp(validTemperature, e_sub_s_ice, formulation());
+    formulas::SatVaporPres_correction(e_sub_s_ice, validTemperature, validPressure,
+                                      formulation());
+    // Convert sat. vapor pressure (wrt ice) to saturated specific humidity (ice)
+    std::vector<float> Q_sub_s_ice;
+    formulas::Qsat_From_Psat(e_sub_s_ice, validPressure, Q_sub_s_ice);
+
+    for (size_t jvalid = 0; jvalid < validObs.size(); ++jvalid) {
+      const size_t iloc = validObs[jvalid];
+      const float mixRatio = mixingRatio[iloc];
+
+      // Calculate RH
+      if (mixRatio >= 0 && Q_sub_s_ice[jvalid] > 0) {
+        relativeHumidity[iloc] = (mixRatio / Q_sub_s_ice[jvalid]) * 100.0f;
+      } else {
+        relativeHumidity[iloc] = missingValueFloat;
+      }
+      if (relativeHumidity[iloc] != missingValueFloat &&
+          !allowSuperSaturation_) {
+        relativeHumidity[iloc] = std::min(100.0f, relativeHumidity[iloc]);
+      }
+    }
+    hasBeenUpdated = true;
+  }
   // Assign the derived relative humidity as DerivedObsValue
   if (hasBeenUpdated) {
     putObservation(relativehumidityvariable_, relativeHumidity);
@@ -383,27 +393,36 @@ void Cal_RelativeHumidity::methodDEFAULT(const std::vector<bool> &apply) {
   // Initialise this vector with missing value
   relativeHumidity.assign(nlocs, missingValueFloat);
 
-  // Loop over all obs
+  // Find the obs that have not been excluded by the where statement and have all inputs
+  std::vector<size_t> validObs;
+  std::vector<float> validAirTemperature;
   for (size_t jobs = 0; jobs < nlocs; ++jobs) {
-    // if the data have been excluded by the where statement
-    if (!apply[jobs]) continue;
-
-    if (specificHumidity[jobs] != missingValueFloat &&
+    if (apply[jobs] && specificHumidity[jobs] != missingValueFloat &&
         airTemperature[jobs] != missingValueFloat && pressure[jobs] != missingValueFloat) {
-      // Calculate saturation vapor pressure from temperature according to requested formulation
-      // Double-check result is always lower than 15% of incoming pressure.
-      satVaporPres = formulas::SatVaporPres_fromTemp(airTemperature[jobs], formulation());
-      esat = std::min(pressure[jobs]*0.15f, satVaporPres);
+      validObs.push_back(jobs);
+      validAirTemperature.push_back(airTemperature[jobs]);
+    }
+  }
 
-      // Convert sat. vapor pressure to sat water vapor mixing ratio
-      qvs = 0.622 * esat/(pressure[jobs]-esat);
+  // Calculate saturation vapor pressure from temperature according to requested formulation
+  std::vector<float> validSatVaporPres;
+  formulas::SatVaporPres_fromTemp(validAirTemperature, validSatVaporPres, formulation());
 
-      // Convert specific humidity to water vapor mixing ratio
-      qv = std::max(1.0e-12f, specificHumidity[jobs]/(1.0f-specificHumidity[jobs]));
+  // Loop over the valid obs
+  for (size_t jvalid = 0; jvalid < validObs.size(); ++jvalid) {
+    const size_t jobs = validObs[jvalid];
+    // Double-check result is always lower than 15% of incoming pressure.
+    satVaporPres = validSatVaporPres[jvalid];
+    esat = std::min(pressure[jobs]*0.15f, satVaporPres);
 
-      // Final RH (which can be greater than 100%) is q/qsat, but set sensible lowest limit
-      relativeHumidity[jobs] = std::max(1.0e-6f, qv/qvs);
-    }
+    // Convert sat. vapor pressure to sat water vapor mixing ratio
+    qvs = 0.622 * esat/(pressure[jobs]-esat);
+
+    // Convert specific humidity to water vapor mixing ratio
+    qv = std::max(1.0e-12f, specificHumidity[jobs]/(1.0f-specificHumidity[jobs]));
+
+    // Final RH (which can be greater than 100%) is q/qsat, but set sensible lowest limit
+    relativeHumidity[jobs] = std::max(1.0e-6f, qv/qvs);
   }
 
   putObservation(relativehumidityvariable_, relativeHumidity);
@@ -461,7 +480,7 @@ void Cal_SpecificHumidity::methodDEFAULT(const std::vector<bool> &) {
   std::vector<float> specificHumidity(nlocs);
   bool have_dewpoint = false;
 
-  if (obsdb_.has("ObsValue", relativehumidityvariable_)) {
+  if (hasObsSpaceVariable("ObsValue", relativehumidityvariable_)) {
     getObservation("ObsValue", relativehumidityvariable_,
                    relativeHumidity, true);
   } else {
@@ -513,26 +532,41 @@ void Cal_SpecificHumidity::methodDEFAULT(const std::vector<bool> &) {
   // to compute saturated vapor pressure, convert this to mixing ratio using relative
   // humidity, then end up with final conversion of mixing ratio to specific humdity.
 
+  // The saturation vapor pressure is calculated in a single call for all obs with valid inputs.
+  std::vector<size_t> validObs;
+  std::vector<float> validTemperature, validSatVaporPres;
   if (have_dewpoint) {
     for (size_t jobs = 0; jobs < nlocs; ++jobs) {
       if (pressure[jobs] != missingValueFloat && dewPointTemperature[jobs] != missingValueFloat) {
-        satVaporPres = formulas::SatVaporPres_fromTemp(dewPointTemperature[jobs], formulation());
-        esat = std::min(pressure[jobs]*0.15f, satVaporPres);
-        qv = 0.622 * esat/(pressure[jobs]-esat);
-        specificHumidity[jobs] = std::max(1.0e-12f, qv/(1.0f+qv));
+        validObs.push_back(jobs);
+        validTemperature.push_back(dewPointTemperature[jobs]);
       }
     }
+    formulas::SatVaporPres_fromTemp(validTemperature, validSatVaporPres, formulation());
+    for (size_t jvalid = 0; jvalid < validObs.size(); ++jvalid) {
+      const size_t jobs = validObs[jvalid];
+      satVaporPres = validSatVaporPres[jvalid];
+      esat = std::min(pressure[jobs]*0.15f, satVaporPres);
+      qv = 0.622 * esat/(pressure[jobs]-esat);
+      specificHumidity[jobs] = std::max(1.0e-12f, qv/(1.0f+qv));
+    }
   } else {
     for (size_t jobs = 0; jobs < nlocs; ++jobs) {
       if (pressure[jobs] != missingValueFloat && airTemperature[jobs] != missingValueFloat &&
                 relativeHumidity[jobs] != missingValueFloat) {
-        satVaporPres = formulas::SatVaporPres_fromTemp(airTemperature[jobs], formulation());
-        esat = std::min(pressure[jobs]*0.15f, satVaporPres);
-        qvs = 0.622 * esat/(pressure[jobs]-esat);
-        qv = std::max(1.0e-12f, relativeHumidity[jobs]*qvs);
-        specificHumidity[jobs] = std::max(1.0e-12f, qv/(1.0f+qv));
+        validObs.push_back(jobs);
+        validTemperature.push_back(airTemperature[jobs]);
       }
     }
+    formulas::SatVaporPres_fromTemp(validTemperature, validSatVaporPres, formulation());
+    for (size_t jvalid = 0; jvalid < validObs.size(); ++jvalid) {
+      const size_t jobs = validObs[jvalid];
+      satVaporPres = validSatVaporPres[jvalid];
+      esat = std::min(pressure[jobs]*0.15f, satVaporPres);
+      qvs = 0.622 * esat/(pressure[jobs]-esat);
+      qv = std::max(1.0e-12f, relativeHumidity[jobs]*qvs);
+      specificHumidity[jobs] = std::max(1.0e-12f, qv/(1.0f+qv));
+    }
   }
 
   putObservation(specifichumidityvariable_, specificHumidity);
@@ -55,7 +55,7 @@ void Cal_PStar::runTransform(const std::vector<bool> &apply) {
                  Pmsl, true);
 
   // MetaData
-  if (data_.has(Variable("MetaData/correctedStationAltitude"))) {
+  if (hasObsSpaceVariable("MetaData", "correctedStationAltitude")) {
     getObservation("MetaData", "correctedStationAltitude",
                      ZStn);
   } else {
@@ -118,8 +118,9 @@ void Cal_PStar::runTransform(const std::vector<bool> &apply) {
   std::vector<bool> PstnUsed_flag(nlocs, false);
 
   // get diagnostic flags from ObsSpace (warn if they have not yet been created)
-  if (obsdb_.has("DiagnosticFlags/PreferredVariable", "stationPressure")) {
-    obsdb_.get_db("DiagnosticFlags/PreferredVariable", "stationPressure", PreferredVariable_flag);
+  if (hasObsSpaceVariable("DiagnosticFlags/PreferredVariable", "stationPressure")) {
+    getObsSpaceVariable("DiagnosticFlags/PreferredVariable", "stationPressure",
+                        PreferredVariable_flag);
   } else {
     throw eckit::UserError("Variable 'DiagnosticFlags/PreferredVariable/stationPressure' does not "
                            "exist yet. It needs to be set up with the 'Create Diagnostic "
@@ -174,11 +175,11 @@ void Cal_PStar::runTransform(const std::vector<bool> &apply) {
   }
 
   putObservation("surface_pressure", PStar);
-  obsdb_.put_db("DerivedObsError", "surface_pressure", PStar_error);
-  obsdb_.put_db("GrossErrorProbability", "surface_pressure", PStar_PGE);
-  obsdb_.put_db("DiagnosticFlags/PmslUsed", "surface_pressure", PmslUsed_flag);
-  obsdb_.put_db("DiagnosticFlags/PstdUsed", "surface_pressure", PstdUsed_flag);
-  obsdb_.put_db("DiagnosticFlags/PstnUsed", "surface_pressure", PstnUsed_flag);
+  putObsSpaceVariable("DerivedObsError", "surface_pressure", PStar_error);
+  putObsSpaceVariable("GrossErrorProbability", "surface_pressure", PStar_PGE);
+  putObsSpaceVariable("DiagnosticFlags/PmslUsed", "surface_pressure", PmslUsed_flag);
+  putObsSpaceVariable("DiagnosticFlags/PstdUsed", "surface_pressure", PstdUsed_flag);
+  putObsSpaceVariable("DiagnosticFlags/PstnUsed", "surface_pressure", PstnUsed_flag);
 }
 }  // namespace ufo
 
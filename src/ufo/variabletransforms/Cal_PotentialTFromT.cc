@@ -106,7 +106,7 @@ void Cal_PotentialTFromT::runTransform(const std::vector<bool> &apply) {
     }
   }
 
-  obsdb_.put_db("DerivedObsValue", potentialtempvariable_, potTemp);
+  putObsSpaceVariable("DerivedObsValue", potentialtempvariable_, potTemp);
   const size_t iv = obserr_.varnames().find(potentialtempvariable_);
   for (size_t jobs = 0; jobs < obsdb_.nlocs(); ++jobs) {
     if (!apply[jobs])
@@ -115,7 +115,7 @@ void Cal_PotentialTFromT::runTransform(const std::vector<bool> &apply) {
   }
 
   // copy temperature's PGEFinal and QCflags to new potentialTemperature
-  obsdb_.put_db("GrossErrorProbability", potentialtempvariable_, temppge);
-  obsdb_.put_db("QCFlags", potentialtempvariable_, tempflags);
+  putObsSpaceVariable("GrossErrorProbability", potentialtempvariable_, temppge);
+  putObsSpaceVariable("QCFlags", potentialtempvariable_, tempflags);
 }
 }  // namespace ufo
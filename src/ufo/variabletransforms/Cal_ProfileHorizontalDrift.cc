@@ -5,6 +5,8 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <vector>
+
 #include "ufo/variabletransforms/Cal_ProfileHorizontalDrift.h"
 #include "ufo/utils/Constants.h"
 
@@ -86,21 +88,28 @@ void Cal_ProfileHorizontalDrift::runTransform(const std::vector<bool> &apply) {
   // Number of profiles in the ObsSpace.
   const size_t nprofs = recnums.size();
 
-  // Perform drift calculation for each profile in the sample.
+  // Locations of each profile.
+  std::vector<const std::vector<size_t> *> profileLocs(nprofs);
+  for (size_t jprof = 0; jprof < nprofs; ++jprof)
+    profileLocs[jprof] = &obsdb_.recidx_vector(recnums[jprof]);
+
+  // Perform drift calculation for each profile in the sample. Profiles are independent and
+  // write to disjoint locations of the output vectors, so they are processed in parallel.
+  const util::DateTime * const windowEnd = keep_in_window_ ? &(obsdb_.windowEnd()) : nullptr;
+#pragma omp parallel for schedule(dynamic)
   for (size_t jprof = 0; jprof < nprofs; ++jprof) {
-    const std::vector<size_t> &locs = obsdb_.recidx_vector(recnums[jprof]);
+    const std::vector<size_t> &locs = *profileLocs[jprof];
     formulas::horizontalDrift(locs, apply,
                               latitude_in, longitude_in, datetime_in,
                               height, wind_speed, wind_from_direction,
                               latitude_out, longitude_out, datetime_out,
-                              formulas::MethodFormulation::UKMO,
-                              keep_in_window_ ? &(obsdb_.windowEnd()) : nullptr);
+                              formulas::MethodFormulation::UKMO, windowEnd);
   }
 
   // Save output values.
-  obsdb_.put_db("MetaData", "latitude", latitude_out);
-  obsdb_.put_db("MetaData", "longitude", longitude_out);
-  obsdb_.put_db("MetaData", "dateTime", datetime_out);
+  putObsSpaceVariable("MetaData", "latitude", latitude_out);
+  putObsSpaceVariable("MetaData", "longitude", longitude_out);
+  putObsSpaceVariable("MetaData", "dateTime", datetime_out);
 }
 }  // namespace ufo
 
@@ -47,37 +47,37 @@ void Cal_QNHtoQFEpressure::runTransform(const std::vector<bool> &apply) {
 
   // MetaData
   std::vector<float> ZStn, PStn_error;
-  if (data_.has(Variable("MetaData/correctedStationAltitude"))) {
+  if (hasObsSpaceVariable("MetaData", "correctedStationAltitude")) {
     getObservation("MetaData", "correctedStationAltitude",
                      ZStn);
   } else {
     getObservation("MetaData", "stationAltitude",
                      ZStn);
   }
-  data_.get(Variable("ObsError/stationPressure"),
-            PStn_error);
+  getFilterData(Variable("ObsError/stationPressure"),
+                PStn_error);
   // Flags
   std::vector<bool> notRounded_flag;
   std::vector<bool> QNHinHg_flag;
   std::vector<bool> QNHhPa_flag;
 
   // get diagnostic flags from ObsSpace (warn if they have not yet been created)
-  if (obsdb_.has("DiagnosticFlags/notRounded", "stationPressure")) {
-    obsdb_.get_db("DiagnosticFlags/notRounded", "stationPressure", notRounded_flag);
+  if (hasObsSpaceVariable("DiagnosticFlags/notRounded", "stationPressure")) {
+    getObsSpaceVariable("DiagnosticFlags/notRounded", "stationPressure", notRounded_flag);
   } else {
     throw eckit::UserError("Variable 'DiagnosticFlags/notRounded/stationPressure' does not "
                            "exist yet. It needs to be set up with the 'Create Diagnostic "
                            "Flags' filter prior to using the 'set' or 'unset' action.");
   }
-  if (obsdb_.has("DiagnosticFlags/QNHinHg", "stationPressure")) {
-    obsdb_.get_db("DiagnosticFlags/QNHinHg", "stationPressure", QNHinHg_flag);
+  if (hasObsSpaceVariable("DiagnosticFlags/QNHinHg", "stationPressure")) {
+    getObsSpaceVariable("DiagnosticFlags/QNHinHg", "stationPressure", QNHinHg_flag);
   } else {
     throw eckit::UserError("Variable 'DiagnosticFlags/QNHinHg/stationPressure' does not exist yet. "
                            "It needs to be set up with the 'Create Diagnostic Flags' filter "
                            "prior to using the 'set' or 'unset' action.");
   }
-  if (obsdb_.has("DiagnosticFlags/QNHhPa", "stationPressure")) {
-    obsdb_.get_db("DiagnosticFlags/QNHhPa", "stationPressure", QNHhPa_flag);
+  if (hasObsSpaceVariable("DiagnosticFlags/QNHhPa", "stationPressure")) {
+    getObsSpaceVariable("DiagnosticFlags/QNHhPa", "stationPressure", QNHhPa_flag);
   } else {
     throw eckit::UserError("Variable 'DiagnosticFlags/QNHhPa/stationPressure' does not exist yet. "
                            "It needs to be set up with the 'Create Diagnostic Flags' filter "
@@ -119,9 +119,9 @@ void Cal_QNHtoQFEpressure::runTransform(const std::vector<bool> &apply) {
   }
 
   putObservation("stationPressure", PStn);
-  obsdb_.put_db("DiagnosticFlags/QNHhPa", "stationPressure", QNHhPa_flag);
-  obsdb_.put_db("DiagnosticFlags/QNHinHg", "stationPressure", QNHinHg_flag);
-  obsdb_.put_db("DerivedObsError", "stationPressure", PStn_error);
+  putObsSpaceVariable("DiagnosticFlags/QNHhPa", "stationPressure", QNHhPa_flag);
+  putObsSpaceVariable("DiagnosticFlags/QNHinHg", "stationPressure", QNHinHg_flag);
+  putObsSpaceVariable("DerivedObsError", "stationPressure", PStn_error);
 }
 }  // namespace ufo
 
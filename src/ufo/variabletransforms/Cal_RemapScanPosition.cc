@@ -51,7 +51,7 @@ void Cal_RemapScanPosition::runTransform(const std::vector<bool> &apply) {
     }
   }
   // Overwrite variable at existing locations
-  obsdb_.put_db("MetaData", "scan_position", remapped_scan_position);
+  putObsSpaceVariable("MetaData", "scan_position", remapped_scan_position);
 }
 }  // namespace ufo
 
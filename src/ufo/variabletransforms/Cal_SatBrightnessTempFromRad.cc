@@ -45,12 +45,12 @@ void Cal_SatBrightnessTempFromRad::runTransform(const std::vector<bool> &apply)
   // Read in radiance to be corrected
   oops::Variables radianceVar(parameters_.transformVariable.value().toOopsVariables());
   ioda::ObsDataVector<float> radiance(obsdb_, radianceVar);
-  data_.get(parameters_.transformVariable.value(), radiance);
+  getFilterData(parameters_.transformVariable.value(), radiance);
 
   // Read in the spectral variable
   oops::Variables spectralVar(parameters_.spectralVariable.value().toOopsVariables());
   ioda::ObsDataVector<float> spectralVariable(obsdb_, spectralVar);
-  data_.get(parameters_.spectralVariable.value(), spectralVariable);
+  getFilterData(parameters_.spectralVariable.value(), spectralVariable);
 
   // Setup Variables
   const size_t nlocs = obsdb_.nlocs();
@@ -65,50 +65,61 @@ void Cal_SatBrightnessTempFromRad::runTransform(const std::vector<bool> &apply)
   // Sanity check
   ASSERT(radiance.nlocs() == nlocs);
 
-  // Loop over all obs
-  for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    if (apply[iloc]) {
-      for (size_t ichan = 0; ichan < nvars; ++ichan) {
-        if ( radiance[ichan][iloc] != missingValueFloat &&
-             radiance[ichan][iloc] > 0.0f &&
-             spectralVariable[ichan][iloc] != missingValueFloat) {
-          double bt = missingValueFloat;
-          switch (parameters_.radianceUnits.value()) {
-            case RadianceUnits::WAVENUMBER: {
-              bt = formulas::inversePlanck(static_cast<double>(radiance[ichan][iloc]),
-                                           static_cast<double>(spectralVariable[ichan][iloc]),
-                                           parameters_.planck1.value(),
-                                           parameters_.planck2.value());
-              break;
-            }
-            case RadianceUnits::FREQUENCY: {
-              double freq = static_cast<double>(spectralVariable[ichan][iloc]);
-              double wvn = freq / Constants::speedOfLight;  // Hz to m-1
-              double rad = static_cast<double>(radiance[ichan][iloc]) * freq / wvn;
-              bt = formulas::inversePlanck(rad, wvn, parameters_.planck1.value(),
-                                           parameters_.planck2.value());
-              break;
-            }
-            case RadianceUnits::WAVELENGTH: {
-              double wvl = static_cast<double>(spectralVariable[ichan][iloc]);
-              double wvn = 1.0e6 / wvl;  // microns to m-1
-              double rad = static_cast<double>(radiance[ichan][iloc]) * wvl / wvn;
-              bt = formulas::inversePlanck(rad, wvn, parameters_.planck1.value(),
-                                           parameters_.planck2.value());
-              break;
-            }
-          }
-          brightnessTemperature[ichan][iloc] = static_cast<float>(bt);
-          if (minval != missingValueFloat)
-            if (brightnessTemperature[ichan][iloc] < minval)
-              brightnessTemperature[ichan][iloc] = missingValueFloat;
-          if (maxval != missingValueFloat)
-            if (brightnessTemperature[ichan][iloc] > maxval)
-              brightnessTemperature[ichan][iloc] = missingValueFloat;
+  // Convert one channel at a time: first the radiances and spectral variable to the units
+  // expected by inversePlanck() (at valid locations only; the results at other locations are
+  // discarded), then all locations at once.
+  std::vector<double> rad(nlocs), wvn(nlocs), bt;
+  std::vector<bool> valid(nlocs);
+  for (size_t ichan = 0; ichan < nvars; ++ichan) {
+    const std::vector<float> &radianceChan = radiance[ichan];
+    const std::vector<float> &spectralChan = spectralVariable[ichan];
+    for (size_t iloc = 0; iloc < nlocs; ++iloc) {
+      valid[iloc] = apply[iloc] &&
+                    radianceChan[iloc] != missingValueFloat &&
+                    radianceChan[iloc] > 0.0f &&
+                    spectralChan[iloc] != missingValueFloat;
+      if (!valid[iloc]) {
+        rad[iloc] = 1.0;
+        wvn[iloc] = 1.0;
+        continue;
+      }
+      switch (parameters_.radianceUnits.value()) {
+        case RadianceUnits::WAVENUMBER: {
+          rad[iloc] = static_cast<double>(radianceChan[iloc]);
+          wvn[iloc] = static_cast<double>(spectralChan[iloc]);
+          break;
         }
-      }  // ichan
-    }  // apply
-  }  // iloc
+        case RadianceUnits::FREQUENCY: {
+          double freq = static_cast<double>(spectralChan[iloc]);
+          wvn[iloc] = freq / Constants::speedOfLight;  // Hz to m-1
+          rad[iloc] = static_cast<double>(radianceChan[iloc]) * freq / wvn[iloc];
+          break;
+        }
+        case RadianceUnits::WAVELENGTH: {
+          double wvl = static_cast<double>(spectralChan[iloc]);
+          wvn[iloc] = 1.0e6 / wvl;  // microns to m-1
+          rad[iloc] = static_cast<double>(radianceChan[iloc]) * wvl / wvn[iloc];
+          break;
+        }
+      }
+    }
+
+    formulas::inversePlanck(rad, wvn, bt, parameters_.planck1.value(),
+                            parameters_.planck2.value());
+
+    std::vector<float> &btChan = brightnessTemperature[ichan];
+    for (size_t iloc = 0; iloc < nlocs; ++iloc) {
+      if (!valid[iloc])
+        continue;
+      btChan[iloc] = static_cast<float>(bt[iloc]);
+      if (minval != missingValueFloat)
+        if (btChan[iloc] < minval)
+          btChan[iloc] = missingValueFloat;
+      if (maxval != missingValueFloat)
+        if (btChan[iloc] > maxval)
+          btChan[iloc] = missingValueFloat;
+    }
+  }  // ichan
 
   //  Write out the resulting data to Derived group and update qcflags
   for (size_t ichan =0; ichan < nvars; ++ichan) {
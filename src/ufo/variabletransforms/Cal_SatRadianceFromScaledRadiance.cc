@@ -51,7 +51,7 @@ void Cal_SatRadianceFromScaledRadiance::runTransform(const std::vector<bool> &ap
   // Read in radiance to be corrected
   oops::Variables radianceVar(parameters_.transformVariable.value().toOopsVariables());
   ioda::ObsDataVector<float> radiance(obsdb_, radianceVar);
-  data_.get(parameters_.transformVariable.value(), radiance);
+  getFilterData(parameters_.transformVariable.value(), radiance);
 
   // Read in scaling factors
   std::vector<int> channelScaleFactor(numScaleFactors, missingValueInt);
@@ -88,22 +88,23 @@ void Cal_SatRadianceFromScaledRadiance::runTransform(const std::vector<bool> &ap
   // Loop over all obs
   // takes a scaled radiance and produces a radiance in (W / (m^2.sr.m^-1))
   // radiance is power / (area . solid angle . wavenumber)
-  for (size_t iloc = 0; iloc < nlocs; ++iloc) {
-    if (apply[iloc]) {
-      for (size_t ichan = 0; ichan < nvars; ++ichan) {
-        if (radiance[ichan][iloc] != missingValueFloat  &&
-            radiance[ichan][iloc] > 0.0f) {
-          for (size_t iscale = 0; iscale < numScaleFactors; ++iscale) {
-            if (channels_[ichan] >= startChannelScale[iscale] &
-                channels_[ichan] <= endChannelScale[iscale]) {
-              radiance[ichan][iloc] *= std::pow(10, (-1.0f*channelScaleFactor[iscale]));
-              break;
-            }  // if channels_
-          }  // iscale
-        }  // if missing
-      }  // ichan
-    }  // apply
-  }  // iloc
+  // The scale factor is the same for all locations, so it is found once per channel.
+  for (size_t ichan = 0; ichan < nvars; ++ichan) {
+    size_t iscale = 0;
+    while (iscale < numScaleFactors &&
+           !(channels_[ichan] >= startChannelScale[iscale] &&
+             channels_[ichan] <= endChannelScale[iscale]))
+      ++iscale;
+    if (iscale == numScaleFactors)
+      continue;
+    const double scale = std::pow(10, (-1.0f*channelScaleFactor[iscale]));
+    std::vector<float> &radianceChan = radiance[ichan];
+    for (size_t iloc = 0; iloc < nlocs; ++iloc) {
+      if (apply[iloc] && radianceChan[iloc] != missingValueFloat &&
+          radianceChan[iloc] > 0.0f)
+        radianceChan[iloc] *= scale;
+    }  // iloc
+  }  // ichan
 
   //  Write out the resulting data to Derived group and update qcflags
   for (size_t ichan =0; ichan < nvars; ++ichan) {
@@ -45,7 +45,7 @@ void Cal_SatZenithAngleCorrection::runTransform(const std::vector<bool> &apply)
   // Read in variable to be corrected
   oops::Variables varin(variableToBeCorrected.toOopsVariables());
   ioda::ObsDataVector<float> varArray(obsdb_, varin);
-  data_.get(variableToBeCorrected, varArray);
+  getFilterData(variableToBeCorrected, varArray);
 
   // Read in zenith angle
   std::vector<float> zenithAngle;
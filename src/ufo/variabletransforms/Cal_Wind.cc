@@ -55,19 +55,16 @@ void Cal_WindSpeedAndDirection::runTransform(const std::vector<bool> &apply) {
                           "U, and V", Here());
   }
 
-  std::vector<float> windSpeed(nlocs), windFromDirection(nlocs);
-  windSpeed.assign(nlocs, missingValueFloat);
-  windFromDirection.assign(nlocs, missingValueFloat);
+  // Calculate wind vector (missing where either component is missing)
+  std::vector<float> windSpeed, windFromDirection;
+  formulas::GetWindDirection(u, v, windFromDirection);
+  formulas::GetWindSpeed(u, v, windSpeed);
 
-  // Loop over all obs
+  // Discard the data excluded by the where statement
   for (size_t jobs = 0; jobs < nlocs; ++jobs) {
-    // if the data have been excluded by the where statement
-    if (!apply[jobs]) continue;
-
-    // Calculate wind vector
-    if (u[jobs] != missingValueFloat && v[jobs] != missingValueFloat) {
-       windFromDirection[jobs] = formulas::GetWindDirection(u[jobs], v[jobs]);
-       windSpeed[jobs] = formulas::GetWindSpeed(u[jobs], v[jobs]);
+    if (!apply[jobs]) {
+      windFromDirection[jobs] = missingValueFloat;
+      windSpeed[jobs] = missingValueFloat;
     }
   }
   // put new variable at existing locations
@@ -124,17 +121,17 @@ void Cal_WindComponents::runTransform(const std::vector<bool> &apply) {
                             "wind speed, and direction", Here());
     }
 
-    std::vector<float> u(nlocs, missingValueFloat), v(nlocs, missingValueFloat);
+    // Calculate wind vector (missing where the speed or direction is missing or the speed is
+    // negative)
+    std::vector<float> u, v;
+    formulas::GetWind_U(windSpeed, windFromDirection, u);
+    formulas::GetWind_V(windSpeed, windFromDirection, v);
 
+    // Discard the data excluded by the where statement
     for (size_t jobs = 0; jobs < nlocs; ++jobs) {
-      // if the data have been excluded by the where statement
-      if (!apply[jobs]) continue;
-
-      // Calculate wind vector
-      if (windFromDirection[jobs] != missingValueFloat &&
-          windSpeed[jobs] != missingValueFloat && windSpeed[jobs] >= 0) {
-        u[jobs] = formulas::GetWind_U(windSpeed[jobs], windFromDirection[jobs]);
-        v[jobs] = formulas::GetWind_V(windSpeed[jobs], windFromDirection[jobs]);
+      if (!apply[jobs]) {
+        u[jobs] = missingValueFloat;
+        v[jobs] = missingValueFloat;
       }
     }
     if (windspeedvariable_.find("At10M") != std::string::npos) {
@@ -151,10 +148,10 @@ void Cal_WindComponents::runTransform(const std::vector<bool> &apply) {
     std::vector<std::vector<float>> windSpeed(nchans, std::vector<float>(nlocs));
     std::vector<std::vector<float>> windFromDirection(nchans, std::vector<float>(nlocs));
     for (size_t ichan = 0; ichan < nchans; ++ichan) {
-      data_.get(Variable(group_ + "/" + windspeedvariable_, channels)[ichan],
-                windSpeed[ichan]);
-      data_.get(Variable(group_ + "/" + winddirectionvariable_, channels)[ichan],
-                windFromDirection[ichan]);
+      getFilterData(Variable(group_ + "/" + windspeedvariable_, channels)[ichan],
+                    windSpeed[ichan]);
+      getFilterData(Variable(group_ + "/" + winddirectionvariable_, channels)[ichan],
+                    windFromDirection[ichan]);
     }
 
     if (!oops::allVectorsSameNonZeroSize(windSpeed, windFromDirection)) {
@@ -164,22 +161,19 @@ void Cal_WindComponents::runTransform(const std::vector<bool> &apply) {
                             "wind speed, and direction", Here());
     }
 
-    std::vector<std::vector<float>> u(nchans, std::vector<float>(nlocs, missingValueFloat)),
-                                    v(nchans, std::vector<float>(nlocs, missingValueFloat));
+    std::vector<std::vector<float>> u(nchans), v(nchans);
 
-    // Loop over all obs
+    // Loop over all channels
     for (size_t jchan = 0; jchan < nchans; ++jchan) {
+      // Calculate wind vector
+      formulas::GetWind_U(windSpeed[jchan], windFromDirection[jchan], u[jchan]);
+      formulas::GetWind_V(windSpeed[jchan], windFromDirection[jchan], v[jchan]);
+
+      // Discard the data excluded by the where statement
       for (size_t jobs = 0; jobs < nlocs; ++jobs) {
-        // if the data have been excluded by the where statement
-        if (!apply[jobs]) continue;
-
-        // Calculate wind vector
-        if (windFromDirection[jchan][jobs] != missingValueFloat &&
-              windSpeed[jchan][jobs] != missingValueFloat && windSpeed[jchan][jobs] >= 0) {
-          u[jchan][jobs] = formulas::GetWind_U(windSpeed[jchan][jobs],
-                           windFromDirection[jchan][jobs]);
-          v[jchan][jobs] = formulas::GetWind_V(windSpeed[jchan][jobs],
-                           windFromDirection[jchan][jobs]);
+        if (!apply[jobs]) {
+          u[jchan][jobs] = missingValueFloat;
+          v[jchan][jobs] = missingValueFloat;
         }
       }
     }
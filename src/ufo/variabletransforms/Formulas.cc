@@ -42,165 +42,262 @@ MethodFormulation resolveFormulations(const std::string& input, const std::strin
   }
 }
 
-/* -------------------------------------------------------------------------------------*/
-float SatVaporPres_fromTemp(float temp_K, MethodFormulation formulation) {
+namespace {
+
+// Kernels of the functions below, templated on the formulation so that the loops of their array
+// versions contain no formulation-dependent branches.
+
+template <MethodFormulation formulation>
+inline float satVaporPresFromTemp(float temp_K);
+
+template <>
+inline float satVaporPresFromTemp<Sonntag>(float temp_K) {
+  /* I. Source: Eqn 7, Sonntag, D., Advancements in the field of hygrometry,
+   *     Meteorol. Zeitschrift, N. F., 3, 51-66, 1994.
+   *     Most radiosonde manufacturers use Wexler, or Hyland and Wexler
+   *     or Sonntag formulations, which are all very similar (Holger Vomel,
+   *     pers. comm., 2011)
+  */
+  const float missingValueFloat = util::missingValue(1.0f);
+  if (temp_K != missingValueFloat) {
+    return std::exp(-6096.9385f / temp_K + 21.2409642f - 2.711193E-2f * temp_K +
+                    1.673952E-5f * temp_K * temp_K + 2.433502f * std::log(temp_K));
+  } else {
+    return 0.0f;
+  }
+}
+
+template <>
+inline float satVaporPresFromTemp<LandoltBornstein>(float temp_K) {
+  /* Returns a saturation mixing ratio given a temperature and pressure
+     using saturation vapour pressures caluclated using the Goff-Gratch
+     formulae, adopted by the WMO as taken from Landolt-Bornstein, 1987
+     Numerical Data and Functional relationships in Science and
+     Technology.  Group V/Vol 4B Meteorology.  Physical and Chemical
+     properties of Air, P35.
+  */
   const float missingValueFloat = util::missingValue(1.0f);
+  if (temp_K != missingValueFloat) {
+    float adj_Temp;
+    float lookup_a;
+    int lookup_i;
+
+    const float Low_temp_thd = 183.15;   // Lowest temperature for which look-up table is valid
+    const float High_temp_thd = 338.15;  // Highest temperature for which look-up table is valid
+    const float Delta_Temp = 0.1;        // Temperature increment of look-up table
+
+    //  Use the lookup table to find saturated vapour pressure.
+    adj_Temp = std::max(Low_temp_thd, temp_K);
+    adj_Temp = std::min(High_temp_thd, adj_Temp);
+
+    lookup_a = (adj_Temp - Low_temp_thd + Delta_Temp) / Delta_Temp;
+    lookup_i = static_cast<int>(lookup_a);
+    lookup_a = lookup_a - lookup_i;
+    return (1.0 - lookup_a) *
+           lookuptable::LandoltBornstein_lookuptable[lookup_i] +
+           lookup_a *
+           lookuptable::LandoltBornstein_lookuptable[lookup_i + 1];
+  } else {
+    return 0.0f;
+  }
+}
+
+template <>
+inline float satVaporPresFromTemp<Walko>(float temp_K) {
+  // Polynomial fit of Goff-Gratch (1946) formulation. (Walko, 1991)
+  const float t0c = static_cast<float>(ufo::Constants::t0c);
+  const float x = std::max(-80.0f, temp_K-t0c);
+  const float c[] = {610.5851f, 44.40316f, 1.430341f, 0.2641412e-1f,
+    0.2995057e-3f, 0.2031998e-5f, 0.6936113e-8f, 0.2564861e-11f, -0.3704404e-13f};
+  return c[0]+x*(c[1]+x*(c[2]+x*(c[3]+x*(c[4]+x*(c[5]+x*(c[6]+x*(c[7]+x*c[8])))))));
+}
+
+template <>
+inline float satVaporPresFromTemp<Murphy>(float temp_K) {
+  // ALTERNATIVE (costs more CPU, more accurate than Walko, 1991)
+  // Source: Murphy and Koop, Review of the vapour pressure of ice and
+  //       supercooled water for atmospheric applications, Q. J. R.
+  //       Meteorol. Soc (2005), 131, pp. 1539-1565.
+  return std::exp(54.842763f - 6763.22f / temp_K - 4.210f * std::log(temp_K)
+                  + 0.000367f * temp_K + std::tanh(0.0415f * (temp_K - 218.8f))
+                  * (53.878f - 1331.22f / temp_K - 9.44523f * std::log(temp_K)
+                  + 0.014025f * temp_K));
+}
+
+template <>
+inline float satVaporPresFromTemp<Rogers>(float temp_K) {
+  // Classical formula from Rogers and Yau (1989; Eq2.17)
   const float t0c = static_cast<float>(ufo::Constants::t0c);
-  float e_sub_s = missingValueFloat;  // Saturation vapour pressure (Pa)
+  return 1000. * 0.6112 * std::exp(17.67f * (temp_K - t0c) / (temp_K - 29.65f));
+}
+
+inline float satVaporPresCorrection(float e_sub_s, float temp_K, float pressure) {
+  /* e_sub_s is the saturation vapour pressure of pure water vapour.FsubW (~ 1.005
+     at 1000 hPa) is the enhancement factor needed for moist air.
+     If P is set to -1: then eg eqns 20, 22 of Sonntag is used
+     If P > 0 then eqn A4.6 of Adrian Gill's book is used to guarantee consistency with the
+     saturated specific humidity.
+  */
+  const float t0c = static_cast<float>(ufo::Constants::t0c);
+  float FsubW;  // Enhancement factor
+  FsubW = 1.0f + 1.0E-8f * pressure * (4.5f + 6.0E-4f * (temp_K - t0c) *(temp_K - t0c));
+  return e_sub_s * FsubW;
+}
+
+inline float qsatFromPsat(float Psat, float P) {
+  // Calculation using the Sonntag (1994) formula. (With fix at low
+  // pressure)
+  //  Note that at very low pressures we apply a fix, to prevent a
+  //     singularity (Qsat tends to 1.0 kg/kg).
+  return (Constants::epsilon * Psat) /
+         (std::max(P, Psat) - (1.0f - Constants::epsilon) * Psat);
+}
+
+inline float virtualTempFromPsatPT(float Psat, float P, float T) {
+  return T * ((P + Psat / Constants::epsilon) / (P + Psat));
+}
 
+/// Map the formulations accepted by SatVaporPres_fromTemp() onto the kernel implementing them.
+MethodFormulation satVaporPresKernel(MethodFormulation formulation) {
   switch (formulation) {
     case formulas::MethodFormulation::UKMO:
-    case formulas::MethodFormulation::Sonntag: {
-      /* I. Source: Eqn 7, Sonntag, D., Advancements in the field of hygrometry,
-       *     Meteorol. Zeitschrift, N. F., 3, 51-66, 1994.
-       *     Most radiosonde manufacturers use Wexler, or Hyland and Wexler
-       *     or Sonntag formulations, which are all very similar (Holger Vomel,
-       *     pers. comm., 2011)
-      */
-      if (temp_K != missingValueFloat) {
-        e_sub_s = std::exp(-6096.9385f / temp_K + 21.2409642f - 2.711193E-2f * temp_K +
-                        1.673952E-5f * temp_K * temp_K + 2.433502f * std::log(temp_K));
-      } else {
-        e_sub_s = 0.0f;
-      }
-      break;
-    }
+    case formulas::MethodFormulation::Sonntag:
+      return Sonntag;
     case formulas::MethodFormulation::UKMOmixingratio:
-    case formulas::MethodFormulation::LandoltBornstein: {
-      /* Returns a saturation mixing ratio given a temperature and pressure
-         using saturation vapour pressures caluclated using the Goff-Gratch
-         formulae, adopted by the WMO as taken from Landolt-Bornstein, 1987
-         Numerical Data and Functional relationships in Science and
-         Technology.  Group V/Vol 4B Meteorology.  Physical and Chemical
-         properties of Air, P35.
-      */
-      if (temp_K != missingValueFloat) {
-        float adj_Temp;
-        float lookup_a;
-        int lookup_i;
-
-        const float Low_temp_thd = 183.15;   // Lowest temperature for which look-up table is valid
-        const float High_temp_thd = 338.15;  // Highest temperature for which look-up table is valid
-        const float Delta_Temp = 0.1;        // Temperature increment of look-up table
-
-        //  Use the lookup table to find saturated vapour pressure.
-        adj_Temp = std::max(Low_temp_thd, temp_K);
-        adj_Temp = std::min(High_temp_thd, adj_Temp);
-
-        lookup_a = (adj_Temp - Low_temp_thd + Delta_Temp) / Delta_Temp;
-        lookup_i = static_cast<int>(lookup_a);
-        lookup_a = lookup_a - lookup_i;
-        e_sub_s = (1.0 - lookup_a) *
-                  lookuptable::LandoltBornstein_lookuptable[lookup_i] +
-                  lookup_a *
-                  lookuptable::LandoltBornstein_lookuptable[lookup_i + 1];
-      } else {
-        e_sub_s = 0.0f;
-      }
-      break;
-    }
-    case formulas::MethodFormulation::Walko: {
-          // Polynomial fit of Goff-Gratch (1946) formulation. (Walko, 1991)
-          float x = std::max(-80.0f, temp_K-t0c);
-          const std::vector<float> c{610.5851f, 44.40316f, 1.430341f, 0.2641412e-1f,
-            0.2995057e-3f, 0.2031998e-5f, 0.6936113e-8f, 0.2564861e-11f, -0.3704404e-13f};
-          e_sub_s = c[0]+x*(c[1]+x*(c[2]+x*(c[3]+x*(c[4]+x*(c[5]+x*(c[6]+x*(c[7]+x*c[8])))))));
-          break;
-    }
-    case formulas::MethodFormulation::Murphy: {
-      // ALTERNATIVE (costs more CPU, more accurate than Walko, 1991)
-      // Source: Murphy and Koop, Review of the vapour pressure of ice and
-      //       supercooled water for atmospheric applications, Q. J. R.
-      //       Meteorol. Soc (2005), 131, pp. 1539-1565.
-      e_sub_s = std::exp(54.842763f - 6763.22f / temp_K - 4.210f * std::log(temp_K)
-                     + 0.000367f * temp_K + std::tanh(0.0415f * (temp_K - 218.8f))
-                     * (53.878f - 1331.22f / temp_K - 9.44523f * std::log(temp_K)
-                     + 0.014025f * temp_K));
-      break;
-    }
+    case formulas::MethodFormulation::LandoltBornstein:
+      return LandoltBornstein;
+    case formulas::MethodFormulation::Walko:
+      return Walko;
+    case formulas::MethodFormulation::Murphy:
+      return Murphy;
     case formulas::MethodFormulation::NCAR:
     case formulas::MethodFormulation::NOAA:
     case formulas::MethodFormulation::Rogers:
-    default: {
-      // Classical formula from Rogers and Yau (1989; Eq2.17)
-      e_sub_s = 1000. * 0.6112 * std::exp(17.67f * (temp_K - t0c) / (temp_K - 29.65f));
-      break;
-    }
+    default:
+      return Rogers;
   }
-  return e_sub_s;
 }
 
-/* -------------------------------------------------------------------------------------*/
-float SatVaporPres_correction(float e_sub_s, float temp_K, float pressure,
-                              MethodFormulation formulation) {
-  const float t0c = static_cast<float>(ufo::Constants::t0c);
-
+/// Throw an exception if \p formulation is not supported by SatVaporPres_correction().
+void checkSatVaporPresCorrectionFormulation(MethodFormulation formulation) {
   switch (formulation) {
     case formulas::MethodFormulation::NCAR:
     case formulas::MethodFormulation::NOAA:
     case formulas::MethodFormulation::UKMOmixingratio:
     case formulas::MethodFormulation::UKMO:
-    case formulas::MethodFormulation::Sonntag: {
-      /* e_sub_s is the saturation vapour pressure of pure water vapour.FsubW (~ 1.005
-         at 1000 hPa) is the enhancement factor needed for moist air.
-         If P is set to -1: then eg eqns 20, 22 of Sonntag is used
-         If P > 0 then eqn A4.6 of Adrian Gill's book is used to guarantee consistency with the
-         saturated specific humidity.
-      */
-      float FsubW;  // Enhancement factor
-      FsubW = 1.0f + 1.0E-8f * pressure * (4.5f + 6.0E-4f * (temp_K - t0c) *(temp_K - t0c));
-      e_sub_s = e_sub_s * FsubW;
-
-      break;
-    }
+    case formulas::MethodFormulation::Sonntag:
+      return;
     default: {
       std::string errString = "Aborting, no method matches enum formulas::MethodFormulation";
       oops::Log::error() << errString;
       throw eckit::BadValue(errString);
     }
   }
-  return e_sub_s;
 }
+
+template <MethodFormulation formulation>
+void satVaporPresFromTemp(const std::vector<float> & temp_K, std::vector<float> & e_sub_s) {
+  const size_t n = temp_K.size();
+  e_sub_s.resize(n);
+  const float * const in = temp_K.data();
+  float * const out = e_sub_s.data();
+  for (size_t i = 0; i < n; ++i)
+    out[i] = satVaporPresFromTemp<formulation>(in[i]);
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------------------*/
+float SatVaporPres_fromTemp(float temp_K, MethodFormulation formulation) {
+  switch (satVaporPresKernel(formulation)) {
+    case Sonntag:
+      return satVaporPresFromTemp<Sonntag>(temp_K);
+    case LandoltBornstein:
+      return satVaporPresFromTemp<LandoltBornstein>(temp_K);
+    case Walko:
+      return satVaporPresFromTemp<Walko>(temp_K);
+    case Murphy:
+      return satVaporPresFromTemp<Murphy>(temp_K);
+    default:
+      return satVaporPresFromTemp<Rogers>(temp_K);
+  }
+}
+
+void SatVaporPres_fromTemp(const std::vector<float> & temp_K, std::vector<float> & e_sub_s,
+                           MethodFormulation formulation) {
+  switch (satVaporPresKernel(formulation)) {
+    case Sonntag:
+      return satVaporPresFromTemp<Sonntag>(temp_K, e_sub_s);
+    case LandoltBornstein:
+      return satVaporPresFromTemp<LandoltBornstein>(temp_K, e_sub_s);
+    case Walko:
+      return satVaporPresFromTemp<Walko>(temp_K, e_sub_s);
+    case Murphy:
+      return satVaporPresFromTemp<Murphy>(temp_K, e_sub_s);
+    default:
+      return satVaporPresFromTemp<Rogers>(temp_K, e_sub_s);
+  }
+}
+
+/* -------------------------------------------------------------------------------------*/
+float SatVaporPres_correction(float e_sub_s, float temp_K, float pressure,
+                              MethodFormulation formulation) {
+  checkSatVaporPresCorrectionFormulation(formulation);
+  return satVaporPresCorrection(e_sub_s, temp_K, pressure);
+}
+
+void SatVaporPres_correction(std::vector<float> & e_sub_s, const std::vector<float> & temp_K,
+                             const std::vector<float> & pressure,
+                             MethodFormulation formulation) {
+  checkSatVaporPresCorrectionFormulation(formulation);
+  ASSERT(temp_K.size() == e_sub_s.size() && pressure.size() == e_sub_s.size());
+  const size_t n = e_sub_s.size();
+  float * const e = e_sub_s.data();
+  const float * const t = temp_K.data();
+  const float * const p = pressure.data();
+  for (size_t i = 0; i < n; ++i)
+    e[i] = satVaporPresCorrection(e[i], t[i], p[i]);
+}
+
 /* -------------------------------------------------------------------------------------*/
 
 float Qsat_From_Psat(float Psat, float P, MethodFormulation formulation) {
-  float QSat = util::missingValue(1.0f);  // Saturated specific humidity or
-                                          // saturated vapour pressure (if P<0)
+  // All formulations use the same formula.
+  return qsatFromPsat(Psat, P);
+}
 
-  switch (formulation) {
-    case formulas::MethodFormulation::NCAR:
-    case formulas::MethodFormulation::NOAA:
-    case formulas::MethodFormulation::UKMOmixingratio:
-    case formulas::MethodFormulation::UKMO:
-    default: {
-      // Calculation using the Sonntag (1994) formula. (With fix at low
-      // pressure)
-      //  Note that at very low pressures we apply a fix, to prevent a
-      //     singularity (Qsat tends to 1.0 kg/kg).
-      QSat = (Constants::epsilon * Psat) /
-             (std::max(P, Psat) - (1.0f - Constants::epsilon) * Psat);
-      break;
-    }
-  }
-  return QSat;
+void Qsat_From_Psat(const std::vector<float> & Psat, const std::vector<float> & P,
+                    std::vector<float> & QSat, MethodFormulation formulation) {
+  ASSERT(P.size() == Psat.size());
+  const size_t n = Psat.size();
+  QSat.resize(n);
+  const float * const psat = Psat.data();
+  const float * const p = P.data();
+  float * const q = QSat.data();
+  for (size_t i = 0; i < n; ++i)
+    q[i] = qsatFromPsat(psat[i], p[i]);
 }
 
 /* -------------------------------------------------------------------------------------*/
 
 // VirtualTemperature()
 float VirtualTemp_From_Psat_P_T(float Psat, float P, float T, MethodFormulation formulation) {
-  float Tv = util::missingValue(1.0f);  // virtual temperature
+  // All formulations use the same formula.
+  return virtualTempFromPsatPT(Psat, P, T);
+}
 
-  switch (formulation) {
-    case formulas::MethodFormulation::NCAR:
-    case formulas::MethodFormulation::NOAA:
-    case formulas::MethodFormulation::UKMO:
-    default: {
-      Tv = T * ((P + Psat / Constants::epsilon) / (P + Psat));
-      break;
-    }
-  }
-  return Tv;
+void VirtualTemp_From_Psat_P_T(const std::vector<float> & Psat, const std::vector<float> & P,
+                               const std::vector<float> & T, std::vector<float> & Tv,
+                               MethodFormulation formulation) {
+  ASSERT(P.size() == Psat.size() && T.size() == Psat.size());
+  const size_t n = Psat.size();
+  Tv.resize(n);
+  const float * const psat = Psat.data();
+  const float * const p = P.data();
+  const float * const t = T.data();
+  float * const tv = Tv.data();
+  for (size_t i = 0; i < n; ++i)
+    tv[i] = virtualTempFromPsatPT(psat[i], p[i], t[i]);
 }
 
 /* -------------------------------------------------------------------------------------*/
@@ -371,6 +468,38 @@ float GetWind_V(float windSpeed, float windFromDirection) {
   return v;
 }
 
+void GetWindDirection(const std::vector<float> & u, const std::vector<float> & v,
+                      std::vector<float> & windDirection) {
+  ASSERT(v.size() == u.size());
+  windDirection.resize(u.size());
+  for (size_t i = 0; i < u.size(); ++i)
+    windDirection[i] = GetWindDirection(u[i], v[i]);
+}
+
+void GetWindSpeed(const std::vector<float> & u, const std::vector<float> & v,
+                  std::vector<float> & windSpeed) {
+  ASSERT(v.size() == u.size());
+  windSpeed.resize(u.size());
+  for (size_t i = 0; i < u.size(); ++i)
+    windSpeed[i] = GetWindSpeed(u[i], v[i]);
+}
+
+void GetWind_U(const std::vector<float> & windSpeed, const std::vector<float> & windFromDirection,
+               std::vector<float> & u) {
+  ASSERT(windFromDirection.size() == windSpeed.size());
+  u.resize(windSpeed.size());
+  for (size_t i = 0; i < windSpeed.size(); ++i)
+    u[i] = GetWind_U(windSpeed[i], windFromDirection[i]);
+}
+
+void GetWind_V(const std::vector<float> & windSpeed, const std::vector<float> & windFromDirection,
+               std::vector<float> & v) {
+  ASSERT(windFromDirection.size() == windSpeed.size());
+  v.resize(windSpeed.size());
+  for (size_t i = 0; i < windSpeed.size(); ++i)
+    v[i] = GetWind_V(windSpeed[i], windFromDirection[i]);
+}
+
 /* -------------------------------------------------------------------------------------
 This formula takes a radiance (W / (m^2.sr.m^-1)) and a wavenumber (m^-1) and outputs
 a brightness temperature. where:
@@ -390,6 +519,23 @@ double inversePlanck(const double radiance, const double wavenumber,
   return BT;
 }
 
+void inversePlanck(const std::vector<double> & radiance, const std::vector<double> & wavenumber,
+                   std::vector<double> & brightnessTemperature,
+                   const double planck1, const double planck2) {
+  ASSERT(wavenumber.size() == radiance.size());
+  const size_t n = radiance.size();
+  brightnessTemperature.resize(n);
+  const double * rad = radiance.data();
+  const double * wvn = wavenumber.data();
+  double * bt = brightnessTemperature.data();
+#pragma omp simd
+  for (size_t i = 0; i < n; ++i) {
+    const double p1 = planck1 * wvn[i] * wvn[i] * wvn[i];
+    const double p2 = planck2 * wvn[i];
+    bt[i] = p2 / std::log(1.0 + p1 / rad[i]);
+  }
+}
+
 /* -------------------------------------------------------------------------------------*/
 
 int RenumberScanPosition(const int scanpos, const int numFOV) {
@@ -450,44 +596,60 @@ void horizontalDrift
     // Average ascent speed (m/s).
     const double ascent_speed = 5.16;
 
+    // Number of valid levels and of layers between adjacent valid levels.
+    const size_t nvalid = locs_valid.size();
+    const size_t nlayers = nvalid - 1;
+
+    // Eastward and northward wind at each valid level.
+    // 180 degrees is subtracted from the wind direction in order to account for the different
+    // conventions used in the observations and in this calculation.
+    std::vector<double> u(nvalid), v(nvalid);
+    for (size_t k = 0; k < nvalid; ++k) {
+      const size_t jloc = locs_valid[k];
+      const double dir = (winddir[jloc] - 180.0) * Constants::deg2rad;
+      u[k] = windspd[jloc] * std::sin(dir);
+      v[k] = windspd[jloc] * std::cos(dir);
+    }
+
+    // Changes in time and latitude across each layer, and the parts of the change in longitude
+    // that do not depend on the latitude. These do not depend on each other, so they are
+    // computed in a separate loop from the accumulation along the profile below.
+    std::vector<double> dt(nlayers), dlat(nlayers), dlon_num(nlayers), totalheight(nlayers);
+    for (size_t k = 0; k < nlayers; ++k) {
+      // Change in height.
+      const double dh = height[locs_valid[k + 1]] - height[locs_valid[k]];
+      // Change in time.
+      dt[k] = dh / ascent_speed;
+      // Average eastward and northward wind between the two levels.
+      const double avgu = 0.5 * (u[k] + u[k + 1]);
+      const double avgv = 0.5 * (v[k] + v[k + 1]);
+      // Total height of the observation above the centre of the Earth.
+      totalheight[k] = ufo::Constants::mean_earth_rad * 1000.0 + height[locs_valid[k]];
+      // Change in latitude.
+      dlat[k] = ufo::Constants::rad2deg * avgv * dt[k] / totalheight[k];
+      dlon_num[k] = ufo::Constants::rad2deg * avgu * dt[k];
+    }
+
     // Cumulative values of change in time.
     // This value is converted to a util::Duration object rather than performing the
     // same conversion to each individual change in time.
     // This avoids a loss in precision given util::Duration is accurate to the nearest second.
     double dt_cumul = 0.0;
 
-    for (size_t k = 0; k < locs_valid.size() - 1; ++k) {
+    for (size_t k = 0; k < nlayers; ++k) {
       // Locations of the current and next valid observations in the profile.
       const size_t loc_current = locs_valid[k];
       const size_t loc_next = locs_valid[k + 1];
 
-      // Compute changes in latitude, longitude and time between adjacent valid levels.
-      // Change in height.
-      const double dh = height[loc_next] - height[loc_current];
-      // Change in time.
-      const double dt = dh / ascent_speed;
-      // Average eastward and northward wind between the two levels.
-      // 180 degrees is subtracted from the wind direction in order to account for the different
-      // conventions used in the observations and in this calculation.
-      const double avgu = 0.5 *
-        (windspd[loc_current] * std::sin((winddir[loc_current] - 180.0) * Constants::deg2rad) +
-         windspd[loc_next] * std::sin((winddir[loc_next] - 180.0) * Constants::deg2rad));
-      const double avgv = 0.5 *
-        (windspd[loc_current] * std::cos((winddir[loc_current] - 180.0) * Constants::deg2rad) +
-         windspd[loc_next] * std::cos((winddir[loc_next] - 180.0) * Constants::deg2rad));
-      // Total height of the observation above the centre of the Earth.
-      const double totalheight = ufo::Constants::mean_earth_rad * 1000.0 + height[loc_current];
-      // Change in latitude.
-      const double dlat = ufo::Constants::rad2deg * avgv * dt / totalheight;
       // Change in longitude.
-      const double dlon = ufo::Constants::rad2deg * avgu * dt /
-        (totalheight * std::cos(lat_out[loc_current] * ufo::Constants::Constants::deg2rad));
+      const double dlon = dlon_num[k] /
+        (totalheight[k] * std::cos(lat_out[loc_current] * ufo::Constants::Constants::deg2rad));
 
       // Fill output values.
-      lat_out[loc_next] = lat_out[loc_current] + dlat;
+      lat_out[loc_next] = lat_out[loc_current] + dlat[k];
       lon_out[loc_next] = lon_out[loc_current] + dlon;
       // Convert the cumulative change in time to a util::Duration.
-      dt_cumul += dt;
+      dt_cumul += dt[k];
       // Calculate the level datetime, keeping it within the assimilation window if required.
       const util::DateTime t_cumul = time0 + util::Duration(static_cast<int64_t>(dt_cumul));
       if (window_end)
@@ -498,11 +660,14 @@ void horizontalDrift
 
     // Copy latitude, longitude and time at each valid location to all invalid
     // locations that lie between the current valid location and the next one above it.
+    // locs_valid is a subsequence of locs, so a single pass over both suffices.
     double lat = lat0;
     double lon = lon0;
     util::DateTime time = time0;
+    size_t kvalid = 0;
     for (size_t jloc : locs) {
-      if (std::find(locs_valid.begin(), locs_valid.end(), jloc) != locs_valid.end()) {
+      if (kvalid < nvalid && locs_valid[kvalid] == jloc) {
+        ++kvalid;
         lat = lat_out[jloc];
         lon = lon_out[jloc];
         time = time_out[jloc];
@@ -73,6 +73,12 @@ MethodFormulation resolveFormulations(const std::string& input, const std::strin
 float SatVaporPres_fromTemp(const float temp_K,
                    const MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
 
+/// \brief Array version of the function above: sets \p e_sub_s[i] to the saturated vapour pressure
+/// at temperature \p temp_K[i]. The formulation is resolved once per call rather than once per
+/// element.
+void SatVaporPres_fromTemp(const std::vector<float> & temp_K, std::vector<float> & e_sub_s,
+                   const MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
+
 
 // -------------------------------------------------------------------------------------
 /*!
@@ -100,6 +106,12 @@ float SatVaporPres_fromTemp(const float temp_K,
 */
 float SatVaporPres_correction(float e_sub_s, float temp_K, float pressure,
                         const MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
+
+/// \brief Array version of the function above: corrects each element of \p e_sub_s in place
+/// using the corresponding elements of \p temp_K and \p pressure.
+void SatVaporPres_correction(std::vector<float> & e_sub_s, const std::vector<float> & temp_K,
+                        const std::vector<float> & pressure,
+                        const MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
 // -------------------------------------------------------------------------------------
 /*!
 * \brief Calculates Saturated specific humidity or saturated vapour pressure using
@@ -124,6 +136,12 @@ float SatVaporPres_correction(float e_sub_s, float temp_K, float pressure,
 float Qsat_From_Psat(float Psat, float P,
                      MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
 
+/// \brief Array version of the function above: sets \p QSat[i] to the value calculated from
+/// \p Psat[i] and \p P[i].
+void Qsat_From_Psat(const std::vector<float> & Psat, const std::vector<float> & P,
+                    std::vector<float> & QSat,
+                    MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
+
 // -------------------------------------------------------------------------------------
 /*!
 * \brief Derive Virtual Temperature from saturation vapour pressure, pressure and temperature
@@ -146,6 +164,12 @@ float Qsat_From_Psat(float Psat, float P,
 float VirtualTemp_From_Psat_P_T(float Psat, float P, float T,
                           MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
 
+/// \brief Array version of the function above: sets \p Tv[i] to the virtual temperature
+/// calculated from \p Psat[i], \p P[i] and \p T[i].
+void VirtualTemp_From_Psat_P_T(const std::vector<float> & Psat, const std::vector<float> & P,
+                          const std::vector<float> & T, std::vector<float> & Tv,
+                          MethodFormulation formulation = formulas::MethodFormulation::DEFAULT);
+
 // -------------------------------------------------------------------------------------
 /*!
 * \brief Derive Virtual Tempreture using Relative humidity, sat. vapour pressure, pressure
@@ -219,6 +243,10 @@ float Pressure_To_Height(float pressure,
 */
 float GetWindDirection(float u, float v);
 
+/// \brief Array version of the function above, applied element by element.
+void GetWindDirection(const std::vector<float> & u, const std::vector<float> & v,
+                      std::vector<float> & windDirection);
+
 // -------------------------------------------------------------------------------------
 /*!
 * \brief Converts u and v wind component into wind speed.
@@ -231,6 +259,10 @@ float GetWindDirection(float u, float v);
 */
 float GetWindSpeed(float u, float v);
 
+/// \brief Array version of the function above, applied element by element.
+void GetWindSpeed(const std::vector<float> & u, const std::vector<float> & v,
+                  std::vector<float> & windSpeed);
+
 // -------------------------------------------------------------------------------------
 /*!
 * \brief Get eastward (u) wind component from wind speed and direction.
@@ -243,6 +275,10 @@ float GetWindSpeed(float u, float v);
 */
 float GetWind_U(float windSpeed, float windFromDirection);
 
+/// \brief Array version of the function above, applied element by element.
+void GetWind_U(const std::vector<float> & windSpeed, const std::vector<float> & windFromDirection,
+               std::vector<float> & u);
+
 // -------------------------------------------------------------------------------------
 /*!
 * \brief Get northward (v) wind component from wind speed and direction.
@@ -255,6 +291,10 @@ float GetWind_U(float windSpeed, float windFromDirection);
 */
 float GetWind_V(float windSpeed, float windFromDirection);
 
+/// \brief Array version of the function above, applied element by element.
+void GetWind_V(const std::vector<float> & windSpeed, const std::vector<float> & windFromDirection,
+               std::vector<float> & v);
+
 // -------------------------------------------------------------------------------------------
 /*!
 * \brief Calculate the brightness temperature for an input radiance.  To minimize
@@ -277,6 +317,19 @@ double inversePlanck(const double radiance, const double wavenumber,
                      double planck1 = 1.191042972e-16,  // (W / (m^2.sr.m-4))
                      double planck2 = 1.4387769e-2);    // (m.K)
 
+/*!
+* \brief Vectorized version of inversePlanck(): set \p brightnessTemperature[i] to the
+*        brightness temperature of \p radiance[i] at \p wavenumber[i] for all i.
+*
+* \details The results are the same as those of the scalar version, but the loop can be
+*          vectorized, which matters when converting the full spectrum of a hyperspectral
+*          sounder. All radiances must be positive.
+*/
+void inversePlanck(const std::vector<double> & radiance, const std::vector<double> & wavenumber,
+                   std::vector<double> & brightnessTemperature,
+                   double planck1 = 1.191042972e-16,  // (W / (m^2.sr.m-4))
+                   double planck2 = 1.4387769e-2);    // (m.K)
+
 // -------------------------------------------------------------------------------------
 /*!
 * \brief Get renumbered scan position 1,2,3,... for satellite instrument
@@ -72,17 +72,29 @@ void OceanDensity::runTransform(const std::vector<bool> &apply) {
     densityflags.assign(nlocs, 0);
   }
 
+  // The valid locations are gathered so that they are all converted in a single call.
+  std::vector<size_t> valid;
   for (size_t loc = 0; loc < nlocs; ++loc) {
     if (!apply[loc]) continue;
     if (sal[loc] != missingValueFloat &&
         temp[loc] != missingValueFloat &&
         pressure[loc] != missingValueFloat) {
-      density[loc] = gsw_rho_t_exact_f90(sal[loc],
-                                           temp[loc],
-                                           pressure[loc]);
+      valid.push_back(loc);
     }
   }
-  obsdb_.put_db("DerivedObsValue", densityvariable_, density);
+  const size_t nvalid = valid.size();
+  std::vector<float> validSal(nvalid), validTemp(nvalid), validPressure(nvalid);
+  std::vector<float> validDensity(nvalid);
+  for (size_t i = 0; i < nvalid; ++i) {
+    validSal[i] = sal[valid[i]];
+    validTemp[i] = temp[valid[i]];
+    validPressure[i] = pressure[valid[i]];
+  }
+  gsw_rho_t_exact_array_f90(static_cast<int>(nvalid), validSal.data(), validTemp.data(),
+                            validPressure.data(), validDensity.data());
+  for (size_t i = 0; i < nvalid; ++i)
+    density[valid[i]] = validDensity[i];
+  putObsSpaceVariable("DerivedObsValue", densityvariable_, density);
   const size_t iv = obserr_.varnames().find(densityvariable_);
   for (size_t jobs = 0; jobs < obsdb_.nlocs(); ++jobs) {
     if (!apply[jobs])
@@ -91,8 +103,8 @@ void OceanDensity::runTransform(const std::vector<bool> &apply) {
   }
 
   // copy PGEFinal and QCflags to new density
-  obsdb_.put_db("GrossErrorProbability", densityvariable_, densitypge);
-  obsdb_.put_db("QCFlags", densityvariable_, densityflags);
+  putObsSpaceVariable("GrossErrorProbability", densityvariable_, densitypge);
+  putObsSpaceVariable("QCFlags", densityvariable_, densityflags);
 }
 
 // -----------------------------------------------------------------------------
@@ -66,14 +66,25 @@ void OceanDepthToPressure::runTransform(const std::vector<bool> &apply) {
   }
 
   // compute pressure as function of depth and latitude
+  // (the valid locations are gathered so that they are all converted in a single call)
+  std::vector<size_t> valid;
   for (size_t loc = 0; loc < nlocs; ++loc) {
     if (!apply[loc]) continue;
     if (depth[loc] != missingValueFloat) {
-      pressure[loc] = gsw_p_from_z_f90(-1.0*depth[loc],
-                                       lats[loc]);
+      valid.push_back(loc);
     }
   }
-  obsdb_.put_db("DerivedObsValue", pressurevariable_, pressure);
+  const size_t nvalid = valid.size();
+  std::vector<float> validHeight(nvalid), validLats(nvalid), validPressure(nvalid);
+  for (size_t i = 0; i < nvalid; ++i) {
+    validHeight[i] = -1.0*depth[valid[i]];
+    validLats[i] = lats[valid[i]];
+  }
+  gsw_p_from_z_array_f90(static_cast<int>(nvalid), validHeight.data(), validLats.data(),
+                         validPressure.data());
+  for (size_t i = 0; i < nvalid; ++i)
+    pressure[valid[i]] = validPressure[i];
+  putObsSpaceVariable("DerivedObsValue", pressurevariable_, pressure);
   const size_t iv = obserr_.varnames().find(pressurevariable_);
   for (size_t jobs = 0; jobs < obsdb_.nlocs(); ++jobs) {
     if (!apply[jobs])
@@ -82,8 +93,8 @@ void OceanDepthToPressure::runTransform(const std::vector<bool> &apply) {
   }
 
   // copy PGEFinal and QCflags to new pressure
-  obsdb_.put_db("GrossErrorProbability", pressurevariable_, pressurepge);
-  obsdb_.put_db("QCFlags", pressurevariable_, pressureflags);
+  putObsSpaceVariable("GrossErrorProbability", pressurevariable_, pressurepge);
+  putObsSpaceVariable("QCFlags", pressurevariable_, pressureflags);
 }
 
 // -----------------------------------------------------------------------------
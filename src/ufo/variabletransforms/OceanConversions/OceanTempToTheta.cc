@@ -76,17 +76,29 @@ void OceanTempToTheta::runTransform(const std::vector<bool> &apply) {
   }
 
   // compute theta as function of temperature, pressure and salinity
+  // (the valid locations are gathered so that they are all converted in a single call)
+  std::vector<size_t> valid;
   for (size_t loc = 0; loc < nlocs; ++loc) {
     if (!apply[loc]) continue;
     if (sal[loc] != missingValueFloat &&
         temp[loc] != missingValueFloat &&
         pressure[loc] != missingValueFloat) {
-      theta[loc] = gsw_pt_from_t_f90(sal[loc],
-                                     temp[loc],
-                                     pressure[loc]);
+      valid.push_back(loc);
     }
   }
-  obsdb_.put_db("DerivedObsValue", thetavariable_, theta);
+  const size_t nvalid = valid.size();
+  std::vector<float> validSal(nvalid), validTemp(nvalid), validPressure(nvalid);
+  std::vector<float> validTheta(nvalid);
+  for (size_t i = 0; i < nvalid; ++i) {
+    validSal[i] = sal[valid[i]];
+    validTemp[i] = temp[valid[i]];
+    validPressure[i] = pressure[valid[i]];
+  }
+  gsw_pt_from_t_array_f90(static_cast<int>(nvalid), validSal.data(), validTemp.data(),
+                          validPressure.data(), validTheta.data());
+  for (size_t i = 0; i < nvalid; ++i)
+    theta[valid[i]] = validTheta[i];
+  putObsSpaceVariable("DerivedObsValue", thetavariable_, theta);
   const size_t iv = obserr_.varnames().find(thetavariable_);
   for (size_t jobs = 0; jobs < obsdb_.nlocs(); ++jobs) {
     if (!apply[jobs])
@@ -95,8 +107,8 @@ void OceanTempToTheta::runTransform(const std::vector<bool> &apply) {
   }
 
   // copy PGEFinal and QCflags to new potential temperature
-  obsdb_.put_db("GrossErrorProbability", thetavariable_, thetapge);
-  obsdb_.put_db("QCFlags", thetavariable_, thetaflags);
+  putObsSpaceVariable("GrossErrorProbability", thetavariable_, thetapge);
+  putObsSpaceVariable("QCFlags", thetavariable_, thetaflags);
 }
 
 // -----------------------------------------------------------------------------
@@ -33,6 +33,7 @@
 #include "ufo/filters/Variables.h"
 #include "ufo/filters/VariableTransformParametersBase.h"
 #include "ufo/variabletransforms/Formulas.h"
+#include "ufo/variabletransforms/TransformColumns.h"
 
 
 namespace ioda {
@@ -62,6 +63,11 @@ class TransformBase {
   virtual void runTransform(const std::vector<bool> &apply) = 0;
   /// Return list of required geovals
   virtual Variables requiredVariables() const { return Variables(); }
+  /// \brief Read ObsSpace variables from and write them to \p columns rather than directly to
+  /// the ObsSpace, so that a sequence of transforms can share intermediate results in memory.
+  ///
+  /// The caller is responsible for calling columns->commit() once the transforms have run.
+  void setColumns(TransformColumns *columns) { columns_ = columns; }
 
  private:
   /// templated function for float, int data types
@@ -87,13 +93,15 @@ class TransformBase {
   bool UseValidDataOnly_;
   /// The observation name
   std::string obsName_;
+  /// If set, ObsSpace variables are read from and written to this object.
+  TransformColumns *columns_ = nullptr;
 
  protected:
   /// templated function for float, int data types
   template <typename T>
   void getObservation(const std::string &originalTag, const std::string &varName,
                       std::vector<T> &obsVector, bool require = false) const {
-    if (!obsdb_.has(originalTag, varName)) {
+    if (!hasObsSpaceVariable(originalTag, varName)) {
       if (require)
         throw eckit::BadValue("The parameter `" + varName + "@" + originalTag +
                               "` does not exist in the ObsSpace ", Here());
@@ -101,8 +109,7 @@ class TransformBase {
         return;
     }
 
-    obsVector.resize(obsdb_.nlocs());
-    obsdb_.get_db(originalTag, varName, obsVector);
+    getObsSpaceVariable(originalTag, varName, obsVector);
     // Set obsValue to missingValue if flag is equal to QCflags::missing or QCflags::bounds
     if (UseValidDataOnly()) filterObservation(varName, obsVector);
   }
@@ -125,9 +132,9 @@ class TransformBase {
         outputTag.substr(0, 7) == "Derived") {
       std::string originalTag = outputTag;
       originalTag.erase(0, 7);  // Remove Derived from group name
-      if (obsdb_.has(originalTag, varName)) {
-        std::vector <T> originalValues(obsdb_.nlocs());
-        obsdb_.get_db(originalTag, varName, originalValues);
+      if (hasObsSpaceVariable(originalTag, varName)) {
+        std::vector <T> originalValues;
+        getObsSpaceVariable(originalTag, varName, originalValues);
         const T missing = util::missingValue(missing);
         for (size_t jloc = 0; jloc < obsdb_.nlocs(); ++jloc) {
           if (outputObsVector[jloc] == missing &&
@@ -137,7 +144,7 @@ class TransformBase {
         }
       }
     }
-    obsdb_.put_db(outputTag, varName, outputObsVector);
+    putObsSpaceVariable(outputTag, varName, outputObsVector);
 
     // Update QC flags to account for values that were previously missing but
     // are now present (or vice versa).
@@ -170,7 +177,7 @@ class TransformBase {
                       const std::vector<T> &obsVector,
                       const std::vector<std::string> & dimList,
                       const std::string &outputTag = "DerivedObsValue") {
-    obsdb_.put_db(outputTag, varName + "_" + channel, obsVector, dimList);
+    putObsSpaceVariable(outputTag, varName + "_" + channel, obsVector, dimList);
     if (flags_.has(varName + "_" + channel)) {
       std::vector<int> &varFlags = flags_[varName + "_" + channel];
       ASSERT(varFlags.size() == obsVector.size());
@@ -185,6 +192,61 @@ class TransformBase {
     }
   }
 
+  /// \brief Return true if the variable \p name from group \p group exists in the ObsSpace or
+  /// has been saved by an earlier transform sharing the same TransformColumns.
+  bool hasObsSpaceVariable(const std::string &group, const std::string &name) const {
+    return columns_ ? columns_->has(group, name) : obsdb_.has(group, name);
+  }
+
+  /// \brief Fill \p values with the values of the variable \p name from group \p group, taken
+  /// from the TransformColumns set with setColumns() if they have been saved there.
+  template <typename T>
+  void getObsSpaceVariable(const std::string &group, const std::string &name,
+                           std::vector<T> &values) const {
+    if (columns_) {
+      columns_->get(group, name, values);
+    } else {
+      values.resize(obsdb_.nlocs());
+      obsdb_.get_db(group, name, values);
+    }
+  }
+
+  /// \brief Save \p values as the variable \p name from group \p group, either directly in the
+  /// ObsSpace or in the TransformColumns set with setColumns().
+  template <typename T>
+  void putObsSpaceVariable(const std::string &group, const std::string &name,
+                           const std::vector<T> &values,
+                           const std::vector<std::string> &dimList = {"nlocs"}) {
+    if (columns_)
+      columns_->put(group, name, values, dimList);
+    else
+      obsdb_.put_db(group, name, values, dimList);
+  }
+
+  /// \brief Fill \p values with the values of \p variable obtained from the ObsFilterData,
+  /// unless an earlier transform sharing the same TransformColumns has saved them.
+  void getFilterData(const Variable &variable, std::vector<float> &values) const {
+    if (columns_ && columns_->isStaged(variable.group(), variable.variable()))
+      columns_->get(variable.group(), variable.variable(), values);
+    else
+      data_.get(variable, values);
+  }
+
+  /// \brief Fill \p values with the values of all channels of \p variable obtained from the
+  /// ObsFilterData, unless an earlier transform sharing the same TransformColumns has saved them.
+  void getFilterData(const Variable &variable, ioda::ObsDataVector<float> &values) const {
+    bool anyStaged = false;
+    if (columns_)
+      for (size_t ich = 0; ich < variable.size(); ++ich)
+        anyStaged = anyStaged || columns_->isStaged(variable.group(), variable.variable(ich));
+    if (!anyStaged) {
+      data_.get(variable, values);
+      return;
+    }
+    for (size_t ich = 0; ich < variable.size(); ++ich)
+      getFilterData(variable[ich], values[ich]);
+  }
+
   std::string getDerivedGroup(const std::string group) const;
 
   /// subclasses to access Method and formualtion used for the calculation
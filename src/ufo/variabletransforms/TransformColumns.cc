@@ -0,0 +1,49 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <string>
+#include <vector>
+
+#include "ufo/variabletransforms/TransformColumns.h"
+
+namespace ufo {
+
+namespace {
+
+/// Visitor writing a vector of values to the ObsSpace.
+class PutVisitor : public boost::static_visitor<void> {
+ public:
+  PutVisitor(ioda::ObsSpace &obsdb, const std::string &group, const std::string &name,
+             const std::vector<std::string> &dimList)
+    : obsdb_(obsdb), group_(group), name_(name), dimList_(dimList)
+  {}
+
+  template <typename T>
+  void operator()(const std::vector<T> &values) const {
+    obsdb_.put_db(group_, name_, values, dimList_);
+  }
+
+ private:
+  ioda::ObsSpace &obsdb_;
+  const std::string &group_;
+  const std::string &name_;
+  const std::vector<std::string> &dimList_;
+};
+
+}  // namespace
+
+void TransformColumns::commit() {
+  for (const std::string &columnKey : order_) {
+    const Column &column = columns_.at(columnKey);
+    boost::apply_visitor(PutVisitor(obsdb_, column.group, column.name, column.dimList),
+                         column.values);
+  }
+  columns_.clear();
+  order_.clear();
+}
+
+}  // namespace ufo
@@ -0,0 +1,108 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef UFO_VARIABLETRANSFORMS_TRANSFORMCOLUMNS_H_
+#define UFO_VARIABLETRANSFORMS_TRANSFORMCOLUMNS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/variant.hpp>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "ioda/ObsSpace.h"
+
+#include "oops/util/DateTime.h"
+
+namespace ufo {
+
+/// \brief ObsSpace variables written by a sequence of variable transforms, kept in memory until
+/// they are committed to the ObsSpace.
+///
+/// Variables read through this class are taken from memory if they have been written by an
+/// earlier transform of the sequence and from the ObsSpace otherwise, so each transform sees the
+/// results of the previous ones without a round trip through the ObsSpace.
+class TransformColumns {
+ public:
+  explicit TransformColumns(ioda::ObsSpace &obsdb) : obsdb_(obsdb) {}
+
+  /// Return true if the variable \p name from group \p group has been written to this object
+  /// or exists in the ObsSpace.
+  bool has(const std::string &group, const std::string &name) const {
+    return columns_.find(key(group, name)) != columns_.end() || obsdb_.has(group, name);
+  }
+
+  /// Return true if the variable \p name from group \p group has been written to this object
+  /// and not committed yet.
+  bool isStaged(const std::string &group, const std::string &name) const {
+    return columns_.find(key(group, name)) != columns_.end();
+  }
+
+  /// Fill \p values with the values of the variable \p name from group \p group.
+  template <typename T>
+  void get(const std::string &group, const std::string &name, std::vector<T> &values) const {
+    const auto it = columns_.find(key(group, name));
+    if (it == columns_.end()) {
+      values.resize(obsdb_.nlocs());
+      obsdb_.get_db(group, name, values);
+      return;
+    }
+    const std::vector<T> *staged = boost::get<std::vector<T>>(&it->second.values);
+    if (staged == nullptr)
+      throw eckit::BadValue("Variable '" + key(group, name) + "' was saved by a previous "
+                            "transform with a different data type", Here());
+    values = *staged;
+  }
+
+  /// Store \p values as the values of the variable \p name from group \p group. They will be
+  /// written to the ObsSpace, with dimensions \p dimList, by commit().
+  template <typename T>
+  void put(const std::string &group, const std::string &name, const std::vector<T> &values,
+           const std::vector<std::string> &dimList = {"nlocs"}) {
+    const std::string columnKey = key(group, name);
+    auto it = columns_.find(columnKey);
+    if (it == columns_.end()) {
+      it = columns_.emplace(columnKey, Column{group, name, values, dimList}).first;
+      order_.push_back(columnKey);
+    } else {
+      it->second.values = values;
+      it->second.dimList = dimList;
+    }
+  }
+
+  /// Write all stored variables to the ObsSpace, in the order in which they were first stored,
+  /// and forget them.
+  void commit();
+
+ private:
+  typedef boost::variant<std::vector<int>,
+                         std::vector<float>,
+                         std::vector<std::string>,
+                         std::vector<util::DateTime>> Values;
+
+  struct Column {
+    std::string group;
+    std::string name;
+    Values values;
+    std::vector<std::string> dimList;
+  };
+
+  static std::string key(const std::string &group, const std::string &name) {
+    return group + "/" + name;
+  }
+
+  ioda::ObsSpace &obsdb_;
+  std::map<std::string, Column> columns_;
+  /// Keys of the variables in columns_, in the order in which they were first stored.
+  std::vector<std::string> order_;
+};
+
+}  // namespace ufo
+
+#endif  // UFO_VARIABLETRANSFORMS_TRANSFORMCOLUMNS_H_
@@ -0,0 +1,226 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_BENCHMARKS_H_
+#define TEST_UFO_BENCHMARKS_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+#include "oops/util/Logger.h"
+#include "test/TestEnvironment.h"
+#include "ufo/utils/GeodesicDistanceCalculator.h"
+#include "ufo/utils/MaxNormDistanceCalculator.h"
+#include "ufo/utils/NullDistanceCalculator.h"
+#include "ufo/utils/PiecewiseLinearInterpolation.h"
+#include "ufo/utils/RecursiveSplitter.h"
+#include "ufo/utils/SpatialBinSelector.h"
+#include "ufo/utils/VertInterp.interface.h"
+
+namespace ufo {
+namespace test {
+
+// Micro-benchmarks of utility kernels used by many filters and operators. Problem sizes and
+// the number of repetitions are read from the `benchmarks` section of the test configuration,
+// so that the same executable can be used for a quick smoke test in CI and for reproducible
+// timings of larger problems. The timings are only reported, not checked.
+
+/// Settings of one benchmark, read from the `benchmarks.<name>` section of the configuration.
+struct BenchmarkSettings {
+  explicit BenchmarkSettings(const std::string &name) : name(name) {
+    const eckit::LocalConfiguration conf(::test::TestEnvironment::config(), "benchmarks");
+    const eckit::LocalConfiguration benchConf = conf.getSubConfiguration(name);
+    size = benchConf.getInt("size", conf.getInt("size", 100000));
+    repetitions = benchConf.getInt("repetitions", conf.getInt("repetitions", 5));
+    EXPECT(size > 0);
+    EXPECT(repetitions > 0);
+  }
+
+  std::string name;
+  int size;
+  int repetitions;
+};
+
+/// Call \p f `settings.repetitions` times and log the minimum and median run time in ms.
+template <typename Function>
+void runBenchmark(const BenchmarkSettings &settings, const std::string &description,
+                  const Function &f) {
+  typedef std::chrono::steady_clock Clock;
+  std::vector<double> times(settings.repetitions);
+  for (double &time : times) {
+    const Clock::time_point start = Clock::now();
+    f();
+    time = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  }
+  std::sort(times.begin(), times.end());
+  oops::Log::info() << "Benchmark " << settings.name << ", " << description
+                    << " (size " << settings.size << "): min " << times.front()
+                    << " ms, median " << times[times.size() / 2] << " ms" << std::endl;
+}
+
+/// Return \p n uniformly distributed random numbers from [\p lower, \p upper).
+template <typename T>
+std::vector<T> randomValues(size_t n, T lower, T upper, unsigned int seed = 123) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<T> distribution(lower, upper);
+  std::vector<T> values(n);
+  for (T &value : values)
+    value = distribution(generator);
+  return values;
+}
+
+CASE("ufo/Benchmarks/RecursiveSplitter") {
+  const BenchmarkSettings settings("recursive splitter");
+  const size_t n = settings.size;
+  // Categories resembling station IDs (many small groups) and observation types (few large
+  // groups).
+  std::vector<int> stations(n), types(n);
+  std::mt19937 generator(123);
+  for (size_t i = 0; i < n; ++i) {
+    stations[i] = generator() % std::max<size_t>(n / 20, 1);
+    types[i] = generator() % 8;
+  }
+  const std::vector<float> times = randomValues(n, 0.0f, 21600.0f);
+
+  size_t numElements = 0;
+  runBenchmark(settings, "groupBy (two keys)", [&] {
+      RecursiveSplitter splitter(n);
+      splitter.groupBy(types);
+      splitter.groupBy(stations);
+      numElements = 0;
+      for (const auto &group : splitter.groups())
+        numElements += std::distance(group.begin(), group.end());
+    });
+  EXPECT_EQUAL(numElements, n);
+
+  RecursiveSplitter splitter(n);
+  splitter.groupBy(types);
+  splitter.groupBy(stations);
+  runBenchmark(settings, "sortGroupsBy", [&] {
+      RecursiveSplitter sorted(splitter);
+      sorted.sortGroupsBy([&times](size_t index) { return times[index]; });
+    });
+}
+
+CASE("ufo/Benchmarks/PiecewiseLinearInterpolation") {
+  const BenchmarkSettings settings("piecewise linear interpolation");
+  const size_t n = settings.size;
+  std::vector<double> abscissas = randomValues(100, -1000.0, 1000.0);
+  std::sort(abscissas.begin(), abscissas.end());
+  const std::vector<double> ordinates = randomValues(100, 0.0, 10.0, 456);
+  const std::vector<double> x = randomValues(n, -1100.0, 1100.0, 789);
+  const PiecewiseLinearInterpolation interp(abscissas, ordinates);
+
+  double sum = 0.0;
+  runBenchmark(settings, "100 points", [&] {
+      sum = 0.0;
+      for (double xi : x)
+        sum += interp(xi);
+    });
+  EXPECT(sum >= 0.0);
+}
+
+CASE("ufo/Benchmarks/SpatialBinSelector") {
+  const BenchmarkSettings settings("spatial bin selector");
+  const size_t n = settings.size;
+  const std::vector<float> latitudes = randomValues(n, -90.0f, 90.0f);
+  const std::vector<float> longitudes = randomValues(n, -180.0f, 180.0f, 456);
+  // Bins about 100 km wide, as in a typical configuration of Gaussian thinning.
+  const float mesh = 100.0f;  // km
+  const SpatialBinSelector::IndexType numLatBins = 200;
+  const SpatialBinSelector selector(numLatBins, SpatialBinCountRoundingMode::NEAREST, mesh);
+
+  long long sum = 0;  // NOLINT(runtime/int)
+  runBenchmark(settings, "latitudeBin and longitudeBin", [&] {
+      sum = 0;
+      for (size_t i = 0; i < n; ++i) {
+        const SpatialBinSelector::IndexType latBin = selector.latitudeBin(latitudes[i]);
+        sum += latBin + selector.longitudeBin(latBin, longitudes[i]);
+      }
+    });
+  EXPECT(sum >= 0);
+}
+
+/// Time the calculation of distances between \p n random points and the centres of the
+/// bins of a 1 degree grid containing them.
+void benchmarkDistanceCalculator(const BenchmarkSettings &settings,
+                                 const std::string &description,
+                                 const DistanceCalculator &calculator) {
+  const size_t n = settings.size;
+  const std::vector<float> latitudes = randomValues(n, -90.0f, 90.0f);
+  const std::vector<float> longitudes = randomValues(n, -180.0f, 180.0f, 456);
+  const std::vector<float> pressures = randomValues(n, 10000.0f, 100000.0f, 789);
+
+  float sum = 0.0f;
+  runBenchmark(settings, description, [&] {
+      sum = 0.0f;
+      for (size_t i = 0; i < n; ++i) {
+        const float latCenter = std::floor(latitudes[i]) + 0.5f;
+        const float lonCenter = std::floor(longitudes[i]) + 0.5f;
+        const float spatial = calculator.spatialDistanceComponent(
+              latitudes[i], longitudes[i], latCenter, lonCenter, 1.0f, 1.0f);
+        const float vertical = calculator.nonspatialDistanceComponent(
+              pressures[i], 50000.0f, 1.0e-4f);
+        sum += calculator.finalise(calculator.combineDistanceComponents(spatial, vertical));
+      }
+    });
+  EXPECT(sum >= 0.0f);
+}
+
+CASE("ufo/Benchmarks/DistanceCalculators") {
+  const BenchmarkSettings settings("distance calculators");
+  benchmarkDistanceCalculator(settings, "geodesic", GeodesicDistanceCalculator());
+  benchmarkDistanceCalculator(settings, "max norm", MaxNormDistanceCalculator());
+  benchmarkDistanceCalculator(settings, "null", NullDistanceCalculator());
+}
+
+CASE("ufo/Benchmarks/VertInterpWeights") {
+  const BenchmarkSettings settings("vert interp weights");
+  const int nlev = 70;
+  const int nobs = settings.size;
+  std::vector<double> vec = randomValues(nlev, 0.0, 80000.0);
+  std::sort(vec.begin(), vec.end());
+  std::vector<double> obl = randomValues(nobs, -1000.0, 81000.0, 456);
+  std::vector<int> wi(nobs);
+  std::vector<double> wf(nobs);
+
+  runBenchmark(settings, "linear search, 70 levels", [&] {
+      for (int i = 0; i < nobs; ++i)
+        vert_interp_weights_f90(nlev, obl[i], vec.data(), wi[i], wf[i]);
+    });
+  runBenchmark(settings, "bisection, 70 levels", [&] {
+      for (int i = 0; i < nobs; ++i)
+        vert_interp_weights_bisect_f90(nlev, obl[i], vec.data(), wi[i], wf[i]);
+    });
+  std::sort(obl.begin(), obl.end());
+  runBenchmark(settings, "batched and sorted, 70 levels", [&] {
+      vert_interp_weights_sorted_f90(nlev, nobs, obl.data(), vec.data(), wi.data(), wf.data());
+    });
+}
+
+class Benchmarks : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::Benchmarks";}
+
+  void register_tests() const override {}
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_BENCHMARKS_H_
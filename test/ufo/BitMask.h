@@ -0,0 +1,116 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_BITMASK_H_
+#define TEST_UFO_BITMASK_H_
+
+#include "ufo/utils/BitMask.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+
+namespace ufo {
+namespace test {
+
+/// Return a vector of \p n bits in which every \p period-th bit is set.
+std::vector<bool> periodicBits(size_t n, size_t period) {
+  std::vector<bool> bits(n, false);
+  for (size_t i = 0; i < n; i += period)
+    bits[i] = true;
+  return bits;
+}
+
+CASE("ufo/BitMask/constructors") {
+  for (size_t n : {0, 1, 63, 64, 65, 200}) {
+    EXPECT_EQUAL(BitMask(n).count(), 0);
+    EXPECT_EQUAL(BitMask(n, true).count(), n);
+    EXPECT(BitMask(n, true).toVector() == std::vector<bool>(n, true));
+
+    const std::vector<bool> bits = periodicBits(n, 3);
+    const BitMask mask(bits);
+    EXPECT_EQUAL(mask.size(), n);
+    EXPECT(mask.toVector() == bits);
+    EXPECT_EQUAL(mask.count(), static_cast<size_t>(std::count(bits.begin(), bits.end(), true)));
+    EXPECT_EQUAL(mask.any(), n > 0);
+    for (size_t i = 0; i < n; ++i)
+      EXPECT_EQUAL(mask.test(i), bits[i]);
+  }
+}
+
+CASE("ufo/BitMask/setAndReset") {
+  BitMask mask(130);
+  mask.set(0);
+  mask.set(64);
+  mask.set(129);
+  EXPECT_EQUAL(mask.count(), 3);
+  mask.reset(64);
+  EXPECT(mask.test(0));
+  EXPECT(!mask.test(64));
+  EXPECT(mask.test(129));
+  EXPECT_EQUAL(mask.count(), 2);
+}
+
+CASE("ufo/BitMask/logicalOperations") {
+  const size_t n = 200;
+  const std::vector<bool> a = periodicBits(n, 2), b = periodicBits(n, 3);
+  std::vector<bool> expectedAnd(n), expectedOr(n), expectedAndNot(n), expectedNot(n);
+  for (size_t i = 0; i < n; ++i) {
+    expectedAnd[i] = a[i] && b[i];
+    expectedOr[i] = a[i] || b[i];
+    expectedAndNot[i] = a[i] && !b[i];
+    expectedNot[i] = !a[i];
+  }
+  EXPECT((BitMask(a) & BitMask(b)).toVector() == expectedAnd);
+  EXPECT((BitMask(a) | BitMask(b)).toVector() == expectedOr);
+  EXPECT(BitMask(a).andNot(BitMask(b)).toVector() == expectedAndNot);
+  BitMask flipped(a);
+  flipped.flip();
+  EXPECT(flipped.toVector() == expectedNot);
+  // Bits beyond the end of the mask must stay unset.
+  EXPECT_EQUAL(flipped.count(), n / 2);
+}
+
+CASE("ufo/BitMask/forEachSetBit") {
+  const std::vector<bool> bits = periodicBits(1000, 37);
+  std::vector<size_t> expected, visited;
+  for (size_t i = 0; i < bits.size(); ++i)
+    if (bits[i])
+      expected.push_back(i);
+  BitMask(bits).forEachSetBit([&visited](size_t i) {visited.push_back(i);});
+  EXPECT(visited == expected);
+
+  visited.clear();
+  BitMask(1000).forEachSetBit([&visited](size_t i) {visited.push_back(i);});
+  EXPECT(visited.empty());
+}
+
+CASE("ufo/BitMask/toBitMasks") {
+  const std::vector<std::vector<bool>> flagged{periodicBits(70, 2), periodicBits(70, 5)};
+  const std::vector<BitMask> masks = toBitMasks(flagged);
+  EXPECT_EQUAL(masks.size(), 2);
+  EXPECT(masks[0].toVector() == flagged[0]);
+  EXPECT(masks[1].toVector() == flagged[1]);
+}
+
+class BitMask : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::BitMask";}
+
+  void register_tests() const override {}
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_BITMASK_H_
@@ -0,0 +1,149 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_CRTMCLEARSKYTHRESHOLD_H_
+#define TEST_UFO_CRTMCLEARSKYTHRESHOLD_H_
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+#include "oops/base/Variables.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Expect.h"
+#include "test/TestEnvironment.h"
+#include "ufo/GeoVaLs.h"
+#include "ufo/Locations.h"
+#include "ufo/ObsBias.h"
+#include "ufo/ObsDiagnostics.h"
+#include "ufo/ObsOperator.h"
+
+namespace ufo {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+/// Simulate the observations with the operator configured by \p obsopconf and return H(x).
+std::vector<double> simulateCRTM(const eckit::LocalConfiguration & obsopconf,
+                                 ioda::ObsSpace & ospace, const GeoVaLs & gval) {
+  ObsOperatorParametersWrapper obsopparams;
+  obsopparams.validateAndDeserialize(obsopconf);
+  const ObsOperator hop(ospace, obsopparams);
+
+  const ObsBias ybias(ospace, ObsBiasParameters());
+  ioda::ObsVector hofx(ospace);
+  ioda::ObsVector bias(ospace);
+  bias.zero();
+  std::unique_ptr<Locations> locs(hop.locations());
+  ObsDiagnostics diags(ospace, *locs, oops::Variables());
+  hop.simulateObs(gval, hofx, ybias, bias, diags);
+
+  std::vector<double> values(hofx.size());
+  for (size_t jval = 0; jval < values.size(); ++jval)
+    values[jval] = hofx[jval];
+  return values;
+}
+
+// -----------------------------------------------------------------------------
+
+/// Check that with a `Clear_Sky_Threshold` the CRTM operator gives the clear-sky H(x) of the
+/// profiles whose condensate does not exceed the threshold and the all-sky H(x) of the others.
+/// The threshold is set between two condensate values near the median, so that there are
+/// profiles of both kinds.
+void testClearSkyThreshold() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const util::DateTime bgn(conf.getString("window begin"));
+  const util::DateTime end(conf.getString("window end"));
+
+  for (const eckit::LocalConfiguration & obsconf : conf.getSubConfigurations("observations")) {
+    ioda::ObsTopLevelParameters obsparams;
+    obsparams.validateAndDeserialize(eckit::LocalConfiguration(obsconf, "obs space"));
+    ioda::ObsSpace ospace(obsparams, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+    eckit::LocalConfiguration allSkyConf(obsconf, "obs operator");
+    const eckit::LocalConfiguration clearSkyConf(obsconf, "clear-sky obs operator");
+    ObsOperatorParametersWrapper allSkyParams;
+    allSkyParams.validateAndDeserialize(allSkyConf);
+    const oops::Variables geovars = ObsOperator(ospace, allSkyParams).requiredVars();
+    GeoVaLsParameters geovalsparams;
+    geovalsparams.validateAndDeserialize(eckit::LocalConfiguration(obsconf, "geovals"));
+    const GeoVaLs gval(geovalsparams, ospace, geovars);
+
+    // Column-integrated condensate of each profile, summed over all cloud species.
+    const size_t nlocs = ospace.nlocs();
+    std::vector<double> condensate(nlocs, 0.0);
+    std::vector<double> values(nlocs);
+    for (const std::string & var : obsconf.getStringVector("cloud geovals")) {
+      for (size_t jlev = 0; jlev < gval.nlevs(var); ++jlev) {
+        gval.getAtLevel(values, var, jlev);
+        for (size_t jloc = 0; jloc < nlocs; ++jloc)
+          condensate[jloc] += values[jloc];
+      }
+    }
+    std::vector<double> sorted = condensate;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    EXPECT(sorted.size() >= 2);
+    const size_t jmedian = (sorted.size() - 1) / 2;
+    // The threshold is passed to CRTM as a float.
+    const float threshold = 0.5 * (sorted[jmedian] + sorted[jmedian + 1]);
+
+    const std::vector<double> allSky = simulateCRTM(allSkyConf, ospace, gval);
+    const std::vector<double> clearSky = simulateCRTM(clearSkyConf, ospace, gval);
+    allSkyConf.set("Clear_Sky_Threshold", static_cast<double>(threshold));
+    const std::vector<double> hofx = simulateCRTM(allSkyConf, ospace, gval);
+
+    const double tol = obsconf.getDouble("tolerance");
+    const size_t nvars = ospace.obsvariables().size();
+    size_t nclear = 0;
+    for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+      const bool clear = condensate[jloc] <= static_cast<double>(threshold);
+      if (clear) ++nclear;
+      const std::vector<double> & expected = clear ? clearSky : allSky;
+      for (size_t jvar = 0; jvar < nvars; ++jvar) {
+        const size_t jval = jloc * nvars + jvar;
+        EXPECT(std::abs(hofx[jval] - expected[jval]) <= tol * std::abs(expected[jval]));
+      }
+    }
+    EXPECT(nclear > 0);
+    EXPECT(nclear < nlocs);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class CRTMClearSkyThreshold : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::CRTMClearSkyThreshold";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/CRTMClearSkyThreshold/testClearSkyThreshold") {
+                      testClearSkyThreshold();
+                    });
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_CRTMCLEARSKYTHRESHOLD_H_
@@ -46,6 +46,7 @@
 #include "ufo/profile/ProfileCheckValidator.h"
 #include "ufo/profile/ProfileDataHandler.h"
 #include "ufo/profile/ProfileDataHolder.h"
+#include "ufo/profile/ProfileVariableHandle.h"
 #include "ufo/profile/ProfileVerticalAveraging.h"
 #include "ufo/profile/VariableNames.h"
 
@@ -177,6 +178,14 @@ void testConventionalProfileProcessing(const eckit::LocalConfiguration &conf) {
     profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure);
     // Attempt to access data with incorrect type
     EXPECT_THROWS(profileDataHandler.get<int>(ufo::VariableNames::obs_air_pressure));
+    // Access the same data with handles, which must give the same results.
+    const ProfileVariableHandle<float> pressureHandle(ufo::VariableNames::obs_air_pressure);
+    EXPECT(entireSampleDataHandler.get(pressureHandle) ==
+           entireSampleDataHandler.get<float>(ufo::VariableNames::obs_air_pressure));
+    EXPECT(profileDataHandler.get(pressureHandle) ==
+           profileDataHandler.get<float>(ufo::VariableNames::obs_air_pressure));
+    const ProfileVariableHandle<int> wrongTypeHandle(ufo::VariableNames::obs_air_pressure);
+    EXPECT_THROWS(profileDataHandler.get(wrongTypeHandle));
   }
 
   // Manually modify Processing flags in order to cover rare code paths.
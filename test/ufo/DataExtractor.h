@@ -9,7 +9,9 @@
 #define TEST_UFO_DATAEXTRACTOR_H_
 
 #include "ufo/utils/dataextractor/DataExtractor.h"
+#include "ufo/utils/dataextractor/DataExtractorCSVBackend.h"
 
+#include <fstream>
 #include <iomanip>
 #include <memory>
 #include <set>
@@ -350,6 +352,109 @@ CASE("ufo/DataExtractor/get1DSlice/not_1d_slice") {
 }
 
 
+CASE("ufo/DataExtractor/extractBatch") {
+  const std::string filepath = "dataextractor_extractbatch.csv";
+  {
+    std::ofstream file(filepath);
+    file << "station_id@MetaData,air_pressure@MetaData,air_temperature@ObsBias\n"
+         << "string,float,float\n"
+         << "XYZ,80000,0.5\n"
+         << "ABC,60000,0.2\n"
+         << "ABC,30000,0.1\n"
+         << "XYZ,40000,0.4\n"
+         << "ABC,90000,0.3\n";
+  }
+
+  const std::vector<std::string> stationIds{"XYZ", "ABC", "XYZ", "ABC", "ABC", "XYZ"};
+  const std::vector<float> pressures{60000, 45000, 60000, 90000, 45000, 40000};
+  const std::vector<float> expectedValues{0.45f, 0.15f, 0.45f, 0.3f, 0.15f, 0.4f};
+
+  for (int iextractor = 0; iextractor < 2; ++iextractor) {
+    // The second extractor reuses the data loaded and sorted by the first.
+    ufo::DataExtractor<float> extractor(filepath, "ObsBias");
+    extractor.scheduleSort("station_id@MetaData", InterpMethod::EXACT,
+                           ExtrapolationMode::ERROR, EquidistantChoice::FIRST);
+    extractor.scheduleSort("air_pressure@MetaData", InterpMethod::LINEAR,
+                           ExtrapolationMode::ERROR, EquidistantChoice::FIRST);
+    extractor.sort();
+
+    const std::vector<float> values = extractor.extractBatch({stationIds, pressures},
+                                                             stationIds.size());
+    for (size_t iloc = 0; iloc < stationIds.size(); ++iloc)
+      EXPECT(oops::is_close_absolute(values[iloc], expectedValues[iloc], 1e-6f, 0,
+                                     oops::TestVerbosity::LOG_SUCCESS_AND_FAILURE));
+
+    for (size_t iloc = 0; iloc < stationIds.size(); ++iloc) {
+      extractor.extract(stationIds[iloc]);
+      extractor.extract(pressures[iloc]);
+      EXPECT_EQUAL(extractor.getResult(), values[iloc]);
+    }
+
+    // A failed batch extraction must leave the extractor ready for further extractions.
+    EXPECT_THROWS(extractor.extractBatch({std::vector<std::string>{"ABC", "DEF"},
+                                          std::vector<float>{45000, 45000}}, 2));
+    extractor.extract(stationIds[0]);
+    extractor.extract(pressures[0]);
+    EXPECT_EQUAL(extractor.getResult(), values[0]);
+  }
+
+  // Data sorted by the same coordinates are shared regardless of the extraction methods.
+  ufo::DataExtractor<float> extractor(filepath, "ObsBias");
+  extractor.scheduleSort("MetaData/station_id", InterpMethod::EXACT,
+                         ExtrapolationMode::ERROR, EquidistantChoice::FIRST);
+  extractor.scheduleSort("MetaData/air_pressure", InterpMethod::NEAREST,
+                         ExtrapolationMode::ERROR, EquidistantChoice::FIRST);
+  extractor.sort();
+  const std::vector<float> values = extractor.extractBatch({stationIds, pressures},
+                                                           stationIds.size());
+  const std::vector<float> expectedNearestValues{0.4f, 0.1f, 0.4f, 0.3f, 0.1f, 0.4f};
+  for (size_t iloc = 0; iloc < stationIds.size(); ++iloc)
+    EXPECT(oops::is_close_absolute(values[iloc], expectedNearestValues[iloc], 1e-6f, 0,
+                                   oops::TestVerbosity::LOG_SUCCESS_AND_FAILURE));
+}
+
+
+
+CASE("ufo/DataExtractor/CSVBackend/parsing") {
+  const std::string filepath = "dataextractor_csvbackend_parsing.csv";
+  {
+    std::ofstream file(filepath);
+    file << "station_id@MetaData,MetaData/channel_number,air_temperature@ObsBias\r\n"
+         << "string,int,float\r\n"
+         << "ABC, 3 ,0.1\r\n"
+         << "\r\n"
+         << "\"X,\"\"Y\",_, _ \r\n"
+         << "A B,7,\"1e2\"\r\n"
+         << "_,-4,-0.25";  // no line terminator
+  }
+
+  const DataExtractorInput<float> input =
+      DataExtractorCSVBackend<float>(filepath).loadData("ObsBias");
+
+  const std::vector<float> expectedPayload{0.1f, missing, 100.0f, -0.25f};
+  ASSERT(input.payloadArray.shape()[0] == expectedPayload.size());
+  for (size_t i = 0; i < expectedPayload.size(); ++i)
+    EXPECT_EQUAL(input.payloadArray[i][0][0], expectedPayload[i]);
+
+  const std::vector<std::string> expectedStationIds{
+    "ABC", "X,\"Y", "A B", util::missingValue(std::string())};
+  EXPECT(boost::get<std::vector<std::string>>(input.coordsVals.at("MetaData/station_id")) ==
+         expectedStationIds);
+  const std::vector<int> expectedChannels{3, util::missingValue(int()), 7, -4};
+  EXPECT(boost::get<std::vector<int>>(input.coordsVals.at("MetaData/channel_number")) ==
+         expectedChannels);
+
+  const std::string badFilepath = "dataextractor_csvbackend_bad.csv";
+  {
+    std::ofstream file(badFilepath);
+    file << "station_id@MetaData,MetaData/channel_number,air_temperature@ObsBias\n"
+         << "string,int,float\n"
+         << "ABC,1.5,0.1\n";
+  }
+  EXPECT_THROWS_MSG(DataExtractorCSVBackend<float>(badFilepath).loadData("ObsBias"),
+                    "Invalid number '1.5' in line 3");
+}
+
 class DataExtractor : public oops::Test {
  public:
   DataExtractor() {}
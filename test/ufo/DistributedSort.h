@@ -0,0 +1,117 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_DISTRIBUTEDSORT_H_
+#define TEST_UFO_DISTRIBUTEDSORT_H_
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/mpi/Comm.h"
+#include "eckit/testing/Test.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+#include "test/TestEnvironment.h"
+#include "ufo/utils/DistributedSort.h"
+
+namespace ufo {
+namespace test {
+
+/// A key and the global index of the value it belongs to, used to break ties.
+struct KeyAndIndex {
+  int key;
+  int index;
+
+  bool operator<(const KeyAndIndex &other) const {
+    return key < other.key || (key == other.key && index < other.index);
+  }
+  bool operator==(const KeyAndIndex &other) const {
+    return key == other.key && index == other.index;
+  }
+};
+
+/// Return pseudo-random keys (in the range [0, maxKey)) of the values held on rank \p rank.
+std::vector<KeyAndIndex> valuesHeldOnRank(size_t rank, size_t numValuesPerRank, int maxKey) {
+  std::vector<KeyAndIndex> values;
+  for (size_t i = 0; i < numValuesPerRank * rank; ++i)
+    values.push_back({static_cast<int>((i * 7919 + 13) % maxKey), static_cast<int>(i)});
+  return values;
+}
+
+CASE("ufo/DistributedSort/sampleSort") {
+  const eckit::Configuration &topLevelConf = ::test::TestEnvironment::config();
+  const eckit::mpi::Comm &comm = oops::mpi::world();
+  for (const eckit::LocalConfiguration &conf : topLevelConf.getSubConfigurations("sample sort")) {
+    const size_t numValuesPerRank = conf.getUnsigned("num values per rank");
+    const int maxKey = conf.getInt("max key");
+
+    // The number of values held on each rank differs, and rank 0 holds none.
+    std::vector<KeyAndIndex> allValues;
+    std::vector<KeyAndIndex> localValues;
+    for (size_t rank = 0; rank < comm.size(); ++rank) {
+      std::vector<KeyAndIndex> values = valuesHeldOnRank(rank, numValuesPerRank, maxKey);
+      for (KeyAndIndex &value : values)
+        value.index += allValues.size();
+      if (rank == comm.rank())
+        localValues = values;
+      allValues.insert(allValues.end(), values.begin(), values.end());
+    }
+    std::sort(allValues.begin(), allValues.end());
+
+    sampleSort(localValues, comm);
+
+    // Check that the partitions held on consecutive ranks form the sorted sequence.
+    std::vector<std::vector<KeyAndIndex>> partitions =
+        distributedsortdetail::exchange(
+          std::vector<std::vector<KeyAndIndex>>(comm.size(), localValues), comm);
+    std::vector<KeyAndIndex> concatenatedPartitions;
+    for (const std::vector<KeyAndIndex> &partition : partitions)
+      concatenatedPartitions.insert(concatenatedPartitions.end(),
+                                    partition.begin(), partition.end());
+    EXPECT(concatenatedPartitions == allValues);
+  }
+}
+
+CASE("ufo/DistributedSort/stableSortReplicated") {
+  const eckit::Configuration &topLevelConf = ::test::TestEnvironment::config();
+  const eckit::mpi::Comm &comm = oops::mpi::world();
+  for (const eckit::LocalConfiguration &conf :
+         topLevelConf.getSubConfigurations("stable sort replicated")) {
+    const size_t numValues = conf.getUnsigned("num values");
+    const int maxKey = conf.getInt("max key");
+
+    std::vector<size_t> values(numValues);
+    for (size_t i = 0; i < numValues; ++i)
+      values[i] = (i * 7919 + 13) % numValues;
+    // Many values compare equal, so the order of the result depends on the stability of the
+    // sort.
+    const auto comp = [maxKey](size_t a, size_t b) { return a % maxKey < b % maxKey; };
+
+    std::vector<size_t> expectedValues = values;
+    std::stable_sort(expectedValues.begin(), expectedValues.end(), comp);
+
+    stableSortReplicated(values, comm, comp);
+    EXPECT_EQUAL(values, expectedValues);
+  }
+}
+
+class DistributedSort : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::DistributedSort";}
+
+  void register_tests() const override {}
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_DISTRIBUTEDSORT_H_
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -97,6 +98,34 @@ void fovWrapperTestHelper(const std::string sensor, const std::string satellite,
     EXPECT(oops::is_close_absolute(sample_power, reference_sample_powers[i], abs_tol));
   }
 
+  // The batched routines should give the same results as the single-observation ones
+  const int nobs = 2;
+  const std::vector<double> scan_positions(nobs, scan_position);
+  const std::vector<double> azimuths(nobs, sensor_azimuth_angle);
+  const std::vector<double> lons(nobs, longitude);
+  const std::vector<double> lats(nobs, latitude);
+  std::vector<double> batch_ellipse_lons(nobs * gsi_npoly);
+  std::vector<double> batch_ellipse_lats(nobs * gsi_npoly);
+  ufo_fov_ellipses_f90(key, sensor_len, sensor_cstr, nobs, scan_positions[0], azimuths[0],
+                       lons[0], lats[0], gsi_npoly, batch_ellipse_lons[0], batch_ellipse_lats[0]);
+  for (int iobs = 0; iobs < nobs; ++iobs) {
+    EXPECT(std::equal(ellipse_lons.begin(), ellipse_lons.end(),
+                      batch_ellipse_lons.begin() + iobs * gsi_npoly));
+    EXPECT(std::equal(ellipse_lats.begin(), ellipse_lats.end(),
+                      batch_ellipse_lats.begin() + iobs * gsi_npoly));
+  }
+
+  const int ntest = reference_sample_powers.size();
+  if (ntest > 0) {
+    const std::vector<double> test_lons(sample_lons.begin(), sample_lons.begin() + ntest);
+    const std::vector<double> test_lats(sample_lats.begin(), sample_lats.begin() + ntest);
+    std::vector<double> sample_powers(ntest);
+    ufo_antenna_powers_within_fov_f90(key, sensor_len, sensor_cstr, scan_position,
+                                      sensor_azimuth_angle, longitude, latitude, ntest,
+                                      test_lons[0], test_lats[0], sample_powers[0]);
+    EXPECT(oops::are_all_close_absolute(sample_powers, reference_sample_powers, abs_tol));
+  }
+
   ufo_fov_delete_f90(key);
 }
 
@@ -8,6 +8,7 @@
 #ifndef TEST_UFO_GEOVALS_H_
 #define TEST_UFO_GEOVALS_H_
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -24,6 +25,7 @@
 #include "oops/runs/Test.h"
 #include "oops/util/FloatCompare.h"
 #include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
 #include "test/TestEnvironment.h"
 #include "ufo/GeoVaLs.h"
 #include "ufo/Locations.h"
@@ -167,12 +169,102 @@ void testGeoVaLs() {
     }
     oops::Log::trace() <<
       "GeoVaLs & operator *= (const std::vector<float>); test succeeded" << std::endl;
+
+///  Check that GeoVaLs::timeSlotsWeightedSum and GeoVaLs::timeSlotsWeightedMerge with two time
+///  slots give the same results as split, multiplication by weights, addition and merge
+    oops::Log::trace() <<
+      "Check GeoVaLs::timeSlotsWeightedSum and GeoVaLs::timeSlotsWeightedMerge" << std::endl;
+    {
+      std::vector<float> w1(nlocs), w2(nlocs);
+      for (std::size_t i = 0; i < nlocs; ++i) {
+        w1[i] = static_cast<float>(i % 7) / 6.0f;
+        w2[i] = 1.0f - w1[i];
+      }
+
+      GeoVaLs first(ospace.distribution(), gv.getVars());
+      GeoVaLs second(ospace.distribution(), gv.getVars());
+      gv.split(first, second);
+      first *= w1;
+      second *= w2;
+      first += second;
+
+      GeoVaLs sum(ospace.distribution(), gv.getVars());
+      std::vector<float> weights(w1);
+      weights.insert(weights.end(), w2.begin(), w2.end());
+      gv.timeSlotsWeightedSum(sum, weights, 2);
+      sum -= first;
+      EXPECT(sum.rms() <= tol * first.rms());
+
+      GeoVaLs weighted1(first);
+      GeoVaLs weighted2(first);
+      weighted1 *= w1;
+      weighted2 *= w2;
+      GeoVaLs merged(gv);
+      merged.merge(weighted1, weighted2);
+
+      GeoVaLs weightedMerged(gv);
+      weightedMerged.timeSlotsWeightedMerge(first, weights, 2);
+      weightedMerged -= merged;
+      EXPECT(weightedMerged.rms() == 0.0);
+    }
+    oops::Log::trace() <<
+      "GeoVaLs::timeSlotsWeightedSum and GeoVaLs::timeSlotsWeightedMerge test succeeded"
+      << std::endl;
+
+///  Check that GeoVaLs::axpy_dot_product_with and GeoVaLs::dot_products_with agree with
+///  GeoVaLs::axpy and GeoVaLs::dot_product_with
+    oops::Log::trace() << "Check GeoVaLs::axpy_dot_product_with and GeoVaLs::dot_products_with"
+                       << std::endl;
+    {
+      GeoVaLs separate(gval);
+      separate.axpy(0.5, gv1);
+      const double dp_separate = separate.dot_product_with(gval);
+
+      GeoVaLs fused(gval);
+      const double dp_fused = fused.axpy_dot_product_with(0.5, gv1, gval);
+      EXPECT(oops::is_close_relative(dp_fused, dp_separate, tol));
+      fused -= separate;
+      EXPECT(fused.rms() <= tol * separate.rms());
+
+      const std::vector<double> dp_vars = separate.dot_products_with(gval);
+      EXPECT_EQUAL(dp_vars.size(), gval.getVars().size());
+      double dp_sum = 0.0;
+      for (const double dp : dp_vars) dp_sum += dp;
+      EXPECT(oops::is_close_relative(dp_sum, dp_separate, tol));
+    }
+    oops::Log::trace() <<
+      "GeoVaLs::axpy_dot_product_with and GeoVaLs::dot_products_with test succeeded" << std::endl;
+
+///  Check the zero GeoVaLs holding a subset of the variables and GeoVaLsView::locations
+    oops::Log::trace() << "Check GeoVaLs subset constructor and GeoVaLsView::locations"
+                       << std::endl;
+    {
+      oops::Variables subsetVars;
+      subsetVars.push_back(ingeovars[ingeovars.size() - 1]);
+      const GeoVaLs subset(gval, subsetVars);
+      EXPECT(subset.getVars() == subsetVars);
+      EXPECT_EQUAL(subset.nlocs(), gval.nlocs());
+      const std::string & var = subsetVars[0];
+      EXPECT_EQUAL(subset.nlevs(var), gval.nlevs(var));
+      EXPECT(subset.rms() == 0.0);
+
+      const GeoVaLsView all = gval.view(var);
+      const size_t begin = all.nlocs() / 2;
+      const GeoVaLsView half = all.locations(begin, all.nlocs() - begin);
+      EXPECT_EQUAL(half.nlocs(), all.nlocs() - begin);
+      EXPECT_EQUAL(half.nlevs(), all.nlevs());
+      for (size_t loc = 0; loc < half.nlocs(); ++loc)
+        for (size_t lev = 0; lev < half.nlevs(); ++lev)
+          EXPECT(half(loc, lev) == all(begin + loc, lev));
+    }
+    oops::Log::trace() << "GeoVaLs subset constructor and GeoVaLsView::locations test succeeded"
+                       << std::endl;
   }
 }
 
 /// \brief Tests GeoVaLs::allocate, GeoVals::put, GeoVaLs::get,
 /// GeoVaLs::putAtLevel, GeoVaLs::getAtLevel,
-/// GeoVaLs::putAtLocation and GeoVaLs::getAtLocation.
+/// GeoVaLs::putAtLocation, GeoVaLs::getAtLocation and GeoVaLs::view.
 void testGeoVaLsAllocatePutGet() {
   const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
   const eckit::LocalConfiguration testconf(conf, "geovals get test");
@@ -188,6 +280,7 @@ void testGeoVaLsAllocatePutGet() {
   oops::Log::test() << "GeoVals allocate test: created empty GeoVaLs with " << testvars <<
                        " variables and nlocs=" << gval.nlocs() << std::endl;
   EXPECT_EQUAL(gval.nlevs(var1), 0);
+  EXPECT(gval.view(var1).empty());
   EXPECT_EQUAL(gval.nlevs(var2), 0);
 
   /// Allocate only the first variable, and test that it's allocated correctly
@@ -292,6 +385,23 @@ void testGeoVaLsAllocatePutGet() {
     // Compare the two vectors.
     EXPECT_EQUAL(testvalues_double, refvalues_double);
   }
+  /// Check that a view returns the same values without copying them.
+  {
+    const GeoVaLsView view = gval.view(var1);
+    EXPECT_EQUAL(view.nlevs(), gval.nlevs(var1));
+    EXPECT_EQUAL(view.nlocs(), gval.nlocs());
+    EXPECT_EQUAL(view.levelStride(), 1);
+    EXPECT_EQUAL(view.locationStride(), gval.nlevs(var1));
+    for (size_t jloc = 0; jloc < gval.nlocs(); ++jloc) {
+      const double * profile = view.atLocation(jloc);
+      for (size_t jlev = 0; jlev < gval.nlevs(var1); ++jlev) {
+        EXPECT_EQUAL(view(jloc, jlev), static_cast<double>(jlev + jloc));
+        EXPECT_EQUAL(profile[jlev], static_cast<double>(jlev + jloc));
+        EXPECT_EQUAL(view.atLevel(jlev)[jloc * view.locationStride()],
+                     static_cast<double>(jlev + jloc));
+      }
+    }
+  }
   /// (2) floats
   /// The reference GeoVaLs at indices (jlev, jloc) are equal to jlev + jloc + 1.
   oops::Log::test() << "putAtLoction with floats" << std::endl;
@@ -396,6 +506,232 @@ void testGeoVaLsConstructor() {
   EXPECT_EQUAL(testvalues_int, refvalues_int);
 }
 
+// -----------------------------------------------------------------------------
+/// Test that the values passed to fill() are retrieved unchanged (up to the single-precision
+/// rounding applied if UFO_GEOVALS_SINGLE_PRECISION is set) and missing values are preserved.
+void testGeoVaLsFill() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const eckit::LocalConfiguration testconf(conf, "geovals get test");
+
+  const std::string var1 = "variable1";
+  const std::string var2 = "variable2";
+  const Locations locs(testconf, oops::mpi::world());
+  GeoVaLs gval(locs, oops::Variables({var1, var2}), {3, 1});
+  const size_t nlocs = gval.nlocs();
+  const double missing = util::missingValue(missing);
+
+  std::vector<size_t> indx(nlocs);
+  std::vector<double> vals;
+  for (size_t jloc = 0; jloc < nlocs; ++jloc)
+    indx[jloc] = jloc;
+  for (size_t jlev = 0; jlev < 4; ++jlev)
+    for (size_t jloc = 0; jloc < nlocs; ++jloc)
+      vals.push_back(jloc % 5 == 0 ? missing : 1.0 / (jlev + jloc + 3.0));
+  gval.fill(indx, vals, true);
+
+  std::vector<double> testvalues(nlocs);
+  for (size_t jlev = 0; jlev < 4; ++jlev) {
+    if (jlev < 3)
+      gval.getAtLevel(testvalues, var1, jlev);
+    else
+      gval.get(testvalues, var2);
+    for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+      const double expected = vals[jlev * nlocs + jloc];
+      if (expected == missing)
+        EXPECT_EQUAL(testvalues[jloc], missing);
+      else
+        EXPECT(oops::is_close_relative(testvalues[jloc], expected, 1e-6));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// Test that fillLocationMajor() and fillADLocationMajor() are equivalent to fill() and fillAD()
+/// applied to the same values ordered by level, including when levels are ordered bottom-up.
+void testGeoVaLsFillLocationMajor() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const eckit::LocalConfiguration testconf(conf, "geovals get test");
+
+  const std::string var1 = "variable1";
+  const std::string var2 = "variable2";
+  const std::vector<size_t> nlevs{3, 1};
+  const Locations locs(testconf, oops::mpi::world());
+  GeoVaLs levelMajor(locs, oops::Variables({var1, var2}), nlevs);
+  GeoVaLs locationMajor(locs, oops::Variables({var1, var2}), nlevs);
+  const size_t nlocs = levelMajor.nlocs();
+
+  // Fill the GeoVaLs at locations in reverse order.
+  std::vector<size_t> indx(nlocs);
+  for (size_t jloc = 0; jloc < nlocs; ++jloc)
+    indx[jloc] = nlocs - 1 - jloc;
+  std::vector<double> levelMajorVals, locationMajorVals;
+  for (size_t nlev : nlevs) {
+    for (size_t jlev = 0; jlev < nlev; ++jlev)
+      for (size_t jloc = 0; jloc < nlocs; ++jloc)
+        levelMajorVals.push_back(1.0 / (nlev + jlev + 2.0 * jloc + 1.0));
+    for (size_t jloc = 0; jloc < nlocs; ++jloc)
+      for (size_t jlev = 0; jlev < nlev; ++jlev)
+        locationMajorVals.push_back(1.0 / (nlev + jlev + 2.0 * jloc + 1.0));
+  }
+
+  for (bool levelsTopDown : {true, false}) {
+    levelMajor.fill(indx, levelMajorVals, levelsTopDown);
+    locationMajor.fillLocationMajor(indx, locationMajorVals, levelsTopDown);
+
+    std::vector<double> expected(nlocs), actual(nlocs);
+    for (size_t jlev = 0; jlev < nlevs[0]; ++jlev) {
+      levelMajor.getAtLevel(expected, var1, jlev);
+      locationMajor.getAtLevel(actual, var1, jlev);
+      EXPECT_EQUAL(actual, expected);
+    }
+    levelMajor.get(expected, var2);
+    locationMajor.get(actual, var2);
+    EXPECT_EQUAL(actual, expected);
+
+    std::vector<double> levelMajorAD(levelMajorVals.size(), 0.0);
+    std::vector<double> locationMajorAD(locationMajorVals.size(), 0.0);
+    levelMajor.fillAD(indx, levelMajorAD, levelsTopDown);
+    locationMajor.fillADLocationMajor(indx, locationMajorAD, levelsTopDown);
+    size_t ilevelMajor = 0;
+    size_t varOffset = 0;
+    for (size_t nlev : nlevs) {
+      for (size_t jlev = 0; jlev < nlev; ++jlev)
+        for (size_t jloc = 0; jloc < nlocs; ++jloc)
+          EXPECT_EQUAL(locationMajorAD[varOffset + jloc * nlev + jlev],
+                       levelMajorAD[ilevelMajor++]);
+      varOffset += nlev * nlocs;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// \brief Tests that GeoVaLs constructed for Locations with required levels store only these
+/// levels of the values passed to fill() and that fillAD() sets the other levels to zero.
+void testGeoVaLsRequiredLevels() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const eckit::LocalConfiguration testconf(conf, "geovals get test");
+
+  const std::string var1 = "variable1";
+  const std::string var2 = "variable2";
+  const std::vector<size_t> nlevs{5, 1};
+  const size_t nstored = 2;
+  const oops::Variables vars({var1, var2});
+  Locations locs(testconf, oops::mpi::world());
+  GeoVaLs full(locs, vars, nlevs);
+  for (bool nearSurface : {true, false}) {
+    RequiredLevels required;
+    required.numLevels = nstored;
+    required.nearSurface = nearSurface;
+    locs.setRequiredLevels({{var1, required}});
+    GeoVaLs subset(locs, vars, nlevs);
+    EXPECT_EQUAL(subset.nlevs(var1), nstored);
+    EXPECT_EQUAL(subset.nlevs(var2), nlevs[1]);
+    const size_t offset = nearSurface ? nlevs[0] - nstored : 0;
+    const size_t nlocs = full.nlocs();
+
+    std::vector<size_t> indx(nlocs);
+    for (size_t jloc = 0; jloc < nlocs; ++jloc)
+      indx[jloc] = jloc;
+    std::vector<double> vals;
+    for (size_t nlev : nlevs)
+      for (size_t jlev = 0; jlev < nlev; ++jlev)
+        for (size_t jloc = 0; jloc < nlocs; ++jloc)
+          vals.push_back(1.0 / (nlev + jlev + 2.0 * jloc + 1.0));
+
+    for (bool levelsTopDown : {true, false}) {
+      full.fill(indx, vals, levelsTopDown);
+      subset.fill(indx, vals, levelsTopDown);
+
+      std::vector<double> expected(nlocs), actual(nlocs);
+      for (size_t jlev = 0; jlev < nstored; ++jlev) {
+        full.getAtLevel(expected, var1, offset + jlev);
+        subset.getAtLevel(actual, var1, jlev);
+        EXPECT_EQUAL(actual, expected);
+      }
+      full.get(expected, var2);
+      subset.get(actual, var2);
+      EXPECT_EQUAL(actual, expected);
+
+      std::vector<double> fullAD(vals.size()), subsetAD(vals.size());
+      full.fillAD(indx, fullAD, levelsTopDown);
+      subset.fillAD(indx, subsetAD, levelsTopDown);
+      for (size_t jlev = 0; jlev < nlevs[0]; ++jlev)
+        for (size_t jloc = 0; jloc < nlocs; ++jloc) {
+          const size_t i = jlev * nlocs + jloc;
+          const bool stored = jlev >= offset && jlev < offset + nstored;
+          EXPECT_EQUAL(subsetAD[i], stored ? fullAD[i] : 0.0);
+        }
+      for (size_t i = nlevs[0] * nlocs; i < vals.size(); ++i)
+        EXPECT_EQUAL(subsetAD[i], fullAD[i]);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+/// \brief Tests that GeoVaLs constructed for Locations sampling observation paths store the
+/// per-path variables only at the path centres.
+void testGeoVaLsPaths() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const eckit::LocalConfiguration testconf(conf, "geovals get test");
+
+  const std::string var1 = "variable1";
+  const std::string var2 = "variable2";
+  const std::vector<size_t> nlevs{3, 1};
+  const oops::Variables vars({var1, var2});
+  Locations locs(testconf, oops::mpi::world());
+  const size_t nlocs = locs.size();
+  GeoVaLs full(locs, vars, nlevs);
+
+  // Paths made up of two consecutive locations (except possibly the last one), represented by
+  // their last location.
+  std::vector<size_t> pathOffsets, pathCentres;
+  for (size_t jloc = 0; jloc < nlocs; jloc += 2) {
+    pathOffsets.push_back(jloc);
+    pathCentres.push_back(std::min(jloc + 1, nlocs - 1));
+  }
+  pathOffsets.push_back(nlocs);
+  const size_t npaths = pathCentres.size();
+  locs.setPaths(pathOffsets, pathCentres, {var2});
+  GeoVaLs paths(locs, vars, nlevs);
+  EXPECT_EQUAL(paths.nlocs(), nlocs);
+  EXPECT_EQUAL(paths.nlocs(var1), nlocs);
+  EXPECT_EQUAL(paths.nlocs(var2), npaths);
+
+  std::vector<size_t> indx(nlocs);
+  for (size_t jloc = 0; jloc < nlocs; ++jloc)
+    indx[jloc] = jloc;
+  std::vector<double> vals;
+  for (size_t nlev : nlevs)
+    for (size_t jlev = 0; jlev < nlev; ++jlev)
+      for (size_t jloc = 0; jloc < nlocs; ++jloc)
+        vals.push_back(1.0 / (nlev + jlev + 2.0 * jloc + 1.0));
+  full.fill(indx, vals, true);
+  paths.fill(indx, vals, true);
+
+  std::vector<double> expected(nlocs), actual(nlocs);
+  for (size_t jlev = 0; jlev < nlevs[0]; ++jlev) {
+    full.getAtLevel(expected, var1, jlev);
+    paths.getAtLevel(actual, var1, jlev);
+    EXPECT_EQUAL(actual, expected);
+  }
+  full.get(expected, var2);
+  std::vector<double> perPath(npaths);
+  paths.get(perPath, var2);
+  for (size_t jpath = 0; jpath < npaths; ++jpath)
+    EXPECT_EQUAL(perPath[jpath], expected[pathCentres[jpath]]);
+
+  std::vector<double> fullAD(vals.size()), pathsAD(vals.size());
+  full.fillAD(indx, fullAD, true);
+  paths.fillAD(indx, pathsAD, true);
+  const size_t var2Offset = nlevs[0] * nlocs;
+  for (size_t i = 0; i < var2Offset; ++i)
+    EXPECT_EQUAL(pathsAD[i], fullAD[i]);
+  std::vector<bool> isCentre(nlocs, false);
+  for (size_t centre : pathCentres)
+    isCentre[centre] = true;
+  for (size_t jloc = 0; jloc < nlocs; ++jloc)
+    EXPECT_EQUAL(pathsAD[var2Offset + jloc], isCentre[jloc] ? fullAD[var2Offset + jloc] : 0.0);
+}
 
 // -----------------------------------------------------------------------------
 
@@ -413,6 +749,14 @@ class GeoVaLs : public oops::Test {
       { testGeoVaLs(); });
     ts.emplace_back(CASE("ufo/GeoVaLs/testGeoVaLsAllocatePutGet")
       { testGeoVaLsAllocatePutGet(); });
+    ts.emplace_back(CASE("ufo/GeoVaLs/testGeoVaLsFill")
+      { testGeoVaLsFill(); });
+    ts.emplace_back(CASE("ufo/GeoVaLs/testGeoVaLsFillLocationMajor")
+      { testGeoVaLsFillLocationMajor(); });
+    ts.emplace_back(CASE("ufo/GeoVaLs/testGeoVaLsRequiredLevels")
+      { testGeoVaLsRequiredLevels(); });
+    ts.emplace_back(CASE("ufo/GeoVaLs/testGeoVaLsPaths")
+      { testGeoVaLsPaths(); });
     ts.emplace_back(CASE("ufo/GeoVaLs/testGeoVaLsConstructor")
       { testGeoVaLsConstructor(); });
   }
@@ -6,6 +6,8 @@
 #ifndef TEST_UFO_HISTORYCHECK_H_
 #define TEST_UFO_HISTORYCHECK_H_
 
+#include <cstdio>
+#include <fstream>
 #include <iomanip>
 #include <memory>
 #include <string>
@@ -59,9 +61,29 @@ void testHistoryCheck(const eckit::LocalConfiguration &conf) {
   std::shared_ptr<ioda::ObsDataVector<int>> qcflags(new ioda::ObsDataVector<int>(
       obsspace, obsspace.obsvariables()));
 
+  // Contents of the state file (one string per line) before and after running the filter.
+  const std::string stateFile = filterConf.getString("state file", "");
+  if (!stateFile.empty()) {
+    std::remove(stateFile.c_str());
+    if (conf.has("initial state")) {
+      std::ofstream os(stateFile);
+      for (const std::string &line : conf.getStringVector("initial state"))
+        os << line << '\n';
+    }
+  }
+
   ufo::HistoryCheck filter(obsspace, filterParameters, qcflags, obserr, conf);
   filter.preProcess();
 
+  if (conf.has("expected state")) {
+    std::ifstream is(stateFile);
+    std::vector<std::string> state;
+    std::string line;
+    while (std::getline(is, line))
+      state.push_back(line);
+    EXPECT_EQUAL(state, conf.getStringVector("expected state"));
+  }
+
   const std::vector<size_t> expectedRejectedObsIndices =
       conf.getUnsignedVector("expected rejected obs indices");
   std::vector<size_t> rejectedObsIndices;
@@ -0,0 +1,120 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_LOCALOBSINDEX_H_
+#define TEST_UFO_LOCALOBSINDEX_H_
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+#include "test/TestEnvironment.h"
+#include "ufo/obslocalization/LocalObsIndex.h"
+
+namespace ufo {
+namespace test {
+
+const char localObsIndexFileName[] = "test_ufo_local_obs_index.bin";
+
+/// Settings of an index of the local obs of observations at \p lons, \p lats.
+ufo::LocalObsIndex::Header localObsIndexSettings(const std::vector<float> &lons,
+                                                 const std::vector<float> &lats) {
+  ufo::LocalObsIndex::Header header;
+  header.nlocs = lons.size();
+  header.locationsChecksum = ufo::LocalObsIndex::locationsChecksum(lons, lats);
+  header.windowStart = 1262304000;  // 2010-01-01T00:00:00Z
+  header.windowEnd = 1262325600;    // 2010-01-01T06:00:00Z
+  header.lengthscale = 1.0e6;
+  header.searchMethod = 1;
+  header.distanceType = 0;
+  header.maxnobs = 2;
+  return header;
+}
+
+CASE("ufo/LocalObsIndex/saveAndReload") {
+  const std::vector<float> lons{10.0f, 20.0f, 30.0f};
+  const std::vector<float> lats{-5.0f, 0.0f, 5.0f};
+  const ufo::LocalObsIndex::Header settings = localObsIndexSettings(lons, lats);
+
+  const std::vector<ufo::LocalObsIndex::Key> keys{{-3.0, 1.0}, {12.0, -2.0}, {12.0, 4.0}};
+  const std::vector<size_t> offsets{0, 2, 2, 3};
+  const std::vector<double> distance{1.5e5, 7.0e5, 2.5e5};
+  const std::vector<int> index{0, 1, 2};
+  std::remove(localObsIndexFileName);
+  ufo::LocalObsIndex::save(localObsIndexFileName, settings, keys, offsets, distance, index);
+
+  std::unique_ptr<const ufo::LocalObsIndex> reloaded =
+      ufo::LocalObsIndex::open(localObsIndexFileName, settings);
+  EXPECT(reloaded != nullptr);
+  EXPECT_EQUAL(reloaded->size(), keys.size());
+  for (size_t jp = 0; jp < keys.size(); ++jp) {
+    ufo::LocalObsIndex::Entry entry;
+    EXPECT(reloaded->find(keys[jp].lon, keys[jp].lat, entry));
+    EXPECT_EQUAL(entry.size, offsets[jp + 1] - offsets[jp]);
+    for (size_t jo = 0; jo < entry.size; ++jo) {
+      EXPECT_EQUAL(entry.distance[jo], distance[offsets[jp] + jo]);
+      EXPECT_EQUAL(entry.index[jo], index[offsets[jp] + jo]);
+    }
+  }
+  ufo::LocalObsIndex::Entry entry;
+  EXPECT_NOT(reloaded->find(12.0, 0.0, entry));
+}
+
+CASE("ufo/LocalObsIndex/mismatch") {
+  const std::vector<float> lons{10.0f, 20.0f, 30.0f};
+  const std::vector<float> lats{-5.0f, 0.0f, 5.0f};
+  const ufo::LocalObsIndex::Header settings = localObsIndexSettings(lons, lats);
+  std::remove(localObsIndexFileName);
+  ufo::LocalObsIndex::save(localObsIndexFileName, settings, {{0.0, 0.0}}, {0, 1}, {0.0}, {0});
+  EXPECT(ufo::LocalObsIndex::open(localObsIndexFileName, settings) != nullptr);
+
+  // Observations at the same number of different (or differently ordered) locations.
+  std::vector<float> movedLats = lats;
+  movedLats[1] = 0.001f;
+  EXPECT(ufo::LocalObsIndex::open(localObsIndexFileName,
+                             localObsIndexSettings(lons, movedLats)) == nullptr);
+  const std::vector<float> swappedLons{20.0f, 10.0f, 30.0f};
+  const std::vector<float> swappedLats{0.0f, -5.0f, 5.0f};
+  EXPECT(ufo::LocalObsIndex::open(localObsIndexFileName,
+                             localObsIndexSettings(swappedLons, swappedLats)) == nullptr);
+
+  // A different assimilation window.
+  ufo::LocalObsIndex::Header otherWindow = settings;
+  otherWindow.windowStart += 21600;
+  otherWindow.windowEnd += 21600;
+  EXPECT(ufo::LocalObsIndex::open(localObsIndexFileName, otherWindow) == nullptr);
+
+  // Different localization settings.
+  ufo::LocalObsIndex::Header otherLengthscale = settings;
+  otherLengthscale.lengthscale *= 2;
+  EXPECT(ufo::LocalObsIndex::open(localObsIndexFileName, otherLengthscale) == nullptr);
+  ufo::LocalObsIndex::Header otherMaxnobs = settings;
+  otherMaxnobs.maxnobs = -1;
+  EXPECT(ufo::LocalObsIndex::open(localObsIndexFileName, otherMaxnobs) == nullptr);
+
+  // A missing file.
+  std::remove(localObsIndexFileName);
+  EXPECT(ufo::LocalObsIndex::open(localObsIndexFileName, settings) == nullptr);
+}
+
+class LocalObsIndex : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::LocalObsIndex";}
+
+  void register_tests() const override {}
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_LOCALOBSINDEX_H_
@@ -8,6 +8,7 @@
 #ifndef TEST_UFO_LOCATIONS_H_
 #define TEST_UFO_LOCATIONS_H_
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <vector>
@@ -116,6 +117,16 @@ void testLonsLats() {
   const float abstol = 1.0e-8;
   EXPECT(oops::are_all_close_absolute(params.refLons.value(), locs.lons(), abstol));
   EXPECT(oops::are_all_close_absolute(params.refLats.value(), locs.lats(), abstol));
+
+  // The Cartesian unit vectors should agree with the latitudes and longitudes.
+  const double deg2rad = M_PI / 180.0;
+  for (size_t jloc = 0; jloc < locs.size(); ++jloc) {
+    const double lon = locs.longitudes()[jloc] * deg2rad;
+    const double lat = locs.latitudes()[jloc] * deg2rad;
+    EXPECT(oops::is_close_absolute(locs.x()[jloc], std::cos(lat) * std::cos(lon), 1.0e-12));
+    EXPECT(oops::is_close_absolute(locs.y()[jloc], std::cos(lat) * std::sin(lon), 1.0e-12));
+    EXPECT(oops::is_close_absolute(locs.z()[jloc], std::sin(lat), 1.0e-12));
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -197,6 +208,26 @@ void testConcatenate() {
   EXPECT(oops::are_all_close_absolute(lats1, locs2.lats(), abstol));
 }
 
+// -----------------------------------------------------------------------------
+/// Tests that repeat() gives the same locations as repeated concatenation
+void testRepeat() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const Locations locs(conf, oops::mpi::world());
+  Locations concatenated(conf, oops::mpi::world());
+  concatenated += locs;
+  concatenated += locs;
+  Locations repeated(conf, oops::mpi::world());
+  repeated.repeat(3);
+
+  EXPECT_EQUAL(repeated.size(), 3*locs.size());
+  EXPECT(repeated.lons() == concatenated.lons());
+  EXPECT(repeated.lats() == concatenated.lats());
+  EXPECT(repeated.times() == concatenated.times());
+  EXPECT(repeated.x() == concatenated.x());
+  EXPECT(repeated.y() == concatenated.y());
+  EXPECT(repeated.z() == concatenated.z());
+}
+
 // -----------------------------------------------------------------------------
 
 class Locations : public oops::Test {
@@ -222,6 +253,8 @@ class Locations : public oops::Test {
       { testFortranTimeMask(); });
     ts.emplace_back(CASE("ufo/Locations/testConcatenation")
       { testConcatenate(); });
+    ts.emplace_back(CASE("ufo/Locations/testRepeat")
+      { testRepeat(); });
   }
 
   void clear() const override {}
@@ -8,8 +8,11 @@
 #ifndef TEST_UFO_METOFFICEBUDDYPAIRFINDER_H_
 #define TEST_UFO_METOFFICEBUDDYPAIRFINDER_H_
 
+#include <algorithm>
 #include <iomanip>
 #include <map>
+#include <memory>
+#include <numeric>
 #include <set>
 #include <string>
 #include <utility>
@@ -27,6 +30,7 @@
 #include "test/TestEnvironment.h"
 #include "ufo/filters/MetOfficeBuddyCheckParameters.h"
 #include "ufo/filters/MetOfficeBuddyPairFinder.h"
+#include "ufo/filters/MetOfficeBuddySearchIndex.h"
 #include "ufo/utils/StringUtils.h"
 
 namespace ufo {
@@ -347,6 +351,75 @@ CASE("ufo/TemporalThinning/Search radius") {
   testSearchRadius(eckit::LocalConfiguration(::test::TestEnvironment::config(), "Search radius"));
 }
 
+bool identical(const std::vector<MetOfficeBuddyPair> &a, const std::vector<MetOfficeBuddyPair> &b) {
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                    [](const MetOfficeBuddyPair &pairA, const MetOfficeBuddyPair &pairB) {
+                      return pairA.obsIdA == pairB.obsIdA && pairA.obsIdB == pairB.obsIdB &&
+                             pairA.distanceInKm == pairB.distanceInKm &&
+                             pairA.rotationAInRad == pairB.rotationAInRad &&
+                             pairA.rotationBInRad == pairB.rotationBInRad;
+                    });
+}
+
+void testSearchIndex(const eckit::LocalConfiguration &conf) {
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+
+  const eckit::LocalConfiguration obsSpaceConf(conf, "obs space");
+  ioda::ObsTopLevelParameters obsParams;
+  obsParams.validateAndDeserialize(obsSpaceConf);
+  ioda::ObsSpace obsSpace(obsParams, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+  std::vector<float> latitudes(obsSpace.nlocs());
+  obsSpace.get_db("MetaData", "latitude", latitudes);
+  std::vector<float> longitudes(obsSpace.nlocs());
+  obsSpace.get_db("MetaData", "longitude", longitudes);
+  std::vector<util::DateTime> datetimes(obsSpace.nlocs());
+  obsSpace.get_db("MetaData", "dateTime", datetimes);
+  std::vector<int> stationIds(obsSpace.recnum().begin(), obsSpace.recnum().end());
+
+  const eckit::LocalConfiguration filterConf(conf, "Met Office Buddy Check");
+  MetOfficeBuddyCheckParameters options;
+  options.deserialize(filterConf);
+
+  std::shared_ptr<MetOfficeBuddySearchIndex> index =
+      MetOfficeBuddySearchIndex::forObsSpace(obsSpace, "test");
+  EXPECT(MetOfficeBuddySearchIndex::forObsSpace(obsSpace, "test") == index);
+  EXPECT(MetOfficeBuddySearchIndex::forObsSpace(obsSpace, "other") != index);
+
+  // The index is built in the first iteration and reused in the others, in which only some
+  // observations are valid.
+  for (size_t stride : {1, 2, 3}) {
+    std::vector<size_t> validObsIds;
+    for (size_t obsId = 0; obsId < obsSpace.nlocs(); obsId += stride)
+      validObsIds.push_back(obsId);
+
+    MetOfficeBuddyPairFinder finder(options, latitudes, longitudes, datetimes,
+                                    nullptr, stationIds);
+    const std::vector<MetOfficeBuddyPair> expectedPairs = finder.findBuddyPairs(validObsIds);
+    const std::vector<MetOfficeBuddyPair> pairs = finder.findBuddyPairs(validObsIds, *index);
+    EXPECT(!pairs.empty());
+    EXPECT(identical(pairs, expectedPairs));
+    EXPECT(index->isUpToDate(latitudes, longitudes, datetimes, nullptr));
+  }
+
+  // Changing the coordinates invalidates the index.
+  for (float &latitude : latitudes)
+    latitude = -latitude;
+  EXPECT_NOT(index->isUpToDate(latitudes, longitudes, datetimes, nullptr));
+  std::vector<size_t> validObsIds(obsSpace.nlocs());
+  std::iota(validObsIds.begin(), validObsIds.end(), 0);
+  MetOfficeBuddyPairFinder finder(options, latitudes, longitudes, datetimes,
+                                  nullptr, stationIds);
+  EXPECT(identical(finder.findBuddyPairs(validObsIds, *index),
+                   finder.findBuddyPairs(validObsIds)));
+  EXPECT(index->isUpToDate(latitudes, longitudes, datetimes, nullptr));
+}
+
+CASE("ufo/MetOfficeBuddyPairFinder/Search index") {
+  testSearchIndex(eckit::LocalConfiguration(::test::TestEnvironment::config(), "Search index"));
+}
+
 class MetOfficeBuddyPairFinder : public oops::Test {
  private:
   std::string testid() const override {return "ufo::test::MetOfficeBuddyPairFinder";}
@@ -57,6 +57,13 @@ void testMetOfficeRadianceErrorMatrices(const eckit::LocalConfiguration &conf) {
   Eigen::MatrixXf BHT;
   bmatrix.multiply(latitude, Hmatrix.transpose(), BHT);
 
+  // The cached Cholesky factorisation should reproduce the bmatrix for this band
+  const Eigen::LLT<Eigen::MatrixXf> & bfactors = bmatrix.factorisation(latitude);
+  ASSERT(bfactors.info() == Eigen::Success);
+  const Eigen::MatrixXf & bband = bmatrix.matrix(latitude);
+  EXPECT((bfactors.reconstructedMatrix() - bband).cwiseAbs().maxCoeff() <
+         tol * bband.cwiseAbs().maxCoeff());
+
   // Test print function
   oops::Log::info() << "bmatrix = " << bmatrix << std::endl;
 
@@ -74,6 +81,11 @@ void testMetOfficeRadianceErrorMatrices(const eckit::LocalConfiguration &conf) {
   // HBH' + R
   rmatrix.add(channels, HBHT, HBHT_R);
 
+  // Repeated requests for the same channels should return the cached variances
+  const Eigen::VectorXf & rvariances = rmatrix.variances(channels);
+  EXPECT(&rmatrix.variances(channels) == &rvariances);
+  EXPECT(std::abs(HBHT(0, 0) + rvariances(0) - HBHT_R(0, 0)) < tol);
+
   // Test print function
   oops::Log::info() << "rmatrix = " << rmatrix << std::endl;
 
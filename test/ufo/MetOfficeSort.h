@@ -46,6 +46,41 @@ CASE("ufo/MetOfficeSort/withKey") {
   }
 }
 
+CASE("ufo/MetOfficeSort/buffered") {
+  const eckit::Configuration &topLevelConf = ::test::TestEnvironment::config();
+  for (const eckit::LocalConfiguration &conf : topLevelConf.getSubConfigurations("no key")) {
+    std::vector<int> input = conf.getIntVector("input");
+    const std::vector<int> expectedOutput = conf.getIntVector("output");
+    metOfficeSort(input.begin(), input.end(), MetOfficeSortAlgorithm::BUFFERED);
+    EXPECT_EQUAL(input, expectedOutput);
+  }
+  for (const eckit::LocalConfiguration &conf : topLevelConf.getSubConfigurations("with key")) {
+    const std::vector<std::string> keys = conf.getStringVector("keys");
+    std::vector<size_t> index(keys.size());
+    std::iota(index.begin(), index.end(), 0);
+    const std::vector<size_t> expectedOutput = conf.getUnsignedVector("output");
+    metOfficeSort(index.begin(), index.end(), [&keys] (size_t i) { return keys[i]; },
+                  MetOfficeSortAlgorithm::BUFFERED);
+    EXPECT_EQUAL(index, expectedOutput);
+  }
+
+  // Compare against the in-place heap sort on ranges long enough to be buffered, with and
+  // without duplicate keys.
+  for (int maxKey : {10, 1000000}) {
+    std::vector<float> keys(1000);
+    for (size_t i = 0; i < keys.size(); ++i)
+      keys[i] = static_cast<float>((i * 7919 + 13) % maxKey);
+    std::vector<size_t> heapSorted(keys.size());
+    std::iota(heapSorted.begin(), heapSorted.end(), 0);
+    std::vector<size_t> bufferSorted = heapSorted;
+    const auto key = [&keys] (size_t i) { return keys[i]; };
+    metOfficeSort(heapSorted.begin(), heapSorted.end(), key, MetOfficeSortAlgorithm::HEAP_SORT);
+    metOfficeSort(bufferSorted.begin(), bufferSorted.end(), key,
+                  MetOfficeSortAlgorithm::BUFFERED);
+    EXPECT_EQUAL(bufferSorted, heapSorted);
+  }
+}
+
 class MetOfficeSort : public oops::Test {
  private:
   std::string testid() const override {return "ufo::test::MetOfficeSort";}
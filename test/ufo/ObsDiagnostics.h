@@ -8,6 +8,7 @@
 #ifndef TEST_UFO_OBSDIAGNOSTICS_H_
 #define TEST_UFO_OBSDIAGNOSTICS_H_
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "oops/base/Variables.h"
 #include "oops/mpi/mpi.h"
 #include "oops/runs/Test.h"
+#include "oops/util/missingValues.h"
 #include "test/TestEnvironment.h"
 #include "ufo/GeoVaLs.h"
 #include "ufo/Locations.h"
@@ -122,6 +124,52 @@ void testObsDiagnostics() {
 
 // -----------------------------------------------------------------------------
 
+void testLazyAllocation() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+  const eckit::LocalConfiguration obsconf(conf, "obs space");
+  ioda::ObsTopLevelParameters obsparams;
+  obsparams.validateAndDeserialize(obsconf);
+  ioda::ObsSpace ospace(obsparams, oops::mpi::world(), bgn, end, oops::mpi::myself());
+  const size_t nlocs = ospace.nlocs();
+
+  eckit::LocalConfiguration obsopconf(conf, "obs operator");
+  ObsOperatorParametersWrapper obsopparams;
+  obsopparams.validateAndDeserialize(obsopconf);
+  ObsOperator hop(ospace, obsopparams);
+
+  eckit::LocalConfiguration diagconf(conf, "obs diagnostics");
+  oops::Variables diagvars(diagconf, "variables");
+  std::unique_ptr<Locations> locs(hop.locations());
+  ObsDiagnostics diags(ospace, *(locs.get()), diagvars);
+
+  const std::string var = diagvars[0];
+  const oops::Variables vars({var});
+  const double missing = util::missingValue(missing);
+  diags.allocate(2, vars);
+  EXPECT(diags.nlevs(var) == 2);
+  // Reallocation with the same number of levels is allowed, with a different one is not.
+  diags.allocate(2, vars);
+  EXPECT_THROWS(diags.allocate(3, vars));
+
+  // Values not saved yet are missing.
+  std::vector<double> vals(nlocs, 0.0);
+  diags.get(vals, var, 0);
+  EXPECT(std::all_of(vals.begin(), vals.end(), [&](double x) { return x == missing; }));
+
+  const std::vector<double> saved(nlocs, 1.0);
+  diags.save(saved, var, 1);
+  diags.get(vals, var, 1);
+  EXPECT(vals == saved);
+  diags.get(vals, var, 0);
+  EXPECT(std::all_of(vals.begin(), vals.end(), [&](double x) { return x == missing; }));
+  EXPECT_THROWS(diags.allocate(3, vars));
+}
+
+// -----------------------------------------------------------------------------
+
 class ObsDiagnostics : public oops::Test {
  public:
   ObsDiagnostics() {}
@@ -134,6 +182,8 @@ class ObsDiagnostics : public oops::Test {
 
     ts.emplace_back(CASE("ufo/ObsDiagnostics/testObsDiagnostics")
       { testObsDiagnostics(); });
+    ts.emplace_back(CASE("ufo/ObsDiagnostics/testLazyAllocation")
+      { testLazyAllocation(); });
   }
 
   void clear() const override {}
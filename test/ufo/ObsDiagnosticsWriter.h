@@ -0,0 +1,142 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_OBSDIAGNOSTICSWRITER_H_
+#define TEST_UFO_OBSDIAGNOSTICSWRITER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+#include "oops/base/Variables.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Expect.h"
+#include "test/TestEnvironment.h"
+#include "ufo/filters/ObsDiagnosticsWriter.h"
+#include "ufo/GeoVaLs.h"
+#include "ufo/ObsDiagnostics.h"
+
+namespace ufo {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+/// Name of the file written by MPI task 0 when the diagnostics are saved to \p filename.
+std::string diagnosticsFileOfTask0(const std::string & filename) {
+  const std::string::size_type dot = filename.rfind('.');
+  if (dot == std::string::npos)
+    return filename + "_0000";
+  return filename.substr(0, dot) + "_0000" + filename.substr(dot);
+}
+
+/// Read the diagnostics \p vars from \p filename.
+std::unique_ptr<ObsDiagnostics> readDiagnostics(const std::string & filename,
+                                                const ioda::ObsSpace & ospace,
+                                                const oops::Variables & vars) {
+  eckit::LocalConfiguration conf;
+  conf.set("filename", filename);
+  GeoVaLsParameters params;
+  params.validateAndDeserialize(conf);
+  return std::make_unique<ObsDiagnostics>(params, ospace, vars);
+}
+
+/// Write \p diags with a YDIAGsaver configured by \p conf, then overwrite the first level of
+/// the first diagnostic (to check that the values written are those passed to postFilter()).
+void saveDiagnostics(const eckit::LocalConfiguration & conf, ioda::ObsSpace & ospace,
+                     ObsDiagnostics & diags, const oops::Variables & vars) {
+  ObsDiagnosticsWriterParameters params;
+  params.validateAndDeserialize(conf);
+  ufo::ObsDiagnosticsWriter writer(ospace, params, nullptr, nullptr);
+  const GeoVaLs gvals(ospace.distribution(), oops::Variables());
+  const ioda::ObsVector hofx(ospace);
+  const ioda::ObsVector bias(ospace);
+  writer.postFilter(gvals, hofx, bias, diags);
+  diags.save(std::vector<double>(ospace.nlocs(), -1.0), vars[0], 0);
+  // The writer waits for the completion of any write in progress when it is destroyed.
+}
+
+// -----------------------------------------------------------------------------
+
+/// Check that the diagnostics file written by YDIAGsaver with `asynchronous: true` is the same
+/// as the one written synchronously.
+void testAsynchronousWrite() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const util::DateTime bgn(conf.getString("window begin"));
+  const util::DateTime end(conf.getString("window end"));
+  ioda::ObsTopLevelParameters obsparams;
+  obsparams.validateAndDeserialize(eckit::LocalConfiguration(conf, "obs space"));
+  ioda::ObsSpace ospace(obsparams, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+  const oops::Variables vars(conf.getStringVector("diagnostics.variables"),
+                             conf.getIntVector("diagnostics.channels"));
+  const std::string input = conf.getString("diagnostics.filename");
+
+  eckit::LocalConfiguration writerConf(conf, "writer");
+  const std::string syncOutput = writerConf.getString("filename") + "_sync.nc4";
+  const std::string asyncOutput = writerConf.getString("filename") + "_async.nc4";
+
+  std::unique_ptr<ObsDiagnostics> diags = readDiagnostics(input, ospace, vars);
+  writerConf.set("filename", syncOutput);
+  writerConf.set("asynchronous", false);
+  saveDiagnostics(writerConf, ospace, *diags, vars);
+
+  diags = readDiagnostics(input, ospace, vars);
+  writerConf.set("filename", asyncOutput);
+  writerConf.set("asynchronous", true);
+  saveDiagnostics(writerConf, ospace, *diags, vars);
+
+  const std::unique_ptr<ObsDiagnostics> original = readDiagnostics(input, ospace, vars);
+  const std::unique_ptr<ObsDiagnostics> sync =
+      readDiagnostics(diagnosticsFileOfTask0(syncOutput), ospace, vars);
+  const std::unique_ptr<ObsDiagnostics> async =
+      readDiagnostics(diagnosticsFileOfTask0(asyncOutput), ospace, vars);
+  std::vector<double> expected(ospace.nlocs()), syncValues(ospace.nlocs()),
+      asyncValues(ospace.nlocs());
+  for (size_t jvar = 0; jvar < vars.size(); ++jvar) {
+    EXPECT_EQUAL(sync->nlevs(vars[jvar]), original->nlevs(vars[jvar]));
+    EXPECT_EQUAL(async->nlevs(vars[jvar]), original->nlevs(vars[jvar]));
+    for (size_t jlev = 0; jlev < original->nlevs(vars[jvar]); ++jlev) {
+      original->get(expected, vars[jvar], jlev);
+      sync->get(syncValues, vars[jvar], jlev);
+      async->get(asyncValues, vars[jvar], jlev);
+      EXPECT_EQUAL(syncValues, expected);
+      EXPECT_EQUAL(asyncValues, expected);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class ObsDiagnosticsWriter : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::ObsDiagnosticsWriter";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/ObsDiagnosticsWriter/asynchronousWrite") {
+                      testAsynchronousWrite();
+                    });
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_OBSDIAGNOSTICSWRITER_H_
@@ -0,0 +1,108 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_OBSERRORDIAGONAL_H_
+#define TEST_UFO_OBSERRORDIAGONAL_H_
+
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Expect.h"
+#include "oops/util/FloatCompare.h"
+#include "test/TestEnvironment.h"
+#include "ufo/errors/ObsErrorDiagonal.h"
+
+namespace ufo {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+/// Return true if \p a and \p b are equal element by element.
+bool sameValues(const ioda::ObsVector &a, const ioda::ObsVector &b) {
+  if (a.size() != b.size())
+    return false;
+  for (size_t jj = 0; jj < a.size(); ++jj)
+    if (a[jj] != b[jj])
+      return false;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+/// \brief Tests that the fused operations of ObsErrorDiagonal produce the same results as the
+/// sequences of separate operations they replace.
+void testObsErrorDiagonalFusedOperations() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const util::DateTime bgn(conf.getString("window begin"));
+  const util::DateTime end(conf.getString("window end"));
+
+  for (const eckit::LocalConfiguration &oconf : conf.getSubConfigurations("observations")) {
+    ioda::ObsTopLevelParameters obsparams;
+    obsparams.validateAndDeserialize(oconf.getSubConfiguration("obs space"));
+    ioda::ObsSpace odb(obsparams, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+    ObsErrorDiagonalParameters errorparams;
+    errorparams.validateAndDeserialize(oconf.getSubConfiguration("obs error"));
+    const ufo::ObsErrorDiagonal R(errorparams, odb, oops::mpi::myself());
+
+    const ioda::ObsVector dy(odb, "ObsValue");
+
+    // inverseMultiplyAndDot
+    ioda::ObsVector expectedRinvDy(dy);
+    R.inverseMultiply(expectedRinvDy);
+    const double expectedDot = dy.dot_product_with(expectedRinvDy);
+    ioda::ObsVector rinvDy(dy);
+    const double dot = R.inverseMultiplyAndDot(rinvDy);
+    EXPECT(sameValues(rinvDy, expectedRinvDy));
+    EXPECT(oops::is_close_relative(dot, expectedDot, 1e-12));
+
+    // multiplyAdd
+    ioda::ObsVector expectedY(dy);
+    ioda::ObsVector rDy(dy);
+    R.multiply(rDy);
+    expectedY.axpy(0.5, rDy);
+    ioda::ObsVector y(dy);
+    R.multiplyAdd(y, 0.5, dy);
+    EXPECT(sameValues(y, expectedY));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class ObsErrorDiagonal : public oops::Test {
+ public:
+  ObsErrorDiagonal() = default;
+  virtual ~ObsErrorDiagonal() = default;
+
+ private:
+  std::string testid() const override {return "ufo::test::ObsErrorDiagonal";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/ObsErrorDiagonal/testObsErrorDiagonalFusedOperations")
+      { testObsErrorDiagonalFusedOperations(); });
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_OBSERRORDIAGONAL_H_
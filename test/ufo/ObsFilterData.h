@@ -31,6 +31,30 @@ namespace test {
 
 // -----------------------------------------------------------------------------
 
+// Check that getView() returns the same values as get() (for the types supported by getView()).
+template <typename T>
+void testGetView(const ufo::ObsFilterData&, const ufo::Variable &,
+                 const std::vector<T> &, const bool) {}
+
+template <typename T>
+void testGetViewNumeric(const ufo::ObsFilterData& data, const ufo::Variable &var,
+                        const std::vector<T> &expectedValues, const bool skipDerived) {
+  const ufo::ObsFilterDataView<T> view = data.getView<T>(var, skipDerived);
+  EXPECT(std::vector<T>(view.begin(), view.end()) == expectedValues);
+}
+
+void testGetView(const ufo::ObsFilterData& data, const ufo::Variable &var,
+                 const std::vector<float> &expectedValues, const bool skipDerived) {
+  testGetViewNumeric(data, var, expectedValues, skipDerived);
+}
+
+void testGetView(const ufo::ObsFilterData& data, const ufo::Variable &var,
+                 const std::vector<int> &expectedValues, const bool skipDerived) {
+  testGetViewNumeric(data, var, expectedValues, skipDerived);
+}
+
+// -----------------------------------------------------------------------------
+
 template <typename T>
 void testHasDtypeAndGet(const ufo::ObsFilterData& data, ioda::ObsSpace &ospace,
                         const ufo::Variable &var,
@@ -53,6 +77,9 @@ void testHasDtypeAndGet(const ufo::ObsFilterData& data, ioda::ObsSpace &ospace,
     EXPECT_EQUAL(vec.nvars(), 1);
     EXPECT(vec[0] == expectedValues);
   }
+
+  // Extract a view of the variable
+  testGetView(data, var, expectedValues, skipDerived);
 }
 
 // -----------------------------------------------------------------------------
@@ -90,6 +117,8 @@ void checkGeoVaLsGet(const ufo::ObsFilterData& data,
     data.get(variable, vec);
     gval.get(ref, variable.variable());
     EXPECT(vec == ref);
+    const ObsFilterDataView<float> view = data.getView<float>(variable);
+    EXPECT(std::vector<float>(view.begin(), view.end()) == ref);
     gval.get(ref2, variable.variable());
     compareMissingValues(ref, ref2);
 ///  otherwise need get(var, level) to retrieve
@@ -262,6 +291,26 @@ void testObsFilterData() {
       testHasDtypeAndGet(data, ospace, var, ioda::ObsDtype::Integer, ref);
     }
 
+///  Check that prefetched float and integer variables are retrieved unchanged:
+    {
+      ufo::Variables prefetchvars = obsvars;
+      prefetchvars += intvars;
+      data.prefetch(prefetchvars);
+      for (size_t jvar = 0; jvar < obsvars.nvars(); ++jvar) {
+        const ufo::Variable &var = obsvars.variable(jvar);
+        std::vector<float> ref(ospace.nlocs());
+        ospace.get_db(var.group(), var.variable(), ref);
+        testHasDtypeAndGet(data, ospace, var, ioda::ObsDtype::Float, ref);
+      }
+      for (size_t jvar = 0; jvar < intvars.nvars(); ++jvar) {
+        const ufo::Variable &var = intvars.variable(jvar);
+        std::vector<int> ref(ospace.nlocs());
+        ospace.get_db(var.group(), var.variable(), ref);
+        testHasDtypeAndGet(data, ospace, var, ioda::ObsDtype::Integer, ref);
+      }
+      data.clearPrefetched();
+    }
+
 ///  Check that has(), get() and dtype() work on string variables in ObsSpace:
     varconfs.clear();
     dataconf.get("string variables", varconfs);
@@ -336,6 +385,10 @@ void testObsFilterData() {
       const std::vector<float> &ref = obserrors[var.variable()];
 
       testHasDtypeAndGet(data, ospace, var, ioda::ObsDtype::Float, ref);
+///  Views of associated ObsDataVectors refer to their data
+      const ObsFilterDataView<float> view = data.getView<float>(var);
+      EXPECT(!view.ownsData());
+      EXPECT(view.data() == ref.data());
     }
 
 ///  Check that associate(), has(), get() and dtype() work on ObsDataVector<int>:
@@ -350,6 +403,7 @@ void testObsFilterData() {
       const std::vector<int> &ref = qcflags[var.variable()];
 
       testHasDtypeAndGet(data, ospace, var, ioda::ObsDtype::Integer, ref);
+      EXPECT(data.getView<int>(var).data() == ref.data());
     }
 
 ///  Check that associate(), has() and get() work on GeoVaLs:
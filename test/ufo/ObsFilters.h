@@ -9,6 +9,7 @@
 #define TEST_UFO_OBSFILTERS_H_
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -16,6 +17,7 @@
 
 #define ECKIT_TESTING_SELF_REGISTER_CASES 0
 
+#include "eckit/mpi/Comm.h"
 #include "eckit/testing/Test.h"
 #include "oops/base/ObsFilters.h"
 #include "oops/interface/GeoVaLs.h"
@@ -35,6 +37,8 @@
 #include "oops/util/parameters/RequiredParameter.h"
 #include "test/interface/ObsTestsFixture.h"
 #include "test/TestEnvironment.h"
+#include "ufo/filters/FilterProfiler.h"
+#include "ufo/filters/ObsAccessorCache.h"
 #include "ufo/filters/FinalCheck.h"
 #include "ufo/filters/QCflags.h"
 #include "ufo/filters/Variable.h"
@@ -81,6 +85,25 @@ class CompareVariablesParameters : public oops::Parameters {
 
 // -----------------------------------------------------------------------------
 
+/// \brief Limits on the cost of running a sequence of filters on observations from a single
+/// obs space.
+///
+/// The cost covers the creation of the filters, the loading of the GeoVaLs and the evaluation of
+/// H(x) (if needed) and the application of the filters; the limits apply on each MPI task.
+class PerformanceBudgetParameters : public oops::Parameters {
+  OOPS_CONCRETE_PARAMETERS(PerformanceBudgetParameters, Parameters)
+
+ public:
+  /// Maximum wall time (s).
+  oops::OptionalParameter<double> maxWallTime{"max wall time", this};
+
+  /// Maximum net growth of the heap (bytes). Not checked on platforms where the heap usage
+  /// cannot be determined (see FilterProfiler::heapBytes()).
+  oops::OptionalParameter<double> maxHeapGrowth{"max heap growth", this};
+};
+
+// -----------------------------------------------------------------------------
+
 /// \brief Options used to configure a test running a sequence of filters on observations
 /// from a single obs space.
 ///
@@ -159,6 +182,15 @@ class ObsTypeParameters : public oops::Parameters {
   /// contains that string.
   oops::OptionalParameter<std::string> expectExceptionWithMessage{
     "expectExceptionWithMessage", this};
+
+  /// If set, the test will fail if running the filters exceeds the specified budget.
+  oops::OptionalParameter<PerformanceBudgetParameters> performanceBudget{
+    "performance budget", this};
+
+  /// If set, the test will fail unless the ObsSpace variables gathered from all MPI ranks by
+  /// ObsAccessor were taken from the ObsAccessorCache rather than gathered again at least this
+  /// number of times.
+  oops::OptionalParameter<size_t> minObsAccessorCacheHits{"minObsAccessorCacheHits", this};
 };
 
 // -----------------------------------------------------------------------------
@@ -384,8 +416,29 @@ void expectVariablesRelativelyEqual(const ObsTraits::ObsSpace &obsspace,
 
 // -----------------------------------------------------------------------------
 
+//!
+//! Fail if the wall time \p seconds or heap growth \p heapBytes measured on any MPI task exceeds
+//! the limits set in \p budget.
+//!
+void checkPerformanceBudget(const eckit::mpi::Comm &comm, const PerformanceBudgetParameters &budget,
+                            double seconds, double heapBytes) {
+  comm.allReduceInPlace(seconds, eckit::mpi::max());
+  comm.allReduceInPlace(heapBytes, eckit::mpi::max());
+  oops::Log::info() << "Filters took " << seconds << " s and grew the heap by " << heapBytes
+                    << " bytes" << std::endl;
+  if (budget.maxWallTime.value() != boost::none)
+    EXPECT(seconds <= *budget.maxWallTime.value());
+  if (budget.maxHeapGrowth.value() != boost::none)
+    EXPECT(heapBytes <= *budget.maxHeapGrowth.value());
+}
+
+// -----------------------------------------------------------------------------
+
 void testFilters(size_t obsSpaceIndex, oops::ObsSpace<ufo::ObsTraits> &obspace,
                  const ObsTypeParameters &params) {
+  const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+  const long long startHeapBytes = FilterProfiler::heapBytes();  // NOLINT(runtime/int)
+
   typedef oops::GeoVaLs<ufo::ObsTraits>           GeoVaLs_;
   typedef oops::ObsDiagnostics<ufo::ObsTraits>    ObsDiags_;
   typedef oops::ObsAuxControl<ufo::ObsTraits>     ObsAuxCtrl_;
@@ -472,6 +525,19 @@ void testFilters(size_t obsSpaceIndex, oops::ObsSpace<ufo::ObsTraits> &obspace,
     obserrfilter.mask(*qcflags);
   }
 
+  if (params.performanceBudget.value() != boost::none) {
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    checkPerformanceBudget(obspace.comm(), *params.performanceBudget.value(), elapsed.count(),
+                           FilterProfiler::heapBytes() - startHeapBytes);
+  }
+
+  if (params.minObsAccessorCacheHits.value() != boost::none) {
+    // The filters are still alive, so this is the cache they shared.
+    const size_t hits = ObsAccessorCache::forObsSpace(obspace.obsspace())->hits();
+    oops::Log::info() << "ObsAccessorCache hits: " << hits << std::endl;
+    EXPECT(hits >= *params.minObsAccessorCacheHits.value());
+  }
+
   qcflags->save("EffectiveQC");
   const std::string errname = "EffectiveError";
   obserrfilter.save(errname);
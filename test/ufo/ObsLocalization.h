@@ -0,0 +1,341 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_OBSLOCALIZATION_H_
+#define TEST_UFO_OBSLOCALIZATION_H_
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/geometry/Point3.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+#include "oops/generic/gc99.h"
+#include "oops/generic/soar.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Expect.h"
+#include "oops/util/missingValues.h"
+#include "test/TestEnvironment.h"
+#include "ufo/obslocalization/LocalizationTaper.h"
+#include "ufo/obslocalization/ObsHorLocalization.h"
+#include "ufo/obslocalization/ObsHorLocGC99.h"
+#include "ufo/obslocalization/ObsHorLocParameters.h"
+#include "ufo/obslocalization/ObsHorLocSOAR.h"
+#include "ufo/obslocalization/ObsHorLocSOARParameters.h"
+#include "ufo/obslocalization/ObsHorVertLocalization.h"
+#include "ufo/obslocalization/ObsHorVertLocParameters.h"
+#include "ufo/obslocalization/ObsVertLocalization.h"
+#include "ufo/obslocalization/ObsVertLocParameters.h"
+
+namespace ufo {
+namespace test {
+
+/// Geometry iterator pointing to a single search point (longitude, latitude and vertical
+/// coordinate).
+class LocalizationTestIterator {
+ public:
+  explicit LocalizationTestIterator(const eckit::geometry::Point3 & point) : point_(point) {}
+  eckit::geometry::Point3 operator*() const {return point_;}
+
+ private:
+  eckit::geometry::Point3 point_;
+};
+
+/// The only part of a model used by the obs localizations.
+struct LocalizationTestModel {
+  typedef LocalizationTestIterator GeometryIterator;
+};
+
+/// Gives access to the local obs of single search points.
+class ObsHorLocalizationProbe : public ObsHorLocalization<LocalizationTestModel> {
+ public:
+  using ObsHorLocalization<LocalizationTestModel>::ObsHorLocalization;
+  using ObsHorLocalization<LocalizationTestModel>::getLocalObs;
+};
+
+/// The ObsSpace configured by the \p obsSpaceKey section of \p conf.
+std::unique_ptr<ioda::ObsSpace> localizationTestObsSpace(
+    const eckit::LocalConfiguration & conf, const std::string & obsSpaceKey = "obs space") {
+  const util::DateTime bgn(conf.getString("window begin"));
+  const util::DateTime end(conf.getString("window end"));
+  ioda::ObsTopLevelParameters obsParams;
+  obsParams.validateAndDeserialize(eckit::LocalConfiguration(conf, obsSpaceKey));
+  return std::make_unique<ioda::ObsSpace>(obsParams, oops::mpi::world(), bgn, end,
+                                          oops::mpi::myself());
+}
+
+/// Search points on a regular longitude-latitude grid, at each of the vertical coordinates
+/// listed in the configuration.
+std::vector<eckit::geometry::Point3> localizationTestPoints(
+    const eckit::LocalConfiguration & conf) {
+  const double spacing = conf.getDouble("search points.spacing");
+  const std::vector<double> levels = conf.getDoubleVector("search points.vertical coordinates");
+  std::vector<eckit::geometry::Point3> points;
+  for (double lat = -90.0; lat <= 90.0; lat += spacing)
+    for (double lon = -180.0; lon < 180.0; lon += spacing)
+      for (double level : levels)
+        points.emplace_back(lon, lat, level);
+  return points;
+}
+
+void testLocalObsBatch() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const std::unique_ptr<ioda::ObsSpace> obsspace = localizationTestObsSpace(conf);
+  const std::vector<eckit::geometry::Point3> points = localizationTestPoints(conf);
+
+  for (const eckit::LocalConfiguration & locConf :
+         conf.getSubConfigurations("horizontal localizations")) {
+    ObsHorLocParameters params;
+    params.validateAndDeserialize(locConf);
+    const double lengthscale = params.lengthscale;
+
+    // Local obs of all points found at once, by several threads if OpenMP is enabled, ...
+    const ObsHorLocalizationProbe batchLocalization(params, *obsspace);
+    const ObsHorLocalizationProbe::LocalObsBatch batch =
+        batchLocalization.getLocalObsBatch(points, lengthscale);
+    EXPECT_EQUAL(batch.offsets.size(), points.size() + 1);
+    EXPECT(batch.offsets.back() > 0);
+
+    // ... must be those found for one point at a time.
+    const ObsHorLocalizationProbe pointLocalization(params, *obsspace);
+    for (size_t jp = 0; jp < points.size(); ++jp) {
+      const auto localobs = pointLocalization.getLocalObs(LocalizationTestIterator(points[jp]),
+                                                          lengthscale);
+      const std::vector<int> index(batch.index.begin() + batch.offsets[jp],
+                                   batch.index.begin() + batch.offsets[jp + 1]);
+      const std::vector<double> distance(batch.distance.begin() + batch.offsets[jp],
+                                         batch.distance.begin() + batch.offsets[jp + 1]);
+      EXPECT_EQUAL(index, localobs.index);
+      EXPECT_EQUAL(distance, localobs.distance);
+    }
+
+    // A second batch is taken from the cache if there is one, and must not change either.
+    const ObsHorLocalizationProbe::LocalObsBatch again =
+        batchLocalization.getLocalObsBatch(points, lengthscale);
+    EXPECT_EQUAL(again.offsets, batch.offsets);
+    EXPECT_EQUAL(again.index, batch.index);
+    EXPECT_EQUAL(again.distance, batch.distance);
+  }
+}
+
+/// Check the batched localization functions against the functions of oops they replace, on
+/// both pieces of the Gaspari-Cohn function, at their boundaries and beyond the lengthscale.
+void testLocalizationTaper() {
+  const double lengthscale = 2000.0;
+  const double SOARexpDecay = 1.5e-3;
+  const std::vector<double> x{0.0, 0.25, 0.5, 0.75, 1.0, 1.5, 3.0};
+  std::vector<double> dist;
+  for (double xx : x)
+    dist.push_back(xx * lengthscale);
+  const double tol = 1.0e-12;
+
+  std::vector<double> taper;
+  gc99Taper(dist, lengthscale, taper);
+  EXPECT_EQUAL(taper.size(), dist.size());
+  for (size_t j = 0; j < dist.size(); ++j)
+    EXPECT(std::abs(taper[j] - oops::gc99(x[j])) <= tol);
+  EXPECT_EQUAL(taper[0], 1.0);
+  EXPECT_EQUAL(taper[5], 0.0);
+
+  soarTaper(dist, SOARexpDecay, taper);
+  EXPECT_EQUAL(taper.size(), dist.size());
+  for (size_t j = 0; j < dist.size(); ++j)
+    EXPECT(std::abs(taper[j] - oops::soar(dist[j] * SOARexpDecay)) <= tol);
+
+  std::vector<double> expected;
+  localizationTaper("Gaspari Cohn", dist, lengthscale, SOARexpDecay, taper);
+  gc99Taper(dist, lengthscale, expected);
+  EXPECT_EQUAL(taper, expected);
+  localizationTaper("SOAR", dist, lengthscale, SOARexpDecay, taper);
+  soarTaper(dist, SOARexpDecay, expected);
+  EXPECT_EQUAL(taper, expected);
+  localizationTaper("Box Car", dist, lengthscale, SOARexpDecay, taper);
+  EXPECT_EQUAL(taper, std::vector<double>(dist.size(), 1.0));
+  localizationTaper("Gaspari Cohn", {}, lengthscale, SOARexpDecay, taper);
+  EXPECT(taper.empty());
+
+  const double missing = util::missingValue(double());
+  EXPECT_THROWS(localizationTaper("SOAR", dist, lengthscale, missing, taper));
+  EXPECT_THROWS(localizationTaper("Gauss", dist, lengthscale, SOARexpDecay, taper));
+
+  // applyTaper multiplies the values of the listed obs only and leaves missing values alone.
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const std::unique_ptr<ioda::ObsSpace> obsspace = localizationTestObsSpace(conf);
+  ioda::ObsVector locvector(*obsspace);
+  const size_t nvars = locvector.nvars();
+  EXPECT(locvector.nlocs() >= 4);
+  for (size_t jj = 0; jj < locvector.size(); ++jj)
+    locvector[jj] = 2.0;
+  for (size_t jvar = 0; jvar < nvars; ++jvar)
+    locvector[3 * nvars + jvar] = missing;
+  applyTaper({1, 3}, {0.25, 0.5}, locvector);
+  for (size_t jloc = 0; jloc < locvector.nlocs(); ++jloc) {
+    const double expectedValue = jloc == 1 ? 0.5 : (jloc == 3 ? missing : 2.0);
+    for (size_t jvar = 0; jvar < nvars; ++jvar)
+      EXPECT_EQUAL(locvector[jloc * nvars + jvar], expectedValue);
+  }
+}
+
+/// Check that the brute force search keeping the `max nobs` closest obs returns the same obs,
+/// in the same order, as a full sort of all obs within the lengthscale by distance and index.
+/// The obs are chosen so that some of the selections have to break ties.
+void testMaxNobs() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const eckit::LocalConfiguration testConf(conf, "max nobs");
+  const std::unique_ptr<ioda::ObsSpace> obsspace =
+      localizationTestObsSpace(conf, "max nobs.obs space");
+  std::vector<float> lons(obsspace->nlocs()), lats(obsspace->nlocs());
+  obsspace->get_db("MetaData", "longitude", lons);
+  obsspace->get_db("MetaData", "latitude", lats);
+
+  const std::vector<double> pointLons = testConf.getDoubleVector("search point longitudes");
+  const std::vector<double> pointLats = testConf.getDoubleVector("search point latitudes");
+  const double lengthscale = testConf.getDouble("lengthscale");
+  size_t nselectionsWithTies = 0;
+  for (int maxnobs : testConf.getIntVector("max nobs values")) {
+    eckit::LocalConfiguration locConf;
+    locConf.set("localization method", "Horizontal Box car");
+    locConf.set("lengthscale", lengthscale);
+    locConf.set("search method", "brute_force");
+    locConf.set("max nobs", maxnobs);
+    ObsHorLocParameters params;
+    params.validateAndDeserialize(locConf);
+    const ObsHorLocalizationProbe localization(params, *obsspace);
+
+    for (size_t jp = 0; jp < pointLons.size(); ++jp) {
+      const eckit::geometry::Point3 point(pointLons[jp], pointLats[jp], 0.0);
+      std::vector<std::pair<double, int>> candidates;
+      for (size_t jloc = 0; jloc < lons.size(); ++jloc) {
+        const double dist = params.distance(point,
+                                            eckit::geometry::Point3(lons[jloc], lats[jloc], 0.0));
+        if (dist < lengthscale)
+          candidates.emplace_back(dist, jloc);
+      }
+      std::sort(candidates.begin(), candidates.end());
+      EXPECT(candidates.size() > static_cast<size_t>(maxnobs));
+      if (candidates[maxnobs - 1].first == candidates[maxnobs].first)
+        ++nselectionsWithTies;
+      candidates.resize(maxnobs);
+
+      const auto localobs = localization.getLocalObs(LocalizationTestIterator(point),
+                                                     lengthscale);
+      EXPECT_EQUAL(localobs.index.size(), candidates.size());
+      for (size_t jlocal = 0; jlocal < candidates.size(); ++jlocal) {
+        EXPECT_EQUAL(localobs.index[jlocal], candidates[jlocal].second);
+        EXPECT_EQUAL(localobs.distance[jlocal], candidates[jlocal].first);
+      }
+    }
+  }
+  EXPECT(nselectionsWithTies > 0);
+}
+
+/// The horizontal localization registered in the obs localization factory under the
+/// `localization method` set in \p conf.
+std::unique_ptr<ObsHorLocalization<LocalizationTestModel>> makeHorLocalization(
+    const eckit::LocalConfiguration & conf, const ioda::ObsSpace & obsspace) {
+  const std::string method = conf.getString("localization method");
+  if (method == "Horizontal SOAR") {
+    ObsHorLocSOARParameters params;
+    params.validateAndDeserialize(conf);
+    return std::make_unique<ObsHorLocSOAR<LocalizationTestModel>>(params, obsspace);
+  }
+  ObsHorLocParameters params;
+  params.validateAndDeserialize(conf);
+  if (method == "Horizontal Gaspari-Cohn")
+    return std::make_unique<ObsHorLocGC99<LocalizationTestModel>>(params, obsspace);
+  EXPECT_EQUAL(method, "Horizontal Box car");
+  return std::make_unique<ObsHorLocalization<LocalizationTestModel>>(params, obsspace);
+}
+
+/// Check that the combined horizontal and vertical localization gives the same local obs and
+/// localization values as the horizontal localization followed by the vertical localization.
+void testHorVertLocalization() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const std::unique_ptr<ioda::ObsSpace> obsspace = localizationTestObsSpace(conf);
+  const std::vector<eckit::geometry::Point3> points = localizationTestPoints(conf);
+  const double missing = util::missingValue(double());
+  const double tol = conf.getDouble("horizontal and vertical localizations tolerance");
+
+  for (const eckit::LocalConfiguration & testConf :
+         conf.getSubConfigurations("horizontal and vertical localizations")) {
+    ObsHorVertLocParameters horVertParams;
+    horVertParams.validateAndDeserialize(
+          eckit::LocalConfiguration(testConf, "horizontal and vertical"));
+    const ObsHorVertLocalization<LocalizationTestModel> horVert(horVertParams, *obsspace);
+
+    const std::unique_ptr<ObsHorLocalization<LocalizationTestModel>> hor =
+        makeHorLocalization(eckit::LocalConfiguration(testConf, "horizontal"), *obsspace);
+    ObsVertLocParameters vertParams;
+    vertParams.validateAndDeserialize(eckit::LocalConfiguration(testConf, "vertical"));
+    const ObsVertLocalization<LocalizationTestModel> vert(vertParams, *obsspace);
+
+    ioda::ObsVector combined(*obsspace);
+    ioda::ObsVector sequential(*obsspace);
+    size_t nlocal = 0;
+    for (const eckit::geometry::Point3 & point : points) {
+      const LocalizationTestIterator iter(point);
+      for (size_t jj = 0; jj < combined.size(); ++jj) {
+        combined[jj] = 1.0;
+        sequential[jj] = 1.0;
+      }
+      horVert.computeLocalization(iter, combined);
+      hor->computeLocalization(iter, sequential);
+      vert.computeLocalization(iter, sequential);
+
+      for (size_t jj = 0; jj < combined.size(); ++jj) {
+        if (sequential[jj] == missing) {
+          EXPECT_EQUAL(combined[jj], missing);
+        } else {
+          ++nlocal;
+          EXPECT(combined[jj] != missing);
+          EXPECT(std::abs(combined[jj] - sequential[jj]) <= tol);
+        }
+      }
+    }
+    // Make sure that the search points are not all too far from the obs.
+    EXPECT(nlocal > 0);
+  }
+}
+
+class ObsLocalization : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::ObsLocalization";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/ObsLocalization/localObsBatch") {
+                      testLocalObsBatch();
+                    });
+    ts.emplace_back(CASE("ufo/ObsLocalization/localizationTaper") {
+                      testLocalizationTaper();
+                    });
+    ts.emplace_back(CASE("ufo/ObsLocalization/maxNobs") {
+                      testMaxNobs();
+                    });
+    ts.emplace_back(CASE("ufo/ObsLocalization/horVertLocalization") {
+                      testHorVertLocalization();
+                    });
+  }
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_OBSLOCALIZATION_H_
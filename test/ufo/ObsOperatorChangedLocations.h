@@ -0,0 +1,154 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_OBSOPERATORCHANGEDLOCATIONS_H_
+#define TEST_UFO_OBSOPERATORCHANGEDLOCATIONS_H_
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+#include "oops/base/Variables.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Expect.h"
+#include "oops/util/missingValues.h"
+#include "test/TestEnvironment.h"
+#include "ufo/GeoVaLs.h"
+#include "ufo/Locations.h"
+#include "ufo/ObsBias.h"
+#include "ufo/ObsDiagnostics.h"
+#include "ufo/ObsOperator.h"
+
+namespace ufo {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+/// Simulate the observations with \p hop and return H(x).
+std::vector<double> simulateHofX(const ObsOperator & hop, ioda::ObsSpace & ospace,
+                                 const GeoVaLs & gval) {
+  const ObsBias ybias(ospace, ObsBiasParameters());
+  ioda::ObsVector hofx(ospace);
+  ioda::ObsVector bias(ospace);
+  bias.zero();
+  std::unique_ptr<Locations> locs(hop.locations());
+  ObsDiagnostics diags(ospace, *locs, oops::Variables());
+  hop.simulateObs(gval, hofx, ybias, bias, diags);
+
+  std::vector<double> values(hofx.size());
+  for (size_t jval = 0; jval < values.size(); ++jval)
+    values[jval] = hofx[jval];
+  return values;
+}
+
+/// Expect \p actual and \p expected to be equal within the relative tolerance \p tol.
+void expectCloseHofX(const std::vector<double> & actual, const std::vector<double> & expected,
+                     double tol) {
+  const double missing = util::missingValue(double());
+  EXPECT_EQUAL(actual.size(), expected.size());
+  for (size_t jval = 0; jval < actual.size(); ++jval) {
+    if (expected[jval] == missing)
+      EXPECT_EQUAL(actual[jval], missing);
+    else
+      EXPECT(std::abs(actual[jval] - expected[jval]) <= tol * std::abs(expected[jval]));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/// Check that an operator with the `recompute only changed locations` option, called a second
+/// time with GeoVaLs perturbed at some locations, produces the same H(x) as an operator
+/// recomputing it at all locations, or the H(x) of the first call if the perturbation does not
+/// exceed the `relative change threshold`.
+void testChangedLocations() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const util::DateTime bgn(conf.getString("window begin"));
+  const util::DateTime end(conf.getString("window end"));
+
+  for (const eckit::LocalConfiguration & obsconf : conf.getSubConfigurations("observations")) {
+    ioda::ObsTopLevelParameters obsparams;
+    obsparams.validateAndDeserialize(eckit::LocalConfiguration(obsconf, "obs space"));
+    ioda::ObsSpace ospace(obsparams, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+    eckit::LocalConfiguration obsopconf(obsconf, "obs operator");
+    EXPECT(obsopconf.getBool("recompute only changed locations"));
+    ObsOperatorParametersWrapper obsopparams;
+    obsopparams.validateAndDeserialize(obsopconf);
+    const ObsOperator hop(ospace, obsopparams);
+    const double threshold = obsopparams.operatorParameters.value().relativeChangeThreshold;
+
+    obsopconf.set("recompute only changed locations", false);
+    ObsOperatorParametersWrapper fullparams;
+    fullparams.validateAndDeserialize(obsopconf);
+    const ObsOperator fullhop(ospace, fullparams);
+
+    GeoVaLsParameters geovalsparams;
+    geovalsparams.validateAndDeserialize(eckit::LocalConfiguration(obsconf, "geovals"));
+    const GeoVaLs gval(geovalsparams, ospace, hop.requiredVars());
+
+    const std::vector<double> firstHofX = simulateHofX(hop, ospace, gval);
+
+    // Perturb all GeoVaLs at every `location stride`-th location.
+    const size_t stride = obsconf.getUnsigned("perturbation.location stride");
+    const double relativeSize = obsconf.getDouble("perturbation.relative size");
+    const GeoVaLs perturbed(gval);
+    const oops::Variables & vars = hop.requiredVars();
+    for (size_t jvar = 0; jvar < vars.size(); ++jvar) {
+      std::vector<double> values(perturbed.nlocs(vars[jvar]));
+      for (size_t jlev = 0; jlev < perturbed.nlevs(vars[jvar]); ++jlev) {
+        perturbed.getAtLevel(values, vars[jvar], jlev);
+        for (size_t jloc = 0; jloc < values.size(); jloc += stride)
+          values[jloc] *= 1.0 + relativeSize;
+        perturbed.putAtLevel(values, vars[jvar], jlev);
+      }
+    }
+
+    const std::vector<double> secondHofX = simulateHofX(hop, ospace, perturbed);
+    const std::vector<double> fullHofX = simulateHofX(fullhop, ospace, perturbed);
+    const double tol = obsconf.getDouble("tolerance");
+    if (relativeSize > threshold) {
+      expectCloseHofX(secondHofX, fullHofX, tol);
+      // Make sure that the perturbation did change H(x), i.e. that something was recomputed.
+      EXPECT(secondHofX != firstHofX);
+    } else {
+      expectCloseHofX(secondHofX, firstHofX, tol);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class ObsOperatorChangedLocations : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::ObsOperatorChangedLocations";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/ObsOperatorChangedLocations/testChangedLocations") {
+                      testChangedLocations();
+                    });
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_OBSOPERATORCHANGEDLOCATIONS_H_
@@ -0,0 +1,150 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_OBSOPERATORSKIPREJECTED_H_
+#define TEST_UFO_OBSOPERATORSKIPREJECTED_H_
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+#include "ioda/ObsVector.h"
+#include "oops/base/Variables.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Expect.h"
+#include "oops/util/missingValues.h"
+#include "test/TestEnvironment.h"
+#include "ufo/filters/QCflags.h"
+#include "ufo/filters/QCFlagsRegistry.h"
+#include "ufo/GeoVaLs.h"
+#include "ufo/Locations.h"
+#include "ufo/ObsBias.h"
+#include "ufo/ObsDiagnostics.h"
+#include "ufo/ObsOperator.h"
+
+namespace ufo {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+/// Simulate the observations with the operator configured by \p obsopconf and return H(x).
+std::vector<double> simulateSkippingRejected(const eckit::LocalConfiguration & obsopconf,
+                                             ioda::ObsSpace & ospace,
+                                             const eckit::LocalConfiguration & gconf) {
+  ObsOperatorParametersWrapper obsopparams;
+  obsopparams.validateAndDeserialize(obsopconf);
+  const ObsOperator hop(ospace, obsopparams);
+
+  GeoVaLsParameters geovalsparams;
+  geovalsparams.validateAndDeserialize(gconf);
+  const GeoVaLs gval(geovalsparams, ospace, hop.requiredVars());
+
+  const ObsBias ybias(ospace, ObsBiasParameters());
+  ioda::ObsVector hofx(ospace);
+  ioda::ObsVector bias(ospace);
+  bias.zero();
+  std::unique_ptr<Locations> locs(hop.locations());
+  ObsDiagnostics diags(ospace, *locs, oops::Variables());
+  hop.simulateObs(gval, hofx, ybias, bias, diags);
+
+  std::vector<double> values(hofx.size());
+  for (size_t jval = 0; jval < values.size(); ++jval)
+    values[jval] = hofx[jval];
+  return values;
+}
+
+// -----------------------------------------------------------------------------
+
+/// Check that an operator with the `SkipRejectedChannels` obs option produces missing H(x) for
+/// the channels rejected by earlier filters and the same H(x) as without the option for the
+/// other channels.
+void testSkipRejectedChannels() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  const util::DateTime bgn(conf.getString("window begin"));
+  const util::DateTime end(conf.getString("window end"));
+  const double missing = util::missingValue(double());
+
+  for (const eckit::LocalConfiguration & obsconf : conf.getSubConfigurations("observations")) {
+    ioda::ObsTopLevelParameters obsparams;
+    obsparams.validateAndDeserialize(eckit::LocalConfiguration(obsconf, "obs space"));
+    ioda::ObsSpace ospace(obsparams, oops::mpi::world(), bgn, end, oops::mpi::myself());
+    const eckit::LocalConfiguration gconf(obsconf, "geovals");
+
+    // Flags as they would be left by the prior filters: the listed channels are rejected.
+    const oops::Variables & vars = ospace.obsvariables();
+    const std::vector<int> & channels = vars.channels();
+    const std::vector<int> rejectedChannels = obsconf.getIntVector("rejected channels");
+    std::vector<bool> rejected(vars.size(), false);
+    std::shared_ptr<ioda::ObsDataVector<int>> qcflags(new ioda::ObsDataVector<int>(ospace, vars));
+    for (size_t jvar = 0; jvar < vars.size(); ++jvar) {
+      rejected[jvar] = std::find(rejectedChannels.begin(), rejectedChannels.end(),
+                                 channels[jvar]) != rejectedChannels.end();
+      for (size_t jloc = 0; jloc < ospace.nlocs(); ++jloc)
+        (*qcflags)[jvar][jloc] = rejected[jvar] ? QCflags::bounds : QCflags::pass;
+    }
+    EXPECT(std::count(rejected.begin(), rejected.end(), true) > 0);
+    QCFlagsRegistry::registerFlags(ospace, qcflags);
+
+    eckit::LocalConfiguration obsopconf(obsconf, "obs operator");
+    eckit::LocalConfiguration obsoptions(obsopconf, "obs options");
+    obsoptions.set("SkipRejectedChannels", true);
+    obsopconf.set("obs options", obsoptions);
+    const std::vector<double> hofx = simulateSkippingRejected(obsopconf, ospace, gconf);
+
+    obsoptions.set("SkipRejectedChannels", false);
+    obsopconf.set("obs options", obsoptions);
+    const std::vector<double> reference = simulateSkippingRejected(obsopconf, ospace, gconf);
+
+    const double tol = obsconf.getDouble("tolerance");
+    const size_t nvars = vars.size();
+    EXPECT_EQUAL(hofx.size(), ospace.nlocs() * nvars);
+    for (size_t jloc = 0; jloc < ospace.nlocs(); ++jloc) {
+      for (size_t jvar = 0; jvar < nvars; ++jvar) {
+        const double value = hofx[jloc * nvars + jvar];
+        const double expected = reference[jloc * nvars + jvar];
+        if (rejected[jvar] || expected == missing)
+          EXPECT_EQUAL(value, missing);
+        else
+          EXPECT(std::abs(value - expected) <= tol * std::abs(expected));
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class ObsOperatorSkipRejected : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::ObsOperatorSkipRejected";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ufo/ObsOperatorSkipRejected/testSkipRejectedChannels") {
+                      testSkipRejectedChannels();
+                    });
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_OBSOPERATORSKIPREJECTED_H_
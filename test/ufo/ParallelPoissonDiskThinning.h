@@ -9,6 +9,7 @@
 #define TEST_UFO_PARALLELPOISSONDISKTHINNING_H_
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <set>
@@ -29,6 +30,7 @@
 #include "test/TestEnvironment.h"
 #include "ufo/filters/PoissonDiskThinning.h"
 #include "ufo/filters/Variables.h"
+#include "ufo/utils/Constants.h"
 #include "ufo/utils/StringUtils.h"  // for splitVarGroup
 
 namespace eckit
@@ -102,6 +104,13 @@ void testPoissonDiskThinning(const eckit::LocalConfiguration &conf,
   obsspace.get_db("MetaData", "air_pressure", pressures);
   obsspace.distribution()->allGatherv(pressures);
 
+  // Collect latitudes and longitudes from all processes
+  std::vector<float> latitudes(obsspace.nlocs()), longitudes(obsspace.nlocs());
+  obsspace.get_db("MetaData", "latitude", latitudes);
+  obsspace.get_db("MetaData", "longitude", longitudes);
+  obsspace.distribution()->allGatherv(latitudes);
+  obsspace.distribution()->allGatherv(longitudes);
+
   // Collect categories from all processes
   std::vector<int> categories(obsspace.nlocs(), 0);
   if (filterConf.has("category_variable"))
@@ -112,20 +121,42 @@ void testPoissonDiskThinning(const eckit::LocalConfiguration &conf,
   }
   obsspace.distribution()->allGatherv(categories);
 
-  // Check distances between observations
-  const float minAllowedDistance = filterConf.getFloat("min_vertical_spacing");
-  std::vector<float> minDistanceToRetainedObs(pressures.size(),
-                                              std::numeric_limits<float>::max());
+  // Check distances between observations. The exclusion volumes are cylinders.
+  const bool hasMinVerticalSpacing = filterConf.has("min_vertical_spacing");
+  const bool hasMinHorizontalSpacing = filterConf.has("min_horizontal_spacing");
+  const float minVerticalSpacing = filterConf.getFloat("min_vertical_spacing", 0.0f);
+  const float minHorizontalSpacing = filterConf.getFloat("min_horizontal_spacing", 0.0f);
+  // Relative tolerance allowing for rounding errors in distance calculations
+  const float tolerance = 1e-4f;
+
+  auto horizontalDistance = [&latitudes, &longitudes](size_t i, size_t j) {
+    const double lat1 = Constants::deg2rad * latitudes[i];
+    const double lat2 = Constants::deg2rad * latitudes[j];
+    const double dlat = lat2 - lat1;
+    const double dlon = Constants::deg2rad * (longitudes[j] - longitudes[i]);
+    const double a = std::sin(dlat / 2) * std::sin(dlat / 2) +
+        std::cos(lat1) * std::cos(lat2) * std::sin(dlon / 2) * std::sin(dlon / 2);
+    return 2 * Constants::mean_earth_rad * std::asin(std::min(1.0, std::sqrt(a)));
+  };
+  // Return true if observation j lies in the interior of the exclusion volume of observation i
+  // enlarged by the factor scale.
+  auto isInExclusionVolume = [&](size_t i, size_t j, float scale) {
+    return (!hasMinVerticalSpacing ||
+            std::abs(pressures[i] - pressures[j]) < scale * minVerticalSpacing) &&
+           (!hasMinHorizontalSpacing ||
+            horizontalDistance(i, j) < scale * minHorizontalSpacing);
+  };
+
+  std::vector<bool> isCloseToRetainedObs(pressures.size(), false);
   for (size_t i : retainedGlobalObsIndices) {
     for (size_t j = 0; j < pressures.size(); ++j) {
       if (j == i || categories[i] != categories[j])
         continue;
-      const float distance = std::abs(pressures[i] - pressures[j]);
       if (oops::contains(retainedGlobalObsIndices, j)) {
         // Retained observations should be far from other retained observation
-        EXPECT(distance >= minAllowedDistance);
-      } else {
-        minDistanceToRetainedObs[j] = std::min(minDistanceToRetainedObs[j], distance);
+        EXPECT(!isInExclusionVolume(i, j, 1 - tolerance));
+      } else if (isInExclusionVolume(i, j, 1 + tolerance)) {
+        isCloseToRetainedObs[j] = true;
       }
     }
   }
@@ -133,7 +164,7 @@ void testPoissonDiskThinning(const eckit::LocalConfiguration &conf,
   for (size_t j = 0; j < pressures.size(); ++j) {
     if (!oops::contains(retainedGlobalObsIndices, j)) {
       // Rejected observations should be close to some retained observation
-      EXPECT(minDistanceToRetainedObs[j] < minAllowedDistance);
+      EXPECT(isCloseToRetainedObs[j]);
     }
   }
 }
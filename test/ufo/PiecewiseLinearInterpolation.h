@@ -51,6 +51,25 @@ CASE("ufo/PiecewiseLinearInterpolation/singleInterpolationPoint") {
   EXPECT_EQUAL(interp(10.0), 2.0);
 }
 
+CASE("ufo/PiecewiseLinearInterpolation/batch") {
+  ufo::PiecewiseLinearInterpolation interp({-1.0, 1.0, 5.0}, {2.0, 4.0, 0.0});
+  const std::vector<double> abscissas{-10.0, -1.0, 0.0, 1.0, 2.0, 5.0, 10.0, 2.0, -1.0, 0.5};
+  const std::vector<double> values = interp(abscissas);
+
+  EXPECT_EQUAL(values.size(), abscissas.size());
+  for (size_t i = 0; i < abscissas.size(); ++i)
+    EXPECT_EQUAL(values[i], interp(abscissas[i]));
+
+  ufo::PiecewiseLinearInterpolation decreasing({5.0, 1.0, -1.0}, {0.0, 4.0, 2.0});
+  const std::vector<double> decreasingValues = decreasing(abscissas);
+  for (size_t i = 0; i < abscissas.size(); ++i)
+    EXPECT_EQUAL(decreasingValues[i], decreasing(abscissas[i]));
+
+  ufo::PiecewiseLinearInterpolation single({-1.0}, {2.0});
+  EXPECT_EQUAL(single(abscissas), std::vector<double>(abscissas.size(), 2.0));
+  EXPECT(interp(std::vector<double>()).empty());
+}
+
 CASE("ufo/PiecewiseLinearInterpolation/noInterpolationPoints") {
   EXPECT_THROWS(ufo::PiecewiseLinearInterpolation({}, {}));
 }
@@ -204,6 +204,30 @@ CASE("ufo/PoissonDiskThinning/Ellipsoidal exclusion volumes") {
                                                  "Ellipsoidal exclusion volumes"));
 }
 
+CASE("ufo/PoissonDiskThinning/"
+     "Horizontal and vertical thinning, min spacing larger than nearest neighbor spacing, "
+     "grid index") {
+  testPoissonDiskThinning(eckit::LocalConfiguration(::test::TestEnvironment::config(),
+                                                 "Horizontal and vertical thinning, "
+                                                 "min spacing larger than nearest neighbor "
+                                                 "spacing, grid index"));
+}
+
+CASE("ufo/PoissonDiskThinning/Variable min spacings, grid index") {
+  testPoissonDiskThinning(eckit::LocalConfiguration(::test::TestEnvironment::config(),
+                                                 "Variable min spacings, grid index"));
+}
+
+CASE("ufo/PoissonDiskThinning/Cylindrical exclusion volumes, grid index") {
+  testPoissonDiskThinning(eckit::LocalConfiguration(::test::TestEnvironment::config(),
+                                                 "Cylindrical exclusion volumes, grid index"));
+}
+
+CASE("ufo/PoissonDiskThinning/Ellipsoidal exclusion volumes, grid index") {
+  testPoissonDiskThinning(eckit::LocalConfiguration(::test::TestEnvironment::config(),
+                                                 "Ellipsoidal exclusion volumes, grid index"));
+}
+
 CASE("ufo/PoissonDiskThinning/Incorrectly ordered min horizontal spacings") {
   testPoissonDiskThinning(eckit::LocalConfiguration(::test::TestEnvironment::config(),
                                                  "Incorrectly ordered min horizontal spacings"),
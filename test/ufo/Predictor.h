@@ -102,6 +102,16 @@ void testPredictor() {
       }
       predictors[p]->compute(ospace, *gval, ydiags, ybias, predData[p]);
       predData[p].save(predictors[p]->name() + "Predictor");
+
+      // computeOrReuse must produce the same values, whether it computes or reuses them
+      for (int pass = 0; pass < 2; ++pass) {
+        ioda::ObsVector reused(ospace);
+        predictors[p]->computeOrReuse(ospace, *gval, ydiags, ybias, reused);
+        bool same = true;
+        for (std::size_t jj = 0; jj < reused.nvars() * reused.nlocs(); ++jj)
+          same = same && reused[jj] == predData[p][jj];
+        EXPECT(same);
+      }
     }
 
     if (expect_error_message) {
@@ -0,0 +1,100 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_RADARSUPEROBBING_H_
+#define TEST_UFO_RADARSUPEROBBING_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+#include "ioda/ObsDataVector.h"
+#include "ioda/ObsSpace.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/util/FloatCompare.h"
+#include "oops/util/Expect.h"
+#include "test/TestEnvironment.h"
+#include "ufo/filters/QCflags.h"
+#include "ufo/filters/RadarSuperobbing.h"
+
+namespace ufo {
+namespace test {
+
+void testRadarSuperobbing(const eckit::LocalConfiguration &conf) {
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+
+  const eckit::LocalConfiguration obsSpaceConf(conf, "obs space");
+  ioda::ObsTopLevelParameters obsParams;
+  obsParams.validateAndDeserialize(obsSpaceConf);
+  ioda::ObsSpace obsspace(obsParams, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+  obsspace.put_db("ObsValue", "radial_velocity", conf.getFloatVector("radial_velocity"));
+  obsspace.put_db("ObsError", "radial_velocity", conf.getFloatVector("obs_errors"));
+  obsspace.put_db("MetaData", "station_id", conf.getIntVector("station_id"));
+  obsspace.put_db("MetaData", "radar_range", conf.getFloatVector("radar_range"));
+  obsspace.put_db("MetaData", "radar_azimuth", conf.getFloatVector("radar_azimuth"));
+  obsspace.put_db("MetaData", "radar_elevation", conf.getFloatVector("radar_elevation"));
+
+  std::shared_ptr<ioda::ObsDataVector<float>> obserr(new ioda::ObsDataVector<float>(
+      obsspace, obsspace.obsvariables(), "ObsError"));
+  std::shared_ptr<ioda::ObsDataVector<int>> qcflags(new ioda::ObsDataVector<int>(
+      obsspace, obsspace.obsvariables()));
+
+  eckit::LocalConfiguration filterConf(conf, "RadarSuperobbing");
+  ufo::RadarSuperobbingParameters filterParameters;
+  filterParameters.validateAndDeserialize(filterConf);
+  ufo::RadarSuperobbing filter(obsspace, filterParameters, qcflags, obserr);
+  filter.preProcess();
+
+  const std::vector<size_t> expectedThinnedObsIndices =
+      conf.getUnsignedVector("expected_thinned_obs_indices");
+  std::vector<size_t> thinnedObsIndices;
+  for (size_t i = 0; i < qcflags->nlocs(); ++i)
+    if ((*qcflags)[0][i] == ufo::QCflags::thinned)
+      thinnedObsIndices.push_back(i);
+  EXPECT_EQUAL(thinnedObsIndices, expectedThinnedObsIndices);
+
+  std::vector<float> obsValues(obsspace.nlocs());
+  obsspace.get_db("DerivedObsValue", "radial_velocity", obsValues);
+  const std::vector<float> expectedObsValues = conf.getFloatVector("expected_obs_values");
+  EXPECT(oops::are_all_close_absolute(obsValues, expectedObsValues, 1e-5f));
+
+  const std::vector<float> expectedObsErrors = conf.getFloatVector("expected_obs_errors");
+  EXPECT(oops::are_all_close_absolute((*obserr)[0], expectedObsErrors, 1e-5f));
+}
+
+class RadarSuperobbing : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::RadarSuperobbing";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+    for (const std::string & testCaseName : conf.keys())
+    {
+      const eckit::LocalConfiguration testCaseConf(::test::TestEnvironment::config(), testCaseName);
+      ts.emplace_back(CASE("ufo/RadarSuperobbing/" + testCaseName, testCaseConf)
+                      {
+                        testRadarSuperobbing(testCaseConf);
+                      });
+    }
+  }
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_RADARSUPEROBBING_H_
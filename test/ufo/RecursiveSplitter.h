@@ -10,8 +10,12 @@
 
 #include "ufo/utils/RecursiveSplitter.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <memory>
+#include <numeric>
+#include <random>
 #include <set>
 #include <string>
 #include <vector>
@@ -19,6 +23,7 @@
 #include "eckit/testing/Test.h"
 #include "oops/runs/Test.h"
 #include "oops/util/Expect.h"
+#include "oops/util/Logger.h"
 
 namespace ufo {
 namespace test {
@@ -232,6 +237,85 @@ CASE("ufo/RecursiveSplitter/Recurse") {
   orderedComparison(splitter, expected);
 }
 
+/// Split \p numIds elements by \p categoriesA and then \p categoriesB and check the groups
+/// (including the order of their elements) match those obtained by stable-sorting all elements.
+template <typename A, typename B>
+void testLargeSplit(size_t numIds, const std::vector<A> &categoriesA,
+                    const std::vector<B> &categoriesB) {
+  ufo::RecursiveSplitter splitter(numIds);
+  splitter.groupBy(categoriesA);
+  splitter.groupBy(categoriesB);
+
+  std::vector<size_t> ids(numIds);
+  std::iota(ids.begin(), ids.end(), 0);
+  auto key = [&](size_t id) { return std::make_pair(categoriesA[id], categoriesB[id]); };
+  std::stable_sort(ids.begin(), ids.end(),
+                   [&](size_t idA, size_t idB) { return key(idA) < key(idB); });
+  std::vector<std::vector<int>> expected;
+  for (size_t i = 0; i < numIds; ++i) {
+    if (i == 0 || key(ids[i]) != key(ids[i - 1]))
+      expected.emplace_back();
+    expected.back().push_back(ids[i]);
+  }
+  size_t numGroups = 0;
+  for (auto it = splitter.groups().begin(); it != splitter.groups().end(); ++it)
+    ++numGroups;
+  EXPECT_EQUAL(numGroups, expected.size());
+  orderedComparison(splitter, expected);
+}
+
+CASE("ufo/RecursiveSplitter/LargeIntCategories") {
+  // Large enough for groupBy() to use a radix sort.
+  const size_t numIds = 20000;
+  std::mt19937 generator(12345);
+  std::uniform_int_distribution<int> intDistribution(-5, 5);
+  std::uniform_int_distribution<size_t> sizeTDistribution(0, 100);
+
+  std::vector<int> intCategories(numIds);
+  std::vector<size_t> sizeTCategories(numIds);
+  for (size_t id = 0; id < numIds; ++id) {
+    // Negative values spanning most of the range of int.
+    intCategories[id] = intDistribution(generator) * 400000000;
+    // Values requiring more than one radix pass.
+    sizeTCategories[id] = sizeTDistribution(generator) * 1000003;
+  }
+
+  testLargeSplit(numIds, intCategories, sizeTCategories);
+  testLargeSplit(numIds, sizeTCategories, intCategories);
+
+  // Categories with a single value.
+  testLargeSplit(numIds, std::vector<int>(numIds, -7), sizeTCategories);
+}
+
+CASE("ufo/RecursiveSplitter/Timing") {
+  // Time groupBy() on a data set of a size typical of a large ObsSpace.
+  const size_t numIds = 10000000;
+  std::mt19937 generator(12345);
+  std::uniform_int_distribution<int> stationDistribution(0, 9999);
+  std::uniform_int_distribution<size_t> levelDistribution(0, 70);
+  std::vector<int> stations(numIds);
+  std::vector<size_t> levels(numIds);
+  for (size_t id = 0; id < numIds; ++id) {
+    stations[id] = stationDistribution(generator);
+    levels[id] = levelDistribution(generator);
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  ufo::RecursiveSplitter splitter(numIds);
+  splitter.groupBy(stations);
+  splitter.groupBy(levels);
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  oops::Log::info() << "RecursiveSplitter: grouped " << numIds << " elements in "
+                    << elapsed.count() << " s" << std::endl;
+
+  size_t numIdsInGroups = 0;
+  for (const auto &group : splitter.groups()) {
+    EXPECT(std::is_sorted(group.begin(), group.end()));
+    numIdsInGroups += group.end() - group.begin();
+  }
+  EXPECT_EQUAL(numIdsInGroups, numIds);
+}
+
 
 class RecursiveSplitter : public oops::Test {
  public:
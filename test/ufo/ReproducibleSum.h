@@ -0,0 +1,119 @@
+/*
+ * (C) Crown Copyright 2023 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_REPRODUCIBLESUM_H_
+#define TEST_UFO_REPRODUCIBLESUM_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+#include "test/TestEnvironment.h"
+#include "ufo/utils/ReproducibleSum.h"
+
+namespace ufo {
+namespace test {
+
+/// Terms of very different magnitudes and both signs.
+std::vector<double> reproducibleSumTerms() {
+  std::mt19937 generator(7);
+  std::normal_distribution<double> normal;
+  std::uniform_int_distribution<int> exponent(-30, 30);
+  std::vector<double> terms(10000);
+  for (double &term : terms)
+    term = normal(generator) * std::ldexp(1.0, exponent(generator));
+  return terms;
+}
+
+CASE("ufo/ReproducibleSum/orderIndependence") {
+  std::vector<double> terms = reproducibleSumTerms();
+  ufo::ReproducibleSum sum;
+  for (double term : terms)
+    sum.add(term);
+
+  std::mt19937 generator(11);
+  std::shuffle(terms.begin(), terms.end(), generator);
+  ufo::ReproducibleSum shuffledSum;
+  for (double term : terms)
+    shuffledSum.add(term);
+  EXPECT_EQUAL(shuffledSum.value(), sum.value());
+
+  // Partial sums combined as by threads...
+  ufo::ReproducibleSum combinedSum;
+  for (size_t part = 0; part < 3; ++part) {
+    ufo::ReproducibleSum partialSum;
+    for (size_t i = part; i < terms.size(); i += 3)
+      partialSum.add(terms[i]);
+    combinedSum += partialSum;
+  }
+  EXPECT_EQUAL(combinedSum.value(), sum.value());
+
+  // ... and as by MPI tasks.
+  std::vector<double> packedSum(ufo::ReproducibleSum::packedSize, 0.0);
+  std::vector<double> packed(ufo::ReproducibleSum::packedSize);
+  for (size_t part = 0; part < 5; ++part) {
+    ufo::ReproducibleSum partialSum;
+    for (size_t i = part; i < terms.size(); i += 5)
+      partialSum.add(terms[i]);
+    partialSum.pack(packed.data());
+    for (size_t i = 0; i < packed.size(); ++i)
+      packedSum[i] += packed[i];
+  }
+  EXPECT_EQUAL(ufo::ReproducibleSum::unpack(packedSum.data()).value(), sum.value());
+
+  const std::vector<double> values = ufo::allReduceValues(
+        std::vector<ufo::ReproducibleSum>{sum, shuffledSum}, [](std::vector<double> &) {});
+  EXPECT_EQUAL(values, std::vector<double>({sum.value(), sum.value()}));
+}
+
+CASE("ufo/ReproducibleSum/accuracy") {
+  ufo::ReproducibleSum sum;
+  sum.add(1e20);
+  sum.add(1.0);
+  sum.add(-1e20);
+  EXPECT_EQUAL(sum.value(), 1.0);
+
+  ufo::ReproducibleSum small;
+  small.add(0.1);
+  small.add(-0.3);
+  EXPECT_EQUAL(small.value(), 0.1 - 0.3);
+
+  EXPECT_EQUAL(ufo::ReproducibleSum().value(), 0.0);
+
+  ufo::ReproducibleSum infinite;
+  infinite.add(1.0);
+  infinite.add(std::numeric_limits<double>::infinity());
+  EXPECT_EQUAL(infinite.value(), std::numeric_limits<double>::infinity());
+}
+
+CASE("ufo/ReproducibleSum/mode") {
+  const bool reproducible = ufo::reproducibleReductions();
+  ufo::setReproducibleReductions(!reproducible);
+  EXPECT_EQUAL(ufo::reproducibleReductions(), !reproducible);
+  ufo::setReproducibleReductions(reproducible);
+  EXPECT_EQUAL(ufo::reproducibleReductions(), reproducible);
+}
+
+class ReproducibleSum : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::ReproducibleSum";}
+
+  void register_tests() const override {}
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_REPRODUCIBLESUM_H_
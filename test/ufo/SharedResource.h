@@ -0,0 +1,79 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_SHAREDRESOURCE_H_
+#define TEST_UFO_SHAREDRESOURCE_H_
+
+#include "ufo/utils/SharedResource.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+
+namespace ufo {
+namespace test {
+
+/// A resource recording the key it was loaded for.
+struct TestResource {
+  explicit TestResource(const std::string &key) : key(key) {}
+  std::string key;
+};
+
+CASE("ufo/SharedResource/loadsEachResourceOnce") {
+  ufo::SharedResource<TestResource>::clear();
+  size_t numLoads = 0;
+  auto loader = [&numLoads](const std::string &key) {
+    return [&numLoads, key]() {
+      ++numLoads;
+      return std::make_shared<const TestResource>(key);
+    };
+  };
+
+  std::shared_ptr<const TestResource> a1 = ufo::SharedResource<TestResource>::get("a", loader("a"));
+  std::shared_ptr<const TestResource> a2 = ufo::SharedResource<TestResource>::get("a", loader("a"));
+  EXPECT_EQUAL(numLoads, 1);
+  EXPECT(a1 == a2);
+  EXPECT_EQUAL(a1->key, "a");
+
+  std::shared_ptr<const TestResource> b = ufo::SharedResource<TestResource>::get("b", loader("b"));
+  EXPECT_EQUAL(numLoads, 2);
+  EXPECT_EQUAL(b->key, "b");
+
+  // Resources are kept even if nobody holds them.
+  a1.reset();
+  a2.reset();
+  ufo::SharedResource<TestResource>::get("a", loader("a"));
+  EXPECT_EQUAL(numLoads, 2);
+
+  // ... until they are cleared.
+  ufo::SharedResource<TestResource>::clear();
+  std::shared_ptr<const TestResource> a3 = ufo::SharedResource<TestResource>::get("a", loader("a"));
+  EXPECT_EQUAL(numLoads, 3);
+  EXPECT_EQUAL(a3->key, "a");
+  EXPECT_EQUAL(b->key, "b");
+}
+
+class SharedResource : public oops::Test {
+ public:
+  SharedResource() {}
+
+ private:
+  std::string testid() const override {return "ufo::test::SharedResource";}
+
+  void register_tests() const override {}
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_SHAREDRESOURCE_H_
@@ -42,6 +42,11 @@ void testVariable() {
     EXPECT(var.group() == refgroup);
     for (std::size_t jvar = 0; jvar < var.size(); ++jvar) {
       EXPECT(var.variable(jvar) == refvars[jvar]);
+      // the variable corresponding to a single channel
+      const Variable channelVar = var[jvar];
+      EXPECT_EQUAL(channelVar.size(), 1);
+      EXPECT_EQUAL(channelVar.variable(), refvars[jvar]);
+      EXPECT_EQUAL(channelVar.group(), refgroup);
     }
     // test the fullName() method
     const std::string refFullName = conf[jj].getString("reference full name");
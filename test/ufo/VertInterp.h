@@ -0,0 +1,198 @@
+/*
+ * (C) Crown copyright 2022, Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_UFO_VERTINTERP_H_
+#define TEST_UFO_VERTINTERP_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Expect.h"
+#include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
+#include "test/TestEnvironment.h"
+#include "ufo/utils/VertInterp.interface.h"
+#include "ufo/utils/VertInterpStencil.h"
+
+namespace ufo {
+namespace test {
+
+/// Create a column of \p nlev monotonic model levels (increasing or decreasing) and
+/// \p nobs observations spanning a slightly larger range, in random order.
+void makeColumn(int nlev, int nobs, bool increasing,
+                std::vector<double> &vec, std::vector<double> &obl) {
+  std::mt19937 generator(123);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  vec.resize(nlev);
+  for (int k = 0; k < nlev; ++k)
+    vec[k] = 10.0 * k + 5.0 * distribution(generator);
+  if (!increasing)
+    std::reverse(vec.begin(), vec.end());
+  obl.resize(nobs);
+  const double missing = util::missingValue(missing);
+  for (int i = 0; i < nobs; ++i) {
+    if (i % 97 == 0)
+      obl[i] = missing;
+    else if (i % 31 == 0)
+      obl[i] = vec[i % nlev];  // exactly on a model level
+    else
+      obl[i] = -20.0 + (10.0 * nlev + 40.0) * distribution(generator);
+  }
+}
+
+void expectSameWeights(int nlev, const std::vector<double> &vec,
+                       const std::vector<double> &obl) {
+  const int nobs = obl.size();
+  std::vector<int> wiSorted(nobs);
+  std::vector<double> wfSorted(nobs);
+  vert_interp_weights_sorted_f90(nlev, nobs, obl.data(), vec.data(),
+                                 wiSorted.data(), wfSorted.data());
+  for (int i = 0; i < nobs; ++i) {
+    int wi = 0, wiBisect = 0;
+    double wf = 0.0, wfBisect = 0.0;
+    vert_interp_weights_f90(nlev, obl[i], vec.data(), wi, wf);
+    vert_interp_weights_bisect_f90(nlev, obl[i], vec.data(), wiBisect, wfBisect);
+    EXPECT_EQUAL(wiBisect, wi);
+    EXPECT_EQUAL(wfBisect, wf);
+    EXPECT_EQUAL(wiSorted[i], wi);
+    EXPECT_EQUAL(wfSorted[i], wf);
+  }
+}
+
+CASE("ufo/VertInterp/increasingColumn") {
+  std::vector<double> vec, obl;
+  makeColumn(137, 5000, true, vec, obl);
+  expectSameWeights(vec.size(), vec, obl);
+  std::sort(obl.begin(), obl.end());
+  expectSameWeights(vec.size(), vec, obl);
+}
+
+CASE("ufo/VertInterp/decreasingColumn") {
+  std::vector<double> vec, obl;
+  makeColumn(137, 5000, false, vec, obl);
+  expectSameWeights(vec.size(), vec, obl);
+  std::sort(obl.begin(), obl.end(), std::greater<double>());
+  expectSameWeights(vec.size(), vec, obl);
+}
+
+CASE("ufo/VertInterp/twoLevels") {
+  const std::vector<double> vec{1.0, 2.0};
+  const std::vector<double> obl{0.0, 1.0, 1.5, 2.0, 3.0};
+  expectSameWeights(vec.size(), vec, obl);
+}
+
+CASE("ufo/VertInterp/stencil") {
+  const int nlev = 71;
+  const int nlocs = 3;
+  std::vector<double> modelCoord, obsCoord;
+  for (int loc = 0; loc < nlocs; ++loc) {
+    std::vector<double> vec, obl;
+    makeColumn(nlev, 200, loc % 2 == 0, vec, obl);
+    for (double &x : vec)
+      x += 100.0;  // make the coordinate positive so that its logarithm can be taken
+    modelCoord.insert(modelCoord.end(), vec.begin(), vec.end());
+    obsCoord.push_back(vec[nlev / 2 + loc] - 1.0);
+  }
+  obsCoord.push_back(util::missingValue(obsCoord[0]));
+  modelCoord.insert(modelCoord.end(), modelCoord.begin(), modelCoord.begin() + nlev);
+  // A profile of observations sharing the same column, partly unsorted and with a missing depth
+  const std::vector<double> profileColumn(modelCoord.begin() + nlev,
+                                          modelCoord.begin() + 2 * nlev);
+  for (int lev : {3, 10, 10, 9, 40, -1, 2, nlev - 1}) {
+    modelCoord.insert(modelCoord.end(), profileColumn.begin(), profileColumn.end());
+    obsCoord.push_back(lev < 0 ? util::missingValue(obsCoord[0]) : profileColumn[lev] + 0.25);
+  }
+
+  for (VertInterpStencil::Transform transform : {VertInterpStencil::Transform::NONE,
+                                                 VertInterpStencil::Transform::LOG}) {
+    const VertInterpStencil stencil(modelCoord.data(), nlev, obsCoord, transform);
+    EXPECT_EQUAL(stencil.nlocs(), obsCoord.size());
+    EXPECT_EQUAL(stencil.nlevs(), static_cast<size_t>(nlev));
+    for (size_t loc = 0; loc < obsCoord.size(); ++loc) {
+      std::vector<double> vec(modelCoord.begin() + loc * nlev,
+                              modelCoord.begin() + (loc + 1) * nlev);
+      double obl = obsCoord[loc];
+      if (transform == VertInterpStencil::Transform::LOG) {
+        for (double &x : vec)
+          x = std::log(x);
+        if (obl != util::missingValue(obl))
+          obl = std::log(obl);
+      }
+      int wi = 0;
+      double wf = 0.0;
+      vert_interp_weights_bisect_f90(nlev, obl, vec.data(), wi, wf);
+      EXPECT_EQUAL(stencil.indices()[loc], wi);
+      EXPECT_EQUAL(stencil.weights()[loc], wf);
+    }
+
+    EXPECT(stencil.matches(modelCoord.data(), nlev, obsCoord));
+    std::vector<double> otherModelCoord = modelCoord;
+    otherModelCoord[nlev + 1] += 0.5;
+    EXPECT_NOT(stencil.matches(otherModelCoord.data(), nlev, obsCoord));
+    std::vector<double> otherObsCoord = obsCoord;
+    otherObsCoord[1] += 0.5;
+    EXPECT_NOT(stencil.matches(modelCoord.data(), nlev, otherObsCoord));
+  }
+}
+
+/// Compare the run times of the linear, bisection and batched searches for the
+/// levels of a sorted ascent. The timings are only reported, not checked.
+CASE("ufo/VertInterp/benchmark") {
+  const int nlev = 137;
+  const int nobs = 200000;
+  std::vector<double> vec, obl;
+  makeColumn(nlev, nobs, true, vec, obl);
+  std::sort(obl.begin(), obl.end());
+  std::vector<int> wi(nobs);
+  std::vector<double> wf(nobs);
+
+  typedef std::chrono::steady_clock Clock;
+  const auto elapsed = [](Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  };
+
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < nobs; ++i)
+    vert_interp_weights_f90(nlev, obl[i], vec.data(), wi[i], wf[i]);
+  const double linearTime = elapsed(start);
+
+  start = Clock::now();
+  for (int i = 0; i < nobs; ++i)
+    vert_interp_weights_bisect_f90(nlev, obl[i], vec.data(), wi[i], wf[i]);
+  const double bisectTime = elapsed(start);
+
+  start = Clock::now();
+  vert_interp_weights_sorted_f90(nlev, nobs, obl.data(), vec.data(), wi.data(), wf.data());
+  const double sortedTime = elapsed(start);
+
+  oops::Log::info() << "Weights for " << nobs << " observations in a column of "
+                    << nlev << " levels:" << std::endl
+                    << "  linear search:    " << linearTime << " ms" << std::endl
+                    << "  bisection:        " << bisectTime << " ms" << std::endl
+                    << "  batched, sorted:  " << sortedTime << " ms" << std::endl;
+}
+
+class VertInterp : public oops::Test {
+ private:
+  std::string testid() const override {return "ufo::test::VertInterp";}
+
+  void register_tests() const override {}
+
+  void clear() const override {}
+};
+
+}  // namespace test
+}  // namespace ufo
+
+#endif  // TEST_UFO_VERTINTERP_H_